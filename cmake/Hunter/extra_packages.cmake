@@ -18,5 +18,6 @@ hunter_add_package(abseil)
 hunter_add_package(Boost COMPONENTS thread)
 hunter_add_package(CLI11)
 hunter_add_package(gRPC)
+hunter_add_package(lz4)
 hunter_add_package(OpenSSL)
 hunter_add_package(Protobuf)
@@ -29,6 +29,7 @@
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/settings.hpp>
+#include <silkworm/common/util.hpp>
 #include <silkworm/rpc/server/backend_kv_server.hpp>
 #include <silkworm/rpc/util.hpp>
 #include "common.hpp"
@@ -85,9 +86,17 @@ int parse_command_line(int argc, char* argv[], CLI::App& app, BackEndKvSettings&
     // TODO(canepat) add check on etherbase using EthAddressValidator [TBD]
     silkworm::cmd::add_option_num_contexts(app, num_contexts);
     silkworm::cmd::add_option_wait_mode(app, wait_mode);
+    bool cpu_affinity{false};
+    app.add_flag("--contexts.affinity", cpu_affinity, "Pin each running context to one CPU core (thread-per-core)");
     app.add_option("--mdbx.max.readers", max_readers, "The maximum number of MDBX readers")
         ->capture_default_str()
         ->check(CLI::Range(1, 32767));
+    std::string memory_quota{"0B"};
+    app.add_option("--rpc.memory.quota", memory_quota, "The maximum memory gRPC may use serving calls (0 = no quota)")
+        ->capture_default_str()
+        ->check([](const std::string& value) -> std::string {
+            return silkworm::parse_size(value) ? "" : "Value " + value + " is not a parseable size";
+        });
 
     // RPC Server options
     app.add_option("--private.api.addr", node_settings.private_api_addr,
@@ -145,6 +154,8 @@ int parse_command_line(int argc, char* argv[], CLI::App& app, BackEndKvSettings&
     server_settings.set_address_uri(node_settings.private_api_addr);
     server_settings.set_num_contexts(num_contexts);
     server_settings.set_wait_mode(wait_mode);
+    server_settings.set_cpu_affinity(cpu_affinity);
+    server_settings.set_memory_quota(silkworm::parse_size(memory_quota).value());
 
     return 0;
 }
@@ -14,6 +14,14 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include <CLI/CLI.hpp>
 #include <absl/container/flat_hash_set.h>
 
@@ -21,6 +29,7 @@
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/buffer.hpp>
+#include <silkworm/db/history_cache.hpp>
 #include <silkworm/execution/processor.hpp>
 
 using namespace evmc::literals;
@@ -34,18 +43,151 @@ static const absl::flat_hash_set<evmc::address> kPhantomAccounts{
     0x5a719cf3e02c17c876f6d294adb5cb7c6eb47e2f_address,
 };
 
-static void print_storage_changes(const db::StorageChanges& s) {
+// Blocks a thread claims at once: enough to amortize the renewal of its read transaction
+static constexpr BlockNum kBlocksPerTask{100};
+
+// State shared by the threads checking blocks
+struct CheckProgress {
+    std::atomic<BlockNum> next;               // First block not claimed yet
+    std::atomic<BlockNum> end;                // First block not to check (lowered to the first missing one)
+    std::atomic<uint64_t> checked{0};         // Blocks checked so far
+    std::atomic_bool stop{false};             // Set on the first exception
+    std::mutex mutex;                         // Guards the lists below
+    std::vector<BlockNum> failed_blocks;      // Blocks failing execution
+    std::vector<BlockNum> mismatched_blocks;  // Blocks whose change sets differ from db
+};
+
+static void print_storage_changes(std::ostream& out, const db::StorageChanges& s) {
     for (const auto& [address, x] : s) {
-        std::cout << to_hex(address) << "\n";
+        out << to_hex(address) << "\n";
         for (const auto& [incarnation, changes] : x) {
-            std::cout << "  " << incarnation << "\n";
+            out << "  " << incarnation << "\n";
             for (const auto& [location, value] : changes) {
-                std::cout << "    " << to_hex(location) << " = " << to_hex(value) << "\n";
+                out << "    " << to_hex(location) << " = " << to_hex(value) << "\n";
+            }
+        }
+    }
+}
+
+//! \brief Compares change sets of a block computed into buffer with those in db
+//! \return Whether they match; if not, the differences are written to report
+static bool compare_changes(mdbx::txn& txn, BlockNum block_num, const db::Buffer& buffer, std::ostream& report) {
+    bool match{true};
+
+    db::AccountChanges db_account_changes{db::read_account_changes(txn, block_num)};
+    const db::AccountChanges& calculated_account_changes{buffer.account_changes().at(block_num)};
+    if (calculated_account_changes != db_account_changes) {
+        for (const auto& e : db_account_changes) {
+            if (!calculated_account_changes.contains(e.first)) {
+                if (!kPhantomAccounts.contains(e.first)) {
+                    report << to_hex(e.first) << " is missing\n";
+                    match = false;
+                }
+            } else if (Bytes val{calculated_account_changes.at(e.first)}; val != e.second) {
+                report << "Value mismatch for " << to_hex(e.first) << ":\n"
+                       << to_hex(val) << "\n"
+                       << "vs DB\n"
+                       << to_hex(e.second) << "\n";
+                match = false;
+            }
+        }
+        for (const auto& e : calculated_account_changes) {
+            if (!db_account_changes.contains(e.first)) {
+                report << to_hex(e.first) << " is not in DB\n";
+                match = false;
+            }
+        }
+
+        if (!match) {
+            report << "Account change mismatch for block " << block_num << " 😲\n";
+        }
+    }
+
+    db::StorageChanges db_storage_changes{db::read_storage_changes(txn, block_num)};
+    db::StorageChanges calculated_storage_changes{};
+    if (buffer.storage_changes().contains(block_num)) {
+        calculated_storage_changes = buffer.storage_changes().at(block_num);
+    }
+    if (calculated_storage_changes != db_storage_changes) {
+        report << "Storage change mismatch for block " << block_num << " 😲\n";
+        print_storage_changes(report, calculated_storage_changes);
+        report << "vs\n";
+        print_storage_changes(report, db_storage_changes);
+        match = false;
+    }
+
+    return match;
+}
+
+//! \brief Claims blocks kBlocksPerTask at a time and checks each of them on top of the state as of its parent
+//! \remarks Blocks are independent from each other: any number of threads can run this on read-only transactions
+static void check_blocks(mdbx::env env, const ChainConfig& chain_config, CheckProgress& progress) {
+    auto engine{consensus::engine_factory(chain_config)};
+    if (!engine) {
+        throw std::runtime_error("Unable to retrieve consensus engine");
+    }
+
+    AdvancedAnalysisCache analysis_cache;
+    ExecutionContext execution_context;
+    std::vector<Receipt> receipts;
+    Block block;
+    absl::Time t1{absl::Now()};
+
+    auto txn{env.start_read()};
+    db::HistoryCache history_cache;  // Shared by the blocks of a task, hence of a read txn
+    while (!progress.stop) {
+        const BlockNum task_from{progress.next.fetch_add(kBlocksPerTask)};
+        if (task_from >= progress.end) {
+            break;
+        }
+        txn.renew_reading();  // A long-lived reader would pin pages of a database being synced
+        history_cache.clear();
+
+        for (BlockNum block_num{task_from}; block_num < task_from + kBlocksPerTask && block_num < progress.end;
+             ++block_num) {
+            if (!db::read_block_by_number(txn, block_num, /*read_senders=*/true, block)) {
+                BlockNum end{progress.end};
+                while (block_num < end && !progress.end.compare_exchange_weak(end, block_num)) {
+                }
+                break;
+            }
+
+            db::Buffer buffer{txn, /*prune_history_threshold=*/0, /*historical_block=*/block_num};
+            buffer.use_history_cache(&history_cache);
+
+            ExecutionProcessor processor{block, *engine, buffer, chain_config, &execution_context};
+            processor.evm().advanced_analysis_cache = &analysis_cache;
+
+            std::ostringstream report;
+            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
+                log::Error() << "Failed to execute block " << block_num;
+                std::scoped_lock lock{progress.mutex};
+                progress.failed_blocks.push_back(block_num);
+            } else if (!compare_changes(txn, block_num, buffer, report)) {
+                log::Error() << report.str();  // As a whole: reports of other threads do not interleave
+                std::scoped_lock lock{progress.mutex};
+                progress.mismatched_blocks.push_back(block_num);
+            }
+
+            if (const auto checked{++progress.checked}; checked % 1000 == 0) {
+                absl::Time t2{absl::Now()};
+                log::Info() << " Checked " << checked << " blocks, this thread is at " << block_num << " after "
+                            << absl::ToDoubleSeconds(t2 - t1) << " s";
+                t1 = t2;
             }
         }
     }
 }
 
+static std::string sorted_list(std::vector<BlockNum>& blocks) {
+    std::sort(blocks.begin(), blocks.end());
+    std::string list;
+    for (const BlockNum block_num : blocks) {
+        list += (list.empty() ? "" : " ") + std::to_string(block_num);
+    }
+    return list;
+}
+
 int main(int argc, char* argv[]) {
     CLI::App app{"Executes Ethereum blocks and compares resulting change sets against DB"};
 
@@ -59,94 +201,52 @@ int main(int argc, char* argv[]) {
     uint64_t to{UINT64_MAX};
     app.add_option("--to", to, "check up to block number (exclusive)");
 
-    CLI11_PARSE(app, argc, argv);
+    unsigned threads{1};
+    app.add_option("--threads", threads, "Number of threads checking blocks concurrently")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 256u));
 
-    absl::Time t1{absl::Now()};
+    CLI11_PARSE(app, argc, argv);
 
     log::Info() << " Checking change sets in " << chaindata << "\n";
 
-    uint64_t block_num{from};
+    CheckProgress progress;
+    progress.next = from;
+    progress.end = to;
 
     try {
         auto data_dir{DataDirectory::from_chaindata(chaindata)};
         data_dir.deploy();
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
+        db_config.readonly = true;
         auto env{db::open_env(db_config)};
-        auto txn{env.start_read()};
-        auto chain_config{db::read_chain_config(txn)};
+        std::optional<ChainConfig> chain_config;
+        {
+            auto txn{env.start_read()};
+            chain_config = db::read_chain_config(txn);
+        }
         if (!chain_config.has_value()) {
             throw std::runtime_error("Unable to retrieve chain config");
         }
 
-        AdvancedAnalysisCache analysis_cache;
-        ObjectPool<EvmoneExecutionState> state_pool;
-        std::vector<Receipt> receipts;
-        auto engine{consensus::engine_factory(chain_config.value())};
-        Block block;
-        for (; block_num < to; ++block_num) {
-            txn.renew_reading();
-            if (!db::read_block_by_number(txn, block_num, /*read_senders=*/true, block)) {
-                break;
-            }
-
-            db::Buffer buffer{txn, /*prune_history_threshold=*/0, /*historical_block=*/block_num};
-
-            ExecutionProcessor processor{block, *engine, buffer, *chain_config};
-            processor.evm().advanced_analysis_cache = &analysis_cache;
-            processor.evm().state_pool = &state_pool;
-
-            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
-                log::Error() << "Failed to execute block " << block_num;
-                continue;
-            }
-
-            db::AccountChanges db_account_changes{db::read_account_changes(txn, block_num)};
-            const db::AccountChanges& calculated_account_changes{buffer.account_changes().at(block_num)};
-            if (calculated_account_changes != db_account_changes) {
-                bool mismatch{false};
-
-                for (const auto& e : db_account_changes) {
-                    if (!calculated_account_changes.contains(e.first)) {
-                        if (!kPhantomAccounts.contains(e.first)) {
-                            log::Error() << to_hex(e.first) << " is missing";
-                            mismatch = true;
-                        }
-                    } else if (Bytes val{calculated_account_changes.at(e.first)}; val != e.second) {
-                        log::Error() << "Value mismatch for " << to_hex(e.first) << ":\n"
-                                     << to_hex(val) << "\n"
-                                     << "vs DB\n"
-                                     << to_hex(e.second);
-                        mismatch = true;
-                    }
+        std::vector<std::exception_ptr> exceptions(threads);
+        std::vector<std::thread> workers;
+        for (unsigned i{0}; i < threads; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    check_blocks(env, *chain_config, progress);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                    progress.stop = true;
                 }
-                for (const auto& e : calculated_account_changes) {
-                    if (!db_account_changes.contains(e.first)) {
-                        log::Error() << to_hex(e.first) << " is not in DB";
-                        mismatch = true;
-                    }
-                }
-
-                if (mismatch) {
-                    log::Error() << "Account change mismatch for block " << block_num << " 😲";
-                }
-            }
-
-            db::StorageChanges db_storage_changes{db::read_storage_changes(txn, block_num)};
-            db::StorageChanges calculated_storage_changes{};
-            if (buffer.storage_changes().contains(block_num)) {
-                calculated_storage_changes = buffer.storage_changes().at(block_num);
-            }
-            if (calculated_storage_changes != db_storage_changes) {
-                log::Error() << "Storage change mismatch for block " << block_num << " 😲";
-                print_storage_changes(calculated_storage_changes);
-                std::cout << "vs\n";
-                print_storage_changes(db_storage_changes);
-            }
-
-            if (block_num % 1000 == 0) {
-                absl::Time t2{absl::Now()};
-                log::Info() << " Checked blocks ≤ " << block_num << " in " << absl::ToDoubleSeconds(t2 - t1) << " s";
-                t1 = t2;
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (auto& ex : exceptions) {
+            if (ex) {
+                std::rethrow_exception(ex);
             }
         }
     } catch (const std::exception& ex) {
@@ -154,6 +254,14 @@ int main(int argc, char* argv[]) {
         return -5;
     }
 
-    log::Info() << " Blocks [" << from << "; " << block_num << ") have been checked";
+    log::Info() << " Blocks [" << from << "; " << progress.end << ") have been checked";
+    if (!progress.failed_blocks.empty()) {
+        log::Error() << " " << progress.failed_blocks.size()
+                     << " block(s) failed execution: " << sorted_list(progress.failed_blocks);
+    }
+    if (!progress.mismatched_blocks.empty()) {
+        log::Error() << " " << progress.mismatched_blocks.size()
+                     << " block(s) with change set mismatches: " << sorted_list(progress.mismatched_blocks);
+    }
     return 0;
 }
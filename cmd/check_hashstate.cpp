@@ -14,14 +14,18 @@
    limitations under the License.
 */
 
+#include <atomic>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 #include <CLI/CLI.hpp>
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/tables.hpp>
 #include <silkworm/db/util.hpp>
@@ -47,79 +51,91 @@ std::pair<db::MapConfig, db::MapConfig> get_tables_for_checking(Operation operat
     }
 }
 
-void check(mdbx::txn& txn, Operation operation) {
-    auto [source_config, target_config] = get_tables_for_checking(operation);
-    auto source_table{db::open_cursor(txn, source_config)};
-    auto target_table{db::open_cursor(txn, target_config)};
-    auto data{source_table.to_first(/*throw_notfound*/ false)};
-
-    while (data) { /* Loop as long as we have no errors*/
-        Bytes mdb_key_as_bytes{db::from_slice(data.key)};
-
-        if (operation == HashAccount) {
-            // Account
-            if (data.key.length() != kAddressLength) {
-                data = source_table.to_next(false);
-                continue;
-            }
-            auto hash{keccak256(mdb_key_as_bytes)};
-            ByteView key{hash.bytes};
-
-            auto actual_value{target_table.find(db::to_slice(key))};
-            if (!actual_value) {
-                log::Error() << "key: " << to_hex(key) << ", does not exist.";
-                return;
-            }
-            if (actual_value.value != data.value) {
-                log::Error() << "Expected: " << to_hex(db::from_slice(data.value)) << ", Actual: << "
-                             << to_hex(db::from_slice(actual_value.value));
-                return;
-            }
-            data = source_table.to_next(false);
+// Source records in between two progress lines
+static constexpr uint64_t kProgressInterval{10'000'000};
 
-        } else if (operation == HashStorage) {
-            // Storage
-            if (data.key.length() != kAddressLength) {
-                data = source_table.to_next(false);
-                continue;
+//! \brief Checks each record of the source table of operation has its hashed counterpart, on parallel read-only
+//! transactions each walking a range of the source table
+//! \return Whether no mismatch has been found
+//! \remarks All ranges stop at the first mismatch
+bool check(mdbx::env env, Operation operation, size_t num_partitions) {
+    auto [source_config, target_config] = get_tables_for_checking(operation);
+    std::atomic_bool failed{false};
+    std::atomic<uint64_t> records{0};
+    const char* source_name{source_config.name};
+
+    const db::PartitionWalkerFactory make_walker{[&, target_config = target_config](mdbx::txn& txn) -> db::WalkFunc {
+        auto target_table{std::make_shared<db::Cursor>(txn, target_config)};
+        return [&failed, &records, source_name, operation, target_table](mdbx::cursor&,
+                                                                          mdbx::cursor::move_result& data) -> bool {
+            if (const auto count{++records}; count % kProgressInterval == 0) {
+                log::Info() << "Checked " << count << " records of " << source_name;
             }
-
-            Bytes key(kHashLength * 2 + db::kIncarnationLength, '\0');
-            std::memcpy(&key[0], keccak256(mdb_key_as_bytes.substr(0, kAddressLength)).bytes, kHashLength);
-            std::memcpy(&key[kHashLength], &mdb_key_as_bytes[kAddressLength], db::kIncarnationLength);
-            std::memcpy(&key[kHashLength + db::kIncarnationLength],
-                        keccak256(mdb_key_as_bytes.substr(kAddressLength + db::kIncarnationLength)).bytes, kHashLength);
-
-            auto target_data{target_table.find_multivalue(db::to_slice(key), data.value, /*throw_notfound*/ false)};
-            if (!target_data) {
-                log::Error() << "Key: " << to_hex(key) << ", does not exist.";
-                return;
+            Bytes mdb_key_as_bytes{db::from_slice(data.key)};
+
+            if (operation == HashAccount) {
+                // Account
+                if (data.key.length() != kAddressLength) {
+                    return !failed;
+                }
+                auto hash{keccak256(mdb_key_as_bytes)};
+                ByteView key{hash.bytes};
+
+                auto actual_value{target_table->find(db::to_slice(key), /*throw_notfound*/ false)};
+                if (!actual_value) {
+                    log::Error() << "key: " << to_hex(key) << ", does not exist.";
+                    failed = true;
+                } else if (actual_value.value != data.value) {
+                    log::Error() << "Expected: " << to_hex(db::from_slice(data.value)) << ", Actual: << "
+                                 << to_hex(db::from_slice(actual_value.value));
+                    failed = true;
+                }
+
+            } else if (operation == HashStorage) {
+                // Storage
+                if (data.key.length() != kAddressLength) {
+                    return !failed;
+                }
+
+                Bytes key(kHashLength * 2 + db::kIncarnationLength, '\0');
+                std::memcpy(&key[0], keccak256(mdb_key_as_bytes.substr(0, kAddressLength)).bytes, kHashLength);
+                std::memcpy(&key[kHashLength], &mdb_key_as_bytes[kAddressLength], db::kIncarnationLength);
+                std::memcpy(&key[kHashLength + db::kIncarnationLength],
+                            keccak256(mdb_key_as_bytes.substr(kAddressLength + db::kIncarnationLength)).bytes,
+                            kHashLength);
+
+                auto target_data{
+                    target_table->find_multivalue(db::to_slice(key), data.value, /*throw_notfound*/ false)};
+                if (!target_data) {
+                    log::Error() << "Key: " << to_hex(key) << ", does not exist.";
+                    failed = true;
+                }
+
+            } else {
+                // Code
+                if (data.key.length() != kAddressLength + db::kIncarnationLength) {
+                    return !failed;
+                }
+                Bytes key(kHashLength + db::kIncarnationLength, '\0');
+                std::memcpy(&key[0], keccak256(mdb_key_as_bytes.substr(0, kAddressLength)).bytes, kHashLength);
+                std::memcpy(&key[kHashLength], &mdb_key_as_bytes[kAddressLength], db::kIncarnationLength);
+                auto actual_value{target_table->find(db::to_slice(key), /*throw_notfound*/ false)};
+                if (!actual_value) {
+                    log::Error() << "Key: " << to_hex(key) << ", does not exist.";
+                    failed = true;
+                } else if (actual_value.value != data.value) {
+                    log::Error() << "Expected: " << to_hex(db::from_slice(data.value)) << ", Actual: << "
+                                 << to_hex(db::from_slice(actual_value.value));
+                    failed = true;
+                }
             }
-            data = source_table.to_next(false);
+            return !failed;
+        };
+    }};
 
-        } else {
-            // Code
-            if (data.key.length() != kAddressLength + db::kIncarnationLength) {
-                data = source_table.to_next(false);
-                continue;
-            }
-            Bytes key(kHashLength + db::kIncarnationLength, '\0');
-            std::memcpy(&key[0], keccak256(mdb_key_as_bytes.substr(0, kAddressLength)).bytes, kHashLength);
-            std::memcpy(&key[kHashLength], &mdb_key_as_bytes[kAddressLength], db::kIncarnationLength);
-            auto actual_value{target_table.find(db::to_slice(key), /*throw_notfound*/ false)};
-            if (!actual_value) {
-                log::Error() << "Key: " << to_hex(key) << ", does not exist.";
-                data = source_table.to_next(false);
-                continue;
-            }
-            if (actual_value.value != data.value) {
-                log::Error() << "Expected: " << to_hex(db::from_slice(data.value)) << ", Actual: << "
-                             << to_hex(db::from_slice(actual_value.value));
-                return;
-            }
-            data = source_table.to_next(false);
-        }
-    }
+    (void)db::parallel_for_each(env, source_config, num_partitions, make_walker);
+    log::Info() << "Checked " << records << " records of " << source_name;
+    return !failed;
 }
 
 int main(int argc, char* argv[]) {
@@ -129,6 +145,11 @@ int main(int argc, char* argv[]) {
     app.add_option("--chaindata", chaindata, "Path to a database populated by Erigon")
         ->capture_default_str()
         ->check(CLI::ExistingDirectory);
+
+    size_t threads{std::thread::hardware_concurrency()};
+    app.add_option("--threads", threads, "Number of threads each checking a range of the source table")
+        ->capture_default_str()
+        ->check(CLI::Range(size_t{1}, size_t{256}));
     CLI11_PARSE(app, argc, argv);
     log::Info() << "Checking HashState";
 
@@ -136,16 +157,20 @@ int main(int argc, char* argv[]) {
         auto data_dir{DataDirectory::from_chaindata(chaindata)};
         data_dir.deploy();
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
+        db_config.readonly = true;
         auto env{db::open_env(db_config)};
-        auto txn{env.start_write()};
 
+        bool ok{true};
         log::Info() << "Checking Accounts";
-        check(txn, HashAccount);
+        ok &= check(env, HashAccount, threads);
         log::Info() << "Checking Storage";
-        check(txn, HashStorage);
+        ok &= check(env, HashStorage, threads);
         log::Info() << "Checking Code Keys";
-        check(txn, Code);
+        ok &= check(env, Code, threads);
         log::Info() << "All Done!";
+        if (!ok) {
+            return -1;
+        }
     } catch (const std::exception& ex) {
         log::Error() << ex.what();
         return -5;
@@ -14,8 +14,11 @@
    limitations under the License.
 */
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 #include <ethash/ethash.hpp>
@@ -26,6 +29,8 @@
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
+#include <silkworm/consensus/ethash/engine.hpp>
+#include <silkworm/consensus/ethash/epoch_context_cache.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
 
@@ -33,12 +38,16 @@ namespace fs = std::filesystem;
 using namespace silkworm;
 
 struct app_options_t {
-    std::string datadir{};          // Provided database path
-    uint32_t block_from{1u};        // Initial block number to start from
-    uint32_t block_to{UINT32_MAX};  // Final block number to process
-    bool debug{false};              // Whether to display some debug info
+    std::string datadir{};                                      // Provided database path
+    uint32_t block_from{1u};                                    // Initial block number to start from
+    uint32_t block_to{UINT32_MAX};                              // Final block number to process
+    uint32_t num_threads{std::thread::hardware_concurrency()};  // Threads verifying the seals
+    bool debug{false};                                          // Whether to display some debug info
 };
 
+// Blocks whose seals are verified together, well below an epoch so that a batch spans at most two of them
+static constexpr uint32_t kBatchSize{4096};
+
 int main(int argc, char* argv[]) {
     // Init command line parser
     CLI::App app("Check PoW.");
@@ -57,6 +66,10 @@ int main(int argc, char* argv[]) {
         ->capture_default_str()
         ->check(CLI::Range(1u, UINT32_MAX));
 
+    app.add_option("--threads", options.num_threads, "Number of threads verifying the seals")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 1024u));
+
     app.add_flag("--debug", options.debug, "May print some debug/trace info.");
 
     CLI11_PARSE(app, argc, argv);
@@ -92,62 +105,65 @@ int main(int argc, char* argv[]) {
         auto max_headers_height{db::stages::read_stage_progress(txn, db::stages::kSendersKey)};
         options.block_to = std::min(options.block_to, static_cast<uint32_t>(max_headers_height));
 
-        // Initialize epoch
-        auto epoch_num{options.block_from / ethash::epoch_length};
-        log::Info() << "Initializing Light Cache for DAG epoch " << epoch_num;
-        auto epoch_context{ethash::create_epoch_context(static_cast<int>(epoch_num))};
+        consensus::EthashEngine engine{*config};
+        auto& epoch_context_cache{consensus::EpochContextCache::instance()};
 
         auto canonical_hashes{db::open_cursor(txn, db::table::kCanonicalHashes)};
 
-        // Loop blocks
+        // Loop batches of blocks, each batch spans at most two epochs
         StopWatch sw;
         sw.start();
-        for (uint32_t block_num{options.block_from}; block_num <= options.block_to && !SignalHandler::signalled();
-             block_num++) {
-            if (epoch_context->epoch_number != static_cast<int>(block_num / ethash::epoch_length)) {
-                epoch_num = (block_num / ethash::epoch_length);
-                log::Info() << "Initializing Light Cache for DAG epoch " << epoch_num;
-                epoch_context = ethash::create_epoch_context(static_cast<int>(epoch_num));
-            }
-
-            auto block_key{db::block_key(block_num)};
-            auto data{canonical_hashes.find(db::to_slice(block_key), /*throw_notfound*/ false)};
-            if (!data) {
-                throw std::runtime_error("Can't retrieve canonical hash for block " + std::to_string(block_num));
-            }
-
-            auto header_key{to_bytes32(db::from_slice(data.value))};
-            auto header{db::read_header(txn, block_num, header_key.bytes)};
-            if (!header.has_value()) {
-                throw std::runtime_error("Can't retrieve header for block " + std::to_string(block_num));
+        std::vector<BlockHeader> headers;
+        std::vector<const BlockHeader*> header_ptrs;
+        for (uint32_t batch_from{options.block_from}; batch_from <= options.block_to && !SignalHandler::signalled();
+             batch_from += kBatchSize) {
+            const uint32_t batch_to{std::min(options.block_to, batch_from + (kBatchSize - 1))};
+            headers.clear();
+            for (uint32_t block_num{batch_from}; block_num <= batch_to; block_num++) {
+                auto block_key{db::block_key(block_num)};
+                auto data{canonical_hashes.find(db::to_slice(block_key), /*throw_notfound*/ false)};
+                if (!data) {
+                    throw std::runtime_error("Can't retrieve canonical hash for block " + std::to_string(block_num));
+                }
+
+                auto header_key{to_bytes32(db::from_slice(data.value))};
+                auto header{db::read_header(txn, block_num, header_key.bytes)};
+                if (!header.has_value()) {
+                    throw std::runtime_error("Can't retrieve header for block " + std::to_string(block_num));
+                }
+                headers.push_back(std::move(*header));
             }
+            header_ptrs.clear();
+            for (const auto& header : headers) header_ptrs.push_back(&header);
 
             // Verify Proof of Work
-            uint64_t nonce{endian::load_big_u64(header->nonce.data())};
-
-            auto seal_hash(header->hash(/*for_sealing =*/true));
-            const auto diff256{intx::be::store<ethash::hash256>(header->difficulty)};
-            const auto sealh256{ethash::hash256_from_bytes(seal_hash.bytes)};
-            const auto mixh256{ethash::hash256_from_bytes(header->mix_hash.bytes)};
-            if (const auto ec = ethash::verify_against_difficulty(*epoch_context, sealh256, mixh256, nonce, diff256);
-                ec) {
-                auto boundary256{header->boundary()};
+            const auto results{engine.validate_seals(header_ptrs, options.num_threads)};
+            const auto failed{std::find_if(results.begin(), results.end(),
+                                           [](ValidationResult r) { return r != ValidationResult::kOk; })};
+            if (failed != results.end()) {
+                const BlockHeader& header{headers[static_cast<size_t>(failed - results.begin())]};
+                const auto epoch_context{epoch_context_cache.get_for_block(header.number)};
+                uint64_t nonce{endian::load_big_u64(header.nonce.data())};
+                auto seal_hash(header.hash(/*for_sealing =*/true));
+                const auto diff256{intx::be::store<ethash::hash256>(header.difficulty)};
+                const auto sealh256{ethash::hash256_from_bytes(seal_hash.bytes)};
+                const auto mixh256{ethash::hash256_from_bytes(header.mix_hash.bytes)};
+                const auto ec{ethash::verify_against_difficulty(*epoch_context, sealh256, mixh256, nonce, diff256)};
+                auto boundary256{header.boundary()};
                 auto result{ethash::hash(*epoch_context, sealh256, nonce)};
                 auto b{to_bytes32({boundary256.bytes, 32})};
                 auto f{to_bytes32({result.final_hash.bytes, 32})};
                 auto m{to_bytes32({result.mix_hash.bytes, 32})};
 
-                std::cout << "\n Pow Verification error on block " << block_num << " : \n"
+                std::cout << "\n Pow Verification error on block " << header.number << " : \n"
                           << "Error: " << ec << "\n"
                           << "Final hash " << to_hex(f) << " expected below " << to_hex(b) << "\n"
                           << "Mix   hash " << to_hex(m) << " expected mix " << to_hex(m) << std::endl;
                 break;
             }
 
-            if (!(block_num % 1000)) {
-                const auto interval{sw.lap()};
-                log::Info() << "At block height " << block_num << " in " << sw.format(interval.second);
-            }
+            const auto interval{sw.lap()};
+            log::Info() << "At block height " << batch_to << " in " << sw.format(interval.second);
         }
 
         log::Info() << "Complete !";
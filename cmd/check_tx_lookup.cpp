@@ -14,7 +14,11 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <limits>
+#include <thread>
 
 #include <CLI/CLI.hpp>
 
@@ -25,112 +29,141 @@
 #include <silkworm/common/util.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
 #include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
-#include <silkworm/etl/collector.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 using namespace silkworm;
 
-int main(int argc, char* argv[]) {
-    SignalHandler::init();
+// Ranges much smaller than the whole block span: later blocks are far denser in transactions than early ones
+static constexpr size_t kRangesPerThread{16};
 
-    namespace fs = std::filesystem;
+// Blocks in between two progress lines
+static constexpr uint64_t kProgressInterval{100'000};
 
-    CLI::App app{"Check Tx Hashes => BlockNumber mapping in database"};
-
-    std::string chaindata{DataDirectory{}.chaindata().path().string()};
-    size_t block_from;
-    app.add_option("--chaindata", chaindata, "Path to a database populated by Erigon")
-        ->capture_default_str()
-        ->check(CLI::ExistingDirectory);
-    app.add_option("--from", block_from, "Initial block number to process (inclusive)")
-        ->capture_default_str()
-        ->check(CLI::Range(1u, UINT32_MAX));
+struct CheckProgress {
+    bool keep_going{false};               // Whether to go on after the first mismatch
+    std::atomic<uint64_t> blocks{0};      // Blocks checked so far
+    std::atomic<uint64_t> mismatches{0};  // Mismatches found so far
 
-    CLI11_PARSE(app, argc, argv);
-
-    auto data_dir{DataDirectory::from_chaindata(chaindata)};
-    data_dir.deploy();
-    db::EnvConfig db_config{data_dir.chaindata().path().string()};
-    etl::Collector collector(data_dir.etl().path().string().c_str(), /* flush size */ 512 * kMebi);
-
-    auto env{db::open_env(db_config)};
-    auto txn{env.start_read()};
+    [[nodiscard]] bool stopping() const { return (mismatches && !keep_going) || SignalHandler::signalled(); }
+};
 
+//! \brief Checks the transactions of blocks [from, to] are all mapped to their block in TxLookup
+static void check_tx_lookup(mdbx::txn& txn, BlockNum from, BlockNum to, CheckProgress& progress) {
     auto bodies_table{db::open_cursor(txn, db::table::kBlockBodies)};
     auto tx_lookup_table{db::open_cursor(txn, db::table::kTxLookup)};
     auto transactions_table{db::open_cursor(txn, db::table::kBlockTransactions)};
-
-    uint64_t expected_block_number{0};
-    Bytes buffer{};  // To extract compacted data
-
-    try {
-        log::Info() << "Checking Transaction Lookups...";
-
-        auto bodies_data{bodies_table.to_first(false)};
-        while (bodies_data) {
-            auto block_number(endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.data())));
-            auto body_rlp{db::from_slice(bodies_data.value)};
-            auto body{db::detail::decode_stored_block_body(body_rlp)};
-
-            if (body.txn_count > 0) {
-                Bytes transaction_key(8, '\0');
-                endian::store_big_u64(transaction_key.data(), body.base_txn_id);
-
-                uint64_t i{0};
-                auto transaction_data{transactions_table.find(db::to_slice(transaction_key), false)};
-                for (; i < body.txn_count && transaction_data.done;
-                     i++, transaction_data = transactions_table.to_next(false)) {
-                    if (!transaction_data) {
-                        log::Error() << "Block " << block_number << " transaction " << i << " not found in "
-                                     << db::table::kBlockTransactions.name << " table";
-                        continue;
-                    }
-
-                    ByteView transaction_rlp{db::from_slice(transaction_data.value)};
-                    auto transaction_hash{keccak256(transaction_rlp)};
-                    ByteView transaction_view{transaction_hash.bytes};
-                    auto lookup_data{tx_lookup_table.find(db::to_slice(transaction_view), false)};
-                    if (!lookup_data) {
-                        log::Error() << "Block " << block_number << " transaction " << i << " with hash "
-                                     << to_hex(transaction_view) << " not found in " << db::table::kTxLookup.name
-                                     << " table";
-                        continue;
-                    }
-
-                    // Erigon stores block height as compact (no leading zeroes)
-                    auto lookup_block_value{db::from_slice(lookup_data.value)};
-                    uint64_t actual_block_number{0};
-                    if (endian::from_big_compact(lookup_block_value, actual_block_number) != DecodingResult::kOk) {
-                        log::Error() << "Failed to read expected block number from: " << to_hex(lookup_block_value);
-                    } else if (actual_block_number != expected_block_number) {
-                        log::Error() << "Mismatch: Expected block number for tx with hash: " << to_hex(transaction_view)
-                                     << " is " << expected_block_number << ", but got: " << actual_block_number;
-                    }
+    TransactionView tx_view;
+
+    const auto mismatch{[&progress](const std::string& message) {
+        log::Error() << message;
+        ++progress.mismatches;
+    }};
+
+    auto bodies_data{bodies_table.lower_bound(db::to_slice(db::block_key(from)), /*throw_notfound=*/false)};
+    for (; bodies_data && !progress.stopping(); bodies_data = bodies_table.to_next(/*throw_notfound=*/false)) {
+        const BlockNum block_number{endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.data()))};
+        if (block_number > to) {
+            break;
+        }
+        auto body_rlp{db::from_slice(bodies_data.value)};
+        auto body{db::detail::decode_stored_block_body(body_rlp)};
+
+        if (body.txn_count > 0) {
+            Bytes transaction_key(8, '\0');
+            endian::store_big_u64(transaction_key.data(), body.base_txn_id);
+
+            uint64_t i{0};
+            auto transaction_data{transactions_table.find(db::to_slice(transaction_key), /*throw_notfound=*/false)};
+            for (; i < body.txn_count && transaction_data.done;
+                 i++, transaction_data = transactions_table.to_next(/*throw_notfound=*/false)) {
+                ByteView transaction_rlp{db::from_slice(transaction_data.value)};
+                if (tx_view.parse(transaction_rlp) != DecodingResult::kOk) {
+                    mismatch("Block " + std::to_string(block_number) + " transaction " + std::to_string(i) +
+                             " can't be decoded");
+                    continue;
+                }
+                const auto transaction_hash{tx_view.hash()};
+                ByteView transaction_view{transaction_hash.bytes};
+                auto lookup_data{tx_lookup_table.find(db::to_slice(transaction_view), /*throw_notfound=*/false)};
+                if (!lookup_data) {
+                    mismatch("Block " + std::to_string(block_number) + " transaction " + std::to_string(i) +
+                             " with hash " + to_hex(transaction_view) + " not found in " +
+                             db::table::kTxLookup.name + " table");
+                    continue;
                 }
 
-                if (i != body.txn_count) {
-                    log::Error() << "Block " << block_number << " claims " << body.txn_count
-                                 << " transactions but only " << i << " read";
+                // Erigon stores block height as compact (no leading zeroes)
+                auto lookup_block_value{db::from_slice(lookup_data.value)};
+                uint64_t actual_block_number{0};
+                if (endian::from_big_compact(lookup_block_value, actual_block_number) != DecodingResult::kOk) {
+                    mismatch("Failed to read expected block number from: " + to_hex(lookup_block_value));
+                } else if (actual_block_number != block_number) {
+                    mismatch("Mismatch: Expected block number for tx with hash: " + to_hex(transaction_view) +
+                             " is " + std::to_string(block_number) + ", but got: " +
+                             std::to_string(actual_block_number));
                 }
             }
 
-            if (expected_block_number % 100000 == 0) {
-                log::Info() << "Scanned blocks " << expected_block_number;
+            if (i != body.txn_count) {
+                mismatch("Block " + std::to_string(block_number) + " claims " + std::to_string(body.txn_count) +
+                         " transactions but only " + std::to_string(i) + " read");
             }
+        }
 
-            if (SignalHandler::signalled()) {
-                break;
-            }
+        if (const auto blocks{++progress.blocks}; blocks % kProgressInterval == 0) {
+            log::Info() << "Scanned blocks " << blocks;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    SignalHandler::init();
+
+    CLI::App app{"Check Tx Hashes => BlockNumber mapping in database"};
+
+    std::string chaindata{DataDirectory{}.chaindata().path().string()};
+    BlockNum block_from{0};
+    BlockNum block_to{std::numeric_limits<BlockNum>::max()};
+    size_t threads{std::thread::hardware_concurrency()};
+    CheckProgress progress;
+    app.add_option("--chaindata", chaindata, "Path to a database populated by Erigon")
+        ->capture_default_str()
+        ->check(CLI::ExistingDirectory);
+    app.add_option("--from", block_from, "Initial block number to process (inclusive)")->capture_default_str();
+    app.add_option("--to", block_to, "Final block number to process (inclusive, defaults to TxLookup progress)");
+    app.add_option("--threads", threads, "Number of threads each checking ranges of blocks")
+        ->capture_default_str()
+        ->check(CLI::Range(size_t{1}, size_t{256}));
+    app.add_flag("--keep-going", progress.keep_going, "Report all mismatches instead of stopping at the first one");
 
-            expected_block_number++;
-            bodies_data = bodies_table.to_next(false);
+    CLI11_PARSE(app, argc, argv);
+
+    try {
+        auto data_dir{DataDirectory::from_chaindata(chaindata)};
+        data_dir.deploy();
+        db::EnvConfig db_config{data_dir.chaindata().path().string()};
+        db_config.readonly = true;
+        auto env{db::open_env(db_config)};
+
+        if (block_to == std::numeric_limits<BlockNum>::max()) {
+            auto txn{env.start_read()};
+            block_to = db::stages::read_stage_progress(txn, db::stages::kTxLookupKey);
         }
 
-        log::Info() << "Check " << (SignalHandler::signalled() ? "aborted" : "completed");
+        log::Info() << "Checking Transaction Lookups of blocks " << block_from << ".." << block_to << "...";
+        db::parallel_for_block_ranges(env, block_from, block_to, threads, kRangesPerThread,
+                                      [&](size_t, mdbx::txn& txn, BlockNum from, BlockNum to) {
+                                          check_tx_lookup(txn, from, to, progress);
+                                      });
+
+        log::Info() << "Check " << (SignalHandler::signalled() ? "aborted" : "completed") << ", "
+                    << progress.blocks << " blocks scanned, " << progress.mismatches << " mismatches";
 
     } catch (const std::exception& ex) {
         log::Error() << ex.what();
         return -5;
     }
-    return 0;
+    return progress.mismatches ? -1 : 0;
 }
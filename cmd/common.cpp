@@ -16,14 +16,18 @@
 
 #include "common.hpp"
 
+#include <bit>
 #include <regex>
 
 #include <boost/asio/ip/address.hpp>
 
 #include <silkworm/chain/genesis.hpp>
+#include <silkworm/common/memory_governor.hpp>
+#include <silkworm/concurrency/affinity.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/genesis.hpp>
 #include <silkworm/db/stages.hpp>
+#include <silkworm/etl/memory_arbiter.hpp>
 
 namespace silkworm::cmd {
 
@@ -102,6 +106,7 @@ void add_logging_options(CLI::App& cli, log::Settings& log_settings) {
     log_opts.add_flag("--log.utc", log_settings.log_utc, "Prints log timings in UTC");
     log_opts.add_flag("--log.threads", log_settings.log_threads, "Prints thread ids");
     log_opts.add_option("--log.file", log_settings.log_file, "Tee all log lines to given file name");
+    log_opts.add_flag("--log.async", log_settings.log_async, "Writes log lines from a background thread");
 }
 
 void add_option_data_dir(CLI::App& cli, std::filesystem::path& data_dir) {
@@ -117,7 +122,7 @@ void add_option_wait_mode(CLI::App& cli, silkworm::rpc::WaitMode& wait_mode) {
     cli.add_option("--wait.mode", wait_mode, "The waiting mode for execution loops during idle cycles")
         ->capture_default_str()
         ->check(CLI::Range(static_cast<uint32_t>(silkworm::rpc::WaitMode::blocking),
-                           static_cast<uint32_t>(silkworm::rpc::WaitMode::busy_spin)))
+                           static_cast<uint32_t>(silkworm::rpc::WaitMode::adaptive)))
         ->default_val(std::to_string(static_cast<uint32_t>(silkworm::rpc::WaitMode::blocking)));
 }
 
@@ -127,8 +132,16 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
     std::filesystem::path data_dir_path;
     std::string chaindata_max_size{human_size(node_settings.chaindata_env_config.max_size)};
     std::string chaindata_growth_size{human_size(node_settings.chaindata_env_config.growth_size)};
+    std::string chaindata_page_size{human_size(node_settings.chaindata_env_config.page_size)};
+    std::string chaindata_headroom_size{human_size(8 * node_settings.chaindata_env_config.growth_size)};
     std::string batch_size{human_size(node_settings.batch_size)};
     std::string etl_buffer_size{human_size(node_settings.etl_buffer_size)};
+    std::string etl_memory_budget{human_size(node_settings.etl_memory_budget)};
+    std::vector<std::string> etl_extra_dirs;
+    std::string commit_dirty_size{human_size(node_settings.commit_policy.dirty_size)};
+    std::string memory_budget{human_size(node_settings.memory_budget)};
+    uint32_t commit_interval_seconds{0};
+    uint32_t sync_interval_seconds{0};
     add_option_data_dir(cli, data_dir_path);
     cli.add_flag("--chaindata.exclusive", node_settings.chaindata_env_config.exclusive,
                  "Chaindata database opened in exclusive mode");
@@ -136,18 +149,49 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
                  "Chaindata database enable readahead");
     cli.add_flag("--chaindata.writemap", node_settings.chaindata_env_config.write_map,
                  "Chaindata database enable writemap");
+    cli.add_flag("--chaindata.ephemeral", node_settings.chaindata_env_config.ephemeral,
+                 "Chaindata database is throwaway (devnets, CI): writemap, never synced and map capped to RAM size\n"
+                 "Best with --datadir on tmpfs. A system crash may corrupt it");
     cli.add_option("--chaindata.growthsize", chaindata_growth_size, "Chaindata database growth size")
         ->capture_default_str()
         ->check(HumanSizeParserValidator("64MB"));
     cli.add_option("--chaindata.maxsize", chaindata_max_size, "Chaindata database max size")
         ->capture_default_str()
         ->check(HumanSizeParserValidator("64MB", {"4TB"}));
-    cli.add_option("--batchsize", batch_size, "Batch size for stage execution")
+    cli.add_option("--chaindata.pagesize", chaindata_page_size,
+                   "Chaindata database page size (power of 2), only applied to a new database\n"
+                   "See toolbox geometry for advice")
         ->capture_default_str()
-        ->check(HumanSizeParserValidator("64MB", {"16GB"}));
+        ->check(HumanSizeParserValidator("256B", {"64KB"}));
+    cli.add_option("--chaindata.headroom", chaindata_headroom_size,
+                   "Free space chaindata database is grown to before each sync cycle (0 = off)\n"
+                   "Few large extensions spare the stalls of many growth steps")
+        ->capture_default_str()
+        ->check(HumanSizeParserValidator("0B", {"1TB"}));
+    cli.add_option("--batchsize", batch_size,
+                   "Batch size for stage execution: max memory of its buffers (capped to half of physical memory)")
+        ->capture_default_str()
+        ->check(HumanSizeParserValidator("64MB", {"128GB"}));
     cli.add_option("--etl.buffersize", etl_buffer_size, "Buffer size for ETL operations")
         ->capture_default_str()
         ->check(HumanSizeParserValidator("64MB", {"1GB"}));
+    const std::map<std::string, etl::Compression> etl_compression_map{{"none", etl::Compression::kNone},
+                                                                      {"lz4", etl::Compression::kLz4}};
+    cli.add_option("--etl.compression", node_settings.etl_compression,
+                   "Compression of ETL temporary files (none, lz4)\n"
+                   "Trades some CPU for much less temporary disk space and I/O")
+        ->transform(CLI::CheckedTransformer(etl_compression_map, CLI::ignore_case))
+        ->default_str("none");
+    cli.add_option("--etl.memory.budget", etl_memory_budget,
+                   "Memory shared by the buffers of all ETL collectors alive at once (0 = the ETL share of\n"
+                   "--memory.budget, if any). Each collector gets an even share and the largest flushes early\n"
+                   "under pressure, so that stages may run concurrently within a fixed budget")
+        ->capture_default_str()
+        ->check(HumanSizeParserValidator("0B", {"1TB"}));
+    cli.add_option("--etl.dirs", etl_extra_dirs,
+                   "More directories ETL temporary files are striped across, besides the one in the data directory\n"
+                   "Best placed on distinct devices: flushes and loads then spread their I/O over all of them")
+        ->check(CLI::ExistingDirectory);
     cli.add_option("--private.api.addr", node_settings.private_api_addr,
                    "Private API network address to serve remote database interface\n"
                    "An empty string means to not start the listener\n"
@@ -169,6 +213,114 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
         ->capture_default_str()
         ->check(CLI::Range(5u, 600u));
 
+    cli.add_option("--sync.loop.tip.latency", node_settings.sync_loop_tip_latency_ms,
+                   "Keeps following the chain tip, running a cycle as soon as new headers are available\n"
+                   "New headers are coalesced for at most this many milliseconds, depending on the observed\n"
+                   "commit cost (0 = off)")
+        ->capture_default_str()
+        ->check(CLI::Range(0u, 60'000u));
+
+    auto& commit_opts = *cli.add_option_group("Commit", "Options on when stages commit their writes");
+    commit_opts
+        .add_option("--commit.dirty.size", commit_dirty_size,
+                    "Stages commit once their writes reach this size (0 = on each stage commit point)")
+        ->capture_default_str()
+        ->check(HumanSizeParserValidator("0B", {"1TB"}));
+    commit_opts
+        .add_option("--commit.interval", commit_interval_seconds,
+                    "Stages commit once this many seconds have passed since previous commit (0 = on each stage commit "
+                    "point)")
+        ->capture_default_str();
+    commit_opts.add_flag("--commit.cycle.end", node_settings.commit_policy.forced_only,
+                         "Stages commit only at the end of each cycle (or when a later stage needs to read their data "
+                         "concurrently)");
+    commit_opts.add_flag("--commit.nosync", node_settings.commit_policy.safe_nosync,
+                         "Commits are not flushed to disk (MDBX_SAFE_NOSYNC) but periodically and at the end of each "
+                         "cycle\nA system crash may lose (not corrupt) the most recent commits");
+    commit_opts
+        .add_option("--commit.sync.interval", sync_interval_seconds,
+                    "With --commit.nosync, flushes commits to disk once this many seconds have passed since "
+                    "previous flush (0 = at cycle end only)")
+        ->capture_default_str();
+
+    cli.add_option("--sync.loop.metrics.file", node_settings.sync_loop_metrics_file,
+                   "Path to a file the sync loop rewrites with per stage metrics after each cycle\n"
+                   "(the downloader rewrites it with download metrics every 10 seconds)\n"
+                   "Prometheus text exposition format, e.g. for the node_exporter textfile collector (empty = off)")
+        ->capture_default_str();
+
+    cli.add_option("--preverified.hashes.file", node_settings.preverified_hashes_file,
+                   "Path to a binary file of pre-verified header hashes (see toolbox extract-headers --binary)\n"
+                   "It is memory-mapped and takes the place of the hashes compiled in, if any")
+        ->check(CLI::ExistingFile);
+
+    cli.add_option("--execution.profile.interval", node_settings.execution_profile_interval,
+                   "Profiles EVM execution sampling one instruction every N\n"
+                   "Top opcodes and contracts are reported along with Execution progress (0 = off)")
+        ->capture_default_str();
+
+    cli.add_option("--execution.precompile.cache", node_settings.precompile_cache_size,
+                   "Max number of expensive precompile results (ecrecover, modexp, pairing ...) memoized\n"
+                   "across blocks by Execution (0 = off)")
+        ->capture_default_str();
+
+    cli.add_flag("--execution.state.root", node_settings.execution_state_root,
+                 "Maintains the state trie in memory and verifies the state root of each block while executing\n"
+                 "The whole state is loaded on start: for small chains only");
+
+    cli.add_option("--execution.state.filter", node_settings.execution_state_filter_bits,
+                   "Bits per key of an in-memory Bloom filter over PlainState keys, sparing Execution the db reads\n"
+                   "of absent accounts and storage. Built on start by a full PlainState walk (0 = off)")
+        ->capture_default_str()
+        ->check(CLI::Range(0u, 32u));
+
+    cli.add_option("--execution.state.cache", node_settings.execution_state_cache_size,
+                   "Max number of accounts, and of storage slots, kept in memory by Execution across batches\n"
+                   "along with recently used code, so that hot contracts are not read again from db (0 = off)")
+        ->capture_default_str();
+
+    cli.add_option("--execution.import.chaindata", node_settings.execution_import_chaindata,
+                   "Path to a trusted database Execution imports the state from, instead of executing blocks\n"
+                   "up to --execution.import.height. It must retain all change sets after that height")
+        ->check(CLI::ExistingDirectory);
+    cli.add_option("--execution.import.height", node_settings.execution_import_height,
+                   "Block whose state is imported from --execution.import.chaindata (e.g. a preverified one)\n"
+                   "Applies to an empty db only: blocks after it are executed as usual")
+        ->capture_default_str();
+    cli.add_option("--execution.import.snapshot", node_settings.execution_import_snapshot,
+                   "Path to a state snapshot (see toolbox export-state) Execution imports, along with the hashed\n"
+                   "state and tries, instead of executing blocks up to the block it was taken at. Applies to an\n"
+                   "empty db only: blocks after it are executed as usual")
+        ->check(CLI::ExistingDirectory);
+
+    cli.add_option("--numa.node",
+                   "Pins stage threads to the CPUs of this NUMA node, so that the memory they touch (db pages,\n"
+                   "ETL buffers) is allocated on it too. Best paired with the node holding most of the page cache")
+        ->check(CLI::Range(0u, 1023u));
+    cli.add_option("--memory.budget", memory_budget,
+                   "Memory shared by Execution buffers, ETL buffers, db dirty pages and downloader links (0 = none)\n"
+                   "Each of them flushes or commits early when the others leave it short, so that the node\n"
+                   "does not outgrow the budget. Usage of each is exported along with stage metrics")
+        ->capture_default_str()
+        ->check(HumanSizeParserValidator("0B", {"4TB"}));
+    const std::map<std::string, HugePages> huge_pages_map{{"off", HugePages::kOff},
+                                                          {"transparent", HugePages::kTransparent},
+                                                          {"explicit", HugePages::kExplicit}};
+    cli.add_option("--huge.pages", node_settings.huge_pages,
+                   "Huge pages backing the db map, ETL buffers and in-memory state tables\n"
+                   "(off, transparent, explicit). Cuts TLB misses of random accesses. Explicit takes them from the\n"
+                   "pool reserved in /proc/sys/vm/nr_hugepages, falling back to transparent ones once exhausted")
+        ->transform(CLI::CheckedTransformer(huge_pages_map, CLI::ignore_case))
+        ->default_str("off");
+
+    cli.add_flag("--canonical.hashes.dense", node_settings.dense_canonical_hashes,
+                 "Keeps all canonical hashes in memory, indexed by block number (32 bytes per block, ~500MB for "
+                 "mainnet)\nCanonical hash lookups of any height then never touch the db");
+
+    cli.add_flag("--history.index.deltas", node_settings.history_index_deltas,
+                 "At chain tip, history index stages append changed blocks as small delta records instead of\n"
+                 "rewriting bitmap chunks, folding them into chunks once they pile up. Not readable by Erigon");
+
     cli.add_flag("--fakepow", node_settings.fake_pow, "Disables proof-of-work verification");
     // Chain options
     auto chains_map{get_known_chains_map()};
@@ -231,9 +383,20 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
     if (node_settings.chaindata_env_config.growth_size > node_settings.chaindata_env_config.max_size / 2) {
         throw std::invalid_argument("--chaindata.growthsize too wide");
     }
+    node_settings.chaindata_env_config.page_size = parse_size(chaindata_page_size).value();
+    if (!std::has_single_bit(node_settings.chaindata_env_config.page_size)) {
+        throw std::invalid_argument("--chaindata.pagesize is not a power of 2");
+    }
+    node_settings.chaindata_env_config.headroom_size = parse_size(chaindata_headroom_size).value();
 
     node_settings.batch_size = parse_size(batch_size).value();
     node_settings.etl_buffer_size = parse_size(etl_buffer_size).value();
+    node_settings.etl_memory_budget = parse_size(etl_memory_budget).value();
+    node_settings.etl_extra_paths.assign(etl_extra_dirs.begin(), etl_extra_dirs.end());
+    node_settings.commit_policy.dirty_size = parse_size(commit_dirty_size).value();
+    node_settings.commit_policy.interval = std::chrono::seconds(commit_interval_seconds);
+    node_settings.commit_policy.sync_interval = std::chrono::seconds(sync_interval_seconds);
+    node_settings.memory_budget = parse_size(memory_budget).value();
 
     // Parse prune mode
     db::PruneDistance olderHistory, olderReceipts, olderSenders, olderTxIndex, olderCallTraces;
@@ -255,6 +418,10 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
                              olderHistory, olderReceipts, olderSenders, olderTxIndex, olderCallTraces, beforeHistory,
                              beforeReceipts, beforeSenders, beforeTxIndex, beforeCallTraces);
 
+    if (cli["--numa.node"]->count()) {
+        node_settings.numa_node = cli["--numa.node"]->as<uint32_t>();
+    }
+
     // Set chain
     if (chain_opts_chain_name->count()) {
         node_settings.network_id = chain_opts_chain_name->as<uint32_t>();
@@ -262,6 +429,38 @@ void parse_silkworm_command_line(CLI::App& cli, int argc, char* argv[], log::Set
 }
 
 void run_preflight_checklist(NodeSettings& node_settings) {
+    // Pin this thread (hence the ones it spawns) and all workers to the requested NUMA node
+    if (node_settings.numa_node) {
+        const auto node{std::to_string(*node_settings.numa_node)};
+        auto cpus{numa_node_cpus(*node_settings.numa_node)};
+        if (cpus.empty()) {
+            throw std::runtime_error("Unable to detect CPUs of NUMA node " + node);
+        }
+        log::Message("NUMA placement", {"node", node, "cpus", std::to_string(cpus.size())});
+        set_threads_affinity(std::move(cpus));
+        if (!apply_thread_affinity()) {
+            throw std::runtime_error("Unable to pin threads to NUMA node " + node);
+        }
+    }
+
+    // Subsystems share the memory budget (if any) from now on
+    if (node_settings.memory_budget) {
+        MemoryGovernor::instance().set_budget(node_settings.memory_budget);
+        log::Message("Memory budget", {"size", human_size(node_settings.memory_budget)});
+    }
+    if (node_settings.etl_memory_budget) {
+        etl::MemoryArbiter::instance().set_budget(node_settings.etl_memory_budget);
+        log::Message("ETL memory budget", {"size", human_size(node_settings.etl_memory_budget)});
+    }
+
+    // Back large buffers allocated from now on (and the db map) with huge pages
+    if (node_settings.huge_pages != HugePages::kOff) {
+        set_huge_pages(node_settings.huge_pages);
+        node_settings.chaindata_env_config.huge_pages = true;
+        log::Message("Huge pages", {"mode", node_settings.huge_pages == HugePages::kExplicit ? "explicit"
+                                                                                           : "transparent"});
+    }
+
     node_settings.data_directory->deploy();                                  // Ensures all subdirs are present
     bool chaindata_exclusive{node_settings.chaindata_env_config.exclusive};  // Save setting
     {
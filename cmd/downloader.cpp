@@ -152,6 +152,9 @@ int main(int argc, char* argv[]) {
 
         // Database access
         Db db{node_settings.chaindata_env_config};
+        if (node_settings.dense_canonical_hashes) {
+            db.load_all_canonical_hashes();
+        }
 
         // Node current status
         HeaderRetrieval headers(Db::ReadOnlyAccess{db});
@@ -170,7 +173,9 @@ int main(int argc, char* argv[]) {
         auto stats_receiving = std::thread([&sentry]() { sentry.stats_receiving_loop(); });
 
         // BlockExchange - download headers and bodies from remote peers using the sentry
-        BlockExchange block_exchange{sentry, Db::ReadOnlyAccess{db}, chain_identity};
+        BlockExchange block_exchange{sentry, Db::ReadOnlyAccess{db}, chain_identity,
+                                     node_settings.preverified_hashes_file};
+        block_exchange.export_metrics_to(node_settings.sync_loop_metrics_file);  // same file as the stages metrics
         auto block_downloading = std::thread([&block_exchange]() { block_exchange.execution_loop(); });
 
         // Stage1 - Header downloader - example code
@@ -24,6 +24,7 @@
 
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/db/history_delta.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/stagedsync/stagedsync.hpp>
 
@@ -57,6 +58,7 @@ int main(int argc, char* argv[]) {
         if (full) {
             auto txn{env.start_write()};
             txn.clear_map(db::open_map(txn, index_config));
+            txn.clear_map(db::open_map(txn, db::history_delta_config(storage)));
             db::stages::write_stage_progress(txn, stage_key, 0);
             txn.commit();
         }
@@ -0,0 +1,362 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include <silkworm/chain/config.hpp>
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/common/stopwatch.hpp>
+#include <silkworm/consensus/engine.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/execution/processor.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+#include <silkworm/state/witness.hpp>
+
+using namespace silkworm;
+
+// Counters of a replay thread
+struct ReplayStats {
+    uint64_t blocks{0};
+    uint64_t txs{0};
+    uint64_t gas{0};
+    uint64_t errors{0};  // Blocks failing validation
+    StopWatch::Duration elapsed{0};
+    BaselineAnalysisCache::Stats analysis_cache{};
+    PrecompileCache::Stats precompile_cache{};
+
+    void merge(const ReplayStats& other) {
+        blocks += other.blocks;
+        txs += other.txs;
+        gas += other.gas;
+        errors += other.errors;
+        elapsed = std::max(elapsed, other.elapsed);  // Threads run concurrently
+        analysis_cache.hits += other.analysis_cache.hits;
+        analysis_cache.misses += other.analysis_cache.misses;
+        precompile_cache.hits += other.precompile_cache.hits;
+        precompile_cache.misses += other.precompile_cache.misses;
+    }
+};
+
+struct ReplaySettings {
+    BlockNum blocks_per_buffer{1'000};
+    size_t analysis_cache_size{5'000};
+    size_t precompile_cache_size{0};
+    std::filesystem::path witness_dir;  // Where block witnesses are written to, or read from when stateless
+};
+
+static std::string rate(double count, StopWatch::Duration elapsed) {
+    const auto seconds{std::chrono::duration<double>(elapsed).count()};
+    return seconds > 0 ? std::to_string(count / seconds) : "n/a";
+}
+
+static std::string hit_rate(uint64_t hits, uint64_t misses) {
+    return hits + misses ? std::to_string(100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses)) + "%"
+                         : "n/a";
+}
+
+static void log_stats(const std::string& title, const ReplayStats& stats) {
+    log::Info(title, {"blocks", std::to_string(stats.blocks), "txs", std::to_string(stats.txs), "errors",
+                      std::to_string(stats.errors), "elapsed", StopWatch::format(stats.elapsed), "Mgas/s",
+                      rate(static_cast<double>(stats.gas) / 1e6, stats.elapsed), "tx/s",
+                      rate(static_cast<double>(stats.txs), stats.elapsed),
+                      "analysis.hits", hit_rate(stats.analysis_cache.hits, stats.analysis_cache.misses),
+                      "precompile.hits", hit_rate(stats.precompile_cache.hits, stats.precompile_cache.misses)});
+}
+
+static std::filesystem::path witness_path(const std::filesystem::path& dir, BlockNum block_num) {
+    return dir / (std::to_string(block_num) + ".witness");
+}
+
+static void write_witness(const std::filesystem::path& dir, const BlockWitness& witness) {
+    const Bytes content{witness.encode()};
+    const auto path{witness_path(dir, witness.block.header.number)};
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file.write(byte_ptr_cast(content.data()), static_cast<std::streamsize>(content.size())) || !file.flush()) {
+        throw std::runtime_error("Unable to write " + path.string());
+    }
+}
+
+static BlockWitness read_witness(const std::filesystem::path& dir, BlockNum block_num) {
+    const auto path{witness_path(dir, block_num)};
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path.string());
+    }
+    Bytes content(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(byte_ptr_cast(content.data()), static_cast<std::streamsize>(content.size()))) {
+        throw std::runtime_error("Unable to read " + path.string());
+    }
+    BlockWitness witness;
+    if (const DecodingResult res{BlockWitness::decode(content, witness)}; res != DecodingResult::kOk) {
+        throw std::runtime_error("Witness " + path.string() + " is malformed, code " +
+                                 std::to_string(static_cast<int>(res)));
+    }
+    if (witness.block.header.number != block_num) {
+        throw std::runtime_error("Witness " + path.string() + " holds block " +
+                                 std::to_string(witness.block.header.number));
+    }
+    return witness;
+}
+
+static void count_block(const Block& block, ValidationResult res, ReplayStats& stats) {
+    if (res != ValidationResult::kOk) {
+        log::Error("Validation error", {"block", std::to_string(block.header.number), "code",
+                                        std::to_string(static_cast<int>(res))});
+        ++stats.errors;
+    }
+    ++stats.blocks;
+    stats.txs += block.transactions.size();
+    stats.gas += block.header.gas_used;
+}
+
+//! \brief Re-executes blocks in range [from, to] on top of historical state, discarding all writes
+//! \remarks With a witness directory, the pre-state read by each valid block is written there along with the block
+//! \remarks Writes of previous blocks are kept in memory for up to blocks_per_buffer blocks, then the buffer is
+//! dropped and a new one reads history as of the next block: this mimics the warm in-memory state of Execution
+static ReplayStats replay(mdbx::env env, const ChainConfig& chain_config, BlockNum from, BlockNum to,
+                          const ReplaySettings& settings, const std::atomic_bool& stop) {
+    ReplayStats stats;
+    auto engine{consensus::engine_factory(chain_config)};
+    if (!engine) {
+        throw std::runtime_error("Unable to retrieve consensus engine");
+    }
+
+    BaselineAnalysisCache analysis_cache{settings.analysis_cache_size};
+    std::unique_ptr<PrecompileCache> precompile_cache;
+    if (settings.precompile_cache_size) {
+        precompile_cache = std::make_unique<PrecompileCache>(settings.precompile_cache_size);
+    }
+    ExecutionContext execution_context;
+    std::vector<Receipt> receipts;
+    Block block;
+
+    StopWatch sw{/*auto_start=*/true};
+    for (BlockNum batch_start{from}; batch_start <= to && !stop; batch_start += settings.blocks_per_buffer) {
+        const BlockNum batch_end{std::min(to, batch_start + settings.blocks_per_buffer - 1)};
+
+        // A fresh snapshot for each buffer: a long-lived reader would pin pages of a database being synced
+        auto txn{env.start_read()};
+        db::Buffer buffer{txn, /*prune_history_threshold=*/0, /*historical_block=*/batch_start};
+
+        for (BlockNum block_num{batch_start}; block_num <= batch_end && !stop; ++block_num) {
+            if (!db::read_block_by_number(txn, block_num, /*read_senders=*/true, block)) {
+                throw std::runtime_error("Unable to read block " + std::to_string(block_num));
+            }
+
+            // Reads are recorded up to the first write of the block, hence all see the state as of its beginning
+            BlockWitness witness;
+            WitnessRecorder recorder{buffer, witness};
+            const bool capture{!settings.witness_dir.empty()};
+
+            ExecutionProcessor processor{block, *engine, capture ? static_cast<State&>(recorder) : buffer,
+                                         chain_config, &execution_context};
+            processor.evm().baseline_analysis_cache = &analysis_cache;
+            processor.evm().precompile_cache = precompile_cache.get();
+
+            const auto res{processor.execute_and_write_block(receipts)};
+            if (capture && res == ValidationResult::kOk) {
+                witness.chain_id = chain_config.chain_id;
+                witness.block = block;
+                write_witness(settings.witness_dir, witness);
+            }
+            count_block(block, res, stats);
+        }
+    }
+    stats.elapsed = sw.stop().second;
+
+    stats.analysis_cache = analysis_cache.stats();
+    if (precompile_cache) {
+        stats.precompile_cache = precompile_cache->stats();
+    }
+    return stats;
+}
+
+//! \brief Re-executes blocks in range [from, to] from their witnesses only, each on a fresh InMemoryState
+//! \remarks No database is involved: the chain config is the known one of the chain id recorded in the witnesses.
+//! Partial state has no meaningful root hence validation stops at gas used, receipts root and logs bloom
+static ReplayStats replay_stateless(BlockNum from, BlockNum to, const ReplaySettings& settings,
+                                    const std::atomic_bool& stop) {
+    ReplayStats stats;
+    const ChainConfig* chain_config{nullptr};
+    std::unique_ptr<consensus::IEngine> engine;
+
+    BaselineAnalysisCache analysis_cache{settings.analysis_cache_size};
+    std::unique_ptr<PrecompileCache> precompile_cache;
+    if (settings.precompile_cache_size) {
+        precompile_cache = std::make_unique<PrecompileCache>(settings.precompile_cache_size);
+    }
+    ExecutionContext execution_context;
+    std::vector<Receipt> receipts;
+
+    StopWatch sw{/*auto_start=*/true};
+    for (BlockNum block_num{from}; block_num <= to && !stop; ++block_num) {
+        const BlockWitness witness{read_witness(settings.witness_dir, block_num)};
+        if (!chain_config) {
+            chain_config = lookup_chain_config(witness.chain_id);
+            if (!chain_config) {
+                throw std::runtime_error("Unknown chain id " + std::to_string(witness.chain_id));
+            }
+            engine = consensus::engine_factory(*chain_config);
+            if (!engine) {
+                throw std::runtime_error("Unable to retrieve consensus engine");
+            }
+        } else if (witness.chain_id != chain_config->chain_id) {
+            throw std::runtime_error("Witness of block " + std::to_string(block_num) + " belongs to another chain");
+        }
+
+        InMemoryState state;
+        witness.load_into(state);
+
+        ExecutionProcessor processor{witness.block, *engine, state, *chain_config, &execution_context};
+        processor.evm().baseline_analysis_cache = &analysis_cache;
+        processor.evm().precompile_cache = precompile_cache.get();
+
+        count_block(witness.block, processor.execute_and_write_block(receipts), stats);
+    }
+    stats.elapsed = sw.stop().second;
+
+    stats.analysis_cache = analysis_cache.stats();
+    if (precompile_cache) {
+        stats.precompile_cache = precompile_cache->stats();
+    }
+    return stats;
+}
+
+int main(int argc, char* argv[]) {
+    CLI::App app{"Re-executes a range of blocks against historical state without writing anything to db"};
+
+    std::string chaindata{DataDirectory{}.chaindata().path().string()};
+    app.add_option("--chaindata", chaindata, "Path to a database populated by Erigon or Silkworm")
+        ->capture_default_str()
+        ->check(CLI::ExistingDirectory);
+
+    BlockNum from{1};
+    app.add_option("--from", from, "Start from block number (inclusive)")->required();
+
+    BlockNum to{1};
+    app.add_option("--to", to, "Replay up to block number (inclusive)")->required();
+
+    unsigned threads{1};
+    app.add_option("--threads", threads, "Number of threads each replaying a disjoint sub-range of blocks")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 256u));
+
+    ReplaySettings settings;
+    app.add_option("--blocks.per.buffer", settings.blocks_per_buffer,
+                   "Number of blocks sharing the same in-memory state before starting over from db")
+        ->capture_default_str()
+        ->check(CLI::Range(BlockNum{1}, BlockNum{1'000'000}));
+    app.add_option("--analysis.cache", settings.analysis_cache_size, "Max entries of each thread's analysis cache")
+        ->capture_default_str();
+    app.add_option("--precompile.cache", settings.precompile_cache_size,
+                   "Max entries of each thread's precompile cache (0 = off)")
+        ->capture_default_str();
+
+    std::string witness_dir;
+    app.add_option("--witness.dir", witness_dir,
+                   "Directory each replayed block is written to along with the pre-state it reads, as <block>.witness");
+    bool stateless{false};
+    app.add_flag("--stateless", stateless, "Re-execute blocks from the witnesses in --witness.dir, without any db")
+        ->needs("--witness.dir");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (from > to) {
+        log::Error() << "--from (" << from << ") must be less than or equal to --to (" << to << ")";
+        return -1;
+    }
+
+    try {
+        settings.witness_dir = witness_dir;
+        mdbx::env_managed env;
+        std::optional<ChainConfig> chain_config;
+        if (!stateless) {
+            auto data_dir{DataDirectory::from_chaindata(chaindata)};
+            data_dir.deploy();
+            db::EnvConfig db_config{data_dir.chaindata().path().string()};
+            db_config.readonly = true;
+            env = db::open_env(db_config);
+
+            auto txn{env.start_read()};
+            chain_config = db::read_chain_config(txn);
+            if (!chain_config) {
+                throw std::runtime_error("Unable to retrieve chain config");
+            }
+            if (!witness_dir.empty()) {
+                std::filesystem::create_directories(settings.witness_dir);
+            }
+        }
+
+        // Split [from, to] into contiguous sub-ranges of (almost) equal length
+        const BlockNum num_blocks{to - from + 1};
+        threads = static_cast<unsigned>(std::min<BlockNum>(threads, num_blocks));
+        const BlockNum chunk{(num_blocks + threads - 1) / threads};
+        threads = static_cast<unsigned>((num_blocks + chunk - 1) / chunk);
+
+        std::atomic_bool stop{false};
+        std::vector<ReplayStats> stats(threads);
+        std::vector<std::exception_ptr> exceptions(threads);
+        std::vector<std::thread> workers;
+        for (unsigned i{0}; i < threads; ++i) {
+            const BlockNum range_from{from + i * chunk};
+            const BlockNum range_to{std::min(to, range_from + chunk - 1)};
+            workers.emplace_back([&, i, range_from, range_to] {
+                try {
+                    stats[i] = stateless ? replay_stateless(range_from, range_to, settings, stop)
+                                         : replay(env, *chain_config, range_from, range_to, settings, stop);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                    stop = true;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (auto& ex : exceptions) {
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+        }
+
+        ReplayStats total;
+        for (unsigned i{0}; i < threads; ++i) {
+            log_stats("Replayed [" + std::to_string(from + i * chunk) + ".." +
+                          std::to_string(std::min(to, from + (i + 1) * chunk - 1)) + "]",
+                      stats[i]);
+            total.merge(stats[i]);
+        }
+        log_stats("Replay total", total);
+        return total.errors ? -2 : 0;
+
+    } catch (const std::exception& ex) {
+        log::Error() << ex.what();
+        return -5;
+    }
+}
@@ -14,7 +14,16 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 
@@ -24,9 +33,104 @@
 #include <silkworm/db/buffer.hpp>
 #include <silkworm/execution/execution.hpp>
 
+using namespace silkworm;
+
+// Blocks in between two lines of counters
+static constexpr uint64_t kReportInterval{50'000};
+
+// Blocks a thread claims at once, aligned so that a task never straddles two lines of counters
+static constexpr uint64_t kBlocksPerTask{1'000};
+static_assert(kReportInterval % kBlocksPerTask == 0);
+
+// What a task has found, merged into the output in block order
+struct TaskResult {
+    uint64_t last_block{0};  // Last block scanned (lower than the task end when the chain ends)
+    uint64_t txs{0};
+    uint64_t errors{0};
+    std::string messages;  // Validation errors
+    bool chain_end{false};
+};
+
+// State shared by the scanning threads and the one printing results
+struct ScanProgress {
+    std::atomic<uint64_t> next_task{0};  // Tasks claimed so far, counted from the first one
+    std::atomic_bool stop{false};        // Set on chain end or failure
+    std::mutex mutex;                    // Guards what follows
+    std::condition_variable cv;          // Signalled on each new result and on failure
+    std::map<uint64_t, TaskResult> results;
+    bool failed{false};  // Whether a thread has thrown: results of its task will never come
+};
+
+// Task t spans blocks (t * kBlocksPerTask, (t + 1) * kBlocksPerTask] clamped to [from, to)
+static uint64_t task_from(uint64_t task, uint64_t from) { return std::max(from, task * kBlocksPerTask + 1); }
+static uint64_t task_to(uint64_t task, uint64_t to) { return std::min(to, (task + 1) * kBlocksPerTask + 1); }
+
+static void scan_blocks(mdbx::env env, const ChainConfig& chain_config, uint64_t from, uint64_t to,
+                        uint64_t first_task, ScanProgress& progress) {
+    auto engine{consensus::engine_factory(chain_config)};
+    if (!engine) {
+        throw std::runtime_error("Unable to retrieve consensus engine");
+    }
+
+    // Each thread has its own execution context and analysis cache
+    AdvancedAnalysisCache analysis_cache;
+    ExecutionContext execution_context;
+    std::vector<Receipt> receipts;
+    Block block;
+
+    auto txn{env.start_read()};
+    while (!progress.stop) {
+        const uint64_t task{first_task + progress.next_task++};
+        if (task_from(task, from) >= to) {
+            break;
+        }
+
+        TaskResult result;
+        std::ostringstream messages;
+        for (uint64_t block_num{task_from(task, from)}; block_num < task_to(task, to); ++block_num) {
+            // Note: If Erigon is actively syncing its database (syncing), it is important not to create
+            // long-running database reads transactions even though that may make your processing faster.
+            txn.renew_reading();
+
+            // Read the block
+            if (!db::read_block_by_number(txn, block_num, /*read_senders=*/true, block)) {
+                result.chain_end = true;
+                break;
+            }
+
+            db::Buffer buffer{txn, /*prune_history_threshold=*/0, /*historical_block=*/block_num};
+
+            ExecutionProcessor processor{block, *engine, buffer, chain_config, &execution_context};
+            processor.evm().advanced_analysis_cache = &analysis_cache;
+
+            // Execute the block and retrieve the receipts
+            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
+                messages << "Validation error " << static_cast<int>(res) << " at block " << block_num << "\n";
+            }
+
+            // There is one receipt per transaction
+            assert(block.transactions.size() == receipts.size());
+
+            // Erigon returns success in the receipt even for pre-Byzantium txs.
+            for (const auto& receipt : receipts) {
+                ++result.txs;
+                result.errors += (!receipt.success);
+            }
+            result.last_block = block_num;
+        }
+        result.messages = messages.str();
+
+        std::scoped_lock lock{progress.mutex};
+        if (result.chain_end) {
+            progress.stop = true;  // Tasks already claimed beyond are finished anyway: output stops at this one
+        }
+        progress.results.emplace(task, std::move(result));
+        progress.cv.notify_one();
+    }
+}
+
 int main(int argc, char* argv[]) {
     CLI::App app{"Executes Ethereum blocks and scans txs for errored txs"};
-    using namespace silkworm;
 
     std::string chaindata{DataDirectory{}.chaindata().path().string()};
     app.add_option("--chaindata", chaindata, "Path to a database populated by Erigon")
@@ -39,94 +143,104 @@ int main(int argc, char* argv[]) {
     uint64_t to{UINT64_MAX};
     app.add_option("--to", to, "check up to block number (exclusive)");
 
+    unsigned threads{1};
+    app.add_option("--threads", threads, "Number of threads scanning blocks (output is the same in any case)")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 256u));
+
     CLI11_PARSE(app, argc, argv);
 
     if (from > to) {
         std::cerr << "--from (" << from << ") must be less than or equal to --to (" << to << ").\n";
         return -1;
     }
+    if (!from) from = 1;  // Block 0 (genesis) has no transactions
 
     int retvar{0};
 
-    // Note: If Erigon is actively syncing its database (syncing), it is important not to create
-    // long-running datbase reads transactions even though that may make your processing faster.
-    // Uncomment the following line (and comment the line below) only if you're certain Erigon is not
-    // running on the same machine.
-    // std::unique_ptr<lmdb::Transaction> txn{env->begin_ro_transaction()};
-
-    AdvancedAnalysisCache analysis_cache;
-    ObjectPool<EvmoneExecutionState> state_pool;
-    std::vector<Receipt> receipts;
+    ScanProgress progress;
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> exceptions(threads);
 
     try {
         auto data_dir{DataDirectory::from_chaindata(chaindata)};
         data_dir.deploy();
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
+        db_config.readonly = true;
         auto env{db::open_env(db_config)};
-        auto txn{env.start_read()};
-        auto chain_config{db::read_chain_config(txn)};
+        std::optional<ChainConfig> chain_config;
+        {
+            auto txn{env.start_read()};
+            chain_config = db::read_chain_config(txn);
+        }
         if (!chain_config) {
             throw std::runtime_error("Unable to retrieve chain config");
         }
-        auto engine{consensus::engine_factory(chain_config.value())};
-        if (!engine) {
-            throw std::runtime_error("Unable to retrieve consensus engine");
+
+        const uint64_t first_task{(from - 1) / kBlocksPerTask};
+        for (unsigned i{0}; i < threads; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    scan_blocks(env, *chain_config, from, to, first_task, progress);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                    std::scoped_lock lock{progress.mutex};
+                    progress.failed = true;
+                    progress.stop = true;
+                    progress.cv.notify_one();
+                }
+            });
         }
 
-        // counters
+        // Merge results in block order
         uint64_t nTxs{0}, nErrors{0};
-
-        Block block;
-        for (uint64_t block_num{from}; block_num < to; ++block_num) {
-            // Note: See the comment above. You may uncomment that line and comment the next line if you're certain
-            // that Erigon is not syncing on the same machine. If you use a long-running transaction by doing this, and
-            // you're mistaken (Erigon is syncing), the database file may 'grow quickly' as per the LMDB docs.
-            txn.renew_reading();
-
-            // Read the block
-            if (!db::read_block_by_number(txn, block_num, /*read_senders=*/true, block)) {
-                break;
-            }
-
-            db::Buffer buffer{txn, /*prune_history_threshold=*/0, /*historical_block=*/block_num};
-
-            ExecutionProcessor processor{block, *engine, buffer, *chain_config};
-            processor.evm().advanced_analysis_cache = &analysis_cache;
-            processor.evm().state_pool = &state_pool;
-
-            // Execute the block and retrieve the receipts
-            if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
-                std::cerr << "Validation error " << static_cast<int>(res) << " at block " << block_num << "\n";
-            }
-
-            // There is one receipt per transaction
-            assert(block.transactions.size() == receipts.size());
-
-            // Erigon returns success in the receipt even for pre-Byzantium txs.
-            for (const auto& receipt : receipts) {
-                ++nTxs;
-                nErrors += (!receipt.success);
+        for (uint64_t task{first_task}; task_from(task, from) < to; ++task) {
+            TaskResult result;
+            {
+                std::unique_lock lock{progress.mutex};
+                progress.cv.wait(lock, [&] { return progress.results.contains(task) || progress.failed; });
+                if (!progress.results.contains(task)) {
+                    break;
+                }
+                result = std::move(progress.results.extract(task).mapped());
             }
+            std::cerr << result.messages;
+            nTxs += result.txs;
+            nErrors += result.errors;
 
             // Report and reset counters
-            if ((block_num % 50000) == 0) {
-                std::cout << block_num << "," << nTxs << "," << nErrors << std::endl;
+            if (result.last_block && (result.last_block % kReportInterval) == 0) {
+                std::cout << result.last_block << "," << nTxs << "," << nErrors << std::endl;
                 nTxs = nErrors = 0;
-
-            } else if ((block_num % 100) == 0) {
+            } else if (result.last_block) {
                 // report progress
-                std::cerr << block_num << "\r";
+                std::cerr << result.last_block << "\r";
                 std::cerr.flush();
             }
-
-            // Note: If per-block database transaction (txn) is being used, it will go out of scope here
-            // and will be reset. No need to explicitly clean up here.
+            if (result.chain_end) {
+                break;
+            }
         }
 
+        progress.stop = true;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+        for (auto& ex : exceptions) {
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+        }
     } catch (std::exception& ex) {
         std::cout << ex.what() << std::endl;
         retvar = -1;
     }
 
+    progress.stop = true;
+    for (auto& worker : workers) {
+        worker.join();  // Still running if the main thread has thrown
+    }
+
     return retvar;
 }
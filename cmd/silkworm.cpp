@@ -20,10 +20,12 @@
 #include <CLI/CLI.hpp>
 
 #include <silkworm/buildinfo.h>
+#include <silkworm/common/instrumentation.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/settings.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
+#include <silkworm/db/snapshot.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/stagedsync/sync_loop.hpp>
 
@@ -109,6 +111,15 @@ int main(int argc, char* argv[]) {
 
         auto chaindata_env{silkworm::db::open_env(node_settings.chaindata_env_config)};
 
+        // Frozen blocks are read from segment files, if any
+        db::SnapshotRepository snapshot_repository{node_settings.data_directory->snapshots().path()};
+        snapshot_repository.reopen();
+        if (snapshot_repository.segments_count()) {
+            db::set_snapshot_repository(&snapshot_repository);
+            log::Message("Snapshots", {"segments", std::to_string(snapshot_repository.segments_count()), "max block",
+                                       std::to_string(*snapshot_repository.max_block_number())});
+        }
+
         // Start boost asio
         using asio_guard_type = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
         auto asio_guard = std::make_unique<asio_guard_type>(node_settings.asio_context.get_executor());
@@ -147,6 +158,11 @@ int main(int argc, char* argv[]) {
                               "etl-tmp", human_size(node_settings.data_directory->etl().size()),      //
                               "uptime", StopWatch::format(total_duration)                             //
                           });
+                for (const auto& sample : instrumentation::report()) {
+                    log::Info("Instrumentation", {"probe", std::string{sample.name},      //
+                                                  "count", std::to_string(sample.count),  //
+                                                  "time", StopWatch::format(sample.time)});
+                }
             }
         }
 
@@ -154,6 +170,7 @@ int main(int argc, char* argv[]) {
         asio_thread.join();
 
         log::Message() << "Closing Database chaindata path " << node_settings.data_directory->chaindata().path();
+        db::set_snapshot_repository(nullptr);
         chaindata_env.close();
         sync_loop.rethrow();  // Eventually throws the exception which caused the stop
         return 0;
@@ -0,0 +1,233 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/buildinfo.h>
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/common/resource_usage.hpp>
+#include <silkworm/common/settings.hpp>
+#include <silkworm/concurrency/signal_handler.hpp>
+#include <silkworm/db/snapshot.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/stagedsync/stage_blockhashes.hpp>
+#include <silkworm/stagedsync/stage_execution.hpp>
+#include <silkworm/stagedsync/stage_hashstate.hpp>
+#include <silkworm/stagedsync/stage_history_index.hpp>
+#include <silkworm/stagedsync/stage_log_index.hpp>
+#include <silkworm/stagedsync/stage_metrics.hpp>
+#include <silkworm/stagedsync/stage_senders.hpp>
+#include <silkworm/stagedsync/stage_tx_lookup.hpp>
+
+using namespace silkworm;
+namespace fs = std::filesystem;
+
+// Runs one stage forward over a block range, then unwinds it, on a throwaway copy of a chaindata snapshot and prints
+// what each run consumed as JSON: same snapshot and range give comparable figures across builds
+
+static std::vector<std::unique_ptr<stagedsync::IStage>> make_stages(NodeSettings& node_settings) {
+    std::vector<std::unique_ptr<stagedsync::IStage>> stages;
+    stages.push_back(std::make_unique<stagedsync::BlockHashes>(&node_settings));
+    stages.push_back(std::make_unique<stagedsync::Senders>(&node_settings));
+    stages.push_back(std::make_unique<stagedsync::Execution>(&node_settings));
+    stages.push_back(std::make_unique<stagedsync::HashState>(&node_settings));
+    stages.push_back(std::make_unique<stagedsync::HistoryIndex>(&node_settings, /*storage=*/false));
+    stages.push_back(std::make_unique<stagedsync::HistoryIndex>(&node_settings, /*storage=*/true));
+    stages.push_back(std::make_unique<stagedsync::LogIndex>(&node_settings));
+    stages.push_back(std::make_unique<stagedsync::TxLookup>(&node_settings));
+    return stages;
+}
+
+static nlohmann::json to_json(const stagedsync::StageMetrics& metrics, BlockNum blocks, size_t page_size) {
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    const auto wall_ms{duration_cast<milliseconds>(metrics.wall_time).count()};
+
+    nlohmann::json json;
+    json["blocks"] = blocks;
+    json["wall_ms"] = wall_ms;
+    json["blocks_per_sec"] = wall_ms ? static_cast<double>(blocks) * 1'000 / static_cast<double>(wall_ms) : 0.0;
+    json["cpu_ms"] = duration_cast<milliseconds>(metrics.cpu_time).count();
+    json["commit_ms"] = duration_cast<milliseconds>(metrics.commit_time).count();
+    json["commits"] = metrics.commits;
+    json["dirty_bytes"] = metrics.committed_bytes;
+    json["dirty_pages"] = metrics.committed_bytes / page_size;
+    json["etl_flushed_bytes"] = metrics.etl_flushed_bytes;
+    json["minor_page_faults"] = metrics.minor_page_faults;
+    json["major_page_faults"] = metrics.major_page_faults;
+    json["block_inputs"] = metrics.block_inputs;
+    json["block_outputs"] = metrics.block_outputs;
+    json["peak_rss_bytes"] = process_resource_usage().peak_resident_bytes;
+    return json;
+}
+
+int main(int argc, char* argv[]) {
+    CLI::App app{"Benchmarks a stage forward and unwind on a throwaway copy of a chaindata snapshot"};
+
+    std::string chaindata{DataDirectory{}.chaindata().path().string()};
+    std::string work_dir{(TemporaryDirectory::get_os_temporary_path() / "stage_bench").string()};
+    std::string stage_name;
+    BlockNum from{0};
+    BlockNum to{0};
+    bool no_unwind{false};
+    bool keep{false};
+    std::string output_file;
+    size_t etl_buffer_size{256_Mebi};
+
+    app.add_option("--chaindata", chaindata, "Path to the chaindata snapshot (left untouched)")
+        ->capture_default_str()
+        ->check(CLI::ExistingDirectory);
+    app.add_option("--workdir", work_dir, "Data directory the snapshot is copied into (must not hold a db)")
+        ->capture_default_str();
+    app.add_option("--stage", stage_name, "Stage to benchmark")
+        ->required()
+        ->check(CLI::IsMember({db::stages::kBlockHashesKey, db::stages::kSendersKey, db::stages::kExecutionKey,
+                               db::stages::kHashStateKey, db::stages::kAccountHistoryIndexKey,
+                               db::stages::kStorageHistoryIndexKey, db::stages::kLogIndexKey,
+                               db::stages::kTxLookupKey}));
+    app.add_option("--from", from, "Block the stage is unwound to before (and after) the forward")->required();
+    app.add_option("--to", to, "Block the stage is forwarded to")->required();
+    app.add_flag("--no-unwind", no_unwind, "Do not benchmark the unwind back to --from");
+    app.add_flag("--keep", keep, "Keep the copy in --workdir when done");
+    app.add_option("--json", output_file, "File results are written to (default stdout)");
+    app.add_option("--etl.buffersize", etl_buffer_size, "Buffer size for ETL operations")
+        ->capture_default_str()
+        ->check(CLI::Range(64_Mebi, 1_Gibi));
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (from >= to) {
+        std::cerr << "--from must be lower than --to" << std::endl;
+        return -1;
+    }
+
+    try {
+        SignalHandler::init();
+
+        // Throwaway copy of the snapshot
+        NodeSettings node_settings{};
+        node_settings.data_directory = std::make_unique<DataDirectory>(fs::path{work_dir}, /*create=*/true);
+        const fs::path target_file{node_settings.data_directory->chaindata().path() / db::kDbDataFileName};
+        if (fs::exists(target_file)) {
+            throw std::runtime_error("Directory " + node_settings.data_directory->chaindata().path().string() +
+                                     " already contains a db");
+        }
+        {
+            db::EnvConfig source_config{chaindata};
+            source_config.readonly = true;
+            auto source_env{db::open_env(source_config)};
+            log::Message("Copying snapshot", {"from", chaindata, "to", target_file.string()});
+            source_env.copy(target_file.string(), /*compactify=*/false, /*forcedynamic=*/true);
+        }
+
+        // Frozen blocks are read from the segment files of the snapshot, if any
+        db::SnapshotRepository snapshot_repository{DataDirectory::from_chaindata(chaindata).snapshots().path()};
+        snapshot_repository.reopen();
+        if (snapshot_repository.segments_count()) {
+            db::set_snapshot_repository(&snapshot_repository);
+        }
+
+        node_settings.chaindata_env_config.path = node_settings.data_directory->chaindata().path().string();
+        node_settings.chaindata_env_config.exclusive = true;
+        node_settings.etl_buffer_size = etl_buffer_size;
+        auto env{db::open_env(node_settings.chaindata_env_config)};
+        db::RWTxn txn{env};
+        node_settings.chain_config = db::read_chain_config(*txn);
+        if (!node_settings.chain_config) {
+            throw std::runtime_error("Unable to retrieve chain configuration");
+        }
+        node_settings.network_id = node_settings.chain_config->chain_id;
+        node_settings.prune_mode = std::make_unique<db::PruneMode>(db::read_prune_mode(*txn));
+
+        auto stages{make_stages(node_settings)};
+        auto it{std::find_if(stages.begin(), stages.end(), [&](const auto& s) { return s->name() == stage_name; })};
+        auto& stage{**it};
+
+        // Bring the stage to --from and bound its forward to --to through the progress of its input
+        const BlockNum progress{stage.get_progress(txn)};
+        if (progress < from) {
+            throw std::runtime_error("Stage " + stage_name + " is at block " + std::to_string(progress) +
+                                     ", below --from");
+        }
+        const char* source{stage.input_source()};
+        const BlockNum source_progress{db::stages::read_stage_progress(*txn, source)};
+        if (source_progress < to) {
+            throw std::runtime_error("Stage " + std::string(source) + " is at block " +
+                                     std::to_string(source_progress) + ", below --to");
+        }
+        if (progress > from) {
+            log::Message("Unwinding", {"stage", stage_name, "from", std::to_string(progress), "to",
+                                       std::to_string(from)});
+            stagedsync::success_or_throw(stage.unwind(txn, from));
+        }
+        db::stages::write_stage_progress(*txn, source, to);
+        txn.commit();
+
+        const auto page_size{env.get_pagesize()};
+        const auto build_info{silkworm_get_buildinfo()};
+        nlohmann::json results;
+        results["stage"] = stage_name;
+        results["from"] = from;
+        results["to"] = to;
+        results["version"] = std::string(build_info->project_version);
+        results["build"] = std::string(build_info->build_type);
+        results["compiler"] = std::string(build_info->compiler_id) + " " + std::string(build_info->compiler_version);
+
+        log::Message("Forward", {"stage", stage_name, "from", std::to_string(from), "to", std::to_string(to)});
+        {
+            const stagedsync::StageMetricsProbe probe{txn};
+            stagedsync::success_or_throw(stage.forward(txn));
+            txn.commit();
+            const BlockNum reached{stage.get_progress(txn)};
+            results["forward"] = to_json(probe.sample(txn), reached - from, page_size);
+        }
+
+        if (!no_unwind && !SignalHandler::signalled()) {
+            log::Message("Unwind", {"stage", stage_name, "from", std::to_string(to), "to", std::to_string(from)});
+            const stagedsync::StageMetricsProbe probe{txn};
+            stagedsync::success_or_throw(stage.unwind(txn, from));
+            txn.commit();
+            results["unwind"] = to_json(probe.sample(txn), to - from, page_size);
+        }
+
+        txn.commit(/*renew=*/false);
+        env.close();
+        if (!keep) {
+            fs::remove_all(work_dir);
+        }
+
+        if (output_file.empty()) {
+            std::cout << results.dump(2) << std::endl;
+        } else {
+            std::ofstream{output_file} << results.dump(2) << std::endl;
+        }
+
+    } catch (const std::exception& ex) {
+        log::Error() << ex.what();
+        return -5;
+    }
+    return 0;
+}
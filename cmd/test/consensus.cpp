@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+#include <algorithm>
 #include <atomic>
 #include <filesystem>
 #include <iostream>
@@ -540,7 +541,9 @@ std::atomic<size_t> total_skipped{0};
 
 using RunnerFunc = RunResults (*)(const nlohmann::json&);
 
-void run_test_file(const fs::path& file_path, RunnerFunc runner) {
+// Returns the wall time spent on the file
+StopWatch::Duration run_test_file(const fs::path& file_path, RunnerFunc runner) {
+    StopWatch sw{/*auto_start=*/true};
     std::ifstream in{file_path.string()};
     nlohmann::json json;
 
@@ -550,7 +553,7 @@ void run_test_file(const fs::path& file_path, RunnerFunc runner) {
         std::cerr << e.what() << "\n";
         print_test_status(file_path.string(), Status::kSkipped);
         ++total_skipped;
-        return;
+        return sw.lap_duration();
     }
 
     RunResults total;
@@ -566,6 +569,8 @@ void run_test_file(const fs::path& file_path, RunnerFunc runner) {
     total_passed += total.passed;
     total_failed += total.failed;
     total_skipped += total.skipped;
+
+    return sw.lap_duration();
 }
 
 // https://ethereum-tests.readthedocs.io/en/latest/test_types/transaction_tests.html
@@ -737,6 +742,8 @@ int main(int argc, char* argv[]) {
     app.add_option("--threads", num_threads, "Number of parallel threads")->capture_default_str();
     bool include_slow_tests{false};
     app.add_flag("--slow", include_slow_tests, "Run slow tests");
+    size_t num_timings{0};
+    app.add_option("--timings", num_timings, "Number of slowest test files to report");
 
     CLI11_PARSE(app, argc, argv);
     init_terminal();
@@ -764,6 +771,14 @@ int main(int argc, char* argv[]) {
         {kTransactionDir, transaction_test},
     };
 
+    struct TestFile {
+        fs::path path;
+        RunnerFunc runner{nullptr};
+        uintmax_t size{0};
+        StopWatch::Duration duration{0};
+    };
+    std::vector<TestFile> test_files;
+
     for (const auto& entry : kTestTypes) {
         const fs::path& dir{entry.first};
         const RunnerFunc runner{entry.second};
@@ -773,14 +788,34 @@ int main(int argc, char* argv[]) {
                 ++total_skipped;
                 i.disable_recursion_pending();
             } else if (fs::is_regular_file(i->path())) {
-                const fs::path path{*i};
-                thread_pool.push_task([path, runner]() { run_test_file(path, runner); });
+                test_files.push_back({i->path(), runner, i->file_size()});
             }
         }
     }
 
+    // Largest files first, so that the pool does not end up waiting on a big file picked up last
+    std::stable_sort(test_files.begin(), test_files.end(),
+                     [](const TestFile& a, const TestFile& b) { return a.size > b.size; });
+
+    for (TestFile& file : test_files) {
+        thread_pool.push_task([&file]() { file.duration = run_test_file(file.path, file.runner); });
+    }
+
     thread_pool.wait_for_tasks();
 
+    if (num_timings != 0) {
+        num_timings = std::min(num_timings, test_files.size());
+        std::partial_sort(test_files.begin(), test_files.begin() + static_cast<std::ptrdiff_t>(num_timings),
+                          test_files.end(),
+                          [](const TestFile& a, const TestFile& b) { return a.duration > b.duration; });
+        std::cout << "Slowest test files:\n";
+        for (size_t i{0}; i < num_timings; ++i) {
+            const TestFile& file{test_files[i]};
+            std::cout << "  " << StopWatch::format(file.duration) << "  "
+                      << fs::relative(file.path, root_dir).string() << "\n";
+        }
+    }
+
     std::cout << kColorGreen << total_passed << " tests passed" << kColorReset << ", ";
     if (total_failed != 0) {
         std::cout << kColorMaroonHigh;
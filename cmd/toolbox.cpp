@@ -14,12 +14,20 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <csignal>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <random>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <thread>
 
 #include <CLI/CLI.hpp>
 #include <boost/bind/bind.hpp>
@@ -31,10 +39,18 @@
 #include <silkworm/common/as_range.hpp>
 #include <silkworm/common/directories.hpp>
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/resource_usage.hpp>
+#include <silkworm/common/stopwatch.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
 #include <silkworm/db/genesis.hpp>
+#include <silkworm/db/geometry.hpp>
+#include <silkworm/db/migrations.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/prune_mode.hpp>
+#include <silkworm/db/snapshot.hpp>
 #include <silkworm/db/stages.hpp>
+#include <silkworm/db/state_snapshot.hpp>
+#include <silkworm/downloader/internals/preverified_hashes.hpp>
 #include <silkworm/stagedsync/stagedsync.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 
@@ -356,11 +372,12 @@ void do_stages(db::EnvConfig& config) {
         while (result) {
             size_t height{endian::load_big_u64(static_cast<uint8_t*>(result.value.data()))};
 
-            // Handle "prune_" stages
+            // Handle "prune_" and "checkpoint_" stages
             size_t offset{0};
-            static const char* prune_prefix = "prune_";
-            if (std::memcmp(result.key.data(), prune_prefix, 6) == 0) {
-                offset = 6;
+            for (const std::string_view prefix : {"prune_", "checkpoint_"}) {
+                if (result.key.as_string().starts_with(prefix)) {
+                    offset = prefix.size();
+                }
             }
 
             bool Known{db::stages::is_known_stage(result.key.char_ptr() + offset)};
@@ -410,6 +427,83 @@ void do_migrations(db::EnvConfig& config) {
     env.close(config.shared);
 }
 
+void do_compact_changesets(db::EnvConfig& config, bool dry) {
+    config.readonly = false;
+
+    if (!config.exclusive) {
+        throw std::runtime_error("Changesets migration requires exclusive access to database");
+    }
+
+    auto env{silkworm::db::open_env(config)};
+    auto txn{env.start_write()};
+    if (!db::migrate_to_compact_changesets(txn)) {
+        std::cout << "\n Database already uses compact changesets\n" << std::endl;
+        return;
+    }
+    if (!dry) {
+        txn.commit();
+    }
+
+    std::cout << "\n Migration " << db::table::kCompactChangeSetsMigration << " applied"
+              << (dry ? " (not persisted due to --dry)" : "") << "\n"
+              << std::endl;
+}
+
+void do_freeze(db::EnvConfig& config, const DataDirectory& data_dir, BlockNum from, BlockNum to, bool prune) {
+    if (prune && !config.exclusive) {
+        throw std::runtime_error("Pruning frozen blocks requires exclusive access to database");
+    }
+    config.readonly = !prune;
+
+    auto env{silkworm::db::open_env(config)};
+    auto txn{prune ? env.start_write() : env.start_read()};
+
+    // Only blocks no longer subject to unwinds and already processed by the stages reading db tables directly
+    BlockNum progress{db::stages::read_stage_progress(txn, db::stages::kExecutionKey)};
+    progress = std::min(progress, db::stages::read_stage_progress(txn, db::stages::kSendersKey));
+    progress = std::min(progress, db::stages::read_stage_progress(txn, db::stages::kTxLookupKey));
+    if (from > to || to + db::kFullImmutabilityThreshold > progress) {
+        throw std::runtime_error("Blocks to freeze must be at least " + std::to_string(db::kFullImmutabilityThreshold) +
+                                 " below stages progress " + std::to_string(progress));
+    }
+
+    db::SnapshotRepository repository{data_dir.snapshots().path()};
+    repository.reopen();
+    if (const auto max_block{repository.max_block_number()}; max_block && from <= *max_block) {
+        throw std::runtime_error("Blocks up to " + std::to_string(*max_block) + " are already frozen");
+    }
+
+    fs::create_directories(data_dir.snapshots().path());
+    const auto path{db::write_block_segment(txn, data_dir.snapshots().path(), from, to)};
+    std::cout << "\n Blocks " << from << " to " << to << " frozen into " << path.string() << std::endl;
+
+    if (prune) {
+        const db::BlockSegment segment{path};
+        const auto erased{db::erase_frozen_blocks(txn, segment)};
+        txn.commit();
+        std::cout << " Erased " << erased << " blocks from db" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void do_export_state(db::EnvConfig& config, const std::string& target_dir, uint32_t num_threads, size_t chunk_size) {
+    config.readonly = true;
+    auto env{silkworm::db::open_env(config)};
+    const auto manifest{db::export_state_snapshot(env, target_dir, num_threads, chunk_size)};
+
+    uint64_t raw_size{0};
+    uint64_t compressed_size{0};
+    for (const auto& chunk : manifest.chunks) {
+        raw_size += chunk.raw_size;
+        compressed_size += chunk.compressed_size;
+    }
+    std::cout << "\n State at block " << manifest.block_number << " exported into " << target_dir << "\n"
+              << " Chunks " << manifest.chunks.size() << " raw " << human_size(raw_size) << " compressed "
+              << human_size(compressed_size) << "\n"
+              << " State root " << to_hex(manifest.state_root.bytes, /*with_prefix=*/true) << "\n"
+              << std::endl;
+}
+
 void do_stage_set(db::EnvConfig& config, std::string&& stage_name, uint32_t new_height, bool dry) {
     config.readonly = false;
 
@@ -508,6 +602,222 @@ void do_freelist(db::EnvConfig& config, bool detail) {
     env.close(config.shared);
 }
 
+void do_geometry(db::EnvConfig& config, const std::vector<std::string>& table_names, size_t cache_size) {
+    static std::string fmt_hdr{" %-24s %6s %10s %12s %10s %12s %9s"};
+    static std::string fmt_row{" %-24s %6s %10u %12s %10s %12u %9.1f"};
+
+    auto env{silkworm::db::open_env(config)};
+    auto txn{env.start_read()};
+
+    std::vector<db::MapShape> shapes;
+    for (const auto& name : table_names) {
+        const auto it{as_range::find_if(db::table::kChainDataTables,
+                                        [&name](const db::MapConfig& table) { return name == table.name; })};
+        if (it == std::end(db::table::kChainDataTables)) {
+            throw std::invalid_argument("Unknown table " + name);
+        }
+        shapes.push_back(db::sample_map_shape(txn, *it));
+    }
+
+    const auto env_info{env.get_info()};
+    const auto advice{db::advise_page_size(shapes, cache_size)};
+
+    std::cout << "\n Page size                : " << human_size(env_info.mi_dxb_pagesize) << "\n"
+              << " Growth step              : " << human_size(env_info.mi_geo.grow) << "\n"
+              << " Cache for lookups        : " << human_size(cache_size) << "\n"
+              << std::endl;
+
+    std::cout << (boost::format(fmt_hdr) % "Table name" % "Page" % "Depth" % "Branch size" % "Cached" % "Overflows" %
+                  "Read us")
+              << std::endl;
+    std::cout << (boost::format(fmt_hdr) % std::string(24, '-') % std::string(6, '-') % std::string(10, '-') %
+                  std::string(12, '-') % std::string(10, '-') % std::string(12, '-') % std::string(9, '-'))
+              << std::endl;
+    for (size_t i{0}; i < shapes.size(); ++i) {
+        std::cout << " " << table_names[i] << " : " << shapes[i].entries << " records, key "
+                  << (boost::format("%.1f") % shapes[i].key_size) << " B, value "
+                  << (boost::format("%.1f") % shapes[i].value_size) << " B" << std::endl;
+        for (const auto& estimate : advice.estimates[i]) {
+            std::cout << (boost::format(fmt_row) % "" % human_size(estimate.page_size) % estimate.depth %
+                          human_size(estimate.branch_pages * estimate.page_size) %
+                          (std::to_string(estimate.cached_levels) + " levels") % estimate.overflow_pages %
+                          estimate.read_time)
+                      << std::endl;
+        }
+    }
+
+    const size_t growth_step{db::advise_growth_step(env_info.mi_geo.current, env_info.mi_geo.upper)};
+    std::cout << "\n Advised page size        : " << human_size(advice.page_size) << " (--chaindata.pagesize)\n"
+              << " Advised growth step      : " << human_size(growth_step) << " (--chaindata.growthsize)\n"
+              << "\n Page size only applies to new databases: copy tables into one (toolbox copy --pagesize)\n"
+              << std::endl;
+
+    txn.commit();
+    env.close(config.shared);
+}
+
+void do_bench_reads(db::EnvConfig& config, const std::string& table_name, size_t lookups, size_t scan_length,
+                    uint32_t threads) {
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    using std::chrono::steady_clock;
+
+    const auto it{as_range::find_if(db::table::kChainDataTables,
+                                    [&table_name](const db::MapConfig& table) { return table_name == table.name; })};
+    if (it == std::end(db::table::kChainDataTables)) {
+        throw std::invalid_argument("Unknown table " + table_name);
+    }
+    if (it->key_mode != ::mdbx::key_mode::usual) {
+        throw std::invalid_argument("Table " + table_name + " keys are not ordered bytewise");
+    }
+    const db::MapConfig& map_config{*it};
+    threads = std::max(threads, 1u);
+
+    auto env{silkworm::db::open_env(config)};
+
+    // Probe keys are drawn uniformly over the 8 bytes following the prefix all keys share: no pass over the table
+    // collects existing keys beforehand, which would bring the pages to be measured into the cache
+    Bytes prefix;
+    uint64_t low{0};
+    uint64_t high{0};
+    {
+        auto txn{env.start_read()};
+        db::Cursor cursor{txn, map_config};
+        const auto first{cursor.to_first(/*throw_notfound=*/false)};
+        if (!first) {
+            std::cout << "\n Table " << table_name << " is empty\n" << std::endl;
+            txn.commit();
+            env.close(config.shared);
+            return;
+        }
+        const Bytes first_key{db::from_slice(first.key)};
+        const Bytes last_key{db::from_slice(cursor.to_last().key)};
+        const auto mismatch{std::mismatch(first_key.begin(), first_key.end(), last_key.begin(), last_key.end())};
+        prefix = first_key.substr(0, static_cast<size_t>(mismatch.first - first_key.begin()));
+        const auto load_point = [&prefix](const Bytes& key) {
+            uint8_t buffer[8]{};
+            const ByteView tail{ByteView{key}.substr(prefix.length(), sizeof(buffer))};
+            std::copy(tail.begin(), tail.end(), buffer);
+            return endian::load_big_u64(buffer);
+        };
+        low = load_point(first_key);
+        high = std::max(load_point(last_key), low);
+        txn.commit();
+    }
+
+    struct Latencies {
+        std::vector<uint64_t> lookups;  // Nanoseconds
+        std::vector<uint64_t> scans;    // Nanoseconds
+        uint64_t records{0};            // Records read
+        uint64_t bytes{0};              // Key and value bytes read
+        uint64_t checksum{0};           // Keeps the reads of values from being optimized away
+    };
+
+    // Each worker runs its share of lookups in its own read transaction, with a fixed seed so runs are comparable
+    const auto bench{[&](uint32_t worker) {
+        Latencies ret;
+        const size_t count{lookups / threads + (worker < lookups % threads ? 1 : 0)};
+        ret.lookups.reserve(count);
+        ret.scans.reserve(scan_length ? count : 0);
+        std::mt19937_64 generator{worker + 1};
+        std::uniform_int_distribution<uint64_t> distribution{low, high};
+        Bytes probe{prefix};
+        probe.resize(prefix.length() + sizeof(uint64_t));
+
+        auto txn{env.start_read()};
+        db::Cursor cursor{txn, map_config};
+        const auto read{[&ret](const ::mdbx::cursor::move_result& data) {
+            ++ret.records;
+            ret.bytes += data.key.length() + data.value.length();
+            if (!data.value.empty()) {
+                // Values may lie on overflow pages the lookup itself does not touch
+                ret.checksum += data.value.byte_ptr()[data.value.length() - 1];
+            }
+        }};
+
+        for (size_t i{0}; i < count && !SignalHandler::signalled(); ++i) {
+            endian::store_big_u64(&probe[prefix.length()], distribution(generator));
+            auto start{steady_clock::now()};
+            auto data{cursor.lower_bound(db::to_slice(probe), /*throw_notfound=*/false)};
+            if (data) {
+                read(data);
+            }
+            ret.lookups.push_back(static_cast<uint64_t>((steady_clock::now() - start) / nanoseconds{1}));
+
+            if (scan_length) {
+                start = steady_clock::now();
+                for (size_t j{0}; data && j < scan_length; ++j) {
+                    data = cursor.to_next(/*throw_notfound=*/false);
+                    if (data) {
+                        read(data);
+                    }
+                }
+                ret.scans.push_back(static_cast<uint64_t>((steady_clock::now() - start) / nanoseconds{1}));
+            }
+        }
+        txn.commit();
+        return ret;
+    }};
+
+    const auto usage_start{process_resource_usage()};
+    const auto time_start{steady_clock::now()};
+    std::vector<std::future<Latencies>> futures;
+    for (uint32_t worker{0}; worker < threads; ++worker) {
+        futures.push_back(std::async(std::launch::async, bench, worker));
+    }
+    Latencies total;
+    for (auto& future : futures) {
+        auto latencies{future.get()};
+        total.lookups.insert(total.lookups.end(), latencies.lookups.begin(), latencies.lookups.end());
+        total.scans.insert(total.scans.end(), latencies.scans.begin(), latencies.scans.end());
+        total.records += latencies.records;
+        total.bytes += latencies.bytes;
+        total.checksum += latencies.checksum;
+    }
+    const auto elapsed{steady_clock::now() - time_start};
+    const auto usage{process_resource_usage() - usage_start};
+    env.close(config.shared);
+
+    static std::string fmt_hdr{" %-24s %10s %10s %10s %10s %12s"};
+    static std::string fmt_row{" %-24s %10u %10.1f %10.1f %10.1f %12.0f"};
+    const double seconds{std::max(std::chrono::duration<double>(elapsed).count(), 1e-9)};
+    const auto print_row{[&](const std::string& name, std::vector<uint64_t>& values) {
+        if (values.empty()) {
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        const auto micros{[&values](size_t index) { return static_cast<double>(values[index]) / 1'000; }};
+        std::cout << (boost::format(fmt_row) % name % values.size() % micros(values.size() / 2) %
+                      micros(values.size() * 99 / 100) % micros(values.size() - 1) %
+                      (static_cast<double>(values.size()) / seconds))
+                  << std::endl;
+    }};
+
+    std::cout << "\n Table                    : " << table_name << "\n"
+              << " Threads                  : " << threads << "\n"
+              << " Elapsed                  : " << StopWatch::format(duration_cast<nanoseconds>(elapsed)) << "\n"
+              << " Records read             : " << total.records << " (" << human_size(total.bytes) << ")\n"
+              << std::endl;
+    std::cout << (boost::format(fmt_hdr) % "Operation" % "Count" % "p50 us" % "p99 us" % "Max us" % "Ops/s")
+              << std::endl;
+    std::cout << (boost::format(fmt_hdr) % std::string(24, '-') % std::string(10, '-') % std::string(10, '-') %
+                  std::string(10, '-') % std::string(10, '-') % std::string(12, '-'))
+              << std::endl;
+    print_row("Point lookup", total.lookups);
+    print_row("Scan of " + std::to_string(scan_length), total.scans);
+
+    const double operations{static_cast<double>(std::max<size_t>(total.lookups.size(), 1))};
+    std::cout << "\n Minor page faults        : " << usage.minor_page_faults << " ("
+              << (boost::format("%.2f") % (static_cast<double>(usage.minor_page_faults) / operations))
+              << " per lookup)\n"
+              << " Major page faults        : " << usage.major_page_faults << " ("
+              << (boost::format("%.2f") % (static_cast<double>(usage.major_page_faults) / operations))
+              << " per lookup)\n"
+              << "\n Major faults are reads from storage: run on a cold cache (or a db larger than memory) to size"
+              << "\n RAM and storage, run twice for the cached figures\n"
+              << std::endl;
+}
+
 void do_schema(db::EnvConfig& config) {
     auto env{silkworm::db::open_env(config)};
     auto txn{env.start_read()};
@@ -595,7 +905,7 @@ void do_compact(db::EnvConfig& config, const std::string& work_dir, bool replace
 }
 
 void do_copy(db::EnvConfig& src_config, const std::string& target_dir, bool create, bool noempty,
-             std::vector<std::string>& names, std::vector<std::string>& xnames) {
+             std::vector<std::string>& names, std::vector<std::string>& xnames, size_t page_size) {
     if (!src_config.exclusive) {
         throw std::runtime_error("Copy tool requires exclusive access to source database");
     }
@@ -618,6 +928,7 @@ void do_copy(db::EnvConfig& src_config, const std::string& target_dir, bool crea
     // Target config
     db::EnvConfig tgt_config{target_path.string()};
     tgt_config.exclusive = true;
+    tgt_config.page_size = page_size;
     fs::path target_file_path{target_path / fs::path(db::kDbDataFileName)};
     if (!fs::exists(target_file_path)) {
         tgt_config.create = true;
@@ -901,19 +1212,71 @@ void do_first_byte_analysis(db::EnvConfig& config) {
     std::cout << "\n" << std::endl;
 }
 
-void do_extract_headers(db::EnvConfig& config, const std::string& file_name, uint32_t step) {
+void do_extract_headers(db::EnvConfig& config, const std::string& file_name, uint32_t step, bool binary,
+                        uint32_t threads) {
     if (!config.exclusive) {
         throw std::runtime_error("Extract headers tool requires exclusive access to database");
     }
 
     auto env{silkworm::db::open_env(config)};
-    auto txn{env.start_read()};
+    BlockNum block_max{0};
+    {
+        auto txn{env.start_read()};
+        block_max = db::stages::read_stage_progress(txn, db::stages::kHeadersKey);
+        txn.commit();
+    }
 
     /// We can store all header hashes into a single byte array given all
     /// hashes are same in length. By consequence we only need to assert
     /// total size of byte array is a multiple of hash length.
     /// The process is mostly the same we have in genesistool.cpp
 
+    // Slot i holds the hash of block i * step: ranges of slots are read in parallel, each slot by a single thread, and
+    // each header still in db is checked against its canonical hash. Hashes stop at the first block with no canonical
+    // hash
+    const BlockNum num_slots{block_max / step + 1};
+    std::vector<evmc::bytes32> hashes(num_slots);
+    std::atomic<BlockNum> first_missing{num_slots};
+    db::parallel_for_block_ranges(
+        env, 0, num_slots - 1, threads, /*ranges_per_thread=*/16,
+        [&](size_t, ::mdbx::txn& txn, BlockNum from, BlockNum to) {
+            auto canonical_hashes{db::open_cursor(txn, db::table::kCanonicalHashes)};
+            auto headers{db::open_cursor(txn, db::table::kHeaders)};
+            for (BlockNum slot{from}; slot <= to && slot < first_missing; ++slot) {
+                const BlockNum block_num{slot * step};
+                const auto data{canonical_hashes.find(db::to_slice(db::block_key(block_num)), false)};
+                if (!data) {
+                    for (BlockNum missing{first_missing}; slot < missing;) {
+                        (void)first_missing.compare_exchange_weak(missing, slot);
+                    }
+                    break;
+                }
+                hashes[slot] = to_bytes32(db::from_slice(data.value));
+                if (!headers.seek(db::to_slice(db::block_key(block_num, hashes[slot].bytes)))) {
+                    continue;  // Frozen into a segment file
+                }
+                const auto header_hash{keccak256(db::from_slice(headers.current().value))};
+                if (std::memcmp(header_hash.bytes, hashes[slot].bytes, kHashLength) != 0) {
+                    throw std::runtime_error("Header of block " + std::to_string(block_num) +
+                                             " does not match its canonical hash");
+                }
+            }
+        });
+
+    if (!first_missing) {
+        throw std::runtime_error("No canonical header found");
+    }
+    hashes.resize(first_missing);
+    const BlockNum max_height{(first_missing - 1) * step};
+
+    if (binary) {
+        PreverifiedHashes::write_file(file_name, std::move(hashes), max_height, step);
+        return;
+    }
+
+    // sorted, so that they are looked up in place
+    std::sort(hashes.begin(), hashes.end());
+
     /// Open the output file
     std::ofstream out_stream{file_name};
     out_stream << "/* Generated by Silkworm toolbox's extract headers */\n"
@@ -921,25 +1284,14 @@ void do_extract_headers(db::EnvConfig& config, const std::string& file_name, uin
                << "#include <cstddef>\n"
                << "static const uint64_t preverified_hashes_mainnet_internal[] = {" << std::endl;
 
-    BlockNum block_max{silkworm::db::stages::read_stage_progress(txn, db::stages::kHeadersKey)};
-    BlockNum max_height{0};
-    auto hashes_table{db::open_cursor(txn, db::table::kCanonicalHashes)};
-
-    for (BlockNum block_num = 0; block_num <= block_max; block_num += step) {
-        auto block_key{db::block_key(block_num)};
-        auto data{hashes_table.find(db::to_slice(block_key), false)};
-        if (!data.done) {
-            break;
-        }
-
-        const uint64_t* chuncks{reinterpret_cast<const uint64_t*>(db::from_slice(data.value).data())};
+    for (const auto& hash : hashes) {
+        const uint64_t* chuncks{reinterpret_cast<const uint64_t*>(hash.bytes)};
         out_stream << "   ";
         for (int i = 0; i < 4; ++i) {
             std::string hex{to_hex(chuncks[i], true)};
             out_stream << hex << ",";
         }
         out_stream << std::endl;
-        max_height = block_num;
     }
 
     out_stream
@@ -990,6 +1342,33 @@ int main(int argc, char* argv[]) {
     auto cmd_freelist = app_main.add_subcommand("freelist", "Print free pages info");
     auto freelist_detail_opt = cmd_freelist->add_flag("--detail", "Gives detail for each FREE_DBI record");
 
+    // Advise on page size and growth step
+    auto cmd_geometry = app_main.add_subcommand("geometry", "Advises page size and growth step from tables shape");
+    std::vector<std::string> cmd_geometry_names{db::table::kPlainState.name, db::table::kHashedStorage.name};
+    cmd_geometry->add_option("--tables", cmd_geometry_names, "Name(s) of tables whose random lookups matter")
+        ->capture_default_str();
+    auto cmd_geometry_cache_opt = cmd_geometry->add_option("--cache", "Memory available to cache tables (e.g. 8GB)")
+                                      ->default_val("8GB")
+                                      ->check([](const std::string& value) -> std::string {
+                                          return parse_size(value) ? "" : "Value " + value + " is not a size";
+                                      });
+
+    // Measure latency of random reads
+    auto cmd_bench_reads = app_main.add_subcommand("bench-reads", "Measures latency of random lookups and scans");
+    std::string cmd_bench_reads_table{db::table::kPlainState.name};
+    size_t cmd_bench_reads_lookups{100'000};
+    size_t cmd_bench_reads_scan{16};
+    uint32_t cmd_bench_reads_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    cmd_bench_reads->add_option("--table", cmd_bench_reads_table, "Name of table to read")->capture_default_str();
+    cmd_bench_reads->add_option("--lookups", cmd_bench_reads_lookups, "Number of random lookups")
+        ->capture_default_str()
+        ->check(CLI::Range(size_t{1}, size_t{1'000'000'000}));
+    cmd_bench_reads->add_option("--scan", cmd_bench_reads_scan, "Records read forward after each lookup (0 none)")
+        ->capture_default_str();
+    cmd_bench_reads->add_option("--threads", cmd_bench_reads_threads, "Number of reading threads")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 1024u));
+
     // Read db schema
     auto cmd_schema = app_main.add_subcommand("schema", "Reports schema version of Silkworm database");
 
@@ -999,6 +1378,10 @@ int main(int argc, char* argv[]) {
     // List migration keys
     auto cmd_migrations = app_main.add_subcommand("migrations", "List migrations");
 
+    // Migrate to compact changesets (schema 4)
+    auto cmd_compact_changesets = app_main.add_subcommand(
+        "compact-changesets", "Rewrites storage changesets in compact form (db no longer readable by Erigon)");
+
     // Clear table tool
     auto cmd_clear = app_main.add_subcommand("clear", "Empties or drops provided named table(s)");
     std::vector<std::string> cmd_clear_names;
@@ -1023,6 +1406,42 @@ int main(int argc, char* argv[]) {
         ->capture_default_str();
     cmd_copy->add_option("--xtables", cmd_copy_xnames, "Don't copy tables matching this list of names")
         ->capture_default_str();
+    auto cmd_copy_pagesize_opt = cmd_copy->add_option("--pagesize", "Page size of target db if created")
+                                     ->default_val("4KB")
+                                     ->check([](const std::string& value) -> std::string {
+                                         const auto size{parse_size(value)};
+                                         return size && std::has_single_bit(*size) && *size >= db::kMinPageSize &&
+                                                        *size <= db::kMaxPageSize
+                                                    ? ""
+                                                    : "Value " + value + " is not a power of 2 in [256B - 64KB]";
+                                     });
+
+    // Move immutable blocks into segment files
+    auto cmd_freeze = app_main.add_subcommand("freeze", "Writes immutable canonical blocks into a segment file")
+                          ->excludes(app_dry_opt);
+    auto cmd_freeze_from_opt =
+        cmd_freeze->add_option("--from", "First block to freeze")->required()->check(CLI::Range(0u, UINT32_MAX));
+    auto cmd_freeze_to_opt =
+        cmd_freeze->add_option("--to", "Last block to freeze")->required()->check(CLI::Range(0u, UINT32_MAX));
+    auto cmd_freeze_prune_opt = cmd_freeze->add_flag("--prune", "Erase frozen headers and bodies from db");
+
+    // Export state snapshot
+    auto cmd_export_state =
+        app_main.add_subcommand("export-state", "Exports the state at Execution progress into a state snapshot")
+            ->excludes(app_dry_opt);
+    auto cmd_export_state_dir_opt =
+        cmd_export_state->add_option("--target", "Directory the snapshot is written into")->required();
+    uint32_t cmd_export_state_threads{std::max(std::thread::hardware_concurrency(), 1u)};
+    cmd_export_state->add_option("--threads", cmd_export_state_threads, "Number of key ranges exported in parallel")
+        ->capture_default_str()
+        ->check(CLI::Range(1u, 1024u));
+    auto cmd_export_state_chunk_opt =
+        cmd_export_state->add_option("--chunk-size", "Raw size chunk files are closed at (e.g. 32MB)")
+            ->default_val("32MB")
+            ->check([](const std::string& value) -> std::string {
+                const auto size{parse_size(value)};
+                return size && *size && *size <= 1_Gibi ? "" : "Value " + value + " is not a size up to 1GB";
+            });
 
     // Stages tool
     auto cmd_stageset = app_main.add_subcommand("stage-set", "Sets a stage to a new height");
@@ -1055,6 +1474,11 @@ int main(int argc, char* argv[]) {
     auto cmd_extract_headers_step_opt = cmd_extract_headers->add_option("--step", "Step every this number of blocks")
                                             ->default_val("100000")
                                             ->check(CLI::Range(1u, UINT32_MAX));
+    auto cmd_extract_headers_binary_opt = cmd_extract_headers->add_flag(
+        "--binary", "Write a binary file, to be used with --preverified.hashes.file, instead of a .cpp file");
+    auto cmd_extract_headers_threads_opt = cmd_extract_headers->add_option("--threads", "Number of reading threads")
+                                               ->default_val(std::max(std::thread::hardware_concurrency(), 1u))
+                                               ->check(CLI::Range(1u, 1024u));
 
     /*
      * Parse arguments and validate
@@ -1099,6 +1523,11 @@ int main(int argc, char* argv[]) {
             } else {
                 do_tables(src_config);
             }
+        } else if (*cmd_geometry) {
+            do_geometry(src_config, cmd_geometry_names, parse_size(cmd_geometry_cache_opt->as<std::string>()).value());
+        } else if (*cmd_bench_reads) {
+            do_bench_reads(src_config, cmd_bench_reads_table, cmd_bench_reads_lookups, cmd_bench_reads_scan,
+                           cmd_bench_reads_threads);
         } else if (*cmd_freelist) {
             do_freelist(src_config, static_cast<bool>(*freelist_detail_opt));
         } else if (*cmd_schema) {
@@ -1107,6 +1536,8 @@ int main(int argc, char* argv[]) {
             do_stages(src_config);
         } else if (*cmd_migrations) {
             do_migrations(src_config);
+        } else if (*cmd_compact_changesets) {
+            do_compact_changesets(src_config, static_cast<bool>(*app_dry_opt));
         } else if (*cmd_clear) {
             do_clear(src_config, static_cast<bool>(*app_dry_opt), static_cast<bool>(*app_yes_opt), cmd_clear_names,
                      static_cast<bool>(*cmd_clear_drop_opt));
@@ -1116,7 +1547,13 @@ int main(int argc, char* argv[]) {
         } else if (*cmd_copy) {
             do_copy(src_config, cmd_copy_targetdir_opt->as<std::string>(),
                     static_cast<bool>(*cmd_copy_target_create_opt), static_cast<bool>(*cmd_copy_target_noempty_opt),
-                    cmd_copy_names, cmd_copy_xnames);
+                    cmd_copy_names, cmd_copy_xnames, parse_size(cmd_copy_pagesize_opt->as<std::string>()).value());
+        } else if (*cmd_export_state) {
+            do_export_state(src_config, cmd_export_state_dir_opt->as<std::string>(), cmd_export_state_threads,
+                            parse_size(cmd_export_state_chunk_opt->as<std::string>()).value());
+        } else if (*cmd_freeze) {
+            do_freeze(src_config, data_dir, cmd_freeze_from_opt->as<BlockNum>(), cmd_freeze_to_opt->as<BlockNum>(),
+                      static_cast<bool>(*cmd_freeze_prune_opt));
         } else if (*cmd_stageset) {
             do_stage_set(src_config, cmd_stageset_name_opt->as<std::string>(), cmd_stageset_height_opt->as<uint32_t>(),
                          static_cast<bool>(*app_dry_opt));
@@ -1135,7 +1572,8 @@ int main(int argc, char* argv[]) {
             do_first_byte_analysis(src_config);
         } else if (*cmd_extract_headers) {
             do_extract_headers(src_config, cmd_extract_headers_file_opt->as<std::string>(),
-                               cmd_extract_headers_step_opt->as<uint32_t>());
+                               cmd_extract_headers_step_opt->as<uint32_t>(), *cmd_extract_headers_binary_opt,
+                               cmd_extract_headers_threads_opt->as<uint32_t>());
         }
 
         return 0;
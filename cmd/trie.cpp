@@ -51,7 +51,8 @@ int main(int argc, char* argv[]) {
         db::EnvConfig db_config{data_dir.chaindata().path().string()};
         auto env{db::open_env(db_config)};
         auto txn{env.start_write()};
-        evmc::bytes32 state_root{trie::regenerate_intermediate_hashes(txn, data_dir.etl().path().string().c_str())};
+        evmc::bytes32 state_root{
+            trie::regenerate_intermediate_hashes_sharded(txn, data_dir.etl().path().string().c_str())};
 
         log::Info() << "State root " << to_hex(state_root);
         txn.commit();
@@ -40,7 +40,10 @@ intx::uint128 intrinsic_gas(const Transaction& txn, bool homestead, bool istanbu
         return gas;
     }
 
-    intx::uint128 non_zero_bytes{as_range::count_if(txn.data, [](char c) { return c != 0; })};
+    if (!txn.non_zero_data_bytes) {
+        txn.non_zero_data_bytes = static_cast<uint64_t>(as_range::count_if(txn.data, [](char c) { return c != 0; }));
+    }
+    intx::uint128 non_zero_bytes{*txn.non_zero_data_bytes};
 
     uint64_t nonZeroGas{istanbul ? fee::kGTxDataNonZeroIstanbul : fee::kGTxDataNonZeroFrontier};
     gas += non_zero_bytes * nonZeroGas;
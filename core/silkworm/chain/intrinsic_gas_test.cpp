@@ -18,6 +18,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+
 #include "protocol_param.hpp"
 
 namespace silkworm {
@@ -52,4 +55,25 @@ TEST_CASE("EIP-2930 intrinsic gas") {
     CHECK(g0 == fee::kGTransaction + 2 * fee::kAccessListAddressCost + 2 * fee::kAccessListStorageKeyCost);
 }
 
+TEST_CASE("Intrinsic gas of call data") {
+    Transaction txn{};
+    txn.data = *from_hex("0001000200");
+
+    const intx::uint128 expected_g0{fee::kGTransaction + 3 * fee::kGTxDataZero + 2 * fee::kGTxDataNonZeroIstanbul};
+    CHECK(intrinsic_gas(txn, /*homestead=*/true, /*istanbul=*/true) == expected_g0);
+    CHECK(txn.non_zero_data_bytes == 2);
+
+    // The count is reused, e.g. by execution after validation
+    CHECK(intrinsic_gas(txn, /*homestead=*/true, /*istanbul=*/true) == expected_g0);
+    CHECK(intrinsic_gas(txn, /*homestead=*/true, /*istanbul=*/false) ==
+          fee::kGTransaction + 3 * fee::kGTxDataZero + 2 * fee::kGTxDataNonZeroFrontier);
+
+    // Decoding into the transaction drops the count
+    Bytes encoded;
+    rlp::encode(encoded, txn);
+    ByteView view{encoded};
+    REQUIRE(rlp::decode(view, txn) == DecodingResult::kOk);
+    CHECK_FALSE(txn.non_zero_data_bytes);
+}
+
 }  // namespace silkworm
@@ -0,0 +1,58 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "address_hash_cache.hpp"
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+AddressHashCache& AddressHashCache::instance() {
+    static AddressHashCache cache;
+    return cache;
+}
+
+evmc::bytes32 AddressHashCache::hash(const evmc::address& address) {
+    {
+        std::scoped_lock lock{mutex_};
+        if (const evmc::bytes32* cached{cache_.get(address)}; cached) {
+            return *cached;
+        }
+    }
+    // Hash outside the lock: concurrent misses on the same address just compute it twice
+    const evmc::bytes32 hash{bit_cast<evmc_bytes32>(keccak256(address.bytes))};
+    std::scoped_lock lock{mutex_};
+    cache_.put(address, hash);
+    return hash;
+}
+
+size_t AddressHashCache::size() const {
+    std::scoped_lock lock{mutex_};
+    return cache_.size();
+}
+
+void AddressHashCache::clear() {
+    std::scoped_lock lock{mutex_};
+    cache_.clear();
+}
+
+AddressHashCache::Stats AddressHashCache::stats() const {
+    std::scoped_lock lock{mutex_};
+    return cache_.stats();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,61 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <mutex>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/tinylfu_cache.hpp>
+
+namespace silkworm {
+
+/** @brief Memoizes keccak256 of account addresses.
+ *
+ * The same addresses recur across the change sets of consecutive blocks and get hashed over and over by HashState
+ * (forward and unwind) and by the trie prefix sets: a frequency-based cache of their hashes saves most of those
+ * keccak256 runs. Thread-safe, so that a single process-wide instance can be shared by stages.
+ */
+class AddressHashCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{100'000};
+
+    using Stats = tinylfu_cache<evmc::address, evmc::bytes32>::Stats;
+
+    explicit AddressHashCache(size_t max_size = kDefaultMaxSize) : cache_{max_size} {}
+
+    // Not copyable nor movable
+    AddressHashCache(const AddressHashCache&) = delete;
+    AddressHashCache& operator=(const AddressHashCache&) = delete;
+
+    //! \brief The process-wide instance shared by HashState and trie computations
+    static AddressHashCache& instance();
+
+    //! \brief Returns keccak256 of address, computing and caching it on miss
+    [[nodiscard]] evmc::bytes32 hash(const evmc::address& address);
+
+    [[nodiscard]] size_t size() const;
+
+    void clear();
+
+    [[nodiscard]] Stats stats() const;
+
+  private:
+    mutable std::mutex mutex_;  // Guards cache_ (lookups update frequencies and recency)
+    tinylfu_cache<evmc::address, evmc::bytes32> cache_;
+};
+
+}  // namespace silkworm
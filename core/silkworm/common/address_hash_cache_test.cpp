@@ -0,0 +1,45 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "address_hash_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+TEST_CASE("AddressHashCache") {
+    AddressHashCache cache{/*max_size=*/10};
+    const auto address{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+    const auto expected{to_bytes32(keccak256(address.bytes).bytes)};
+
+    CHECK(cache.hash(address) == expected);
+    CHECK(cache.stats().misses == 1);
+    CHECK(cache.size() == 1);
+
+    CHECK(cache.hash(address) == expected);
+    CHECK(cache.stats().hits == 1);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.hash(address) == expected);
+
+    CHECK(AddressHashCache::instance().hash(address) == expected);
+    CHECK(&AddressHashCache::instance() == &AddressHashCache::instance());
+}
+
+}  // namespace silkworm
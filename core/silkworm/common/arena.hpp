@@ -0,0 +1,104 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace silkworm {
+
+/** @brief Monotonic memory arena: allocations bump a pointer within large chunks and are never freed individually.
+ *
+ * All memory is released at once by reset(), which retains the chunks for reuse, so that in steady state
+ * allocating from the arena does not hit the heap at all.
+ * Objects created with create() are not destroyed by the arena: destructors, if non-trivial, must be invoked
+ * explicitly before reset().
+ */
+class MonotonicArena {
+  public:
+    static constexpr size_t kDefaultChunkSize{64 * 1024};
+
+    explicit MonotonicArena(size_t chunk_size = kDefaultChunkSize) : chunk_size_{chunk_size} {}
+
+    // Not copyable nor movable
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        while (current_ < chunks_.size()) {
+            if (void* ptr{allocate_in(chunks_[current_], size, alignment)}; ptr != nullptr) {
+                return ptr;
+            }
+            ++current_;
+            offset_ = 0;
+        }
+        // Oversized requests get a dedicated chunk
+        chunks_.push_back(Chunk{std::make_unique<std::byte[]>(std::max(chunk_size_, size + alignment)),
+                                std::max(chunk_size_, size + alignment)});
+        current_ = chunks_.size() - 1;
+        offset_ = 0;
+        return allocate_in(chunks_[current_], size, alignment);
+    }
+
+    template <class T, class... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    //! \brief Makes all the memory available again for allocation
+    void reset() noexcept {
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    //! \brief Overall memory reserved by the arena
+    [[nodiscard]] size_t capacity() const noexcept {
+        size_t capacity{0};
+        for (const auto& chunk : chunks_) {
+            capacity += chunk.size;
+        }
+        return capacity;
+    }
+
+  private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size{0};
+    };
+
+    void* allocate_in(Chunk& chunk, size_t size, size_t alignment) noexcept {
+        const auto base{reinterpret_cast<uintptr_t>(chunk.data.get())};
+        const uintptr_t aligned{(base + offset_ + alignment - 1) & ~(uintptr_t{alignment} - 1)};
+        if (aligned + size > base + chunk.size) {
+            return nullptr;
+        }
+        offset_ = aligned + size - base;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    const size_t chunk_size_;
+    std::vector<Chunk> chunks_;
+    size_t current_{0};  // Chunk being allocated from
+    size_t offset_{0};   // First free byte within current chunk
+};
+
+}  // namespace silkworm
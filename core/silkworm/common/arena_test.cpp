@@ -0,0 +1,65 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "arena.hpp"
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("MonotonicArena") {
+    MonotonicArena arena{/*chunk_size=*/128};
+
+    SECTION("Alignment") {
+        (void)arena.allocate(1, 1);
+        void* ptr{arena.allocate(8, 8)};
+        CHECK(reinterpret_cast<uintptr_t>(ptr) % 8 == 0);
+        ptr = arena.allocate(16, 16);
+        CHECK(reinterpret_cast<uintptr_t>(ptr) % 16 == 0);
+    }
+
+    SECTION("Objects") {
+        auto* str{arena.create<std::string>("arena")};
+        auto* num{arena.create<uint64_t>(42)};
+        CHECK(*str == "arena");
+        CHECK(*num == 42);
+        std::destroy_at(str);
+    }
+
+    SECTION("Chunks are reused after reset") {
+        for (int i{0}; i < 100; ++i) {
+            (void)arena.allocate(32, 8);
+        }
+        const size_t capacity{arena.capacity()};
+        CHECK(capacity >= 100 * 32);
+
+        arena.reset();
+        for (int i{0}; i < 100; ++i) {
+            (void)arena.allocate(32, 8);
+        }
+        CHECK(arena.capacity() == capacity);
+    }
+
+    SECTION("Oversized allocation") {
+        void* ptr{arena.allocate(1'000, 8)};
+        CHECK(ptr != nullptr);
+        CHECK(arena.capacity() >= 1'000);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,125 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <silkworm/common/lru_cache.hpp>
+
+namespace silkworm {
+
+/** @brief Thread-safe cache made of shards, each one a cache_t (lru_cache by default) guarded by its own mutex.
+ *
+ * A key always goes to the same shard, picked from its hash, so that threads working on different keys seldom
+ * contend on the same lock. Eviction is per shard: each one holds up to max_size / num_shards entries, and the
+ * least recently used entry of the whole cache is only approximately the first one to go.
+ * The interface mirrors lru_cache, but for get(): values are returned as copies, as a pointer into a shard would be
+ * left unprotected once its lock released. Cheaply copyable values (e.g. shared_ptr) are thus preferable.
+ */
+template <typename key_t, typename value_t, template <typename, typename> class cache_t = lru_cache,
+          typename hash_t = std::hash<key_t>>
+class concurrent_lru_cache {
+  public:
+    static constexpr size_t kDefaultNumShards{16};
+
+    //! \param num_shards : rounded up to a power of 2, though small caches get fewer shards than entries
+    explicit concurrent_lru_cache(size_t max_size, size_t num_shards = kDefaultNumShards) {
+        size_t shards{1};
+        while (shards < num_shards && shards * 2 <= max_size) {
+            shards <<= 1;
+        }
+        mask_ = shards - 1;
+        const size_t max_shard_size{(max_size + shards - 1) / shards};
+        shards_.reserve(shards);
+        for (size_t i{0}; i < shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>(max_shard_size));
+        }
+    }
+
+    // Not copyable nor movable
+    concurrent_lru_cache(const concurrent_lru_cache&) = delete;
+    concurrent_lru_cache& operator=(const concurrent_lru_cache&) = delete;
+
+    void put(const key_t& key, const value_t& value) {
+        Shard& shard{shard_of(key)};
+        std::scoped_lock lock{shard.mutex};
+        shard.cache.put(key, value);
+    }
+
+    std::optional<value_t> get_as_copy(const key_t& key) {
+        Shard& shard{shard_of(key)};
+        std::scoped_lock lock{shard.mutex};
+        return shard.cache.get_as_copy(key);
+    }
+
+    bool remove(const key_t& key) {
+        Shard& shard{shard_of(key)};
+        std::scoped_lock lock{shard.mutex};
+        return shard.cache.remove(key);
+    }
+
+    //! \remarks Not a snapshot: shards are visited one after the other
+    [[nodiscard]] size_t size() const {
+        size_t total{0};
+        for (const auto& shard : shards_) {
+            std::scoped_lock lock{shard->mutex};
+            total += shard->cache.size();
+        }
+        return total;
+    }
+
+    void clear() {
+        for (const auto& shard : shards_) {
+            std::scoped_lock lock{shard->mutex};
+            shard->cache.clear();
+        }
+    }
+
+    [[nodiscard]] size_t num_shards() const noexcept { return shards_.size(); }
+
+  private:
+    static constexpr size_t kCacheLineSize{64};
+
+    // Aligned so that the mutexes of different shards do not share a cache line
+    struct alignas(kCacheLineSize) Shard {
+        explicit Shard(size_t max_size) : cache{max_size} {}
+        mutable std::mutex mutex;
+        cache_t<key_t, value_t> cache;
+    };
+
+    Shard& shard_of(const key_t& key) const noexcept {
+        // Finalizer of MurmurHash3, as std::hash may be the identity (e.g. on integers)
+        uint64_t h{hash_t{}(key)};
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccd;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53;
+        h ^= h >> 33;
+        return *shards_[static_cast<size_t>(h) & mask_];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t mask_{0};
+};
+
+}  // namespace silkworm
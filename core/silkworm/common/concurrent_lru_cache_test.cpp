@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "concurrent_lru_cache.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/tinylfu_cache.hpp>
+
+namespace silkworm {
+
+TEST_CASE("concurrent_lru_cache") {
+    SECTION("same interface as lru_cache") {
+        concurrent_lru_cache<int, int> cache{64, 4};
+        CHECK(cache.num_shards() == 4);
+        CHECK_FALSE(cache.get_as_copy(7));
+
+        cache.put(7, 777);
+        CHECK(cache.get_as_copy(7) == 777);
+        cache.put(7, 778);
+        CHECK(cache.get_as_copy(7) == 778);
+        CHECK(cache.size() == 1);
+
+        CHECK(cache.remove(7));
+        CHECK_FALSE(cache.remove(7));
+        CHECK(cache.size() == 0);
+
+        for (int i{0}; i < 10; ++i) cache.put(i, i);
+        cache.clear();
+        CHECK(cache.size() == 0);
+    }
+
+    SECTION("capacity is split among shards") {
+        concurrent_lru_cache<int, int> cache{64, 3};
+        CHECK(cache.num_shards() == 4);
+        for (int i{0}; i < 1'000; ++i) cache.put(i, i);
+        CHECK(cache.size() <= 64);
+        CHECK(cache.size() > 32);
+        CHECK(cache.get_as_copy(999) == 999);  // the most recent entry of its shard
+
+        concurrent_lru_cache<int, int> small_cache{2};
+        CHECK(small_cache.num_shards() == 2);
+    }
+
+    SECTION("other replacement policy") {
+        concurrent_lru_cache<int, int, tinylfu_cache> cache{1'000};
+        cache.put(1, 10);
+        CHECK(cache.get_as_copy(1) == 10);
+    }
+
+    SECTION("shared by threads") {
+        constexpr int kThreads{4};
+        constexpr int kKeys{2'000};
+        concurrent_lru_cache<int, int> cache{kKeys};
+        std::atomic<int> mismatches{0};  // Catch assertions are not thread safe
+        std::vector<std::thread> threads;
+        for (int t{0}; t < kThreads; ++t) {
+            threads.emplace_back([&cache, &mismatches, t] {
+                for (int i{0}; i < kKeys; ++i) {
+                    const int key{(i * kThreads + t) % kKeys};
+                    if (const auto value{cache.get_as_copy(key)}; value) {
+                        if (*value != key * 10) ++mismatches;
+                    } else {
+                        cache.put(key, key * 10);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(mismatches == 0);
+        CHECK(cache.size() <= kKeys + cache.num_shards());
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,69 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace silkworm {
+
+/** @brief Standard allocator keeping track of the bytes currently allocated through it (and its copies).
+ *
+ * Makes the actual footprint of containers (e.g. slots and control bytes of hash tables, nodes of trees)
+ * measurable: pass the same counter to all the containers which must be accounted together.
+ * Memory is obtained from a stateless Base allocator (std::allocator by default).
+ * Not thread-safe: the counter is a plain integer.
+ */
+template <class T, template <class> class Base = std::allocator>
+class CountingAllocator {
+  public:
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = CountingAllocator<U, Base>;
+    };
+
+    //! \param counter : the counter to update; must outlive all the allocations
+    explicit CountingAllocator(size_t* counter) noexcept : counter_{counter} {}
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U, Base>& other) noexcept : counter_{other.counter()} {}  // NOLINT
+
+    [[nodiscard]] T* allocate(size_t n) {
+        T* ptr{Base<T>{}.allocate(n)};
+        *counter_ += n * sizeof(T);
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        *counter_ -= n * sizeof(T);
+        Base<T>{}.deallocate(ptr, n);
+    }
+
+    [[nodiscard]] size_t* counter() const noexcept { return counter_; }
+
+    template <class U>
+    friend bool operator==(const CountingAllocator& a, const CountingAllocator<U, Base>& b) noexcept {
+        return a.counter_ == b.counter();
+    }
+
+  private:
+    size_t* counter_;
+};
+
+}  // namespace silkworm
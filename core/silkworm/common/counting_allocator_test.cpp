@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "counting_allocator.hpp"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("CountingAllocator") {
+    size_t allocated{0};
+
+    SECTION("Vector") {
+        {
+            std::vector<uint64_t, CountingAllocator<uint64_t>> v{CountingAllocator<uint64_t>{&allocated}};
+            v.reserve(100);
+            CHECK(allocated == 100 * sizeof(uint64_t));
+            v.shrink_to_fit();
+            CHECK(allocated == 0);
+        }
+        CHECK(allocated == 0);
+    }
+
+    SECTION("Rebound allocators share the counter") {
+        using Alloc = CountingAllocator<std::pair<const int, int>>;
+        std::map<int, int, std::less<int>, Alloc> tree{Alloc{&allocated}};
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, Alloc> table{Alloc{&allocated}};
+        for (int i{0}; i < 1000; ++i) {
+            tree.emplace(i, i);
+            table.emplace(i, i);
+        }
+        CHECK(allocated > 2000 * sizeof(std::pair<const int, int>));
+        tree.clear();
+        table = decltype(table){Alloc{&allocated}};
+        CHECK(allocated < 1000 * sizeof(std::pair<const int, int>));  // At most an empty bucket array is left
+    }
+
+    SECTION("Equality") {
+        size_t other{0};
+        CHECK(CountingAllocator<int>{&allocated} == CountingAllocator<char>{&allocated});
+        CHECK_FALSE(CountingAllocator<int>{&allocated} == CountingAllocator<int>{&other});
+    }
+}
+
+}  // namespace silkworm
@@ -20,22 +20,20 @@
 
 namespace silkworm::endian {
 
+// Leading zeros are counted off the value (see intx::count_significant_bytes) rather than searched in its bytes
+
 ByteView to_big_compact(const uint64_t value) {
-    if (!value) {
-        return {};
-    }
     SILKWORM_THREAD_LOCAL uint8_t full_be[sizeof(uint64_t)];
     store_big_u64(&full_be[0], value);
-    return zeroless_view(full_be);
+    const size_t length{intx::count_significant_bytes(value)};
+    return {&full_be[sizeof(uint64_t) - length], length};
 }
 
 ByteView to_big_compact(const intx::uint256& value) {
-    if (!value) {
-        return {};
-    }
     SILKWORM_THREAD_LOCAL uint8_t full_be[sizeof(intx::uint256)];
     intx::be::store(full_be, value);
-    return zeroless_view(full_be);
+    const size_t length{intx::count_significant_bytes(value)};
+    return {&full_be[sizeof(intx::uint256) - length], length};
 }
 
 }  // namespace silkworm::endian
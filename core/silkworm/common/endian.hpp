@@ -58,6 +58,9 @@ const auto store_big_u32 = intx::be::unsafe::store<uint32_t>;
 // Similar to boost::endian::store_big_u64
 const auto store_big_u64 = intx::be::unsafe::store<uint64_t>;
 
+// Similar to boost::endian::store_little_u64
+const auto store_little_u64 = intx::le::unsafe::store<uint64_t>;
+
 //! \brief Transforms a uint64_t stored in memory with native endianness to it's compacted big endian byte form
 //! \param [in] value : the value to be transformed
 //! \return A ByteView (std::string_view) into an internal static buffer (thread specific) of the function
@@ -76,6 +79,19 @@ ByteView to_big_compact(uint64_t value);
 //! \remarks A "compact" big endian form strips leftmost bytes valued to zero
 ByteView to_big_compact(const intx::uint256& value);
 
+//! \brief Stores the compacted big endian form of an unsigned integer at the front of out
+//! \param [out] out : must have room for sizeof(T) bytes, whatever the value
+//! \return The number of bytes stored, zero for a zero value
+//! \remarks The full width is stored first and its significant bytes then copied: no loop over the leading zeros
+template <UnsignedIntegral T>
+inline size_t store_big_compact(uint8_t* out, const T& value) noexcept {
+    uint8_t full_be[sizeof(T)];
+    intx::be::unsafe::store(full_be, value);
+    const size_t length{intx::count_significant_bytes(value)};
+    std::memcpy(out, full_be + sizeof(T) - length, length);
+    return length;
+}
+
 //! \brief Parses unsigned integer from a compacted big endian byte form.
 //! \param [in] data : byte view of a compacted value.
 //! Its length must not be greater than the sizeof the UnsignedIntegral type; otherwise, kOverflow is returned.
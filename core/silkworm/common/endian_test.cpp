@@ -135,6 +135,12 @@ TEST_CASE("Block as key and compact form") {
         // Try retrieve a compacted value from an empty Byte string
         REQUIRE(from_big_compact(Bytes{}, out64) == DecodingResult::kOk);
         CHECK(out64 == 0u);
+        // Compact form stored into a buffer
+        uint8_t buffer[sizeof(intx::uint256)];
+        CHECK(to_hex({buffer, store_big_compact(buffer, block_number)}) == "5485ffde");
+        CHECK(store_big_compact(buffer, uint64_t{0}) == 0);
+        CHECK(to_hex({buffer, store_big_compact(buffer, intx::uint256{block_number} << 128)}) ==
+              "5485ffde00000000000000000000000000000000");
         // Try retrieve a compacted value from a too large Byte string
         Bytes extra_long_bytes(sizeof(uint64_t) + 1, 0);
         CHECK(from_big_compact(extra_long_bytes, out64) == DecodingResult::kOverflow);
@@ -16,6 +16,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <evmc/evmc.hpp>
+
 #if defined(__wasm__)
 
 #include <unordered_map>
@@ -45,34 +51,77 @@ and https://abseil.io/docs/cpp/guides/container#fn:pointer-stability
 
 N.B. FlatHashMap is generally faster than NodeHashMap,
 so prefer it unless you need pointer stability.
+
+Keys of fixed size that are (nearly) uniformly distributed do not need the generic hasher,
+see AddressHasher and DigestHasher below, as well as FlatAddressMap and FlatAddressSet.
 */
 
+namespace detail {
+
+inline uint64_t load64(const uint8_t* data) noexcept {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+inline uint32_t load32(const uint8_t* data) noexcept {
+    uint32_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+}  // namespace detail
+
+//! \brief Hasher of addresses, which are keccak-derived bar a few (e.g. precompiles) made of zeros but their last
+//! bytes: folding their three words with one multiplication is enough
+struct AddressHasher {
+    size_t operator()(const evmc::address& address) const noexcept {
+        const uint64_t folded{detail::load64(address.bytes) ^ detail::load64(address.bytes + 8) ^
+                              detail::load32(address.bytes + 16)};
+        const uint64_t product{folded * 0x9e3779b97f4a7c15};  // 2^64 / golden ratio
+        return static_cast<size_t>(product ^ (product >> 32));  // low bits depend on all of them too
+    }
+};
+
+//! \brief Hasher of keys which are digests (e.g. code hashes): any 8 of their bytes already make a good hash
+//! \attention Not for keys which can be freely chosen, such as storage locations: colliding ones would be trivial
+struct DigestHasher {
+    size_t operator()(const evmc::bytes32& digest) const noexcept {
+        return static_cast<size_t>(detail::load64(digest.bytes));
+    }
+};
+
 #if defined(__wasm__)
 
 // Abseil is not compatible with Wasm due to its mutli-threading features,
 // at least not under CMake, but see
 // https://github.com/abseil/abseil-cpp/pull/721
 
-template <class K, class V>
-using FlatHashMap = std::unordered_map<K, V>;
+template <class K, class V, class Hash = std::hash<K>>
+using FlatHashMap = std::unordered_map<K, V, Hash>;
 
-template <class T>
-using FlatHashSet = std::unordered_set<T>;
+template <class T, class Hash = std::hash<T>>
+using FlatHashSet = std::unordered_set<T, Hash>;
 
-template <class K, class V>
-using NodeHashMap = std::unordered_map<K, V>;
+template <class K, class V, class Hash = std::hash<K>>
+using NodeHashMap = std::unordered_map<K, V, Hash>;
 
 #else
 
-template <class K, class V>
-using FlatHashMap = absl::flat_hash_map<K, V>;
+template <class K, class V, class Hash = typename absl::flat_hash_map<K, V>::hasher>
+using FlatHashMap = absl::flat_hash_map<K, V, Hash>;
 
-template <class T>
-using FlatHashSet = absl::flat_hash_set<T>;
+template <class T, class Hash = typename absl::flat_hash_set<T>::hasher>
+using FlatHashSet = absl::flat_hash_set<T, Hash>;
 
-template <class K, class V>
-using NodeHashMap = absl::node_hash_map<K, V>;
+template <class K, class V, class Hash = typename absl::node_hash_map<K, V>::hasher>
+using NodeHashMap = absl::node_hash_map<K, V, Hash>;
 
 #endif
 
+template <class V>
+using FlatAddressMap = FlatHashMap<evmc::address, V, AddressHasher>;
+
+using FlatAddressSet = FlatHashSet<evmc::address, AddressHasher>;
+
 }  // namespace silkworm
@@ -0,0 +1,53 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "hash_maps.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("AddressHasher") {
+    using evmc::literals::operator""_address;
+
+    const AddressHasher hasher;
+    FlatHashSet<size_t> low_bits;
+    for (uint8_t i{1}; i <= 9; ++i) {  // precompiles only differ in their last byte
+        evmc::address precompile{};
+        precompile.bytes[19] = i;
+        low_bits.insert(hasher(precompile) & 0x7f);
+    }
+    CHECK(low_bits.size() == 9);
+
+    FlatAddressMap<int> map;
+    map[0x00000000219ab540356cbb839cbe05303d7705fa_address] = 1;
+    map[0xc02aaa39b223fe8d0a0e5c4f27ead9083c756cc2_address] = 2;
+    CHECK(map.at(0xc02aaa39b223fe8d0a0e5c4f27ead9083c756cc2_address) == 2);
+    CHECK_FALSE(map.contains(0xa0b86991c6218b36c1d19d4a2e9eb0ce3606eb48_address));
+}
+
+TEST_CASE("DigestHasher") {
+    using evmc::literals::operator""_bytes32;
+
+    const auto digest{0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470_bytes32};
+    CHECK(DigestHasher{}(digest) == detail::load64(digest.bytes));
+
+    NodeHashMap<evmc::bytes32, int, DigestHasher> map;
+    map[digest] = 1;
+    CHECK(map.at(digest) == 1);
+}
+
+}  // namespace silkworm
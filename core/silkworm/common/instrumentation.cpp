@@ -0,0 +1,90 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace silkworm::instrumentation {
+
+// Probes are only ever added, at the head: a lock-free list
+static std::atomic<Probe*> probes_{nullptr};
+
+// Reference point to convert ticks into time
+static const auto kStartTicks{ticks()};
+static const auto kStartTime{std::chrono::steady_clock::now()};
+
+Probe::Probe(std::string_view name) noexcept : name_{name} {
+    Probe* head{probes_.load(std::memory_order_relaxed)};
+    do {
+        next_ = head;
+    } while (!probes_.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint64_t Probe::count() const noexcept {
+    uint64_t total{0};
+    for (const Slot& slot : slots_) {
+        total += slot.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t Probe::elapsed_ticks() const noexcept {
+    uint64_t total{0};
+    for (const Slot& slot : slots_) {
+        total += slot.ticks.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Probe::reset() noexcept {
+    for (Slot& slot : slots_) {
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.ticks.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<Sample> report() {
+    const auto elapsed_ticks{ticks() - kStartTicks};
+    const auto elapsed_time{std::chrono::steady_clock::now() - kStartTime};
+    const double ns_per_tick{
+        elapsed_ticks ? static_cast<double>(elapsed_time.count()) / static_cast<double>(elapsed_ticks) : 1.0};
+
+    std::map<std::string_view, std::pair<uint64_t, uint64_t>> by_name;  // Count and ticks
+    for (const Probe* probe{probes_.load(std::memory_order_acquire)}; probe; probe = probe->next()) {
+        auto& [count, probe_ticks]{by_name[probe->name()]};
+        count += probe->count();
+        probe_ticks += probe->elapsed_ticks();
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(by_name.size());
+    for (const auto& [name, values] : by_name) {
+        const auto ns{static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(values.second) * ns_per_tick)};
+        samples.push_back({name, values.first, std::chrono::nanoseconds{ns}});
+    }
+    std::stable_sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) { return a.time > b.time; });
+    return samples;
+}
+
+void reset() noexcept {
+    for (Probe* probe{probes_.load(std::memory_order_acquire)}; probe; probe = probe->next()) {
+        probe->reset();
+    }
+}
+
+}  // namespace silkworm::instrumentation
@@ -0,0 +1,163 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+/*
+Hot path instrumentation: named counters and scoped timers, aggregated process-wide
+
+    void Buffer::read_account(...) {
+        SILK_SCOPED_TIMER("db::Buffer::read_account");
+        ...
+        SILK_COUNT("db::Buffer::account_misses", 1);
+    }
+
+Each site owns a static Probe, registered on first use, whose values are spread over per-thread slots so that
+threads hitting the same site do not contend on a cache line. Timers read the time stamp counter (RDTSC) where
+available and steady_clock elsewhere; ticks are converted to time only when reporting.
+
+Everything compiles to nothing unless SILKWORM_INSTRUMENTATION is defined (CMake option of the same name).
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace silkworm::instrumentation {
+
+#if defined(SILKWORM_INSTRUMENTATION)
+inline constexpr bool kEnabled{true};
+#else
+inline constexpr bool kEnabled{false};
+#endif
+
+//! \brief Raw time stamp: CPU cycles where RDTSC is available, steady_clock nanoseconds otherwise
+inline uint64_t ticks() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+//! \brief Values of one instrumented site
+class Probe {
+  public:
+    static constexpr size_t kThreadSlots{32};
+
+    //! \param name : must outlive the probe (i.e. a literal); probes of the same name are reported together
+    explicit Probe(std::string_view name) noexcept;
+
+    // Not copyable nor movable: registered by address
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+
+    void add(uint64_t count, uint64_t elapsed_ticks) noexcept {
+        Slot& slot{slots_[thread_slot()]};
+        slot.count.fetch_add(count, std::memory_order_relaxed);
+        slot.ticks.fetch_add(elapsed_ticks, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::string_view name() const noexcept { return name_; }
+    [[nodiscard]] uint64_t count() const noexcept;
+    [[nodiscard]] uint64_t elapsed_ticks() const noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] Probe* next() const noexcept { return next_; }
+
+  private:
+    static constexpr size_t kCacheLineSize{64};
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> ticks{0};
+    };
+
+    // Threads take slots round robin: slots are only shared past kThreadSlots threads
+    static size_t thread_slot() noexcept {
+        thread_local const size_t slot{next_thread_slot_.fetch_add(1, std::memory_order_relaxed) % kThreadSlots};
+        return slot;
+    }
+
+    static inline std::atomic<size_t> next_thread_slot_{0};
+
+    std::string_view name_;
+    std::array<Slot, kThreadSlots> slots_{};
+    Probe* next_{nullptr};
+};
+
+//! \brief Adds one count and the time elapsed in its scope to a probe
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(Probe& probe) noexcept : probe_{probe}, start_{ticks()} {}
+    ~ScopedTimer() { probe_.add(1, ticks() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    Probe& probe_;
+    const uint64_t start_;
+};
+
+struct Sample {
+    std::string_view name;
+    uint64_t count{0};
+    std::chrono::nanoseconds time{0};  // Zero for mere counters
+};
+
+//! \brief Aggregates all the probes hit so far, by name, the most time consuming first
+//! \remarks Instrumented sites only get probes when built with SILKWORM_INSTRUMENTATION
+std::vector<Sample> report();
+
+//! \brief Zeroes all the probes, e.g. to report on intervals
+void reset() noexcept;
+
+}  // namespace silkworm::instrumentation
+
+#if defined(SILKWORM_INSTRUMENTATION)
+
+#define SILK_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define SILK_INSTRUMENTATION_CONCAT(a, b) SILK_INSTRUMENTATION_CONCAT_(a, b)
+
+#define SILK_SCOPED_TIMER(name)                                                                               \
+    static silkworm::instrumentation::Probe SILK_INSTRUMENTATION_CONCAT(silk_probe_, __LINE__){name};         \
+    const silkworm::instrumentation::ScopedTimer SILK_INSTRUMENTATION_CONCAT(silk_scoped_timer_, __LINE__) { \
+        SILK_INSTRUMENTATION_CONCAT(silk_probe_, __LINE__)                                                    \
+    }
+
+#define SILK_COUNT(name, n)                                         \
+    do {                                                            \
+        static silkworm::instrumentation::Probe silk_probe_{name}; \
+        silk_probe_.add(n, 0);                                      \
+    } while (false)
+
+#else
+
+#define SILK_SCOPED_TIMER(name) static_cast<void>(0)
+#define SILK_COUNT(name, n) static_cast<void>(0)
+
+#endif
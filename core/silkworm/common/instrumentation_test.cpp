@@ -0,0 +1,77 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::instrumentation {
+
+TEST_CASE("Instrumentation probes") {
+    static Probe timed{"test::timed"};
+    static Probe counted{"test::counted"};
+    static Probe counted_elsewhere{"test::counted"};
+    reset();
+
+    std::thread other_thread{[] {
+        for (int i{0}; i < 10; ++i) {
+            const ScopedTimer timer{timed};
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+    }};
+    counted.add(3, 0);
+    counted_elsewhere.add(2, 0);
+    other_thread.join();
+
+    CHECK(timed.count() == 10);
+    CHECK(timed.elapsed_ticks() > 0);
+
+    const auto samples{report()};
+    const auto find{[&](std::string_view name) {
+        return std::find_if(samples.begin(), samples.end(), [&](const Sample& s) { return s.name == name; });
+    }};
+    const auto timed_sample{find("test::timed")};
+    REQUIRE(timed_sample != samples.end());
+    CHECK(timed_sample->count == 10);
+    CHECK(timed_sample->time >= std::chrono::milliseconds{1});
+    CHECK(timed_sample == samples.begin());  // the most time consuming
+
+    const auto counted_sample{find("test::counted")};
+    REQUIRE(counted_sample != samples.end());
+    CHECK(counted_sample->count == 5);  // both sites
+    CHECK(counted_sample->time.count() == 0);
+
+    reset();
+    CHECK(timed.count() == 0);
+    CHECK(counted.count() == 0);
+}
+
+TEST_CASE("Instrumentation macros") {
+    for (int i{0}; i < 3; ++i) {
+        SILK_SCOPED_TIMER("test::macro_timer");
+        SILK_COUNT("test::macro_counter", 2);
+    }
+    if constexpr (kEnabled) {
+        const auto samples{report()};
+        CHECK(std::any_of(samples.begin(), samples.end(),
+                          [](const Sample& s) { return s.name == "test::macro_counter" && s.count == 6; }));
+    }
+}
+
+}  // namespace silkworm::instrumentation
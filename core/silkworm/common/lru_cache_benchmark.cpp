@@ -0,0 +1,49 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/lru_cache.hpp>
+
+namespace silkworm {
+
+// Lookups of a working set twice the cache size: about half of them miss and evict
+static void BM_LruCache_PutGet(benchmark::State& state) {
+    const auto cache_size{static_cast<size_t>(state.range(0))};
+    lru_cache<uint64_t, uint64_t> cache{cache_size};
+
+    std::mt19937_64 rng{42};
+    std::vector<uint64_t> keys(64 * 1024);
+    for (auto& key : keys) {
+        key = rng() % (2 * cache_size);
+    }
+
+    size_t i{0};
+    for ([[maybe_unused]] auto _ : state) {
+        const uint64_t key{keys[i++ % keys.size()]};
+        if (const uint64_t* value{cache.get(key)}; value) {
+            benchmark::DoNotOptimize(*value);
+        } else {
+            cache.put(key, key);
+        }
+    }
+}
+BENCHMARK(BM_LruCache_PutGet)->Arg(1'000)->Arg(100'000);
+
+}  // namespace silkworm
@@ -0,0 +1,86 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "object_pool.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("ObjectPool") {
+    SECTION("Not thread safe") {
+        ObjectPool<int> pool;
+        CHECK(pool.empty());
+        CHECK(pool.acquire() == nullptr);
+
+        pool.add(new int{1});
+        pool.add(new int{2});
+        CHECK(pool.size() == 2);
+
+        gsl::owner<int*> last{pool.acquire()};
+        REQUIRE(last);
+        CHECK(*last == 2);  // last in, first out
+        delete last;
+        CHECK(pool.size() == 1);
+    }
+
+    SECTION("Objects added by other threads are acquired") {
+        ObjectPool<int> pool{/*thread_safe=*/true};
+        std::thread{[&pool] { pool.add(new int{42}); }}.join();
+        CHECK(pool.size() == 1);
+
+        gsl::owner<int*> object{pool.acquire()};
+        REQUIRE(object);
+        CHECK(*object == 42);
+        delete object;
+        CHECK(pool.empty());
+    }
+
+    SECTION("Concurrent acquire and add") {
+        ObjectPool<int> pool{/*thread_safe=*/true};
+        static constexpr int kNumThreads{4};
+        static constexpr int kObjectsPerThread{8};
+        for (int i{0}; i < kNumThreads * kObjectsPerThread; ++i) {
+            pool.add(new int{i});
+        }
+
+        std::vector<std::thread> threads;
+        for (int t{0}; t < kNumThreads; ++t) {
+            threads.emplace_back([&pool] {
+                for (int i{0}; i < 1'000; ++i) {
+                    std::vector<gsl::owner<int*>> acquired;
+                    for (int j{0}; j < kObjectsPerThread; ++j) {
+                        if (gsl::owner<int*> object{pool.acquire()}) {
+                            acquired.push_back(object);
+                        }
+                    }
+                    for (gsl::owner<int*> object : acquired) {
+                        pool.add(object);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(pool.size() == kNumThreads * kObjectsPerThread);  // none lost nor duplicated
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_for.hpp"
+
+#ifndef __wasm__
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+namespace silkworm {
+
+void parallel_for(size_t num_tasks, size_t num_threads, const std::function<void(size_t)>& task) {
+#ifndef __wasm__
+    std::atomic<size_t> next_task{0};
+    const auto run_all{[&] {
+        for (size_t i{next_task++}; i < num_tasks; i = next_task++) {
+            task(i);
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    const size_t num_workers{std::min(num_threads, num_tasks)};
+    for (size_t i{1}; i < num_workers; ++i) {
+        workers.emplace_back(run_all);
+    }
+    run_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+#else
+    (void)num_threads;
+    for (size_t i{0}; i < num_tasks; ++i) {
+        task(i);
+    }
+#endif
+}
+
+size_t hardware_threads() noexcept {
+#ifndef __wasm__
+    return std::max(1u, std::thread::hardware_concurrency());
+#else
+    return 1;
+#endif
+}
+
+}  // namespace silkworm
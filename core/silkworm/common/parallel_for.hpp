@@ -0,0 +1,31 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace silkworm {
+
+//! \brief Runs task(i) for each i in [0, num_tasks) on up to num_threads threads, the calling one included
+//! \remarks Tasks are handed out one at a time, so uneven tasks are balanced; sequential without threads (wasm)
+void parallel_for(size_t num_tasks, size_t num_threads, const std::function<void(size_t)>& task);
+
+//! \brief Number of threads the hardware runs concurrently, at least 1 (always 1 on wasm)
+size_t hardware_threads() noexcept;
+
+}  // namespace silkworm
@@ -0,0 +1,37 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_for.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("parallel_for") {
+    for (size_t num_threads : {0, 1, 4, 100}) {
+        std::vector<std::atomic_int> runs(50);
+        parallel_for(runs.size(), num_threads, [&](size_t i) { ++runs[i]; });
+        for (const auto& r : runs) {
+            CHECK(r == 1);  // each task run once
+        }
+    }
+    CHECK(hardware_threads() >= 1);
+}
+
+}  // namespace silkworm
@@ -0,0 +1,135 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace silkworm {
+
+/** @brief Pool of same-sized memory blocks carved out of large slabs, with a free list of released blocks.
+ *
+ * Suited to graphs of many small nodes allocated and freed one by one (e.g. with std::allocate_shared through a
+ * SlabAllocator): nodes are packed in contiguous memory and their (de)allocation costs a couple of pointer updates.
+ * The block size is fixed by the first allocation; requests not fitting a block are forwarded to operator new.
+ * Memory is returned to the system only when the pool is destroyed, so it must outlive all its blocks.
+ * Not thread-safe.
+ */
+class SlabPool {
+  public:
+    static constexpr size_t kDefaultBlocksPerSlab{1024};
+
+    explicit SlabPool(size_t blocks_per_slab = kDefaultBlocksPerSlab)
+        : blocks_per_slab_{std::max<size_t>(blocks_per_slab, 1)} {}
+
+    // Not copyable nor movable
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (block_size_ == 0) {
+            // Blocks are max-aligned and large enough to hold a free list entry once released
+            const size_t align{alignof(std::max_align_t)};
+            block_size_ = (std::max(size, sizeof(FreeBlock)) + align - 1) / align * align;
+        }
+        if (!fits(size, alignment)) {
+            return ::operator new(size, std::align_val_t{alignment});
+        }
+        ++blocks_in_use_;
+        if (free_list_ != nullptr) {
+            FreeBlock* block{free_list_};
+            free_list_ = block->next;
+            return block;
+        }
+        if (slabs_.empty() || next_block_ == blocks_per_slab_) {
+            slabs_.push_back(std::make_unique<std::byte[]>(block_size_ * blocks_per_slab_));
+            next_block_ = 0;
+        }
+        return slabs_.back().get() + block_size_ * next_block_++;
+    }
+
+    void deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (!fits(size, alignment)) {
+            ::operator delete(ptr, std::align_val_t{alignment});
+            return;
+        }
+        --blocks_in_use_;
+        free_list_ = new (ptr) FreeBlock{free_list_};
+    }
+
+    //! \brief Size of each block (zero until the first allocation)
+    [[nodiscard]] size_t block_size() const noexcept { return block_size_; }
+
+    //! \brief Number of blocks currently handed out
+    [[nodiscard]] size_t blocks_in_use() const noexcept { return blocks_in_use_; }
+
+    //! \brief Overall memory reserved by the pool
+    [[nodiscard]] size_t capacity() const noexcept { return slabs_.size() * blocks_per_slab_ * block_size_; }
+
+  private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    [[nodiscard]] bool fits(size_t size, size_t alignment) const noexcept {
+        return size <= block_size_ && alignment <= alignof(std::max_align_t);
+    }
+
+    const size_t blocks_per_slab_;
+    size_t block_size_{0};
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    size_t next_block_{0};  // First never used block within last slab
+    FreeBlock* free_list_{nullptr};
+    size_t blocks_in_use_{0};
+};
+
+/** @brief Standard allocator drawing single objects from a SlabPool.
+ *
+ * Allocations of more than one object (or of rebound types larger than the pool blocks) fall back to operator new,
+ * so it is best used for node-based storage, e.g. std::allocate_shared<T>(SlabAllocator<T>{&pool}, ...), where all
+ * the requests have the same size.
+ */
+template <class T>
+class SlabAllocator {
+  public:
+    using value_type = T;
+
+    //! \param pool : the pool to draw from; must outlive all the allocations
+    explicit SlabAllocator(SlabPool* pool) noexcept : pool_{pool} {}
+
+    template <class U>
+    SlabAllocator(const SlabAllocator<U>& other) noexcept : pool_{other.pool()} {}  // NOLINT
+
+    [[nodiscard]] T* allocate(size_t n) { return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T* ptr, size_t n) noexcept { pool_->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    [[nodiscard]] SlabPool* pool() const noexcept { return pool_; }
+
+    template <class U>
+    friend bool operator==(const SlabAllocator& a, const SlabAllocator<U>& b) noexcept {
+        return a.pool_ == b.pool();
+    }
+
+  private:
+    SlabPool* pool_;
+};
+
+}  // namespace silkworm
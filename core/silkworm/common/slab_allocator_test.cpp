@@ -0,0 +1,91 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "slab_allocator.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("SlabPool") {
+    SlabPool pool{/*blocks_per_slab=*/4};
+
+    SECTION("Block size is fixed by first allocation") {
+        void* ptr{pool.allocate(20, 4)};
+        CHECK(pool.block_size() >= 20);
+        CHECK(pool.block_size() % alignof(std::max_align_t) == 0);
+        CHECK(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) == 0);
+        pool.deallocate(ptr, 20, 4);
+        CHECK(pool.blocks_in_use() == 0);
+    }
+
+    SECTION("Released blocks are reused") {
+        std::vector<void*> blocks;
+        for (int i{0}; i < 10; ++i) {
+            blocks.push_back(pool.allocate(16));
+        }
+        CHECK(pool.blocks_in_use() == 10);
+        const size_t capacity{pool.capacity()};
+        CHECK(capacity == 3 * 4 * pool.block_size());
+
+        for (void* ptr : blocks) {
+            pool.deallocate(ptr, 16);
+        }
+        CHECK(pool.blocks_in_use() == 0);
+        for (int i{0}; i < 10; ++i) {
+            CHECK(std::find(blocks.begin(), blocks.end(), pool.allocate(16)) != blocks.end());
+        }
+        CHECK(pool.capacity() == capacity);
+    }
+
+    SECTION("Oversized allocation") {
+        void* small{pool.allocate(16)};
+        void* large{pool.allocate(1'000)};
+        CHECK(large != nullptr);
+        CHECK(pool.blocks_in_use() == 1);
+        pool.deallocate(large, 1'000);
+        pool.deallocate(small, 16);
+    }
+}
+
+TEST_CASE("SlabAllocator") {
+    SlabPool pool;
+
+    SECTION("Shared objects") {
+        auto str{std::allocate_shared<std::string>(SlabAllocator<std::string>{&pool}, "a long string, not inlined")};
+        auto other{std::allocate_shared<std::string>(SlabAllocator<std::string>{&pool}, "slab")};
+        CHECK(*str == "a long string, not inlined");
+        CHECK(*other == "slab");
+        CHECK(pool.blocks_in_use() == 2);  // Object and control block share a block
+
+        str.reset();
+        CHECK(pool.blocks_in_use() == 1);
+    }
+
+    SECTION("Containers") {
+        std::vector<int, SlabAllocator<int>> vec{SlabAllocator<int>{&pool}};
+        for (int i{0}; i < 100; ++i) {
+            vec.push_back(i);
+        }
+        CHECK(vec[99] == 99);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,306 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace silkworm {
+
+/** @brief Approximate access frequency of keys: a count-min sketch of small saturating counters.
+ *
+ * Counters are halved once the number of recorded accesses reaches a sample size proportional to the width
+ * of the sketch, so that frequencies reflect recent history.
+ */
+template <typename key_t, typename hash_t = std::hash<key_t>>
+class frequency_sketch {
+  public:
+    static constexpr size_t kDepth{4};
+    static constexpr uint8_t kMaxCount{15};
+
+    //! \param max_size : the max number of entries of the cache the sketch is sized for
+    explicit frequency_sketch(size_t max_size) {
+        // A row several times wider than the cache keeps collisions with hot keys (i.e. overestimates) rare
+        size_t width{16};
+        while (width < max_size * 4) {
+            width <<= 1;
+        }
+        mask_ = width - 1;
+        sample_size_ = std::max<size_t>(max_size, 1) * 10;
+        table_.resize(width * kDepth);
+    }
+
+    //! \brief Records one access to key
+    //! \remarks Conservative update: only the smallest counters are incremented, which limits overestimation
+    void increment(const key_t& key) noexcept {
+        const uint64_t h{mix(hash_t{}(key))};
+        const uint8_t min{frequency(h)};
+        if (min == kMaxCount) {
+            return;
+        }
+        for (size_t i{0}; i < kDepth; ++i) {
+            uint8_t& counter{table_[index(h, i)]};
+            if (counter == min) {
+                ++counter;
+            }
+        }
+        if (++additions_ == sample_size_) {
+            reset();
+        }
+    }
+
+    //! \brief Estimated number of recent accesses to key (never underestimated, saturates at kMaxCount)
+    [[nodiscard]] uint8_t frequency(const key_t& key) const noexcept { return frequency(mix(hash_t{}(key))); }
+
+    void clear() noexcept {
+        std::fill(table_.begin(), table_.end(), uint8_t{0});
+        additions_ = 0;
+    }
+
+  private:
+    [[nodiscard]] uint8_t frequency(uint64_t h) const noexcept {
+        uint8_t min{kMaxCount};
+        for (size_t i{0}; i < kDepth; ++i) {
+            min = std::min(min, table_[index(h, i)]);
+        }
+        return min;
+    }
+
+    // Finalizer of MurmurHash3: spreads poor std::hash values (e.g. identity on integers)
+    static uint64_t mix(uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Double hashing: row i uses h1 + i * h2
+    [[nodiscard]] size_t index(uint64_t h, size_t row) const noexcept {
+        const uint64_t h1{h & 0xffffffff};
+        const uint64_t h2{(h >> 32) | 1};
+        return row * (mask_ + 1) + static_cast<size_t>((h1 + row * h2) & mask_);
+    }
+
+    void reset() noexcept {
+        for (auto& counter : table_) {
+            counter >>= 1;
+        }
+        additions_ /= 2;
+    }
+
+    std::vector<uint8_t> table_;
+    size_t mask_{0};
+    size_t sample_size_{0};
+    size_t additions_{0};
+};
+
+/** @brief Scan-resistant cache with W-TinyLFU replacement policy.
+ *
+ * New entries land in a small LRU window; entries evicted from the window compete for admission into the main
+ * segmented LRU (probation + protected) against its victim, based on their estimated access frequency.
+ * A burst of one-off keys thus cannot flush frequently used entries out of the cache.
+ * The interface mirrors lru_cache so that it can be used as a drop-in replacement.
+ *
+ * See https://arxiv.org/abs/1512.00727
+ */
+template <typename key_t, typename value_t>
+class tinylfu_cache {
+  public:
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};   // Entries dropped to make room for others (including rejected candidates)
+        uint64_t rejections{0};  // Candidates denied admission into the main segment
+    };
+
+    explicit tinylfu_cache(size_t max_size)
+        : max_window_size_{std::min(max_size, std::max<size_t>(1, max_size / 100))},
+          max_main_size_{max_size - max_window_size_},
+          max_protected_size_{max_main_size_ * 4 / 5},
+          sketch_{max_size} {}
+
+    void put(const key_t& key, const value_t& value) {
+        sketch_.increment(key);
+        if (auto it{map_.find(key)}; it != map_.end()) {
+            it->second->value = value;
+            touch(it->second);
+            return;
+        }
+        if (max_window_size_ == 0) {
+            return;
+        }
+        window_.push_front(Entry{key, value, Segment::kWindow});
+        map_.emplace(key, window_.begin());
+        if (window_.size() > max_window_size_) {
+            evict_from_window();
+        }
+    }
+
+    const value_t* get(const key_t& key) {
+        sketch_.increment(key);
+        auto it{map_.find(key)};
+        if (it == map_.end()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        touch(it->second);
+        return &(it->second->value);
+    }
+
+    std::optional<value_t> get_as_copy(const key_t& key) {
+        auto val{get(key)};
+        if (val == nullptr) {
+            return std::nullopt;
+        }
+        return {*val};
+    }
+
+    bool remove(const key_t& key) {
+        auto it{map_.find(key)};
+        if (it == map_.end()) {
+            return false;
+        }
+        segment(it->second->segment).erase(it->second);
+        map_.erase(it);
+        return true;
+    }
+
+    //! \brief Whether key is cached, neither counting as an access nor affecting recency
+    [[nodiscard]] bool contains(const key_t& key) const noexcept { return map_.contains(key); }
+
+    [[nodiscard]] size_t size() const noexcept { return map_.size(); }
+
+    //! \brief Removes all entries and forgets recorded frequencies (stats are retained)
+    void clear() noexcept {
+        map_.clear();
+        window_.clear();
+        probation_.clear();
+        protected_.clear();
+        sketch_.clear();
+    }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+    //! \brief Records an access to key without looking it up, e.g. when the value is not needed this time
+    void record_access(const key_t& key) noexcept { sketch_.increment(key); }
+
+    //! \brief Estimated number of recent accesses (get, put or record_access) to key, cached or not
+    [[nodiscard]] uint8_t frequency(const key_t& key) const noexcept { return sketch_.frequency(key); }
+
+  private:
+    enum class Segment : uint8_t {
+        kWindow,
+        kProbation,
+        kProtected,
+    };
+
+    struct Entry {
+        key_t key;
+        value_t value;
+        Segment segment;
+    };
+
+    using list_t = std::list<Entry>;
+    using list_iterator_t = typename list_t::iterator;
+
+    list_t& segment(Segment s) noexcept {
+        switch (s) {
+            case Segment::kWindow:
+                return window_;
+            case Segment::kProbation:
+                return probation_;
+            default:
+                return protected_;
+        }
+    }
+
+    // N.B. splicing across lists does not invalidate iterators held by map_
+    void move_to_front(list_t& to, list_iterator_t it, Segment s) {
+        to.splice(to.begin(), segment(it->segment), it);
+        it->segment = s;
+    }
+
+    void touch(list_iterator_t it) {
+        switch (it->segment) {
+            case Segment::kWindow:
+                move_to_front(window_, it, Segment::kWindow);
+                break;
+            case Segment::kProbation:
+                // A second hit promotes the entry; the protected segment overflows into probation
+                move_to_front(protected_, it, Segment::kProtected);
+                if (protected_.size() > max_protected_size_) {
+                    move_to_front(probation_, std::prev(protected_.end()), Segment::kProbation);
+                }
+                break;
+            case Segment::kProtected:
+                move_to_front(protected_, it, Segment::kProtected);
+                break;
+        }
+    }
+
+    void evict_from_window() {
+        const auto candidate{std::prev(window_.end())};
+        if (probation_.size() + protected_.size() < max_main_size_) {
+            move_to_front(probation_, candidate, Segment::kProbation);
+            return;
+        }
+        if (probation_.empty() && !protected_.empty()) {
+            move_to_front(probation_, std::prev(protected_.end()), Segment::kProbation);
+        }
+        if (probation_.empty()) {
+            evict(candidate);
+            return;
+        }
+        const auto victim{std::prev(probation_.end())};
+        if (sketch_.frequency(candidate->key) > sketch_.frequency(victim->key)) {
+            evict(victim);
+            move_to_front(probation_, candidate, Segment::kProbation);
+        } else {
+            ++stats_.rejections;
+            evict(candidate);
+        }
+    }
+
+    void evict(list_iterator_t it) {
+        ++stats_.evictions;
+        map_.erase(it->key);
+        segment(it->segment).erase(it);
+    }
+
+    const size_t max_window_size_;
+    const size_t max_main_size_;
+    const size_t max_protected_size_;
+
+    list_t window_;
+    list_t probation_;
+    list_t protected_;
+    std::unordered_map<key_t, list_iterator_t> map_;
+    frequency_sketch<key_t> sketch_;
+    Stats stats_;
+};
+
+}  // namespace silkworm
@@ -0,0 +1,112 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "tinylfu_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("TinyLFU put and get") {
+    tinylfu_cache<int, int> cache(10);
+    CHECK(cache.get(7) == nullptr);
+    cache.put(7, 777);
+    REQUIRE(cache.get(7));
+    CHECK(*cache.get(7) == 777);
+    CHECK(cache.size() == 1);
+
+    cache.put(7, 778);
+    CHECK(cache.get_as_copy(7) == 778);
+    CHECK(cache.size() == 1);
+
+    CHECK(cache.remove(7));
+    CHECK_FALSE(cache.remove(7));
+    CHECK(cache.size() == 0);
+
+    const auto& stats{cache.stats()};
+    CHECK(stats.hits == 3);
+    CHECK(stats.misses == 1);
+}
+
+TEST_CASE("TinyLFU keeps size within capacity") {
+    static constexpr int kCapacity{50};
+    tinylfu_cache<int, int> cache(kCapacity);
+    for (int i{0}; i < 1'000; ++i) {
+        cache.put(i, i);
+        CHECK(cache.size() <= kCapacity);
+    }
+    CHECK(cache.size() == kCapacity);
+    CHECK(cache.stats().evictions == 1'000 - kCapacity);
+}
+
+TEST_CASE("TinyLFU single entry") {
+    tinylfu_cache<int, int> cache(1);
+    cache.put(1, 111);
+    cache.put(2, 222);
+    CHECK(cache.size() == 1);
+    CHECK(cache.get(1) == nullptr);
+    REQUIRE(cache.get(2));
+    CHECK(*cache.get(2) == 222);
+}
+
+TEST_CASE("TinyLFU is scan resistant") {
+    static constexpr int kCapacity{100};
+    static constexpr int kNumHotKeys{50};
+    tinylfu_cache<int, int> cache(kCapacity);
+    const auto access{[&cache](int key) {
+        if (cache.get(key)) {
+            return true;
+        }
+        cache.put(key, key);
+        return false;
+    }};
+
+    // Hot keys are accessed repeatedly
+    for (int round{0}; round < 5; ++round) {
+        for (int i{0}; i < kNumHotKeys; ++i) {
+            access(i);
+        }
+    }
+
+    // Each round a scan of one-off keys as large as the whole cache precedes the hot keys:
+    // with pure LRU no hot key would ever be found
+    int one_off_key{1'000};
+    for (int round{0}; round < 10; ++round) {
+        for (int i{0}; i < kCapacity; ++i) {
+            access(one_off_key++);
+        }
+        int hot_keys_found{0};
+        for (int i{0}; i < kNumHotKeys; ++i) {
+            if (access(i)) {
+                ++hot_keys_found;
+            }
+        }
+        CHECK(hot_keys_found == kNumHotKeys);
+    }
+    CHECK(cache.stats().rejections > 0);
+}
+
+TEST_CASE("TinyLFU clear") {
+    tinylfu_cache<int, int> cache(10);
+    for (int i{0}; i < 10; ++i) {
+        cache.put(i, i);
+    }
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.get(0) == nullptr);
+}
+
+}  // namespace silkworm
@@ -16,7 +16,11 @@
 
 #include "util.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <regex>
 
 #include <silkworm/common/as_range.hpp>
@@ -234,8 +238,25 @@ std::string human_size(uint64_t bytes) {
 }
 
 size_t prefix_length(ByteView a, ByteView b) {
-    size_t len{std::min(a.length(), b.length())};
-    for (size_t i{0}; i < len; ++i) {
+    const size_t len{std::min(a.length(), b.length())};
+    size_t i{0};
+
+    // Word at a time: the first differing byte is given by the lowest (little endian) or highest (big endian)
+    // set bit of the xor
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t x, y;
+        std::memcpy(&x, &a[i], sizeof(uint64_t));
+        std::memcpy(&y, &b[i], sizeof(uint64_t));
+        if (const uint64_t diff{x ^ y}; diff != 0) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + static_cast<size_t>(std::countr_zero(diff)) / 8;
+            } else {
+                return i + static_cast<size_t>(std::countl_zero(diff)) / 8;
+            }
+        }
+    }
+
+    for (; i < len; ++i) {
         if (a[i] != b[i]) {
             return i;
         }
@@ -243,4 +264,117 @@ size_t prefix_length(ByteView a, ByteView b) {
     return len;
 }
 
+#if defined(__wasm_simd128__)
+namespace {
+
+    // The same 64-bit word of two Keccak states: on WASM SIMD128 every operation handles both at once
+    using KeccakLanes = uint64_t __attribute__((vector_size(16)));
+
+    constexpr size_t kKeccak256Rate{136};  // Bytes absorbed per permutation
+
+    constexpr uint64_t kKeccakRoundConstants[24]{
+        0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+        0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+        0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+        0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+        0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+    // Rotation offsets of word x + 5 * y
+    constexpr unsigned kKeccakRotations[25]{0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+                                            25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14};
+
+    inline KeccakLanes rotate_left(KeccakLanes v, unsigned n) noexcept {
+        return n ? (v << n) | (v >> (64 - n)) : v;
+    }
+
+    void keccak_f1600_x2(KeccakLanes (&a)[25]) noexcept {
+        for (const uint64_t round_constant : kKeccakRoundConstants) {
+            // Theta
+            KeccakLanes c[5];
+            for (size_t x{0}; x < 5; ++x) {
+                c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+            }
+            for (size_t x{0}; x < 5; ++x) {
+                const KeccakLanes d{c[(x + 4) % 5] ^ rotate_left(c[(x + 1) % 5], 1)};
+                for (size_t y{0}; y < 25; y += 5) {
+                    a[x + y] ^= d;
+                }
+            }
+            // Rho and pi
+            KeccakLanes b[25];
+            for (size_t x{0}; x < 5; ++x) {
+                for (size_t y{0}; y < 5; ++y) {
+                    b[y + 5 * ((2 * x + 3 * y) % 5)] = rotate_left(a[x + 5 * y], kKeccakRotations[x + 5 * y]);
+                }
+            }
+            // Chi
+            for (size_t y{0}; y < 25; y += 5) {
+                for (size_t x{0}; x < 5; ++x) {
+                    a[x + y] = b[x + y] ^ (~b[(x + 1) % 5 + y] & b[(x + 2) % 5 + y]);
+                }
+            }
+            // Iota
+            a[0] ^= KeccakLanes{round_constant, round_constant};
+        }
+    }
+
+    // Keccak-256 of two inputs in the two lanes of one state: the shorter one is done after its last block
+    // while the permutations go on for the longer one
+    void keccak256_x2(ByteView in0, ByteView in1, ethash::hash256& out0, ethash::hash256& out1) noexcept {
+        const ByteView inputs[2]{in0, in1};
+        ethash::hash256* outputs[2]{&out0, &out1};
+        const size_t num_blocks[2]{in0.length() / kKeccak256Rate + 1, in1.length() / kKeccak256Rate + 1};
+
+        KeccakLanes state[25]{};
+        uint8_t last_block[kKeccak256Rate];
+        for (size_t block{0}; block < std::max(num_blocks[0], num_blocks[1]); ++block) {
+            for (size_t lane{0}; lane < 2; ++lane) {
+                if (block >= num_blocks[lane]) {
+                    continue;
+                }
+                const uint8_t* data{inputs[lane].data() + block * kKeccak256Rate};
+                if (block + 1 == num_blocks[lane]) {  // Padded, always shorter than the rate
+                    const size_t length{inputs[lane].length() % kKeccak256Rate};
+                    std::memset(last_block, 0, sizeof(last_block));
+                    if (length) {
+                        std::memcpy(last_block, data, length);
+                    }
+                    last_block[length] ^= 0x01;
+                    last_block[kKeccak256Rate - 1] ^= 0x80;
+                    data = last_block;
+                }
+                for (size_t i{0}; i < kKeccak256Rate / sizeof(uint64_t); ++i) {
+                    uint64_t word;  // Little endian, as WASM
+                    std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+                    state[i][lane] ^= word;
+                }
+            }
+            keccak_f1600_x2(state);
+            for (size_t lane{0}; lane < 2; ++lane) {
+                if (block + 1 == num_blocks[lane]) {
+                    for (size_t i{0}; i < kHashLength / sizeof(uint64_t); ++i) {
+                        const uint64_t word{state[i][lane]};
+                        std::memcpy(outputs[lane]->bytes + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+                    }
+                }
+            }
+        }
+    }
+
+}  // namespace
+#endif  // defined(__wasm_simd128__)
+
+void keccak256_batch(std::span<const ByteView> inputs, std::span<ethash::hash256> out) noexcept {
+    assert(out.size() >= inputs.size());
+    size_t i{0};
+#if defined(__wasm_simd128__)
+    for (; i + 2 <= inputs.size(); i += 2) {
+        keccak256_x2(inputs[i], inputs[i + 1], out[i], out[i + 1]);
+    }
+#endif
+    for (; i < inputs.size(); ++i) {
+        out[i] = keccak256(inputs[i]);
+    }
+}
+
 }  // namespace silkworm
@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -82,4 +83,12 @@ size_t prefix_length(ByteView a, ByteView b);
 
 inline ethash::hash256 keccak256(ByteView view) { return ethash::keccak256(view.data(), view.size()); }
 
+// Preferred number of inputs per keccak256_batch call: the lane count of the widest (AVX-512) multi-lane Keccak
+inline constexpr size_t kKeccakBatchSize{8};
+
+// Hashes inputs[i] into out[i]; out must be at least as large as inputs.
+// Independent inputs hashed together are the entry point for a multi-lane implementation:
+// two at a time in the lanes of WASM SIMD128 (SILKWORM_WASM_SIMD), else one after the other.
+void keccak256_batch(std::span<const ByteView> inputs, std::span<ethash::hash256> out) noexcept;
+
 }  // namespace silkworm
@@ -0,0 +1,39 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+static void BM_Keccak256(benchmark::State& state) {
+    std::mt19937_64 rng{42};
+    Bytes data(static_cast<size_t>(state.range(0)), '\0');
+    for (auto& b : data) {
+        b = static_cast<uint8_t>(rng());
+    }
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(keccak256(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_Keccak256)->Arg(20)->Arg(32)->Arg(64)->Arg(1024)->Arg(24 * 1024);
+
+}  // namespace silkworm
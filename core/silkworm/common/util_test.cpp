@@ -112,6 +112,38 @@ TEST_CASE("to_bytes32") {
           "7576351873263824fff23784264823469344629364396429864239864938264a");
 }
 
+TEST_CASE("prefix_length") {
+    CHECK(prefix_length({}, {}) == 0);
+    CHECK(prefix_length(*from_hex("0a0b"), {}) == 0);
+    CHECK(prefix_length(*from_hex("0a0b"), *from_hex("0a0b0c")) == 2);
+
+    // Mismatch within and past the first word
+    const Bytes a{*from_hex("000102030405060708090a0b0c0d0e0f10")};
+    for (size_t i{0}; i < a.length(); ++i) {
+        Bytes b{a};
+        b[i] ^= 0x80;
+        CHECK(prefix_length(a, b) == i);
+        CHECK(prefix_length(b, a) == i);
+    }
+    CHECK(prefix_length(a, a) == a.length());
+}
+
+TEST_CASE("keccak256_batch") {
+    const Bytes short_input{*from_hex("0a0b0c")};
+    const Bytes long_input(200, 0x5a);    // Longer than a Keccak-256 block
+    const Bytes rate_input(136, 0xa5);    // Exactly a block: padding takes another one
+    const Bytes longer_input(300, 0x3c);  // Paired with shorter inputs by multi-lane implementations
+    const std::vector<ByteView> inputs{ByteView{}, short_input, long_input, rate_input, longer_input, short_input};
+    std::vector<ethash::hash256> out(inputs.size());
+    keccak256_batch(inputs, out);
+    for (size_t i{0}; i < inputs.size(); ++i) {
+        CHECK(to_hex(out[i].bytes) == to_hex(keccak256(inputs[i]).bytes));
+    }
+    CHECK(to_hex(out[0].bytes) == to_hex(kEmptyHash));
+
+    keccak256_batch({}, {});  // no-op
+}
+
 TEST_CASE("iequals") {
     std::string a{"Hello World"};
     std::string b{"Hello wOrld"};
@@ -19,6 +19,7 @@
 
 #include <silkworm/chain/protocol_param.hpp>
 #include <silkworm/common/as_range.hpp>
+#include <silkworm/common/parallel_for.hpp>
 #include <silkworm/rlp/encode_vector.hpp>
 #include <silkworm/trie/vector_root.hpp>
 
@@ -27,7 +28,8 @@ namespace silkworm::consensus {
 ValidationResult EngineBase::pre_validate_block(const Block& block, const BlockState& state) {
     const BlockHeader& header{block.header};
 
-    if (ValidationResult err{validate_block_header(header, state, /*with_future_timestamp_check=*/true)};
+    if (ValidationResult err{validate_block_header(header, state, /*with_future_timestamp_check=*/true,
+                                                    /*with_seal_check=*/true)};
         err != ValidationResult::kOk) {
         return err;
     }
@@ -72,7 +74,8 @@ ValidationResult EngineBase::validate_ommers(const Block& block, const BlockStat
     std::optional<BlockHeader> parent{get_parent_header(state, header)};
 
     for (const BlockHeader& ommer : block.ommers) {
-        if (ValidationResult err{validate_block_header(ommer, state, /*with_future_timestamp_check=*/false)};
+        if (ValidationResult err{validate_block_header(ommer, state, /*with_future_timestamp_check=*/false,
+                                                        /*with_seal_check=*/true)};
             err != ValidationResult::kOk) {
             return ValidationResult::kInvalidOmmerHeader;
         }
@@ -90,7 +93,7 @@ ValidationResult EngineBase::validate_ommers(const Block& block, const BlockStat
 }
 
 ValidationResult EngineBase::validate_block_header(const BlockHeader& header, const BlockState& state,
-                                                   bool with_future_timestamp_check) {
+                                                   bool with_future_timestamp_check, bool with_seal_check) {
     if (with_future_timestamp_check) {
         const std::time_t now{std::time(nullptr)};
         if (header.timestamp > static_cast<uint64_t>(now)) {
@@ -157,7 +160,7 @@ ValidationResult EngineBase::validate_block_header(const BlockHeader& header, co
         return ValidationResult::kWrongBaseFee;
     }
 
-    return validate_seal(header);
+    return with_seal_check ? validate_seal(header) : ValidationResult::kOk;
 }
 
 std::optional<BlockHeader> EngineBase::get_parent_header(const BlockState& state, const BlockHeader& header) {
@@ -244,6 +247,10 @@ evmc::bytes32 EngineBase::compute_transaction_root(const BlockBody& body) {
         rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
     };
 
+    if (body.transactions.size() >= trie::kParallelRootHashThreshold) {
+        return trie::parallel_root_hash(body.transactions, kEncoder, hardware_threads());
+    }
+
     evmc::bytes32 txn_root{trie::root_hash(body.transactions, kEncoder)};
 
     return txn_root;
@@ -36,9 +36,10 @@ class EngineBase : public IEngine {
     //! \param [in] header: header to validate.
     //! \param [in] with_future_timestamp_check : whether to check header timestamp is in the future wrt host current
     //! time \see https://github.com/torquem-ch/silkworm/issues/448
+    //! \param [in] with_seal_check : whether to validate the seal too
     //! \note Shouldn't be used for genesis block.
     ValidationResult validate_block_header(const BlockHeader& header, const BlockState& state,
-                                           bool with_future_timestamp_check) override;
+                                           bool with_future_timestamp_check, bool with_seal_check) override;
 
     //! \brief Performs validation of block ommers only.
     //! \brief See [YP] Sections 11.1 "Ommer Validation".
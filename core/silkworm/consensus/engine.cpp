@@ -19,6 +19,7 @@
 #include <silkpre/secp256k1n.hpp>
 
 #include <silkworm/chain/intrinsic_gas.hpp>
+#include <silkworm/common/parallel_for.hpp>
 #include <silkworm/consensus/ethash/engine.hpp>
 #include <silkworm/consensus/merge/engine.hpp>
 #include <silkworm/consensus/noproof/engine.hpp>
@@ -27,6 +28,14 @@ namespace silkworm::consensus {
 
 void IEngine::finalize(IntraBlockState&, const Block&, evmc_revision) {}
 
+std::vector<ValidationResult> IEngine::validate_seals(std::span<const BlockHeader* const> headers,
+                                                      size_t num_threads) {
+    std::vector<ValidationResult> results(headers.size());
+    parallel_for(headers.size(), num_threads, [&](size_t i) { results[i] = validate_seal(*headers[i]); });
+    return results;
+}
+
+
 ValidationResult pre_validate_transaction(const Transaction& txn, uint64_t block_number, const ChainConfig& config,
                                           const std::optional<intx::uint256>& base_fee_per_gas) {
     const evmc_revision rev{config.revision(block_number)};
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include <silkworm/consensus/validation.hpp>
 #include <silkworm/state/intra_block_state.hpp>
 #include <silkworm/state/state.hpp>
@@ -39,13 +42,22 @@ class IEngine {
     //! \param [in] state: current state.
     //! \param [in] with_future_timestamp_check : whether to check header timestamp is in the future wrt host current
     //! time \see https://github.com/torquem-ch/silkworm/issues/448
+    //! \param [in] with_seal_check : whether to validate the seal too (false when it has already been checked apart,
+    //! see validate_seal)
     //! \note Shouldn't be used for genesis block.
     virtual ValidationResult validate_block_header(const BlockHeader& header, const BlockState& state,
-                                                   bool with_future_timestamp_check) = 0;
+                                                   bool with_future_timestamp_check, bool with_seal_check) = 0;
 
     //! \brief Validates the seal of the header
+    //! \remarks Depends on the header only, so it is safe to call concurrently for different headers
     virtual ValidationResult validate_seal(const BlockHeader& header) = 0;
 
+    //! \brief Validates the seals of many headers, spreading them over up to num_threads threads
+    //! \return The result of validate_seal for each header, in the same order
+    //! \remarks Engines may override it to group the headers sharing costly state (e.g. Ethash epochs)
+    virtual std::vector<ValidationResult> validate_seals(std::span<const BlockHeader* const> headers,
+                                                         size_t num_threads);
+
     //! \brief Performs validation of block ommers only.
     //! \brief See [YP] Sections 11.1 "Ommer Validation".
     //! \param [in] block: block to validate.
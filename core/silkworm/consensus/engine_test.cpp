@@ -15,6 +15,7 @@
 */
 
 #include <catch2/catch.hpp>
+#include <ethash/ethash.hpp>
 
 #include <silkworm/common/test_util.hpp>
 
@@ -60,6 +61,28 @@ TEST_CASE("Consensus Engine Seal") {
     CHECK(consensus_engine->validate_seal(fake_header) == ValidationResult::kOk);
 }
 
+TEST_CASE("Consensus Engine Seals") {
+    std::vector<BlockHeader> fake_headers(5);
+    fake_headers[2].number = ethash::epoch_length;  // Out of order, on the next epoch
+    std::vector<const BlockHeader*> headers;
+    for (const auto& header : fake_headers) {
+        headers.push_back(&header);
+    }
+
+    std::unique_ptr<IEngine> consensus_engine{engine_factory(kMainnetConfig)};  // Ethash consensus engine
+    for (size_t num_threads : {1, 3}) {
+        const auto results{consensus_engine->validate_seals(headers, num_threads)};
+        REQUIRE(results.size() == headers.size());
+        for (size_t i{0}; i < headers.size(); ++i) {
+            CHECK(results[i] == consensus_engine->validate_seal(*headers[i]));
+        }
+    }
+    CHECK(consensus_engine->validate_seals({}, 2).empty());
+
+    consensus_engine = engine_factory(test::kLondonConfig);  // Noproof consensus engine
+    CHECK(consensus_engine->validate_seals(headers, 2) == std::vector<ValidationResult>(5, ValidationResult::kOk));
+}
+
 TEST_CASE("Validate transaction types") {
     const std::optional<intx::uint256> base_fee_per_gas{std::nullopt};
 
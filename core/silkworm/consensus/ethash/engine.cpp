@@ -16,9 +16,14 @@
 
 #include "engine.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 #include <silkworm/chain/difficulty.hpp>
 #include <silkworm/chain/protocol_param.hpp>
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/parallel_for.hpp>
+#include <silkworm/consensus/ethash/epoch_context_cache.hpp>
 
 namespace silkworm::consensus {
 
@@ -44,23 +49,55 @@ void EthashEngine::finalize(IntraBlockState& state, const Block& block, const ev
 }
 
 // Ethash ProofOfWork verification
-ValidationResult EthashEngine::validate_seal(const BlockHeader& header) {
-    const int epoch_number{static_cast<int>(header.number / ethash::epoch_length)};
-    if (!epoch_context_ || epoch_context_->epoch_number != epoch_number) {
-        epoch_context_.reset(); // Firstly release the obsoleted context
-        epoch_context_ = ethash::create_epoch_context(epoch_number);
-    }
-
+static ValidationResult verify_seal(const ethash::epoch_context& epoch_context, const BlockHeader& header) {
     const auto nonce{endian::load_big_u64(header.nonce.data())};
     const auto seal_hash(header.hash(/*for_sealing =*/true));
     const auto diff256{intx::be::store<ethash::hash256>(header.difficulty)};
     const auto sealh256{ethash::hash256_from_bytes(seal_hash.bytes)};
     const auto mixh256{ethash::hash256_from_bytes(header.mix_hash.bytes)};
 
-    const auto ec{ethash::verify_against_difficulty(*epoch_context_, sealh256, mixh256, nonce, diff256)};
+    const auto ec{ethash::verify_against_difficulty(epoch_context, sealh256, mixh256, nonce, diff256)};
     return ec ? ValidationResult::kInvalidSeal : ValidationResult::kOk;
 }
 
+ValidationResult EthashEngine::validate_seal(const BlockHeader& header) {
+    return verify_seal(*EpochContextCache::instance().get_for_block(header.number), header);
+}
+
+std::vector<ValidationResult> EthashEngine::validate_seals(std::span<const BlockHeader* const> headers,
+                                                           size_t num_threads) {
+    // Several chunks per thread to balance the load
+    static constexpr size_t kChunksPerThread{4};
+    const auto epoch_of{[&headers](size_t i) { return headers[i]->number / ethash::epoch_length; }};
+
+    std::vector<size_t> order(headers.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return epoch_of(a) < epoch_of(b); });
+
+    // Chunks of headers of the same epoch, as [begin, end) ranges of order
+    const size_t num_chunks{std::max<size_t>(1, num_threads) * kChunksPerThread};
+    const size_t max_chunk_size{std::max<size_t>(1, headers.size() / num_chunks)};
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t begin{0}, end{0}; begin < order.size(); begin = end) {
+        end = begin + 1;
+        while (end < order.size() && end - begin < max_chunk_size && epoch_of(order[end]) == epoch_of(order[begin])) {
+            ++end;
+        }
+        chunks.emplace_back(begin, end);
+    }
+
+    std::vector<ValidationResult> results(headers.size());
+    parallel_for(chunks.size(), num_threads, [&](size_t c) {
+        const auto [begin, end]{chunks[c]};
+        // Chunks are handed out in epoch order, so the next epoch is prefetched ahead of its first chunk
+        const auto epoch_context{EpochContextCache::instance().get_for_block(headers[order[begin]]->number)};
+        for (size_t i{begin}; i < end; ++i) {
+            results[order[i]] = verify_seal(*epoch_context, *headers[order[i]]);
+        }
+    });
+    return results;
+}
+
 ValidationResult EthashEngine::validate_difficulty(const BlockHeader& header, const BlockHeader& parent) {
     const bool parent_has_uncles{parent.ommers_hash != kEmptyListHash};
     const intx::uint256 difficulty{canonical_difficulty(header.number, header.timestamp, parent.difficulty,
@@ -16,8 +16,6 @@
 
 #pragma once
 
-#include <ethash/ethash.hpp>
-
 #include <silkworm/consensus/base/engine.hpp>
 
 namespace silkworm::consensus {
@@ -28,8 +26,14 @@ class EthashEngine : public EngineBase {
     explicit EthashEngine(const ChainConfig& chain_config) : EngineBase(chain_config, /*prohibit_ommers=*/false) {}
 
     //! \brief Validates the seal of the header
+    //! \remarks Thread safe: epoch contexts come from the process-wide EpochContextCache
     ValidationResult validate_seal(const BlockHeader& header) override;
 
+    //! \brief Validates the seals of many headers, sharded by epoch so that each chunk takes its context once
+    //! \remarks Best fed with headers of a few consecutive epochs, as EpochContextCache keeps three of them
+    std::vector<ValidationResult> validate_seals(std::span<const BlockHeader* const> headers,
+                                                 size_t num_threads) override;
+
     ValidationResult validate_difficulty(const BlockHeader& header, const BlockHeader& parent) override;
 
     //! \brief See [YP] Section 11.3 "Reward Application".
@@ -37,9 +41,6 @@ class EthashEngine : public EngineBase {
     //! \param [in] block: current block to apply rewards for.
     //! \param [in] revision: EVM fork.
     void finalize(IntraBlockState& state, const Block& block, evmc_revision revision) override;
-
-  private:
-    ethash::epoch_context_ptr epoch_context_{nullptr, ethash_destroy_epoch_context};
 };
 
 }  // namespace silkworm::consensus
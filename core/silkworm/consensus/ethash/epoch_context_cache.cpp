@@ -0,0 +1,67 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "epoch_context_cache.hpp"
+
+namespace silkworm::consensus {
+
+EpochContextCache& EpochContextCache::instance() {
+    static EpochContextCache cache;
+    return cache;
+}
+
+EpochContextCache::EpochContextPtr EpochContextCache::get(int epoch_number) {
+    ensure(epoch_number, std::launch::deferred);
+    std::shared_future<EpochContextPtr> context;
+    {
+        std::unique_lock lock{mutex_};
+        context = slots_[static_cast<size_t>(epoch_number) % kSlots].context;
+    }
+    return context.get();  // Outside the lock: the generation of a deferred context takes seconds
+}
+
+EpochContextCache::EpochContextPtr EpochContextCache::get_for_block(uint64_t block_number) {
+    const auto epoch_number{static_cast<int>(block_number / ethash::epoch_length)};
+    if (block_number % ethash::epoch_length >= kPrefetchFromBlock) {
+        prefetch(epoch_number + 1);
+    }
+    return get(epoch_number);
+}
+
+void EpochContextCache::prefetch(int epoch_number) {
+#ifndef __wasm__
+    ensure(epoch_number, std::launch::async);
+#else
+    (void)epoch_number;
+#endif
+}
+
+void EpochContextCache::ensure(int epoch_number, std::launch policy) {
+    std::shared_future<EpochContextPtr> evicted;
+    std::unique_lock lock{mutex_};
+    Slot& slot{slots_[static_cast<size_t>(epoch_number) % kSlots]};
+    if (slot.epoch_number == epoch_number) {
+        return;
+    }
+    // Released after the lock: dropping a still running background generation waits for it
+    evicted = std::move(slot.context);
+    slot.epoch_number = epoch_number;
+    slot.context = std::async(policy, [epoch_number] {
+                       return EpochContextPtr{ethash::create_epoch_context(epoch_number)};
+                   }).share();
+}
+
+}  // namespace silkworm::consensus
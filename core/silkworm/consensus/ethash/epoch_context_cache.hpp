@@ -0,0 +1,68 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+
+#include <ethash/ethash.hpp>
+
+namespace silkworm::consensus {
+
+//! \brief Process-wide cache of Ethash epoch contexts, shared by all the engines and threads
+//! \remarks Contexts are refcounted: an evicted context lives on until its last user releases it
+class EpochContextCache {
+  public:
+    using EpochContextPtr = std::shared_ptr<const ethash::epoch_context>;
+
+    //! \brief Blocks of an epoch past which the context of the next epoch is generated in background
+    static constexpr uint64_t kPrefetchFromBlock{ethash::epoch_length * 9 / 10};
+
+    static EpochContextCache& instance();
+
+    //! \brief Returns the context of the given epoch, creating it if not cached
+    //! \remarks Concurrent callers asking for the same epoch wait for a single generation
+    EpochContextPtr get(int epoch_number);
+
+    //! \brief Returns the context of the epoch of the given block and, when the end of the epoch is near,
+    //! prefetches the context of the next one
+    EpochContextPtr get_for_block(uint64_t block_number);
+
+    //! \brief Starts generating the context of the given epoch in background, unless already cached
+    //! \remarks Synchronous generation on the first get() for platforms without threads
+    void prefetch(int epoch_number);
+
+  private:
+    EpochContextCache() = default;
+
+    void ensure(int epoch_number, std::launch policy);
+
+    // Three slots so that the current epoch, the previous one (headers straddling the boundary) and the prefetched
+    // next one do not evict each other
+    static constexpr size_t kSlots{3};
+
+    struct Slot {
+        int epoch_number{-1};
+        std::shared_future<EpochContextPtr> context;
+    };
+
+    std::mutex mutex_;  // Guards the slots, not the contexts (read-only once created)
+    Slot slots_[kSlots];
+};
+
+}  // namespace silkworm::consensus
@@ -0,0 +1,55 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "epoch_context_cache.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::consensus {
+
+TEST_CASE("EpochContextCache") {
+    auto& cache{EpochContextCache::instance()};
+
+    SECTION("contexts are shared") {
+        std::vector<EpochContextCache::EpochContextPtr> contexts(4);
+        std::vector<std::thread> threads;
+        for (auto& context : contexts) {
+            threads.emplace_back([&cache, &context] { context = cache.get(0); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& context : contexts) {
+            REQUIRE(context);
+            CHECK(context->epoch_number == 0);
+            CHECK(context == contexts[0]);  // generated once
+        }
+    }
+
+    SECTION("next epoch is prefetched near the end of the current one") {
+        const auto context{cache.get_for_block(EpochContextCache::kPrefetchFromBlock)};
+        CHECK(context->epoch_number == 0);
+        const auto next_context{cache.get(1)};
+        CHECK(next_context->epoch_number == 1);
+        CHECK(cache.get_for_block(ethash::epoch_length) == next_context);
+        CHECK(cache.get(0) == context);  // not evicted by the prefetch
+    }
+}
+
+}  // namespace silkworm::consensus
@@ -32,7 +32,7 @@ ValidationResult MergeEngine::pre_validate_block(const Block& block, const Block
 }
 
 ValidationResult MergeEngine::validate_block_header(const BlockHeader& header, const BlockState& state,
-                                                    bool with_future_timestamp_check) {
+                                                    bool with_future_timestamp_check, bool with_seal_check) {
     // TODO (Andrew) how will all this work with backwards sync?
 
     const std::optional<BlockHeader> parent{EngineBase::get_parent_header(state, header)};
@@ -49,12 +49,12 @@ ValidationResult MergeEngine::validate_block_header(const BlockHeader& header, c
         if (parent_total_difficulty >= terminal_total_difficulty_) {
             return ValidationResult::kPoWBlockAfterMerge;
         }
-        return ethash_engine_.validate_block_header(header, state, with_future_timestamp_check);
+        return ethash_engine_.validate_block_header(header, state, with_future_timestamp_check, with_seal_check);
     } else {
         if (parent->difficulty != 0 && !terminal_pow_block(*parent, state)) {
             return ValidationResult::kPoSBlockBeforeMerge;
         }
-        return pos_engine_.validate_block_header(header, state, with_future_timestamp_check);
+        return pos_engine_.validate_block_header(header, state, with_future_timestamp_check, with_seal_check);
     }
 }
 
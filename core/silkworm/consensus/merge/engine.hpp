@@ -30,7 +30,7 @@ class MergeEngine : public IEngine {
     ValidationResult pre_validate_block(const Block& block, const BlockState& state) override;
 
     ValidationResult validate_block_header(const BlockHeader& header, const BlockState& state,
-                                           bool with_future_timestamp_check) override;
+                                           bool with_future_timestamp_check, bool with_seal_check) override;
 
     ValidationResult validate_seal(const BlockHeader& header) override;
 
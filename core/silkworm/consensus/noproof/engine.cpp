@@ -20,4 +20,8 @@ namespace silkworm::consensus {
 
 ValidationResult NoProofEngine::validate_seal(const BlockHeader&) { return ValidationResult::kOk; }
 
+std::vector<ValidationResult> NoProofEngine::validate_seals(std::span<const BlockHeader* const> headers, size_t) {
+    return std::vector<ValidationResult>(headers.size(), ValidationResult::kOk);
+}
+
 }  // namespace silkworm::consensus
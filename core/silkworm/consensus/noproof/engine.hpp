@@ -28,6 +28,9 @@ class NoProofEngine : public EthashEngine {
 
     //! \brief Validates the seal of the header
     ValidationResult validate_seal(const BlockHeader& header) final;
+
+    std::vector<ValidationResult> validate_seals(std::span<const BlockHeader* const> headers,
+                                                 size_t num_threads) final;
 };
 
 }  // namespace silkworm::consensus
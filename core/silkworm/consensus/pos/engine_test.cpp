@@ -52,15 +52,17 @@ TEST_CASE("Proof-of-Stake consensus engine") {
     InMemoryState state;
     state.insert_block(parent, header.parent_hash);
 
-    CHECK(ethash_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false) ==
-          ValidationResult::kWrongDifficulty);
+    CHECK(ethash_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false,
+                                              /*with_seal_check=*/true) == ValidationResult::kWrongDifficulty);
 
-    CHECK(pos_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false) ==
-          ValidationResult::kOk);
+    CHECK(pos_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false,
+                                           /*with_seal_check=*/true) == ValidationResult::kOk);
 
     header.nonce[2] = 5;
-    CHECK(pos_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false) ==
-          ValidationResult::kInvalidNonce);
+    CHECK(pos_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false,
+                                           /*with_seal_check=*/true) == ValidationResult::kInvalidNonce);
+    CHECK(pos_engine.validate_block_header(header, state, /*with_future_timestamp_check=*/false,
+                                           /*with_seal_check=*/false) == ValidationResult::kOk);
 }
 
 }  // namespace silkworm::consensus
@@ -22,24 +22,46 @@ namespace silkworm {
 
 std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis> AdvancedAnalysisCache::get(const evmc::bytes32& key,
                                                                                    evmc_revision revision) noexcept {
-    if (revision_ == revision) {
-        const auto* ptr{cache_.get(key)};
-        return ptr ? *ptr : nullptr;
-    } else {
+    RevisionCache* cache{caches_[static_cast<size_t>(revision)].get()};
+    if (!cache) {
         return nullptr;
     }
+    const auto* ptr{cache->get(key)};
+    return ptr ? *ptr : nullptr;
 }
 
 void AdvancedAnalysisCache::put(const evmc::bytes32& key,
                                 const std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis>& analysis,
                                 evmc_revision revision) noexcept {
-    if (revision_ != revision) {
-        // multiple revisions are not supported
-        cache_.clear();
+    auto& cache{caches_[static_cast<size_t>(revision)]};
+    if (!cache) {
+        cache = std::make_unique<RevisionCache>(max_size_);
     }
-    revision_ = revision;
+    cache->put(key, analysis);
+}
 
-    cache_.put(key, analysis);
+size_t AdvancedAnalysisCache::size() const noexcept {
+    size_t size{0};
+    for (const auto& cache : caches_) {
+        if (cache) {
+            size += cache->size();
+        }
+    }
+    return size;
+}
+
+AdvancedAnalysisCache::Stats AdvancedAnalysisCache::stats() const noexcept {
+    Stats stats;
+    for (const auto& cache : caches_) {
+        if (cache) {
+            const auto& revision_stats{cache->stats()};
+            stats.hits += revision_stats.hits;
+            stats.misses += revision_stats.misses;
+            stats.evictions += revision_stats.evictions;
+            stats.rejections += revision_stats.rejections;
+        }
+    }
+    return stats;
 }
 
 }  // namespace silkworm
@@ -16,29 +16,35 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/baseline.hpp>
 
 #include <silkworm/common/base.hpp>
-#include <silkworm/common/lru_cache.hpp>
+#include <silkworm/common/tinylfu_cache.hpp>
 
 namespace silkworm {
 
 // Cache of EVM baseline analyses.
-using BaselineAnalysisCache = lru_cache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
+// Frequency-aware replacement keeps hot contracts cached through blocks calling many one-off contracts.
+using BaselineAnalysisCache = tinylfu_cache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
 
 /** @brief Cache of EVM advanced analyses.
  *
- * Adavanced interpreter analyses performed for different EVM revisions do not coexist in the cache
- * and all other revisions are evicted on revision update.
+ * Adavanced interpreter analyses depend on the EVM revision, hence entries are keyed by (code hash, revision).
+ * Each revision has its own capacity budget, so going back and forth across a fork boundary
+ * (e.g. consensus tests or unwinds) does not flush the working set of other revisions.
  */
 class AdvancedAnalysisCache {
   public:
     static constexpr size_t kDefaultMaxSize{5'000};
 
-    explicit AdvancedAnalysisCache(size_t maxSize = kDefaultMaxSize) : cache_{maxSize} {}
+    using Stats = tinylfu_cache<evmc::bytes32, std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis>>::Stats;
+
+    //! \param maxSize : the max number of entries for each revision
+    explicit AdvancedAnalysisCache(size_t maxSize = kDefaultMaxSize) : max_size_{maxSize} {}
 
     // Not copyable nor movable
     AdvancedAnalysisCache(const AdvancedAnalysisCache&) = delete;
@@ -51,14 +57,22 @@ class AdvancedAnalysisCache {
                                                                 evmc_revision revision) noexcept;
 
     /** @brief Puts an EVM analysis into the cache.
-     * All cache entries for other EVM revisions are evicted.
+     * It may evict other entries of the same EVM revision only.
      */
     void put(const evmc::bytes32& key, const std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis>& analysis,
              evmc_revision revision) noexcept;
 
+    //! \brief Overall number of entries across all revisions
+    [[nodiscard]] size_t size() const noexcept;
+
+    //! \brief Counters accumulated across all revisions
+    [[nodiscard]] Stats stats() const noexcept;
+
   private:
-    lru_cache<evmc::bytes32, std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis>> cache_;
-    evmc_revision revision_{EVMC_MAX_REVISION};
+    using RevisionCache = tinylfu_cache<evmc::bytes32, std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis>>;
+
+    size_t max_size_;
+    std::array<std::unique_ptr<RevisionCache>, EVMC_MAX_REVISION + 1> caches_{};  // Lazily created
 };
 
 }  // namespace silkworm
@@ -0,0 +1,50 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "analysis_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("AdvancedAnalysisCache keeps multiple revisions") {
+    AdvancedAnalysisCache cache{/*maxSize=*/2};
+
+    const auto code_hash1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto code_hash2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto analysis1{std::make_shared<evmone::advanced::AdvancedCodeAnalysis>()};
+    const auto analysis2{std::make_shared<evmone::advanced::AdvancedCodeAnalysis>()};
+
+    CHECK(cache.get(code_hash1, EVMC_ISTANBUL) == nullptr);
+
+    cache.put(code_hash1, analysis1, EVMC_ISTANBUL);
+    cache.put(code_hash1, analysis2, EVMC_BERLIN);
+    CHECK(cache.get(code_hash1, EVMC_ISTANBUL) == analysis1);
+    CHECK(cache.get(code_hash1, EVMC_BERLIN) == analysis2);
+    CHECK(cache.get(code_hash1, EVMC_LONDON) == nullptr);
+
+    // Going back and forth across the fork boundary retains both revisions
+    cache.put(code_hash2, analysis2, EVMC_ISTANBUL);
+    CHECK(cache.get(code_hash1, EVMC_BERLIN) == analysis2);
+    CHECK(cache.get(code_hash2, EVMC_ISTANBUL) == analysis2);
+    CHECK(cache.size() == 3);
+
+    const auto stats{cache.stats()};
+    CHECK(stats.hits == 4);
+    CHECK(stats.misses == 2);
+}
+
+}  // namespace silkworm
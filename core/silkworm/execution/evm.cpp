@@ -17,10 +17,13 @@
 #include "evm.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <iterator>
 #include <memory>
+#include <utility>
 
 #include <ethash/keccak.hpp>
 #include <evmone/advanced_execution.hpp>
@@ -30,6 +33,7 @@
 #include <silkpre/precompile.h>
 
 #include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/instrumentation.hpp>
 
 #include "address.hpp"
 
@@ -60,16 +64,44 @@ class DelegatingTracer : public evmone::Tracer {
     IntraBlockState& intra_block_state_;
 };
 
-EVM::EVM(const Block& block, IntraBlockState& state, const ChainConfig& config) noexcept
+ExecutionContext::ExecutionContext() noexcept : vm_{evmc_create_evmone()} {}
+
+ExecutionContext::~ExecutionContext() { vm_->destroy(vm_); }
+
+static uint8_t number_of_precompiles(evmc_revision rev) noexcept {
+    if (rev >= EVMC_ISTANBUL) {
+        return SILKPRE_NUMBER_OF_ISTANBUL_CONTRACTS;
+    } else if (rev >= EVMC_BYZANTIUM) {
+        return SILKPRE_NUMBER_OF_BYZANTIUM_CONTRACTS;
+    } else {
+        return SILKPRE_NUMBER_OF_FRONTIER_CONTRACTS;
+    }
+}
+
+EVM::EVM(const Block& block, IntraBlockState& state, const ChainConfig& config, ExecutionContext* context) noexcept
     : beneficiary{block.header.beneficiary},
       block_{block},
       state_{state},
       config_{config},
-      evm1_{evmc_create_evmone()} {}
+      revision_{config.revision(block.header.number)},
+      number_of_precompiles_{silkworm::number_of_precompiles(revision_)} {
+    if (context) {
+        evm1_ = context->vm();
+        owns_evm1_ = false;
+        state_pool = &context->state_pool();
+    } else {
+        evm1_ = evmc_create_evmone();
+    }
+}
 
-EVM::~EVM() { evm1_->destroy(evm1_); }
+EVM::~EVM() {
+    if (owns_evm1_) {
+        evm1_->destroy(evm1_);
+    }
+}
 
 CallResult EVM::execute(const Transaction& txn, uint64_t gas) noexcept {
+    SILK_SCOPED_TIMER("EVM::execute");
     assert(txn.from.has_value());  // sender must be recovered
 
     txn_ = &txn;
@@ -217,6 +249,35 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
         const int64_t gas{static_cast<int64_t>(contract.gas(input.data(), input.length(), revision()))};
         if (gas < 0 || gas > message.gas) {
             res.status_code = EVMC_OUT_OF_GAS;
+        } else if (precompile_cache && PrecompileCache::is_cacheable(num)) {
+            const evmc::bytes32 key{PrecompileCache::key(num, input)};
+            if (const PrecompileResult* cached{precompile_cache->get(key)}; cached) {
+                if (cached->success) {
+                    res.gas_left -= gas;
+                    // Like silkpre outputs, the copy is released by evmc_free_result_memory
+                    auto data{static_cast<uint8_t*>(std::malloc(cached->output.length()))};
+                    std::memcpy(data, cached->output.data(), cached->output.length());
+                    res.output_size = cached->output.length();
+                    res.output_data = data;
+                    res.release = evmc_free_result_memory;
+                } else {
+                    res.status_code = EVMC_PRECOMPILE_FAILURE;
+                }
+            } else {
+                SilkpreOutput output{contract.run(input.data(), input.length())};
+                PrecompileResult result;
+                if (output.data) {
+                    result.success = true;
+                    result.output.assign(output.data, output.size);
+                    res.gas_left -= gas;
+                    res.output_size = output.size;
+                    res.output_data = output.data;
+                    res.release = evmc_free_result_memory;
+                } else {
+                    res.status_code = EVMC_PRECOMPILE_FAILURE;
+                }
+                precompile_cache->put(key, std::move(result));
+            }
         } else {
             SilkpreOutput output{contract.run(input.data(), input.length())};
             if (output.data) {
@@ -257,17 +318,55 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
 evmc_result EVM::execute(const evmc_message& msg, ByteView code, const evmc::bytes32* code_hash) noexcept {
     const evmc_revision rev{revision()};
 
-    if (exo_evm) {
-        EvmHost host{*this};
-        return exo_evm->execute(exo_evm, &host.get_interface(), host.to_context(), rev, &msg, code.data(), code.size());
+    switch (select_backend(rev, code, code_hash)) {
+        case VmBackend::kExo:
+            // Keep counting executions so that hot code stays hot
+            if (code_hash && baseline_analysis_cache) {
+                baseline_analysis_cache->record_access(*code_hash);
+            }
+            return execute_with_exo_evm(rev, msg, code);
+        case VmBackend::kAdvanced:
+            return execute_with_advanced_interpreter(rev, msg, code, *code_hash);
+        default:
+            return execute_with_baseline_interpreter(rev, msg, code, code_hash);
+    }
+}
+
+VmBackend EVM::select_backend(evmc_revision rev, ByteView code, const evmc::bytes32* code_hash) const noexcept {
+    if (dispatch_policy) {
+        VmCallInfo info;
+        info.revision = rev;
+        info.code_size = code.size();
+        info.has_code_hash = code_hash != nullptr;
+        if (code_hash && baseline_analysis_cache) {
+            info.frequency = baseline_analysis_cache->frequency(*code_hash);
+        }
+        const VmBackend backend{dispatch_policy->select(info)};
+        if (backend == VmBackend::kExo && exo_evm) {
+            return backend;
+        } else if (backend == VmBackend::kAdvanced && code_hash && advanced_analysis_cache) {
+            return backend;
+        } else if (backend == VmBackend::kBaseline) {
+            return backend;
+        }
+        // Selected backend not available: default dispatch
+    }
+
+    if (exo_evm && !dispatch_policy) {
+        return VmBackend::kExo;
     } else if (code_hash && advanced_analysis_cache) {
-        return execute_with_advanced_interpreter(rev, msg, code, *code_hash);
+        return VmBackend::kAdvanced;
     } else {
         // for one-off execution baseline interpreter is generally faster
-        return execute_with_baseline_interpreter(rev, msg, code, code_hash);
+        return VmBackend::kBaseline;
     }
 }
 
+evmc_result EVM::execute_with_exo_evm(evmc_revision rev, const evmc_message& msg, ByteView code) noexcept {
+    EvmHost host{*this};
+    return exo_evm->execute(exo_evm, &host.get_interface(), host.to_context(), rev, &msg, code.data(), code.size());
+}
+
 gsl::owner<EvmoneExecutionState*> EVM::acquire_state() noexcept {
     gsl::owner<EvmoneExecutionState*> state{nullptr};
     if (state_pool) {
@@ -337,28 +436,20 @@ evmc_result EVM::execute_with_advanced_interpreter(evmc_revision rev, const evmc
     return res;
 }
 
-evmc_revision EVM::revision() const noexcept { return config().revision(block_.header.number); }
-
 void EVM::add_tracer(EvmTracer& tracer) noexcept {
     assert(advanced_analysis_cache == nullptr);
 
+    // Tracers cannot be removed from a VM: never install them on a shared one
+    if (!owns_evm1_) {
+        evm1_ = evmc_create_evmone();
+        owns_evm1_ = true;
+    }
+
     const auto vm{static_cast<evmone::VM*>(evm1_)};
     vm->add_tracer(std::make_unique<DelegatingTracer>(tracer, state_));
     tracers_.push_back(std::ref(tracer));
 }
 
-uint8_t EVM::number_of_precompiles() const noexcept {
-    const evmc_revision rev{revision()};
-
-    if (rev >= EVMC_ISTANBUL) {
-        return SILKPRE_NUMBER_OF_ISTANBUL_CONTRACTS;
-    } else if (rev >= EVMC_BYZANTIUM) {
-        return SILKPRE_NUMBER_OF_BYZANTIUM_CONTRACTS;
-    } else {
-        return SILKPRE_NUMBER_OF_FRONTIER_CONTRACTS;
-    }
-}
-
 bool EVM::is_precompiled(const evmc::address& contract) const noexcept {
     if (is_zero(contract)) {
         return false;
@@ -368,6 +459,50 @@ bool EVM::is_precompiled(const evmc::address& contract) const noexcept {
     return contract <= max_precompiled;
 }
 
+namespace {
+
+    //! \brief SSTORE gas refunds of a revision, see EIP-1283, EIP-2200, EIP-2929 and EIP-3529
+    struct SstoreSchedule {
+        bool net_gas_metering{false};         // EIP-1283 (Constantinople) and EIP-2200 (Istanbul onwards)
+        uint64_t clears_refund{0};            // Refund for clearing a slot
+        uint64_t restore_added_refund{0};     // Refund for resetting a slot to its original zero value
+        uint64_t restore_modified_refund{0};  // Refund for resetting a slot to its original non-zero value
+    };
+
+    template <evmc_revision rev>
+    constexpr SstoreSchedule sstore_schedule() noexcept {
+        SstoreSchedule schedule;
+        schedule.net_gas_metering = rev >= EVMC_ISTANBUL || rev == EVMC_CONSTANTINOPLE;
+
+        uint64_t sload_cost{fee::kGSLoadTangerineWhistle};
+        if constexpr (rev >= EVMC_BERLIN) {
+            sload_cost = fee::kWarmStorageReadCost;
+        } else if constexpr (rev >= EVMC_ISTANBUL) {
+            sload_cost = fee::kGSLoadIstanbul;
+        }
+
+        uint64_t sstore_reset_gas{fee::kGSReset};
+        if constexpr (rev >= EVMC_BERLIN) {
+            sstore_reset_gas -= fee::kColdSloadCost;
+        }
+
+        schedule.clears_refund = rev >= EVMC_LONDON ? sstore_reset_gas + fee::kAccessListStorageKeyCost
+                                                    : fee::kRSClear;
+        schedule.restore_added_refund = fee::kGSSet - sload_cost;
+        schedule.restore_modified_refund = sstore_reset_gas - sload_cost;
+        return schedule;
+    }
+
+    template <size_t... revs>
+    constexpr std::array<SstoreSchedule, sizeof...(revs)> sstore_schedules(std::index_sequence<revs...>) noexcept {
+        return {sstore_schedule<static_cast<evmc_revision>(revs)>()...};
+    }
+
+    // Evaluated at compile time for every revision: SSTORE only looks its revision up
+    constexpr auto kSstoreSchedules{sstore_schedules(std::make_index_sequence<EVMC_MAX_REVISION + 1>{})};
+
+}  // namespace
+
 bool EvmHost::account_exists(const evmc::address& address) const noexcept {
     const evmc_revision rev{evm_.revision()};
 
@@ -403,10 +538,8 @@ evmc_storage_status EvmHost::set_storage(const evmc::address& address, const evm
 
     evm_.state().set_storage(address, key, new_val);
 
-    const evmc_revision rev{evm_.revision()};
-    const bool eip1283{rev >= EVMC_ISTANBUL || rev == EVMC_CONSTANTINOPLE};
-
-    if (!eip1283) {
+    const SstoreSchedule& schedule{kSstoreSchedules[static_cast<size_t>(evm_.revision())]};
+    if (!schedule.net_gas_metering) {
         if (is_zero(current_val)) {
             return EVMC_STORAGE_ADDED;
         }
@@ -419,50 +552,31 @@ evmc_storage_status EvmHost::set_storage(const evmc::address& address, const evm
         return EVMC_STORAGE_MODIFIED;
     }
 
-    const uint64_t sload_cost{[rev]() {
-        if (rev >= EVMC_BERLIN) {
-            return fee::kWarmStorageReadCost;
-        } else if (rev >= EVMC_ISTANBUL) {
-            return fee::kGSLoadIstanbul;
-        } else {
-            return fee::kGSLoadTangerineWhistle;
-        }
-    }()};
-
-    uint64_t sstore_reset_gas{fee::kGSReset};
-    if (rev >= EVMC_BERLIN) {
-        sstore_reset_gas -= fee::kColdSloadCost;
-    }
-
     // https://eips.ethereum.org/EIPS/eip-1283
     const evmc::bytes32 original_val{evm_.state().get_original_storage(address, key)};
 
-    // https://eips.ethereum.org/EIPS/eip-3529
-    const uint64_t sstore_clears_refund{rev >= EVMC_LONDON ? sstore_reset_gas + fee::kAccessListStorageKeyCost
-                                                           : fee::kRSClear};
-
     if (original_val == current_val) {
         if (is_zero(original_val)) {
             return EVMC_STORAGE_ADDED;
         }
         if (is_zero(new_val)) {
-            evm_.state().add_refund(sstore_clears_refund);
+            evm_.state().add_refund(schedule.clears_refund);
         }
         return EVMC_STORAGE_MODIFIED;
     } else {
         if (!is_zero(original_val)) {
             if (is_zero(current_val)) {
-                evm_.state().subtract_refund(sstore_clears_refund);
+                evm_.state().subtract_refund(schedule.clears_refund);
             }
             if (is_zero(new_val)) {
-                evm_.state().add_refund(sstore_clears_refund);
+                evm_.state().add_refund(schedule.clears_refund);
             }
         }
         if (original_val == new_val) {
             if (is_zero(original_val)) {
-                evm_.state().add_refund(fee::kGSSet - sload_cost);
+                evm_.state().add_refund(schedule.restore_added_refund);
             } else {
-                evm_.state().add_refund(sstore_reset_gas - sload_cost);
+                evm_.state().add_refund(schedule.restore_modified_refund);
             }
         }
         return EVMC_STORAGE_MODIFIED_AGAIN;
@@ -26,6 +26,8 @@
 #include <silkworm/common/object_pool.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
+#include <silkworm/execution/vm_dispatch.hpp>
 #include <silkworm/state/intra_block_state.hpp>
 #include <silkworm/types/block.hpp>
 
@@ -57,13 +59,39 @@ class EvmTracer {
 
 using EvmoneExecutionState = evmone::advanced::AdvancedExecutionState;
 
+/** @brief Execution resources reusable across EVM instances, e.g. for all the blocks of an execution batch.
+ *
+ * Sharing a context avoids creating a VM instance for each block and keeps the per-call scratch memory
+ * (execution states with their stack and memory pages) allocated in steady state.
+ * Not thread-safe: use one context per execution thread.
+ */
+class ExecutionContext {
+  public:
+    ExecutionContext() noexcept;
+    ~ExecutionContext();
+
+    // Not copyable nor movable
+    ExecutionContext(const ExecutionContext&) = delete;
+    ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+    evmc_vm* vm() const noexcept { return vm_; }
+
+    ObjectPool<EvmoneExecutionState>& state_pool() noexcept { return state_pool_; }
+
+  private:
+    evmc_vm* vm_{nullptr};
+    ObjectPool<EvmoneExecutionState> state_pool_;
+};
+
 class EVM {
   public:
     // Not copyable nor movable
     EVM(const EVM&) = delete;
     EVM& operator=(const EVM&) = delete;
 
-    EVM(const Block& block, IntraBlockState& state, const ChainConfig& config) noexcept;
+    // If context is specified, its VM and state pool are used; the context must outlive this EVM
+    EVM(const Block& block, IntraBlockState& state, const ChainConfig& config,
+        ExecutionContext* context = nullptr) noexcept;
 
     ~EVM();
 
@@ -77,7 +105,8 @@ class EVM {
     // Precondition: txn.from must be recovered
     CallResult execute(const Transaction& txn, uint64_t gas) noexcept;
 
-    evmc_revision revision() const noexcept;
+    // Fixed for the block: evaluated once on construction
+    evmc_revision revision() const noexcept { return revision_; }
 
     void add_tracer(EvmTracer& tracer) noexcept;
     const std::vector<std::reference_wrapper<EvmTracer>>& tracers() const noexcept { return tracers_; };
@@ -92,6 +121,13 @@ class EVM {
 
     evmc_vm* exo_evm{nullptr};  // it's possible to use an exogenous EVMC VM
 
+    // Point to a cache instance in order to memoize results of expensive precompiles (e.g. ecrecover, pairing)
+    PrecompileCache* precompile_cache{nullptr};
+
+    // Point to a policy in order to choose the backend for each call (e.g. exo_evm only for hot contracts)
+    // rather than using exo_evm for all calls
+    VmDispatchPolicy* dispatch_policy{nullptr};
+
     evmc::address beneficiary;  // block.header.beneficiary by default; may be overridden for Clique
 
   private:
@@ -103,26 +139,33 @@ class EVM {
 
     evmc_result execute(const evmc_message& message, ByteView code, const evmc::bytes32* code_hash) noexcept;
 
+    evmc_result execute_with_exo_evm(evmc_revision rev, const evmc_message& message, ByteView code) noexcept;
+
     evmc_result execute_with_baseline_interpreter(evmc_revision rev, const evmc_message& message, ByteView code,
                                                   const evmc::bytes32* code_hash) noexcept;
 
     evmc_result execute_with_advanced_interpreter(evmc_revision rev, const evmc_message& message, ByteView code,
                                                   const evmc::bytes32& code_hash) noexcept;
 
+    VmBackend select_backend(evmc_revision rev, ByteView code, const evmc::bytes32* code_hash) const noexcept;
+
     gsl::owner<EvmoneExecutionState*> acquire_state() noexcept;
     void release_state(gsl::owner<EvmoneExecutionState*> state) noexcept;
 
-    uint8_t number_of_precompiles() const noexcept;
+    uint8_t number_of_precompiles() const noexcept { return number_of_precompiles_; }
     bool is_precompiled(const evmc::address& contract) const noexcept;
 
     const Block& block_;
     IntraBlockState& state_;
     const ChainConfig& config_;
+    const evmc_revision revision_;
+    const uint8_t number_of_precompiles_;
     const Transaction* txn_{nullptr};
     std::vector<evmc::bytes32> block_hashes_{};
     std::vector<std::reference_wrapper<EvmTracer>> tracers_;
 
     evmc_vm* evm1_{nullptr};
+    bool owns_evm1_{true};  // false when evm1_ belongs to an ExecutionContext
 };
 
 class EvmHost : public evmc::Host {
@@ -650,6 +650,72 @@ TEST_CASE("Tracing precompiled contract failure") {
     CHECK(res.status == EVMC_PRECOMPILE_FAILURE);
 }
 
+TEST_CASE("Precompile cache") {
+    Block block{};
+    block.header.number = 10'336'006;
+    evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    EVM evm{block, state, kMainnetConfig};
+    PrecompileCache cache;
+    evm.precompile_cache = &cache;
+
+    Transaction txn{};
+    txn.from = caller;
+    uint64_t gas{50'000};
+
+    SECTION("ecrecover") {
+        txn.to = 0x0000000000000000000000000000000000000001_address;
+        txn.data = *from_hex(
+            "38d18acb67d25c8bb9942764b62f18e17054f66a817bd4295423adf9ed98873e"
+            "000000000000000000000000000000000000000000000000000000000000001b"
+            "38d18acb67d25c8bb9942764b62f18e17054f66a817bd4295423adf9ed98873e"
+            "789d1dd423d25f0772d2748d60f7e4b81bb14d086eba8e8e8efb6dcff8a4ae02");
+
+        evm.precompile_cache = nullptr;
+        const CallResult expected{evm.execute(txn, gas)};
+        REQUIRE(expected.status == EVMC_SUCCESS);
+        CHECK(expected.data.length() == 32);
+
+        evm.precompile_cache = &cache;
+        for (int i{0}; i < 2; ++i) {
+            CallResult res{evm.execute(txn, gas)};
+            CHECK(res.status == expected.status);
+            CHECK(res.gas_left == expected.gas_left);
+            CHECK(res.data == expected.data);
+        }
+        CHECK(cache.size() == 1);
+        CHECK(cache.stats().hits == 1);
+        CHECK(cache.stats().misses == 1);
+        CHECK(cache.hit_rate() == 0.5);
+
+        // Same input to another precompile is a different entry
+        CHECK(PrecompileCache::key(0x01, txn.data) != PrecompileCache::key(0x05, txn.data));
+    }
+
+    SECTION("Failures are cached too") {
+        evmc::address max_precompiled{};
+        max_precompiled.bytes[kAddressLength - 1] = SILKPRE_NUMBER_OF_ISTANBUL_CONTRACTS;
+        txn.to = max_precompiled;
+        for (int i{0}; i < 2; ++i) {
+            CallResult res{evm.execute(txn, gas)};
+            CHECK(res.status == EVMC_PRECOMPILE_FAILURE);
+        }
+        CHECK(cache.stats().hits == 1);
+    }
+
+    SECTION("Cheap precompiles are not cached") {
+        txn.to = 0x0000000000000000000000000000000000000004_address;  // identity
+        txn.data = *from_hex("c0ffee");
+        CallResult res{evm.execute(txn, gas)};
+        CHECK(res.status == EVMC_SUCCESS);
+        CHECK(res.data == txn.data);
+        CHECK(cache.size() == 0);
+        CHECK_FALSE(cache.hit_rate());
+    }
+}
+
 TEST_CASE("Smart contract creation w/ insufficient balance") {
     Block block{};
     block.header.number = 1;
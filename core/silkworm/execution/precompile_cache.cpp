@@ -0,0 +1,51 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "precompile_cache.hpp"
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+bool PrecompileCache::is_cacheable(uint8_t num) noexcept {
+    switch (num) {
+        case 0x02:  // sha256
+        case 0x03:  // ripemd160
+        case 0x04:  // identity
+            return false;
+        default:
+            return true;
+    }
+}
+
+evmc::bytes32 PrecompileCache::key(uint8_t num, ByteView input) noexcept {
+    evmc::bytes32 key{bit_cast<evmc_bytes32>(keccak256(input))};
+    // Folding the precompile number into the hash avoids copying the input to prepend it
+    key.bytes[0] ^= num;
+    return key;
+}
+
+std::optional<double> PrecompileCache::hit_rate() const noexcept {
+    const Stats& s{cache_.stats()};
+    const uint64_t lookups{s.hits + s.misses};
+    if (lookups == 0) {
+        return std::nullopt;
+    }
+    return static_cast<double>(s.hits) / static_cast<double>(lookups);
+}
+
+}  // namespace silkworm
@@ -0,0 +1,76 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/tinylfu_cache.hpp>
+
+namespace silkworm {
+
+//! \brief Outcome of a precompiled contract run (without gas, which is computed separately)
+struct PrecompileResult {
+    bool success{false};
+    Bytes output;
+};
+
+/** @brief Memoizes the outputs of expensive precompiled contracts, keyed by (precompile, input hash).
+ *
+ * Precompiled contracts are pure functions of their input, hence results stay valid across blocks and revisions.
+ * Only precompiles whose run is much more expensive than hashing their input are cached
+ * (i.e. ecrecover, modexp, BN256 add/mul/pairing, blake2f): sha256, ripemd160 and identity are not.
+ * Not thread-safe: use one cache per execution thread.
+ */
+class PrecompileCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{10'000};
+
+    using Stats = tinylfu_cache<evmc::bytes32, PrecompileResult>::Stats;
+
+    explicit PrecompileCache(size_t max_size = kDefaultMaxSize) : cache_{max_size} {}
+
+    // Not copyable nor movable
+    PrecompileCache(const PrecompileCache&) = delete;
+    PrecompileCache& operator=(const PrecompileCache&) = delete;
+
+    //! \brief Whether results of the precompile at address 0x..num are worth caching
+    [[nodiscard]] static bool is_cacheable(uint8_t num) noexcept;
+
+    //! \brief Cache key of a precompile run
+    [[nodiscard]] static evmc::bytes32 key(uint8_t num, ByteView input) noexcept;
+
+    //! \brief Gets a cached result, if any
+    [[nodiscard]] const PrecompileResult* get(const evmc::bytes32& key) noexcept { return cache_.get(key); }
+
+    //! \brief Puts a result into the cache, possibly evicting less frequently used ones
+    void put(const evmc::bytes32& key, PrecompileResult result) { cache_.put(key, result); }
+
+    [[nodiscard]] size_t size() const noexcept { return cache_.size(); }
+
+    void clear() noexcept { cache_.clear(); }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return cache_.stats(); }
+
+    //! \brief Ratio of lookups served from the cache, nullopt if no lookup has been done
+    [[nodiscard]] std::optional<double> hit_rate() const noexcept;
+
+  private:
+    tinylfu_cache<evmc::bytes32, PrecompileResult> cache_;
+};
+
+}  // namespace silkworm
@@ -18,6 +18,14 @@
 
 #include <cassert>
 
+#if !defined(__wasm__)
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
 #include <silkworm/chain/dao.hpp>
 #include <silkworm/chain/intrinsic_gas.hpp>
 #include <silkworm/chain/protocol_param.hpp>
@@ -25,9 +33,20 @@
 
 namespace silkworm {
 
+#if !defined(__wasm__)
+struct ExecutionProcessor::Speculation {
+    // N.B. declaration order matters: processor must be destroyed before the state it reads from
+    std::unique_ptr<RecordingState> db;
+    std::unique_ptr<ExecutionProcessor> processor;
+    ValidationResult result{ValidationResult::kOk};
+    Receipt receipt;
+    uint64_t gas_used{0};
+};
+#endif
+
 ExecutionProcessor::ExecutionProcessor(const Block& block, consensus::IEngine& consensus_engine, State& state,
-                                       const ChainConfig& config)
-    : state_{state}, consensus_engine_{consensus_engine}, evm_{block, state_, config} {
+                                       const ChainConfig& config, ExecutionContext* context)
+    : state_{state}, consensus_engine_{consensus_engine}, evm_{block, state_, config, context} {
     evm_.beneficiary = consensus_engine.get_beneficiary(block.header);
 }
 
@@ -103,9 +122,11 @@ void ExecutionProcessor::execute_transaction(const Transaction& txn, Receipt& re
 
     const uint64_t gas_used{txn.gas_limit - refund_gas(txn, vm_res.gas_left)};
 
-    // award the fee recipient
-    const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
-    state_.add_to_balance(evm_.beneficiary, priority_fee_per_gas * gas_used);
+    // award the fee recipient (deferred to commit when speculating)
+    if (!speculative_) {
+        const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
+        state_.add_to_balance(evm_.beneficiary, priority_fee_per_gas * gas_used);
+    }
 
     state_.destruct_suicides();
     if (rev >= EVMC_SPURIOUS_DRAGON) {
@@ -156,14 +177,23 @@ ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vecto
     cumulative_gas_used_ = 0;
 
     receipts.resize(block.transactions.size());
-    auto receipt_it{receipts.begin()};
-    for (const auto& txn : block.transactions) {
-        const ValidationResult err{validate_transaction(txn)};
-        if (err != ValidationResult::kOk) {
+#if !defined(__wasm__)
+    if (can_execute_in_parallel()) {
+        if (const ValidationResult err{execute_transactions_in_parallel(receipts)}; err != ValidationResult::kOk) {
             return err;
         }
-        execute_transaction(txn, *receipt_it);
-        ++receipt_it;
+    } else
+#endif
+    {
+        auto receipt_it{receipts.begin()};
+        for (const auto& txn : block.transactions) {
+            const ValidationResult err{validate_transaction(txn)};
+            if (err != ValidationResult::kOk) {
+                return err;
+            }
+            execute_transaction(txn, *receipt_it);
+            ++receipt_it;
+        }
     }
 
     consensus_engine_.finalize(state_, block, evm_.revision());
@@ -171,6 +201,120 @@ ValidationResult ExecutionProcessor::execute_block_no_post_validation(std::vecto
     return ValidationResult::kOk;
 }
 
+bool ExecutionProcessor::can_execute_in_parallel() const noexcept {
+    const Block& block{evm_.block()};
+    // DAO balance transfers happen before the first transaction and are not visible to speculations
+    return parallel_workers_ > 1 && block.transactions.size() > 1 && block.header.number != evm_.config().dao_block &&
+           evm_.tracers().empty() && evm_.exo_evm == nullptr;
+}
+
+#if !defined(__wasm__)
+
+ValidationResult ExecutionProcessor::execute_transactions_in_parallel(std::vector<Receipt>& receipts) noexcept {
+    const std::vector<Transaction>& transactions{evm_.block().transactions};
+    const size_t num_txns{transactions.size()};
+
+    // Speculate all transactions concurrently against the state at the beginning of the block
+    std::vector<Speculation> speculations(num_txns);
+    std::mutex db_mutex;
+    std::atomic<size_t> next_txn{0};
+    const size_t num_workers{std::min(parallel_workers_, num_txns)};
+    std::vector<ExecutionContext> contexts(num_workers);  // Must outlive speculations
+    const auto speculate_all{[&](ExecutionContext& context) {
+        static constexpr size_t kAnalysisCacheSize{256};
+        BaselineAnalysisCache analysis_cache{kAnalysisCacheSize};
+        for (size_t i{next_txn++}; i < num_txns; i = next_txn++) {
+            speculate(transactions[i], speculations[i], db_mutex, analysis_cache, context);
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers - 1);
+    for (size_t i{1}; i < num_workers; ++i) {
+        workers.emplace_back(speculate_all, std::ref(contexts[i]));
+    }
+    speculate_all(contexts[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Commit in order: a speculation is valid unless it read something written by a preceding transaction.
+    // Every transaction writes to the fee recipient, hence any read of it invalidates the speculation.
+    state::AccessSet block_writes;
+    state_.set_write_tracking(true);
+    ValidationResult res{ValidationResult::kOk};
+    for (size_t i{0}; i < num_txns; ++i) {
+        const Transaction& txn{transactions[i]};
+        Speculation& speculation{speculations[i]};
+
+        res = validate_transaction(txn);
+        if (res != ValidationResult::kOk) {
+            break;
+        }
+
+        const state::AccessSet& reads{speculation.db->reads()};
+        const bool valid{speculation.result == ValidationResult::kOk && !reads.accounts.contains(evm_.beneficiary) &&
+                         !reads.intersects(block_writes)};
+
+        state_.clear_writes();
+        if (valid) {
+            commit(txn, speculation, receipts[i]);
+        } else {
+            execute_transaction(txn, receipts[i]);
+        }
+        block_writes.merge(state_.writes());
+
+        speculation.processor.reset();
+        speculation.db.reset();
+    }
+    state_.set_write_tracking(false);
+    state_.clear_writes();
+
+    return res;
+}
+
+void ExecutionProcessor::speculate(const Transaction& txn, Speculation& speculation, std::mutex& db_mutex,
+                                   BaselineAnalysisCache& analysis_cache, ExecutionContext& context) noexcept {
+    speculation.db = std::make_unique<RecordingState>(state_.db(), db_mutex);
+    speculation.processor = std::make_unique<ExecutionProcessor>(evm_.block(), consensus_engine_, *speculation.db,
+                                                                 evm_.config(), &context);
+
+    ExecutionProcessor& processor{*speculation.processor};
+    processor.speculative_ = true;
+    processor.evm_.beneficiary = evm_.beneficiary;
+    processor.evm_.baseline_analysis_cache = &analysis_cache;
+    processor.state_.set_write_tracking(true);
+
+    speculation.result = processor.validate_transaction(txn);
+    if (speculation.result == ValidationResult::kOk) {
+        processor.execute_transaction(txn, speculation.receipt);
+        speculation.gas_used = processor.cumulative_gas_used();
+    }
+}
+
+void ExecutionProcessor::commit(const Transaction& txn, Speculation& speculation, Receipt& receipt) noexcept {
+    // Same sequence of execute_transaction with the VM execution replaced by the speculation outcome
+    state_.clear_journal_and_substate();
+    state_.merge_transaction(speculation.processor->state_);
+
+    const intx::uint256 base_fee_per_gas{evm_.block().header.base_fee_per_gas.value_or(0)};
+    const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
+    state_.add_to_balance(evm_.beneficiary, priority_fee_per_gas * speculation.gas_used);
+
+    // Dead accounts touched by the transaction itself have already been destructed by the speculation
+    if (evm_.revision() >= EVMC_SPURIOUS_DRAGON) {
+        state_.destruct_touched_dead();
+    }
+
+    state_.finalize_transaction();
+
+    cumulative_gas_used_ += speculation.gas_used;
+
+    receipt = std::move(speculation.receipt);
+    receipt.cumulative_gas_used = cumulative_gas_used_;
+}
+#endif  // !defined(__wasm__)
+
 ValidationResult ExecutionProcessor::execute_and_write_block(std::vector<Receipt>& receipts) noexcept {
     if (const ValidationResult res{execute_block_no_post_validation(receipts)}; res != ValidationResult::kOk) {
         return res;
@@ -184,7 +328,9 @@ ValidationResult ExecutionProcessor::execute_and_write_block(std::vector<Receipt
 
     if (evm_.revision() >= EVMC_BYZANTIUM) {
         static constexpr auto kEncoder = [](Bytes& to, const Receipt& r) { rlp::encode(to, r); };
-        evmc::bytes32 receipt_root{trie::root_hash(receipts, kEncoder)};
+        const evmc::bytes32 receipt_root{receipts.size() >= trie::kParallelRootHashThreshold && parallel_workers_ > 1
+                                             ? trie::parallel_root_hash(receipts, kEncoder, parallel_workers_)
+                                             : trie::root_hash(receipts, kEncoder)};
         if (receipt_root != header.receipts_root) {
             return ValidationResult::kWrongReceiptsRoot;
         }
@@ -17,10 +17,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <silkworm/consensus/engine.hpp>
 #include <silkworm/execution/evm.hpp>
+#include <silkworm/state/recording_state.hpp>
 #include <silkworm/state/state.hpp>
 #include <silkworm/types/block.hpp>
 #include <silkworm/types/receipt.hpp>
@@ -33,7 +35,9 @@ class ExecutionProcessor {
     ExecutionProcessor(const ExecutionProcessor&) = delete;
     ExecutionProcessor& operator=(const ExecutionProcessor&) = delete;
 
-    ExecutionProcessor(const Block& block, consensus::IEngine& engine, State& state, const ChainConfig& config);
+    // If context is specified, it is shared by the EVM (see ExecutionContext) and must outlive this processor
+    ExecutionProcessor(const Block& block, consensus::IEngine& engine, State& state, const ChainConfig& config,
+                       ExecutionContext* context = nullptr);
 
     // Preconditions:
     // 1) consensus' pre_validate_transaction(txn) must return kOk
@@ -51,6 +55,14 @@ class ExecutionProcessor {
 
     uint64_t cumulative_gas_used() const noexcept { return cumulative_gas_used_; }
 
+    //! \brief Enables optimistic parallel execution of block transactions using the given number of threads.
+    //! \details Transactions are first executed speculatively and concurrently against the state at the beginning
+    //! of the block, each one recording the accounts and storage it reads. They are then committed in order:
+    //! a transaction that read anything written by a preceding one is re-executed sequentially.
+    //! Receipts and state changes are identical to those of sequential execution.
+    //! \remarks Ignored (i.e. sequential execution) when tracers or an exogenous VM are in use.
+    void set_parallel_workers(size_t num_workers) noexcept { parallel_workers_ = num_workers; }
+
     EVM& evm() noexcept { return evm_; }
     const EVM& evm() const noexcept { return evm_; }
 
@@ -63,10 +75,25 @@ class ExecutionProcessor {
     uint64_t available_gas() const noexcept;
     uint64_t refund_gas(const Transaction& txn, uint64_t gas_left) noexcept;
 
+    [[nodiscard]] bool can_execute_in_parallel() const noexcept;
+
+#if !defined(__wasm__)
+    // Outcome of a transaction executed speculatively on its own IntraBlockState
+    struct Speculation;
+
+    [[nodiscard]] ValidationResult execute_transactions_in_parallel(std::vector<Receipt>& receipts) noexcept;
+    void speculate(const Transaction& txn, Speculation& speculation, std::mutex& db_mutex,
+                   BaselineAnalysisCache& analysis_cache, ExecutionContext& context) noexcept;
+    void commit(const Transaction& txn, Speculation& speculation, Receipt& receipt) noexcept;
+#endif
+
     uint64_t cumulative_gas_used_{0};
     IntraBlockState state_;
     consensus::IEngine& consensus_engine_;
     EVM evm_;
+
+    size_t parallel_workers_{0};
+    bool speculative_{false};  // When true the fee recipient is not awarded, see commit
 };
 
 }  // namespace silkworm
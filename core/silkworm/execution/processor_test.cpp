@@ -437,3 +437,93 @@ TEST_CASE("Empty suicide beneficiary") {
 }
 
 }  // namespace silkworm
+
+TEST_CASE("Parallel execution yields the same results as sequential one") {
+    Block block{};
+    block.header.number = 4'000'000;  // pre-Byzantium: receipts root is not checked
+    block.header.gas_limit = 10'000'000;
+    block.header.beneficiary = 0x4bb96091ee9d802ed039c4d1a5f6216f90f81b01_address;
+
+    const evmc::address sender1{0x00000000000000000000000000000000000a0001_address};
+    const evmc::address sender2{0x00000000000000000000000000000000000a0002_address};
+    const evmc::address sender3{0x00000000000000000000000000000000000a0003_address};
+    const evmc::address sender4{0x00000000000000000000000000000000000a0004_address};
+
+    const auto make_txn{[](const evmc::address& from, uint64_t nonce, std::optional<evmc::address> to, Bytes data) {
+        Transaction txn{
+            Transaction::Type::kLegacy,  // type
+            nonce,                       // nonce
+            10 * kGiga,                  // max_priority_fee_per_gas
+            10 * kGiga,                  // max_fee_per_gas
+            200'000,                     // gas_limit
+            to,                          // to
+            1'000,                       // value
+            std::move(data),             // data
+            false,                       // odd_y_parity
+            std::nullopt,                // chain_id
+            1,                           // r
+            1,                           // s
+        };
+        txn.from = from;
+        return txn;
+    }};
+
+    // This contract initially sets its 0th storage to 0x2a and its 1st storage to 0x01c9.
+    // When called, it updates its 0th storage to the input provided.
+    const Bytes deployment_code{*from_hex("602a6000556101c960015560068060166000396000f3600035600055")};
+    const evmc::address contract{create_address(sender4, 0)};
+
+    block.transactions = {
+        make_txn(sender1, 0, 0x00000000000000000000000000000000000b0001_address, {}),
+        make_txn(sender2, 0, 0x00000000000000000000000000000000000b0002_address, {}),
+        make_txn(sender4, 0, std::nullopt, deployment_code),
+        make_txn(sender1, 1, 0x00000000000000000000000000000000000b0003_address, {}),  // same sender as 1st
+        make_txn(sender3, 0, sender2, {}),                                             // reads account of 2nd
+        make_txn(sender4, 1, contract, *from_hex("0x2b")),                             // calls contract of 3rd
+    };
+
+    const auto execute{[&](size_t num_workers, InMemoryState& state, std::vector<Receipt>& receipts) {
+        for (const auto& sender : {sender1, sender2, sender3, sender4}) {
+            Account account{};
+            account.balance = kEther;
+            state.update_account(sender, /*initial=*/std::nullopt, account);
+        }
+        auto engine{consensus::engine_factory(kMainnetConfig)};
+        ExecutionProcessor processor{block, *engine, state, kMainnetConfig};
+        processor.set_parallel_workers(num_workers);
+        return processor.execute_and_write_block(receipts);
+    }};
+
+    // Find out the overall gas used
+    {
+        InMemoryState state;
+        std::vector<Receipt> receipts;
+        REQUIRE(execute(/*num_workers=*/1, state, receipts) == ValidationResult::kWrongBlockGas);
+        block.header.gas_used = receipts.back().cumulative_gas_used;
+    }
+
+    InMemoryState sequential_state;
+    std::vector<Receipt> sequential_receipts;
+    REQUIRE(execute(/*num_workers=*/1, sequential_state, sequential_receipts) == ValidationResult::kOk);
+
+    InMemoryState parallel_state;
+    std::vector<Receipt> parallel_receipts;
+    REQUIRE(execute(/*num_workers=*/4, parallel_state, parallel_receipts) == ValidationResult::kOk);
+
+    REQUIRE(sequential_receipts.size() == parallel_receipts.size());
+    for (size_t i{0}; i < sequential_receipts.size(); ++i) {
+        CHECK(sequential_receipts[i].success == parallel_receipts[i].success);
+        CHECK(sequential_receipts[i].cumulative_gas_used == parallel_receipts[i].cumulative_gas_used);
+        CHECK(sequential_receipts[i].bloom == parallel_receipts[i].bloom);
+    }
+    CHECK(sequential_state.accounts() == parallel_state.accounts());
+    CHECK(sequential_state.account_changes() == parallel_state.account_changes());
+    CHECK(sequential_state.state_root_hash() == parallel_state.state_root_hash());
+
+    // CALLDATALOAD pads the input on the right
+    evmc::bytes32 expected_storage{};
+    expected_storage.bytes[0] = 0x2b;
+    CHECK(parallel_state.read_storage(contract, kDefaultIncarnation, {}) == expected_storage);
+}
+
+}  // namespace silkworm
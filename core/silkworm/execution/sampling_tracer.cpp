@@ -0,0 +1,114 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sampling_tracer.hpp"
+
+#include <algorithm>
+
+namespace silkworm {
+
+void ExecutionProfile::merge(const ExecutionProfile& other) {
+    samples += other.samples;
+    for (size_t i{0}; i < opcode_samples.size(); ++i) {
+        opcode_samples[i] += other.opcode_samples[i];
+    }
+    for (const auto& [address, value] : other.contract_samples) {
+        contract_samples[address] += value;
+    }
+    for (const auto& [address, value] : other.contract_gas) {
+        contract_gas[address] += value;
+    }
+    for (const auto& [address, value] : other.contract_executions) {
+        contract_executions[address] += value;
+    }
+}
+
+void ExecutionProfile::clear() noexcept {
+    samples = 0;
+    opcode_samples.fill(0);
+    contract_samples.clear();
+    contract_gas.clear();
+    contract_executions.clear();
+}
+
+std::vector<std::pair<uint8_t, uint64_t>> ExecutionProfile::top_opcodes(size_t n) const {
+    std::vector<std::pair<uint8_t, uint64_t>> ret;
+    for (size_t i{0}; i < opcode_samples.size(); ++i) {
+        if (opcode_samples[i]) {
+            ret.emplace_back(static_cast<uint8_t>(i), opcode_samples[i]);
+        }
+    }
+    const auto last{ret.begin() + static_cast<std::ptrdiff_t>(std::min(n, ret.size()))};
+    std::partial_sort(ret.begin(), last, ret.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    ret.erase(last, ret.end());
+    return ret;
+}
+
+std::vector<std::pair<evmc::address, uint64_t>> ExecutionProfile::top_contracts_by_gas(size_t n) const {
+    std::vector<std::pair<evmc::address, uint64_t>> ret{contract_gas.begin(), contract_gas.end()};
+    const auto last{ret.begin() + static_cast<std::ptrdiff_t>(std::min(n, ret.size()))};
+    std::partial_sort(ret.begin(), last, ret.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    ret.erase(last, ret.end());
+    return ret;
+}
+
+SamplingTracer::SamplingTracer(uint32_t sample_interval) noexcept
+    : sample_interval_{std::max(sample_interval, 1u)}, countdown_{sample_interval_} {}
+
+void SamplingTracer::on_execution_start(evmc_revision, const evmc_message& msg, evmone::bytes_view code) noexcept {
+    // Contract deployment messages have no code address
+    const bool has_code_address{msg.code_address != evmc::address{}};
+    frames_.push_back({code, has_code_address ? msg.code_address : msg.recipient, msg.gas, 0});
+}
+
+void SamplingTracer::on_instruction_start(uint32_t pc, const intx::uint256*, int, const evmone::ExecutionState&,
+                                          const IntraBlockState&) noexcept {
+    if (--countdown_ != 0) {
+        return;
+    }
+    countdown_ = sample_interval_;
+    if (frames_.empty()) {
+        return;
+    }
+    const Frame& frame{frames_.back()};
+    if (pc < frame.code.size()) {
+        ++profile_.samples;
+        ++profile_.opcode_samples[frame.code[pc]];
+        ++profile_.contract_samples[frame.contract];
+    }
+}
+
+void SamplingTracer::on_execution_end(const evmc_result& result, const IntraBlockState&) noexcept {
+    if (frames_.empty()) {
+        return;
+    }
+    const Frame frame{frames_.back()};
+    frames_.pop_back();
+
+    const int64_t gas_used{std::max<int64_t>(frame.gas - result.gas_left, 0)};
+    const int64_t own_gas_used{std::max<int64_t>(gas_used - frame.nested_gas_used, 0)};
+    profile_.contract_gas[frame.contract] += static_cast<uint64_t>(own_gas_used);
+    ++profile_.contract_executions[frame.contract];
+    if (!frames_.empty()) {
+        frames_.back().nested_gas_used += gas_used;
+    }
+}
+
+void SamplingTracer::on_precompiled_run(const evmc_result&, int64_t, const IntraBlockState&) noexcept {}
+
+void SamplingTracer::on_reward_granted(const CallResult&, const IntraBlockState&) noexcept {}
+
+}  // namespace silkworm
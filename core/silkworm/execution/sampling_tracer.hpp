@@ -0,0 +1,89 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <silkworm/common/hash_maps.hpp>
+#include <silkworm/execution/evm.hpp>
+
+namespace silkworm {
+
+//! Statistical profile of EVM execution
+struct ExecutionProfile {
+    uint64_t samples{0};
+    std::array<uint64_t, 256> opcode_samples{};                // Samples per opcode
+    FlatHashMap<evmc::address, uint64_t> contract_samples;     // Samples per contract (i.e. code address)
+    FlatHashMap<evmc::address, uint64_t> contract_gas;         // Gas used per contract, excluding nested calls
+    FlatHashMap<evmc::address, uint64_t> contract_executions;  // Call frames per contract
+
+    void merge(const ExecutionProfile& other);
+    void clear() noexcept;
+
+    //! \brief The n opcodes with most samples, in descending order
+    [[nodiscard]] std::vector<std::pair<uint8_t, uint64_t>> top_opcodes(size_t n) const;
+
+    //! \brief The n contracts which used most gas, in descending order
+    [[nodiscard]] std::vector<std::pair<evmc::address, uint64_t>> top_contracts_by_gas(size_t n) const;
+};
+
+/** @brief Low-overhead tracer profiling EVM execution.
+ *
+ * Only one instruction every sample_interval is recorded (opcode and contract), while gas is accounted per call
+ * frame, so the profile is cheap enough to be collected in production.
+ * Not thread-safe: use one tracer per execution thread and merge the profiles.
+ */
+class SamplingTracer : public EvmTracer {
+  public:
+    static constexpr uint32_t kDefaultSampleInterval{1'000};
+
+    explicit SamplingTracer(uint32_t sample_interval = kDefaultSampleInterval) noexcept;
+
+    void on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept override;
+
+    void on_instruction_start(uint32_t pc, const intx::uint256* stack_top, int stack_height,
+                              const evmone::ExecutionState& state,
+                              const IntraBlockState& intra_block_state) noexcept override;
+
+    void on_execution_end(const evmc_result& result, const IntraBlockState& intra_block_state) noexcept override;
+
+    void on_precompiled_run(const evmc_result& result, int64_t gas,
+                            const IntraBlockState& intra_block_state) noexcept override;
+
+    void on_reward_granted(const CallResult& result, const IntraBlockState& intra_block_state) noexcept override;
+
+    [[nodiscard]] const ExecutionProfile& profile() const noexcept { return profile_; }
+    void clear_profile() noexcept { profile_.clear(); }
+
+  private:
+    struct Frame {
+        evmone::bytes_view code;
+        evmc::address contract;
+        int64_t gas{0};
+        int64_t nested_gas_used{0};
+    };
+
+    const uint32_t sample_interval_;
+    uint32_t countdown_;
+    std::vector<Frame> frames_;
+    ExecutionProfile profile_;
+};
+
+}  // namespace silkworm
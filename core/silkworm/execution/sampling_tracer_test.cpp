@@ -0,0 +1,82 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sampling_tracer.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/test_util.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+
+#include "address.hpp"
+
+namespace silkworm {
+
+TEST_CASE("SamplingTracer") {
+    Block block{};
+    block.header.number = 10'336'006;
+    const evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+
+    // Deploys a contract setting storage[0] = 0x2a and storage[1] = 0x01c9
+    // (see "Tracing smart contract with storage" in evm_test.cpp)
+    const Bytes code{*from_hex("602a6000556101c960015560068060166000396000f3600035600055")};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    EVM evm{block, state, kMainnetConfig};
+
+    SamplingTracer tracer{/*sample_interval=*/1};
+    evm.add_tracer(tracer);
+
+    Transaction txn{};
+    txn.from = caller;
+    txn.data = code;
+
+    const uint64_t gas{100'000};
+    const CallResult res{evm.execute(txn, gas)};
+    REQUIRE(res.status == EVMC_SUCCESS);
+
+    // 13 instructions executed by the init code
+    const ExecutionProfile& profile{tracer.profile()};
+    CHECK(profile.samples == 13);
+    CHECK(profile.opcode_samples[0x60] == 7);  // PUSH1
+    CHECK(profile.opcode_samples[0x55] == 2);  // SSTORE
+
+    const evmc::address contract{create_address(caller, 0)};
+    CHECK(profile.contract_samples.at(contract) == 13);
+    CHECK(profile.contract_executions.at(contract) == 1);
+    // Code deposit is charged after execution
+    const uint64_t execution_gas{gas - res.gas_left - 6 * fee::kGCodeDeposit};
+    CHECK(profile.contract_gas.at(contract) == execution_gas);
+
+    const auto top_opcodes{profile.top_opcodes(2)};
+    REQUIRE(top_opcodes.size() == 2);
+    CHECK(top_opcodes[0] == std::pair<uint8_t, uint64_t>{0x60, 7});
+    CHECK(top_opcodes[1].second == 2);
+
+    ExecutionProfile aggregate;
+    aggregate.merge(profile);
+    aggregate.merge(profile);
+    CHECK(aggregate.samples == 24);
+    CHECK(aggregate.top_contracts_by_gas(10) ==
+          std::vector<std::pair<evmc::address, uint64_t>>{{contract, 2 * execution_gas}});
+
+    tracer.clear_profile();
+    CHECK(tracer.profile().samples == 0);
+}
+
+}  // namespace silkworm
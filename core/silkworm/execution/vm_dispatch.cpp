@@ -0,0 +1,32 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "vm_dispatch.hpp"
+
+namespace silkworm {
+
+VmBackend ThresholdDispatchPolicy::select(const VmCallInfo& info) noexcept {
+    if (!info.has_code_hash) {
+        return VmBackend::kBaseline;
+    }
+    if (info.code_size >= settings_.min_code_size && info.frequency >= settings_.min_frequency &&
+        info.revision <= settings_.max_revision) {
+        return VmBackend::kExo;
+    }
+    return settings_.use_advanced ? VmBackend::kAdvanced : VmBackend::kBaseline;
+}
+
+}  // namespace silkworm
@@ -0,0 +1,76 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <evmc/evmc.h>
+
+namespace silkworm {
+
+//! Backends available to execute EVM code
+enum class VmBackend {
+    kBaseline,  // evmone baseline interpreter
+    kAdvanced,  // evmone advanced interpreter (requires EVM::advanced_analysis_cache)
+    kExo,       // exogenous EVMC VM, e.g. a JIT/AOT compiler (requires EVM::exo_evm)
+};
+
+//! What is known about a code execution before choosing its backend
+struct VmCallInfo {
+    evmc_revision revision{EVMC_MAX_REVISION};
+    size_t code_size{0};
+    bool has_code_hash{false};  // false for one-off code, e.g. contract creation
+    uint8_t frequency{0};       // Estimated recent executions of the same code, from EVM::baseline_analysis_cache
+};
+
+/** @brief Strategy selecting the backend for each code execution.
+ *
+ * Implementations must be cheap: select is invoked for every call frame executing code.
+ * Selecting a backend which is not available falls back to the default dispatch.
+ */
+class VmDispatchPolicy {
+  public:
+    virtual ~VmDispatchPolicy() = default;
+
+    virtual VmBackend select(const VmCallInfo& info) noexcept = 0;
+};
+
+/** @brief Dispatches hot contracts to the exogenous VM and everything else to an interpreter.
+ *
+ * Code is considered hot when its size and its recent execution frequency both reach the configured thresholds
+ * and the revision is supported by the exogenous VM. Other code runs on the advanced interpreter if allowed,
+ * otherwise on the baseline one, which is generally faster for one-off executions.
+ */
+class ThresholdDispatchPolicy : public VmDispatchPolicy {
+  public:
+    struct Settings {
+        size_t min_code_size{256};                      // Smaller code does not amortize the compilation
+        uint8_t min_frequency{8};                       // Recent executions (saturates at 15)
+        evmc_revision max_revision{EVMC_MAX_REVISION};  // Latest revision supported by the exogenous VM
+        bool use_advanced{false};                       // Prefer advanced over baseline interpreter for cached code
+    };
+
+    explicit ThresholdDispatchPolicy(const Settings& settings) noexcept : settings_{settings} {}
+
+    VmBackend select(const VmCallInfo& info) noexcept override;
+
+  private:
+    Settings settings_;
+};
+
+}  // namespace silkworm
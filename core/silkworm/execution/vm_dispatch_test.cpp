@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "vm_dispatch.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("ThresholdDispatchPolicy") {
+    ThresholdDispatchPolicy::Settings settings;
+    settings.min_code_size = 100;
+    settings.min_frequency = 4;
+    settings.max_revision = EVMC_LONDON;
+    ThresholdDispatchPolicy policy{settings};
+
+    VmCallInfo info;
+    info.revision = EVMC_LONDON;
+    info.code_size = 100;
+    info.has_code_hash = true;
+    info.frequency = 4;
+    CHECK(policy.select(info) == VmBackend::kExo);
+
+    SECTION("One-off code") {
+        info.has_code_hash = false;
+        CHECK(policy.select(info) == VmBackend::kBaseline);
+    }
+
+    SECTION("Small code") {
+        info.code_size = 99;
+        CHECK(policy.select(info) == VmBackend::kBaseline);
+    }
+
+    SECTION("Cold code") {
+        info.frequency = 3;
+        CHECK(policy.select(info) == VmBackend::kBaseline);
+
+        ThresholdDispatchPolicy advanced_policy{{settings.min_code_size, settings.min_frequency,
+                                                 settings.max_revision, /*use_advanced=*/true}};
+        CHECK(advanced_policy.select(info) == VmBackend::kAdvanced);
+    }
+
+    SECTION("Unsupported revision") {
+        info.revision = EVMC_SHANGHAI;
+        CHECK(policy.select(info) == VmBackend::kBaseline);
+    }
+}
+
+}  // namespace silkworm
@@ -89,6 +89,19 @@ std::pair<Header, DecodingResult> decode_header(ByteView& from) noexcept {
     return {h, DecodingResult::kOk};
 }
 
+std::pair<size_t, DecodingResult> count_items(ByteView payload) noexcept {
+    size_t num_items{0};
+    while (!payload.empty()) {
+        const auto [h, err]{decode_header(payload)};
+        if (err != DecodingResult::kOk) {
+            return {num_items, err};
+        }
+        payload.remove_prefix(h.payload_length);
+        ++num_items;
+    }
+    return {num_items, DecodingResult::kOk};
+}
+
 template <>
 DecodingResult decode(ByteView& from, evmc::bytes32& to) noexcept {
     return decode(from, to.bytes);
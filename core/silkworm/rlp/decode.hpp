@@ -37,6 +37,10 @@ namespace silkworm::rlp {
 // in which case the byte is put back.
 [[nodiscard]] std::pair<Header, DecodingResult> decode_header(ByteView& from) noexcept;
 
+// Structural pre-scan of the payload of a list: walks the headers of its items, without decoding them,
+// and returns how many there are, or an error if the payload is not a sequence of well-formed items.
+[[nodiscard]] std::pair<size_t, DecodingResult> count_items(ByteView payload) noexcept;
+
 template <class T>
 DecodingResult decode(ByteView& from, T& to) noexcept;
 
@@ -109,6 +113,12 @@ DecodingResult decode_vector(ByteView& from, std::vector<T>& to) noexcept {
     to.clear();
 
     ByteView payload_view{from.substr(0, h.payload_length)};
+    // Sized once so that decoded elements never get moved, and malformed lists are rejected before any decoding
+    const auto [num_items, count_err]{count_items(payload_view)};
+    if (count_err != DecodingResult::kOk) {
+        return count_err;
+    }
+    to.reserve(num_items);
     while (!payload_view.empty()) {
         to.emplace_back();
         if (err = decode(payload_view, to.back()); err != DecodingResult::kOk) {
@@ -93,6 +93,24 @@ TEST_CASE("RLP decoding") {
     SECTION("vectors") {
         CHECK(decode_vector_success<intx::uint256>("C0").empty());
         CHECK(decode_vector_success<uint64_t>("C883BBCCB583FFC0B5") == std::vector<uint64_t>{0xBBCCB5, 0xFFC0B5});
+
+        Bytes truncated{*from_hex("C583BBCCB583")};  // second item declares 3 bytes, none follows
+        ByteView view{truncated};
+        std::vector<uint64_t> res;
+        CHECK(decode_vector(view, res) == DecodingResult::kInputTooShort);
+        CHECK(res.empty());  // rejected before decoding
+    }
+
+    SECTION("item count") {
+        CHECK(count_items({}).first == 0);
+        Bytes items{*from_hex("0183BBCCB5C0C2C001")};  // a byte, a string, an empty list and a nested list
+        const auto [num_items, err]{count_items(items)};
+        CHECK(err == DecodingResult::kOk);
+        CHECK(num_items == 4);
+        items.pop_back();
+        CHECK(count_items(items).second == DecodingResult::kInputTooShort);
+        Bytes non_canonical{*from_hex("8101")};
+        CHECK(count_items(non_canonical).second == DecodingResult::kNonCanonicalSize);
     }
 }
 
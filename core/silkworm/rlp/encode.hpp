@@ -59,6 +59,11 @@ void encode(Bytes& to, const bool&);
 
 size_t length_of_length(uint64_t payload_length) noexcept;
 
+//! \brief Length of the encoding of an item, i.e. of its header followed by its payload
+inline size_t item_length(const Header& header) noexcept {
+    return length_of_length(header.payload_length) + header.payload_length;
+}
+
 size_t length(ByteView) noexcept;
 
 template <UnsignedIntegral T>
@@ -31,22 +31,26 @@ namespace detail {
         }
         return h;
     }
+
+    //! \brief Encodes v under its header h computed beforehand, not to measure the items twice
+    template <class T>
+    void encode_list(Bytes& to, const Header& h, const std::vector<T>& v) {
+        to.reserve(to.size() + item_length(h));
+        encode_header(to, h);
+        for (const T& x : v) {
+            encode(to, x);
+        }
+    }
 }  // namespace detail
 
 template <class T>
 size_t length(const std::vector<T>& v) {
-    const size_t payload_length{detail::rlp_header(v).payload_length};
-    return length_of_length(payload_length) + payload_length;
+    return item_length(detail::rlp_header(v));
 }
 
 template <class T>
 void encode(Bytes& to, const std::vector<T>& v) {
-    const Header h{detail::rlp_header(v)};
-    to.reserve(to.size() + length_of_length(h.payload_length) + h.payload_length);
-    encode_header(to, h);
-    for (const T& x : v) {
-        encode(to, x);
-    }
+    detail::encode_list(to, detail::rlp_header(v), v);
 }
 
 }  // namespace silkworm::rlp
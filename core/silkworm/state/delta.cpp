@@ -50,7 +50,9 @@ StorageChangeDelta::StorageChangeDelta(const evmc::address& address, const evmc:
                                        const evmc::bytes32& previous) noexcept
     : address_{address}, key_{key}, previous_{previous} {}
 
-void StorageChangeDelta::revert(IntraBlockState& state) noexcept { state.storage_[address_].current[key_] = previous_; }
+void StorageChangeDelta::revert(IntraBlockState& state) noexcept {
+    state.storage_[address_].current[key_].value = previous_;
+}
 
 StorageWipeDelta::StorageWipeDelta(const evmc::address& address, Storage storage) noexcept
     : address_{address}, storage_{std::move(storage)} {}
@@ -16,14 +16,6 @@
 
 #include "in_memory_state.hpp"
 
-#include <map>
-
-#include <ethash/keccak.hpp>
-
-#include <silkworm/common/util.hpp>
-#include <silkworm/rlp/encode.hpp>
-#include <silkworm/trie/hash_builder.hpp>
-
 namespace silkworm {
 
 std::optional<Account> InMemoryState::read_account(const evmc::address& address) const noexcept {
@@ -44,14 +36,11 @@ ByteView InMemoryState::read_code(const evmc::bytes32& code_hash) const noexcept
 
 evmc::bytes32 InMemoryState::read_storage(const evmc::address& address, uint64_t incarnation,
                                           const evmc::bytes32& location) const noexcept {
-    const auto it1{storage_.find(address)};
+    const auto it1{storage_.find({address, incarnation})};
     if (it1 != storage_.end()) {
-        const auto it2{it1->second.find(incarnation)};
+        const auto it2{it1->second.find(location)};
         if (it2 != it1->second.end()) {
-            const auto it3{it2->second.find(location)};
-            if (it3 != it2->second.end()) {
-                return it3->second;
-            }
+            return it2->second;
         }
     }
     return {};
@@ -146,6 +135,7 @@ void InMemoryState::begin_block(uint64_t block_number) {
 void InMemoryState::update_account(const evmc::address& address, std::optional<Account> initial,
                                    std::optional<Account> current) {
     account_changes_[block_number_][address] = initial;
+    state_root_.update_account(address, current);
 
     if (current.has_value()) {
         accounts_[address] = current.value();
@@ -165,17 +155,25 @@ void InMemoryState::update_account_code(const evmc::address&, uint64_t, const ev
 
 void InMemoryState::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
                                    const evmc::bytes32& initial, const evmc::bytes32& current) {
-    storage_changes_[block_number_][address][incarnation][location] = initial;
+    storage_changes_[block_number_][{address, incarnation}][location] = initial;
+    state_root_.update_storage(address, incarnation, location, current);
+    write_storage(address, incarnation, location, current);
+}
 
-    if (is_zero(current)) {
-        storage_[address][incarnation].erase(location);
+void InMemoryState::write_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                                  const evmc::bytes32& value) {
+    if (is_zero(value)) {
+        if (const auto it{storage_.find({address, incarnation})}; it != storage_.end()) {
+            it->second.erase(location);
+        }
     } else {
-        storage_[address][incarnation][location] = current;
+        storage_[{address, incarnation}][location] = value;
     }
 }
 
 void InMemoryState::unwind_state_changes(uint64_t block_number) {
     for (const auto& [address, account] : account_changes_[block_number]) {
+        state_root_.update_account(address, account);
         if (account) {
             accounts_[address] = *account;
         } else {
@@ -183,15 +181,11 @@ void InMemoryState::unwind_state_changes(uint64_t block_number) {
         }
     }
 
-    for (const auto& [address, storage1] : storage_changes_[block_number]) {
-        for (const auto& [incarnation, storage2] : storage1) {
-            for (const auto& [location, value] : storage2) {
-                if (is_zero(value)) {
-                    storage_[address][incarnation].erase(location);
-                } else {
-                    storage_[address][incarnation][location] = value;
-                }
-            }
+    for (const auto& [key, storage] : storage_changes_[block_number]) {
+        const auto& [address, incarnation]{key};
+        for (const auto& [location, value] : storage) {
+            state_root_.update_storage(address, incarnation, location, value);
+            write_storage(address, incarnation, location, value);
         }
     }
 }
@@ -199,64 +193,10 @@ void InMemoryState::unwind_state_changes(uint64_t block_number) {
 size_t InMemoryState::number_of_accounts() const { return accounts_.size(); }
 
 size_t InMemoryState::storage_size(const evmc::address& address, uint64_t incarnation) const {
-    const auto it1{storage_.find(address)};
-    if (it1 != storage_.end()) {
-        const auto it2{it1->second.find(incarnation)};
-        if (it2 != it1->second.end()) {
-            return it2->second.size();
-        }
-    }
-    return 0;
+    const auto it{storage_.find({address, incarnation})};
+    return it != storage_.end() ? it->second.size() : 0;
 }
 
-// https://eth.wiki/fundamentals/patricia-tree#storage-trie
-evmc::bytes32 InMemoryState::account_storage_root(const evmc::address& address, uint64_t incarnation) const {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return kEmptyRoot;
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end() || it2->second.empty()) {
-        return kEmptyRoot;
-    }
-
-    const auto& storage{it2->second};
-
-    std::map<evmc::bytes32, Bytes> storage_rlp;
-    Bytes buffer;
-    for (const auto& [location, value] : storage) {
-        ethash::hash256 hash{keccak256(location)};
-        buffer.clear();
-        rlp::encode(buffer, zeroless_view(value));
-        storage_rlp[to_bytes32(hash.bytes)] = buffer;
-    }
-
-    trie::HashBuilder hb;
-    for (const auto& [hash, rlp] : storage_rlp) {
-        hb.add_leaf(trie::unpack_nibbles(hash), rlp);
-    }
-
-    return hb.root_hash();
-}
-
-evmc::bytes32 InMemoryState::state_root_hash() const {
-    if (accounts_.empty()) {
-        return kEmptyRoot;
-    }
-
-    std::map<evmc::bytes32, Bytes> account_rlp;
-    for (const auto& [address, account] : accounts_) {
-        ethash::hash256 hash{keccak256(address)};
-        evmc::bytes32 storage_root{account_storage_root(address, account.incarnation)};
-        account_rlp[to_bytes32(hash.bytes)] = account.rlp(storage_root);
-    }
-
-    trie::HashBuilder hb;
-    for (const auto& [hash, rlp] : account_rlp) {
-        hb.add_leaf(trie::unpack_nibbles(hash), rlp);
-    }
-
-    return hb.root_hash();
-}
+evmc::bytes32 InMemoryState::state_root_hash() const { return state_root_.root_hash(); }
 
 }  // namespace silkworm
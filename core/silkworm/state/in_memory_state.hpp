@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <silkworm/common/hash_maps.hpp>
 #include <silkworm/state/state.hpp>
+#include <silkworm/trie/incremental_trie.hpp>
 
 namespace silkworm {
 
@@ -29,10 +33,12 @@ class InMemoryState : public State {
     // address -> initial value
     using AccountChanges = std::unordered_map<evmc::address, std::optional<Account>>;
 
-    // address -> incarnation -> location -> initial value
-    using StorageChanges =
-        std::unordered_map<evmc::address,
-                           std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>;
+    // (address, incarnation) -> location -> value
+    // Flat and sorted: a single lookup per storage access, the storage of an account is contiguous
+    using Storage = std::map<std::pair<evmc::address, uint64_t>, FlatHashMap<evmc::bytes32, evmc::bytes32>>;
+
+    // (address, incarnation) -> location -> initial value
+    using StorageChanges = Storage;
 
   public:
     std::optional<Account> read_account(const evmc::address& address) const noexcept override;
@@ -88,8 +94,6 @@ class InMemoryState : public State {
     const std::unordered_map<evmc::address, Account>& accounts() const { return accounts_; }
 
   private:
-    evmc::bytes32 account_storage_root(const evmc::address& address, uint64_t incarnation) const;
-
     std::unordered_map<evmc::address, Account> accounts_;
 
     // hash -> code
@@ -97,9 +101,10 @@ class InMemoryState : public State {
 
     std::unordered_map<evmc::address, uint64_t> prev_incarnations_;
 
-    // address -> incarnation -> location -> value
-    std::unordered_map<evmc::address, std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>
-        storage_;
+    void write_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                       const evmc::bytes32& value);
+
+    Storage storage_;
 
     // block number -> hash -> header
     std::map<BlockNum, std::unordered_map<evmc::bytes32, BlockHeader>> headers_;
@@ -116,6 +121,9 @@ class InMemoryState : public State {
     std::unordered_map<uint64_t, StorageChanges> storage_changes_;  // per block
 
     uint64_t block_number_{0};
+
+    // Kept up to date with accounts_ & storage_: only what changed in between is re-hashed by state_root_hash
+    mutable trie::IncrementalStateRoot state_root_;
 };
 
 }  // namespace silkworm
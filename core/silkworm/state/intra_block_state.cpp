@@ -16,6 +16,8 @@
 
 #include "intra_block_state.hpp"
 
+#include <memory>
+
 #include <ethash/keccak.hpp>
 
 #include <silkworm/common/cast.hpp>
@@ -23,6 +25,8 @@
 
 namespace silkworm {
 
+IntraBlockState::~IntraBlockState() { clear_journal(); }
+
 const state::Object* IntraBlockState::get_object(const evmc::address& address) const noexcept {
     auto it{objects_.find(address)};
     if (it != objects_.end()) {
@@ -47,19 +51,35 @@ state::Object* IntraBlockState::get_object(const evmc::address& address) noexcep
 
 state::Object& IntraBlockState::get_or_create_object(const evmc::address& address) noexcept {
     auto* obj{get_object(address)};
+    record_write(address);
 
     if (obj == nullptr) {
-        journal_.emplace_back(new state::CreateDelta{address});
+        journal_.push_back(delta_arena_.create<state::CreateDelta>(address));
         obj = &objects_[address];
         obj->current = Account{};
+        obj->journal_epoch = journal_epoch_;
     } else if (obj->current == std::nullopt) {
-        journal_.emplace_back(new state::UpdateDelta{address, *obj});
+        save_object(address, *obj);
         obj->current = Account{};
     }
 
     return *obj;
 }
 
+void IntraBlockState::save_object(const evmc::address& address, state::Object& obj) noexcept {
+    if (obj.journal_epoch != journal_epoch_) {
+        journal_.push_back(delta_arena_.create<state::UpdateDelta>(address, obj));
+        obj.journal_epoch = journal_epoch_;
+    }
+}
+
+void IntraBlockState::save_balance(const evmc::address& address, state::Object& obj) noexcept {
+    if (obj.journal_epoch != journal_epoch_ && obj.balance_journal_epoch != journal_epoch_) {
+        journal_.push_back(delta_arena_.create<state::UpdateBalanceDelta>(address, obj.current->balance));
+        obj.balance_journal_epoch = journal_epoch_;
+    }
+}
+
 bool IntraBlockState::exists(const evmc::address& address) const noexcept {
     auto* obj{get_object(address)};
     return obj != nullptr && obj->current != std::nullopt;
@@ -74,6 +94,8 @@ bool IntraBlockState::is_dead(const evmc::address& address) const noexcept {
 }
 
 void IntraBlockState::create_contract(const evmc::address& address) noexcept {
+    record_write(address);
+
     state::Object created{};
     created.current = Account{};
 
@@ -87,9 +109,9 @@ void IntraBlockState::create_contract(const evmc::address& address) noexcept {
         } else if (prev->initial) {
             prev_incarnation = prev->initial->incarnation;
         }
-        journal_.emplace_back(new state::UpdateDelta{address, *prev});
+        journal_.push_back(delta_arena_.create<state::UpdateDelta>(address, *prev));
     } else {
-        journal_.emplace_back(new state::CreateDelta{address});
+        journal_.push_back(delta_arena_.create<state::CreateDelta>(address));
     }
 
     if (!prev_incarnation || prev_incarnation == 0) {
@@ -97,14 +119,15 @@ void IntraBlockState::create_contract(const evmc::address& address) noexcept {
     }
 
     created.current->incarnation = *prev_incarnation + 1;
+    created.journal_epoch = journal_epoch_;
 
     objects_[address] = created;
 
     auto it{storage_.find(address)};
     if (it == storage_.end()) {
-        journal_.emplace_back(new state::StorageCreateDelta{address});
+        journal_.push_back(delta_arena_.create<state::StorageCreateDelta>(address));
     } else {
-        journal_.emplace_back(new state::StorageWipeDelta{address, it->second});
+        journal_.push_back(delta_arena_.create<state::StorageWipeDelta>(address, it->second));
         storage_.erase(address);
     }
 }
@@ -116,14 +139,14 @@ void IntraBlockState::touch(const evmc::address& address) noexcept {
     // and https://github.com/ethereum/EIPs/issues/716
     static constexpr evmc::address kRipemdAddress{0x0000000000000000000000000000000000000003_address};
     if (inserted && address != kRipemdAddress) {
-        journal_.emplace_back(new state::TouchDelta{address});
+        journal_.push_back(delta_arena_.create<state::TouchDelta>(address));
     }
 }
 
 void IntraBlockState::record_suicide(const evmc::address& address) noexcept {
     const bool inserted{self_destructs_.insert(address).second};
     if (inserted) {
-        journal_.emplace_back(new state::SuicideDelta{address});
+        journal_.push_back(delta_arena_.create<state::SuicideDelta>(address));
     }
 }
 
@@ -144,6 +167,7 @@ void IntraBlockState::destruct_touched_dead() {
 // Doesn't create a delta since it's called at the end of a transaction,
 // when we don't need snapshots anymore.
 void IntraBlockState::destruct(const evmc::address& address) {
+    record_write(address);
     storage_.erase(address);
     auto* obj{get_object(address)};
     if (obj) {
@@ -158,21 +182,21 @@ intx::uint256 IntraBlockState::get_balance(const evmc::address& address) const n
 
 void IntraBlockState::set_balance(const evmc::address& address, const intx::uint256& value) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    save_balance(address, obj);
     obj.current->balance = value;
     touch(address);
 }
 
 void IntraBlockState::add_to_balance(const evmc::address& address, const intx::uint256& addend) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    save_balance(address, obj);
     obj.current->balance += addend;
     touch(address);
 }
 
 void IntraBlockState::subtract_from_balance(const evmc::address& address, const intx::uint256& subtrahend) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateBalanceDelta{address, obj.current->balance});
+    save_balance(address, obj);
     obj.current->balance -= subtrahend;
     touch(address);
 }
@@ -184,7 +208,7 @@ uint64_t IntraBlockState::get_nonce(const evmc::address& address) const noexcept
 
 void IntraBlockState::set_nonce(const evmc::address& address, uint64_t nonce) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateDelta{address, obj});
+    save_object(address, obj);
     obj.current->nonce = nonce;
 }
 
@@ -220,7 +244,7 @@ evmc::bytes32 IntraBlockState::get_code_hash(const evmc::address& address) const
 
 void IntraBlockState::set_code(const evmc::address& address, ByteView code) noexcept {
     auto& obj{get_or_create_object(address)};
-    journal_.emplace_back(new state::UpdateDelta{address, obj});
+    save_object(address, obj);
     obj.current->code_hash = bit_cast<evmc_bytes32>(keccak256(code));
 
     // Don't overwrite already existing code so that views of it
@@ -231,7 +255,7 @@ void IntraBlockState::set_code(const evmc::address& address, ByteView code) noex
 evmc_access_status IntraBlockState::access_account(const evmc::address& address) noexcept {
     const bool cold_read{accessed_addresses_.insert(address).second};
     if (cold_read) {
-        journal_.emplace_back(new state::AccountAccessDelta{address});
+        journal_.push_back(delta_arena_.create<state::AccountAccessDelta>(address));
     }
     return cold_read ? EVMC_ACCESS_COLD : EVMC_ACCESS_WARM;
 }
@@ -239,7 +263,7 @@ evmc_access_status IntraBlockState::access_account(const evmc::address& address)
 evmc_access_status IntraBlockState::access_storage(const evmc::address& address, const evmc::bytes32& key) noexcept {
     const bool cold_read{accessed_storage_keys_[address].insert(key).second};
     if (cold_read) {
-        journal_.emplace_back(new state::StorageAccessDelta{address, key});
+        journal_.push_back(delta_arena_.create<state::StorageAccessDelta>(address, key));
     }
     return cold_read ? EVMC_ACCESS_COLD : EVMC_ACCESS_WARM;
 }
@@ -266,7 +290,7 @@ evmc::bytes32 IntraBlockState::get_storage(const evmc::address& address, const e
     if (!original) {
         auto it{storage.current.find(key)};
         if (it != storage.current.end()) {
-            return it->second;
+            return it->second.value;
         }
     }
 
@@ -295,8 +319,15 @@ void IntraBlockState::set_storage(const evmc::address& address, const evmc::byte
     if (prev == value) {
         return;
     }
-    storage_[address].current[key] = value;
-    journal_.emplace_back(new state::StorageChangeDelta{address, key, prev});
+    state::CurrentValue& current{storage_[address].current[key]};
+    if (current.journal_epoch != journal_epoch_) {
+        journal_.push_back(delta_arena_.create<state::StorageChangeDelta>(address, key, prev));
+        current.journal_epoch = journal_epoch_;
+    }
+    current.value = value;
+    if (track_writes_) {
+        writes_.add(address, key);
+    }
 }
 
 void IntraBlockState::write_to_db(uint64_t block_number) {
@@ -333,8 +364,47 @@ void IntraBlockState::write_to_db(uint64_t block_number) {
     }
 }
 
+void IntraBlockState::merge_transaction(IntraBlockState& other) noexcept {
+    for (const auto& [address, obj] : other.objects_) {
+        auto [it, inserted]{objects_.try_emplace(address, obj)};
+        if (!inserted) {
+            // Initial values are the same by precondition
+            it->second.current = obj.current;
+        }
+        // Journal epochs are those of the other state
+        it->second.journal_epoch = 0;
+        it->second.balance_journal_epoch = 0;
+        // Storage has been wiped if the account has been either destructed or (re)created
+        if (!obj.initial || !obj.current || obj.initial->incarnation != obj.current->incarnation) {
+            storage_.erase(address);
+        }
+    }
+
+    for (auto& [address, storage] : other.storage_) {
+        state::Storage& dst{storage_[address]};
+        for (const auto& [key, val] : storage.committed) {
+            auto [it, inserted]{dst.committed.try_emplace(key, val)};
+            if (!inserted) {
+                it->second.original = val.original;
+            }
+        }
+    }
+
+    for (const auto& [code_hash, code] : other.existing_code_) {
+        existing_code_.try_emplace(code_hash, code);
+    }
+    for (auto& [code_hash, code] : other.new_code_) {
+        new_code_.try_emplace(code_hash, std::move(code));
+    }
+
+    if (track_writes_) {
+        writes_.merge(other.writes_);
+    }
+}
+
 IntraBlockState::Snapshot IntraBlockState::take_snapshot() const noexcept {
     IntraBlockState::Snapshot snapshot;
+    ++journal_epoch_;
     snapshot.journal_size_ = journal_.size();
     snapshot.log_size_ = logs_.size();
     snapshot.refund_ = refund_;
@@ -344,8 +414,11 @@ IntraBlockState::Snapshot IntraBlockState::take_snapshot() const noexcept {
 void IntraBlockState::revert_to_snapshot(const IntraBlockState::Snapshot& snapshot) noexcept {
     for (size_t i = journal_.size(); i > snapshot.journal_size_; --i) {
         journal_[i - 1]->revert(*this);
+        std::destroy_at(journal_[i - 1]);
     }
+    // Memory of reverted deltas is reclaimed at the end of the transaction
     journal_.resize(snapshot.journal_size_);
+    ++journal_epoch_;
     logs_.resize(snapshot.log_size_);
     refund_ = snapshot.refund_;
 }
@@ -354,14 +427,23 @@ void IntraBlockState::finalize_transaction() {
     for (auto& x : storage_) {
         state::Storage& storage{x.second};
         for (const auto& [key, val] : storage.current) {
-            storage.committed[key].original = val;
+            storage.committed[key].original = val.value;
         }
         storage.current.clear();
     }
 }
 
-void IntraBlockState::clear_journal_and_substate() {
+void IntraBlockState::clear_journal() noexcept {
+    for (state::Delta* delta : journal_) {
+        std::destroy_at(delta);
+    }
     journal_.clear();
+    delta_arena_.reset();
+    ++journal_epoch_;
+}
+
+void IntraBlockState::clear_journal_and_substate() {
+    clear_journal();
 
     // and the substate
     self_destructs_.clear();
@@ -21,6 +21,7 @@
 
 #include <intx/intx.hpp>
 
+#include <silkworm/common/arena.hpp>
 #include <silkworm/common/base.hpp>
 #include <silkworm/common/hash_maps.hpp>
 #include <silkworm/state/delta.hpp>
@@ -52,6 +53,8 @@ class IntraBlockState {
 
     explicit IntraBlockState(State& db) noexcept : db_{db} {}
 
+    ~IntraBlockState();
+
     State& db() { return db_; }
 
     bool exists(const evmc::address& address) const noexcept;
@@ -114,7 +117,24 @@ class IntraBlockState {
 
     uint64_t get_refund() const noexcept { return refund_; }
 
-    const FlatHashSet<evmc::address>& touched() const noexcept { return touched_; }
+    const FlatAddressSet& touched() const noexcept { return touched_; }
+
+    /** @name Speculative execution support */
+    ///@{
+
+    // Enables or disables the tracking of written accounts and storage locations (off by default).
+    // Tracking is conservative: writes later reverted are still recorded.
+    void set_write_tracking(bool enabled) noexcept { track_writes_ = enabled; }
+
+    const state::AccessSet& writes() const noexcept { return writes_; }
+    void clear_writes() noexcept { writes_.clear(); }
+
+    // Merges the outcome of a single transaction executed on another IntraBlockState backed by the same initial
+    // state. Precondition: none of the accounts or storage locations read by that transaction has been written
+    // here, so that its outcome is the same as if it had been executed on this state.
+    void merge_transaction(IntraBlockState& other) noexcept;
+
+    ///@}
 
   private:
     friend class state::CreateDelta;
@@ -135,25 +155,47 @@ class IntraBlockState {
 
     state::Object& get_or_create_object(const evmc::address& address) noexcept;
 
+    void clear_journal() noexcept;
+
+    // Journal the object, or its balance alone, unless already saved in the current epoch
+    void save_object(const evmc::address& address, state::Object& obj) noexcept;
+    void save_balance(const evmc::address& address, state::Object& obj) noexcept;
+
+    void record_write(const evmc::address& address) noexcept {
+        if (track_writes_) {
+            writes_.add(address);
+        }
+    }
+
     State& db_;
 
-    mutable FlatHashMap<evmc::address, state::Object> objects_;
-    mutable FlatHashMap<evmc::address, state::Storage> storage_;
+    mutable FlatAddressMap<state::Object> objects_;
+    mutable FlatAddressMap<state::Storage> storage_;
 
     // we want pointer stability here, thus node map
-    mutable NodeHashMap<evmc::bytes32, ByteView> existing_code_;
-    NodeHashMap<evmc::bytes32, Bytes> new_code_;
+    mutable NodeHashMap<evmc::bytes32, ByteView, DigestHasher> existing_code_;
+    NodeHashMap<evmc::bytes32, Bytes, DigestHasher> new_code_;
 
-    std::vector<std::unique_ptr<state::Delta>> journal_;
+    // Deltas live in a per-transaction arena, reset in one shot by clear_journal_and_substate
+    MonotonicArena delta_arena_;
+    std::vector<state::Delta*> journal_;
+
+    // Copy on first write: an object or a storage location saved in the journal needs no other delta until the
+    // epoch changes, which every snapshot, revert and clearing of the journal does. Hence the journal and the cost of
+    // a revert are bounded by the number of locations written, not by the number of writes.
+    mutable uint64_t journal_epoch_{1};
 
     // substate
-    FlatHashSet<evmc::address> self_destructs_;
+    FlatAddressSet self_destructs_;
     std::vector<Log> logs_;
-    FlatHashSet<evmc::address> touched_;
+    FlatAddressSet touched_;
     uint64_t refund_{0};
     // EIP-2929 substate
-    FlatHashSet<evmc::address> accessed_addresses_;
-    FlatHashMap<evmc::address, FlatHashSet<evmc::bytes32>> accessed_storage_keys_;
+    FlatAddressSet accessed_addresses_;
+    FlatAddressMap<FlatHashSet<evmc::bytes32>> accessed_storage_keys_;
+
+    bool track_writes_{false};
+    state::AccessSet writes_;
 };
 
 }  // namespace silkworm
@@ -0,0 +1,107 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "intra_block_state.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/state/in_memory_state.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Snapshots of IntraBlockState") {
+    static constexpr evmc::address kAddress{0xbe00000000000000000000000000000000000000_address};
+    static constexpr evmc::bytes32 kLocation{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    static constexpr evmc::bytes32 kValue1{0x000000000000000000000000000000000000000000000000000000000000000a_bytes32};
+    static constexpr evmc::bytes32 kValue2{0x000000000000000000000000000000000000000000000000000000000000000b_bytes32};
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    state.add_to_balance(kAddress, 100);
+    state.set_storage(kAddress, kLocation, kValue1);
+
+    SECTION("repeated writes are reverted") {
+        const auto snapshot{state.take_snapshot()};
+        for (int i{0}; i < 10; ++i) {
+            state.add_to_balance(kAddress, 1);
+            state.set_nonce(kAddress, state.get_nonce(kAddress) + 1);
+            state.subtract_from_balance(kAddress, 2);
+            state.set_storage(kAddress, kLocation, i % 2 ? kValue1 : kValue2);
+        }
+        CHECK(state.get_balance(kAddress) == 90);
+        CHECK(state.get_nonce(kAddress) == 10);
+        state.revert_to_snapshot(snapshot);
+        CHECK(state.get_balance(kAddress) == 100);
+        CHECK(state.get_nonce(kAddress) == 0);
+        CHECK(state.get_current_storage(kAddress, kLocation) == kValue1);
+    }
+
+    SECTION("writes after a successful inner frame are reverted with the outer one") {
+        const auto outer{state.take_snapshot()};
+        state.add_to_balance(kAddress, 1);
+        {
+            [[maybe_unused]] const auto inner{state.take_snapshot()};
+            state.add_to_balance(kAddress, 10);
+            state.set_storage(kAddress, kLocation, kValue2);
+        }  // inner frame succeeded
+        state.add_to_balance(kAddress, 100);
+        state.set_storage(kAddress, kLocation, evmc::bytes32{});
+        CHECK(state.get_balance(kAddress) == 211);
+
+        state.revert_to_snapshot(outer);
+        CHECK(state.get_balance(kAddress) == 100);
+        CHECK(state.get_current_storage(kAddress, kLocation) == kValue1);
+    }
+
+    SECTION("writes after a reverted inner frame are reverted with the outer one") {
+        const auto outer{state.take_snapshot()};
+        state.set_storage(kAddress, kLocation, kValue2);
+        const auto inner{state.take_snapshot()};
+        state.set_storage(kAddress, kLocation, evmc::bytes32{});
+        state.set_nonce(kAddress, 7);
+        state.revert_to_snapshot(inner);
+        CHECK(state.get_current_storage(kAddress, kLocation) == kValue2);
+        CHECK(state.get_nonce(kAddress) == 0);
+
+        state.set_storage(kAddress, kLocation, evmc::bytes32{});
+        state.set_nonce(kAddress, 8);
+        state.revert_to_snapshot(outer);
+        CHECK(state.get_current_storage(kAddress, kLocation) == kValue1);
+        CHECK(state.get_nonce(kAddress) == 0);
+    }
+
+    SECTION("balance saved alone, then the whole account") {
+        const auto snapshot{state.take_snapshot()};
+        state.add_to_balance(kAddress, 1);
+        state.set_nonce(kAddress, 1);
+        state.add_to_balance(kAddress, 1);
+        state.revert_to_snapshot(snapshot);
+        CHECK(state.get_balance(kAddress) == 100);
+        CHECK(state.get_nonce(kAddress) == 0);
+    }
+
+    SECTION("accounts created in a frame are removed by its revert") {
+        static constexpr evmc::address kOther{0xbf00000000000000000000000000000000000000_address};
+        const auto snapshot{state.take_snapshot()};
+        state.add_to_balance(kOther, 1);
+        state.set_nonce(kOther, 1);
+        state.add_to_balance(kOther, 1);
+        state.revert_to_snapshot(snapshot);
+        CHECK_FALSE(state.exists(kOther));
+    }
+}
+
+}  // namespace silkworm
@@ -27,6 +27,10 @@ namespace silkworm::state {
 struct Object {
     std::optional<Account> initial;
     std::optional<Account> current;
+
+    // Journal epochs (see IntraBlockState) in which the whole object and its balance alone were last saved
+    uint64_t journal_epoch{0};
+    uint64_t balance_journal_epoch{0};
 };
 
 struct CommittedValue {
@@ -34,9 +38,57 @@ struct CommittedValue {
     evmc::bytes32 original{};  // value at the beginning of the transaction; see EIP-2200
 };
 
+struct CurrentValue {
+    evmc::bytes32 value{};
+    uint64_t journal_epoch{0};  // journal epoch (see IntraBlockState) in which the previous value was last saved
+};
+
 struct Storage {
     FlatHashMap<evmc::bytes32, CommittedValue> committed;
-    FlatHashMap<evmc::bytes32, evmc::bytes32> current;
+    FlatHashMap<evmc::bytes32, CurrentValue> current;
+};
+
+// Accounts and storage locations read or written by one or more transactions.
+// Used for conflict detection in speculative (parallel) execution.
+struct AccessSet {
+    FlatAddressSet accounts;
+    FlatAddressMap<FlatHashSet<evmc::bytes32>> storage;
+
+    void add(const evmc::address& address) { accounts.insert(address); }
+
+    void add(const evmc::address& address, const evmc::bytes32& location) { storage[address].insert(location); }
+
+    void merge(const AccessSet& other) {
+        accounts.insert(other.accounts.begin(), other.accounts.end());
+        for (const auto& [address, locations] : other.storage) {
+            storage[address].insert(locations.begin(), locations.end());
+        }
+    }
+
+    [[nodiscard]] bool intersects(const AccessSet& other) const noexcept {
+        for (const auto& address : accounts) {
+            if (other.accounts.contains(address)) {
+                return true;
+            }
+        }
+        for (const auto& [address, locations] : storage) {
+            const auto it{other.storage.find(address)};
+            if (it == other.storage.end()) {
+                continue;
+            }
+            for (const auto& location : locations) {
+                if (it->second.contains(location)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void clear() noexcept {
+        accounts.clear();
+        storage.clear();
+    }
 };
 
 }  // namespace silkworm::state
@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+// Speculative execution relies on multi-threading, which is not available in Wasm
+#if !defined(__wasm__)
+
+#include <mutex>
+
+#include <silkworm/state/object.hpp>
+#include <silkworm/state/state.hpp>
+
+namespace silkworm {
+
+/// RecordingState is a read-only view over another State which records every account and storage location read.
+/// The underlying state is accessed under a mutex shared amongst all views, so that multiple speculative
+/// transactions can be executed concurrently on top of a State implementation which is not thread-safe.
+/// State changes are not supported: the view is meant to be wrapped by an IntraBlockState which is never written.
+class RecordingState : public State {
+  public:
+    RecordingState(const State& db, std::mutex& db_mutex) noexcept : db_{db}, db_mutex_{db_mutex} {}
+
+    std::optional<Account> read_account(const evmc::address& address) const noexcept override;
+
+    ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
+                               const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<BlockHeader> read_header(uint64_t block_number,
+                                           const evmc::bytes32& block_hash) const noexcept override;
+
+    [[nodiscard]] bool read_body(uint64_t block_number, const evmc::bytes32& block_hash,
+                                 BlockBody& out) const noexcept override;
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number,
+                                                  const evmc::bytes32& block_hash) const noexcept override;
+
+    evmc::bytes32 state_root_hash() const override;
+
+    uint64_t current_canonical_block() const override;
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override;
+
+    void insert_block(const Block& block, const evmc::bytes32& hash) override;
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override;
+
+    void decanonize_block(uint64_t block_number) override;
+
+    void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
+
+    void begin_block(uint64_t block_number) override;
+
+    void update_account(const evmc::address& address, std::optional<Account> initial,
+                        std::optional<Account> current) override;
+
+    void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
+                             ByteView code) override;
+
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& initial, const evmc::bytes32& current) override;
+
+    void unwind_state_changes(uint64_t block_number) override;
+
+    // Accounts and storage locations read so far.
+    // N.B. reading a storage location records its account as well.
+    const state::AccessSet& reads() const noexcept { return reads_; }
+
+  private:
+    const State& db_;
+    std::mutex& db_mutex_;
+    mutable state::AccessSet reads_;
+};
+
+}  // namespace silkworm
+
+#endif  // !defined(__wasm__)
@@ -0,0 +1,413 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "witness.hpp"
+
+#include <cstring>
+
+#include <silkworm/common/assert.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+namespace {
+
+    constexpr uint8_t kMagic[8]{'S', 'W', 'W', 'I', 'T', 'N', 'S', '1'};
+
+    void append_u32(Bytes& to, uint32_t value) {
+        uint8_t buffer[sizeof(uint32_t)];
+        endian::store_big_u32(buffer, value);
+        to.append(buffer, sizeof(buffer));
+    }
+
+    void append_u64(Bytes& to, uint64_t value) {
+        uint8_t buffer[sizeof(uint64_t)];
+        endian::store_big_u64(buffer, value);
+        to.append(buffer, sizeof(buffer));
+    }
+
+    void append_sized(Bytes& to, ByteView data) {
+        append_u32(to, static_cast<uint32_t>(data.length()));
+        to.append(data);
+    }
+
+    //! \brief Bounds-checked consumption of an encoded witness: every read fails once the input is exhausted
+    class WitnessReader {
+      public:
+        explicit WitnessReader(ByteView data) noexcept : data_{data} {}
+
+        [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+        [[nodiscard]] bool read(size_t length, ByteView& out) noexcept {
+            if (data_.length() < length) {
+                return false;
+            }
+            out = data_.substr(0, length);
+            data_.remove_prefix(length);
+            return true;
+        }
+
+        [[nodiscard]] bool read_u8(size_t& out) noexcept {
+            ByteView view;
+            if (!read(sizeof(uint8_t), view)) {
+                return false;
+            }
+            out = view[0];
+            return true;
+        }
+
+        [[nodiscard]] bool read_u32(size_t& out) noexcept {
+            ByteView view;
+            if (!read(sizeof(uint32_t), view)) {
+                return false;
+            }
+            out = endian::load_big_u32(view.data());
+            return true;
+        }
+
+        [[nodiscard]] bool read_u64(uint64_t& out) noexcept {
+            ByteView view;
+            if (!read(sizeof(uint64_t), view)) {
+                return false;
+            }
+            out = endian::load_big_u64(view.data());
+            return true;
+        }
+
+        [[nodiscard]] bool read_address(evmc::address& out) noexcept {
+            ByteView view;
+            if (!read(kAddressLength, view)) {
+                return false;
+            }
+            std::memcpy(out.bytes, view.data(), kAddressLength);
+            return true;
+        }
+
+        [[nodiscard]] bool read_hash(evmc::bytes32& out) noexcept {
+            ByteView view;
+            if (!read(kHashLength, view)) {
+                return false;
+            }
+            std::memcpy(out.bytes, view.data(), kHashLength);
+            return true;
+        }
+
+        //! \brief Reads a u32 length prefixed field
+        [[nodiscard]] bool read_sized(ByteView& out) noexcept {
+            size_t length{0};
+            return read_u32(length) && read(length, out);
+        }
+
+      private:
+        ByteView data_;
+    };
+
+    //! \brief Decodes a whole RLP field, any trailing byte being an error
+    template <class T>
+    DecodingResult decode_rlp_field(ByteView field, T& to) noexcept {
+        if (const DecodingResult res{rlp::decode(field, to)}; res != DecodingResult::kOk) {
+            return res;
+        }
+        return field.empty() ? DecodingResult::kOk : DecodingResult::kUnexpectedLength;
+    }
+
+}  // namespace
+
+Bytes BlockWitness::encode() const {
+    Bytes out(kMagic, sizeof(kMagic));
+    append_u64(out, chain_id);
+
+    Bytes rlp;
+    rlp::encode(rlp, block);
+    append_sized(out, rlp);
+    append_u32(out, static_cast<uint32_t>(block.transactions.size()));
+    for (const auto& txn : block.transactions) {
+        SILKWORM_ASSERT(txn.from.has_value());
+        out.append(txn.from->bytes, kAddressLength);
+    }
+
+    append_u32(out, static_cast<uint32_t>(accounts.size()));
+    for (const auto& [address, account] : accounts) {
+        out.append(address.bytes, kAddressLength);
+        const Bytes encoded{account.encode_for_storage()};
+        out.push_back(static_cast<uint8_t>(encoded.length()));
+        out.append(encoded);
+    }
+
+    append_u32(out, static_cast<uint32_t>(previous_incarnations.size()));
+    for (const auto& [address, incarnation] : previous_incarnations) {
+        out.append(address.bytes, kAddressLength);
+        append_u64(out, incarnation);
+    }
+
+    append_u32(out, static_cast<uint32_t>(storage.size()));
+    for (const auto& [key, value] : storage) {
+        const auto& [address, incarnation, location]{key};
+        out.append(address.bytes, kAddressLength);
+        append_u64(out, incarnation);
+        out.append(location.bytes, kHashLength);
+        const ByteView zeroless{zeroless_view(value)};
+        out.push_back(static_cast<uint8_t>(zeroless.length()));
+        out.append(zeroless);
+    }
+
+    append_u32(out, static_cast<uint32_t>(code.size()));
+    for (const auto& [code_hash, bytecode] : code) {
+        out.append(code_hash.bytes, kHashLength);
+        append_sized(out, bytecode);
+    }
+
+    append_u32(out, static_cast<uint32_t>(headers.size()));
+    for (const auto& [block_hash, header] : headers) {
+        out.append(block_hash.bytes, kHashLength);
+        rlp.clear();
+        rlp::encode(rlp, header);
+        append_sized(out, rlp);
+    }
+
+    return out;
+}
+
+DecodingResult BlockWitness::decode(ByteView from, BlockWitness& to) noexcept {
+    to = {};
+    WitnessReader reader{from};
+
+    ByteView view;
+    if (!reader.read(sizeof(kMagic), view)) {
+        return DecodingResult::kInputTooShort;
+    }
+    if (std::memcmp(view.data(), kMagic, sizeof(kMagic)) != 0) {
+        return DecodingResult::kInvalidFieldset;
+    }
+    if (!reader.read_u64(to.chain_id) || !reader.read_sized(view)) {
+        return DecodingResult::kInputTooShort;
+    }
+    if (const DecodingResult res{decode_rlp_field(view, to.block)}; res != DecodingResult::kOk) {
+        return res;
+    }
+
+    size_t count{0};
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    if (count != to.block.transactions.size()) {
+        return DecodingResult::kUnexpectedLength;
+    }
+    for (auto& txn : to.block.transactions) {
+        txn.from.emplace();
+        if (!reader.read_address(*txn.from)) {
+            return DecodingResult::kInputTooShort;
+        }
+    }
+
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        evmc::address address;
+        size_t length{0};
+        if (!reader.read_address(address) || !reader.read_u8(length) || !reader.read(length, view)) {
+            return DecodingResult::kInputTooShort;
+        }
+        const auto [account, res]{Account::from_encoded_storage(view)};
+        if (res != DecodingResult::kOk) {
+            return res;
+        }
+        to.accounts.emplace(address, account);
+    }
+
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        evmc::address address;
+        uint64_t incarnation{0};
+        if (!reader.read_address(address) || !reader.read_u64(incarnation)) {
+            return DecodingResult::kInputTooShort;
+        }
+        to.previous_incarnations.emplace(address, incarnation);
+    }
+
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 location;
+        size_t length{0};
+        if (!reader.read_address(address) || !reader.read_u64(incarnation) || !reader.read_hash(location) ||
+            !reader.read_u8(length)) {
+            return DecodingResult::kInputTooShort;
+        }
+        if (length > kHashLength) {
+            return DecodingResult::kOverflow;
+        }
+        if (!reader.read(length, view)) {
+            return DecodingResult::kInputTooShort;
+        }
+        to.storage.emplace(std::make_tuple(address, incarnation, location), to_bytes32(view));
+    }
+
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        evmc::bytes32 code_hash;
+        if (!reader.read_hash(code_hash) || !reader.read_sized(view)) {
+            return DecodingResult::kInputTooShort;
+        }
+        to.code.emplace(code_hash, Bytes{view});
+    }
+
+    if (!reader.read_u32(count)) {
+        return DecodingResult::kInputTooShort;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        evmc::bytes32 block_hash;
+        if (!reader.read_hash(block_hash) || !reader.read_sized(view)) {
+            return DecodingResult::kInputTooShort;
+        }
+        BlockHeader header;
+        if (const DecodingResult res{decode_rlp_field(view, header)}; res != DecodingResult::kOk) {
+            return res;
+        }
+        to.headers.emplace(block_hash, std::move(header));
+    }
+
+    return reader.empty() ? DecodingResult::kOk : DecodingResult::kUnexpectedLength;
+}
+
+void BlockWitness::load_into(InMemoryState& state) const {
+    // Incarnations go first: recording a destructed account erases it
+    for (const auto& [address, incarnation] : previous_incarnations) {
+        Account destructed{};
+        destructed.incarnation = incarnation;
+        state.update_account(address, destructed, /*current=*/std::nullopt);
+    }
+    for (const auto& [address, account] : accounts) {
+        state.update_account(address, /*initial=*/std::nullopt, account);
+    }
+    for (const auto& [key, value] : storage) {
+        const auto& [address, incarnation, location]{key};
+        state.update_storage(address, incarnation, location, /*initial=*/{}, value);
+    }
+    for (const auto& [code_hash, bytecode] : code) {
+        state.update_account_code(/*address=*/{}, /*incarnation=*/0, code_hash, bytecode);
+    }
+    for (const auto& [block_hash, header] : headers) {
+        Block ancestor;
+        ancestor.header = header;
+        state.insert_block(ancestor, block_hash);
+    }
+}
+
+std::optional<Account> WitnessRecorder::read_account(const evmc::address& address) const noexcept {
+    std::optional<Account> account{db_.read_account(address)};
+    if (recording_ && account) {
+        witness_.accounts.try_emplace(address, *account);
+    }
+    return account;
+}
+
+ByteView WitnessRecorder::read_code(const evmc::bytes32& code_hash) const noexcept {
+    const ByteView code{db_.read_code(code_hash)};
+    if (recording_ && !code.empty()) {
+        witness_.code.try_emplace(code_hash, code);
+    }
+    return code;
+}
+
+evmc::bytes32 WitnessRecorder::read_storage(const evmc::address& address, uint64_t incarnation,
+                                            const evmc::bytes32& location) const noexcept {
+    const evmc::bytes32 value{db_.read_storage(address, incarnation, location)};
+    if (recording_ && !is_zero(value)) {
+        witness_.storage.try_emplace(std::make_tuple(address, incarnation, location), value);
+    }
+    return value;
+}
+
+uint64_t WitnessRecorder::previous_incarnation(const evmc::address& address) const noexcept {
+    const uint64_t incarnation{db_.previous_incarnation(address)};
+    if (recording_ && incarnation != 0) {
+        witness_.previous_incarnations.try_emplace(address, incarnation);
+    }
+    return incarnation;
+}
+
+std::optional<BlockHeader> WitnessRecorder::read_header(uint64_t block_number,
+                                                        const evmc::bytes32& block_hash) const noexcept {
+    std::optional<BlockHeader> header{db_.read_header(block_number, block_hash)};
+    if (recording_ && header) {
+        witness_.headers.try_emplace(block_hash, *header);
+    }
+    return header;
+}
+
+bool WitnessRecorder::read_body(uint64_t block_number, const evmc::bytes32& block_hash, BlockBody& out) const noexcept {
+    return db_.read_body(block_number, block_hash, out);
+}
+
+std::optional<intx::uint256> WitnessRecorder::total_difficulty(uint64_t block_number,
+                                                               const evmc::bytes32& block_hash) const noexcept {
+    return db_.total_difficulty(block_number, block_hash);
+}
+
+evmc::bytes32 WitnessRecorder::state_root_hash() const { return db_.state_root_hash(); }
+
+uint64_t WitnessRecorder::current_canonical_block() const { return db_.current_canonical_block(); }
+
+std::optional<evmc::bytes32> WitnessRecorder::canonical_hash(uint64_t block_number) const {
+    return db_.canonical_hash(block_number);
+}
+
+void WitnessRecorder::insert_block(const Block& block, const evmc::bytes32& hash) { db_.insert_block(block, hash); }
+
+void WitnessRecorder::canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) {
+    db_.canonize_block(block_number, block_hash);
+}
+
+void WitnessRecorder::decanonize_block(uint64_t block_number) { db_.decanonize_block(block_number); }
+
+void WitnessRecorder::insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) {
+    db_.insert_receipts(block_number, receipts);
+}
+
+void WitnessRecorder::begin_block(uint64_t block_number) {
+    recording_ = false;
+    db_.begin_block(block_number);
+}
+
+void WitnessRecorder::update_account(const evmc::address& address, std::optional<Account> initial,
+                                     std::optional<Account> current) {
+    db_.update_account(address, initial, current);
+}
+
+void WitnessRecorder::update_account_code(const evmc::address& address, uint64_t incarnation,
+                                          const evmc::bytes32& code_hash, ByteView code) {
+    db_.update_account_code(address, incarnation, code_hash, code);
+}
+
+void WitnessRecorder::update_storage(const evmc::address& address, uint64_t incarnation,
+                                     const evmc::bytes32& location, const evmc::bytes32& initial,
+                                     const evmc::bytes32& current) {
+    db_.update_storage(address, incarnation, location, initial, current);
+}
+
+void WitnessRecorder::unwind_state_changes(uint64_t block_number) { db_.unwind_state_changes(block_number); }
+
+}  // namespace silkworm
@@ -0,0 +1,126 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/decoding_result.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+#include <silkworm/state/state.hpp>
+#include <silkworm/types/block.hpp>
+
+/*
+Block witnesses: the block along with every piece of pre-state its execution reads, so that it can be re-executed on
+an InMemoryState seeded with the witness only, without any database. The encoding is
+
+    witness      : magic (8 bytes) + chain_id_u64 (BE) + block_length_u32 (BE) + block RLP +
+                   sender_count_u32 (BE) + senders (20 bytes each) + the sections below, in order
+    accounts     : count_u32 (BE) + per entry address (20 bytes) + value_length_u8 + Account::encode_for_storage
+    incarnations : count_u32 (BE) + per entry address (20 bytes) + previous_incarnation_u64 (BE)
+    storage      : count_u32 (BE) + per entry address (20 bytes) + incarnation_u64 (BE) + location (32 bytes) +
+                   value_length_u8 + value without leading zeros
+    code         : count_u32 (BE) + per entry code_hash (32 bytes) + code_length_u32 (BE) + code
+    headers      : count_u32 (BE) + per entry block_hash (32 bytes) + header_length_u32 (BE) + header RLP
+
+Entries are sorted by key. Only what is there is recorded: missing accounts, zero incarnations and zero storage
+values read the same from an empty state. Headers are the ancestors looked up by BLOCKHASH.
+*/
+namespace silkworm {
+
+struct BlockWitness {
+    uint64_t chain_id{0};
+    Block block;  // Senders are held in the transactions
+
+    std::map<evmc::address, Account> accounts;
+    std::map<evmc::address, uint64_t> previous_incarnations;
+    std::map<std::tuple<evmc::address, uint64_t, evmc::bytes32>, evmc::bytes32> storage;
+    std::map<evmc::bytes32, Bytes> code;
+    std::map<evmc::bytes32, BlockHeader> headers;
+
+    [[nodiscard]] Bytes encode() const;
+
+    //! \brief Decodes a witness produced by encode
+    //! \remarks Each transaction of the block must have its sender recorded
+    [[nodiscard]] static DecodingResult decode(ByteView from, BlockWitness& to) noexcept;
+
+    //! \brief Seeds an empty state with the pre-state of the witness, ready for the block to be executed on top
+    void load_into(InMemoryState& state) const;
+};
+
+//! \brief Pass-through State which records into a BlockWitness everything read from the underlying state up to the
+//! first state change, i.e. the pre-state of the block being executed
+//! \remarks Accesses are not synchronized: parallel execution already serializes reads of the underlying state
+class WitnessRecorder : public State {
+  public:
+    WitnessRecorder(State& db, BlockWitness& witness) noexcept : db_{db}, witness_{witness} {}
+
+    std::optional<Account> read_account(const evmc::address& address) const noexcept override;
+
+    ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
+                               const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<BlockHeader> read_header(uint64_t block_number,
+                                           const evmc::bytes32& block_hash) const noexcept override;
+
+    [[nodiscard]] bool read_body(uint64_t block_number, const evmc::bytes32& block_hash,
+                                 BlockBody& out) const noexcept override;
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number,
+                                                  const evmc::bytes32& block_hash) const noexcept override;
+
+    evmc::bytes32 state_root_hash() const override;
+
+    uint64_t current_canonical_block() const override;
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override;
+
+    void insert_block(const Block& block, const evmc::bytes32& hash) override;
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override;
+
+    void decanonize_block(uint64_t block_number) override;
+
+    void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
+
+    void begin_block(uint64_t block_number) override;
+
+    void update_account(const evmc::address& address, std::optional<Account> initial,
+                        std::optional<Account> current) override;
+
+    void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash,
+                             ByteView code) override;
+
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& initial, const evmc::bytes32& current) override;
+
+    void unwind_state_changes(uint64_t block_number) override;
+
+  private:
+    State& db_;
+    BlockWitness& witness_;
+    bool recording_{true};  // Reads past begin_block may see the changes of the block itself
+};
+
+}  // namespace silkworm
@@ -0,0 +1,163 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "witness.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/consensus/engine.hpp>
+#include <silkworm/execution/processor.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Block witness") {
+    Block block{};
+    block.header.number = 4'000'000;  // pre-Byzantium: receipts root is not checked
+    block.header.gas_limit = 10'000'000;
+    block.header.beneficiary = 0x4bb96091ee9d802ed039c4d1a5f6216f90f81b01_address;
+    block.header.parent_hash = 0xa4c1ae3b1b4ac1dd5cd4fb2a5a1b1d1b1a6a27fa55bf6a34c9b0d3ab69aa2c7f_bytes32;
+
+    const evmc::address sender{0x00000000000000000000000000000000000a0001_address};
+    const evmc::address contract{0x00000000000000000000000000000000000c0de1_address};
+    const evmc::address bystander{0x00000000000000000000000000000000000b0001_address};
+
+    // Stores BLOCKHASH(NUMBER - 2) into location 1 and a copy of location 0 into location 2
+    const Bytes code{*from_hex("600243034060015560005460025500")};
+    const evmc::bytes32 code_hash{to_bytes32(keccak256(code).bytes)};
+    const evmc::bytes32 location0{};
+    const evmc::bytes32 location1{to_bytes32(Bytes{0x01})};
+    const evmc::bytes32 location2{to_bytes32(Bytes{0x02})};
+    const evmc::bytes32 value0{to_bytes32(Bytes{0x2a})};
+
+    BlockHeader parent;
+    parent.number = block.header.number - 1;
+    parent.parent_hash = 0x3b18ba8e8d7f3e5dbf44d5aaec2ab0e3b9e8dcdb9db2a39e5e64e7bd6a0f9a6c_bytes32;
+
+    Transaction txn{
+        Transaction::Type::kLegacy,  // type
+        0,                           // nonce
+        10 * kGiga,                  // max_priority_fee_per_gas
+        10 * kGiga,                  // max_fee_per_gas
+        200'000,                     // gas_limit
+        contract,                    // to
+        1'000,                       // value
+        {},                          // data
+        false,                       // odd_y_parity
+        std::nullopt,                // chain_id
+        1,                           // r
+        1,                           // s
+    };
+    txn.from = sender;
+    block.transactions.push_back(txn);
+
+    const auto seed{[&](InMemoryState& state) {
+        Account account{};
+        account.balance = kEther;
+        state.update_account(sender, /*initial=*/std::nullopt, account);
+        state.update_account(bystander, /*initial=*/std::nullopt, account);
+        account.code_hash = code_hash;
+        account.incarnation = kDefaultIncarnation;
+        state.update_account(contract, /*initial=*/std::nullopt, account);
+        state.update_account_code(contract, kDefaultIncarnation, code_hash, code);
+        state.update_storage(contract, kDefaultIncarnation, location0, /*initial=*/{}, value0);
+        Block ancestor;
+        ancestor.header = parent;
+        state.insert_block(ancestor, block.header.parent_hash);
+    }};
+
+    auto engine{consensus::engine_factory(kMainnetConfig)};
+    std::vector<Receipt> receipts;
+    const auto execute{[&](State& state) {
+        ExecutionProcessor processor{block, *engine, state, kMainnetConfig};
+        return processor.execute_and_write_block(receipts);
+    }};
+
+    // Find out the overall gas used
+    {
+        InMemoryState state;
+        seed(state);
+        REQUIRE(execute(state) == ValidationResult::kWrongBlockGas);
+        block.header.gas_used = receipts.back().cumulative_gas_used;
+    }
+
+    InMemoryState db;
+    seed(db);
+    BlockWitness witness;
+    witness.chain_id = kMainnetConfig.chain_id;
+    witness.block = block;
+    WitnessRecorder recorder{db, witness};
+    REQUIRE(execute(recorder) == ValidationResult::kOk);
+
+    SECTION("Records the pre-state read") {
+        CHECK(witness.accounts.size() == 2);  // Neither the bystander nor the missing beneficiary
+        CHECK(witness.accounts.at(sender).balance == kEther);
+        CHECK(witness.accounts.at(contract).code_hash == code_hash);
+        CHECK(witness.previous_incarnations.empty());
+        REQUIRE(witness.storage.size() == 1);  // Other locations are zero
+        CHECK(witness.storage.begin()->second == value0);
+        CHECK(witness.code.at(code_hash) == code);
+        REQUIRE(witness.headers.size() == 1);
+        CHECK(witness.headers.at(block.header.parent_hash) == parent);
+    }
+
+    SECTION("Encoding round trip") {
+        witness.previous_incarnations.emplace(bystander, 3);
+        const Bytes encoded{witness.encode()};
+
+        BlockWitness decoded;
+        REQUIRE(BlockWitness::decode(encoded, decoded) == DecodingResult::kOk);
+        CHECK(decoded.chain_id == witness.chain_id);
+        CHECK(decoded.block.header == block.header);
+        REQUIRE(decoded.block.transactions.size() == 1);
+        CHECK(decoded.block.transactions[0] == txn);
+        CHECK(decoded.block.transactions[0].from == sender);
+        CHECK(decoded.accounts == witness.accounts);
+        CHECK(decoded.previous_incarnations == witness.previous_incarnations);
+        CHECK(decoded.storage == witness.storage);
+        CHECK(decoded.code == witness.code);
+        CHECK(decoded.headers == witness.headers);
+
+        CHECK(BlockWitness::decode(ByteView{encoded}.substr(0, encoded.length() - 1), decoded) ==
+              DecodingResult::kInputTooShort);
+        CHECK(BlockWitness::decode(encoded + Bytes{0x00}, decoded) == DecodingResult::kUnexpectedLength);
+        Bytes wrong_magic{encoded};
+        wrong_magic[0] ^= 0xff;
+        CHECK(BlockWitness::decode(wrong_magic, decoded) == DecodingResult::kInvalidFieldset);
+    }
+
+    SECTION("Stateless re-execution") {
+        BlockWitness decoded;
+        REQUIRE(BlockWitness::decode(witness.encode(), decoded) == DecodingResult::kOk);
+        InMemoryState stateless;
+        decoded.load_into(stateless);
+        block = decoded.block;
+        REQUIRE(execute(stateless) == ValidationResult::kOk);
+
+        for (const auto& address : {sender, contract, block.header.beneficiary}) {
+            CHECK(stateless.read_account(address) == db.read_account(address));
+        }
+        CHECK(stateless.read_storage(contract, kDefaultIncarnation, location1) == parent.parent_hash);
+        for (const auto& location : {location0, location1, location2}) {
+            CHECK(stateless.read_storage(contract, kDefaultIncarnation, location) ==
+                  db.read_storage(contract, kDefaultIncarnation, location));
+        }
+        CHECK_FALSE(stateless.read_account(bystander));
+    }
+}
+
+}  // namespace silkworm
@@ -20,7 +20,6 @@
 #include <bitset>
 #include <cassert>
 #include <cstring>
-#include <span>
 
 #include <ethash/keccak.hpp>
 
@@ -31,39 +30,52 @@
 namespace silkworm::trie {
 
 Bytes pack_nibbles(ByteView nibbles) {
-    const size_t n{(nibbles.length() + 1) / 2};
-    Bytes out(n, '\0');
-    if (n == 0) {
-        return out;
+    Bytes out((nibbles.length() + 1) / 2, '\0');
+
+    // Plain indexed loops over raw pointers get vectorized by the compiler
+    const uint8_t* in{nibbles.data()};
+    uint8_t* dst{out.data()};
+    const size_t num_pairs{nibbles.length() / 2};
+    for (size_t i{0}; i < num_pairs; ++i) {
+        dst[i] = static_cast<uint8_t>((in[2 * i] << 4) | in[2 * i + 1]);
     }
-
-    auto out_it{out.begin()};
-    while (!nibbles.empty()) {
-        *out_it = nibbles[0] << 4;
-        nibbles.remove_prefix(1);
-        if (!nibbles.empty()) {
-            *out_it += nibbles[0];
-            nibbles.remove_prefix(1);
-            std::advance(out_it, 1);
-        }
+    if (nibbles.length() % 2 != 0) {
+        dst[num_pairs] = static_cast<uint8_t>(in[nibbles.length() - 1] << 4);
     }
 
     return out;
 }
 
+void unpack_nibbles(ByteView packed, uint8_t* out) noexcept {
+    const uint8_t* in{packed.data()};
+    size_t i{0};
+#if defined(__wasm_simd128__)
+    // Eight bytes at a time, each widened to a little endian word: high nibble in its low byte, low nibble in its high
+    using ByteLanes = uint8_t __attribute__((vector_size(8)));
+    using WordLanes = uint16_t __attribute__((vector_size(16)));
+    for (; i + sizeof(ByteLanes) <= packed.length(); i += sizeof(ByteLanes)) {
+        ByteLanes bytes;
+        std::memcpy(&bytes, in + i, sizeof(bytes));
+        const WordLanes words{__builtin_convertvector(bytes, WordLanes)};
+        const WordLanes nibbles{(words >> 4) | ((words & 0xF) << 8)};
+        std::memcpy(out + 2 * i, &nibbles, sizeof(nibbles));
+    }
+#endif
+    for (; i < packed.length(); ++i) {
+        out[2 * i] = in[i] >> 4;
+        out[2 * i + 1] = in[i] & 0xF;
+    }
+}
+
 Bytes unpack_nibbles(ByteView packed) {
     Bytes out(2 * packed.length(), '\0');
-    auto out_it{out.begin()};
-    for (const auto& b : packed) {
-        *out_it++ = b >> 4;
-        *out_it++ = b & 0xF;
-    }
+    unpack_nibbles(packed, out.data());
     return out;
 }
 
 // See "Specification: Compact encoding of hex sequence with optional terminator"
 // at https://eth.wiki/fundamentals/patricia-tree
-static Bytes encode_path(ByteView nibbles, bool terminating) {
+Bytes encode_path(ByteView nibbles, bool terminating) {
     Bytes res(nibbles.length() / 2 + 1, '\0');
     const bool odd{nibbles.length() % 2 != 0};
 
@@ -84,60 +96,112 @@ static Bytes encode_path(ByteView nibbles, bool terminating) {
     return res;
 }
 
-ByteView HashBuilder::leaf_node_rlp(ByteView path, ByteView value) {
-    Bytes encoded_path{encode_path(path, /*terminating=*/true)};
-    rlp_buffer_.clear();
-    rlp::Header h{/*list=*/true, /*payload_length=*/rlp::length(encoded_path) + rlp::length(value)};
-    rlp::encode_header(rlp_buffer_, h);
-    rlp::encode(rlp_buffer_, encoded_path);
-    rlp::encode(rlp_buffer_, value);
-    return rlp_buffer_;
+// Length of the RLP of the compact encoding of a path
+static size_t encoded_path_rlp_length(size_t num_nibbles) {
+    const size_t len{num_nibbles / 2 + 1};
+    return len > 1 ? len + 1 : 1;  // A single byte is below 0x80, hence encoded as itself
+}
+
+// Appends the RLP of the compact encoding of a path, built in place
+static void encode_path_rlp(Bytes& out, ByteView nibbles, bool terminating) {
+    const size_t len{nibbles.length() / 2 + 1};
+    if (len > 1) {
+        out.push_back(static_cast<uint8_t>(rlp::kEmptyStringCode + len));
+    }
+
+    const bool odd{nibbles.length() % 2 != 0};
+    uint8_t first{static_cast<uint8_t>((terminating ? 0x20 : 0x00) + (odd ? 0x10 : 0x00))};
+    if (odd) {
+        first |= nibbles[0];
+        nibbles.remove_prefix(1);
+    }
+    out.push_back(first);
+
+    for (size_t i{0}; i < nibbles.length(); i += 2) {
+        out.push_back(static_cast<uint8_t>((nibbles[i] << 4) + nibbles[i + 1]));
+    }
+}
+
+ByteView HashBuilder::leaf_node_rlp(Bytes& out, ByteView path, ByteView value) {
+    out.clear();
+    rlp::Header h{/*list=*/true, /*payload_length=*/encoded_path_rlp_length(path.length()) + rlp::length(value)};
+    rlp::encode_header(out, h);
+    encode_path_rlp(out, path, /*terminating=*/true);
+    rlp::encode(out, value);
+    return out;
+}
+
+HashBuilder::NodeRef HashBuilder::leaf_node_ref(ByteView path, ByteView value, Bytes& rlp_buffer) {
+    return NodeRef{leaf_node_rlp(rlp_buffer, path, value)};
 }
 
 ByteView HashBuilder::extension_node_rlp(ByteView path, ByteView child_ref) {
-    Bytes encoded_path{encode_path(path, /*terminating=*/false)};
     rlp_buffer_.clear();
-    rlp::Header h{/*list=*/true, /*payload_length=*/rlp::length(encoded_path) + child_ref.length()};
+    rlp::Header h{/*list=*/true, /*payload_length=*/encoded_path_rlp_length(path.length()) + child_ref.length()};
     rlp::encode_header(rlp_buffer_, h);
-    rlp::encode(rlp_buffer_, encoded_path);
+    encode_path_rlp(rlp_buffer_, path, /*terminating=*/false);
     rlp_buffer_.append(child_ref);
     return rlp_buffer_;
 }
 
-static Bytes wrap_hash(std::span<const uint8_t, kHashLength> hash) {
-    Bytes wrapped(kHashLength + 1, '\0');
-    wrapped[0] = rlp::kEmptyStringCode + kHashLength;
-    std::memcpy(&wrapped[1], &hash[0], kHashLength);
-    return wrapped;
+HashBuilder::NodeRef::NodeRef(ByteView rlp) {
+    if (rlp.length() < kHashLength) {
+        std::memcpy(data_, rlp.data(), rlp.length());
+        length_ = static_cast<uint8_t>(rlp.length());
+    } else {
+        *this = wrap_hash(keccak256(rlp).bytes);
+    }
 }
 
-static Bytes node_ref(ByteView rlp) {
-    if (rlp.length() < kHashLength) {
-        return Bytes{rlp};
+HashBuilder::NodeRef HashBuilder::NodeRef::wrap_hash(const uint8_t* hash) noexcept {
+    NodeRef ref;
+    ref.data_[0] = rlp::kEmptyStringCode + kHashLength;
+    std::memcpy(&ref.data_[1], hash, kHashLength);
+    ref.length_ = kHashLength + 1;
+    return ref;
+}
+
+HashBuilder::HashBuilder() {
+    key_.reserve(kMaxKeyLength);
+    stack_.reserve(kMaxKeyLength);
+}
+
+void HashBuilder::add_leaf(ByteView key, ByteView value) {
+    assert(key > key_);
+    assert(key.length() <= kMaxKeyLength);
+    if (!key_.empty()) {
+        gen_struct_step(key_, key);
     }
-    const ethash::hash256 hash{keccak256(rlp)};
-    return wrap_hash(hash.bytes);
+    key_.assign(key);
+    leaf_value_.assign(value);
+    leaf_node_ref_.reset();
+    is_leaf_ = true;
 }
 
-void HashBuilder::add_leaf(Bytes key, ByteView value) {
+void HashBuilder::add_leaf_node_ref(ByteView key, const NodeRef& leaf_node_ref) {
     assert(key > key_);
+    assert(key.length() <= kMaxKeyLength);
     if (!key_.empty()) {
         gen_struct_step(key_, key);
     }
-    key_ = std::move(key);
-    value_ = Bytes{value};
+    key_.assign(key);
+    leaf_value_.clear();
+    leaf_node_ref_ = leaf_node_ref;
+    is_leaf_ = true;
 }
 
-void HashBuilder::add_branch_node(Bytes key, const evmc::bytes32& value, bool is_in_db_trie) {
+void HashBuilder::add_branch_node(ByteView key, const evmc::bytes32& value, bool is_in_db_trie) {
     assert(key > key_ || (key_.empty() && key.empty()));
+    assert(key.length() <= kMaxKeyLength);
     if (!key_.empty()) {
         gen_struct_step(key_, key);
     } else if (key.empty()) {
         // known root hash
-        stack_.push_back(wrap_hash(value.bytes));
+        stack_.push_back(NodeRef::wrap_hash(value.bytes));
     }
-    key_ = std::move(key);
-    value_ = value;
+    key_.assign(key);
+    hash_ = value;
+    is_leaf_ = false;
     is_in_db_trie_ = is_in_db_trie;
 }
 
@@ -145,10 +209,24 @@ void HashBuilder::finalize() {
     if (!key_.empty()) {
         gen_struct_step(key_, {});
         key_.clear();
-        value_ = Bytes{};
+        leaf_value_.clear();
+        leaf_node_ref_.reset();
+        is_leaf_ = true;
     }
 }
 
+void HashBuilder::reset() {
+    key_.clear();
+    leaf_value_.clear();
+    leaf_node_ref_.reset();
+    is_leaf_ = true;
+    is_in_db_trie_ = false;
+    groups_.resize(0);
+    tree_masks_.resize(0);
+    hash_masks_.resize(0);
+    stack_.clear();
+}
+
 evmc::bytes32 HashBuilder::root_hash() { return root_hash(/*auto_finalize=*/true); }
 
 evmc::bytes32 HashBuilder::root_hash(bool auto_finalize) {
@@ -160,10 +238,10 @@ evmc::bytes32 HashBuilder::root_hash(bool auto_finalize) {
         return kEmptyRoot;
     }
 
-    const Bytes& node_ref{stack_.back()};
+    const NodeRef& node_ref{stack_.back()};
     evmc::bytes32 res{};
     if (node_ref.length() == kHashLength + 1) {
-        std::memcpy(res.bytes, &node_ref[1], kHashLength);
+        std::memcpy(res.bytes, &node_ref.data()[1], kHashLength);
     } else {
         res = bit_cast<evmc_bytes32>(keccak256(node_ref));
     }
@@ -200,10 +278,14 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
 
         const ByteView short_node_key{current.substr(from)};
         if (!build_extensions) {
-            if (const Bytes * leaf_value{std::get_if<Bytes>(&value_)}) {
-                stack_.push_back(node_ref(leaf_node_rlp(short_node_key, *leaf_value)));
+            if (is_leaf_) {
+                if (leaf_node_ref_) {
+                    stack_.push_back(*leaf_node_ref_);
+                } else {
+                    stack_.emplace_back(leaf_node_rlp(rlp_buffer_, short_node_key, leaf_value_));
+                }
             } else {
-                stack_.push_back(wrap_hash(std::get<evmc::bytes32>(value_).bytes));
+                stack_.push_back(NodeRef::wrap_hash(hash_.bytes));
                 if (node_collector) {
                     if (is_in_db_trie_) {
                         // keep track of existing records in DB
@@ -230,7 +312,7 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
                 }
             }
 
-            stack_.back() = node_ref(extension_node_rlp(short_node_key, stack_.back()));
+            stack_.back() = NodeRef{extension_node_rlp(short_node_key, stack_.back())};
 
             hash_masks_.resize(from);
             tree_masks_.resize(from);
@@ -243,7 +325,7 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
 
         // Close the immediately encompassing prefix group, if needed
         if (!succeeding.empty() || preceding_exists) {  // branch node
-            std::vector<Bytes> child_hashes{branch_ref(groups_[len], hash_masks_[len])};
+            branch_ref(groups_[len], hash_masks_[len]);
 
             // See node/silkworm/trie/intermediate_hashes.hpp
             if (node_collector) {
@@ -257,12 +339,9 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
                         tree_masks_[len - 1] |= 1u << current[len - 1];  // register myself in parent bitmap
                     }
 
-                    std::vector<evmc::bytes32> hashes(child_hashes.size());
-                    for (size_t i{0}; i < child_hashes.size(); ++i) {
-                        assert(child_hashes[i].size() == kHashLength + 1);
-                        std::memcpy(hashes[i].bytes, &child_hashes[i][1], kHashLength);
-                    }
-                    Node n{groups_[len], tree_masks_[len], hash_masks_[len], hashes};
+                    const size_t num_hashes{std::bitset<16>(hash_masks_[len]).count()};
+                    Node n{groups_[len], tree_masks_[len], hash_masks_[len],
+                           std::vector<evmc::bytes32>(child_hashes_, child_hashes_ + num_hashes)};
                     if (len == 0) {
                         n.set_root_hash(root_hash(/*auto_finalize=*/false));
                     }
@@ -288,11 +367,9 @@ void HashBuilder::gen_struct_step(ByteView current, const ByteView succeeding) {
     }
 }
 
-// Takes children from the stack and replaces them with branch node ref.
-std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_mask) {
+void HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_mask) {
     assert_subset(hash_mask, state_mask);
-    std::vector<Bytes> child_hashes;
-    child_hashes.reserve(std::bitset<16>(hash_mask).count());
+    size_t num_hashes{0};
 
     const size_t first_child_idx{stack_.size() - std::bitset<16>(state_mask).count()};
 
@@ -312,10 +389,12 @@ std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_ma
 
     for (size_t i{first_child_idx}, digit{0}; digit < 16; ++digit) {
         if (state_mask & (1u << digit)) {
+            const NodeRef& child{stack_[i++]};
             if (hash_mask & (1u << digit)) {
-                child_hashes.push_back(stack_[i]);
+                assert(child.length() == kHashLength + 1);
+                std::memcpy(child_hashes_[num_hashes++].bytes, &child.data()[1], kHashLength);
             }
-            rlp_buffer_.append(stack_[i++]);
+            rlp_buffer_.append(child);
         } else {
             rlp_buffer_.push_back(rlp::kEmptyStringCode);
         }
@@ -325,9 +404,7 @@ std::vector<Bytes> HashBuilder::branch_ref(uint16_t state_mask, uint16_t hash_ma
     rlp_buffer_.push_back(rlp::kEmptyStringCode);
 
     stack_.resize(first_child_idx + 1);
-    stack_.back() = node_ref(rlp_buffer_);
-
-    return child_hashes;
+    stack_.back() = NodeRef{rlp_buffer_};
 }
 
 }  // namespace silkworm::trie
@@ -16,9 +16,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
 #include <optional>
-#include <variant>
 #include <vector>
 
 #include <silkworm/common/base.hpp>
@@ -32,32 +33,92 @@ using NodeCollector = std::function<void(ByteView unpacked_key, const Node&)>;
 // Calculates root hash of a Modified Merkle Patricia Trie.
 // See Appendix D "Modified Merkle Patricia Trie" of the Yellow Paper
 // and https://eth.wiki/fundamentals/patricia-tree
+//
+// All scratch space is either inline or reused across entries,
+// so that adding an entry doesn't touch the heap once the buffers have warmed up.
 class HashBuilder {
   public:
+    // Keys are at most as long as an unpacked hash, which bounds the depth of the structural stacks
+    static constexpr size_t kMaxKeyLength{2 * kHashLength};
+
+    // Node reference: either the RLP of a node shorter than 32 bytes or its RLP-wrapped hash
+    class NodeRef {
+      public:
+        NodeRef() = default;
+        explicit NodeRef(ByteView rlp);
+
+        operator ByteView() const noexcept { return {data_, length_}; }
+
+        size_t length() const noexcept { return length_; }
+        const uint8_t* data() const noexcept { return data_; }
+
+        static NodeRef wrap_hash(const uint8_t* hash) noexcept;
+
+      private:
+        uint8_t data_[kHashLength + 1]{};
+        uint8_t length_{0};
+    };
+
     HashBuilder(const HashBuilder&) = delete;
     HashBuilder& operator=(const HashBuilder&) = delete;
 
-    HashBuilder() = default;
+    HashBuilder();
 
     // Entries (leaves, nodes) must be added in the strictly increasing lexicographic order (by key).
     // Consequently, duplicate keys are not allowed.
     // The key should be unpacked, i.e. have one nibble per byte.
     // In addition, a leaf key may not be a prefix of another leaf key
     // (e.g. leaves with keys 0a0b & 0a0b0005 may not coexist).
-    void add_leaf(Bytes unpacked_key, ByteView value);
+    void add_leaf(ByteView unpacked_key, ByteView value);
+
+    // Same as add_leaf, with the reference to the leaf node computed in advance by leaf_node_ref,
+    // e.g. concurrently for many leaves.
+    // The path of the leaf node must be the part of the key below the branch node holding the leaf,
+    // or the whole key for a single leaf.
+    void add_leaf_node_ref(ByteView unpacked_key, const NodeRef& leaf_node_ref);
+
+    // Reference to the leaf node with the given path (unpacked) and value; rlp_buffer is scratch space.
+    static NodeRef leaf_node_ref(ByteView path, ByteView value, Bytes& rlp_buffer);
 
     // Entries (leaves, nodes) must be added in the strictly increasing lexicographic order (by key).
     // Consequently, duplicate keys are not allowed.
     // The key should be unpacked, i.e. have one nibble per byte.
     // Nodes whose RLP is shorter than 32 bytes may not be added.
-    void add_branch_node(Bytes unpacked_key, const evmc::bytes32& hash, bool is_in_db_trie = false);
+    void add_branch_node(ByteView unpacked_key, const evmc::bytes32& hash, bool is_in_db_trie = false);
 
     // May only be called after all entries have been added.
     evmc::bytes32 root_hash();
 
+    // Gets the builder ready for another trie, keeping its buffers (and node_collector).
+    void reset();
+
     NodeCollector node_collector{nullptr};
 
   private:
+    // Stack of masks with inline storage: one element per nibble of the current key
+    class MaskStack {
+      public:
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        // Newly added elements are zeroed
+        void resize(size_t n) noexcept {
+            assert(n <= kMaxKeyLength);
+            if (n > size_) {
+                std::fill(&masks_[size_], &masks_[n], uint16_t{0});
+            }
+            size_ = n;
+        }
+
+        uint16_t& operator[](size_t i) noexcept { return masks_[i]; }
+        uint16_t& back() noexcept { return masks_[size_ - 1]; }
+        void pop_back() noexcept { --size_; }
+
+      private:
+        uint16_t masks_[kMaxKeyLength]{};
+        size_t size_{0};
+    };
+
     evmc::bytes32 root_hash(bool auto_finalize);
 
     void finalize();
@@ -65,21 +126,28 @@ class HashBuilder {
     // See Erigon GenStructStep
     void gen_struct_step(ByteView current, ByteView succeeding);
 
-    std::vector<Bytes> branch_ref(uint16_t state_mask, uint16_t hash_mask);
+    // Replaces the children on top of the stack with the branch node ref
+    // and copies the hashes of the children selected by hash_mask into child_hashes_
+    void branch_ref(uint16_t state_mask, uint16_t hash_mask);
 
-    ByteView leaf_node_rlp(ByteView path, ByteView value);
+    static ByteView leaf_node_rlp(Bytes& out, ByteView path, ByteView value);
 
     ByteView extension_node_rlp(ByteView path, ByteView child_ref);
 
-    Bytes key_;                                 // unpacked – one nibble per byte
-    std::variant<Bytes, evmc::bytes32> value_;  // leaf value or node hash
+    Bytes key_;           // unpacked – one nibble per byte
+    Bytes leaf_value_;    // value of the last entry, if a leaf
+    evmc::bytes32 hash_;  // hash of the last entry, if a node
+    bool is_leaf_{true};
     bool is_in_db_trie_{false};
+    // node of the last entry, if a leaf added by add_leaf_node_ref
+    std::optional<NodeRef> leaf_node_ref_;
 
-    std::vector<uint16_t> groups_;
-    std::vector<uint16_t> tree_masks_;
-    std::vector<uint16_t> hash_masks_;
-    std::vector<Bytes> stack_;  // node references: hashes or embedded RLPs
+    MaskStack groups_;
+    MaskStack tree_masks_;
+    MaskStack hash_masks_;
+    std::vector<NodeRef> stack_;  // node references: hashes or embedded RLPs
 
+    evmc::bytes32 child_hashes_[16];
     Bytes rlp_buffer_;
 };
 
@@ -89,4 +157,10 @@ Bytes pack_nibbles(ByteView nibbles);
 // Erigon DecompressNibbles
 Bytes unpack_nibbles(ByteView packed);
 
+// Same as above without allocation: out must have room for 2 * packed.length() nibbles
+void unpack_nibbles(ByteView packed, uint8_t* out) noexcept;
+
+// Compact (hex-prefix) encoding of a nibble path, see Appendix C "Hex-Prefix Encoding" of the Yellow Paper
+Bytes encode_path(ByteView nibbles, bool terminating);
+
 }  // namespace silkworm::trie
@@ -0,0 +1,57 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm::trie {
+
+// State trie of range(0) accounts: hashed keys spread uniformly like those of the real state
+static void BM_HashBuilder_Accounts(benchmark::State& state) {
+    std::mt19937_64 rng{42};
+    std::vector<std::pair<Bytes, Bytes>> leaves(static_cast<size_t>(state.range(0)));
+    for (auto& [key, value] : leaves) {
+        uint64_t seed{rng()};
+        const ethash::hash256 hash{keccak256({reinterpret_cast<const uint8_t*>(&seed), sizeof(seed)})};
+        key = unpack_nibbles({hash.bytes, kHashLength});
+
+        Account account;
+        account.nonce = rng() % 1'000;
+        account.balance = rng();
+        value = account.rlp(kEmptyRoot);
+    }
+    std::sort(leaves.begin(), leaves.end());
+
+    HashBuilder hb;
+    for ([[maybe_unused]] auto _ : state) {
+        hb.reset();
+        for (const auto& [key, value] : leaves) {
+            hb.add_leaf(key, value);
+        }
+        benchmark::DoNotOptimize(hb.root_hash());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * leaves.size()));
+}
+BENCHMARK(BM_HashBuilder_Accounts)->Arg(1'000)->Arg(100'000);
+
+}  // namespace silkworm::trie
@@ -136,6 +136,29 @@ TEST_CASE("HashBuilder2") {
     CHECK(to_hex(hb2.root_hash()) == to_hex(hash1.bytes));
 }
 
+TEST_CASE("HashBuilder reset") {
+    const auto key1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto key2{0xf000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const Bytes val(40, 0xab);  // Long enough for leaves not to be embedded
+
+    HashBuilder reference;
+    reference.add_leaf(unpack_nibbles(key1), val);
+    reference.add_leaf(unpack_nibbles(key2), val);
+    const evmc::bytes32 root{reference.root_hash()};
+
+    HashBuilder hb;
+    hb.add_leaf(unpack_nibbles(key1), *from_hex("01"));
+    hb.add_leaf(unpack_nibbles(key2), *from_hex("02"));  // Left half-built on purpose
+    hb.reset();
+    for (int i{0}; i < 2; ++i) {
+        hb.add_leaf(unpack_nibbles(key1), val);
+        hb.add_leaf(unpack_nibbles(key2), val);
+        CHECK(to_hex(hb.root_hash()) == to_hex(root));
+        hb.reset();
+    }
+    CHECK(to_hex(hb.root_hash()) == to_hex(kEmptyRoot));
+}
+
 TEST_CASE("Known root hash") {
     static constexpr auto root_hash{0x9fa752911d55c3a1246133fe280785afbdba41f357e9cae1131d5f5b0a078b9c_bytes32};
     HashBuilder hb;
@@ -152,4 +175,15 @@ TEST_CASE("pack_nibbles") {
     CHECK(to_hex(pack_nibbles(*from_hex("0a0b0207"))) == "ab27");
 }
 
+TEST_CASE("unpack_nibbles") {
+    CHECK(unpack_nibbles({}).empty());
+    CHECK(to_hex(unpack_nibbles(*from_hex("ab27"))) == "0a0b0207");
+
+    const Bytes packed{*from_hex("00112233445566778899aabbccddeeff01")};
+    uint8_t unpacked[2 * 17];
+    unpack_nibbles(packed, unpacked);
+    CHECK(to_hex(ByteView{unpacked, sizeof(unpacked)}) == to_hex(unpack_nibbles(packed)));
+    CHECK(pack_nibbles(ByteView{unpacked, sizeof(unpacked)}) == packed);
+}
+
 }  // namespace silkworm::trie
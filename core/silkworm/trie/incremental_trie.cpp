@@ -0,0 +1,287 @@
+/*
+   Copyright 2021-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "incremental_trie.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <ethash/keccak.hpp>
+
+#include <silkworm/common/instrumentation.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static Bytes wrap_hash(const ethash::hash256& hash) {
+    Bytes wrapped(kHashLength + 1, '\0');
+    wrapped[0] = rlp::kEmptyStringCode + kHashLength;
+    std::memcpy(&wrapped[1], hash.bytes, kHashLength);
+    return wrapped;
+}
+
+static Bytes node_ref_of(ByteView rlp) {
+    if (rlp.length() < kHashLength) {
+        return Bytes{rlp};
+    }
+    return wrap_hash(keccak256(rlp));
+}
+
+static Bytes list_rlp(ByteView payload) {
+    Bytes rlp;
+    rlp::encode_header(rlp, rlp::Header{/*list=*/true, /*payload_length=*/payload.length()});
+    rlp.append(payload);
+    return rlp;
+}
+
+void IncrementalTrie::put(const evmc::bytes32& key, Bytes value) {
+    assert(!value.empty());
+    uint8_t nibbles[2 * kHashLength];
+    unpack_nibbles(key, nibbles);
+    if (insert(root_, ByteView{nibbles, sizeof(nibbles)}, value)) {
+        ++size_;
+    }
+}
+
+void IncrementalTrie::erase(const evmc::bytes32& key) {
+    uint8_t nibbles[2 * kHashLength];
+    unpack_nibbles(key, nibbles);
+    if (remove(root_, ByteView{nibbles, sizeof(nibbles)})) {
+        --size_;
+    }
+}
+
+void IncrementalTrie::clear() noexcept {
+    root_.reset();
+    size_ = 0;
+}
+
+bool IncrementalTrie::insert(std::unique_ptr<TreeNode>& node, ByteView key, Bytes& value) {
+    if (!node) {
+        node = std::make_unique<TreeNode>();
+        node->path = key;
+        node->value = std::move(value);
+        return true;
+    }
+
+    node->ref.clear();
+    const size_t common{prefix_length(node->path, key)};
+    if (node->is_leaf()) {
+        if (common == key.length()) {
+            node->value = std::move(value);  // All keys have the same length, hence this is the same key
+            return false;
+        }
+    } else if (common == node->path.length()) {
+        return insert(node->children[key[common]], key.substr(common + 1), value);
+    }
+
+    // Paths diverge at nibble #common: a new branch takes over the common part of the path
+    auto branch{std::make_unique<TreeNode>()};
+    branch->path = node->path.substr(0, common);
+    const uint8_t existing_nibble{node->path[common]};
+    node->path.erase(0, common + 1);
+    branch->children[existing_nibble] = std::move(node);
+    (void)insert(branch->children[key[common]], key.substr(common + 1), value);
+    node = std::move(branch);
+    return true;
+}
+
+bool IncrementalTrie::remove(std::unique_ptr<TreeNode>& node, ByteView key) {
+    if (!node) {
+        return false;
+    }
+
+    const size_t common{prefix_length(node->path, key)};
+    if (node->is_leaf()) {
+        if (common != key.length()) {
+            return false;
+        }
+        node.reset();
+        return true;
+    }
+    if (common != node->path.length() || !remove(node->children[key[common]], key.substr(common + 1))) {
+        return false;
+    }
+
+    node->ref.clear();
+    int remaining_nibble{-1};
+    for (int i{0}; i < 16; ++i) {
+        if (node->children[i]) {
+            if (remaining_nibble != -1) {
+                return true;  // Still a branch
+            }
+            remaining_nibble = i;
+        }
+    }
+
+    // A branch always has at least 2 children: the only one left is merged into its parent
+    assert(remaining_nibble != -1);
+    auto child{std::move(node->children[remaining_nibble])};
+    Bytes path{std::move(node->path)};
+    path.push_back(static_cast<uint8_t>(remaining_nibble));
+    path.append(child->path);
+    child->path = std::move(path);
+    child->ref.clear();
+    node = std::move(child);
+    return true;
+}
+
+ByteView IncrementalTrie::node_ref(TreeNode& node) {
+    if (node.ref.empty()) {
+        node.ref = node_ref_of(node_rlp(node));
+    }
+    return node.ref;
+}
+
+Bytes IncrementalTrie::node_rlp(TreeNode& node) {
+    Bytes payload;
+    if (node.is_leaf()) {
+        rlp::encode(payload, encode_path(node.path, /*terminating=*/true));
+        rlp::encode(payload, node.value);
+        return list_rlp(payload);
+    }
+
+    refresh_children(node);
+    for (const auto& child : node.children) {
+        if (child) {
+            payload.append(child->ref);
+        } else {
+            payload.push_back(rlp::kEmptyStringCode);
+        }
+    }
+    payload.push_back(rlp::kEmptyStringCode);  // no value: all keys have the same length
+    Bytes branch_rlp{list_rlp(payload)};
+    if (node.path.empty()) {
+        return branch_rlp;
+    }
+
+    payload.clear();
+    rlp::encode(payload, encode_path(node.path, /*terminating=*/false));
+    payload.append(node_ref_of(branch_rlp));
+    return list_rlp(payload);
+}
+
+void IncrementalTrie::refresh_children(TreeNode& node) {
+    std::array<Bytes, 16> rlps;
+    std::array<TreeNode*, 16> dirty{};
+    size_t num_dirty{0};
+    for (auto& child : node.children) {
+        if (child && child->ref.empty()) {
+            rlps[num_dirty] = node_rlp(*child);
+            dirty[num_dirty++] = child.get();
+        }
+    }
+
+    // Siblings don't depend on each other: the ones to be hashed are hashed together
+    std::array<ByteView, 16> inputs;
+    std::array<TreeNode*, 16> hashed{};
+    size_t num_hashed{0};
+    for (size_t i{0}; i < num_dirty; ++i) {
+        if (rlps[i].length() < kHashLength) {
+            dirty[i]->ref = std::move(rlps[i]);
+        } else {
+            inputs[num_hashed] = rlps[i];
+            hashed[num_hashed++] = dirty[i];
+        }
+    }
+    std::array<ethash::hash256, 16> hashes;
+    keccak256_batch({inputs.data(), num_hashed}, hashes);
+    for (size_t i{0}; i < num_hashed; ++i) {
+        hashed[i]->ref = wrap_hash(hashes[i]);
+    }
+}
+
+evmc::bytes32 IncrementalTrie::root_hash() {
+    if (!root_) {
+        return kEmptyRoot;
+    }
+
+    const ByteView ref{node_ref(*root_)};
+    if (ref.length() < kHashLength) {
+        // Root node is hashed regardless of its length
+        return to_bytes32(keccak256(ref).bytes);
+    }
+    return to_bytes32(ref.substr(1));
+}
+
+void IncrementalStateRoot::update_account(const evmc::address& address, const std::optional<Account>& account) {
+    if (account) {
+        accounts_.insert_or_assign(address, *account);
+    } else {
+        accounts_.erase(address);
+    }
+    changed_.insert(address);
+}
+
+void IncrementalStateRoot::update_storage(const evmc::address& address, uint64_t incarnation,
+                                          const evmc::bytes32& location, const evmc::bytes32& value) {
+    IncrementalTrie& storage{storage_[{address, incarnation}]};
+    const auto hashed_location{to_bytes32(keccak256(location).bytes)};
+    if (is_zero(value)) {
+        storage.erase(hashed_location);
+    } else {
+        Bytes rlp;
+        rlp::encode(rlp, zeroless_view(value));
+        storage.put(hashed_location, std::move(rlp));
+    }
+    changed_.insert(address);
+}
+
+evmc::bytes32 IncrementalStateRoot::root_hash() {
+    SILK_SCOPED_TIMER("trie::IncrementalStateRoot::root_hash");
+    std::array<const evmc::address*, kKeccakBatchSize> batch{};
+    std::array<ByteView, kKeccakBatchSize> inputs;
+    std::array<ethash::hash256, kKeccakBatchSize> hashed_addresses;
+    for (auto it{changed_.begin()}; it != changed_.end();) {
+        size_t n{0};
+        for (; n < kKeccakBatchSize && it != changed_.end(); ++n, ++it) {
+            batch[n] = &*it;
+            inputs[n] = *it;
+        }
+        keccak256_batch({inputs.data(), n}, hashed_addresses);
+        for (size_t i{0}; i < n; ++i) {
+            update_state_trie(*batch[i], to_bytes32(hashed_addresses[i].bytes));
+        }
+    }
+    changed_.clear();
+    return state_trie_.root_hash();
+}
+
+void IncrementalStateRoot::update_state_trie(const evmc::address& address, const evmc::bytes32& hashed_address) {
+    const auto it{accounts_.find(address)};
+    if (it == accounts_.end()) {
+        state_trie_.erase(hashed_address);
+        return;
+    }
+    const Account& account{it->second};
+    evmc::bytes32 storage_root{kEmptyRoot};
+    if (auto storage_it{storage_.find({address, account.incarnation})}; storage_it != storage_.end()) {
+        storage_root = storage_it->second.root_hash();
+    }
+    state_trie_.put(hashed_address, account.rlp(storage_root));
+}
+
+void IncrementalStateRoot::clear() noexcept {
+    accounts_.clear();
+    storage_.clear();
+    changed_.clear();
+    state_trie_.clear();
+}
+
+}  // namespace silkworm::trie
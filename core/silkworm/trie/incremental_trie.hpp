@@ -0,0 +1,121 @@
+/*
+   Copyright 2021-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm::trie {
+
+// In-memory Modified Merkle Patricia Trie keyed by hashes (i.e. fixed length keys) which keeps the references
+// of all its nodes: after an update only the nodes along the updated path are re-hashed.
+// Unlike HashBuilder, entries may be added and removed in any order.
+class IncrementalTrie {
+  public:
+    IncrementalTrie() = default;
+
+    // not copyable, movable
+    IncrementalTrie(const IncrementalTrie&) = delete;
+    IncrementalTrie& operator=(const IncrementalTrie&) = delete;
+    IncrementalTrie(IncrementalTrie&&) noexcept = default;
+    IncrementalTrie& operator=(IncrementalTrie&&) noexcept = default;
+
+    // Inserts or replaces the leaf at key. The value (leaf payload, e.g. an RLP-encoded account) may not be empty.
+    void put(const evmc::bytes32& key, Bytes value);
+
+    // Removes the leaf at key, if any
+    void erase(const evmc::bytes32& key);
+
+    // Only dirty nodes are encoded and hashed
+    evmc::bytes32 root_hash();
+
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept;
+
+  private:
+    // Either a leaf (non-empty value) or a branch, optionally preceded by an extension (non-empty path)
+    struct TreeNode {
+        Bytes path;  // unpacked – one nibble per byte
+        Bytes value;
+        std::array<std::unique_ptr<TreeNode>, 16> children{};
+        Bytes ref;  // cached node reference: either embedded RLP or RLP of the hash; empty when dirty
+
+        [[nodiscard]] bool is_leaf() const noexcept { return !value.empty(); }
+    };
+
+    static bool insert(std::unique_ptr<TreeNode>& node, ByteView key, Bytes& value);
+
+    static bool remove(std::unique_ptr<TreeNode>& node, ByteView key);
+
+    static ByteView node_ref(TreeNode& node);
+
+    // Refreshes the references of dirty descendants first
+    static Bytes node_rlp(TreeNode& node);
+
+    // Updates the references of dirty children, hashing them in a batch
+    static void refresh_children(TreeNode& node);
+
+    std::unique_ptr<TreeNode> root_;
+    size_t size_{0};
+};
+
+// Maintains the state root of a set of plain accounts and storage as they're updated, e.g. block after block.
+// Keys are hashed on the fly, hence neither HashState nor the intermediate hashes of db are needed.
+// Storage is kept per incarnation, so that unwinding to a previous incarnation restores its storage root.
+// N.B. The whole state has to be loaded first: the memory footprint makes this suitable for small chains only.
+class IncrementalStateRoot {
+  public:
+    IncrementalStateRoot() = default;
+
+    // not copyable
+    IncrementalStateRoot(const IncrementalStateRoot&) = delete;
+    IncrementalStateRoot& operator=(const IncrementalStateRoot&) = delete;
+
+    // A nullopt account is a deleted one
+    void update_account(const evmc::address& address, const std::optional<Account>& account);
+
+    // A zero value deletes the storage slot
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& value);
+
+    // Storage roots and the state trie are updated for accounts changed since last call only
+    evmc::bytes32 root_hash();
+
+    [[nodiscard]] size_t number_of_accounts() const noexcept { return accounts_.size(); }
+
+    void clear() noexcept;
+
+  private:
+    void update_state_trie(const evmc::address& address, const evmc::bytes32& hashed_address);
+
+    std::unordered_map<evmc::address, Account> accounts_;
+    std::map<std::pair<evmc::address, uint64_t>, IncrementalTrie> storage_;  // (address, incarnation) -> storage
+    std::unordered_set<evmc::address> changed_;                             // Accounts not yet in state_trie_
+    IncrementalTrie state_trie_;
+};
+
+}  // namespace silkworm::trie
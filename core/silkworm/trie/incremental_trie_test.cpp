@@ -0,0 +1,153 @@
+/*
+   Copyright 2021-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "incremental_trie.hpp"
+
+#include <cstring>
+#include <map>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static evmc::bytes32 full_root(const std::map<evmc::bytes32, Bytes>& leaves) {
+    HashBuilder hb;
+    for (const auto& [key, value] : leaves) {
+        hb.add_leaf(unpack_nibbles(key), value);
+    }
+    return hb.root_hash();
+}
+
+TEST_CASE("IncrementalTrie") {
+    IncrementalTrie trie;
+    CHECK(trie.empty());
+    CHECK(trie.root_hash() == kEmptyRoot);
+
+    SECTION("Single leaf") {
+        const auto key{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+        trie.put(key, *from_hex("01"));
+        CHECK(trie.size() == 1);
+        CHECK(to_hex(trie.root_hash()) == to_hex(full_root({{key, *from_hex("01")}})));
+
+        trie.erase(key);
+        CHECK(trie.empty());
+        CHECK(trie.root_hash() == kEmptyRoot);
+    }
+
+    SECTION("Embedded nodes") {
+        // Same keys of HashBuilder1: the branch node is short enough to be embedded into the extension node
+        const auto key1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+        const auto key2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+        trie.put(key2, *from_hex("02"));
+        trie.put(key1, *from_hex("01"));
+        CHECK(to_hex(trie.root_hash()) == to_hex(full_root({{key1, *from_hex("01")}, {key2, *from_hex("02")}})));
+    }
+
+    SECTION("Random updates") {
+        std::mt19937_64 rng{42};  // NOLINT(cert-msc32-c, cert-msc51-cpp)
+        std::map<evmc::bytes32, Bytes> expected;
+        std::vector<evmc::bytes32> keys;
+        for (size_t round{0}; round < 20; ++round) {
+            for (size_t i{0}; i < 50; ++i) {
+                evmc::bytes32 key;
+                for (size_t j{0}; j < kHashLength; j += sizeof(uint64_t)) {
+                    const uint64_t r{rng()};
+                    std::memcpy(&key.bytes[j], &r, sizeof(r));
+                }
+                if (i % 5 == 0) {
+                    key.bytes[0] = 0xab;  // Force long shared paths
+                    key.bytes[1] = 0xcd;
+                }
+                Bytes value;
+                rlp::encode(value, rng());
+                trie.put(key, value);
+                expected[key] = value;
+                keys.push_back(key);
+            }
+            // Overwrite some and delete some
+            for (size_t i{0}; i < 10; ++i) {
+                const auto& key{keys[rng() % keys.size()]};
+                Bytes value;
+                rlp::encode(value, rng());
+                trie.put(key, value);
+                expected[key] = value;
+            }
+            for (size_t i{0}; i < 15; ++i) {
+                const auto key{keys[rng() % keys.size()]};
+                trie.erase(key);
+                expected.erase(key);
+            }
+            REQUIRE(trie.size() == expected.size());
+            REQUIRE(to_hex(trie.root_hash()) == to_hex(full_root(expected)));
+        }
+
+        // Deleting everything gives the empty trie back
+        for (const auto& key : keys) {
+            trie.erase(key);
+        }
+        CHECK(trie.empty());
+        CHECK(trie.root_hash() == kEmptyRoot);
+    }
+}
+
+TEST_CASE("IncrementalStateRoot") {
+    const auto address_a{0x71562b71999873db5b286df957af199ec94617f7_address};
+    const auto address_b{0xa94f5374fce5edbac8d8c9e0d6d2d88e1c4ba55e_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x0000000000000000000000000000000000000000000000000000000000000111_bytes32};
+
+    IncrementalStateRoot state_root;
+    CHECK(state_root.root_hash() == kEmptyRoot);
+
+    Account account_a;
+    account_a.balance = 1'000'000;
+    Account account_b;
+    account_b.incarnation = 1;
+    state_root.update_account(address_a, account_a);
+    state_root.update_account(address_b, account_b);
+    state_root.update_storage(address_b, 1, location, value);
+
+    Bytes storage_value;
+    rlp::encode(storage_value, zeroless_view(value));
+    const evmc::bytes32 storage_root{full_root({{to_bytes32(keccak256(location).bytes), storage_value}})};
+    const evmc::bytes32 expected{full_root({{to_bytes32(keccak256(address_a).bytes), account_a.rlp(kEmptyRoot)},
+                                            {to_bytes32(keccak256(address_b).bytes), account_b.rlp(storage_root)}})};
+    CHECK(to_hex(state_root.root_hash()) == to_hex(expected));
+    CHECK(state_root.number_of_accounts() == 2);
+
+    // A new incarnation starts with empty storage
+    account_b.incarnation = 2;
+    state_root.update_account(address_b, account_b);
+    const evmc::bytes32 expected_recreated{
+        full_root({{to_bytes32(keccak256(address_a).bytes), account_a.rlp(kEmptyRoot)},
+                   {to_bytes32(keccak256(address_b).bytes), account_b.rlp(kEmptyRoot)}})};
+    CHECK(to_hex(state_root.root_hash()) == to_hex(expected_recreated));
+
+    // Clearing the storage slot of the previous incarnation
+    state_root.update_storage(address_b, 1, location, evmc::bytes32{});
+    CHECK(to_hex(state_root.root_hash()) == to_hex(expected_recreated));
+
+    state_root.update_account(address_a, std::nullopt);
+    state_root.update_account(address_b, std::nullopt);
+    CHECK(state_root.root_hash() == kEmptyRoot);
+}
+
+}  // namespace silkworm::trie
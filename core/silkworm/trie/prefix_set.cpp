@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <cassert>
 
+#include <silkworm/common/assert.hpp>
 #include <silkworm/common/util.hpp>
 
 namespace silkworm::trie {
@@ -60,4 +61,44 @@ bool PrefixSet::contains(ByteView prefix) {
     }
 }
 
+FrozenPrefixSet PrefixSet::freeze() const { return FrozenPrefixSet{keys_}; }
+
+FrozenPrefixSet::FrozenPrefixSet(std::vector<Bytes> keys) {
+    if (keys.empty()) {
+        return;
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    size_t total_length{0};
+    for (const auto& key : keys) {
+        total_length += key.length();
+    }
+    SILKWORM_ASSERT(total_length <= UINT32_MAX);
+    data_.reserve(total_length);
+    offsets_.reserve(keys.size() + 1);
+    for (const auto& key : keys) {
+        offsets_.push_back(static_cast<uint32_t>(data_.length()));
+        data_.append(key);
+    }
+    offsets_.push_back(static_cast<uint32_t>(data_.length()));
+}
+
+bool FrozenPrefixSet::contains(ByteView prefix) const noexcept {
+    // Keys starting with prefix are not less than prefix and come first among those that are not:
+    // the smallest key not less than prefix is the only candidate
+    size_t first{0};
+    size_t count{size()};
+    while (count > 0) {
+        const size_t step{count / 2};
+        if (key(first + step) < prefix) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first < size() && key(first).starts_with(prefix);
+}
+
 }  // namespace silkworm::trie
@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include <silkworm/common/base.hpp>
 
 namespace silkworm::trie {
 
+class FrozenPrefixSet;
+
 /// A set of byte strings with the following property:
 /// If x ∈ S and x starts with y, then y ∈ S.
 /// Corresponds to RetainList in Erigon.
@@ -39,10 +42,38 @@ class PrefixSet {
     // Doesn't change the set logically, but is not marked const since it's not safe to call this method concurrently.
     bool contains(ByteView prefix);
 
+    // Immutable copy of this set for lookups in any order, possibly concurrent
+    [[nodiscard]] FrozenPrefixSet freeze() const;
+
   private:
     std::vector<Bytes> keys_;
     bool sorted_{false};
     size_t index_{0};
 };
 
+/// An immutable PrefixSet: contains() may be called in any order and from many threads at the same time.
+/// Keys are sorted and stored back to back in a single buffer, hence each costs its length plus an offset
+/// instead of a heap allocation.
+class FrozenPrefixSet {
+  public:
+    /// Constructs an empty set.
+    FrozenPrefixSet() = default;
+
+    // duplicates are dropped
+    explicit FrozenPrefixSet(std::vector<Bytes> keys);
+
+    [[nodiscard]] bool contains(ByteView prefix) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  private:
+    [[nodiscard]] ByteView key(size_t i) const noexcept {
+        return ByteView{data_}.substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    Bytes data_;                     // Sorted keys, back to back
+    std::vector<uint32_t> offsets_;  // Key i spans [offsets_[i], offsets_[i + 1]) of data_
+};
+
 }  // namespace silkworm::trie
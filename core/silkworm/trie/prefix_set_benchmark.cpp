@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <algorithm>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/trie/hash_builder.hpp>
+#include <silkworm/trie/prefix_set.hpp>
+
+namespace silkworm::trie {
+
+// Changed keys as collected during execution, then walked in order by the trie loader
+static std::vector<Bytes> random_unpacked_keys(size_t count) {
+    std::mt19937_64 rng{42};
+    std::vector<Bytes> keys(count);
+    for (Bytes& key : keys) {
+        Bytes packed(kHashLength, '\0');
+        for (auto& b : packed) {
+            b = static_cast<uint8_t>(rng());
+        }
+        key = unpack_nibbles(packed);
+    }
+    return keys;
+}
+
+static void BM_PrefixSet_InsertContains(benchmark::State& state) {
+    const std::vector<Bytes> keys{random_unpacked_keys(static_cast<size_t>(state.range(0)))};
+    std::vector<Bytes> prefixes{keys};
+    std::sort(prefixes.begin(), prefixes.end());
+    for (Bytes& prefix : prefixes) {
+        prefix.resize(4);
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        PrefixSet set;
+        for (const Bytes& key : keys) {
+            set.insert(key);
+        }
+        for (const Bytes& prefix : prefixes) {
+            benchmark::DoNotOptimize(set.contains(prefix));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+BENCHMARK(BM_PrefixSet_InsertContains)->Arg(1'000)->Arg(100'000);
+
+static void BM_FrozenPrefixSet_Contains(benchmark::State& state) {
+    const std::vector<Bytes> keys{random_unpacked_keys(static_cast<size_t>(state.range(0)))};
+    const FrozenPrefixSet set{keys};
+    const std::vector<Bytes> lookups{random_unpacked_keys(1'024)};
+
+    size_t i{0};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(set.contains(ByteView{lookups[i++ % lookups.size()]}.substr(0, 6)));
+    }
+}
+BENCHMARK(BM_FrozenPrefixSet_Contains)->Arg(1'000)->Arg(100'000);
+
+}  // namespace silkworm::trie
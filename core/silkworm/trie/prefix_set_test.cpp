@@ -46,4 +46,34 @@ TEST_CASE("Prefix set") {
     CHECK(!ps.contains(string_view_to_byte_view("yyz")));
 }
 
+TEST_CASE("Frozen prefix set") {
+    CHECK(!FrozenPrefixSet{}.contains(string_view_to_byte_view("")));
+
+    PrefixSet ps;
+    ps.insert(string_view_to_byte_view("abc"));
+    ps.insert(string_view_to_byte_view("fg"));
+    ps.insert(string_view_to_byte_view("abc"));  // duplicate
+    ps.insert(string_view_to_byte_view("ab"));
+
+    const FrozenPrefixSet frozen{ps.freeze()};
+    CHECK(frozen.size() == 3);
+
+    // Any order
+    CHECK(!frozen.contains(string_view_to_byte_view("yyz")));
+    CHECK(frozen.contains(string_view_to_byte_view("fg")));
+    CHECK(!frozen.contains(string_view_to_byte_view("aac")));
+    CHECK(frozen.contains(string_view_to_byte_view("")));
+    CHECK(!frozen.contains(string_view_to_byte_view("fgk")));
+    CHECK(frozen.contains(string_view_to_byte_view("abc")));
+    CHECK(!frozen.contains(string_view_to_byte_view("b")));
+    CHECK(frozen.contains(string_view_to_byte_view("a")));
+    CHECK(!frozen.contains(string_view_to_byte_view("abcd")));
+    CHECK(frozen.contains(string_view_to_byte_view("f")));
+    CHECK(!frozen.contains(string_view_to_byte_view("fy")));
+    CHECK(frozen.contains(string_view_to_byte_view("ab")));
+
+    // The original set is still usable
+    CHECK(ps.contains(string_view_to_byte_view("ab")));
+}
+
 }  // namespace silkworm::trie
@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
+#include <silkworm/common/parallel_for.hpp>
+#include <silkworm/common/util.hpp>
 #include <silkworm/rlp/encode.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 
@@ -55,4 +60,49 @@ evmc::bytes32 root_hash(const std::vector<Value>& v, Encoder value_encoder) {
     return hb.root_hash();
 }
 
+// Number of values from which parallel_root_hash pays for its threads
+inline constexpr size_t kParallelRootHashThreshold{1'024};
+
+// Same as root_hash, with the values RLP-encoded and their leaf nodes hashed on up to num_threads threads;
+// only the assembly of the trie is sequential. Worthwhile for thousands of values.
+template <class Value, typename Encoder>
+evmc::bytes32 parallel_root_hash(const std::vector<Value>& v, Encoder value_encoder, size_t num_threads) {
+    static constexpr size_t kLeavesPerTask{64};
+
+    // Keys in trie order
+    std::vector<Bytes> keys(v.size());
+    Bytes index_rlp;
+    for (size_t j{0}; j < v.size(); ++j) {
+        index_rlp.clear();
+        rlp::encode(index_rlp, adjust_index_for_rlp(j, v.size()));
+        keys[j] = unpack_nibbles(index_rlp);
+    }
+
+    // A leaf hangs just below the deepest branch node it shares with its neighbours
+    std::vector<HashBuilder::NodeRef> leaves(v.size());
+    const size_t num_tasks{(v.size() + kLeavesPerTask - 1) / kLeavesPerTask};
+    parallel_for(num_tasks, num_threads, [&](size_t task) {
+        Bytes value_rlp;
+        Bytes rlp_buffer;
+        const size_t end{std::min(v.size(), (task + 1) * kLeavesPerTask)};
+        for (size_t j{task * kLeavesPerTask}; j < end; ++j) {
+            size_t depth{0};
+            if (v.size() > 1) {
+                const size_t preceding_len{j > 0 ? prefix_length(keys[j - 1], keys[j]) : 0};
+                const size_t succeeding_len{j + 1 < v.size() ? prefix_length(keys[j], keys[j + 1]) : 0};
+                depth = std::max(preceding_len, succeeding_len) + 1;
+            }
+            value_rlp.clear();
+            value_encoder(value_rlp, v[adjust_index_for_rlp(j, v.size())]);
+            leaves[j] = HashBuilder::leaf_node_ref(ByteView{keys[j]}.substr(depth), value_rlp, rlp_buffer);
+        }
+    });
+
+    HashBuilder hb;
+    for (size_t j{0}; j < v.size(); ++j) {
+        hb.add_leaf_node_ref(keys[j], leaves[j]);
+    }
+    return hb.root_hash();
+}
+
 }  // namespace silkworm::trie
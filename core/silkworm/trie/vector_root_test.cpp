@@ -53,4 +53,18 @@ TEST_CASE("Hardcoded root hash") {
     CHECK(to_hex(root_hash(receipts, kEncoder)) == "7ea023138ee7d80db04eeec9cf436dc35806b00cc5fe8e5f611fb7cf1b35b177");
 }
 
+TEST_CASE("Parallel root hash") {
+    // Short values are embedded in their parent nodes, long ones are hashed
+    static constexpr auto kEncoder = [](Bytes& to, const Bytes& value) { rlp::encode(to, value); };
+    for (size_t value_length : {1, 40}) {
+        for (size_t size : {0, 1, 2, 16, 127, 128, 129, 300}) {
+            std::vector<Bytes> values(size);
+            for (size_t i{0}; i < size; ++i) {
+                values[i] = Bytes(value_length, static_cast<uint8_t>(i));
+            }
+            CHECK(parallel_root_hash(values, kEncoder, /*num_threads=*/4) == root_hash(values, kEncoder));
+        }
+    }
+}
+
 }  // namespace silkworm::trie
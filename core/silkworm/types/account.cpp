@@ -20,57 +20,59 @@
 
 namespace silkworm {
 
+// Appends a length prefixed compact field, out must have room for 1 + sizeof(T) bytes
+template <UnsignedIntegral T>
+static size_t encode_field_for_storage(uint8_t* out, const T& value) noexcept {
+    const size_t length{endian::store_big_compact(out + 1, value)};
+    out[0] = static_cast<uint8_t>(length);
+    return 1 + length;
+}
+
 Bytes Account::encode_for_storage(bool omit_code_hash) const {
-    Bytes res(1, '\0');
+    // Widest encoding: field set, then each field prefixed by its length
+    uint8_t encoded[1 + (1 + sizeof(nonce)) + (1 + sizeof(balance)) + (1 + sizeof(incarnation)) + (1 + kHashLength)];
     uint8_t field_set{0};
+    size_t pos{1};
 
     if (nonce != 0) {
         field_set |= 1;
-        auto be{endian::to_big_compact(nonce)};
-        res.push_back(static_cast<uint8_t>(be.length()));
-        res.append(be);
+        pos += encode_field_for_storage(&encoded[pos], nonce);
     }
 
     if (balance != 0) {
         field_set |= 2;
-        auto be{endian::to_big_compact(balance)};
-        res.push_back(static_cast<uint8_t>(be.length()));
-        res.append(be);
+        pos += encode_field_for_storage(&encoded[pos], balance);
     }
 
     if (incarnation != 0) {
         field_set |= 4;
-        auto be{endian::to_big_compact(incarnation)};
-        res.push_back(static_cast<uint8_t>(be.length()));
-        res.append(be);
+        pos += encode_field_for_storage(&encoded[pos], incarnation);
     }
 
     if (code_hash != kEmptyHash && !omit_code_hash) {
         field_set |= 8;
-        res.push_back(kHashLength);
-        res.append(code_hash.bytes, kHashLength);
+        encoded[pos++] = kHashLength;
+        std::memcpy(&encoded[pos], code_hash.bytes, kHashLength);
+        pos += kHashLength;
     }
 
-    res[0] = field_set;
-    return res;
+    encoded[0] = field_set;
+    return Bytes{encoded, pos};
 }
 
 size_t Account::encoding_length_for_storage() const {
     size_t len{1};
 
     if (nonce != 0) {
-        auto be{endian::to_big_compact(nonce)};
-        len += 1 + be.length();
+        len += 1 + intx::count_significant_bytes(nonce);
     }
 
     if (balance != 0) {
-        auto be{endian::to_big_compact(balance)};
-        len += 1 + be.length();
+        len += 1 + intx::count_significant_bytes(balance);
     }
 
     if (incarnation != 0) {
-        auto be{endian::to_big_compact(incarnation)};
-        len += 1 + be.length();
+        len += 1 + intx::count_significant_bytes(incarnation);
     }
 
     if (code_hash != kEmptyHash) {
@@ -108,6 +110,9 @@ std::pair<Account, DecodingResult> Account::from_encoded_storage(ByteView encode
     size_t pos{1};
     for (int i{1}; i < 16; i *= 2) {
         if (field_set & i) {
+            if (encoded_payload.length() <= pos) {
+                return {a, DecodingResult::kInputTooShort};
+            }
             uint8_t len = encoded_payload[pos++];
             if (encoded_payload.length() < pos + len) {
                 return {a, DecodingResult::kInputTooShort};
@@ -159,6 +164,9 @@ std::pair<uint64_t, DecodingResult> Account::incarnation_from_encoded_storage(By
     size_t pos{1};
     for (int i{1}; i < 8; i *= 2) {
         if (field_set & i) {
+            if (encoded_payload.length() <= pos) {
+                return {0, DecodingResult::kInputTooShort};
+            }
             uint8_t len = encoded_payload[pos++];
             if (encoded_payload.length() < pos + len) {
                 return {0, DecodingResult::kInputTooShort};
@@ -0,0 +1,60 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm {
+
+static Account sample_account(bool contract) {
+    Account account;
+    account.nonce = 3'125;
+    account.balance = intx::from_string<intx::uint256>("1234567890123456789012");
+    if (contract) {
+        account.code_hash = 0xf1885eda54b7a053318cd41e2093220dab15d65381b1157a3633a83bfd5c9239_bytes32;
+        account.incarnation = kDefaultIncarnation;
+    }
+    return account;
+}
+
+static void BM_Account_EncodeForStorage(benchmark::State& state) {
+    const Account account{sample_account(state.range(0) != 0)};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(account.encode_for_storage());
+    }
+}
+BENCHMARK(BM_Account_EncodeForStorage)->ArgName("contract")->Arg(0)->Arg(1);
+
+static void BM_Account_FromEncodedStorage(benchmark::State& state) {
+    const Bytes encoded{sample_account(state.range(0) != 0).encode_for_storage()};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(Account::from_encoded_storage(encoded));
+    }
+}
+BENCHMARK(BM_Account_FromEncodedStorage)->ArgName("contract")->Arg(0)->Arg(1);
+
+static void BM_Account_Rlp(benchmark::State& state) {
+    const Account account{sample_account(/*contract=*/true)};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(account.rlp(kEmptyRoot));
+    }
+}
+BENCHMARK(BM_Account_Rlp);
+
+}  // namespace silkworm
@@ -85,6 +85,12 @@ TEST_CASE("Decode account from storage") {
         REQUIRE(err == DecodingResult::kLeadingZero);
     }
 
+    SECTION("Missing field length") {
+        Bytes encoded{*from_hex("030105")};  // nonce then nothing for the balance
+        auto [decoded, err]{Account::from_encoded_storage(encoded)};
+        REQUIRE(err == DecodingResult::kInputTooShort);
+    }
+
     SECTION("Wrong code_hash payload") {
         Bytes encoded{*from_hex("0x0805c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a4")};
         auto [decoded, err]{Account::from_encoded_storage(encoded)};
@@ -92,4 +98,23 @@ TEST_CASE("Decode account from storage") {
     }
 }
 
+TEST_CASE("Encode account for storage") {
+    Account account;
+    CHECK(account.encode_for_storage() == *from_hex("00"));
+
+    account.nonce = 0x0102;
+    account.balance = intx::uint256{1} << 255;  // widest balance
+    account.incarnation = ~uint64_t{0};         // widest incarnation
+    account.code_hash = 0xf1885eda54b7a053318cd41e2093220dab15d65381b1157a3633a83bfd5c9239_bytes32;
+    const Bytes encoded{account.encode_for_storage()};
+    CHECK(encoded.length() == account.encoding_length_for_storage());
+    CHECK(to_hex(encoded.substr(0, 4)) == "0f020102");
+
+    auto [decoded, err]{Account::from_encoded_storage(encoded)};
+    REQUIRE(err == DecodingResult::kOk);
+    CHECK(decoded == account);
+
+    CHECK(account.encode_for_storage(/*omit_code_hash=*/true).length() == encoded.length() - 1 - kHashLength);
+}
+
 }  // namespace silkworm
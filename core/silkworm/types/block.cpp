@@ -69,13 +69,12 @@ namespace rlp {
         return rlp_head;
     }
 
-    size_t length(const BlockHeader& header) {
-        Header rlp_head{rlp_header(header)};
-        return length_of_length(rlp_head.payload_length) + rlp_head.payload_length;
-    }
+    size_t length(const BlockHeader& header) { return item_length(rlp_header(header)); }
 
     void encode(Bytes& to, const BlockHeader& header, bool for_sealing) {
-        encode_header(to, rlp_header(header, for_sealing));
+        const Header rlp_head{rlp_header(header, for_sealing)};
+        to.reserve(to.size() + item_length(rlp_head));
+        encode_header(to, rlp_head);
         encode(to, header.parent_hash.bytes);
         encode(to, header.ommers_hash.bytes);
         encode(to, header.beneficiary.bytes);
@@ -176,12 +175,14 @@ namespace rlp {
     }
 
     void encode(Bytes& to, const BlockBody& block_body) {
-        Header rlp_head{true, 0};
-        rlp_head.payload_length += length(block_body.transactions);
-        rlp_head.payload_length += length(block_body.ommers);
+        // Lists are measured once and the whole body is written into a single reservation
+        const Header transactions_head{detail::rlp_header(block_body.transactions)};
+        const Header ommers_head{detail::rlp_header(block_body.ommers)};
+        const Header rlp_head{true, item_length(transactions_head) + item_length(ommers_head)};
+        to.reserve(to.size() + item_length(rlp_head));
         encode_header(to, rlp_head);
-        encode(to, block_body.transactions);
-        encode(to, block_body.ommers);
+        detail::encode_list(to, transactions_head, block_body.transactions);
+        detail::encode_list(to, ommers_head, block_body.ommers);
     }
 
     template <>
@@ -239,14 +240,15 @@ namespace rlp {
     }
 
     void encode(Bytes& to, const Block& block) {
-        Header rlp_head{true, 0};
-        rlp_head.payload_length += length(block.header);
-        rlp_head.payload_length += length(block.transactions);
-        rlp_head.payload_length += length(block.ommers);
+        // Lists are measured once and the whole block is written into a single reservation
+        const Header transactions_head{detail::rlp_header(block.transactions)};
+        const Header ommers_head{detail::rlp_header(block.ommers)};
+        const Header rlp_head{true, length(block.header) + item_length(transactions_head) + item_length(ommers_head)};
+        to.reserve(to.size() + item_length(rlp_head));
         encode_header(to, rlp_head);
         encode(to, block.header);
-        encode(to, block.transactions);
-        encode(to, block.ommers);
+        detail::encode_list(to, transactions_head, block.transactions);
+        detail::encode_list(to, ommers_head, block.ommers);
     }
 
 }  // namespace rlp
@@ -0,0 +1,832 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <cstdlib>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/vector_root.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm {
+
+// Mainnet block 12593055 (149 transactions), as received in a NewBlock packet
+// (split in two literals to stay within compiler limits)
+static const char* kBlock12593055Part1 =
+    "f9a137f9020da002da05e7a22eb312ed3b9229658b11a6d3eb4d778ebeb0e7c1ed62c45d71f459a01dcc4de8dec75d7aab85b567b6ccd4"
+    "1ad312451b948a7413f0a142fd40d493479404668ec2f57cc15c381b461b9fedab5d451c8f7fa075a55d654f81008c90e78d280378ce17"
+    "055b7c4a71eb008a2a457259376c3cc0a0f6179ced1e84f54e28f28475b7b0c72b9dce48392aa3dc0c50b17ec59fc8c7b2a09b1e119219"
+    "54c4cfeb7e057b4478acd1d29e0647dd02a834abd9e6e3b26a95e4b901001aa22c2725a26bf1018634bcc0001610a888e130d20f045550"
+    "89303a8d4108139b15500304a9059074ab3b02c70061131f6d913be812642107ea08421e34a3247a116036c508a1a9091c43491e7269b0"
+    "00670d24c1c24085709128468a602302781440eda323a8a193487818418069ce749188d18c0325c146303493251b00ad4a6dc7c50a53b9"
+    "381659004a2f3a1c16caf15ccdc51470188c714445a292d4a02b99c08051d1a0400cfaee9e000018849d2009447aaf406841282e22388a"
+    "d81f4c3cee0e2b23c073603d9eb38a094605ab6412910c2b24176801a08201a0e344c1186010d8824b849d093d0ae1248a063407553065"
+    "a411d0651c8d8850b15951871b589c89edcbab83c0279f83e3a78a83e37c718460bf39208c7370696465723239151454f7a0b6079798db"
+    "6beacdea14b1fac863ad6cd9b2d077f35cd05a987b66f9664b39228843bfd8c3836af356f99f23f9016b6e85059682f0008302738994d9"
+    "e1ce17f2641f24ae83637ab66a2cca9c378b9f80b901044a25d94a0000000000000000000000000000000000000000000000001bc16d67"
+    "4ec800000000000000000000000000000000000000000000000000c0adcef4aaa4d92c9400000000000000000000000000000000000000"
+    "000000000000000000000000a00000000000000000000000001aae1bc09e1785c8cb00650db0c6015bd73b0c7e00000000000000000000"
+    "00000000000000000000000000000000000060bf3d96000000000000000000000000000000000000000000000000000000000000000200"
+    "00000000000000000000007d1afa7b718fb893db30a3abc0cfc608aacfebb0000000000000000000000000c02aaa39b223fe8d0a0e5c4f"
+    "27ead9083c756cc226a034a461a43135ab229b9e4e9d844f935a5aa97edaa8d3f1dd3b8ca01a72d158cea021747d5cb8281225686fc3c6"
+    "2142ec67792f3702ea2ba09980d3591d738b1cd2f9034c82049d808305543d9400000000000080c886232e9b7ebbfb942b5987aa80b902"
+    "e8000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000"
+    "0000000000000000f7860000000000000000000000000000000000b3f879cb30fe243b4dfee438691c0400000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000002400000000"
+    "0000000000000000000000000000000000000000000000000000256c00000000000000000000000094e10946570808e40fa86a4bdcbfce"
+    "233ddfae39000000000000000000000000000000000000000000000000003f0f731b0f28d8000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000037b68000000000000000000"
+    "000000819f3450da6f110ba6ea52195b3beafa246062de0000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000001246366b93600000000000000000000000000000000000000"
+    "00000000000000000000000004022c0d9f0000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000014eb16171a4ae9a9000000000000000000000000fbc312fa3b5be4e7631db2901ae7e0e79a"
+    "764c9b00000000000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000"
+    "000000000000000000000080000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000"
+    "000000000000000000000000000044e92fb4d4ba2f0000000000000000000000007f8f7dd53d1f3ac1052565e3ff451d7fe666a3110000"
+    "0000000000000000000000000000000000000000008e61861432408ff58126a0f11f4bd499a8abae89cc8a6fd9cb1c20f8b233e28127d2"
+    "25a27fe2a90889329aa038ff14a956a9bc34b566086f27b4554ceb4714b4ecaaad787f2cffa386443ac7f901478241198083b71b009400"
+    "000000003b3cc22af3ae1eac0440bcee416b4080b8e41c25f691000000000000000000000000389999216860ab8e0175387a0c90e5c525"
+    "22c945000000000000000000000000854373387e41371ac6e307a1f29603c6fa10d8720000000000000000000000000000000000000000"
+    "000000021d3bd55e803c00000000000000000000000000000000000000000000000002a4c7b7df40d765b0590000000000000000000000"
+    "000000000000000000000000000000000000c0279f00000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000025a0b269e96732e36beaff3b4d04f9e756e4718237ca5e1de9"
+    "50d5000a7ee4f5cd24a02ce80c6999d9b3d33c3343f048455ccf2eb9032bf411c99334fcdce8743e00bbf9018b5c8503b9aca0008303c6"
+    "e0947a250d5630b4cf539739df2c5dacb4c659f2488d80b9012438ed173900000000000000000000000000000000000000000000000000"
+    "000012b1a82c800000000000000000000000000000000000000000000001e3b3ace9974c7d9eb600000000000000000000000000000000"
+    "000000000000000000000000000000a0000000000000000000000000ce38000e4feeff573009b5772eb2f046e52ec6ae00000000000000"
+    "00000000000000000000000000000000000000000060bf3c5b000000000000000000000000000000000000000000000000000000000000"
+    "0003000000000000000000000000dac17f958d2ee523a2206206994597c13d831ec7000000000000000000000000c02aaa39b223fe8d0a"
+    "0e5c4f27ead9083c756cc2000000000000000000000000389999216860ab8e0175387a0c90e5c52522c94526a0917faa06e871cd2d7f00"
+    "c20b054a2882a2c8c2f8da49315483ef1defc315a35ba03451379ba41277c4955d39135f16b41a2532a7f91fa447207a6dbb16a254c7de"
+    "f9014e82411a8083b71b009400000000003b3cc22af3ae1eac0440bcee416b40873d59b4160bdd63b8e42331b6c5000000000000000000"
+    "000000389999216860ab8e0175387a0c90e5c52522c945000000000000000000000000854373387e41371ac6e307a1f29603c6fa10d872"
+    "0000000000000000000000000000000000000000000002973f5bcbf8c31443ad0000000000000000000000000000000000000000000000"
+    "021d821bdd9c2089790000000000000000000000000000000000000000000000000000000000c0279f0000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000026a0b02675"
+    "f02ad450704e2a186523e761223df90498219be7a4b203a770d40c3efea07f9aabe4b2edb6d19d1e9d78e374d3ee1ebc7055c570a9864d"
+    "3e8d067f6d71d2f905e882023680830f424094000000000000abe945c436595ce765a8a261317b80b90584000000000000000000000000"
+    "0020a3b9ac4e694300000000000000000000000000000a1000000000000000000000000000000000000000000000000000000000000000"
+    "4000000000000000000000000000000000000000000000000000000000000000290000000027128acb0800000088e6a0c2ddd26feeb64f"
+    "039a2c41296fcb3f5640000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000abe945c436595ce765a8a261317b000000000000000000000000000000000000000000000000000000000000000100000000"
+    "000000000000000000000000000000000000000000000007b79fa95e000000000000000000000000000000000000000000000000000000"
+    "01000276a400000000000000000000000000000000000000000000000000000000000000a0000000000000000000000000000000000000"
+    "00000000000000000000000004200000000000000000000000000000000000000000000000000000000000000020000000000000000000"
+    "000000000000000000000000000000000000000000001f000000001d128acb080000008c54aa2a32a779e6f6fbea568ad85a19e0109c26"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000088e6a0c2ddd26feeb64f03"
+    "9a2c41296fcb3f564000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+    "000000000000000007115a385c758a815af700000000000000000000000000000000000000000000000000000001000276a40000000000"
+    "0000000000000000000000000000000000000000000000000000a000000000000000000000000000000000000000000000000000000000"
+    "000002e0000000000000000000000000000000000000000000000000000000000000002000000000000000000000000000000000000000"
+    "00000000000000000000000015000000000c128acb08000000f87bb87fd9ea1c260ddf77b9c707ad9437ff836400000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000009928e4046d7c6513326ccea028cd3e7a91c7590a00"
+    "00000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000"
+    "b7e174cc69ed000000000000000000000000000000000000000000000000000000000001000276a4000000000000000000000000000000"
+    "00000000000000000000000000000000a000000000000000000000000000000000000000000000000000000000000000c0000000000000"
+    "00000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000"
+    "0000040000000002a9059cbb000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000f87bb87fd9ea1c260ddf77b9c707ad9437ff83640000000000000000000000"
+    "00000000000000000000000000b7e174cc69ed00000000000005022c0d9f0000009928e4046d7c6513326ccea028cd3e7a91c7590a0000"
+    "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000007115a"
+    "385c758a815af700000000000000000000000000000000000000000000000000000000000000000000000000000000000000008c54aa2a"
+    "32a779e6f6fbea568ad85a19e0109c26000000000000000000000000000000000000000000000000000000000000008000000000000000"
+    "000000000000000000000000000000000000000000000000001ba0c481a953e7d78770db329fa902a33866ea74354450ea5bb83d30cb85"
+    "3ccf9225a05630677fe40f3e3ecf29f9a83f63eb614a19ddab8b0581fa6df6084cd0e0ad07f8ad8303b07b85174876e800830668a0946c"
+    "222ede5cabb355f676cb9f237932502682fbd080b844a9059cbb0000000000000000000000008dcb282f28346fdf800733d0857e71ae8c"
+    "1032f70000000000000000000000000000000000000000000000878678326eac90000025a0b26920c9827e09efbbf98ecedc2b0b5e7d2e"
+    "f1fcc03562e62713041b0fb8eb68a02e22318d56f09bc200b06f4b592feadb6f70cc9fbb6b346fc0d4874c94682de9f8708305a7218512"
+    "64c45600830186a0944e2c3a30aa950f7553e32313b011718822dfb50b883d7a858762fb00008025a0fd9421301fc8290907071e223d5e"
+    "68161b5bad61effd8f2b2b7f0cb2c575b13ca04f47fc6d362ab962d934201a3d4af5d18e72f0986606769fba799e1a4d269642f8aa0485"
+    "1176592e008301725d94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000000000000084d717c1a207"
+    "03f6accd7e51ff64a3216086c63d000000000000000000000000000000000000000000000000000000000621061f26a057b7ad64e244ff"
+    "018aacf3012ca97526439de8bfdcd5dad3f560cb6e3909c23ea04327697d24b5fbdbb4008a33b3ccc9188bb8d5ccfa6fe94a5424b11e73"
+    "873459f8aa06851176592e0083010e2b94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb0000000000000000000000"
+    "00fd579a2beea0fa8547ef9feb53fa5ffcca90d8a3000000000000000000000000000000000000000000000000000000000b9f76c026a0"
+    "ebfc11aaeba712ea0c3af5c73b388f1ce6a8c8095369bc6066afa3c907e61160a01139fc8f0e880f463cba4e4e77fe6dd2742a54a81788"
+    "faa02b2e30af76e08d8cf8aa0a851176592e008301725d94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000"
+    "000000000000000084d717c1a20703f6accd7e51ff64a3216086c63d000000000000000000000000000000000000000000000000000000"
+    "0004013bc326a032b8610770dcccaa04117dcb9148b673b5c57a0e92b30f40c51b6f7a93b8777fa03f719516d574273c4d2781a830572c"
+    "5156fb178ccc073401eb90c17fe5da1522f8aa06851176592e0083010e2b94dac17f958d2ee523a2206206994597c13d831ec780b844a9"
+    "059cbb000000000000000000000000fd579a2beea0fa8547ef9feb53fa5ffcca90d8a30000000000000000000000000000000000000000"
+    "00000000000000000b9f76c026a0f03e41014eef2a88399888d453d84e61093752c799ef9beddfec35b5f973455ca03d895e76b975d9a3"
+    "c442352d7e114f5c66656a159b4f29a39188073b178b54b9f86d82403a850df84758008252089491960757483df4b1a4a9899801803224"
+    "d3b8b7bf8709d42749f4f800801ba097db60f57781b9ebabb747fb8019828ae3ab5f6c014ab2adf01efecda78777a6a01a113db18a9616"
+    "50ccb43e489e698f557c38a34044d381753c5523e1a161a2b5f8ad8302f3c0850df8475800830493e094dac17f958d2ee523a220620699"
+    "4597c13d831ec780b844a9059cbb0000000000000000000000007a0a7e914fb5b8dc9afad06ede881eb9f2b08252000000000000000000"
+    "000000000000000000000000000000000000037e11d60025a08423c36f952b40d3919d6e1f5f924c4e1052ae4c589427d32596862ad3ae"
+    "814ba026da461609a86bbc67046e2977269cb3b5aaa5aa72539721579b7421eaa32596f86d82403b850df84758008252089405ed733249"
+    "9f7b5b0691e08b91bebf2ce8d7eb468709d42749f4f800801ca03fe8e07d03a401b752323efd7f7c3a2057d41d5eaba64678691fb0c616"
+    "2724a0a007919e09e619bab6733ea74e1b377e9349bd88461cd17de71ca53934ed925257f86f828bf38509502f900083019a2894bf668a"
+    "25eb8f29e186fca48c401bb33753c7392388d02ab486cedc00008026a0af04fa11c5719377e895079a0cf3937019b82e144845e3da33e5"
+    "969d5137ead9a06bb372b9551a29dda1ddb03cc63c65208d5b69db5dded5ee72345e48ec3f0b4ef8ad8311aaeb850737be76008301fde8"
+    "946226e00bcac68b0fe55583b90a1d727c14fab77f80b844a9059cbb000000000000000000000000bb8dd2bf40c1428ddaa8641ded7396"
+    "7e50093f410000000000000000000000000000000000000000000020cd84c1a9253be0400026a00f9b9788d89bd0a6e23874f9350c30e0"
+    "dcfc10fe3edb979c850810380ad19cd6a04487d5993e23dd807df330cc5260116d3d9abfd54fe86fd98d3f540bdff915eaf8ad8311aaec"
+    "85077359400083019a2894474021845c4643113458ea4414bdb7fb74a01a7780b844a9059cbb000000000000000000000000dae070c037"
+    "af4354ee50c495e36bfc305143abbe00000000000000000000000000000000000000000000010228c1b66665f4000026a02da7d81208b0"
+    "799ff6cd2da8090171fcf64c4b141ac97eebd79749c81aa41ceea0488e4d85e26f3c27216c580f434fe24f144e40aaa67218e55525577d"
+    "8b6c0513f9038e830122d185071fe6f2008313d620948eca806aecc86ce90da803b080ca4e3a9b8097ad80b903244e913cd90000000000"
+    "00000000000000000000000000000000000000000000000001701800000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000000000c000000000000000000000000000000000000000"
+    "0000000000000000000000010000000000000000000000000000000000000000000000000000000000000002e000000000000000000000"
+    "0000000000000000000000000000000000000000030000000000000000000000000000000000000000000000000000000000000000010e"
+    "42c49023ff0707f8c58636fa1c5a164679fe2647b0bdca2641367d0b045098000000000000000000000000000000000000000000000000"
+    "00000000000001b00b00014b3c00014b3c0000002c0019001d1d6ecb758a0022c337a00000000000000000000b00014b3c00014b3c0001"
+    "4ab200260001b8d3c9ae2eac47f643e90000000000000000000b00014b3c00014b3c0000000f0005001d295b8d8309006cc51320000000"
+    "0000000000000b00014b3c00014b3c000000060003001d00092dda600bc5adc0800000000000000000000b00014b3c00014b3c00014ab2"
+    "00260001b8f5f1784eac283a3ec90000000000000000000b00014b3c00014b3c000000260014001daab221c9060090292de00000000000"
+    "000000000b000146f9000146f9000000050000001d2898b839680a20c079a00000000000000000000b00014b3c00014b3c000000110007"
+    "001d42d472c0e90036d85a0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000026a07c055b63aa9d8778d75e7f31929e549c1ee44b0973fe1a21aeaa4368"
+    "1c4d9833a07678074bcdfceabf5b2bcd09aa2a33ae4a16629de4ef2544077be61f534a0996f86c808506fc23ac0082520894100aceca80"
+    "c6384636cbd81428ce85f588da38e5880dde79b8592ea0008026a07c0ec6e4a4650579273c6c9811a7acd9d4a1296ecdd865f8d7d4375b"
+    "996fa995a045fd01528db85c7ca7aca7e6ca2308fb77e52d67e554fb8a4d10185312ba856ff864768506fc23ac00825208948b6adc98d2"
+    "9e9f20abaf5b234e5fb712072c15ab808026a0e59d53c9f3d5aef9d8fe53dbe37f24d8752f1ce49e6fcf79adc5bf7db3471edca00ae5e8"
+    "3e9cc62e1942fc0ed3c7c171a237157464f4b75e2e96acb8c7d2c133fff86d821db28506c088e20082520894ad998c49bdd11681d25c65"
+    "f4147937424bb8f0da870945c7fadd20008025a04bdcd4517334de6324e59e233032d430c4d7f6234404ac4bcc758464b1227d88a01f1f"
+    "6ff7904e9517c543df09a3f4058bc4ca757ebfa44a4c401d727c359afd53f86c8245cc850684ee180082753094bed2dc22549d8c3ec1d3"
+    "88496a0c7d2d885fed8f8699c59bb5f4008025a0f8e4a5a54f58f7dcca503a09c1a6ad1e8b5a329e5a09dfdf12235746273dfb13a008a0"
+    "388f436963bdb6a88e7b4d227010b2b6c6669d440390f45aed2534747eccf8aa80850684ee180083015f90943242aebcdcf8de491004b1"
+    "c98e6595e9827f6c1780b844a9059cbb000000000000000000000000000143860260217df44ce56d20ad92561dc5a12000000000000000"
+    "000000000000000000000000000000000ad78ebc5ac620000026a034d88b5de8450822f51b63d8321d8482bb46d3b90abc4dd073f662c1"
+    "6a604cdaa012b2caf88a7341c4a5d7c78e73dd50311eb3c0a595b519461696bb0bfa1ddc06f86c80850684ee180082520894f2750ead88"
+    "16cba74f8c9ab84b8cee67a17723488806d34468844640008025a0d7e4612d91302f2045a5d308171c509103bfa0db3b37715083584c4c"
+    "dfb30df7a00b46d47d1d0cb19c2e6f85e344169a20f1b4140a097ec9e00e7b1dbe3b1ec825f9054d82298e850684ee18008307a120943d"
+    "0bb55d0d2f255d7a0eab8a53a91b3369728e3680b904e4c980753900000000000000000000000000000000000000000000000000000000"
+    "00000080000000000000000000000000000000000000000000000000000000000000032000000000000000000000000000000000000000"
+    "00000000000000000000000400000001010101000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000028000000000000000000000003be97243ef5328ce601df68241bcea460000c7a10507"
+    "0c010f06040e0b00090d020a08030500000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000600000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000"
+    "0000000000000000000000000002b916860000000000000000000000000000000000000000000000000000000002b9f54c000000000000"
+    "0000000000000000000000000000000000000000000002b9f54c0000000000000000000000000000000000000000000000000000000002"
+    "ba56510000000000000000000000000000000000000000000000000000000002ba56510000000000000000000000000000000000000000"
+    "000000000000000002bafb290000000000000000000000000000000000000000000000000000000002bb05890000000000000000000000"
+    "000000000000000000000000000000000002bb29af0000000000000000000000000000000000000000000000000000000002bb69680000"
+    "000000000000000000000000000000000000000000000000000002bca2b300000000000000000000000000000000000000000000000000"
+    "00000002bca2b30000000000000000000000000000000000000000000000000000000002bca2b300000000000000000000000000000000"
+    "00000000000000000000000002bcf3a70000000000000000000000000000000000000000000000000000000002be7eac00000000000000"
+    "00000000000000000000000000000000000000000002be84240000000000000000000000000000000000000000000000000000000002c0"
+    "572a0000000000000000000000000000000000000000000000000000000000000006c6ba53c0bf9ef4f37d38278b8c927640807facd749"
+    "0272ae75637ee7a2ad9fbd077790507a8089ccc31e7cc72ea5eb1cd99a02732bfc8ad14bc76d3b95c198ca83a55addc8026b62ec14ea10"
+    "8d57008b137d7698c591399e5632abde70495f5165d782ee8d3444c9d0ba0cfe281defe09c2e7a173fa01fa02d043c0ea0034ef4f3b133"
+    "075a095fb45cc16cb8894f42bed868270188383e212b18750ffa37a5d159818c3acccd5374859d615d9c61aec1ee87caaff0e07164cd68"
+    "aacc9bf6cfaa00000000000000000000000000000000000000000000000000000000000000065c5e4c66356a4e190a1fdd02bc887d34a8"
+    "ad7183e92756ed79c775818727cfce464b7a57744b2e2a9e4ba26d17bef1538442cd6a54dfe65a23bbdbb68f3470e912058dce25e0fd08"
+    "9a1557b12666f463f0b839bee153ca6be5e6af6f156138b73b56220488b0c2866753b151e23ba8c9be1ee436f181e8ce273b1f26807af5"
+    "157dcf19bab449f06081263c5163293ecefbd8c50a17313cca3bbe96f41ac3c6207b71295769a6aa0343cba290af78cbd598a12a5ae993"
+    "7a0c8d5662fb81a32c0e26a01be578b9dd686ab210c74ea37e42801f4f4b055796d8e56970539cc7e8b1b3fea0134375a6b11dbe1a6077"
+    "748b5b18365b60040eb0d9bdeb1482ecae4241b536a7f9015381e1850649534e0083039c75947a250d5630b4cf539739df2c5dacb4c659"
+    "f2488d88016345785d8a0000b8e47ff36ab50000000000000000000000000000000000000000fc5c358bbda935d7fc771f420000000000"
+    "000000000000000000000000000000000000000000000000000080000000000000000000000000edaad0b06f28ebed2a2bc36434b98b6d"
+    "9933421b0000000000000000000000000000000000000000000000000000000060bf3dc100000000000000000000000000000000000000"
+    "00000000000000000000000002000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc200000000000000000000"
+    "0000387c291bc3274389054e82ce81dd318a0113caf525a0df7aeec8bcba43891e7fe0045be70f2bf2eb84ea608916086350ab43cee350"
+    "cba04ef3e935c8cd7d585d2d74b436d792e62bf40035595bf5b926becbfc08641ff2f9016d821fb9850649534e0083024ff694d9e1ce17"
+    "f2641f24ae83637ab66a2cca9c378b9f80b9010418cbafe5000000000000000000000000000000000000000000023981b4f1427b3ac32e"
+    "df0000000000000000000000000000000000000000000000000dfbfb5423f2bdcf00000000000000000000000000000000000000000000"
+    "000000000000000000a000000000000000000000000050664ede715e131f584d3e7eaabd7818bb20a06800000000000000000000000000"
+    "00000000000000000000000000000060bf3d59000000000000000000000000000000000000000000000000000000000000000200000000"
+    "0000000000000000090185f2135308bad17527004364ebcc2d37e5f6000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9"
+    "083c756cc225a0a2dd8d5b4544154c8d7c2d0b517d425f8b4612609b29a7f8301b7ad5518b635ba03914779d686e3e543379b0c4d8e62a"
+    "c6a9a4b39d9c51564af63e3fd7b8aae047f9016b0c850649534e008302e22c947a250d5630b4cf539739df2c5dacb4c659f2488d80b901"
+    "04791ac9470000000000000000000000000000000000000000000000000000000003e0d763000000000000000000000000000000000000"
+    "00000000000001aa96160c0564c700000000000000000000000000000000000000000000000000000000000000a0000000000000000000"
+    "0000008df7c2b57d5d3f251b7914b79dc843be6752ae6c0000000000000000000000000000000000000000000000000000000060bf3a12"
+    "0000000000000000000000000000000000000000000000000000000000000002000000000000000000000000f3a561e0f83814149992bc"
+    "dc2ad375acba84754e000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc226a07a4513c77fcb41a7fe825b12"
+    "612b15b1e6898f665716a4d8d5cb91f1780436c7a02da1ce22aded247f874ff2a2eaac6e05f6a48043de30d39ca6e520e414ec67f0f870"
+    "8301ec5685060db8840083015f909439358c05cff307f5dfd617e5e9c2deac97edaf4b880d3ce7f9876330008025a0bf27f79de2dd4550"
+    "ef347655094b8ae96457288c6449f6ff2fe941539074b332a0535c3089058be1da6c03930bafe62cc4d44bfce598c0fda7d38c84c05b45"
+    "7c08f8ad8319d7bf85060db8840083019a2894dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000"
+    "00000088276868564e56af968e8f3146977560e58ca59c0000000000000000000000000000000000000000000000000000000046edf580"
+    "26a019091869d137101e3404196be128719b2df595a24215a41292276982002259a4a06c8e08f0ebd56cc6a4f9787b831bdd113ba6e39d"
+    "4e3738b3bd6081f08f534fbaf86b0285060db8840082520894bc60c4fd44d1856017fe4009817f1cef5363ca05871c3627cdd3b6b98026"
+    "a0e193c55aecd92258925f1d57c548218832da63e78e6133a1e57ff1d41a82764ea02aae6c407c133a2d3491a8ab8a4f17b3cd71fcd05a"
+    "bccd8590f8691d5c767f82f9018c819885060db884008302a688941bd435f3c054b6e901b7b108a0ab7617c808677b80b901240863b7ac"
+    "000000000000000000000000c0aee478e3658e2610c5f7a4a2e1777ce9e4f2ace18a34eb0e04b04f7a0ac29a6e80748dca96319b42c54d"
+    "679cb821dca90c63030000000000000000000000000000000000000000000000000f494c58787e8e3d0000000000000000000000000000"
+    "0000000000000000000000ab1b65af7c583800000000000000000000000000000000000000000000000000000000000000c00000000000"
+    "00000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000"
+    "0000000200000000000000000000000044564d0bd94343f72e3c8a0d22308b7fa71db0bb000000000000000000000000eeeeeeeeeeeeee"
+    "eeeeeeeeeeeeeeeeeeeeeeeeee26a0b48c200c454ff9a125510ce26df5bff5d826f7dd1eb250d0b65d8e03e7ffbd04a00f92431a6d466f"
+    "49a5f50e180d62e4982267892055f16c91c75a311de2d02872f901538202f185060db884008303ea4f947a250d5630b4cf539739df2c5d"
+    "acb4c659f2488d87fecbc7a74442f8b8e4fb3bdb410000000000000000000000000000000000000000c85532aeb47f0ec0300000000000"
+    "00000000000000000000000000000000000000000000000000000000008000000000000000000000000054ec0f31378c8fef5abd9ff0be"
+    "137f5a1fe765ae0000000000000000000000000000000000000000000000000000000060bf3d5900000000000000000000000000000000"
+    "00000000000000000000000000000002000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc200000000000000"
+    "0000000000387c291bc3274389054e82ce81dd318a0113caf525a01590a5ae8c8acc1e1cdfcdddb5c067d6cc39b3d73a5eaeef57088992"
+    "15baa0bba023d73645575aee9ca8b12e23bc155d5939de7f96cb212887abb95295492a7e8df86f8302599a8505de097c0082520894b010"
+    "3c1ec463ef0110cc23a1f4fc6c32019ddbd98809d93e526b89d8008026a0f5892e0d7650e48bd633f5b7e733d80e5390a4cad9fe66aea1"
+    "67612d5b6d8f73a00f61e3b69ddff6b24f526541ce0375907e1a72d4a699fe52ea340cf97f979c17f8838244638505d21dba00830186a0"
+    "9463bfbb2fdf497b2ca99c38efbffd89337a2462e388078f3dc38b4b3c0094000000000000000000000000000000000000000025a08195"
+    "c6a20f745c6508e5b0188f60dd97d3d5367337f9dccfeda57f751ddae2f5a06d1a44eded9c2bb69883abd60140455a46553d36bf400e0f"
+    "38380e28baf0daa2f8892e8505d21dba0083030d4094ebc86fb12ab0ffac6cbcafce2f049bfe7efada0d80a41bf6ddae00000000000000"
+    "000000000000000000000000000000000a59d8e565eed5068025a00103372596d481f32952d732f3970de11bc6525be019528db2a8a2a7"
+    "4b3eab0ba014da08d2a68175b8077f52a190322abf409d39f82b4b117a40e44e61425e2f72f86c018505d21dba0082520894dc6d1f8b90"
+    "6a9e9c7ebb657c645a4779c94cad848801619e53b9a4efa08025a00678ca14da11068b73b4af5d8e7e581f3d6beffc0e5e785bef4c6d2f"
+    "d53e7535a03151462109b04fccdb09c2a6268b578cf37d2c38a4ecf2282f006d16d2f8ab09f9018d82033c8505d21dba00830362fb94d9"
+    "e1ce17f2641f24ae83637ab66a2cca9c378b9f80b9012438ed173900000000000000000000000000000000000000000000000000000002"
+    "8dbf3ee60000000000000000000000000000000000000000000001c5a60fe86cc1672bee00000000000000000000000000000000000000"
+    "000000000000000000000000a0000000000000000000000000d939fb3d761daec4ad40cfd801b8de620449eed700000000000000000000"
+    "00000000000000000000000000000000000060bf3d96000000000000000000000000000000000000000000000000000000000000000300"
+    "0000000000000000000000a0b86991c6218b36c1d19d4a2e9eb0ce3606eb48000000000000000000000000c02aaa39b223fe8d0a0e5c4f"
+    "27ead9083c756cc20000000000000000000000005dbcf33d8c2e976c6b560249878e6f1491bca25c26a0184ab959c924086602bf87dee3"
+    "a0b35412dba64c0bdfe41e2b819a3ddcbfec16a00cab3069ed2778f9bddff385da5c022de8a8a35ae98b25392baf23cea12440e8f8aa0b"
+    "85059682f0008301683a94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000000000000028c6c06298"
+    "d514db089934071355e5743bf21d60000000000000000000000000000000000000000000000000000000005d944c8025a0f510de111fd7"
+    "381ead43d660808772cb3e3276fb08aaf3dee6b6c48d60da2cf1a0407be9705f0d2f0245c6ee6e4aabe5a9320732092305bbbcdb362e85"
+    "7cef06b3f8aa8085059682f0008301d17b94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000000000"
+    "0000e59cd29be3be4461d79c0881d238cbe87d64595a00000000000000000000000000000000000000000000000000000000096a448626"
+    "a0bf4fbb28df035903edf8dd911103a789356812cc7c62f1b8eca6e6a9457d15e8a011e55f8a9b1b7cdfd1e6cb18f0a349e9d0bf9083b0"
+    "2d23e31462e288e64ee250f86b6485059682f000825208949c9a6ce7433cc24d8204359fb508ea9c2a46f82d87ca61f661e85f3b8026a0"
+    "5709c681b2c4b4d8811db36f22cac10426128a00341ce0cf3ce9c85aac961a53a05319a65ab5dc91bcbf37165f2658aebf6e1950e2f60d"
+    "999646f6a1393f3aea4ff901ab5285059682f00083047bab94a356867fdcea8e71aeaf87805808803806231fdc80b901440dd4ebd90000"
+    "0000000000000000000043dfc4159d86f3a37a5a4b3d4580b888ad7d4ddd000000000000000000000000dac17f958d2ee523a220620699"
+    "4597c13d831ec700000000000000000000000000000000000000000000032d26d12e980b60000000000000000000000000000000000000"
+    "000000000000000000000004e76853cb000000000000000000000000000000000000000000000000000000000000010000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000060bf3c6f000000000000000000000000000000000000000000"
+    "00000000000000000000010000000000000000000000008876819535b48b551c9e97ebc07332c7482b4b2d26a04f905fe5fbadbf961253"
+    "8a1cb84da802fb643c8a0bce8440d25c5613b2ae3f89a0157d041af9b739b5a954741a3c1a0ae8dc0f01d3cde7ee27168b9a5624b72d5c"
+    "f8aa0285059682f0008301d17b94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000e59c"
+    "d29be3be4461d79c0881d238cbe87d64595a000000000000000000000000000000000000000000000000000000000367950026a0079bb8"
+    "86b6ec7fed60ae446aee311bb5e8b479bd135d382aa7e9d24b5fe996faa04b6c828c1ed06fa573edb2e2bd5fa9b723461f300c18321169"
+    "ab948505a16f0bf902ad82169785059682f00083040cb49497d43f3301b3f35433bc6af38f7046da2020657980b90244e94ce445000000"
+    "00000000000000000000000000000000000000000000000000000000e00000000000000000000000000000000000000000000000000000"
+    "00000000010000000000000000000000000000000000000000000000000000000000000001600000000000000000000000000000000000"
+    "0000000000000000000000000001e01c000000000000000000000000000000000000000000000000000000000000010000000000000000"
+    "0000000000000000000000000000008ec70a8851c42318bf000000000000000000000000000000000000000000000000000992c4a0d5b0"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000020000000000000000000000007f8f7dd53d1f3ac1052565e3ff451d7fe666a31100000000000000000000000081"
+    "9f3450da6f110ba6ea52195b3beafa246062de000000000000000000000000000000000000000000000000000000000000000300000000"
+    "00000000000000007d1afa7b718fb893db30a3abc0cfc608aacfebb0000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9"
+    "083c756cc2000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000000000000000000000000000000000"
+    "000000000000000000000000000200000000000000000000000000000000000000000000000000000000000f3688000000000000000000"
+    "00000000000000000000000000000000000000000f368825a0984db548623c56aa529d3d6761877565fd2ca9e1ae8199ffe9b5e56584f5"
+    "e753a04a56a2e1019951936a09b3328e053f112637729cb5a2e76878709a69ea0ecc6bb901f301f901ef01820dad85059682f00083124f"
+    "8094391fb6e28870b1ec24780510740412f6d35e914180b90184c5d4049400000000000000000000000000000000000000000000000014"
+    "a62ce765762f7a0000000000000000000000000000000000000000000000000012c221cc6a000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001c00000000000000"
+    "000000000000000000000000000000000000000000000000a0000000000000000000000000000000000000000000000000000000000000"
+    "00020000000000000000000000007f8f7dd53d1f3ac1052565e3ff451d7fe666a3110000000000000000000000007d1afa7b718fb893db"
+    "30a3abc0cfc608aacfebb00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "819f3450da6f110ba6ea52195b3beafa246062de000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000"
+    "0000000000000000000000000000000000000000000000000000000000c001a0c34bafce5a54df13c2ea113b588efe648b9cfd132b2954"
+    "d9dce038dbfc298d42a013fe3a2217bbceef991568482e733541a437b1b853446aa23409aec4d8ac47b9b901f301f901ef01820d788505"
+    "9682f00083124f8094391fb6e28870b1ec24780510740412f6d35e914180b90184c5d40494000000000000000000000000000000000000"
+    "00000000000014a62ce765762f7a0000000000000000000000000000000000000000000000000012c221cc6a0000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000015"
+    "00000000000000000000000000000000000000000000000000000000000000a00000000000000000000000000000000000000000000000"
+    "0000000000000000020000000000000000000000007f8f7dd53d1f3ac1052565e3ff451d7fe666a3110000000000000000000000007d1a"
+    "fa7b718fb893db30a3abc0cfc608aacfebb000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000819f3450da6f110ba6ea52195b3beafa246062de000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead908"
+    "3c756cc20000000000000000000000000000000000000000000000000000000000000000c001a087984d4cfb2af6a84be288f75e404995"
+    "d2198adb9b59b4d58b296b77ed25498ca0119fd067a2a5bea35a2774fee27073467849c033e8fee2f02b8c222c3890b9faf8fa8273c785"
+    "059682f0008305db8794860bd2dba9cd475a61e6d1b45e16c365f6d78f6680b892c89e4361fc90fac785b6cd79a83351ef80922bb48443"
+    "1e8d689c49c0000000000000000000000000000000000000000000000000154a6b191866d90502000f7f8f7dd53d1f3ac1052565e3ff45"
+    "1d7fe666a3117d1afa7b718fb893db30a3abc0cfc608aacfebb0000f819f3450da6f110ba6ea52195b3beafa246062de00000000000000"
+    "000000000000000000000000006e26a02fe77f3bb74855ccff1d9361d3ba251175c43f7ccb72e7ae17b40339c784d0eaa0537a1bcb6f86"
+    "a6d1f8c559c82eee238e607ea3eaf7054579cd8230a0428fb486f8e482274585059682f0008309324c9478a55b9b3bbeffb36a43d9905f"
+    "654d2769dc55e880b87cc89e43613cd408f736c1479affaafa48c037ee736582243d628642fe0abf20dcc2c82f28fe4f3e406928c22915"
+    "c15ae46df198876f96532d0df948d5000000003c071aae1bc09e1785c8cb00650db0c6015bd73b0c7ec558a96bb0020003000656000000"
+    "7d1afa7b718fb893db30a3abc0cfc608aacfebb05500000125a0642f936b3dcd4eb5510e76e07ea47bb9b623641582770827a4dc18ced4"
+    "0dbd49a0137a33472049c58873ac7493211914d58acd8a5fd39d9d747619d59b29305efcf90153825be985059682f00083034698940000"
+    "000000007f150bd6f54c40a34d7c3d5e9f5680b8ebc1b683cc000224000000000000147d456da0dd4c00017f8f7dd53d1f3ac1052565e3"
+    "ff451d7fe666a3110600c02aaa39b223fe8d0a0e5c4f27ead9083c756cc200000000000000000000000000000000000000000000006126"
+    "acbbc49ec7bc2000000000000000000000000000000000000000000000005ed5c1d90eb78e9cc500819f3450da6f110ba6ea52195b3bea"
+    "fa246062de06007d1afa7b718fb893db30a3abc0cfc608aacfebb000000000000000000000000000000000000000000000000000020bf3"
+    "f866639d00000000000000000000000000000000000000000000000000020b1ba34929531ba057f242835d766605f51acbea2585465e7e"
+    "8147349cba69533951f395b97e83d3a06850d3657d61b6b0c06fdadd494e38c9e962458c10fdc1850db9279683ea1931f8ad8301f36085"
+    "059682f0008303291894a0b86991c6218b36c1d19d4a2e9eb0ce3606eb4880b844a9059cbb000000000000000000000000693c0854ead4"
+    "2aa21c043735c06a4057774415bc000000000000000000000000000000000000000000000000000000010d0d9b0c26a0e9746e8092f62f"
+    "c3b5ffccf33b2dfb49caeea622bd3750ce82a33f1f228c0341a06d04f3a97ddeabcd931c121ea64ddc41fab3f4b3774ea33ca81046ff39"
+    "823edaf8ad8303933c85059682f000830329189495ad61b0a150d79219dcf64e1e6cc01f0b64c4ce80b844a9059cbb0000000000000000"
+    "0000000008b796c538e20006a5a208ef66834c828bab2f5c00000000000000000000000000000000000000000b6cdc4e3f1180e56d8900"
+    "0025a0adfadbf96e8478460ff57669213994444042d3f8c20781492575205802e2b52ea03831ec819f4783859ce2f84681b0197cda7a61"
+    "5b9af1a7c4ab105ac2edccaa7ff8ad8301818d85059682f0008303291894dac17f958d2ee523a2206206994597c13d831ec780b844a905"
+    "9cbb0000000000000000000000007f5813ee6f4a8f32392e355417c250b0cb808d52000000000000000000000000000000000000000000"
+    "0000000000000032a9f88025a0ee5bbca1d679320bc7b35348738d0e9ce96219e14a4abee10fcfc390e726649fa0479937982a689d441b"
+    "d0c787867d96fdc31bf667dfea045681bab1a7a809c664f8ad8301954e85059682f0008303291894dac17f958d2ee523a2206206994597"
+    "c13d831ec780b844a9059cbb0000000000000000000000002ba5206efec64e8bd8aeb29ca28b233d34d90df30000000000000000000000"
+    "0000000000000000000000000000000000019b721425a075b4a95395c36a4fffd0fd5aafcd2a430dce3e4c5cdf059965783a3672a41243"
+    "a02b5da5bc53c7b05f557f2054ae67179b2994002d7fc52b4d82c816d6c9fc8eacf8ad8303f3b285059682f000830329189469af81e73a"
+    "73b40adf4f3d4223cd9b1ece62307480b844a9059cbb000000000000000000000000f584f8728b874a6a5c7a8d4d387c9aae9172d62100"
+    "00000000000000000000000000000000000000000001fd777327431118000025a0c2c9987c4d812a202add8cea62084b607f0fa7b96921"
+    "d8c047efac1552bffee7a0169b413d6e4112d25cf9f04e7d456b4a39d5e28ea8b585c6fe3a295f5cbd50a6f9016b0a85059682f0008303"
+    "f5a3947a250d5630b4cf539739df2c5dacb4c659f2488d80b90104791ac9470000000000000000000000000000000000000004c5624583"
+    "f9dd59ee90000000000000000000000000000000000000000000000000000000050b3649af304265000000000000000000000000000000"
+    "00000000000000000000000000000000a00000000000000000000000005c981e29cf823ecad0855b4bcbbf3621b872c5bd000000000000"
+    "0000000000000000000000000000000000000000000060bf3fee0000000000000000000000000000000000000000000000000000000000"
+    "000002000000000000000000000000387c291bc3274389054e82ce81dd318a0113caf5000000000000000000000000c02aaa39b223fe8d"
+    "0a0e5c4f27ead9083c756cc225a03c834ad83d73b9c9bb71401d8fa1489dbe94f727f8768db02145ffc54f840483a009a46474e8a8f3e5"
+    "361623b01dab0637c30765dcd99d97a49964a0a0984cbefaf86f8301818e85059682f000830329189438f806c3f38ac4fd2db321dcb6c8"
+    "1c2d1ff782d8871c21ce7783bc008026a087005cb514610a7a56a4c68f6bad0a6eeac017fd72ffe19847bc1fe143600422a028e7c3c312"
+    "69909777f64e2226526d2dd3adc5d40c9d5f10344d1d58caf7db62f86f8301954f85059682f0008303291894820d2924fc880a3c045e64"
+    "d35390a1faeb4f431f874768d7effc40008025a0bde4719bcd15391b00907a1e4f718979659b40a0078d66e8d877699fafed7c89a03961"
+    "629d7e0577deb39e0b439ccefbe939bd6588229a14a908143fc33b1085a1f8ad8303933d85059682f0008303291894a0b86991c6218b36"
+    "c1d19d4a2e9eb0ce3606eb4880b844a9059cbb0000000000000000000000001b1a919863cef84eebfc04e7b715ce2e937926b800000000"
+    "000000000000000000000000000000000000000000000000532602c025a084e32486360f6cde8c6ba9fb418d2dbb21f91ff043b4589644"
+    "f74bcc7046030ca069c0486c7907059e28d8e256af51b8b5e815ba7f8d337e322e1a333dc14afc5ef8708301f36185059682f000830329"
+    "18940fc83737de049d768abe2d813d0aaaa513eff7aa8805838f3c0006f0008025a05aaae833a25d78c45b76786f2e0d8d444479e5ee0e"
+    "9e32dfcf9a914fc1e869cfa07f6cb321676f557654fd29565eb0082d42903e4cc4ff0c5bd3e9d861845c1530f8ad8303f3b385059682f0"
+    "008303291894dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000b89eb49bc337d2bfaee3"
+    "60ec63ad606b6788ceb2000000000000000000000000000000000000000000000000000000000ba25cf026a0d7166b2e96462ee14357aa"
+    "c5f48832c026f1234aa559f42cf69dbc3ac9e44544a064155ac89cf28aec7c18c3977f73613a3875976e5063cd53092221ad6b97d5a3f8"
+    "718301818f85059682f0008303291894cf753bb6a24d35793c476b490128ad060a62cead89015f26d643132428008025a0da9d5f397e6a"
+    "983f701c610efc9afcbd9526933ad99c4e9a7a0faceabdd87c1ba025ba9a10b62ca4ebbc2b75eced6c01a660e2d54118cd16b8aad01c83"
+    "9211fe7bf8708301955085059682f00083032918940ea62469d13da0c31fae2637ec561dfe4296c47c8813cc383921be10008026a0b322"
+    "ce1ed64c3a6fe638c9ee2d8e7d0042f733b2aa196dbaee4b3ef395ae6d39a07eb10ac17f6e2956a1d7505e7eb24d999c4352e432ddc556"
+    "6cfef870efd6879bf86f8303933e85059682f0008303291894b51b16c4bd608f8dbb936b7a99602270b092faeb873ac5200738b4008025"
+    "a0e81bf9cbc20445f726043f8ddbe54525b20b7d08df1eecb65b6a0bd568e24437a0468d802f095395654a8998a06f09cd41566aa45793"
+    "31ce6055ed8c8dde4feaecf8ad8301f36285059682f0008303291894dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb"
+    "000000000000000000000000c792f5ee199fc96aefdc2d0c3f6a906e18b5416c0000000000000000000000000000000000000000000000"
+    "000000000002fb665a25a00bddbfe1f8161c57f451e879d9b0e47dc68a27e160338149d65080bf0de4322da036bf5a71567cdfa89dabc1"
+    "d59c39552d53f2624dd4714c4eaf108bbb358fac20f8ad8303f3b485059682f0008303291894a0b86991c6218b36c1d19d4a2e9eb0ce36"
+    "06eb4880b844a9059cbb000000000000000000000000a16ca674b211eea99a8d2e2130329447253f583a00000000000000000000000000"
+    "000000000000000000000000000082f5c3d34025a0e41666c8b61ebf940301aea87494c8a314eba02702ebd4cb796aacfd09c96f8ca056"
+    "29a9e92a05bb9ba018aad333a278102100629893fc509a1987836a75748d57f8ad8301f36385059682f0008303291894a0b86991c6218b"
+    "36c1d19d4a2e9eb0ce3606eb4880b844a9059cbb000000000000000000000000533bf95effe28e65093bf37ae605db8bbcb702af000000"
+    "0000000000000000000000000000000000000000000000000438b364b025a0f0355bf38ed49e31048120d17a25e4fcaa875140b0be5839"
+    "bcfa6c63aaf1aef9a022a8be9d942a044d59aa6706d66a51efb40129dad994a44dffda0339a2da4ac6f8aa8085059682f00083018d7f94"
+    "bc4171f45ef0ef66e76f979df021a34b46dcc81d80b844a9059cbb000000000000000000000000a1d8d972560c2f8144af871db508f0b0"
+    "b10a3fbf0000000000000000000000000000000000000000000000056bc75e2d6310000025a0aa8e6f9dc8b8922d00bd7ce6cf5e0fd07d"
+    "35b115015b81731c618e57b74e36f5a030ba1219dbbf39221954c63c66f19a12461fa03781ce2a66aa9fc52d2a5a7e43f8aa8085059682"
+    "f000830186a09495ad61b0a150d79219dcf64e1e6cc01f0b64c4ce80b844a9059cbb000000000000000000000000da816e2122a8a39b09"
+    "26bfa84edd3d42477e9efd000000000000000000000000000000000000000000064110b5faceaf9b2400001ba041e5224b9f5429af08f4"
+    "19c1d6e5f53b021fdc53807c14fa24eb293e1ddcf60aa01aa2524ed6a2bd0b4adfe2f41bd2278831cff7dc24ddb43bd6f1cce2b0ebf968"
+    "f8708303f3b585059682f00083032918946d382006c73c6343ed07f5a9cbfe49126d266388880ba0c601660850008026a0ecad790e6b49"
+    "0818ff3c0a537f9ce7ce06ac1f81ac62fbfbf854ad7ef937c9cea065f7338c3e67c684ce502b84abea99cecf0a230446c6497537d995bc"
+    "7d2352d1f8938309340585059682f0008301c6f8940b95993a39a363d99280ac950f5e4536ab5c55668751b660cdd58000a41a69523000"
+    "0000000000000000000000a1ce07187dd877d6595b0380bb27a8bc43fadc2126a0bc48facf9dc208079430360ca50e8baaaf45fd55b40a"
+    "238c3239db33929dade7a01b5f63dfede86c3ca6c02a2833e72ddc94fba5419d104531d991903bd250c5e2f8ad8303f3b685059682f000"
+    "830329189495ad61b0a150d79219dcf64e1e6cc01f0b64c4ce80b844a9059cbb000000000000000000000000d31b13a5e40b4b20090d4d"
+    "f7cbc397fac498a20a000000000000000000000000000000000000000007bf374052a8012cb124000025a0040820fddf3037f98cd4977f"
+    "e0ef6c1a987b615deadaef52198ad24d441d4851a00c64b81a570f574c5676d796144e44f695cf1cf92119c4053b1dbd07c03b2934f8aa"
+    "0f85059682f0008301d17b94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000e59cd29b"
+    "e3be4461d79c0881d238cbe87d64595a00000000000000000000000000000000000000000000000000000002540be40025a04dd912fb33"
+    "3d7f44269d56a05863812ef9f2bd7abe2c6e329dfff282c0688005a042f3691205250f399a94aaed05d43dc75d557f48a3b49680ad2cff"
+    "cfd7186773f86e82021585059682f00082520894c05f5ddef22e601df388f2d27e70991da05b792488807bcef2850fd0008025a0f04d7d"
+    "6cf1db67a63bb3280ecea01c0d404b3e361795cd04793b5c1ff870098ba05728a5e7e2f5ff0e2f0f314197641588f0373a9ca2d633d4b8"
+    "4f50d2248b94fcf8aa8085059682f0008302981094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000"
+    "000000000039f6a6c85d39d5abad8a398310c52e7c374f2ba30000000000000000000000000000000000000000000000000000000001b4"
+    "142525a0d4cf7b65c662d867e157713b13b9c618320738e35a41944643772d23defaa0c8a03bc04ff0039c51ec1ca951e656ce05327d5e"
+    "98a8ac16d4eb5ac3bee83244af2bf8aa8085059682f0008302981094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb"
+    "00000000000000000000000039f6a6c85d39d5abad8a398310c52e7c374f2ba30000000000000000000000000000000000000000000000"
+    "000000000003ca751f25a01d02a7db44ecab5d7cb3366be1222df80c13aa81f967f568910c27552282e147a04bca8e3530edcde21d5a51"
+    "dfb4f6882acada21dd9783a842d1e58c43fe2f10e9f8ad830766bf850560de070083015f9094dac17f958d2ee523a2206206994597c13d"
+    "831ec780b844a9059cbb000000000000000000000000c3f27de00fa7944e2e740e00c39b6aa8dd9e23ca00000000000000000000000000"
+    "00000000000000000000000000000003c14dc025a0cbb611d90ec3ada07c2a03fbfc617120ebd1af427683914e5ceb8c011d60530ba00c"
+    "67218b6791f78c33f67615bd45a822e0f2de9127d93e11bf702658a50447cbf8ad830766c0850560de070083015f9094dac17f958d2ee5"
+    "23a2206206994597c13d831ec780b844a9059cbb0000000000000000000000000db75191000f28a7a5feb0ba0b10d7c26ac5e9b0000000"
+    "0000000000000000000000000000000000000000000000000005a995c026a0eb130a9b8e931125fc8f341b50e75fbbba63bf3d35470c9e"
+    "2040be0bbf07dc33a06cbddaa1ea25e143050f001470727956d75afaadbf3e3a44857a63ad9b0c724af8ad830766c1850560de07008301"
+    "4c089495ad61b0a150d79219dcf64e1e6cc01f0b64c4ce80b844a9059cbb0000000000000000000000008e525207d339f43d77d2d8865c"
+    "283c8d183a9da8000000000000000000000000000000000000000000070774d8c36e74300f280026a0c159a75966e8435dbbf04016fc74"
+    "60ba1b632025e6d706d2cdaec644c90dfa1ca07b455e2300139d011b68cfef20507789a7c7362d9c1a360d8f9e1c8429e872e4f8a95485"
+    "055ae8260082d9f994ea3983fc6d0fbbc41fb6f6091f68f3e08894dc0680b844095ea7b30000000000000000000000007a250d5630b4cf";
+static const char* kBlock12593055Part2 =
+    "539739df2c5dacb4c659f2488dffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff26a025cd775666888675"
+    "38f20bdc6055cba737663716a17936557684b4e3b87c8216a0783150f876c8e60670ed1fd61f355c85b39749d114b5adc1982f097626d9"
+    "4637f9054d820a0985055ae826008307a12094724d08f4688cda05d8e3243db9db1b20c90f3a0580b904e4c98075390000000000000000"
+    "00000000000000000000000000000000000000000000008000000000000000000000000000000000000000000000000000000000000003"
+    "20000000000000000000000000000000000000000000000000000000000000040000000100010000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000028000000000000000000000004806"
+    "2f5b368583d83f2869ea756eb4480000083402070d0c09060e0f030504020b0801000a0000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000060000000000000000000000000000000000000000000000000000000"
+    "0000000010000000000000000000000000000000000000000000000000000000000021c870000000000000000000000000000000000000"
+    "000000000000000000000021c870000000000000000000000000000000000000000000000000000000000021d053000000000000000000"
+    "000000000000000000000000000000000000000021d837000000000000000000000000000000000000000000000000000000000021d837"
+    "000000000000000000000000000000000000000000000000000000000021d8370000000000000000000000000000000000000000000000"
+    "00000000000021e99e00000000000000000000000000000000000000000000000000000000002228b30000000000000000000000000000"
+    "00000000000000000000000000000022290800000000000000000000000000000000000000000000000000000000002235960000000000"
+    "000000000000000000000000000000000000000000000000227c2800000000000000000000000000000000000000000000000000000000"
+    "00227c28000000000000000000000000000000000000000000000000000000000022928b00000000000000000000000000000000000000"
+    "00000000000000000000229367000000000000000000000000000000000000000000000000000000000022936700000000000000000000"
+    "0000000000000000000000000000000000000022a04b00000000000000000000000000000000000000000000000000000000000000069c"
+    "09ee769bbb59201dcac0413223acbdda9fbc86e00686d66234679f2e40f9a4c8c8ee9f397dfbea71595d1ec33ff8b37b7bd38ca52fe5ad"
+    "c337f83f2dc080cd70f37e0c4da9bd8283ef43e1d3097bd0a28cffb8530e3f2eae27dadc1ba455daca5e4a55ca711ace22919f25fbf1ae"
+    "76184a58d8a0e61c487832bd7fa97e1c9c14b655dd58b3bcec93986e5eb360dbe295e5194c54d4053a4acac968719000425f133dad15bb"
+    "1d3b190a2cdeebf777a87911afe6a0dd528699254160b097990f0000000000000000000000000000000000000000000000000000000000"
+    "00000648c6abb25e35d04c4239c65feedcf156642d5bee626e8afba0007b4c1ba610131bbd945b9b495d31f57d82c58a2a67231c59129e"
+    "c5920d5f5427b22e73aea96135cb3d2be14738aaf00626d726044845c71fd66478253930c3fac74c481498ff3850800a0d2fa54a790d30"
+    "ec54bd5d2a7bad42afc94bbefd53fb0db315512b4e420a069708a3beb59bb4cff556688e6705706c9ecc5fa2dff3a17255dee71b856f8b"
+    "91ca0062496a6b7f151544668e23d8923ca47aa177a8438ceeba69ed5a8126a077b0bb0963a2d8807a1e4fc402d4304979ce96d2d1aba6"
+    "7f0c40cca045a3e1bca03deb534e73caed2984ee8c3d70a8b2743cab6861c1943697131b3f0425e38721f9054d822b7585055ae8260083"
+    "07a120940c7907d97b7f708ecda1a0b3124d32cd8b1e392080b904e4c98075390000000000000000000000000000000000000000000000"
+    "00000000000000008000000000000000000000000000000000000000000000000000000000000003200000000000000000000000000000"
+    "00000000000000000000000000000000040001000101010000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000002800000000000000000000000bb553dcb9977c0313e473bb0122edeaa00"
+    "00be0d020f01060d0309050802040e0b0a0c07000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000060000000000000000000000000000000000000000000000000000000000000001000000000000000000000"
+    "00000000000000000000000000000000000149c699a50000000000000000000000000000000000000000000000000000000149d4336300"
+    "00000000000000000000000000000000000000000000000000000149e10e14000000000000000000000000000000000000000000000000"
+    "0000000149e35e090000000000000000000000000000000000000000000000000000000149f34e87000000000000000000000000000000"
+    "000000000000000000000000014a60fee0000000000000000000000000000000000000000000000000000000014a62fe4f000000000000"
+    "000000000000000000000000000000000000000000014a7021f0000000000000000000000000000000000000000000000000000000014a"
+    "77494e000000000000000000000000000000000000000000000000000000014a7a9ae80000000000000000000000000000000000000000"
+    "00000000000000014a8b81ff000000000000000000000000000000000000000000000000000000014a8b81ff0000000000000000000000"
+    "00000000000000000000000000000000014b782710000000000000000000000000000000000000000000000000000000014b7827100000"
+    "00000000000000000000000000000000000000000000000000014b78271000000000000000000000000000000000000000000000000000"
+    "0000014b78271000000000000000000000000000000000000000000000000000000000000000065df2e900c17cb5dff490d0056cec4fa1"
+    "8bfb0b59754195b2ec99ae9e6e82d0a4ff40a3d4b2e0fd8d482d7d5cf9a204f7ded6ac5f218a825d482de186eeb8bafb8a1921e2685c9b"
+    "ad82d99fa9c2fbbf1f95d14b64bb317142251b566ace6abbb94a3997fc6349f20f645dd6f82273f19bb5a5c1956a70bb88b99377e3fda8"
+    "2be299abcb5782e2d796445de9e8228d2b08555d1ec631f41c3aefff84518c695af31589b5a121e973de77729aea5db65e26c9918497ef"
+    "24d6cc734174010fede81e00000000000000000000000000000000000000000000000000000000000000067b381cb464c3615c361c5c49"
+    "5de8347f964d8232a4c7cd5709415045ae7857b6289fb93b0b23886a7ee37420bf2e0c70c939dded0ec21480a0885eed1ed07958228f6a"
+    "405b5144278772cf2c740e7facfa3cdfda0bb24fcd8573279d4346c015668dbc65058eef29115175f8a4011dc521089ffc885e3a4dc14f"
+    "e8a6e62949f154e112eab64f2351e2b283fd0b83610dddc6b513cbc504476bf4f7a3187178fb6bfc061dcea8a77e16c9d1021189b89bed"
+    "f6dfb81dd960859491b53833c6394226a080bf8fa9e71b54edef08d8dc70ba2ce3a2ce66306c6cfb705b43fe411118d4c5a035a3d09d5b"
+    "33ad50dc04a12b76de55bcc060cd1f50598ffb26fadb754026819df8aa4585052e3df9908301356994dac17f958d2ee523a22062069945"
+    "97c13d831ec780b844a9059cbb0000000000000000000000008979d1e0ecab3cf5ae8a5a7b2d792aa119f34be100000000000000000000"
+    "00000000000000000000000000000000000000b6bf351ca0fa43f28f99946ebc67d7981a2599ff0d15baa5f4611fa755820aecc04ac670"
+    "c8a07e14b6c3a96791545cee13ad75fb38895e928ad78fac90e9489cd9a2b3de7847f8ac824786850525433d0083030d4094dac17f958d"
+    "2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000000000000055327c92c56b0975688d9573ac06b9e071080fdf00"
+    "00000000000000000000000000000000000000000000000000000013178af026a0ec1a4902c3fc1734ca32d948cbb0d03449594737e674"
+    "39fe8a8785ecad980693a04de4ee2ac5fb59c9facd6d34e2192c417d316a678035427fe2cb71785573a345f90d8b0785051f4d5c008303"
+    "2401943b5d2b254224954547a33cbf753bcaa5eb4b27bd80b90d249ec9b36b000000000000000000000000000000000000000000000000"
+    "0000000000000080000000000000000000000000000000000000000000000000000000000000001c5912761463f22caa4755669e01f98d"
+    "65a7df710603de85ea3cd21e1ce57404062c02e84cbeed0dc770ee6581a3039dbf3790e9f16ffe523dde0a509d3ff11275000000000000"
+    "00000000000000000000000000000000000000000000000000320000000000000000000000001407d79438fb0e960f8e8489f32f87f2b7"
+    "d022d20000000000000000000000000000000000000000000000030d96a4ce702ad5700000000000000000000000005fbe0ae423f17670"
+    "28f150aa92545267507588ef0000000000000000000000000000000000000000000000030d67cec5d6149ca80000000000000000000000"
+    "00bd0f5d4be49f83fc26925d454533da2e2504da6a0000000000000000000000000000000000000000000000030d4438aa0ba034980000"
+    "000000000000000000001ede6ed83cb8187fce376289370ec1e67ebaa8400000000000000000000000000000000000000000000000030b"
+    "f2a758025832400000000000000000000000006f2d38db1a92ce1b444f3259fa92ae5807ec941900000000000000000000000000000000"
+    "00000000000000030b6f21bd8452cf20000000000000000000000000fe44ed35c5900dbdb70e4b91eaed92b6f339c8b000000000000000"
+    "00000000000000000000000000000000030b35da06d8e7e6c00000000000000000000000008bca4cdfb1793a9ff24464d17412decd86b8"
+    "0f770000000000000000000000000000000000000000000000030b2eba84c746aee0000000000000000000000000f17f9beb8c91670d6f"
+    "79a335dbb73c85f28ff4000000000000000000000000000000000000000000000000030b25ecde605c1a20000000000000000000000000"
+    "f788b7e1841bac0de9bf2fab9382878b2e85db0d00000000000000000000000000000000000000000000000309c4090b516d4260000000"
+    "000000000000000000001b8fd08545cc8fa3734a6e53652c61724df2240000000000000000000000000000000000000000000000030754"
+    "254cee8170ea000000000000000000000000df4ce936d128dc40cc1fe8fef8ccafa6872d89450000000000000000000000000000000000"
+    "0000000000000303fdac333ad85400000000000000000000000000534c4701eae465d435e86ad6ddf33b80c73700f20000000000000000"
+    "000000000000000000000000000000030336160b339fc8980000000000000000000000003c4a9196cb91f791f1bcae5d676753526ee077"
+    "e6000000000000000000000000000000000000000000000003025bc4b10032dfd0000000000000000000000000b5f64075e1d61e95cd16"
+    "e17530e808c8078d3e9700000000000000000000000000000000000000000000000302120e653909024000000000000000000000000052"
+    "32522349ede8da7bf0ab87de4bb52c0a62e75100000000000000000000000000000000000000000000000301850cf3e0096b8000000000"
+    "00000000000000006a2ebd6b63dc3f8ccd1f91292cefb07255e01c86000000000000000000000000000000000000000000000003014b1e"
+    "3b8112f9100000000000000000000000005ed7a5a0db39896c5394eca6da011d3b600a1750000000000000000000000000000000000000"
+    "000000000002fc4e31f125b6f180000000000000000000000000916657bf340912702285ed840b59b29f181ab9b6000000000000000000"
+    "000000000000000000000000000002fbc67f03e7e5d010000000000000000000000000024f1f8b3789bfdf9edb47f58a0d7a3afeaea804"
+    "000000000000000000000000000000000000000000000002fb7a5240cfee917c000000000000000000000000e0561d1e080c4fdc8996cf"
+    "cd27416714ff1f2f41000000000000000000000000000000000000000000000002fb634354694df2800000000000000000000000009ad3"
+    "cc72eb9a7d6415703c26366cf46b31dfd181000000000000000000000000000000000000000000000002faccde621751a9100000000000"
+    "00000000000000a797ac344ac4823176481c15ca99a10fc73e0756000000000000000000000000000000000000000000000002fa777069"
+    "791f2f8e000000000000000000000000e008437ba0adb9aedf4d6d929f0a26a2ef1bdca000000000000000000000000000000000000000"
+    "0000000002fa1a6d6e413c82580000000000000000000000007fa24284261b5509159b3c68cea28ae9ac28f9c900000000000000000000"
+    "0000000000000000000000000002fa186eac22b8a720000000000000000000000000992f10d4d7184a9cdc5677ba9911fafa3315ea6100"
+    "0000000000000000000000000000000000000000000002f9044f0b85e90130000000000000000000000000acda2babfb23f495f7cc0688"
+    "f15134fb3129898f000000000000000000000000000000000000000000000002f6261db006d5496e0000000000000000000000004e0fbd"
+    "d8d5f97ee1b7fc2df2afef63e70ff4c12c000000000000000000000000000000000000000000000002f2a4e2cc0ccc9070000000000000"
+    "0000000000005d01bd46e72edfac2a397d13379514f13063cc6a000000000000000000000000000000000000000000000002f264d4786a"
+    "3cb200000000000000000000000000864798eb93c81be58b07a86ebda60035e8bac1970000000000000000000000000000000000000000"
+    "00000002f247e7f66c8be9800000000000000000000000006691774039f67f69cce5ce78f3791905a84956060000000000000000000000"
+    "00000000000000000000000002f1ec88b2c4f8d988000000000000000000000000fa62b9414774784209727879b255586768cef1f80000"
+    "00000000000000000000000000000000000000000002f1773b42eafa6d3c00000000000000000000000088811d23b99c15d5ac8bce1ea4"
+    "399f5acf1f393a000000000000000000000000000000000000000000000002f16728de38553e90000000000000000000000000cb3701a3"
+    "217f4306f23f4fcdb665daee6d99a421000000000000000000000000000000000000000000000002efd7ac743f81676000000000000000"
+    "000000000061bf427b41367ba75b2b9807285e10b3c425681c000000000000000000000000000000000000000000000002efd719cf351e"
+    "3dd00000000000000000000000002aa7008863b8677fc0af85fea4d20ed3d9d219aa000000000000000000000000000000000000000000"
+    "000002ef8700ede2011770000000000000000000000000563044fa8d54b5487ebc2b68e55e490071910e83000000000000000000000000"
+    "000000000000000000000002ef8700ede2011770000000000000000000000000eb96fd96b2a0ad2ef4b9f431e72021522749b076000000"
+    "000000000000000000000000000000000000000002ef205484df500300000000000000000000000000fa2df41481e77ed815d0e52f098e"
+    "245cb9b2944d000000000000000000000000000000000000000000000002ef205484df500300000000000000000000000000f899e54786"
+    "0c95541ba21ed3894d97e047ea9424000000000000000000000000000000000000000000000002ef205484df5003000000000000000000"
+    "00000000b1d0fa3b334c7c32079c2c73e6c6d487af67884e000000000000000000000000000000000000000000000002ef205484df5003"
+    "0000000000000000000000000000f9c4dbc954d0ceb85949edc40cfc45f3d97e5d00000000000000000000000000000000000000000000"
+    "0002ef205484df5003000000000000000000000000009700bae27bd4538e43c197bbc5dd1ca4300eb0a200000000000000000000000000"
+    "0000000000000000000002ef205484df500300000000000000000000000000c71be09684aaaaa6657a624d4aa9b3ebc5ade11d00000000"
+    "0000000000000000000000000000000000000002eda606afd91f65f00000000000000000000000006ddf69807305627aa848886d807b9d"
+    "78af8ec1d8000000000000000000000000000000000000000000000002ecfe600578624c760000000000000000000000008e64fe4f19f2"
+    "d1768a7820b80e9268eb52752926000000000000000000000000000000000000000000000002ec32c3d259350b90000000000000000000"
+    "0000007291131892c232fcf4b9e6cd8cddd5b591052168000000000000000000000000000000000000000000000002ec0f7b1c8ef476e8"
+    "000000000000000000000000668ce1ee8ef24426ea3f15a8955ef0515e584e260000000000000000000000000000000000000000000000"
+    "02ec0884796f62a19c000000000000000000000000f5f1cf6681015c7a6ec6fb1bd3834904cc6cc5b80000000000000000000000000000"
+    "00000000000000000002eb04a858ffe18910000000000000000000000000c88924eda18b61e8ccb76e2888bd5575a8844d8d0000000000"
+    "00000000000000000000000000000000000002e98750241e6c8723000000000000000000000000dbeae7ade0d6b715745837dcd82b3561"
+    "eb0819b5000000000000000000000000000000000000000000000002e80317f5be771d2026a08c96a2b07f232deba95e8f46022a5785ff"
+    "206a01d2e3e0696a5af851a294485aa032164a83635c4dab1a978e07e50d21d3e05d244eac5af0ab1e57b73f48af14fbf8ab82014b8505"
+    "1f4d5c0082caee94aa6e8127831c9de45ae56bb1b0d4d4da6e5665bd80b844a9059cbb000000000000000000000000afdb1643361de294"
+    "04b4baf347eb62b6491c9de700000000000000000000000000000000000000000000000072b8dd1e34132a7926a03ea1081cdd0f912b9f"
+    "67268a8b09da082ee2e9db7cb01923a85b8086e1df8c6ca032672bc868f4c2c88f046313bce869c968eecd435815c9f4672967130e7a3f"
+    "a1f901522485051f4d5c00830280f7947a250d5630b4cf539739df2c5dacb4c659f2488d88337da2312621c000b8e47ff36ab500000000"
+    "000000000000000000000000000000279b63ad700f3c5e22064ffc36000000000000000000000000000000000000000000000000000000"
+    "000000008000000000000000000000000050d8d23865e5a99be09d4eff051ccc9bc1eba55c000000000000000000000000000000000000"
+    "0000000000000000000060bf3d960000000000000000000000000000000000000000000000000000000000000002000000000000000000"
+    "000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000000000000000000000e02889ad55cbd30c95894fe038debe7314e68a1d"
+    "26a09a285c7e2710c1cf6a4223709750287ecb0e11beebbd038881e2811cdc1f0a75a011f97937a496e1b022ab9467385610c88a82b07f"
+    "84138576ed51e6a277f1731ff8aa3c8504e3b298198301388094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb0000"
+    "0000000000000000000007fb8823969bf143096ce734240fccf015f5482500000000000000000000000000000000000000000000000000"
+    "000004a817c80026a04dabaf22654464f04f8f2dd2afa488f77e5c058eb1aabfc6230a111734305f1ba00981ba4cc4614dcdb8be4c27fb"
+    "92cc620be00f5e57e8a05cf7c686bef0be388ef8a9808504e3b2920082edbe94dac17f958d2ee523a2206206994597c13d831ec780b844"
+    "a9059cbb000000000000000000000000562680a4dc50ed2f14d75bf31f494cfe0b8d10a100000000000000000000000000000000000000"
+    "00000000000000000010bfb84026a04ebb0e2449fe4e14bced2fa128f9767ceae6373f789df3a488b4338db0bf59e0a051c20ec2e58d6e"
+    "5d3b800548cfcb88d76fed5f439e189a5340edc7ea1ab42033f8a9018504e3b2920082edbe94dac17f958d2ee523a2206206994597c13d"
+    "831ec780b844a9059cbb000000000000000000000000562680a4dc50ed2f14d75bf31f494cfe0b8d10a100000000000000000000000000"
+    "00000000000000000000000000000010bfb84025a064517ae47e2e10ba8adb453bfa85ea9601ced7908cfc3b480c722bb14ca98e8ca071"
+    "19f21d01b962956843710dc785a51315d705f5824d050d980cac08ded54b52f86d824a538504e3b2920082520894a5260eedd463818574"
+    "5eb58b95a0066a7b95db10876a94d74f4300008025a0531391f1af5deae7b291f0896cf7e14d7a84605f652e18a7dd06f843c8786c35a0"
+    "285b585aed2f6170a39ea3e0caef116979f5e8b90f6b6be241fe20c12dadccbcf8ac8205048504e3b2920083015f9094dac17f958d2ee5"
+    "23a2206206994597c13d831ec780b844a9059cbb0000000000000000000000000b3102ed9a20af3e854ded5f04b8d6a9cb7322e3000000"
+    "0000000000000000000000000000000000000000000000000f86700e0026a088f41ae3ddf61bcce08a77d580cb45ba6d831868df8e25c1"
+    "3773dff73ef1330aa074ce8489f7de6a18763036cdf2dc0b9e4ec376d5db886cbbbea9f697d128f466f8640d8504e3b292008268f19432"
+    "23f5cf53b5443c891640ae1bfef6be8ed6fc6980801ba0a02d473167d54a40e50ca3c69e5eaa6cfa1293226a070bf60977822b3cee1ff3"
+    "a011802acfdcdbc450c991fdf3bc82d743e9f003d13a4f02fe4e5b2ca0ee1022e0f9050c81ba8504b6fe7a8083012496947be8076f4ea4"
+    "a4ad08075c2508e481d6c946d12b80b904a4a8a41c700000000000000000000000007be8076f4ea4a4ad08075c2508e481d6c946d12b00"
+    "0000000000000000000000ff6d917a46f3071e9dc83a57aba7e1c6e46b991c000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000005b3256965e7c3cf26e11fcaf296dfc8807c01073000000000000000000000000bc4ca0"
+    "eda7647a8ab7c2061c2e118a18a936f13d0000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0001f400000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000044004c09e76a000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000060bd1a6700000000000000000000000000000000000000000000000000"
+    "0000000000000034c66e8961459c3d3e756a6b4ba11c60d0f11417260611a4a45834a9f9686d7800000000000000000000000000000000"
+    "00000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000100000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000340000000000000000000000000000000000000000000"
+    "00000000000000000003e00000000000000000000000000000000000000000000000000000000000000480000000000000000000000000"
+    "000000000000000000000000000000000000001c59c5fd9e14ea8c9a634f3dd822041f2ded1f989aeecddb4ae395b700f85f3045427065"
+    "038b8ac20a0f1a62dcebe62738ed5e7b21b98aae8c274635b5f33a86b90000000000000000000000000000000000000000000000000000"
+    "00000000006423b872dd000000000000000000000000ff6d917a46f3071e9dc83a57aba7e1c6e46b991c00000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000010ae00000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "64000000000000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffff0000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000025a02aff"
+    "6e89acade6f43450579fb797099bcefffb8d7d81fb6c41d812fe636f58cda056a43347848f89a3b93375453a46fcf1f0b930867fc5f72e"
+    "81fe3c4748da534df86b038504a817cdb38252089487f02f6851be40cf01421185b5cac01057271a198756c1dc516a40008025a0f44a03"
+    "94d30b1cc993e27c477636431b61bd10af36ec016dad53575fae32b9e0a078bfc563898aa496c699c17562eac6c23bdbe9803f19130a7f"
+    "9acd94da222908f8ab81858504a817cdb38301388094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000"
+    "000000000000a7696e82b23361f8d6f769e50605d376628f9b0f0000000000000000000000000000000000000000000000000000000828"
+    "02a3c025a03dd665a150981632eb2f61640458a1737c3c51ce3912aeef5063c91eca7c0355a01fa843d508c30900eb4e9ff84dc7fecb26"
+    "b188d035bfb6c02d3e409f332ce953f9016d82a8c58504a817c801830243cd94fa103c21ea2df71dfb92b0652f8b1d795e51cdef80b901"
+    "041cff79cd0000000000000000000000006a172d5dd7400244c8f24e3a73cc20c01babc44d000000000000000000000000000000000000"
+    "000000000000000000000000004000000000000000000000000000000000000000000000000000000000000000843f7fccb70000000000"
+    "00000000000000dd974d5c2e2928dea5f71b9825b8b646686bd20000000000000000000000000056178a0d5f301baf6cf3e1cd53d98634"
+    "37345bf900000000000000000000000077d8bb66a2489f0aaa3ed9cdf1e4221ce9a21d5700000000000000000000000000000000000000"
+    "0000000381c10c41f8050000000000000000000000000000000000000000000000000000000000000025a04fca6d12b9ed39ede5ec94dc"
+    "2e83c4ca67c165571b72160374509b7125b6c67ba0022e6bd3d4f2cabac66127cf9b926a9cff9f52c7737c7c90b8aee0d8cd97cffcf904"
+    "ab2a8504a817c8008366067e94a5644e29708357803b5a882d272c41cc0df92b3480b90444ac9650d80000000000000000000000000000"
+    "00000000000000000000000000000000002000000000000000000000000000000000000000000000000000000000000000030000000000"
+    "00000000000000000000000000000000000000000000000000006000000000000000000000000000000000000000000000000000000000"
+    "00000160000000000000000000000000000000000000000000000000000000000000022000000000000000000000000000000000000000"
+    "000000000000000000000000c4f3995c6700000000000000000000000083222a4169224832260457ee734eb88ac18420a8000000000000"
+    "0000000000000000000000000000000000c09cde54c572c339760000000000000000000000000000000000000000000000000000000060"
+    "bf3f69000000000000000000000000000000000000000000000000000000000000001cf3a83da76f5cc3350ec4b9799f9a0e4ac8b73be7"
+    "87ecc99f17e8c26a11bef5df58dcac9dfa2f82a3f7ddd7da0ea3fd93baf1c31209594af41f832e94aa4a78fc0000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008413ead5620000"
+    "000000000000000000000d88ed6e74bbfd96b831231638b66c05571e824f000000000000000000000000c02aaa39b223fe8d0a0e5c4f27"
+    "ead9083c756cc20000000000000000000000000000000000000000000000000000000000000bb800000000000000000000000000000000"
+    "000000000376176377be37ab4ef662dd000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000001a4d44f2bf200000000000000000000000083222a4169224832260457ee734eb88ac184"
+    "20a80000000000000000000000000000000000000000000000c09cde54c572c33976000000000000000000000000000000000000000000"
+    "00000000000000000000640000000000000000000000000d88ed6e74bbfd96b831231638b66c05571e824f000000000000000000000000"
+    "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc20000000000000000000000000000000000000000000000000000000000000bb8ffffff"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffe9a1cffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "fffffffef41c0000000000000000000000000000000000000000000038b0bd8349a805654e4c0000000000000000000000000000000000"
+    "000000000000011a0ff6cbf11dd976000000000000000000000000fe8d66b455e03b6879f1a518714e58edcf958d750000000000000000"
+    "000000000000000000000000000000000000000060bf3f6900000000000000000000000000000000000000000000000000000000000000"
+    "010000000000000000000000000000000000000000000000000000000026a0283eb79ea4cd3be7e325a9fdcfa026eda339dc21f9dce790"
+    "a5f7c2f31e06cb5ca037d0a596a1f40044c795930e615a3850e1041507bdd8583e83f7bcb1b0a50d48f8aa7f8504a817c800830197e894"
+    "f629cbd94d3791c9250152bd8dfbdf380e2a3b9c80b844a9059cbb000000000000000000000000dca7590126f8ccbb8b880dd223e3b36b"
+    "50b61515000000000000000000000000000000000000000000000004b75e170de2fc00001ca0adeb8d87e60137dd7bbeac3fb295e8238c"
+    "e658f98d0bdcb752ba9c643dd64a72a0330581488b0179338b23c8ef1efc0c408c1955fb0622a0dd3da7c7965cb61542f8ac82fa288504"
+    "a817c8008301d4c09478a52e12c7b63d05c12f9608307587cf654ec3d080b844a9059cbb0000000000000000000000003240cee67a101a"
+    "303e5c72edd8996256db20792a000000000000000000000000000000000000000002f90193ef3075fa980000001ca095426c5b27f19ae0"
+    "75e0d06743ca3c46fdca9eda5d249700158e6f5b130bbcd0a0450f7e1ea19849aed1e9348b31a3c9e68777221a0c8a94fe7d2ac3824390"
+    "824af9016d82041a8504a817c8008302a996947a250d5630b4cf539739df2c5dacb4c659f2488d80b9010418cbafe50000000000000000"
+    "0000000000000000000000000000001cbd90b7f5cc0660000000000000000000000000000000000000000000000000000091e9065bde09"
+    "f900000000000000000000000000000000000000000000000000000000000000a0000000000000000000000000ff8f6f4accc8fe7db194"
+    "0f9799e4e7ca4f4766160000000000000000000000000000000000000000000000000000000060bf3d5d00000000000000000000000000"
+    "00000000000000000000000000000000000002000000000000000000000000182f4c4c97cd1c24e1df8fc4c053e5c47bf53bef00000000"
+    "0000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc225a0497a97a4fe3a3df2963a31395dc1ef316d8b1620bde4ea9e39"
+    "2eba276d313b4aa02d82127e4040148ff0a51995adced3455b0c884057cd7414bb2bc4b623e3d320f89181888504a817c8008303681094"
+    "fbddadd80fe7bda00b901fbaf73803f2238ae65587153ec73fc1c000a405eec28900000000000000000000000000000000000000000000"
+    "0000000000000000000126a0539641b34c94f47f7ae0b3d2179ef2a715e79e1a08a15329e7513c8994cc4465a03f4c5c8b3c46edc21799"
+    "ae67200adcca455d7270194141cccdf1bae4b29aa2e8f8aa128504a817c8008301725d94dac17f958d2ee523a2206206994597c13d831e"
+    "c780b844a9059cbb000000000000000000000000f14579103d5c11e03a828e9a920bc0c203b35eed000000000000000000000000000000"
+    "000000000000000000000000000e194dd526a03593a885d8044fcd7a82b30672def7128f827b453e5fcfab838a38a939c10759a04635c2"
+    "cb0eaaa1de9e637f865ce2981b017b3a4d8c4c9fbbfd15e9178b548ac1f8ad8308c4c08504a817c80083015f90943242aebcdcf8de4910"
+    "04b1c98e6595e9827f6c1780b844a9059cbb0000000000000000000000008f5a307dc15d67c947d672b61cab176720ee16160000000000"
+    "000000000000000000000000000000000000056bc75e2d6310000026a0d1414ea7a9fd096aace5916aee33b1e28193d0aacf05e1ec462d"
+    "fd8d08fe35dea017967753fb5ad04d23059d2b182eea546d1e1f4dc63ebadd332dc2e2c8a8ce75f8aa1f8504a817c80083011dd294a0b8"
+    "6991c6218b36c1d19d4a2e9eb0ce3606eb4880b844a9059cbb000000000000000000000000806b0267c1d50b0da1a4bfec5c5d67e58b20"
+    "915f00000000000000000000000000000000000000000000000000000000ee6b280026a066395e0e9ea02d59143effe376f17ad0d4a487"
+    "477855efba7e4215ecb96aee8da061e212dd1d626c17f6a12068dd25dc9680f44d60810b0c1171f101ab2490d72ef86a81d08504a817c8"
+    "00830c35009473f5e5260423a2742d9f8ac49dea6cb5eaec465e8084e9fad8ee26a04b8d392955fd52122fe68e8af40f3e51715875ae0c"
+    "10d16c9b11b1555222d837a066d179540baa849043ed89ce5188fbf5f582f73fe6b914a54ab6487bb34f33eef86b048504a817c8008252"
+    "08947641f348561420d791efbac8655504c2ae75eb9f877bd4aee6c236688025a0baab83f88009d7be0a886e1ed5afd529a5987dd7f30e"
+    "783b97459d268ea5c781a063916a8fc103b23be63cf3033ad98e7b6e61f5964ccdcf74a3b5d4d3079e94f0f86c808504a817c800825208"
+    "94588df9539c86a58e1fa3b4572c58a6299122681e881a4c6475b95d80008025a072ebc5e831fc1ff961cc15884c2f95051d4e0ea8cc56"
+    "251f518cc293e9dfadb4a04cf051ea6eea66cfc01c734d506067921461ee12fe94a414a0d259a0e7d2c16ff8aa81a78504a817c80082d1"
+    "4694bbc2ae13b23d715c30720f079fcd9b4a7409350580b844095ea7b300000000000000000000000011111112542d85b3ef69ae05771c"
+    "2dccff4faa26ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff26a05458b666f973c93030ebd258fd7c1a"
+    "f6a22d0a4777c1be8938d6f709be93a7f0a066e18a04b4f6572f87e28e4042da8a1b9c3443168ea54eae93d9133a5f689fc9f8aa028504"
+    "a817c80083012dd49450d1c9771902476076ecfc8b2a83ad6b9355a4c980b844a9059cbb0000000000000000000000008d5274eb0a6787"
+    "dfcc53ba844a86d46af5ee7576000000000000000000000000000000000000000000000000382d628d82c8000025a0afff645b6f6a7736"
+    "a59f7d6d822455d9afaa3ecbfc3d8a24da9937e58348c6faa018807346002e9c62dfe72dff417300498ccbf82eb52f734d70e0be043368"
+    "b48af8ac8201ed8504a817c80083054fc39402e2151d4f351881017abdf2dd2b51150841d5b380b8447050ccd900000000000000000000"
+    "0000e65e74f39762c61ecbbeda7e65e52370b662d43e000000000000000000000000000000000000000000000000000000000000000125"
+    "a0c1c290c85da0f5fec652f8f264e727edfb3e81df30379c88070bcaa95ad86c55a035c08f6b7450513ca89b5b65e96d8dd4d3d8001b8e"
+    "42aa7be2a4e19e1131867ef9018b218504a817c800830537c4947a250d5630b4cf539739df2c5dacb4c659f2488d80b901245c11d79500"
+    "00000000000000000000000000000000000000007556a94c2dabeb2272fc89000000000000000000000000000000000000000013994082"
+    "67b2c17bdfd313b900000000000000000000000000000000000000000000000000000000000000a000000000000000000000000055458b"
+    "e48de1cafaa7b51ef69de0456d5b8b78ec0000000000000000000000000000000000000000000000000000000060bf3fee000000000000"
+    "000000000000000000000000000000000000000000000000000300000000000000000000000015874d65e649880c2614e7a480cb7c9a55"
+    "787ff6000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000000000000000000000387c291bc3274389"
+    "054e82ce81dd318a0113caf526a0b0e14c55dcdf3ba1587b2963b496648d36c3a8813a0ae2df3ce72bfd1192d2b2a01e6479cbf406bbc4"
+    "ecf6334d91dfd1c0e6bb5b031cd394f1217fa4f5730a79f5f86581b88504a817c8008252089429d09ea6cdd688cdd0b8decb0c234139f1"
+    "17fb9b808025a0ba21f0a129f12992ca303e3832431be947833c4693b7c3f289d4955c30893b81a07ee12d0fc7312ccf03d7907b02f4cd"
+    "14ca760e745a1597be13ab33c2a7cceafaf8aa0d8504a817c80083010fd194dbdb4d16eda451d0503b854cf79d55697f90c8df80b84409"
+    "5ea7b3000000000000000000000000e34b087bf3c99e664316a15b01e5295eb35127600000000000000000000000000000000000000000"
+    "fffffffffff096fb4da2000025a0276e4c8b8c3e0408867e397b052c7f3ce82a29fa93723da0d7344c24e3a7928ba02cb0d56c6a4a6079"
+    "afd266396d0d97d9d358b96a5c828d7c31ce48a121429a1bf90151038504a817c80083024477947a250d5630b4cf539739df2c5dacb4c6"
+    "59f2488d87129a7a61e6e000b8e47ff36ab5000000000000000000000000000000000000000003470897fd94e3f7e4bbeb3e0000000000"
+    "0000000000000000000000000000000000000000000000000000800000000000000000000000009a0dcb81872cd8714cf3f3152aece7da"
+    "ac7fed8a0000000000000000000000000000000000000000000000000000000060bf3dce00000000000000000000000000000000000000"
+    "00000000000000000000000002000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc200000000000000000000"
+    "0000e7537ada16f22f4dca3f3a171a65093188538f3226a07f55b09c9b087eb99c70295f8205c443122f0bb300ecd273810a8ed92d4756"
+    "8da071595fc9b5da941a7935b91e1b39c15b2d2a50f1a67f803be0f99e8d697a4a1ef88a819a8504a817c8008301c9c0949733f49d577d"
+    "a2b6705ca173382c0e3cdfff2a4880a42e1a7d4d000000000000000000000000000000000000000000000000000000000000019226a03c"
+    "cf804ddef2dd7c07c5b52e2594e98f9abd77e4d5f38fd39310276510be5600a0275e9c39fb6094cc27f1cf090c04d7e8e8b4edf83693db"
+    "ff221779bfae1a51f5f901522885049c2c06008302cba1947a250d5630b4cf539739df2c5dacb4c659f2488d880271aaccce324394b8e4"
+    "7ff36ab500000000000000000000000000000000000000000000000cd03a03baabf5ad7000000000000000000000000000000000000000"
+    "00000000000000000000000080000000000000000000000000a8eb7a85833c87b8a1729b06cebdc3154205c32e00000000000000000000"
+    "00000000000000000000000000000000000060bf3fee000000000000000000000000000000000000000000000000000000000000000200"
+    "0000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2000000000000000000000000c52c326331e9ce41f04484d3"
+    "b5e564815802880426a0d5fa105f71d4a63968fc6ba523975e3342d67d79a8bc5fb633a39a939d851116a04414bdd47f66e091ed8389c8"
+    "305e739e28d9a6df58bd4b1f0b1202f2e1cc4024f8a90285049c2c060082ed5894a0b86991c6218b36c1d19d4a2e9eb0ce3606eb4880b8"
+    "44095ea7b30000000000000000000000008df6084e3b84a65ab9dd2325b5422e5debd8944affffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffff26a03a0b22876f326df6a0b9e07eead7543d4c58f1524df87e02d99a3258a0d20d76a039b86fed9e8e"
+    "210218c6d961205cf0da3d3e09e40dbce96478535fa53dea6b23f9014a0385049c2c06008306f158948df6084e3b84a65ab9dd2325b542"
+    "2e5debd8944a80b8e40d7f0754000000000000000000000000000000000000000000000000000000000000008000000000000000000000"
+    "00000000000000000000000000000000000002faf080000000000000000000000000000000000000000000000002a5a2d16b47bde61800"
+    "0000000000000000000000000000000000000000000000000000000003d090000000000000000000000000000000000000000000000000"
+    "0000000000000002000000000000000000000000a0b86991c6218b36c1d19d4a2e9eb0ce3606eb480000000000000000000000006b1754"
+    "74e89094c44da98b954eedeac495271d0f26a048d2eaa8993008235ad5382e060eaea7a7de09e7b2b07bfa1ed261f0da39eca2a0456712"
+    "afcdd6bb2a1810fe4aa5868a58cdce8d905b98c636f384fa720ab65641f86c0785049c2c0600825208941bf6937cc2059f39a26571460f"
+    "eb4189d983fe8c880138ef09d7da63da8026a019be77014376ae8312c04ed7d42ff47c487d4828136e9dabf47c1c033e051c2da07b4764"
+    "cf56d90a2adedec424d092c5b5bbef629734aed91ee3e1fe607be9c622f9016b1c85049c2c060083031010947a250d5630b4cf539739df"
+    "2c5dacb4c659f2488d80b90104791ac9470000000000000000000000000000000000000000f3a19568e36d6171a64c0000000000000000"
+    "0000000000000000000000000000000000002501e44c90f974d20000000000000000000000000000000000000000000000000000000000"
+    "0000a0000000000000000000000000705cf78b9bd9ee562c42c5fcc58e2e6cd0fc64aa0000000000000000000000000000000000000000"
+    "000000000000000060bf3d9600000000000000000000000000000000000000000000000000000000000000020000000000000000000000"
+    "0015874d65e649880c2614e7a480cb7c9a55787ff6000000000000000000000000c02aaa39b223fe8d0a0e5c4f27ead9083c756cc225a0"
+    "899cb79f45cae28a1b47a69a2f35f2bea822d9ea95eba92cc64e656028acd7c3a0484eb541fb33d2d1d47d33b75d387fbd317039e99da4"
+    "c523135159781d1f9678f8aa1a85049bdfbac08301357594dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000"
+    "00000000000000008979d1e0ecab3cf5ae8a5a7b2d792aa119f34be1000000000000000000000000000000000000000000000000000000"
+    "0000a299a31ba03d406117e8686b7bf816ac97fb9d01a68069cda15a79c256fa7b97e754076617a00ddc76d382bd6e1646f451ed0a2d68"
+    "a2bf6e669709de97796bfa50a7082e19d5f8aa1b85049bdfbac08301357594dac17f958d2ee523a2206206994597c13d831ec780b844a9"
+    "059cbb0000000000000000000000005f2933d40b7052973497ac228d253466ec48fef40000000000000000000000000000000000000000"
+    "0000000000000001d018e4551ca0ba5e2235d47df387830c660466d3a2063328ecac2967addad45b93a55136dc94a0714ad9544366b6b4"
+    "ee0a94c065b6e4276d18c61dc0dda31462f8e5974c965a53f8a98085048a4a6b8d82df6a941f9840a85d5af5bf1d1762f925bdaddc4201"
+    "f98480b844a9059cbb0000000000000000000000002178dad8e54b40d8a76e409009b6a1712b4d2a600000000000000000000000000000"
+    "0000000000000000000010ee4f8941fa000026a0893911d7b5186a3adb639621ea4cda65778da764daeef44e6f570cd400c349eda00980"
+    "9dcc819ec9cc431c6861f74eaf91b8cd9cb70bdf0231982a9b4644f2e067f8ad83027e0585048a4a63008303d09094a0b86991c6218b36"
+    "c1d19d4a2e9eb0ce3606eb4880b844a9059cbb00000000000000000000000059a5208b32e627891c389ebafc644145224006e800000000"
+    "00000000000000000000000000000000000000000000000826299e0025a060261da5f15508d1ce20792579948123fdb79951872fe22193"
+    "b90cc24e948b2ea034f4a797aec4540361f2055ae37204350d10eeb3fad1b114160eb377ab262555f8a98085048a4a630082edbe94dac1"
+    "7f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000562680a4dc50ed2f14d75bf31f494cfe0b8d"
+    "10a10000000000000000000000000000000000000000000000000000000016c4db8025a066b4084072e772ebc18de7bedcdd4dba6c1107"
+    "29d91b676bf412eb4e04c065e8a03a11e444bbfaecec869c7db981a479f1d68c63aff76d8d55708f6bb43f604685f8a9018504e3b29200"
+    "82edbe94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000562680a4dc50ed2f14d75bf3"
+    "1f494cfe0b8d10a10000000000000000000000000000000000000000000000000000000016c4db8025a07a5d6d8fde50e5cb7b3749864a"
+    "5464a65d62b5732a003135df404e59168d75fea06b5d15a9856cbf2b434e7662daa04a002fe2f7f9afc0c2a396d920e2de71bc3df86682"
+    "45058504841efd9182afc8940000000000007f150bd6f54c40a34d7c3d5e9f5680801ba04d81dc08aef931bc1a5f43701490559f82bbfc"
+    "b5e1f838f8c3e42842e55df857a019351fb6bd5b47d294b98b9c38548cbf3f7563f89ee4bdb36390009fddb3d3ecf8668245f18504840b"
+    "85f382afc8940000000000007f150bd6f54c40a34d7c3d5e9f5680801ba00e82cc9f007bd67ada35f899646edbe29ded0bde418de2a3c2"
+    "1f9b7e008c578aa07a9b15b77872277333b4e2947ea15e063004673918b08f01768b35c79fd16f08f8ac82011685047bfc470083011170"
+    "94dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000fd5c6f4b02add34bd4f52f51c38954"
+    "4812805386000000000000000000000000000000000000000000000000000000037e11d6001ba07e4d949bd7fda1bc0bdc9d0af9fd7f63"
+    "5f704ff260b06fdace3115da45ba1f66a007160c623ad7b02ca8931cc153deca18e2ddf114682fa7ff848e718437247bd2f8ac8201a585"
+    "047bfc47008301117094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000c9b94ed82931"
+    "e9977ad48bb1e2666252f36af5b9000000000000000000000000000000000000000000000000000000019febd4801ca0094749e3101f49"
+    "53567d0c46af1d88abe277e717b955e46f5f62325432075cbaa06419675586afed015297126aa21ea68634706775a9056f83126706af23"
+    "61a49df86e8306b19c85047272df0082520894945dd0eaca3ca61a60cf61ec7939466d673a75b087031f1500e650008025a084c7d153da"
+    "7b84b863338cc4152e227bfbee605983079ca65383c05302edeb4ba00203ce199cf69b2218f034e1b0f661ecb0b2a45247fe399a948716"
+    "3cd8220384f86e8306b19d85047272df0082520894fc75e87669fccc93322c1b52b6534acb5ea7b7e187031f1500e650008026a08b5405"
+    "cabbdb811b03b1f7c4aab6c0c07acb9e29cedfb2ddfeb5b4e10be543a5a07f24c2d67f7b4de1e2e5478f80ab695da0b74e35cb7109d538"
+    "9c43a097d2f37ff8aa6285046c7d04198301388094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000"
+    "00000000004dd7f0049eccab5de2499ee9f0a5b50f4910b33200000000000000000000000000000000000000000000000000000006fc23"
+    "ac0026a059000925dd20bc24c9ce52dfb384a7fb3b3a661ab7d5d15f9193cfaf208adb09a07e18dfd935fd1548c058b7dbd07199a21f9e"
+    "2da392b7f73ca80f2d780587c1bbf8a98085046c7d041982d03294dac17f958d2ee523a2206206994597c13d831ec780b844095ea7b300"
+    "00000000000000000000008a42d311d282bfcaa5133b2de0a8bcdbecea3073ffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffff26a0ce9ad1675821aade0daec86f9344776ddaac6898c2bf20f68a32fd50c42e16bda061f1f86266ebfefdd68bbd00"
+    "eb56e985d73fc3017af69b3ac390c657bcebb0e2f8ab81d185046c7d03b38301388094dac17f958d2ee523a2206206994597c13d831ec7"
+    "80b844a9059cbb00000000000000000000000023c055f139a446a45ef2e088174cdc3f45d8f97f00000000000000000000000000000000"
+    "00000000000000000000000a39a83d4026a0824cb001ffafe011918c1d66b000fa42b27fb7540ce68f38daf7f2b721e85fd2a078d6ec7e"
+    "8b6fc2bfa03e4fd95780cbbc8612e45ee274c5c69e79fa7d74b560a0f8ab81b485046c7d03b38301388094dac17f958d2ee523a2206206"
+    "994597c13d831ec780b844a9059cbb0000000000000000000000006668a5f8eeeb6ca31c219484d9a9e01ed47cda270000000000000000"
+    "0000000000000000000000000000000000000000ed77040025a02a512fa7c2d50e7b0bb6d69b7ef5fe8e0c9ac1e023eeeb0a150f776efe"
+    "8489b2a057796baae8782c3afcf1cd14dd39ea568712ff97750fec374804864c9b600a1af8a90f85046c7d03b382c62d94dac17f958d2e"
+    "e523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000eb4969a3e424190e07dacaf478afcb6bab9d795e0000"
+    "0000000000000000000000000000000000000000000000000001c0495a4026a0b39f2e557e28e40f3e31d898d60ca0324a900546effada"
+    "8270bcc2ef4c25a5d0a06e0f20ace36038a46c7dd8c543e8ee582af6047a4ce2a30fcddf8ec99930b358f86b0485046c7d03b382520894"
+    "8b51baac7b80f02e6229fb54d0b7853f38e7877b876a94d74f4300008025a08ba2819dbcf0fc3247c48fec437782c4c54909b517731469"
+    "2fc1d2fcae7d6fc4a0685fe048b0577e3491b9a36745757be0940f9e635280dcfcdee54baaf38d94e5f9016b3385046c7d03b383024a4a"
+    "9437d7f26405103c9bc9d8f9352cf32c5b655cbe0280b9010418cbafe500000000000000000000000000000000000000000000000016e9"
+    "fa740cce0897000000000000000000000000000000000000000000000000061964c9331772c20000000000000000000000000000000000"
+    "0000000000000000000000000000a0000000000000000000000000f1b1c471d5b830805360750146af7cc2cd87279f0000000000000000"
+    "000000000000000000000000000000000000000060bf3d5d00000000000000000000000000000000000000000000000000000000000000"
+    "02000000000000000000000000da86006036540822e0cd2861dbd2fd7ff9caa0e8000000000000000000000000c02aaa39b223fe8d0a0e"
+    "5c4f27ead9083c756cc225a044c5fae326888ab629bcce814b942d98be2d30a5664697e78dd1d879d4eba54ca05ff411dcbcbd18bf0d78"
+    "b5756db9bd7c345546a63b7f93decb37b38758f813f3f86d82010085046c7d03b382520894102f69c9a410803fe0ed0737d7f0599fba63"
+    "4553870e35fa931a00008025a03de1f8800d50f91cef2854e336427f6763b5180fed1efc2bacd62014640acf7ca04c7e38e5be91c3e796"
+    "82db082594480e5746cca9059443da5f2937ea2baf5206f8aa0c85046c7d03b38301388094dac17f958d2ee523a2206206994597c13d83"
+    "1ec780b844a9059cbb0000000000000000000000002182dc672c5cfa0e883674438f75f69a870e84cc0000000000000000000000000000"
+    "0000000000000000000000000001a468aa1026a07b8c3629dca19c5a1f336a200d7b70e8dfbb686e0b4798010077a1cd7aace512a0601e"
+    "1c09c7e5b50c04268a420b6dff822a9f5886b832c80f881f3a47288c4f45f8aa3485046c7d03b38301388094dac17f958d2ee523a22062"
+    "06994597c13d831ec780b844a9059cbb0000000000000000000000002622771f6743098c9a563dd6a27aff41e850f2f700000000000000"
+    "000000000000000000000000000000000000000000eaa9da4026a0474400f594f40dad4d7a3e42a44dbe849c069f1f3d3a64b3ab02bfd9"
+    "7d26e4aca074ac9c757411d6964e58accb3e63d26ec084482f03710ae48b7d16e53ecce567f8ab81dd85046c7d03b38301388094dac17f"
+    "958d2ee523a2206206994597c13d831ec780b844a9059cbb00000000000000000000000064452a2f3af318d86d947ba33beadfe39456ed"
+    "3a00000000000000000000000000000000000000000000000000000003550087c025a0f2524b9255efbb29e5f4a8d700ed64abc2d052c4"
+    "17b62d207e0989baaddc8f73a02bee843efbb10a06cb1f0e91f1bd8c2659b160cc6b0e9efb086962f54a3e1480f8ac8201da85046c7d03"
+    "b38301388094dac17f958d2ee523a2206206994597c13d831ec780b844a9059cbb000000000000000000000000da5f5bbe50c40db6420f"
+    "063bd84f4a12906eb21b000000000000000000000000000000000000000000000000000000005bac048025a09e1a4527de5dc12c1531dd"
+    "f02792e97110aad51cd8b5d6e37b476b9fee30a0dfa013b0d2dce17b15df671c8a3b6cebf6dd7a36010758072d500bd25f06fc0af116f8"
+    "aa3e85046c7d03b38301388094a0b86991c6218b36c1d19d4a2e9eb0ce3606eb4880b844a9059cbb00000000000000000000000020f127"
+    "5222c2f38ba5acf1a4decbcf3836b9d07e00000000000000000000000000000000000000000000000000000004634f238025a02d56bced"
+    "e5d2f88e31a6e193cce0477ee90eaae40b973f0b4561168fad189564a003a763076cc37f3bd7c0578bf49c17e9c38765353bc7fdcb1c9e"
+    "7ca56bc68d00f90190818885046c7cfe0083025a0094def1c0ded9bec7f1a1670819833240f027b25eff80b90128d9627aa40000000000"
+    "00000000000000000000000000000000000000000000000000008000000000000000000000000000000000000000000000000004db7325"
+    "4763000000000000000000000000000000000000000000000000000000a6bee2f1d363a200000000000000000000000000000000000000"
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000200000000000000000000"
+    "00001494ca1f11d487c2bbe4543e90080aeba4ba3c2b000000000000000000000000eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee86"
+    "9584cd0000000000000000000000003ce37278de6388532c3949ce4e886f365b14fb560000000000000000000000000000000000000000"
+    "000000d9fdcb57c460bf387e25a06b9b826a2bd04c001796f988e89fe7ee09025fbe33c249d04cfff1155d0b1fe8a0252b469352e7928a"
+    "b3177227a815587f6ff0a85fea954fcb821a18c2d52e7ab3f86b0385046c7cfe0082520894754aa2bbfb6248f871f57ea99429a4d7f116"
+    "d76d87426387b6b5b6008025a0aa24da7cdc61bdae943549b3ee04b2908b1291735bcc002b32052383dd8ab680a0698cc7eb9d9c5eebc9"
+    "9578dc70780408ff2722c82a58f080a61ca568893d9cc8f86c8085046c7cfe0082520894588df9539c86a58e1fa3b4572c58a629912268"
+    "1e880b3a9343394f10008025a03a875173a9e5da077e24d63dd6a29b2501a1ab2eb7116bda964ad78eb0b0a242a01e95d4fbebbd88c6f3"
+    "01208678146c3416edeab6ae29936988735b7005a131d4c0";
+
+static Bytes block_12593055_rlp() { return *from_hex(std::string{kBlock12593055Part1} + kBlock12593055Part2); }
+
+static Block decode_block(ByteView encoded) {
+    Block block;
+    if (rlp::decode(encoded, block) != DecodingResult::kOk) {
+        std::abort();
+    }
+    return block;
+}
+
+static void BM_Block_Decode(benchmark::State& state) {
+    const Bytes block_rlp{block_12593055_rlp()};
+    for ([[maybe_unused]] auto _ : state) {
+        ByteView view{block_rlp};
+        Block block;
+        benchmark::DoNotOptimize(rlp::decode(view, block));
+        benchmark::DoNotOptimize(block);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * block_rlp.size()));
+}
+BENCHMARK(BM_Block_Decode);
+
+static void BM_Block_Encode(benchmark::State& state) {
+    const Bytes block_rlp{block_12593055_rlp()};
+    const Block block{decode_block(block_rlp)};
+    Bytes encoded;
+    for ([[maybe_unused]] auto _ : state) {
+        encoded.clear();
+        rlp::encode(encoded, block);
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * block_rlp.size()));
+}
+BENCHMARK(BM_Block_Encode);
+
+static void BM_Block_TransactionsRoot(benchmark::State& state) {
+    static constexpr auto kEncoder = [](Bytes& to, const Transaction& txn) {
+        rlp::encode(to, txn, /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
+    };
+    const Block block{decode_block(block_12593055_rlp())};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(trie::root_hash(block.transactions, kEncoder));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * block.transactions.size()));
+}
+BENCHMARK(BM_Block_TransactionsRoot);
+
+}  // namespace silkworm
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "block_header_view.hpp"
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+DecodingResult BlockHeaderView::parse(ByteView& from) noexcept {
+    fields_ = {};
+
+    const ByteView start{from};
+    auto [h, err]{rlp::decode_header(from)};
+    if (err != DecodingResult::kOk) {
+        return err;
+    }
+    if (!h.list) {
+        return DecodingResult::kUnexpectedString;
+    }
+    ByteView payload{from.substr(0, h.payload_length)};
+    from.remove_prefix(h.payload_length);
+    encoded_ = start.substr(0, start.length() - from.length());
+
+    size_t num_fields{0};
+    for (; num_fields < kNumFields && !payload.empty(); ++num_fields) {
+        const ByteView item{payload};
+        auto [item_h, item_err]{rlp::decode_header(payload)};
+        if (item_err != DecodingResult::kOk) {
+            return item_err;
+        }
+        if (item_h.list) {
+            return DecodingResult::kUnexpectedList;
+        }
+        payload.remove_prefix(item_h.payload_length);
+        fields_[num_fields] = item.substr(0, item.length() - payload.length());
+    }
+    if (num_fields < static_cast<size_t>(Field::kBaseFeePerGas)) {
+        return DecodingResult::kInputTooShort;
+    }
+    if (!payload.empty()) {
+        return DecodingResult::kListLengthMismatch;
+    }
+    return DecodingResult::kOk;
+}
+
+evmc::bytes32 BlockHeaderView::hash() const noexcept { return bit_cast<evmc_bytes32>(keccak256(encoded_)); }
+
+ByteView BlockHeaderView::extra_data() const noexcept {
+    ByteView item{field(Field::kExtraData)};
+    if (item.empty()) {
+        return item;
+    }
+    // Header has already been validated by parse
+    const auto [h, err]{rlp::decode_header(item)};
+    return item.substr(0, h.payload_length);
+}
+
+DecodingResult BlockHeaderView::decode(BlockHeader& to) const noexcept {
+    ByteView view{encoded_};
+    return rlp::decode(view, to);
+}
+
+}  // namespace silkworm
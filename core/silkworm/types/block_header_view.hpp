@@ -0,0 +1,90 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <array>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm {
+
+//! \brief A lazy, non-owning view on an RLP encoded block header, the header counterpart of TransactionView.
+//! Parsing only locates the RLP items of the fields: the hash is computed over the encoded bytes without re-encoding
+//! and extra data is available without copy.
+//! \remarks The view points to the encoded bytes it has been parsed from, which must outlive it
+class BlockHeaderView {
+  public:
+    enum class Field : uint8_t {
+        kParentHash,
+        kOmmersHash,
+        kBeneficiary,
+        kStateRoot,
+        kTransactionsRoot,
+        kReceiptsRoot,
+        kLogsBloom,
+        kDifficulty,
+        kNumber,
+        kGasLimit,
+        kGasUsed,
+        kTimestamp,
+        kExtraData,
+        kMixHash,
+        kNonce,
+        kBaseFeePerGas,  // EIP-1559, absent before London
+    };
+    static constexpr size_t kNumFields{static_cast<size_t>(Field::kBaseFeePerGas) + 1};
+
+    //! \brief Locates the fields of an RLP encoded header
+    //! \remarks Consumes the header from the input. Fields are only checked to be RLP strings
+    [[nodiscard]] DecodingResult parse(ByteView& from) noexcept;
+
+    //! \brief The whole RLP encoding of the header
+    [[nodiscard]] ByteView encoded() const noexcept { return encoded_; }
+
+    //! \brief The header hash (see BlockHeader::hash), i.e. keccak of encoded()
+    [[nodiscard]] evmc::bytes32 hash() const noexcept;
+
+    //! \brief The whole RLP item (header included) of a field or an empty view if the field is absent
+    [[nodiscard]] ByteView field(Field f) const noexcept { return fields_[static_cast<size_t>(f)]; }
+
+    //! \brief Decodes the RLP item of a field
+    template <class T>
+    [[nodiscard]] DecodingResult decode_field(Field f, T& to) const noexcept {
+        ByteView item{field(f)};
+        if (item.empty()) {
+            return DecodingResult::kInvalidFieldset;
+        }
+        return rlp::decode(item, to);
+    }
+
+    //! \brief The extra data as a zero-copy view
+    [[nodiscard]] ByteView extra_data() const noexcept;
+
+    //! \brief Fully decodes the header
+    [[nodiscard]] DecodingResult decode(BlockHeader& to) const noexcept;
+
+  private:
+    ByteView encoded_{};
+    std::array<ByteView, kNumFields> fields_{};
+};
+
+}  // namespace silkworm
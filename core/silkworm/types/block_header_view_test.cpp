@@ -0,0 +1,102 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "block_header_view.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+
+namespace silkworm {
+
+TEST_CASE("BlockHeaderView") {
+    BlockHeader header;
+    header.parent_hash = 0xb397a22bb95bf14753ec174f02f99df3f0bdf70d1851cdff813ebf745f5aeb55_bytes32;
+    header.ommers_hash = kEmptyListHash;
+    header.beneficiary = 0x0c729be7c39543c3d549282a40395299d987cec2_address;
+    header.state_root = 0xc2bcdfd012534fa0b19ffba5fae6fc81edd390e9b7d5007d1e92e8e835286e9d_bytes32;
+    header.transactions_root = kEmptyRoot;
+    header.receipts_root = kEmptyRoot;
+    header.difficulty = 12'555'442'155'599;
+    header.number = 13'000'013;
+    header.gas_limit = 3'141'592;
+    header.gas_used = 0;
+    header.timestamp = 1455404305;
+    header.extra_data = *from_hex("d883010a08846765746888676f312e31372e33856c696e7578");
+    header.mix_hash = 0xf0a53dfdd6c2f2a661e718ef29092de60d81d45f84044bec7bf4b36630b2bc08_bytes32;
+    header.nonce[7] = 35;
+
+    for (const bool london : {false, true}) {
+        if (london) {
+            header.base_fee_per_gas = 1'000'000'000;
+        }
+        Bytes encoded;
+        rlp::encode(encoded, header);
+        const size_t encoded_length{encoded.length()};
+        encoded.push_back(0xc0);  // Trailing data must be left over
+
+        BlockHeaderView view;
+        ByteView from{encoded};
+        REQUIRE(view.parse(from) == DecodingResult::kOk);
+        CHECK(from.length() == 1);
+
+        CHECK(view.encoded() == ByteView{encoded}.substr(0, encoded_length));
+        CHECK(view.hash() == header.hash());
+        CHECK(view.extra_data() == header.extra_data);
+        CHECK(view.extra_data().data() >= encoded.data());  // not a copy
+        CHECK(view.field(BlockHeaderView::Field::kBaseFeePerGas).empty() == !london);
+
+        uint64_t number{0};
+        REQUIRE(view.decode_field(BlockHeaderView::Field::kNumber, number) == DecodingResult::kOk);
+        CHECK(number == header.number);
+
+        BlockHeader decoded;
+        REQUIRE(view.decode(decoded) == DecodingResult::kOk);
+        CHECK(decoded == header);
+    }
+
+    SECTION("Invalid headers") {
+        BlockHeaderView view;
+
+        Bytes not_a_list{*from_hex("8400000000")};
+        ByteView from{not_a_list};
+        CHECK(view.parse(from) == DecodingResult::kUnexpectedString);
+
+        Bytes too_few_fields{*from_hex("c3010203")};
+        from = too_few_fields;
+        CHECK(view.parse(from) == DecodingResult::kInputTooShort);
+
+        Bytes list_field{*from_hex("c3c08001")};
+        from = list_field;
+        CHECK(view.parse(from) == DecodingResult::kUnexpectedList);
+
+        Bytes encoded;
+        rlp::encode(encoded, header);
+        ByteView payload{encoded};
+        const auto [h, err]{rlp::decode_header(payload)};
+        REQUIRE(err == DecodingResult::kOk);
+        Bytes too_many_fields;
+        rlp::encode_header(too_many_fields, {true, h.payload_length + 1});
+        too_many_fields.append(payload);
+        too_many_fields.push_back(0x01);
+        from = too_many_fields;
+        CHECK(view.parse(from) == DecodingResult::kListLengthMismatch);
+    }
+}
+
+}  // namespace silkworm
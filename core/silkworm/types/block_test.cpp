@@ -105,6 +105,7 @@ TEST_CASE("BlockBody RLP 2") {
 
     Bytes rlp{};
     rlp::encode(rlp, body);
+    CHECK(rlp.size() == rlp::length(body));
 
     ByteView view{rlp};
     BlockBody decoded{};
@@ -169,6 +170,11 @@ TEST_CASE("EIP-2718 Block RLP") {
 
     CHECK(block.transactions[1].type == Transaction::Type::kEip2930);
     CHECK(block.transactions[1].access_list.size() == 1);
+
+    Bytes out{};
+    rlp::encode(out, block);
+    CHECK(to_hex(out) == rlp_hex);
+    CHECK(out.size() == rlp::length(block));
 }
 
 TEST_CASE("EIP-1559 Header RLP") {
@@ -16,29 +16,125 @@
 
 #include "bloom.hpp"
 
+#include <cstring>
+#include <optional>
+
 #include <ethash/keccak.hpp>
 
 #include <silkworm/common/util.hpp>
 
 namespace silkworm {
 
-// See Section 4.3.1 "Transaction Receipt" of the Yellow Paper
-static void m3_2048(Bloom& bloom, ByteView x) {
-    ethash::hash256 hash{keccak256(x)};
-    for (unsigned i{0}; i < 6; i += 2) {
-        unsigned bit{static_cast<unsigned>(hash.bytes[i + 1] + (hash.bytes[i] << 8)) & 0x7FFu};
-        bloom[kBloomByteLength - 1 - bit / 8] |= 1 << (bit % 8);
+namespace {
+
+    // Bits set by an address or a topic, see Section 4.3.1 "Transaction Receipt" of the Yellow Paper
+    using BloomBits = std::array<uint16_t, 3>;
+
+    BloomBits m3_2048(const ethash::hash256& hash) {
+        BloomBits bits;
+        for (unsigned i{0}; i < 3; ++i) {
+            bits[i] = static_cast<uint16_t>((hash.bytes[2 * i + 1] + (hash.bytes[2 * i] << 8)) & 0x7FFu);
+        }
+        return bits;
     }
-}
+
+    void set_bits(Bloom& bloom, const BloomBits& bits) {
+        for (const uint16_t bit : bits) {
+            bloom[kBloomByteLength - 1 - bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+        }
+    }
+
+    // Direct-mapped cache of the bits of the values hashed so far. The logs of a receipt keep repeating the same
+    // contract addresses and event signatures (e.g. the Transfer topic of every token transfer): those are hashed once
+    class BloomBitsCache {
+      public:
+        const BloomBits* find(ByteView x) const {
+            const Entry& entry{entries_[slot(x)]};
+            if (entry.length != x.length() || std::memcmp(entry.value.data(), x.data(), x.length()) != 0) {
+                return nullptr;
+            }
+            return &entry.bits;
+        }
+
+        void insert(ByteView x, const BloomBits& bits) {
+            Entry& entry{entries_[slot(x)]};
+            std::memcpy(entry.value.data(), x.data(), x.length());
+            entry.length = x.length();
+            entry.bits = bits;
+        }
+
+      private:
+        static constexpr size_t kNumEntries{64};
+
+        // Trailing bytes vary the most, also amongst left-padded topics
+        static size_t slot(ByteView x) {
+            uint64_t word;
+            std::memcpy(&word, x.data() + x.length() - sizeof(word), sizeof(word));
+            return word % kNumEntries;
+        }
+
+        struct Entry {
+            std::array<uint8_t, kHashLength> value;
+            size_t length{0};  // never matches: addresses and topics are not empty
+            BloomBits bits;
+        };
+        std::array<Entry, kNumEntries> entries_{};
+    };
+
+    // Sets the bits of values into a bloom: the values not in the cache (if any) are hashed a batch at a time
+    class BloomBuilder {
+      public:
+        BloomBuilder(Bloom& bloom, BloomBitsCache* cache) : bloom_{bloom}, cache_{cache} {}
+
+        void add(ByteView x) {
+            if (cache_) {
+                if (const BloomBits* bits{cache_->find(x)}) {
+                    set_bits(bloom_, *bits);
+                    return;
+                }
+            }
+            pending_[num_pending_++] = x;
+            if (num_pending_ == kKeccakBatchSize) {
+                flush();
+            }
+        }
+
+        void flush() {
+            keccak256_batch({pending_.data(), num_pending_}, hashes_);
+            for (size_t i{0}; i < num_pending_; ++i) {
+                const BloomBits bits{m3_2048(hashes_[i])};
+                set_bits(bloom_, bits);
+                if (cache_) {
+                    cache_->insert(pending_[i], bits);
+                }
+            }
+            num_pending_ = 0;
+        }
+
+      private:
+        Bloom& bloom_;
+        BloomBitsCache* cache_;
+        std::array<ByteView, kKeccakBatchSize> pending_;
+        std::array<ethash::hash256, kKeccakBatchSize> hashes_;
+        size_t num_pending_{0};
+    };
+
+}  // namespace
 
 Bloom logs_bloom(const std::vector<Log>& logs) {
     Bloom bloom{};  // zero initialization
+    std::optional<BloomBitsCache> cache;
+    if (logs.size() > 1) {  // otherwise nothing to repeat
+        cache.emplace();
+    }
+    BloomBuilder builder{bloom, cache ? &*cache : nullptr};
     for (const Log& log : logs) {
-        m3_2048(bloom, log.address);
+        builder.add(log.address);
         for (const auto& topic : log.topics) {
-            m3_2048(bloom, topic);
+            builder.add(topic);
         }
     }
+    builder.flush();
     return bloom;
 }
 
@@ -0,0 +1,51 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/types/bloom.hpp>
+
+namespace silkworm {
+
+// Receipts of mainnet blocks hold a few logs with up to 4 topics each
+static void BM_LogsBloom(benchmark::State& state) {
+    std::mt19937_64 rng{42};
+    auto random_bytes{[&rng](uint8_t* data, size_t size) {
+        for (size_t i{0}; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(rng());
+        }
+    }};
+
+    std::vector<Log> logs(static_cast<size_t>(state.range(0)));
+    for (Log& log : logs) {
+        random_bytes(log.address.bytes, kAddressLength);
+        log.topics.resize(rng() % 5);
+        for (evmc::bytes32& topic : log.topics) {
+            random_bytes(topic.bytes, kHashLength);
+        }
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(logs_bloom(logs));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * logs.size()));
+}
+BENCHMARK(BM_LogsBloom)->Arg(1)->Arg(8)->Arg(64);
+
+}  // namespace silkworm
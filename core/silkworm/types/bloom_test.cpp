@@ -44,5 +44,16 @@ TEST_CASE("Hardcoded Bloom") {
           "000000000000000000000000000000000000000000000000000000280000000000400000800000004000000000"
           "000000000000000000000000000000000000000000000000000000000000100000100000000000000000000000"
           "00000000001400000000000000008000000000000000000000000000000000");
+
+    // Values repeated amongst logs set the same bits
+    std::vector<Log> repeated_logs{logs};
+    for (size_t i{0}; i < 100; ++i) {
+        repeated_logs.push_back(logs[i % logs.size()]);
+    }
+    CHECK(logs_bloom(repeated_logs) == bloom);
+
+    Bloom joined{logs_bloom({logs[0]})};
+    join(joined, logs_bloom({logs[1]}));
+    CHECK(joined == bloom);
 }
 }  // namespace silkworm
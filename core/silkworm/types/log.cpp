@@ -29,10 +29,7 @@ static Header header(const Log& l) {
     return h;
 }
 
-size_t length(const Log& l) {
-    Header h{header(l)};
-    return length_of_length(h.payload_length) + h.payload_length;
-}
+size_t length(const Log& l) { return item_length(header(l)); }
 
 void encode(Bytes& to, const Log& l) {
     encode_header(to, header(l));
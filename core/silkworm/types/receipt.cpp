@@ -31,11 +31,18 @@ static Header header(const Receipt& r) {
     return h;
 }
 
+// EIP-2718 receipts are prefixed by their type
+static size_t type_length(const Receipt& r) { return r.type != Transaction::Type::kLegacy ? 1 : 0; }
+
+size_t length(const Receipt& r) { return type_length(r) + item_length(header(r)); }
+
 void encode(Bytes& to, const Receipt& r) {
+    const Header h{header(r)};
+    to.reserve(to.size() + type_length(r) + item_length(h));
     if (r.type != Transaction::Type::kLegacy) {
         to.push_back(static_cast<uint8_t>(r.type));
     }
-    encode_header(to, header(r));
+    encode_header(to, h);
     encode(to, r.success);
     encode(to, r.cumulative_gas_used);
     encode(to, r.bloom);
@@ -33,6 +33,7 @@ struct Receipt {
 };
 
 namespace rlp {
+    size_t length(const Receipt&);
     void encode(Bytes& to, const Receipt&);
 }
 
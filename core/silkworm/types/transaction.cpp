@@ -30,7 +30,7 @@
 namespace silkworm {
 
 bool operator==(const Transaction& a, const Transaction& b) {
-    // from is omitted since it's derived from the signature
+    // from and non_zero_data_bytes are omitted since they're derived from the other fields
     return a.type == b.type && a.nonce == b.nonce && a.max_priority_fee_per_gas == b.max_priority_fee_per_gas &&
            a.max_fee_per_gas == b.max_fee_per_gas && a.gas_limit == b.gas_limit && a.to == b.to && a.value == b.value &&
            a.data == b.data && a.odd_y_parity == b.odd_y_parity && a.chain_id == b.chain_id && a.r == b.r &&
@@ -59,10 +59,7 @@ namespace rlp {
         return h;
     }
 
-    size_t length(const AccessListEntry& e) {
-        Header rlp_head{rlp_header(e)};
-        return length_of_length(rlp_head.payload_length) + rlp_head.payload_length;
-    }
+    size_t length(const AccessListEntry& e) { return item_length(rlp_header(e)); }
 
     void encode(Bytes& to, const AccessListEntry& e) {
         encode_header(to, rlp_header(e));
@@ -139,8 +136,8 @@ namespace rlp {
         }
     }
 
-    static void legacy_encode(Bytes& to, const Transaction& txn, bool for_signing) {
-        encode_header(to, rlp_header(txn, for_signing));
+    static void legacy_encode(Bytes& to, const Transaction& txn, const Header& rlp_head, bool for_signing) {
+        encode_header(to, rlp_head);
 
         encode(to, txn.nonce);
         encode(to, txn.max_fee_per_gas);
@@ -164,14 +161,12 @@ namespace rlp {
         }
     }
 
-    static void eip2718_encode(Bytes& to, const Transaction& txn, bool for_signing, bool wrap_into_array) {
+    static void eip2718_encode(Bytes& to, const Transaction& txn, const Header& rlp_head, bool for_signing,
+                               bool wrap_into_array) {
         assert(txn.type == Transaction::Type::kEip2930 || txn.type == Transaction::Type::kEip1559);
 
-        Header rlp_head{rlp_header(txn, for_signing)};
-
         if (wrap_into_array) {
-            auto rlp_len{static_cast<size_t>(length_of_length(rlp_head.payload_length) + rlp_head.payload_length)};
-            encode_header(to, {false, rlp_len + 1});
+            encode_header(to, {false, item_length(rlp_head) + 1});
         }
 
         to.push_back(static_cast<uint8_t>(txn.type));
@@ -203,10 +198,21 @@ namespace rlp {
     }
 
     void encode(Bytes& to, const Transaction& txn, bool for_signing, bool wrap_eip2718_into_string) {
+        // Measured once, both for the header and for a single reservation
+        const Header rlp_head{rlp_header(txn, for_signing)};
+        size_t rlp_len{item_length(rlp_head)};
+        if (txn.type != Transaction::Type::kLegacy) {
+            ++rlp_len;  // type
+            if (wrap_eip2718_into_string) {
+                rlp_len += length_of_length(rlp_len);
+            }
+        }
+        to.reserve(to.size() + rlp_len);
+
         if (txn.type == Transaction::Type::kLegacy) {
-            legacy_encode(to, txn, for_signing);
+            legacy_encode(to, txn, rlp_head, for_signing);
         } else {
-            eip2718_encode(to, txn, for_signing, wrap_eip2718_into_string);
+            eip2718_encode(to, txn, rlp_head, for_signing, wrap_eip2718_into_string);
         }
     }
 
@@ -331,6 +337,7 @@ namespace rlp {
 
     DecodingResult decode_transaction(ByteView& from, Transaction& to, Eip2718Wrapping allowed) noexcept {
         to.from.reset();
+        to.non_zero_data_bytes.reset();
 
         if (from.empty()) {
             return DecodingResult::kInputTooShort;
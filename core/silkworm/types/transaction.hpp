@@ -61,6 +61,10 @@ struct Transaction {
 
     std::optional<evmc::address> from{std::nullopt};  // sender recovered from the signature
 
+    // Non-zero bytes of data, counted once by intrinsic_gas for both validation and execution
+    // \remarks Derived like from: to be reset whenever data is changed
+    mutable std::optional<uint64_t> non_zero_data_bytes{std::nullopt};
+
     [[nodiscard]] intx::uint256 v() const;  // EIP-155
 
     //! \brief Returns false if v is not acceptable (v != 27 && v != 28 && v < 35, see EIP-155)
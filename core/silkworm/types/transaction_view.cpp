@@ -0,0 +1,225 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "transaction_view.hpp"
+
+#include <span>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+
+#include "y_parity_and_chain_id.hpp"
+
+namespace silkworm {
+
+namespace {
+
+    using Field = TransactionView::Field;
+
+    // Order of fields within the RLP list of each transaction type
+    constexpr std::array kLegacyFields{Field::kNonce, Field::kMaxFeePerGas, Field::kGasLimit, Field::kTo,
+                                       Field::kValue, Field::kData,         Field::kV,        Field::kR,
+                                       Field::kS};
+    constexpr std::array kEip2930Fields{Field::kChainId, Field::kNonce, Field::kMaxFeePerGas, Field::kGasLimit,
+                                        Field::kTo,      Field::kValue, Field::kData,         Field::kAccessList,
+                                        Field::kV,       Field::kR,     Field::kS};
+    constexpr std::array kEip1559Fields{Field::kChainId,   Field::kNonce, Field::kMaxPriorityFeePerGas,
+                                        Field::kMaxFeePerGas, Field::kGasLimit, Field::kTo,
+                                        Field::kValue,     Field::kData,  Field::kAccessList,
+                                        Field::kV,         Field::kR,     Field::kS};
+
+    // Views on all the RLP items from first to last, which are contiguous within the list
+    ByteView items_span(ByteView first, ByteView last) noexcept {
+        return {first.data(), static_cast<size_t>(last.data() + last.length() - first.data())};
+    }
+
+}  // namespace
+
+DecodingResult TransactionView::parse(ByteView& from) noexcept {
+    fields_ = {};
+
+    if (from.empty()) {
+        return DecodingResult::kInputTooShort;
+    }
+
+    ByteView payload;
+    if (0 < from[0] && from[0] < rlp::kEmptyStringCode) {  // Raw serialization of a typed transaction
+        encoded_ = from;
+        type_ = static_cast<Transaction::Type>(from[0]);
+        from.remove_prefix(1);
+        auto [h, err]{rlp::decode_header(from)};
+        if (err != DecodingResult::kOk) {
+            return err;
+        }
+        if (!h.list) {
+            return DecodingResult::kUnexpectedString;
+        }
+        payload = from.substr(0, h.payload_length);
+        from.remove_prefix(h.payload_length);
+        encoded_ = encoded_.substr(0, encoded_.length() - from.length());
+    } else {
+        const ByteView start{from};
+        auto [h, err]{rlp::decode_header(from)};
+        if (err != DecodingResult::kOk) {
+            return err;
+        }
+        if (h.list) {  // Legacy transaction
+            type_ = Transaction::Type::kLegacy;
+            payload = from.substr(0, h.payload_length);
+            from.remove_prefix(h.payload_length);
+            encoded_ = start.substr(0, start.length() - from.length());
+        } else {  // String-wrapped typed transaction
+            if (h.payload_length == 0) {
+                return DecodingResult::kInputTooShort;
+            }
+            encoded_ = from.substr(0, h.payload_length);
+            from.remove_prefix(h.payload_length);
+            type_ = static_cast<Transaction::Type>(encoded_[0]);
+            ByteView inner{encoded_.substr(1)};
+            auto [inner_h, inner_err]{rlp::decode_header(inner)};
+            if (inner_err != DecodingResult::kOk) {
+                return inner_err;
+            }
+            if (!inner_h.list) {
+                return DecodingResult::kUnexpectedString;
+            }
+            if (inner.length() != inner_h.payload_length) {
+                return DecodingResult::kListLengthMismatch;
+            }
+            payload = inner;
+        }
+    }
+
+    std::span<const Field> order;
+    switch (type_) {
+        case Transaction::Type::kLegacy:
+            order = kLegacyFields;
+            break;
+        case Transaction::Type::kEip2930:
+            order = kEip2930Fields;
+            break;
+        case Transaction::Type::kEip1559:
+            order = kEip1559Fields;
+            break;
+        default:
+            return DecodingResult::kUnsupportedTransactionType;
+    }
+
+    for (const Field f : order) {
+        const ByteView start{payload};
+        auto [h, err]{rlp::decode_header(payload)};
+        if (err != DecodingResult::kOk) {
+            return err;
+        }
+        if (h.list != (f == Field::kAccessList)) {
+            return h.list ? DecodingResult::kUnexpectedList : DecodingResult::kUnexpectedString;
+        }
+        payload.remove_prefix(h.payload_length);
+        fields_[static_cast<size_t>(f)] = start.substr(0, start.length() - payload.length());
+    }
+    if (!payload.empty()) {
+        return DecodingResult::kListLengthMismatch;
+    }
+
+    if (type_ != Transaction::Type::kEip1559) {
+        // Gas price is both the tip and the fee cap (see rlp::decode_transaction)
+        fields_[static_cast<size_t>(Field::kMaxPriorityFeePerGas)] = field(Field::kMaxFeePerGas);
+    }
+    return DecodingResult::kOk;
+}
+
+ethash::hash256 TransactionView::hash() const noexcept { return keccak256(encoded_); }
+
+ByteView TransactionView::data() const noexcept {
+    ByteView item{field(Field::kData)};
+    if (item.empty()) {
+        return item;
+    }
+    // Header has already been validated by parse
+    const auto [h, err]{rlp::decode_header(item)};
+    return item.substr(0, h.payload_length);
+}
+
+DecodingResult TransactionView::decode_signature(bool& odd_y_parity, std::optional<intx::uint256>& chain_id,
+                                                 intx::uint256& r, intx::uint256& s) const noexcept {
+    if (type_ == Transaction::Type::kLegacy) {
+        intx::uint256 v;
+        if (DecodingResult err{decode_field(Field::kV, v)}; err != DecodingResult::kOk) {
+            return err;
+        }
+        const std::optional<YParityAndChainId> parity_and_id{v_to_y_parity_and_chain_id(v)};
+        if (parity_and_id == std::nullopt) {
+            return DecodingResult::kInvalidVInSignature;
+        }
+        odd_y_parity = parity_and_id->odd;
+        chain_id = parity_and_id->chain_id;
+    } else {
+        intx::uint256 id;
+        if (DecodingResult err{decode_field(Field::kChainId, id)}; err != DecodingResult::kOk) {
+            return err;
+        }
+        chain_id = id;
+        if (DecodingResult err{decode_field(Field::kV, odd_y_parity)}; err != DecodingResult::kOk) {
+            return err;
+        }
+    }
+
+    if (DecodingResult err{decode_field(Field::kR, r)}; err != DecodingResult::kOk) {
+        return err;
+    }
+    return decode_field(Field::kS, s);
+}
+
+DecodingResult TransactionView::encode_for_signing(Bytes& to) const {
+    if (type_ == Transaction::Type::kLegacy) {
+        const ByteView fields{items_span(field(Field::kNonce), field(Field::kData))};
+        intx::uint256 v;
+        if (DecodingResult err{decode_field(Field::kV, v)}; err != DecodingResult::kOk) {
+            return err;
+        }
+        const std::optional<YParityAndChainId> parity_and_id{v_to_y_parity_and_chain_id(v)};
+        if (parity_and_id == std::nullopt) {
+            return DecodingResult::kInvalidVInSignature;
+        }
+        if (!parity_and_id->chain_id) {
+            rlp::encode_header(to, {.list = true, .payload_length = fields.length()});
+            to.append(fields);
+            return DecodingResult::kOk;
+        }
+        // EIP-155
+        const intx::uint256& chain_id{*parity_and_id->chain_id};
+        rlp::encode_header(to, {.list = true, .payload_length = fields.length() + rlp::length(chain_id) + 2});
+        to.append(fields);
+        rlp::encode(to, chain_id);
+        to.push_back(rlp::kEmptyStringCode);
+        to.push_back(rlp::kEmptyStringCode);
+        return DecodingResult::kOk;
+    }
+
+    const ByteView fields{items_span(field(Field::kChainId), field(Field::kAccessList))};
+    to.push_back(static_cast<uint8_t>(type_));
+    rlp::encode_header(to, {.list = true, .payload_length = fields.length()});
+    to.append(fields);
+    return DecodingResult::kOk;
+}
+
+DecodingResult TransactionView::decode(Transaction& to) const noexcept {
+    ByteView view{encoded_};
+    return rlp::decode_transaction(view, to, rlp::Eip2718Wrapping::kNone);
+}
+
+}  // namespace silkworm
@@ -0,0 +1,101 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include <ethash/hash_types.hpp>
+#include <intx/intx.hpp>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <silkworm/types/transaction.hpp>
+
+namespace silkworm {
+
+//! \brief A lazy, non-owning view on an RLP encoded transaction.
+//! Parsing only locates the RLP items of the fields: each field is decoded when asked for, so consumers interested in
+//! the hash or the signature never pay for decoding calldata and access lists.
+//! \remarks The view points to the encoded bytes it has been parsed from, which must outlive it
+class TransactionView {
+  public:
+    enum class Field : uint8_t {
+        kChainId,               // EIP-155 chain id of typed transactions (legacy ones carry it in V)
+        kNonce,                 //
+        kMaxPriorityFeePerGas,  // Gas price for legacy and EIP-2930 transactions
+        kMaxFeePerGas,          // Gas price for legacy and EIP-2930 transactions
+        kGasLimit,              //
+        kTo,                    // Empty string for contract creation
+        kValue,                 //
+        kData,                  //
+        kAccessList,            // EIP-2930
+        kV,                     // V for legacy transactions, Y parity for typed ones
+        kR,                     //
+        kS,                     //
+    };
+    static constexpr size_t kNumFields{static_cast<size_t>(Field::kS) + 1};
+
+    //! \brief Locates the fields of a transaction serialized either as a legacy RLP list, as a raw EIP-2718 typed
+    //! transaction or as a typed transaction wrapped into an RLP string (as in block bodies and db)
+    //! \remarks Consumes the transaction from the input. Fields are only checked to be RLP items of the expected kind
+    [[nodiscard]] DecodingResult parse(ByteView& from) noexcept;
+
+    [[nodiscard]] Transaction::Type type() const noexcept { return type_; }
+
+    //! \brief The canonical EIP-2718 serialization: the RLP list for legacy transactions, the type byte followed by
+    //! the RLP list for typed ones (i.e. never string wrapped)
+    [[nodiscard]] ByteView encoded() const noexcept { return encoded_; }
+
+    //! \brief The transaction hash, i.e. keccak of encoded()
+    [[nodiscard]] ethash::hash256 hash() const noexcept;
+
+    //! \brief The whole RLP item (header included) of a field or an empty view if the field is not part of the type
+    [[nodiscard]] ByteView field(Field f) const noexcept { return fields_[static_cast<size_t>(f)]; }
+
+    //! \brief Decodes the RLP item of a field
+    template <class T>
+    [[nodiscard]] DecodingResult decode_field(Field f, T& to) const noexcept {
+        ByteView item{field(f)};
+        if (item.empty()) {
+            return DecodingResult::kInvalidFieldset;
+        }
+        return rlp::decode(item, to);
+    }
+
+    //! \brief The calldata (or init code) as a zero-copy view
+    [[nodiscard]] ByteView data() const noexcept;
+
+    //! \brief Decodes the signature fields (see Transaction::set_v for legacy transactions)
+    [[nodiscard]] DecodingResult decode_signature(bool& odd_y_parity, std::optional<intx::uint256>& chain_id,
+                                                  intx::uint256& r, intx::uint256& s) const noexcept;
+
+    //! \brief Appends the payload to be hashed for sender recovery (see Transaction::recover_sender).
+    //! \remarks Built out of the raw encoding of the fields: only V of legacy transactions gets decoded
+    [[nodiscard]] DecodingResult encode_for_signing(Bytes& to) const;
+
+    //! \brief Fully decodes the transaction
+    [[nodiscard]] DecodingResult decode(Transaction& to) const noexcept;
+
+  private:
+    Transaction::Type type_{Transaction::Type::kLegacy};
+    ByteView encoded_{};
+    std::array<ByteView, kNumFields> fields_{};
+};
+
+}  // namespace silkworm
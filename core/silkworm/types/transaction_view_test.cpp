@@ -0,0 +1,137 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "transaction_view.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+static Transaction sample_transaction(Transaction::Type type) {
+    Transaction txn{
+        type,                                                // type
+        7,                                                   // nonce
+        10000000000,                                         // max_priority_fee_per_gas
+        30000000000,                                         // max_fee_per_gas
+        5748100,                                             // gas_limit
+        0x811a752c8cd697e3cb27279c330ed1ada745a8d7_address,  // to
+        2 * kEther,                                          // value
+        *from_hex("6ebaf477f83e051589c1188bcc6ddccd"),       // data
+        true,                                                // odd_y_parity
+        5,                                                   // chain_id
+        intx::from_string<intx::uint256>("0x36b241b061a36a32ab7fe86c7aa9eb592dd59018cd0443adc0903590c16b02b0"),  // r
+        intx::from_string<intx::uint256>("0x5edcc541b4741c5cc6dd347c5ed9577ef293a62787b4510465fadbfe39ee4094"),  // s
+    };
+    if (type != Transaction::Type::kLegacy) {
+        txn.access_list = {
+            {0xde0b295669a9fd93d5f28d9ec85e40f4cb697bae_address,
+             {0x0000000000000000000000000000000000000000000000000000000000000003_bytes32}},
+        };
+    }
+    if (type != Transaction::Type::kEip1559) {
+        txn.max_priority_fee_per_gas = txn.max_fee_per_gas;
+    }
+    return txn;
+}
+
+TEST_CASE("TransactionView") {
+    for (const auto type : {Transaction::Type::kLegacy, Transaction::Type::kEip2930, Transaction::Type::kEip1559}) {
+        Transaction txn{sample_transaction(type)};
+        Bytes canonical;
+        rlp::encode(canonical, txn, /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
+
+        for (const bool wrapped : {false, true}) {
+            Bytes encoded;
+            rlp::encode(encoded, txn, /*for_signing=*/false, wrapped);
+            encoded.push_back(0xc0);  // Trailing data must be left over
+
+            TransactionView view;
+            ByteView from{encoded};
+            REQUIRE(view.parse(from) == DecodingResult::kOk);
+            CHECK(from == ByteView{encoded}.substr(encoded.length() - 1));
+
+            CHECK(view.type() == type);
+            CHECK(view.encoded() == canonical);
+            CHECK(ByteView{view.hash().bytes, kHashLength} == ByteView{keccak256(canonical).bytes, kHashLength});
+            CHECK(view.data() == txn.data);
+
+            uint64_t nonce{0};
+            REQUIRE(view.decode_field(TransactionView::Field::kNonce, nonce) == DecodingResult::kOk);
+            CHECK(nonce == txn.nonce);
+            intx::uint256 tip;
+            REQUIRE(view.decode_field(TransactionView::Field::kMaxPriorityFeePerGas, tip) == DecodingResult::kOk);
+            CHECK(tip == txn.max_priority_fee_per_gas);
+            CHECK(view.field(TransactionView::Field::kAccessList).empty() == (type == Transaction::Type::kLegacy));
+
+            bool odd_y_parity{false};
+            std::optional<intx::uint256> chain_id;
+            intx::uint256 r, s;
+            REQUIRE(view.decode_signature(odd_y_parity, chain_id, r, s) == DecodingResult::kOk);
+            CHECK(odd_y_parity == txn.odd_y_parity);
+            CHECK(chain_id == txn.chain_id);
+            CHECK(r == txn.r);
+            CHECK(s == txn.s);
+
+            Bytes for_signing, expected_for_signing;
+            REQUIRE(view.encode_for_signing(for_signing) == DecodingResult::kOk);
+            rlp::encode(expected_for_signing, txn, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
+            CHECK(for_signing == expected_for_signing);
+
+            Transaction decoded;
+            REQUIRE(view.decode(decoded) == DecodingResult::kOk);
+            CHECK(decoded == txn);
+        }
+    }
+
+    SECTION("Pre EIP-155") {
+        Transaction txn{sample_transaction(Transaction::Type::kLegacy)};
+        txn.chain_id.reset();
+        Bytes encoded;
+        rlp::encode(encoded, txn);
+
+        TransactionView view;
+        ByteView from{encoded};
+        REQUIRE(view.parse(from) == DecodingResult::kOk);
+        Bytes for_signing, expected_for_signing;
+        REQUIRE(view.encode_for_signing(for_signing) == DecodingResult::kOk);
+        rlp::encode(expected_for_signing, txn, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
+        CHECK(for_signing == expected_for_signing);
+    }
+
+    SECTION("Malformed") {
+        TransactionView view;
+        ByteView from{};
+        CHECK(view.parse(from) == DecodingResult::kInputTooShort);
+
+        Bytes encoded;
+        rlp::encode(encoded, sample_transaction(Transaction::Type::kEip1559));
+        from = ByteView{encoded}.substr(0, encoded.length() - 1);
+        CHECK(view.parse(from) == DecodingResult::kInputTooShort);
+
+        encoded[2] = 0x03;  // Unknown type
+        from = encoded;
+        CHECK(view.parse(from) == DecodingResult::kUnsupportedTransactionType);
+
+        const Bytes short_list{*from_hex("c3010203")};
+        from = short_list;
+        CHECK(view.parse(from) == DecodingResult::kInputTooShort);
+    }
+}
+
+}  // namespace silkworm
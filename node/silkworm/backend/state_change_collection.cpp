@@ -16,6 +16,8 @@
 
 #include "state_change_collection.hpp"
 
+#include <algorithm>
+
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/base.hpp>
 #include <silkworm/common/log.hpp>
@@ -24,6 +26,71 @@
 
 namespace silkworm {
 
+namespace {
+    //! The weight of one account change in the batch size, each of its storage changes counting as one more entry.
+    std::size_t change_weight(const remote::AccountChange& account_change) {
+        return 1 + static_cast<std::size_t>(account_change.storagechanges_size());
+    }
+
+    //! Sort the account changes by address (keeping incarnations in order) and the storage changes by location.
+    void sort_changes(remote::StateChange& state_change) {
+        auto& changes = *state_change.mutable_changes();
+        std::stable_sort(changes.pointer_begin(), changes.pointer_end(), [](const auto* lhs, const auto* rhs) {
+            return rpc::address_from_H160(lhs->address()) < rpc::address_from_H160(rhs->address());
+        });
+        for (auto& account_change : changes) {
+            auto& storage_changes = *account_change.mutable_storagechanges();
+            std::sort(storage_changes.pointer_begin(), storage_changes.pointer_end(), [](const auto* lhs, const auto* rhs) {
+                return rpc::bytes32_from_H256(lhs->location()) < rpc::bytes32_from_H256(rhs->location());
+            });
+        }
+    }
+} // namespace
+
+std::vector<StateChangeBatchPtr> split_state_change_batch(remote::StateChangeBatch&& batch, std::size_t max_entries) {
+    std::vector<StateChangeBatchPtr> chunks;
+    std::shared_ptr<remote::StateChangeBatch> chunk;
+    std::size_t chunk_entries{0};
+    const auto start_chunk = [&]() {
+        if (chunk) {
+            chunks.push_back(std::move(chunk));
+        }
+        chunk = std::make_shared<remote::StateChangeBatch>();
+        chunk->set_databaseviewid(batch.databaseviewid());
+        chunk->set_pendingblockbasefee(batch.pendingblockbasefee());
+        chunk->set_blockgaslimit(batch.blockgaslimit());
+        chunk_entries = 0;
+    };
+
+    start_chunk();
+    for (auto& state_change : *batch.mutable_changebatch()) {
+        remote::StateChange* chunk_change{nullptr};
+        const auto start_chunk_change = [&]() {
+            chunk_change = chunk->add_changebatch();
+            chunk_change->set_blockheight(state_change.blockheight());
+            if (state_change.has_blockhash()) {
+                *chunk_change->mutable_blockhash() = state_change.blockhash();
+            }
+            chunk_change->set_direction(state_change.direction());
+        };
+
+        start_chunk_change();
+        chunk_change->mutable_txs()->Swap(state_change.mutable_txs());
+        for (auto& account_change : *state_change.mutable_changes()) {
+            const auto weight = change_weight(account_change);
+            if (chunk_entries > 0 && chunk_entries + weight > max_entries) {
+                start_chunk();
+                start_chunk_change();
+            }
+            // Swapping moves the change without copying its content
+            chunk_change->add_changes()->Swap(&account_change);
+            chunk_entries += weight;
+        }
+    }
+    chunks.push_back(std::move(chunk));
+    return chunks;
+}
+
 std::optional<StateChangeToken> StateChangeCollection::subscribe(StateChangeConsumer consumer, StateChangeFilter /*filter*/) {
     std::unique_lock consumers_lock{consumers_mutex_};
     StateChangeToken token = ++next_token_;
@@ -39,7 +106,7 @@ bool StateChangeCollection::unsubscribe(StateChangeToken token) {
 
 void StateChangeCollection::reset(uint64_t tx_id) {
     tx_id_ = tx_id;
-    state_changes_.clear_changebatch();
+    state_changes_.Clear();
     latest_change_ = nullptr;
     account_change_index_.clear();
     storage_change_index_.clear();
@@ -190,14 +257,21 @@ void StateChangeCollection::notify_batch(uint64_t pending_base_fee, uint64_t gas
     state_changes_.set_pendingblockbasefee(pending_base_fee);
     state_changes_.set_blockgaslimit(gas_limit);
     state_changes_.set_databaseviewid(tx_id_);
+    for (auto& state_change : *state_changes_.mutable_changebatch()) {
+        sort_changes(state_change);
+    }
+
+    // Freeze the batch chunks once and share them: consumers have independent lifecycles but never modify them
+    const auto shared_chunks = split_state_change_batch(std::move(state_changes_), kMaxStateChangeBatchEntries);
+    SILK_DEBUG << "Notify batch split in chunks=" << shared_chunks.size();
 
     std::unique_lock consumers_lock{consumers_mutex_};
-    for (const auto& [_, batch_callback] : consumers_) {
-        // Make a copy of state change batch for every consumer because lifecycle is independent
-        const std::optional<remote::StateChangeBatch> frozen_batch = state_changes_;
-        SILK_DEBUG << "Notify callback=" << &batch_callback << " batch=" << &frozen_batch;
-        batch_callback(frozen_batch);
-        SILK_DEBUG << "Notify callback=" << &batch_callback << " done";
+    for (const auto& shared_batch : shared_chunks) {
+        for (const auto& [_, batch_callback] : consumers_) {
+            SILK_DEBUG << "Notify callback=" << &batch_callback << " batch=" << shared_batch.get();
+            batch_callback(shared_batch);
+            SILK_DEBUG << "Notify callback=" << &batch_callback << " done";
+        }
     }
     reset(0);
 
@@ -208,7 +282,7 @@ void StateChangeCollection::close() {
     std::unique_lock consumers_lock{consumers_mutex_};
     for (const auto& [_, batch_callback] : consumers_) {
         SILK_DEBUG << "Notify close to callback=" << &batch_callback;
-        batch_callback(std::nullopt);
+        batch_callback(nullptr);
         SILK_DEBUG << "Notify close to callback=" << &batch_callback << " done";
     }
     reset(0);
@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 #include <evmc/evmc.hpp>
 #include <gsl/pointers>
@@ -30,7 +31,19 @@
 
 namespace silkworm {
 
-using StateChangeConsumer = std::function<void(std::optional<remote::StateChangeBatch>)>;
+//! Immutable state change batch shared by all the consumers, null when the source is closed.
+using StateChangeBatchPtr = std::shared_ptr<const remote::StateChangeBatch>;
+
+//! Called on the producer thread: it must hand the batch over to its own executor and return, without blocking.
+using StateChangeConsumer = std::function<void(StateChangeBatchPtr)>;
+
+//! The max number of account and storage changes in one notified batch: larger batches are split into chunks.
+constexpr std::size_t kMaxStateChangeBatchEntries{10'000};
+
+//! Split the batch into chunks of at most max_entries account and storage changes, each one carrying the batch
+//! metadata. The changes of one block can be split across chunks, each part carrying the block metadata and the
+//! transactions staying in the first one. An account change is never split, whatever its storage changes.
+std::vector<StateChangeBatchPtr> split_state_change_batch(remote::StateChangeBatch&& batch, std::size_t max_entries);
 
 struct StateChangeFilter {
     bool with_storage{false};
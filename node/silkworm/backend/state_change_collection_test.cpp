@@ -101,7 +101,7 @@ TEST_CASE("StateChangeCollection::notify_batch", "[silkworm][rpc][state_change_c
 
     SECTION("OK: notifies batch w/o changes to single consumer") {
         uint32_t notification_count{0};
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->databaseviewid() == 0);
@@ -114,14 +114,14 @@ TEST_CASE("StateChangeCollection::notify_batch", "[silkworm][rpc][state_change_c
 
     SECTION("OK: notifies batch w/o changes to multiple consumers") {
         uint32_t notification_count1{0}, notification_count2{0};
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->databaseviewid() == 0);
             CHECK(batch->changebatch_size() == 0);
             ++notification_count1;
         }, StateChangeFilter{});
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->databaseviewid() == 0);
@@ -131,6 +131,88 @@ TEST_CASE("StateChangeCollection::notify_batch", "[silkworm][rpc][state_change_c
         scc.notify_batch(kTestPendingBaseFee, kTestGasLimit);
         CHECK((notification_count1 == 1 && notification_count2 == 1));
     }
+
+    SECTION("OK: notifies changes sorted by address and location") {
+        const auto address1{0x00000000000000000000000000000000000000aa_address};
+        scc.subscribe([&](StateChangeBatchPtr batch) {
+            REQUIRE(batch->changebatch_size() == 1);
+            const remote::StateChange& state_change = batch->changebatch(0);
+            REQUIRE(state_change.changes_size() == 2);
+            CHECK(address_from_H160(state_change.changes(0).address()) == address1);
+            const remote::AccountChange& account_change1 = state_change.changes(1);
+            CHECK(address_from_H160(account_change1.address()) == kTestAddress);
+            REQUIRE(account_change1.storagechanges_size() == 2);
+            CHECK(bytes32_from_H256(account_change1.storagechanges(0).location()) == kTestHashedLocation1);
+            CHECK(bytes32_from_H256(account_change1.storagechanges(1).location()) == kTestHashedLocation2);
+        }, StateChangeFilter{});
+        scc.start_new_batch(kTestBlockNumber, kTestBlockHash, {}, /*unwind=*/false);
+        scc.change_storage(kTestAddress, kTestIncarnation, kTestHashedLocation2, kTestValue1);
+        scc.change_storage(kTestAddress, kTestIncarnation, kTestHashedLocation1, kTestValue2);
+        scc.change_account(address1, kTestIncarnation, kTestData1);
+        scc.notify_batch(kTestPendingBaseFee, kTestGasLimit);
+    }
+
+    SECTION("OK: notifies the same immutable batch to multiple consumers") {
+        StateChangeBatchPtr batch1, batch2;
+        scc.subscribe([&](StateChangeBatchPtr batch) { batch1 = batch; }, StateChangeFilter{});
+        scc.subscribe([&](StateChangeBatchPtr batch) { batch2 = batch; }, StateChangeFilter{});
+        scc.notify_batch(kTestPendingBaseFee, kTestGasLimit);
+        REQUIRE(batch1);
+        CHECK(batch1 == batch2);  // shared, not copied for each consumer
+        CHECK(batch1->pendingblockbasefee() == kTestPendingBaseFee);
+        scc.close();
+        CHECK((!batch1 && !batch2));  // closing notifies null
+    }
+}
+
+TEST_CASE("split_state_change_batch", "[silkworm][rpc][state_change_collection]") {
+    remote::StateChangeBatch batch;
+    batch.set_databaseviewid(kTestDatabaseViewId);
+    batch.set_pendingblockbasefee(kTestPendingBaseFee);
+    remote::StateChange* state_change = batch.add_changebatch();
+    state_change->set_blockheight(kTestBlockNumber);
+    state_change->set_allocated_blockhash(H256_from_bytes32(kTestBlockHash).release());
+    state_change->add_txs("tx");
+    for (uint64_t incarnation{1}; incarnation <= 3; ++incarnation) {
+        remote::AccountChange* account_change = state_change->add_changes();
+        account_change->set_allocated_address(H160_from_address(kTestAddress).release());
+        account_change->set_incarnation(incarnation);
+        account_change->add_storagechanges()->set_allocated_location(H256_from_bytes32(kTestHashedLocation1).release());
+    }
+
+    SECTION("OK: small batch in one chunk") {
+        const auto chunks = split_state_change_batch(std::move(batch), kMaxStateChangeBatchEntries);
+        REQUIRE(chunks.size() == 1);
+        CHECK(chunks[0]->databaseviewid() == kTestDatabaseViewId);
+        REQUIRE(chunks[0]->changebatch_size() == 1);
+        CHECK(chunks[0]->changebatch(0).txs_size() == 1);
+        CHECK(chunks[0]->changebatch(0).changes_size() == 3);
+    }
+
+    SECTION("OK: large batch split in chunks keeping block metadata") {
+        const auto chunks = split_state_change_batch(std::move(batch), /*max_entries=*/4);  // 2 entries per change
+        REQUIRE(chunks.size() == 2);
+        for (const auto& chunk : chunks) {
+            CHECK(chunk->databaseviewid() == kTestDatabaseViewId);
+            CHECK(chunk->pendingblockbasefee() == kTestPendingBaseFee);
+            REQUIRE(chunk->changebatch_size() == 1);
+            CHECK(chunk->changebatch(0).blockheight() == kTestBlockNumber);
+            CHECK(bytes32_from_H256(chunk->changebatch(0).blockhash()) == kTestBlockHash);
+        }
+        CHECK(chunks[0]->changebatch(0).txs_size() == 1);
+        CHECK(chunks[1]->changebatch(0).txs_size() == 0);
+        REQUIRE(chunks[0]->changebatch(0).changes_size() == 2);
+        REQUIRE(chunks[1]->changebatch(0).changes_size() == 1);
+        CHECK(chunks[0]->changebatch(0).changes(0).incarnation() == 1);
+        CHECK(chunks[0]->changebatch(0).changes(1).incarnation() == 2);
+        CHECK(chunks[1]->changebatch(0).changes(0).incarnation() == 3);
+    }
+
+    SECTION("OK: account change larger than chunk not split") {
+        const auto chunks = split_state_change_batch(std::move(batch), /*max_entries=*/1);
+        REQUIRE(chunks.size() == 3);
+        CHECK(chunks[2]->changebatch(0).changes(0).storagechanges_size() == 1);
+    }
 }
 
 TEST_CASE("StateChangeCollection::reset", "[silkworm][rpc][state_change_collection]") {
@@ -138,13 +220,13 @@ TEST_CASE("StateChangeCollection::reset", "[silkworm][rpc][state_change_collecti
 
     SECTION("OK: notifies batch w/o changes with expected transaction ID") {
         REQUIRE(scc.tx_id() == 0);
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->databaseviewid() == scc.tx_id());
         }, StateChangeFilter{});
         scc.notify_batch(kTestPendingBaseFee, kTestGasLimit);
         scc.reset(kTestDatabaseViewId);
         CHECK(scc.tx_id() == kTestDatabaseViewId);
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->databaseviewid() == scc.tx_id());
         }, StateChangeFilter{});
         scc.notify_batch(kTestPendingBaseFee, kTestGasLimit);
@@ -156,7 +238,7 @@ TEST_CASE("StateChangeCollection::start_new_batch", "[silkworm][rpc][state_chang
 
     SECTION("OK: one new batch in FORWARD direction") {
         scc.start_new_batch(kTestBlockNumber, kTestBlockHash, std::vector<silkworm::Bytes>{}, /*unwind=*/false);
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->databaseviewid() == 0);
@@ -171,7 +253,7 @@ TEST_CASE("StateChangeCollection::start_new_batch", "[silkworm][rpc][state_chang
 
     SECTION("OK: two new batches in FORWARD and UNWIND directions") {
         scc.start_new_batch(kTestBlockNumber, kTestBlockHash, sample_rlp_buffers(), /*unwind=*/false);
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -202,7 +284,7 @@ TEST_CASE("StateChangeCollection::change_account", "[silkworm][rpc][state_change
     StateChangeCollection scc;
 
     SECTION("OK: change one account once") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -227,7 +309,7 @@ TEST_CASE("StateChangeCollection::change_account", "[silkworm][rpc][state_change
     }
 
     SECTION("OK: change one account twice") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -260,7 +342,7 @@ TEST_CASE("StateChangeCollection::change_account", "[silkworm][rpc][state_change
     }
 
     SECTION("OK: change account after changing code") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -290,7 +372,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     StateChangeCollection scc;
 
     SECTION("OK: change code of one account once") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -315,7 +397,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     }
 
     SECTION("OK: change code of one account twice") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -348,7 +430,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     }
 
     SECTION("OK: change code after changing storage in new incarnation") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -384,7 +466,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     }
 
     SECTION("OK: change code after changing storage in same incarnation") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -413,7 +495,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     }
 
     SECTION("OK: change code after changing account in new incarnation") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -447,7 +529,7 @@ TEST_CASE("StateChangeCollection::change_code", "[silkworm][rpc][state_change_co
     }
 
     SECTION("OK: change code after changing account in same incarnation") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -478,7 +560,7 @@ TEST_CASE("StateChangeCollection::change_storage", "[silkworm][rpc][state_change
     StateChangeCollection scc;
 
     SECTION("OK: change storage of one account once") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -506,7 +588,7 @@ TEST_CASE("StateChangeCollection::change_storage", "[silkworm][rpc][state_change
     }
 
     SECTION("OK: change storage of one account twice") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->changebatch_size() == 1);
@@ -549,7 +631,7 @@ TEST_CASE("StateChangeCollection::delete_account", "[silkworm][rpc][state_change
     StateChangeCollection scc;
 
     SECTION("OK: delete one account once in forward direction") {
-        scc.subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+        scc.subscribe([&](StateChangeBatchPtr batch) {
             CHECK(batch->pendingblockbasefee() == kTestPendingBaseFee);
             CHECK(batch->blockgaslimit() == kTestGasLimit);
             CHECK(batch->databaseviewid() == 0);
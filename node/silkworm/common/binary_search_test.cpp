@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <random>
 #include <vector>
 
 #include <catch2/catch.hpp>
 #include <silkworm/common/as_range.hpp>
+#include <silkworm/common/base.hpp>
 
 namespace silkworm {
 
@@ -48,4 +50,55 @@ TEST_CASE("binary_find_if") {
     check_binary_find_if({1, 3, 3, 5}, 6);
 }
 
+TEST_CASE("StaticSortedIndex") {
+    SECTION("empty") {
+        const StaticSortedIndex<int> index;
+        CHECK(index.empty());
+        CHECK(index.lower_bound(0) == nullptr);
+        CHECK_FALSE(index.contains(0));
+        const std::vector<int> none;
+        CHECK(StaticSortedIndex<int>{none}.lower_bound(0) == nullptr);
+    }
+
+    SECTION("same as std::lower_bound") {
+        // All the shapes of the last level of the implicit tree, then a larger one
+        for (int size : {1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 31, 32, 33, 1'000}) {
+            std::vector<int> sorted;
+            for (int i{0}; i < size; ++i) {
+                sorted.push_back(2 * i + 1);  // odd, so that even probes are missing
+            }
+            const StaticSortedIndex<int> index{sorted};
+            CHECK(index.size() == sorted.size());
+            for (int probe{0}; probe <= 2 * size + 1; ++probe) {
+                const auto expected{std::lower_bound(sorted.begin(), sorted.end(), probe)};
+                const int* found{index.lower_bound(probe)};
+                if (expected == sorted.end()) {
+                    CHECK(found == nullptr);
+                } else {
+                    REQUIRE(found != nullptr);
+                    CHECK(*found == *expected);
+                }
+                CHECK(index.contains(probe) == (probe % 2 == 1 && probe < 2 * size));
+            }
+        }
+    }
+
+    SECTION("hashes") {
+        std::mt19937_64 rng{42};
+        std::vector<evmc::bytes32> hashes(10'000);
+        for (auto& hash : hashes) {
+            for (auto& byte : hash.bytes) {
+                byte = static_cast<uint8_t>(rng());
+            }
+        }
+        std::sort(hashes.begin(), hashes.end());
+        const StaticSortedIndex<evmc::bytes32> index{hashes};
+        CHECK(as_range::all_of(hashes, [&](const auto& hash) { return index.contains(hash); }));
+        evmc::bytes32 missing{hashes.front()};
+        missing.bytes[31] ^= 1;
+        CHECK(index.contains(missing) == std::binary_search(hashes.begin(), hashes.end(), missing));
+        CHECK_FALSE(index.contains(evmc::bytes32{}));  // below the smallest, with overwhelming probability
+    }
+}
+
 }  // namespace silkworm
@@ -184,7 +184,9 @@ void DataDirectory::deploy() {
     chaindata_.create();
     etl_.create();
     etl_.clear();
+    checkpoints_.create();
     nodes_.create();
+    snapshots_.create();
 }
 
 std::filesystem::path TemporaryDirectory::get_os_temporary_path() { return std::filesystem::temp_directory_path(); }
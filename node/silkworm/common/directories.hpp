@@ -83,11 +83,12 @@ class TemporaryDirectory final : public Directory {
 };
 
 //! \brief DataDirectory wraps the directory tree used by Silkworm as base storage path.
-//! A typical DataDirectory has at least 3 subdirs
+//! A typical DataDirectory has at least 4 subdirs
 //! <base_path>
 //! ├───chaindata   <-- Where main database is stored
 //! ├───etl-temp    <-- Where temporary files from etl collector are stored
-//! └───nodes       <-- Where database(s) for discovered nodes are stored
+//! ├───nodes       <-- Where database(s) for discovered nodes are stored
+//! └───snapshots   <-- Where segment files of frozen blocks are stored
 class DataDirectory final : public Directory {
   public:
     //! \brief Creates an instance of Silkworm's data directory given an initial base path
@@ -97,7 +98,9 @@ class DataDirectory final : public Directory {
         : Directory(base_path, create),
           chaindata_(base_path / "chaindata", create),
           etl_(base_path / "etl-temp", create),
-          nodes_(base_path / "nodes", create){};
+          checkpoints_(base_path / "checkpoints", create),
+          nodes_(base_path / "nodes", create),
+          snapshots_(base_path / "snapshots", create){};
 
     //! \brief Creates an instance of Silkworm's data directory starting from default storage path. (each host OS has
     //! its own)
@@ -127,7 +130,7 @@ class DataDirectory final : public Directory {
     static std::filesystem::path get_default_storage_path();
 
     //! \brief Deploys the full tree on filesystem (i.e. missing directories are created).
-    //! Etl directory gets also cleared
+    //! Etl directory gets also cleared (checkpoints one is not)
     void deploy();
 
     //! \brief DataDirectory can't be cleared
@@ -137,13 +140,19 @@ class DataDirectory final : public Directory {
     [[nodiscard]] const Directory& chaindata() const { return chaindata_; }
     //! \brief Returns the "etl" directory (where temporary etl files are stored)
     [[nodiscard]] const Directory& etl() const { return etl_; }
+    //! \brief Returns the "checkpoints" directory (where etl files of interrupted stages are kept across restarts)
+    [[nodiscard]] const Directory& checkpoints() const { return checkpoints_; }
     //! \brief Returns the "nodes" directory (where discovery nodes info are stored)
     [[nodiscard]] const Directory& nodes() const { return nodes_; }
+    //! \brief Returns the "snapshots" directory (where segment files of frozen blocks are stored)
+    [[nodiscard]] const Directory& snapshots() const { return snapshots_; }
 
   private:
-    Directory chaindata_;  // Database storage
-    Directory etl_;        // Temporary etl files
-    Directory nodes_;      // Nodes discovery databases
+    Directory chaindata_;    // Database storage
+    Directory etl_;          // Temporary etl files
+    Directory checkpoints_;  // Etl files of resumable stages
+    Directory nodes_;        // Nodes discovery databases
+    Directory snapshots_;    // Frozen blocks segments
 };
 
 }  // namespace silkworm
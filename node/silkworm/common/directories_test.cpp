@@ -77,6 +77,14 @@ TEST_CASE("DataDirectory") {
         REQUIRE(data_dir.etl().size() != 0);
         data_dir.etl().clear();
         REQUIRE(data_dir.etl().is_pristine() == true);
+
+        // Checkpoints survive a new deployment
+        {
+            std::ofstream f((data_dir.checkpoints().path() / "fake.manifest").string());
+            f << "Some fake text" << std::flush;
+        }
+        REQUIRE_NOTHROW(data_dir.deploy());
+        REQUIRE(data_dir.checkpoints().is_pristine() == false);
     }
 }
 
@@ -14,6 +14,9 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -24,6 +27,7 @@
 #include <absl/time/clock.h>
 
 #include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/spsc_ring.hpp>
 
 namespace silkworm::log {
 
@@ -32,14 +36,183 @@ static std::mutex out_mtx{};
 static std::unique_ptr<std::fstream> file_{nullptr};
 thread_local std::string thread_name_{};
 
+static void format_prefix(std::ostream& out, Level level, std::chrono::system_clock::time_point timestamp,
+                          std::string_view thread_name);
+static void write_line(std::string line, bool flush);
+
+//! A log line handed over to the background writer, which adds the prefix and does the I/O
+struct Record {
+    uint64_t sequence{0};
+    Level level{Level::kNone};
+    std::chrono::system_clock::time_point timestamp;
+    std::string thread_name;
+    std::string message;
+};
+
+//! Writes the lines pushed by the logging threads, each of them having its own SpscRing so that logging never waits
+//! on a lock nor on I/O: a line is dropped (and counted) when its thread's ring is full
+class AsyncWriter {
+  public:
+    static constexpr size_t kRingCapacity{1'024};
+    static constexpr std::chrono::milliseconds kWriteInterval{10};
+
+    AsyncWriter() : generation_{++generations_}, thread_{[this] { run(); }} {}
+    ~AsyncWriter() {
+        {
+            std::scoped_lock lock{mutex_};
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void push(Record&& record) {
+        Ring& ring{local_ring()};
+        record.sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+        if (record.level != Level::kCritical) {
+            if (!ring.try_push(std::move(record))) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        // Critical lines usually come right before an abort: they are never dropped and written before returning
+        while (!ring.try_push(std::move(record))) {
+            std::this_thread::yield();
+        }
+        flush();
+    }
+
+    void flush() {
+        const uint64_t target{next_sequence_.load(std::memory_order_relaxed)};
+        std::unique_lock lock{mutex_};
+        ++flush_requests_;
+        cv_.notify_all();
+        cv_.wait(lock, [&] { return stopping_ || processed() >= target; });
+        --flush_requests_;
+    }
+
+    [[nodiscard]] uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    using Ring = SpscRing<Record>;
+
+    Ring& local_ring() {
+        // Rings outlive their thread until drained, and a thread may have logged through a previous writer
+        thread_local std::pair<uint64_t, std::shared_ptr<Ring>> local{0, nullptr};
+        if (local.first != generation_) {
+            local = {generation_, std::make_shared<Ring>(kRingCapacity)};
+            std::scoped_lock lock{mutex_};
+            rings_.push_back(local.second);
+        }
+        return *local.second;
+    }
+
+    [[nodiscard]] uint64_t processed() const {
+        return written_.load(std::memory_order_acquire) + dropped_.load(std::memory_order_acquire);
+    }
+
+    void run() {
+        std::vector<Record> batch;
+        uint64_t reported_dropped{0};
+        bool stopping{false};
+        while (!stopping) {
+            {
+                std::unique_lock lock{mutex_};
+                cv_.wait_for(lock, kWriteInterval, [&] { return stopping_ || flush_requests_ != 0; });
+                stopping = stopping_;
+                drain(batch);
+            }
+
+            // Lines of different threads are put back in order, at least within a batch
+            std::sort(batch.begin(), batch.end(),
+                      [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+            if (!batch.empty()) {
+                std::scoped_lock out_lck{out_mtx};
+                for (const Record& record : batch) {
+                    std::stringstream ss;
+                    format_prefix(ss, record.level, record.timestamp, record.thread_name);
+                    ss << record.message;
+                    write_line(ss.str(), /*flush=*/&record == &batch.back());
+                }
+            }
+            written_.fetch_add(batch.size(), std::memory_order_release);
+            batch.clear();
+
+            if (const uint64_t dropped{dropped_.load(std::memory_order_relaxed)}; dropped != reported_dropped) {
+                std::stringstream ss;
+                format_prefix(ss, Level::kWarning, std::chrono::system_clock::now(), {});
+                ss << "Log buffers full: " << dropped - reported_dropped << " line(s) dropped";
+                std::scoped_lock out_lck{out_mtx};
+                write_line(ss.str(), /*flush=*/true);
+                reported_dropped = dropped;
+            }
+
+            { std::scoped_lock lock{mutex_}; }  // a flusher is either before its predicate check or waiting
+            cv_.notify_all();
+        }
+    }
+
+    // Must be called holding mutex_
+    void drain(std::vector<Record>& batch) {
+        Record record;
+        for (auto it{rings_.begin()}; it != rings_.end();) {
+            while ((*it)->try_pop(record)) {
+                batch.push_back(std::move(record));
+            }
+            if (it->use_count() == 1 && (*it)->empty()) {
+                it = rings_.erase(it);  // its thread is gone
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    static inline std::atomic<uint64_t> generations_{0};
+    const uint64_t generation_;
+
+    std::mutex mutex_;  // guards rings_ and the waits, never taken to push a line
+    std::condition_variable cv_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    size_t flush_requests_{0};
+    bool stopping_{false};
+
+    std::atomic<uint64_t> next_sequence_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::thread thread_;
+};
+
+static std::unique_ptr<AsyncWriter> async_writer_{nullptr};
+
+// Stops the writer at exit, after the last lines have been written: reset() clears async_writer_ before the writer
+// is destroyed, so that lines logged meanwhile go the synchronous way
+static struct AsyncWriterGuard {
+    ~AsyncWriterGuard() { async_writer_.reset(); }
+} async_writer_guard_;
+
 void init(Settings& settings) {
     settings_ = settings;
     if (!settings_.log_file.empty()) {
         tee_file(std::filesystem::path(settings.log_file));
     }
     init_terminal();
+    if (settings_.log_async && !async_writer_) {
+        async_writer_ = std::make_unique<AsyncWriter>();
+    } else if (!settings_.log_async) {
+        async_writer_.reset();
+    }
 }
 
+void flush() {
+    if (async_writer_) async_writer_->flush();
+}
+
+uint64_t dropped_lines() { return async_writer_ ? async_writer_->dropped() : 0; }
+
 void tee_file(const std::filesystem::path& path) {
     file_ = std::make_unique<std::fstream>(path.string(), std::ios::out | std::ios::app);
     if (!file_->is_open()) {
@@ -89,26 +262,57 @@ struct separate_thousands : std::numpunct<char> {
     string_type do_grouping() const override { return "\3"; } // groups of 3 digit
 };
 
-BufferBase::BufferBase(Level level) : should_print_(level <= settings_.log_verbosity) {
-    if (!should_print_) return;
-
-    if (settings_.log_thousands_sep != 0) {
-        ss_.imbue(std::locale(ss_.getloc(), new separate_thousands(settings_.log_thousands_sep)));
-    }
-
+static void format_prefix(std::ostream& out, Level level, std::chrono::system_clock::time_point timestamp,
+                          std::string_view thread_name) {
     auto [prefix, color] = get_level_settings(level);
 
     // Prefix
-    ss_ << kColorReset << " " << color << prefix << kColorReset << " ";
+    out << kColorReset << " " << color << prefix << kColorReset << " ";
 
     // TimeStamp
     static const absl::TimeZone tz{settings_.log_utc ? absl::LocalTimeZone() : absl::UTCTimeZone()};
-    absl::Time now{absl::Now()};
-    ss_ << kColorCyan << "[" << absl::FormatTime("%m-%d|%H:%M:%E3S", now, tz) << " " << tz << "] " << kColorReset;
+    const absl::Time time{absl::FromChrono(timestamp)};
+    out << kColorCyan << "[" << absl::FormatTime("%m-%d|%H:%M:%E3S", time, tz) << " " << tz << "] " << kColorReset;
 
     // ThreadId
-    if (settings_.log_threads) {
-        ss_ << "[" << get_thread_name() << "] ";
+    if (!thread_name.empty()) {
+        out << "[" << thread_name << "] ";
+    }
+}
+
+// Writes to the console and tees to the file, if any: must be called holding out_mtx
+static void write_line(std::string line, bool flush) {
+    // Pattern to identify colorization
+    static const std::regex color_pattern("(\\\x1b\\[[0-9;]{1,}m)");
+
+    bool colorized{true};
+    if (settings_.log_nocolor) {
+        line = std::regex_replace(line, color_pattern, "");
+        colorized = false;
+    }
+    auto& out = settings_.log_std_out ? std::cout : std::cerr;
+    out << line << '\n';
+    if (flush) out.flush();
+    if (file_ && file_->is_open()) {
+        if (colorized) {
+            line = std::regex_replace(line, color_pattern, "");
+        }
+        *file_ << line << '\n';
+        if (flush) file_->flush();
+    }
+}
+
+BufferBase::BufferBase(Level level) : level_(level), should_print_(level <= settings_.log_verbosity) {
+    if (!should_print_) return;
+
+    if (settings_.log_thousands_sep != 0) {
+        ss_.imbue(std::locale(ss_.getloc(), new separate_thousands(settings_.log_thousands_sep)));
+    }
+
+    timestamp_ = std::chrono::system_clock::now();
+    async_ = async_writer_ != nullptr;
+    if (!async_) {
+        format_prefix(ss_, level, timestamp_, settings_.log_threads ? get_thread_name() : std::string{});
     }
 }
 
@@ -125,24 +329,16 @@ BufferBase::BufferBase(Level level, std::string_view msg, const std::vector<std:
 void BufferBase::flush() {
     if (!should_print_) return;
 
-    // Pattern to identify colorization
-    static const std::regex color_pattern("(\\\x1b\\[[0-9;]{1,}m)");
-
-    bool colorized{true};
-    std::string line{ss_.str()};
-    if (settings_.log_nocolor) {
-        line = std::regex_replace(line, color_pattern, "");
-        colorized = false;
+    if (async_ && async_writer_) {
+        async_writer_->push({.level = level_,
+                             .timestamp = timestamp_,
+                             .thread_name = settings_.log_threads ? get_thread_name() : std::string{},
+                             .message = ss_.str()});
+        return;
     }
+
     std::unique_lock out_lck{out_mtx};
-    auto& out = settings_.log_std_out ? std::cout : std::cerr;
-    out << line << std::endl;
-    if (file_ && file_->is_open()) {
-        if (colorized) {
-            line = std::regex_replace(line, color_pattern, "");
-        }
-        *file_ << line << std::endl;
-    }
+    write_line(ss_.str(), /*flush=*/true);
 }
 
 }  // namespace silkworm::log
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <sstream>
 #include <vector>
@@ -44,6 +46,7 @@ struct Settings {
     Level log_verbosity{Level::kInfo};  // Log verbosity level
     std::string log_file;               // Log to file
     char log_thousands_sep{0};          // Thousands separator
+    bool log_async{false};              // Whether log lines are written by a background thread
 };
 
 //! \brief Initializes logging facilities
@@ -70,6 +73,13 @@ bool test_verbosity(Level level);
 //! \note This function is not thread safe as it's meant to be used at start of process and never called again
 void tee_file(const std::filesystem::path& path);
 
+//! \brief Waits for the log lines emitted so far to be written
+//! \remarks Only needed with log_async: critical lines are flushed anyway
+void flush();
+
+//! \brief Returns the number of log lines dropped because their thread's buffer was full (log_async only)
+uint64_t dropped_lines();
+
 class BufferBase {
   public:
     explicit BufferBase(Level level);
@@ -89,7 +99,10 @@ class BufferBase {
 
   protected:
     void flush();
+    const Level level_;
     const bool should_print_;
+    bool async_{false};  // the prefix is left to the background writer
+    std::chrono::system_clock::time_point timestamp_;
     std::stringstream ss_;
 };
 
@@ -16,9 +16,12 @@
 
 #include "log.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -127,4 +130,45 @@ TEST_CASE("LogBuffer", "[silkworm][common][log]") {
     }
 }
 
+TEST_CASE("Asynchronous logging", "[silkworm][common][log]") {
+    std::stringstream out;
+    StreamSwap cerr_swap{std::cerr, out};
+
+    Settings log_settings;
+    log_settings.log_nocolor = true;
+    log_settings.log_threads = true;
+    log_settings.log_async = true;
+    init(log_settings);
+
+    constexpr int kThreads{4};
+    constexpr int kLinesPerThread{100};  // within a thread buffer: nothing is dropped
+    std::vector<std::thread> threads;
+    for (int t{0}; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            set_thread_name(("logger" + std::to_string(t)).c_str());
+            for (int i{0}; i < kLinesPerThread; ++i) {
+                Info() << "line " << t << "." << i;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    flush();
+
+    const std::string content{out.str()};
+    CHECK(dropped_lines() == 0);
+    CHECK(std::count(content.begin(), content.end(), '\n') == kThreads * kLinesPerThread);
+    CHECK(content.find("[logger3] line 3.99") != std::string::npos);
+    CHECK(content.find('\x1b') == std::string::npos);
+    // Lines of a thread keep their order
+    CHECK(content.find("line 2.10") < content.find("line 2.11"));
+
+    Critical() << "written before returning";
+    CHECK(out.str().find("written before returning") != std::string::npos);
+
+    log_settings.log_async = false;  // back to synchronous logging
+    init(log_settings);
+}
+
 }  // namespace silkworm::log
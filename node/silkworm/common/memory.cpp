@@ -0,0 +1,119 @@
+/*
+    Copyright 2021 The Silkworm Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+            http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "memory.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace silkworm {
+
+static std::atomic<HugePages> huge_pages_mode{HugePages::kOff};
+
+std::optional<size_t> total_physical_memory() noexcept {
+#if defined(_WIN32)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return static_cast<size_t>(status.ullTotalPhys);
+    }
+#elif defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    const long pages{sysconf(_SC_PHYS_PAGES)};
+    const long page_size{sysconf(_SC_PAGESIZE)};
+    if (pages > 0 && page_size > 0) {
+        return static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+    }
+#endif
+    return std::nullopt;
+}
+
+void set_huge_pages(HugePages mode) noexcept { huge_pages_mode = mode; }
+
+HugePages huge_pages() noexcept { return huge_pages_mode; }
+
+#if defined(_WIN32)
+
+void* allocate_large(size_t size) { return ::operator new(size, std::align_val_t{kHugePageSize}); }
+
+void deallocate_large(void* ptr, size_t) noexcept { ::operator delete(ptr, std::align_val_t{kHugePageSize}); }
+
+bool advise_huge_pages(void*, size_t) noexcept { return false; }
+
+#else
+
+static size_t round_up_to_huge_page(size_t size) noexcept {
+    return (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+void* allocate_large(size_t size) {
+    size = round_up_to_huge_page(size);
+    const auto mode{huge_pages()};
+#if defined(MAP_HUGETLB)
+    if (mode == HugePages::kExplicit) {
+        void* ptr{::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0)};
+        if (ptr != MAP_FAILED) {
+            return ptr;
+        }
+        // Pool exhausted (or not reserved at all): fall back to transparent huge pages
+    }
+#endif
+
+    // Over-map by one huge page and trim both ends so that the block is aligned on a huge page
+    const size_t mapped_size{size + kHugePageSize};
+    void* mapped{::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    const auto mapped_begin{reinterpret_cast<uintptr_t>(mapped)};
+    const uintptr_t begin{(mapped_begin + kHugePageSize - 1) / kHugePageSize * kHugePageSize};
+    if (begin > mapped_begin) {
+        (void)::munmap(mapped, begin - mapped_begin);
+    }
+    if (const uintptr_t end{begin + size}; end < mapped_begin + mapped_size) {
+        (void)::munmap(reinterpret_cast<void*>(end), mapped_begin + mapped_size - end);
+    }
+    if (mode != HugePages::kOff) {
+        (void)advise_huge_pages(reinterpret_cast<void*>(begin), size);
+    }
+    return reinterpret_cast<void*>(begin);
+}
+
+void deallocate_large(void* ptr, size_t size) noexcept {
+    // Also unmaps explicit huge pages, whose mappings have the very same rounded size
+    (void)::munmap(ptr, round_up_to_huge_page(size));
+}
+
+bool advise_huge_pages(void* begin, size_t size) noexcept {
+#if defined(MADV_HUGEPAGE)
+    return ::madvise(begin, size, MADV_HUGEPAGE) == 0;
+#else
+    (void)begin;
+    (void)size;
+    return false;
+#endif
+}
+
+#endif
+
+}  // namespace silkworm
@@ -0,0 +1,89 @@
+/*
+    Copyright 2021 The Silkworm Authors
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+            http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace silkworm {
+
+//! \brief Total physical memory of the host in bytes, if detectable
+std::optional<size_t> total_physical_memory() noexcept;
+
+//! \brief Size of a huge page (x86-64 and arm64 default)
+inline constexpr size_t kHugePageSize{size_t{2} << 20};
+
+//! \brief How large memory blocks (see allocate_large) and the db map are backed
+enum class HugePages {
+    kOff,          // Regular pages
+    kTransparent,  // Advised as transparent huge pages (MADV_HUGEPAGE)
+    kExplicit,     // Taken from the reserved huge page pool (MAP_HUGETLB), else as transparent
+};
+
+//! \brief Sets how large memory blocks allocated from now on are backed
+void set_huge_pages(HugePages mode) noexcept;
+
+//! \brief Returns the mode set by set_huge_pages
+[[nodiscard]] HugePages huge_pages() noexcept;
+
+//! \brief Maps an anonymous block of at least size bytes, aligned on a huge page and backed as set by set_huge_pages
+//! \remarks Throws std::bad_alloc. Blocks are rounded up to huge pages: meant for sizes of kHugePageSize or more
+[[nodiscard]] void* allocate_large(size_t size);
+
+//! \brief Unmaps a block returned by allocate_large(size)
+void deallocate_large(void* ptr, size_t size) noexcept;
+
+//! \brief Advises the kernel to back [begin, begin + size) with transparent huge pages (where supported)
+//! \return Whether the advice was taken
+bool advise_huge_pages(void* begin, size_t size) noexcept;
+
+//! \brief Standard allocator placing allocations of kHugePageSize or more in allocate_large blocks
+//! \remarks Suits containers with large contiguous arrays accessed at random, e.g. the slots of hash tables, which
+//! suffer from TLB misses on regular pages. Smaller allocations go to std::allocator
+template <class T>
+class HugePageAllocator {
+  public:
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+
+    template <class U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}  // NOLINT
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n * sizeof(T) >= kHugePageSize) {
+            return static_cast<T*>(allocate_large(n * sizeof(T)));
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n * sizeof(T) >= kHugePageSize) {
+            deallocate_large(ptr, n * sizeof(T));
+        } else {
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+    }
+
+    template <class U>
+    friend bool operator==(const HugePageAllocator&, const HugePageAllocator<U>&) noexcept {
+        return true;
+    }
+};
+
+}  // namespace silkworm
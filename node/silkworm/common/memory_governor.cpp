@@ -0,0 +1,103 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "memory_governor.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace silkworm {
+
+const char* memory_tag_name(MemoryTag tag) noexcept {
+    switch (tag) {
+        case MemoryTag::kStateBuffer:
+            return "state_buffer";
+        case MemoryTag::kEtl:
+            return "etl";
+        case MemoryTag::kHeaderChain:
+            return "header_chain";
+        case MemoryTag::kDbDirtyPages:
+            return "db_dirty_pages";
+        case MemoryTag::kRpc:
+            return "rpc";
+    }
+    return "unknown";
+}
+
+MemoryGovernor& MemoryGovernor::instance() {
+    static MemoryGovernor governor;
+    return governor;
+}
+
+void MemoryGovernor::update_peak(Account& account, size_t usage) noexcept {
+    size_t peak{account.peak.load(std::memory_order_relaxed)};
+    while (usage > peak && !account.peak.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryGovernor::charge(MemoryTag tag, size_t bytes) noexcept {
+    Account& account{accounts_[index(tag)]};
+    update_peak(account, account.usage.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    total_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryGovernor::release(MemoryTag tag, size_t bytes) noexcept {
+    accounts_[index(tag)].usage.fetch_sub(bytes, std::memory_order_relaxed);
+    total_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryGovernor::set_usage(MemoryTag tag, size_t bytes) noexcept {
+    Account& account{accounts_[index(tag)]};
+    const size_t previous{account.usage.exchange(bytes, std::memory_order_relaxed)};
+    update_peak(account, bytes);
+    // Unsigned wrap-around makes this right whichever way usage went
+    total_.fetch_add(bytes - previous, std::memory_order_relaxed);
+}
+
+size_t MemoryGovernor::allowance(MemoryTag tag) const noexcept {
+    const size_t budget_bytes{budget()};
+    if (!budget_bytes) {
+        return std::numeric_limits<size_t>::max();
+    }
+    const size_t total{total_usage()};
+    const size_t own{std::min(usage(tag), total)};
+    const size_t others{total - own};
+    const size_t left{budget_bytes > others ? budget_bytes - others : 0};
+    return std::max(left, budget_bytes / kMinAllowanceDivisor);
+}
+
+std::string MemoryGovernor::to_prometheus_text() const {
+    std::ostringstream out;
+    out << "# HELP silkworm_memory_budget_bytes Memory budget shared by all subsystems (0 = none)\n"
+        << "# TYPE silkworm_memory_budget_bytes gauge\n"
+        << "silkworm_memory_budget_bytes " << budget() << "\n";
+    const auto add_family{[&](const char* name, const char* help, const auto& value_of) {
+        out << "# HELP silkworm_memory_" << name << " " << help << "\n"
+            << "# TYPE silkworm_memory_" << name << " gauge\n";
+        for (size_t i{0}; i < kMemoryTags; ++i) {
+            out << "silkworm_memory_" << name << "{subsystem=\"" << memory_tag_name(static_cast<MemoryTag>(i))
+                << "\"} " << value_of(accounts_[i]) << "\n";
+        }
+    }};
+    add_family("usage_bytes", "Memory accounted to the subsystem",
+               [](const Account& account) { return account.usage.load(std::memory_order_relaxed); });
+    add_family("peak_usage_bytes", "Highest memory accounted to the subsystem",
+               [](const Account& account) { return account.peak.load(std::memory_order_relaxed); });
+    return out.str();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,112 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace silkworm {
+
+//! \brief Subsystems whose memory is accounted (see MemoryGovernor)
+enum class MemoryTag : uint8_t {
+    kStateBuffer,    // Execution buffers of state changes (db::Buffer)
+    kEtl,            // Arena blocks and descriptors of ETL buffers (etl::Buffer)
+    kHeaderChain,    // Links of the header downloader (estimated)
+    kDbDirtyPages,   // Dirty pages of the write transaction not yet committed
+    kRpc,            // Resource quota of the gRPC server (reserved in full)
+};
+
+inline constexpr size_t kMemoryTags{5};
+
+//! \brief Name of a tag, as the value of the subsystem label of metrics
+[[nodiscard]] const char* memory_tag_name(MemoryTag tag) noexcept;
+
+//! \brief Accounts the memory held by each subsystem and shares one budget among them
+//! \remarks Subsystems either charge and release bytes as they allocate and free them, or set their usage as sampled
+//! from time to time. Those able to shrink (i.e. flushing buffers, committing) check their allowance: what the budget
+//! leaves once all other subsystems are accounted, hence growing as others shrink. All methods are thread safe and
+//! lock free
+class MemoryGovernor {
+  public:
+    //! \brief The least allowance of any subsystem, as a fraction of the budget, so that all of them make progress
+    static constexpr size_t kMinAllowanceDivisor{16};
+
+    MemoryGovernor() = default;
+
+    // Not copyable nor movable
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    //! \brief The instance shared by the whole process
+    static MemoryGovernor& instance();
+
+    //! \brief Sets the budget shared by all subsystems (0 = no budget)
+    void set_budget(size_t bytes) noexcept { budget_.store(bytes, std::memory_order_relaxed); }
+    [[nodiscard]] size_t budget() const noexcept { return budget_.load(std::memory_order_relaxed); }
+
+    //! \brief Accounts bytes newly held by a subsystem
+    void charge(MemoryTag tag, size_t bytes) noexcept;
+
+    //! \brief Accounts bytes no longer held by a subsystem (formerly charged)
+    void release(MemoryTag tag, size_t bytes) noexcept;
+
+    //! \brief Replaces the bytes accounted to a subsystem with a sampled value
+    void set_usage(MemoryTag tag, size_t bytes) noexcept;
+
+    [[nodiscard]] size_t usage(MemoryTag tag) const noexcept {
+        return accounts_[index(tag)].usage.load(std::memory_order_relaxed);
+    }
+
+    //! \brief Highest usage of a subsystem so far
+    [[nodiscard]] size_t peak_usage(MemoryTag tag) const noexcept {
+        return accounts_[index(tag)].peak.load(std::memory_order_relaxed);
+    }
+
+    //! \brief Usage of all subsystems together
+    [[nodiscard]] size_t total_usage() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+    //! \brief Whether a budget is set and overall usage exceeds it
+    [[nodiscard]] bool over_budget() const noexcept {
+        const size_t budget_bytes{budget()};
+        return budget_bytes && total_usage() > budget_bytes;
+    }
+
+    //! \brief The most a subsystem may hold, given what all the others hold now
+    //! \return SIZE_MAX without a budget, otherwise never less than budget / kMinAllowanceDivisor
+    [[nodiscard]] size_t allowance(MemoryTag tag) const noexcept;
+
+    //! \brief Renders budget, usage and peak usage of each subsystem in Prometheus text exposition format
+    [[nodiscard]] std::string to_prometheus_text() const;
+
+  private:
+    struct Account {
+        std::atomic<size_t> usage{0};
+        std::atomic<size_t> peak{0};
+    };
+
+    static size_t index(MemoryTag tag) noexcept { return static_cast<size_t>(tag); }
+    static void update_peak(Account& account, size_t usage) noexcept;
+
+    std::atomic<size_t> budget_{0};
+    std::atomic<size_t> total_{0};
+    std::array<Account, kMemoryTags> accounts_{};
+};
+
+}  // namespace silkworm
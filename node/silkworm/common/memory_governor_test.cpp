@@ -0,0 +1,70 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "memory_governor.hpp"
+
+#include <limits>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("MemoryGovernor") {
+    MemoryGovernor governor;
+
+    SECTION("Accounting") {
+        governor.charge(MemoryTag::kEtl, 100);
+        governor.charge(MemoryTag::kEtl, 50);
+        governor.release(MemoryTag::kEtl, 120);
+        governor.set_usage(MemoryTag::kStateBuffer, 1'000);
+        governor.set_usage(MemoryTag::kStateBuffer, 400);
+        CHECK(governor.usage(MemoryTag::kEtl) == 30);
+        CHECK(governor.peak_usage(MemoryTag::kEtl) == 150);
+        CHECK(governor.usage(MemoryTag::kStateBuffer) == 400);
+        CHECK(governor.peak_usage(MemoryTag::kStateBuffer) == 1'000);
+        CHECK(governor.total_usage() == 430);
+
+        const auto text{governor.to_prometheus_text()};
+        CHECK(text.find("silkworm_memory_usage_bytes{subsystem=\"etl\"} 30\n") != std::string::npos);
+        CHECK(text.find("silkworm_memory_peak_usage_bytes{subsystem=\"state_buffer\"} 1000\n") != std::string::npos);
+    }
+
+    SECTION("No budget") {
+        governor.set_usage(MemoryTag::kHeaderChain, 1'000'000);
+        CHECK_FALSE(governor.over_budget());
+        CHECK(governor.allowance(MemoryTag::kStateBuffer) == std::numeric_limits<size_t>::max());
+    }
+
+    SECTION("Shared budget") {
+        governor.set_budget(1'600);
+        governor.set_usage(MemoryTag::kStateBuffer, 500);
+        governor.set_usage(MemoryTag::kHeaderChain, 300);
+        CHECK_FALSE(governor.over_budget());
+        CHECK(governor.allowance(MemoryTag::kStateBuffer) == 1'300);
+        CHECK(governor.allowance(MemoryTag::kEtl) == 800);
+
+        // Others growing shrink the allowance, down to a minimum share
+        governor.set_usage(MemoryTag::kHeaderChain, 1'500);
+        CHECK(governor.over_budget());
+        CHECK(governor.allowance(MemoryTag::kStateBuffer) == 100);
+        CHECK(governor.allowance(MemoryTag::kEtl) == 1'600 / MemoryGovernor::kMinAllowanceDivisor);
+
+        governor.set_usage(MemoryTag::kHeaderChain, 0);
+        CHECK(governor.allowance(MemoryTag::kStateBuffer) == 1'600);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,48 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "resource_usage.hpp"
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace silkworm {
+
+ResourceUsage process_resource_usage() noexcept {
+    ResourceUsage usage;
+#if !defined(_WIN32)
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        const auto to_duration{[](const timeval& tv) {
+            return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+        }};
+        usage.cpu_time = to_duration(ru.ru_utime) + to_duration(ru.ru_stime);
+        usage.minor_page_faults = static_cast<uint64_t>(ru.ru_minflt);
+        usage.major_page_faults = static_cast<uint64_t>(ru.ru_majflt);
+        usage.block_inputs = static_cast<uint64_t>(ru.ru_inblock);
+        usage.block_outputs = static_cast<uint64_t>(ru.ru_oublock);
+#if defined(__APPLE__)
+        usage.peak_resident_bytes = static_cast<uint64_t>(ru.ru_maxrss);  // bytes
+#else
+        usage.peak_resident_bytes = static_cast<uint64_t>(ru.ru_maxrss) * 1024;  // kilobytes
+#endif
+    }
+#endif
+    return usage;
+}
+
+}  // namespace silkworm
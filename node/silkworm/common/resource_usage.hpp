@@ -0,0 +1,46 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace silkworm {
+
+//! \brief Resources consumed by the whole process (all threads) since its start
+struct ResourceUsage {
+    std::chrono::microseconds cpu_time{0};  // User + system
+    uint64_t minor_page_faults{0};          // Served without I/O (e.g. page cache hits of mapped files)
+    uint64_t major_page_faults{0};          // Requiring I/O
+    uint64_t block_inputs{0};               // File system input operations
+    uint64_t block_outputs{0};              // File system output operations
+    uint64_t peak_resident_bytes{0};        // High-water mark of resident memory (mapped db pages included)
+
+    //! \brief Returns what has been consumed between earlier and this sample
+    //! \remarks The peak of resident memory is not a consumption: the one of this sample is kept
+    [[nodiscard]] ResourceUsage operator-(const ResourceUsage& earlier) const noexcept {
+        return {cpu_time - earlier.cpu_time, minor_page_faults - earlier.minor_page_faults,
+                major_page_faults - earlier.major_page_faults, block_inputs - earlier.block_inputs,
+                block_outputs - earlier.block_outputs, peak_resident_bytes};
+    }
+};
+
+//! \brief Samples resources consumed by the process so far
+//! \remarks All zeroes where not supported (i.e. Windows)
+ResourceUsage process_resource_usage() noexcept;
+
+}  // namespace silkworm
@@ -0,0 +1,41 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "resource_usage.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Process resource usage") {
+    const auto before{process_resource_usage()};
+
+    volatile uint64_t sink{0};
+    for (uint64_t i{0}; i < 10'000'000; ++i) {
+        sink = sink + i;
+    }
+
+    const auto after{process_resource_usage()};
+    const auto delta{after - before};
+    CHECK(after.cpu_time >= before.cpu_time);
+    CHECK(delta.cpu_time == after.cpu_time - before.cpu_time);
+    CHECK(after.minor_page_faults >= before.minor_page_faults);
+    CHECK(delta.minor_page_faults == after.minor_page_faults - before.minor_page_faults);
+    CHECK(after.peak_resident_bytes >= before.peak_resident_bytes);
+    CHECK(delta.peak_resident_bytes == after.peak_resident_bytes);
+}
+
+}  // namespace silkworm
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #ifdef __APPLE__
 // otherwise <boost/asio/detail/socket_types.hpp> dependency doesn't compile
@@ -28,8 +30,10 @@
 #include <silkworm/chain/config.hpp>
 #include <silkworm/common/base.hpp>
 #include <silkworm/common/directories.hpp>
+#include <silkworm/common/memory.hpp>
 #include <silkworm/db/mdbx.hpp>
 #include <silkworm/db/prune_mode.hpp>
+#include <silkworm/etl/util.hpp>
 
 namespace silkworm {
 
@@ -41,6 +45,9 @@ struct NodeSettings {
     std::optional<ChainConfig> chain_config;               // Chain config
     size_t batch_size{512_Mebi};                           // Batch size to use in stages
     size_t etl_buffer_size{256_Mebi};                      // Buffer size for ETL operations
+    etl::Compression etl_compression{};                    // Compression of ETL files (none by default)
+    std::vector<std::filesystem::path> etl_extra_paths{};  // More dirs ETL files are striped across (devices)
+    size_t etl_memory_budget{0};                           // Memory shared by live ETL collectors (0 = none)
     std::string private_api_addr{"127.0.0.1:9090"};        // Default API listener
     std::string sentry_api_addr{};                         // Default address(es) of sentry
     bool fake_pow{false};                                  // Whether to verify Proof-of-Work (PoW)
@@ -48,6 +55,23 @@ struct NodeSettings {
     std::unique_ptr<db::PruneMode> prune_mode;             // Prune mode
     uint32_t sync_loop_throttle_seconds{0};                // Minimum interval amongst sync cycle
     uint32_t sync_loop_log_interval_seconds{30};           // Interval for sync loop to emit logs
+    std::string sync_loop_metrics_file{};                  // Prometheus text file of stage metrics (empty = off)
+    std::string preverified_hashes_file{};                 // Binary file of pre-verified hashes (empty = embedded)
+    uint32_t sync_loop_tip_latency_ms{0};                  // Max delay coalescing new headers at tip (0 = off)
+    db::CommitPolicy commit_policy{};                      // When stages commit (by default on each request)
+    uint32_t execution_profile_interval{0};                // Sample one EVM instruction every N (0 = no profiling)
+    size_t precompile_cache_size{0};                       // Max cached precompile results (0 = no caching)
+    bool execution_state_root{false};                      // Whether Execution verifies state root of each block
+    size_t execution_state_filter_bits{0};                 // Bits per key of Execution PlainState filter (0 = off)
+    size_t execution_state_cache_size{0};                  // Max accounts (and slots) Execution keeps warm (0 = off)
+    std::string execution_import_chaindata{};              // Trusted db Execution imports state from (empty = off)
+    BlockNum execution_import_height{0};                   // Block whose state is imported (executing from next)
+    std::string execution_import_snapshot{};               // State snapshot dir Execution imports from (empty = off)
+    std::optional<uint32_t> numa_node{std::nullopt};       // NUMA node stage threads are pinned to (none = off)
+    HugePages huge_pages{HugePages::kOff};                 // Huge pages backing db map and large buffers
+    bool dense_canonical_hashes{false};                    // Whether all canonical hashes are kept in memory
+    size_t memory_budget{0};                               // Memory shared by subsystems (0 = no budget)
+    bool history_index_deltas{false};                      // Whether history index appends deltas at chain tip
 };
 
 }  // namespace silkworm
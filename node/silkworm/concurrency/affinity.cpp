@@ -0,0 +1,102 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "affinity.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace silkworm {
+
+static std::mutex affinity_mutex;
+static std::vector<unsigned> affinity_cpus;  // Guarded by affinity_mutex
+
+static std::optional<unsigned> parse_cpu(std::string_view str) {
+    unsigned cpu{0};
+    const auto [ptr, ec]{std::from_chars(str.data(), str.data() + str.length(), cpu)};
+    if (ec != std::errc{} || ptr != str.data() + str.length()) {
+        return std::nullopt;
+    }
+    return cpu;
+}
+
+std::optional<std::vector<unsigned>> parse_cpu_list(std::string_view list) {
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+
+    std::vector<unsigned> cpus;
+    while (!list.empty()) {
+        const auto comma{list.find(',')};
+        const auto item{list.substr(0, comma)};
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        const auto dash{item.find('-')};
+        const auto first{parse_cpu(item.substr(0, dash))};
+        const auto last{dash == std::string_view::npos ? first : parse_cpu(item.substr(dash + 1))};
+        if (!first || !last || *first > *last) {
+            return std::nullopt;
+        }
+        for (unsigned cpu{*first}; cpu <= *last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<unsigned> numa_node_cpus(unsigned node) {
+    std::ifstream file{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+    std::string list;
+    if (!file || !std::getline(file, list)) {
+        return {};
+    }
+    return parse_cpu_list(list).value_or(std::vector<unsigned>{});
+}
+
+void set_threads_affinity(std::vector<unsigned> cpus) {
+    std::unique_lock lock{affinity_mutex};
+    affinity_cpus = std::move(cpus);
+}
+
+bool apply_thread_affinity() noexcept {
+    std::unique_lock lock{affinity_mutex};
+    if (affinity_cpus.empty()) {
+        return true;
+    }
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const auto cpu : affinity_cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    return false;  // Not supported
+#endif
+}
+
+}  // namespace silkworm
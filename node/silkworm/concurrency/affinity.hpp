@@ -0,0 +1,40 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace silkworm {
+
+//! \brief Parses a Linux CPU list (e.g. "0-3,8,10-11") into the sorted CPU numbers it lists
+//! \return The CPU numbers or std::nullopt if list is malformed
+std::optional<std::vector<unsigned>> parse_cpu_list(std::string_view list);
+
+//! \brief Returns the CPUs of a NUMA node (empty if there's no such node or topology is not detectable)
+std::vector<unsigned> numa_node_cpus(unsigned node);
+
+//! \brief Sets the CPUs the threads of Worker and thread_pool instances started from now on are pinned to
+//! \remarks Memory those threads first touch (ETL buffers, MDBX pages faulted in) is then allocated by the OS on the
+//! NUMA node of those CPUs. An empty set disables pinning
+void set_threads_affinity(std::vector<unsigned> cpus);
+
+//! \brief Pins the calling thread to the CPUs set by set_threads_affinity, if any
+//! \return False if pinning is set but could not be applied
+bool apply_thread_affinity() noexcept;
+
+}  // namespace silkworm
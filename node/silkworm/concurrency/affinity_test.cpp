@@ -0,0 +1,56 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "affinity.hpp"
+
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Parse CPU list") {
+    CHECK(parse_cpu_list("") == std::vector<unsigned>{});
+    CHECK(parse_cpu_list("5\n") == std::vector<unsigned>{5});
+    CHECK(parse_cpu_list("0-3,8,10-11") == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(parse_cpu_list("8,0-1,1") == std::vector<unsigned>{0, 1, 8});
+
+    CHECK_FALSE(parse_cpu_list("3-1"));
+    CHECK_FALSE(parse_cpu_list("0,,2"));
+    CHECK_FALSE(parse_cpu_list("a-b"));
+}
+
+TEST_CASE("Thread affinity") {
+    SECTION("No pinning") {
+        set_threads_affinity({});
+        CHECK(apply_thread_affinity());
+    }
+
+#if defined(__linux__)
+    SECTION("Pin to NUMA node 0") {
+        const auto cpus{numa_node_cpus(0)};
+        if (!cpus.empty()) {
+            set_threads_affinity(cpus);
+            bool pinned{false};
+            std::thread thread{[&pinned] { pinned = apply_thread_affinity(); }};
+            thread.join();
+            CHECK(pinned);
+            set_threads_affinity({});
+        }
+    }
+#endif
+}
+
+}  // namespace silkworm
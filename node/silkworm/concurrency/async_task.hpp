@@ -0,0 +1,88 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <silkworm/concurrency/coroutine.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <silkworm/concurrency/task_scheduler.hpp>
+
+namespace silkworm {
+
+namespace detail {
+    template <typename R>
+    struct AsyncRunSignature {
+        using type = void(std::exception_ptr, R);
+    };
+    template <>
+    struct AsyncRunSignature<void> {
+        using type = void(std::exception_ptr);
+    };
+}  // namespace detail
+
+//! \brief Runs a blocking function (a DB scan, an ETL flush...) on the scheduler and resumes the awaiting coroutine on
+//! its own executor with the result, or the exception thrown. The thread running the coroutine is free meanwhile, so a
+//! single thread can interleave many coroutines waiting on blocking work
+//! \remarks A non-void result must be default constructible
+template <typename F, typename R = std::invoke_result_t<F&>>
+boost::asio::awaitable<R> async_run(TaskScheduler& scheduler, F func,
+                                    TaskScheduler::Priority priority = TaskScheduler::Priority::kNormal) {
+    using Signature = typename detail::AsyncRunSignature<R>::type;
+    auto executor = co_await boost::asio::this_coro::executor;
+
+    co_return co_await boost::asio::async_initiate<decltype(boost::asio::use_awaitable), Signature>(
+        [&](auto handler) {
+            // The scheduler takes copyable tasks while the handler is move-only
+            auto shared_handler = std::make_shared<decltype(handler)>(std::move(handler));
+            scheduler.post(
+                [func = std::move(func), shared_handler, executor]() mutable {
+                    std::exception_ptr exception;
+                    if constexpr (std::is_void_v<R>) {
+                        try {
+                            func();
+                        } catch (...) {
+                            exception = std::current_exception();
+                        }
+                        boost::asio::post(executor, [shared_handler, exception]() { (*shared_handler)(exception); });
+                    } else {
+                        R result{};
+                        try {
+                            result = func();
+                        } catch (...) {
+                            exception = std::current_exception();
+                        }
+                        boost::asio::post(executor, [shared_handler, exception, result = std::move(result)]() mutable {
+                            (*shared_handler)(exception, std::move(result));
+                        });
+                    }
+                },
+                priority);
+        },
+        boost::asio::use_awaitable);
+}
+
+}  // namespace silkworm
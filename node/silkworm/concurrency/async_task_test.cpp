@@ -0,0 +1,78 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "async_task.hpp"
+
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_future.hpp>
+
+namespace silkworm {
+
+using namespace boost::asio;
+
+TEST_CASE("async_run") {
+    TaskScheduler scheduler{2};
+    io_context context;
+
+    SECTION("result") {
+        const auto context_thread = std::this_thread::get_id();
+        auto task = co_spawn(
+            context,
+            [&]() -> awaitable<int> {
+                const int result = co_await async_run(scheduler, [] { return 123; });
+                CHECK(std::this_thread::get_id() == context_thread);  // resumed on the context
+                co_return result;
+            },
+            use_future);
+        context.run();
+        CHECK(task.get() == 123);
+    }
+
+    SECTION("interleaved coroutines") {
+        int completed{0};
+        for (int i = 0; i < 4; ++i) {
+            co_spawn(
+                context,
+                [&]() -> awaitable<void> {
+                    co_await async_run(scheduler, [] { std::this_thread::sleep_for(std::chrono::milliseconds(10)); });
+                    ++completed;  // always on the context thread
+                },
+                detached);
+        }
+        context.run();
+        CHECK(completed == 4);
+    }
+
+    SECTION("exception") {
+        auto task = co_spawn(
+            context,
+            [&]() -> awaitable<int> {
+                co_return co_await async_run(scheduler, []() -> int { throw std::runtime_error("failed"); });
+            },
+            use_future);
+        context.run();
+        CHECK_THROWS_AS(task.get(), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,91 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "auto_reset_event.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#endif
+
+namespace silkworm {
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+              "futex word must be a plain 32 bit integer");
+
+static void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) noexcept {
+    const auto seconds{std::chrono::duration_cast<std::chrono::seconds>(timeout)};
+    timespec relative_timeout{};
+    relative_timeout.tv_sec = static_cast<time_t>(seconds.count());
+    relative_timeout.tv_nsec = static_cast<long>((timeout - seconds).count());
+    // Returns at once if word no longer holds expected: no wake-up can be lost in between
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &relative_timeout,
+                  nullptr, 0);
+}
+
+static void futex_wake_one(std::atomic<uint32_t>& word) noexcept {
+    (void)syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void AutoResetEvent::notify() noexcept {
+    if (state_.exchange(1) == 0 && waiters_.load() != 0) {
+        futex_wake_one(state_);
+    }
+}
+
+bool AutoResetEvent::wait_for(std::chrono::milliseconds timeout) noexcept {
+    const auto deadline{std::chrono::steady_clock::now() + timeout};
+    while (!try_wait()) {
+        const auto now{std::chrono::steady_clock::now()};
+        if (now >= deadline) {
+            return false;
+        }
+        waiters_.fetch_add(1);
+        futex_wait(state_, /*expected=*/0, deadline - now);
+        waiters_.fetch_sub(1);
+    }
+    return true;
+}
+
+#else
+
+void AutoResetEvent::notify() noexcept {
+    if (state_.exchange(1) == 0 && waiters_.load() != 0) {
+        // Taking the mutex orders this notification after the waiter has checked state_ and gone to sleep
+        std::scoped_lock lock{mutex_};
+        cv_.notify_one();
+    }
+}
+
+bool AutoResetEvent::wait_for(std::chrono::milliseconds timeout) noexcept {
+    if (try_wait()) {
+        return true;
+    }
+    std::unique_lock lock{mutex_};
+    waiters_.fetch_add(1);
+    const bool notified{cv_.wait_for(lock, timeout, [this] { return try_wait(); })};
+    waiters_.fetch_sub(1);
+    return notified;
+}
+
+#endif
+
+}  // namespace silkworm
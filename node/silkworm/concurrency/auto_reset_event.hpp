@@ -0,0 +1,64 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if !defined(__linux__)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace silkworm {
+
+//! \brief Wake-up flag for one waiting thread: notify() sets it, a wait consumes it. Notifying with nobody waiting
+//! costs a single atomic exchange; waiting sleeps on a futex (Linux) hence no mutex is ever taken by either side
+//! \remarks Elsewhere a mutex and a condition variable back the sleep, still only touched when someone is waiting
+class AutoResetEvent {
+  public:
+    AutoResetEvent() = default;
+
+    // Not copyable nor movable
+    AutoResetEvent(const AutoResetEvent&) = delete;
+    AutoResetEvent& operator=(const AutoResetEvent&) = delete;
+
+    //! \brief Sets the event, waking up the waiting thread if any
+    void notify() noexcept;
+
+    //! \brief Consumes the event if set, without waiting
+    //! \return Whether the event was set
+    bool try_wait() noexcept { return state_.exchange(0, std::memory_order_acquire) != 0; }
+
+    //! \brief Waits for the event to be set and consumes it
+    //! \return Whether the event has been set before timeout expired
+    bool wait_for(std::chrono::milliseconds timeout) noexcept;
+
+    //! \brief Clears the event
+    void reset() noexcept { state_.store(0, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint32_t> state_{0};    // 1 when set. Futex word on Linux
+    std::atomic<uint32_t> waiters_{0};  // Number of threads sleeping (or about to) on state_
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+};
+
+}  // namespace silkworm
@@ -0,0 +1,63 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "auto_reset_event.hpp"
+
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("AutoResetEvent") {
+    AutoResetEvent event;
+
+    SECTION("Set and consume") {
+        CHECK_FALSE(event.try_wait());
+        CHECK_FALSE(event.wait_for(1ms));
+        event.notify();
+        event.notify();  // Not counted
+        CHECK(event.wait_for(1ms));
+        CHECK_FALSE(event.try_wait());
+        event.notify();
+        event.reset();
+        CHECK_FALSE(event.try_wait());
+    }
+
+    SECTION("Wake up waiting thread") {
+        constexpr int kRounds{10'000};
+        std::atomic_int consumed{0};
+        std::thread waiter{[&] {
+            while (consumed < kRounds) {
+                if (event.wait_for(1s)) {
+                    ++consumed;
+                }
+            }
+        }};
+        for (int i{0}; i < kRounds; ++i) {
+            while (consumed < i) {
+                std::this_thread::yield();
+            }
+            event.notify();
+        }
+        waiter.join();
+        CHECK(consumed == kRounds);
+    }
+}
+
+}  // namespace silkworm
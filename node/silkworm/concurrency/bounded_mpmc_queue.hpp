@@ -0,0 +1,237 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+/** BoundedMpmcQueue is a lock-free multi-producer multi-consumer queue on a ring of sequenced cells (D. Vyukov):
+ *  producers only contend on the enqueue index and consumers on the dequeue one, each cell being handed over by its
+ *  own sequence number. Waiting for an element, or for room when the queue is full, is done on condition variables
+ *  that are only touched when somebody is actually waiting, so that the push and pop fast paths never take a lock.
+ *  Same interface as ThreadSafeQueue, see ConcurrentQueue.
+ */
+template <typename T>
+class BoundedMpmcQueue {
+  public:
+    static constexpr std::size_t kDefaultCapacity{1 << 16};
+
+    //! The capacity is rounded up to a power of 2
+    explicit BoundedMpmcQueue(std::size_t capacity = kDefaultCapacity)
+        : mask_(std::bit_ceil(std::max(capacity, std::size_t{2})) - 1), cells_(new Cell[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedMpmcQueue() {
+        const std::size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+        for (std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos) {
+            element(cells_[pos & mask_])->~T();
+        }
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    //! Push, waiting for room if the queue is full
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    //! Push if there is room, without waiting
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    bool try_pop(T& popped_value) {
+        if (!try_pop_element(popped_value)) {
+            return false;
+        }
+        notify(push_waiters_, not_full_);
+        return true;
+    }
+
+    void wait_and_pop(T& popped_value) {
+        if (spin_pop(popped_value)) {
+            return;
+        }
+        {
+            std::unique_lock lock{mutex_};
+            Waiting waiting{pop_waiters_};
+            not_empty_.wait(lock, [&] { return try_pop_element(popped_value); });
+        }
+        notify(push_waiters_, not_full_);
+    }
+
+    template <typename Duration>
+    bool timed_wait_and_pop(T& popped_value, Duration const& wait_duration) {
+        if (spin_pop(popped_value)) {
+            return true;
+        }
+        {
+            std::unique_lock lock{mutex_};
+            Waiting waiting{pop_waiters_};
+            if (!not_empty_.wait_for(lock, wait_duration, [&] { return try_pop_element(popped_value); })) {
+                return false;
+            }
+        }
+        notify(push_waiters_, not_full_);
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    //! Exact when idle, approximate while pushed or popped concurrently
+    [[nodiscard]] size_t size() const {
+        const std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const std::size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? std::min(enqueue_pos - dequeue_pos, capacity()) : 0;
+    }
+
+    [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+  private:
+    static constexpr std::size_t kCacheLineSize{64};
+    static constexpr int kSpinCount{64};
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    //! Registers a waiter for the time of a wait, made visible to the notifiers before the wait predicate is checked
+    struct Waiting {
+        explicit Waiting(std::atomic<std::size_t>& waiters) : waiters_(waiters) {
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Waiting() { waiters_.fetch_sub(1, std::memory_order_relaxed); }
+        std::atomic<std::size_t>& waiters_;
+    };
+
+    // Tries a few times before having to wait: under load the element is usually about to come
+    bool spin_pop(T& popped_value) {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (try_pop(popped_value)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    static T* element(Cell& cell) { return std::launder(reinterpret_cast<T*>(cell.storage)); }
+
+    template <typename U>
+    void emplace(U&& value) {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (try_emplace(std::forward<U>(value))) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock lock{mutex_};
+            Waiting waiting{push_waiters_};
+            not_full_.wait(lock, [&] { return try_emplace_element(std::forward<U>(value)); });
+        }
+        notify(pop_waiters_, not_empty_);
+    }
+
+    template <typename U>
+    bool try_emplace(U&& value) {
+        if (!try_emplace_element(std::forward<U>(value))) {
+            return false;
+        }
+        notify(pop_waiters_, not_empty_);
+        return true;
+    }
+
+    // The value is only consumed on success
+    template <typename U>
+    bool try_emplace_element(U&& value) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (difference == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (cell.storage) T(std::forward<U>(value));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop_element(T& popped_value) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (difference == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    T* stored = element(cell);
+                    popped_value = std::move(*stored);
+                    stored->~T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Must not be called holding mutex_. The fence pairs with the one of Waiting: either the waiter sees the change
+    // in its predicate, or the notifier sees the waiter
+    void notify(const std::atomic<std::size_t>& waiters, std::condition_variable& condition_variable) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        { std::scoped_lock lock{mutex_}; }  // the waiter is either before its predicate check or waiting
+        condition_variable.notify_one();
+    }
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+
+    alignas(kCacheLineSize) std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::atomic<std::size_t> pop_waiters_{0};
+    std::atomic<std::size_t> push_waiters_{0};
+};
@@ -0,0 +1,151 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bounded_mpmc_queue.hpp"
+
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/thread_safe_queue.hpp>
+
+namespace silkworm {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("BoundedMpmcQueue") {
+    SECTION("FIFO up to the capacity") {
+        BoundedMpmcQueue<int> queue{3};
+        CHECK(queue.capacity() == 4);
+        CHECK(queue.empty());
+
+        for (int i = 0; i < 4; ++i) CHECK(queue.try_push(i));
+        CHECK_FALSE(queue.try_push(4));
+        CHECK(queue.size() == 4);
+
+        int value{-1};
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_pop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(queue.try_pop(value));
+        CHECK(queue.empty());
+    }
+
+    SECTION("timed wait") {
+        BoundedMpmcQueue<int> queue{2};
+        int value{-1};
+        CHECK_FALSE(queue.timed_wait_and_pop(value, 10ms));
+
+        std::thread producer{[&] {
+            std::this_thread::sleep_for(10ms);
+            queue.push(42);
+        }};
+        CHECK(queue.timed_wait_and_pop(value, 10s));
+        CHECK(value == 42);
+        producer.join();
+    }
+
+    SECTION("push waits for room") {
+        BoundedMpmcQueue<int> queue{2};
+        queue.push(1);
+        queue.push(2);
+        std::thread producer{[&] { queue.push(3); }};
+
+        int value{-1};
+        std::this_thread::sleep_for(10ms);
+        queue.wait_and_pop(value);
+        CHECK(value == 1);
+        producer.join();
+        CHECK(queue.size() == 2);
+    }
+
+    SECTION("elements left are destroyed") {
+        auto element = std::make_shared<int>(1);
+        {
+            BoundedMpmcQueue<std::shared_ptr<int>> queue{4};
+            queue.push(element);
+            queue.push(element);
+            CHECK(element.use_count() == 3);
+        }
+        CHECK(element.use_count() == 1);
+    }
+
+    SECTION("many producers and consumers") {
+        constexpr int kThreads{4};
+        constexpr int kPerThread{20'000};
+        BoundedMpmcQueue<int> queue{64};  // small, to have producers waiting for room
+
+        std::vector<long> sums(kThreads, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 1; i <= kPerThread; ++i) queue.push(i);
+            });
+            threads.emplace_back([&, t] {
+                int value{0};
+                for (int i = 0; i < kPerThread; ++i) {
+                    queue.wait_and_pop(value);
+                    sums[static_cast<size_t>(t)] += value;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        const long expected = kThreads * (static_cast<long>(kPerThread) * (kPerThread + 1) / 2);
+        CHECK(std::accumulate(sums.begin(), sums.end(), 0L) == expected);
+        CHECK(queue.empty());
+    }
+}
+
+// Micro-benchmark against ThreadSafeQueue, not run by default: use the [.benchmark] tag to run it
+template <typename Queue>
+static double transfers_per_second(Queue& queue, int threads_per_side, int per_thread) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_per_side; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < per_thread; ++i) queue.push(i);
+        });
+        threads.emplace_back([&] {
+            int value{0};
+            for (int i = 0; i < per_thread; ++i) queue.wait_and_pop(value);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads_per_side * per_thread / elapsed.count();
+}
+
+TEST_CASE("BoundedMpmcQueue vs ThreadSafeQueue", "[.benchmark]") {
+    constexpr int kPerThread{1'000'000};
+    for (int threads_per_side : {1, 2, 4}) {
+        ThreadSafeQueue<int> locked_queue;
+        BoundedMpmcQueue<int> lock_free_queue;
+        const double locked = transfers_per_second(locked_queue, threads_per_side, kPerThread);
+        const double lock_free = transfers_per_second(lock_free_queue, threads_per_side, kPerThread);
+        log::Info("Queue benchmark", {"producers/consumers", std::to_string(threads_per_side),
+                                      "ThreadSafeQueue ops/s", std::to_string(static_cast<long>(locked)),
+                                      "BoundedMpmcQueue ops/s", std::to_string(static_cast<long>(lock_free))});
+    }
+}
+
+}  // namespace silkworm
@@ -20,8 +20,8 @@
  * Decisions about concurrent containers
  */
 
-#include <silkworm/concurrency/thread_safe_queue.hpp>
+#include <silkworm/concurrency/bounded_mpmc_queue.hpp>
 
+// Lock-free on push and pop, bounded: push waits for room when full
 template <typename T>
-using ConcurrentQueue =
-    ThreadSafeQueue<T>;  // todo: use a better alternative from a known library (Intel oneTBB concurrent_queue<T>?)
+using ConcurrentQueue = BoundedMpmcQueue<T>;
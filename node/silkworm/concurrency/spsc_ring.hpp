@@ -0,0 +1,87 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/** SpscRing is a lock-free bounded ring for exactly one producer thread and one consumer thread: each side owns its
+ *  index and only reads the other one, refreshing its cached copy of it when the ring looks full (resp. empty).
+ *  Neither side ever waits: try_push fails when the ring is full and try_pop when it is empty.
+ *  T must be default constructible and move assignable.
+ */
+template <typename T>
+class SpscRing {
+  public:
+    //! The capacity is rounded up to a power of 2
+    explicit SpscRing(std::size_t capacity)
+        : mask_(std::bit_ceil(std::max(capacity, std::size_t{2})) - 1), slots_(new T[mask_ + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    //! Producer side only. The value is only consumed on success
+    bool try_push(T&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;  // full
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Consumer side only
+    bool try_pop(T& popped_value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;  // empty
+            }
+        }
+        popped_value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Exact from either side when the other one is idle
+    [[nodiscard]] bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+  private:
+    static constexpr std::size_t kCacheLineSize{64};
+
+    const std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};  // written by the consumer
+    std::size_t cached_tail_{0};                                 // consumer's copy of tail_
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};  // written by the producer
+    std::size_t cached_head_{0};                                 // producer's copy of head_
+};
@@ -0,0 +1,82 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "spsc_ring.hpp"
+
+#include <string>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("SpscRing") {
+    SECTION("FIFO up to the capacity") {
+        SpscRing<int> ring{3};
+        CHECK(ring.capacity() == 4);
+        CHECK(ring.empty());
+
+        for (int i = 0; i < 4; ++i) CHECK(ring.try_push(int{i}));
+        CHECK_FALSE(ring.try_push(4));
+
+        int value{-1};
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(ring.try_pop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(ring.try_pop(value));
+        CHECK(ring.empty());
+
+        for (int i = 4; i < 7; ++i) CHECK(ring.try_push(int{i}));  // wrapping around
+        REQUIRE(ring.try_pop(value));
+        CHECK(value == 4);
+    }
+
+    SECTION("value kept on failed push") {
+        SpscRing<std::string> ring{2};
+        CHECK(ring.try_push("a"));
+        CHECK(ring.try_push("b"));
+        std::string value{"c"};
+        CHECK_FALSE(ring.try_push(std::move(value)));
+        CHECK(value == "c");
+    }
+
+    SECTION("one producer and one consumer") {
+        constexpr int kCount{100'000};
+        SpscRing<int> ring{64};
+
+        std::thread producer{[&] {
+            for (int i = 0; i < kCount; ++i) {
+                while (!ring.try_push(int{i})) std::this_thread::yield();
+            }
+        }};
+
+        int expected{0};
+        int value{-1};
+        while (expected < kCount) {
+            if (ring.try_pop(value)) {
+                REQUIRE(value == expected);
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        CHECK(ring.empty());
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,176 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "task_scheduler.hpp"
+
+#include <string>
+#include <utility>
+
+#include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/affinity.hpp>
+
+namespace silkworm {
+
+// The scheduler and the index of the worker running on this thread, if any
+static thread_local const TaskScheduler* current_scheduler{nullptr};
+static thread_local std::size_t current_index{0};
+
+TaskScheduler::TaskScheduler(std::size_t num_threads) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    workers_.reserve(num_threads);
+    for (std::size_t i{0}; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(num_threads);
+    for (std::size_t i{0}; i < num_threads; ++i) {
+        threads_.emplace_back([this, i] { work(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::scoped_lock lock{sleep_mutex_};
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+std::size_t TaskScheduler::current_worker() const {
+    return current_scheduler == this ? current_index : kNoWorker;
+}
+
+void TaskScheduler::post(Task task, Priority priority) {
+    std::size_t index{current_worker()};
+    if (index == kNoWorker) {
+        index = next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    }
+    Worker& worker{*workers_[index]};
+    {
+        std::scoped_lock lock{worker.mutex};
+        worker.deques[static_cast<std::size_t>(priority)].push_back(std::move(task));
+    }
+    queued_.fetch_add(1);
+    {
+        std::scoped_lock lock{sleep_mutex_};  // a worker is either before its check of queued_ or sleeping
+    }
+    wakeup_.notify_one();
+}
+
+bool TaskScheduler::take_task(std::size_t self, Task& task) {
+    for (std::size_t priority{0}; priority < kNumPriorities; ++priority) {
+        if (self != kNoWorker) {
+            Worker& worker{*workers_[self]};
+            std::scoped_lock lock{worker.mutex};
+            auto& deque{worker.deques[priority]};
+            if (!deque.empty()) {
+                task = std::move(deque.back());
+                deque.pop_back();
+                return true;
+            }
+        }
+        const std::size_t start{self == kNoWorker ? 0 : self + 1};
+        for (std::size_t i{0}; i < workers_.size(); ++i) {
+            const std::size_t victim{(start + i) % workers_.size()};
+            if (victim == self) {
+                continue;
+            }
+            Worker& worker{*workers_[victim]};
+            std::scoped_lock lock{worker.mutex};
+            auto& deque{worker.deques[priority]};
+            if (!deque.empty()) {
+                task = std::move(deque.front());
+                deque.pop_front();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::run_one() {
+    Task task;
+    if (!take_task(current_worker(), task)) {
+        return false;
+    }
+    queued_.fetch_sub(1);
+    task();
+    return true;
+}
+
+void TaskScheduler::work(std::size_t index) {
+    current_scheduler = this;
+    current_index = index;
+    log::set_thread_name(("tasks-" + std::to_string(index)).c_str());
+    (void)apply_thread_affinity();
+
+    while (true) {
+        if (run_one()) {
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex_};
+        wakeup_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+TaskGroup::~TaskGroup() {
+    wait_no_throw();
+}
+
+void TaskGroup::run(TaskScheduler::Task task) {
+    pending_.fetch_add(1);
+    scheduler_.post(
+        [this, task = std::move(task)] {
+            try {
+                task();
+            } catch (...) {
+                std::scoped_lock lock{exception_mutex_};
+                if (!exception_) {
+                    exception_ = std::current_exception();
+                }
+            }
+            pending_.fetch_sub(1);  // the group may be gone right after this
+        },
+        priority_);
+}
+
+void TaskGroup::wait() {
+    wait_no_throw();
+    std::scoped_lock lock{exception_mutex_};
+    if (exception_) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+}
+
+void TaskGroup::wait_no_throw() {
+    while (pending_.load() > 0) {
+        if (!scheduler_.run_one()) {
+            std::this_thread::yield();  // the last tasks are running on other threads
+        }
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,144 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace silkworm {
+
+/** TaskScheduler is a work-stealing executor meant to be shared by the whole node (see shared()), so that stages,
+ *  ETL, trie computation and downloader decoding share the cores instead of each one oversubscribing them with its
+ *  own threads. Each worker thread has its own deques, one per priority: tasks posted from a task go to the deque of
+ *  the worker running it and are taken back LIFO (cache-hot), while idle workers steal FIFO from the others.
+ *  Tasks posted from outside are spread round-robin. Higher priority tasks are always taken first.
+ *  Tasks posted with post() must not throw: use a TaskGroup to get exceptions back.
+ */
+class TaskScheduler {
+  public:
+    using Task = std::function<void()>;
+
+    enum class Priority : uint8_t {
+        kHigh,    // on the critical path of the sync
+        kNormal,  // background work
+    };
+    static constexpr std::size_t kNumPriorities{2};
+
+    explicit TaskScheduler(std::size_t num_threads = std::thread::hardware_concurrency());
+
+    //! Runs the tasks still queued, then joins the threads
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    //! The scheduler shared by the whole node, with one thread per hardware thread, started on first use
+    static TaskScheduler& shared();
+
+    void post(Task task, Priority priority = Priority::kNormal);
+
+    //! Runs a queued task on the calling thread, if any: this is how waiting threads help instead of blocking
+    bool run_one();
+
+    //! Calls loop(begin, end) on chunks of [first, last) of at least grain_size indices and waits for all of them
+    //! \remarks A few chunks per thread are made, so that faster threads steal from the slower ones
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, const F& loop, std::size_t grain_size = 1,
+                      Priority priority = Priority::kNormal);
+
+    [[nodiscard]] std::size_t num_threads() const { return workers_.size(); }
+
+  private:
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<Task>, kNumPriorities> deques;
+    };
+
+    static constexpr std::size_t kNoWorker{SIZE_MAX};
+    static constexpr std::size_t kChunksPerThread{4};
+
+    void work(std::size_t index);
+    bool take_task(std::size_t self, Task& task);
+    [[nodiscard]] std::size_t current_worker() const;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_worker_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wakeup_;
+    std::atomic<std::size_t> queued_{0};
+    bool stopping_{false};  // guarded by sleep_mutex_
+};
+
+//! Tasks run together and waited for together. The first exception thrown by a task is rethrown by wait().
+class TaskGroup {
+  public:
+    explicit TaskGroup(TaskScheduler& scheduler, TaskScheduler::Priority priority = TaskScheduler::Priority::kNormal)
+        : scheduler_(scheduler), priority_(priority) {}
+
+    //! Waits for the tasks still running, any exception is lost
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(TaskScheduler::Task task);
+
+    //! Waits for all the tasks, running queued tasks meanwhile: nested groups cannot deadlock
+    void wait();
+
+  private:
+    void wait_no_throw();
+
+    TaskScheduler& scheduler_;
+    TaskScheduler::Priority priority_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+};
+
+template <typename F>
+void TaskScheduler::parallel_for(std::size_t first, std::size_t last, const F& loop, std::size_t grain_size,
+                                 Priority priority) {
+    if (first >= last) {
+        return;
+    }
+    const std::size_t num_chunks{num_threads() * kChunksPerThread};
+    const std::size_t chunk_size{std::max(grain_size, (last - first + num_chunks - 1) / num_chunks)};
+
+    TaskGroup group{*this, priority};
+    for (std::size_t begin{first}; begin < last;) {
+        const std::size_t end{last - begin > chunk_size ? begin + chunk_size : last};
+        group.run([&loop, begin, end] { loop(begin, end); });
+        begin = end;
+    }
+    group.wait();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,91 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "task_scheduler.hpp"
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("TaskScheduler") {
+    TaskScheduler scheduler{4};
+    CHECK(scheduler.num_threads() == 4);
+
+    SECTION("posted tasks run") {
+        std::atomic<int> count{0};
+        TaskGroup group{scheduler};
+        for (int i = 0; i < 1'000; ++i) {
+            group.run([&] { ++count; });
+        }
+        group.wait();
+        CHECK(count == 1'000);
+    }
+
+    SECTION("parallel for") {
+        std::vector<int> values(10'007, 1);
+        std::atomic<std::size_t> calls{0};
+        scheduler.parallel_for(0, values.size(), [&](std::size_t begin, std::size_t end) {
+            ++calls;
+            for (std::size_t i = begin; i < end; ++i) values[i] *= 2;
+        });
+        CHECK(std::accumulate(values.begin(), values.end(), 0) == 2 * 10'007);
+        CHECK(calls == 4 * 4);  // a few chunks per thread
+
+        calls = 0;
+        scheduler.parallel_for(0, 100, [&](std::size_t, std::size_t) { ++calls; }, /*grain_size=*/50);
+        CHECK(calls == 2);
+        scheduler.parallel_for(5, 5, [&](std::size_t, std::size_t) { ++calls; });
+        CHECK(calls == 2);
+    }
+
+    SECTION("nested groups") {
+        std::atomic<int> count{0};
+        scheduler.parallel_for(0, 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                scheduler.parallel_for(0, 16, [&](std::size_t b, std::size_t e) { count += static_cast<int>(e - b); });
+            }
+        });
+        CHECK(count == 16 * 16);
+    }
+
+    SECTION("exceptions") {
+        TaskGroup group{scheduler, TaskScheduler::Priority::kHigh};
+        group.run([] { throw std::runtime_error("task failed"); });
+        group.run([] {});
+        CHECK_THROWS_AS(group.wait(), std::runtime_error);
+        group.wait();  // rethrown once
+    }
+
+    SECTION("run by the waiting thread") {
+        TaskScheduler single{1};
+        std::atomic<bool> release{false};
+        single.post([&] {
+            while (!release) std::this_thread::yield();
+        });
+        std::atomic<int> count{0};
+        TaskGroup group{single};
+        group.run([&] { ++count; });
+        group.run([&] { release = true; });
+        group.wait();  // the only worker is busy: helped by this thread
+        CHECK(count == 1);
+    }
+}
+
+}  // namespace silkworm
@@ -36,6 +36,8 @@
 
 #include <boost/thread/thread.hpp>  // boost::thread
 
+#include <silkworm/concurrency/affinity.hpp>  // silkworm::apply_thread_affinity
+
 namespace silkworm {
 
 // ============================================================================================= //
@@ -377,9 +379,11 @@ class thread_pool {
 
     /**
      * @brief A worker function to be assigned to each thread in the pool. Continuously pops tasks out of the queue and
-     * executes them, as long as the atomic variable running is set to true.
+     * executes them, as long as the atomic variable running is set to true. The thread is first pinned to the CPUs
+     * set through set_threads_affinity (if any).
      */
     void worker() {
+        (void)apply_thread_affinity();
         while (running_) {
             std::function<void()> task;
             if (!paused && pop_task(task)) {
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/affinity.hpp>
 
 namespace silkworm {
 
@@ -31,13 +32,18 @@ void Worker::start(bool wait) {
     }
 
     exception_ptr_ = nullptr;
-    kicked_.store(false);
+    kick_event_.reset();
 
     thread_ = std::make_unique<std::thread>([&]() {
         log::set_thread_name(name_.c_str());
+        if (!apply_thread_affinity()) {
+            log::Warning(name_, {"affinity", "unable to pin thread"});
+        }
         State expected_starting{State::kStarting};
         if (state_.compare_exchange_strong(expected_starting, State::kStarted)) {
-            signal_worker_started(this);
+            if (on_worker_started) {
+                on_worker_started(this);
+            }
             try {
                 work();
             } catch (const std::exception& ex) {
@@ -46,7 +52,9 @@ void Worker::start(bool wait) {
             }
         }
         state_.store(State::kStopped);
-        signal_worker_stopped(this);
+        if (on_worker_stopped) {
+            on_worker_stopped(this);
+        }
     });
 
     while (wait) {
@@ -69,14 +77,10 @@ void Worker::stop(bool wait) {
     }
 }
 
-void Worker::kick() {
-    kicked_.store(true);
-    kicked_cv_.notify_all();
-}
+void Worker::kick() { kick_event_.notify(); }
 
 bool Worker::wait_for_kick(uint32_t timeout_milliseconds) {
-    bool expected_kicked_value{true};
-    while (!kicked_.compare_exchange_strong(expected_kicked_value, false)) {
+    while (!kick_event_.try_wait()) {
         auto current_state{get_state()};
         if (current_state == Worker::State::kStarted) {
             state_.store(Worker::State::kKickWaiting);
@@ -84,12 +88,12 @@ bool Worker::wait_for_kick(uint32_t timeout_milliseconds) {
             break;
         }
         if (timeout_milliseconds) {
-            std::unique_lock l(kick_mtx_);
-            (void)kicked_cv_.wait_for(l, std::chrono::milliseconds(timeout_milliseconds));
+            if (kick_event_.wait_for(std::chrono::milliseconds(timeout_milliseconds))) {
+                break;
+            }
         } else {
             std::this_thread::yield();
         }
-        expected_kicked_value = true;
     }
 
     if (is_stopping()) {
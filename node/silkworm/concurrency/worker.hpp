@@ -17,12 +17,11 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <thread>
 
-#include <boost/signals2/signal.hpp>
-
+#include <silkworm/concurrency/auto_reset_event.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
 
 namespace silkworm {
@@ -61,11 +60,13 @@ class Worker {
     //! \brief Rethrows captured exception (if any)
     void rethrow();
 
-    //! \brief Signals connected handlers the underlying thread is about to start
-    boost::signals2::signal<void(Worker* sender)> signal_worker_started;
+    //! \brief Called on the underlying thread when it's about to start
+    //! \remarks Set it before start(): it's invoked with no synchronization
+    std::function<void(Worker* sender)> on_worker_started;
 
-    //! \brief Signals connected handlers the underlying thread is terminated
-    boost::signals2::signal<void(Worker* sender)> signal_worker_stopped;
+    //! \brief Called on the underlying thread when it's terminated
+    //! \remarks Set it before start(): it's invoked with no synchronization
+    std::function<void(Worker* sender)> on_worker_stopped;
 
   protected:
     /**
@@ -74,12 +75,10 @@ class Worker {
      * Returns True if the kick has been received and should go ahead
      * otherwise False (i.e. the thread has been asked to stop)
      *
-     * @param [in] timeout: Timeout for conditional variable wait (milliseconds). Defaults to 100 ms
+     * @param [in] timeout: Timeout for each wait on the kick event (milliseconds). Defaults to 100 ms
      */
     bool wait_for_kick(uint32_t timeout_milliseconds = 100);  // Puts a thread in non-busy wait for data to process
-    std::atomic_bool kicked_{false};                          // Whether the kick has been received
-    std::condition_variable kicked_cv_{};                     // Condition variable to wait for kick
-    std::mutex kick_mtx_{};                                   // Mutex for conditional wait of kick
+    AutoResetEvent kick_event_{};                             // Set by kick(), consumed by wait_for_kick()
     std::string name_;
 
   private:
@@ -20,10 +20,22 @@
 #include <silkworm/common/endian.hpp>
 
 #include "bitmap.hpp"
+#include "history_cache.hpp"
+#include "history_delta.hpp"
+#include "snapshot.hpp"
 #include "tables.hpp"
 
 namespace silkworm::db {
 
+//! \brief Returns the frozen segment of the block identified by key (block number + hash), if any
+static const BlockSegment* frozen_block_segment(ByteView key) {
+    const auto* repository{snapshot_repository()};
+    if (!repository || key.length() != sizeof(BlockNum) + kHashLength) {
+        return nullptr;
+    }
+    return repository->find_segment(endian::load_big_u64(key.data()));
+}
+
 std::optional<VersionBase> read_schema_version(mdbx::txn& txn) {
     Cursor src(txn, db::table::kDatabaseInfo);
     if (!src.seek(mdbx::slice{kDbSchemaVersionKey})) {
@@ -60,6 +72,14 @@ void write_schema_version(mdbx::txn& txn, const VersionBase& schema_version) {
     src.upsert(mdbx::slice{kDbSchemaVersionKey}, to_slice(value));
 }
 
+ChangeSetFormat read_changeset_format(mdbx::txn& txn) {
+    const auto schema_version{read_schema_version(txn)};
+    if (schema_version.has_value() && schema_version.value() >= table::kCompactChangeSetsSchemaVersion) {
+        return ChangeSetFormat::kCompact;
+    }
+    return ChangeSetFormat::kPlain;
+}
+
 std::optional<BlockHeader> read_header(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHashLength]) {
     auto key{block_key(block_number, hash)};
     return read_header(txn, key);
@@ -77,6 +97,12 @@ std::optional<BlockHeader> read_header(mdbx::txn& txn, ByteView key) {
 }
 
 Bytes read_header_raw(mdbx::txn& txn, ByteView key) {
+    if (const auto* segment{frozen_block_segment(key)}; segment) {
+        if (const ByteView raw{segment->header_rlp(endian::load_big_u64(key.data()), key.substr(sizeof(BlockNum)))};
+            !raw.empty()) {
+            return Bytes{raw};
+        }
+    }
     Cursor src(txn, db::table::kHeaders);
     auto data{src.find(to_slice(key), false)};
     if (!data) {
@@ -137,6 +163,17 @@ void write_total_difficulty(mdbx::txn& txn, BlockNum block_number, const uint8_t
     write_total_difficulty(txn, key, total_difficulty);
 }
 
+std::optional<evmc::bytes32> read_canonical_header_hash(mdbx::txn& txn, BlockNum block_number) {
+    Cursor src(txn, table::kCanonicalHashes);
+    const Bytes key{block_key(block_number)};
+    const auto data{src.find(to_slice(key), false)};
+    if (!data) {
+        return std::nullopt;
+    }
+    SILKWORM_ASSERT(data.value.length() == kHashLength);
+    return to_bytes32(from_slice(data.value));
+}
+
 void write_canonical_header(mdbx::txn& txn, const BlockHeader& header) {
     write_canonical_header_hash(txn, header.hash().bytes, header.number);
 }
@@ -163,8 +200,9 @@ void write_transactions(mdbx::txn& txn, const std::vector<Transaction>& transact
 
     Cursor target(txn, table::kBlockTransactions);
     auto key{db::block_key(base_id)};
+    Bytes value{};  // reused amongst transactions not to reallocate
     for (const auto& transaction : transactions) {
-        Bytes value{};
+        value.clear();
         rlp::encode(value, transaction);
         mdbx::slice value_slice{value.data(), value.length()};
         target.put(to_slice(key), &value_slice, MDBX_APPEND);
@@ -190,6 +228,24 @@ void read_transactions(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count
     SILKWORM_ASSERT(i == count);
 }
 
+void read_transaction_views(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count,
+                            std::vector<TransactionView>& out) {
+    out.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    auto key{db::block_key(base_id)};
+
+    uint64_t i{0};
+    for (auto data{txn_table.find(to_slice(key), false)}; data.done && i < count;
+         data = txn_table.to_next(/*throw_notfound = */ false), ++i) {
+        ByteView data_view{from_slice(data.value)};
+        rlp::success_or_throw(out[i].parse(data_view));
+    }
+    SILKWORM_ASSERT(i == count);
+}
+
 bool read_block_by_number(mdbx::txn& txn, BlockNum number, bool read_senders, Block& block) {
     Cursor canonical_hashes_cursor(txn, table::kCanonicalHashes);
     const Bytes key{block_key(number)};
@@ -223,6 +279,16 @@ bool read_body(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHas
 }
 
 bool read_body(mdbx::txn& txn, const Bytes& key, bool read_senders, BlockBody& out) {
+    if (const auto* segment{frozen_block_segment(key)}; segment) {
+        ByteView raw{segment->body_rlp(endian::load_big_u64(key.data()), ByteView{key}.substr(sizeof(BlockNum)))};
+        if (!raw.empty()) {
+            rlp::success_or_throw(rlp::decode(raw, out));
+            if (!out.transactions.empty() && read_senders) {
+                parse_senders(txn, key, out.transactions);
+            }
+            return true;
+        }
+    }
     Cursor src(txn, table::kBlockBodies);
     auto data{src.find(to_slice(key), false)};
     if (!data) {
@@ -241,6 +307,9 @@ bool read_body(mdbx::txn& txn, const Bytes& key, bool read_senders, BlockBody& o
 
 bool has_body(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHashLength]) {
     auto key{block_key(block_number, hash)};
+    if (const auto* segment{frozen_block_segment(key)}; segment && !segment->body_rlp(block_number, hash).empty()) {
+        return true;
+    }
     Cursor src(txn, table::kBlockBodies);
     return src.find(to_slice(key), false);
 }
@@ -282,11 +351,8 @@ std::vector<evmc::address> read_senders(mdbx::txn& txn, const Bytes& key) {
     return senders;
 }
 
-void parse_senders(mdbx::txn& txn, const Bytes& key, std::vector<Transaction>& out) {
-    if (out.empty()) {
-        return;
-    }
-    auto data_view{read_senders_raw(txn, key)};
+//! \brief Fills transactions' senders from a view on their addresses, recovering them if the view is empty
+static void fill_senders(ByteView data_view, std::vector<Transaction>& out) {
     if (!data_view.empty()) {
         SILKWORM_ASSERT(data_view.length() % kAddressLength == 0);
         SILKWORM_ASSERT(data_view.length() / kAddressLength == out.size());
@@ -303,6 +369,38 @@ void parse_senders(mdbx::txn& txn, const Bytes& key, std::vector<Transaction>& o
     }
 }
 
+void parse_senders(mdbx::txn& txn, const Bytes& key, std::vector<Transaction>& out) {
+    if (out.empty()) {
+        return;
+    }
+    fill_senders(read_senders_raw(txn, key), out);
+}
+
+SendersReader::SendersReader(mdbx::txn& txn) : cursor_{txn, table::kSenders} {}
+
+ByteView SendersReader::read_raw(BlockNum block_number, std::span<const uint8_t, kHashLength> hash) {
+    key_.resize(sizeof(BlockNum) + kHashLength);
+    endian::store_big_u64(key_.data(), block_number);
+    std::memcpy(&key_[sizeof(BlockNum)], hash.data(), kHashLength);
+    // Sequential reads usually find the wanted block right next to the previous one
+    if (!cursor_.eof()) {
+        const auto next{cursor_.to_next(/*throw_notfound=*/false)};
+        if (next && from_slice(next.key) == key_) {
+            return from_slice(next.value);
+        }
+    }
+    const auto data{cursor_.find(to_slice(key_), /*throw_notfound=*/false)};
+    return data ? from_slice(data.value) : ByteView{};
+}
+
+void SendersReader::parse(BlockNum block_number, std::span<const uint8_t, kHashLength> hash,
+                          std::vector<Transaction>& out) {
+    if (out.empty()) {
+        return;
+    }
+    fill_senders(read_raw(block_number, hash), out);
+}
+
 std::optional<ByteView> read_code(mdbx::txn& txn, const evmc::bytes32& code_hash) {
     Cursor src(txn, table::kCode);
     auto key{to_slice(code_hash)};
@@ -318,14 +416,16 @@ static std::optional<ByteView> historical_account(mdbx::txn& txn, const evmc::ad
     Cursor src(txn, table::kAccountHistory);
     const Bytes history_key{account_history_key(address, block_number)};
     const auto data{src.lower_bound(to_slice(history_key), /*throw_notfound=*/false)};
-    if (!data || !data.key.starts_with(to_slice(address))) {
-        return std::nullopt;
+    std::optional<BlockNum> change_block;
+    if (data && data.key.starts_with(to_slice(address))) {
+        change_block = bitmap::seek(bitmap::read(from_slice(data.value)), block_number);
     }
-
-    const auto bitmap{bitmap::read(from_slice(data.value))};
-    const auto change_block{bitmap::seek(bitmap, block_number)};
     if (!change_block) {
-        return std::nullopt;
+        // Changes not folded into chunks yet, if any, are all above them
+        change_block = seek_history_delta(txn, table::kAccountHistoryDelta, ByteView{address}, block_number);
+        if (!change_block) {
+            return std::nullopt;
+        }
     }
 
     src.bind(txn, table::kAccountChangeSet);
@@ -339,32 +439,35 @@ static std::optional<ByteView> historical_storage(mdbx::txn& txn, const evmc::ad
     Cursor src(txn, table::kStorageHistory);
     const Bytes history_key{storage_history_key(address, location, block_number)};
     const auto data{src.lower_bound(to_slice(history_key), /*throw_notfound=*/false)};
-    if (!data) {
-        return std::nullopt;
-    }
-
-    const ByteView k{from_slice(data.key)};
-    SILKWORM_ASSERT(k.length() == kAddressLength + kHashLength + sizeof(BlockNum));
-
-    if (k.substr(0, kAddressLength) != ByteView{address} ||
-        k.substr(kAddressLength, kHashLength) != ByteView{location}) {
-        return std::nullopt;
+    const ByteView key_prefix{ByteView{history_key}.substr(0, kAddressLength + kHashLength)};
+    std::optional<BlockNum> change_block;
+    if (data) {
+        const ByteView k{from_slice(data.key)};
+        SILKWORM_ASSERT(k.length() == kAddressLength + kHashLength + sizeof(BlockNum));
+        if (k.starts_with(key_prefix)) {
+            change_block = bitmap::seek(bitmap::read(from_slice(data.value)), block_number);
+        }
     }
-
-    const auto bitmap{bitmap::read(from_slice(data.value))};
-    const auto change_block{bitmap::seek(bitmap, block_number)};
     if (!change_block) {
-        return std::nullopt;
+        // Changes not folded into chunks yet, if any, are all above them
+        change_block = seek_history_delta(txn, table::kStorageHistoryDelta, key_prefix, block_number);
+        if (!change_block) {
+            return std::nullopt;
+        }
     }
 
     src.bind(txn, table::kStorageChangeSet);
     const Bytes change_set_key{storage_change_key(*change_block, address, incarnation)};
-    return find_value_suffix(src, change_set_key, location);
+    return find_value_suffix(src, change_set_key, storage_change_location(location, read_changeset_format(txn)));
 }
 
-std::optional<Account> read_account(mdbx::txn& txn, const evmc::address& address, std::optional<BlockNum> block_num) {
-    std::optional<ByteView> encoded{block_num.has_value() ? historical_account(txn, address, block_num.value())
-                                                          : std::nullopt};
+std::optional<Account> read_account(mdbx::txn& txn, const evmc::address& address, std::optional<BlockNum> block_num,
+                                    HistoryCache* history_cache) {
+    std::optional<ByteView> encoded;
+    if (block_num.has_value()) {
+        encoded = history_cache ? history_cache->account(txn, address, *block_num)
+                                : historical_account(txn, address, *block_num);
+    }
 
     if (!encoded.has_value()) {
         Cursor src(txn, table::kPlainState);
@@ -382,8 +485,8 @@ std::optional<Account> read_account(mdbx::txn& txn, const evmc::address& address
     if (acc.incarnation > 0 && acc.code_hash == kEmptyHash) {
         // restore code hash
         Cursor src(txn, table::kPlainCodeHash);
-        auto key{storage_prefix(address, acc.incarnation)};
-        if (auto data{src.find(to_slice(key), /*throw_notfound*/ false)};
+        const auto key{plain_storage_prefix(address, acc.incarnation)};
+        if (auto data{src.find({key.data(), key.size()}, /*throw_notfound*/ false)};
             data.done && data.value.length() == kHashLength) {
             std::memcpy(acc.code_hash.bytes, data.value.data(), kHashLength);
         }
@@ -393,14 +496,17 @@ std::optional<Account> read_account(mdbx::txn& txn, const evmc::address& address
 }
 
 evmc::bytes32 read_storage(mdbx::txn& txn, const evmc::address& address, uint64_t incarnation,
-                           const evmc::bytes32& location, std::optional<BlockNum> block_num) {
-    std::optional<ByteView> val{block_num.has_value()
-                                    ? historical_storage(txn, address, incarnation, location, block_num.value())
-                                    : std::nullopt};
+                           const evmc::bytes32& location, std::optional<BlockNum> block_num,
+                           HistoryCache* history_cache) {
+    std::optional<ByteView> val;
+    if (block_num.has_value()) {
+        val = history_cache ? history_cache->storage(txn, address, incarnation, location, *block_num)
+                            : historical_storage(txn, address, incarnation, location, *block_num);
+    }
     if (!val.has_value()) {
         Cursor src(txn, table::kPlainState);
-        auto key{storage_prefix(address, incarnation)};
-        val = find_value_suffix(src, key, location);
+        const auto key{plain_storage_prefix(address, incarnation)};
+        val = find_value_suffix(src, {key.data(), key.size()}, location);
     }
 
     if (!val.has_value()) {
@@ -454,6 +560,7 @@ StorageChanges read_storage_changes(mdbx::txn& txn, BlockNum block_num) {
     StorageChanges changes;
 
     const Bytes block_prefix{block_key(block_num)};
+    const ChangeSetFormat format{read_changeset_format(txn)};
 
     Cursor src(txn, table::kStorageChangeSet);
     auto key_prefix{to_slice(block_prefix)};
@@ -471,12 +578,8 @@ StorageChanges read_storage_changes(mdbx::txn& txn, BlockNum block_num) {
         data.key.remove_prefix(kAddressLength);
         uint64_t incarnation{endian::load_big_u64(static_cast<uint8_t*>(data.key.data()))};
 
-        SILKWORM_ASSERT(data.value.length() >= kHashLength);
-        evmc::bytes32 location;
-        std::memcpy(location.bytes, data.value.data(), kHashLength);
-        data.value.remove_prefix(kHashLength);
-
-        changes[address][incarnation][location] = db::from_slice(data.value);
+        const auto [location, value]{split_storage_change_value(db::from_slice(data.value), format)};
+        changes[address][incarnation][location] = value;
         data = src.to_next(/*throw_notfound=*/false);
     }
 
@@ -29,15 +29,21 @@
 #include <silkworm/db/util.hpp>
 #include <silkworm/types/account.hpp>
 #include <silkworm/types/block.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 namespace silkworm::db {
 
+class HistoryCache;
+
 // Pulls database schema version
 std::optional<VersionBase> read_schema_version(mdbx::txn& txn);
 
 // Writes database schema version (throws on downgrade)
 void write_schema_version(mdbx::txn& txn, const VersionBase& schema_version);
 
+//! \brief Returns the encoding of table::kStorageChangeSet values implied by database schema version
+ChangeSetFormat read_changeset_format(mdbx::txn& txn);
+
 std::optional<BlockHeader> read_header(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHashLength]);
 std::optional<BlockHeader> read_header(mdbx::txn& txn, ByteView key);
 Bytes read_header_raw(mdbx::txn& txn, ByteView key);
@@ -48,6 +54,9 @@ void write_header(mdbx::txn& txn, const BlockHeader& header, bool with_header_nu
 //! \brief Writes header hash in table::kHeaderNumbers
 void write_header_number(mdbx::txn& txn, const uint8_t (&hash)[kHashLength], BlockNum number);
 
+//! \brief Reads the canonical header hash of block_number from table::kCanonicalHashes
+std::optional<evmc::bytes32> read_canonical_header_hash(mdbx::txn& txn, BlockNum block_number);
+
 //! \brief Writes the header hash in table::kCanonicalHashes
 void write_canonical_header(mdbx::txn& txn, const BlockHeader& header);
 
@@ -91,10 +100,34 @@ std::vector<evmc::address> read_senders(mdbx::txn& txn, BlockNum block_number, c
 //! \brief Fills transactions' senders addresses directly in place
 void parse_senders(mdbx::txn& txn, const Bytes& key, std::vector<Transaction>& out);
 
+//! \brief Reads senders of many blocks through a single cursor on table::kSenders: meant for block ranges read in
+//! ascending order, as subsequent blocks are reached by moving to next record instead of searching the whole map
+class SendersReader {
+  public:
+    explicit SendersReader(mdbx::txn& txn);
+
+    //! \brief Returns a view on the senders of a block, concatenated kAddressLength bytes each, or an empty view if
+    //! there are none (e.g. pruned)
+    //! \remarks The view points to db data: it is valid until the end of the transaction or its next write
+    [[nodiscard]] ByteView read_raw(BlockNum block_number, std::span<const uint8_t, kHashLength> hash);
+
+    //! \brief Fills transactions' senders addresses of a block directly in place, recovering them if not in db
+    void parse(BlockNum block_number, std::span<const uint8_t, kHashLength> hash, std::vector<Transaction>& out);
+
+  private:
+    Cursor cursor_;
+    Bytes key_;
+};
+
 // See Erigon ReadTransactions
 void read_transactions(mdbx::txn& txn, uint64_t base_id, uint64_t count, std::vector<Transaction>& out);
 void read_transactions(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count, std::vector<Transaction>& out);
 
+//! \brief Same as read_transactions but only locates the fields of each transaction without decoding them
+//! \remarks Views point to db data: they are valid until the end of the transaction or its next write
+void read_transaction_views(mdbx::cursor& txn_table, uint64_t base_id, uint64_t count,
+                            std::vector<TransactionView>& out);
+
 //! \brief Persist transactions into db's bucket table::kBlockTransactions.
 //! The key starts from base_id and is incremented by 1 for each transaction.
 //! \remarks Before calling this ensure you got a proper base_id by incrementing sequence for table::kBlockTransactions.
@@ -103,12 +136,16 @@ void write_transactions(mdbx::txn& txn, const std::vector<Transaction>& transact
 std::optional<ByteView> read_code(mdbx::txn& txn, const evmc::bytes32& code_hash);
 
 // Reads current or historical (if block_number is specified) account.
+// Historical lookups go through history_cache, if any (see HistoryCache).
 std::optional<Account> read_account(mdbx::txn& txn, const evmc::address& address,
-                                    std::optional<BlockNum> block_number = std::nullopt);
+                                    std::optional<BlockNum> block_number = std::nullopt,
+                                    HistoryCache* history_cache = nullptr);
 
 // Reads current or historical (if block_number is specified) storage.
+// Historical lookups go through history_cache, if any (see HistoryCache).
 evmc::bytes32 read_storage(mdbx::txn& txn, const evmc::address& address, uint64_t incarnation,
-                           const evmc::bytes32& location, std::optional<BlockNum> block_number = std::nullopt);
+                           const evmc::bytes32& location, std::optional<BlockNum> block_number = std::nullopt,
+                           HistoryCache* history_cache = nullptr);
 
 // Reads current or historical (if block_number is specified) previous incarnation.
 std::optional<uint64_t> read_previous_incarnation(mdbx::txn& txn, const evmc::address& address,
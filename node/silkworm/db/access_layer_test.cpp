@@ -401,6 +401,18 @@ namespace db {
         CHECK(block_num == expected_block_num);
         CHECK_NOTHROW(stages::write_stage_prune_progress(txn, stages::kBlockBodiesKey, 0));
         CHECK(stages::read_stage_prune_progress(txn, stages::kBlockBodiesKey) == 0);
+
+        // Check "checkpoint_" prefix
+        CHECK_FALSE(stages::read_stage_checkpoint(txn, stages::kHashStateKey));
+        const stages::StageCheckpoint expected_checkpoint{expected_block_num, *from_hex("ab")};
+        CHECK_NOTHROW(stages::write_stage_checkpoint(txn, stages::kHashStateKey, expected_checkpoint));
+        const auto checkpoint{stages::read_stage_checkpoint(txn, stages::kHashStateKey)};
+        REQUIRE(checkpoint);
+        CHECK(checkpoint->target == expected_block_num);
+        CHECK(checkpoint->key == *from_hex("ab"));
+        CHECK(stages::read_stage_progress(txn, stages::kHashStateKey) == 0);  // Progress is unaffected
+        CHECK_NOTHROW(stages::clear_stage_checkpoint(txn, stages::kHashStateKey));
+        CHECK_FALSE(stages::read_stage_checkpoint(txn, stages::kHashStateKey));
     }
 
     TEST_CASE("read_difficulty") {
@@ -476,6 +488,48 @@ namespace db {
 
             CHECK(block.transactions[0].from == 0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address);
             CHECK(block.transactions[1].from == 0x941591b6ca8e8dd05c69efdec02b77c72dac1496_address);
+
+            // Same through a reader of consecutive blocks
+            Bytes next_key{block_key(header.number + 1, hash.bytes)};
+            sender_table.upsert(to_slice(next_key), to_slice(full_senders));
+            SendersReader senders{txn};
+            CHECK(senders.read_raw(header.number - 1, hash.bytes).empty());
+            CHECK(senders.read_raw(header.number, hash.bytes) == full_senders);
+            CHECK(senders.read_raw(header.number + 1, hash.bytes) == full_senders);
+            CHECK(senders.read_raw(header.number + 2, hash.bytes).empty());
+
+            for (auto& transaction : block.transactions) {
+                transaction.from.reset();
+            }
+            senders.parse(header.number, hash.bytes, block.transactions);
+            CHECK(block.transactions[0].from == 0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address);
+            CHECK(block.transactions[1].from == 0x941591b6ca8e8dd05c69efdec02b77c72dac1496_address);
+        }
+
+        SECTION("read_transaction_views") {
+            BlockBody body{sample_block_body()};
+            CHECK_NOTHROW(write_body(txn, body, hash.bytes, header.number));
+            auto bodies_table{db::open_cursor(txn, table::kBlockBodies)};
+            const Bytes key{block_key(header.number, hash.bytes)};
+            auto body_data{bodies_table.find(to_slice(key), /*throw_notfound=*/false)};
+            REQUIRE(body_data);
+            ByteView body_view{from_slice(body_data.value)};
+            const auto stored_body{detail::decode_stored_block_body(body_view)};
+
+            auto transactions_table{db::open_cursor(txn, table::kBlockTransactions)};
+            std::vector<TransactionView> views;
+            read_transaction_views(transactions_table, stored_body.base_txn_id, body.transactions.size(), views);
+            REQUIRE(views.size() == body.transactions.size());
+            for (size_t i{0}; i < views.size(); ++i) {
+                Bytes encoded;
+                rlp::encode(encoded, body.transactions[i], /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
+                CHECK(views[i].type() == body.transactions[i].type);
+                CHECK(views[i].encoded() == encoded);
+                CHECK(views[i].data() == body.transactions[i].data);
+                Transaction decoded;
+                REQUIRE(views[i].decode(decoded) == DecodingResult::kOk);
+                CHECK(decoded == body.transactions[i]);
+            }
         }
     }
 
@@ -528,6 +582,8 @@ namespace db {
 
         const auto addr{0xb000000000000000000000000000000000000008_address};
         const Bytes key{storage_prefix(addr, kDefaultIncarnation)};
+        const auto plain_key{plain_storage_prefix(addr, kDefaultIncarnation)};
+        CHECK(ByteView{plain_key.data(), plain_key.size()} == key);
 
         const auto loc1{0x000000000000000000000000000000000000a000000000000000000000000037_bytes32};
         const auto loc2{0x0000000000000000000000000000000000000000000000000000000000000000_bytes32};
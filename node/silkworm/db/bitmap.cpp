@@ -16,8 +16,12 @@
 
 #include "bitmap.hpp"
 
+#include <cstring>
+#include <limits>
+
 #include <silkworm/common/binary_search.hpp>
 #include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
 
 namespace silkworm::db::bitmap {
 
@@ -74,4 +78,129 @@ roaring::Roaring cut_left(roaring::Roaring& bm, uint64_t size_limit) { return cu
 
 roaring::Roaring64Map cut_left(roaring::Roaring64Map& bm, uint64_t size_limit) { return cut_left_impl(bm, size_limit); }
 
+roaring::Roaring get(mdbx::cursor& index_table, ByteView key, uint32_t from, uint32_t to) {
+    roaring::Roaring result;
+    if (from > to) {
+        return result;
+    }
+    Bytes chunk_key(key.size() + sizeof(uint32_t), '\0');
+    std::memcpy(chunk_key.data(), key.data(), key.size());
+    endian::store_big_u32(&chunk_key[key.size()], from);
+
+    for (auto data{index_table.lower_bound(db::to_slice(chunk_key), /*throw_notfound=*/false)}; data;
+         data = index_table.to_next(/*throw_notfound=*/false)) {
+        const ByteView chunk_index{db::from_slice(data.key)};
+        if (chunk_index.size() != chunk_key.size() || chunk_index.substr(0, key.size()) != key) {
+            break;
+        }
+        const auto chunk{roaring::Roaring::readSafe(data.value.char_ptr(), data.value.length())};
+        result |= chunk;
+        if (endian::load_big_u32(&chunk_index[key.size()]) >= to) {
+            break;
+        }
+    }
+    // First and last chunks may straddle the range
+    result &= roaring::Roaring(roaring::api::roaring_bitmap_from_range(from, uint64_t{to} + 1, 1));
+    return result;
+}
+
+template <typename RoaringMap, typename Suffix>
+static void truncate_impl(mdbx::cursor& index_table, ByteView key, Suffix from) {
+    const auto store_suffix{[](uint8_t* dst, Suffix suffix) {
+        if constexpr (sizeof(Suffix) == sizeof(uint64_t)) {
+            endian::store_big_u64(dst, suffix);
+        } else {
+            endian::store_big_u32(dst, suffix);
+        }
+    }};
+
+    Bytes chunk_key(key.size() + sizeof(Suffix), '\0');
+    std::memcpy(chunk_key.data(), key.data(), key.size());
+    store_suffix(&chunk_key[key.size()], from);
+
+    RoaringMap kept;
+    for (auto data{index_table.lower_bound(db::to_slice(chunk_key), /*throw_notfound=*/false)}; data;
+         data = index_table.to_next(/*throw_notfound=*/false)) {
+        const ByteView chunk_index{db::from_slice(data.key)};
+        if (chunk_index.size() != chunk_key.size() || chunk_index.substr(0, key.size()) != key) {
+            break;
+        }
+        auto chunk{RoaringMap::readSafe(data.value.char_ptr(), data.value.length())};
+        index_table.erase(/*whole_multivalue=*/true);
+        // Only the first chunk visited may hold values below from: drop the tail one value at a time, which is
+        // bounded by the chunk size limit and usually amounts to a handful of blocks
+        while (!chunk.isEmpty() && chunk.maximum() >= from) {
+            chunk.remove(chunk.maximum());
+        }
+        kept |= chunk;
+    }
+
+    if (!kept.isEmpty()) {
+        store_suffix(&chunk_key[key.size()], std::numeric_limits<Suffix>::max());
+        Bytes kept_bytes(kept.getSizeInBytes(), '\0');
+        kept.write(byte_ptr_cast(kept_bytes.data()));
+        index_table.upsert(db::to_slice(chunk_key), db::to_slice(kept_bytes));
+    }
+}
+
+void truncate(mdbx::cursor& index_table, ByteView key, uint64_t from) {
+    truncate_impl<roaring::Roaring64Map, uint64_t>(index_table, key, from);
+}
+
+void truncate32(mdbx::cursor& index_table, ByteView key, uint32_t from) {
+    truncate_impl<roaring::Roaring, uint32_t>(index_table, key, from);
+}
+
+template <typename RoaringMap, typename Suffix>
+static std::optional<Bytes> prune_impl(mdbx::cursor& index_table, ByteView resume_key, Suffix prune_from,
+                                       size_t max_chunks) {
+    const auto load_suffix{[](const uint8_t* src) -> Suffix {
+        if constexpr (sizeof(Suffix) == sizeof(uint64_t)) {
+            return endian::load_big_u64(src);
+        } else {
+            return endian::load_big_u32(src);
+        }
+    }};
+
+    auto data{resume_key.empty() ? index_table.to_first(/*throw_notfound=*/false)
+                                 : index_table.lower_bound(db::to_slice(resume_key), /*throw_notfound=*/false)};
+    for (size_t visited{0}; data; data = index_table.to_next(/*throw_notfound=*/false), ++visited) {
+        const ByteView chunk_index{db::from_slice(data.key)};
+        if (visited == max_chunks) {
+            return Bytes{chunk_index};
+        }
+        // Chunks are suffixed by their maximum value
+        if (load_suffix(&chunk_index[chunk_index.size() - sizeof(Suffix)]) < prune_from) {
+            index_table.erase(/*whole_multivalue=*/true);
+            continue;
+        }
+        auto chunk{RoaringMap::readSafe(data.value.char_ptr(), data.value.length())};
+        if (chunk.isEmpty() || chunk.minimum() >= prune_from) {
+            continue;
+        }
+        // Only the first chunk reaching prune_from holds values below it: drop its head one value at a time, which
+        // is bounded by the chunk size limit
+        while (!chunk.isEmpty() && chunk.minimum() < prune_from) {
+            chunk.remove(chunk.minimum());
+        }
+        if (chunk.isEmpty()) {
+            index_table.erase(/*whole_multivalue=*/true);
+            continue;
+        }
+        const Bytes chunk_key{chunk_index};  // Key data is no longer valid once the page is written
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        index_table.upsert(db::to_slice(chunk_key), db::to_slice(chunk_bytes));
+    }
+    return std::nullopt;
+}
+
+std::optional<Bytes> prune(mdbx::cursor& index_table, ByteView resume_key, uint64_t prune_from, size_t max_chunks) {
+    return prune_impl<roaring::Roaring64Map, uint64_t>(index_table, resume_key, prune_from, max_chunks);
+}
+
+std::optional<Bytes> prune32(mdbx::cursor& index_table, ByteView resume_key, uint32_t prune_from, size_t max_chunks) {
+    return prune_impl<roaring::Roaring, uint32_t>(index_table, resume_key, prune_from, max_chunks);
+}
+
 }  // namespace silkworm::db::bitmap
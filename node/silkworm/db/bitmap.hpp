@@ -25,6 +25,7 @@
 #pragma GCC diagnostic pop
 
 #include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
 
 namespace silkworm::db::bitmap {
 
@@ -44,4 +45,27 @@ roaring::Roaring64Map cut_left(roaring::Roaring64Map& bitmap, uint64_t size_limi
 // Remove from a bitmap and return its biggest left part not exceeding a given size
 roaring::Roaring cut_left(roaring::Roaring& bitmap, uint64_t size_limit);
 
+// Return the values in range [from, to] of the bitmap chunked under key in a table of 32-bit indices
+// (e.g. LogTopicIndex, LogAddressIndex): chunk keys are suffixed by the maximum value of the chunk (UINT32_MAX for the
+// last one), hence chunks entirely below from are skipped by a single seek and the walk stops at the first chunk
+// reaching beyond to.
+roaring::Roaring get(mdbx::cursor& index_table, ByteView key, uint32_t from, uint32_t to);
+
+// Remove all values not less than from of the bitmap chunked under key in a table of 64-bit indices
+// (e.g. AccountHistory, StorageHistory). A single seek skips chunks entirely below from: only the chunks reaching it
+// are visited, the first one possibly surviving in part as the new last chunk (suffix UINT64_MAX).
+void truncate(mdbx::cursor& index_table, ByteView key, uint64_t from);
+
+// Same as above for tables of 32-bit indices (e.g. LogTopicIndex, LogAddressIndex)
+void truncate32(mdbx::cursor& index_table, ByteView key, uint32_t from);
+
+// Remove all values less than prune_from from the bitmaps of a table of 64-bit indices, visiting at most max_chunks
+// chunks in key order from resume_key (from the first chunk when empty). Chunks entirely below prune_from are erased,
+// the first one of each key reaching it is rewritten in place without its lower values.
+// Return the key to resume from in a later call, or std::nullopt once the end of the table has been reached.
+std::optional<Bytes> prune(mdbx::cursor& index_table, ByteView resume_key, uint64_t prune_from, size_t max_chunks);
+
+// Same as above for tables of 32-bit indices (e.g. LogTopicIndex, LogAddressIndex)
+std::optional<Bytes> prune32(mdbx::cursor& index_table, ByteView resume_key, uint32_t prune_from, size_t max_chunks);
+
 }  // namespace silkworm::db::bitmap
@@ -16,10 +16,17 @@
 
 #include "bitmap.hpp"
 
+#include <cstring>
+#include <optional>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/tables.hpp>
+
 namespace silkworm::db::bitmap {
 
 TEST_CASE("cut_left1") {
@@ -76,4 +83,181 @@ TEST_CASE("cut_left3") {
     CHECK(bm.cardinality() == 0);
 }
 
+TEST_CASE("get range from chunks") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    auto txn{env.start_write()};
+    auto index_table{open_cursor(txn, table::kLogTopicIndex)};
+
+    const Bytes key{*from_hex("0x0000000000000000000000000000000000000000000000000000000000000001")};
+    const Bytes other_key{*from_hex("0x0000000000000000000000000000000000000000000000000000000000000002")};
+    const auto put_chunk{[&](ByteView chunk_key, uint32_t suffix, const roaring::Roaring& chunk) {
+        Bytes chunk_index(chunk_key.size() + 4, '\0');
+        std::memcpy(chunk_index.data(), chunk_key.data(), chunk_key.size());
+        endian::store_big_u32(&chunk_index[chunk_key.size()], suffix);
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        index_table.upsert(to_slice(chunk_index), to_slice(chunk_bytes));
+    }};
+    put_chunk(key, 30, roaring::Roaring::bitmapOf(3, 10, 20, 30));
+    put_chunk(key, 60, roaring::Roaring::bitmapOf(3, 40, 50, 60));
+    put_chunk(key, UINT32_MAX, roaring::Roaring::bitmapOf(2, 70, 80));
+    put_chunk(other_key, UINT32_MAX, roaring::Roaring::bitmapOf(2, 25, 55));
+
+    CHECK(get(index_table, key, 0, UINT32_MAX) == roaring::Roaring::bitmapOf(8, 10, 20, 30, 40, 50, 60, 70, 80));
+    CHECK(get(index_table, key, 20, 50) == roaring::Roaring::bitmapOf(4, 20, 30, 40, 50));
+    CHECK(get(index_table, key, 31, 39).isEmpty());
+    CHECK(get(index_table, key, 75, 1'000) == roaring::Roaring::bitmapOf(1, 80));
+    CHECK(get(index_table, key, 50, 40).isEmpty());
+    CHECK(get(index_table, other_key, 0, 50) == roaring::Roaring::bitmapOf(1, 25));
+    CHECK(get(index_table, *from_hex("0x03"), 0, UINT32_MAX).isEmpty());
+}
+
+TEST_CASE("truncate chunks") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    auto txn{env.start_write()};
+    auto index_table{open_cursor(txn, table::kAccountHistory)};
+
+    const Bytes key{*from_hex("0x0000000000000000000000000000000000000001")};
+    const Bytes other_key{*from_hex("0x0000000000000000000000000000000000000002")};
+    const auto chunk_index{[](ByteView chunk_key, uint64_t suffix) {
+        Bytes index(chunk_key.size() + 8, '\0');
+        std::memcpy(index.data(), chunk_key.data(), chunk_key.size());
+        endian::store_big_u64(&index[chunk_key.size()], suffix);
+        return index;
+    }};
+    const auto put_chunk{[&](ByteView chunk_key, uint64_t suffix, const roaring::Roaring64Map& chunk) {
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        index_table.upsert(to_slice(chunk_index(chunk_key, suffix)), to_slice(chunk_bytes));
+    }};
+    const auto read_chunk{[&](ByteView chunk_key, uint64_t suffix) -> std::optional<roaring::Roaring64Map> {
+        const auto data{index_table.find(to_slice(chunk_index(chunk_key, suffix)), /*throw_notfound=*/false)};
+        if (!data) {
+            return std::nullopt;
+        }
+        return read(from_slice(data.value));
+    }};
+    put_chunk(key, 30, roaring::Roaring64Map::bitmapOf(3, 10, 20, 30));
+    put_chunk(key, 60, roaring::Roaring64Map::bitmapOf(3, 40, 50, 60));
+    put_chunk(key, UINT64_MAX, roaring::Roaring64Map::bitmapOf(2, 70, 80));
+    put_chunk(other_key, UINT64_MAX, roaring::Roaring64Map::bitmapOf(2, 25, 55));
+
+    SECTION("Tail of last chunk") {
+        truncate(index_table, key, 75);
+        CHECK(read_chunk(key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(1, 70));
+        CHECK(read_chunk(key, 60) == roaring::Roaring64Map::bitmapOf(3, 40, 50, 60));
+        CHECK(read_chunk(other_key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(2, 25, 55));
+    }
+
+    SECTION("Whole last chunk") {
+        truncate(index_table, key, 61);
+        CHECK(read_chunk(key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(3, 40, 50, 60));
+        CHECK_FALSE(read_chunk(key, 60).has_value());
+        CHECK(read_chunk(key, 30) == roaring::Roaring64Map::bitmapOf(3, 10, 20, 30));
+    }
+
+    SECTION("Across chunks") {
+        truncate(index_table, key, 45);
+        CHECK(read_chunk(key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(1, 40));
+        CHECK_FALSE(read_chunk(key, 60).has_value());
+        CHECK(read_chunk(key, 30) == roaring::Roaring64Map::bitmapOf(3, 10, 20, 30));
+    }
+
+    SECTION("Everything") {
+        truncate(index_table, key, 0);
+        CHECK_FALSE(read_chunk(key, UINT64_MAX).has_value());
+        CHECK_FALSE(read_chunk(key, 60).has_value());
+        CHECK_FALSE(read_chunk(key, 30).has_value());
+        CHECK(read_chunk(other_key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(2, 25, 55));
+    }
+
+    SECTION("32-bit indices") {
+        auto log_index_table{open_cursor(txn, table::kLogAddressIndex)};
+        Bytes index(key.size() + 4, '\0');
+        std::memcpy(index.data(), key.data(), key.size());
+        endian::store_big_u32(&index[key.size()], UINT32_MAX);
+        const auto chunk{roaring::Roaring::bitmapOf(3, 5, 6, 7)};
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        log_index_table.upsert(to_slice(index), to_slice(chunk_bytes));
+
+        truncate32(log_index_table, key, 6);
+        CHECK(get(log_index_table, key, 0, UINT32_MAX) == roaring::Roaring::bitmapOf(1, 5));
+    }
+}
+
+TEST_CASE("prune chunks") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    auto txn{env.start_write()};
+    auto index_table{open_cursor(txn, table::kAccountHistory)};
+
+    const Bytes key{*from_hex("0x0000000000000000000000000000000000000001")};
+    const Bytes other_key{*from_hex("0x0000000000000000000000000000000000000002")};
+    const auto chunk_index{[](ByteView chunk_key, uint64_t suffix) {
+        Bytes index(chunk_key.size() + 8, '\0');
+        std::memcpy(index.data(), chunk_key.data(), chunk_key.size());
+        endian::store_big_u64(&index[chunk_key.size()], suffix);
+        return index;
+    }};
+    const auto put_chunk{[&](ByteView chunk_key, uint64_t suffix, const roaring::Roaring64Map& chunk) {
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        index_table.upsert(to_slice(chunk_index(chunk_key, suffix)), to_slice(chunk_bytes));
+    }};
+    const auto read_chunk{[&](ByteView chunk_key, uint64_t suffix) -> std::optional<roaring::Roaring64Map> {
+        const auto data{index_table.find(to_slice(chunk_index(chunk_key, suffix)), /*throw_notfound=*/false)};
+        if (!data) {
+            return std::nullopt;
+        }
+        return read(from_slice(data.value));
+    }};
+    put_chunk(key, 30, roaring::Roaring64Map::bitmapOf(3, 10, 20, 30));
+    put_chunk(key, 60, roaring::Roaring64Map::bitmapOf(3, 40, 50, 60));
+    put_chunk(key, UINT64_MAX, roaring::Roaring64Map::bitmapOf(2, 70, 80));
+    put_chunk(other_key, UINT64_MAX, roaring::Roaring64Map::bitmapOf(2, 25, 55));
+
+    SECTION("Whole table") {
+        CHECK_FALSE(prune(index_table, {}, 45, 100).has_value());
+        CHECK_FALSE(read_chunk(key, 30).has_value());
+        CHECK(read_chunk(key, 60) == roaring::Roaring64Map::bitmapOf(2, 50, 60));
+        CHECK(read_chunk(key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(2, 70, 80));
+        CHECK(read_chunk(other_key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(1, 55));
+    }
+
+    SECTION("Resumable") {
+        const auto resume_key{prune(index_table, {}, 60, 2)};
+        REQUIRE(resume_key == chunk_index(key, UINT64_MAX));
+        CHECK_FALSE(read_chunk(key, 30).has_value());
+        CHECK(read_chunk(key, 60) == roaring::Roaring64Map::bitmapOf(1, 60));
+        CHECK(read_chunk(other_key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(2, 25, 55));
+
+        CHECK_FALSE(prune(index_table, *resume_key, 60, 2).has_value());
+        CHECK(read_chunk(key, UINT64_MAX) == roaring::Roaring64Map::bitmapOf(2, 70, 80));
+        CHECK_FALSE(read_chunk(other_key, UINT64_MAX).has_value());
+    }
+
+    SECTION("32-bit indices") {
+        auto log_index_table{open_cursor(txn, table::kLogAddressIndex)};
+        Bytes index(key.size() + 4, '\0');
+        std::memcpy(index.data(), key.data(), key.size());
+        endian::store_big_u32(&index[key.size()], UINT32_MAX);
+        const auto chunk{roaring::Roaring::bitmapOf(3, 5, 6, 7)};
+        Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+        chunk.write(byte_ptr_cast(chunk_bytes.data()));
+        log_index_table.upsert(to_slice(index), to_slice(chunk_bytes));
+
+        CHECK_FALSE(prune32(log_index_table, {}, 6, 10).has_value());
+        CHECK(get(log_index_table, key, 0, UINT32_MAX) == roaring::Roaring::bitmapOf(2, 6, 7));
+    }
+}
+
 }  // namespace silkworm::db::bitmap
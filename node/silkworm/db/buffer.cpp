@@ -22,9 +22,13 @@
 #include <absl/container/btree_set.h>
 
 #include <silkworm/common/endian.hpp>
+#include <silkworm/common/instrumentation.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/changed_keys.hpp>
+#include <silkworm/db/state_cache.hpp>
+#include <silkworm/db/state_filter.hpp>
 #include <silkworm/db/tables.hpp>
 #include <silkworm/types/log_cbor.hpp>
 #include <silkworm/types/receipt_cbor.hpp>
@@ -64,6 +68,9 @@ void Buffer::update_account(const evmc::address& address, std::optional<Account>
     if (equal) {
         return;
     }
+    if (state_root_) {
+        state_root_->update_account(address, current);
+    }
     auto it{accounts_.find(address)};
     if (it != accounts_.end()) {
         batch_state_size_ -= it->second.has_value() ? sizeof(Account) : 0;
@@ -87,10 +94,12 @@ void Buffer::update_account_code(const evmc::address& address, uint64_t incarnat
     // that were previously returned by read_code() are still valid.
     if (hash_to_code_.try_emplace(code_hash, code).second) {
         batch_state_size_ += kHashLength + code.length();
+        state_payload_size_ += code.length();
     }
 
     if (storage_prefix_to_code_hash_.insert_or_assign(storage_prefix(address, incarnation), code_hash).second) {
         batch_state_size_ += kPlainStoragePrefixLength + kHashLength;
+        state_payload_size_ += kPlainStoragePrefixLength;
     }
 }
 
@@ -99,6 +108,9 @@ void Buffer::update_storage(const evmc::address& address, uint64_t incarnation,
     if (current == initial) {
         return;
     }
+    if (state_root_) {
+        state_root_->update_storage(address, incarnation, location, current);
+    }
     if (block_number_ >= prune_history_threshold_) {
         changed_storage_.insert(address);
         ByteView initial_val{zeroless_view(initial)};
@@ -109,8 +121,8 @@ void Buffer::update_storage(const evmc::address& address, uint64_t incarnation,
         }
     }
 
-    if (storage_[address][incarnation].insert_or_assign(location, current).second) {
-        batch_state_size_ += kPlainStoragePrefixLength + kHashLength + kHashLength;
+    if (storage_.insert_or_assign(StorageKey{address, incarnation, location}, current).second) {
+        batch_state_size_ += kPlainStoragePrefixLength + kLocationLength + kHashLength;
     }
 }
 
@@ -138,6 +150,9 @@ void Buffer::write_history_to_db() {
                 mdbx::slice v{change_value.data(), kAddressLength + account_encoded.length()};
                 mdbx::error::success_or_throw(account_change_table.put(k, &v, MDBX_APPENDDUP));
                 written_size += kAddressLength + account_encoded.length();
+                if (changed_keys_) {
+                    changed_keys_->insert_account(address);
+                }
             }
         }
         block_account_changes_.clear();
@@ -151,7 +166,7 @@ void Buffer::write_history_to_db() {
 
     if (!block_storage_changes_.empty()) {
         Bytes change_key(sizeof(BlockNum) + kPlainStoragePrefixLength, '\0');
-        Bytes change_value(kHashLength + 128, '\0');  // Se comment above (account changes) for explanation about 128
+        const ChangeSetFormat format{read_changeset_format(txn_)};
 
         auto storage_change_table{db::open_cursor(txn_, table::kStorageChangeSet)};
         for (const auto& [block_num, storage_changes] : block_storage_changes_) {
@@ -164,12 +179,14 @@ void Buffer::write_history_to_db() {
                     endian::store_big_u64(&change_key[sizeof(BlockNum) + kAddressLength], incarnation);
                     written_size += kIncarnationLength;
                     for (const auto& [location, value] : locations_values) {
-                        std::memcpy(&change_value[0], location.bytes, kHashLength);
-                        std::memcpy(&change_value[kHashLength], value.data(), value.length());
-                        mdbx::slice change_value_slice{change_value.data(), kHashLength + value.length()};
+                        const Bytes change_value{storage_change_value(location, value, format)};
+                        mdbx::slice change_value_slice{to_slice(change_value)};
                         mdbx::error::success_or_throw(
                             storage_change_table.put(to_slice(change_key), &change_value_slice, MDBX_APPENDDUP));
-                        written_size += kLocationLength + value.length();
+                        written_size += change_value.length();
+                        if (changed_keys_) {
+                            changed_keys_->insert_storage(address, incarnation, location);
+                        }
                     }
                 }
             }
@@ -259,6 +276,9 @@ void Buffer::write_state_to_db() {
         for (const auto& entry : hash_to_code_) {
             code_table.upsert(to_slice(entry.first), to_slice(entry.second));
             written_size += kHashLength + entry.second.length();
+            if (state_cache_) {
+                state_cache_->put_code(entry.first, entry.second);
+            }
         }
         hash_to_code_.clear();
         total_written_size += written_size;
@@ -284,44 +304,57 @@ void Buffer::write_state_to_db() {
         written_size = 0;
     }
 
-    // Extract sorted index of unique addresses before inserting into the DB
-    absl::btree_set<evmc::address> addresses;
-    for (auto& x : accounts_) {
-        addresses.insert(x.first);
-    }
-    for (auto& x : storage_) {
-        addresses.insert(x.first);
-    }
-
-    if (should_trace) {
-        auto [_, duration]{sw.lap()};
-        log::Trace("Sorted addresses", {"in", StopWatch::format(duration)});
+    if (!state_write_prepared_) {
+        prepare_state_write();
+        if (should_trace) {
+            auto [_, duration]{sw.lap()};
+            log::Trace("Sorted addresses and storage", {"in", StopWatch::format(duration)});
+        }
     }
 
     auto state_table{db::open_cursor(txn_, table::kPlainState)};
-    for (const auto& address : addresses) {
+    auto slot{sorted_slots_.begin()};
+    for (const auto& address : sorted_addresses_) {
         if (auto it{accounts_.find(address)}; it != accounts_.end()) {
             auto key{to_slice(address)};
             state_table.erase(key, /*whole_multivalue=*/true);  // PlainState is multivalue
+            if (state_cache_) {
+                state_cache_->put_account(address, it->second);
+            }
             if (it->second.has_value()) {
                 Bytes encoded{it->second->encode_for_storage()};
                 state_table.upsert(key, to_slice(encoded));
                 written_size += kAddressLength + encoded.length();
+                if (state_filter_) {
+                    state_filter_->insert_account(address);
+                }
             }
             accounts_.erase(it);
         }
 
-        if (auto it{storage_.find(address)}; it != storage_.end()) {
-            for (const auto& [incarnation, contract_storage] : it->second) {
-                Bytes prefix{storage_prefix(address, incarnation)};
-                for (const auto& [location, value] : contract_storage) {
-                    upsert_storage_value(state_table, prefix, location, value);
-                    written_size += prefix.length() + kLocationLength + kHashLength;
-                }
+        // Slots are sorted the same way as addresses, hence the ones of this address (if any) come next
+        Bytes prefix;
+        uint64_t prefix_incarnation{0};
+        for (; slot != sorted_slots_.end() && (*slot)->first.address == address; ++slot) {
+            const auto& [key, value]{**slot};
+            if (prefix.empty() || prefix_incarnation != key.incarnation) {
+                prefix = storage_prefix(address, key.incarnation);
+                prefix_incarnation = key.incarnation;
+            }
+            upsert_storage_value(state_table, prefix, key.location, value);
+            written_size += prefix.length() + kLocationLength + kHashLength;
+            if (state_cache_) {
+                state_cache_->put_storage(address, key.incarnation, key.location, value);
+            }
+            if (state_filter_ && value != evmc::bytes32{}) {
+                state_filter_->insert_storage(address, key.incarnation, key.location);
             }
-            storage_.erase(it);
         }
     }
+    sorted_slots_.clear();
+    sorted_addresses_.clear();
+    state_write_prepared_ = false;
+    storage_.clear();
     total_written_size += written_size;
     if (should_trace) {
         auto [_, duration]{sw.lap()};
@@ -330,42 +363,74 @@ void Buffer::write_state_to_db() {
     }
     written_size = 0;
     batch_state_size_ = 0;
+    state_payload_size_ = 0;
 
     auto [time_point, _]{sw.stop()};
     log::Info("Flushed state",
               {"size", human_size(total_written_size), "in", StopWatch::format(sw.since_start(time_point))});
 }
 
+void Buffer::prepare_state_write() {
+    // Extract sorted index of unique addresses and of storage slots before inserting into the DB
+    absl::btree_set<evmc::address> addresses;
+    for (const auto& x : accounts_) {
+        addresses.insert(x.first);
+    }
+    sorted_slots_.clear();
+    sorted_slots_.reserve(storage_.size());
+    for (const auto& x : storage_) {
+        addresses.insert(x.first.address);
+        sorted_slots_.push_back(&x);
+    }
+    std::sort(sorted_slots_.begin(), sorted_slots_.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+    sorted_addresses_.assign(addresses.begin(), addresses.end());
+    state_write_prepared_ = true;
+}
+
 void Buffer::write_to_db() {
     write_history_to_db();
 
     // This should be very last to be written so updated pages
     // have higher chances not to be evicted from RAM
     write_state_to_db();
+
+    if (state_cache_) {
+        state_cache_->trim();
+    }
 }
 
 // Erigon WriteReceipts in core/rawdb/accessors_chain.go
-void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) {
+EncodedReceipts encode_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) {
+    EncodedReceipts encoded{block_key(block_number), cbor_encode(receipts), {}};
     for (uint32_t i{0}; i < receipts.size(); ++i) {
-        if (receipts[i].logs.empty()) {
-            continue;
+        if (!receipts[i].logs.empty()) {
+            encoded.logs.emplace_back(log_key(block_number, i), cbor_encode(receipts[i].logs));
         }
+    }
+    return encoded;
+}
 
-        Bytes key{log_key(block_number, i)};
-        Bytes value{cbor_encode(receipts[i].logs)};
+void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) {
+    insert_receipts(encode_receipts(block_number, receipts));
+}
 
-        if (logs_.insert_or_assign(key, value).second) {
-            batch_history_size_ += key.size() + value.size();
+void Buffer::insert_receipts(EncodedReceipts&& encoded) {
+    for (auto& [key, value] : encoded.logs) {
+        const size_t size{key.size() + value.size()};
+        if (logs_.insert_or_assign(std::move(key), std::move(value)).second) {
+            batch_history_size_ += size;
         }
     }
 
-    Bytes key{block_key(block_number)};
-    Bytes value{cbor_encode(receipts)};
-    receipts_[key] = value;
-    batch_history_size_ += key.size() + value.size();
+    batch_history_size_ += encoded.key.size() + encoded.receipts.size();
+    receipts_[std::move(encoded.key)] = std::move(encoded.receipts);
 }
 
 evmc::bytes32 Buffer::state_root_hash() const {
+    if (state_root_) {
+        return state_root_->root_hash();
+    }
     throw std::runtime_error(std::string(__FUNCTION__).append(" not yet implemented"));
 }
 
@@ -426,23 +491,69 @@ bool Buffer::read_body(uint64_t block_number, const evmc::bytes32& block_hash, B
     return db::read_body(txn_, key, /*read_senders=*/false, body);
 }
 
-std::optional<Account> Buffer::read_account(const evmc::address& address) const noexcept {
+const std::optional<Account>* Buffer::find_account(const evmc::address& address) const noexcept {
     if (auto it{accounts_.find(address)}; it != accounts_.end()) {
-        return it->second;
+        return &it->second;
+    }
+    return parent_ ? parent_->find_account(address) : nullptr;
+}
+
+const evmc::bytes32* Buffer::find_storage(const StorageKey& key) const noexcept {
+    if (auto it{storage_.find(key)}; it != storage_.end()) {
+        return &it->second;
+    }
+    return parent_ ? parent_->find_storage(key) : nullptr;
+}
+
+const Bytes* Buffer::find_code(const evmc::bytes32& code_hash) const noexcept {
+    if (auto it{hash_to_code_.find(code_hash)}; it != hash_to_code_.end()) {
+        return &it->second;
+    }
+    return parent_ ? parent_->find_code(code_hash) : nullptr;
+}
+
+const uint64_t* Buffer::find_incarnation(const evmc::address& address) const noexcept {
+    if (auto it{incarnations_.find(address)}; it != incarnations_.end()) {
+        return &it->second;
+    }
+    return parent_ ? parent_->find_incarnation(address) : nullptr;
+}
+
+std::optional<Account> Buffer::read_account(const evmc::address& address) const noexcept {
+    SILK_SCOPED_TIMER("db::Buffer::read_account");
+    if (const auto* account{find_account(address)}; account) {
+        return *account;
+    }
+    std::optional<Account> db_account;
+    if (const std::optional<Account>* cached{state_cache_ && !historical_block_ ? state_cache_->get_account(address)
+                                                                                : nullptr}) {
+        db_account = *cached;
+    } else {
+        if (historical_block_ || !state_filter_ || state_filter_->may_contain_account(address)) {
+            db_account = db::read_account(txn_, address, historical_block_, history_cache_);
+        }
+        if (state_cache_ && !historical_block_) {
+            state_cache_->put_account(address, db_account);
+        }
     }
-    auto db_account{db::read_account(txn_, address, historical_block_)};
     accounts_[address] = db_account;
     batch_state_size_ += kAddressLength + db_account.value_or(Account()).encoding_length_for_storage();
     return db_account;
 }
 
 ByteView Buffer::read_code(const evmc::bytes32& code_hash) const noexcept {
-    if (auto it{hash_to_code_.find(code_hash)}; it != hash_to_code_.end()) {
-        return it->second;
+    SILK_SCOPED_TIMER("db::Buffer::read_code");
+    if (const Bytes* code{find_code(code_hash)}; code) {
+        return *code;
+    }
+    if (state_cache_) {
+        if (const auto cached{state_cache_->get_code(code_hash)}; cached) {
+            return *cached;
+        }
     }
     std::optional<ByteView> code{db::read_code(txn_, code_hash)};
     if (code.has_value()) {
-        return *code;
+        return state_cache_ ? state_cache_->put_code(code_hash, *code) : *code;
     } else {
         return {};
     }
@@ -450,25 +561,53 @@ ByteView Buffer::read_code(const evmc::bytes32& code_hash) const noexcept {
 
 evmc::bytes32 Buffer::read_storage(const evmc::address& address, uint64_t incarnation,
                                    const evmc::bytes32& location) const noexcept {
-    size_t payload_length{kAddressLength + kIncarnationLength + kLocationLength + kHashLength};
-    if (auto it1{storage_.find(address)}; it1 != storage_.end()) {
-        payload_length -= kAddressLength;
-        if (auto it2{it1->second.find(incarnation)}; it2 != it1->second.end()) {
-            payload_length -= kIncarnationLength;
-            if (auto it3{it2->second.find(location)}; it3 != it2->second.end()) {
-                return it3->second;
-            }
+    SILK_SCOPED_TIMER("db::Buffer::read_storage");
+    StorageKey key{address, incarnation, location};
+    if (const evmc::bytes32* value{find_storage(key)}; value) {
+        return *value;
+    }
+    evmc::bytes32 db_storage{};
+    if (const evmc::bytes32* cached{state_cache_ && !historical_block_
+                                        ? state_cache_->get_storage(address, incarnation, location)
+                                        : nullptr}) {
+        db_storage = *cached;
+    } else {
+        if (historical_block_ || !state_filter_ ||
+            state_filter_->may_contain_storage(address, incarnation, location)) {
+            db_storage = db::read_storage(txn_, address, incarnation, location, historical_block_, history_cache_);
+        }
+        if (state_cache_ && !historical_block_) {
+            state_cache_->put_storage(address, incarnation, location, db_storage);
         }
     }
-    auto db_storage{db::read_storage(txn_, address, incarnation, location, historical_block_)};
-    storage_[address][incarnation][location] = db_storage;
-    batch_state_size_ += payload_length;
+    storage_.emplace(key, db_storage);
+    batch_state_size_ += kPlainStoragePrefixLength + kLocationLength + kHashLength;
     return db_storage;
 }
 
+void Buffer::preload_account(const evmc::address& address, const std::optional<Account>& account) const noexcept {
+    if (parent_ && parent_->find_account(address)) {
+        return;  // Read through parent, db value is stale
+    }
+    if (accounts_.try_emplace(address, account).second) {
+        batch_state_size_ += kAddressLength + account.value_or(Account()).encoding_length_for_storage();
+    }
+}
+
+void Buffer::preload_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                             const evmc::bytes32& value) const noexcept {
+    StorageKey key{address, incarnation, location};
+    if (parent_ && parent_->find_storage(key)) {
+        return;  // Read through parent, db value is stale
+    }
+    if (storage_.try_emplace(key, value).second) {
+        batch_state_size_ += kPlainStoragePrefixLength + kLocationLength + kHashLength;
+    }
+}
+
 uint64_t Buffer::previous_incarnation(const evmc::address& address) const noexcept {
-    if (auto it{incarnations_.find(address)}; it != incarnations_.end()) {
-        return it->second;
+    if (const uint64_t* incarnation{find_incarnation(address)}; incarnation) {
+        return *incarnation;
     }
     std::optional<uint64_t> incarnation{db::read_previous_incarnation(txn_, address, historical_block_)};
     return incarnation.value_or(0);
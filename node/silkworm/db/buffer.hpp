@@ -18,35 +18,65 @@
 
 #include <cassert>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
-#include <absl/container/flat_hash_set.h>
 
+#include <silkworm/common/counting_allocator.hpp>
+#include <silkworm/common/hash_maps.hpp>
+#include <silkworm/common/memory.hpp>
 #include <silkworm/db/util.hpp>
 #include <silkworm/state/state.hpp>
 #include <silkworm/trie/hash_builder.hpp>
+#include <silkworm/trie/incremental_trie.hpp>
 #include <silkworm/types/account.hpp>
 #include <silkworm/types/block.hpp>
 #include <silkworm/types/receipt.hpp>
 
 namespace silkworm::db {
 
+//! \brief Receipts and logs of a block encoded for storage into BlockReceipts and Logs
+struct EncodedReceipts {
+    Bytes key;                                  // Block key of receipts record
+    Bytes receipts;                             // CBOR of all receipts
+    std::vector<std::pair<Bytes, Bytes>> logs;  // Log key => CBOR of logs (only for transactions logging)
+};
+
+//! \brief Encodes receipts of a block (and their logs) for storage
+//! \remarks Does not touch any state, hence may run on any thread (see Buffer::insert_receipts)
+EncodedReceipts encode_receipts(uint64_t block_number, const std::vector<Receipt>& receipts);
+
+class ChangedKeys;
+class HistoryCache;
+class StateCache;
+class StateFilter;
+
 class Buffer : public State {
   public:
     // txn must be valid (its handle != nullptr)
+    // If parent is specified, state not found in this buffer is looked up in parent before reading db: parent must
+    // not be modified and must outlive this buffer (or be detached) - see detach_parent
     explicit Buffer(mdbx::txn& txn, BlockNum prune_history_threshold,
-                    std::optional<BlockNum> historical_block = std::nullopt)
-        : txn_{txn}, prune_history_threshold_{prune_history_threshold}, historical_block_{historical_block} {
+                    std::optional<BlockNum> historical_block = std::nullopt, const Buffer* parent = nullptr)
+        : txn_{txn},
+          prune_history_threshold_{prune_history_threshold},
+          historical_block_{historical_block},
+          parent_{parent} {
         assert(txn_);
     }
 
+    // Not copyable nor movable: containers account their memory into a member of this instance
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
     /** @name Readers */
     ///@{
 
     [[nodiscard]] std::optional<Account> read_account(const evmc::address& address) const noexcept override;
 
+    //! \remarks Code not written by this buffer is not copied: the view points into the pages of txn
     [[nodiscard]] ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
 
     [[nodiscard]] evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation,
@@ -70,6 +100,16 @@ class Buffer : public State {
 
     [[nodiscard]] std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override;
 
+    //! \brief Seeds the read cache with an account value read from db, unless the account is already cached
+    //! \remarks The value must match what read_account would fetch from db, i.e. it must come from a snapshot
+    //! taken after the last state write of txn
+    void preload_account(const evmc::address& address, const std::optional<Account>& account) const noexcept;
+
+    //! \brief Seeds the read cache with a storage value read from db, unless the location is already cached
+    //! \remarks Same requirements of preload_account apply
+    void preload_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                         const evmc::bytes32& value) const noexcept;
+
     ///@}
 
     void insert_block(const Block& block, const evmc::bytes32& hash) override;
@@ -80,6 +120,9 @@ class Buffer : public State {
 
     void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
 
+    //! \brief Inserts receipts already encoded by encode_receipts (possibly on another thread)
+    void insert_receipts(EncodedReceipts&& encoded);
+
     /** @name State changes
      *  Change sets are backward changes of the state, i.e. account/storage values <em>at the beginning of a block</em>.
      */
@@ -119,10 +162,49 @@ class Buffer : public State {
     //! \brief Approximate size of accrued history in bytes.
     [[nodiscard]] size_t current_batch_history_size() const noexcept { return batch_history_size_; }
 
+    //! \brief Memory used by this buffer in bytes
+    //! \remarks State containers are measured exactly (including hash table and tree overhead) through their
+    //! allocator, history is estimated from payload sizes
+    [[nodiscard]] size_t memory_usage() const noexcept {
+        return state_allocated_size_ + state_payload_size_ + batch_history_size_;
+    }
+
     //! \brief Persists *all* accrued contents into db
     //! \remarks write_history_to_db is implicitly called
     void write_to_db();
 
+    //! \brief Sorts accrued state in db order ahead of write_to_db, which then only has to upsert it
+    //! \remarks Does not access db nor modify state lookups, hence it may run on a separate thread while a
+    //! child buffer reads through this one. This buffer must not be read nor modified until written to db
+    void prepare_state_write();
+
+    //! \brief Stops reading through parent, e.g. once parent contents have been written to db
+    //! \remarks Code views returned by read_code may point into parent: detach between blocks only
+    void detach_parent() noexcept { parent_ = nullptr; }
+
+    [[nodiscard]] const Buffer* parent() const noexcept { return parent_; }
+
+    //! \brief Forwards every state change to state_root, which then provides state_root_hash
+    //! \remarks state_root must reflect the state this buffer starts from and must outlive it
+    void track_state_root(trie::IncrementalStateRoot* state_root) noexcept { state_root_ = state_root; }
+
+    //! \brief Routes historical account and storage reads through history_cache (see db::HistoryCache)
+    //! \remarks history_cache must be bound to the same read transaction as this buffer and must outlive it
+    void use_history_cache(HistoryCache* history_cache) noexcept { history_cache_ = history_cache; }
+
+    //! \brief Skips db reads of current accounts and storage that state_filter rules out, and inserts every account
+    //! and storage location written to db into it
+    //! \remarks state_filter must hold all keys of PlainState and must outlive this buffer
+    void use_state_filter(StateFilter* state_filter) noexcept { state_filter_ = state_filter; }
+
+    //! \brief Reads current state through state_cache before db, and updates it with all state written to db
+    //! \remarks state_cache must reflect PlainState and must outlive this buffer. Its code is trimmed by write_to_db
+    void use_state_cache(StateCache* state_cache) noexcept { state_cache_ = state_cache; }
+
+    //! \brief Inserts the keys of every account and storage change written to db into changed_keys
+    //! \remarks changed_keys must outlive this buffer
+    void record_changed_keys(ChangedKeys* changed_keys) noexcept { changed_keys_ = changed_keys; }
+
     //! \brief Persists *history* accrued contents into db
     void write_history_to_db();
 
@@ -130,9 +212,23 @@ class Buffer : public State {
     //! \brief Persists *state* accrued contents into db
     void write_state_to_db();
 
+    struct StorageKey;
+
+    // Lookups of in-memory state only, in this buffer first then up the parent chain
+    [[nodiscard]] const std::optional<Account>* find_account(const evmc::address& address) const noexcept;
+    [[nodiscard]] const evmc::bytes32* find_storage(const StorageKey& key) const noexcept;
+    [[nodiscard]] const Bytes* find_code(const evmc::bytes32& code_hash) const noexcept;
+    [[nodiscard]] const uint64_t* find_incarnation(const evmc::address& address) const noexcept;
+
     mdbx::txn& txn_;
     uint64_t prune_history_threshold_;
     std::optional<uint64_t> historical_block_{};
+    const Buffer* parent_{nullptr};
+    trie::IncrementalStateRoot* state_root_{nullptr};
+    HistoryCache* history_cache_{nullptr};
+    StateFilter* state_filter_{nullptr};
+    StateCache* state_cache_{nullptr};
+    ChangedKeys* changed_keys_{nullptr};
 
     absl::btree_map<Bytes, BlockHeader> headers_{};
     absl::btree_map<Bytes, BlockBody> bodies_{};
@@ -140,16 +236,65 @@ class Buffer : public State {
 
     // State
 
-    mutable absl::flat_hash_map<evmc::address, std::optional<Account>> accounts_;
-
-    // address -> incarnation -> location -> value
-    mutable absl::flat_hash_map<evmc::address,
-                                absl::btree_map<uint64_t, absl::flat_hash_map<evmc::bytes32, evmc::bytes32>>>
-        storage_;
-
-    absl::btree_map<evmc::address, uint64_t> incarnations_;
-    absl::btree_map<evmc::bytes32, Bytes> hash_to_code_;
-    absl::btree_map<Bytes, evmc::bytes32> storage_prefix_to_code_hash_;
+    // Slot arrays of hash tables are large and probed at random: they go to huge pages when enabled
+    template <class T>
+    using HashMapAllocator = CountingAllocator<T, HugePageAllocator>;
+    template <class K, class V, class Hash = typename absl::flat_hash_map<K, V>::hasher>
+    using CountedHashMap = absl::flat_hash_map<K, V, Hash, typename absl::flat_hash_map<K, V>::key_equal,
+                                               HashMapAllocator<std::pair<const K, V>>>;
+    template <class K, class V>
+    using CountedBtreeMap = absl::btree_map<K, V, std::less<K>, CountingAllocator<std::pair<const K, V>>>;
+
+    // Declared ahead of the containers using it, so that it outlives them
+    mutable size_t state_allocated_size_{0};  // Bytes allocated by state containers
+    size_t state_payload_size_{0};            // Out-of-line payloads of state containers (e.g. code)
+
+    mutable CountedHashMap<evmc::address, std::optional<Account>, AddressHasher> accounts_{
+        HashMapAllocator<std::pair<const evmc::address, std::optional<Account>>>{&state_allocated_size_}};
+
+    //! \brief Fixed-width composite key of a storage slot
+    struct StorageKey {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 location;
+
+        friend bool operator==(const StorageKey&, const StorageKey&) = default;
+
+        //! \brief Same order as PlainState keys (address, incarnation) and duplicates (location)
+        friend bool operator<(const StorageKey& a, const StorageKey& b) noexcept {
+            if (a.address != b.address) {
+                return a.address < b.address;
+            }
+            if (a.incarnation != b.incarnation) {
+                return a.incarnation < b.incarnation;
+            }
+            return a.location < b.location;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H h, const StorageKey& key) {
+            h = H::combine_contiguous(std::move(h), key.address.bytes, kAddressLength);
+            h = H::combine_contiguous(std::move(h), key.location.bytes, kHashLength);
+            return H::combine(std::move(h), key.incarnation);
+        }
+    };
+
+    // (address, incarnation, location) -> value
+    // A single flat table with inline values: one probe per lookup. Sorted only once, when flushed to db
+    mutable CountedHashMap<StorageKey, evmc::bytes32> storage_{
+        HashMapAllocator<std::pair<const StorageKey, evmc::bytes32>>{&state_allocated_size_}};
+
+    // Sorted index of state built by prepare_state_write
+    bool state_write_prepared_{false};
+    std::vector<evmc::address> sorted_addresses_;
+    std::vector<const std::pair<const StorageKey, evmc::bytes32>*> sorted_slots_;
+
+    CountedBtreeMap<evmc::address, uint64_t> incarnations_{
+        CountingAllocator<std::pair<const evmc::address, uint64_t>>{&state_allocated_size_}};
+    CountedBtreeMap<evmc::bytes32, Bytes> hash_to_code_{
+        CountingAllocator<std::pair<const evmc::bytes32, Bytes>>{&state_allocated_size_}};
+    CountedBtreeMap<Bytes, evmc::bytes32> storage_prefix_to_code_hash_{
+        CountingAllocator<std::pair<const Bytes, evmc::bytes32>>{&state_allocated_size_}};
 
     // History and changesets
 
@@ -163,7 +308,7 @@ class Buffer : public State {
 
     // Current block stuff
     uint64_t block_number_{0};
-    absl::flat_hash_set<evmc::address> changed_storage_;
+    FlatAddressSet changed_storage_;
 };
 
 }  // namespace silkworm::db
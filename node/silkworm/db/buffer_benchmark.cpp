@@ -0,0 +1,110 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/buffer.hpp>
+
+namespace silkworm::db {
+
+static std::vector<evmc::address> random_addresses(size_t count) {
+    std::mt19937_64 rng{42};
+    std::vector<evmc::address> addresses(count);
+    for (evmc::address& address : addresses) {
+        for (auto& b : address.bytes) {
+            b = static_cast<uint8_t>(rng());
+        }
+    }
+    return addresses;
+}
+
+static void update_accounts(Buffer& buffer, const std::vector<evmc::address>& addresses, uint64_t nonce) {
+    static constexpr auto kLocation{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    Account account;
+    account.nonce = nonce;
+    account.balance = nonce;
+    account.incarnation = kDefaultIncarnation;
+    evmc::bytes32 value;
+    endian::store_big_u64(&value.bytes[kHashLength - 8], nonce);
+    for (const evmc::address& address : addresses) {
+        buffer.update_account(address, std::nullopt, account);
+        buffer.update_storage(address, kDefaultIncarnation, kLocation, {}, value);
+    }
+}
+
+// Changes of a block touching range(0) contracts, accrued in memory
+static void BM_DbBuffer_Update(benchmark::State& state) {
+    test::Context context;
+    const std::vector<evmc::address> addresses{random_addresses(static_cast<size_t>(state.range(0)))};
+
+    uint64_t block_number{1};
+    for ([[maybe_unused]] auto _ : state) {
+        Buffer buffer{context.txn(), 0};
+        buffer.begin_block(block_number);
+        update_accounts(buffer, addresses, block_number++);
+        benchmark::DoNotOptimize(buffer.current_batch_state_size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_DbBuffer_Update)->Arg(1'000)->Arg(10'000);
+
+// Flush of the changes above to the db
+static void BM_DbBuffer_WriteToDb(benchmark::State& state) {
+    test::Context context;
+    const std::vector<evmc::address> addresses{random_addresses(static_cast<size_t>(state.range(0)))};
+
+    uint64_t block_number{1};
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        Buffer buffer{context.txn(), 0};
+        buffer.begin_block(block_number);
+        update_accounts(buffer, addresses, block_number++);
+        state.ResumeTiming();
+
+        buffer.write_to_db();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_DbBuffer_WriteToDb)->Arg(1'000)->Arg(10'000);
+
+// Reads of accounts found in the db only, as with a fresh buffer for each batch of blocks
+static void BM_DbBuffer_ReadAccount(benchmark::State& state) {
+    test::Context context;
+    const std::vector<evmc::address> addresses{random_addresses(static_cast<size_t>(state.range(0)))};
+    {
+        Buffer buffer{context.txn(), 0};
+        buffer.begin_block(1);
+        update_accounts(buffer, addresses, 1);
+        buffer.write_to_db();
+    }
+    context.commit_and_renew_txn();
+
+    for ([[maybe_unused]] auto _ : state) {
+        Buffer buffer{context.txn(), 0};
+        for (const evmc::address& address : addresses) {
+            benchmark::DoNotOptimize(buffer.read_account(address));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * addresses.size()));
+}
+BENCHMARK(BM_DbBuffer_ReadAccount)->Arg(1'000)->Arg(10'000);
+
+}  // namespace silkworm::db
@@ -21,6 +21,7 @@
 #include <silkworm/common/test_context.hpp>
 #include <silkworm/db/buffer.hpp>
 #include <silkworm/db/tables.hpp>
+#include <silkworm/state/in_memory_state.hpp>
 
 namespace silkworm::db {
 
@@ -67,6 +68,123 @@ TEST_CASE("Storage update") {
     CHECK(db_value_b == zeroless_view(value_b));
 }
 
+TEST_CASE("Storage flush of several contracts") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address_a{0xbe00000000000000000000000000000000000000_address};
+    const auto address_b{0x0a00000000000000000000000000000000000000_address};
+    const auto location_1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto location_2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto value_1{0x0000000000000000000000000000000000000000000000000000000000000111_bytes32};
+    const auto value_2{0x0000000000000000000000000000000000000000000000000000000000000222_bytes32};
+    const auto value_3{0x0000000000000000000000000000000000000000000000000000000000000333_bytes32};
+
+    Buffer buffer{txn, 0};
+    buffer.begin_block(1);
+    buffer.update_storage(address_a, 2, location_2, {}, value_1);
+    buffer.update_storage(address_a, 1, location_1, {}, value_2);
+    buffer.update_storage(address_b, 1, location_1, {}, value_3);
+    Account account_b;
+    account_b.incarnation = 1;
+    buffer.update_account(address_b, std::nullopt, account_b);
+
+    // Reads are served from the buffer
+    CHECK(buffer.read_storage(address_a, 2, location_2) == value_1);
+    CHECK(buffer.read_storage(address_a, 2, location_1) == evmc::bytes32{});
+    CHECK(buffer.read_storage(address_b, 1, location_1) == value_3);
+
+    buffer.write_to_db();
+    CHECK(buffer.current_batch_state_size() == 0);
+
+    auto state{db::open_cursor(txn, table::kPlainState)};
+    CHECK(find_value_suffix(state, storage_prefix(address_a, 2), location_2) == zeroless_view(value_1));
+    CHECK(find_value_suffix(state, storage_prefix(address_a, 1), location_1) == zeroless_view(value_2));
+    CHECK_FALSE(find_value_suffix(state, storage_prefix(address_a, 2), location_1));
+    CHECK(find_value_suffix(state, storage_prefix(address_b, 1), location_1) == zeroless_view(value_3));
+    CHECK(read_account(txn, address_b) == account_b);
+}
+
+TEST_CASE("Buffer reading through parent") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address{0xbe00000000000000000000000000000000000000_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value_1{0x0000000000000000000000000000000000000000000000000000000000000111_bytes32};
+    const auto value_2{0x0000000000000000000000000000000000000000000000000000000000000222_bytes32};
+    Account account;
+    account.nonce = 7;
+
+    Buffer parent{txn, 0};
+    parent.begin_block(1);
+    parent.update_account(address, std::nullopt, account);
+    parent.update_storage(address, kDefaultIncarnation, location, {}, value_1);
+
+    Buffer child{txn, 0, std::nullopt, &parent};
+    CHECK(child.read_account(address) == account);
+    CHECK(child.read_storage(address, kDefaultIncarnation, location) == value_1);
+    CHECK(child.current_batch_state_size() == 0);  // Nothing copied from parent
+
+    // Stale db values are not preloaded over parent ones
+    child.preload_storage(address, kDefaultIncarnation, location, evmc::bytes32{});
+    CHECK(child.read_storage(address, kDefaultIncarnation, location) == value_1);
+
+    child.begin_block(2);
+    child.update_storage(address, kDefaultIncarnation, location, value_1, value_2);
+    CHECK(child.read_storage(address, kDefaultIncarnation, location) == value_2);
+    CHECK(parent.read_storage(address, kDefaultIncarnation, location) == value_1);
+
+    // Parent goes first, then child overrides
+    parent.prepare_state_write();
+    parent.write_to_db();
+    child.detach_parent();
+    CHECK(child.read_account(address) == account);  // Now from db
+    child.write_to_db();
+
+    auto state{db::open_cursor(txn, table::kPlainState)};
+    CHECK(find_value_suffix(state, storage_prefix(address, kDefaultIncarnation), location) ==
+          zeroless_view(value_2));
+}
+
+TEST_CASE("Buffer tracking state root") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address_a{0xbe00000000000000000000000000000000000000_address};
+    const auto address_b{0x6f00000000000000000000000000000000000000_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x0000000000000000000000000000000000000000000000000000000000000111_bytes32};
+    Account account_a;
+    account_a.balance = kEther;
+    Account account_b;
+    account_b.incarnation = kDefaultIncarnation;
+
+    Buffer buffer{txn, 0};
+    CHECK_THROWS(buffer.state_root_hash());
+
+    trie::IncrementalStateRoot state_root;
+    buffer.track_state_root(&state_root);
+    CHECK(buffer.state_root_hash() == kEmptyRoot);
+
+    InMemoryState expected;
+    for (State* state : std::initializer_list<State*>{&buffer, &expected}) {
+        state->begin_block(1);
+        state->update_storage(address_b, kDefaultIncarnation, location, {}, value);
+        state->update_account(address_a, std::nullopt, account_a);
+        state->update_account(address_b, std::nullopt, account_b);
+    }
+    CHECK(buffer.state_root_hash() == expected.state_root_hash());
+    CHECK(buffer.state_root_hash() != kEmptyRoot);
+
+    // Self-destruct wipes storage as well
+    for (State* state : std::initializer_list<State*>{&buffer, &expected}) {
+        state->begin_block(2);
+        state->update_account(address_b, account_b, std::nullopt);
+    }
+    CHECK(buffer.state_root_hash() == expected.state_root_hash());
+}
+
 TEST_CASE("Account update") {
     test::Context context;
     auto& txn{context.txn()};
@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "changed_keys.hpp"
+
+namespace silkworm::db {
+
+void ChangedKeys::reset(BlockNum block_num) {
+    accounts_.clear();
+    storage_.clear();
+    valid_ = true;
+    from_ = block_num;
+    to_ = block_num;
+}
+
+void ChangedKeys::invalidate() noexcept {
+    accounts_.clear();
+    storage_.clear();
+    valid_ = false;
+}
+
+void ChangedKeys::insert_account(const evmc::address& address) {
+    if (valid_) {
+        accounts_.insert(address);
+        check_size();
+    }
+}
+
+void ChangedKeys::insert_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) {
+    if (valid_) {
+        storage_.insert({address, incarnation, location});
+        check_size();
+    }
+}
+
+void ChangedKeys::advance(BlockNum block_num) noexcept {
+    if (valid_) {
+        to_ = block_num;
+    }
+}
+
+void ChangedKeys::check_size() noexcept {
+    // Past this size scanning change sets is cheap compared to the rest of the work anyway
+    if (size() > max_keys_) {
+        invalidate();
+    }
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,90 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <tuple>
+
+#include <absl/container/btree_set.h>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::db {
+
+//! \brief Sorted keys of the accounts and storage locations a range of blocks changed, recorded by Execution as it
+//! writes change sets (see Buffer::record_changed_keys) and handed over to the stages following it in the same sync
+//! cycle, which then need not scan AccountChangeSet and StorageChangeSet again to find them
+//! \details Keys are recorded for blocks after from() up to to(), i.e. the ones committed by Execution since reset().
+//! They're lost on restart and dropped altogether past max_keys: stages fall back to change sets whenever
+//! covers() fails. Not thread safe
+class ChangedKeys {
+  public:
+    static constexpr size_t kDefaultMaxKeys{2'000'000};
+
+    struct StorageKey {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 location;
+
+        friend bool operator<(const StorageKey& lhs, const StorageKey& rhs) noexcept {
+            return std::tie(lhs.address, lhs.incarnation, lhs.location) <
+                   std::tie(rhs.address, rhs.incarnation, rhs.location);
+        }
+    };
+
+    explicit ChangedKeys(size_t max_keys = kDefaultMaxKeys) : max_keys_{max_keys} {}
+
+    // not copyable
+    ChangedKeys(const ChangedKeys&) = delete;
+    ChangedKeys& operator=(const ChangedKeys&) = delete;
+
+    //! \brief Drops all keys and starts recording the ones changed by blocks after block_num
+    void reset(BlockNum block_num);
+
+    //! \brief Drops all keys and stops recording until next reset, e.g. after an unwind or an error
+    void invalidate() noexcept;
+
+    void insert_account(const evmc::address& address);
+    void insert_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location);
+
+    //! \brief Marks the changes of blocks up to block_num as recorded
+    void advance(BlockNum block_num) noexcept;
+
+    //! \brief Whether these are exactly the keys changed by blocks in (from, to]
+    [[nodiscard]] bool covers(BlockNum from, BlockNum to) const noexcept {
+        return valid_ && from_ == from && to_ == to;
+    }
+
+    [[nodiscard]] bool valid() const noexcept { return valid_; }
+    [[nodiscard]] BlockNum from() const noexcept { return from_; }
+    [[nodiscard]] BlockNum to() const noexcept { return to_; }
+    [[nodiscard]] size_t size() const noexcept { return accounts_.size() + storage_.size(); }
+
+    [[nodiscard]] const absl::btree_set<evmc::address>& accounts() const noexcept { return accounts_; }
+    [[nodiscard]] const absl::btree_set<StorageKey>& storage() const noexcept { return storage_; }
+
+  private:
+    void check_size() noexcept;
+
+    size_t max_keys_;
+    bool valid_{false};
+    BlockNum from_{0};
+    BlockNum to_{0};
+    absl::btree_set<evmc::address> accounts_;
+    absl::btree_set<StorageKey> storage_;
+};
+
+}  // namespace silkworm::db
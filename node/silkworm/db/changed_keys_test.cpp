@@ -0,0 +1,96 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "changed_keys.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/buffer.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("ChangedKeys") {
+    using evmc::literals::operator""_address;
+    using evmc::literals::operator""_bytes32;
+
+    const auto address1{0x00000000000000000000000000000000000000aa_address};
+    const auto address2{0x00000000000000000000000000000000000000bb_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+
+    SECTION("Block range") {
+        ChangedKeys changed_keys;
+        changed_keys.insert_account(address1);  // not recording yet
+        CHECK(changed_keys.size() == 0);
+        CHECK_FALSE(changed_keys.covers(0, 0));
+
+        changed_keys.reset(5);
+        CHECK(changed_keys.covers(5, 5));
+        changed_keys.insert_account(address2);
+        changed_keys.insert_account(address1);
+        changed_keys.insert_account(address2);
+        changed_keys.advance(8);
+        CHECK(changed_keys.covers(5, 8));
+        CHECK_FALSE(changed_keys.covers(5, 7));
+        CHECK_FALSE(changed_keys.covers(6, 8));
+        REQUIRE(changed_keys.accounts().size() == 2);
+        CHECK(*changed_keys.accounts().begin() == address1);  // sorted
+
+        changed_keys.invalidate();
+        CHECK_FALSE(changed_keys.covers(5, 8));
+        CHECK(changed_keys.size() == 0);
+    }
+
+    SECTION("Bounded") {
+        ChangedKeys changed_keys{/*max_keys=*/2};
+        changed_keys.reset(0);
+        changed_keys.insert_account(address1);
+        changed_keys.insert_storage(address1, kDefaultIncarnation, location);
+        changed_keys.advance(1);
+        CHECK(changed_keys.covers(0, 1));
+        changed_keys.insert_storage(address2, kDefaultIncarnation, location);
+        CHECK_FALSE(changed_keys.valid());
+        CHECK(changed_keys.size() == 0);
+    }
+
+    SECTION("Recorded by buffer") {
+        test::Context context;
+        ChangedKeys changed_keys;
+        changed_keys.reset(0);
+
+        Buffer buffer{context.txn(), 0};
+        buffer.record_changed_keys(&changed_keys);
+        Account account;
+        account.incarnation = kDefaultIncarnation;
+        buffer.begin_block(1);
+        buffer.update_account(address1, std::nullopt, account);
+        buffer.update_storage(address1, kDefaultIncarnation, location, {}, location);
+        buffer.begin_block(2);
+        buffer.update_account(address2, std::nullopt, account);
+        buffer.update_storage(address1, kDefaultIncarnation, location, location, {});
+        CHECK(changed_keys.size() == 0);  // recorded as written to db only
+
+        buffer.write_to_db();
+        CHECK(changed_keys.accounts() == absl::btree_set<evmc::address>{address1, address2});
+        REQUIRE(changed_keys.storage().size() == 1);
+        const auto& storage_key{*changed_keys.storage().begin()};
+        CHECK(storage_key.address == address1);
+        CHECK(storage_key.incarnation == kDefaultIncarnation);
+        CHECK(storage_key.location == location);
+    }
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,92 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "changeset_walk.hpp"
+
+#include <tuple>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/parallel_walk.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+namespace {
+
+    //! \brief Invokes func on each record of blocks [from, to] of a changeset keyed by block number
+    //! \return The number of the last block having changes, 0 if none
+    template <typename Func>
+    BlockNum walk_changeset(::mdbx::txn& txn, const MapConfig& config, BlockNum from, BlockNum to, Func&& func) {
+        BlockNum last_block_num{0};
+        auto changeset{open_cursor(txn, config)};
+        auto data{changeset.lower_bound(to_slice(block_key(from)), /*throw_notfound=*/false)};
+        for (; data.done; data = changeset.to_next(/*throw_notfound=*/false)) {
+            const ByteView key{from_slice(data.key)};
+            const BlockNum block_num{endian::load_big_u64(key.data())};
+            if (block_num > to) {
+                break;
+            }
+            last_block_num = block_num;
+            func(block_num, key.substr(sizeof(BlockNum)), from_slice(data.value));
+        }
+        return last_block_num;
+    }
+
+}  // namespace
+
+BlockNum for_each_account_change(::mdbx::txn& txn, BlockNum from, BlockNum to, const AccountChangeFunc& func) {
+    AccountChange change;
+    return walk_changeset(txn, table::kAccountChangeSet, from, to, [&](BlockNum block_num, ByteView, ByteView value) {
+        change.block_num = block_num;
+        change.address = value.substr(0, kAddressLength);
+        change.value = value.substr(kAddressLength);
+        func(change);
+    });
+}
+
+BlockNum for_each_storage_change(::mdbx::txn& txn, BlockNum from, BlockNum to, const StorageChangeFunc& func) {
+    const ChangeSetFormat format{read_changeset_format(txn)};
+    StorageChange change;
+    const auto walker{[&](BlockNum block_num, ByteView key, ByteView value) {
+        change.block_num = block_num;
+        change.address = key.substr(0, kAddressLength);
+        change.incarnation = endian::load_big_u64(&key[kAddressLength]);
+        std::tie(change.location, change.value) = split_storage_change_value(value, format);
+        func(change);
+    }};
+    return walk_changeset(txn, table::kStorageChangeSet, from, to, walker);
+}
+
+void parallel_for_each_account_change(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                                      size_t ranges_per_thread, const ParallelAccountChangeFunc& func) {
+    parallel_for_block_ranges(env, from, to, num_threads, ranges_per_thread,
+                              [&](size_t worker, ::mdbx::txn& txn, BlockNum range_from, BlockNum range_to) {
+                                  for_each_account_change(txn, range_from, range_to,
+                                                          [&](const AccountChange& change) { func(worker, change); });
+                              });
+}
+
+void parallel_for_each_storage_change(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                                      size_t ranges_per_thread, const ParallelStorageChangeFunc& func) {
+    parallel_for_block_ranges(env, from, to, num_threads, ranges_per_thread,
+                              [&](size_t worker, ::mdbx::txn& txn, BlockNum range_from, BlockNum range_to) {
+                                  for_each_storage_change(txn, range_from, range_to,
+                                                          [&](const StorageChange& change) { func(worker, change); });
+                              });
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+//! \brief An entry of AccountChangeSet. Views point into the database pages of the walking transaction, hence are
+//! valid only until the walking function returns
+struct AccountChange {
+    BlockNum block_num{0};
+    ByteView address;  // 20 bytes
+    ByteView value;    // Encoded account before the block, empty if it did not exist
+};
+
+//! \brief An entry of StorageChangeSet. Views point into the database pages of the walking transaction, hence are
+//! valid only until the walking function returns
+struct StorageChange {
+    BlockNum block_num{0};
+    ByteView address;  // 20 bytes
+    uint64_t incarnation{0};
+    evmc::bytes32 location;  // Decoded, as compact changesets do not store it in full
+    ByteView value;          // Zeroless value before the block, empty if it was zero
+};
+
+using AccountChangeFunc = std::function<void(const AccountChange&)>;
+using StorageChangeFunc = std::function<void(const StorageChange&)>;
+
+//! \brief Walks AccountChangeSet entries of blocks [from, to] in blocks order, without copying keys nor values
+//! \return The number of the last block having changes, 0 if none
+BlockNum for_each_account_change(::mdbx::txn& txn, BlockNum from, BlockNum to, const AccountChangeFunc& func);
+
+//! \brief Walks StorageChangeSet entries of blocks [from, to] in blocks order, without copying keys nor values
+//! \return The number of the last block having changes, 0 if none
+//! \remarks Whichever format changesets are stored in (see read_changeset_format), locations are given in full
+BlockNum for_each_storage_change(::mdbx::txn& txn, BlockNum from, BlockNum to, const StorageChangeFunc& func);
+
+//! \brief Invoked on a change by the thread number worker in [0, num_threads) (see parallel_for_block_ranges)
+using ParallelAccountChangeFunc = std::function<void(size_t worker, const AccountChange&)>;
+using ParallelStorageChangeFunc = std::function<void(size_t worker, const StorageChange&)>;
+
+//! \brief Walks AccountChangeSet entries of blocks [from, to] on num_threads parallel threads, each on its own
+//! read-only transaction taking ranges of consecutive blocks (see parallel_for_block_ranges)
+//! \remarks Changes of the same range come in blocks order and ranges taken by the same worker in ascending order,
+//! hence the first change of a key met by a worker is its earliest one within that worker
+void parallel_for_each_account_change(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                                      size_t ranges_per_thread, const ParallelAccountChangeFunc& func);
+
+//! \brief Same as above for StorageChangeSet entries
+void parallel_for_each_storage_change(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                                      size_t ranges_per_thread, const ParallelStorageChangeFunc& func);
+
+}  // namespace silkworm::db
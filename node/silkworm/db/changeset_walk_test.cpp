@@ -0,0 +1,120 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "changeset_walk.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("Changeset walk") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address1{0x63c696931d3d3fd7cd83472febd193488266660d_address};
+    const auto address2{0xe439698beccd2acfba60eaa7f7b0b073bcebbdf9_address};
+    const auto location1{0xb2559376a79a91a99e2a5b644fe9cafdce005b8ad5359c49645ce225e62e6ba5_bytes32};
+    const auto location2{0x0000000000000000000000000000000000000000000000000000000000000017_bytes32};
+    const Bytes value1{*from_hex("c9b131a4")};
+    const Bytes value2{*from_hex("076ebaf477f0")};
+
+    // Blocks 10 to 109 change both accounts, odd ones storage of address1 too
+    {
+        const ChangeSetFormat format{read_changeset_format(txn)};
+        auto account_changeset{open_cursor(txn, table::kAccountChangeSet)};
+        auto storage_changeset{open_cursor(txn, table::kStorageChangeSet)};
+        for (BlockNum block_num{10}; block_num < 110; ++block_num) {
+            const Bytes key{block_key(block_num)};
+            for (const auto& address : {address1, address2}) {
+                Bytes value{ByteView{address}};
+                value.append(block_num % 2 ? value1 : value2);
+                account_changeset.upsert(to_slice(key), to_slice(value));
+            }
+            if (block_num % 2) {
+                const Bytes storage_key{storage_change_key(block_num, address1, kDefaultIncarnation)};
+                for (const auto& location : {location1, location2}) {
+                    const Bytes value{storage_change_value(location, value2, format)};
+                    storage_changeset.upsert(to_slice(storage_key), to_slice(value));
+                }
+            }
+        }
+    }
+
+    SECTION("Accounts") {
+        std::vector<std::tuple<BlockNum, evmc::address, Bytes>> changes;
+        const BlockNum last{for_each_account_change(txn, 20, 29, [&](const AccountChange& change) {
+            changes.emplace_back(change.block_num, to_evmc_address(change.address), Bytes{change.value});
+        })};
+        CHECK(last == 29);
+        REQUIRE(changes.size() == 20);
+        CHECK(changes.front() == std::make_tuple(BlockNum{20}, address1, value2));
+        CHECK(changes[1] == std::make_tuple(BlockNum{20}, address2, value2));
+        CHECK(changes.back() == std::make_tuple(BlockNum{29}, address2, value1));
+
+        CHECK(for_each_account_change(txn, 200, 300, [](const AccountChange&) { FAIL(); }) == 0);
+    }
+
+    SECTION("Storage") {
+        std::vector<std::tuple<BlockNum, evmc::address, uint64_t, evmc::bytes32, Bytes>> changes;
+        const BlockNum last{for_each_storage_change(txn, 0, 20, [&](const StorageChange& change) {
+            changes.emplace_back(change.block_num, to_evmc_address(change.address), change.incarnation,
+                                 change.location, Bytes{change.value});
+        })};
+        CHECK(last == 19);
+        REQUIRE(changes.size() == 10);
+        CHECK(changes.front() == std::make_tuple(BlockNum{11}, address1, kDefaultIncarnation, location2, value2));
+        CHECK(changes.back() == std::make_tuple(BlockNum{19}, address1, kDefaultIncarnation, location1, value2));
+    }
+
+    SECTION("Parallel") {
+        context.commit_txn();
+        constexpr size_t kThreads{4};
+        std::vector<std::vector<BlockNum>> worker_blocks(kThreads);
+        parallel_for_each_account_change(context.env(), 30, 109, kThreads, /*ranges_per_thread=*/4,
+                                         [&](size_t worker, const AccountChange& change) {
+                                             worker_blocks[worker].push_back(change.block_num);
+                                         });
+        size_t account_changes{0};
+        for (const auto& blocks : worker_blocks) {
+            // Ranges of a worker come in ascending order
+            CHECK(std::is_sorted(blocks.begin(), blocks.end()));
+            account_changes += blocks.size();
+        }
+        CHECK(account_changes == 160);
+
+        std::mutex mutex;
+        std::vector<BlockNum> storage_blocks;
+        parallel_for_each_storage_change(context.env(), 0, 200, kThreads, /*ranges_per_thread=*/4,
+                                         [&](size_t, const StorageChange& change) {
+                                             std::scoped_lock lock{mutex};
+                                             storage_blocks.push_back(change.block_num);
+                                         });
+        CHECK(storage_blocks.size() == 100);
+    }
+}
+
+}  // namespace silkworm::db
@@ -16,13 +16,78 @@
 
 #include "genesis.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
 #include <silkworm/chain/genesis.hpp>
-#include <silkworm/state/in_memory_state.hpp>
+#include <silkworm/common/parallel_for.hpp>
 #include <silkworm/trie/hash_builder.hpp>
+#include <silkworm/trie/vector_root.hpp>
 
 #include "tables.hpp"
 
 namespace silkworm::db {
+
+namespace {
+
+    using Allocation = std::pair<evmc::address, Account>;
+
+    size_t nibble_prefix_length(const evmc::bytes32& a, const evmc::bytes32& b) {
+        const size_t length{prefix_length(ByteView{a.bytes, kHashLength}, ByteView{b.bytes, kHashLength})};
+        if (length == kHashLength) {
+            return 2 * length;
+        }
+        return 2 * length + ((a.bytes[length] >> 4) == (b.bytes[length] >> 4) ? 1 : 0);
+    }
+
+    //! rief State root of allocations sorted by address: addresses are hashed and leaf nodes built on several threads,
+    //! only the assembly of the trie is sequential
+    evmc::bytes32 allocations_root(const std::vector<Allocation>& allocations) {
+        static constexpr size_t kLeavesPerTask{256};
+        const size_t num_tasks{(allocations.size() + kLeavesPerTask - 1) / kLeavesPerTask};
+        const size_t num_threads{allocations.size() >= trie::kParallelRootHashThreshold ? hardware_threads() : 1};
+
+        std::vector<std::pair<evmc::bytes32, const Account*>> leaves(allocations.size());
+        parallel_for(num_tasks, num_threads, [&](size_t task) {
+            const size_t end{std::min(allocations.size(), (task + 1) * kLeavesPerTask)};
+            for (size_t i{task * kLeavesPerTask}; i < end; ++i) {
+                leaves[i] = {to_bytes32(keccak256(allocations[i].first).bytes), &allocations[i].second};
+            }
+        });
+        std::sort(leaves.begin(), leaves.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        // A leaf hangs just below the deepest branch node it shares with its neighbours
+        std::vector<trie::HashBuilder::NodeRef> node_refs(leaves.size());
+        parallel_for(num_tasks, num_threads, [&](size_t task) {
+            uint8_t key[trie::HashBuilder::kMaxKeyLength];
+            Bytes rlp_buffer;
+            const size_t end{std::min(leaves.size(), (task + 1) * kLeavesPerTask)};
+            for (size_t i{task * kLeavesPerTask}; i < end; ++i) {
+                size_t depth{0};
+                if (leaves.size() > 1) {
+                    const size_t preceding_len{i > 0 ? nibble_prefix_length(leaves[i - 1].first, leaves[i].first) : 0};
+                    const size_t succeeding_len{
+                        i + 1 < leaves.size() ? nibble_prefix_length(leaves[i].first, leaves[i + 1].first) : 0};
+                    depth = std::max(preceding_len, succeeding_len) + 1;
+                }
+                trie::unpack_nibbles(ByteView{leaves[i].first.bytes, kHashLength}, key);
+                node_refs[i] = trie::HashBuilder::leaf_node_ref(ByteView{key, sizeof(key)}.substr(depth),
+                                                                leaves[i].second->rlp(kEmptyRoot), rlp_buffer);
+            }
+        });
+
+        trie::HashBuilder hb;
+        uint8_t key[trie::HashBuilder::kMaxKeyLength];
+        for (size_t i{0}; i < leaves.size(); ++i) {
+            trie::unpack_nibbles(ByteView{leaves[i].first.bytes, kHashLength}, key);
+            hb.add_leaf_node_ref(ByteView{key, sizeof(key)}, node_refs[i]);
+        }
+        return hb.root_hash();
+    }
+
+}  // namespace
+
 std::pair<bool, std::vector<std::string>> validate_genesis_json(const nlohmann::json& genesis_json) {
     std::pair<bool, std::vector<std::string>> ret{true, {}};
     if (genesis_json.is_discarded()) {
@@ -133,46 +198,44 @@ bool initialize_genesis(mdbx::txn& txn, const nlohmann::json& genesis_json, bool
     }
 
     try {
-        InMemoryState state_buffer{};
         evmc::bytes32 state_root_hash{kEmptyRoot};
 
         // Allocate accounts
         if (genesis_json.contains("alloc")) {
-            auto expected_allocations{genesis_json["alloc"].size()};
-
+            std::vector<Allocation> allocations;
+            allocations.reserve(genesis_json["alloc"].size());
             for (auto& item : genesis_json["alloc"].items()) {
                 auto address_bytes{from_hex(item.key())};
-                evmc::address account_address = to_evmc_address(*address_bytes);
                 auto balance_str{item.value()["balance"].get<std::string>()};
-                Account account{0, intx::from_string<intx::uint256>(balance_str)};
-                state_buffer.update_account(account_address, std::nullopt, account);
+                allocations.emplace_back(to_evmc_address(*address_bytes),
+                                         Account{0, intx::from_string<intx::uint256>(balance_str)});
             }
 
-            auto applied_allocations{static_cast<size_t>(state_buffer.account_changes().at(0).size())};
-            if (applied_allocations != expected_allocations) {
+            // Sorted by address, so that a fresh plain state is appended to
+            std::sort(allocations.begin(), allocations.end(),
+                      [](const Allocation& a, const Allocation& b) { return a.first < b.first; });
+            if (std::adjacent_find(allocations.begin(), allocations.end(),
+                                   [](const Allocation& a, const Allocation& b) { return a.first == b.first; }) !=
+                allocations.end()) {
                 // Maybe some account alloc has been inserted twice ?
                 throw std::logic_error("Allocations mismatch. Check uniqueness of accounts");
             }
 
             // Write allocations to db - no changes only accounts
-            // Also compute state_root_hash in a single pass
-            std::map<evmc::bytes32, Bytes> account_rlp;
             auto state_table{db::open_cursor(txn, db::table::kPlainState)};
-            for (const auto& [address, account] : state_buffer.accounts()) {
-                // Store account plain state
+            const bool append{!state_table.to_last(/*throw_notfound=*/false)};
+            for (const auto& [address, account] : allocations) {
                 Bytes encoded{account.encode_for_storage()};
-                state_table.upsert(db::to_slice(address), db::to_slice(encoded));
-
-                // First pass for state_root_hash
-                ethash::hash256 hash{keccak256(address)};
-                account_rlp[to_bytes32(hash.bytes)] = account.rlp(kEmptyRoot);
+                if (append) {
+                    state_table.append(db::to_slice(address), db::to_slice(encoded));
+                } else {
+                    state_table.upsert(db::to_slice(address), db::to_slice(encoded));
+                }
             }
 
-            trie::HashBuilder hb;
-            for (const auto& [hash, rlp] : account_rlp) {
-                hb.add_leaf(trie::unpack_nibbles(hash), rlp);
+            if (!allocations.empty()) {
+                state_root_hash = allocations_root(allocations);
             }
-            state_root_hash = hb.root_hash();
         }
 
         const BlockHeader header{read_genesis_header(genesis_json, state_root_hash)};
@@ -19,6 +19,7 @@
 #include <catch2/catch.hpp>
 
 #include <silkworm/chain/genesis.hpp>
+#include <silkworm/chain/identity.hpp>
 #include <silkworm/common/test_context.hpp>
 
 namespace silkworm {
@@ -35,30 +36,35 @@ namespace db {
             REQUIRE(db::initialize_genesis(txn, genesis_json, /*allow_exceptions=*/false));
             context.commit_and_renew_txn();
             CHECK(db::read_chain_config(txn) == silkworm::kMainnetConfig);
+            CHECK(db::read_canonical_header_hash(txn, 0) == silkworm::kMainnetIdentity.genesis_hash);
         }
         SECTION("Initialize with Goerli") {
             auto source_data{silkworm::read_genesis_data(silkworm::kGoerliConfig.chain_id)};
             auto genesis_json = nlohmann::json::parse(source_data, nullptr, /*allow_exceptions=*/false);
             REQUIRE(db::initialize_genesis(txn, genesis_json, /*allow_exceptions=*/false));
             CHECK(db::read_chain_config(txn) == silkworm::kGoerliConfig);
+            CHECK(db::read_canonical_header_hash(txn, 0) == silkworm::kGoerliIdentity.genesis_hash);
         }
         SECTION("Initialize with Rinkeby") {
             auto source_data{silkworm::read_genesis_data(silkworm::kRinkebyConfig.chain_id)};
             auto genesis_json = nlohmann::json::parse(source_data, nullptr, /*allow_exceptions=*/false);
             REQUIRE(db::initialize_genesis(txn, genesis_json, /*allow_exceptions=*/false));
             CHECK(db::read_chain_config(txn) == silkworm::kRinkebyConfig);
+            CHECK(db::read_canonical_header_hash(txn, 0) == silkworm::kRinkebyIdentity.genesis_hash);
         }
         SECTION("Initialize with Ropsten") {
             auto source_data{silkworm::read_genesis_data(silkworm::kRopstenConfig.chain_id)};
             auto genesis_json = nlohmann::json::parse(source_data, nullptr, /*allow_exceptions=*/false);
             REQUIRE(db::initialize_genesis(txn, genesis_json, /*allow_exceptions=*/false));
             CHECK(db::read_chain_config(txn) == silkworm::kRopstenConfig);
+            CHECK(db::read_canonical_header_hash(txn, 0) == silkworm::kRopstenIdentity.genesis_hash);
         }
         SECTION("Initialize with Sepolia") {
             auto source_data{silkworm::read_genesis_data(silkworm::kSepoliaConfig.chain_id)};
             auto genesis_json = nlohmann::json::parse(source_data, nullptr, /*allow_exceptions=*/false);
             REQUIRE(db::initialize_genesis(txn, genesis_json, /*allow_exceptions=*/false));
             CHECK(db::read_chain_config(txn) == silkworm::kSepoliaConfig);
+            CHECK(db::read_canonical_header_hash(txn, 0) == silkworm::kSepoliaIdentity.genesis_hash);
         }
 
         SECTION("Initialize with invalid Json") {
@@ -0,0 +1,184 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "geometry.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+#include <silkworm/db/parallel_walk.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+namespace {
+
+    // MDBX page layout
+    constexpr size_t kPageHeaderSize{20};
+    constexpr size_t kNodeHeaderSize{8};
+    constexpr size_t kNodeIndexSize{2};
+    constexpr size_t kOverflowPointerSize{4};
+    constexpr double kFillFactor{0.693};  // ln(2): average fill of B+tree pages under random inserts
+
+    // NVMe-class storage
+    constexpr double kReadLatency{80.0};         // Microseconds per random read
+    constexpr double kReadThroughput{2'000.0};  // Bytes per microsecond
+
+    constexpr size_t kMinAdvisedPageSize{4_Kibi};
+    constexpr size_t kMinGrowthStep{256_Mebi};
+    constexpr size_t kMaxGrowthStep{16_Gibi};
+
+    uint64_t ceil_div(uint64_t a, uint64_t b) { return (a + b - 1) / b; }
+
+}  // namespace
+
+size_t grow_geometry(::mdbx::env& env, size_t headroom) {
+    const auto info{env.get_info()};
+    const size_t used{static_cast<size_t>((info.mi_last_pgno + 1) * info.mi_dxb_pagesize)};
+    const auto current{static_cast<size_t>(info.mi_geo.current)};
+    const auto upper{static_cast<size_t>(info.mi_geo.upper)};
+    const auto step{static_cast<size_t>(info.mi_geo.grow)};
+
+    size_t target{used + headroom};
+    if (step) {
+        target = static_cast<size_t>(ceil_div(target, step) * step);
+    }
+    target = std::min(target, upper);
+    if (target <= current) {
+        return 0;
+    }
+    ::mdbx::error::success_or_throw(::mdbx_env_set_geometry(env, /*size_lower=*/-1, static_cast<intptr_t>(target),
+                                                            /*size_upper=*/-1, /*growth_step=*/-1,
+                                                            /*shrink_threshold=*/-1, /*pagesize=*/-1));
+    return target;
+}
+
+MapShape sample_map_shape(::mdbx::txn& txn, const MapConfig& config, size_t max_samples) {
+    MapShape ret{};
+    Cursor cursor{txn, config};
+    const auto stat{txn.get_map_stat(cursor.map())};
+    ret.entries = stat.ms_entries;
+    ret.data_size = (stat.ms_branch_pages + stat.ms_leaf_pages + stat.ms_overflow_pages) * stat.ms_psize;
+    if (!ret.entries || !max_samples) {
+        return ret;
+    }
+
+    // A run of consecutive records from the first key of each range
+    const std::vector<Bytes> starts{partition_keys(txn, config, std::max<size_t>(max_samples / 256, 1))};
+    const size_t run_length{std::max<size_t>(max_samples / starts.size(), 1)};
+    uint64_t samples{0};
+    size_t key_bytes{0};
+    size_t value_bytes{0};
+    for (const auto& start : starts) {
+        auto data{start.empty() ? cursor.to_first(/*throw_notfound=*/false)
+                                : cursor.lower_bound(to_slice(start), /*throw_notfound=*/false)};
+        for (size_t i{0}; data && i < run_length; ++i) {
+            ++samples;
+            key_bytes += data.key.length();
+            value_bytes += data.value.length();
+            data = cursor.to_next(/*throw_notfound=*/false);
+        }
+    }
+    ret.key_size = static_cast<double>(key_bytes) / static_cast<double>(samples);
+    ret.value_size = static_cast<double>(value_bytes) / static_cast<double>(samples);
+    return ret;
+}
+
+PagesEstimate estimate_pages(const MapShape& shape, size_t page_size, size_t cache_bytes) {
+    PagesEstimate ret{.page_size = page_size};
+    if (!shape.entries) {
+        return ret;
+    }
+
+    const auto usable{static_cast<double>(page_size - kPageHeaderSize) * kFillFactor};
+    const auto key_size{static_cast<size_t>(std::ceil(shape.key_size))};
+    const auto value_size{static_cast<size_t>(std::ceil(shape.value_size))};
+
+    // A leaf must hold at least two nodes: larger values are moved to pages of their own
+    const size_t max_node_size{(((page_size - kPageHeaderSize) / 2) & ~size_t{1}) - kNodeIndexSize};
+    size_t node_size{kNodeHeaderSize + key_size + value_size};
+    uint64_t overflow_pages_per_record{0};
+    if (node_size > max_node_size) {
+        node_size = kNodeHeaderSize + key_size + kOverflowPointerSize;
+        overflow_pages_per_record = ceil_div(kPageHeaderSize + value_size, page_size);
+    }
+    const auto records_per_leaf{
+        std::max<uint64_t>(static_cast<uint64_t>(usable / static_cast<double>(node_size + kNodeIndexSize)), 1)};
+    const auto fanout{std::max<uint64_t>(
+        static_cast<uint64_t>(usable / static_cast<double>(kNodeHeaderSize + key_size + kNodeIndexSize)), 2)};
+
+    ret.leaf_pages = ceil_div(shape.entries, records_per_leaf);
+    ret.overflow_pages = shape.entries * overflow_pages_per_record;
+
+    // Pages of each level from leaves up to root
+    std::vector<uint64_t> levels{ret.leaf_pages};
+    while (levels.back() > 1) {
+        levels.push_back(ceil_div(levels.back(), fanout));
+        ret.branch_pages += levels.back();
+    }
+    ret.depth = levels.size();
+
+    // Top levels are the hottest ones, hence the ones kept in cache
+    size_t cached_bytes{0};
+    for (auto it{levels.rbegin()}; it != levels.rend(); ++it) {
+        cached_bytes += static_cast<size_t>(*it) * page_size;
+        if (cached_bytes > cache_bytes) {
+            break;
+        }
+        ++ret.cached_levels;
+    }
+    const auto page_reads{static_cast<double>(ret.depth - ret.cached_levels + overflow_pages_per_record)};
+    ret.read_time = page_reads * (kReadLatency + static_cast<double>(page_size) / kReadThroughput);
+    return ret;
+}
+
+PageSizeAdvice advise_page_size(const std::vector<MapShape>& shapes, size_t cache_bytes) {
+    PageSizeAdvice ret{};
+    const size_t total_size{std::accumulate(shapes.begin(), shapes.end(), size_t{0},
+                                            [](size_t sum, const MapShape& shape) { return sum + shape.data_size; })};
+
+    ret.estimates.resize(shapes.size());
+    double best_time{0};
+    for (size_t page_size{kMinAdvisedPageSize}; page_size <= kMaxPageSize; page_size *= 2) {
+        double time{0};
+        for (size_t i{0}; i < shapes.size(); ++i) {
+            const size_t share{total_size ? static_cast<size_t>(static_cast<double>(cache_bytes) *
+                                                                static_cast<double>(shapes[i].data_size) /
+                                                                static_cast<double>(total_size))
+                                          : cache_bytes / shapes.size()};
+            const auto& estimate{ret.estimates[i].emplace_back(estimate_pages(shapes[i], page_size, share))};
+            time += estimate.read_time;
+        }
+        if (!ret.page_size || time < best_time) {
+            best_time = time;
+            ret.page_size = page_size;
+        }
+    }
+    return ret;
+}
+
+size_t advise_growth_step(size_t file_size, size_t max_size) {
+    size_t step{std::clamp(std::bit_floor(file_size / 16), kMinGrowthStep, kMaxGrowthStep)};
+    if (max_size >= 2) {
+        step = std::min(step, std::bit_floor(max_size / 2));
+    }
+    return step;
+}
+
+}  // namespace silkworm::db
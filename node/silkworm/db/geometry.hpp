@@ -0,0 +1,84 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief Grows the datafile ahead of demand so that at least headroom bytes are free past the last used page
+//! \param [in] env : the environment to grow
+//! \param [in] headroom : the free space wanted, rounded up to a multiple of the growth step and capped by the upper
+//! bound of the geometry
+//! \return The new size of the datafile or zero if no growth was needed
+//! \remarks Few large extensions spare writers the remap stalls of growth-step sized ones. Not to be called while a
+//! write transaction is in progress
+size_t grow_geometry(::mdbx::env& env, size_t headroom);
+
+//! \brief Average shape of the records of a map
+struct MapShape {
+    uint64_t entries{0};   // Number of records (values for multi-value maps)
+    double key_size{0};    // Average key size in bytes
+    double value_size{0};  // Average value size in bytes
+    size_t data_size{0};   // Size of all pages of the map at its current page size
+};
+
+//! \brief Samples the records of a map to estimate its shape
+//! \remarks Samples are spread over the key space (see partition_keys)
+MapShape sample_map_shape(::mdbx::txn& txn, const MapConfig& config, size_t max_samples = 4096);
+
+//! \brief Estimated layout of a map's B+tree for a given page size
+struct PagesEstimate {
+    size_t page_size{0};
+    size_t depth{0};             // Levels of the tree, leaves included
+    uint64_t branch_pages{0};    // Pages of all inner levels
+    uint64_t leaf_pages{0};      //
+    uint64_t overflow_pages{0};  // Pages holding values too large to fit a leaf
+    size_t cached_levels{0};     // How many top levels fit the cache budget given to estimate_pages
+    double read_time{0};         // Expected storage time of a random lookup (microseconds)
+
+    [[nodiscard]] size_t bytes() const noexcept { return (branch_pages + leaf_pages + overflow_pages) * page_size; }
+};
+
+//! \brief Estimates the B+tree of a map with the given shape for a page size
+//! \param [in] cache_bytes : the memory available to keep the top levels of the tree in the page cache
+//! \remarks Models MDBX page layout with pages filled to ln(2) (random inserts). A lookup reads from storage the levels
+//! not fitting the cache and the overflow pages of its value, each read costing the latency and transfer time of
+//! NVMe-class storage: smaller pages mean shorter reads, larger ones fewer levels and overflows. Multi-value maps are
+//! modelled as flat trees of key + value records
+PagesEstimate estimate_pages(const MapShape& shape, size_t page_size, size_t cache_bytes);
+
+//! \brief Recommended page size and estimates for each candidate
+struct PageSizeAdvice {
+    size_t page_size{0};
+    std::vector<std::vector<PagesEstimate>> estimates;  // For each shape, one estimate per candidate page size
+};
+
+//! \brief Picks the page size (4 KiB to 64 KiB) minimizing the overall read time of random lookups on the given maps
+//! \param [in] cache_bytes : the memory available to the page cache, shared among maps in proportion to their size
+//! \remarks Ties are resolved in favor of the smaller page size, which writes fewer bytes per changed record
+PageSizeAdvice advise_page_size(const std::vector<MapShape>& shapes, size_t cache_bytes);
+
+//! \brief Recommended growth step of a datafile: about 1/16 of its size as a power of 2 within [256 MiB, 16 GiB]
+//! \remarks Capped to half of max_size
+size_t advise_growth_step(size_t file_size, size_t max_size);
+
+}  // namespace silkworm::db
@@ -0,0 +1,118 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "geometry.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("Grow geometry") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;  // Max size 64 MiB, growth step 2 MiB
+    auto env{open_env(db_config)};
+
+    const auto info{env.get_info()};
+    const size_t used{static_cast<size_t>((info.mi_last_pgno + 1) * info.mi_dxb_pagesize)};
+    const size_t headroom{static_cast<size_t>(info.mi_geo.current) - used + 4_Mebi};
+    const size_t new_size{grow_geometry(env, headroom)};
+    REQUIRE(new_size >= used + headroom);
+    CHECK(new_size % 2_Mebi == 0);
+    CHECK(env.get_info().mi_geo.current == new_size);
+
+    // Enough headroom already
+    CHECK(grow_geometry(env, headroom) == 0);
+
+    // Capped by max size
+    CHECK(grow_geometry(env, 1_Gibi) == 64_Mebi);
+    CHECK(grow_geometry(env, 1_Gibi) == 0);
+}
+
+TEST_CASE("Sample map shape") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    const MapConfig config{"Numbers"};
+
+    auto txn{env.start_write()};
+    CHECK(sample_map_shape(txn, config).entries == 0);
+
+    Cursor cursor{txn, config};
+    Bytes key(8, '\0');
+    const Bytes value(32, '\0');
+    for (size_t i{0}; i < 10'000; ++i) {
+        endian::store_big_u64(key.data(), i * 7);
+        cursor.upsert(to_slice(key), to_slice(value));
+    }
+
+    const MapShape shape{sample_map_shape(txn, config, /*max_samples=*/1'000)};
+    CHECK(shape.entries == 10'000);
+    CHECK(shape.key_size == 8);
+    CHECK(shape.value_size == 32);
+    CHECK(shape.data_size > 0);
+}
+
+TEST_CASE("Page size advice") {
+    const MapShape state{1'000'000'000, /*key_size=*/32, /*value_size=*/40, /*data_size=*/100_Gibi};
+
+    SECTION("Estimates") {
+        CHECK(estimate_pages(MapShape{}, 4_Kibi, 0).depth == 0);
+
+        size_t previous_depth{SIZE_MAX};
+        for (size_t page_size{4_Kibi}; page_size <= kMaxPageSize; page_size *= 2) {
+            const PagesEstimate estimate{estimate_pages(state, page_size, /*cache_bytes=*/0)};
+            CHECK(estimate.depth <= previous_depth);
+            CHECK(estimate.depth > 1);
+            CHECK(estimate.cached_levels == 0);
+            CHECK(estimate.overflow_pages == 0);
+            previous_depth = estimate.depth;
+
+            const PagesEstimate cached{estimate_pages(state, page_size, /*cache_bytes=*/SIZE_MAX)};
+            CHECK(cached.cached_levels == cached.depth);
+            CHECK(cached.read_time == 0);
+        }
+
+        const MapShape large_values{1'000, /*key_size=*/32, /*value_size=*/6'000, /*data_size=*/0};
+        CHECK(estimate_pages(large_values, 4_Kibi, 0).overflow_pages == 2'000);
+        CHECK(estimate_pages(large_values, 16_Kibi, 0).overflow_pages == 0);
+    }
+
+    SECTION("Page size") {
+        // Deep trees, nothing cached: larger pages save levels
+        CHECK(advise_page_size({state}, /*cache_bytes=*/0).page_size == 16_Kibi);
+        // Inner levels cached: a lookup reads a leaf only, the smaller the better
+        const PageSizeAdvice advice{advise_page_size({state}, /*cache_bytes=*/8_Gibi)};
+        CHECK(advice.page_size == 4_Kibi);
+        REQUIRE(advice.estimates.size() == 1);
+        CHECK(advice.estimates[0].size() == 5);
+    }
+
+    SECTION("Growth step") {
+        CHECK(advise_growth_step(0, 3_Tebi) == 256_Mebi);
+        CHECK(advise_growth_step(64_Gibi, 3_Tebi) == 4_Gibi);
+        CHECK(advise_growth_step(1_Tebi, 3_Tebi) == 16_Gibi);
+        CHECK(advise_growth_step(1_Tebi, 8_Gibi) == 4_Gibi);
+    }
+}
+
+}  // namespace silkworm::db
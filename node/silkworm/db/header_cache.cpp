@@ -0,0 +1,165 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "header_cache.hpp"
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+HeaderCache::HeaderCache(size_t max_headers, size_t max_canonical_hashes)
+    : headers_{max_headers}, total_difficulties_{max_headers}, max_canonical_hashes_{max_canonical_hashes} {}
+
+void HeaderCache::load_all_canonical_hashes(mdbx::txn& txn) {
+    std::vector<evmc::bytes32> hashes;
+    Cursor cursor{txn, table::kCanonicalHashes};
+    if (const auto last{cursor.to_last(/*throw_notfound=*/false)}; last) {
+        hashes.resize(endian::load_big_u64(static_cast<const uint8_t*>(last.key.data())) + 1);
+        cursor.to_first();
+        cursor_for_each_read_ahead(cursor, [&hashes](::mdbx::cursor&, ::mdbx::cursor::move_result& data) {
+            const auto block_number{endian::load_big_u64(static_cast<const uint8_t*>(data.key.data()))};
+            hashes[block_number] = to_bytes32(from_slice(data.value));
+            return true;
+        });
+    }
+
+    std::unique_lock lock{mutex_};
+    canonical_hashes_.clear();
+    dense_canonical_hashes_ = std::move(hashes);
+    dense_ = true;
+}
+
+std::optional<BlockHeader> HeaderCache::read_header(mdbx::txn& txn, BlockNum block_number,
+                                                    const uint8_t (&hash)[kHashLength]) {
+    const auto key{to_bytes32(ByteView{hash, kHashLength})};
+    if (auto header{headers_.get_as_copy(key)}; header) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return header;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    // No lock held while reading: concurrent misses on the same header just decode it twice
+    auto header{db::read_header(txn, block_number, hash)};
+    if (header) {
+        headers_.put(key, *header);
+    }
+    return header;
+}
+
+std::optional<intx::uint256> HeaderCache::read_total_difficulty(mdbx::txn& txn, BlockNum block_number,
+                                                                const uint8_t (&hash)[kHashLength]) {
+    const auto key{to_bytes32(ByteView{hash, kHashLength})};
+    if (auto total_difficulty{total_difficulties_.get_as_copy(key)}; total_difficulty) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return total_difficulty;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto total_difficulty{db::read_total_difficulty(txn, block_number, hash)};
+    if (total_difficulty) {
+        total_difficulties_.put(key, *total_difficulty);
+    }
+    return total_difficulty;
+}
+
+std::optional<evmc::bytes32> HeaderCache::read_canonical_header_hash(mdbx::txn& txn, BlockNum block_number) {
+    {
+        std::shared_lock lock{mutex_};
+        if (dense_) {
+            const auto& hashes{dense_canonical_hashes_};
+            if (block_number < hashes.size() && hashes[block_number] != evmc::bytes32{}) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return hashes[block_number];
+            }
+        } else if (const auto it{canonical_hashes_.find(block_number)}; it != canonical_hashes_.end()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto hash{db::read_canonical_header_hash(txn, block_number)};
+    if (hash) {
+        std::unique_lock lock{mutex_};
+        put_canonical_hash(block_number, *hash);
+    }
+    return hash;
+}
+
+std::optional<BlockHeader> HeaderCache::read_canonical_header(mdbx::txn& txn, BlockNum block_number) {
+    const auto hash{read_canonical_header_hash(txn, block_number)};
+    if (!hash) {
+        return std::nullopt;
+    }
+    return read_header(txn, block_number, hash->bytes);
+}
+
+void HeaderCache::write_canonical_header(mdbx::txn& txn, const BlockHeader& header) {
+    const auto hash{header.hash()};
+    write_canonical_header_hash(txn, hash.bytes, header.number);
+    headers_.put(hash, header);
+}
+
+void HeaderCache::write_canonical_header_hash(mdbx::txn& txn, const uint8_t (&hash)[kHashLength],
+                                              BlockNum block_number) {
+    db::write_canonical_header_hash(txn, hash, block_number);
+    std::unique_lock lock{mutex_};
+    put_canonical_hash(block_number, to_bytes32(ByteView{hash, kHashLength}));
+}
+
+void HeaderCache::erase_canonical_header_hash(BlockNum block_number) {
+    std::unique_lock lock{mutex_};
+    if (block_number < dense_canonical_hashes_.size()) {
+        dense_canonical_hashes_[block_number] = evmc::bytes32{};
+    }
+    canonical_hashes_.erase(block_number);
+}
+
+void HeaderCache::unwind(BlockNum height) {
+    std::unique_lock lock{mutex_};
+    if (height + 1 < dense_canonical_hashes_.size()) {
+        dense_canonical_hashes_.resize(height + 1);
+    }
+    canonical_hashes_.erase(canonical_hashes_.upper_bound(height), canonical_hashes_.end());
+}
+
+void HeaderCache::clear() {
+    headers_.clear();
+    total_difficulties_.clear();
+    std::unique_lock lock{mutex_};
+    canonical_hashes_.clear();
+    dense_canonical_hashes_.clear();  // Still dense, filled again by reads
+}
+
+HeaderCache::Stats HeaderCache::stats() const {
+    return {.hits = hits_.load(std::memory_order_relaxed), .misses = misses_.load(std::memory_order_relaxed)};
+}
+
+void HeaderCache::put_canonical_hash(BlockNum block_number, const evmc::bytes32& hash) {
+    if (dense_) {
+        if (block_number >= dense_canonical_hashes_.size()) {
+            dense_canonical_hashes_.resize(block_number + 1);  // Amortized, the chain grows one block at a time
+        }
+        dense_canonical_hashes_[block_number] = hash;
+        return;
+    }
+    canonical_hashes_.insert_or_assign(block_number, hash);
+    if (canonical_hashes_.size() > max_canonical_hashes_) {
+        canonical_hashes_.erase(canonical_hashes_.begin());
+    }
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,111 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/concurrent_lru_cache.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::db {
+
+//! \brief A cache of decoded headers, total difficulties and canonical hashes in front of access_layer reads, to be
+//! shared by components reading the same recent headers over and over (e.g. header verification during reorgs)
+//! \remarks Thread safe. Headers and total difficulties are keyed by hash, hence never go stale. Canonical hashes are
+//! kept for the highest block numbers only and must be maintained by writing them through the cache and notifying
+//! unwinds. Values read or written by a write transaction are cached straight away: clear() if it gets aborted
+//! Optionally all canonical hashes are kept in a dense array indexed by block number (32 bytes per block, ~500MB for
+//! mainnet), so that canonical lookups of any height never touch the db
+class HeaderCache {
+  public:
+    static constexpr size_t kDefaultMaxHeaders{4'096};
+    static constexpr size_t kDefaultMaxCanonicalHashes{16'384};
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit HeaderCache(size_t max_headers = kDefaultMaxHeaders,
+                         size_t max_canonical_hashes = kDefaultMaxCanonicalHashes);
+
+    // Not copyable nor movable
+    HeaderCache(const HeaderCache&) = delete;
+    HeaderCache& operator=(const HeaderCache&) = delete;
+
+    //! \brief Switches canonical hashes to the dense array, filled with all the ones in table::kCanonicalHashes
+    //! \remarks Those cached so far are dropped. Hashes written or read later are added to the array, which grows
+    //! with the chain and shrinks on unwind. Nothing is evicted anymore
+    void load_all_canonical_hashes(mdbx::txn& txn);
+
+    //! \brief Same as db::read_header
+    std::optional<BlockHeader> read_header(mdbx::txn& txn, BlockNum block_number, const uint8_t (&hash)[kHashLength]);
+
+    //! \brief Same as db::read_total_difficulty
+    std::optional<intx::uint256> read_total_difficulty(mdbx::txn& txn, BlockNum block_number,
+                                                       const uint8_t (&hash)[kHashLength]);
+
+    //! \brief Same as db::read_canonical_header_hash
+    std::optional<evmc::bytes32> read_canonical_header_hash(mdbx::txn& txn, BlockNum block_number);
+
+    //! \brief Reads the canonical header of block_number
+    std::optional<BlockHeader> read_canonical_header(mdbx::txn& txn, BlockNum block_number);
+
+    //! \brief Same as db::write_canonical_header, updating the cache
+    void write_canonical_header(mdbx::txn& txn, const BlockHeader& header);
+
+    //! \brief Same as db::write_canonical_header_hash, updating the cache
+    void write_canonical_header_hash(mdbx::txn& txn, const uint8_t (&hash)[kHashLength], BlockNum block_number);
+
+    //! \brief Drops the cached canonical hash of block_number (e.g. as it has been deleted from db)
+    void erase_canonical_header_hash(BlockNum block_number);
+
+    //! \brief Drops the cached canonical hashes of blocks above height
+    void unwind(BlockNum height);
+
+    //! \brief Drops everything
+    void clear();
+
+    [[nodiscard]] Stats stats() const;
+
+  private:
+    void put_canonical_hash(BlockNum block_number, const evmc::bytes32& hash);
+
+    // Lock striped: readers of different headers seldom contend
+    concurrent_lru_cache<evmc::bytes32, BlockHeader> headers_;
+    concurrent_lru_cache<evmc::bytes32, intx::uint256> total_difficulties_;
+
+    mutable std::shared_mutex mutex_;  // Guards canonical_hashes_, dense_ and dense_canonical_hashes_
+    std::map<BlockNum, evmc::bytes32> canonical_hashes_;  // The lowest block numbers are evicted first
+    const size_t max_canonical_hashes_;
+    bool dense_{false};                                    // Whether dense_canonical_hashes_ is used in place of map
+    std::vector<evmc::bytes32> dense_canonical_hashes_;    // Indexed by block number, zero hash if not cached
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,122 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "header_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/access_layer.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("HeaderCache") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    BlockHeader header;
+    header.number = 42;
+    header.gas_limit = 30'000'000;
+    write_header(txn, header);
+    const auto hash{header.hash()};
+    evmc::bytes32 other_hash{hash};
+    other_hash.bytes[0] ^= 0xff;
+
+    HeaderCache cache{/*max_headers=*/2, /*max_canonical_hashes=*/2};
+
+    SECTION("Headers") {
+        CHECK_FALSE(cache.read_header(txn, header.number, other_hash.bytes));
+        auto read_header{cache.read_header(txn, header.number, hash.bytes)};
+        REQUIRE(read_header);
+        CHECK(read_header->gas_limit == header.gas_limit);
+        CHECK(cache.stats().misses == 2);
+
+        read_header = cache.read_header(txn, header.number, hash.bytes);
+        REQUIRE(read_header);
+        CHECK(read_header->hash() == hash);
+        CHECK(cache.stats().hits == 1);
+    }
+
+    SECTION("Canonical hashes") {
+        CHECK_FALSE(cache.read_canonical_header_hash(txn, header.number));
+        cache.write_canonical_header(txn, header);
+        CHECK(read_canonical_header_hash(txn, header.number) == hash);
+        CHECK(cache.read_canonical_header_hash(txn, header.number) == hash);
+        CHECK(cache.stats().hits == 1);
+
+        const auto canonical_header{cache.read_canonical_header(txn, header.number)};
+        REQUIRE(canonical_header);
+        CHECK(canonical_header->hash() == hash);
+        CHECK(cache.stats().hits == 3);
+    }
+
+    SECTION("Unwind") {
+        cache.write_canonical_header(txn, header);
+
+        // Overwrite db behind the cache, unwind makes it visible
+        write_canonical_header_hash(txn, other_hash.bytes, header.number);
+        CHECK(cache.read_canonical_header_hash(txn, header.number) == hash);
+        cache.unwind(header.number);
+        CHECK(cache.read_canonical_header_hash(txn, header.number) == hash);
+        cache.unwind(header.number - 1);
+        CHECK(cache.read_canonical_header_hash(txn, header.number) == other_hash);
+
+        cache.erase_canonical_header_hash(header.number);
+        write_canonical_header_hash(txn, hash.bytes, header.number);
+        CHECK(cache.read_canonical_header_hash(txn, header.number) == hash);
+    }
+
+    SECTION("Canonical hashes are capped to the highest ones") {
+        for (BlockNum block_number{1}; block_number <= 3; ++block_number) {
+            cache.write_canonical_header_hash(txn, hash.bytes, block_number);
+        }
+        write_canonical_header_hash(txn, other_hash.bytes, 1);
+        write_canonical_header_hash(txn, other_hash.bytes, 3);
+        CHECK(cache.read_canonical_header_hash(txn, 3) == hash);   // Cached
+        CHECK(cache.read_canonical_header_hash(txn, 1) == other_hash);  // Evicted
+    }
+
+    SECTION("Dense canonical hashes") {
+        for (BlockNum block_number{1}; block_number <= 3; ++block_number) {
+            write_canonical_header_hash(txn, hash.bytes, block_number);
+        }
+        cache.load_all_canonical_hashes(txn);
+
+        // Served from memory, db overwritten behind the cache, none evicted
+        write_canonical_header_hash(txn, other_hash.bytes, 1);
+        CHECK(cache.read_canonical_header_hash(txn, 1) == hash);
+        CHECK(cache.read_canonical_header_hash(txn, 3) == hash);
+        CHECK(cache.stats().hits == 2);
+        CHECK_FALSE(cache.read_canonical_header_hash(txn, 0));
+        CHECK_FALSE(cache.read_canonical_header_hash(txn, 4));
+
+        // Growing with the chain
+        cache.write_canonical_header_hash(txn, other_hash.bytes, 5);
+        CHECK(cache.read_canonical_header_hash(txn, 5) == other_hash);
+        CHECK(cache.stats().hits == 3);
+
+        cache.unwind(2);
+        write_canonical_header_hash(txn, other_hash.bytes, 3);
+        CHECK(cache.read_canonical_header_hash(txn, 3) == other_hash);
+        CHECK(cache.read_canonical_header_hash(txn, 1) == hash);
+
+        cache.erase_canonical_header_hash(1);
+        CHECK(cache.read_canonical_header_hash(txn, 1) == other_hash);
+    }
+}
+
+}  // namespace silkworm::db
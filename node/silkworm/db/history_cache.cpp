@@ -0,0 +1,150 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "history_cache.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/history_delta.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+static std::string to_cache_key(ByteView key) { return {byte_ptr_cast(key.data()), key.length()}; }
+
+HistoryCache::HistoryCache(size_t max_chunks, size_t max_seeks) : chunks_{max_chunks}, seeks_{max_seeks} {}
+
+std::optional<ByteView> HistoryCache::account(mdbx::txn& txn, const evmc::address& address, BlockNum block_number) {
+    const ByteView key{address};
+    const std::string memo_key{to_cache_key(key)};
+    if (const Seek* memo{find_seek(memo_key, block_number)}) {
+        return memo->value;
+    }
+
+    Seek seek;
+    if (const auto change_block{
+            seek_change(txn, table::kAccountHistory, table::kAccountHistoryDelta, key, block_number, seek)}) {
+        Cursor change_sets(txn, table::kAccountChangeSet);
+        seek.value = find_value_suffix(change_sets, block_key(*change_block), key);
+    }
+    seeks_.put(memo_key, seek);
+    return seek.value;
+}
+
+std::optional<ByteView> HistoryCache::storage(mdbx::txn& txn, const evmc::address& address, uint64_t incarnation,
+                                              const evmc::bytes32& location, BlockNum block_number) {
+    Bytes key(kAddressLength + kHashLength + sizeof(uint64_t), '\0');
+    std::memcpy(&key[0], address.bytes, kAddressLength);
+    std::memcpy(&key[kAddressLength], location.bytes, kHashLength);
+    endian::store_big_u64(&key[kAddressLength + kHashLength], incarnation);
+    const std::string memo_key{to_cache_key(key)};
+    if (const Seek* memo{find_seek(memo_key, block_number)}) {
+        return memo->value;
+    }
+
+    Seek seek;
+    const ByteView history_key{ByteView{key}.substr(0, kAddressLength + kHashLength)};  // incarnation is not part of it
+    if (const auto change_block{
+            seek_change(txn, table::kStorageHistory, table::kStorageHistoryDelta, history_key, block_number, seek)}) {
+        if (!changeset_format_) {
+            changeset_format_ = read_changeset_format(txn);
+        }
+        Cursor change_sets(txn, table::kStorageChangeSet);
+        seek.value = find_value_suffix(change_sets, storage_change_key(*change_block, address, incarnation),
+                                       storage_change_location(location, *changeset_format_));
+    }
+    seeks_.put(memo_key, seek);
+    return seek.value;
+}
+
+const HistoryCache::Seek* HistoryCache::find_seek(const std::string& memo_key, BlockNum block_number) {
+    const Seek* seek{seeks_.get(memo_key)};
+    if (seek && seek->from <= block_number && block_number <= seek->to) {
+        ++hits_;
+        return seek;
+    }
+    ++misses_;
+    return nullptr;
+}
+
+std::optional<BlockNum> HistoryCache::seek_change(mdbx::txn& txn, const MapConfig& history_table,
+                                                  const MapConfig& delta_table, ByteView key, BlockNum block_number,
+                                                  Seek& seek) {
+    Bytes chunk_key(key.length() + sizeof(BlockNum), '\0');
+    std::memcpy(&chunk_key[0], key.data(), key.length());
+    endian::store_big_u64(&chunk_key[key.length()], block_number);
+
+    Cursor history(txn, history_table);
+    const auto data{history.lower_bound(to_slice(chunk_key), /*throw_notfound=*/false)};
+    if (!data || !data.key.starts_with(to_slice(key))) {
+        // No change in chunks: the last chunk of any key with history has suffix UINT64_MAX. Still there may be deltas
+        const auto first_delta{seek_history_delta(txn, delta_table, key, 0)};
+        if (!first_delta || *first_delta >= block_number) {
+            seek.from = 0;
+            seek.to = first_delta.value_or(std::numeric_limits<BlockNum>::max());
+            return first_delta;
+        }
+        const auto delta_block{seek_history_delta(txn, delta_table, key, block_number)};
+        seek.from = block_number;
+        seek.to = delta_block.value_or(std::numeric_limits<BlockNum>::max());
+        return delta_block;
+    }
+
+    const std::string cache_key{to_cache_key(from_slice(data.key))};
+    std::shared_ptr<const roaring::Roaring64Map> chunk;
+    if (const auto* cached{chunks_.get(cache_key)}) {
+        chunk = *cached;
+    } else {
+        chunk = std::make_shared<const roaring::Roaring64Map>(bitmap::read(from_slice(data.value)));
+        chunks_.put(cache_key, chunk);
+    }
+
+    const auto change_block{bitmap::seek(*chunk, block_number)};
+    if (!change_block) {
+        // Past the last chunk only deltas are left, which may hold changes before block_number too
+        const auto delta_block{seek_history_delta(txn, delta_table, key, block_number)};
+        seek.from = block_number;
+        seek.to = delta_block.value_or(std::numeric_limits<BlockNum>::max());
+        return delta_block;
+    }
+    seek.to = *change_block;
+
+    // The range starts after the previous change, if in this very chunk (earlier chunks are not looked at)
+    seek.from = block_number;
+    if (block_number > 0) {
+        const uint64_t rank{chunk->rank(block_number - 1)};
+        uint64_t previous_change{0};
+        if (rank > 0 && chunk->select(rank - 1, &previous_change)) {
+            seek.from = previous_change + 1;
+        }
+    }
+
+    return change_block;
+}
+
+void HistoryCache::clear() noexcept {
+    chunks_.clear();
+    seeks_.clear();
+    changeset_format_.reset();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,88 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/lru_cache.hpp>
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+//! \brief A cache in front of the historical lookups of read_account and read_storage, to be shared by the historical
+//! Buffers of consecutive blocks (e.g. replaying or scanning a range of blocks) so that the same history chunks are
+//! not located and decoded over and over.
+//! Decoded AccountHistory/StorageHistory chunks are kept by chunk key. On top of that, the last lookup of each account
+//! or storage location is memoized along with the range of blocks it holds for (those having no change in between),
+//! hence further lookups within that range take neither a history seek nor a change set seek.
+//! \remarks Not thread safe. Values are views into the pages of the transaction they have been read with: a cache must
+//! only be used with a single read transaction and be cleared as soon as that is renewed or closed
+class HistoryCache {
+  public:
+    static constexpr size_t kDefaultMaxChunks{4'096};
+    static constexpr size_t kDefaultMaxSeeks{65'536};
+
+    explicit HistoryCache(size_t max_chunks = kDefaultMaxChunks, size_t max_seeks = kDefaultMaxSeeks);
+
+    // not copyable
+    HistoryCache(const HistoryCache&) = delete;
+    HistoryCache& operator=(const HistoryCache&) = delete;
+
+    //! \brief Encoded account as of block_number from AccountChangeSet, std::nullopt if it hasn't changed since then
+    //! (i.e. it's to be read from PlainState)
+    std::optional<ByteView> account(mdbx::txn& txn, const evmc::address& address, BlockNum block_number);
+
+    //! \brief Zeroless storage value as of block_number from StorageChangeSet, std::nullopt if it hasn't changed since
+    //! then (i.e. it's to be read from PlainState)
+    std::optional<ByteView> storage(mdbx::txn& txn, const evmc::address& address, uint64_t incarnation,
+                                    const evmc::bytes32& location, BlockNum block_number);
+
+    //! \brief Lookups served by memoized ones, without any db access
+    [[nodiscard]] size_t hits() const noexcept { return hits_; }
+    [[nodiscard]] size_t misses() const noexcept { return misses_; }
+
+    void clear() noexcept;
+
+  private:
+    // Outcome of a lookup, the same for all blocks in [from, to]
+    struct Seek {
+        BlockNum from{0};
+        BlockNum to{0};
+        std::optional<ByteView> value;
+    };
+
+    // Memoized lookup under memo_key if it holds for block_number, nullptr otherwise
+    const Seek* find_seek(const std::string& memo_key, BlockNum block_number);
+
+    // First block not lower than block_number in which the entity under key changed, as per history table and its
+    // deltas. Also sets the range of blocks seek holds for
+    std::optional<BlockNum> seek_change(mdbx::txn& txn, const MapConfig& history_table, const MapConfig& delta_table,
+                                        ByteView key, BlockNum block_number, Seek& seek);
+
+    lru_cache<std::string, std::shared_ptr<const roaring::Roaring64Map>> chunks_;
+    lru_cache<std::string, Seek> seeks_;
+    std::optional<ChangeSetFormat> changeset_format_;
+    size_t hits_{0};
+    size_t misses_{0};
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,123 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "history_cache.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/chain/protocol_param.hpp>
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/history_delta.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/execution/execution.hpp>
+#include <silkworm/stagedsync/stagedsync.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("HistoryCache") {
+    using evmc::literals::operator""_address;
+
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto miner_a{0x00000000000000000000000000000000000000aa_address};
+    const auto miner_b{0x00000000000000000000000000000000000000bb_address};
+    const auto never_touched{0x00000000000000000000000000000000000000cc_address};
+
+    Buffer buffer{txn, 0};
+    for (BlockNum block_num{1}; block_num <= 4; ++block_num) {
+        Block block;
+        block.header.number = block_num;
+        block.header.beneficiary = block_num % 2 ? miner_a : miner_b;
+        REQUIRE(execute_block(block, buffer, kMainnetConfig) == ValidationResult::kOk);
+    }
+    buffer.write_to_db();
+
+    RWTxn tm{txn};
+    REQUIRE(stagedsync::stage_account_history(tm, context.dir().etl().path()) == stagedsync::StageResult::kSuccess);
+
+    HistoryCache cache{/*max_chunks=*/2, /*max_seeks=*/2};
+
+    SECTION("Same reads as without cache") {
+        for (const auto& address : {miner_a, miner_b, never_touched}) {
+            for (BlockNum block_num{1}; block_num <= 5; ++block_num) {
+                const auto expected{read_account(txn, address, block_num)};
+                const auto cached{read_account(txn, address, block_num, &cache)};
+                REQUIRE(cached.has_value() == expected.has_value());
+                if (expected) {
+                    CHECK(cached->balance == expected->balance);
+                }
+            }
+        }
+    }
+
+    SECTION("Reads between changes are memoized") {
+        CHECK_FALSE(read_account(txn, miner_a, 1, &cache));  // created in block 1
+        CHECK(read_account(txn, miner_a, 2, &cache)->balance == param::kBlockRewardFrontier);
+        CHECK(read_account(txn, miner_a, 3, &cache)->balance == param::kBlockRewardFrontier);
+        CHECK(cache.hits() == 1);  // block 3 holds the same as block 2
+        CHECK(read_account(txn, miner_a, 5, &cache)->balance == 2 * param::kBlockRewardFrontier);  // from PlainState
+        CHECK_FALSE(read_account(txn, never_touched, 3, &cache));
+        CHECK_FALSE(read_account(txn, never_touched, 1, &cache));
+        CHECK(cache.hits() == 2);
+        CHECK(cache.misses() == 4);
+
+        cache.clear();
+        CHECK(read_account(txn, miner_a, 4, &cache)->balance == 2 * param::kBlockRewardFrontier);
+        CHECK(cache.hits() == 0);
+        CHECK(cache.misses() == 1);
+    }
+
+    SECTION("Changes in deltas") {
+        std::vector<std::optional<intx::uint256>> expected;
+        for (const auto& address : {miner_a, miner_b, never_touched}) {
+            for (BlockNum block_num{1}; block_num <= 5; ++block_num) {
+                const auto account{read_account(txn, address, block_num)};
+                expected.push_back(account ? std::optional{account->balance} : std::nullopt);
+            }
+        }
+
+        // Move blocks 3 and 4 out of chunks into deltas, as forward at chain tip would have written them
+        auto history_table{open_cursor(txn, table::kAccountHistory)};
+        auto delta_table{open_cursor(txn, table::kAccountHistoryDelta)};
+        for (const auto& [address, block_num] : {std::pair{miner_a, BlockNum{3}}, std::pair{miner_b, BlockNum{4}}}) {
+            bitmap::truncate(history_table, ByteView{address}, 3);
+            append_history_deltas(delta_table, ByteView{address}, roaring::Roaring64Map::bitmapOf(1, block_num));
+        }
+
+        size_t i{0};
+        for (const auto& address : {miner_a, miner_b, never_touched}) {
+            for (BlockNum block_num{1}; block_num <= 5; ++block_num, ++i) {
+                const auto account{read_account(txn, address, block_num)};
+                const auto cached{read_account(txn, address, block_num, &cache)};
+                REQUIRE(account.has_value() == expected[i].has_value());
+                REQUIRE(cached.has_value() == expected[i].has_value());
+                if (expected[i]) {
+                    CHECK(account->balance == *expected[i]);
+                    CHECK(cached->balance == *expected[i]);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace silkworm::db
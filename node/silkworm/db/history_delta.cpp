@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "history_delta.hpp"
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+const MapConfig& history_delta_config(bool storage) {
+    return storage ? table::kStorageHistoryDelta : table::kAccountHistoryDelta;
+}
+
+void append_history_deltas(::mdbx::cursor& delta_table, ByteView key, const roaring::Roaring64Map& blocks) {
+    Bytes value(sizeof(BlockNum), '\0');
+    for (const BlockNum block_num : blocks) {
+        endian::store_big_u64(value.data(), block_num);
+        delta_table.upsert(to_slice(key), to_slice(value));
+    }
+}
+
+std::optional<BlockNum> seek_history_delta(::mdbx::txn& txn, const MapConfig& delta_config, ByteView key,
+                                           BlockNum block_number) {
+    if (!has_map(txn, delta_config.name)) {
+        return std::nullopt;
+    }
+    Cursor deltas(txn, delta_config);
+    Bytes value(sizeof(BlockNum), '\0');
+    endian::store_big_u64(value.data(), block_number);
+    const auto data{deltas.lower_bound_multivalue(to_slice(key), to_slice(value), /*throw_notfound=*/false)};
+    if (!data) {
+        return std::nullopt;
+    }
+    return endian::load_big_u64(static_cast<const uint8_t*>(data.value.data()));
+}
+
+void truncate_history_deltas(::mdbx::cursor& delta_table, ByteView key, BlockNum from) {
+    Bytes value(sizeof(BlockNum), '\0');
+    endian::store_big_u64(value.data(), from);
+    // Deltas are few per key (the ones of blocks near the tip): seeking again after each erase keeps it simple
+    while (delta_table.lower_bound_multivalue(to_slice(key), to_slice(value), /*throw_notfound=*/false)) {
+        delta_table.erase();
+    }
+}
+
+size_t for_each_history_delta(::mdbx::cursor& delta_table, const HistoryDeltaFunc& func) {
+    size_t num_keys{0};
+    roaring::Roaring64Map blocks;
+    auto data{delta_table.to_first(/*throw_notfound=*/false)};
+    while (data) {
+        const Bytes key{from_slice(data.key)};
+        blocks.clear();
+        while (data) {
+            blocks.add(endian::load_big_u64(static_cast<const uint8_t*>(data.value.data())));
+            data = delta_table.to_current_next_multi(/*throw_notfound=*/false);
+        }
+        func(key, blocks);
+        ++num_keys;
+        data = delta_table.to_next(/*throw_notfound=*/false);
+    }
+    return num_keys;
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,50 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief Delta table accompanying a history index, i.e. kStorageHistoryDelta or kAccountHistoryDelta
+//! \remarks Deltas of a key are blocks above all the ones in its chunks: readers look at them only when the chunks
+//! have no change at or after the requested block
+const MapConfig& history_delta_config(bool storage);
+
+//! \brief Appends the blocks of a bitmap to the deltas of key
+void append_history_deltas(::mdbx::cursor& delta_table, ByteView key, const roaring::Roaring64Map& blocks);
+
+//! \brief Finds the first block not less than block_number among the deltas of key
+//! \remarks Databases opened read-only may predate delta tables: they have no deltas at all
+std::optional<BlockNum> seek_history_delta(::mdbx::txn& txn, const MapConfig& delta_config, ByteView key,
+                                           BlockNum block_number);
+
+//! \brief Removes all the deltas of key not less than from
+void truncate_history_deltas(::mdbx::cursor& delta_table, ByteView key, BlockNum from);
+
+using HistoryDeltaFunc = std::function<void(ByteView key, const roaring::Roaring64Map& blocks)>;
+
+//! \brief Walks the delta table in key order, passing all the deltas of each key as a bitmap
+//! \return The number of keys walked
+size_t for_each_history_delta(::mdbx::cursor& delta_table, const HistoryDeltaFunc& func);
+
+}  // namespace silkworm::db
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "history_delta.hpp"
+
+#include <map>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("History deltas") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address1{0x63c696931d3d3fd7cd83472febd193488266660d_address};
+    const auto address2{0xe439698beccd2acfba60eaa7f7b0b073bcebbdf9_address};
+    const ByteView key1{address1};
+    const ByteView key2{address2};
+    const MapConfig& delta_config{history_delta_config(/*storage=*/false)};
+
+    {
+        auto delta_table{open_cursor(txn, delta_config)};
+        append_history_deltas(delta_table, key1, roaring::Roaring64Map::bitmapOf(3, 100, 105, 110));
+        append_history_deltas(delta_table, key2, roaring::Roaring64Map::bitmapOf(1, 101));
+        append_history_deltas(delta_table, key1, roaring::Roaring64Map::bitmapOf(2, 110, 120));  // 110 is kept once
+    }
+
+    SECTION("Seek") {
+        CHECK(seek_history_delta(txn, delta_config, key1, 0) == 100);
+        CHECK(seek_history_delta(txn, delta_config, key1, 100) == 100);
+        CHECK(seek_history_delta(txn, delta_config, key1, 101) == 105);
+        CHECK(seek_history_delta(txn, delta_config, key1, 111) == 120);
+        CHECK_FALSE(seek_history_delta(txn, delta_config, key1, 121));
+        CHECK(seek_history_delta(txn, delta_config, key2, 50) == 101);
+        CHECK_FALSE(seek_history_delta(txn, delta_config, key2, 102));
+        const auto address3{0x0000000000000000000000000000000000000001_address};
+        CHECK_FALSE(seek_history_delta(txn, delta_config, ByteView{address3}, 0));
+    }
+
+    SECTION("Truncate") {
+        auto delta_table{open_cursor(txn, delta_config)};
+        truncate_history_deltas(delta_table, key1, 106);
+        CHECK(seek_history_delta(txn, delta_config, key1, 101) == 105);
+        CHECK_FALSE(seek_history_delta(txn, delta_config, key1, 106));
+        CHECK(seek_history_delta(txn, delta_config, key2, 0) == 101);  // Other keys are untouched
+
+        truncate_history_deltas(delta_table, key1, 0);
+        CHECK_FALSE(seek_history_delta(txn, delta_config, key1, 0));
+    }
+
+    SECTION("Walk") {
+        std::map<Bytes, roaring::Roaring64Map> deltas;
+        auto delta_table{open_cursor(txn, delta_config)};
+        const auto collect{[&](ByteView key, const roaring::Roaring64Map& blocks) { deltas.emplace(key, blocks); }};
+        CHECK(for_each_history_delta(delta_table, collect) == 2);
+        REQUIRE(deltas.size() == 2);
+        CHECK(deltas[Bytes{key1}] == roaring::Roaring64Map::bitmapOf(4, 100, 105, 110, 120));
+        CHECK(deltas[Bytes{key2}] == roaring::Roaring64Map::bitmapOf(1, 101));
+    }
+}
+
+}  // namespace silkworm::db
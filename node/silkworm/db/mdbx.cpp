@@ -16,6 +16,20 @@
 
 #include "mdbx.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <silkworm/common/instrumentation.hpp>
+#include <silkworm/common/memory.hpp>
+#include <silkworm/common/memory_governor.hpp>
+
 namespace silkworm::db {
 
 namespace detail {
@@ -41,6 +55,39 @@ namespace detail {
         return cursor.erase();
     }
 
+    //! \brief Advises huge pages on the mappings of db_file by this process, as listed in /proc/self/maps
+    //! \return The number of bytes advised
+    static size_t advise_map_huge_pages(const std::filesystem::path& db_file) {
+        size_t advised_size{0};
+#if defined(__linux__)
+        const auto file_name{std::filesystem::weakly_canonical(db_file).string()};
+        std::ifstream maps{"/proc/self/maps"};
+        std::string line;
+        while (std::getline(maps, line)) {
+            // Format is "begin-end perms offset dev inode path"
+            if (line.size() <= file_name.size() ||
+                line.compare(line.size() - file_name.size(), file_name.size(), file_name) != 0) {
+                continue;
+            }
+            uintptr_t begin{0};
+            uintptr_t end{0};
+            const char* const first{line.data()};
+            const char* const last{line.data() + line.size()};
+            const auto [dash, ec]{std::from_chars(first, last, begin, 16)};
+            if (ec != std::errc{} || dash == last || *dash != '-' ||
+                std::from_chars(dash + 1, last, end, 16).ec != std::errc{} || end <= begin) {
+                continue;
+            }
+            if (advise_huge_pages(reinterpret_cast<void*>(begin), end - begin)) {
+                advised_size += end - begin;
+            }
+        }
+#else
+        (void)db_file;
+#endif
+        return advised_size;
+    }
+
 }  // namespace detail
 
 ::mdbx::env_managed open_env(const EnvConfig& config) {
@@ -106,14 +153,28 @@ namespace detail {
     if (config.write_map) {
         flags |= MDBX_WRITEMAP;
     }
+    if (config.ephemeral) {
+        // Nothing is ever flushed but by the kernel on its own: best placed on tmpfs. A system crash may corrupt it
+        flags |= MDBX_WRITEMAP | MDBX_UTTERLY_NOSYNC;
+    }
 
     ::mdbx::env_managed::create_parameters cp{};  // Default create parameters
     if (!config.shared) {
         auto max_map_size = static_cast<intptr_t>(config.inmemory ? 64_Mebi : config.max_size);
+        if (config.ephemeral && !config.inmemory) {
+            // Pages are never written back on purpose, so the map can't usefully outgrow the RAM
+            if (const auto ram{total_physical_memory()}; ram && *ram < config.max_size) {
+                max_map_size = static_cast<intptr_t>(*ram);
+            }
+        }
         auto growth_size = static_cast<intptr_t>(config.inmemory ? 2_Mebi : config.growth_size);
         cp.geometry.make_dynamic(::mdbx::env::geometry::default_value, max_map_size);
         cp.geometry.growth_step = growth_size;
-        cp.geometry.pagesize = 4_Kibi;
+        if (config.page_size < kMinPageSize || config.page_size > kMaxPageSize ||
+            !std::has_single_bit(config.page_size)) {
+            throw std::invalid_argument("Invalid argument : config.page_size");
+        }
+        cp.geometry.pagesize = static_cast<intptr_t>(config.page_size);
     }
 
     ::mdbx::env::operate_parameters op{};  // Operational parameters
@@ -145,6 +206,10 @@ namespace detail {
     if (!config.inmemory) {
         ret.check_readers();
     }
+    if (config.huge_pages) {
+        // Mappings MDBX makes afterwards (if any) are not advised
+        (void)detail::advise_map_huge_pages(db_file);
+    }
     return ret;
 }
 
@@ -207,6 +272,184 @@ MDBX_stat Cursor::get_map_stat() const {
     return txn().get_map_stat(map());
 }
 
+void RWTxn::commit(bool renew) {
+    if (external_txn_) {
+        return;
+    }
+    if (renew && !commit_policy_.always()) {
+        if (commit_policy_.forced_only) {
+            return;
+        }
+        // Dirty pages live in memory till committed: they count against the node memory budget too
+        const size_t dirty_size{managed_txn_.get_info().txn_space_dirty};
+        auto& memory_governor{MemoryGovernor::instance()};
+        memory_governor.set_usage(MemoryTag::kDbDirtyPages, dirty_size);
+        const bool size_due{(commit_policy_.dirty_size && dirty_size >= commit_policy_.dirty_size) ||
+                            dirty_size >= memory_governor.allowance(MemoryTag::kDbDirtyPages)};
+        const bool time_due{commit_policy_.interval.count() &&
+                            std::chrono::steady_clock::now() - last_commit_time_ >= commit_policy_.interval};
+        if (!size_due && !time_due) {
+            return;
+        }
+    }
+    do_commit(renew);
+    if (commit_policy_.safe_nosync &&
+        (!renew || (commit_policy_.sync_interval.count() &&
+                    std::chrono::steady_clock::now() - last_sync_time_ >= commit_policy_.sync_interval))) {
+        (void)env_->sync_to_disk();
+        last_sync_time_ = std::chrono::steady_clock::now();
+    }
+}
+
+void RWTxn::force_commit(bool renew) {
+    if (external_txn_) {
+        return;
+    }
+    do_commit(renew);
+    if (commit_policy_.safe_nosync) {
+        (void)env_->sync_to_disk();
+        last_sync_time_ = std::chrono::steady_clock::now();
+    }
+}
+
+void RWTxn::do_commit(bool renew) {
+    /*
+     * renew is required here due to RAII
+     * RWTxn txn(env);
+     * txn.commit();
+     * env.close();
+     * causes a segfault for tx being aborted when the env is already closed
+     *
+     * Workarounds
+     * - either pass renew==false to last commit
+     * - or keep RWTxn in a lower scope
+     * */
+    SILK_SCOPED_TIMER("db::RWTxn::commit");
+    const auto start{std::chrono::steady_clock::now()};
+    commit_stats_.dirty_bytes += managed_txn_.get_info().txn_space_dirty;
+    managed_txn_.commit();
+    MemoryGovernor::instance().set_usage(MemoryTag::kDbDirtyPages, 0);
+    last_commit_time_ = std::chrono::steady_clock::now();
+    commit_stats_.duration += last_commit_time_ - start;
+    ++commit_stats_.count;
+    if (renew) {
+        managed_txn_ = env_->start_write();  // renew transaction
+    }
+}
+
+void RWTxn::set_commit_policy(const CommitPolicy& policy) {
+    commit_policy_ = policy;
+    if (env_) {
+        constexpr auto kUtterlyNoSync{static_cast<unsigned>(MDBX_UTTERLY_NOSYNC)};
+        unsigned flags{0};
+        ::mdbx::error::success_or_throw(::mdbx_env_get_flags(*env_, &flags));
+        if ((flags & kUtterlyNoSync) == kUtterlyNoSync) {
+            commit_policy_.safe_nosync = false;  // Ephemeral env: there is nothing to flush periodically
+            return;
+        }
+        ::mdbx::error::success_or_throw(::mdbx_env_set_flags(*env_, MDBX_SAFE_NOSYNC, policy.safe_nosync));
+    }
+}
+
+BulkLoader::BulkLoader(RWTxn& txn, const MapConfig& config, double dirty_ratio)
+    : txn_{txn},
+      config_{config},
+      cursor_{txn, config},
+      flags_{config.value_mode == ::mdbx::value_mode::single ? MDBX_APPEND : MDBX_APPENDDUP} {
+    uint64_t dirty_pages_limit{0};
+    ::mdbx::error::success_or_throw(::mdbx_env_get_option(txn_->env(), MDBX_opt_txn_dp_limit, &dirty_pages_limit));
+    max_dirty_size_ = static_cast<size_t>(static_cast<double>(dirty_pages_limit * txn_->env().get_pagesize()) *
+                                          dirty_ratio);
+}
+
+void BulkLoader::append(ByteView key, ByteView value) {
+    ::mdbx::slice k{key.data(), key.length()};
+    ::mdbx::slice v{value.data(), value.length()};
+    ::mdbx::error::success_or_throw(cursor_.put(k, &v, flags_));
+    if (++size_ % kCheckInterval == 0 && !txn_.is_external() && txn_->get_info().txn_space_dirty >= max_dirty_size_) {
+        commit();
+        ++commits_;
+    }
+}
+
+void BulkLoader::commit() {
+    txn_.commit();
+    cursor_.bind(txn_, config_);
+}
+
+ROTxnPool::ROTxnPool(::mdbx::env env, size_t max_idle) : env_{env}, max_idle_{max_idle} {}
+
+ROTxnPool::Lease ROTxnPool::acquire() {
+    std::unique_ptr<Slot> slot;
+    {
+        std::unique_lock lock{mutex_};
+        if (!idle_.empty()) {
+            slot = std::move(idle_.back());
+            idle_.pop_back();
+        }
+    }
+    if (slot) {
+        slot->txn.renew_reading();
+        for (auto& [name, cursor] : slot->cursors) {
+            cursor->renew(slot->txn);
+        }
+    } else {
+        slot = std::make_unique<Slot>();
+        slot->txn = env_.start_read();
+    }
+    return Lease{this, std::move(slot)};
+}
+
+size_t ROTxnPool::idle() const {
+    std::unique_lock lock{mutex_};
+    return idle_.size();
+}
+
+void ROTxnPool::release(std::unique_ptr<Slot> slot) noexcept {
+    try {
+        // Releases the snapshot straight away: an idle transaction must not pin pages
+        slot->txn.reset_reading();
+        std::unique_lock lock{mutex_};
+        if (idle_.size() < max_idle_) {
+            idle_.push_back(std::move(slot));
+        }
+    } catch (...) {
+        // Slot is dropped: next acquire starts a new transaction
+    }
+}
+
+ROTxnPool::Lease& ROTxnPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        slot_ = std::move(other.slot_);
+    }
+    return *this;
+}
+
+void ROTxnPool::Lease::refresh() {
+    slot_->txn.reset_reading();
+    slot_->txn.renew_reading();
+    for (auto& [name, cursor] : slot_->cursors) {
+        cursor->renew(slot_->txn);
+    }
+}
+
+Cursor& ROTxnPool::Lease::cursor(const MapConfig& config) {
+    for (auto& [name, cursor] : slot_->cursors) {
+        if (name == config.name) {
+            return *cursor;
+        }
+    }
+    return *slot_->cursors.emplace_back(config.name, std::make_unique<Cursor>(slot_->txn, config)).second;
+}
+
+void ROTxnPool::Lease::release() noexcept {
+    if (slot_) {
+        pool_->release(std::move(slot_));
+    }
+}
+
 bool has_map(::mdbx::txn& tx, const char* map_name) {
     try {
         ::mdbx::map_handle main_map{1};
@@ -253,6 +496,69 @@ size_t cursor_for_count(::mdbx::cursor& cursor, const WalkFunc& walker, size_t c
     return ret;
 }
 
+ScanReadAhead::ScanReadAhead(size_t window, CursorMoveDirection direction) noexcept
+    : forward_{direction == CursorMoveDirection::Forward} {
+#if !defined(_WIN32)
+    page_size_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    jumps_ = kMaxJumps;  // No hints available
+#endif
+    window_ = std::max(page_size_, window / page_size_ * page_size_);
+}
+
+void ScanReadAhead::advise(const ::mdbx::slice& key) noexcept {
+    if (disabled()) {
+        return;
+    }
+    const auto address{reinterpret_cast<uintptr_t>(key.data())};
+    const uintptr_t half{window_ / 2};
+    if (address >= begin_ && address < end_) {
+        // Within advised range: advise the next window once record is less than half a window away from the edge
+        if (forward_ && address >= end_ - half) {
+            advise_range(end_);
+            begin_ = end_ - window_;
+            end_ += window_;
+            jumps_ = 0;
+        } else if (!forward_ && address < begin_ + half) {
+            advise_range(begin_ - window_);
+            end_ = begin_ + window_;
+            begin_ -= window_;
+            jumps_ = 0;
+        }
+        return;
+    }
+
+    // Out of advised range: restart from the page holding the record
+    if (hints_ && ++jumps_ >= kMaxJumps) {
+        return;
+    }
+    const uintptr_t page{address / page_size_ * page_size_};
+    begin_ = forward_ ? page : page + page_size_ - window_;
+    end_ = begin_ + window_;
+    advise_range(begin_);
+}
+
+void ScanReadAhead::advise_range(uintptr_t begin) noexcept {
+    ++hints_;
+#if !defined(_WIN32)
+    (void)::madvise(reinterpret_cast<void*>(begin), window_, MADV_WILLNEED);
+#else
+    (void)begin;
+#endif
+}
+
+size_t cursor_for_each_read_ahead(::mdbx::cursor& cursor, const WalkFunc& walker, const CursorMoveDirection direction,
+                                  size_t window) {
+    ScanReadAhead read_ahead{window, direction};
+    return cursor_for_each(
+        cursor,
+        [&](::mdbx::cursor& c, ::mdbx::cursor::move_result& data) {
+            read_ahead.advise(data.key);
+            return walker(c, data);
+        },
+        direction);
+}
+
 size_t cursor_erase(mdbx::cursor& cursor, const CursorMoveDirection direction) {
     return cursor_for_each(cursor, detail::cursor_erase_data, direction);
 }
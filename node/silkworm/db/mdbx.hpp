@@ -16,9 +16,14 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
@@ -45,6 +50,20 @@ namespace detail {
     };
 }  // namespace detail
 
+//! \brief When commit requests on a managed RWTxn are actually honored. By default (no trigger) each request commits,
+//! otherwise a commit happens as soon as any trigger fires
+struct CommitPolicy {
+    size_t dirty_size{0};                   // Commit once dirty space reaches this size (0 = no size trigger)
+    std::chrono::seconds interval{0};       // Commit once this much time has passed since previous commit (0 = none)
+    bool forced_only{false};                // Ignore all requests: commit on forced commits only (e.g. at cycle end)
+    bool safe_nosync{false};                // Commit without flushing to disk (MDBX_SAFE_NOSYNC): a system crash may
+                                            // lose (not corrupt) the most recent commits
+    std::chrono::seconds sync_interval{0};  // With safe_nosync, flush to disk this often (0 = on forced commits only)
+
+    //! \brief Whether each request commits
+    [[nodiscard]] bool always() const { return !dirty_size && !interval.count() && !forced_only; }
+};
+
 //! \brief This class manages mdbx transactions across stages.
 //! It either creates new mdbx transaction as need be or uses an externally provided transaction.
 //! The external transaction mode is handy for running several stages on a handful of blocks atomically.
@@ -62,34 +81,46 @@ class RWTxn {
     RWTxn(const RWTxn&) = delete;
     RWTxn& operator=(const RWTxn&) = delete;
 
+    //! \brief Whether this is a wrapper over an externally provided transaction (i.e. commits are deferred)
+    [[nodiscard]] bool is_external() const { return external_txn_ != nullptr; }
+
     mdbx::txn& operator*() { return external_txn_ ? *external_txn_ : managed_txn_; }
     mdbx::txn* operator->() { return external_txn_ ? external_txn_ : &managed_txn_; }
 
-    void commit(const bool renew = true) {
-        /*
-         * renew is required here due to RAII
-         * RWTxn txn(env);
-         * txn.commit();
-         * env.close();
-         * causes a segfault for tx being aborted when the env is already closed
-         *
-         * Workarounds
-         * - either pass renew==false to last commit
-         * - or keep RWTxn in a lower scope
-         * */
-
-        if (external_txn_ == nullptr) {
-            managed_txn_.commit();
-            if (renew) {
-                managed_txn_ = env_->start_write();  // renew transaction
-            }
-        }
-    }
+    //! \brief Requests a commit, which is honored according to the commit policy (see CommitPolicy)
+    //! \param [in] renew : whether a new transaction is started after committing. A final commit (i.e. with no
+    //! renewal) is always honored
+    //! \remarks Does nothing when this is a wrapper over an external transaction
+    void commit(bool renew = true);
+
+    //! \brief Commits regardless of the commit policy, e.g. when other transactions have to see written data
+    //! \remarks With safe_nosync policies, committed data is also flushed to disk
+    void force_commit(bool renew = true);
+
+    //! \brief Sets the policy commit requests are honored with from now on
+    //! \remarks Toggles MDBX_SAFE_NOSYNC on the whole environment according to policy, unless it is ephemeral (see
+    //! EnvConfig) hence never synced anyway
+    void set_commit_policy(const CommitPolicy& policy);
+    [[nodiscard]] const CommitPolicy& commit_policy() const { return commit_policy_; }
+
+    //! \brief Totals of the commits this instance has actually performed (i.e. none for an external transaction)
+    struct CommitStats {
+        uint64_t count{0};
+        uint64_t dirty_bytes{0};  // Space dirtied by transactions being committed, i.e. roughly what hits the disk
+        std::chrono::steady_clock::duration duration{0};
+    };
+    [[nodiscard]] const CommitStats& commit_stats() const { return commit_stats_; }
 
   private:
     mdbx::txn* external_txn_{nullptr};
     mdbx::env* env_{nullptr};
     mdbx::txn_managed managed_txn_;
+    CommitStats commit_stats_;
+    CommitPolicy commit_policy_;
+    std::chrono::steady_clock::time_point last_commit_time_{std::chrono::steady_clock::now()};
+    std::chrono::steady_clock::time_point last_sync_time_{std::chrono::steady_clock::now()};
+
+    void do_commit(bool renew);
 };
 
 //! \brief Pointer to a processing function invoked by cursor_for_each & cursor_for_count on each record
@@ -99,6 +130,10 @@ class RWTxn {
 using WalkFunc = std::function<bool(::mdbx::cursor& cursor, ::mdbx::cursor::move_result& data)>;
 
 //! \brief Essential environment settings
+//! \brief Page sizes MDBX can be configured with (powers of 2)
+inline constexpr size_t kMinPageSize{256};
+inline constexpr size_t kMaxPageSize{64_Kibi};
+
 struct EnvConfig {
     std::string path{};
     bool create{false};          // Whether db file must be created
@@ -108,8 +143,12 @@ struct EnvConfig {
     bool shared{false};          // Whether this process opens a db already opened by another process
     bool read_ahead{false};      // Whether to enable mdbx read ahead
     bool write_map{false};       // Whether to enable mdbx write map
+    bool ephemeral{false};       // Whether the db is throwaway (devnets, CI): never synced, see open_env
     size_t max_size{3_Tebi};     // Max mdbx map size
     size_t growth_size{2_Gibi};  // Increment size for each extension
+    size_t page_size{4_Kibi};    // Page size of a newly created db (existing ones keep theirs)
+    size_t headroom_size{0};     // Free space synced dbs are grown to ahead of demand (0 = off, see grow_geometry)
+    bool huge_pages{false};      // Whether to advise transparent huge pages on the map (where the kernel supports)
     uint32_t max_tables{128};    // Default max number of named tables
     uint32_t max_readers{100};   // Default max number of readers
 };
@@ -174,6 +213,116 @@ class Cursor : public ::mdbx::cursor {
     static thread_local ObjectPool<MDBX_cursor, detail::cursor_handle_deleter> handles_pool_;
 };
 
+//! \brief Streams sorted records into a map in append mode, committing the underlying (managed) transaction each
+//! time its dirty pages approach the environment's dirty pages limit: MDBX never has to spill them mid-transaction
+//! \remarks Meant for maps being (re)built from scratch: records must come in strictly increasing order and after any
+//! record already in map. Intermediate commits make loaded records visible before the caller's own final commit,
+//! hence only use on data which is idempotent to reload. No intermediate commit happens on external transactions
+class BulkLoader {
+  public:
+    static constexpr size_t kCheckInterval{1024};  // Records between two checks of dirty pages
+
+    //! \param [in] txn : the transaction to load into
+    //! \param [in] config : the configuration settings for the target map
+    //! \param [in] dirty_ratio : fraction of the dirty pages limit triggering a commit
+    explicit BulkLoader(RWTxn& txn, const MapConfig& config, double dirty_ratio = 0.75);
+
+    // Not copyable nor movable
+    BulkLoader(const BulkLoader&) = delete;
+    BulkLoader& operator=(const BulkLoader&) = delete;
+
+    //! \brief Appends a record (MDBX_APPENDDUP for multi-value maps) committing when needed
+    //! \remarks Throws if record is out of order
+    void append(ByteView key, ByteView value);
+
+    //! \brief Commits what has been loaded so far and rebinds to the renewed transaction
+    void commit();
+
+    //! \brief Number of records appended
+    [[nodiscard]] size_t size() const { return size_; }
+
+    //! \brief Number of intermediate commits
+    [[nodiscard]] size_t commits() const { return commits_; }
+
+  private:
+    RWTxn& txn_;
+    const MapConfig config_;
+    Cursor cursor_;
+    MDBX_put_flags_t flags_;
+    size_t max_dirty_size_;  // Bytes of dirty pages triggering a commit
+    size_t size_{0};
+    size_t commits_{0};
+};
+
+//! \brief Lends read-only transactions on the last committed snapshot, recycling their MDBX handles: a transaction
+//! given back is reset (releasing its snapshot) and renewed on the next acquire, together with the cursors opened
+//! through it. Readers served many times over (RPC calls, warmups) thus skip mdbx_txn_begin and cursor binding costs.
+//! \remarks Thread safe. Relies on MDBX_NOTLS (see open_env) as a transaction may be lent to different threads over
+//! time, though to one at a time. The pool must outlive its leases and be destroyed before its env is closed
+class ROTxnPool {
+  public:
+    class Lease;
+
+    static constexpr size_t kDefaultMaxIdle{64};  // Transactions kept for reuse
+
+    explicit ROTxnPool(::mdbx::env env, size_t max_idle = kDefaultMaxIdle);
+
+    // Not copyable nor movable
+    ROTxnPool(const ROTxnPool&) = delete;
+    ROTxnPool& operator=(const ROTxnPool&) = delete;
+
+    //! \brief Lends a transaction on the last committed snapshot
+    [[nodiscard]] Lease acquire();
+
+    //! \brief Number of transactions given back and waiting for reuse
+    [[nodiscard]] size_t idle() const;
+
+  private:
+    struct Slot {
+        ::mdbx::txn_managed txn;
+        std::vector<std::pair<std::string, std::unique_ptr<Cursor>>> cursors;  // Warm cursors by map name
+    };
+
+    void release(std::unique_ptr<Slot> slot) noexcept;
+
+    ::mdbx::env env_;
+    const size_t max_idle_;
+    mutable std::mutex mutex_;  // Guards idle_
+    std::vector<std::unique_ptr<Slot>> idle_;
+};
+
+//! \brief A read-only transaction lent by ROTxnPool and given back on destruction
+class ROTxnPool::Lease {
+  public:
+    ~Lease() { release(); }
+
+    Lease(Lease&& other) noexcept : pool_{other.pool_}, slot_{std::move(other.slot_)} {}
+    Lease& operator=(Lease&& other) noexcept;
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    [[nodiscard]] ::mdbx::txn& operator*() const { return slot_->txn; }
+    [[nodiscard]] ::mdbx::txn* operator->() const { return &slot_->txn; }
+
+    //! \brief Moves the transaction (and its warm cursors) to the last committed snapshot
+    //! \remarks Cursors positions are lost
+    void refresh();
+
+    //! \brief Returns a cursor on the map, opened once per pooled transaction and kept across leases
+    //! \remarks The cursor is not positioned: seek before reading
+    [[nodiscard]] Cursor& cursor(const MapConfig& config);
+
+  private:
+    friend class ROTxnPool;
+    Lease(ROTxnPool* pool, std::unique_ptr<Slot> slot) : pool_{pool}, slot_{std::move(slot)} {}
+
+    void release() noexcept;
+
+    ROTxnPool* pool_;
+    std::unique_ptr<Slot> slot_;
+};
+
 //! \brief Checks whether a provided map name exists in database
 //! \param [in] tx : a reference to a valid mdbx transaction
 //! \param [in] map_name : the name of the map to check for
@@ -221,6 +370,54 @@ size_t cursor_for_each(::mdbx::cursor& cursor, const WalkFunc& func,
 size_t cursor_for_count(::mdbx::cursor& cursor, const WalkFunc& func, size_t max_count,
                         CursorMoveDirection direction = CursorMoveDirection::Forward);
 
+//! \brief Hints the kernel to read ahead the pages a sequential scan is about to visit. Environments are opened with
+//! MDBX_NORDAHEAD (which suits random lookups), hence cold full table scans otherwise fault in one page at a time.
+//! The scan notifies each record it reaches: a window of pages past the record is advised MADV_WILLNEED and, as the
+//! scan crosses half of it, the next contiguous window is advised. Records far from the advised window (pages of the
+//! map not laid out in key order) restart the window, and too many of those in a row disable the hints altogether.
+//! \remarks Best suited for maps built in append mode (e.g. by ETL loads) whose leaf pages mostly follow keys order.
+//! Advising is a mere hint: pages not (or no longer) mapped are silently ignored
+class ScanReadAhead {
+  public:
+    static constexpr size_t kDefaultWindow{8_Mebi};
+    static constexpr size_t kMaxJumps{16};  // Consecutive window restarts before giving up
+
+    explicit ScanReadAhead(size_t window = kDefaultWindow,
+                           CursorMoveDirection direction = CursorMoveDirection::Forward) noexcept;
+
+    //! \brief Notifies the scan has reached the record whose key is provided
+    void advise(const ::mdbx::slice& key) noexcept;
+
+    //! \brief Number of windows advised so far
+    [[nodiscard]] size_t hints() const noexcept { return hints_; }
+
+    //! \brief Whether hints have been given up on as the map is not laid out in keys order
+    [[nodiscard]] bool disabled() const noexcept { return jumps_ >= kMaxJumps; }
+
+  private:
+    void advise_range(uintptr_t begin) noexcept;
+
+    const bool forward_;
+    size_t page_size_{4_Kibi};
+    size_t window_;
+    uintptr_t begin_{0};  // Currently advised range [begin_, end_)
+    uintptr_t end_{0};
+    size_t jumps_{0};
+    size_t hints_{0};
+};
+
+//! \brief Same as cursor_for_each with kernel read ahead hints for the pages of upcoming records
+//! \param [in] cursor : A reference to a cursor opened on a map
+//! \param [in] func : A pointer to a std::function with the code to execute on records. Note the return value of the
+//! function may stop the loop
+//! \param [in] direction : Whether the cursor should navigate records forward (default) or backwards
+//! \param [in] window : The size of each read ahead window
+//! \return The overall number of processed records
+//! \remarks Meant for cold scans of large maps (see ScanReadAhead)
+size_t cursor_for_each_read_ahead(::mdbx::cursor& cursor, const WalkFunc& func,
+                                  CursorMoveDirection direction = CursorMoveDirection::Forward,
+                                  size_t window = ScanReadAhead::kDefaultWindow);
+
 //! \brief Erases map records by cursor until any record is found
 //! \param [in] cursor : A reference to a cursor opened on a map
 //! \param [in] direction : Whether the cursor should navigate records forward (default) or backwards
@@ -17,11 +17,15 @@
 #include <atomic>
 #include <map>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
 #include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/memory.hpp>
 #include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/util.hpp>
 
 static const std::map<std::string, std::string> kGeneticCode{
     {"AAA", "Lysine"},        {"AAC", "Asparagine"},    {"AAG", "Lysine"},        {"AAU", "Asparagine"},
@@ -164,6 +168,236 @@ TEST_CASE("RWTxn") {
         ext_tx = env.start_write();
         REQUIRE(db::has_map(ext_tx, table_name) == false);
     }
+
+    SECTION("Commit policy") {
+        auto tx{db::RWTxn(env)};
+        db::CommitPolicy policy;
+        policy.forced_only = true;
+        tx.set_commit_policy(policy);
+        (void)tx->create_map(table_name, mdbx::key_mode::usual, mdbx::value_mode::single);
+
+        tx.commit();  // Only a request: nothing committed
+        {
+            auto ro_tx{env.start_read()};
+            CHECK(db::has_map(ro_tx, table_name) == false);
+        }
+        CHECK(tx.commit_stats().count == 0);
+
+        tx.force_commit();
+        {
+            auto ro_tx{env.start_read()};
+            CHECK(db::has_map(ro_tx, table_name));
+        }
+        CHECK(tx.commit_stats().count == 1);
+
+        policy.forced_only = false;
+        policy.dirty_size = 1_Gibi;
+        tx.set_commit_policy(policy);
+        db::Cursor table_cursor(*tx, {table_name});
+        table_cursor.upsert(mdbx::slice{"key"}, mdbx::slice{"value"});
+        tx.commit();  // Below dirty size
+        CHECK(tx.commit_stats().count == 1);
+
+        tx.commit(/*renew=*/false);  // Final commits are always honored
+        CHECK(tx.commit_stats().count == 2);
+        auto ro_tx{env.start_read()};
+        CHECK(ro_tx.get_map_stat(ro_tx.open_map(table_name)).ms_entries == 1);
+    }
+}
+
+TEST_CASE("Ephemeral env") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.ephemeral = true;
+    auto env{open_env(db_config)};
+
+    unsigned flags{0};
+    REQUIRE(::mdbx_env_get_flags(env, &flags) == MDBX_SUCCESS);
+    CHECK((flags & MDBX_WRITEMAP) == MDBX_WRITEMAP);
+    CHECK((flags & MDBX_UTTERLY_NOSYNC) == MDBX_UTTERLY_NOSYNC);
+    if (const auto ram{total_physical_memory()}; ram && *ram < db_config.max_size) {
+        CHECK(env.get_info().mi_geo.upper < db_config.max_size);
+    }
+
+    // Commit policies can't turn syncs back on
+    RWTxn txn{env};
+    CommitPolicy policy;
+    policy.safe_nosync = true;
+    txn.set_commit_policy(policy);
+    CHECK_FALSE(txn.commit_policy().safe_nosync);
+    REQUIRE(::mdbx_env_get_flags(env, &flags) == MDBX_SUCCESS);
+    CHECK((flags & MDBX_UTTERLY_NOSYNC) == MDBX_UTTERLY_NOSYNC);
+    txn.commit(/*renew=*/false);
+}
+
+TEST_CASE("BulkLoader") {
+    const TemporaryDirectory tmp_dir;
+    db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    const db::MapConfig config{"Numbers"};
+    const size_t count{100'000};
+
+    auto key_of{[](size_t i) {
+        Bytes key(8, '\0');
+        endian::store_big_u64(key.data(), i);
+        return key;
+    }};
+
+    SECTION("Managed with intermediate commits") {
+        {
+            db::RWTxn tx{env};
+            db::BulkLoader loader{tx, config, /*dirty_ratio=*/0.0001};
+            for (size_t i{0}; i < count; ++i) {
+                const Bytes key{key_of(i)};
+                loader.append(key, key);
+            }
+            CHECK(loader.size() == count);
+            CHECK(loader.commits() > 0);
+            tx.commit(/*renew=*/false);
+        }
+
+        auto tx{env.start_read()};
+        db::Cursor cursor{tx, config};
+        REQUIRE(cursor.get_map_stat().ms_entries == count);
+        CHECK(db::from_slice(cursor.to_last().key) == key_of(count - 1));
+    }
+
+    SECTION("External") {
+        auto ext_tx{env.start_write()};
+        db::RWTxn tx{ext_tx};
+        db::BulkLoader loader{tx, config, /*dirty_ratio=*/0.0001};
+        for (size_t i{0}; i < count; ++i) {
+            const Bytes key{key_of(i)};
+            loader.append(key, key);
+        }
+        CHECK(loader.commits() == 0);
+        ext_tx.abort();
+    }
+
+    SECTION("Out of order") {
+        db::RWTxn tx{env};
+        db::BulkLoader loader{tx, config};
+        loader.append(key_of(2), key_of(2));
+        CHECK_THROWS(loader.append(key_of(1), key_of(1)));
+    }
+}
+
+TEST_CASE("ROTxnPool") {
+    const TemporaryDirectory tmp_dir;
+    db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    const db::MapConfig config{"Colors"};
+
+    auto put{[&](const char* key, const char* value) {
+        auto tx{env.start_write()};
+        db::Cursor cursor{tx, config};
+        cursor.upsert(mdbx::slice{key}, mdbx::slice{value});
+        tx.commit();
+    }};
+    put("red", "#FF0000");
+
+    db::ROTxnPool pool{env, /*max_idle=*/2};
+    CHECK(pool.idle() == 0);
+
+    SECTION("Transactions are reused on latest snapshot") {
+        db::Cursor* warm_cursor{nullptr};
+        {
+            auto lease{pool.acquire()};
+            CHECK(lease->is_readonly());
+            auto& cursor{lease.cursor(config)};
+            CHECK(&cursor == &lease.cursor(config));
+            CHECK(cursor.seek(mdbx::slice{"red"}));
+            CHECK_FALSE(cursor.seek(mdbx::slice{"blue"}));
+            warm_cursor = &cursor;
+        }
+        CHECK(pool.idle() == 1);
+
+        put("blue", "#0000FF");
+        {
+            auto lease{pool.acquire()};
+            CHECK(pool.idle() == 0);
+            auto& cursor{lease.cursor(config)};
+            CHECK(&cursor == warm_cursor);
+            CHECK(cursor.seek(mdbx::slice{"blue"}));
+        }
+        CHECK(pool.idle() == 1);
+    }
+
+    SECTION("Refresh moves to latest snapshot") {
+        auto lease{pool.acquire()};
+        auto& cursor{lease.cursor(config)};
+        put("green", "#00FF00");
+        CHECK_FALSE(cursor.seek(mdbx::slice{"green"}));
+        lease.refresh();
+        CHECK(cursor.seek(mdbx::slice{"green"}));
+    }
+
+    SECTION("Idle transactions are capped") {
+        {
+            auto lease1{pool.acquire()};
+            auto lease2{pool.acquire()};
+            auto lease3{pool.acquire()};
+            CHECK(pool.idle() == 0);
+        }
+        CHECK(pool.idle() == 2);
+    }
+
+    SECTION("Concurrent leases") {
+        std::atomic_size_t found{0};
+        std::vector<std::thread> readers;
+        for (size_t i{0}; i < 4; ++i) {
+            readers.emplace_back([&] {
+                for (size_t j{0}; j < 100; ++j) {
+                    auto lease{pool.acquire()};
+                    if (lease.cursor(config).seek(mdbx::slice{"red"})) {
+                        ++found;
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        CHECK(found == 400);
+        CHECK(pool.idle() <= 2);
+    }
+}
+
+TEST_CASE("ScanReadAhead") {
+    static constexpr size_t kPageSize{4_Kibi};
+    std::vector<uint8_t> region(64 * kPageSize);
+    auto at{[&](size_t offset) { return mdbx::slice{&region[offset], 1}; }};
+
+    SECTION("Sequential forward") {
+        ScanReadAhead read_ahead{/*window=*/8 * kPageSize};
+        for (size_t offset{0}; offset < region.size(); offset += 64) {
+            read_ahead.advise(at(offset));
+        }
+        CHECK(read_ahead.hints() >= region.size() / (8 * kPageSize));
+        CHECK_FALSE(read_ahead.disabled());
+    }
+
+    SECTION("Sequential reverse") {
+        ScanReadAhead read_ahead{/*window=*/8 * kPageSize, CursorMoveDirection::Reverse};
+        for (size_t offset{region.size()}; offset > 64; offset -= 64) {
+            read_ahead.advise(at(offset - 1));
+        }
+        CHECK(read_ahead.hints() >= region.size() / (8 * kPageSize));
+        CHECK_FALSE(read_ahead.disabled());
+    }
+
+    SECTION("Scattered records disable hints") {
+        ScanReadAhead read_ahead{/*window=*/kPageSize};
+        for (size_t i{0}; i < 2 * ScanReadAhead::kMaxJumps; ++i) {
+            read_ahead.advise(at((i % 2 ? 0 : 32 * kPageSize) + i * 8));
+        }
+        CHECK(read_ahead.disabled());
+        const size_t hints{read_ahead.hints()};
+        read_ahead.advise(at(0));
+        CHECK(read_ahead.hints() == hints);
+    }
 }
 
 TEST_CASE("Cursor walk") {
@@ -246,6 +480,22 @@ TEST_CASE("Cursor walk") {
         CHECK(data_map.at("AAU") == "Asparagine");
     }
 
+    SECTION("cursor_for_each_read_ahead") {
+        for (const auto& [key, value] : kGeneticCode) {
+            table_cursor.upsert(mdbx::slice{key}, mdbx::slice{value});
+        }
+        table_cursor.bind(txn, {table_name});
+        CHECK(cursor_for_each_read_ahead(table_cursor, save_all_data_vec) == kGeneticCode.size());
+        CHECK(data_vec.front().first == "AAA");
+        CHECK(data_vec.size() == kGeneticCode.size());
+        data_vec.clear();
+
+        table_cursor.bind(txn, {table_name});
+        CHECK(cursor_for_each_read_ahead(table_cursor, save_all_data_vec, CursorMoveDirection::Reverse,
+                                         /*window=*/4_Kibi) == kGeneticCode.size());
+        CHECK(data_vec.back().first == "AAA");
+    }
+
     SECTION("cursor_for_count") {
         // empty table
         cursor_for_count(table_cursor, save_all_data_map, /*max_count=*/5);
@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "migrations.hpp"
+
+#include <vector>
+
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+bool migrate_to_compact_changesets(mdbx::txn& txn) {
+    if (read_changeset_format(txn) == ChangeSetFormat::kCompact) {
+        return false;
+    }
+
+    Cursor changes(txn, table::kStorageChangeSet);
+    std::vector<Bytes> values;
+    auto data{changes.to_first(/*throw_notfound=*/false)};
+    while (data) {
+        const Bytes key{from_slice(data.key)};
+        values.clear();
+        for (; data; data = changes.to_current_next_multi(/*throw_notfound=*/false)) {
+            const auto [location, value]{split_storage_change_value(from_slice(data.value), ChangeSetFormat::kPlain)};
+            values.push_back(storage_change_value(location, value, ChangeSetFormat::kCompact));
+        }
+
+        // Compact values sort as the plain ones hence they can be appended
+        (void)changes.find(to_slice(key));
+        changes.erase(/*whole_multivalue=*/true);
+        for (const auto& value : values) {
+            mdbx::slice value_slice{to_slice(value)};
+            mdbx::error::success_or_throw(changes.put(to_slice(key), &value_slice, MDBX_APPENDDUP));
+        }
+        data = changes.to_next(/*throw_notfound=*/false);
+    }
+
+    // Value holds the Execution progress the migration has been applied at
+    Cursor migrations(txn, table::kMigrations);
+    const Bytes progress{block_key(stages::read_stage_progress(txn, stages::kExecutionKey))};
+    migrations.upsert(mdbx::slice{table::kCompactChangeSetsMigration}, to_slice(progress));
+    write_schema_version(txn, table::kCompactChangeSetsSchemaVersion);
+    return true;
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,31 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief Rewrites all table::kStorageChangeSet values in ChangeSetFormat::kCompact, then bumps database schema to
+//! table::kCompactChangeSetsSchemaVersion and records table::kCompactChangeSetsMigration in table::kMigrations
+//! \return False if database already uses compact change sets (nothing is done)
+//! \remarks Changes are not committed. Migration is not reversible and the resulting database is no longer readable
+//! by Erigon
+bool migrate_to_compact_changesets(mdbx::txn& txn);
+
+}  // namespace silkworm::db
@@ -0,0 +1,132 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "migrations.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("Storage change values") {
+    const auto short_location{0x0000000000000000000000000000000000000000000000000000000000000017_bytes32};
+    const auto long_location{0xb2559376a79a91a99e2a5b644fe9cafdce005b8ad5359c49645ce225e62e6ba5_bytes32};
+    const Bytes value{*from_hex("9a31634956ec64b6865a")};
+
+    SECTION("Plain") {
+        const Bytes encoded{storage_change_value(short_location, value, ChangeSetFormat::kPlain)};
+        CHECK(encoded.length() == kHashLength + value.length());
+        const auto [location, previous_value]{split_storage_change_value(encoded, ChangeSetFormat::kPlain)};
+        CHECK(location == short_location);
+        CHECK(previous_value == value);
+    }
+
+    SECTION("Compact") {
+        const Bytes encoded{storage_change_value(short_location, value, ChangeSetFormat::kCompact)};
+        CHECK(encoded == *from_hex("0117" + to_hex(value)));
+        const auto [location, previous_value]{split_storage_change_value(encoded, ChangeSetFormat::kCompact)};
+        CHECK(location == short_location);
+        CHECK(previous_value == value);
+
+        const Bytes zero_location{storage_change_value(evmc::bytes32{}, {}, ChangeSetFormat::kCompact)};
+        CHECK(zero_location == Bytes(1, '\0'));
+        CHECK(split_storage_change_value(zero_location, ChangeSetFormat::kCompact).first == evmc::bytes32{});
+
+        CHECK(storage_change_location(long_location, ChangeSetFormat::kCompact).length() == 1 + kHashLength);
+    }
+
+    SECTION("Compact locations keep their order") {
+        const Bytes a{storage_change_location(
+            0x0000000000000000000000000000000000000000000000000000000000000002_bytes32, ChangeSetFormat::kCompact)};
+        const Bytes b{storage_change_location(
+            0x0000000000000000000000000000000000000000000000000000000000000100_bytes32, ChangeSetFormat::kCompact)};
+        const Bytes c{storage_change_location(long_location, ChangeSetFormat::kCompact)};
+        CHECK(a < b);
+        CHECK(b < c);
+    }
+
+    SECTION("Malformed") {
+        CHECK_THROWS_AS(split_storage_change_value(Bytes(kHashLength - 1, '\0'), ChangeSetFormat::kPlain),
+                        std::runtime_error);
+        CHECK_THROWS_AS(split_storage_change_value({}, ChangeSetFormat::kCompact), std::runtime_error);
+        CHECK_THROWS_AS(split_storage_change_value(*from_hex("21"), ChangeSetFormat::kCompact), std::runtime_error);
+        CHECK_THROWS_AS(split_storage_change_value(*from_hex("0301"), ChangeSetFormat::kCompact), std::runtime_error);
+    }
+}
+
+TEST_CASE("Migrate to compact changesets") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const auto address{0xbe00000000000000000000000000000000000000_address};
+    const auto location_a{0x0000000000000000000000000000000000000000000000000000000000000013_bytes32};
+    const auto location_b{0xb2559376a79a91a99e2a5b644fe9cafdce005b8ad5359c49645ce225e62e6ba5_bytes32};
+    const auto value_a{0x000000000000000000000000000000000000000000000000000000000000006b_bytes32};
+    const auto value_b{0x0000000000000000000000000000000000000000000000000000000000000132_bytes32};
+
+    {
+        Buffer buffer{txn, 0};
+        buffer.begin_block(1);
+        buffer.update_storage(address, kDefaultIncarnation, location_a, /*initial=*/{}, /*current=*/value_a);
+        buffer.update_storage(address, kDefaultIncarnation, location_b, /*initial=*/{}, /*current=*/value_b);
+        buffer.begin_block(2);
+        buffer.update_storage(address, kDefaultIncarnation, location_a, /*initial=*/value_a, /*current=*/value_b);
+        buffer.write_to_db();
+    }
+
+    CHECK(read_changeset_format(txn) == ChangeSetFormat::kPlain);
+    const StorageChanges changes1{read_storage_changes(txn, 1)};
+    const StorageChanges changes2{read_storage_changes(txn, 2)};
+    REQUIRE(changes1.size() == 1);
+    REQUIRE(changes1.at(address).at(kDefaultIncarnation).size() == 2);
+    REQUIRE(changes2.at(address).at(kDefaultIncarnation).at(location_a) == zeroless_view(value_a));
+
+    auto storage_change_table{open_cursor(txn, table::kStorageChangeSet)};
+
+    REQUIRE(migrate_to_compact_changesets(txn));
+    CHECK(read_changeset_format(txn) == ChangeSetFormat::kCompact);
+    CHECK(read_schema_version(txn) == table::kCompactChangeSetsSchemaVersion);
+    CHECK(txn.get_map_stat(storage_change_table.map()).ms_entries == 3);
+    CHECK(read_storage_changes(txn, 1) == changes1);
+    CHECK(read_storage_changes(txn, 2) == changes2);
+
+    auto migrations{open_cursor(txn, table::kMigrations)};
+    CHECK(migrations.find(mdbx::slice{table::kCompactChangeSetsMigration}, /*throw_notfound=*/false));
+
+    // Already migrated
+    CHECK_FALSE(migrate_to_compact_changesets(txn));
+
+    // New changes are written compact
+    {
+        Buffer buffer{txn, 0};
+        buffer.begin_block(3);
+        buffer.update_storage(address, kDefaultIncarnation, location_a, /*initial=*/value_b, /*current=*/value_a);
+        buffer.write_to_db();
+    }
+    const auto data{storage_change_table.find(to_slice(storage_change_key(3, address, kDefaultIncarnation)),
+                                              /*throw_notfound=*/false)};
+    REQUIRE(data);
+    const Bytes expected_value{storage_change_value(location_a, zeroless_view(value_b), ChangeSetFormat::kCompact)};
+    CHECK(from_slice(data.value) == expected_value);
+    CHECK(read_storage_changes(txn, 3).at(address).at(kDefaultIncarnation).at(location_a) == zeroless_view(value_b));
+}
+
+}  // namespace silkworm::db
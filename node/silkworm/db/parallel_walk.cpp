@@ -0,0 +1,213 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "parallel_walk.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+namespace {
+
+    constexpr size_t kSamplesPerPartition{16};
+
+    //! \brief Big endian value of the 8 bytes of key following offset (zero padded)
+    uint64_t load_interpolation_point(ByteView key, size_t offset) {
+        uint8_t buffer[8]{};
+        if (offset < key.length()) {
+            const ByteView tail{key.substr(offset, sizeof(buffer))};
+            std::copy(tail.begin(), tail.end(), buffer);
+        }
+        return endian::load_big_u64(buffer);
+    }
+
+    //! \brief Estimated number of records in [begin, end): a null pointer stands for either end of map
+    size_t estimate_records(::mdbx::txn& txn, ::mdbx::map_handle map, const Bytes* begin, const Bytes* end) {
+        ::mdbx::slice begin_key{begin ? to_slice(*begin) : ::mdbx::slice{}};
+        ::mdbx::slice end_key{end ? to_slice(*end) : ::mdbx::slice{}};
+        ptrdiff_t distance{0};
+        if (::mdbx_estimate_range(txn, map.dbi, begin ? &begin_key : nullptr, nullptr, end ? &end_key : nullptr,
+                                  nullptr, &distance) != MDBX_SUCCESS) {
+            return 1;  // Weight samples evenly
+        }
+        return static_cast<size_t>(std::max<ptrdiff_t>(distance, 0));
+    }
+
+    size_t walk_range(::mdbx::env env, const MapConfig& config, const Bytes& begin, const Bytes* end,
+                      const PartitionWalkerFactory& make_walker) {
+        auto txn{env.start_read()};
+        const WalkFunc walker{make_walker(txn)};
+        Cursor cursor{txn, config};
+        auto data{begin.empty() ? cursor.to_first(/*throw_notfound=*/false)
+                                : cursor.lower_bound(to_slice(begin), /*throw_notfound=*/false)};
+        size_t ret{0};
+        while (data.done && (!end || from_slice(data.key) < *end)) {
+            ++ret;
+            if (!walker(cursor, data)) {
+                break;
+            }
+            data = cursor.to_next(/*throw_notfound=*/false);
+        }
+        return ret;
+    }
+
+}  // namespace
+
+std::vector<Bytes> partition_keys(::mdbx::txn& txn, const MapConfig& config, size_t num_partitions) {
+    std::vector<Bytes> keys{Bytes{}};
+    if (num_partitions < 2 || config.key_mode != ::mdbx::key_mode::usual) {
+        return keys;
+    }
+
+    Cursor cursor{txn, config};
+    const auto first{cursor.to_first(/*throw_notfound=*/false)};
+    if (!first) {
+        return keys;
+    }
+    const Bytes first_key{from_slice(first.key)};
+    const Bytes last_key{from_slice(cursor.to_last().key)};
+
+    // Samples are interpolated over the 8 bytes following the prefix all keys share
+    const auto mismatch{std::mismatch(first_key.begin(), first_key.end(), last_key.begin(), last_key.end())};
+    const auto prefix_length{static_cast<size_t>(mismatch.first - first_key.begin())};
+    const uint64_t low{load_interpolation_point(first_key, prefix_length)};
+    const uint64_t high{load_interpolation_point(last_key, prefix_length)};
+    if (high <= low) {
+        return keys;
+    }
+
+    const size_t num_samples{num_partitions * kSamplesPerPartition};
+    const uint64_t step{(high - low) / num_samples};
+    const uint64_t step_remainder{(high - low) % num_samples};
+    Bytes probe{first_key.substr(0, prefix_length)};
+    probe.resize(prefix_length + sizeof(uint64_t));
+    std::vector<Bytes> samples;
+    for (size_t i{1}; i < num_samples; ++i) {
+        endian::store_big_u64(&probe[prefix_length], low + step * i + step_remainder * i / num_samples);
+        const auto data{cursor.lower_bound(to_slice(probe), /*throw_notfound=*/false)};
+        if (!data) {
+            break;
+        }
+        Bytes sample{from_slice(data.key)};
+        if (sample != first_key && (samples.empty() || samples.back() != sample)) {
+            samples.push_back(std::move(sample));
+        }
+    }
+
+    // Records between consecutive samples: weights[i] covers [samples[i - 1], samples[i]) with map ends at either side
+    std::vector<size_t> weights(samples.size() + 1);
+    size_t total{0};
+    for (size_t i{0}; i < weights.size(); ++i) {
+        weights[i] = estimate_records(txn, cursor.map(), i ? &samples[i - 1] : nullptr,
+                                      i < samples.size() ? &samples[i] : nullptr);
+        total += weights[i];
+    }
+
+    // Each range starts at the first sample past its share of records
+    size_t cumulative{0};
+    for (size_t i{0}; i < samples.size() && keys.size() < num_partitions; ++i) {
+        cumulative += weights[i];
+        if (cumulative * num_partitions >= total * keys.size()) {
+            keys.push_back(samples[i]);
+        }
+    }
+    return keys;
+}
+
+size_t parallel_for_each(::mdbx::env env, const MapConfig& config, size_t num_partitions, const WalkFunc& func) {
+    return parallel_for_each(env, config, num_partitions, [&func](::mdbx::txn&) { return func; });
+}
+
+size_t parallel_for_each(::mdbx::env env, const MapConfig& config, size_t num_partitions,
+                         const PartitionWalkerFactory& make_walker) {
+    std::vector<Bytes> boundaries;
+    {
+        auto txn{env.start_read()};
+        boundaries = partition_keys(txn, config, num_partitions);
+    }
+
+    thread_pool pool{static_cast<uint32_t>(boundaries.size())};
+    std::vector<std::future<size_t>> walks;
+    walks.reserve(boundaries.size());
+    for (size_t i{0}; i < boundaries.size(); ++i) {
+        const Bytes* end{i + 1 < boundaries.size() ? &boundaries[i + 1] : nullptr};
+        walks.push_back(pool.submit([&, i, end] { return walk_range(env, config, boundaries[i], end, make_walker); }));
+    }
+
+    size_t ret{0};
+    std::exception_ptr exception;
+    for (auto& walk : walks) {
+        try {
+            ret += walk.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+    return ret;
+}
+
+void parallel_for_block_ranges(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                               size_t ranges_per_thread, const BlockRangeFunc& func) {
+    if (from > to) {
+        return;
+    }
+    num_threads = std::max<size_t>(num_threads, 1);
+    const BlockNum num_ranges{num_threads * std::max<size_t>(ranges_per_thread, 1)};
+    const BlockNum range_size{(to - from + num_ranges) / num_ranges};
+    std::atomic<BlockNum> next_from{from};
+
+    thread_pool pool{static_cast<uint32_t>(num_threads)};
+    std::vector<std::future<bool>> walks;
+    walks.reserve(num_threads);
+    for (size_t i{0}; i < num_threads; ++i) {
+        walks.push_back(pool.submit([&, i] {
+            auto txn{env.start_read()};
+            for (BlockNum range_from{next_from.fetch_add(range_size)}; range_from <= to;
+                 range_from = next_from.fetch_add(range_size)) {
+                func(i, txn, range_from, std::min(to, range_from + range_size - 1));
+            }
+        }));
+    }
+
+    std::exception_ptr exception;
+    for (auto& walk : walks) {
+        try {
+            (void)walk.get();
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+}  // namespace silkworm::db
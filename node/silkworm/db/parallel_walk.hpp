@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief Invoked once per partition on the thread walking it, with the partition's own read-only transaction
+//! \return The function to be invoked on each record of the partition (see WalkFunc)
+//! \remarks Handy to open per-partition cursors on other maps
+using PartitionWalkerFactory = std::function<WalkFunc(::mdbx::txn& txn)>;
+
+//! \brief Splits the records of a map into contiguous key ranges holding about the same number of records
+//! \param [in] txn : a reference to a valid mdbx transaction
+//! \param [in] config : the configuration settings for the map
+//! \param [in] num_partitions : the number of ranges wanted
+//! \return The sorted first keys of each range: range i spans [keys[i], keys[i + 1]), the last range being open ended.
+//! First key is always empty (i.e. beginning of map). Fewer ranges than requested may be returned (e.g. small maps)
+//! \remarks Boundaries are picked by sampling keys interpolated between the first and last key of the map and then
+//! weighting samples by MDBX estimates of the records in between. Unless keys are sorted lexicographically
+//! (::mdbx::key_mode::usual) a single range is returned
+std::vector<Bytes> partition_keys(::mdbx::txn& txn, const MapConfig& config, size_t num_partitions);
+
+//! \brief Walks all records of a map on parallel threads, each walking a contiguous range of keys (see partition_keys)
+//! on its own read-only transaction
+//! \param [in] env : the environment to open read-only transactions on
+//! \param [in] config : the configuration settings for the map
+//! \param [in] num_partitions : the number of ranges, hence of threads
+//! \param [in] func : the function invoked on each record. Must be thread safe: records of different ranges are
+//! processed concurrently, records of the same range in keys order. A false return value stops only its own range
+//! \return The overall number of processed records
+//! \remarks Rethrows the first exception thrown by any walker once all ranges are done. Multi-value records of the same
+//! key always fall within the same range
+size_t parallel_for_each(::mdbx::env env, const MapConfig& config, size_t num_partitions, const WalkFunc& func);
+
+//! \brief Same as above with a walker function built once per range
+size_t parallel_for_each(::mdbx::env env, const MapConfig& config, size_t num_partitions,
+                         const PartitionWalkerFactory& make_walker);
+
+//! \brief Invoked on a range of blocks [from, to] by the thread number worker in [0, num_threads), on the read-only
+//! transaction of that thread
+using BlockRangeFunc = std::function<void(size_t worker, ::mdbx::txn& txn, BlockNum from, BlockNum to)>;
+
+//! \brief Splits blocks [from, to] into ranges of consecutive blocks, each taken by the first idle of num_threads
+//! parallel threads
+//! \param [in] env : the environment to open read-only transactions on (one per thread)
+//! \param [in] from : the first block (inclusive)
+//! \param [in] to : the last block (inclusive)
+//! \param [in] num_threads : the number of threads
+//! \param [in] ranges_per_thread : the number of ranges per thread. Later blocks are usually much heavier than early
+//! ones: many small ranges keep all threads busy till the end
+//! \param [in] func : the function invoked on each range. Must be thread safe, although the same worker index is never
+//! used concurrently (i.e. safe to index per-thread state)
+//! \remarks Rethrows the first exception thrown by func once all threads are done
+void parallel_for_block_ranges(::mdbx::env env, BlockNum from, BlockNum to, size_t num_threads,
+                               size_t ranges_per_thread, const BlockRangeFunc& func);
+
+}  // namespace silkworm::db
@@ -0,0 +1,147 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "parallel_walk.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("Parallel walk") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    const MapConfig config{"Numbers"};
+    const size_t count{20'000};
+
+    {
+        auto txn{env.start_write()};
+        Cursor cursor{txn, config};
+        Bytes key(8, '\0');
+        for (size_t i{0}; i < count; ++i) {
+            // Keys spread unevenly: the denser half at the bottom of the range
+            endian::store_big_u64(key.data(), i < count / 2 ? i : i * 1'000);
+            cursor.upsert(to_slice(key), to_slice(key));
+        }
+        (void)open_map(txn, {"Empty"});
+        txn.commit();
+    }
+
+    SECTION("Partition keys") {
+        auto txn{env.start_read()};
+        const auto keys{partition_keys(txn, config, 4)};
+        REQUIRE(keys.size() == 4);
+        CHECK(keys.front().empty());
+        CHECK(std::is_sorted(keys.begin(), keys.end()));
+
+        CHECK(partition_keys(txn, config, 1).size() == 1);
+        CHECK(partition_keys(txn, {"Empty"}, 4).size() == 1);
+    }
+
+    SECTION("All records are walked once") {
+        std::atomic_size_t walked{0};
+        std::atomic_uint64_t sum{0};
+        const WalkFunc walker{[&](::mdbx::cursor&, ::mdbx::cursor::move_result& data) {
+            ++walked;
+            sum += endian::load_big_u64(static_cast<const uint8_t*>(data.key.data()));
+            return true;
+        }};
+        CHECK(parallel_for_each(env, config, 4, walker) == count);
+        CHECK(walked == count);
+
+        uint64_t expected_sum{0};
+        for (size_t i{0}; i < count; ++i) {
+            expected_sum += i < count / 2 ? i : i * 1'000;
+        }
+        CHECK(sum == expected_sum);
+    }
+
+    SECTION("Walkers are built per partition") {
+        std::atomic_size_t walkers{0};
+        const size_t processed{parallel_for_each(env, config, 3, [&](::mdbx::txn& txn) -> WalkFunc {
+            CHECK(txn.is_readonly());
+            ++walkers;
+            return [](::mdbx::cursor&, ::mdbx::cursor::move_result&) { return true; };
+        })};
+        CHECK(processed == count);
+        CHECK(walkers == 3);
+    }
+
+    SECTION("Exceptions are rethrown") {
+        CHECK_THROWS_AS(parallel_for_each(env, config, 4,
+                                          [](::mdbx::cursor&, ::mdbx::cursor::move_result&) -> bool {
+                                              throw std::runtime_error("walker failure");
+                                          }),
+                        std::runtime_error);
+    }
+}
+
+TEST_CASE("Parallel block ranges") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+
+    SECTION("All blocks are walked once") {
+        const size_t num_threads{4};
+        std::vector<std::vector<std::pair<BlockNum, BlockNum>>> ranges(num_threads);
+        parallel_for_block_ranges(env, 10, 1'000, num_threads, /*ranges_per_thread=*/8,
+                                  [&](size_t worker, ::mdbx::txn& txn, BlockNum from, BlockNum to) {
+                                      CHECK(txn.is_readonly());
+                                      ranges[worker].emplace_back(from, to);
+                                  });
+
+        std::vector<std::pair<BlockNum, BlockNum>> all_ranges;
+        for (const auto& worker_ranges : ranges) {
+            all_ranges.insert(all_ranges.end(), worker_ranges.begin(), worker_ranges.end());
+        }
+        std::sort(all_ranges.begin(), all_ranges.end());
+        REQUIRE(!all_ranges.empty());
+        CHECK(all_ranges.front().first == 10);
+        CHECK(all_ranges.back().second == 1'000);
+        for (size_t i{1}; i < all_ranges.size(); ++i) {
+            CHECK(all_ranges[i].first == all_ranges[i - 1].second + 1);
+        }
+    }
+
+    SECTION("Empty span") {
+        std::atomic<size_t> count{0};
+        parallel_for_block_ranges(env, 10, 9, 4, 8, [&](size_t, ::mdbx::txn&, BlockNum, BlockNum) { ++count; });
+        CHECK(count == 0);
+    }
+
+    SECTION("Exceptions are rethrown") {
+        CHECK_THROWS_AS(parallel_for_block_ranges(env, 1, 100, 4, 8,
+                                                  [](size_t, ::mdbx::txn&, BlockNum, BlockNum) {
+                                                      throw std::runtime_error("range failure");
+                                                  }),
+                        std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::db
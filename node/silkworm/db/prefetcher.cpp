@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "prefetcher.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+KeyPrefetcher::KeyPrefetcher(::mdbx::env env, uint32_t queue_depth)
+    : txn_pool_{env, queue_depth}, pool_{queue_depth} {}
+
+KeyPrefetcher::~KeyPrefetcher() { (void)wait(); }
+
+void KeyPrefetcher::schedule(const MapConfig& map, std::vector<PrefetchKey> keys) {
+    if (keys.size() < kMinKeys) {
+        return;
+    }
+    auto shared_keys{std::make_shared<const std::vector<PrefetchKey>>(std::move(keys))};
+    for (size_t from{0}; from < shared_keys->size(); from += kBatchSize) {
+        const size_t to{std::min(from + kBatchSize, shared_keys->size())};
+        batches_.push_back(pool_.submit([this, map, shared_keys, from, to] {
+            return lookup(map, *shared_keys, from, to);
+        }));
+    }
+}
+
+size_t KeyPrefetcher::wait() {
+    size_t found{0};
+    for (auto& batch : batches_) {
+        try {
+            found += batch.get();
+        } catch (const std::exception&) {
+            // A failed prefetch (e.g. map not yet created) is not an error
+        }
+    }
+    batches_.clear();
+    return found;
+}
+
+size_t KeyPrefetcher::lookup(const MapConfig& map, const std::vector<PrefetchKey>& keys, size_t from, size_t to) {
+    auto txn{txn_pool_.acquire()};
+    auto& cursor{txn.cursor(map)};
+    size_t found{0};
+    for (size_t i{from}; i < to; ++i) {
+        const auto& [key, value_prefix]{keys[i]};
+        const auto data{value_prefix.empty() ? cursor.find(to_slice(key), /*throw_notfound=*/false)
+                                             : cursor.lower_bound_multivalue(to_slice(key), to_slice(value_prefix),
+                                                                             /*throw_notfound=*/false)};
+        if (data) {
+            ++found;
+        }
+    }
+    return found;
+}
+
+}  // namespace silkworm::db
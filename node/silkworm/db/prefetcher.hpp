@@ -0,0 +1,71 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <future>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief A key about to be looked up in a map
+struct PrefetchKey {
+    Bytes key;
+    Bytes value_prefix{};  // For multi-value maps: the prefix of the value looked up (see find_value_suffix)
+};
+
+//! \brief Faults in the pages of a batch of keys known ahead of time, so that the synchronous lookups following them
+//! find the B-tree already in page cache instead of waiting on storage one page at a time.
+//! \details Keys are looked up on background threads, each with a read-only transaction lent by a pool: every thread
+//! blocked on a page fault is a read in flight, hence the number of threads is the queue depth of the storage.
+//! Worth it on high-latency (e.g. network attached) block devices, where a single cursor walking cold pages leaves
+//! the device idle most of the time
+//! \remarks Lookups run on the last committed snapshot, whose untouched pages are the same the writing transaction
+//! reads. Failed lookups are not errors: the synchronous ones will read what they need on their own
+class KeyPrefetcher {
+  public:
+    static constexpr uint32_t kDefaultQueueDepth{32};  // Threads
+    static constexpr size_t kBatchSize{512};           // Keys looked up by a thread in a row
+    static constexpr size_t kMinKeys{1'024};           // Fewer keys are not worth waking up threads
+
+    explicit KeyPrefetcher(::mdbx::env env, uint32_t queue_depth = kDefaultQueueDepth);
+    ~KeyPrefetcher();
+
+    // Not copyable nor movable
+    KeyPrefetcher(const KeyPrefetcher&) = delete;
+    KeyPrefetcher& operator=(const KeyPrefetcher&) = delete;
+
+    //! \brief Schedules the lookup of keys in map, in batches taken in order by the first idle threads
+    //! \remarks Keys should be sorted, as the synchronous lookups following are: those then trail the prefetch
+    void schedule(const MapConfig& map, std::vector<PrefetchKey> keys);
+
+    //! \brief Waits for all scheduled lookups
+    //! \return The number of keys found
+    size_t wait();
+
+  private:
+    size_t lookup(const MapConfig& map, const std::vector<PrefetchKey>& keys, size_t from, size_t to);
+
+    ROTxnPool txn_pool_;
+    std::vector<std::future<size_t>> batches_;
+    thread_pool pool_;  // Declared last: destroyed (joined) first
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,76 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "prefetcher.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("Key prefetcher") {
+    const TemporaryDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    const MapConfig single{"Single"};
+    const MapConfig multi{"Multi", ::mdbx::key_mode::usual, ::mdbx::value_mode::multi};
+    const size_t count{10'000};
+
+    {
+        auto txn{env.start_write()};
+        Cursor single_cursor{txn, single};
+        Cursor multi_cursor{txn, multi};
+        Bytes key(8, '\0');
+        for (size_t i{0}; i < count; ++i) {
+            endian::store_big_u64(key.data(), i * 2);  // Odd keys are missing
+            single_cursor.upsert(to_slice(key), to_slice(key));
+            multi_cursor.upsert(to_slice(key.substr(0, 6)), to_slice(key));
+        }
+        txn.commit();
+    }
+
+    std::vector<PrefetchKey> single_keys;
+    std::vector<PrefetchKey> multi_keys;
+    Bytes key(8, '\0');
+    for (size_t i{0}; i < count; ++i) {
+        endian::store_big_u64(key.data(), i);
+        single_keys.push_back({key});
+        multi_keys.push_back({key.substr(0, 6), key});
+    }
+
+    KeyPrefetcher prefetcher{env, /*queue_depth=*/4};
+    prefetcher.schedule(single, single_keys);
+    CHECK(prefetcher.wait() == count / 2);
+    prefetcher.schedule(multi, multi_keys);
+    CHECK(prefetcher.wait() == count);  // Lower bound lands on next value of the same key
+
+    SECTION("Too few keys") {
+        single_keys.resize(KeyPrefetcher::kMinKeys - 1);
+        prefetcher.schedule(single, single_keys);
+        CHECK(prefetcher.wait() == 0);
+    }
+
+    SECTION("Missing map") {
+        prefetcher.schedule({"Missing"}, single_keys);
+        CHECK(prefetcher.wait() == 0);
+    }
+}
+
+}  // namespace silkworm::db
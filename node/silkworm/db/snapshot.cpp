@@ -0,0 +1,294 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::db {
+
+namespace {
+
+    constexpr std::array<uint8_t, 8> kSegmentMagic{'S', 'W', 'B', 'L', 'O', 'C', 'K', 'S'};
+
+    std::atomic<const SnapshotRepository*> installed_repository{nullptr};
+
+    std::string padded_block_number(BlockNum block_number) {
+        std::string res{std::to_string(block_number)};
+        if (res.length() < 9) {
+            res.insert(0, 9 - res.length(), '0');
+        }
+        return res;
+    }
+
+}  // namespace
+
+BlockSegment::BlockSegment(std::filesystem::path path) : path_{std::move(path)} {
+    const auto file_size{std::filesystem::file_size(path_)};
+    if (file_size < kHeaderSize) {
+        throw std::runtime_error("Segment " + path_.string() + " is too short");
+    }
+
+    try {
+        file_ = boost::interprocess::file_mapping{path_.string().c_str(), boost::interprocess::read_only};
+        region_ = boost::interprocess::mapped_region{file_, boost::interprocess::read_only};
+    } catch (const boost::interprocess::interprocess_exception& ex) {
+        throw std::runtime_error("Unable to map segment " + path_.string() + " : " + ex.what());
+    }
+    // Blocks are read by number, hence there's no point in reading ahead
+    (void)region_.advise(boost::interprocess::mapped_region::advice_random);
+    data_ = ByteView{static_cast<const uint8_t*>(region_.get_address()), region_.get_size()};
+
+    if (std::memcmp(data_.data(), kSegmentMagic.data(), kSegmentMagic.size()) != 0) {
+        throw std::runtime_error("Segment " + path_.string() + " has invalid magic");
+    }
+    first_block_ = endian::load_big_u64(&data_[8]);
+    block_count_ = endian::load_big_u64(&data_[16]);
+    index_offset_ = endian::load_big_u64(&data_[24]);
+    if (block_count_ == 0 || index_offset_ < kHeaderSize || index_offset_ > data_.length() ||
+        (data_.length() - index_offset_) / kIndexEntrySize != block_count_ ||
+        (data_.length() - index_offset_) % kIndexEntrySize != 0) {
+        throw std::runtime_error("Segment " + path_.string() + " has invalid index");
+    }
+
+    // Records must be contiguous and lie in between header and index
+    uint64_t expected_offset{kHeaderSize};
+    for (size_t i{0}; i < block_count_; ++i) {
+        const uint8_t* entry{&data_[index_offset_ + i * kIndexEntrySize]};
+        const uint64_t header_offset{endian::load_big_u64(entry + kHashLength)};
+        const uint64_t body_offset{endian::load_big_u64(entry + kHashLength + sizeof(uint64_t))};
+        if (header_offset != expected_offset || body_offset < header_offset || body_offset > index_offset_) {
+            throw std::runtime_error("Segment " + path_.string() + " has invalid record offsets for block " +
+                                     std::to_string(first_block_ + i));
+        }
+        expected_offset = i + 1 < block_count_ ? endian::load_big_u64(entry + kIndexEntrySize + kHashLength)
+                                               : index_offset_;
+        if (expected_offset < body_offset) {
+            throw std::runtime_error("Segment " + path_.string() + " has invalid record offsets for block " +
+                                     std::to_string(first_block_ + i));
+        }
+    }
+}
+
+std::string BlockSegment::file_name(BlockNum from, BlockNum to) {
+    return "blocks-" + padded_block_number(from) + "-" + padded_block_number(to) + kExtension;
+}
+
+std::optional<evmc::bytes32> BlockSegment::block_hash(BlockNum block_number) const {
+    if (!contains(block_number)) {
+        return std::nullopt;
+    }
+    return to_bytes32(data_.substr(index_offset_ + (block_number - first_block_) * kIndexEntrySize, kHashLength));
+}
+
+ByteView BlockSegment::header_rlp(BlockNum block_number, ByteView hash) const {
+    const uint8_t* entry{find_entry(block_number, hash)};
+    return entry ? record(entry, /*body=*/false) : ByteView{};
+}
+
+ByteView BlockSegment::body_rlp(BlockNum block_number, ByteView hash) const {
+    const uint8_t* entry{find_entry(block_number, hash)};
+    return entry ? record(entry, /*body=*/true) : ByteView{};
+}
+
+const uint8_t* BlockSegment::find_entry(BlockNum block_number, ByteView hash) const {
+    if (!contains(block_number) || hash.length() != kHashLength) {
+        return nullptr;
+    }
+    const uint8_t* entry{&data_[index_offset_ + (block_number - first_block_) * kIndexEntrySize]};
+    return std::memcmp(entry, hash.data(), kHashLength) == 0 ? entry : nullptr;
+}
+
+ByteView BlockSegment::record(const uint8_t* entry, bool body) const {
+    const uint64_t header_offset{endian::load_big_u64(entry + kHashLength)};
+    const uint64_t body_offset{endian::load_big_u64(entry + kHashLength + sizeof(uint64_t))};
+    if (!body) {
+        return data_.substr(header_offset, body_offset - header_offset);
+    }
+    const bool is_last{entry + kIndexEntrySize == data_.data() + data_.length()};
+    const uint64_t end_offset{is_last ? index_offset_ : endian::load_big_u64(entry + kIndexEntrySize + kHashLength)};
+    return data_.substr(body_offset, end_offset - body_offset);
+}
+
+BlockSegmentWriter::BlockSegmentWriter(std::filesystem::path path, BlockNum first_block)
+    : path_{std::move(path)}, temp_path_{path_.string() + ".tmp"}, first_block_{first_block} {
+    if (std::filesystem::exists(path_)) {
+        throw std::runtime_error("Segment " + path_.string() + " already exists");
+    }
+    file_.open(temp_path_, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("Unable to create " + temp_path_.string());
+    }
+    write(Bytes(BlockSegment::kHeaderSize, '\0'));  // Filled by finish()
+}
+
+BlockSegmentWriter::~BlockSegmentWriter() {
+    if (file_.is_open()) {
+        file_.close();
+        std::error_code ec;
+        std::filesystem::remove(temp_path_, ec);
+    }
+}
+
+void BlockSegmentWriter::append(const evmc::bytes32& hash, ByteView header_rlp, ByteView body_rlp) {
+    uint8_t entry[BlockSegment::kIndexEntrySize];
+    std::memcpy(entry, hash.bytes, kHashLength);
+    endian::store_big_u64(&entry[kHashLength], offset_);
+    endian::store_big_u64(&entry[kHashLength + sizeof(uint64_t)], offset_ + header_rlp.length());
+    index_.append(entry, sizeof(entry));
+
+    write(header_rlp);
+    write(body_rlp);
+    offset_ += header_rlp.length() + body_rlp.length();
+    ++block_count_;
+}
+
+void BlockSegmentWriter::finish() {
+    if (!block_count_) {
+        throw std::runtime_error("Segment " + path_.string() + " has no blocks");
+    }
+    write(index_);
+
+    uint8_t header[BlockSegment::kHeaderSize];
+    std::memcpy(header, kSegmentMagic.data(), kSegmentMagic.size());
+    endian::store_big_u64(&header[8], first_block_);
+    endian::store_big_u64(&header[16], block_count_);
+    endian::store_big_u64(&header[24], offset_);
+    file_.seekp(0);
+    write(ByteView{header});
+    file_.close();
+    if (!file_) {
+        throw std::runtime_error("Unable to write " + temp_path_.string());
+    }
+    std::filesystem::rename(temp_path_, path_);
+}
+
+void BlockSegmentWriter::write(ByteView bytes) {
+    file_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.length()));
+    if (!file_) {
+        throw std::runtime_error("Unable to write " + temp_path_.string());
+    }
+}
+
+SnapshotRepository::SnapshotRepository(std::filesystem::path dir) : dir_{std::move(dir)} {}
+
+void SnapshotRepository::reopen() {
+    std::vector<std::unique_ptr<BlockSegment>> segments;
+    if (std::filesystem::exists(dir_)) {
+        for (const auto& entry : std::filesystem::directory_iterator{dir_}) {
+            if (entry.is_regular_file() && entry.path().extension() == BlockSegment::kExtension) {
+                segments.push_back(std::make_unique<BlockSegment>(entry.path()));
+            }
+        }
+    }
+    std::sort(segments.begin(), segments.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs->first_block() < rhs->first_block(); });
+    for (size_t i{1}; i < segments.size(); ++i) {
+        if (segments[i]->first_block() <= segments[i - 1]->last_block()) {
+            throw std::runtime_error("Segments " + segments[i - 1]->path().string() + " and " +
+                                     segments[i]->path().string() + " overlap");
+        }
+    }
+    segments_ = std::move(segments);
+}
+
+std::optional<BlockNum> SnapshotRepository::max_block_number() const {
+    if (segments_.empty()) {
+        return std::nullopt;
+    }
+    return segments_.back()->last_block();
+}
+
+const BlockSegment* SnapshotRepository::find_segment(BlockNum block_number) const {
+    auto it{std::upper_bound(segments_.begin(), segments_.end(), block_number,
+                             [](BlockNum number, const auto& segment) { return number < segment->first_block(); })};
+    if (it == segments_.begin()) {
+        return nullptr;
+    }
+    --it;
+    return (*it)->contains(block_number) ? it->get() : nullptr;
+}
+
+void set_snapshot_repository(const SnapshotRepository* repository) noexcept { installed_repository = repository; }
+
+const SnapshotRepository* snapshot_repository() noexcept { return installed_repository; }
+
+std::filesystem::path write_block_segment(mdbx::txn& txn, const std::filesystem::path& dir, BlockNum from,
+                                          BlockNum to) {
+    if (from > to) {
+        throw std::runtime_error("Invalid block range [" + std::to_string(from) + ", " + std::to_string(to) + "]");
+    }
+    const std::filesystem::path path{dir / BlockSegment::file_name(from, to)};
+    BlockSegmentWriter writer{path, from};
+
+    BlockBody body;
+    Bytes body_rlp;
+    for (BlockNum block_number{from}; block_number <= to; ++block_number) {
+        const auto hash{read_canonical_header_hash(txn, block_number)};
+        if (!hash) {
+            throw std::runtime_error("Missing canonical hash of block " + std::to_string(block_number));
+        }
+        const Bytes key{block_key(block_number, hash->bytes)};
+        const Bytes header_rlp{read_header_raw(txn, key)};
+        if (header_rlp.empty() || !read_body(txn, key, /*read_senders=*/false, body)) {
+            throw std::runtime_error("Missing block " + std::to_string(block_number));
+        }
+        body_rlp.clear();
+        rlp::encode(body_rlp, body);
+        writer.append(*hash, header_rlp, body_rlp);
+    }
+
+    writer.finish();
+    return path;
+}
+
+size_t erase_frozen_blocks(mdbx::txn& txn, const BlockSegment& segment) {
+    Cursor headers(txn, table::kHeaders);
+    Cursor bodies(txn, table::kBlockBodies);
+    Cursor transactions(txn, table::kBlockTransactions);
+
+    size_t erased{0};
+    for (BlockNum block_number{segment.first_block()}; block_number <= segment.last_block(); ++block_number) {
+        const Bytes key{block_key(block_number, segment.block_hash(block_number)->bytes)};
+        if (headers.find(to_slice(key), /*throw_notfound=*/false)) {
+            headers.erase();
+        }
+        const auto data{bodies.find(to_slice(key), /*throw_notfound=*/false)};
+        if (!data) {
+            continue;
+        }
+        ByteView data_view{from_slice(data.value)};
+        const auto stored_body{detail::decode_stored_block_body(data_view)};
+        const Bytes first_txn_key{block_key(stored_body.base_txn_id)};
+        if (stored_body.txn_count && transactions.find(to_slice(first_txn_key), /*throw_notfound=*/false)) {
+            (void)cursor_erase(transactions, first_txn_key, stored_body.txn_count);
+        }
+        bodies.erase();
+        ++erased;
+    }
+    return erased;
+}
+
+}  // namespace silkworm::db
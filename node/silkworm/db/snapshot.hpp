@@ -0,0 +1,176 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+/*
+Frozen blocks: headers and bodies of canonical blocks deep enough to never be unwound can be moved out of db into
+append-only segment files, each holding a contiguous range of blocks. A segment is laid out as
+
+    header  : magic (8 bytes) + first_block_u64 (BE) + block_count_u64 (BE) + index_offset_u64 (BE)
+    records : for each block, header RLP immediately followed by body RLP (network format)
+    index   : for each block, hash (32 bytes) + header_offset_u64 (BE) + body_offset_u64 (BE)
+
+and is memory-mapped once opened, so that reads are plain views on the mapped file.
+*/
+namespace silkworm::db {
+
+//! \brief Blocks this far below the head of Execution are considered immutable (same as Erigon)
+inline constexpr BlockNum kFullImmutabilityThreshold{90'000};
+
+//! \brief Read-only view on a memory-mapped segment file of frozen blocks
+class BlockSegment {
+  public:
+    static constexpr const char* kExtension{".seg"};
+    static constexpr size_t kHeaderSize{32};
+    static constexpr size_t kIndexEntrySize{kHashLength + 2 * sizeof(uint64_t)};
+
+    //! \brief Maps the segment file at path
+    //! \remarks Throws std::runtime_error if file is not a well-formed segment
+    explicit BlockSegment(std::filesystem::path path);
+
+    // Not copyable nor movable
+    BlockSegment(const BlockSegment&) = delete;
+    BlockSegment& operator=(const BlockSegment&) = delete;
+
+    //! \brief Returns the canonical file name of a segment holding blocks in range [from, to]
+    static std::string file_name(BlockNum from, BlockNum to);
+
+    [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+    [[nodiscard]] BlockNum first_block() const { return first_block_; }
+    [[nodiscard]] BlockNum last_block() const { return first_block_ + block_count_ - 1; }
+    [[nodiscard]] size_t block_count() const { return block_count_; }
+    [[nodiscard]] bool contains(BlockNum block_number) const {
+        return block_number >= first_block_ && block_number - first_block_ < block_count_;
+    }
+
+    //! \brief Returns the hash of given block, if held in segment
+    [[nodiscard]] std::optional<evmc::bytes32> block_hash(BlockNum block_number) const;
+
+    //! \brief Returns a view on the RLP header of given block, empty if not held in segment or hash does not match
+    [[nodiscard]] ByteView header_rlp(BlockNum block_number, ByteView hash) const;
+
+    //! \brief Returns a view on the RLP body of given block, empty if not held in segment or hash does not match
+    [[nodiscard]] ByteView body_rlp(BlockNum block_number, ByteView hash) const;
+
+  private:
+    //! \brief Returns pointer to index entry of given block, nullptr if not held in segment or hash does not match
+    [[nodiscard]] const uint8_t* find_entry(BlockNum block_number, ByteView hash) const;
+    [[nodiscard]] ByteView record(const uint8_t* entry, bool body) const;
+
+    std::filesystem::path path_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    ByteView data_;
+    BlockNum first_block_{0};
+    size_t block_count_{0};
+    size_t index_offset_{0};
+};
+
+//! \brief Builds a new segment file by appending blocks in ascending order
+//! \remarks Data is written to a temporary file renamed to its final path by finish(), hence an unfinished segment
+//! is never visible to SnapshotRepository
+class BlockSegmentWriter {
+  public:
+    //! \brief Starts a segment whose first block is first_block
+    //! \remarks Throws std::runtime_error if path already exists
+    BlockSegmentWriter(std::filesystem::path path, BlockNum first_block);
+    ~BlockSegmentWriter();
+
+    // Not copyable nor movable
+    BlockSegmentWriter(const BlockSegmentWriter&) = delete;
+    BlockSegmentWriter& operator=(const BlockSegmentWriter&) = delete;
+
+    //! \brief Appends next block in sequence
+    void append(const evmc::bytes32& hash, ByteView header_rlp, ByteView body_rlp);
+
+    //! \brief Writes index, closes file and moves it to its final path
+    //! \remarks Throws std::runtime_error if no block has been appended
+    void finish();
+
+  private:
+    void write(ByteView bytes);
+
+    std::filesystem::path path_;
+    std::filesystem::path temp_path_;
+    std::ofstream file_;
+    BlockNum first_block_;
+    uint64_t offset_{BlockSegment::kHeaderSize};
+    Bytes index_;
+    size_t block_count_{0};
+};
+
+//! \brief The set of segments found in a directory, with non overlapping block ranges
+class SnapshotRepository {
+  public:
+    explicit SnapshotRepository(std::filesystem::path dir);
+
+    // Not copyable nor movable
+    SnapshotRepository(const SnapshotRepository&) = delete;
+    SnapshotRepository& operator=(const SnapshotRepository&) = delete;
+
+    //! \brief (Re)opens all segment files in directory
+    //! \remarks Throws std::runtime_error on malformed or overlapping segments. Not thread safe
+    void reopen();
+
+    [[nodiscard]] const std::filesystem::path& path() const { return dir_; }
+    [[nodiscard]] size_t segments_count() const { return segments_.size(); }
+
+    //! \brief Returns the highest block held in segments, if any
+    [[nodiscard]] std::optional<BlockNum> max_block_number() const;
+
+    //! \brief Returns the segment holding given block, nullptr if none
+    [[nodiscard]] const BlockSegment* find_segment(BlockNum block_number) const;
+
+  private:
+    std::filesystem::path dir_;
+    std::vector<std::unique_ptr<BlockSegment>> segments_;  // Sorted by block range
+};
+
+//! \brief Sets the repository access_layer block readers (headers and bodies) look into before db, nullptr for none
+//! \remarks The repository must outlive its use and must not be reopened while readers are running
+void set_snapshot_repository(const SnapshotRepository* repository) noexcept;
+
+//! \brief Returns the repository set by set_snapshot_repository, if any
+[[nodiscard]] const SnapshotRepository* snapshot_repository() noexcept;
+
+//! \brief Writes headers and bodies of canonical blocks in range [from, to] into a new segment file in dir
+//! \return The path of the new segment
+//! \remarks Throws std::runtime_error if any block in range is missing
+std::filesystem::path write_block_segment(mdbx::txn& txn, const std::filesystem::path& dir, BlockNum from,
+                                          BlockNum to);
+
+//! \brief Erases from db headers, bodies and transactions of the blocks held in segment
+//! \return The number of erased blocks
+//! \remarks Senders, canonical hashes and total difficulties are kept in db
+size_t erase_frozen_blocks(mdbx::txn& txn, const BlockSegment& segment);
+
+}  // namespace silkworm::db
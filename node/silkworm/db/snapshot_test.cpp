@@ -0,0 +1,168 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "snapshot.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/access_layer.hpp>
+
+namespace silkworm::db {
+
+static void write_segment(const std::filesystem::path& dir, BlockNum from, BlockNum to) {
+    BlockSegmentWriter writer{dir / BlockSegment::file_name(from, to), from};
+    for (BlockNum block_number{from}; block_number <= to; ++block_number) {
+        evmc::bytes32 hash{};
+        hash.bytes[0] = static_cast<uint8_t>(block_number);
+        const Bytes header_rlp(3, static_cast<uint8_t>(block_number));
+        const Bytes body_rlp(static_cast<size_t>(block_number % 3), static_cast<uint8_t>(block_number + 1));
+        writer.append(hash, header_rlp, body_rlp);
+    }
+    writer.finish();
+}
+
+TEST_CASE("BlockSegment") {
+    TemporaryDirectory tmp_dir;
+    const auto path{tmp_dir.path() / BlockSegment::file_name(10, 12)};
+
+    SECTION("Read back") {
+        write_segment(tmp_dir.path(), 10, 12);
+        const BlockSegment segment{path};
+        CHECK(segment.first_block() == 10);
+        CHECK(segment.last_block() == 12);
+        CHECK(segment.block_count() == 3);
+        CHECK_FALSE(segment.contains(9));
+        CHECK_FALSE(segment.contains(13));
+
+        for (BlockNum block_number{10}; block_number <= 12; ++block_number) {
+            const auto hash{segment.block_hash(block_number)};
+            REQUIRE(hash);
+            CHECK(hash->bytes[0] == block_number);
+            CHECK(segment.header_rlp(block_number, *hash) == Bytes(3, static_cast<uint8_t>(block_number)));
+            CHECK(segment.body_rlp(block_number, *hash) ==
+                  Bytes(static_cast<size_t>(block_number % 3), static_cast<uint8_t>(block_number + 1)));
+        }
+
+        const auto hash{*segment.block_hash(11)};
+        CHECK(segment.header_rlp(12, hash).empty());
+        CHECK(segment.header_rlp(13, hash).empty());
+        CHECK_FALSE(segment.block_hash(13));
+    }
+
+    SECTION("Unfinished segment is discarded") {
+        {
+            BlockSegmentWriter writer{path, 10};
+            CHECK_THROWS_AS(writer.finish(), std::runtime_error);
+        }
+        CHECK(std::filesystem::is_empty(tmp_dir.path()));
+    }
+
+    SECTION("Existing segment is not overwritten") {
+        write_segment(tmp_dir.path(), 10, 12);
+        CHECK_THROWS_AS(BlockSegmentWriter(path, 10), std::runtime_error);
+    }
+
+    SECTION("Malformed segment") {
+        {
+            std::ofstream file{path, std::ios::binary};
+            file << "Not a segment at all, not even close";
+        }
+        CHECK_THROWS_AS(BlockSegment{path}, std::runtime_error);
+    }
+}
+
+TEST_CASE("SnapshotRepository") {
+    TemporaryDirectory tmp_dir;
+    SnapshotRepository repository{tmp_dir.path()};
+    repository.reopen();
+    CHECK(repository.segments_count() == 0);
+    CHECK_FALSE(repository.max_block_number());
+    CHECK(repository.find_segment(0) == nullptr);
+
+    write_segment(tmp_dir.path(), 5, 6);
+    write_segment(tmp_dir.path(), 0, 1);
+    repository.reopen();
+    CHECK(repository.segments_count() == 2);
+    CHECK(repository.max_block_number() == 6);
+    REQUIRE(repository.find_segment(0));
+    CHECK(repository.find_segment(1)->first_block() == 0);
+    CHECK(repository.find_segment(2) == nullptr);
+    CHECK(repository.find_segment(4) == nullptr);
+    REQUIRE(repository.find_segment(6));
+    CHECK(repository.find_segment(6)->first_block() == 5);
+    CHECK(repository.find_segment(7) == nullptr);
+
+    write_segment(tmp_dir.path(), 6, 7);
+    CHECK_THROWS_AS(repository.reopen(), std::runtime_error);
+}
+
+TEST_CASE("Frozen blocks") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    std::vector<Block> blocks(3);
+    for (size_t i{0}; i < blocks.size(); ++i) {
+        auto& block{blocks[i]};
+        block.header.number = i;
+        block.header.gas_limit = 30'000'000;
+        if (i) {
+            block.header.parent_hash = blocks[i - 1].header.hash();
+        }
+        block.transactions.resize(i);
+        for (auto& transaction : block.transactions) {
+            transaction.nonce = i;
+            transaction.gas_limit = 21'000;
+            transaction.to = 0xe5ef458d37212a06e3f59d40c454e76150ae7c32_address;
+            transaction.value = kEther;
+            CHECK(transaction.set_v(27));
+            transaction.r = 1;
+            transaction.s = 1;
+        }
+        const auto hash{block.header.hash()};
+        write_header(txn, block.header);
+        write_body(txn, block, hash.bytes, block.header.number);
+        write_canonical_header_hash(txn, hash.bytes, block.header.number);
+    }
+
+    const auto path{write_block_segment(txn, context.dir().snapshots().path(), 0, 2)};
+    SnapshotRepository repository{context.dir().snapshots().path()};
+    repository.reopen();
+    REQUIRE(repository.max_block_number() == 2);
+    CHECK(erase_frozen_blocks(txn, *repository.find_segment(0)) == 3);
+    CHECK(txn.get_map_stat(open_map(txn, table::kBlockTransactions)).ms_entries == 0);
+
+    Block block;
+    CHECK_FALSE(read_block_by_number(txn, 2, /*read_senders=*/false, block));
+
+    set_snapshot_repository(&repository);
+    for (const auto& expected : blocks) {
+        const auto hash{expected.header.hash()};
+        REQUIRE(read_block_by_number(txn, expected.header.number, /*read_senders=*/false, block));
+        CHECK(block.header == expected.header);
+        CHECK(block.transactions == expected.transactions);
+        CHECK(has_body(txn, expected.header.number, hash.bytes));
+        CHECK(read_header(txn, expected.header.number, hash.bytes) == expected.header);
+    }
+    // Non canonical blocks are still looked up in db
+    evmc::bytes32 other_hash{};
+    CHECK_FALSE(read_header(txn, 1, other_hash.bytes));
+    CHECK_FALSE(has_body(txn, 1, other_hash.bytes));
+    set_snapshot_repository(nullptr);
+}
+
+}  // namespace silkworm::db
@@ -92,6 +92,65 @@ void write_stage_unwind(mdbx::txn& txn, const char* stage_name, BlockNum block_n
     set_stage_data(txn, stage_name, block_num, silkworm::db::table::kSyncStageUnwind);
 }
 
+static constexpr const char* kCheckpointPrefix{"checkpoint_"};
+
+std::optional<StageCheckpoint> read_stage_checkpoint(mdbx::txn& txn, const char* stage_name) {
+    if (!is_known_stage(stage_name)) {
+        throw std::invalid_argument("Unknown stage name " + std::string(stage_name));
+    }
+
+    try {
+        db::Cursor src(txn, table::kSyncStageProgress);
+        const std::string item_key{std::string(kCheckpointPrefix) + stage_name};
+        auto data{src.find(mdbx::slice(item_key.c_str()), /*throw_notfound*/ false)};
+        if (!data) {
+            return std::nullopt;
+        } else if (data.value.size() < sizeof(uint64_t)) {
+            throw std::length_error("Expected at least 8 bytes of data got " + std::to_string(data.value.size()));
+        }
+        const ByteView value{db::from_slice(data.value)};
+        return StageCheckpoint{endian::load_big_u64(value.data()), Bytes{value.substr(sizeof(uint64_t))}};
+    } catch (const mdbx::exception& ex) {
+        std::string what("Error in " + std::string(__FUNCTION__) + " " + std::string(ex.what()));
+        throw std::runtime_error(what);
+    }
+}
+
+void write_stage_checkpoint(mdbx::txn& txn, const char* stage_name, const StageCheckpoint& checkpoint) {
+    if (!is_known_stage(stage_name)) {
+        throw std::invalid_argument("Unknown stage name");
+    }
+
+    try {
+        const std::string item_key{std::string(kCheckpointPrefix) + stage_name};
+        Bytes value(sizeof(uint64_t), 0);
+        endian::store_big_u64(value.data(), checkpoint.target);
+        value.append(checkpoint.key);
+        db::Cursor target(txn, table::kSyncStageProgress);
+        target.upsert(mdbx::slice(item_key.c_str()), db::to_slice(value));
+    } catch (const mdbx::exception& ex) {
+        std::string what("Error in " + std::string(__FUNCTION__) + " " + std::string(ex.what()));
+        throw std::runtime_error(what);
+    }
+}
+
+void clear_stage_checkpoint(mdbx::txn& txn, const char* stage_name) {
+    if (!is_known_stage(stage_name)) {
+        throw std::invalid_argument("Unknown stage name");
+    }
+
+    try {
+        const std::string item_key{std::string(kCheckpointPrefix) + stage_name};
+        db::Cursor target(txn, table::kSyncStageProgress);
+        if (target.find(mdbx::slice(item_key.c_str()), /*throw_notfound*/ false)) {
+            target.erase();
+        }
+    } catch (const mdbx::exception& ex) {
+        std::string what("Error in " + std::string(__FUNCTION__) + " " + std::string(ex.what()));
+        throw std::runtime_error(what);
+    }
+}
+
 bool is_known_stage(const char* name) {
     if (strlen(name)) {
         for (auto stage : kAllStages) {
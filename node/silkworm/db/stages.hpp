@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <silkworm/db/tables.hpp>
 
 /*
@@ -135,6 +137,30 @@ BlockNum read_stage_unwind(mdbx::txn& txn, const char* stage_name);
 //! defaults to 0 which means to clear any previously recorded invalidation point.
 void write_stage_unwind(mdbx::txn& txn, const char* stage_name, BlockNum block_num = 0);
 
+//! \brief A point within a forward run of a stage which has been committed: on restart the stage may resume from it
+//! instead of starting over
+struct StageCheckpoint {
+    BlockNum target{0};  // The height the interrupted run was heading to
+    Bytes key;           // The last key the run has completely loaded (empty if none yet)
+};
+
+//! \brief Reads from db the checkpoint (if any) of the provided stage name
+//! \param [in] txn : a reference to a ro/rw db transaction
+//! \param [in] stage_name : the name of the requested stage (must be known see kAllStages[])
+std::optional<StageCheckpoint> read_stage_checkpoint(mdbx::txn& txn, const char* stage_name);
+
+//! \brief Writes into db the checkpoint for the provided stage name
+//! \param [in] txn : a reference to a rw db transaction
+//! \param [in] stage_name : the name of the involved stage (must be known see kAllStages[])
+//! \param [in] checkpoint : the checkpoint the stage must record
+//! \remarks A checkpoint is only meaningful once committed along with the data it accounts for
+void write_stage_checkpoint(mdbx::txn& txn, const char* stage_name, const StageCheckpoint& checkpoint);
+
+//! \brief Removes from db the checkpoint (if any) of the provided stage name
+//! \param [in] txn : a reference to a rw db transaction
+//! \param [in] stage_name : the name of the involved stage (must be known see kAllStages[])
+void clear_stage_checkpoint(mdbx::txn& txn, const char* stage_name);
+
 //! \brief Whether the provided stage name is known to Silkworm
 //! \param [in] stage_name : The name of the stage to check for
 //! \return Whether it exists in kAllStages[]
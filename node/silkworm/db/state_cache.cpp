@@ -0,0 +1,102 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_cache.hpp"
+
+#include <cstring>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+
+namespace silkworm::db {
+
+static std::string storage_cache_key(const evmc::address& address, uint64_t incarnation,
+                                     const evmc::bytes32& location) {
+    std::string key(kAddressLength + sizeof(uint64_t) + kHashLength, '\0');
+    auto* data{byte_ptr_cast(key.data())};
+    std::memcpy(data, address.bytes, kAddressLength);
+    endian::store_big_u64(data + kAddressLength, incarnation);
+    std::memcpy(data + kAddressLength + sizeof(uint64_t), location.bytes, kHashLength);
+    return key;
+}
+
+StateCache::StateCache(size_t max_entries, size_t max_code_bytes)
+    : accounts_{max_entries}, storage_{max_entries}, max_code_bytes_{max_code_bytes} {}
+
+const std::optional<Account>* StateCache::get_account(const evmc::address& address) {
+    const std::optional<Account>* account{accounts_.get(address)};
+    if (account) {
+        ++hits_;
+    } else {
+        ++misses_;
+    }
+    return account;
+}
+
+void StateCache::put_account(const evmc::address& address, const std::optional<Account>& account) {
+    accounts_.put(address, account);
+}
+
+const evmc::bytes32* StateCache::get_storage(const evmc::address& address, uint64_t incarnation,
+                                             const evmc::bytes32& location) {
+    const evmc::bytes32* value{storage_.get(storage_cache_key(address, incarnation, location))};
+    if (value) {
+        ++hits_;
+    } else {
+        ++misses_;
+    }
+    return value;
+}
+
+void StateCache::put_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                             const evmc::bytes32& value) {
+    storage_.put(storage_cache_key(address, incarnation, location), value);
+}
+
+std::optional<ByteView> StateCache::get_code(const evmc::bytes32& code_hash) {
+    if (const auto it{code_.find(code_hash)}; it != code_.end()) {
+        ++hits_;
+        return it->second;
+    }
+    ++misses_;
+    return std::nullopt;
+}
+
+ByteView StateCache::put_code(const evmc::bytes32& code_hash, ByteView code) {
+    const auto [it, inserted]{code_.try_emplace(code_hash, code)};
+    if (inserted) {
+        code_bytes_ += code.length();
+    }
+    return it->second;
+}
+
+void StateCache::trim() noexcept {
+    if (code_bytes_ > max_code_bytes_) {
+        code_.clear();
+        code_bytes_ = 0;
+    }
+}
+
+void StateCache::clear() noexcept {
+    accounts_.clear();
+    storage_.clear();
+    code_.clear();
+    code_bytes_ = 0;
+    hits_ = 0;
+    misses_ = 0;
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,82 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/hash_maps.hpp>
+#include <silkworm/common/lru_cache.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm::db {
+
+//! \brief Clean cache of current accounts, storage and code, meant to outlive a single Buffer so that the state
+//! hot contracts keep touching stays in memory from one batch to the next (see Buffer::use_state_cache)
+//! \details Both present and absent accounts and storage are cached. Buffers fill it with what they read from db and
+//! update it with what they write to db: it's kept coherent with PlainState as long as nothing else changes it.
+//! Otherwise, e.g. after an unwind or an aborted transaction, the cache must be cleared.
+//! \remarks Code views returned by get_code stay valid until the next trim() or clear(). Not thread safe
+class StateCache {
+  public:
+    static constexpr size_t kDefaultMaxCodeBytes{64_Mebi};
+
+    //! \param [in] max_entries : max number of accounts, and max number of storage slots kept
+    //! \param [in] max_code_bytes : size of code past which trim() drops all code
+    explicit StateCache(size_t max_entries, size_t max_code_bytes = kDefaultMaxCodeBytes);
+
+    // not copyable
+    StateCache(const StateCache&) = delete;
+    StateCache& operator=(const StateCache&) = delete;
+
+    //! \brief Returns nullptr if the account is not known, otherwise the account (std::nullopt meaning no account)
+    const std::optional<Account>* get_account(const evmc::address& address);
+    void put_account(const evmc::address& address, const std::optional<Account>& account);
+
+    //! \brief Returns nullptr if the storage location is not known, otherwise its value
+    const evmc::bytes32* get_storage(const evmc::address& address, uint64_t incarnation,
+                                     const evmc::bytes32& location);
+    void put_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                     const evmc::bytes32& value);
+
+    //! \brief Returns std::nullopt if the code is not known
+    std::optional<ByteView> get_code(const evmc::bytes32& code_hash);
+
+    //! \brief Stores a copy of code (if not known yet) and returns a view of it
+    ByteView put_code(const evmc::bytes32& code_hash, ByteView code);
+
+    //! \brief Drops all code if over budget
+    //! \remarks Invalidates code views, hence to be called in between blocks only
+    void trim() noexcept;
+
+    void clear() noexcept;
+
+    [[nodiscard]] size_t hits() const noexcept { return hits_; }
+    [[nodiscard]] size_t misses() const noexcept { return misses_; }
+
+  private:
+    lru_cache<evmc::address, std::optional<Account>> accounts_;
+    lru_cache<std::string, evmc::bytes32> storage_;
+    NodeHashMap<evmc::bytes32, Bytes> code_;  // Code is immutable: only pointer stability matters
+    size_t code_bytes_{0};
+    size_t max_code_bytes_;
+    size_t hits_{0};
+    size_t misses_{0};
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,93 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/buffer.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("StateCache") {
+    using evmc::literals::operator""_address;
+    using evmc::literals::operator""_bytes32;
+
+    const auto address1{0x00000000000000000000000000000000000000aa_address};
+    const auto address2{0x00000000000000000000000000000000000000bb_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32};
+
+    SECTION("Bounded") {
+        StateCache cache{/*max_entries=*/1, /*max_code_bytes=*/4};
+        Account account;
+        account.nonce = 3;
+        cache.put_account(address1, account);
+        cache.put_account(address2, std::nullopt);
+        CHECK_FALSE(cache.get_account(address1));  // evicted
+        const auto* absent{cache.get_account(address2)};
+        REQUIRE(absent);
+        CHECK_FALSE(absent->has_value());
+
+        cache.put_storage(address1, kDefaultIncarnation, location, value);
+        CHECK(*cache.get_storage(address1, kDefaultIncarnation, location) == value);
+        CHECK_FALSE(cache.get_storage(address1, kDefaultIncarnation + 1, location));
+        CHECK(cache.hits() == 2);
+        CHECK(cache.misses() == 2);
+
+        const Bytes code{*from_hex("600160005500")};
+        const ByteView code_view{cache.put_code(kEmptyHash, code)};
+        CHECK(code_view == code);
+        CHECK(cache.get_code(kEmptyHash) == code_view);  // same copy
+        cache.trim();  // over budget
+        CHECK_FALSE(cache.get_code(kEmptyHash));
+    }
+
+    SECTION("Shared by buffers") {
+        test::Context context;
+        auto& txn{context.txn()};
+        StateCache cache{/*max_entries=*/16};
+
+        Account account;
+        account.nonce = 1;
+        Buffer writer{txn, 0};
+        writer.use_state_cache(&cache);
+        writer.begin_block(1);
+        CHECK_FALSE(writer.read_account(address1));
+        writer.update_account(address1, std::nullopt, account);
+        writer.update_storage(address1, kDefaultIncarnation, location, {}, value);
+        writer.write_to_db();
+
+        // Written state is cached as such
+        const auto hits{cache.hits()};
+        Buffer reader{txn, 0};
+        reader.use_state_cache(&cache);
+        CHECK(reader.read_account(address1)->nonce == 1);
+        CHECK(reader.read_storage(address1, kDefaultIncarnation, location) == value);
+        CHECK(cache.hits() == hits + 2);
+
+        // Read state is cached too
+        CHECK_FALSE(reader.read_account(address2));
+        Buffer other_reader{txn, 0};
+        other_reader.use_state_cache(&cache);
+        CHECK_FALSE(other_reader.read_account(address2));
+        CHECK(cache.hits() == hits + 3);
+    }
+}
+
+}  // namespace silkworm::db
@@ -0,0 +1,139 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_filter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <silkworm/common/assert.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db {
+
+// MurmurHash3 finalizer: every input bit affects every output bit
+static uint64_t mix(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t load64(const uint8_t* data) noexcept {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+// Storage locations may be freely chosen (e.g. small integers), hence all keys are fully mixed
+static uint64_t account_hash(const evmc::address& address) noexcept {
+    uint32_t tail;
+    std::memcpy(&tail, address.bytes + 16, sizeof(tail));
+    return mix(mix(mix(load64(address.bytes) ^ 0x9e3779b97f4a7c15) ^ load64(address.bytes + 8)) ^ tail);
+}
+
+static uint64_t storage_hash(const evmc::address& address, uint64_t incarnation,
+                             const evmc::bytes32& location) noexcept {
+    uint64_t h{mix(account_hash(address) ^ incarnation)};
+    for (size_t i{0}; i < kHashLength; i += sizeof(uint64_t)) {
+        h = mix(h ^ load64(location.bytes + i));
+    }
+    return h;
+}
+
+StateFilter::StateFilter(size_t expected_keys, size_t bits_per_key) : expected_keys_{expected_keys} {
+    SILKWORM_ASSERT(bits_per_key > 0);
+    const size_t bits{std::max<size_t>(expected_keys, 1) * bits_per_key};
+    blocks_.resize((bits + sizeof(Block) * 8 - 1) / (sizeof(Block) * 8));
+}
+
+StateFilter StateFilter::build(mdbx::txn& txn, size_t bits_per_key) {
+    auto plain_state{open_cursor(txn, table::kPlainState)};
+    StateFilter filter{2 * static_cast<size_t>(txn.get_map_stat(plain_state.map()).ms_entries), bits_per_key};
+
+    auto data{plain_state.to_first(/*throw_notfound=*/false)};
+    while (data) {
+        const ByteView key{from_slice(data.key)};
+        const auto address{to_evmc_address(key)};
+        if (key.length() == kAddressLength) {
+            filter.insert_account(address);
+            data = plain_state.to_next(/*throw_notfound=*/false);
+        } else {
+            // Storage locations are duplicates of (address, incarnation)
+            SILKWORM_ASSERT(key.length() == kPlainStoragePrefixLength);
+            const uint64_t incarnation{endian::load_big_u64(&key[kAddressLength])};
+            while (data) {
+                const ByteView entry{from_slice(data.value)};
+                SILKWORM_ASSERT(entry.length() > kLocationLength);
+                filter.insert_storage(address, incarnation, to_bytes32(entry.substr(0, kLocationLength)));
+                data = plain_state.to_current_next_multi(/*throw_notfound=*/false);
+            }
+            data = plain_state.to_next(/*throw_notfound=*/false);
+        }
+    }
+    return filter;
+}
+
+void StateFilter::insert_account(const evmc::address& address) noexcept { insert(account_hash(address)); }
+
+void StateFilter::insert_storage(const evmc::address& address, uint64_t incarnation,
+                                 const evmc::bytes32& location) noexcept {
+    insert(storage_hash(address, incarnation, location));
+}
+
+bool StateFilter::may_contain_account(const evmc::address& address) const noexcept {
+    return may_contain(account_hash(address));
+}
+
+bool StateFilter::may_contain_storage(const evmc::address& address, uint64_t incarnation,
+                                      const evmc::bytes32& location) const noexcept {
+    return may_contain(storage_hash(address, incarnation, location));
+}
+
+// The upper half of hash picks the block (multiply-shift rather than modulo), a remix of it picks the bit of each
+// word from 6 bits apiece
+
+void StateFilter::insert(uint64_t hash) noexcept {
+    Block& block{blocks_[static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32)]};
+    const uint64_t bits{mix(hash)};
+    bool added{false};
+    for (size_t i{0}; i < 8; ++i) {
+        const uint64_t mask{uint64_t{1} << ((bits >> (6 * i)) & 63)};
+        added |= (block.words[i] & mask) == 0;
+        block.words[i] |= mask;
+    }
+    if (added) {
+        ++size_;
+    }
+}
+
+bool StateFilter::may_contain(uint64_t hash) const noexcept {
+    const Block& block{blocks_[static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32)]};
+    const uint64_t bits{mix(hash)};
+    for (size_t i{0}; i < 8; ++i) {
+        if ((block.words[i] & (uint64_t{1} << ((bits >> (6 * i)) & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace silkworm::db
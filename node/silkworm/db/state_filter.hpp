@@ -0,0 +1,74 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+//! \brief Blocked Bloom filter over the keys of PlainState (accounts, and storage locations of accounts'
+//! incarnations), letting reads of absent state return without descending the db B-tree
+//! \details Each key sets one bit in each of the 8 words of a single cache-line sized block, hence a lookup touches
+//! one cache line only. With 10 bits per key about 1% of absent keys are reported as possibly present.
+//! \remarks Keys are never removed: the filter is a superset of PlainState keys as long as every write goes through
+//! it (see Buffer::use_state_filter). It must be rebuilt whenever PlainState changes otherwise (e.g. unwinds) and is
+//! best rebuilt once saturated(), i.e. once more keys than planned have been inserted. Not thread safe
+class StateFilter {
+  public:
+    static constexpr size_t kDefaultBitsPerKey{10};
+
+    //! \param [in] expected_keys : number of keys planned for, past which the filter is saturated
+    explicit StateFilter(size_t expected_keys, size_t bits_per_key = kDefaultBitsPerKey);
+
+    //! \brief Builds a filter of all keys in PlainState, planning for twice as many
+    static StateFilter build(mdbx::txn& txn, size_t bits_per_key = kDefaultBitsPerKey);
+
+    void insert_account(const evmc::address& address) noexcept;
+    void insert_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) noexcept;
+
+    //! \brief False if the account is definitely not in PlainState
+    [[nodiscard]] bool may_contain_account(const evmc::address& address) const noexcept;
+
+    //! \brief False if the storage location is definitely not in PlainState
+    [[nodiscard]] bool may_contain_storage(const evmc::address& address, uint64_t incarnation,
+                                           const evmc::bytes32& location) const noexcept;
+
+    //! \brief Number of distinct keys inserted (up to false positives)
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] bool saturated() const noexcept { return size_ > expected_keys_; }
+
+    [[nodiscard]] size_t memory_usage() const noexcept { return blocks_.size() * sizeof(Block); }
+
+  private:
+    struct alignas(64) Block {
+        uint64_t words[8]{};
+    };
+
+    void insert(uint64_t hash) noexcept;
+    [[nodiscard]] bool may_contain(uint64_t hash) const noexcept;
+
+    std::vector<Block> blocks_;
+    size_t expected_keys_;
+    size_t size_{0};
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,115 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_filter.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/buffer.hpp>
+
+namespace silkworm::db {
+
+static evmc::address make_address(uint64_t n) {
+    evmc::address address;
+    endian::store_big_u64(address.bytes + 12, n);
+    return address;
+}
+
+static evmc::bytes32 make_location(uint64_t n) {
+    evmc::bytes32 location;
+    endian::store_big_u64(location.bytes + 24, n);
+    return location;
+}
+
+TEST_CASE("StateFilter") {
+    SECTION("No false negatives, few false positives") {
+        constexpr uint64_t kKeys{10'000};
+        StateFilter filter{/*expected_keys=*/2 * kKeys};
+        for (uint64_t i{0}; i < kKeys; ++i) {
+            filter.insert_account(make_address(i));
+            filter.insert_storage(make_address(0), 1, make_location(i));  // Small locations, as in most contracts
+        }
+        CHECK(filter.size() > 2 * kKeys * 99 / 100);  // Up to false positives
+        CHECK_FALSE(filter.saturated());
+
+        size_t false_positives{0};
+        for (uint64_t i{0}; i < kKeys; ++i) {
+            REQUIRE(filter.may_contain_account(make_address(i)));
+            REQUIRE(filter.may_contain_storage(make_address(0), 1, make_location(i)));
+            false_positives += filter.may_contain_account(make_address(kKeys + i));
+            false_positives += filter.may_contain_storage(make_address(0), 2, make_location(i));  // Other incarnation
+            false_positives += filter.may_contain_storage(make_address(1), 1, make_location(i));  // Other account
+        }
+        CHECK(false_positives < 3 * kKeys * 3 / 100);
+
+        filter.insert_account(make_address(2 * kKeys));
+        filter.insert_account(make_address(2 * kKeys));  // Not counted twice
+        CHECK(filter.size() <= 2 * kKeys + 1);
+    }
+
+    SECTION("Saturation") {
+        StateFilter filter{/*expected_keys=*/2};
+        filter.insert_account(make_address(1));
+        filter.insert_account(make_address(2));
+        CHECK_FALSE(filter.saturated());
+        filter.insert_account(make_address(3));
+        CHECK(filter.saturated());
+    }
+
+    SECTION("Built from PlainState and written through by Buffer") {
+        test::Context context;
+        auto& txn{context.txn()};
+
+        const auto address1{make_address(1)};
+        const auto address2{make_address(2)};
+        const auto location{make_location(42)};
+        const evmc::bytes32 value{make_location(0xbeef)};
+
+        Account account;
+        account.nonce = 1;
+        Buffer writer{txn, 0};
+        writer.begin_block(1);
+        writer.update_account(address1, std::nullopt, account);
+        writer.update_storage(address1, kDefaultIncarnation, location, {}, value);
+        writer.write_to_db();
+
+        auto filter{StateFilter::build(txn)};
+        CHECK(filter.size() == 2);
+        CHECK_FALSE(filter.saturated());
+        CHECK(filter.may_contain_account(address1));
+        CHECK(filter.may_contain_storage(address1, kDefaultIncarnation, location));
+
+        Buffer buffer{txn, 0};
+        buffer.use_state_filter(&filter);
+        buffer.begin_block(2);
+        CHECK(buffer.read_account(address1)->nonce == 1);
+        CHECK(buffer.read_storage(address1, kDefaultIncarnation, location) == value);
+        CHECK_FALSE(buffer.read_account(address2));
+
+        account.nonce = 7;
+        buffer.update_account(address2, std::nullopt, account);
+        buffer.write_to_db();
+        CHECK(filter.may_contain_account(address2));
+
+        Buffer reader{txn, 0};
+        reader.use_state_filter(&filter);
+        CHECK(reader.read_account(address2)->nonce == 7);
+    }
+}
+
+}  // namespace silkworm::db
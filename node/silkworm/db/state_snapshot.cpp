@@ -0,0 +1,503 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_snapshot.hpp"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/parallel_walk.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/etl/collector.hpp>
+#include <silkworm/trie/intermediate_hashes.hpp>
+
+namespace silkworm::db {
+
+namespace {
+
+    constexpr uint8_t kMagic[8]{'S', 'W', 'S', 'T', 'A', 'T', 'E', '1'};
+    constexpr size_t kManifestHeaderSize{sizeof(kMagic) + sizeof(uint64_t) + 2 * kHashLength + sizeof(uint64_t)};
+    constexpr size_t kChunkEntryFixedSize{1 + 3 * sizeof(uint64_t) + kHashLength + sizeof(uint16_t)};
+    constexpr size_t kMaxChunkSize{1_Gibi};  // Well within LZ4 limits
+
+    void append_u64(Bytes& out, uint64_t value) {
+        uint8_t buf[sizeof(uint64_t)];
+        endian::store_big_u64(buf, value);
+        out.append(buf, sizeof(buf));
+    }
+
+    void append_u32(Bytes& out, uint32_t value) {
+        uint8_t buf[sizeof(uint32_t)];
+        endian::store_big_u32(buf, value);
+        out.append(buf, sizeof(buf));
+    }
+
+    Bytes read_file(const std::filesystem::path& path) {
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (!file) {
+            throw std::runtime_error("Unable to open " + path.string());
+        }
+        Bytes content(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        if (!file.read(byte_ptr_cast(content.data()), static_cast<std::streamsize>(content.size()))) {
+            throw std::runtime_error("Unable to read " + path.string());
+        }
+        return content;
+    }
+
+    void write_file(const std::filesystem::path& path, ByteView content) {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if (!file.write(byte_ptr_cast(content.data()), static_cast<std::streamsize>(content.size())) ||
+            !file.flush()) {
+            throw std::runtime_error("Unable to write " + path.string());
+        }
+    }
+
+    //! \brief Invokes func on each record of the raw content of a chunk
+    //! \return The number of records
+    size_t for_each_record(ByteView raw, const std::function<void(ByteView key, ByteView value)>& func) {
+        size_t count{0};
+        while (!raw.empty()) {
+            ByteView fields[2];
+            for (auto& field : fields) {
+                if (raw.length() < sizeof(uint32_t)) {
+                    throw std::runtime_error("Truncated chunk record");
+                }
+                const size_t length{endian::load_big_u32(raw.data())};
+                raw.remove_prefix(sizeof(uint32_t));
+                if (raw.length() < length) {
+                    throw std::runtime_error("Truncated chunk record");
+                }
+                field = raw.substr(0, length);
+                raw.remove_prefix(length);
+            }
+            func(fields[0], fields[1]);
+            ++count;
+        }
+        return count;
+    }
+
+    //! \brief Writes the records of a key range of a table into consecutive chunk files
+    class ChunkWriter {
+      public:
+        ChunkWriter(const std::filesystem::path& dir, uint8_t table, size_t partition, size_t chunk_size)
+            : dir_{dir}, table_{table}, partition_{partition}, chunk_size_{chunk_size} {}
+
+        void append(ByteView key, ByteView value) {
+            append_u32(raw_, static_cast<uint32_t>(key.length()));
+            raw_.append(key);
+            append_u32(raw_, static_cast<uint32_t>(value.length()));
+            raw_.append(value);
+            ++records_;
+            if (raw_.length() >= chunk_size_) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (raw_.empty()) {
+                return;
+            }
+            StateSnapshotChunk& chunk{chunks_.emplace_back()};
+            chunk.table = table_;
+            chunk.records = records_;
+            chunk.raw_size = raw_.length();
+            chunk.hash = bit_cast<evmc_bytes32>(keccak256(raw_));
+            chunk.file_name = std::string(kStateSnapshotTables[table_].name) + "." + std::to_string(partition_) + "." +
+                              std::to_string(chunks_.size() - 1) + ".lz4";
+
+            compressed_.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw_.length()))));
+            const int compressed_size{LZ4_compress_default(byte_ptr_cast(raw_.data()),
+                                                           byte_ptr_cast(compressed_.data()),
+                                                           static_cast<int>(raw_.length()),
+                                                           static_cast<int>(compressed_.length()))};
+            if (compressed_size <= 0) {
+                throw std::runtime_error("Unable to compress chunk " + chunk.file_name);
+            }
+            chunk.compressed_size = static_cast<uint64_t>(compressed_size);
+            write_file(dir_ / chunk.file_name, ByteView{compressed_.data(), chunk.compressed_size});
+
+            raw_.clear();
+            records_ = 0;
+        }
+
+        [[nodiscard]] std::vector<StateSnapshotChunk>& chunks() { return chunks_; }
+
+      private:
+        std::filesystem::path dir_;
+        uint8_t table_;
+        size_t partition_;
+        size_t chunk_size_;
+        Bytes raw_;
+        Bytes compressed_;
+        uint64_t records_{0};
+        std::vector<StateSnapshotChunk> chunks_;
+    };
+
+    //! \brief Raw records of a chunk along with the hashed state entries they yield
+    struct DecodedChunk {
+        Bytes raw;
+        std::vector<etl::Entry> hashed_accounts;   // HashedAccounts records
+        std::vector<etl::Entry> hashed_storage;    // HashedStorage records, with location hash moved into the key
+        std::vector<etl::Entry> hashed_code_hash;  // HashedCodeHash records
+    };
+
+    DecodedChunk decode_chunk(const std::filesystem::path& dir, const StateSnapshotChunk& chunk) {
+        const auto path{dir / chunk.file_name};
+        const Bytes compressed{read_file(path)};
+        if (compressed.length() != chunk.compressed_size || chunk.raw_size > kMaxChunkSize) {
+            throw std::runtime_error("Chunk " + path.string() + " has unexpected size");
+        }
+        DecodedChunk decoded;
+        decoded.raw.resize(chunk.raw_size);
+        const int raw_size{LZ4_decompress_safe(byte_ptr_cast(compressed.data()), byte_ptr_cast(decoded.raw.data()),
+                                               static_cast<int>(compressed.length()),
+                                               static_cast<int>(decoded.raw.length()))};
+        if (raw_size < 0 || static_cast<uint64_t>(raw_size) != chunk.raw_size) {
+            throw std::runtime_error("Chunk " + path.string() + " is corrupted");
+        }
+        if (bit_cast<evmc_bytes32>(keccak256(decoded.raw)) != chunk.hash) {
+            throw std::runtime_error("Chunk " + path.string() + " does not match its hash");
+        }
+
+        const std::string_view table_name{kStateSnapshotTables[chunk.table].name};
+        const bool plain_state{table_name == table::kPlainState.name};
+        const bool plain_code_hash{table_name == table::kPlainCodeHash.name};
+
+        // Records are sorted by address: each address is hashed once
+        evmc::address last_address;
+        ethash::hash256 address_hash{};
+        bool has_address{false};
+        const auto hash_address{[&](ByteView key) {
+            if (key.length() < kAddressLength) {
+                throw std::runtime_error("Chunk " + path.string() + " has unexpected key " + to_hex(key));
+            }
+            if (!has_address || std::memcmp(key.data(), last_address.bytes, kAddressLength) != 0) {
+                last_address = to_evmc_address(key);
+                address_hash = keccak256(last_address.bytes);
+                has_address = true;
+            }
+        }};
+
+        const size_t records{for_each_record(decoded.raw, [&](ByteView key, ByteView value) {
+            if (!plain_state && !plain_code_hash) {
+                return;  // Not hashed
+            }
+            hash_address(key);
+            if (plain_state && key.length() == kAddressLength) {
+                decoded.hashed_accounts.push_back({Bytes{address_hash.bytes, kHashLength}, Bytes{value}});
+            } else if (plain_state && key.length() == kPlainStoragePrefixLength && value.length() >= kHashLength) {
+                // Key hash (32 bytes) + Incarnation (8 bytes) + Location hash (32 bytes)
+                Bytes hashed_key(kHashedStoragePrefixLength + kHashLength, '\0');
+                std::memcpy(&hashed_key[0], address_hash.bytes, kHashLength);
+                std::memcpy(&hashed_key[kHashLength], &key[kAddressLength], kIncarnationLength);
+                const auto location_hash{keccak256(value.substr(0, kHashLength))};
+                std::memcpy(&hashed_key[kHashedStoragePrefixLength], location_hash.bytes, kHashLength);
+                decoded.hashed_storage.push_back({std::move(hashed_key), Bytes{value.substr(kHashLength)}});
+            } else if (plain_code_hash && key.length() == kPlainStoragePrefixLength) {
+                Bytes hashed_key(kHashedStoragePrefixLength, '\0');
+                std::memcpy(&hashed_key[0], address_hash.bytes, kHashLength);
+                std::memcpy(&hashed_key[kHashLength], &key[kAddressLength], kIncarnationLength);
+                decoded.hashed_code_hash.push_back({std::move(hashed_key), Bytes{value}});
+            } else {
+                throw std::runtime_error("Chunk " + path.string() + " has unexpected record " + to_hex(key));
+            }
+        })};
+        if (records != chunk.records) {
+            throw std::runtime_error("Chunk " + path.string() + " has unexpected record count");
+        }
+        return decoded;
+    }
+
+}  // namespace
+
+StateSnapshotManifest StateSnapshotManifest::read(const std::filesystem::path& dir) {
+    const auto path{dir / kFileName};
+    const Bytes content{read_file(path)};
+    ByteView view{content};
+    if (view.length() < kManifestHeaderSize || std::memcmp(view.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Manifest " + path.string() + " has invalid header");
+    }
+    view.remove_prefix(sizeof(kMagic));
+
+    StateSnapshotManifest manifest;
+    manifest.block_number = endian::load_big_u64(view.data());
+    view.remove_prefix(sizeof(uint64_t));
+    std::memcpy(manifest.block_hash.bytes, view.data(), kHashLength);
+    view.remove_prefix(kHashLength);
+    std::memcpy(manifest.state_root.bytes, view.data(), kHashLength);
+    view.remove_prefix(kHashLength);
+    const uint64_t chunk_count{endian::load_big_u64(view.data())};
+    view.remove_prefix(sizeof(uint64_t));
+
+    for (uint64_t i{0}; i < chunk_count; ++i) {
+        if (view.length() < kChunkEntryFixedSize) {
+            throw std::runtime_error("Manifest " + path.string() + " is truncated");
+        }
+        StateSnapshotChunk& chunk{manifest.chunks.emplace_back()};
+        chunk.table = view[0];
+        view.remove_prefix(1);
+        chunk.records = endian::load_big_u64(view.data());
+        chunk.raw_size = endian::load_big_u64(view.data() + sizeof(uint64_t));
+        chunk.compressed_size = endian::load_big_u64(view.data() + 2 * sizeof(uint64_t));
+        view.remove_prefix(3 * sizeof(uint64_t));
+        std::memcpy(chunk.hash.bytes, view.data(), kHashLength);
+        view.remove_prefix(kHashLength);
+        const size_t name_length{endian::load_big_u16(view.data())};
+        view.remove_prefix(sizeof(uint16_t));
+        if (view.length() < name_length) {
+            throw std::runtime_error("Manifest " + path.string() + " is truncated");
+        }
+        chunk.file_name = std::string{byte_ptr_cast(view.data()), name_length};
+        view.remove_prefix(name_length);
+
+        // Chunks are loaded by appends and refer to files within dir only
+        const bool out_of_order{i > 0 && chunk.table < manifest.chunks[i - 1].table};
+        if (chunk.table >= kStateSnapshotTables.size() || out_of_order || chunk.file_name.empty() ||
+            chunk.file_name.find('/') != std::string::npos || chunk.file_name.find('\\') != std::string::npos ||
+            chunk.file_name == "." || chunk.file_name == "..") {
+            throw std::runtime_error("Manifest " + path.string() + " has invalid chunk " + std::to_string(i));
+        }
+    }
+    if (!view.empty()) {
+        throw std::runtime_error("Manifest " + path.string() + " has trailing data");
+    }
+    return manifest;
+}
+
+void StateSnapshotManifest::write(const std::filesystem::path& dir) const {
+    Bytes content(kMagic, sizeof(kMagic));
+    append_u64(content, block_number);
+    content.append(block_hash.bytes, kHashLength);
+    content.append(state_root.bytes, kHashLength);
+    append_u64(content, chunks.size());
+    for (const auto& chunk : chunks) {
+        content.push_back(chunk.table);
+        append_u64(content, chunk.records);
+        append_u64(content, chunk.raw_size);
+        append_u64(content, chunk.compressed_size);
+        content.append(chunk.hash.bytes, kHashLength);
+        uint8_t name_length[sizeof(uint16_t)];
+        endian::store_big_u16(name_length, static_cast<uint16_t>(chunk.file_name.length()));
+        content.append(name_length, sizeof(name_length));
+        content.append(string_view_to_byte_view(chunk.file_name));
+    }
+
+    const auto path{dir / kFileName};
+    auto temp_path{path};
+    temp_path += ".tmp";
+    write_file(temp_path, content);
+    std::filesystem::rename(temp_path, path);
+}
+
+StateSnapshotManifest export_state_snapshot(::mdbx::env env, const std::filesystem::path& dir, size_t num_threads,
+                                            size_t chunk_size) {
+    if (!chunk_size || chunk_size > kMaxChunkSize) {
+        throw std::runtime_error("Invalid chunk size " + std::to_string(chunk_size));
+    }
+    num_threads = std::max<size_t>(num_threads, 1);
+    std::filesystem::create_directories(dir);
+    if (std::filesystem::exists(dir / StateSnapshotManifest::kFileName)) {
+        throw std::runtime_error("Directory " + dir.string() + " already holds a state snapshot");
+    }
+
+    StateSnapshotManifest manifest;
+    std::vector<std::vector<Bytes>> boundaries;  // Key ranges of each table
+    auto txn{env.start_read()};
+    const uint64_t txn_id{txn.id()};
+    manifest.block_number = stages::read_stage_progress(txn, stages::kExecutionKey);
+    const auto block_hash{read_canonical_header_hash(txn, manifest.block_number)};
+    if (!block_hash) {
+        throw std::runtime_error("Missing canonical hash of block " + std::to_string(manifest.block_number));
+    }
+    const auto header{read_header(txn, manifest.block_number, block_hash->bytes)};
+    if (!header) {
+        throw std::runtime_error("Missing header of block " + std::to_string(manifest.block_number));
+    }
+    manifest.block_hash = *block_hash;
+    manifest.state_root = header->state_root;
+    for (const auto& config : kStateSnapshotTables) {
+        boundaries.push_back(partition_keys(txn, config, num_threads));
+    }
+
+    log::Info("Exporting state snapshot", {"block", std::to_string(manifest.block_number), "dir", dir.string()});
+
+    // Each key range of each table is walked on its own read-only transaction, which must see the same snapshot
+    const auto export_range{[&](uint8_t table_index, size_t partition) -> std::vector<StateSnapshotChunk> {
+        auto range_txn{env.start_read()};
+        if (range_txn.id() != txn_id) {
+            throw std::runtime_error("Database changed while exporting state snapshot");
+        }
+        const auto& ranges{boundaries[table_index]};
+        const Bytes& begin{ranges[partition]};
+        const Bytes* end{partition + 1 < ranges.size() ? &ranges[partition + 1] : nullptr};
+
+        ChunkWriter writer{dir, table_index, partition, chunk_size};
+        Cursor cursor{range_txn, kStateSnapshotTables[table_index]};
+        auto data{begin.empty() ? cursor.to_first(/*throw_notfound=*/false)
+                                : cursor.lower_bound(to_slice(begin), /*throw_notfound=*/false)};
+        while (data.done && (!end || from_slice(data.key) < *end)) {
+            writer.append(from_slice(data.key), from_slice(data.value));
+            data = cursor.to_next(/*throw_notfound=*/false);
+        }
+        writer.flush();
+        return std::move(writer.chunks());
+    }};
+
+    thread_pool pool{static_cast<uint32_t>(num_threads)};
+    std::vector<std::future<std::vector<StateSnapshotChunk>>> exports;
+    for (uint8_t i{0}; i < kStateSnapshotTables.size(); ++i) {
+        for (size_t partition{0}; partition < boundaries[i].size(); ++partition) {
+            exports.push_back(pool.submit([&export_range, i, partition] { return export_range(i, partition); }));
+        }
+    }
+
+    // Ranges were submitted in table then key order: so are their chunks
+    std::exception_ptr exception;
+    for (auto& range_export : exports) {
+        try {
+            auto chunks{range_export.get()};
+            manifest.chunks.insert(manifest.chunks.end(), std::make_move_iterator(chunks.begin()),
+                                   std::make_move_iterator(chunks.end()));
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    manifest.write(dir);
+    log::Info("Exported state snapshot", {"block", std::to_string(manifest.block_number), "chunks",
+                                          std::to_string(manifest.chunks.size())});
+    return manifest;
+}
+
+StateSnapshotManifest import_state_snapshot(RWTxn& txn, const std::filesystem::path& dir,
+                                            const std::filesystem::path& etl_dir, size_t num_threads) {
+    const auto manifest{StateSnapshotManifest::read(dir)};
+    num_threads = std::max<size_t>(num_threads, 1);
+    log::Info("Importing state snapshot", {"block", std::to_string(manifest.block_number), "chunks",
+                                           std::to_string(manifest.chunks.size())});
+
+    for (const auto& config : kStateSnapshotTables) {
+        txn->clear_map(open_map(*txn, config));
+    }
+    for (const auto& config : {table::kHashedAccounts, table::kHashedStorage, table::kHashedCodeHash,
+                               table::kTrieOfAccounts, table::kTrieOfStorage, table::kAccountChangeSet,
+                               table::kStorageChangeSet}) {
+        txn->clear_map(open_map(*txn, config));
+    }
+
+    // Chunks are decompressed, verified and hashed ahead on the pool, a bounded number at a time, while the calling
+    // thread appends them in order: a single bulk loader at a time as each may commit
+    etl::Collector hashed_accounts{etl_dir};
+    etl::Collector hashed_storage{etl_dir};
+    etl::Collector hashed_code_hash{etl_dir};
+    {
+        thread_pool pool{static_cast<uint32_t>(num_threads)};
+        std::deque<std::future<DecodedChunk>> pending;
+        size_t next_chunk{0};
+        const auto schedule{[&] {
+            while (next_chunk < manifest.chunks.size() && pending.size() < 2 * num_threads) {
+                const StateSnapshotChunk* chunk{&manifest.chunks[next_chunk++]};
+                pending.push_back(pool.submit([&dir, chunk] { return decode_chunk(dir, *chunk); }));
+            }
+        }};
+
+        std::unique_ptr<BulkLoader> loader;
+        uint8_t loader_table{0};
+        try {
+            for (const auto& chunk : manifest.chunks) {
+                schedule();
+                DecodedChunk decoded{pending.front().get()};
+                pending.pop_front();
+
+                if (!loader || loader_table != chunk.table) {
+                    loader.reset();
+                    loader = std::make_unique<BulkLoader>(txn, kStateSnapshotTables[chunk.table]);
+                    loader_table = chunk.table;
+                }
+                (void)for_each_record(decoded.raw, [&](ByteView key, ByteView value) { loader->append(key, value); });
+                for (auto& entry : decoded.hashed_accounts) {
+                    hashed_accounts.collect(std::move(entry));
+                }
+                for (auto& entry : decoded.hashed_storage) {
+                    hashed_storage.collect(std::move(entry));
+                }
+                for (auto& entry : decoded.hashed_code_hash) {
+                    hashed_code_hash.collect(std::move(entry));
+                }
+            }
+        } catch (...) {
+            // Let scheduled chunks complete before the pool goes
+            for (auto& decode : pending) {
+                decode.wait();
+            }
+            throw;
+        }
+    }
+
+    {
+        BulkLoader loader{txn, table::kHashedAccounts};
+        hashed_accounts.load(loader);
+    }
+    {
+        // Location hash moves back from key to value
+        BulkLoader loader{txn, table::kHashedStorage};
+        Bytes value;
+        hashed_storage.load(loader, [&value](const etl::EntryView& entry, BulkLoader& storage_loader) {
+            value.assign(entry.key.substr(kHashedStoragePrefixLength));
+            value.append(entry.value);
+            storage_loader.append(entry.key.substr(0, kHashedStoragePrefixLength), value);
+        });
+    }
+    {
+        BulkLoader loader{txn, table::kHashedCodeHash};
+        hashed_code_hash.load(loader);
+    }
+
+    // The hashed state is committed unless within an external transaction: tries are then built on parallel threads
+    txn.force_commit();
+    if (txn.is_external()) {
+        (void)trie::regenerate_intermediate_hashes(*txn, etl_dir, &manifest.state_root);
+    } else {
+        (void)trie::regenerate_intermediate_hashes_sharded(*txn, etl_dir, &manifest.state_root);
+    }
+
+    log::Info("Imported state snapshot", {"block", std::to_string(manifest.block_number)});
+    return manifest;
+}
+
+}  // namespace silkworm::db
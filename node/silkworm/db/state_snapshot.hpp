@@ -0,0 +1,100 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/tables.hpp>
+
+/*
+State snapshots: the plain state as of a block, exported into a directory of compressed chunk files, which a new node
+imports in place of executing all blocks up to that block. A snapshot directory holds
+
+    manifest    : magic (8 bytes) + block_number_u64 (BE) + block_hash (32 bytes) + state_root (32 bytes) +
+                  chunk_count_u64 (BE) + one entry per chunk
+    entry       : table_u8 + records_u64 (BE) + raw_size_u64 (BE) + compressed_size_u64 (BE) + hash (32 bytes) +
+                  file_name_length_u16 (BE) + file_name
+    chunk files : a single LZ4 block of records, each being key_length_u32 (BE) + key + value_length_u32 (BE) + value
+
+Chunks hold contiguous sorted records and are listed in table then key order, so that loading them in manifest order
+only ever appends. The hash of a chunk is the Keccak-256 of its raw (uncompressed) records. The manifest is written
+last: a directory without one is not a snapshot.
+*/
+namespace silkworm::db {
+
+//! \brief Tables held by a state snapshot, in manifest order
+inline constexpr std::array<MapConfig, 4> kStateSnapshotTables{table::kPlainState, table::kCode, table::kPlainCodeHash,
+                                                              table::kIncarnationMap};
+
+//! \brief Raw size past which a chunk is closed
+inline constexpr size_t kDefaultStateSnapshotChunkSize{32_Mebi};
+
+struct StateSnapshotChunk {
+    uint8_t table{0};  // Index into kStateSnapshotTables
+    uint64_t records{0};
+    uint64_t raw_size{0};
+    uint64_t compressed_size{0};
+    evmc::bytes32 hash;
+    std::string file_name;  // Relative to the snapshot directory
+};
+
+struct StateSnapshotManifest {
+    static constexpr const char* kFileName{"manifest"};
+
+    BlockNum block_number{0};
+    evmc::bytes32 block_hash;
+    evmc::bytes32 state_root;
+    std::vector<StateSnapshotChunk> chunks;
+
+    //! \brief Reads the manifest of the snapshot in dir
+    //! \remarks Throws std::runtime_error if missing or malformed
+    static StateSnapshotManifest read(const std::filesystem::path& dir);
+
+    //! \brief Writes the manifest into dir, atomically replacing any previous one
+    void write(const std::filesystem::path& dir) const;
+};
+
+//! \brief Exports the state as of the Execution stage progress of env into dir
+//! \param [in] env : the environment to open read-only transactions on, one per thread. It must not be written
+//! meanwhile: threads check they all read the very same snapshot and throw otherwise
+//! \param [in] dir : the directory chunks and manifest are written into (created if missing, must hold no manifest)
+//! \param [in] num_threads : number of key ranges of each table compressed in parallel
+//! \param [in] chunk_size : raw size past which a chunk is closed
+//! \return The manifest written into dir
+StateSnapshotManifest export_state_snapshot(::mdbx::env env, const std::filesystem::path& dir, size_t num_threads,
+                                            size_t chunk_size = kDefaultStateSnapshotChunkSize);
+
+//! \brief Replaces the state of txn with the one of the snapshot in dir, along with the hashed state and the tries
+//! \param [in] txn : the transaction to import into. Loads commit along the way unless it is external
+//! \param [in] dir : the snapshot directory
+//! \param [in] etl_dir : the directory hashed entries are sorted in
+//! \param [in] num_threads : number of threads decompressing, verifying and hashing chunks ahead of the loads
+//! \return The manifest of the snapshot
+//! \remarks Chunks are appended in manifest order by the calling thread. PlainState, Code, PlainCodeHash,
+//! IncarnationMap, HashedAccounts, HashedStorage, HashedCodeHash, TrieOfAccounts, TrieOfStorage and change sets are
+//! replaced. Throws std::runtime_error on a chunk not matching its hash and trie::WrongRoot if the state does not
+//! match the root of the manifest. Progresses are not written: the caller does once done
+StateSnapshotManifest import_state_snapshot(RWTxn& txn, const std::filesystem::path& dir,
+                                            const std::filesystem::path& etl_dir, size_t num_threads);
+
+}  // namespace silkworm::db
@@ -0,0 +1,126 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_snapshot.hpp"
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/state/in_memory_state.hpp>
+
+namespace silkworm::db {
+
+static std::vector<std::pair<Bytes, Bytes>> read_records(::mdbx::env& env, const MapConfig& config) {
+    auto txn{env.start_read()};
+    Cursor cursor{txn, config};
+    std::vector<std::pair<Bytes, Bytes>> records;
+    for (auto data{cursor.to_first(/*throw_notfound=*/false)}; data; data = cursor.to_next(/*throw_notfound=*/false)) {
+        records.emplace_back(Bytes{from_slice(data.key)}, Bytes{from_slice(data.value)});
+    }
+    return records;
+}
+
+TEST_CASE("State snapshot") {
+    test::Context source;
+
+    // Same state in db and in memory, the latter computing the expected root
+    InMemoryState expected_state;
+    Buffer buffer{source.txn(), 0};
+    size_t storage_records{0};
+    for (State* state : std::vector<State*>{&buffer, &expected_state}) {
+        state->begin_block(1);
+        for (uint8_t i{0}; i < 100; ++i) {
+            evmc::address address;
+            address.bytes[0] = i;
+            Account account;
+            account.nonce = i + 1u;
+            account.balance = i;
+            if (i % 10 == 0) {
+                const Bytes code{0x60, i, 0x00};
+                account.incarnation = kDefaultIncarnation;
+                account.code_hash = bit_cast<evmc_bytes32>(keccak256(code));
+                state->update_account_code(address, kDefaultIncarnation, account.code_hash, code);
+                for (uint8_t j{1}; j <= i / 10 + 1; ++j) {
+                    evmc::bytes32 location;
+                    location.bytes[31] = j;
+                    evmc::bytes32 value;
+                    value.bytes[31] = static_cast<uint8_t>(i + j);
+                    state->update_storage(address, kDefaultIncarnation, location, {}, value);
+                    storage_records += state == &buffer ? 1 : 0;
+                }
+            }
+            state->update_account(address, std::nullopt, account);
+        }
+    }
+    buffer.write_to_db();
+
+    BlockHeader header;
+    header.number = 1;
+    header.state_root = expected_state.state_root_hash();
+    write_header(source.txn(), header);
+    write_canonical_header(source.txn(), header);
+    stages::write_stage_progress(source.txn(), stages::kExecutionKey, 1);
+    source.commit_txn();
+
+    const TemporaryDirectory tmp_dir;
+    const auto snapshot_dir{tmp_dir.path() / "state"};
+    const auto manifest{export_state_snapshot(source.env(), snapshot_dir, /*num_threads=*/2, /*chunk_size=*/512)};
+    CHECK(manifest.block_number == 1);
+    CHECK(manifest.block_hash == header.hash());
+    CHECK(manifest.state_root == header.state_root);
+    CHECK(manifest.chunks.size() > 3);  // Small chunks
+    CHECK_THROWS_AS(export_state_snapshot(source.env(), snapshot_dir, 2), std::runtime_error);
+
+    const auto read_manifest{StateSnapshotManifest::read(snapshot_dir)};
+    REQUIRE(read_manifest.chunks.size() == manifest.chunks.size());
+    for (size_t i{0}; i < manifest.chunks.size(); ++i) {
+        CHECK(read_manifest.chunks[i].file_name == manifest.chunks[i].file_name);
+        CHECK(read_manifest.chunks[i].hash == manifest.chunks[i].hash);
+    }
+
+    test::Context target;
+    target.commit_txn();
+
+    SECTION("Import") {
+        RWTxn txn{target.env()};
+        (void)import_state_snapshot(txn, snapshot_dir, target.dir().etl().path(), /*num_threads=*/2);
+        txn.commit(/*renew=*/false);
+
+        for (const auto& config : kStateSnapshotTables) {
+            CHECK(read_records(target.env(), config) == read_records(source.env(), config));
+        }
+        CHECK(read_records(target.env(), table::kHashedAccounts).size() == 100);
+        CHECK(read_records(target.env(), table::kHashedStorage).size() == storage_records);
+        CHECK(read_records(target.env(), table::kHashedCodeHash).size() == 10);
+    }
+
+    SECTION("Corrupted chunk") {
+        std::ofstream{snapshot_dir / manifest.chunks.back().file_name, std::ios::binary | std::ios::app} << 'x';
+        RWTxn txn{target.env()};
+        CHECK_THROWS_AS(import_state_snapshot(txn, snapshot_dir, target.dir().etl().path(), 2), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::db
@@ -40,7 +40,8 @@ void check_or_create_chaindata_tables(mdbx::txn& txn) {
     auto db_schema_version{db::read_schema_version(txn)};
     if (!db_schema_version.has_value()) {
         db::write_schema_version(txn, kRequiredSchemaVersion);
-    } else if (db_schema_version.value() != kRequiredSchemaVersion) {
+    } else if (db_schema_version.value() != kRequiredSchemaVersion &&
+               db_schema_version.value() != kCompactChangeSetsSchemaVersion) {
         throw std::runtime_error("Incompatible schema version. Expected " + kRequiredSchemaVersion.to_string() +
                                  " got " + db_schema_version.value().to_string());
     }
@@ -28,6 +28,12 @@ namespace silkworm::db::table {
 
 inline constexpr VersionBase kRequiredSchemaVersion{3, 0, 0};  // We're compatible with this
 
+//! \brief Opt-in schema storing StorageChangeSet values in ChangeSetFormat::kCompact (not readable by Erigon)
+inline constexpr VersionBase kCompactChangeSetsSchemaVersion{4, 0, 0};
+
+//! \brief Key in Migration table of the migration from kRequiredSchemaVersion to kCompactChangeSetsSchemaVersion
+inline constexpr const char* kCompactChangeSetsMigration{"compact_storage_changesets"};
+
 inline constexpr const char* kLastHeaderKey{"LastHeader"};
 
 /* Canonical tables */
@@ -46,6 +52,18 @@ inline constexpr const char* kLastHeaderKey{"LastHeader"};
 inline constexpr db::MapConfig kAccountChangeSet{"AccountChangeSet", mdbx::key_mode::usual, mdbx::value_mode::multi};
 
 inline constexpr db::MapConfig kAccountHistory{"AccountHistory"};
+
+//! \details Stores the blocks changing an account above the last AccountHistory chunk, appended at the chain tip
+//! until the HistoryIndex stage folds them into chunks. Opt-in (NodeSettings::history_index_deltas) and not
+//! readable by Erigon
+//! \struct
+//! \verbatim
+//!   key   : address
+//!   value : block_num_u64 (BE)
+//! \endverbatim
+inline constexpr db::MapConfig kAccountHistoryDelta{"AccountHistoryDelta", mdbx::key_mode::usual,
+                                                    mdbx::value_mode::multi};
+
 inline constexpr db::MapConfig kBlockBodies{"BlockBody"};
 
 //! \details Stores the binding of *canonical* block number with header hash
@@ -214,10 +232,21 @@ inline constexpr db::MapConfig kStateSnapshotInfo{"StateSnapshotInfo"};
 //!   key   : block_num_u64 (BE) + address + incarnation_u64 (BE)
 //!   value : plain_storage_location (32 bytes) + X
 //! \endverbatim
+//! \remarks With kCompactChangeSetsSchemaVersion location is stored without leading zeros and prefixed by its length
+//! (see db::ChangeSetFormat)
 inline constexpr db::MapConfig kStorageChangeSet{"StorageChangeSet", mdbx::key_mode::usual, mdbx::value_mode::multi};
 
 inline constexpr db::MapConfig kStorageHistory{"StorageHistory"};
 
+//! \details Same as kAccountHistoryDelta for StorageHistory
+//! \struct
+//! \verbatim
+//!   key   : address + location (32 bytes)
+//!   value : block_num_u64 (BE)
+//! \endverbatim
+inline constexpr db::MapConfig kStorageHistoryDelta{"StorageHistoryDelta", mdbx::key_mode::usual,
+                                                    mdbx::value_mode::multi};
+
 //! \details Stores reached progress for each stage
 //! \struct
 //! \verbatim
@@ -237,6 +266,7 @@ inline constexpr db::MapConfig kTxLookup{"BlockTransactionLookup"};
 inline constexpr db::MapConfig kChainDataTables[]{
     kAccountChangeSet,
     kAccountHistory,
+    kAccountHistoryDelta,
     kBlockBodies,
     kBlockReceipts,
     kBloomBits,
@@ -272,6 +302,7 @@ inline constexpr db::MapConfig kChainDataTables[]{
     kStateSnapshotInfo,
     kStorageChangeSet,
     kStorageHistory,
+    kStorageHistoryDelta,
     kSyncStageProgress,
     kSyncStageUnwind,
     kTrieOfAccounts,
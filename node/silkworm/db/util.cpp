@@ -33,6 +33,14 @@ Bytes storage_prefix(ByteView address, uint64_t incarnation) {
     return res;
 }
 
+std::array<uint8_t, kPlainStoragePrefixLength> plain_storage_prefix(const evmc::address& address,
+                                                                    uint64_t incarnation) noexcept {
+    std::array<uint8_t, kPlainStoragePrefixLength> res;
+    std::memcpy(res.data(), address.bytes, kAddressLength);
+    endian::store_big_u64(&res[kAddressLength], incarnation);
+    return res;
+}
+
 Bytes block_key(BlockNum block_number) {
     Bytes key(8, '\0');
     endian::store_big_u64(&key[0], block_number);
@@ -76,7 +84,43 @@ Bytes log_key(BlockNum block_number, uint32_t transaction_id) {
     return key;
 }
 
-std::pair<Bytes, Bytes> changeset_to_plainstate_format(const ByteView key, ByteView value) {
+Bytes storage_change_location(const evmc::bytes32& location, ChangeSetFormat format) {
+    if (format == ChangeSetFormat::kPlain) {
+        return Bytes{location.bytes, kHashLength};
+    }
+    const ByteView zeroless{zeroless_view(ByteView{location})};
+    Bytes res(1 + zeroless.length(), '\0');
+    res[0] = static_cast<uint8_t>(zeroless.length());
+    std::memcpy(&res[1], zeroless.data(), zeroless.length());
+    return res;
+}
+
+Bytes storage_change_value(const evmc::bytes32& location, ByteView value, ChangeSetFormat format) {
+    Bytes res{storage_change_location(location, format)};
+    res.append(value);
+    return res;
+}
+
+std::pair<evmc::bytes32, ByteView> split_storage_change_value(ByteView value, ChangeSetFormat format) {
+    size_t location_length{kHashLength};
+    if (format == ChangeSetFormat::kCompact) {
+        if (value.empty() || value[0] > kHashLength) {
+            throw std::runtime_error("Invalid compact location in " + std::string(__FUNCTION__));
+        }
+        location_length = value[0];
+        value.remove_prefix(1);
+    }
+    if (value.length() < location_length) {
+        throw std::runtime_error("Invalid value length " + std::to_string(value.length()) +
+                                 " for storage changeset in " + std::string(__FUNCTION__));
+    }
+    evmc::bytes32 location{};
+    std::memcpy(&location.bytes[kHashLength - location_length], value.data(), location_length);
+    value.remove_prefix(location_length);
+    return {location, value};
+}
+
+std::pair<Bytes, Bytes> changeset_to_plainstate_format(const ByteView key, ByteView value, ChangeSetFormat format) {
     if (key.size() == 8) {
         if (value.length() < kAddressLength) {
             throw std::runtime_error("Invalid value length " + std::to_string(value.length()) +
@@ -87,17 +131,12 @@ std::pair<Bytes, Bytes> changeset_to_plainstate_format(const ByteView key, ByteV
         const Bytes previous_value{value.substr(kAddressLength)};
         return {address, previous_value};
     } else if (key.length() == 8 + kPlainStoragePrefixLength) {
-        if (value.length() < kHashLength) {
-            throw std::runtime_error("Invalid value length " + std::to_string(value.length()) +
-                                     " for storage changeset in " + std::string(__FUNCTION__));
-        }
-
         // StorageChangeSet See storage_change_key
+        const auto [location, previous_value]{split_storage_change_value(value, format)};
         Bytes full_key(kPlainStoragePrefixLength + kHashLength, '\0');
         std::memcpy(&full_key[0], &key[8], kPlainStoragePrefixLength);
-        std::memcpy(&full_key[kPlainStoragePrefixLength], &value[0], kHashLength);
-        value.remove_prefix(kHashLength);
-        return {full_key, Bytes(value)};
+        std::memcpy(&full_key[kPlainStoragePrefixLength], location.bytes, kHashLength);
+        return {full_key, Bytes(previous_value)};
     }
     throw std::runtime_error("Invalid key length " + std::to_string(key.length()) + " in " + std::string(__FUNCTION__));
 }
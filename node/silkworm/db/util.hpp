@@ -21,6 +21,7 @@ Part of the compatibility layer with the Erigon DB format;
 see its package dbutils.
 */
 
+#include <array>
 #include <compare>
 #include <span>
 #include <string>
@@ -70,6 +71,10 @@ using StorageChanges = absl::btree_map<evmc::address, absl::btree_map<uint64_t,
 // address can be either plain account address (20 bytes) or hash thereof (32 bytes)
 Bytes storage_prefix(ByteView address, uint64_t incarnation);
 
+//! \brief Same as storage_prefix for plain addresses, on the stack rather than on the heap (e.g. for lookups)
+std::array<uint8_t, kPlainStoragePrefixLength> plain_storage_prefix(const evmc::address& address,
+                                                                    uint64_t incarnation) noexcept;
+
 // Erigon EncodeBlockNumber
 Bytes block_key(BlockNum block_number);
 
@@ -87,13 +92,32 @@ Bytes storage_history_key(const evmc::address& address, const evmc::bytes32& loc
 // Erigon LogKey
 Bytes log_key(BlockNum block_number, uint32_t transaction_id);
 
+//! \brief Encodings of StorageChangeSet values
+enum class ChangeSetFormat {
+    kPlain,    // location (32 bytes) + zeroless previous value : Erigon compatible, schema 3
+    kCompact,  // zeroless location length (1 byte) + zeroless location + zeroless previous value : schema 4
+};
+
+//! \brief Returns the leading part of a StorageChangeSet value identifying location
+//! \remarks Compact locations sort in the same order as the plain ones, hence dupsort order is preserved and values
+//! can still be sought by location (see find_value_suffix)
+Bytes storage_change_location(const evmc::bytes32& location, ChangeSetFormat format);
+
+//! \brief Builds a StorageChangeSet value from a location and its zeroless previous value
+Bytes storage_change_value(const evmc::bytes32& location, ByteView value, ChangeSetFormat format);
+
+//! \brief Splits a StorageChangeSet value into location and zeroless previous value
+//! \remarks Throws std::runtime_error on malformed values
+std::pair<evmc::bytes32, ByteView> split_storage_change_value(ByteView value, ChangeSetFormat format);
+
 //! \brief Converts change set (AccountChangeSet/StorageChangeSet) entry to plain state format.
 //! \param [in] key : Change set key.
 //! \param [in] value : Change set value.
+//! \param [in] format : Encoding of StorageChangeSet values.
 //! \return Plain state key + previous value of the account or storage.
 //! \remarks For storage location is returned as the last part of the key,
 //! while technically in PlainState it's the first part of the value.
-std::pair<Bytes, Bytes> changeset_to_plainstate_format(ByteView key, ByteView value);
+std::pair<Bytes, Bytes> changeset_to_plainstate_format(ByteView key, ByteView value, ChangeSetFormat format);
 
 inline mdbx::slice to_slice(ByteView value) { return {value.data(), value.length()}; }
 
@@ -16,24 +16,32 @@ limitations under the License.
 
 #include "block_exchange.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <future>
 #include <thread>
 
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/memory_governor.hpp>
+#include <silkworm/common/stopwatch.hpp>
 #include <silkworm/downloader/internals/preverified_hashes.hpp>
 #include <silkworm/downloader/messages/inbound_message.hpp>
 #include <silkworm/downloader/messages/outbound_get_block_bodies.hpp>
 #include <silkworm/downloader/rpc/penalize_peer.hpp>
+#include <silkworm/stagedsync/stage_metrics.hpp>
 
 namespace silkworm {
 
-BlockExchange::BlockExchange(SentryClient& sentry, const Db::ReadOnlyAccess& dba, const ChainIdentity& ci)
+BlockExchange::BlockExchange(SentryClient& sentry, const Db::ReadOnlyAccess& dba, const ChainIdentity& ci,
+                             const std::filesystem::path& preverified_hashes_file)
     : db_access_{dba},
       sentry_{sentry},
       chain_identity_{ci},
-      preverified_hashes_{PreverifiedHashes::load(ci.config.chain_id)},
+      preverified_hashes_{preverified_hashes_file.empty() ? PreverifiedHashes::load(ci.config.chain_id)
+                                                          : PreverifiedHashes::load_file(preverified_hashes_file)},
       header_chain_{ci},
-      body_sequence_{dba, ci} {
+      body_sequence_{dba, ci},
+      prepare_pool_{std::max(2u, std::thread::hardware_concurrency() / 4)} {
     auto tx = db_access_.start_ro_tx();
     header_chain_.recover_initial_state(tx);
     header_chain_.set_preverified_hashes(&preverified_hashes_);
@@ -47,21 +55,45 @@ BlockExchange::~BlockExchange() {
 const ChainIdentity& BlockExchange::chain_identity() const { return chain_identity_; }
 const PreverifiedHashes& BlockExchange::preverified_hashes() const { return preverified_hashes_; }
 
-void BlockExchange::accept(std::shared_ptr<Message> message) { messages_.push(message); }
+void BlockExchange::accept(std::shared_ptr<Message> message) {
+    std::promise<std::shared_ptr<Message>> ready;
+    ready.set_value(std::move(message));
+    messages_.push(ready.get_future().share());
+}
+
+void BlockExchange::receive_message(std::shared_ptr<const sentry::InboundMessage> raw_message) {
+    // Messages get decoded and prepared in parallel while execution_loop processes them one by one in arrival order;
+    // the raw message is shared with the decoding task, that decodes directly from its payload
+    messages_.push(
+        prepare_pool_.submit([this, raw = std::move(raw_message)] { return decode_and_prepare(*raw); }).share());
+}
+
+void BlockExchange::export_metrics_to(std::string file) { metrics_file_ = std::move(file); }
 
-void BlockExchange::receive_message(const sentry::InboundMessage& raw_message) {
+std::shared_ptr<Message> BlockExchange::decode_and_prepare(const sentry::InboundMessage& raw_message) {
     try {
+        StopWatch timing{/*auto_start=*/true};
         auto message = InboundMessage::make(raw_message);
+        if (!message) return nullptr;  // ignored
 
         SILK_TRACE << "BlockExchange received message " << *message;
 
-        messages_.push(message);
+        message->prepare();
+        metrics().observe(DownloadMetrics::Histogram::DecodeUs,
+                          std::chrono::duration<double, std::micro>(timing.lap_duration()).count(),
+                          std::chrono::system_clock::now());
+        return message;
     } catch (rlp::DecodingError& error) {
         PeerId peer_id = string_from_H512(raw_message.peer_id());
         log::Warning() << "BlockExchange received and ignored a malformed message, peer= " << peer_id
                        << ", msg-id= " << raw_message.id() << "/" << sentry::MessageId_Name(raw_message.id()) << " - "
                        << error.what();
         send_penalization(peer_id, BadBlockPenalty);
+        return nullptr;
+    } catch (const std::exception& error) {
+        log::Warning() << "BlockExchange received and ignored a message, msg-id= " << raw_message.id() << " - "
+                       << error.what();
+        return nullptr;
     }
 }
 
@@ -71,24 +103,54 @@ void BlockExchange::execution_loop() {
     log::set_thread_name("block-exchange");
 
     sentry_.subscribe(SentryClient::Scope::BlockAnnouncements,
-                      [this](const sentry::InboundMessage& msg) { receive_message(msg); });
+                      [this](std::shared_ptr<const sentry::InboundMessage> msg) { receive_message(std::move(msg)); });
     sentry_.subscribe(SentryClient::Scope::BlockRequests,
-                      [this](const sentry::InboundMessage& msg) { receive_message(msg); });
+                      [this](std::shared_ptr<const sentry::InboundMessage> msg) { receive_message(std::move(msg)); });
 
     auto constexpr kShortInterval = 1000ms;
     time_point_t last_update = system_clock::now();
+    time_point_t last_sample = last_update;
+    time_point_t last_export = last_update;
 
     while (!is_stopping() && !sentry_.is_stopping()) {
+        // sample queues & export metrics, the loop wakes up at least every kShortInterval
+        auto now = system_clock::now();
+        if (now - last_sample >= kShortInterval) {
+            sample_metrics(now);
+            last_sample = now;
+        }
+        if (!metrics_file_.empty() && now - last_export >= kMetricsExportInterval) {
+            try {
+                stagedsync::write_metrics_file(metrics_file_, metrics().to_prometheus_text(now) +
+                                                                  MemoryGovernor::instance().to_prometheus_text());
+            } catch (const std::exception& e) {
+                // Not fatal: metrics are going to be written again at the next interval
+                log::Warning() << "BlockExchange unable to write metrics file " << metrics_file_ << ": " << e.what();
+            }
+            last_export = now;
+        }
+
         // pop a message from the queue
-        std::shared_ptr<Message> message;
-        bool present = messages_.timed_wait_and_pop(message, kShortInterval);
-        if (!present) continue;  // timeout, needed to check exiting_
+        std::shared_future<std::shared_ptr<Message>> pending_message;
+        bool present = header_chain_.recovering() ? messages_.try_pop(pending_message)
+                                                  : messages_.timed_wait_and_pop(pending_message, kShortInterval);
+        if (!present) {
+            if (header_chain_.recovering()) {  // idle: go on loading older headers, one batch at a time
+                auto tx = db_access_.start_ro_tx();
+                header_chain_.recover_more_links(tx, kLinksRecoveryBatch);
+            }
+            continue;  // timeout, needed to check exiting_
+        }
+
+        // wait for it to be decoded and prepared
+        std::shared_ptr<Message> message = pending_message.get();
+        if (!message) continue;  // malformed or ignored
 
         // process the message (command pattern)
         message->execute(db_access_, header_chain_, body_sequence_, sentry_);
 
         // log status
-        auto now = system_clock::now();
+        now = system_clock::now();
         if (silkworm::log::test_verbosity(silkworm::log::Level::kDebug) && now - last_update > 30s) {
             log_status();
             last_update = now;
@@ -121,6 +183,20 @@ void BlockExchange::log_status() {
                  << "; stats: " << body_sequence_.statistics();
 }
 
+void BlockExchange::sample_metrics(time_point_t tp) {
+    DownloadMetrics& metrics = this->metrics();
+    metrics.observe(DownloadMetrics::Histogram::WindowOccupancyPercent,
+                    100 * sentry_.peer_tracker().window_occupancy(tp), tp);
+    metrics.observe(DownloadMetrics::Histogram::MessageQueueDepth, static_cast<double>(messages_.size()), tp);
+    metrics.observe(DownloadMetrics::Histogram::PendingLinks, static_cast<double>(header_chain_.pending_links()), tp);
+    metrics.observe(DownloadMetrics::Histogram::OutstandingBodies,
+                    static_cast<double>(body_sequence_.outstanding_bodies(tp)), tp);
+    for (auto scope : {SentryClient::Scope::BlockAnnouncements, SentryClient::Scope::BlockRequests}) {
+        metrics.set_dispatch_stats(SentryClient::scope_name(scope), sentry_.dispatch_stats(scope));
+    }
+    MemoryGovernor::instance().set_usage(MemoryTag::kHeaderChain, header_chain_.memory_usage());
+}
+
 void BlockExchange::send_penalization(PeerId id, Penalty p) noexcept {
     rpc::PenalizePeer penalize_peer(id, p);
     penalize_peer.do_not_throw_on_failure();
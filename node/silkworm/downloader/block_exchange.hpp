@@ -19,6 +19,7 @@ limitations under the License.
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/concurrency/active_component.hpp>
 #include <silkworm/concurrency/containers.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
 #include <silkworm/downloader/internals/db_tx.hpp>
 #include <silkworm/downloader/internals/header_chain.hpp>
 #include <silkworm/downloader/internals/body_sequence.hpp>
@@ -30,7 +31,9 @@ namespace silkworm {
 //! \brief Implement the logic needed to download headers and bodies
 class BlockExchange : public ActiveComponent {
   public:
-    BlockExchange(SentryClient&, const Db::ReadOnlyAccess&, const ChainIdentity&);
+    // pre-verified hashes are read from the given binary file if any, otherwise the embedded ones are used
+    BlockExchange(SentryClient&, const Db::ReadOnlyAccess&, const ChainIdentity&,
+                  const std::filesystem::path& preverified_hashes_file = {});
     ~BlockExchange();
 
     void accept(std::shared_ptr<Message>); /*[[thread_safe]]*/
@@ -38,15 +41,23 @@ class BlockExchange : public ActiveComponent {
 
     const ChainIdentity& chain_identity() const;
     const PreverifiedHashes& preverified_hashes() const;
+
+    DownloadMetrics& metrics() { return sentry_.download_metrics(); }  /*[[thread_safe]]*/
+    void export_metrics_to(std::string file);  // Prometheus text file rewritten periodically, to set before running
   private:
-    using MessageQueue = ConcurrentQueue<std::shared_ptr<Message>>;  // used internally to store new messages
+    // used internally to store new messages, in arrival order, while they get decoded and prepared
+    using MessageQueue = ConcurrentQueue<std::shared_future<std::shared_ptr<Message>>>;
 
-    void receive_message(const sentry::InboundMessage& raw_message);
+    void receive_message(std::shared_ptr<const sentry::InboundMessage> raw_message);
+    std::shared_ptr<Message> decode_and_prepare(const sentry::InboundMessage& raw_message);  /*[[thread_safe]]*/
     void send_penalization(PeerId id, Penalty p) noexcept;
     void log_status();
+    void sample_metrics(time_point_t);  // occupancy and queue depths
 
     static constexpr seconds_t kRpcTimeout = std::chrono::seconds(1);
-    
+    static constexpr seconds_t kMetricsExportInterval = std::chrono::seconds(10);
+    static constexpr size_t kLinksRecoveryBatch = 4096;  // older persisted headers loaded at a time when idle
+
     Db::ReadOnlyAccess db_access_;
     SentryClient& sentry_;
     const ChainIdentity& chain_identity_;
@@ -54,6 +65,8 @@ class BlockExchange : public ActiveComponent {
     HeaderChain header_chain_;
     BodySequence body_sequence_;
     MessageQueue messages_{};  // thread safe queue where to receive messages from sentry
+    std::string metrics_file_;  // empty = no export
+    thread_pool prepare_pool_;  // decoding and stateless validation of inbound messages; declared last: joined first
 };
 
 }  // namespace silkworm
@@ -34,6 +34,9 @@ bool BodyPersistence::unwind_needed() const { return unwind_needed_; }
 BlockNum BodyPersistence::unwind_point() const { return unwind_point_; }
 Hash BodyPersistence::bad_block() const { return bad_block_; }
 void BodyPersistence::set_preverified_height(BlockNum height) { preverified_height_ = height; }
+void BodyPersistence::set_sender_prerecovery(stagedsync::recovery::SenderPrerecovery* prerecovery) {
+    sender_prerecovery_ = prerecovery;
+}
 
 void BodyPersistence::persist(const Block& block) {
     Hash block_hash = block.header.hash();  // save cpu
@@ -57,6 +60,9 @@ void BodyPersistence::persist(const Block& block) {
 
     if (!tx_.has_body(block_hash, block_num)) {
         tx_.write_body(block, block_hash, block_num);
+        if (sender_prerecovery_) {
+            sender_prerecovery_->submit(block, block_hash);
+        }
     }
 
     if (block_num > highest_height_) {
@@ -19,6 +19,7 @@ limitations under the License.
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/db/buffer.hpp>
 #include <silkworm/consensus/engine.hpp>
+#include <silkworm/stagedsync/stage_senders/sender_prerecovery.hpp>
 
 #include "db_tx.hpp"
 #include "types.hpp"
@@ -43,6 +44,9 @@ class BodyPersistence {
     Hash bad_block() const;
 
     void set_preverified_height(BlockNum height);
+
+    // optional: senders of persisted bodies are recovered in background, ahead of the Senders stage
+    void set_sender_prerecovery(stagedsync::recovery::SenderPrerecovery* prerecovery);
   private:
     using ConsensusEnginePtr = std::unique_ptr<consensus::IEngine>;
 
@@ -54,6 +58,7 @@ class BodyPersistence {
     BlockNum highest_height_{0};
 
     BlockNum preverified_height_{0};
+    stagedsync::recovery::SenderPrerecovery* sender_prerecovery_{nullptr};
 
     BlockNum unwind_point_{0};
     bool unwind_needed_{false};
@@ -20,19 +20,30 @@
 
 namespace silkworm {
 
-BodyRetrieval::BodyRetrieval(Db::ReadOnlyAccess db_access) : db_tx_{db_access.start_ro_tx()} {}
+BodyRetrieval::BodyRetrieval(Db::ReadOnlyAccess db_access)
+    : db_tx_{db_access.start_ro_tx()}, serving_cache_{db_access.serving_cache()} {}
 
-std::vector<BlockBody> BodyRetrieval::recover(std::vector<Hash> request) {
-    std::vector<BlockBody> response;
+std::optional<Bytes> BodyRetrieval::read_encoded_body(const Hash& hash) {
+    if (serving_cache_) {
+        if (auto encoded_body = serving_cache_->body(hash); encoded_body) return encoded_body;
+    }
+    BlockBody body;
+    if (!db_tx_.read_body(hash, body)) return std::nullopt;
+    Bytes encoded_body;
+    rlp::encode(encoded_body, body);
+    return encoded_body;
+}
+
+std::vector<Bytes> BodyRetrieval::recover(std::vector<Hash> request) {
+    std::vector<Bytes> response;
     size_t bytes = 0;
-    for (size_t i = 0; i <= request.size(); ++i) {
-        Hash& hash = request[i];
-        BlockBody body;
-        if (!db_tx_.read_body(hash, body)) {
+    for (size_t i = 0; i < request.size(); ++i) {
+        auto body = read_encoded_body(request[i]);
+        if (!body) {
             continue;
         }
-        response.push_back(body);
-        bytes += rlp::length(body);
+        bytes += body->length();
+        response.push_back(std::move(*body));
         if (bytes >= soft_response_limit || response.size() >= max_bodies_serve || i >= 2 * max_bodies_serve) {
             break;
         }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "db_tx.hpp"
+#include "serving_cache.hpp"
 #include "types.hpp"
 
 namespace silkworm {
@@ -28,10 +29,13 @@ class BodyRetrieval {
 
     explicit BodyRetrieval(Db::ReadOnlyAccess db_access);
 
-    std::vector<BlockBody> recover(std::vector<Hash>);
+    std::vector<Bytes> recover(std::vector<Hash>);  // bodies RLP encoded, from the db's ServingCache if present there
 
   protected:
+    std::optional<Bytes> read_encoded_body(const Hash&);  // from the cache first
+
     Db::ReadOnlyAccess::Tx db_tx_;
+    ServingCache* serving_cache_;  // optional
 };
 
 }  // namespace silkworm
@@ -14,7 +14,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+
 #include <silkworm/chain/difficulty.hpp>
+#include <silkworm/common/assert.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/consensus/base/engine.hpp>
 
@@ -71,17 +74,35 @@ std::list<NewBlockPacket>& BodySequence::announces_to_do() {
     return announcements_to_do_;
 }
 
-Penalty BodySequence::accept_requested_bodies(BlockBodiesPacket66& packet, const PeerId&) {
+auto BodySequence::compute_roots(const BlockBody& body) -> BodyRoots {
+    return {consensus::EngineBase::compute_ommers_hash(body), consensus::EngineBase::compute_transaction_root(body)};
+}
+
+auto BodySequence::compute_roots(const std::vector<BlockBody>& bodies) -> std::vector<BodyRoots> {
+    std::vector<BodyRoots> roots;
+    roots.reserve(bodies.size());
+    for (const auto& body : bodies) roots.push_back(compute_roots(body));
+    return roots;
+}
+
+Penalty BodySequence::accept_requested_bodies(BlockBodiesPacket66& packet, const PeerId& peer_id) {
+    return accept_requested_bodies(packet, compute_roots(packet.request), peer_id);
+}
+
+Penalty BodySequence::accept_requested_bodies(BlockBodiesPacket66& packet, const std::vector<BodyRoots>& roots,
+                                              const PeerId&) {
     Penalty penalty = NoPenalty;
 
+    SILKWORM_ASSERT(roots.size() == packet.request.size());
     statistics_.received_items += packet.request.size();
 
     // Find matching requests and completing BodyRequest
     auto matching_requests = body_requests_.find_by_request_id(packet.requestId);
 
-    for (auto& body: packet.request) {
-        Hash oh = consensus::EngineBase::compute_ommers_hash(body);
-        Hash tr = consensus::EngineBase::compute_transaction_root(body);
+    for (size_t i = 0; i < packet.request.size(); i++) {
+        BlockBody& body = packet.request[i];
+        const Hash& oh = roots[i].ommers_hash;
+        const Hash& tr = roots[i].transactions_root;
 
         auto exact_request = body_requests_.end(); // = no request
 
@@ -133,16 +154,26 @@ Penalty BodySequence::accept_requested_bodies(BlockBodiesPacket66& packet, const
     return penalty;
 }
 
-Penalty BodySequence::accept_new_block(const Block& block, const PeerId&) {
+Penalty BodySequence::accept_new_block(const Block& block, const PeerId& peer_id) {
+    return accept_new_block(block, compute_roots(block), peer_id);
+}
+
+Penalty BodySequence::accept_new_block(const Block& block, const BodyRoots& roots, const PeerId&) {
 
     // save for later usage
-    announced_blocks_.add(block);
+    announced_blocks_.add(block, roots);
 
     return Penalty::NoPenalty;
 }
 
 auto BodySequence::request_more_bodies(time_point_t tp, uint64_t active_peers)
     -> std::tuple<GetBlockBodiesPacket66, std::vector<PeerPenalization>, MinBlock> {
+    return request_more_bodies(tp, active_peers, kMaxBlocksPerMessage, kRequestDeadline);
+}
+
+auto BodySequence::request_more_bodies(time_point_t tp, uint64_t active_peers, size_t max_bodies,
+                                       milliseconds_t hedge_delay)
+    -> std::tuple<GetBlockBodiesPacket66, std::vector<PeerPenalization>, MinBlock> {
     GetBlockBodiesPacket66 packet;
     packet.requestId = RANDOM_NUMBER.generate_one();
 
@@ -153,14 +184,16 @@ auto BodySequence::request_more_bodies(time_point_t tp, uint64_t active_peers)
     if (tp - last_nack_ < kNoPeerDelay)
         return {};
 
-    auto penalizations = renew_stale_requests(packet, min_block, tp, timeout);
+    max_bodies = std::clamp<size_t>(max_bodies, 1, kMaxBlocksPerMessage);
+
+    auto penalizations = renew_stale_requests(packet, min_block, tp, timeout, hedge_delay, max_bodies);
 
     size_t stale_requests = 0; // see below
     auto outstanding_bodies = body_requests_.size() - ready_bodies_ - stale_requests;
 
-    if (packet.request.size() < kMaxBlocksPerMessage &&   // if this condition is true stale_requests == 0
+    if (packet.request.size() < max_bodies &&   // if this condition is true stale_requests == 0
         outstanding_bodies < kPerPeerMaxOutstandingRequests * active_peers * kMaxBlocksPerMessage) {
-        make_new_requests(packet, min_block, tp, timeout);
+        make_new_requests(packet, min_block, tp, timeout, max_bodies);
     }
 
     statistics_.requested_items += packet.request.size();
@@ -169,19 +202,30 @@ auto BodySequence::request_more_bodies(time_point_t tp, uint64_t active_peers)
 }
 
 //! Re-evaluate past (stale) requests
-auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block,
-                                        time_point_t tp, seconds_t timeout) -> std::vector<PeerPenalization> {
+auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block, time_point_t tp,
+                                        seconds_t timeout, milliseconds_t hedge_delay, size_t max_bodies)
+    -> std::vector<PeerPenalization> {
     std::vector<PeerPenalization> penalizations;
 
+    // the lowest pending requests hold back the withdrawal of all the ready bodies above them, so a slow peer can
+    // stall the whole window: these ones are hedged, i.e. sent again (to another peer) well before the deadline;
+    // the late response is still accepted by hash if it arrives first
+    size_t pending_position = 0;
+
     for (auto& br: body_requests_) {
         BodyRequest& past_request = br.second;
 
-        if (past_request.ready || tp - past_request.request_time < timeout)
+        if (past_request.ready)
+            continue;
+
+        const bool hedged = pending_position++ < kMaxBlocksPerMessage;
+        const milliseconds_t deadline = hedged ? std::min<milliseconds_t>(hedge_delay, timeout) : timeout;
+        if (tp - past_request.request_time < deadline)
             continue;
 
         packet.request.push_back(past_request.block_hash);
         past_request.request_time = tp;
-        past_request.request_id = packet.requestId;
+        body_requests_.assign_request_id(past_request, packet.requestId);
 
         // Erigon increment a penalization counter for the peer, but it doesn't use it
         //penalizations.emplace_back({Penalty::BadBlockPenalty, });
@@ -191,21 +235,22 @@ auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum
 
         min_block = std::max(min_block, past_request.block_height);
 
-        if (packet.request.size() >= kMaxBlocksPerMessage) break;
+        if (packet.request.size() >= max_bodies) break;
     }
 
     return penalizations;
 }
 
 //! Make requests of new bodies to get progress
-void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block, time_point_t tp, seconds_t) {
+void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block, time_point_t tp, seconds_t,
+                                     size_t max_bodies) {
     auto tx = db_access_.start_ro_tx();
 
     BlockNum last_requested_block = highest_body_in_db_;
     if (!body_requests_.empty())
         last_requested_block = body_requests_.rbegin()->second.block_height; // the last requested
 
-    while (packet.request.size() < kMaxBlocksPerMessage && last_requested_block < headers_stage_height_) {
+    while (packet.request.size() < max_bodies && last_requested_block < headers_stage_height_) {
         BlockNum bn = last_requested_block + 1;
 
         auto header = tx.read_canonical_header(bn);
@@ -217,15 +262,14 @@ void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& m
 
         BodyRequest new_request;
         new_request.block_height = bn;
-        new_request.request_id = packet.requestId;
         new_request.block_hash = header->hash();
         new_request.request_time = tp;
 
-        std::optional<BlockBody> announced_body = announced_blocks_.remove(bn);
-        if (announced_body && is_valid_body(*header, *announced_body)) {
-            add_to_announcements(*header, *announced_body, tx);
+        std::optional<AnnouncedBlocks::Body> announced = announced_blocks_.remove(bn);
+        if (announced && announced->roots.match(*header)) {
+            add_to_announcements(*header, announced->body, tx);
 
-            new_request.body = std::move(*announced_body);
+            new_request.body = std::move(announced->body);
             new_request.ready = true;
             ready_bodies_ += 1; 
         }
@@ -239,7 +283,8 @@ void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& m
 
         new_request.header = std::move(*header);
 
-        body_requests_.emplace(bn, std::move(new_request));
+        auto added = body_requests_.add(std::move(new_request));
+        body_requests_.assign_request_id(added->second, packet.requestId);
 
         ++last_requested_block;
     }
@@ -248,21 +293,16 @@ void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& m
 
 void BodySequence::request_nack(const GetBlockBodiesPacket66& packet) {
     seconds_t timeout = BodySequence::kRequestDeadline;
-    for (auto& br: body_requests_) {
-        BodyRequest& past_request = br.second;
-        if (past_request.request_id == packet.requestId)
-            past_request.request_time -= timeout;
+    for (auto& br: body_requests_.find_by_request_id(packet.requestId)) {
+        BodyRequest& past_request = br->second;
+        past_request.request_time -= timeout;
     }
     last_nack_ = std::chrono::system_clock::now();
     statistics_.requested_items -= packet.request.size();
 }
 
 bool BodySequence::is_valid_body(const BlockHeader& header, const BlockBody& body) {
-    if (header.ommers_hash != consensus::EngineBase::compute_ommers_hash(body))
-        return false;
-    if (header.transactions_root != consensus::EngineBase::compute_transaction_root(body))
-        return false;
-    return true;
+    return compute_roots(body).match(header);
 }
 
 auto BodySequence::withdraw_ready_bodies() -> std::vector<Block> {
@@ -277,7 +317,7 @@ auto BodySequence::withdraw_ready_bodies() -> std::vector<Block> {
         highest_body_in_db_ = std::max(highest_body_in_db_, past_request.block_height);
         ready_bodies.push_back({std::move(past_request.body), std::move(past_request.header)});
 
-        curr_req = body_requests_.erase(curr_req);  // erase curr_req and update curr_req to point to the next request
+        curr_req = body_requests_.remove(curr_req);  // erase curr_req and update curr_req to point to the next request
     }
     
     ready_bodies_ -= ready_bodies.size();
@@ -304,20 +344,21 @@ void BodySequence::add_to_announcements(BlockHeader header, BlockBody body, Db::
     announcements_to_do_.push_back(std::move(packet));
 }
 
-void BodySequence::AnnouncedBlocks::add(Block block) {
+void BodySequence::AnnouncedBlocks::add(Block block, const BodyRoots& roots) {
     if (blocks_.size() >= kMaxAnnouncedBlocks) {
         return;
     }
 
-    blocks_.emplace(block.header.number, std::move(block));
+    const BlockNum bn = block.header.number;
+    blocks_.emplace(bn, Body{std::move(block), roots});  // header is not needed, it comes from db
 }
 
-std::optional<BlockBody> BodySequence::AnnouncedBlocks::remove(BlockNum bn) {
+auto BodySequence::AnnouncedBlocks::remove(BlockNum bn) -> std::optional<Body> {
     auto b = blocks_.find(bn);
     if (b == blocks_.end())
         return std::nullopt;
 
-    std::optional<BlockBody> body = std::move(b->second);
+    std::optional<Body> body = std::move(b->second);
     blocks_.erase(b);
     return body;
 }
@@ -326,22 +367,71 @@ size_t BodySequence::AnnouncedBlocks::size() {
     return blocks_.size();
 }
 
+auto BodySequence::IncreasingHeightOrderedRequestContainer::add(BodyRequest request) -> Iter {
+    const BlockNum bn = request.block_height;
+    by_roots_[{request.header.ommers_hash, request.header.transactions_root}].insert(bn);
+    auto [elem, inserted] = emplace(bn, std::move(request));
+    SILKWORM_ASSERT(inserted);
+    return elem;
+}
+
+auto BodySequence::IncreasingHeightOrderedRequestContainer::remove(Iter elem) -> Iter {
+    const BlockHeader& header = elem->second.header;
+    auto roots = by_roots_.find({header.ommers_hash, header.transactions_root});
+    if (roots != by_roots_.end()) {
+        roots->second.erase(elem->first);
+        if (roots->second.empty()) by_roots_.erase(roots);
+    }
+    return erase(elem);  // by_request_id_ is not updated, its stale entries are skipped on lookup
+}
+
+void BodySequence::IncreasingHeightOrderedRequestContainer::assign_request_id(BodyRequest& request,
+                                                                              uint64_t request_id) {
+    request.request_id = request_id;
+    by_request_id_[request_id].push_back(request.block_height);
+
+    if (by_request_id_.size() > prune_threshold_) prune_request_ids();
+}
+
+void BodySequence::IncreasingHeightOrderedRequestContainer::prune_request_ids() {
+    for (auto entry = by_request_id_.begin(); entry != by_request_id_.end();) {
+        const uint64_t request_id = entry->first;
+        const bool stale = std::none_of(entry->second.begin(), entry->second.end(), [&](BlockNum bn) {
+            auto elem = find(bn);
+            return elem != end() && elem->second.request_id == request_id;
+        });
+        entry = stale ? by_request_id_.erase(entry) : std::next(entry);
+    }
+    prune_threshold_ = std::max(kMinPruneThreshold, 2 * by_request_id_.size());  // amortized over many assignments
+}
+
 auto BodySequence::IncreasingHeightOrderedRequestContainer::find_by_request_id(uint64_t request_id) -> std::list<Iter> {
     std::list<Impl::iterator> matching_requests;
-    for (auto elem = begin(); elem != end(); elem++) {
-        const BodyRequest& request = elem->second;
-        if (request.request_id == request_id) matching_requests.push_back(elem);
+    auto entry = by_request_id_.find(request_id);
+    if (entry == by_request_id_.end()) return matching_requests;
+
+    for (BlockNum bn : entry->second) {
+        auto elem = find(bn);
+        // skip requests already withdrawn or re-assigned to another request id
+        if (elem != end() && elem->second.request_id == request_id) matching_requests.push_back(elem);
     }
     return matching_requests;
 }
 
-auto BodySequence::IncreasingHeightOrderedRequestContainer::find_by_hash(Hash oh, Hash tr) -> Iter {
-    auto r = std::find_if(begin(), end(), [&oh, &tr](const auto& elem) {
-        const BodyRequest& request = elem.second;
-        return (request.header.ommers_hash == oh && request.header.transactions_root == tr);
-    });
-
-    return r;
+auto BodySequence::IncreasingHeightOrderedRequestContainer::find_by_hash(const Hash& oh, const Hash& tr) -> Iter {
+    auto roots = by_roots_.find({oh, tr});
+    if (roots == by_roots_.end()) return end();
+
+    // a late response can complete any pending request with the same roots (e.g. empty bodies), preferring the
+    // lowest one as it holds back the withdrawal; if none is pending the lowest one is reported as duplicated
+    Iter lowest = end();
+    for (BlockNum bn : roots->second) {
+        auto elem = find(bn);
+        if (elem == end()) continue;
+        if (!elem->second.ready) return elem;
+        if (lowest == end()) lowest = elem;
+    }
+    return lowest;
 }
 
 BlockNum BodySequence::IncreasingHeightOrderedRequestContainer::lowest_block() const {
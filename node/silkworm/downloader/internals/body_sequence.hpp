@@ -17,6 +17,9 @@ limitations under the License.
 #pragma once
 
 #include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
 
 #include <silkworm/chain/identity.hpp>
 
@@ -48,15 +51,37 @@ class BodySequence {
     using MinBlock = BlockNum;
     auto request_more_bodies(time_point_t tp, uint64_t active_peers)
         -> std::tuple<GetBlockBodiesPacket66, std::vector<PeerPenalization>, MinBlock>;
+    //! same as above with hints from peer statistics (see PeerTracker): max_bodies limits the size of the request and
+    //! the lowest pending requests, that hold back all the others, are renewed (hedged) after hedge_delay
+    auto request_more_bodies(time_point_t tp, uint64_t active_peers, size_t max_bodies, milliseconds_t hedge_delay)
+        -> std::tuple<GetBlockBodiesPacket66, std::vector<PeerPenalization>, MinBlock>;
 
     //! it needs to know if the request issued was not delivered
     void request_nack(const GetBlockBodiesPacket66&);
 
+    //! roots identifying a body, i.e. the ones its header must have
+    struct BodyRoots {
+        Hash ommers_hash;
+        Hash transactions_root;
+
+        [[nodiscard]] bool match(const BlockHeader& header) const {
+            return header.ommers_hash == ommers_hash && header.transactions_root == transactions_root;
+        }
+    };
+
+    //! computing roots is the expensive part of body validation: being thread safe, it can be done in advance
+    static BodyRoots compute_roots(const BlockBody&);
+    static std::vector<BodyRoots> compute_roots(const std::vector<BlockBody>&);
+
     //! core functionalities: process received bodies
     Penalty accept_requested_bodies(BlockBodiesPacket66&, const PeerId&);
+    //! same as above with roots of the bodies computed in advance (see compute_roots)
+    Penalty accept_requested_bodies(BlockBodiesPacket66&, const std::vector<BodyRoots>&, const PeerId&);
 
     //! core functionalities: process received block announcement
     Penalty accept_new_block(const Block&, const PeerId&);
+    //! same as above with roots of the body computed in advance (see compute_roots)
+    Penalty accept_new_block(const Block&, const BodyRoots&, const PeerId&);
 
     //! core functionalities: returns bodies that are ready to be persisted
     auto withdraw_ready_bodies() -> std::vector<Block>;
@@ -83,9 +108,9 @@ class BodySequence {
 
   protected:
     void recover_initial_state();
-    void make_new_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t tp, seconds_t timeout);
-    auto renew_stale_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t tp, seconds_t timeout)
-        -> std::vector<PeerPenalization>;
+    void make_new_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t tp, seconds_t timeout, size_t max_bodies);
+    auto renew_stale_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t tp, seconds_t timeout,
+                              milliseconds_t hedge_delay, size_t max_bodies) -> std::vector<PeerPenalization>;
     void add_to_announcements(BlockHeader, BlockBody, Db::ReadOnlyAccess::Tx&);
 
     static bool is_valid_body(const BlockHeader&, const BlockBody&);
@@ -101,23 +126,43 @@ class BodySequence {
     };
 
     struct AnnouncedBlocks {
-        void add(Block block);
-        std::optional<BlockBody> remove(BlockNum bn);
+        struct Body {
+            BlockBody body;
+            BodyRoots roots;
+        };
+        void add(Block block, const BodyRoots& roots);
+        std::optional<Body> remove(BlockNum bn);
         size_t size();
       private:
-        std::map<BlockNum, Block> blocks_;
+        std::map<BlockNum, Body> blocks_;
     };
 
     //using IncreasingHeightOrderedMap = std::map<BlockNum, BodyRequest>; // default ordering: less<BlockNum>
+    //! requests are indexed by request id and by body roots so that responses, that can arrive in any order, are
+    //! matched without scanning the whole window; insertions, removals and request id changes must go through add(),
+    //! remove() and assign_request_id() to keep the indexes up to date
     struct IncreasingHeightOrderedRequestContainer: public std::map<BlockNum, BodyRequest> {
         using Impl = std::map<BlockNum, BodyRequest>;
         using Iter = Impl::iterator;
 
+        Iter add(BodyRequest);
+        Iter remove(Iter);
+        void assign_request_id(BodyRequest&, uint64_t request_id);
+
         std::list<Iter> find_by_request_id(uint64_t request_id);
-        Iter find_by_hash(Hash oh, Hash tr);
+        Iter find_by_hash(const Hash& oh, const Hash& tr);  // the lowest pending request, if any, else the lowest one
 
         [[nodiscard]] BlockNum lowest_block() const;
         [[nodiscard]] BlockNum highest_block() const;
+
+      private:
+        void prune_request_ids();
+
+        using Roots = std::pair<Hash, Hash>;  // ommers hash, transactions root; many empty bodies share the same
+        std::map<Roots, std::set<BlockNum>> by_roots_;
+        std::unordered_map<uint64_t, std::vector<BlockNum>> by_request_id_;  // stale entries are skipped on lookup
+        static constexpr size_t kMinPruneThreshold{64};
+        size_t prune_threshold_{kMinPruneThreshold};  // by_request_id_ size that triggers prune_request_ids()
     };
 
     IncreasingHeightOrderedRequestContainer body_requests_;
@@ -164,6 +164,27 @@ TEST_CASE("body downloading", "[silkworm][downloader][BodySequence]") {
         REQUIRE(statistic.rejected_items() == 0);
     }
 
+    SECTION("should accept block 1 with roots computed in advance") {
+        auto [packet, penalizations, min_block] = bs.request_more_bodies(tp, active_peers);
+        REQUIRE(!packet.request.empty());
+
+        // roots computed elsewhere (e.g. on another thread)
+        auto roots = BodySequence::compute_roots(block1);
+        REQUIRE(roots.match(header1));
+
+        PeerId peer_id{"1"};
+        BlockBodiesPacket66 response_packet;
+        response_packet.requestId = packet.requestId;
+        response_packet.request.push_back(block1);
+
+        auto penalty = bs.accept_requested_bodies(response_packet, {roots}, peer_id);
+
+        REQUIRE(penalty == NoPenalty);
+        REQUIRE(bs.body_requests_[1].ready);
+        REQUIRE(bs.body_requests_[1].body == block1);
+        REQUIRE(bs.statistics().accepted_items == 1);
+    }
+
     SECTION("should renew the request of block 1") {
         // requesting
         auto [packet1, penalizations1, min_block1] = bs.request_more_bodies(tp, active_peers);
@@ -390,6 +411,38 @@ TEST_CASE("body downloading", "[silkworm][downloader][BodySequence]") {
         REQUIRE(bs.body_requests_.size() == 1);
     }
 
+    SECTION("should hedge the lowest pending request after hedge delay") {
+        using namespace std::chrono_literals;
+        milliseconds_t hedge_delay = 2s;
+        size_t max_bodies = BodySequence::kMaxBlocksPerMessage;
+
+        auto [packet1, penalizations1, min_block1] = bs.request_more_bodies(tp, active_peers, max_bodies, hedge_delay);
+        REQUIRE(packet1.request.size() == 1);
+
+        // before hedge delay
+        tp += 1s;
+        auto [packet2, penalizations2, min_block2] = bs.request_more_bodies(tp, active_peers, max_bodies, hedge_delay);
+        REQUIRE(packet2.request.empty());
+
+        // still far from the deadline, but past hedge delay
+        tp += 2s;
+        auto [packet3, penalizations3, min_block3] = bs.request_more_bodies(tp, active_peers, max_bodies, hedge_delay);
+        REQUIRE(packet3.request.size() == 1);
+        REQUIRE(packet3.request[0] == header1_hash);
+        REQUIRE(min_block3 == 1);
+
+        BodySequence_ForTest::BodyRequest& request_status = bs.body_requests_[1];
+        REQUIRE(request_status.request_time == tp);
+        REQUIRE(request_status.request_id == packet3.requestId);
+
+        // the response to the first request is still accepted
+        BlockBodiesPacket66 response_packet;
+        response_packet.requestId = packet1.requestId;
+        response_packet.request.push_back(block1);
+        bs.accept_requested_bodies(response_packet, "peer-id");
+        REQUIRE(request_status.ready);
+    }
+
     SECTION("should not renew recent requests but make new requests") {
         // requesting
         auto [packet1, penalizations1, min_block1] = bs.request_more_bodies(tp, active_peers);
@@ -429,6 +482,46 @@ TEST_CASE("body downloading", "[silkworm][downloader][BodySequence]") {
         REQUIRE(statistic.rejected_items() == 0);
     }
 
+    SECTION("late responses complete the lowest pending requests with the same roots") {
+        // block 2 has an empty body as block 1
+        BlockHeader header2;
+        header2.number = 2;
+        header2.parent_hash = header1_hash;
+        header2.ommers_hash = header1.ommers_hash;
+        header2.transactions_root = header1.transactions_root;
+        auto txn2 = context.env().start_write();
+        db::write_canonical_header_hash(txn2, header2.hash().bytes, 2);
+        db::write_canonical_header(txn2, header2);
+        db::write_header(txn2, header2, true);
+        txn2.commit();
+        bs.sync_current_state(highest_body, 2);
+
+        auto [packet, penalizations, min_block] = bs.request_more_bodies(tp, active_peers);
+        REQUIRE(packet.request.size() == 2);
+
+        PeerId peer_id{"1"};
+        BlockBodiesPacket66 response_packet;
+        response_packet.requestId = packet.requestId - 1;  // simulate responses to past requests
+        response_packet.request.push_back(block1);
+
+        bs.accept_requested_bodies(response_packet, peer_id);
+        REQUIRE(bs.body_requests_[1].ready);
+        REQUIRE(!bs.body_requests_[2].ready);
+
+        bs.accept_requested_bodies(response_packet, peer_id);
+        REQUIRE(bs.body_requests_[2].ready);
+        REQUIRE(bs.statistics().accepted_items == 2);
+
+        auto ready_blocks = bs.withdraw_ready_bodies();
+        REQUIRE(ready_blocks.size() == 2);
+        REQUIRE(bs.body_requests_.empty());
+        REQUIRE(bs.highest_block_in_db() == 2);
+
+        // once withdrawn, bodies are no longer matched
+        bs.accept_requested_bodies(response_packet, peer_id);
+        REQUIRE(bs.statistics().reject_causes.not_requested == 1);
+    }
+
     SECTION("accepting and using an announced block") {
         // initial status
         auto& announcements_to_do = bs.announces_to_do();
@@ -17,13 +17,18 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <queue>
 #include <set>
 #include <span>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
+#include <silkworm/common/cast.hpp>
+
 #include "db_tx.hpp"
+#include "header_scratch.hpp"
 #include "priority_queue.hpp"
 #include "types.hpp"
 
@@ -32,24 +37,51 @@ namespace silkworm {
 // Auxiliary types needed to implement WorkingChain
 
 // A link corresponds to a block header, links are connected to each other by reverse of parentHash relation
+// The header is kept RLP encoded, possibly in a scratch area (see HeaderScratch), and decoded when needed: chain
+// building only needs the fields repeated here, verification and persistence happen once per header
 struct Link {
-    std::shared_ptr<BlockHeader> header;      // Header to which this link point to
-    BlockNum blockHeight = 0;                 // Block height of the header, repeated here for convenience (remove?)
+    BlockNum blockHeight = 0;                 // Block height of the header
     Hash hash;                                // Hash of the header
+    Hash parentHash;                          // Parent hash of the header
+    intx::uint256 difficulty;                 // Difficulty of the header
     std::vector<std::shared_ptr<Link>> next;  // Reverse of parentHash,allows iter.over links in asc. block height order
     bool persisted = false;                   // Whether this link comes from the database record
     bool preverified = false;                 // Ancestor of pre-verified header
+    std::optional<bool> valid_seal;           // Outcome of the seal check, if done in advance (see verify_seals())
+    HeaderScratch::Record encoded_header;     // RLP of the header to which this link point to
+    size_t queue_index = kNotQueued;          // Position in the OldestFirstLinkQueue holding it (if any)
+
+    Link(const BlockHeader& h, bool persisted_, HeaderScratch* scratch = nullptr) {
+        Bytes rlp;
+        rlp::encode(rlp, h);
+        blockHeight = h.number;
+        hash = bit_cast<evmc_bytes32>(keccak256(rlp));  // avoid h.hash() re-do rlp encoding
+        parentHash = h.parent_hash;
+        difficulty = h.difficulty;
+        encoded_header = scratch ? scratch->store(rlp) : HeaderScratch::Record{std::move(rlp)};
+        persisted = persisted_;
+    }
 
-    Link(BlockHeader h, bool persisted_) {
+    // from a header read from db, whose rlp and hash are known: no need to encode and hash it again
+    Link(const BlockHeader& h, const Hash& hash_, ByteView rlp, bool persisted_, HeaderScratch* scratch = nullptr) {
         blockHeight = h.number;
-        hash = h.hash();  // save computation
-        header = std::make_shared<BlockHeader>(std::move(h));
+        hash = hash_;
+        parentHash = h.parent_hash;
+        difficulty = h.difficulty;
+        encoded_header = scratch ? scratch->store(rlp) : HeaderScratch::Record{Bytes{rlp}};
         persisted = persisted_;
     }
 
+    [[nodiscard]] std::shared_ptr<BlockHeader> header() const {
+        auto header = std::make_shared<BlockHeader>();
+        ByteView rlp = encoded_header.view();
+        rlp::success_or_throw(rlp::decode(rlp, *header));
+        return header;
+    }
+
     void remove_child(const Link& child) {
         auto to_remove =
-                std::remove_if(next.begin(), next.end(), [child](auto& link) { return (link->hash == child.hash); });
+                std::remove_if(next.begin(), next.end(), [&child](auto& link) { return (link->hash == child.hash); });
         next.erase(to_remove, next.end());
     }
 
@@ -70,6 +102,7 @@ struct Anchor {
     std::vector<std::shared_ptr<Link>> links;  // Links attached immediately to this anchor
     BlockNum lastLinkHeight; // the blockHeight of the last link of the chain bundle anchored to this
     PeerId peerId;
+    size_t queue_index = kNotQueued;  // Position in the OldestFirstAnchorQueue holding it (if any)
 
     Anchor(const BlockHeader& header, PeerId p) {
         parentHash = header.parent_hash;
@@ -83,7 +116,7 @@ struct Anchor {
 
     void remove_child(const Link& child) {
         auto to_remove =
-                std::remove_if(links.begin(), links.end(), [child](auto& link) { return (link->hash == child.hash); });
+                std::remove_if(links.begin(), links.end(), [&child](auto& link) { return (link->hash == child.hash); });
         links.erase(to_remove, links.end());
     }
 
@@ -132,6 +165,14 @@ struct AnchorYoungerThan : public std::function<bool(std::shared_ptr<Link>, std:
     }
 };
 
+struct AnchorOlderThan : public std::function<bool(std::shared_ptr<Anchor>, std::shared_ptr<Anchor>)> {
+    bool operator()(const std::shared_ptr<Anchor>& x, const std::shared_ptr<Anchor>& y) const {
+        return x->timestamp != y->timestamp ?
+               x->timestamp < y->timestamp :      // prefer smaller timestamp
+               x->blockHeight < y->blockHeight;   // when timestamps are the same prioritise low blockHeight
+    }
+};
+
 struct BlockOlderThan : public std::function<bool(BlockNum, BlockNum)> {
     bool operator()(const BlockNum& x, const BlockNum& y) const { return x < y; }
 };
@@ -158,7 +199,8 @@ namespace silkworm { // reopen namespace
 
 using OldestFirstLinkMap = map_based_priority_queue<std::shared_ptr<Link>, BlockOlderThan>;
 
-using OldestFirstLinkQueue = set_based_priority_queue<std::shared_ptr<Link>, LinkOlderThan>;
+// Links and anchors are erased and re-positioned one by one: they track their position in the heap (queue_index)
+using OldestFirstLinkQueue = indexed_priority_queue<std::shared_ptr<Link>, LinkOlderThan>;
 
 // We need a queue for all links to
 // - store the links
@@ -168,14 +210,11 @@ using YoungestFirstLinkQueue = set_based_priority_queue<std::shared_ptr<Link>,
 
 // We need a queue for anchors to get anchors in reverse order respect to timestamp
 // (that is the time at which we asked peers for ancestor of the anchor)
-using OldestFirstAnchorQueue = heap_based_priority_queue<std::shared_ptr<Anchor>,
-        std::vector<std::shared_ptr<Anchor>>,  // inner impl
-        AnchorYoungerThan>;  // c++ heap is a max heap
-// (note that go heap is a min heap)
+using OldestFirstAnchorQueue = indexed_priority_queue<std::shared_ptr<Anchor>, AnchorOlderThan>;
 
 // Maps
-using LinkMap = std::map<Hash, std::shared_ptr<Link>>;      // hash = link hash
-using AnchorMap = std::map<Hash, std::shared_ptr<Anchor>>;  // hash = anchor *parent* hash
+using LinkMap = std::unordered_map<Hash, std::shared_ptr<Link>>;  // hash = link hash
+using AnchorMap = std::map<Hash, std::shared_ptr<Anchor>>;        // hash = anchor *parent* hash
 
 /* todo: improve encapsulation
  * AnchorMap key is the anchor parent hash, note 'parent', so it is better to encapsulate this knowledge in a class
@@ -208,19 +247,31 @@ struct HeaderList : std::enable_shared_from_this<HeaderList> {
   public:
     using Header_Ref = std::vector<BlockHeader>::const_iterator;
 
-    static std::shared_ptr<HeaderList> make(const std::vector<BlockHeader>& headers) {
-        return std::shared_ptr<HeaderList>(new HeaderList(headers));
+    // hashes of headers are computed here unless provided (e.g. computed on another thread, see compute_hashes)
+    static std::shared_ptr<HeaderList> make(const std::vector<BlockHeader>& headers, std::vector<Hash> hashes = {}) {
+        return std::shared_ptr<HeaderList>(new HeaderList(headers, std::move(hashes)));
+    }
+
+    static std::vector<Hash> compute_hashes(const std::vector<BlockHeader>& headers) {
+        std::vector<Hash> hashes;
+        hashes.reserve(headers.size());
+        for (const auto& header : headers) hashes.emplace_back(header.hash());
+        return hashes;
     }
 
     auto split_into_segments() -> std::tuple<std::vector<Segment>, Penalty>;  // the core functionality of HeaderList
 
     std::vector<BlockHeader>& headers() { return headers_; }
 
+    const Hash& hash_of(Header_Ref header) const { return hashes_[static_cast<size_t>(header - headers_.begin())]; }
+
   private:
-    HeaderList(std::vector<BlockHeader> headers)
-            : headers_(std::move(headers)) {}  // private, it needs to stay in the heap,
-    // use make method to get an instance
+    HeaderList(std::vector<BlockHeader> headers, std::vector<Hash> hashes)
+            : headers_(std::move(headers)), hashes_(std::move(hashes)) {  // private, it needs to stay in the heap,
+        if (hashes_.size() != headers_.size()) hashes_ = compute_hashes(headers_);  // use make to get an instance
+    }
     std::vector<BlockHeader> headers_;
+    std::vector<Hash> hashes_;  // hashes_[i] is the hash of headers_[i]
 
     std::vector<Header_Ref> to_ref();
 
@@ -243,6 +294,8 @@ struct Segment
 
     [[nodiscard]] HeaderList::Header_Ref lowest_header() const { return back(); }
 
+    [[nodiscard]] const Hash& hash(size_t i) const { return line_->hash_of((*this)[i]); }  // no re-computation
+
     using Slice = std::span<const HeaderList::Header_Ref>;  // a Segment slice
 
     [[nodiscard]] Slice slice(size_t start, size_t end) const {
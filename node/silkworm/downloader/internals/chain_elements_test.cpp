@@ -40,9 +40,11 @@ TEST_CASE("links") {
     auto link3 = std::make_shared<Link>(headers[3], persisted);
 
     SECTION("construction") {
-        REQUIRE(*(link1.header) == headers[1]);
+        REQUIRE(*(link1.header()) == headers[1]);
         REQUIRE(link1.blockHeight == headers[1].number);
         REQUIRE(link1.hash == headers[1].hash());
+        REQUIRE(link1.parentHash == headers[1].parent_hash);
+        REQUIRE(link1.difficulty == headers[1].difficulty);
         REQUIRE(link1.persisted == persisted);
         REQUIRE(link1.preverified == false);
         REQUIRE(link1.next.empty());
@@ -15,6 +15,8 @@
 */
 
 #include <algorithm>
+#include <atomic>
+#include <set>
 
 #include <catch2/catch.hpp>
 
@@ -42,11 +44,18 @@ class DummyConsensusEngine : public consensus::IEngine {
 
     ValidationResult validate_ommers(const Block&, const BlockState&) override { return ValidationResult::kOk; }
 
-    ValidationResult validate_block_header(const BlockHeader&, const BlockState&, bool) override {
-        return ValidationResult::kOk;
+    ValidationResult validate_block_header(const BlockHeader& header, const BlockState&, bool,
+                                           bool with_seal_check) override {
+        return with_seal_check ? validate_seal(header) : ValidationResult::kOk;
     }
 
-    ValidationResult validate_seal(const BlockHeader&) override { return ValidationResult::kOk; }
+    ValidationResult validate_seal(const BlockHeader& header) override {
+        ++seal_checks;
+        return invalid_seals.contains(header.hash()) ? ValidationResult::kInvalidSeal : ValidationResult::kOk;
+    }
+
+    std::set<Hash> invalid_seals;  // not to be changed while checks are running
+    std::atomic<size_t> seal_checks{0};
 
     evmc::address get_beneficiary(const BlockHeader&) override { return {}; }
 };
@@ -490,6 +499,46 @@ TEST_CASE("working/persistent-chain integration test") {
         REQUIRE(tx.read_canonical_hash(2) == header2_hash);
     }
 
+    /* status:
+     *         h0 (persisted)
+     * input:
+     *        (h0) <----- h1 <----- h2 (invalid seal) <----- h3
+     */
+    SECTION("a header with an invalid seal") {
+        Db::ReadWriteAccess::Tx tx(txn);  // sub transaction
+
+        auto header0 = tx.read_canonical_header(0);
+        BlockNum highest_in_db = 0;
+
+        std::vector<BlockHeader> headers(3);
+        Hash parent_hash = header0->hash();
+        for (size_t i = 0; i < headers.size(); i++) {
+            headers[i].number = i + 1;
+            headers[i].difficulty = 1'000'000;
+            headers[i].parent_hash = parent_hash;
+            parent_hash = headers[i].hash();
+        }
+
+        auto engine = std::make_unique<DummyConsensusEngine>();
+        engine->invalid_seals.insert(headers[1].hash());
+        auto& seal_checks = engine->seal_checks;
+
+        HeaderChain_ForTest wc(std::move(engine));
+        wc.recover_initial_state(tx);
+        wc.sync_current_state(highest_in_db);
+        auto request_id = wc.generate_request_id();
+
+        PeerId peer_id = "1";
+        wc.accept_headers(headers, request_id, peer_id);
+
+        Headers headers_to_persist = wc.withdraw_stable_headers();
+
+        REQUIRE(headers_to_persist.size() == 1);  // h2 is skipped and so h3 that cannot connect anymore
+        REQUIRE(*headers_to_persist[0] == headers[0]);
+        REQUIRE(wc.highest_block_in_db() == 1);
+        REQUIRE(seal_checks.load() == headers.size());  // checked all together in advance, no more by verify()
+    }
+
     /* status:
      *        h0
      * input:
@@ -512,4 +561,47 @@ TEST_CASE("working/persistent-chain integration test") {
     //  }
 }
 
+TEST_CASE("lazy recovery of persisted headers") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    // a chain of headers in db, and a fork at the lowest block number of the headers loaded at startup
+    constexpr BlockNum kHeaders{2'000};
+    std::vector<Hash> hashes;
+    Hash parent_hash;
+    for (BlockNum number{0}; number < kHeaders; ++number) {
+        BlockHeader header;
+        header.number = number;
+        header.parent_hash = parent_hash;
+        header.difficulty = 1'000;
+        db::write_header(txn, header);
+        parent_hash = header.hash();
+        hashes.push_back(parent_hash);
+    }
+    BlockHeader fork;
+    fork.number = kHeaders - 1'024;
+    fork.parent_hash = hashes[fork.number - 1];
+    fork.difficulty = 2'000;
+    db::write_header(txn, fork);
+
+    Db::ReadWriteAccess::Tx tx(txn);
+    std::vector<BlockNum> numbers;
+    tx.read_headers_in_reverse_order(kHeaders - 2, 2, [&](const Hash& hash, ByteView, BlockHeader&& header) {
+        CHECK(hash == header.hash());
+        numbers.push_back(header.number);
+    });
+    CHECK(numbers == std::vector<BlockNum>{kHeaders - 3, kHeaders - 4});
+
+    HeaderChain_ForTest wc(std::make_unique<DummyConsensusEngine>());
+    wc.recover_initial_state(tx);
+    CHECK(wc.recovering());
+    CHECK(wc.has_link(hashes.back()));
+    CHECK(wc.has_link(fork.hash()));  // block numbers are loaded as a whole
+    CHECK_FALSE(wc.has_link(hashes.front()));
+
+    wc.recover_more_links(tx, 4096);
+    CHECK_FALSE(wc.recovering());
+    CHECK(wc.has_link(hashes.front()));
+}
+
 }  // namespace silkworm
@@ -16,17 +16,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/cast.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/header_cache.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/tables.hpp>
 #include <silkworm/db/util.hpp>
 
+#include "serving_cache.hpp"
 #include "types.hpp"
 
 using namespace silkworm;
@@ -51,8 +56,16 @@ class Db {
 
     Db(mdbx::env_managed&& env) : env_{std::move(env)} {}  // low level construction, more silkworm friendly
 
+    // Keep all the canonical hashes in memory, see db::HeaderCache::load_all_canonical_hashes
+    void load_all_canonical_hashes() {
+        auto txn = env_.start_read();
+        header_cache_.load_all_canonical_hashes(txn);
+    }
+
   private:
     mdbx::env_managed env_;
+    db::HeaderCache header_cache_;  // Shared by all transactions started through this db
+    ServingCache serving_cache_;    // Filled by the transactions writing headers and bodies, read to serve peers
 };
 
 // A read-only access to database - used to enforce in some method signatures the type of access
@@ -60,12 +73,15 @@ class Db::ReadOnlyAccess {
   public:
     class Tx;
 
-    ReadOnlyAccess(Db& db) : env_{db.env_} {}
-    ReadOnlyAccess(mdbx::env& env) : env_{env} {}  // low level construction, more silkworm friendly
-    ReadOnlyAccess(const ReadOnlyAccess& copy) : env_{copy.env_} {}
+    ReadOnlyAccess(Db& db) : env_{db.env_}, header_cache_{&db.header_cache_}, serving_cache_{&db.serving_cache_} {}
+    ReadOnlyAccess(mdbx::env& env) : env_{env} {}  // low level construction, more silkworm friendly, no cache
+    ReadOnlyAccess(const ReadOnlyAccess& copy)
+        : env_{copy.env_}, header_cache_{copy.header_cache_}, serving_cache_{copy.serving_cache_} {}
 
     Tx start_ro_tx();
 
+    ServingCache* serving_cache() const { return serving_cache_; }  // optional
+
   protected:
     // auto start_read() {return env_.start_read();}
     // auto start_write() {return env_.start_write();}
@@ -73,6 +89,8 @@ class Db::ReadOnlyAccess {
     // auto commit(mdbx::txn_managed& txn) {return txn.commit();};
 
     mdbx::env& env_;
+    db::HeaderCache* header_cache_{nullptr};
+    ServingCache* serving_cache_{nullptr};
 };
 
 // A read-write access to database - used to enforce in some method signatures the type of access
@@ -92,15 +110,21 @@ class Db::ReadWriteAccess : public Db::ReadOnlyAccess {
 class Db::ReadOnlyAccess::Tx {
   protected:
     mdbx::txn_managed txn;
+    db::HeaderCache* header_cache{nullptr};    // Optional, shared with other txs of the same db
+    ServingCache* serving_cache{nullptr};      // Optional, as above, maintained by writes
 
-    Tx(mdbx::txn_managed&& source) : txn{std::move(source)} {}
+    Tx(mdbx::txn_managed&& source, db::HeaderCache* cache, ServingCache* serving = nullptr)
+        : txn{std::move(source)}, header_cache{cache}, serving_cache{serving} {}
 
   public:
-    Tx(Db::ReadOnlyAccess& access) : Tx{access.env_.start_read()} {}
-    Tx(const Tx&) = delete;                                   // not copyable
-    Tx(Tx&& source) noexcept : txn(std::move(source.txn)) {}  // only movable
-    Tx(mdbx::txn& source) : txn{source.start_nested()} {}     // to be more silkworm friendly
-    ~Tx() {}                                                  // destroying txn cause abort if not done
+    Tx(Db::ReadOnlyAccess& access) : Tx{access.env_.start_read(), access.header_cache_} {}
+    Tx(const Tx&) = delete;  // not copyable
+    Tx(Tx&& source) noexcept  // only movable
+        : txn(std::move(source.txn)),
+          header_cache{std::exchange(source.header_cache, nullptr)},
+          serving_cache{std::exchange(source.serving_cache, nullptr)} {}
+    Tx(mdbx::txn& source) : txn{source.start_nested()} {}  // to be more silkworm friendly
+    ~Tx() {}                                               // destroying txn cause abort if not done
 
     void close() { txn.abort(); }  // a more friendly name for a read-only tx
     void abort() { txn.abort(); }
@@ -108,7 +132,12 @@ class Db::ReadOnlyAccess::Tx {
 
     mdbx::txn_managed& raw() { return txn; }  // for compatibility reason with other modules
 
-    std::optional<Hash> read_canonical_hash(BlockNum b) {  // throws db exceptions // todo: add to db::access_layer.hpp?
+    std::optional<Hash> read_canonical_hash(BlockNum b) {  // throws db exceptions
+        if (header_cache) {
+            auto hash{header_cache->read_canonical_header_hash(txn, b)};
+            if (!hash) return std::nullopt;
+            return Hash(ByteView{hash->bytes, kHashLength});
+        }
         auto hashes_table = db::open_cursor(txn, db::table::kCanonicalHashes);
         // accessing this table with only b we will get the hash of the canonical block at height b
         auto key = db::block_key(b);
@@ -132,7 +161,9 @@ class Db::ReadOnlyAccess::Tx {
         return Hash(ret.value());
     }
 
-    std::optional<BlockHeader> read_header(BlockNum b, Hash h) { return db::read_header(txn, b, h.bytes); }
+    std::optional<BlockHeader> read_header(BlockNum b, Hash h) {
+        return header_cache ? header_cache->read_header(txn, b, h.bytes) : db::read_header(txn, b, h.bytes);
+    }
 
     std::optional<BlockHeader> read_canonical_header(BlockNum b) {  // also known as read-header-by-number
         std::optional<Hash> h = read_canonical_hash(b);
@@ -194,6 +225,36 @@ class Db::ReadOnlyAccess::Tx {
         }
     }
 
+    // Reads headers with block number lower than below in reverse order, along with their hash and rlp, at least limit
+    // of them (unless the table ends) and all those of the last block number read, so that it can be the next below
+    void read_headers_in_reverse_order(BlockNum below, size_t limit,
+                                       std::function<void(const Hash&, ByteView, BlockHeader&&)> callback) {
+        auto header_table = db::open_cursor(txn, db::table::kHeaders);
+
+        bool throw_notfound = false;
+        Bytes below_key = db::block_key(below);
+        auto data = header_table.lower_bound(db::to_slice(below_key), throw_notfound);
+        data = data ? header_table.to_previous(throw_notfound) : header_table.to_last(throw_notfound);
+        size_t read = 0;
+        BlockNum last_number = below;
+        while (data) {
+            ByteView key = db::from_slice(data.key);
+            BlockNum number = endian::load_big_u64(key.data());
+            if (read >= limit && number != last_number) break;
+            // read header
+            BlockHeader header;
+            ByteView rlp = db::from_slice(data.value);
+            ByteView data_view = rlp;
+            rlp::success_or_throw(rlp::decode(data_view, header));
+            read++;
+            last_number = number;
+            // consume header
+            callback(Hash{key.substr(sizeof(BlockNum))}, rlp, std::move(header));
+            // move backward
+            data = header_table.to_previous(throw_notfound);
+        }
+    }
+
     [[nodiscard]] bool has_body(const Hash& h, BlockNum bn) { return db::has_body(txn, bn, h.bytes); }
 
     [[nodiscard]] bool read_body(const Hash& h, BlockNum bn, BlockBody& body) {
@@ -209,7 +270,8 @@ class Db::ReadOnlyAccess::Tx {
     }
 
     std::optional<intx::uint256> read_total_difficulty(BlockNum b, Hash h) {
-        return db::read_total_difficulty(txn, b, h.bytes);
+        return header_cache ? header_cache->read_total_difficulty(txn, b, h.bytes)
+                            : db::read_total_difficulty(txn, b, h.bytes);
     }
 
     BlockNum read_stage_progress(const char* stage_name) { return db::stages::read_stage_progress(txn, stage_name); }
@@ -259,10 +321,21 @@ class Db::ReadWriteAccess::Tx : public Db::ReadOnlyAccess::Tx {
     using base = Db::ReadOnlyAccess::Tx;
 
   public:
-    Tx(Db::ReadWriteAccess& access) : base{access.env_.start_write()} {}
-    Tx(const Tx&) = delete;                                    // not copyable
-    Tx(Tx&& source) noexcept : base(std::move(source.txn)) {}  // only movable
-    Tx(mdbx::txn& source) : base{source} {}                    // to be more silkworm friendly
+    Tx(Db::ReadWriteAccess& access)
+        : base{access.env_.start_write(), access.header_cache_, access.serving_cache_} {}
+    Tx(const Tx&) = delete;                                  // not copyable
+    Tx(Tx&& source) noexcept : base(std::move(source)) {}  // only movable
+    Tx(mdbx::txn& source) : base{source} {}                  // to be more silkworm friendly
+    ~Tx() { discard_cache(); }                               // destroying txn cause abort if not done
+
+    void abort() {
+        txn.abort();
+        discard_cache();
+    }
+    void commit() {
+        txn.commit();
+        header_cache = nullptr;  // cached values are now committed ones
+    }
 
     void write_header(const BlockHeader& header, bool with_header_numbers) {
         Bytes encoded_header;
@@ -281,7 +354,46 @@ class Db::ReadWriteAccess::Tx : public Db::ReadOnlyAccess::Tx {
         }
     }
 
-    void write_body(const BlockBody& body, Hash h, BlockNum bn) { db::write_body(txn, body, h.bytes, bn); }
+    //! a header to be written by write_headers() along with its total difficulty
+    struct HeaderRecord {
+        const BlockHeader* header{nullptr};
+        Hash hash;
+        intx::uint256 total_difficulty;
+    };
+
+    //! same as write_header(header, true) and write_total_difficulty() for each record, but rows are sorted per table
+    //! and go through a single cursor each, appended while their keys are beyond the last ones in the table
+    void write_headers(const std::vector<HeaderRecord>& records) {
+        if (records.empty()) return;
+
+        std::vector<std::pair<Bytes, Bytes>> headers, total_difficulties, header_numbers;
+        headers.reserve(records.size());
+        total_difficulties.reserve(records.size());
+        header_numbers.reserve(records.size());
+        for (const auto& record : records) {
+            Bytes key = db::block_key(record.header->number, record.hash.bytes);
+            Bytes encoded_header, encoded_td;
+            rlp::encode(encoded_header, *record.header);
+            rlp::encode(encoded_td, record.total_difficulty);
+            if (serving_cache) serving_cache->put_header(record.hash, encoded_header);
+            headers.emplace_back(key, std::move(encoded_header));
+            total_difficulties.emplace_back(std::move(key), std::move(encoded_td));
+            header_numbers.emplace_back(header_numbers_key(record.hash), db::block_key(record.header->number));
+        }
+
+        write_sorted(db::table::kHeaders, headers);
+        write_sorted(db::table::kDifficulty, total_difficulties);
+        write_sorted(db::table::kHeaderNumbers, header_numbers);  // keys are hashes, usually no append here
+    }
+
+    void write_body(const BlockBody& body, Hash h, BlockNum bn) {
+        db::write_body(txn, body, h.bytes, bn);
+        if (serving_cache) {
+            Bytes encoded_body;
+            rlp::encode(encoded_body, body);
+            serving_cache->put_body(h, encoded_body);
+        }
+    }
 
     void write_head_header_hash(Hash h) {
         Bytes key = head_header_key();
@@ -314,6 +426,8 @@ class Db::ReadWriteAccess::Tx : public Db::ReadOnlyAccess::Tx {
         auto hashes_table = db::open_cursor(txn, db::table::kCanonicalHashes);
         hashes_table.upsert(skey, svalue);
         hashes_table.close();
+        if (header_cache) header_cache->erase_canonical_header_hash(b);
+        if (serving_cache) serving_cache->invalidate_replies();
     }
 
     void write_stage_progress(const char* stage_name, BlockNum height) {
@@ -325,6 +439,40 @@ class Db::ReadWriteAccess::Tx : public Db::ReadOnlyAccess::Tx {
         Bytes key = db::block_key(b);
         auto skey = db::to_slice(key);
         (void)hashes_table.erase(skey);
+        if (header_cache) header_cache->erase_canonical_header_hash(b);
+        if (serving_cache) serving_cache->invalidate_replies();
+    }
+
+  private:
+    void write_sorted(const db::MapConfig& config, std::vector<std::pair<Bytes, Bytes>>& rows) {
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        auto table = db::open_cursor(txn, config);
+        auto last = table.to_last(/*throw_notfound=*/false);
+        const Bytes last_key = last ? Bytes{db::from_slice(last.key)} : Bytes{};  // empty precedes any key
+
+        const Bytes* previous_key = nullptr;
+        for (auto& [key, value] : rows) {
+            if (previous_key && *previous_key == key) continue;  // skip duplicates, MDBX_APPEND would reject them
+            previous_key = &key;
+
+            auto skey = db::to_slice(key);
+            auto svalue = db::to_slice(value);
+            if (key > last_key) {
+                mdbx::error::success_or_throw(table.put(skey, &svalue, MDBX_APPEND));
+            } else {
+                table.upsert(skey, svalue);
+            }
+        }
+        table.close();
+    }
+
+    // Values read or written by a tx which is not going to be committed must not outlive it
+    void discard_cache() {
+        if (header_cache) {
+            header_cache->clear();
+            header_cache = nullptr;
+        }
     }
 };
 
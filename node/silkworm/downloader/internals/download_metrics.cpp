@@ -0,0 +1,225 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "download_metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace silkworm {
+
+namespace {
+
+    size_t bucket_of(double value) {
+        if (!(value > 1)) return 0;  // also NaN
+        auto bucket = static_cast<size_t>(std::ceil(std::log2(value)));
+        return std::min(bucket, RollingHistogram::kBuckets - 1);
+    }
+
+    double lower_bound_of(size_t bucket) { return bucket == 0 ? 0 : std::ldexp(1.0, static_cast<int>(bucket) - 1); }
+    double upper_bound_of(size_t bucket) { return std::ldexp(1.0, static_cast<int>(bucket)); }
+
+    struct Family {
+        const char* name;
+        const char* help;
+    };
+
+    constexpr std::array<Family, 8> kHistogramFamilies{{
+        {"response_latency_ms", "Round-trip time of the requests to peers"},
+        {"decode_us", "Decoding and stateless validation of an inbound message"},
+        {"headers_persistence_ms", "Persistence of a batch of headers"},
+        {"bodies_persistence_ms", "Persistence of a batch of bodies"},
+        {"window_occupancy_percent", "Outstanding requests over what the tracked peers can take"},
+        {"message_queue_depth", "Inbound messages waiting to be executed"},
+        {"pending_links", "Headers waiting in memory to be verified and persisted"},
+        {"outstanding_bodies", "Bodies requested and not yet received"},
+    }};
+
+    constexpr std::array<Family, 3> kRateFamilies{{
+        {"inbound_bytes_per_second", "Bytes of headers and bodies messages received"},
+        {"headers_per_second", "Headers received"},
+        {"bodies_per_second", "Bodies received"},
+    }};
+
+    constexpr std::array<double, 4> kQuantiles{0.5, 0.9, 0.99, 1.0};
+
+    constexpr size_t kPeerLabelLength = 16;  // enough to tell peers apart
+
+    void write_summary(std::ostream& out, const std::string& name, const std::string& labels,
+                       const RollingHistogram& histogram, time_point_t tp) {
+        const std::string separator = labels.empty() ? "" : ",";
+        for (double q : kQuantiles) {
+            const double value = histogram.quantile(q, tp);
+            out << name << "{" << labels << separator << "quantile=\"" << q << "\"} ";
+            if (std::isnan(value)) {
+                out << "NaN\n";
+            } else {
+                out << value << "\n";
+            }
+        }
+        const std::string braced_labels = labels.empty() ? "" : "{" + labels + "}";
+        out << name << "_sum" << braced_labels << " " << histogram.sum() << "\n";
+        out << name << "_count" << braced_labels << " " << histogram.count() << "\n";
+    }
+
+    void write_header(std::ostream& out, const std::string& name, const char* help) {
+        out << "# HELP " << name << " " << help << " (quantiles over the last minute)\n"
+            << "# TYPE " << name << " summary\n";
+    }
+
+}  // namespace
+
+int64_t RollingHistogram::epoch_of(time_point_t tp) {
+    return std::chrono::duration_cast<seconds_t>(tp.time_since_epoch()).count() / kSlotDuration.count();
+}
+
+void RollingHistogram::observe(double value, time_point_t tp) {
+    const int64_t epoch = epoch_of(tp);
+    Slot& slot = slots_[static_cast<size_t>(epoch) % kSlots];
+    if (slot.epoch != epoch) {
+        slot.epoch = epoch;
+        slot.counts.fill(0);
+    }
+    ++slot.counts[bucket_of(value)];
+    ++count_;
+    sum_ += value;
+}
+
+double RollingHistogram::quantile(double q, time_point_t tp) const {
+    const int64_t epoch = epoch_of(tp);
+    std::array<uint64_t, kBuckets> counts{};
+    uint64_t total = 0;
+    for (const auto& slot : slots_) {
+        if (slot.epoch > epoch || slot.epoch <= epoch - static_cast<int64_t>(kSlots)) continue;  // out of window
+        for (size_t i = 0; i < kBuckets; ++i) {
+            counts[i] += slot.counts[i];
+            total += slot.counts[i];
+        }
+    }
+    if (total == 0) return std::numeric_limits<double>::quiet_NaN();
+
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(total);
+    double cumulative = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        if (counts[i] == 0) continue;
+        if (cumulative + static_cast<double>(counts[i]) >= rank) {
+            if (i == kBuckets - 1) return lower_bound_of(i);  // no upper bound to interpolate with
+            const double fraction = (rank - cumulative) / static_cast<double>(counts[i]);
+            return lower_bound_of(i) + (upper_bound_of(i) - lower_bound_of(i)) * fraction;
+        }
+        cumulative += static_cast<double>(counts[i]);
+    }
+    return lower_bound_of(kBuckets - 1);  // not reached
+}
+
+void RateMeter::add(uint64_t amount, time_point_t tp) {
+    roll(tp);
+    amount_ += amount;
+}
+
+const RollingHistogram& RateMeter::rates(time_point_t tp) {
+    roll(tp);
+    return rates_;
+}
+
+void RateMeter::roll(time_point_t tp) {
+    const int64_t second = std::chrono::duration_cast<seconds_t>(tp.time_since_epoch()).count();
+    if (second_ < 0) second_ = second;
+    if (second <= second_) return;
+
+    rates_.observe(static_cast<double>(amount_), time_point_t{seconds_t{second_}});
+    amount_ = 0;
+
+    // idle seconds, older ones would be out of the window anyway
+    const int64_t window = static_cast<int64_t>(RollingHistogram::kSlots) * RollingHistogram::kSlotDuration.count();
+    for (int64_t idle = std::max(second_ + 1, second - window); idle < second; ++idle) {
+        rates_.observe(0, time_point_t{seconds_t{idle}});
+    }
+    second_ = second;
+}
+
+void DownloadMetrics::observe(Histogram histogram, double value, time_point_t tp) {
+    std::unique_lock lock{mutex_};
+    histograms_[static_cast<size_t>(histogram)].observe(value, tp);
+}
+
+void DownloadMetrics::add(Rate rate, uint64_t amount, time_point_t tp) {
+    std::unique_lock lock{mutex_};
+    rates_[static_cast<size_t>(rate)].add(amount, tp);
+}
+
+void DownloadMetrics::observe_latency(const PeerId& peer_id, double latency_ms, time_point_t tp) {
+    std::unique_lock lock{mutex_};
+    histograms_[static_cast<size_t>(Histogram::ResponseLatencyMs)].observe(latency_ms, tp);
+    peer_latencies_[peer_id].observe(latency_ms, tp);
+}
+
+void DownloadMetrics::forget_peer(const PeerId& peer_id) {
+    std::unique_lock lock{mutex_};
+    peer_latencies_.erase(peer_id);
+}
+
+void DownloadMetrics::set_dispatch_stats(const std::string& scope, const DispatchStats& stats) {
+    std::unique_lock lock{mutex_};
+    dispatch_stats_[scope] = stats;
+}
+
+std::string DownloadMetrics::to_prometheus_text(time_point_t tp) const {
+    static_assert(kHistogramFamilies.size() == kHistograms && kRateFamilies.size() == kRates);
+    std::unique_lock lock{mutex_};
+    std::ostringstream out;
+
+    for (size_t i = 0; i < kHistograms; ++i) {
+        const std::string name = std::string{"silkworm_download_"} + kHistogramFamilies[i].name;
+        write_header(out, name, kHistogramFamilies[i].help);
+        write_summary(out, name, "", histograms_[i], tp);
+    }
+
+    for (size_t i = 0; i < kRates; ++i) {
+        const std::string name = std::string{"silkworm_download_"} + kRateFamilies[i].name;
+        write_header(out, name, kRateFamilies[i].help);
+        write_summary(out, name, "", rates_[i].rates(tp), tp);
+    }
+
+    const std::string name = "silkworm_download_peer_latency_ms";
+    write_header(out, name, "Round-trip time of the requests to each peer");
+    for (const auto& [peer_id, histogram] : peer_latencies_) {
+        write_summary(out, name, "peer=\"" + peer_id.substr(0, kPeerLabelLength) + "\"", histogram, tp);
+    }
+
+    const auto write_dispatch = [&](const char* family, const char* type, const char* help, auto member) {
+        const std::string dispatch_name = std::string{"silkworm_download_"} + family;
+        out << "# HELP " << dispatch_name << " " << help << "\n"
+            << "# TYPE " << dispatch_name << " " << type << "\n";
+        for (const auto& [scope, stats] : dispatch_stats_) {
+            out << dispatch_name << "{scope=\"" << scope << "\"} " << stats.*member << "\n";
+        }
+    };
+    write_dispatch("dispatched_messages_total", "counter", "Inbound messages handed to the subscribers",
+                   &DispatchStats::dispatched);
+    write_dispatch("dropped_messages_total", "counter", "Inbound messages dropped because the dispatch queue was full",
+                   &DispatchStats::dropped);
+    write_dispatch("dispatch_backpressure_total", "counter", "Times the receiving loop waited for the dispatch queue",
+                   &DispatchStats::blocked);
+    write_dispatch("dispatch_queue_depth", "gauge", "Inbound messages waiting to be dispatched",
+                   &DispatchStats::queued);
+
+    return out.str();
+}
+
+}  // namespace silkworm
@@ -0,0 +1,132 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "types.hpp"
+
+namespace silkworm {
+
+/** RollingHistogram counts observations in exponential buckets (upper bounds 1, 2, 4, ...) over a rolling window made
+ *  of kSlots slots of kSlotDuration each: quantiles reflect the last minute only, while count and sum are cumulative.
+ *  Not thread safe.
+ */
+class RollingHistogram {
+  public:
+    static constexpr size_t kBuckets{32};  // the last one has no upper bound
+    static constexpr size_t kSlots{6};
+    static constexpr seconds_t kSlotDuration{10};
+
+    void observe(double value, time_point_t);
+
+    //! the value below which falls the fraction q of the observations in the window, interpolated within its bucket
+    //! \return NaN if there are no observations in the window
+    [[nodiscard]] double quantile(double q, time_point_t) const;
+
+    [[nodiscard]] uint64_t count() const { return count_; }  // since construction
+    [[nodiscard]] double sum() const { return sum_; }        // since construction
+
+  private:
+    struct Slot {
+        int64_t epoch{-1};  // time since epoch in kSlotDuration units, the slot is stale if out of the window
+        std::array<uint64_t, kBuckets> counts{};
+    };
+
+    static int64_t epoch_of(time_point_t);
+
+    std::array<Slot, kSlots> slots_;
+    uint64_t count_{0};
+    double sum_{0};
+};
+
+/** RateMeter turns amounts (e.g. bytes received) into rates per second, one observation each second, so that their
+ *  distribution can be looked at: a second without anything counts as a zero rate.
+ *  Not thread safe.
+ */
+class RateMeter {
+  public:
+    void add(uint64_t amount, time_point_t);
+
+    //! the rates of the seconds completed up to tp
+    [[nodiscard]] const RollingHistogram& rates(time_point_t tp);
+
+  private:
+    void roll(time_point_t);  // observes the rates of the seconds elapsed
+
+    int64_t second_{-1};  // the second being counted
+    uint64_t amount_{0};  // in the second being counted
+    RollingHistogram rates_;
+};
+
+//! Counters of the dispatch of inbound messages of a scope to the subscribers (see SentryClient)
+struct DispatchStats {
+    uint64_t dispatched{0};  // handed to subscribers
+    uint64_t dropped{0};     // discarded because the queue of the scope was full
+    uint64_t blocked{0};     // times the receiving loop waited for room in the queue (backpressure)
+    size_t queued{0};        // waiting to be dispatched
+};
+
+/** DownloadMetrics collects distributions of what limits the block download: peers (latency and throughput),
+ *  decoding of their messages, persistence, and how full the request window and the queues in between are.
+ *  It is fed by the downloader messages, the BlockExchange and the stages, that run on different threads, so it is
+ *  thread safe. Metrics are exported in Prometheus text exposition format, like the stage metrics (see
+ *  stagedsync::to_prometheus_text).
+ */
+class DownloadMetrics {
+  public:
+    enum class Histogram {
+        ResponseLatencyMs,       // of all peers
+        DecodeUs,                // decoding and stateless validation of an inbound message
+        HeadersPersistenceMs,    // of a batch of headers
+        BodiesPersistenceMs,     // of a batch of bodies
+        WindowOccupancyPercent,  // outstanding requests over what peers can take (see PeerTracker)
+        MessageQueueDepth,       // inbound messages waiting to be executed by the BlockExchange
+        PendingLinks,            // headers waiting in the HeaderChain
+        OutstandingBodies,       // bodies requested and not yet received
+    };
+    enum class Rate {
+        InboundBytes,  // of headers and bodies messages
+        Headers,
+        Bodies,
+    };
+
+    void observe(Histogram, double value, time_point_t);
+    void add(Rate, uint64_t amount, time_point_t);
+
+    void observe_latency(const PeerId&, double latency_ms, time_point_t);  // also as ResponseLatencyMs
+    void forget_peer(const PeerId&);
+
+    void set_dispatch_stats(const std::string& scope, const DispatchStats&);  // latest counters of the scope
+
+    [[nodiscard]] std::string to_prometheus_text(time_point_t) const;
+
+  private:
+    static constexpr size_t kHistograms{static_cast<size_t>(Histogram::OutstandingBodies) + 1};
+    static constexpr size_t kRates{static_cast<size_t>(Rate::Bodies) + 1};
+
+    mutable std::mutex mutex_;  // guards the members below
+    std::array<RollingHistogram, kHistograms> histograms_;
+    mutable std::array<RateMeter, kRates> rates_;  // rolled also when read
+    std::map<PeerId, RollingHistogram> peer_latencies_;
+    std::map<std::string, DispatchStats> dispatch_stats_;  // by scope
+};
+
+}  // namespace silkworm
@@ -0,0 +1,93 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "download_metrics.hpp"
+
+#include <cmath>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("RollingHistogram") {
+    using namespace std::chrono_literals;
+    const time_point_t tp{seconds_t{1'000'000}};
+    RollingHistogram histogram;
+
+    CHECK(std::isnan(histogram.quantile(0.5, tp)));
+
+    for (int i = 1; i <= 100; ++i) histogram.observe(i, tp);
+    CHECK(histogram.count() == 100);
+    CHECK(histogram.sum() == 5050);
+
+    const double median = histogram.quantile(0.5, tp);
+    CHECK(median > 32);  // in bucket (32, 64]
+    CHECK(median <= 64);
+    CHECK(histogram.quantile(1.0, tp) == 128);  // upper bound of bucket (64, 128]
+    CHECK(histogram.quantile(0.0, tp) <= 1);
+
+    // observations leave the window, not the totals
+    CHECK(std::isnan(histogram.quantile(0.5, tp + 60s)));
+    histogram.observe(1000, tp + 60s);
+    CHECK(histogram.quantile(0.5, tp + 60s) > 512);
+    CHECK(histogram.count() == 101);
+}
+
+TEST_CASE("RateMeter") {
+    using namespace std::chrono_literals;
+    const time_point_t tp{seconds_t{1'000'000}};
+    RateMeter meter;
+
+    meter.add(1000, tp);
+    meter.add(1000, tp + 500ms);
+    CHECK(meter.rates(tp + 900ms).count() == 0);  // the second is not complete
+
+    meter.add(10, tp + 3s);  // 2000 in the first second, then 2 idle seconds
+    const auto& rates = meter.rates(tp + 3s);
+    CHECK(rates.count() == 3);
+    CHECK(rates.sum() == 2000);
+
+    CHECK(meter.rates(tp + 1h).count() < 3 + 100);  // a long idle period does not take a long time
+}
+
+TEST_CASE("DownloadMetrics") {
+    const time_point_t tp{seconds_t{1'000'000}};
+    DownloadMetrics metrics;
+
+    metrics.observe(DownloadMetrics::Histogram::DecodeUs, 250, tp);
+    metrics.add(DownloadMetrics::Rate::Bodies, 128, tp);
+    metrics.observe_latency("0123456789abcdef0123", 100, tp);
+
+    std::string text = metrics.to_prometheus_text(tp);
+    CHECK(text.find("# TYPE silkworm_download_decode_us summary\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_decode_us_count 1\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_response_latency_ms_count 1\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_bodies_persistence_ms{quantile=\"0.5\"} NaN\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_peer_latency_ms_count{peer=\"0123456789abcdef\"} 1\n") != std::string::npos);
+
+    metrics.forget_peer("0123456789abcdef0123");
+    text = metrics.to_prometheus_text(tp);
+    CHECK(text.find("peer=") == std::string::npos);
+
+    metrics.set_dispatch_stats("block_requests", {.dispatched = 10, .dropped = 2, .blocked = 0, .queued = 3});
+    text = metrics.to_prometheus_text(tp);
+    CHECK(text.find("# TYPE silkworm_download_dropped_messages_total counter\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_dispatched_messages_total{scope=\"block_requests\"} 10\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_dropped_messages_total{scope=\"block_requests\"} 2\n") != std::string::npos);
+    CHECK(text.find("silkworm_download_dispatch_queue_depth{scope=\"block_requests\"} 3\n") != std::string::npos);
+}
+
+}  // namespace silkworm
@@ -16,6 +16,9 @@
 
 #include "header_chain.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/common/as_range.hpp>
 #include <silkworm/common/log.hpp>
@@ -37,6 +40,7 @@ HeaderChain::HeaderChain(const ChainIdentity& ci) : HeaderChain(consensus::engin
 HeaderChain::HeaderChain(ConsensusEnginePtr consensus_engine)
     : highest_in_db_(0),
       top_seen_height_(0),
+      recovered_down_to_(0),
       preverified_hashes_(&PreverifiedHashes::none),
       seen_announces_(1000),
       consensus_engine_{std::move(consensus_engine)},
@@ -76,6 +80,12 @@ size_t HeaderChain::pending_links() const { return links_.size() - persisted_lin
 
 size_t HeaderChain::anchors() const { return anchors_.size(); }
 
+size_t HeaderChain::memory_usage() const {
+    // Encoded headers spilled to the scratch area are file backed, hence reclaimable by the kernel: not counted
+    constexpr size_t kIndexEntrySize{64};  // rough cost of an entry in the maps and queues over links and anchors
+    return link_pool_.capacity() + anchor_pool_.capacity() + (links_.size() + anchors_.size()) * kIndexEntrySize;
+}
+
 std::vector<Announce>& HeaderChain::announces_to_do() { return announces_to_do_; }
 
 void HeaderChain::add_bad_headers(const std::set<Hash>& bads) {
@@ -85,13 +95,38 @@ void HeaderChain::add_bad_headers(const std::set<Hash>& bads) {
 void HeaderChain::recover_initial_state(Db::ReadOnlyAccess::Tx& tx) {
     reduce_persisted_links_to(0);  // drain persistedLinksQueue and remove links
 
-    tx.read_headers_in_reverse_order(persistent_link_limit, [this](BlockHeader&& header) {
-        this->add_header_as_link(header, true);  // todo: optimize add_header_as_link to use Header&&
-    });
+    // startup must be fast: load the most recent headers only, the tip is followed from them, older ones later
+    recovering_ = true;
+    recovered_down_to_ = std::numeric_limits<BlockNum>::max();
+    recover_more_links(tx, eagerly_recovered_links);
 
     // highest_in_db_ = tx.read_stage_progress(db::stages::kHeadersKey); // will be done by sync_current_state
 }
 
+void HeaderChain::recover_more_links(Db::ReadOnlyAccess::Tx& tx, size_t count) {
+    if (!recovering_) return;
+    // do not load links that reduce_persisted_links_to() would drop straight away
+    const size_t room = persistent_link_limit - std::min(persisted_link_queue_.size(), persistent_link_limit);
+    count = std::min(count, room);
+
+    size_t read = 0;
+    if (count > 0) {
+        tx.read_headers_in_reverse_order(recovered_down_to_, count,
+                                         [this, &read](const Hash& hash, ByteView rlp, BlockHeader&& header) {
+                                             ++read;
+                                             recovered_down_to_ = header.number;
+                                             if (links_.contains(hash)) return;  // already received meanwhile
+                                             add_persisted_link(header, hash, rlp);
+                                         });
+    }
+    if (read < count || count == room) {
+        recovering_ = false;
+        SILK_DEBUG << "HeaderChain: persisted links recovered, " << persisted_link_queue_.size() << " in memory";
+    }
+}
+
+bool HeaderChain::recovering() const { return recovering_; }
+
 void HeaderChain::sync_current_state(BlockNum highest_in_db) {
     highest_in_db_ = highest_in_db;
 
@@ -108,8 +143,9 @@ Headers HeaderChain::withdraw_stable_headers() {
     SILK_TRACE << "HeaderChain: finding headers to persist on top of " << highest_in_db_ << " (" << insert_list_.size()
                << " waiting in queue)";
 
-    OldestFirstLinkQueue assessing_list = insert_list_;  // use move() operation if it is assured that after the move
-    insert_list_.clear();                                // the container is empty and can be reused
+    verify_seals();  // PoW of the links added since last time, before verify() checks them one by one
+
+    OldestFirstLinkQueue assessing_list = std::move(insert_list_);  // insert_list_ is left empty, to be refilled
 
     while (!assessing_list.empty()) {
         // Choose a link at top
@@ -130,7 +166,7 @@ Headers HeaderChain::withdraw_stable_headers() {
             insert_list_.push(link);
             log::Warning() << "HeaderChain: added future link,"
                            << " hash=" << link->hash << " height=" << link->blockHeight
-                           << " timestamp=" << link->header->timestamp << ")";
+                           << " timestamp=" << link->header()->timestamp << ")";
             continue;
         }
 
@@ -149,7 +185,7 @@ Headers HeaderChain::withdraw_stable_headers() {
         }
 
         // Insert in the list of headers to persist
-        stable_headers.push_back(link->header);  // will be persisted by HeaderPersistence
+        stable_headers.push_back(link->header());  // will be persisted by HeaderPersistence
 
         // Update persisted height, and state
         if (link->blockHeight > highest_in_db_) {
@@ -193,8 +229,15 @@ auto HeaderChain::verify(const Link& link) -> VerificationResult {
         return Skip;
     }
 
+    if (link.valid_seal.has_value() && !*link.valid_seal) {
+        return Skip;
+    }
+
     bool with_future_timestamp_check = true;
-    auto result = consensus_engine_->validate_block_header(*link.header, chain_state_, with_future_timestamp_check);
+    bool with_seal_check = !link.valid_seal.has_value();  // i.e. not already done by verify_seals()
+    auto header = link.header();
+    auto result = consensus_engine_->validate_block_header(*header, chain_state_, with_future_timestamp_check,
+                                                           with_seal_check);
 
     if (result != ValidationResult::kOk) {
         if (result == ValidationResult::kUnknownParent) {
@@ -206,9 +249,39 @@ auto HeaderChain::verify(const Link& link) -> VerificationResult {
         return Skip;
     }
 
+    chain_state_.remember(*header, link.hash);  // the parent of the next link to verify, likely
     return Accept;
 }
 
+// Seal verification is the costly part of verify() (ethash PoW) and it does not need the parent, so it can be done in
+// parallel for all the new links and ahead of their connection to the persisted chain
+void HeaderChain::verify_seals() {
+    std::vector<std::shared_ptr<Link>> batch;
+    for (auto& link : unverified_links_) {
+        // links may have been pre-verified, persisted or removed in the meantime
+        if (link->preverified || link->persisted || link->valid_seal.has_value() || !links_.contains(link->hash))
+            continue;
+        batch.push_back(std::move(link));
+    }
+    unverified_links_.clear();
+
+    if (batch.size() < min_seal_batch) return;  // verify() will do
+
+    std::vector<std::shared_ptr<BlockHeader>> decoded_headers;  // Link::header() decodes on each call
+    std::vector<const BlockHeader*> headers;
+    decoded_headers.reserve(batch.size());
+    headers.reserve(batch.size());
+    for (const auto& link : batch) headers.push_back(decoded_headers.emplace_back(link->header()).get());
+
+    const size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const auto results = consensus_engine_->validate_seals(headers, num_threads);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i]->valid_seal = results[i] == ValidationResult::kOk;
+    }
+
+    SILK_TRACE << "HeaderChain: " << batch.size() << " seals verified on " << num_threads << " threads";
+}
+
 // reduce persistedLinksQueue and remove links
 void HeaderChain::reduce_persisted_links_to(size_t limit) {
     if (persisted_link_queue_.size() <= limit) return;
@@ -229,60 +302,19 @@ void HeaderChain::reduce_persisted_links_to(size_t limit) {
 // Note: Erigon's HeadersForward is implemented in OutboundGetBlockHeaders message
 
 /*
- * Skeleton query.
- * Request "seed" headers that can became anchors.
- * It requests N headers starting at highestInDb + stride up to topSeenHeight.
- * If there is an anchor at height < topSeenHeight this will be the top limit: this way we prioritize the fill of a big
- * hole near the bottom. If the lowest hole is not so big we do not need a skeleton query yet.
+ * Segments query.
+ * Split the gap between highestInDb and topSeenHeight in segments and request many of them in parallel, each to a
+ * different peer, see SegmentScheduler. The headers received are processed as any other: a segment becomes a chain
+ * bundle that connects to the segment below, once received, and to the segment above.
  */
-std::optional<GetBlockHeadersPacket66> HeaderChain::request_skeleton() {
-    using namespace std::chrono_literals;
-
-    if (anchors_.size() > 64) {
-        skeleton_condition_ = "busy";
-        return std::nullopt;
-    }
-
-    BlockNum top = top_seen_height_;
-    BlockNum bottom = highest_in_db_ + stride;  // warning: this can be inside a chain in memory
-    if (top <= bottom) {
-        skeleton_condition_ = "end";
-        return std::nullopt;
-    }
+auto HeaderChain::request_segments(time_point_t tp, seconds_t timeout, const std::vector<PeerTracker::IdlePeer>& idle_peers)
+    -> std::vector<SegmentScheduler::Assignment> {
+    auto assignments = segment_scheduler_.schedule(highest_in_db_, top_seen_height_, idle_peers, tp, timeout,
+                                                   [this] { return generate_request_id(); });
 
-    BlockNum lowest_anchor = lowest_anchor_within_range(highest_in_db_, top + 1);
-    // using bottom variable in place of highest_in_db_ in the range is wrong because if there is an anchor under
-    // bottom we issue a wrong request, f.e. if the anchor=1536 was extended down we would request again origin=1536
+    for (const auto& assignment : assignments) statistics_.requested_items += assignment.packet.request.amount;
 
-    if (lowest_anchor <= bottom) {
-        log::Trace() << "HeaderChain, no need for skeleton request (lowest_anchor = " << lowest_anchor
-                     << ", highest_in_db = " << highest_in_db_ << ")";
-        skeleton_condition_ = "deep";
-        return std::nullopt;
-    }
-
-    BlockNum length = (lowest_anchor - bottom) / stride;
-
-    if (length > max_len) length = max_len;
-
-    if (length == 0) {
-        log::Trace() << "HeaderChain, no need for skeleton request (lowest_anchor = " << lowest_anchor
-                     << ", highest_in_db = " << highest_in_db_ << ")";
-        skeleton_condition_ = "low";
-        return std::nullopt;
-    }
-
-    GetBlockHeadersPacket66 packet;
-    packet.requestId = generate_request_id();  // RANDOM_NUMBER.generate_one();
-    packet.request.origin = bottom;
-    packet.request.amount = length;
-    packet.request.skip = stride - 1;
-    packet.request.reverse = false;
-
-    statistics_.requested_items += length;
-    skeleton_condition_ = "ok";
-
-    return {packet};
+    return assignments;
 }
 
 size_t HeaderChain::anchors_within_range(BlockNum max) {
@@ -290,16 +322,6 @@ size_t HeaderChain::anchors_within_range(BlockNum max) {
         as_range::count_if(anchors_, [&max](const auto& anchor) { return anchor.second->blockHeight < max; }));
 }
 
-BlockNum HeaderChain::lowest_anchor_within_range(BlockNum bottom, BlockNum top) {
-    BlockNum lowest = top;
-    for (const auto& anchor : anchors_) {
-        if (anchor.second->blockHeight >= bottom && anchor.second->blockHeight < lowest) {
-            lowest = anchor.second->blockHeight;
-        }
-    }
-    return lowest;
-}
-
 std::shared_ptr<Anchor> HeaderChain::highest_anchor() {
     std::shared_ptr<Anchor> highest_anchor = nullptr;
     for (const auto& a : anchors_) {
@@ -344,9 +366,15 @@ auto HeaderChain::request_more_headers(time_point_t time_point, seconds_t timeou
             return {nullopt, penalties};  // anchor not ready for "extend" re-request yet
         }
 
+        if (segment_scheduler_.covers(anchor->blockHeight - 1)) {
+            anchor->timestamp = time_point + timeout;  // the headers below are being requested as a segment, wait
+            anchor_queue_.update(anchor);              // without counting it as a timeout
+            continue;
+        }
+
         if (anchor->timeouts < 10) {
             anchor->update_timestamp(time_point + timeout);
-            anchor_queue_.fix();  // re-sort
+            anchor_queue_.update(anchor);  // re-sort
 
             GetBlockHeadersPacket66 packet{
                 generate_request_id(),  // RANDOM_NUMBER.generate_one(),
@@ -374,7 +402,7 @@ auto HeaderChain::request_more_headers(time_point_t time_point, seconds_t timeou
     return {nullopt, penalties};
 }
 
-void HeaderChain::invalidate(std::shared_ptr<Anchor> anchor) {
+void HeaderChain::invalidate(const std::shared_ptr<Anchor>& anchor) {
     remove(anchor);
     // remove upwards
     auto& link_to_remove = anchor->links;
@@ -392,6 +420,8 @@ void HeaderChain::save_external_announce(Hash h) {
 }
 
 void HeaderChain::request_nack(const GetBlockHeadersPacket66& packet) {
+    segment_scheduler_.on_nack(packet.requestId);
+
     std::shared_ptr<Anchor> anchor;
 
     if (std::holds_alternative<Hash>(packet.request.origin)) {
@@ -417,13 +447,14 @@ void HeaderChain::request_nack(const GetBlockHeadersPacket66& packet) {
     log::Trace() << "[INFO] HeaderChain: restoring timestamp due to request nack, requestId=" << packet.requestId;
 
     anchor->restore_timestamp();
-    anchor_queue_.fix();
+    anchor_queue_.update(anchor);
 }
 
 bool HeaderChain::has_link(Hash hash) { return (links_.find(hash) != links_.end()); }
 
-auto HeaderChain::find_bad_header(const std::vector<BlockHeader>& headers) -> bool {
-    for (auto& header : headers) {
+auto HeaderChain::find_bad_header(const std::vector<BlockHeader>& headers, const std::vector<Hash>& hashes) -> bool {
+    for (size_t i = 0; i < headers.size(); i++) {
+        const BlockHeader& header = headers[i];
         if (is_zero(header.parent_hash) && header.number != 0) {
             log::Warning() << "HeaderChain: received malformed header: " << header.number;
             return true;
@@ -432,8 +463,7 @@ auto HeaderChain::find_bad_header(const std::vector<BlockHeader>& headers) -> bo
             log::Warning() << "HeaderChain: received header w/ wrong diff: " << header.number;
             return true;
         }
-        Hash header_hash = header.hash();
-        if (bad_headers_.contains(header_hash)) {
+        if (bad_headers_.contains(hashes[i])) {
             log::Warning() << "HeaderChain: received bad header: " << header.number;
             return true;
         }
@@ -443,8 +473,15 @@ auto HeaderChain::find_bad_header(const std::vector<BlockHeader>& headers) -> bo
 
 auto HeaderChain::accept_headers(const std::vector<BlockHeader>& headers, uint64_t requestId, const PeerId& peer_id)
     -> std::tuple<Penalty, RequestMoreHeaders> {
+    return accept_headers(headers, /*hashes=*/{}, requestId, peer_id);
+}
+
+auto HeaderChain::accept_headers(const std::vector<BlockHeader>& headers, std::vector<Hash> hashes,
+                                 uint64_t requestId, const PeerId& peer_id) -> std::tuple<Penalty, RequestMoreHeaders> {
     bool request_more_headers = false;
 
+    segment_scheduler_.on_response(requestId, headers);
+
     if (headers.empty()) return {Penalty::NoPenalty, request_more_headers};
     statistics_.received_items += headers.size();
 
@@ -455,12 +492,14 @@ auto HeaderChain::accept_headers(const std::vector<BlockHeader>& headers, uint64
         return {Penalty::NoPenalty, request_more_headers};
     }
 
-    if (find_bad_header(headers)) {
+    if (hashes.size() != headers.size()) hashes = HeaderList::compute_hashes(headers);  // not provided
+
+    if (find_bad_header(headers, hashes)) {
         statistics_.reject_causes.bad += headers.size();
         return {Penalty::BadBlockPenalty, request_more_headers};
     }
 
-    auto header_list = HeaderList::make(headers);
+    auto header_list = HeaderList::make(headers, std::move(hashes));
 
     auto [segments, penalty] = header_list->split_into_segments();
 
@@ -521,7 +560,7 @@ auto HeaderList::split_into_segments() -> std::tuple<std::vector<Segment>, Penal
     size_t segmentIdx = 0;
 
     for (auto& header : headers) {
-        Hash header_hash = header->hash();
+        const Hash& header_hash = hash_of(header);
 
         if (dedupMap.contains(header_hash)) {
             return {std::vector<Segment>{}, Penalty::DuplicateHeaderPenalty};
@@ -576,7 +615,7 @@ auto HeaderChain::process_segment(const Segment& segment, bool is_a_new_block, c
 
     auto highest_header = segment.front();
     auto height = highest_header->number;
-    if (height > top_seen_height_ && (is_a_new_block || seen_announces_.get(Hash(highest_header->hash())) != nullptr)) {
+    if (height > top_seen_height_ && (is_a_new_block || seen_announces_.get(segment.hash(0)) != nullptr)) {
         top_seen_height_ = height;
     }
 
@@ -637,8 +676,8 @@ void HeaderChain::reduce_links_to(size_t limit) {
 auto HeaderChain::find_anchor(const Segment& segment) const
     -> std::tuple<std::optional<std::shared_ptr<Anchor>>, Start> {
     for (size_t i = 0; i < segment.size(); i++) {
-        auto a = anchors_.find(segment[i]->hash());  // todo: hash() compute the value, save cpu
-        if (a != anchors_.end()) {                   // segment[i]->hash() == anchor.parent_hash
+        auto a = anchors_.find(segment.hash(i));
+        if (a != anchors_.end()) {  // segment.hash(i) == anchor.parent_hash
             return {a->second, i};
         }
     }
@@ -649,7 +688,7 @@ auto HeaderChain::find_anchor(const Segment& segment) const
 // find_link find the highest existing link (from start) that the new segment can be attached to
 auto HeaderChain::find_link(const Segment& segment, size_t start) const
     -> std::tuple<std::optional<std::shared_ptr<Link>>, End> {
-    auto duplicate_link = get_link(segment[start]->hash());
+    auto duplicate_link = get_link(segment.hash(start));
     if (duplicate_link) return {std::nullopt, 0};
 
     for (size_t i = start; i < segment.size(); i++) {
@@ -668,12 +707,12 @@ auto HeaderChain::get_link(const Hash& hash) const -> std::optional<std::shared_
 }
 
 // find_anchors find the anchor the link is anchored to
-auto HeaderChain::find_anchor(std::shared_ptr<Link> link) const
+auto HeaderChain::find_anchor(const std::shared_ptr<Link>& link) const
     -> std::tuple<std::optional<std::shared_ptr<Anchor>>, DeepLink> {
     auto parent_link = link;
     decltype(links_.begin()) it;
     do {
-        it = links_.find(parent_link->header->parent_hash);
+        it = links_.find(parent_link->parentHash);
         if (it != links_.end()) {
             parent_link = it->second;
         }
@@ -683,19 +722,19 @@ auto HeaderChain::find_anchor(std::shared_ptr<Link> link) const
         return {std::nullopt, parent_link};  // ok, no anchor because the link is in a segment attached to a
     }                                        // persisted link that we return
 
-    auto a = anchors_.find(parent_link->header->parent_hash);
+    auto a = anchors_.find(parent_link->parentHash);
     if (a == anchors_.end()) {
         log::Trace()
             << "[ERROR] HeaderChain: segment cut&paste error, segment without anchor or persisted attach point, "
             << "starting bn=" << link->blockHeight << " ending bn=" << parent_link->blockHeight << " "
-            << "parent=" << to_hex(parent_link->header->parent_hash);
+            << "parent=" << to_hex(parent_link->parentHash);
         return {std::nullopt, parent_link};  // wrong, invariant violation, no anchor but there should be
     }
     return {a->second, parent_link};
 }
 
-void HeaderChain::connect(std::shared_ptr<Link> attachment_link, Segment::Slice segment_slice,
-                          std::shared_ptr<Anchor> anchor) {
+void HeaderChain::connect(const std::shared_ptr<Link>& attachment_link, Segment::Slice segment_slice,
+                          const std::shared_ptr<Anchor>& anchor) {
     using std::to_string;
     // Extend up
 
@@ -749,7 +788,8 @@ void HeaderChain::connect(std::shared_ptr<Link> attachment_link, Segment::Slice
                  << (anchor_preverified ? " (V)" : "");
 }
 
-auto HeaderChain::extend_down(Segment::Slice segment_slice, std::shared_ptr<Anchor> anchor) -> RequestMoreHeaders {
+auto HeaderChain::extend_down(Segment::Slice segment_slice, const std::shared_ptr<Anchor>& anchor)
+    -> RequestMoreHeaders {
     // Add or find new anchor
     auto new_anchor_header = *segment_slice.rbegin();  // lowest header
     bool check_limits = false;
@@ -790,7 +830,7 @@ auto HeaderChain::extend_down(Segment::Slice segment_slice, std::shared_ptr<Anch
     return !pre_existing;
 }
 
-void HeaderChain::extend_up(std::shared_ptr<Link> attachment_link, Segment::Slice segment_slice) {
+void HeaderChain::extend_up(const std::shared_ptr<Link>& attachment_link, Segment::Slice segment_slice) {
     using std::to_string;
     // Search for bad headers
     if (bad_headers_.contains(attachment_link->hash)) {
@@ -885,7 +925,7 @@ auto HeaderChain::add_anchor_if_not_present(const BlockHeader& anchor_header, Pe
                                               ", limit: " + to_string(anchor_limit));
     }
 
-    std::shared_ptr<Anchor> anchor = std::make_shared<Anchor>(anchor_header, peerId);
+    auto anchor = std::allocate_shared<Anchor>(SlabAllocator<Anchor>{&anchor_pool_}, anchor_header, peerId);
     if (anchor->blockHeight > 0) {
         anchors_[anchor_header.parent_hash] = anchor;
         anchor_queue_.push(anchor);
@@ -894,16 +934,25 @@ auto HeaderChain::add_anchor_if_not_present(const BlockHeader& anchor_header, Pe
 }
 
 auto HeaderChain::add_header_as_link(const BlockHeader& header, bool persisted) -> std::shared_ptr<Link> {
-    auto link = std::make_shared<Link>(header, persisted);
+    auto link = std::allocate_shared<Link>(SlabAllocator<Link>{&link_pool_}, header, persisted, &header_scratch_);
     links_[link->hash] = link;
     if (persisted) {
         persisted_link_queue_.push(link);
+    } else if (link->blockHeight > preverified_hashes_->height) {
+        unverified_links_.push_back(link);  // its seal will be verified by verify_seals()
     }
 
     return link;
 }
 
-void HeaderChain::remove(std::shared_ptr<Anchor> anchor) {
+void HeaderChain::add_persisted_link(const BlockHeader& header, const Hash& hash, ByteView rlp) {
+    auto link = std::allocate_shared<Link>(SlabAllocator<Link>{&link_pool_}, header, hash, rlp, /*persisted=*/true,
+                                           &header_scratch_);
+    links_[link->hash] = link;
+    persisted_link_queue_.push(link);
+}
+
+void HeaderChain::remove(const std::shared_ptr<Anchor>& anchor) {
     size_t erased1 = anchors_.erase(anchor->parentHash);
     bool erased2 = anchor_queue_.erase(anchor);
 
@@ -916,7 +965,7 @@ void HeaderChain::remove(std::shared_ptr<Anchor> anchor) {
 void HeaderChain::mark_as_preverified(std::shared_ptr<Link> link) {
     while (link && !link->persisted) {
         link->preverified = true;
-        auto parent = links_.find(link->header->parent_hash);
+        auto parent = links_.find(link->parentHash);
         link = (parent != links_.end() ? parent->second : nullptr);
     }
 }
@@ -17,15 +17,19 @@
 #pragma once
 
 #include <cstdio>
+#include <memory>
+#include <vector>
 
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/common/lru_cache.hpp>
+#include <silkworm/common/slab_allocator.hpp>
 #include <silkworm/consensus/engine.hpp>
 #include <silkworm/downloader/packets/get_block_headers_packet.hpp>
 
 #include "preverified_hashes.hpp"
 #include "chain_elements.hpp"
 #include "header_only_state.hpp"
+#include "segment_scheduler.hpp"
 #include "statistics.hpp"
 
 namespace silkworm {
@@ -37,7 +41,7 @@ namespace silkworm {
  *    - organize headers in segments
  *    - extend/connect segments
  *    - decide what headers can be persisted on the db
- * A user of this class, i.e. the HeaderDownloader, must ask it for header requests (see request_skeleton(),
+ * A user of this class, i.e. the HeaderDownloader, must ask it for header requests (see request_segments(),
  * request_more_headers()). HeaderChain doesn't know anything about the process that must be used to communicate with
  * the peers that are outside, the downloader have the charge to do real requests to peers. And when the downloader
  * receive headers from some peers, because it asked or because there is a new header announcement, it must provide
@@ -52,7 +56,7 @@ namespace silkworm {
  * anchor of this bundle.
  *
  * HeaderChain has 2 logic to extend this collection of chain bundles:
- * - Skeleton query: request headers in a wide range, as seed to grow later, they become anchor without links
+ * - Segments query: request in parallel contiguous segments of the range to fill, they become anchors with links
  * - Anchor extension query: request headers to extend anchors
  */
 class HeaderChain {
@@ -63,8 +67,13 @@ class HeaderChain {
     explicit HeaderChain(ConsensusEnginePtr); // alternative constructor
 
     // load initial state from db - this must be done at creation time
+    // only the most recent persisted headers are loaded, enough to follow the tip, the others by recover_more_links()
     void recover_initial_state(Db::ReadOnlyAccess::Tx&);
 
+    // load older persisted headers, up to count, if not all loaded yet - to be called when idle
+    void recover_more_links(Db::ReadOnlyAccess::Tx&, size_t count);
+    bool recovering() const;  // whether persisted headers are still being loaded
+
     // sync current state - this must be done at header forward
     void sync_current_state(BlockNum highest_in_db);
 
@@ -76,12 +85,14 @@ class HeaderChain {
     std::pair<BlockNum,BlockNum> anchor_height_range() const;
     size_t pending_links() const;
     size_t anchors() const;
+    size_t memory_usage() const;  // estimate of the heap held by links and anchors (see MemoryTag::kHeaderChain)
     const Download_Statistics& statistics() const;
 
-        // core functionalities: anchor collection
-    // to collect anchor more quickly we do a skeleton request i.e. a request of many headers equally distributed in a
-    // given range of block chain that we want to fill
-    auto request_skeleton() -> std::optional<GetBlockHeadersPacket66>;
+    // core functionalities: anchor collection
+    // to fill the range of block chain that we want quickly we request many segments of it in parallel, each to a
+    // different peer among the idle ones (see SegmentScheduler)
+    auto request_segments(time_point_t tp, seconds_t timeout, const std::vector<PeerTracker::IdlePeer>& idle_peers)
+        -> std::vector<SegmentScheduler::Assignment>;
 
     // core functionalities: anchor extension
     // to complete a range of block chain we need to do a request of headers to extend up or down an anchor or a segment
@@ -94,6 +105,9 @@ class HeaderChain {
     // when a remote peer satisfy our request we receive one or more headers that will be processed
     using RequestMoreHeaders = bool;
     auto accept_headers(const std::vector<BlockHeader>&, uint64_t requestId, const PeerId&) -> std::tuple<Penalty, RequestMoreHeaders>;
+    // same as above with hashes of headers computed in advance (e.g. on another thread, see HeaderList::compute_hashes)
+    auto accept_headers(const std::vector<BlockHeader>&, std::vector<Hash> hashes, uint64_t requestId, const PeerId&)
+        -> std::tuple<Penalty, RequestMoreHeaders>;
 
     // core functionalities: persist new headers that have persisted parent
     auto withdraw_stable_headers() -> Headers;
@@ -107,11 +121,12 @@ class HeaderChain {
 
   protected:
     static constexpr BlockNum max_len = 192;
-    static constexpr BlockNum stride = 8 * max_len;
     static constexpr size_t anchor_limit = 512;
     static constexpr size_t link_total = 1024 * 1024;
     static constexpr size_t persistent_link_limit = link_total / 16;
     static constexpr size_t link_limit = link_total - persistent_link_limit;
+    static constexpr size_t min_seal_batch = 2;  // smaller batches are checked inline by verify()
+    static constexpr size_t eagerly_recovered_links = 1024;  // loaded at startup, well beyond usual reorg depth
 
     auto process_segment(const Segment&, bool is_a_new_block, const PeerId&) -> RequestMoreHeaders;
 
@@ -121,31 +136,38 @@ class HeaderChain {
     auto find_link(const Segment&, size_t start) const -> std::tuple<std::optional<std::shared_ptr<Link>>, End>;
     auto get_link(const Hash& hash) const -> std::optional<std::shared_ptr<Link>>;
     using DeepLink = std::shared_ptr<Link>;
-    auto find_anchor(std::shared_ptr<Link> link) const -> std::tuple<std::optional<std::shared_ptr<Anchor>>, DeepLink>;
+    auto find_anchor(const std::shared_ptr<Link>& link) const
+        -> std::tuple<std::optional<std::shared_ptr<Anchor>>, DeepLink>;
 
     void reduce_links_to(size_t limit);
     void reduce_persisted_links_to(size_t limit);
 
     using Pre_Existing = bool;
-    void invalidate(std::shared_ptr<Anchor>);
-    void remove(std::shared_ptr<Anchor>);
-    bool find_bad_header(const std::vector<BlockHeader>&);
+    void invalidate(const std::shared_ptr<Anchor>&);
+    void remove(const std::shared_ptr<Anchor>&);
+    bool find_bad_header(const std::vector<BlockHeader>&, const std::vector<Hash>& hashes);
     auto add_header_as_link(const BlockHeader& header, bool persisted) -> std::shared_ptr<Link>;
+    void add_persisted_link(const BlockHeader& header, const Hash& hash, ByteView rlp);
     auto add_anchor_if_not_present(const BlockHeader& header, PeerId, bool check_limits)
         -> std::tuple<std::shared_ptr<Anchor>, Pre_Existing>;
     void mark_as_preverified(std::shared_ptr<Link>);
     size_t anchors_within_range(BlockNum max);
-    BlockNum lowest_anchor_within_range(BlockNum bottom, BlockNum top);
     std::shared_ptr<Anchor> highest_anchor();
 
     enum VerificationResult { Preverified, Skip, Postpone, Accept };
     VerificationResult verify(const Link& link);
+    void verify_seals();  // checks in parallel the seals of links in unverified_links_, see Link::valid_seal
 
-    void connect(std::shared_ptr<Link>, Segment::Slice, std::shared_ptr<Anchor>);
-    auto extend_down(Segment::Slice, std::shared_ptr<Anchor>) -> RequestMoreHeaders;
-    void extend_up(std::shared_ptr<Link>, Segment::Slice);
+    void connect(const std::shared_ptr<Link>&, Segment::Slice, const std::shared_ptr<Anchor>&);
+    auto extend_down(Segment::Slice, const std::shared_ptr<Anchor>&) -> RequestMoreHeaders;
+    void extend_up(const std::shared_ptr<Link>&, Segment::Slice);
     auto new_anchor(Segment::Slice, PeerId) -> RequestMoreHeaders;
 
+    // Storage of links, anchors and links' encoded headers, declared before the containers pointing to them so that
+    // they are destroyed after them
+    SlabPool link_pool_;
+    SlabPool anchor_pool_;
+    HeaderScratch header_scratch_;
     OldestFirstAnchorQueue anchor_queue_;        // Priority queue of anchors used to sequence the header requests
     LinkMap links_;                              // Links by header hash
     AnchorMap anchors_;                          // Mapping from parentHash to collection of anchors
@@ -153,6 +175,8 @@ class HeaderChain {
     OldestFirstLinkQueue insert_list_;  // List of non-persisted links that can be inserted (their parent is persisted)
     BlockNum highest_in_db_;
     BlockNum top_seen_height_;
+    bool recovering_{false};     // Whether persisted links are still being loaded from db
+    BlockNum recovered_down_to_;  // Lowest block number loaded so far
     std::set<Hash> bad_headers_;
     const PreverifiedHashes* preverified_hashes_; // Set of hashes that are known to belong to canonical chain
     using Ignore = int;
@@ -160,7 +184,7 @@ class HeaderChain {
     std::vector<Announce> announces_to_do_;
     ConsensusEnginePtr consensus_engine_;
     CustomHeaderOnlyChainState chain_state_;
-    time_point_t last_skeleton_request;
+    SegmentScheduler segment_scheduler_;
 
     uint64_t generate_request_id();
     uint64_t is_valid_request_id(uint64_t request_id);
@@ -169,7 +193,8 @@ class HeaderChain {
     uint64_t request_count = 0;
 
     Download_Statistics statistics_;
-    std::string skeleton_condition_;
+
+    std::vector<std::shared_ptr<Link>> unverified_links_;  // New links above the pre-verified range, see verify_seals()
 };
 
 }  // namespace silkworm
@@ -1415,7 +1415,8 @@ TEST_CASE("HeaderChain - process_segment - (8) sibling with anchor invalidation
         auto anchor2 = chain.anchors_[headers[3].parent_hash];
         anchor2->timestamp = now + timeout;  // avoid extension now
 
-        chain.anchor_queue_.fix();
+        chain.anchor_queue_.update(anchor1);
+        chain.anchor_queue_.update(anchor2);
 
         auto [packet, penalizations] = chain.request_more_headers(now, timeout);  // invalidate (=erase) anchor1
 
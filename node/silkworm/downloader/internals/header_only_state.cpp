@@ -23,13 +23,26 @@ namespace silkworm {
 CustomHeaderOnlyChainState::CustomHeaderOnlyChainState(OldestFirstLinkMap& persistedLinkQueue)
     : persistedLinkQueue_(persistedLinkQueue) {}
 
+void CustomHeaderOnlyChainState::remember(const BlockHeader& header, const evmc::bytes32& hash) const {
+    window_.insert_or_assign({header.number, hash}, header);
+    if (window_.size() > kWindowSize) {
+        window_.erase(window_.begin());
+    }
+}
+
 std::optional<BlockHeader> CustomHeaderOnlyChainState::read_header(BlockNum block_number,
                                                                    const evmc::bytes32& hash) const noexcept {
+    if (auto cached = window_.find({block_number, hash}); cached != window_.end()) {
+        return cached->second;
+    }
+
     auto [initial_link, final_link] = persistedLinkQueue_.equal_range(block_number);
 
     for (auto link = initial_link; link != final_link; link++) {
         if (link->second->blockHeight == block_number && link->second->hash == hash) {
-            return *link->second->header;
+            auto header = link->second->header();
+            remember(*header, hash);
+            return *header;
         }
     }
 
@@ -16,6 +16,9 @@ limitations under the License.
 
 #pragma once
 
+#include <map>
+#include <utility>
+
 #include <silkworm/state/block_state.hpp>
 
 #include "chain_elements.hpp"
@@ -28,9 +31,20 @@ namespace silkworm {
 class CustomHeaderOnlyChainState : public BlockState {
     OldestFirstLinkMap& persistedLinkQueue_;  // not nice
 
+    // Sliding window of the headers decoded lately, the lowest block numbers leaving first: verifying a header reads
+    // its parent, that has just been verified itself, so most reads need neither a search of the links nor decoding.
+    // Keyed by hash too, hence never stale. Not thread safe, as the links it is in front of
+    using BlockNumHashPair = std::pair<BlockNum, evmc::bytes32>;
+    mutable std::map<BlockNumHashPair, BlockHeader> window_;
+
   public:
+    static constexpr size_t kWindowSize{256};
+
     CustomHeaderOnlyChainState(OldestFirstLinkMap& persistedLinkQueue);
 
+    // Keep a header just verified in the window, as it is likely the parent of the next one to verify
+    void remember(const BlockHeader& header, const evmc::bytes32& hash) const;
+
     std::optional<BlockHeader> read_header(uint64_t block_number,
                                            const evmc::bytes32& block_hash) const noexcept override;
 
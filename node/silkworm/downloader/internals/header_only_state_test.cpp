@@ -0,0 +1,59 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "header_only_state.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("CustomHeaderOnlyChainState") {
+    OldestFirstLinkMap persisted_links;
+    CustomHeaderOnlyChainState chain_state{persisted_links};
+
+    BlockHeader header;
+    header.number = 10;
+    header.gas_limit = 30'000'000;
+    auto link = std::make_shared<Link>(header, /*persisted=*/true);
+    persisted_links.push(link);
+
+    SECTION("read from persisted links, then from the window") {
+        auto read = chain_state.read_header(header.number, link->hash);
+        REQUIRE(read);
+        CHECK(read->gas_limit == header.gas_limit);
+        CHECK_FALSE(chain_state.read_header(header.number + 1, link->hash));
+
+        persisted_links.erase(link);
+        read = chain_state.read_header(header.number, link->hash);
+        REQUIRE(read);
+        CHECK(read->hash() == link->hash);
+    }
+
+    SECTION("lowest block numbers leave the window first") {
+        for (BlockNum number{1}; number <= CustomHeaderOnlyChainState::kWindowSize + 1; ++number) {
+            BlockHeader verified;
+            verified.number = number;
+            chain_state.remember(verified, verified.hash());
+        }
+        BlockHeader lowest, highest;
+        lowest.number = 1;
+        highest.number = CustomHeaderOnlyChainState::kWindowSize + 1;
+        CHECK_FALSE(chain_state.read_header(lowest.number, lowest.hash()));
+        CHECK(chain_state.read_header(highest.number, highest.hash()));
+    }
+}
+
+}  // namespace silkworm
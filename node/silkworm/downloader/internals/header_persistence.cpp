@@ -66,7 +66,15 @@ void HeaderPersistence::persist(const Headers& headers) {
     StopWatch measure_curr_scope;                  // only for test
     auto start_time = measure_curr_scope.start();  // only for test
 
-    as_range::for_each(headers, [this](const auto& header) { persist(*header); });
+    // total difficulties are computed in a single pass, parents can be in the batch itself
+    batch_.reserve(headers.size());
+    try {
+        as_range::for_each(headers, [this](const auto& header) { add_to_batch(*header); });
+    } catch (...) {
+        write_batch();  // headers admitted so far are persisted anyway, as they would have been one by one
+        throw;
+    }
+    write_batch();
 
     auto [end_time, _] = measure_curr_scope.lap();  // only for test
 
@@ -75,7 +83,12 @@ void HeaderPersistence::persist(const Headers& headers) {
                  << " (duration=" << measure_curr_scope.format(end_time - start_time) << ")"; // only for test
 }
 
-void HeaderPersistence::persist(const BlockHeader& header) {  // todo: try to modularize
+void HeaderPersistence::persist(const BlockHeader& header) {
+    add_to_batch(header);
+    write_batch();
+}
+
+void HeaderPersistence::add_to_batch(const BlockHeader& header) {  // todo: try to modularize
     // Admittance conditions
     auto height = header.number;
     Hash hash = header.hash();
@@ -83,10 +96,10 @@ void HeaderPersistence::persist(const BlockHeader& header) {  // todo: try to mo
         return;  // skip duplicates
     }
 
-    if (tx_.read_header(height, hash).has_value()) {
+    if (batch_index_.contains(hash) || tx_.read_header(height, hash).has_value()) {
         return;  // already inserted, skip
     }
-    auto parent = tx_.read_header(height - 1, header.parent_hash);
+    auto parent = read_header(height - 1, header.parent_hash);
     if (!parent) {
         std::string error_message = "HeaderPersistence: could not find parent with hash " + to_hex(header.parent_hash) + " and height " +
                                     std::to_string(height - 1) + " for header " + hash.to_hex();
@@ -95,7 +108,12 @@ void HeaderPersistence::persist(const BlockHeader& header) {  // todo: try to mo
     }
 
     // Calculate total difficulty
-    auto parent_td = tx_.read_total_difficulty(height - 1, header.parent_hash);
+    std::optional<BigInt> parent_td;
+    if (auto in_batch = batch_index_.find(header.parent_hash); in_batch != batch_index_.end()) {
+        parent_td = batch_[in_batch->second].total_difficulty;
+    } else {
+        parent_td = tx_.read_total_difficulty(height - 1, header.parent_hash);
+    }
     if (!parent_td) {
         std::string error_message = "HeaderPersistence: parent's total difficulty not found with hash " +
                                     to_hex(header.parent_hash) + " and height " + std::to_string(height - 1) +
@@ -112,9 +130,8 @@ void HeaderPersistence::persist(const BlockHeader& header) {  // todo: try to mo
         // find the forking point - i.e. the latest header on the canonical chain which is an ancestor of this one
         BlockNum forking_point = find_forking_point(tx_, header, height, *parent);
 
-        // Save progress
-        tx_.write_head_header_hash(hash);                           // can throw exception
-        tx_.write_stage_progress(db::stages::kHeadersKey, height);  // can throw exception
+        // Save progress (see write_batch)
+        head_changed_ = true;
 
         highest_in_db_ = height;
         highest_hash_ = hash;
@@ -128,15 +145,31 @@ void HeaderPersistence::persist(const BlockHeader& header) {  // todo: try to mo
         }
     }
 
-    // Save progress
-    tx_.write_total_difficulty(height, hash, td);
+    // Save header and total difficulty (see write_batch)
+    batch_index_.emplace(hash, batch_.size());
+    batch_.push_back({&header, hash, td});
+
+    previous_hash_ = hash;
+}
+
+void HeaderPersistence::write_batch() {
+    if (head_changed_) {
+        tx_.write_head_header_hash(highest_hash_);                          // can throw exception
+        tx_.write_stage_progress(db::stages::kHeadersKey, highest_in_db_);  // can throw exception
+        head_changed_ = false;
+    }
 
-    // Save header
-    tx_.write_header(header, true);  // true = with_header_numbers
+    tx_.write_headers(batch_);  // with header numbers
 
-    // SILK_TRACE << "HeaderPersistence: saved header height=" << height << " hash=" << hash;
+    batch_.clear();
+    batch_index_.clear();
+}
 
-    previous_hash_ = hash;
+std::optional<BlockHeader> HeaderPersistence::read_header(BlockNum height, const Hash& hash) {
+    if (auto in_batch = batch_index_.find(hash); in_batch != batch_index_.end()) {
+        return *batch_[in_batch->second].header;
+    }
+    return tx_.read_header(height, hash);
 }
 
 BlockNum HeaderPersistence::find_forking_point(Db::ReadWriteAccess::Tx& tx, const BlockHeader& header, BlockNum height,
@@ -161,7 +194,7 @@ BlockNum HeaderPersistence::find_forking_point(Db::ReadWriteAccess::Tx& tx, cons
         // look in the cache first
         const Hash* cached_canon_hash;
         while ((cached_canon_hash = canonical_cache_.get(ancestor_height)) && *cached_canon_hash != ancestor_hash) {
-            auto ancestor = tx.read_header(ancestor_height, ancestor_hash);
+            auto ancestor = read_header(ancestor_height, ancestor_hash);
             ancestor_hash = ancestor->parent_hash;
             ancestor_height--;
         }  // if this loop finds a prev_canon_hash the next loop will be executed, is this right?
@@ -169,7 +202,7 @@ BlockNum HeaderPersistence::find_forking_point(Db::ReadWriteAccess::Tx& tx, cons
         // now look in the db
         std::optional<Hash> db_canon_hash;
         while ((db_canon_hash = tx.read_canonical_hash(ancestor_height)) && db_canon_hash != ancestor_hash) {
-            auto ancestor = tx.read_header(ancestor_height, ancestor_hash);
+            auto ancestor = read_header(ancestor_height, ancestor_hash);
             ancestor_hash = ancestor->parent_hash;
             ancestor_height--;
         }
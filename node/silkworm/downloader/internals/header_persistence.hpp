@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include <silkworm/common/lru_cache.hpp>
 
 #include "chain_elements.hpp"
@@ -44,7 +47,7 @@ class HeaderPersistence {
   public:
     explicit HeaderPersistence(Db::ReadWriteAccess::Tx& tx);
 
-    void persist(const Headers&);
+    void persist(const Headers&);  // headers are written in a batch, see Db::ReadWriteAccess::Tx::write_headers()
     void persist(const BlockHeader&);
     void close();
 
@@ -63,6 +66,10 @@ class HeaderPersistence {
   private:
     static constexpr size_t kCanonicalCacheSize = 1000;
 
+    void add_to_batch(const BlockHeader&);  // computes total difficulty and canonical head changes, not writing
+    void write_batch();
+    std::optional<BlockHeader> read_header(BlockNum height, const Hash& hash);  // looks in the batch first
+
     BlockNum find_forking_point(Db::ReadWriteAccess::Tx&, const BlockHeader& header, BlockNum height,
                                 const BlockHeader& parent);
     void update_canonical_chain(BlockNum height, Hash hash);
@@ -78,6 +85,10 @@ class HeaderPersistence {
     bool new_canonical_{false};
     lru_cache<BlockNum, Hash> canonical_cache_;
     bool closed_{false};
+
+    std::vector<Db::ReadWriteAccess::Tx::HeaderRecord> batch_;  // headers not yet written, in persist() order
+    std::unordered_map<Hash, size_t> batch_index_;             // hash -> position in batch_
+    bool head_changed_{false};                                  // head header hash & stage progress not yet written
 };
 
 }  // namespace silkworm
@@ -155,6 +155,60 @@ TEST_CASE("header persistence", "[silkworm][downloader][HeaderPersistence]") {
         REQUIRE(tx.read_canonical_hash(1) == header1_hash);
         REQUIRE(tx.read_canonical_hash(2) == header2_hash);
     }
+
+    /* status:
+     *         h0 (persisted)
+     * input (in a single batch):
+     *        (h0) <----- h1 <----- h2 <----- h3
+     *                |-- h1'
+     */
+    SECTION("a batch of headers whose parents are in the batch itself") {
+        Db::ReadWriteAccess::Tx tx(txn);  // sub transaction
+
+        auto header0 = tx.read_canonical_header(0);
+        auto header0_hash = header0->hash();
+
+        Headers headers;
+        Hash parent_hash = header0_hash;
+        for (BlockNum bn = 1; bn <= 3; ++bn) {
+            auto header = std::make_shared<BlockHeader>();
+            header->number = bn;
+            header->difficulty = 1'000'000 + bn;
+            header->parent_hash = parent_hash;
+            parent_hash = header->hash();
+            headers.push_back(header);
+        }
+        auto header1b = std::make_shared<BlockHeader>();
+        header1b->number = 1;
+        header1b->difficulty = 1'000'000;
+        header1b->parent_hash = header0_hash;
+        header1b->extra_data = string_view_to_byte_view("I'm different");
+        headers.push_back(header1b);
+        headers.push_back(headers[2]);  // duplicated
+
+        HeaderPersistence pc(tx);
+        pc.persist(headers);
+
+        BigInt expected_td = header0->difficulty + 3'000'006;
+        REQUIRE(pc.total_difficulty() == expected_td);
+        REQUIRE(pc.highest_height() == 3);
+        REQUIRE(pc.highest_hash() == parent_hash);
+        REQUIRE(pc.unwind_needed() == false);
+
+        // check db content
+        REQUIRE(tx.read_head_header_hash() == parent_hash);
+        REQUIRE(tx.read_stage_progress(db::stages::kHeadersKey) == 3);
+        REQUIRE(tx.read_total_difficulty(3, parent_hash) == expected_td);
+        REQUIRE(tx.read_total_difficulty(1, header1b->hash()) == header0->difficulty + header1b->difficulty);
+        for (const auto& header : headers) {
+            REQUIRE(tx.read_header(header->hash()) == *header);  // through header numbers
+        }
+
+        pc.close();
+
+        REQUIRE(tx.read_canonical_hash(1) == headers[0]->hash());
+        REQUIRE(tx.read_canonical_hash(3) == parent_hash);
+    }
 }
 
 }  // namespace silkworm
\ No newline at end of file
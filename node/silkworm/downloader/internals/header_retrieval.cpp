@@ -20,43 +20,53 @@
 
 namespace silkworm {
 
-HeaderRetrieval::HeaderRetrieval(Db::ReadOnlyAccess db_access) : db_tx_{db_access.start_ro_tx()} {}
+HeaderRetrieval::HeaderRetrieval(Db::ReadOnlyAccess db_access)
+    : db_tx_{db_access.start_ro_tx()}, serving_cache_{db_access.serving_cache()} {}
 
-std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse) {
+std::optional<Bytes> HeaderRetrieval::read_encoded_header(BlockNum block_num, const Hash& hash) {
+    if (serving_cache_) {
+        if (auto encoded_header = serving_cache_->header(hash); encoded_header) return encoded_header;
+    }
+    auto encoded_header = db_tx_.read_rlp_encoded_header(block_num, hash);  // as it is in the db, no re-encoding
+    if (!encoded_header) return std::nullopt;
+    return Bytes{*encoded_header};
+}
+
+std::vector<Bytes> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse) {
     using std::optional;
     uint64_t max_non_canonical = 100;
 
-    std::vector<BlockHeader> headers;
+    std::vector<Bytes> headers;
     long long bytes = 0;
     Hash hash = origin;
     bool unknown = false;
 
     // first
-    optional<BlockHeader> header = db_tx_.read_header(hash);
+    optional<BlockNum> block_num = db_tx_.read_block_num(hash);
+    if (!block_num) return headers;
+    optional<Bytes> header = read_encoded_header(*block_num, hash);
     if (!header) return headers;
-    BlockNum block_num = header->number;
-    headers.push_back(*header);
-    bytes += est_header_rlp_size;
+    bytes += static_cast<long long>(header->length());
+    headers.push_back(std::move(*header));
 
     // followings
     do {
         // compute next hash & number - todo: understand and improve readability
         if (!reverse) {
-            BlockNum current = header->number;
+            BlockNum current = *block_num;
             BlockNum next = current + skip + 1;
             if (next <= current) {  // true only if there is an overflow
                 unknown = true;
                 log::Warning() << "GetBlockHeaders skip overflow attack:"
                                       << " current=" << current << ", skip=" << skip << ", next=" << next;
             } else {
-                header = db_tx_.read_canonical_header(next);
-                if (!header)
+                optional<Hash> nextHash = db_tx_.read_canonical_hash(next);
+                if (!nextHash)
                     unknown = true;
                 else {
-                    Hash nextHash = header->hash();
-                    auto [expOldHash, _] = get_ancestor(nextHash, next, skip + 1, max_non_canonical);
+                    auto [expOldHash, _] = get_ancestor(*nextHash, next, skip + 1, max_non_canonical);
                     if (expOldHash == hash) {
-                        hash = nextHash;
+                        hash = *nextHash;
                         block_num = next;
                     } else
                         unknown = true;
@@ -67,37 +77,38 @@ std::vector<BlockHeader> HeaderRetrieval::recover_by_hash(Hash origin, uint64_t
             if (ancestor == 0)
                 unknown = true;
             else
-                std::tie(hash, block_num) = get_ancestor(hash, block_num, ancestor, max_non_canonical);
+                std::tie(hash, *block_num) = get_ancestor(hash, *block_num, ancestor, max_non_canonical);
         }
 
         // end todo: understand
 
         if (unknown) break;
 
-        header = db_tx_.read_header(block_num, hash);
+        header = read_encoded_header(*block_num, hash);
         if (!header) break;
-        headers.push_back(*header);
-        bytes += est_header_rlp_size;
+        bytes += static_cast<long long>(header->length());
+        headers.push_back(std::move(*header));
 
     } while (headers.size() < amount && bytes < soft_response_limit && headers.size() < max_headers_serve);
 
     return headers;
 }
 
-std::vector<BlockHeader> HeaderRetrieval::recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip,
-                                                            bool reverse) {
+std::vector<Bytes> HeaderRetrieval::recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse) {
     using std::optional;
 
-    std::vector<BlockHeader> headers;
+    std::vector<Bytes> headers;
     long long bytes = 0;
     BlockNum block_num = origin;
 
     do {
-        optional<BlockHeader> header = db_tx_.read_canonical_header(block_num);
+        optional<Hash> hash = db_tx_.read_canonical_hash(block_num);
+        if (!hash) break;
+        optional<Bytes> header = read_encoded_header(block_num, *hash);
         if (!header) break;
 
-        headers.push_back(*header);
-        bytes += est_header_rlp_size;
+        bytes += static_cast<long long>(header->length());
+        headers.push_back(std::move(*header));
 
         if (!reverse)
             block_num += skip + 1;  // Number based traversal towards the leaf block
@@ -17,24 +17,25 @@
 #pragma once
 
 #include "db_tx.hpp"
+#include "serving_cache.hpp"
 #include "types.hpp"
 
 namespace silkworm {
 
 /*
  * HeaderRetrieval has the responsibility to retrieve BlockHeader from the db using the hash or the block number.
+ * Headers are retrieved RLP encoded, ready to be sent, from the db's ServingCache if present there.
  */
 class HeaderRetrieval {
   public:
     static const long soft_response_limit = 2 * 1024 * 1024;  // Target maximum size of returned blocks
-    static const long est_header_rlp_size = 500;              // Approximate size of an RLP encoded block header
     static const long max_headers_serve = 1024;  // Amount of block headers to be fetched per retrieval request
 
     explicit HeaderRetrieval(Db::ReadOnlyAccess db_access);
 
-    // Headers
-    std::vector<BlockHeader> recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse);
-    std::vector<BlockHeader> recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse);
+    // Headers, RLP encoded
+    std::vector<Bytes> recover_by_hash(Hash origin, uint64_t amount, uint64_t skip, bool reverse);
+    std::vector<Bytes> recover_by_number(BlockNum origin, uint64_t amount, uint64_t skip, bool reverse);
 
     // Node current status
     BlockNum head_height();
@@ -45,7 +46,10 @@ class HeaderRetrieval {
                                             uint64_t& max_non_canonical);
 
   protected:
+    std::optional<Bytes> read_encoded_header(BlockNum, const Hash&);  // from the cache first
+
     Db::ReadOnlyAccess::Tx db_tx_;
+    ServingCache* serving_cache_;  // optional
 };
 
 }  // namespace silkworm
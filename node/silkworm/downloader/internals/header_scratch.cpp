@@ -0,0 +1,142 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "header_scratch.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include <silkworm/common/directories.hpp>
+#include <silkworm/common/log.hpp>
+
+namespace silkworm {
+
+namespace fs = std::filesystem;
+namespace bip = boost::interprocess;
+
+HeaderScratch::Record::Record(Record&& other) noexcept
+    : scratch_{std::exchange(other.scratch_, nullptr)},
+      segment_{other.segment_},
+      data_{other.data_},
+      heap_{std::move(other.heap_)} {}
+
+auto HeaderScratch::Record::operator=(Record&& other) noexcept -> Record& {
+    if (this != &other) {
+        release();
+        scratch_ = std::exchange(other.scratch_, nullptr);
+        segment_ = other.segment_;
+        data_ = other.data_;
+        heap_ = std::move(other.heap_);
+    }
+    return *this;
+}
+
+HeaderScratch::Record::~Record() { release(); }
+
+void HeaderScratch::Record::release() {
+    if (scratch_) {
+        scratch_->release(segment_);
+        scratch_ = nullptr;
+    }
+}
+
+HeaderScratch::HeaderScratch(fs::path directory, size_t max_segments)
+    : directory_{std::move(directory)}, max_segments_{max_segments} {}
+
+bool HeaderScratch::open() {
+    if (open_ || open_failed_) return open_;
+    fs::path file_path;
+    try {
+        if (directory_.empty()) directory_ = TemporaryDirectory::get_os_temporary_path();
+        file_path = TemporaryDirectory::get_unique_temporary_path(directory_);
+        std::ofstream file{file_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        file.close();
+        fs::resize_file(file_path, max_segments_ * kSegmentSize);  // sparse, disk is used as pages get written back
+        file_ = bip::file_mapping{file_path.string().c_str(), bip::read_write};
+        fs::remove(file_path);  // the mapping keeps it alive, nothing is left behind on exit
+        segments_.reserve(max_segments_);
+        open_ = true;
+        return true;
+    } catch (const std::exception& ex) {
+        log::Warning() << "HeaderScratch: unable to create " << file_path.string() << " (" << ex.what()
+                       << "), headers are kept on the heap";
+        std::error_code ec;
+        fs::remove(file_path, ec);
+        open_failed_ = true;
+        return false;
+    }
+}
+
+auto HeaderScratch::store(ByteView rlp) -> Record {
+    Segment* segment = segment_for(rlp.length());
+    if (!segment) return Record{Bytes{rlp}};
+
+    auto* dest = static_cast<uint8_t*>(segment->region.get_address()) + segment->used;
+    std::memcpy(dest, rlp.data(), rlp.length());
+    segment->used += rlp.length();
+    ++segment->live;
+
+    Record record;
+    record.scratch_ = this;
+    record.segment_ = current_;
+    record.data_ = ByteView{dest, rlp.length()};
+    return record;
+}
+
+auto HeaderScratch::segment_for(size_t length) -> Segment* {
+    if (length == 0 || length > kSegmentSize) return nullptr;
+    if (!open()) return nullptr;
+
+    if (!segments_.empty() && segments_[current_].used + length <= kSegmentSize) {
+        return &segments_[current_];
+    }
+
+    // the current segment is full: move to a free one, i.e. whose records have all been released
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        if (i != current_ && segments_[i].live == 0) {
+            segments_[i].used = 0;
+            current_ = i;
+            return &segments_[i];
+        }
+    }
+
+    if (segments_.size() == max_segments_) return nullptr;
+    try {
+        const auto offset = static_cast<bip::offset_t>(segments_.size() * kSegmentSize);
+        Segment segment{bip::mapped_region{file_, bip::read_write, offset, kSegmentSize}};
+        (void)segment.region.advise(bip::mapped_region::advice_sequential);
+        segments_.push_back(std::move(segment));
+    } catch (const bip::interprocess_exception& ex) {
+        log::Warning() << "HeaderScratch: unable to map a new segment (" << ex.what() << ")";
+        return nullptr;
+    }
+    current_ = segments_.size() - 1;
+    return &segments_[current_];
+}
+
+void HeaderScratch::release(size_t segment) {
+    Segment& s = segments_[segment];
+    if (--s.live == 0 && segment == current_) s.used = 0;  // rewind, nothing lives here
+}
+
+size_t HeaderScratch::live_records() const {
+    size_t live = 0;
+    for (const auto& segment : segments_) live += segment.live;
+    return live;
+}
+
+}  // namespace silkworm
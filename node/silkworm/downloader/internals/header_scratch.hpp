@@ -0,0 +1,96 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm {
+
+/** HeaderScratch is a scratch area for RLP encoded headers the downloader holds in memory until persistence.
+ *  It is a sparse temporary file, unlinked as soon as it is mapped, divided in segments that are mapped on demand and
+ *  filled in append order: the kernel can write back and drop its pages under memory pressure, so many more pending
+ *  headers fit in the same RAM. A segment is reused once all its records have been released.
+ *  When the scratch area is full (or cannot be created) records fall back to the heap.
+ *  Not thread safe, but records can be read concurrently as long as none is stored or released.
+ */
+class HeaderScratch {
+  public:
+    static constexpr size_t kSegmentSize{64_Mebi};
+    static constexpr size_t kDefaultMaxSegments{64};
+
+    //! an encoded header, in the scratch area or on the heap, releasing its space on destruction
+    class Record {
+      public:
+        Record() = default;
+        explicit Record(Bytes heap) : heap_{std::move(heap)} {}
+        Record(Record&&) noexcept;
+        Record& operator=(Record&&) noexcept;
+        ~Record();
+
+        [[nodiscard]] ByteView view() const { return scratch_ ? data_ : ByteView{heap_}; }
+        [[nodiscard]] bool spilled() const { return scratch_ != nullptr; }
+
+      private:
+        friend class HeaderScratch;
+        void release();
+
+        HeaderScratch* scratch_{nullptr};
+        size_t segment_{0};
+        ByteView data_;  // in the scratch area
+        Bytes heap_;     // if not spilled
+    };
+
+    //! the file is created in directory (the OS temporary directory if empty) on the first store()
+    explicit HeaderScratch(std::filesystem::path directory = {}, size_t max_segments = kDefaultMaxSegments);
+
+    // Not copyable nor movable: records refer to it
+    HeaderScratch(const HeaderScratch&) = delete;
+    HeaderScratch& operator=(const HeaderScratch&) = delete;
+
+    [[nodiscard]] Record store(ByteView rlp);
+
+    [[nodiscard]] size_t mapped_segments() const { return segments_.size(); }
+    [[nodiscard]] size_t live_records() const;
+
+  private:
+    struct Segment {
+        boost::interprocess::mapped_region region;
+        size_t used{0};  // bytes appended so far
+        size_t live{0};  // records not yet released
+    };
+
+    bool open();
+    Segment* segment_for(size_t length);  // the current segment if it has room, else a free or new one (if any)
+    void release(size_t segment);
+
+    std::filesystem::path directory_;
+    const size_t max_segments_;
+    bool open_{false};
+    bool open_failed_{false};
+    boost::interprocess::file_mapping file_;
+    std::vector<Segment> segments_;  // reserved in advance, records point into them
+    size_t current_{0};              // segment being filled
+};
+
+}  // namespace silkworm
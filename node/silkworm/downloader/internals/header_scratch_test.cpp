@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "header_scratch.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+
+namespace silkworm {
+
+TEST_CASE("HeaderScratch") {
+    TemporaryDirectory tmp_dir;
+    const Bytes rlp(600, 0xAB);
+
+    SECTION("records are stored in the scratch area and released") {
+        HeaderScratch scratch{tmp_dir.path()};
+        {
+            auto record1 = scratch.store(rlp);
+            auto record2 = scratch.store(Bytes(700, 0xCD));
+            CHECK(record1.spilled());
+            CHECK(record1.view() == rlp);
+            CHECK(record2.view() == Bytes(700, 0xCD));
+            CHECK(scratch.mapped_segments() == 1);
+            CHECK(scratch.live_records() == 2);
+
+            HeaderScratch::Record moved{std::move(record1)};
+            CHECK(moved.view() == rlp);
+            CHECK(scratch.live_records() == 2);
+        }
+        CHECK(scratch.live_records() == 0);
+        CHECK(std::filesystem::is_empty(tmp_dir.path()));  // the file is unlinked once mapped
+    }
+
+    SECTION("a full scratch area falls back to the heap") {
+        HeaderScratch scratch{tmp_dir.path(), /*max_segments=*/0};
+        auto record = scratch.store(rlp);
+        CHECK_FALSE(record.spilled());
+        CHECK(record.view() == rlp);
+    }
+
+    SECTION("a segment whose records have been released is reused") {
+        HeaderScratch scratch{tmp_dir.path(), /*max_segments=*/2};
+        const Bytes big(HeaderScratch::kSegmentSize / 2 + 1, 0x01);
+        auto record1 = scratch.store(big);
+        {
+            auto record2 = scratch.store(big);  // does not fit in the first segment
+            CHECK(scratch.mapped_segments() == 2);
+        }
+        auto record3 = scratch.store(big);  // does not fit in the second segment, rewound anyway as empty
+        CHECK(record3.spilled());
+        auto record4 = scratch.store(big);  // no room left
+        CHECK_FALSE(record4.spilled());
+        CHECK(scratch.mapped_segments() == 2);
+        CHECK(record1.view() == big);
+        CHECK(record3.view() == big);
+    }
+}
+
+}  // namespace silkworm
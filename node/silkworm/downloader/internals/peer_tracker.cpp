@@ -0,0 +1,155 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "peer_tracker.hpp"
+
+#include <algorithm>
+
+namespace silkworm {
+
+PeerTracker::PeerTracker(seconds_t request_deadline) : request_deadline_{request_deadline} {}
+
+void PeerTracker::on_connect(const PeerId& peer_id) {
+    std::unique_lock lock{mutex_};
+    peers_.try_emplace(peer_id);
+}
+
+void PeerTracker::on_disconnect(const PeerId& peer_id) {
+    std::unique_lock lock{mutex_};
+    peers_.erase(peer_id);
+}
+
+void PeerTracker::on_height(const PeerId& peer_id, BlockNum height) {
+    std::unique_lock lock{mutex_};
+    Peer& peer = peers_[peer_id];
+    peer.height = std::max(peer.height, height);
+}
+
+void PeerTracker::on_request(const PeerId& peer_id, uint64_t request_id, size_t items, time_point_t tp) {
+    std::unique_lock lock{mutex_};
+    peers_[peer_id].outstanding.push_back({request_id, items, tp});
+}
+
+auto PeerTracker::on_response(const PeerId& peer_id, uint64_t request_id, size_t items, time_point_t tp)
+    -> std::optional<double> {
+    std::unique_lock lock{mutex_};
+    auto p = peers_.find(peer_id);
+    if (p == peers_.end()) return std::nullopt;
+    Peer& peer = p->second;
+
+    auto r = std::find_if(peer.outstanding.begin(), peer.outstanding.end(),
+                          [request_id](const Request& request) { return request.id == request_id; });
+    if (r == peer.outstanding.end()) return std::nullopt;  // unsolicited or already expired: not a reliable sample
+
+    auto rtt = std::chrono::duration<double, std::milli>(tp - r->sent).count();
+    rtt = std::max(rtt, 1.0);  // clock granularity
+    add_sample(peer.stats, rtt, static_cast<double>(std::min(items, r->items)) * 1000.0 / rtt);
+    peer.outstanding.erase(r);
+    return rtt;
+}
+
+auto PeerTracker::select(size_t max_items, time_point_t tp) -> std::optional<Target> {
+    std::unique_lock lock{mutex_};
+    if (++selections_ % kExploreEvery == 0) return std::nullopt;
+
+    const std::pair<const PeerId, Peer>* best = nullptr;
+    for (auto& entry : peers_) {
+        Peer& peer = entry.second;
+        expire_requests(peer, tp);
+        if (peer.stats.samples == 0 || peer.stats.items_per_sec <= 0) continue;
+        if (peer.outstanding.size() >= kPerPeerMaxOutstandingRequests) continue;
+        if (best == nullptr || peer.stats.items_per_sec > best->second.stats.items_per_sec) best = &entry;
+    }
+    if (best == nullptr) return std::nullopt;
+
+    const double deliverable = best->second.stats.items_per_sec * static_cast<double>(kTargetResponseTime.count());
+    const size_t items = std::clamp(static_cast<size_t>(deliverable), std::min(kMinItemsPerRequest, max_items),
+                                    max_items);
+    return Target{best->first, best->second.height, items};
+}
+
+auto PeerTracker::idle_peers(time_point_t tp) -> std::vector<IdlePeer> {
+    std::unique_lock lock{mutex_};
+    std::vector<std::pair<double, IdlePeer>> ranked;  // by throughput, 0 if not measured
+    for (auto& [peer_id, peer] : peers_) {
+        expire_requests(peer, tp);
+        if (peer.outstanding.size() >= kPerPeerMaxOutstandingRequests) continue;
+        const double throughput = peer.stats.samples > 0 ? peer.stats.items_per_sec : 0;
+        ranked.push_back({throughput, {peer_id, peer.height, kPerPeerMaxOutstandingRequests - peer.outstanding.size()}});
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& x, const auto& y) { return x.first > y.first; });
+
+    std::vector<IdlePeer> idle;
+    idle.reserve(ranked.size());
+    for (auto& entry : ranked) idle.push_back(std::move(entry.second));
+    return idle;
+}
+
+milliseconds_t PeerTracker::hedge_delay() const {
+    std::unique_lock lock{mutex_};
+    std::vector<double> rtts;
+    for (const auto& entry : peers_) {
+        if (entry.second.stats.samples > 0) rtts.push_back(entry.second.stats.rtt_ms);
+    }
+    if (rtts.empty()) return request_deadline_;  // no clue: wait for the deadline
+
+    auto median = rtts.begin() + static_cast<std::ptrdiff_t>(rtts.size() / 2);
+    std::nth_element(rtts.begin(), median, rtts.end());
+    const auto delay = milliseconds_t{static_cast<milliseconds_t::rep>(3 * *median)};
+    return std::clamp<milliseconds_t>(delay, kMinHedgeDelay, request_deadline_);
+}
+
+auto PeerTracker::stats(const PeerId& peer_id) const -> std::optional<PeerStats> {
+    std::unique_lock lock{mutex_};
+    auto p = peers_.find(peer_id);
+    if (p == peers_.end()) return std::nullopt;
+    return p->second.stats;
+}
+
+double PeerTracker::window_occupancy(time_point_t tp) const {
+    std::unique_lock lock{mutex_};
+    if (peers_.empty()) return 0;
+    size_t outstanding = 0;
+    for (const auto& entry : peers_) {
+        for (const auto& request : entry.second.outstanding) {
+            if (tp - request.sent < request_deadline_) ++outstanding;
+        }
+    }
+    return static_cast<double>(outstanding) / static_cast<double>(peers_.size() * kPerPeerMaxOutstandingRequests);
+}
+
+void PeerTracker::expire_requests(Peer& peer, time_point_t tp) {
+    const auto deadline_ms = std::chrono::duration<double, std::milli>(request_deadline_).count();
+    std::erase_if(peer.outstanding, [&](const Request& request) {
+        if (tp - request.sent < request_deadline_) return false;
+        add_sample(peer.stats, deadline_ms, 0);  // as if it answered at deadline with nothing
+        ++peer.stats.timeouts;
+        return true;
+    });
+}
+
+void PeerTracker::add_sample(PeerStats& stats, double rtt_ms, double items_per_sec) {
+    if (stats.samples == 0) {
+        stats.rtt_ms = rtt_ms;
+        stats.items_per_sec = items_per_sec;
+    } else {
+        stats.rtt_ms += kSmoothing * (rtt_ms - stats.rtt_ms);
+        stats.items_per_sec += kSmoothing * (items_per_sec - stats.items_per_sec);
+    }
+    ++stats.samples;
+}
+
+}  // namespace silkworm
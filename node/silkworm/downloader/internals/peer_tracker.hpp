@@ -0,0 +1,104 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "types.hpp"
+
+namespace silkworm {
+
+/** PeerTracker keeps per-peer estimates of round-trip time and throughput, learned matching the requests we send
+ *  with the responses we receive, so that requests can be aimed at the fastest peers and sized on their capacity.
+ *  It is fed by the SentryClient (peer disconnections) and by the downloader messages (requests sent, responses
+ *  received, block heights seen) that run on different threads, so it is thread safe.
+ */
+class PeerTracker {
+  public:
+    static constexpr double kSmoothing = 0.25;                // weight of the newest sample in the moving averages
+    static constexpr size_t kPerPeerMaxOutstandingRequests = 4;  // a peer with so many pending requests is busy
+    static constexpr size_t kExploreEvery = 4;  // one selection out of kExploreEvery is left to the sentry, so that
+                                                // peers not measured yet (or after a bad streak) get requests too
+    static constexpr size_t kMinItemsPerRequest = 16;
+    static constexpr seconds_t kTargetResponseTime{2};    // requests are sized to be served within this time
+    static constexpr milliseconds_t kMinHedgeDelay{1000};  // lower bound of hedge_delay()
+
+    explicit PeerTracker(seconds_t request_deadline = seconds_t{30});
+
+    void on_connect(const PeerId&);
+    void on_disconnect(const PeerId&);
+    void on_height(const PeerId&, BlockNum);  // the peer has (at least) this block
+    void on_request(const PeerId&, uint64_t request_id, size_t items, time_point_t);
+    //! \return the round-trip time in milliseconds, if the response matches a request
+    auto on_response(const PeerId&, uint64_t request_id, size_t items, time_point_t) -> std::optional<double>;
+
+    struct Target {
+        PeerId peer_id;
+        BlockNum height;   // highest block the peer is known to have
+        size_t max_items;  // how many items to request to the peer
+    };
+    //! Selects the fastest measured peer that is not busy
+    //! \return nullopt when there is no such peer or when this request must go to a peer chosen by the sentry
+    auto select(size_t max_items, time_point_t) -> std::optional<Target>;
+
+    struct IdlePeer {
+        PeerId peer_id;
+        BlockNum height;    // highest block the peer is known to have, 0 if not known yet
+        size_t free_slots;  // requests the peer can still take
+    };
+    //! Peers that are not busy, the measured ones fastest first, then the others
+    auto idle_peers(time_point_t) -> std::vector<IdlePeer>;
+
+    //! After this delay an outstanding request is likely to be among the slowest and worth being duplicated
+    [[nodiscard]] milliseconds_t hedge_delay() const;
+
+    struct PeerStats {
+        double rtt_ms{0};         // moving average of the round-trip time
+        double items_per_sec{0};  // moving average of the throughput
+        size_t samples{0};        // responses received and requests expired
+        size_t timeouts{0};       // requests without response within the deadline
+    };
+    [[nodiscard]] auto stats(const PeerId&) const -> std::optional<PeerStats>;
+
+    //! Outstanding requests (not expired) over what the tracked peers can take, from 0 to 1
+    [[nodiscard]] double window_occupancy(time_point_t) const;
+
+  private:
+    struct Request {
+        uint64_t id;
+        size_t items;
+        time_point_t sent;
+    };
+    struct Peer {
+        BlockNum height{0};
+        PeerStats stats;
+        std::vector<Request> outstanding;
+    };
+
+    void expire_requests(Peer&, time_point_t);  // requests without response past the deadline count as failures
+    static void add_sample(PeerStats&, double rtt_ms, double items_per_sec);
+
+    const seconds_t request_deadline_;
+    mutable std::mutex mutex_;  // guards the members below
+    std::map<PeerId, Peer> peers_;
+    size_t selections_{0};
+};
+
+}  // namespace silkworm
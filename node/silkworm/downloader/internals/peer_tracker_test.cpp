@@ -0,0 +1,144 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "peer_tracker.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("PeerTracker") {
+    using namespace std::chrono_literals;
+
+    PeerTracker tracker{/*request_deadline=*/30s};
+    time_point_t tp = std::chrono::system_clock::now();
+
+    SECTION("no statistics") {
+        CHECK_FALSE(tracker.select(128, tp));
+        CHECK(tracker.hedge_delay() == 30s);
+        CHECK_FALSE(tracker.stats("1"));
+    }
+
+    SECTION("responses are matched with requests") {
+        tracker.on_request("1", 10, 128, tp);
+        tracker.on_response("1", 11, 128, tp + 1s);  // not requested
+        CHECK(tracker.stats("1")->samples == 0);
+
+        tracker.on_response("1", 10, 128, tp + 1s);
+        auto stats = tracker.stats("1");
+        REQUIRE(stats);
+        CHECK(stats->samples == 1);
+        CHECK(stats->rtt_ms == Approx(1000));
+        CHECK(stats->items_per_sec == Approx(128));
+
+        tracker.on_response("1", 10, 128, tp + 2s);  // duplicated
+        CHECK(tracker.stats("1")->samples == 1);
+    }
+
+    SECTION("the fastest peer is selected and requests are sized on its throughput") {
+        tracker.on_height("1", 1'000);
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_response("1", 1, 128, tp + 4s);  // 32 items/s
+        tracker.on_request("2", 2, 128, tp);
+        tracker.on_response("2", 2, 128, tp + 8s);  // 16 items/s
+
+        auto target = tracker.select(128, tp + 8s);
+        REQUIRE(target);
+        CHECK(target->peer_id == "1");
+        CHECK(target->height == 1'000);
+        CHECK(target->max_items == 64);  // served in kTargetResponseTime
+
+        CHECK(tracker.hedge_delay() == 24s);  // 3 times the median rtt
+    }
+
+    SECTION("busy peers are not selected") {
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_response("1", 1, 128, tp + 100ms);
+        for (uint64_t i = 2; i < 2 + PeerTracker::kPerPeerMaxOutstandingRequests; i++) {
+            tracker.on_request("1", i, 128, tp);
+        }
+        CHECK_FALSE(tracker.select(128, tp + 200ms));
+        CHECK(tracker.hedge_delay() == PeerTracker::kMinHedgeDelay);
+    }
+
+    SECTION("requests without response expire") {
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_response("1", 1, 128, tp + 100ms);
+        tracker.on_request("1", 2, 128, tp);
+        CHECK(tracker.select(128, tp + 40s));  // request 2 expired, peer 1 is still the fastest one seen
+        auto stats = tracker.stats("1");
+        CHECK(stats->timeouts == 1);
+        CHECK(stats->items_per_sec < 1280);
+
+        tracker.on_response("1", 2, 128, tp + 41s);  // too late
+        CHECK(tracker.stats("1")->samples == 2);
+    }
+
+    SECTION("selections are left to the sentry now and then") {
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_response("1", 1, 128, tp + 100ms);
+        size_t left_to_sentry = 0;
+        for (size_t i = 0; i < 4 * PeerTracker::kExploreEvery; i++) {
+            if (!tracker.select(128, tp)) left_to_sentry++;
+        }
+        CHECK(left_to_sentry == 4);
+    }
+
+    SECTION("disconnected peers are forgotten") {
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_response("1", 1, 128, tp + 100ms);
+        tracker.on_disconnect("1");
+        CHECK_FALSE(tracker.stats("1"));
+        CHECK_FALSE(tracker.select(128, tp));
+    }
+
+    SECTION("window occupancy") {
+        CHECK(tracker.window_occupancy(tp) == 0);
+        tracker.on_request("1", 1, 128, tp);
+        tracker.on_request("1", 2, 128, tp);
+        tracker.on_height("2", 100);
+        CHECK(tracker.window_occupancy(tp) == 2.0 / (2 * PeerTracker::kPerPeerMaxOutstandingRequests));
+        CHECK(tracker.on_response("1", 1, 128, tp + 100ms) == 100);
+        CHECK_FALSE(tracker.on_response("1", 1, 128, tp + 100ms));  // duplicated
+        CHECK(tracker.window_occupancy(tp + 100ms) == 1.0 / (2 * PeerTracker::kPerPeerMaxOutstandingRequests));
+        CHECK(tracker.window_occupancy(tp + 40s) == 0);  // expired
+    }
+
+    SECTION("idle peers") {
+        tracker.on_connect("1");
+        tracker.on_request("2", 1, 128, tp);
+        tracker.on_response("2", 1, 128, tp + 1s);
+        tracker.on_height("2", 1'000);
+        for (uint64_t id = 10; id < 10 + PeerTracker::kPerPeerMaxOutstandingRequests; ++id) {
+            tracker.on_request("3", id, 128, tp);
+        }
+        tracker.on_request("4", 20, 128, tp);
+        tracker.on_response("4", 20, 128, tp + 4s);  // slower than "2"
+        tracker.on_request("4", 21, 128, tp + 4s);
+
+        auto idle = tracker.idle_peers(tp + 4s);
+        REQUIRE(idle.size() == 3);  // "3" is busy
+        CHECK(idle[0].peer_id == "2");
+        CHECK(idle[0].height == 1'000);
+        CHECK(idle[0].free_slots == PeerTracker::kPerPeerMaxOutstandingRequests);
+        CHECK(idle[1].peer_id == "4");
+        CHECK(idle[1].free_slots == PeerTracker::kPerPeerMaxOutstandingRequests - 1);
+        CHECK(idle[2].peer_id == "1");  // not measured yet
+        CHECK(idle[2].height == 0);
+    }
+}
+
+}  // namespace silkworm
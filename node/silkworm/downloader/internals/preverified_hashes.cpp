@@ -16,38 +16,120 @@
 
 #include "preverified_hashes.hpp"
 
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+
+#ifndef SILKWORM_NO_EMBEDDED_PREVERIFIED_HASHES
 extern const uint64_t* preverified_hashes_mainnet_data();
 extern size_t sizeof_preverified_hashes_mainnet_data();
 extern uint64_t preverified_hashes_mainnet_height();
+#endif
 
 namespace silkworm {
 
+namespace bip = boost::interprocess;
+
 PreverifiedHashes PreverifiedHashes::none = {};
 
-void load_preverified_hashes(PreverifiedHashes& destination, const uint64_t* (*preverified_hashes_data)(),
-                             size_t (*sizeof_preverified_hashes_data)(), uint64_t (*preverified_hashes_height)()) {
-    auto data_size = sizeof_preverified_hashes_data();
-    if (data_size == 0) return;
+namespace {
+
+    constexpr size_t kFileHeaderSize{PreverifiedHashes::kFileMagic.size() + 3 * sizeof(uint64_t)};
+
+    [[maybe_unused]] void load_preverified_hashes(PreverifiedHashes& destination,
+                                                  const uint64_t* (*preverified_hashes_data)(),
+                                                  size_t (*sizeof_preverified_hashes_data)(),
+                                                  uint64_t (*preverified_hashes_height)()) {
+        auto data_size = sizeof_preverified_hashes_data();
+        if (data_size == 0) return;
 
-    auto data_ptr = reinterpret_cast<const evmc::bytes32*>(preverified_hashes_data());
-    auto num_elements{data_size / sizeof(evmc::bytes32)};
+        auto data_ptr = reinterpret_cast<const evmc::bytes32*>(preverified_hashes_data());
+        std::span<const evmc::bytes32> data{data_ptr, data_size / sizeof(evmc::bytes32)};
 
-    for (uint64_t i = 0; i < num_elements; ++i) {
-        destination.hashes.insert(data_ptr[i]);
+        if (std::is_sorted(data.begin(), data.end())) {
+            destination.sorted_hashes = data;  // in place, static storage
+        } else {
+            auto sorted = std::make_shared<std::vector<evmc::bytes32>>(data.begin(), data.end());
+            std::sort(sorted->begin(), sorted->end());
+            destination.sorted_hashes = *sorted;
+            destination.storage = std::move(sorted);
+        }
+
+        destination.height = preverified_hashes_height();
     }
 
-    destination.height = preverified_hashes_height();
-}
+}  // namespace
 
-PreverifiedHashes PreverifiedHashes::load(uint64_t chain_id) {
+PreverifiedHashes PreverifiedHashes::load([[maybe_unused]] uint64_t chain_id) {
     PreverifiedHashes result{};
 
+#ifndef SILKWORM_NO_EMBEDDED_PREVERIFIED_HASHES
     if (chain_id == 1) {
         load_preverified_hashes(result, preverified_hashes_mainnet_data, sizeof_preverified_hashes_mainnet_data,
                                 preverified_hashes_mainnet_height);
     }
+#endif
 
     return result;
 }
 
+PreverifiedHashes PreverifiedHashes::load_file(const std::filesystem::path& file_path) {
+    auto invalid = [&](const std::string& reason) {
+        return std::runtime_error("invalid pre-verified hashes file " + file_path.string() + ": " + reason);
+    };
+
+    auto region = std::make_shared<bip::mapped_region>();
+    try {
+        bip::file_mapping file{file_path.string().c_str(), bip::read_only};
+        *region = bip::mapped_region{file, bip::read_only};  // the mapping outlives the file handle
+    } catch (const bip::interprocess_exception& ex) {
+        throw invalid(ex.what());
+    }
+    (void)region->advise(bip::mapped_region::advice_random);  // binary search
+
+    ByteView data{static_cast<const uint8_t*>(region->get_address()), region->get_size()};
+    if (data.size() < kFileHeaderSize || data.substr(0, kFileMagic.size()) != string_view_to_byte_view(kFileMagic)) {
+        throw invalid("unknown format");
+    }
+    data.remove_prefix(kFileMagic.size());
+    const uint64_t height{endian::load_little_u64(&data[0])};
+    const uint64_t count{endian::load_little_u64(&data[2 * sizeof(uint64_t)])};
+    data.remove_prefix(3 * sizeof(uint64_t));
+    if (data.size() / sizeof(evmc::bytes32) != count || data.size() % sizeof(evmc::bytes32) != 0) {
+        throw invalid("truncated");
+    }
+
+    PreverifiedHashes result{};
+    result.height = height;
+    result.sorted_hashes = {reinterpret_cast<const evmc::bytes32*>(data.data()), count};
+    if (!std::is_sorted(result.sorted_hashes.begin(), result.sorted_hashes.end())) {
+        throw invalid("hashes not sorted");
+    }
+    result.storage = std::move(region);
+    return result;
+}
+
+void PreverifiedHashes::write_file(const std::filesystem::path& file_path, std::vector<evmc::bytes32> hashes,
+                                   uint64_t height, uint64_t step) {
+    std::sort(hashes.begin(), hashes.end());
+
+    Bytes header(kFileHeaderSize, '\0');
+    std::memcpy(header.data(), kFileMagic.data(), kFileMagic.size());
+    endian::store_little_u64(&header[kFileMagic.size()], height);
+    endian::store_little_u64(&header[kFileMagic.size() + sizeof(uint64_t)], step);
+    endian::store_little_u64(&header[kFileMagic.size() + 2 * sizeof(uint64_t)], hashes.size());
+
+    std::ofstream out{file_path, std::ios_base::binary | std::ios_base::trunc};
+    out.write(byte_ptr_cast(header.data()), static_cast<std::streamsize>(header.size()));
+    out.write(reinterpret_cast<const char*>(hashes.data()),
+              static_cast<std::streamsize>(hashes.size() * sizeof(evmc::bytes32)));
+    if (!out) throw std::runtime_error("unable to write pre-verified hashes file " + file_path.string());
+}
+
 }  // namespace silkworm
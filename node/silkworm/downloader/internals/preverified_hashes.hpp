@@ -16,9 +16,14 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
 #include <set>
+#include <span>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include <silkworm/common/base.hpp>
 
@@ -32,23 +37,44 @@ namespace silkworm {
  * But in practice, it makes sense to have a lot of them so that verification does not require loading the entire header
  * chain first.
  *
- * The set of pre-verified hashes must be generated with the toolbox utility provided with Silkworm and added manually
- * to the build of Silkworm. This is a task that will be accomplished by Silkworm authors that know which set of header
- * to add. The toolbox generate a .cpp file for a chain using headers in the chain local db. The generated file contains
- * the code that initialise a static instance of PreverifiedHashes so this instance must be listed here, as member of
- * the PreverifiedHashes class, like mainnet below. For the mainnet is already provided a file
- * preverified_hashes_mainnet.cpp
- *
+ * The set of pre-verified hashes must be generated with the toolbox utility provided with Silkworm, from the headers in
+ * the chain local db. It comes in two forms:
+ * - a generated .cpp file that initialises a static array, compiled in the build of Silkworm (unless the CMake option
+ *   SILKWORM_EMBED_PREVERIFIED_HASHES is OFF); the instance must be listed here, in load(), like mainnet. For the
+ *   mainnet is already provided a file preverified_hashes_mainnet.cpp
+ * - a binary file, see load_file(), that is memory-mapped and can be updated without recompiling
+ * In both cases hashes are looked up with a binary search in a sorted array, not copied into a set on startup (an
+ * embedded array generated unsorted, by older versions of the toolbox, is copied and sorted once).
  */
 
 struct PreverifiedHashes {
     std::set<evmc::bytes32> hashes;  // Set of hashes of headers that are known to belong to canonical chain
     uint64_t height{0};              // Block height corresponding to the highest pre-verified header
+    std::span<const evmc::bytes32> sorted_hashes{};  // More of them, in a sorted array (embedded or mapped)
+    std::shared_ptr<const void> storage{};           // Owner of the memory of sorted_hashes, if any
 
-    [[nodiscard]] bool contains(const evmc::bytes32& hash) const { return hashes.find(hash) != hashes.end(); }
+    [[nodiscard]] bool contains(const evmc::bytes32& hash) const {
+        return hashes.contains(hash) || std::binary_search(sorted_hashes.begin(), sorted_hashes.end(), hash);
+    }
 
     static PreverifiedHashes load(uint64_t chain_id); // Load a set of pre-verified hashes from low level impl
     static PreverifiedHashes none;
+
+    /* Binary file format, integers are little endian:
+     *   8 bytes: kFileMagic
+     *   8 bytes: height, the block height of the highest pre-verified header
+     *   8 bytes: step, the distance in blocks between consecutive pre-verified headers
+     *   8 bytes: count of hashes
+     *   count * 32 bytes: hashes in ascending order
+     */
+    static constexpr std::string_view kFileMagic{"SWPVHSH1"};
+
+    //! Maps the file, hashes are looked up in place
+    //! \throws std::runtime_error if the file cannot be mapped or it is not a valid file of pre-verified hashes
+    static PreverifiedHashes load_file(const std::filesystem::path& file_path);
+    //! Writes hashes (in any order) in the binary file format
+    static void write_file(const std::filesystem::path& file_path, std::vector<evmc::bytes32> hashes, uint64_t height,
+                           uint64_t step);
 };
 
 }  // namespace silkworm
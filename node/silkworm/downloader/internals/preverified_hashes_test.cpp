@@ -0,0 +1,69 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "preverified_hashes.hpp"
+
+#include <fstream>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/directories.hpp>
+
+namespace silkworm {
+
+TEST_CASE("PreverifiedHashes") {
+    using evmc::literals::operator""_bytes32;
+
+    TemporaryDirectory tmp_dir;
+    const auto file_path = tmp_dir.path() / "preverified_hashes.bin";
+
+    const auto hash1 = 0xd4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3_bytes32;
+    const auto hash2 = 0x88e96d4537bea4d9c05d12549907b32561d3bf31f45aae734cdc119f13406cb6_bytes32;
+    const auto hash3 = 0xb495a1d7e6663152ae92708da4843337b958146015a2802f4193a410044698c9_bytes32;
+    const auto other = 0x3d6122660cc824376f11ee842f83addc3525e2dd6756b9bcf0affa6aa88cf741_bytes32;
+
+    SECTION("binary file") {
+        PreverifiedHashes::write_file(file_path, {hash1, hash2, hash3}, /*height=*/2 * 192, /*step=*/192);
+
+        const auto preverified_hashes = PreverifiedHashes::load_file(file_path);
+        CHECK(preverified_hashes.height == 2 * 192);
+        CHECK(preverified_hashes.sorted_hashes.size() == 3);
+        CHECK(preverified_hashes.contains(hash1));
+        CHECK(preverified_hashes.contains(hash2));
+        CHECK(preverified_hashes.contains(hash3));
+        CHECK_FALSE(preverified_hashes.contains(other));
+    }
+
+    SECTION("invalid binary files") {
+        CHECK_THROWS_AS(PreverifiedHashes::load_file(file_path), std::runtime_error);  // missing
+
+        PreverifiedHashes::write_file(file_path, {hash1, hash2}, 192, 192);
+        std::filesystem::resize_file(file_path, std::filesystem::file_size(file_path) - 1);
+        CHECK_THROWS_AS(PreverifiedHashes::load_file(file_path), std::runtime_error);  // truncated
+
+        std::ofstream{file_path, std::ios_base::binary | std::ios_base::trunc} << "not a file of hashes";
+        CHECK_THROWS_AS(PreverifiedHashes::load_file(file_path), std::runtime_error);  // unknown format
+    }
+
+    SECTION("in memory") {
+        PreverifiedHashes preverified_hashes{{hash1}, 0};
+        CHECK(preverified_hashes.contains(hash1));
+        CHECK_FALSE(preverified_hashes.contains(hash2));
+        CHECK_FALSE(PreverifiedHashes::none.contains(hash1));
+    }
+}
+
+}  // namespace silkworm
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <queue>
 #include <set>
+#include <utility>
 #include <vector>
 
 /*
@@ -68,6 +71,131 @@ class heap_based_priority_queue : public std::priority_queue<T, SEQ, CMP> {
     void fix() { std::make_heap(this->c.begin(), this->c.end(), this->comp); }
 };
 
+/*
+ * An intrusive 4-ary heap whose top is the first element according to CMP (as in set_based_priority_queue)
+ * Each element tracks its own position in the heap, in the size_t field INDEX returns a reference to, hence any element
+ * can be erased or re-positioned after a change of its priority in O(log n), with no search and no allocation per
+ * element. An element is held at most once (pushing it again just re-positions it) and by one queue at a time:
+ * its index field is kNotQueued when outside. For the same reason queues are movable but not copyable
+ *
+ * Sample usage:
+ *   struct Link { BlockNum blockHeight; size_t queue_index{kNotQueued}; ... };
+ *   indexed_priority_queue<std::shared_ptr<Link>, LinkOlderThan> queue;
+ */
+inline constexpr size_t kNotQueued{std::numeric_limits<size_t>::max()};
+
+struct queue_index_of {  // default INDEX: the queue_index field of a pointed-to element
+    template <typename P>
+    size_t& operator()(const P& element) const {
+        return element->queue_index;
+    }
+};
+
+template <typename T, typename CMP, typename INDEX = queue_index_of>
+class indexed_priority_queue {
+    static constexpr size_t kArity{4};  // Shallower than a binary heap, and children share cache lines
+
+    std::vector<T> elements_;
+    CMP cmp_;
+    INDEX index_;
+
+  public:
+    indexed_priority_queue() = default;
+    indexed_priority_queue(indexed_priority_queue&& other) noexcept : elements_{std::move(other.elements_)} {
+        other.elements_.clear();  // elements now belong to this queue
+    }
+    indexed_priority_queue& operator=(indexed_priority_queue&& other) noexcept {
+        clear();
+        elements_ = std::move(other.elements_);
+        other.elements_.clear();
+        return *this;
+    }
+    indexed_priority_queue(const indexed_priority_queue&) = delete;
+    indexed_priority_queue& operator=(const indexed_priority_queue&) = delete;
+    ~indexed_priority_queue() { clear(); }
+
+    [[nodiscard]] const T& top() const { return elements_.front(); }
+    void pop() { erase_at(0); }
+    void push(const T& element) {
+        if (contains(element)) {
+            update(element);
+            return;
+        }
+        elements_.push_back(element);
+        index_(element) = elements_.size() - 1;
+        sift_up(elements_.size() - 1);
+    }
+    bool erase(const T& element) {
+        if (!contains(element)) return false;
+        erase_at(index_(element));
+        return true;
+    }
+    // restore the heap invariant after a change of the priority of element (no-op if not queued)
+    void update(const T& element) {
+        if (!contains(element)) return;
+        const size_t position{index_(element)};
+        if (!sift_up(position)) sift_down(position);
+    }
+    void clear() {
+        for (auto& element : elements_) index_(element) = kNotQueued;
+        elements_.clear();
+    }
+    [[nodiscard]] size_t size() const { return elements_.size(); }
+    [[nodiscard]] bool empty() const { return elements_.empty(); }
+    [[nodiscard]] bool contains(const T& element) const {
+        const size_t position{index_(element)};
+        return position < elements_.size() && elements_[position] == element;
+    }
+
+    void push_all(const std::vector<T>& source) { for (auto& element: source) push(element); } // bulk insert
+
+  private:
+    void erase_at(size_t position) {
+        index_(elements_[position]) = kNotQueued;
+        const size_t last{elements_.size() - 1};
+        if (position != last) {
+            elements_[position] = std::move(elements_[last]);
+            index_(elements_[position]) = position;
+        }
+        elements_.pop_back();
+        if (position < elements_.size() && !sift_up(position)) sift_down(position);
+    }
+
+    // moves the element at position up while it comes before its parent, returns whether it moved
+    bool sift_up(size_t position) {
+        const size_t start{position};
+        while (position > 0) {
+            const size_t parent{(position - 1) / kArity};
+            if (!cmp_(elements_[position], elements_[parent])) break;
+            swap_at(position, parent);
+            position = parent;
+        }
+        return position != start;
+    }
+
+    // moves the element at position down while a child comes before it
+    void sift_down(size_t position) {
+        while (true) {
+            const size_t first_child{position * kArity + 1};
+            if (first_child >= elements_.size()) break;
+            size_t best{first_child};
+            const size_t end{std::min(first_child + kArity, elements_.size())};
+            for (size_t child{first_child + 1}; child < end; ++child) {
+                if (cmp_(elements_[child], elements_[best])) best = child;
+            }
+            if (!cmp_(elements_[best], elements_[position])) break;
+            swap_at(position, best);
+            position = best;
+        }
+    }
+
+    void swap_at(size_t a, size_t b) {
+        std::swap(elements_[a], elements_[b]);
+        index_(elements_[a]) = a;
+        index_(elements_[b]) = b;
+    }
+};
+
 /*
  * A multimap based priority_queue for ease removal of elements
  *
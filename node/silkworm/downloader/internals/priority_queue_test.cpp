@@ -98,7 +98,7 @@ TEST_CASE("Oldest_First_Anchor_Queue") {
         REQUIRE((queue.top()->timestamp == now + 5s && queue.top()->blockHeight == 1));
 
         // let fix it
-        queue.fix();
+        queue.update(top_anchor);
         REQUIRE(
             (queue.top()->timestamp == now && queue.top()->blockHeight == 3));  // now 2nd anchor is the new top anchor
         REQUIRE(queue.size() == 4);
@@ -146,10 +146,14 @@ TEST_CASE("Oldest_First_Anchor_Queue - siblings handling") {
     queue.erase(anchor2);           // erase only 1 element using identity, not block number
     REQUIRE(queue.size() == 1);
 
-    queue.push(anchor1);            // add the same object, same identity
+    queue.push(anchor2);            // add the sibling again
     REQUIRE(queue.size() == 2);     // it should be present
+    queue.push(anchor1);            // add the same object, same identity
+    REQUIRE(queue.size() == 2);     // it is held once
     queue.erase(anchor1);           // erase 1 element only
-    REQUIRE(queue.size() == 1);     
+    REQUIRE(queue.size() == 1);
+    REQUIRE(queue.top() == anchor2);
+    REQUIRE(!queue.erase(anchor1));  // no longer there
 }
 
 TEST_CASE("Youngest_First_Link_Queue") {
@@ -266,9 +270,9 @@ TEST_CASE("Oldest_First_Link_Queue") {
     SECTION("siblings, same identity") {
         REQUIRE(queue.size() == 4);
 
-        queue.push(link1);  // again, same identity
+        queue.push(link1);  // again, same identity: held once
 
-        REQUIRE(queue.size() == 5);
+        REQUIRE(queue.size() == 4);
         bool link1_present = queue.contains(link1);
         REQUIRE(link1_present == true);
     }
@@ -294,6 +298,51 @@ TEST_CASE("Oldest_First_Link_Queue") {
     }
 }
 
+TEST_CASE("indexed_priority_queue - random operations") {
+    struct Item {
+        int value{0};
+        size_t queue_index{kNotQueued};
+    };
+    struct ItemLess {
+        bool operator()(const std::shared_ptr<Item>& x, const std::shared_ptr<Item>& y) const {
+            return x->value < y->value;
+        }
+    };
+
+    std::vector<std::shared_ptr<Item>> items;
+    for (int i{0}; i < 200; ++i) {
+        items.push_back(std::make_shared<Item>(Item{(i * 7919) % 1000}));
+    }
+    indexed_priority_queue<std::shared_ptr<Item>, ItemLess> queue;
+    queue.push_all(items);
+    REQUIRE(queue.size() == items.size());
+
+    // Change, erase and re-push arbitrary elements
+    for (size_t i{0}; i < items.size(); i += 3) {
+        items[i]->value = static_cast<int>((i * 104729) % 1000);
+        queue.update(items[i]);
+    }
+    for (size_t i{1}; i < items.size(); i += 5) {
+        REQUIRE(queue.erase(items[i]));
+        REQUIRE(items[i]->queue_index == kNotQueued);
+    }
+    for (size_t i{1}; i < items.size(); i += 10) {
+        queue.push(items[i]);
+    }
+
+    auto moved{std::move(queue)};
+    REQUIRE(queue.empty());  // NOLINT(bugprone-use-after-move)
+    std::vector<int> popped;
+    while (!moved.empty()) {
+        popped.push_back(moved.top()->value);
+        REQUIRE(moved.contains(moved.top()));
+        moved.pop();
+    }
+    CHECK(popped.size() == items.size() - 20);
+    CHECK(std::is_sorted(popped.begin(), popped.end()));
+    CHECK(std::all_of(items.begin(), items.end(), [](const auto& item) { return item->queue_index == kNotQueued; }));
+}
+
 TEST_CASE("Oldest_First_Link_Map") {
     using namespace std::literals::chrono_literals;
     BlockHeader dummy_header;
@@ -350,9 +399,9 @@ TEST_CASE("Oldest_First_Link_Map") {
     SECTION("siblings, same identity") {
         REQUIRE(queue.size() == 4);
 
-        queue.push(link1);  // again, same identity
+        queue.push(link1);  // again, same identity: held once
 
-        REQUIRE(queue.size() == 5);
+        REQUIRE(queue.size() == 4);
         bool link1_present = queue.contains(link1);
         REQUIRE(link1_present == true);
 
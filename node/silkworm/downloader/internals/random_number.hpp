@@ -15,6 +15,7 @@
 */
 
 #pragma once
+#include <mutex>
 #include <random>
 
 #include "singleton.hpp"
@@ -24,6 +25,7 @@ namespace silkworm {
 class RandomNumber {
     std::mt19937_64 generator_;                      // the 64-bit Mersenne Twister 19937 generator
     std::uniform_int_distribution<uint64_t> distr_;  // a uniform distribution
+    std::mutex mutex_;                               // messages get built on different threads
 
   public:
     RandomNumber() {
@@ -36,7 +38,10 @@ class RandomNumber {
         generator_.seed(rd());  // init generator_ with a random seed
     }
 
-    uint64_t generate_one() { return distr_(generator_); }
+    uint64_t generate_one() {
+        std::scoped_lock lock(mutex_);
+        return distr_(generator_);
+    }
 };
 
 #define RANDOM_NUMBER default_instantiating::Singleton<RandomNumber>::instance()
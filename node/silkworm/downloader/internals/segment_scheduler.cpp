@@ -0,0 +1,129 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "segment_scheduler.hpp"
+
+#include <algorithm>
+
+namespace silkworm {
+
+auto SegmentScheduler::schedule(BlockNum highest_in_db, BlockNum top_seen,
+                                const std::vector<PeerTracker::IdlePeer>& idle_peers, time_point_t tp,
+                                seconds_t timeout, const std::function<uint64_t()>& generate_request_id)
+    -> std::vector<Assignment> {
+    // segments that reached the db are done, whatever their state
+    for (auto s = segments_.begin(); s != segments_.end() && s->first <= highest_in_db;) {
+        if (s->second.state == State::Requested) requests_.erase(s->second.request_id);
+        s = segments_.erase(s);
+    }
+
+    // whole segments only: the tip is left to the anchor extension and to the announcements
+    BlockNum next_top = top_of(highest_in_db + 1);
+    for (size_t i = 0; i < kLookahead && next_top <= top_seen; ++i, next_top += kSegmentLength) {
+        segments_.try_emplace(next_top);
+    }
+
+    for (auto& [top, entry] : segments_) {
+        if (entry.state == State::Requested && entry.deadline <= tp) fail(entry);
+    }
+
+    // a slot for each request the idle peers can take: first one per peer, then a second one per peer and so on
+    std::vector<const PeerTracker::IdlePeer*> slots;
+    for (size_t round = 0;; ++round) {
+        const size_t previous_size = slots.size();
+        for (const auto& peer : idle_peers) {
+            if (peer.free_slots > round) slots.push_back(&peer);
+        }
+        if (slots.size() == previous_size) break;
+    }
+
+    std::vector<Assignment> assignments;
+    size_t unassigned = 0;
+    for (auto& [top, entry] : segments_) {
+        if (entry.state != State::Pending) continue;
+
+        auto slot = std::find_if(slots.begin(), slots.end(), [&, top = top](const PeerTracker::IdlePeer* peer) {
+            return (peer->height == 0 || peer->height >= top) &&  // height 0: not known yet
+                   std::find(entry.failed_peers.begin(), entry.failed_peers.end(), peer->peer_id) ==
+                       entry.failed_peers.end();
+        });
+        if (slot != slots.end()) {
+            entry.peer_id = (*slot)->peer_id;
+            slots.erase(slot);
+        } else if (unassigned < kMaxUnassignedPerRound) {
+            entry.peer_id.reset();
+            ++unassigned;
+        } else {
+            continue;
+        }
+
+        entry.amount = top - std::max(highest_in_db, top - kSegmentLength);
+        entry.state = State::Requested;
+        entry.request_id = generate_request_id();
+        entry.deadline = tp + timeout;
+        ++entry.attempts;
+        requests_[entry.request_id] = top;
+
+        GetBlockHeadersPacket66 packet{entry.request_id, {top, entry.amount, 0, true}};  // from top downwards
+        assignments.push_back({std::move(packet), entry.peer_id});
+    }
+
+    return assignments;
+}
+
+void SegmentScheduler::on_response(uint64_t request_id, const std::vector<BlockHeader>& headers) {
+    auto r = requests_.find(request_id);
+    if (r == requests_.end()) return;  // not for a segment, or too late
+    const BlockNum top = r->second;
+    Entry& entry = segments_.at(top);
+
+    const bool complete = headers.size() == entry.amount && headers.front().number == top;
+    if (!complete) {
+        fail(entry);  // the headers received are used anyway, but the segment is requested again
+        return;
+    }
+    entry.state = State::Complete;
+    requests_.erase(r);
+}
+
+void SegmentScheduler::on_nack(uint64_t request_id) {
+    auto r = requests_.find(request_id);
+    if (r == requests_.end()) return;
+    Entry& entry = segments_.at(r->second);
+    entry.state = State::Pending;
+    entry.peer_id.reset();
+    --entry.attempts;
+    requests_.erase(r);
+}
+
+bool SegmentScheduler::covers(BlockNum block) const {
+    auto s = segments_.find(top_of(block));
+    return s != segments_.end() && (s->second.state == State::Pending || s->second.state == State::Requested);
+}
+
+void SegmentScheduler::fail(Entry& entry) {
+    requests_.erase(entry.request_id);
+    if (entry.peer_id) entry.failed_peers.push_back(*entry.peer_id);
+    entry.peer_id.reset();
+    if (entry.attempts < kRetryBudget) {
+        entry.state = State::Pending;
+    } else {
+        entry.state = State::Abandoned;
+        ++abandoned_;
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,87 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <silkworm/downloader/packets/get_block_headers_packet.hpp>
+
+#include "peer_tracker.hpp"
+#include "types.hpp"
+
+namespace silkworm {
+
+/** SegmentScheduler fills the gap between the highest header in the db and the highest header seen with many
+ *  concurrent requests. The gap is split in fixed-size segments, aligned to multiples of kSegmentLength, and each
+ *  segment is requested top-down to a different peer, with its own deadline and retry budget. Responses need no
+ *  special treatment: the HeaderChain stitches them as any other segment, the top header of one becoming the parent of
+ *  the anchor of the one above. A segment that exhausts its budget is abandoned to the anchor extension.
+ *  Not thread safe, it is owned by the HeaderChain.
+ */
+class SegmentScheduler {
+  public:
+    static constexpr BlockNum kSegmentLength{192};        // headers per segment, i.e. per request
+    static constexpr size_t kLookahead{256};              // segments above the db that can be requested: each one may
+                                                          // become an anchor, so it must stay below the anchor limit
+    static constexpr size_t kRetryBudget{4};              // requests of a segment before it is abandoned
+    static constexpr size_t kMaxUnassignedPerRound{2};    // requests left to the sentry, to discover peers
+
+    struct Assignment {
+        GetBlockHeadersPacket66 packet;
+        std::optional<PeerId> peer_id;  // nullopt if the sentry must choose the peer
+    };
+
+    //! Requests for the segments of (highest_in_db, top_seen] not requested yet or whose request failed, lowest first,
+    //! spread over the idle peers (fastest first) so that they go to different peers as long as there are enough
+    auto schedule(BlockNum highest_in_db, BlockNum top_seen, const std::vector<PeerTracker::IdlePeer>& idle_peers,
+                  time_point_t, seconds_t timeout, const std::function<uint64_t()>& generate_request_id)
+        -> std::vector<Assignment>;
+
+    //! A segment is complete if the response has all of its headers, otherwise it will be requested to another peer
+    void on_response(uint64_t request_id, const std::vector<BlockHeader>&);
+    void on_nack(uint64_t request_id);  // the request was not sent, the attempt does not count
+
+    //! true if the block is in a segment that is requested or to be requested, so other requests for it are redundant
+    [[nodiscard]] bool covers(BlockNum) const;
+
+    [[nodiscard]] size_t in_flight() const { return requests_.size(); }
+    [[nodiscard]] size_t abandoned() const { return abandoned_; }
+
+  private:
+    enum class State { Pending, Requested, Complete, Abandoned };
+    struct Entry {
+        State state{State::Pending};
+        uint64_t request_id{0};
+        BlockNum amount{0};  // headers requested, less than kSegmentLength if the db is inside the segment
+        std::optional<PeerId> peer_id;
+        time_point_t deadline;
+        size_t attempts{0};
+        std::vector<PeerId> failed_peers;  // they are not asked again for this segment
+    };
+
+    void fail(Entry&);
+    static BlockNum top_of(BlockNum block) { return (block + kSegmentLength - 1) / kSegmentLength * kSegmentLength; }
+
+    std::map<BlockNum, Entry> segments_;     // by top block
+    std::map<uint64_t, BlockNum> requests_;  // top block of the segment by request id
+    size_t abandoned_{0};
+};
+
+}  // namespace silkworm
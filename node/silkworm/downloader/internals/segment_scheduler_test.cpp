@@ -0,0 +1,120 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "segment_scheduler.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("SegmentScheduler") {
+    using namespace std::chrono_literals;
+    constexpr BlockNum L = SegmentScheduler::kSegmentLength;
+
+    SegmentScheduler scheduler;
+    time_point_t tp = std::chrono::system_clock::now();
+    uint64_t request_id = 0;
+    auto generate_request_id = [&request_id] { return ++request_id; };
+
+    auto headers_from = [](BlockNum top, BlockNum amount) {
+        std::vector<BlockHeader> headers(amount);
+        for (BlockNum i = 0; i < amount; ++i) headers[i].number = top - i;
+        return headers;
+    };
+
+    const std::vector<PeerTracker::IdlePeer> peers{{"fast", 0, 2}, {"slow", 0, 1}};
+
+    SECTION("segments are spread over the peers, the lowest first") {
+        auto assignments = scheduler.schedule(/*highest_in_db=*/100, /*top_seen=*/10 * L, peers, tp, 5s,
+                                              generate_request_id);
+        // 3 slots, then requests left to the sentry
+        REQUIRE(assignments.size() == 3 + SegmentScheduler::kMaxUnassignedPerRound);
+        CHECK(assignments[0].peer_id == "fast");
+        CHECK(assignments[1].peer_id == "slow");
+        CHECK(assignments[2].peer_id == "fast");
+        CHECK_FALSE(assignments[3].peer_id);
+
+        const auto& lowest = assignments[0].packet;
+        CHECK(std::get<BlockNum>(lowest.request.origin) == L);
+        CHECK(lowest.request.amount == L - 100);  // not below the db
+        CHECK(lowest.request.reverse);
+        CHECK(std::get<BlockNum>(assignments[1].packet.request.origin) == 2 * L);
+        CHECK(assignments[1].packet.request.amount == L);
+
+        CHECK(scheduler.in_flight() == assignments.size());
+        CHECK(scheduler.covers(L + 1));
+        CHECK(scheduler.covers(10 * L));
+        CHECK_FALSE(scheduler.covers(10 * L + 1));  // the tip is not scheduled
+    }
+
+    SECTION("complete segments are not requested again") {
+        auto assignments = scheduler.schedule(0, 2 * L, peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 2);
+        scheduler.on_response(assignments[0].packet.requestId, headers_from(L, L));
+        CHECK_FALSE(scheduler.covers(1));
+        CHECK(scheduler.covers(L + 1));
+
+        assignments = scheduler.schedule(0, 2 * L, peers, tp + 10s, 5s, generate_request_id);  // 2nd one expired
+        REQUIRE(assignments.size() == 1);
+        CHECK(std::get<BlockNum>(assignments[0].packet.request.origin) == 2 * L);
+    }
+
+    SECTION("failed segments go to other peers until the budget is exhausted") {
+        auto assignments = scheduler.schedule(0, L, peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 1);
+        CHECK(assignments[0].peer_id == "fast");
+        scheduler.on_response(assignments[0].packet.requestId, headers_from(L, 10));  // partial
+
+        assignments = scheduler.schedule(0, L, peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 1);
+        CHECK(assignments[0].peer_id == "slow");
+
+        scheduler.on_nack(assignments[0].packet.requestId);  // does not count
+        assignments = scheduler.schedule(0, L, peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 1);
+        CHECK(assignments[0].peer_id == "slow");
+
+        for (size_t attempt = 3; attempt <= SegmentScheduler::kRetryBudget; ++attempt) {
+            tp += 10s;
+            assignments = scheduler.schedule(0, L, peers, tp, 5s, generate_request_id);
+            REQUIRE(assignments.size() == 1);
+            CHECK_FALSE(assignments[0].peer_id);  // both peers failed
+        }
+        tp += 10s;
+        CHECK(scheduler.schedule(0, L, peers, tp, 5s, generate_request_id).empty());
+        CHECK(scheduler.abandoned() == 1);
+        CHECK_FALSE(scheduler.covers(1));  // left to the anchor extension
+    }
+
+    SECTION("segments that reached the db are forgotten") {
+        auto assignments = scheduler.schedule(0, 2 * L, peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 2);
+        assignments = scheduler.schedule(L, 2 * L, peers, tp, 5s, generate_request_id);
+        CHECK(assignments.empty());
+        CHECK(scheduler.in_flight() == 1);
+        CHECK_FALSE(scheduler.covers(L));
+    }
+
+    SECTION("peers not having the segment are not asked") {
+        const std::vector<PeerTracker::IdlePeer> low_peers{{"low", L, 4}};
+        auto assignments = scheduler.schedule(0, 2 * L, low_peers, tp, 5s, generate_request_id);
+        REQUIRE(assignments.size() == 2);
+        CHECK(assignments[0].peer_id == "low");
+        CHECK_FALSE(assignments[1].peer_id);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "serving_cache.hpp"
+
+namespace silkworm {
+
+ServingCache::ServingCache(size_t max_headers, size_t max_bodies, size_t max_replies)
+    : headers_{max_headers}, bodies_{max_bodies}, replies_{max_replies} {}
+
+void ServingCache::put_header(const Hash& hash, ByteView encoded_header) {
+    std::unique_lock lock{mutex_};
+    headers_.put(hash, Bytes{encoded_header});
+    replies_.clear();
+}
+
+void ServingCache::put_body(const Hash& hash, ByteView encoded_body) {
+    std::unique_lock lock{mutex_};
+    bodies_.put(hash, Bytes{encoded_body});
+    replies_.clear();
+}
+
+std::optional<Bytes> ServingCache::header(const Hash& hash) {
+    std::unique_lock lock{mutex_};
+    auto encoded_header = headers_.get_as_copy(hash);
+    ++(encoded_header ? stats_.hits : stats_.misses);
+    return encoded_header;
+}
+
+std::optional<Bytes> ServingCache::body(const Hash& hash) {
+    std::unique_lock lock{mutex_};
+    auto encoded_body = bodies_.get_as_copy(hash);
+    ++(encoded_body ? stats_.hits : stats_.misses);
+    return encoded_body;
+}
+
+void ServingCache::put_reply(const std::string& query, ByteView encoded_reply) {
+    std::unique_lock lock{mutex_};
+    replies_.put(query, Bytes{encoded_reply});
+}
+
+std::optional<Bytes> ServingCache::reply(const std::string& query) {
+    std::unique_lock lock{mutex_};
+    auto encoded_reply = replies_.get_as_copy(query);
+    if (encoded_reply) ++stats_.coalesced;
+    return encoded_reply;
+}
+
+void ServingCache::invalidate_replies() {
+    std::unique_lock lock{mutex_};
+    replies_.clear();
+}
+
+void ServingCache::clear() {
+    std::unique_lock lock{mutex_};
+    headers_.clear();
+    bodies_.clear();
+    replies_.clear();
+}
+
+ServingCache::Stats ServingCache::stats() const {
+    std::unique_lock lock{mutex_};
+    return stats_;
+}
+
+}  // namespace silkworm
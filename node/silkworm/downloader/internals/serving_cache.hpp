@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <silkworm/common/lru_cache.hpp>
+
+#include "types.hpp"
+
+namespace silkworm {
+
+/** ServingCache keeps RLP encoded headers and bodies recently persisted, to answer peers' GetBlockHeaders and
+ *  GetBlockBodies without reading and re-encoding them from the db: peers mostly ask for the same recent ranges.
+ *  It also keeps the latest replies by query, so identical queries arriving one after the other (from different peers)
+ *  are answered with a single retrieval.
+ *  Thread safe. Headers and bodies are keyed by block hash, hence never go stale, and are put in the cache by the db
+ *  transaction writing them (see Db::ReadWriteAccess::Tx). Replies depend on the canonical chain, so they are dropped
+ *  whenever something is written.
+ */
+class ServingCache {
+  public:
+    static constexpr size_t kDefaultMaxHeaders{4'096};
+    static constexpr size_t kDefaultMaxBodies{512};
+    static constexpr size_t kDefaultMaxReplies{64};
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t coalesced{0};  // queries answered with a previous reply
+    };
+
+    explicit ServingCache(size_t max_headers = kDefaultMaxHeaders, size_t max_bodies = kDefaultMaxBodies,
+                          size_t max_replies = kDefaultMaxReplies);
+
+    // Not copyable nor movable
+    ServingCache(const ServingCache&) = delete;
+    ServingCache& operator=(const ServingCache&) = delete;
+
+    void put_header(const Hash& hash, ByteView encoded_header);
+    void put_body(const Hash& hash, ByteView encoded_body);
+
+    std::optional<Bytes> header(const Hash& hash);
+    std::optional<Bytes> body(const Hash& hash);
+
+    //! query is an opaque key (e.g. message id and encoded request), reply the encoded list of headers or bodies
+    void put_reply(const std::string& query, ByteView encoded_reply);
+    std::optional<Bytes> reply(const std::string& query);
+
+    void invalidate_replies();  // e.g. as the canonical chain changed
+    void clear();
+
+    [[nodiscard]] Stats stats() const;
+
+  private:
+    mutable std::mutex mutex_;  // Guards members below
+    lru_cache<Hash, Bytes> headers_;
+    lru_cache<Hash, Bytes> bodies_;
+    lru_cache<std::string, Bytes> replies_;
+    Stats stats_;
+};
+
+}  // namespace silkworm
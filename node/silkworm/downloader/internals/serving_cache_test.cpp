@@ -0,0 +1,63 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "serving_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("ServingCache") {
+    ServingCache cache{/*max_headers=*/2, /*max_bodies=*/1, /*max_replies=*/2};
+
+    Hash hash1, hash2, hash3;
+    hash1.bytes[0] = 1;
+    hash2.bytes[0] = 2;
+    hash3.bytes[0] = 3;
+    const Bytes rlp1(500, 0x01), rlp2(500, 0x02), rlp3(500, 0x03);
+
+    SECTION("headers and bodies") {
+        cache.put_header(hash1, rlp1);
+        cache.put_header(hash2, rlp2);
+        cache.put_body(hash1, rlp3);
+
+        CHECK(cache.header(hash1) == rlp1);
+        cache.put_header(hash3, rlp3);  // evicts the least recently used: hash2
+        CHECK_FALSE(cache.header(hash2));
+        CHECK(cache.header(hash3) == rlp3);
+        CHECK(cache.body(hash1) == rlp3);
+        CHECK_FALSE(cache.body(hash2));
+
+        CHECK(cache.stats().hits == 3);
+        CHECK(cache.stats().misses == 2);
+    }
+
+    SECTION("replies") {
+        cache.put_reply("query1", rlp1);
+        CHECK(cache.reply("query1") == rlp1);
+        CHECK_FALSE(cache.reply("query2"));
+        CHECK(cache.stats().coalesced == 1);
+
+        cache.put_header(hash1, rlp1);  // may change the outcome of queries
+        CHECK_FALSE(cache.reply("query1"));
+
+        cache.put_reply("query1", rlp1);
+        cache.invalidate_replies();
+        CHECK_FALSE(cache.reply("query1"));
+    }
+}
+
+}  // namespace silkworm
@@ -26,18 +26,30 @@ InboundBlockBodies::InboundBlockBodies(const sentry::InboundMessage& msg) {
         throw std::logic_error("InboundBlockBodies received wrong InboundMessage");
 
     peerId_ = string_from_H512(msg.peer_id());
+    bytes_ = msg.data().size();
 
-    ByteView data = string_view_to_byte_view(msg.data());  // copy for consumption
+    ByteView data = string_view_to_byte_view(msg.data());  // view on the payload, no copy
     rlp::success_or_throw(rlp::decode(data, packet_));
 
     SILK_TRACE << "Received message " << *this;
 }
 
+void InboundBlockBodies::prepare() { roots_ = BodySequence::compute_roots(packet_.request); }
+
 void InboundBlockBodies::execute(Db::ReadOnlyAccess, HeaderChain&, BodySequence& bs, SentryClient& sentry) {
 
     SILK_TRACE << "Processing message " << *this;
 
-    Penalty penalty = bs.accept_requested_bodies(packet_, peerId_);
+    const auto now = std::chrono::system_clock::now();
+    auto latency_ms = sentry.peer_tracker().on_response(peerId_, packet_.requestId, packet_.request.size(), now);
+
+    DownloadMetrics& metrics = sentry.download_metrics();
+    if (latency_ms) metrics.observe_latency(peerId_, *latency_ms, now);
+    metrics.add(DownloadMetrics::Rate::InboundBytes, bytes_, now);
+    metrics.add(DownloadMetrics::Rate::Bodies, packet_.request.size(), now);
+
+    if (roots_.size() != packet_.request.size()) prepare();  // not prepared
+    Penalty penalty = bs.accept_requested_bodies(packet_, roots_, peerId_);
 
     if (penalty != Penalty::NoPenalty) {
         SILK_TRACE << "Replying to " << identify(*this) << " with penalize_peer";
@@ -30,11 +30,14 @@ class InboundBlockBodies : public InboundMessage {
     std::string content() const override;
     uint64_t reqId() const override;
 
+    void prepare() override;
     void execute(Db::ReadOnlyAccess db, HeaderChain&, BodySequence&, SentryClient&) override;
 
   private:
     PeerId peerId_;
+    size_t bytes_;  // of the payload
     BlockBodiesPacket66 packet_;
+    std::vector<BodySequence::BodyRoots> roots_;  // of packet_ bodies, computed by prepare
 };
 
 }  // namespace silkworm
@@ -21,17 +21,59 @@
 #include <silkworm/downloader/messages/outbound_get_block_headers.hpp>
 #include <silkworm/downloader/rpc/peer_min_block.hpp>
 #include <silkworm/downloader/rpc/penalize_peer.hpp>
+#include <silkworm/types/block_header_view.hpp>
 
 namespace silkworm {
 
+// Headers are located through views on the payload: their hashes are computed over the bytes received rather than
+// over a re-encoding of each header (see HeaderList::compute_hashes)
+static DecodingResult decode_packet(ByteView& from, BlockHeadersPacket66& packet, std::vector<Hash>& hashes) noexcept {
+    auto [rlp_head, err]{rlp::decode_header(from)};
+    if (err != DecodingResult::kOk) {
+        return err;
+    }
+    if (!rlp_head.list) {
+        return DecodingResult::kUnexpectedString;
+    }
+    const uint64_t leftover{from.length() - rlp_head.payload_length};
+
+    if (err = rlp::decode(from, packet.requestId); err != DecodingResult::kOk) {
+        return err;
+    }
+
+    auto [headers_head, headers_err]{rlp::decode_header(from)};
+    if (headers_err != DecodingResult::kOk) {
+        return headers_err;
+    }
+    if (!headers_head.list) {
+        return DecodingResult::kUnexpectedString;
+    }
+    ByteView headers{from.substr(0, headers_head.payload_length)};
+    from.remove_prefix(headers_head.payload_length);
+
+    while (!headers.empty()) {
+        BlockHeaderView view;
+        if (err = view.parse(headers); err != DecodingResult::kOk) {
+            return err;
+        }
+        if (err = view.decode(packet.request.emplace_back()); err != DecodingResult::kOk) {
+            return err;
+        }
+        hashes.emplace_back(view.hash());
+    }
+
+    return from.length() == leftover ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
+}
+
 InboundBlockHeaders::InboundBlockHeaders(const sentry::InboundMessage& msg) {
     if (msg.id() != sentry::MessageId::BLOCK_HEADERS_66)
         throw std::logic_error("InboundBlockHeaders received wrong InboundMessage");
 
     peerId_ = string_from_H512(msg.peer_id());
+    bytes_ = msg.data().size();
 
-    ByteView data = string_view_to_byte_view(msg.data());  // copy for consumption
-    rlp::success_or_throw(rlp::decode(data, packet_));
+    ByteView data = string_view_to_byte_view(msg.data());  // view on the payload, no copy
+    rlp::success_or_throw(decode_packet(data, packet_, hashes_));
 
     SILK_TRACE << "Received message " << *this;
 }
@@ -46,8 +88,19 @@ void InboundBlockHeaders::execute(Db::ReadOnlyAccess, HeaderChain& hc, BodySeque
         highestBlock = std::max(highestBlock, header.number);
     }
 
+    const auto now = std::chrono::system_clock::now();
+    PeerTracker& peer_tracker = sentry.peer_tracker();
+    auto latency_ms = peer_tracker.on_response(peerId_, packet_.requestId, packet_.request.size(), now);
+    peer_tracker.on_height(peerId_, highestBlock);
+
+    DownloadMetrics& metrics = sentry.download_metrics();
+    if (latency_ms) metrics.observe_latency(peerId_, *latency_ms, now);
+    metrics.add(DownloadMetrics::Rate::InboundBytes, bytes_, now);
+    metrics.add(DownloadMetrics::Rate::Headers, packet_.request.size(), now);
+
     // Save the headers
-    auto [penalty, requestMoreHeaders] = hc.accept_headers(packet_.request, packet_.requestId, peerId_);
+    auto [penalty, requestMoreHeaders] =
+        hc.accept_headers(packet_.request, std::move(hashes_), packet_.requestId, peerId_);
 
     // Reply
     if (penalty != Penalty::NoPenalty) {
@@ -34,7 +34,9 @@ class InboundBlockHeaders : public InboundMessage {
 
   private:
     PeerId peerId_;
+    size_t bytes_;  // of the payload
     BlockHeadersPacket66 packet_;
+    std::vector<Hash> hashes_;  // of packet_ headers, computed while decoding
 };
 
 }  // namespace silkworm
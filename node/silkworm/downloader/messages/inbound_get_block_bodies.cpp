@@ -16,9 +16,10 @@
 
 #include "inbound_get_block_bodies.hpp"
 
+#include <silkworm/common/cast.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/downloader/internals/body_retrieval.hpp>
-#include <silkworm/downloader/packets/block_bodies_packet.hpp>
+#include <silkworm/downloader/packets/rlp_eth66_packet_coding.hpp>
 #include <silkworm/downloader/rpc/send_message_by_id.hpp>
 
 namespace silkworm {
@@ -54,26 +55,37 @@ void InboundGetBlockBodies::execute(Db::ReadOnlyAccess db, HeaderChain&, BodySeq
     if (bs.highest_block_in_db() == 0)
         return;
 
-    BodyRetrieval body_retrieval(db);
+    // identical queries (usually from different peers) are answered with the same reply while the chain is unchanged
+    ServingCache* serving_cache = db.serving_cache();
+    std::string query(1, static_cast<char>(sentry::MessageId::GET_BLOCK_BODIES_66));
+    query.reserve(1 + packet_.request.size() * kHashLength);
+    for (const auto& hash : packet_.request) query.append(byte_ptr_cast(hash.bytes), kHashLength);
 
-    BlockBodiesPacket66 reply;
-    reply.requestId = packet_.requestId;
-    reply.request = body_retrieval.recover(packet_.request);
+    std::optional<Bytes> encoded_bodies = serving_cache ? serving_cache->reply(query) : std::nullopt;
+    if (!encoded_bodies) {
+        BodyRetrieval body_retrieval(db);
 
-    if (reply.request.empty()) {
-        log::Trace() << "[WARNING] Not replying to " << identify(*this) << ", no blocks found";
-        return;
+        std::vector<Bytes> bodies = body_retrieval.recover(packet_.request);
+
+        if (bodies.empty()) {
+            log::Trace() << "[WARNING] Not replying to " << identify(*this) << ", no blocks found";
+            return;
+        }
+
+        encoded_bodies.emplace();
+        rlp::encode_list_of_encoded(*encoded_bodies, bodies);
+        if (serving_cache) serving_cache->put_reply(query, *encoded_bodies);
     }
 
     Bytes rlp_encoding;
-    rlp::encode(rlp_encoding, reply);
+    rlp::encode_eth66_packet_of_encoded(rlp_encoding, packet_.requestId, *encoded_bodies);
 
     auto msg_reply = std::make_unique<sentry::OutboundMessageData>();
     msg_reply->set_id(sentry::MessageId::BLOCK_BODIES_66);
     msg_reply->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
 
     SILK_TRACE << "Replying to " << identify(*this) << " using send_message_by_id with "
-                 << reply.request.size() << " bodies";
+                 << rlp_encoding.length() << " bytes of bodies";
 
     rpc::SendMessageById rpc(peerId_, std::move(msg_reply));
     rpc.do_not_throw_on_failure();
@@ -19,7 +19,7 @@
 #include <silkworm/common/cast.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/downloader/internals/header_retrieval.hpp>
-#include <silkworm/downloader/packets/block_headers_packet.hpp>
+#include <silkworm/downloader/packets/rlp_eth66_packet_coding.hpp>
 #include <silkworm/downloader/rpc/send_message_by_id.hpp>
 
 namespace silkworm {
@@ -45,33 +45,45 @@ void InboundGetBlockHeaders::execute(Db::ReadOnlyAccess db, HeaderChain&, BodySe
     if (bs.highest_block_in_db() == 0) // skip requests in the first sync even if we already saved some headers
         return;
 
-    HeaderRetrieval header_retrieval(db);
-
-    BlockHeadersPacket66 reply;
-    reply.requestId = packet_.requestId;
-    if (holds_alternative<Hash>(packet_.request.origin)) {
-        reply.request = header_retrieval.recover_by_hash(get<Hash>(packet_.request.origin), packet_.request.amount,
-                                                         packet_.request.skip, packet_.request.reverse);
-    } else {
-        reply.request =
-            header_retrieval.recover_by_number(get<BlockNum>(packet_.request.origin), packet_.request.amount,
-                                               packet_.request.skip, packet_.request.reverse);
-    }
-
-    if (reply.request.empty()) {
-        log::Trace() << "[WARNING] Not replying to " << identify(*this) << ", no headers found";
-        return;
+    // identical queries (usually from different peers) are answered with the same reply while the chain is unchanged
+    ServingCache* serving_cache = db.serving_cache();
+    Bytes encoded_query{static_cast<uint8_t>(sentry::MessageId::GET_BLOCK_HEADERS_66)};
+    rlp::encode(encoded_query, packet_.request);
+    const std::string query{byte_ptr_cast(encoded_query.data()), encoded_query.length()};
+
+    std::optional<Bytes> encoded_headers = serving_cache ? serving_cache->reply(query) : std::nullopt;
+    if (!encoded_headers) {
+        HeaderRetrieval header_retrieval(db);
+
+        std::vector<Bytes> headers;
+        if (holds_alternative<Hash>(packet_.request.origin)) {
+            headers = header_retrieval.recover_by_hash(get<Hash>(packet_.request.origin), packet_.request.amount,
+                                                       packet_.request.skip, packet_.request.reverse);
+        } else {
+            headers = header_retrieval.recover_by_number(get<BlockNum>(packet_.request.origin),
+                                                         packet_.request.amount, packet_.request.skip,
+                                                         packet_.request.reverse);
+        }
+
+        if (headers.empty()) {
+            log::Trace() << "[WARNING] Not replying to " << identify(*this) << ", no headers found";
+            return;
+        }
+
+        encoded_headers.emplace();
+        rlp::encode_list_of_encoded(*encoded_headers, headers);
+        if (serving_cache) serving_cache->put_reply(query, *encoded_headers);
     }
 
     Bytes rlp_encoding;
-    rlp::encode(rlp_encoding, reply);
+    rlp::encode_eth66_packet_of_encoded(rlp_encoding, packet_.requestId, *encoded_headers);
 
     auto msg_reply = std::make_unique<sentry::OutboundMessageData>();
     msg_reply->set_id(sentry::MessageId::BLOCK_HEADERS_66);
     msg_reply->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
 
     SILK_TRACE << "Replying to " << identify(*this) << " using send_message_by_id with "
-                        << reply.request.size() << " headers";
+                        << rlp_encoding.length() << " bytes of headers";
 
     rpc::SendMessageById rpc{peerId_, std::move(msg_reply)};
     rpc.do_not_throw_on_failure();
@@ -33,21 +33,26 @@ InboundNewBlock::InboundNewBlock(const sentry::InboundMessage& msg) {
 
     peerId_ = string_from_H512(msg.peer_id());
 
-    ByteView data = string_view_to_byte_view(msg.data());  // copy for consumption
+    ByteView data = string_view_to_byte_view(msg.data());  // view on the payload, no copy
     rlp::success_or_throw(rlp::decode(data, packet_));
 
     SILK_TRACE << "Received message " << *this;
 }
 
-void InboundNewBlock::execute(Db::ReadOnlyAccess, HeaderChain&, BodySequence& bs, SentryClient&) {
+void InboundNewBlock::prepare() { roots_ = BodySequence::compute_roots(packet_.block); }
+
+void InboundNewBlock::execute(Db::ReadOnlyAccess, HeaderChain&, BodySequence& bs, SentryClient& sentry) {
     SILK_TRACE << "Processing message " << *this;
 
+    sentry.peer_tracker().on_height(peerId_, packet_.block.header.number);
+
     // todo: complete implementation
     /*
     // use packet_.td ?
     hc.accept_header(packet_.block.header); // process as single header segment
     */
-    bs.accept_new_block(packet_.block, peerId_); // add to prefetched bodies
+    if (!roots_) prepare();  // not prepared
+    bs.accept_new_block(packet_.block, *roots_, peerId_); // add to prefetched bodies
 }
 
 uint64_t InboundNewBlock::reqId() const { return reqId_; }
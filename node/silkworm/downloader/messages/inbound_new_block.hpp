@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <silkworm/downloader/packets/new_block_packet.hpp>
 
 #include "inbound_message.hpp"
@@ -30,11 +32,13 @@ class InboundNewBlock : public InboundMessage {
     std::string content() const override;
     uint64_t reqId() const override;
 
+    void prepare() override;
     void execute(Db::ReadOnlyAccess, HeaderChain&, BodySequence&, SentryClient&) override;
 
   private:
     std::string peerId_;
     NewBlockPacket packet_;
+    std::optional<BodySequence::BodyRoots> roots_;  // of packet_ block, computed by prepare
     uint64_t reqId_;
 };
 
@@ -33,7 +33,7 @@ InboundNewBlockHashes::InboundNewBlockHashes(const sentry::InboundMessage& msg)
 
     peerId_ = string_from_H512(msg.peer_id());
 
-    ByteView data = string_view_to_byte_view(msg.data());  // copy for consumption
+    ByteView data = string_view_to_byte_view(msg.data());  // view on the payload, no copy
     rlp::success_or_throw(rlp::decode(data, packet_));
 
     SILK_TRACE << "Received message " << *this;
@@ -28,6 +28,11 @@ class Message {
   public:
     virtual std::string name() const = 0;
 
+    // prepare: thread safe pre-processing of the message content (e.g. hashing) ahead of execute, which can then skip
+    // it; it runs on any thread, concurrently with other messages' prepare and execute, so it must not touch any state
+    // but the message's own
+    virtual void prepare() {}
+
     // execute: inbound message send a reply, outbound message send a request
     virtual void execute(Db::ReadOnlyAccess, HeaderChain&, BodySequence&, SentryClient&) = 0;
 
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <silkworm/common/log.hpp>
 #include <silkworm/downloader/rpc/penalize_peer.hpp>
+#include <silkworm/downloader/rpc/send_message_by_id.hpp>
 #include <silkworm/downloader/rpc/send_message_by_min_block.hpp>
 
 namespace silkworm {
@@ -33,15 +34,23 @@ void OutboundGetBlockBodies::execute(Db::ReadOnlyAccess, HeaderChain&, BodySeque
 
     seconds_t timeout = 1s;
     int max_requests = 64;  // limit the number of requests sent per round
+    PeerTracker& peer_tracker = sentry.peer_tracker();
 
     do {
         time_point_t now = std::chrono::system_clock::now();
 
-        auto [packet, penalizations, min_block] = bs.request_more_bodies(now, sentry.active_peers());
+        // aim at the fastest peer, if any, asking it as many bodies as it can deliver quickly
+        auto target = peer_tracker.select(BodySequence::kMaxBlocksPerMessage, now);
+        size_t max_bodies = target ? target->max_items : BodySequence::kMaxBlocksPerMessage;
+
+        auto [packet, penalizations, min_block] =
+            bs.request_more_bodies(now, sentry.active_peers(), max_bodies, peer_tracker.hedge_delay());
 
         if (packet.request.empty()) break;
 
-        auto send_outcome = send_packet(sentry, packet, min_block, timeout);
+        if (target && target->height < min_block) target.reset();  // it may not have the bodies, the sentry chooses
+
+        auto send_outcome = send_packet(sentry, packet, target, min_block, timeout);
 
         SILK_TRACE << "Bodies request sent (" << packet << "), received by " << send_outcome.peers_size() << " peer(s)";
 
@@ -50,6 +59,10 @@ void OutboundGetBlockBodies::execute(Db::ReadOnlyAccess, HeaderChain&, BodySeque
             break;
         }
 
+        for (const auto& peer : send_outcome.peers()) {
+            peer_tracker.on_request(string_from_H512(peer), packet.requestId, packet.request.size(), now);
+        }
+
         requested_bodies_ += packet.request.size();
         ++sent_reqs_;
 
@@ -63,6 +76,7 @@ void OutboundGetBlockBodies::execute(Db::ReadOnlyAccess, HeaderChain&, BodySeque
 }
 
 sentry::SentPeers OutboundGetBlockBodies::send_packet(SentryClient& sentry, const GetBlockBodiesPacket66& packet_,
+                                                      const std::optional<PeerTracker::Target>& target,
                                                       BlockNum min_block, seconds_t timeout) {
     auto request = std::make_unique<sentry::OutboundMessageData>();  // create header request
 
@@ -72,21 +86,33 @@ sentry::SentPeers OutboundGetBlockBodies::send_packet(SentryClient& sentry, cons
     rlp::encode(rlp_encoding, packet_);
     request->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
 
-    SILK_TRACE << "Sending message OutboundGetBlockBodies with send_message_by_min_block, content:" << packet_;
+    auto exec_remotely = [&](auto& rpc) -> std::optional<sentry::SentPeers> {
+        rpc.timeout(timeout);
+        rpc.do_not_throw_on_failure();
 
-    rpc::SendMessageByMinBlock rpc{min_block, std::move(request)};
+        sentry.exec_remotely(rpc);
 
-    rpc.timeout(timeout);
-    rpc.do_not_throw_on_failure();
-
-    sentry.exec_remotely(rpc);
-
-    if (!rpc.status().ok()) {
-        SILK_TRACE << "Failure of rpc OutboundGetBlockBodies " << packet_ << ": " << rpc.status().error_message();
-        return {};
+        if (!rpc.status().ok()) {
+            SILK_TRACE << "Failure of rpc OutboundGetBlockBodies " << packet_ << ": " << rpc.status().error_message();
+            return std::nullopt;
+        }
+        return rpc.reply();
+    };
+
+    std::optional<sentry::SentPeers> reply;
+    if (target) {
+        SILK_TRACE << "Sending message OutboundGetBlockBodies with send_message_by_id to " << target->peer_id
+                   << ", content:" << packet_;
+        rpc::SendMessageById rpc{target->peer_id, std::move(request)};
+        reply = exec_remotely(rpc);
+    } else {
+        SILK_TRACE << "Sending message OutboundGetBlockBodies with send_message_by_min_block, content:" << packet_;
+        rpc::SendMessageByMinBlock rpc{min_block, std::move(request)};
+        reply = exec_remotely(rpc);
     }
+    if (!reply) return {};
 
-    sentry::SentPeers peers = rpc.reply();
+    sentry::SentPeers peers = std::move(*reply);
     SILK_TRACE << "Received rpc result of OutboundGetBlockBodies reqId=" << packet_.requestId << ": "
                << std::to_string(peers.peers_size()) + " peer(s)";
 
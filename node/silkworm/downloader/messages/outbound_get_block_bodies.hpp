@@ -16,6 +16,9 @@ limitations under the License.
 
 #pragma once
 
+#include <optional>
+
+#include <silkworm/downloader/internals/peer_tracker.hpp>
 #include <silkworm/downloader/packets/get_block_bodies_packet.hpp>
 
 #include "outbound_message.hpp"
@@ -34,7 +37,9 @@ class OutboundGetBlockBodies : public OutboundMessage {
     int sent_request() const;
 
   private:
-    sentry::SentPeers send_packet(SentryClient&, const GetBlockBodiesPacket66&, BlockNum min_block, seconds_t timeout);
+    sentry::SentPeers send_packet(SentryClient&, const GetBlockBodiesPacket66&,
+                                  const std::optional<PeerTracker::Target>& target, BlockNum min_block,
+                                  seconds_t timeout);
     void send_penalization(SentryClient&, const PeerPenalization&, seconds_t timeout);
 
     int sent_reqs_{0};
@@ -16,14 +16,55 @@
 
 #include "outbound_get_block_headers.hpp"
 
+#include <optional>
 #include <sstream>
 
 #include <silkworm/common/log.hpp>
 #include <silkworm/downloader/rpc/penalize_peer.hpp>
+#include <silkworm/downloader/rpc/send_message_by_id.hpp>
 #include <silkworm/downloader/rpc/send_message_by_min_block.hpp>
 
 namespace silkworm {
 
+namespace {
+
+    std::unique_ptr<sentry::OutboundMessageData> encode_request(const GetBlockHeadersPacket66& packet) {
+        auto request = std::make_unique<sentry::OutboundMessageData>();
+        request->set_id(sentry::MessageId::GET_BLOCK_HEADERS_66);
+
+        Bytes rlp_encoding;
+        rlp::encode(rlp_encoding, packet);
+        request->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
+        return request;
+    }
+
+    // sends the request and records it in the PeerTracker
+    template <class Rpc>
+    sentry::SentPeers exec_remotely(SentryClient& sentry, Rpc& rpc, const GetBlockHeadersPacket66& packet,
+                                    seconds_t timeout) {
+        rpc.timeout(timeout);
+        rpc.do_not_throw_on_failure();
+
+        sentry.exec_remotely(rpc);
+
+        if (!rpc.status().ok()) {
+            SILK_TRACE << "Failure of rpc OutboundGetBlockHeaders " << packet << ": " << rpc.status().error_message();
+            return {};
+        }
+
+        sentry::SentPeers peers = rpc.reply();
+        time_point_t now = std::chrono::system_clock::now();
+        for (const auto& peer : peers.peers()) {
+            sentry.peer_tracker().on_request(string_from_H512(peer), packet.requestId, packet.request.amount, now);
+        }
+        SILK_TRACE << "Received rpc result of OutboundGetBlockHeaders reqId=" << packet.requestId << ": "
+                   << std::to_string(peers.peers_size()) + " peer(s)";
+
+        return peers;
+    }
+
+}  // namespace
+
 OutboundGetBlockHeaders::OutboundGetBlockHeaders() {}
 
 int OutboundGetBlockHeaders::sent_request() const {
@@ -64,14 +105,23 @@ void OutboundGetBlockHeaders::execute(Db::ReadOnlyAccess, HeaderChain& hc, BodyS
     } while (max_requests > 0);  // && packet != std::nullopt && receiving_peers != nullptr
 
     // anchor collection
-    auto packet = hc.request_skeleton();
+    PeerTracker& peer_tracker = sentry.peer_tracker();
+    auto assignments = hc.request_segments(now, timeout, peer_tracker.idle_peers(now));
 
-    if (packet != std::nullopt) {
-        auto send_outcome = send_packet(sentry, *packet, timeout);
-        sent_reqs_++;
-        packets_ += "SK o=" + std::to_string(std::get<BlockNum>(packet->request.origin)) + ",";  // todo: log level?
-        SILK_TRACE << "Headers skeleton request sent (" << *packet << "), received by " << send_outcome.peers_size()
-                     << " peer(s)";
+    for (const auto& [packet, peer_id] : assignments) {
+        const auto top = std::get<BlockNum>(packet.request.origin);
+        auto send_outcome = peer_id ? send_packet_to(sentry, packet, *peer_id, timeout)
+                                    : send_packet_by_min_block(sentry, packet, top, timeout);  // to discover peers
+
+        packets_ += "SG o=" + std::to_string(top) + ",";  // todo: log level?
+        SILK_TRACE << "Headers segment request sent (" << packet << "), received by " << send_outcome.peers_size()
+                   << " peer(s)";
+
+        if (send_outcome.peers_size() == 0) {
+            hc.request_nack(packet);
+            continue;
+        }
+        ++sent_reqs_;
     }
 
     if (!packets_.empty()) {
@@ -87,33 +137,31 @@ sentry::SentPeers OutboundGetBlockHeaders::send_packet(SentryClient& sentry,
     BlockNum min_block = std::get<BlockNum>(packet_.request.origin);  // choose target peer
     if (!packet_.request.reverse) min_block += packet_.request.amount * packet_.request.skip;
 
-    auto request = std::make_unique<sentry::OutboundMessageData>();  // create header request
-
-    request->set_id(sentry::MessageId::GET_BLOCK_HEADERS_66);
-
-    Bytes rlp_encoding;
-    rlp::encode(rlp_encoding, packet_);
-    request->set_data(rlp_encoding.data(), rlp_encoding.length());  // copy
-
-    SILK_TRACE << "Sending message OutboundGetBlockHeaders with send_message_by_min_block, content:" << packet_;
-
-    rpc::SendMessageByMinBlock rpc{min_block, std::move(request)};
-
-    rpc.timeout(timeout);
-    rpc.do_not_throw_on_failure();
-
-    sentry.exec_remotely(rpc);
+    // aim at the fastest peer if it has the headers, otherwise the sentry chooses
+    PeerTracker& peer_tracker = sentry.peer_tracker();
+    time_point_t now = std::chrono::system_clock::now();
+    auto target = peer_tracker.select(packet_.request.amount, now);
 
-    if (!rpc.status().ok()) {
-        SILK_TRACE << "Failure of rpc OutboundNewBlockHashes " << packet_ << ": " << rpc.status().error_message();
-        return {};
+    if (target && target->height >= min_block) {
+        return send_packet_to(sentry, packet_, target->peer_id, timeout);
     }
+    return send_packet_by_min_block(sentry, packet_, min_block, timeout);
+}
 
-    sentry::SentPeers peers = rpc.reply();
-    SILK_TRACE << "Received rpc result of OutboundGetBlockHeaders reqId=" << packet_.requestId << ": "
-                 << std::to_string(peers.peers_size()) + " peer(s)";
+sentry::SentPeers OutboundGetBlockHeaders::send_packet_by_min_block(SentryClient& sentry,
+                                                                    const GetBlockHeadersPacket66& packet_,
+                                                                    BlockNum min_block, seconds_t timeout) {
+    SILK_TRACE << "Sending message OutboundGetBlockHeaders with send_message_by_min_block, content:" << packet_;
+    rpc::SendMessageByMinBlock rpc{min_block, encode_request(packet_)};
+    return exec_remotely(sentry, rpc, packet_, timeout);
+}
 
-    return peers;
+sentry::SentPeers OutboundGetBlockHeaders::send_packet_to(SentryClient& sentry, const GetBlockHeadersPacket66& packet_,
+                                                          const PeerId& peer_id, seconds_t timeout) {
+    SILK_TRACE << "Sending message OutboundGetBlockHeaders with send_message_by_id to " << peer_id
+               << ", content:" << packet_;
+    rpc::SendMessageById rpc{peer_id, encode_request(packet_)};
+    return exec_remotely(sentry, rpc, packet_, timeout);
 }
 
 void OutboundGetBlockHeaders::send_penalization(SentryClient& sentry, const PeerPenalization& penalization, seconds_t timeout) {
@@ -35,6 +35,9 @@ class OutboundGetBlockHeaders : public OutboundMessage {
 
   private:
     sentry::SentPeers send_packet(SentryClient&, const GetBlockHeadersPacket66&, seconds_t timeout);
+    sentry::SentPeers send_packet_to(SentryClient&, const GetBlockHeadersPacket66&, const PeerId&, seconds_t timeout);
+    sentry::SentPeers send_packet_by_min_block(SentryClient&, const GetBlockHeadersPacket66&, BlockNum min_block,
+                                               seconds_t timeout);
     void send_penalization(SentryClient&, const PeerPenalization&, seconds_t timeout);
 
     int sent_reqs_{0};
@@ -21,6 +21,7 @@
 #include "get_block_headers_packet.hpp"
 #include "new_block_hashes_packet.hpp"
 #include "new_block_packet.hpp"
+#include "rlp_eth66_packet_coding.hpp"
 
 // generic implementations (must follow types)
 #include <silkworm/rlp/encode_vector.hpp>
@@ -1099,6 +1100,15 @@ TEST_CASE("BlockHeadersPacket (eth/66) decoding/encoding") {
     // length test
     auto len = rlp::length(packet);
     REQUIRE(len == re_encoded.size());
+
+    // encoding of already encoded headers, as served from ServingCache
+    Bytes encoded_header;
+    rlp::encode(encoded_header, packet.request[0]);
+    Bytes encoded_headers;
+    rlp::encode_list_of_encoded(encoded_headers, {encoded_header});
+    Bytes re_encoded_as_raw;
+    rlp::encode_eth66_packet_of_encoded(re_encoded_as_raw, packet.requestId, encoded_headers);
+    REQUIRE(to_hex(re_encoded_as_raw) == raw_packet);
 }
 
 // TESTs related to BlockBodiesPacket66 encoding/decoding - eth/66 version
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <type_traits>
+#include <vector>
 
 #include <silkworm/downloader/internals/types.hpp>
 
@@ -63,6 +64,29 @@ inline size_t length_eth66_packet(const T& from) noexcept {
     return rlp_head_len + rlp_head.payload_length;
 }
 
+// encodes a list of items already RLP encoded, e.g. headers or bodies read as they are from a cache
+inline void encode_list_of_encoded(Bytes& to, const std::vector<Bytes>& items) {
+    rlp::Header rlp_head{true, 0};
+    for (const auto& item : items) rlp_head.payload_length += item.length();
+
+    to.reserve(to.size() + rlp::length_of_length(rlp_head.payload_length) + rlp_head.payload_length);
+    rlp::encode_header(to, rlp_head);
+    for (const auto& item : items) to.append(item);
+}
+
+// encodes an eth66 packet whose request is already RLP encoded, e.g. by encode_list_of_encoded()
+inline void encode_eth66_packet_of_encoded(Bytes& to, uint64_t requestId, ByteView encoded_request) {
+    rlp::Header rlp_head{true, 0};
+
+    rlp_head.payload_length += rlp::length(requestId);
+    rlp_head.payload_length += encoded_request.length();
+
+    rlp::encode_header(to, rlp_head);
+
+    rlp::encode(to, requestId);
+    to.append(encoded_request);
+}
+
 template <typename T>
 inline DecodingResult decode_eth66_packet(ByteView& from, T& to) noexcept {
     auto [rlp_head, err0]{rlp::decode_header(from)};
@@ -16,7 +16,14 @@
 
 #include "sentry_client.hpp"
 
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/bounded_mpmc_queue.hpp>
 
 #include <silkworm/downloader/rpc/hand_shake.hpp>
 #include <silkworm/downloader/rpc/peer_count.hpp>
@@ -26,11 +33,126 @@
 
 namespace silkworm {
 
+// Queue and thread handing the messages of a scope to its subscribers
+class SentryClient::Dispatcher {
+  public:
+    using message_t = std::shared_ptr<const sentry::InboundMessage>;
+
+    Dispatcher(Scope scope, bool drop_when_full)
+        : scope_{scope}, drop_when_full_{drop_when_full}, queue_{kDispatchQueueCapacity}, thread_{[this] { run(); }} {}
+
+    ~Dispatcher() {
+        stopping_ = true;
+        thread_.join();
+    }
+
+    void subscribe(subscriber_t callback) {
+        // copy on write: the dispatch thread keeps using the list it took, subscriptions are rare
+        std::scoped_lock lock{mutex_};
+        auto subscribers{std::make_shared<std::vector<subscriber_t>>(*subscribers_)};
+        subscribers->push_back(std::move(callback));
+        subscribers_ = std::move(subscribers);
+    }
+
+    void push(const message_t& message) {
+        if (queue_.try_push(message)) return;
+        if (drop_when_full_) {
+            ++dropped_;
+            return;
+        }
+        ++blocked_;
+        queue_.push(message);  // backpressure on the receiving loop
+    }
+
+    [[nodiscard]] DispatchStats stats() const { return {dispatched_, dropped_, blocked_, queue_.size()}; }
+
+  private:
+    void run() {
+        log::set_thread_name(scope_ == Scope::BlockAnnouncements ? "sentry-announc"
+                             : scope_ == Scope::BlockRequests    ? "sentry-request"
+                                                                 : "sentry-other  ");
+        using namespace std::chrono_literals;
+        message_t message;
+        while (!stopping_) {
+            if (!queue_.timed_wait_and_pop(message, 100ms)) continue;  // timeout, needed to check stopping_
+
+            std::shared_ptr<const std::vector<subscriber_t>> subscribers;
+            {
+                std::scoped_lock lock{mutex_};
+                subscribers = subscribers_;
+            }
+            for (const auto& subscriber : *subscribers) {
+                try {
+                    subscriber(message);
+                } catch (const std::exception& e) {
+                    log::Warning() << "SentryClient, " << scope_name(scope_) << " subscriber failed: " << e.what();
+                }
+            }
+            ++dispatched_;
+            message.reset();  // do not hold the last message while waiting
+        }
+    }
+
+    const Scope scope_;
+    const bool drop_when_full_;
+    BoundedMpmcQueue<message_t> queue_;
+
+    std::mutex mutex_;  // guards subscribers_ pointer
+    std::shared_ptr<const std::vector<subscriber_t>> subscribers_{std::make_shared<std::vector<subscriber_t>>()};
+
+    std::atomic<uint64_t> dispatched_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> blocked_{0};
+    std::atomic_bool stopping_{false};
+    std::thread thread_;  // last, started once everything else is initialized
+};
+
+namespace {
+    size_t index_of(SentryClient::Scope scope) {
+        return static_cast<size_t>(std::countr_zero(static_cast<unsigned>(scope)));  // scopes are single bits
+    }
+}  // namespace
+
+auto SentryClient::make_dispatchers() -> std::array<std::unique_ptr<Dispatcher>, kScopes> {
+    // block requests are served best effort, the requesting peer asks someone else when it gets no answer, while
+    // announcements and replies to our own requests are the download itself
+    std::array<std::unique_ptr<Dispatcher>, kScopes> dispatchers;
+    for (auto [scope, drop_when_full] : {std::pair{Scope::BlockRequests, true},
+                                         std::pair{Scope::BlockAnnouncements, false}, std::pair{Scope::Other, true}}) {
+        dispatchers[index_of(scope)] = std::make_unique<Dispatcher>(scope, drop_when_full);
+    }
+    return dispatchers;
+}
+
 SentryClient::SentryClient(const std::string& sentry_addr)
-    : base_t(grpc::CreateChannel(sentry_addr, grpc::InsecureChannelCredentials())) {
+    : base_t(grpc::CreateChannel(sentry_addr, grpc::InsecureChannelCredentials())), dispatchers_{make_dispatchers()} {
     log::Info() << "SentryClient, connecting to remote sentry...";
 }
 
+SentryClient::SentryClient(std::shared_ptr<grpc::Channel> channel)
+    : base_t(std::move(channel)), dispatchers_{make_dispatchers()} {
+    log::Info() << "SentryClient, connecting to sentry through provided channel...";
+}
+
+SentryClient::~SentryClient() = default;
+
+SentryClient::Dispatcher& SentryClient::dispatcher(Scope scope) const {
+    return *dispatchers_[index_of(scope)];
+}
+
+const char* SentryClient::scope_name(Scope scope) {
+    switch (scope) {
+        case Scope::BlockRequests:
+            return "block_requests";
+        case Scope::BlockAnnouncements:
+            return "block_announcements";
+        default:
+            return "other";
+    }
+}
+
+DispatchStats SentryClient::dispatch_stats(Scope scope) const { return dispatcher(scope).stats(); }
+
 SentryClient::Scope SentryClient::scope(const sentry::InboundMessage& message) {
     switch (message.id()) {
         case sentry::MessageId::BLOCK_HEADERS_66:
@@ -46,13 +168,10 @@ SentryClient::Scope SentryClient::scope(const sentry::InboundMessage& message) {
     }
 }
 
-void SentryClient::subscribe(Scope scope, subscriber_t callback) { subscribers_[scope].push_back(std::move(callback)); }
+void SentryClient::subscribe(Scope scope, subscriber_t callback) { dispatcher(scope).subscribe(std::move(callback)); }
 
-void SentryClient::publish(const sentry::InboundMessage& message) {
-    auto subscribers = subscribers_[scope(message)];
-    for (auto& subscriber : subscribers) {
-        subscriber(message);
-    }
+void SentryClient::publish(const std::shared_ptr<const sentry::InboundMessage>& message) {
+    dispatcher(scope(*message)).push(message);
 }
 
 void SentryClient::set_status(Hash head_hash, BigInt head_td, const ChainIdentity& chain_identity) {
@@ -85,7 +204,10 @@ void SentryClient::execution_loop() {
 
     // receive messages
     while (!is_stopping() && message_subscription.receive_one_reply()) {
-        const auto& message = message_subscription.reply();
+        // take the reply without copying it: the payload, possibly a large body packet, is handed to subscribers as
+        // is and decoded in place by them, the call gets an empty reply to be filled by the next receive_one_reply()
+        auto message = std::make_shared<sentry::InboundMessage>();
+        message->Swap(&message_subscription.reply());
 
         // SILK_TRACE << "SentryClient received message " << *message;
 
@@ -118,10 +240,14 @@ void SentryClient::stats_receiving_loop() {
         if (stat.event_id() == sentry::PeerEvent::Connect) {
             event = "connected";
             active_peers_++;
+            peer_tracker_.on_connect(peerId);
         } else {
             event = "disconnected";
             if (active_peers_ > 0) active_peers_--; // workaround, to fix this we need to improve the interface
-        }                                           // or issue a count_active_peers()
+                                                    // or issue a count_active_peers()
+            peer_tracker_.on_disconnect(peerId);
+            download_metrics_.forget_peer(peerId);
+        }
 
         log::Info() << "Peer " << peerId << " " << event << ", active " << active_peers_;
     }
@@ -16,11 +16,16 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+
 #include <p2psentry/sentry.grpc.pb.h>
 
 #include <silkworm/chain/identity.hpp>
 #include <silkworm/concurrency/active_component.hpp>
+#include <silkworm/downloader/internals/download_metrics.hpp>
 #include <silkworm/downloader/internals/grpc_sync_client.hpp>
+#include <silkworm/downloader/internals/peer_tracker.hpp>
 #include <silkworm/downloader/internals/sentry_type_casts.hpp>
 #include <silkworm/downloader/internals/types.hpp>
 
@@ -39,11 +44,13 @@ namespace silkworm {
 class SentryClient : public rpc::Client<sentry::Sentry>, public ActiveComponent {
   public:
     using base_t = rpc::Client<sentry::Sentry>;
-    using subscriber_t = std::function<void(const sentry::InboundMessage&)>;
+    using subscriber_t = std::function<void(std::shared_ptr<const sentry::InboundMessage>)>;  // shared, not copied
 
     explicit SentryClient(const std::string& sentry_addr);  // connect to the remote sentry
+    explicit SentryClient(std::shared_ptr<grpc::Channel> channel);  // e.g. in-process channel to an embedded sentry
     SentryClient(const SentryClient&) = delete;
     SentryClient(SentryClient&&) = delete;
+    ~SentryClient() override;  // joins the dispatch threads
 
     void set_status(Hash head_hash, BigInt head_td, const ChainIdentity&);  // init the remote sentry
     void hand_shake();  // needed by the remote sentry, also check the protocol version
@@ -51,6 +58,9 @@ class SentryClient : public rpc::Client<sentry::Sentry>, public ActiveComponent
 
     uint64_t active_peers(); // return cached peers count
 
+    PeerTracker& peer_tracker() { return peer_tracker_; }  // latency & throughput of peers, to choose request targets
+    DownloadMetrics& download_metrics() { return download_metrics_; }  // distributions to be exported
+
     using base_t::exec_remotely;  // exec_remotely(SentryRpc& rpc) sends a rpc request to the remote sentry
 
     enum Scope { BlockRequests = 0x01, BlockAnnouncements = 0x02, Other = 0x04 };
@@ -58,16 +68,31 @@ class SentryClient : public rpc::Client<sentry::Sentry>, public ActiveComponent
 
     void subscribe(Scope, subscriber_t callback);  // subscribe with sentry to receive messages
 
+    // Each scope is dispatched by its own thread from a bounded queue, so that a slow subscriber of a scope (e.g.
+    // serving block requests from db) does not delay the messages of the others. When the queue of a scope is full
+    // BlockAnnouncements apply backpressure (the receiving loop waits) while other scopes drop the message
+    static constexpr size_t kDispatchQueueCapacity{1024};
+
+    [[nodiscard]] DispatchStats dispatch_stats(Scope) const;
+    static const char* scope_name(Scope);
+
     /*[[long_running]]*/ void execution_loop() override;  // do a long-running loop to wait for messages
     /*[[long_running]]*/ void stats_receiving_loop();     // do a long-running loop to wait for peer statistics
 
     static Scope scope(const sentry::InboundMessage& message);  // find the scope of the message
 
   protected:
-    void publish(const sentry::InboundMessage&);  // notifying registered subscribers
+    void publish(const std::shared_ptr<const sentry::InboundMessage>&);  // enqueue to the dispatcher of its scope
+
+    class Dispatcher;
+    static constexpr size_t kScopes{3};
+    [[nodiscard]] Dispatcher& dispatcher(Scope) const;
+    static std::array<std::unique_ptr<Dispatcher>, kScopes> make_dispatchers();
 
-    std::map<Scope, std::list<subscriber_t>> subscribers_;  // todo: optimize
+    std::array<std::unique_ptr<Dispatcher>, kScopes> dispatchers_;  // indexed by the bit of the scope
     std::atomic<uint64_t> active_peers_{0};
+    PeerTracker peer_tracker_;
+    DownloadMetrics download_metrics_;
 };
 
 // custom exception
@@ -123,6 +123,7 @@ Stage::Result BodiesStage::forward([[maybe_unused]] bool first_sync) {
 
         BodyPersistence body_persistence(tx, block_downloader_.chain_identity());
         body_persistence.set_preverified_height(block_downloader_.preverified_hashes().height);
+        body_persistence.set_sender_prerecovery(sender_prerecovery_);
 
         RepeatedMeasure<BlockNum> height_progress(body_persistence.initial_height());
         log::Info() << "[2/16 Bodies] Waiting for bodies... from=" << height_progress.get();
@@ -149,7 +150,12 @@ Stage::Result BodiesStage::forward([[maybe_unused]] bool first_sync) {
                 // read response
                 auto bodies = withdraw_command->result().get();
                 // persist bodies
+                StopWatch persistence_timing{/*auto_start=*/true};
                 body_persistence.persist(bodies);
+                block_downloader_.metrics().observe(
+                    DownloadMetrics::Histogram::BodiesPersistenceMs,
+                    std::chrono::duration<double, std::milli>(persistence_timing.lap_duration()).count(),
+                    std::chrono::system_clock::now());
                 // check unwind condition
                 if (body_persistence.unwind_needed()) {
                     result.status = Result::UnwindNeeded;
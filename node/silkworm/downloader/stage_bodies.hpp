@@ -20,6 +20,7 @@ limitations under the License.
 #include <silkworm/downloader/internals/db_tx.hpp>
 #include <silkworm/downloader/internals/types.hpp>
 #include <silkworm/downloader/messages/internal_message.hpp>
+#include <silkworm/stagedsync/stage_senders/sender_prerecovery.hpp>
 
 #include "block_exchange.hpp"
 #include "stage.h"
@@ -37,6 +38,11 @@ class BodiesStage : public Stage {
     Stage::Result unwind_to(BlockNum new_height,
                             Hash bad_block) override;  // go backward, unwinding headers to new_height
 
+    // optional: hand senders recovery of accepted bodies to a background pool shared with the Senders stage
+    void set_sender_prerecovery(stagedsync::recovery::SenderPrerecovery* prerecovery) {
+        sender_prerecovery_ = prerecovery;
+    }
+
   private:
     void send_body_requests();  // send requests for more bodies
     auto sync_body_sequence(BlockNum highest_body, BlockNum highest_header) -> std::shared_ptr<InternalMessage<void>>;
@@ -45,6 +51,7 @@ class BodiesStage : public Stage {
 
     Db::ReadWriteAccess db_access_;
     BlockExchange& block_downloader_;
+    stagedsync::recovery::SenderPrerecovery* sender_prerecovery_{nullptr};
 };
 
 }  // namespace silkworm
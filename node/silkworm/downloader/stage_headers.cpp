@@ -94,9 +94,14 @@ auto HeadersStage::forward(bool first_sync) -> Stage::Result {
                     // persist headers
                     header_persistence.persist(stable_headers);
 
+                    const auto insertion_duration = insertion_timing.lap_duration();
+                    block_downloader_.metrics().observe(
+                        DownloadMetrics::Histogram::HeadersPersistenceMs,
+                        std::chrono::duration<double, std::milli>(insertion_duration).count(),
+                        std::chrono::system_clock::now());
                     if (stable_headers.size() > 100000) {
                         log::Info() << "[1/16 Headers] Inserted headers tot=" << stable_headers.size()
-                            << " (duration=" << StopWatch::format(insertion_timing.lap_duration()) << "s)";
+                            << " (duration=" << StopWatch::format(insertion_duration) << "s)";
                     }
                 }
 
@@ -79,7 +79,6 @@ class HeadersStage : public Stage {
     auto sync_header_chain(BlockNum highest_in_db) -> std::shared_ptr<InternalMessage<void>>;
     auto withdraw_stable_headers() -> std::shared_ptr<InternalMessage<std::tuple<Headers, bool>>>;
     auto update_bad_headers(std::set<Hash>) -> std::shared_ptr<InternalMessage<void>>;
-    void receive_message(const sentry::InboundMessage&);
 
     Db::ReadWriteAccess db_access_;
     BlockExchange& block_downloader_;
@@ -0,0 +1,195 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "buffer.hpp"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <silkworm/common/endian.hpp>
+
+namespace silkworm::etl {
+
+void Buffer::put(ByteView key, ByteView value) {
+    const size_t length{key.size() + value.size()};
+    if (descriptors_.empty()) {
+        key_length_ = key.size();
+    } else if (key.size() != key_length_) {
+        key_length_ = kVariableKeyLength;
+    }
+
+    // Move to next block (allocating it if needed) when current one is full
+    while (current_block_ < blocks_.size() &&
+           blocks_[current_block_].size() + length > blocks_[current_block_].capacity()) {
+        ++current_block_;
+    }
+    if (current_block_ == blocks_.size()) {
+        auto& block{blocks_.emplace_back()};
+        block.reserve(std::max(length, std::min(optimal_size_, kArenaBlockSize)));
+        account(block.capacity());
+    }
+    Block& block{blocks_[current_block_]};
+
+    const size_t descriptors_capacity{descriptors_.capacity()};
+    Descriptor& d{descriptors_.emplace_back()};
+    if (descriptors_.capacity() != descriptors_capacity) {
+        account((descriptors_.capacity() - descriptors_capacity) * sizeof(Descriptor));
+    }
+    uint8_t prefix[8]{};
+    if (!key.empty()) {
+        std::memcpy(prefix, key.data(), std::min(key.size(), sizeof(prefix)));
+    }
+    d.key_prefix = endian::load_big_u64(prefix);
+    d.block = static_cast<uint32_t>(current_block_);
+    d.offset = static_cast<uint32_t>(block.size());
+    d.key_length = static_cast<uint32_t>(key.size());
+    d.value_length = static_cast<uint32_t>(value.size());
+    block.append(key);
+    block.append(value);
+
+    size_ += length + sizeof(head_t);
+    memory_size_ += length + kEntryOverhead;
+}
+
+void Buffer::shrink(size_t max_size) {
+    if (!descriptors_.empty()) {
+        return;
+    }
+    size_t kept_blocks{0};
+    size_t kept_size{0};
+    while (kept_blocks < blocks_.size() && kept_size + blocks_[kept_blocks].capacity() <= max_size) {
+        kept_size += blocks_[kept_blocks++].capacity();
+    }
+    size_t freed_size{0};
+    for (size_t i{kept_blocks}; i < blocks_.size(); ++i) {
+        freed_size += blocks_[i].capacity();
+    }
+    blocks_.erase(blocks_.begin() + static_cast<std::ptrdiff_t>(kept_blocks), blocks_.end());
+    reserved_size_ -= freed_size;
+    MemoryGovernor::instance().release(MemoryTag::kEtl, freed_size);
+}
+
+bool Buffer::less(const Descriptor& a, const Descriptor& b) const noexcept {
+    if (a.key_prefix != b.key_prefix) {
+        return a.key_prefix < b.key_prefix;
+    }
+    const ByteView a_data{&blocks_[a.block][a.offset], a.key_length + a.value_length};
+    const ByteView b_data{&blocks_[b.block][b.offset], b.key_length + b.value_length};
+    const auto diff{a_data.substr(0, a.key_length).compare(b_data.substr(0, b.key_length))};
+    if (diff != 0) {
+        return diff < 0;
+    }
+    return a_data.substr(a.key_length) < b_data.substr(b.key_length);
+}
+
+void Buffer::radix_sort(std::span<Descriptor> descriptors) const {
+    // One pass over data builds histograms of all digits of key prefixes
+    static constexpr size_t kDigitBits{11};
+    static constexpr size_t kDigits{(64 + kDigitBits - 1) / kDigitBits};
+    static constexpr size_t kBuckets{size_t{1} << kDigitBits};
+    std::vector<std::array<size_t, kBuckets>> counts(kDigits, std::array<size_t, kBuckets>{});
+    for (const Descriptor& d : descriptors) {
+        for (size_t digit{0}; digit < kDigits; ++digit) {
+            ++counts[digit][(d.key_prefix >> (kDigitBits * digit)) & (kBuckets - 1)];
+        }
+    }
+
+    // LSD passes from least significant digit: stable counting sort on each digit, skipping digits
+    // all keys share (e.g. high bytes of block numbers or the zero padding of keys shorter than prefix)
+    std::unique_ptr<Descriptor[]> scratch{new Descriptor[descriptors.size()]};  // No need to zero initialize
+    std::span<Descriptor> from{descriptors};
+    std::span<Descriptor> to{scratch.get(), descriptors.size()};
+    for (size_t digit{0}; digit < kDigits; ++digit) {
+        auto& count{counts[digit]};
+        if (std::find(count.begin(), count.end(), descriptors.size()) != count.end()) {
+            continue;
+        }
+        size_t sum{0};
+        for (auto& c : count) {
+            sum += std::exchange(c, sum);  // Turn counts into starting positions
+        }
+        for (const Descriptor& d : from) {
+            to[count[(d.key_prefix >> (kDigitBits * digit)) & (kBuckets - 1)]++] = d;
+        }
+        std::swap(from, to);
+    }
+    if (from.data() != descriptors.data()) {
+        std::copy(from.begin(), from.end(), descriptors.begin());
+    }
+
+    // Entries sharing the prefix (longer keys or duplicate keys) are ordered by full comparison
+    const auto comparator{[this](const Descriptor& a, const Descriptor& b) { return less(a, b); }};
+    for (auto run_begin{descriptors.begin()}; run_begin != descriptors.end();) {
+        auto run_end{std::find_if(run_begin + 1, descriptors.end(),
+                                  [&](const Descriptor& d) { return d.key_prefix != run_begin->key_prefix; })};
+        if (run_end - run_begin > 1) {
+            std::sort(run_begin, run_end, comparator);
+        }
+        run_begin = run_end;
+    }
+}
+
+void Buffer::sort(size_t num_threads) {
+    const auto comparator{[this](const Descriptor& a, const Descriptor& b) { return less(a, b); }};
+    const auto sort_part{[&](std::vector<Descriptor>::iterator first, std::vector<Descriptor>::iterator last) {
+        if (key_length_ != kVariableKeyLength && last - first >= static_cast<std::ptrdiff_t>(kMinEntriesForRadixSort)) {
+            radix_sort({first, last});
+        } else {
+            std::sort(first, last, comparator);
+        }
+    }};
+
+    const size_t num_parts{std::min(num_threads, descriptors_.size() / kMinEntriesPerSortThread)};
+    if (num_parts < 2) {
+        sort_part(descriptors_.begin(), descriptors_.end());
+        return;
+    }
+
+    std::vector<size_t> bounds(num_parts + 1);
+    for (size_t i{0}; i <= num_parts; ++i) {
+        bounds[i] = descriptors_.size() * i / num_parts;
+    }
+    const auto at{[this](size_t pos) { return descriptors_.begin() + static_cast<std::ptrdiff_t>(pos); }};
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_parts);
+    for (size_t i{0}; i < num_parts; ++i) {
+        threads.emplace_back([&, i] { sort_part(at(bounds[i]), at(bounds[i + 1])); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Merge adjacent sorted runs doubling their width at each round
+    for (size_t width{1}; width < num_parts; width *= 2) {
+        threads.clear();
+        for (size_t i{0}; i + width < num_parts; i += 2 * width) {
+            const size_t first{bounds[i]};
+            const size_t middle{bounds[i + width]};
+            const size_t last{bounds[std::min(i + 2 * width, num_parts)]};
+            threads.emplace_back(
+                [&, first, middle, last] { std::inplace_merge(at(first), at(middle), at(last), comparator); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+}  // namespace silkworm::etl
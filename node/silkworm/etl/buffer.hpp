@@ -17,64 +17,143 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <span>
+#include <thread>
 #include <vector>
 
 #include <silkworm/common/base.hpp>
+#include <silkworm/common/memory.hpp>
+#include <silkworm/common/memory_governor.hpp>
 #include <silkworm/etl/util.hpp>
 
 namespace silkworm::etl {
 
 inline constexpr size_t kInitialBufferCapacity = 32768;
+inline constexpr size_t kMinEntriesPerSortThread = 65536;
+inline constexpr size_t kMinEntriesForRadixSort = 1024;
+inline constexpr size_t kArenaBlockSize = 16_Mebi;
 
 // In ETL, a buffer must be used stores entries, sort them and write them to file
+// Keys and values are appended into large arena blocks and entries are tracked (and sorted) by compact descriptors
+// caching the first bytes of the key: no allocation happens per entry and memory usage is accounted exactly
 class Buffer {
   public:
+    // Memory used by each entry on top of its key and value
+    static constexpr size_t kEntryOverhead{24};
+
     // Not copyable nor movable
     Buffer(const Buffer&) = delete;
     Buffer& operator=(const Buffer&) = delete;
 
-    explicit Buffer(size_t optimal_size) : optimal_size_(optimal_size) { buffer_.reserve(kInitialBufferCapacity); }
-
-    void put(const Entry& entry) {
-        // Add a new entry to the buffer
-        size_ += entry.size() + sizeof(head_t);
-        buffer_.push_back(entry);
+    explicit Buffer(size_t optimal_size) : optimal_size_(optimal_size) {
+        descriptors_.reserve(kInitialBufferCapacity);
+        account(descriptors_.capacity() * sizeof(Descriptor));
     }
 
-    void put(Entry&& entry) {
-        // Add a new entry to the buffer
-        size_ += entry.size() + sizeof(head_t);
-        buffer_.push_back(std::move(entry));
-    }
+    ~Buffer() { MemoryGovernor::instance().release(MemoryTag::kEtl, reserved_size_); }
+
+    // Add a new entry to the buffer
+    void put(ByteView key, ByteView value);
+    void put(const Entry& entry) { put(entry.key, entry.value); }
 
     void clear() noexcept {
-        // Set the buffer to contain 0 entries
-        buffer_.clear();
+        // Set the buffer to contain 0 entries (arena blocks are kept for reuse)
+        descriptors_.clear();
+        for (auto& block : blocks_) {
+            block.clear();
+        }
+        current_block_ = 0;
+        key_length_ = 0;
         size_ = 0;
+        memory_size_ = 0;
     }
 
+    // Free the arena blocks of an empty buffer beyond the first ones holding up to max_size bytes (e.g. once its
+    // collector has been granted less memory than it took)
+    void shrink(size_t max_size);
+
     [[nodiscard]] bool overflows() const noexcept {
-        // Whether accounted size overflows optimal_size_ (i.e. time to flush)
-        return size_ >= optimal_size_;
+        // Whether accounted memory overflows optimal_size_ (i.e. time to flush)
+        return memory_size_ >= optimal_size_;
     }
 
-    void sort() {
-        // Sort buffer in increasing order by key comparison
-        std::sort(buffer_.begin(), buffer_.end());
+    // Sort buffer in increasing order by key comparison
+    // Large buffers are split into up to num_threads parts sorted concurrently and then merged pairwise.
+    // When all keys have the same length, parts are radix sorted on the cached key prefix
+    void sort(size_t num_threads = std::thread::hardware_concurrency());
+
+    void swap(Buffer& other) noexcept {
+        // Exchange contents (and optimal size) with other buffer
+        std::swap(optimal_size_, other.optimal_size_);
+        std::swap(size_, other.size_);
+        std::swap(memory_size_, other.memory_size_);
+        std::swap(reserved_size_, other.reserved_size_);
+        std::swap(current_block_, other.current_block_);
+        std::swap(key_length_, other.key_length_);
+        blocks_.swap(other.blocks_);
+        descriptors_.swap(other.descriptors_);
     }
 
     [[nodiscard]] size_t size() const noexcept {
-        // Actual size of accounted data
+        // Actual size of accounted data once written to file
         return size_;
     }
 
-    [[nodiscard]] const std::vector<Entry>& entries() const noexcept { return buffer_; }
+    [[nodiscard]] size_t memory_size() const noexcept {
+        // Memory used by entries: keys, values and descriptors
+        return memory_size_;
+    }
+
+    [[nodiscard]] size_t reserved_size() const noexcept {
+        // Memory held by arena blocks and descriptors, used or not (as accounted to MemoryTag::kEtl)
+        return reserved_size_;
+    }
+
+    [[nodiscard]] size_t entries_count() const noexcept { return descriptors_.size(); }
+
+    [[nodiscard]] ByteView key(size_t index) const noexcept {
+        const Descriptor& d{descriptors_[index]};
+        return {&blocks_[d.block][d.offset], d.key_length};
+    }
+
+    [[nodiscard]] ByteView value(size_t index) const noexcept {
+        const Descriptor& d{descriptors_[index]};
+        return {&blocks_[d.block][d.offset + d.key_length], d.value_length};
+    }
 
   private:
+    struct Descriptor {
+        uint64_t key_prefix;  // First 8 bytes of key (zero padded) as big endian: most comparisons end here
+        uint32_t block;       // Index of arena block holding key followed by value
+        uint32_t offset;      // Position of key in block
+        uint32_t key_length;
+        uint32_t value_length;
+    };
+    static_assert(sizeof(Descriptor) == kEntryOverhead);
+
+    static constexpr size_t kVariableKeyLength{SIZE_MAX};
+
+    [[nodiscard]] bool less(const Descriptor& a, const Descriptor& b) const noexcept;
+    void radix_sort(std::span<Descriptor> descriptors) const;  // LSD on key prefixes, then comparison within ties
+
+    void account(size_t bytes) noexcept {
+        reserved_size_ += bytes;
+        MemoryGovernor::instance().charge(MemoryTag::kEtl, bytes);
+    }
+
     size_t optimal_size_;
     size_t size_ = 0;
+    size_t memory_size_ = 0;
+    size_t reserved_size_ = 0;
+
+    // Arena blocks are filled in place then sorted through at random: they go to huge pages when enabled
+    using Block = std::basic_string<uint8_t, std::char_traits<uint8_t>, HugePageAllocator<uint8_t>>;
 
-    std::vector<Entry> buffer_;  // buffer for holding entries
+    std::vector<Block> blocks_;  // Arena blocks: Block::size() is the used part, never grown beyond capacity
+    size_t current_block_ = 0;   // Block where next entry is appended (if it fits)
+    size_t key_length_ = 0;      // Length shared by all keys or kVariableKeyLength
+    std::vector<Descriptor> descriptors_;
 };
 
 }  // namespace silkworm::etl
@@ -0,0 +1,64 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/etl/buffer.hpp>
+
+namespace silkworm::etl {
+
+// Sort of 1M entries: fixed width keys like hashed addresses (radix sorted) or keys of length 8 to 40
+static void BM_EtlBuffer_Sort(benchmark::State& state) {
+    const bool fixed_width{state.range(0) != 0};
+    const auto num_threads{static_cast<size_t>(state.range(1))};
+
+    std::mt19937_64 rng{42};
+    std::vector<Entry> entries(1'000'000);
+    for (size_t i{0}; i < entries.size(); ++i) {
+        entries[i].key.resize(fixed_width ? kHashLength : 8 + rng() % 33);
+        for (auto& b : entries[i].key) {
+            b = static_cast<uint8_t>(rng());
+        }
+        entries[i].value.resize(8);
+        endian::store_big_u64(&entries[i].value[0], i);
+    }
+
+    Buffer buffer{512_Mebi};
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        buffer.clear();
+        for (const Entry& entry : entries) {
+            buffer.put(entry);
+        }
+        state.ResumeTiming();
+
+        buffer.sort(num_threads);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * entries.size()));
+}
+BENCHMARK(BM_EtlBuffer_Sort)
+    ->ArgNames({"fixed_width", "threads"})
+    ->Args({0, 1})
+    ->Args({0, 4})
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace silkworm::etl
@@ -0,0 +1,149 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "buffer.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::etl {
+
+TEST_CASE("ETL Buffer sort") {
+    Buffer buffer{256_Mebi};
+    std::vector<Entry> entries;
+    const size_t count{5 * kMinEntriesPerSortThread + 123};  // Uneven parts
+    for (size_t i{0}; i < count; ++i) {
+        // Plenty of repeated keys and of keys sharing the cached prefix, some shorter than it
+        Bytes key(static_cast<size_t>(std::rand()) % 12, '\0');
+        for (auto& byte : key) {
+            byte = static_cast<uint8_t>(std::rand() % 3);
+        }
+        Bytes value(8, '\0');
+        endian::store_big_u64(&value[0], i);
+        entries.push_back({key, value});
+        buffer.put(entries.back());
+    }
+    std::sort(entries.begin(), entries.end());
+
+    SECTION("Single thread") { buffer.sort(/*num_threads=*/1); }
+    SECTION("Multiple threads") { buffer.sort(/*num_threads=*/3); }
+    SECTION("More threads than parts") { buffer.sort(/*num_threads=*/64); }
+
+    REQUIRE(buffer.entries_count() == count);
+    for (size_t i{0}; i < count; ++i) {
+        REQUIRE(buffer.key(i) == entries[i].key);
+        REQUIRE(buffer.value(i) == entries[i].value);
+    }
+}
+
+TEST_CASE("ETL Buffer radix sort of fixed width keys") {
+    const size_t key_length{GENERATE(as<size_t>{}, 4, 8, 32)};
+    const size_t num_threads{GENERATE(as<size_t>{}, 1, 4)};
+
+    Buffer buffer{256_Mebi};
+    std::vector<Entry> entries;
+    const size_t count{4 * kMinEntriesPerSortThread + 7};
+    for (size_t i{0}; i < count; ++i) {
+        Bytes key(key_length, '\0');
+        // Random low bytes (like block numbers) and some duplicate keys
+        endian::store_big_u32(&key[0], static_cast<uint32_t>(std::rand()) % 300'000);
+        if (key_length > 8) {
+            key[key_length - 1] = static_cast<uint8_t>(std::rand());  // Ties on prefix are settled beyond it
+        }
+        Bytes value(static_cast<size_t>(std::rand()) % 3, static_cast<uint8_t>(std::rand()));
+        entries.push_back({key, value});
+        buffer.put(entries.back());
+    }
+    std::sort(entries.begin(), entries.end());
+
+    buffer.sort(num_threads);
+    REQUIRE(buffer.entries_count() == count);
+    for (size_t i{0}; i < count; ++i) {
+        REQUIRE(buffer.key(i) == entries[i].key);
+        REQUIRE(buffer.value(i) == entries[i].value);
+    }
+}
+
+TEST_CASE("ETL Buffer accounting") {
+    Buffer buffer{100};
+    const Bytes small(10, '\x01');
+    const Bytes large(200, '\x02');  // Larger than an arena block
+
+    buffer.put(small, small);
+    CHECK(buffer.size() == 20 + sizeof(head_t));
+    CHECK(buffer.memory_size() == 20 + Buffer::kEntryOverhead);
+    CHECK_FALSE(buffer.overflows());
+
+    buffer.put(large, ByteView{});
+    buffer.put(ByteView{}, small);
+    CHECK(buffer.memory_size() == 230 + 3 * Buffer::kEntryOverhead);
+    CHECK(buffer.overflows());
+
+    REQUIRE(buffer.entries_count() == 3);
+    CHECK(buffer.key(0) == small);
+    CHECK(buffer.value(0) == small);
+    CHECK(buffer.key(1) == large);
+    CHECK(buffer.value(1).empty());
+    CHECK(buffer.key(2).empty());
+    CHECK(buffer.value(2) == small);
+
+    buffer.clear();
+    CHECK(buffer.entries_count() == 0);
+    CHECK(buffer.memory_size() == 0);
+    buffer.put(small, small);
+    CHECK(buffer.key(0) == small);
+}
+
+TEST_CASE("ETL Buffer reserved memory") {
+    auto& governor{MemoryGovernor::instance()};
+    const size_t usage_before{governor.usage(MemoryTag::kEtl)};
+    {
+        Buffer buffer{100};
+        const size_t initial_size{buffer.reserved_size()};
+        CHECK(initial_size == kInitialBufferCapacity * Buffer::kEntryOverhead);
+        buffer.put(Bytes(200, '\x02'), ByteView{});
+        CHECK(buffer.reserved_size() >= initial_size + 200);
+        CHECK(governor.usage(MemoryTag::kEtl) == usage_before + buffer.reserved_size());
+
+        // Cleared arena blocks are kept for reuse, hence still accounted
+        const size_t reserved_size{buffer.reserved_size()};
+        buffer.clear();
+        CHECK(buffer.reserved_size() == reserved_size);
+
+        // Unless shrunk
+        buffer.shrink(0);
+        CHECK(buffer.reserved_size() == initial_size);
+        CHECK(governor.usage(MemoryTag::kEtl) == usage_before + initial_size);
+    }
+    CHECK(governor.usage(MemoryTag::kEtl) == usage_before);
+}
+
+TEST_CASE("ETL Buffer swap") {
+    Buffer a{1_Kibi};
+    Buffer b{2_Kibi};
+    a.put({*from_hex("01"), *from_hex("02")});
+    a.swap(b);
+    CHECK(a.entries_count() == 0);
+    CHECK(a.size() == 0);
+    REQUIRE(b.entries_count() == 1);
+    CHECK(b.key(0) == *from_hex("01"));
+    CHECK(b.size() == 2 + sizeof(head_t));
+}
+
+}  // namespace silkworm::etl
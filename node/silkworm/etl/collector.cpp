@@ -17,10 +17,11 @@
 #include "collector.hpp"
 
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
-#include <queue>
 
 #include <silkworm/common/directories.hpp>
+#include <silkworm/common/instrumentation.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/concurrency/signal_handler.hpp>
 
@@ -28,33 +29,156 @@ namespace silkworm::etl {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+    constexpr const char* kManifestHeader{"silkworm-etl-manifest 1"};
+
+    struct ManifestFile {
+        std::string name;  // Relative to manifest directory
+        size_t size{0};
+        Compression compression{Compression::kNone};
+    };
+
+    struct Manifest {
+        size_t entries_count{0};
+        std::vector<ManifestFile> files;
+    };
+
+    std::optional<Manifest> read_manifest(const fs::path& manifest_path) {
+        std::ifstream stream{manifest_path};
+        if (!stream.is_open()) {
+            return std::nullopt;
+        }
+        std::string header;
+        std::getline(stream, header);
+        Manifest manifest;
+        size_t files_count{0};
+        if (header != kManifestHeader || !(stream >> manifest.entries_count >> files_count)) {
+            throw etl_error("Invalid manifest " + manifest_path.string());
+        }
+        for (size_t i{0}; i < files_count; ++i) {
+            ManifestFile file;
+            int compression{0};
+            if (!(stream >> file.name >> file.size >> compression)) {
+                throw etl_error("Invalid manifest " + manifest_path.string());
+            }
+            file.compression = static_cast<Compression>(compression);
+            manifest.files.push_back(std::move(file));
+        }
+        return manifest;
+    }
+
+    // Tournament (loser) tree over the head entries of k sorted sources: the smallest head is found at the root
+    // and, once its source has advanced, a new winner is found replaying only log2(k) matches from the leaf up.
+    // An exhausted source (nullopt head) loses every match; ties are broken by source index to keep loading stable
+    class LoserTree {
+      public:
+        explicit LoserTree(const std::vector<std::optional<EntryView>>& heads) : heads_{heads}, losers_(heads.size()) {
+            const size_t k{heads_.size()};
+            std::vector<size_t> winners(2 * k);
+            for (size_t i{0}; i < k; ++i) {
+                winners[k + i] = i;
+            }
+            for (size_t node{k - 1}; node > 0; --node) {
+                size_t winner{winners[2 * node]};
+                size_t loser{winners[2 * node + 1]};
+                if (beats(loser, winner)) {
+                    std::swap(winner, loser);
+                }
+                winners[node] = winner;
+                losers_[node] = loser;
+            }
+            losers_[0] = winners[1];
+        }
+
+        //! \brief Index of the source holding the smallest head
+        [[nodiscard]] size_t winner() const noexcept { return losers_[0]; }
+
+        //! \brief Restores the tree after the head of winner() has changed
+        void replay() {
+            size_t winner{losers_[0]};
+            for (size_t node{(heads_.size() + winner) / 2}; node > 0; node /= 2) {
+                if (beats(losers_[node], winner)) {
+                    std::swap(losers_[node], winner);
+                }
+            }
+            losers_[0] = winner;
+        }
+
+      private:
+        [[nodiscard]] bool beats(size_t a, size_t b) const {
+            if (!heads_[a]) {
+                return false;
+            }
+            if (!heads_[b]) {
+                return true;
+            }
+            if (*heads_[a] < *heads_[b]) {
+                return true;
+            }
+            return !(*heads_[b] < *heads_[a]) && a < b;
+        }
+
+        const std::vector<std::optional<EntryView>>& heads_;
+        std::vector<size_t> losers_;  // losers_[0] holds the overall winner
+    };
+
+}  // namespace
+
 Collector::~Collector() {
     clear();  // Will ensure all files (if any) have been orderly closed and deleted
-    if (work_path_managed_ && fs::exists(work_path_)) {
-        fs::remove_all(work_path_);
+    if (work_path_managed_ && fs::exists(work_paths_.front())) {
+        fs::remove_all(work_paths_.front());
     }
 }
 
 void Collector::flush_buffer() {
+    SILK_SCOPED_TIMER("etl::Collector::flush_buffer");
+    wait_for_flush();  // Only one background flush at a time: also back-pressures collection
     if (buffer_.size()) {
-        buffer_.sort();
+        buffer_.swap(flushing_buffer_);
+        lease_.report(buffer_.memory_size());
+        next_report_size_ = buffer_.memory_size() + kReportInterval;
 
-        /* Build a unique file name to pass FileProvider */
+        /* Build a unique file name to pass FileProvider, striping files across work paths */
+        const fs::path& work_path{work_paths_[file_providers_.size() % work_paths_.size()]};
         fs::path new_file_path{
-            work_path_ / fs::path(std::to_string(unique_id_) + "-" + std::to_string(file_providers_.size()) + ".bin")};
+            work_path / fs::path(std::to_string(unique_id_) + "-" + std::to_string(file_providers_.size()) + ".bin")};
+
+        file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size(), compression_));
+        pending_flush_ = std::async(std::launch::async, [this, file_provider = file_providers_.back().get()] {
+            flushing_buffer_.sort();
+            file_provider->flush(flushing_buffer_);
+            flushing_buffer_.clear();
+            flushing_buffer_.shrink(lease_.granted_size());
+            total_flushed_bytes_ += file_provider->get_file_size();
+            log::Info("Collector flushed file", {"path", std::string(file_provider->get_file_name()), "size",
+                                                 human_size(file_provider->get_file_size())});
+        });
+    }
+}
 
-        file_providers_.emplace_back(new FileProvider(new_file_path.string(), file_providers_.size()));
-        file_providers_.back()->flush(buffer_);
-        buffer_.clear();
-        log::Info("Collector flushed file", {"path", std::string(file_providers_.back()->get_file_name()), "size",
-                                             human_size(file_providers_.back()->get_file_size())});
+void Collector::wait_for_flush() {
+    if (pending_flush_.valid()) {
+        pending_flush_.get();
+    }
+}
+
+bool Collector::needs_early_flush() {
+    const size_t memory_size{buffer_.memory_size()};
+    if (memory_size < next_report_size_) {
+        return false;
     }
+    next_report_size_ = memory_size + kReportInterval;
+    lease_.report(memory_size);
+    const bool flush_requested{lease_.take_flush_request()};
+    return flush_requested || memory_size >= lease_.granted_size() || over_memory_budget();
 }
 
 void Collector::collect(const Entry& entry) {
     buffer_.put(entry);
     ++size_;
-    if (buffer_.overflows()) {
+    if (buffer_.overflows() || needs_early_flush()) {
         flush_buffer();
     }
 }
@@ -62,42 +186,173 @@ void Collector::collect(const Entry& entry) {
 void Collector::collect(Entry&& entry) {
     buffer_.put(std::move(entry));
     ++size_;
-    if (buffer_.overflows()) {
+    if (buffer_.overflows() || needs_early_flush()) {
         flush_buffer();
     }
 }
 
+void Collector::merge(Collector& other) {
+    if (work_path_managed_ || other.work_path_managed_) {
+        throw etl_error("Cannot merge collectors managing their own work path");
+    }
+    if (other.empty()) {
+        return;
+    }
+    other.flush_buffer();
+    other.wait_for_flush();
+    for (auto& file_provider : other.file_providers_) {
+        file_providers_.push_back(std::move(file_provider));
+    }
+    other.file_providers_.clear();
+    size_ += other.size_;
+    other.size_ = 0;
+}
+
+void Collector::persist(const fs::path& manifest_path) {
+    discard(manifest_path);
+    flush_buffer();
+    wait_for_flush();
+
+    Manifest manifest{size_, {}};
+    const fs::path directory{manifest_path.parent_path()};
+    fs::create_directories(directory);
+    for (auto& file_provider : file_providers_) {
+        const std::string name{manifest_path.stem().string() + "-" + std::to_string(manifest.files.size()) + ".bin"};
+        file_provider->persist((directory / name).string());
+        manifest.files.push_back({name, file_provider->get_file_size(), compression_});
+    }
+
+    // Write aside and rename so a manifest is either complete or missing
+    fs::path temp_path{manifest_path};
+    temp_path += ".tmp";
+    {
+        std::ofstream stream{temp_path, std::ios_base::out | std::ios_base::trunc};
+        stream << kManifestHeader << "\n" << manifest.entries_count << " " << manifest.files.size() << "\n";
+        for (const auto& file : manifest.files) {
+            stream << file.name << " " << file.size << " " << static_cast<int>(file.compression) << "\n";
+        }
+        stream.close();
+        if (!stream) {
+            throw etl_error("Unable to write manifest " + temp_path.string());
+        }
+    }
+    fs::rename(temp_path, manifest_path);
+}
+
+void Collector::restore(const fs::path& manifest_path) {
+    if (!empty()) {
+        throw etl_error("Cannot restore into a non empty collector");
+    }
+    const auto manifest{read_manifest(manifest_path)};
+    if (!manifest) {
+        throw etl_error("Missing manifest " + manifest_path.string());
+    }
+    const fs::path directory{manifest_path.parent_path()};
+    std::vector<std::unique_ptr<FileProvider>> file_providers;
+    for (const auto& file : manifest->files) {
+        auto& file_provider{file_providers.emplace_back(
+            new FileProvider((directory / file.name).string(), file_providers.size(), file.compression))};
+        file_provider->open();
+        if (file_provider->get_file_size() != file.size) {
+            throw etl_error("Truncated file " + file_provider->get_file_name());
+        }
+    }
+    file_providers_ = std::move(file_providers);
+    size_ = manifest->entries_count;
+}
+
+void Collector::discard(const fs::path& manifest_path) {
+    std::optional<Manifest> manifest;
+    try {
+        manifest = read_manifest(manifest_path);
+    } catch (const etl_error&) {
+        // Remove the broken manifest anyway: its files, if any, are going to be overwritten
+    }
+    std::error_code ec;
+    if (manifest) {
+        for (const auto& file : manifest->files) {
+            fs::remove(manifest_path.parent_path() / file.name, ec);
+        }
+    }
+    fs::remove(manifest_path, ec);
+}
+
 void Collector::load(mdbx::cursor& target, const LoadFunc& load_func, MDBX_put_flags_t flags) {
+    const bool in_memory{file_providers_.empty()};
+    Entry etl_entry;  // Reused: load_func wants an Entry while records are views on buffer arena or mapped files
+    consume([&](const EntryView& entry) {
+        if (load_func) {
+            etl_entry.key.assign(entry.key);
+            etl_entry.value.assign(entry.value);
+            load_func(etl_entry, target, flags);
+        } else {
+            mdbx::slice k{db::to_slice(entry.key)};
+
+            if (in_memory && entry.value.empty()) {
+                target.erase(k);
+            } else {
+                mdbx::slice v{db::to_slice(entry.value)};
+                mdbx::error::success_or_throw(target.put(k, &v, flags));
+            }
+        }
+    });
+}
+
+void Collector::load(db::BulkLoader& loader) {
+    consume([&loader](const EntryView& entry) { loader.append(entry.key, entry.value); });
+}
+
+void Collector::load(db::BulkLoader& loader,
+                     const std::function<void(const EntryView&, db::BulkLoader&)>& load_func) {
+    consume([&](const EntryView& entry) { load_func(entry, loader); });
+}
+
+void Collector::consume(const std::function<void(const EntryView&)>& load_entry) {
+    SILK_SCOPED_TIMER("etl::Collector::load");
     size_t counter{32};  // Every 32 entry we track the key being loaded
     set_loading_key({});
 
+    // Both only apply to this load
+    const auto resume_key{std::move(resume_key_)};
+    resume_key_.reset();
+    const auto checkpoint_func{std::move(checkpoint_func_)};
+    checkpoint_func_ = nullptr;
+
     if (empty()) {
         return;
     }
 
+    // Skips already loaded entries and raises checkpoints (if requested) in between distinct keys
+    Bytes last_key;
+    size_t since_checkpoint{0};
+    const auto func{[&](const EntryView& entry) {
+        if (resume_key && entry.key <= ByteView{*resume_key}) {
+            return;
+        }
+        if (checkpoint_func) {
+            if (since_checkpoint && since_checkpoint >= checkpoint_interval_ && entry.key != ByteView{last_key}) {
+                checkpoint_func(last_key);
+                since_checkpoint = 0;
+            }
+            last_key.assign(entry.key);
+            ++since_checkpoint;
+        }
+        load_entry(entry);
+    }};
+
     if (file_providers_.empty()) {
         buffer_.sort();
 
-        for (const auto& etl_entry : buffer_.entries()) {
+        for (size_t i{0}; i < buffer_.entries_count(); ++i) {
+            const EntryView entry{buffer_.key(i), buffer_.value(i)};
             if (!--counter) {
                 if (SignalHandler::signalled()) {
                     throw std::runtime_error("Operation cancelled");
                 }
                 counter = 32;
-                set_loading_key(etl_entry.key);
-            }
-            if (load_func) {
-                load_func(etl_entry, target, flags);
-            } else {
-                mdbx::slice k{db::to_slice(etl_entry.key)};
-
-                if (etl_entry.value.empty()) {
-                    target.erase(k);
-                } else {
-                    mdbx::slice v{db::to_slice(etl_entry.value)};
-                    mdbx::error::success_or_throw(target.put(k, &v, flags));
-                }
+                set_loading_key(entry.key);
             }
+            func(entry);
         }
 
         size_ = 0;
@@ -107,60 +362,35 @@ void Collector::load(mdbx::cursor& target, const LoadFunc& load_func, MDBX_put_f
 
     // Flush not overflown buffer data to file
     flush_buffer();
+    wait_for_flush();
 
-    // Define a priority queue based on smallest available key
-    auto key_comparer = [](const std::pair<Entry, size_t>& left, const std::pair<Entry, size_t>& right) {
-        return right.first < left.first;
-    };
-    std::priority_queue<std::pair<Entry, size_t>, std::vector<std::pair<Entry, size_t>>, decltype(key_comparer)> queue(
-        key_comparer);
-
-    // Read one "record" from each data_provider and let the queue
-    // sort them. On top of the queue the smallest key
+    // Read one "record" from each file provider and let the tournament tree pick the smallest key
+    // Records are views into mapped files. Each provider has the kernel read its mapped window ahead: windows of
+    // files on different devices are thus read in parallel while the merge goes on
+    std::vector<std::optional<EntryView>> heads;
+    heads.reserve(file_providers_.size());
     for (auto& file_provider : file_providers_) {
-        auto item{file_provider->read_entry()};
-        if (item.has_value()) {
-            queue.push(std::move(*item));
-        }
+        heads.push_back(file_provider->read_entry());
     }
+    LoserTree tree{heads};
 
-    // Process the queue from smallest to largest key
-    while (!queue.empty()) {
-        auto& [etl_entry, provider_index]{queue.top()};           // Pick the smallest key by reference
-        auto& file_provider{file_providers_.at(provider_index)};  // and set current file provider
+    // Process from smallest to largest key
+    for (size_t provider_index{tree.winner()}; heads[provider_index]; provider_index = tree.winner()) {
+        const EntryView& entry{*heads[provider_index]};
 
         if (!--counter) {
             if (SignalHandler::signalled()) {
                 throw std::runtime_error("Operation cancelled");
             }
             counter = 32;
-            set_loading_key(etl_entry.key);
+            set_loading_key(entry.key);
         }
+        func(entry);
 
-        // Process linked pairs
-        if (load_func) {
-            load_func(etl_entry, target, flags);
-        } else {
-            mdbx::slice k{db::to_slice(etl_entry.key)};
-            mdbx::slice v{db::to_slice(etl_entry.value)};
-            mdbx::error::success_or_throw(target.put(k, &v, flags));
-        }
-
-        // From the provider which has served the current key
-        // read next "record"
-        auto next{file_provider->read_entry()};
-
-        // At this point `current` has been processed.
-        // We can remove it from the queue
-        queue.pop();
-
-        // Add next item to the queue only if it has
-        // meaningful data
-        if (next.has_value()) {
-            queue.push(std::move(*next));
-        } else {
-            file_provider.reset();
-        }
+        // From the provider which has served the current key read next "record"
+        // and replay the matches on its path
+        heads[provider_index] = file_providers_[provider_index]->read_entry();
+        tree.replay();
     }
     size_ = 0;  // We have consumed all items
 }
@@ -187,4 +417,12 @@ std::filesystem::path Collector::set_work_path(const std::optional<std::filesyst
     return res;
 }
 
+std::vector<fs::path> Collector::set_work_paths(const fs::path& work_path, const std::vector<fs::path>& extra_paths) {
+    std::vector<fs::path> res{set_work_path(work_path)};
+    for (const auto& extra_path : extra_paths) {
+        res.push_back(set_work_path(extra_path));
+    }
+    return res;
+}
+
 }  // namespace silkworm::etl
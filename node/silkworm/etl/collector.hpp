@@ -13,12 +13,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <mutex>
+#include <vector>
 
+#include <silkworm/common/memory_governor.hpp>
 #include <silkworm/common/settings.hpp>
 #include <silkworm/db/mdbx.hpp>
 #include <silkworm/etl/buffer.hpp>
 #include <silkworm/etl/file_provider.hpp>
+#include <silkworm/etl/memory_arbiter.hpp>
 #include <silkworm/etl/util.hpp>
 
 // ETL : Extract, Transform, Load
@@ -31,21 +36,56 @@ inline constexpr size_t kOptimalBufferSize = 256_Mebi;
 // Function pointer to process Load on before Load data into tables
 using LoadFunc = std::function<void(const Entry&, mdbx::cursor&, MDBX_put_flags_t)>;
 
+// Function invoked along a load with the last key whose entries have all been loaded
+using CheckpointFunc = std::function<void(ByteView last_key)>;
+
 // Collects data Extracted from db
+// Collection is double-buffered: once a buffer overflows it gets sorted and flushed to file
+// on a separate thread while collection goes on into the other one. Hence memory usage peaks at twice the buffer size
+// The buffer size is an upper bound: all live collectors share the ETL budget (see MemoryArbiter), which may have
+// them flush earlier
 class Collector {
   public:
     // Not copyable nor movable
     Collector(const Collector&) = delete;
     Collector& operator=(const Collector&) = delete;
 
-    explicit Collector(const NodeSettings* node_settings)
+    explicit Collector(const NodeSettings* node_settings) : Collector(node_settings, node_settings->etl_buffer_size) {}
+
+    //! \brief Same as above with a buffer size of its own (e.g. one of many collectors filled in parallel)
+    Collector(const NodeSettings* node_settings, size_t optimal_size)
+        : work_path_managed_{false},
+          work_paths_{set_work_paths(node_settings->data_directory->etl().path(), node_settings->etl_extra_paths)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size},
+          compression_{node_settings->etl_compression},
+          lease_{MemoryArbiter::instance(), optimal_size} {}
+    explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize,
+                       Compression compression = Compression::kNone)
+        : work_path_managed_{false},
+          work_paths_{set_work_path(work_path)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size},
+          compression_{compression},
+          lease_{MemoryArbiter::instance(), optimal_size} {}
+
+    //! \brief Flushed files are striped round-robin across work_paths (e.g. directories on distinct devices), so that
+    //! both flushes and loads spread their I/O over all of them
+    explicit Collector(const std::vector<std::filesystem::path>& work_paths, size_t optimal_size = kOptimalBufferSize,
+                       Compression compression = Compression::kNone)
         : work_path_managed_{false},
-          work_path_{set_work_path(node_settings->data_directory->etl().path())},
-          buffer_{node_settings->etl_buffer_size} {};
-    explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{false}, work_path_{set_work_path(work_path)}, buffer_{optimal_size} {}
+          work_paths_{set_work_paths(work_paths.at(0),
+                                     std::vector<std::filesystem::path>(work_paths.begin() + 1, work_paths.end()))},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size},
+          compression_{compression},
+          lease_{MemoryArbiter::instance(), optimal_size} {}
     explicit Collector(size_t optimal_size = kOptimalBufferSize)
-        : work_path_managed_{true}, work_path_{set_work_path(std::nullopt)}, buffer_{optimal_size} {}
+        : work_path_managed_{true},
+          work_paths_{set_work_path(std::nullopt)},
+          buffer_{optimal_size},
+          flushing_buffer_{optimal_size},
+          lease_{MemoryArbiter::instance(), optimal_size} {}
 
     ~Collector();
 
@@ -60,6 +100,43 @@ class Collector {
     void load(mdbx::cursor& target, const LoadFunc& load_func = {},
               MDBX_put_flags_t flags = MDBX_put_flags_t::MDBX_UPSERT);
 
+    //! \brief Loads collected entries (as they are) into a map being rebuilt from scratch
+    //! \param [in] loader : a bulk loader on target map, which might commit along the way
+    void load(db::BulkLoader& loader);
+
+    //! \brief Loads collected entries, as transformed by load_func, into a map being rebuilt from scratch
+    //! \remarks load_func is in charge of appending to loader any number of records (none included) per entry
+    void load(db::BulkLoader& loader, const std::function<void(const EntryView&, db::BulkLoader&)>& load_func);
+
+    //! \brief Moves all entries collected by other into this instance: loading then walks entries of both in order
+    //! \remarks Entries of other are flushed to files, which are handed over to this instance. Both collectors must not
+    //! manage their own work path (i.e. must be built with a path), as a managed one is removed along with its files
+    void merge(Collector& other);
+
+    //! \brief Flushes all collected entries to files which, along with a manifest listing them, outlive this instance
+    //! \param [in] manifest_path : the manifest file (any former one with its files is discarded). Files are placed
+    //! next to it and named after it
+    //! \remarks Persisted files are kept even once loaded: use discard to get rid of them
+    void persist(const std::filesystem::path& manifest_path);
+
+    //! \brief Re-opens the files listed in a manifest written by persist (possibly by a previous run)
+    //! \remarks Throws etl_error if this instance is not empty or any of the files is missing or truncated
+    void restore(const std::filesystem::path& manifest_path);
+
+    //! \brief Removes a manifest written by persist along with all its files (if any)
+    static void discard(const std::filesystem::path& manifest_path);
+
+    //! \brief Next load skips all entries with a key lower than or equal to key (i.e. already loaded ones)
+    void set_resume_key(ByteView key) { resume_key_ = Bytes{key}; }
+
+    //! \brief Next load invokes func about every interval entries, in between two distinct keys
+    //! \remarks func gets the last key loaded: being on a key boundary, a load resumed after it (see
+    //! set_resume_key) loads exactly the remaining entries
+    void set_checkpoint(size_t interval, CheckpointFunc func) {
+        checkpoint_interval_ = interval;
+        checkpoint_func_ = std::move(func);
+    }
+
     //! \brief Returns the number of actually collected items
     [[nodiscard]] size_t size() const { return size_; }
 
@@ -68,11 +145,23 @@ class Collector {
 
     //! \brief Clears contents of collector and reset
     void clear() {
+        if (pending_flush_.valid()) {
+            pending_flush_.wait();  // Errors are irrelevant: files are going away
+            pending_flush_ = {};
+        }
         file_providers_.clear();
         buffer_.clear();
+        flushing_buffer_.clear();
+        lease_.report(0);
+        next_report_size_ = kReportInterval;
         size_ = 0;
+        resume_key_.reset();
+        checkpoint_func_ = nullptr;
     }
 
+    //! \brief Returns the number of bytes all collectors have flushed to files since the start of the process
+    [[nodiscard]] static uint64_t total_flushed_bytes() { return total_flushed_bytes_.load(); }
+
     //! \brief Returns the hex representation of current load key (for progress tracking)
     [[nodiscard]] std::string get_load_key() const {
         std::unique_lock l{mutex_};
@@ -81,8 +170,24 @@ class Collector {
 
   private:
     static std::filesystem::path set_work_path(const std::optional<std::filesystem::path>& provided_work_path);
+    static std::vector<std::filesystem::path> set_work_paths(const std::filesystem::path& work_path,
+                                                             const std::vector<std::filesystem::path>& extra_paths);
 
-    void flush_buffer();  // Write buffer to file
+    // Walks all collected entries in increasing order (tracking load key and honoring cancellation)
+    void consume(const std::function<void(const EntryView&)>& func);
+
+    //! \brief Whether buffer is worth flushing early as the node is over its memory budget: flushing spares the
+    //! allocation of further arena blocks, the ones in place being reused
+    [[nodiscard]] bool over_memory_budget() const noexcept {
+        return buffer_.memory_size() >= kArenaBlockSize && MemoryGovernor::instance().over_budget();
+    }
+
+    //! \brief Whether buffer has to be flushed before overflowing: beyond the size granted by the arbiter, when asked
+    //! to by it or over the memory budget. Checked (and reported to the arbiter) every kReportInterval bytes
+    [[nodiscard]] bool needs_early_flush();
+
+    void flush_buffer();    // Hand buffer over to a background task sorting and writing it to file
+    void wait_for_flush();  // Wait for background flush (if any) to complete and rethrow its errors
 
     void set_loading_key(ByteView key) {
         std::unique_lock l{mutex_};
@@ -90,26 +195,37 @@ class Collector {
     }
 
     bool work_path_managed_;
-    std::filesystem::path work_path_;
-    Buffer buffer_;
+    std::vector<std::filesystem::path> work_paths_;  // Flushed files go round-robin (a managed path is the only one)
+    Buffer buffer_;                                // Entries being collected
+    Buffer flushing_buffer_;                       // Entries being sorted and written by pending_flush_
+    std::future<void> pending_flush_;              // Background flush of flushing_buffer_
+    Compression compression_{Compression::kNone};  // Compression of flushed files
+    MemoryArbiter::Lease lease_;                   // Share of the ETL budget (see MemoryArbiter)
+
+    static constexpr size_t kReportInterval{1_Mebi};
+    size_t next_report_size_{kReportInterval};  // Buffer memory size of next report to lease_
 
     /*
      * TL;DR; In no way two instances of collector can have
      * the same unique_id_
      *
-     * This id will be unique across the application
-     * No other object will be located at the same address
-     * If this object gets destroyed another object may get
-     * the same address but in such case all dependant files
-     * would be already destroyed too thus keeping file
-     * names uniqueness.
+     * This id will be unique across the application for its
+     * whole lifetime: files of a collector may outlive it
+     * once merged into another one, hence the address of
+     * the object would not be enough
      */
-    uintptr_t unique_id_{reinterpret_cast<uintptr_t>(this)};
+    static inline std::atomic<uint64_t> next_unique_id_{0};
+    const uint64_t unique_id_{next_unique_id_++};
+
+    static inline std::atomic<uint64_t> total_flushed_bytes_{0};  // Across all instances (for metrics)
 
     std::vector<std::unique_ptr<FileProvider>> file_providers_;  // Collection of file providers
     size_t size_{0};                                             // Total collected size
     mutable std::mutex mutex_{};                                 // To sync loading_key_
     std::string loading_key_{};                                  // Actual load key (for log purposes)
+    std::optional<Bytes> resume_key_;                            // Entries up to this key are skipped while loading
+    size_t checkpoint_interval_{0};                              // Loaded entries in between checkpoints
+    CheckpointFunc checkpoint_func_;                             // Invoked on checkpoints of next load (if any)
 };
 
 }  // namespace silkworm::etl
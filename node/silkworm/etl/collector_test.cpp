@@ -13,6 +13,8 @@
 
 #include "collector.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 #include <set>
 #include <thread>
@@ -63,7 +65,7 @@ void run_collector_test(LoadFunc load_func, bool do_copy = true) {
     auto set{generate_entry_set(1000)};  // 1000 entries in total
     size_t generated_size{0};
     for (const auto& entry : set) {
-        generated_size += entry.size() + 8;
+        generated_size += entry.size() + Buffer::kEntryOverhead;
     }
     auto collector{Collector(context.dir().etl().path(), generated_size / 10)};  // expect 10 files
 
@@ -74,8 +76,9 @@ void run_collector_test(LoadFunc load_func, bool do_copy = true) {
         else
             collector.collect(std::move(entry));
     }
-    // Check whether temporary files were generated
-    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 10);
+    // Check whether temporary files were generated (last one might still be in the works on background thread)
+    const auto num_files{std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{})};
+    CHECK((num_files == 9 || num_files == 10));
 
     // Load data while reading loading key from another thread
     auto key_reader_thread = std::thread([&collector]() -> void {
@@ -106,4 +109,177 @@ TEST_CASE("collect_and_load") {
     });
 }
 
+static void run_many_files_test(Compression compression) {
+    test::Context context;
+
+    // Many small files, each holding a slice of entries, some keys repeated across files
+    auto set{generate_entry_set(5000)};
+    for (size_t i{0}; i < 500; ++i) {
+        set.push_back(set[i * 7]);
+    }
+    auto collector{Collector(context.dir().etl().path(), 1_Kibi, compression)};
+    for (const auto& entry : set) {
+        collector.collect(entry);
+    }
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) > 100);
+
+    std::vector<Entry> loaded;
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to, [&loaded](const Entry& entry, mdbx::cursor&, MDBX_put_flags_t) { loaded.push_back(entry); });
+
+    std::sort(set.begin(), set.end());
+    REQUIRE(loaded.size() == set.size());
+    for (size_t i{0}; i < set.size(); ++i) {
+        CHECK(loaded[i].key == set[i].key);
+        CHECK(loaded[i].value == set[i].value);
+    }
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+}
+
+TEST_CASE("collect_and_load_many_files_in_order") { run_many_files_test(Compression::kNone); }
+
+TEST_CASE("collect_and_load_many_compressed_files_in_order") { run_many_files_test(Compression::kLz4); }
+
+TEST_CASE("collect_and_load_striped_files") {
+    test::Context context;
+    const std::vector<fs::path> work_paths{context.dir().etl().path() / "a", context.dir().etl().path() / "b"};
+    const auto files_count{[](const fs::path& path) {
+        return std::distance(fs::directory_iterator{path}, fs::directory_iterator{});
+    }};
+
+    auto set{generate_entry_set(3000)};
+    Collector collector(work_paths, 1_Kibi);
+    for (const auto& entry : set) {
+        collector.collect(entry);
+    }
+    // Files go round-robin (last one might still be in the works on background thread)
+    CHECK(files_count(work_paths[0]) > 10);
+    CHECK(std::abs(files_count(work_paths[0]) - files_count(work_paths[1])) <= 2);
+
+    std::vector<Entry> loaded;
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to, [&loaded](const Entry& entry, mdbx::cursor&, MDBX_put_flags_t) { loaded.push_back(entry); });
+
+    std::sort(set.begin(), set.end());
+    REQUIRE(loaded.size() == set.size());
+    for (size_t i{0}; i < set.size(); ++i) {
+        CHECK(loaded[i].key == set[i].key);
+        CHECK(loaded[i].value == set[i].value);
+    }
+    CHECK(files_count(work_paths[0]) == 0);
+    CHECK(files_count(work_paths[1]) == 0);
+}
+
+TEST_CASE("merge_collectors") {
+    test::Context context;
+
+    // Entries are spread over collectors holding either files or in memory data only
+    auto set{generate_entry_set(3000)};
+    Collector collector(context.dir().etl().path(), 1_Kibi);
+    Collector other_with_files(context.dir().etl().path(), 1_Kibi);
+    Collector other_in_memory(context.dir().etl().path());
+    Collector other_empty(context.dir().etl().path());
+    for (size_t i{0}; i < set.size(); ++i) {
+        switch (i % 3) {
+            case 0:
+                collector.collect(set[i]);
+                break;
+            case 1:
+                other_with_files.collect(set[i]);
+                break;
+            default:
+                other_in_memory.collect(set[i]);
+        }
+    }
+
+    collector.merge(other_with_files);
+    collector.merge(other_in_memory);
+    collector.merge(other_empty);
+    CHECK(collector.size() == set.size());
+    CHECK(other_with_files.empty());
+    CHECK(other_in_memory.empty());
+
+    Collector managed;
+    CHECK_THROWS_AS(collector.merge(managed), etl_error);
+
+    std::vector<Entry> loaded;
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+    collector.load(to, [&loaded](const Entry& entry, mdbx::cursor&, MDBX_put_flags_t) { loaded.push_back(entry); });
+
+    std::sort(set.begin(), set.end());
+    REQUIRE(loaded.size() == set.size());
+    for (size_t i{0}; i < set.size(); ++i) {
+        CHECK(loaded[i].key == set[i].key);
+        CHECK(loaded[i].value == set[i].value);
+    }
+    CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+}
+
+TEST_CASE("persist_and_restore_collector") {
+    test::Context context;
+
+    auto set{generate_entry_set(3000)};
+    const fs::path manifest_path{context.dir().etl().path() / "collector.manifest"};
+    {
+        Collector collector(context.dir().etl().path(), 1_Kibi, Compression::kLz4);
+        for (const auto& entry : set) {
+            collector.collect(entry);
+        }
+        collector.persist(manifest_path);
+    }
+    std::sort(set.begin(), set.end());
+    CHECK(fs::exists(manifest_path));
+
+    auto to{db::open_cursor(context.txn(), db::table::kHeaderNumbers)};
+
+    SECTION("Load is interrupted and resumed after last checkpoint") {
+        std::vector<Entry> loaded;
+        Bytes checkpoint_key;
+        {
+            Collector collector(context.dir().etl().path());
+            collector.restore(manifest_path);
+            CHECK(collector.size() == set.size());
+            collector.set_checkpoint(100, [&](ByteView last_key) {
+                CHECK(ByteView{loaded.back().key} == last_key);
+                checkpoint_key = last_key;
+                if (loaded.size() > 1000) {
+                    throw std::runtime_error("Interrupted");
+                }
+            });
+            CHECK_THROWS_AS(collector.load(to, [&loaded](const Entry& entry, mdbx::cursor&, MDBX_put_flags_t) {
+                loaded.push_back(entry);
+            }),
+                            std::runtime_error);
+        }
+        REQUIRE(!checkpoint_key.empty());
+        while (loaded.back().key != checkpoint_key) {
+            loaded.pop_back();  // Loaded past the checkpoint: will be loaded again
+        }
+
+        Collector collector(context.dir().etl().path());
+        collector.restore(manifest_path);
+        collector.set_resume_key(checkpoint_key);
+        collector.load(to, [&loaded](const Entry& entry, mdbx::cursor&, MDBX_put_flags_t) { loaded.push_back(entry); });
+        REQUIRE(loaded.size() == set.size());
+        for (size_t i{0}; i < set.size(); ++i) {
+            CHECK(loaded[i].key == set[i].key);
+            CHECK(loaded[i].value == set[i].value);
+        }
+
+        // Files are kept until discarded
+        CHECK(fs::exists(manifest_path));
+        Collector::discard(manifest_path);
+        CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+    }
+
+    SECTION("Missing files are reported") {
+        fs::remove(context.dir().etl().path() / "collector-0.bin");
+        Collector collector(context.dir().etl().path());
+        CHECK_THROWS_AS(collector.restore(manifest_path), etl_error);
+        Collector::discard(manifest_path);
+        CHECK_THROWS_AS(collector.restore(manifest_path), etl_error);
+        CHECK(std::distance(fs::directory_iterator{context.dir().etl().path()}, fs::directory_iterator{}) == 0);
+    }
+}
+
 }  // namespace silkworm::etl
@@ -16,24 +16,30 @@
 
 #include "file_provider.hpp"
 
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 
 #include <silkworm/common/cast.hpp>
 
 namespace silkworm::etl {
 
 namespace fs = std::filesystem;
+namespace bip = boost::interprocess;
 
 // https://abseil.io/tips/117
-FileProvider::FileProvider(std::string file_name, size_t id) : id_{id}, file_name_{std::move(file_name)} {}
+FileProvider::FileProvider(std::string file_name, size_t id, Compression compression)
+    : id_{id}, file_name_{std::move(file_name)}, compression_{compression} {}
 
 FileProvider::~FileProvider() { reset(); }
 
 void FileProvider::flush(Buffer& buffer) {
     head_t head{};
 
-    // Check we have enough space to store all data
-    auto entries{buffer.entries()};
+    // Check we have enough space to store all data (compression can only help)
     file_size_ = buffer.size();
     fs::path workdir(fs::path(file_name_).parent_path());
     if (fs::space(workdir).available < file_size_) {
@@ -42,68 +48,224 @@ void FileProvider::flush(Buffer& buffer) {
     }
 
     // Open file for output and flush data
-    file_.open(file_name_, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-    if (!file_.is_open()) {
+    std::ofstream file{file_name_, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+    if (!file.is_open()) {
         reset();
         throw etl_error(errno2str(errno));
     }
 
-    for (const auto& entry : entries) {
-        head.lengths[0] = entry.key.size();
-        head.lengths[1] = entry.value.size();
-        if (!file_.write(byte_ptr_cast(head.bytes), 8) ||
-            !file_.write(byte_ptr_cast(entry.key.data()), static_cast<std::streamsize>(entry.key.size())) ||
-            !file_.write(byte_ptr_cast(entry.value.data()), static_cast<std::streamsize>(entry.value.size()))) {
+    size_t written{0};
+    auto write_bytes{[&](const uint8_t* data, size_t length) {
+        if (!file.write(byte_ptr_cast(data), static_cast<std::streamsize>(length))) {
             auto err{errno};
+            file.close();
             reset();
             throw etl_error(errno2str(err));
         }
+        written += length;
+    }};
+
+    Bytes block;  // Raw entries of the block being compressed
+    auto write_block{[&]() {
+        head_t frame{};
+        compressed_.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(block.size()))));
+        const int compressed_size{LZ4_compress_default(byte_ptr_cast(block.data()), byte_ptr_cast(compressed_.data()),
+                                                       static_cast<int>(block.size()),
+                                                       static_cast<int>(compressed_.size()))};
+        if (compressed_size <= 0) {
+            file.close();
+            reset();
+            throw etl_error("Unable to compress block");
+        }
+        frame.lengths[0] = static_cast<uint32_t>(compressed_size);
+        frame.lengths[1] = static_cast<uint32_t>(block.size());
+        write_bytes(frame.bytes, sizeof(head_t));
+        write_bytes(compressed_.data(), static_cast<size_t>(compressed_size));
+        block.clear();
+    }};
+
+    if (compression_ != Compression::kNone) {
+        block.reserve(kCompressionBlockSize + kCompressionBlockSize / 8);
     }
 
-    // Close file in output mode and reopen for input mode
-    // This is actually not strictly needed but amends an odd behavior on Windows
-    // which prevents correct display of file size if the handle
-    // has not been closed
-    file_.close();
-    file_.open(file_name_, std::ios_base::in | std::ios_base::binary);
-    if (!file_.is_open()) {
+    for (size_t i{0}; i < buffer.entries_count(); ++i) {
+        const ByteView key{buffer.key(i)};
+        const ByteView value{buffer.value(i)};
+        head.lengths[0] = static_cast<uint32_t>(key.size());
+        head.lengths[1] = static_cast<uint32_t>(value.size());
+        if (compression_ == Compression::kNone) {
+            write_bytes(head.bytes, sizeof(head_t));
+            write_bytes(key.data(), key.size());
+            write_bytes(value.data(), value.size());
+        } else {
+            block.append(head.bytes, sizeof(head_t));
+            block.append(key);
+            block.append(value);
+            if (block.size() >= kCompressionBlockSize) {
+                write_block();
+            }
+        }
+    }
+    if (!block.empty()) {
+        write_block();
+    }
+    compressed_.clear();
+    compressed_.shrink_to_fit();
+
+    // Close file in output mode (so all data hits the file) and map it for input
+    file.close();
+    if (!file) {
         auto err{errno};
         reset();
         throw etl_error(errno2str(err));
     }
+    file_size_ = written;
+    try {
+        mapping_ = bip::file_mapping(file_name_.c_str(), bip::read_only);
+    } catch (const bip::interprocess_exception& ex) {
+        reset();
+        throw etl_error(ex.what());
+    }
 }
 
-std::optional<std::pair<Entry, size_t>> FileProvider::read_entry() {
-    head_t head{};
-
-    if (!file_.is_open() || !file_size_) {
+std::optional<EntryView> FileProvider::read_entry() {
+    if (!file_size_) {
         throw etl_error("Invalid file handle");
     }
 
-    if (!file_.read(byte_ptr_cast(head.bytes), 8)) {
+    head_t head{};
+    if (compression_ == Compression::kNone) {
+        if (position_ == file_size_) {
+            reset();
+            return std::nullopt;
+        }
+        std::memcpy(head.bytes, map(position_, sizeof(head_t)).data(), sizeof(head_t));
+        const ByteView data{map(position_ + sizeof(head_t), size_t{head.lengths[0]} + head.lengths[1])};
+        position_ += sizeof(head_t) + data.size();
+        return EntryView{data.substr(0, head.lengths[0]), data.substr(head.lengths[0])};
+    }
+
+    if (block_position_ == block_.size() && !read_compressed_block()) {
         reset();
         return std::nullopt;
     }
+    const ByteView data{ByteView{block_}.substr(block_position_)};
+    if (data.size() < sizeof(head_t)) {
+        throw etl_error("Corrupted block in file " + file_name_);
+    }
+    std::memcpy(head.bytes, data.data(), sizeof(head_t));
+    const size_t length{size_t{head.lengths[0]} + head.lengths[1]};
+    if (data.size() - sizeof(head_t) < length) {
+        throw etl_error("Corrupted block in file " + file_name_);
+    }
+    block_position_ += sizeof(head_t) + length;
+    return EntryView{data.substr(sizeof(head_t), head.lengths[0]),
+                     data.substr(sizeof(head_t) + head.lengths[0], head.lengths[1])};
+}
 
-    Entry entry{Bytes(head.lengths[0], '\0'), Bytes(head.lengths[1], '\0')};
-    if (!file_.read(byte_ptr_cast(entry.key.data()), head.lengths[0]) ||
-        !file_.read(byte_ptr_cast(entry.value.data()), head.lengths[1])) {
-        auto err{errno};
-        reset();
-        throw etl_error(errno2str(err));
+bool FileProvider::read_compressed_block() {
+    if (position_ == file_size_) {
+        return false;
     }
+    head_t frame{};
+    std::memcpy(frame.bytes, map(position_, sizeof(head_t)).data(), sizeof(head_t));
+    const ByteView compressed{map(position_ + sizeof(head_t), frame.lengths[0])};
 
-    return std::make_pair(entry, id_);
+    block_.resize(frame.lengths[1]);
+    const int raw_size{LZ4_decompress_safe(byte_ptr_cast(compressed.data()), byte_ptr_cast(block_.data()),
+                                           static_cast<int>(frame.lengths[0]), static_cast<int>(frame.lengths[1]))};
+    if (raw_size <= 0 || raw_size != static_cast<int>(frame.lengths[1])) {
+        throw etl_error("Corrupted block in file " + file_name_);
+    }
+    position_ += sizeof(head_t) + compressed.size();
+    block_position_ = 0;
+    return true;
+}
+
+ByteView FileProvider::map(size_t offset, size_t length) {
+    if (offset + length > file_size_) {
+        throw etl_error("Truncated file " + file_name_);
+    }
+    if (offset < window_offset_ || offset + length > window_offset_ + window_.get_size()) {
+        // Slide window forward: unmapping the former one releases its pages
+        const size_t page_size{bip::mapped_region::get_page_size()};
+        const size_t start{offset / page_size * page_size};
+        const size_t size{std::min(file_size_ - start, std::max(kMapWindowSize, offset + length - start))};
+        window_ = bip::mapped_region{};
+        try {
+            window_ = bip::mapped_region(mapping_, bip::read_only, static_cast<bip::offset_t>(start), size);
+        } catch (const bip::interprocess_exception& ex) {
+            throw etl_error(ex.what());
+        }
+        window_.advise(bip::mapped_region::advice_sequential);
+        window_.advise(bip::mapped_region::advice_willneed);  // Asynchronous read of the whole window
+        window_offset_ = start;
+    }
+    return {static_cast<const uint8_t*>(window_.get_address()) + (offset - window_offset_), length};
 }
 
 void FileProvider::reset() {
+    window_ = bip::mapped_region{};
+    mapping_ = bip::file_mapping{};
+    window_offset_ = 0;
+    position_ = 0;
+    block_.clear();
+    block_position_ = 0;
+    compressed_.clear();
     file_size_ = 0;
-    if (file_.is_open()) {
-        file_.close();
-        fs::remove(file_name_.c_str());
+    if (!persistent_) {
+        std::error_code ec;
+        fs::remove(file_name_, ec);
+    }
+}
+
+void FileProvider::persist(std::string file_name) {
+    if (!file_size_) {
+        throw etl_error("Invalid file handle");
+    }
+    window_ = bip::mapped_region{};
+    window_offset_ = 0;
+    mapping_ = bip::file_mapping{};
+    std::error_code ec;
+    fs::rename(file_name_, file_name, ec);
+    if (ec && fs::copy_file(file_name_, file_name, fs::copy_options::overwrite_existing, ec)) {
+        // Across devices (e.g. striped work paths) files are copied instead
+        fs::remove(file_name_, ec);
+    }
+    if (ec) {
+        throw etl_error("Unable to rename " + file_name_ + " : " + ec.message());
+    }
+    file_name_ = std::move(file_name);
+    persistent_ = true;
+    try {
+        mapping_ = bip::file_mapping(file_name_.c_str(), bip::read_only);
+    } catch (const bip::interprocess_exception& ex) {
+        throw etl_error(ex.what());
     }
 }
 
+void FileProvider::open() {
+    std::error_code ec;
+    const auto file_size{fs::file_size(file_name_, ec)};
+    if (ec || !file_size) {
+        throw etl_error("Unable to open " + file_name_);
+    }
+    persistent_ = true;
+    try {
+        mapping_ = bip::file_mapping(file_name_.c_str(), bip::read_only);
+    } catch (const bip::interprocess_exception& ex) {
+        throw etl_error(ex.what());
+    }
+    file_size_ = static_cast<size_t>(file_size);
+}
+
+void FileProvider::discard() {
+    persistent_ = false;
+    reset();
+}
+
+size_t FileProvider::id() const { return id_; }
+
 std::string FileProvider::get_file_name() const { return file_name_; }
 
 size_t FileProvider::get_file_size() const { return file_size_; }
@@ -16,36 +16,76 @@
 
 #pragma once
 
-#include <fstream>
-#include <memory>
 #include <optional>
+#include <string>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include <silkworm/etl/buffer.hpp>
 #include <silkworm/etl/util.hpp>
 
 namespace silkworm::etl {
 
+inline constexpr size_t kMapWindowSize = 64_Mebi;
+inline constexpr size_t kCompressionBlockSize = 1_Mebi;
+
 /**
  * Provides an abstraction to flush data to disk
- * and re-read flushed data sequentially
+ * and re-read flushed data sequentially.
+ * Data is read through a memory mapped window (of about kMapWindowSize bytes) sliding forward
+ * along the file: entries are served as views in place and pages already read are unmapped as the window moves.
+ * When compression is enabled entries are written in independently compressed blocks
+ * of about kCompressionBlockSize bytes, each preceded by a head_t holding compressed and raw lengths:
+ * entries are then served as views into the block last decompressed
  */
 class FileProvider {
   public:
-    FileProvider(std::string file_name, size_t id);
+    // Not copyable nor movable
+    FileProvider(const FileProvider&) = delete;
+    FileProvider& operator=(const FileProvider&) = delete;
+
+    FileProvider(std::string file_name, size_t id, Compression compression = Compression::kNone);
     ~FileProvider();
 
-    void flush(Buffer& buffer);                            // Write buffer's contents to disk
-    std::optional<std::pair<Entry, size_t>> read_entry();  // Read next data element from file starting from position 0
-    void reset();                                          // Remove the file when eof is met
+    void flush(Buffer& buffer);  // Write buffer's contents to disk
+
+    // Read next data element from file starting from position 0 (nullopt once all have been read)
+    // Returned views are valid until next call
+    std::optional<EntryView> read_entry();
+
+    void reset();  // Remove the file when eof is met (unless persistent)
 
+    //! \brief Renames the flushed file, which from now on outlives this instance (see discard)
+    void persist(std::string file_name);
+
+    //! \brief Maps an existing file as flushed by an instance of a previous run (see persist): the file is persistent
+    void open();
+
+    //! \brief Removes the file even if persistent
+    void discard();
+
+    size_t id() const;
     std::string get_file_name() const;
-    size_t get_file_size() const;
+    size_t get_file_size() const;  // Size of data on disk (i.e. after compression)
 
   private:
+    ByteView map(size_t offset, size_t length);  // Slides the mapped window (if needed) to cover requested range
+    bool read_compressed_block();                 // Decompresses next block into block_ (false at end of file)
+
     size_t id_;
-    std::fstream file_;      // Actual file stream
     std::string file_name_;  // Actual name of file
     size_t file_size_{0};    // Actual size of written data
+    Compression compression_;
+
+    boost::interprocess::file_mapping mapping_;  // Read-only mapping of the whole file (once flushed)
+    boost::interprocess::mapped_region window_;  // Currently mapped range
+    size_t window_offset_{0};                    // Position in file of window_ start
+    size_t position_{0};                         // Position in file of next entry (or block) to be read
+    Bytes block_;                                // Last decompressed block
+    size_t block_position_{0};                   // Position in block_ of next entry to be read
+    Bytes compressed_;                           // Compressed block being written
+    bool persistent_{false};                     // Whether file is kept once read or on destruction
 };
 
 }  // namespace silkworm::etl
@@ -0,0 +1,85 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "memory_arbiter.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <silkworm/common/memory_governor.hpp>
+
+namespace silkworm::etl {
+
+MemoryArbiter::Lease::Lease(MemoryArbiter& arbiter, size_t requested_size)
+    : arbiter_{arbiter}, requested_size_{requested_size} {
+    arbiter_.enroll(this);
+}
+
+MemoryArbiter::Lease::~Lease() { arbiter_.withdraw(this); }
+
+size_t MemoryArbiter::Lease::granted_size() const noexcept {
+    const size_t budget{arbiter_.budget()};
+    if (budget == std::numeric_limits<size_t>::max()) {
+        return requested_size_;
+    }
+    const size_t share{budget / 2 / std::max<size_t>(arbiter_.leases(), 1)};
+    return std::min(requested_size_, std::max(share, kMinGrant));
+}
+
+void MemoryArbiter::Lease::report(size_t bytes) noexcept {
+    const size_t previous{reported_size_.exchange(bytes, std::memory_order_relaxed)};
+    // Unsigned wrap-around makes this right whichever way the size went
+    const size_t usage{arbiter_.usage_.fetch_add(bytes - previous, std::memory_order_relaxed) + bytes - previous};
+    const size_t budget{arbiter_.budget()};
+    if (bytes > previous && budget != std::numeric_limits<size_t>::max() && usage > budget / 2) {
+        arbiter_.relieve();
+    }
+}
+
+MemoryArbiter& MemoryArbiter::instance() {
+    static MemoryArbiter arbiter;
+    return arbiter;
+}
+
+size_t MemoryArbiter::budget() const noexcept {
+    const size_t budget{budget_.load(std::memory_order_relaxed)};
+    return budget ? budget : MemoryGovernor::instance().allowance(MemoryTag::kEtl);
+}
+
+void MemoryArbiter::enroll(Lease* lease) {
+    std::scoped_lock lock{leases_mutex_};
+    leases_.push_back(lease);
+    num_leases_.store(leases_.size(), std::memory_order_relaxed);
+}
+
+void MemoryArbiter::withdraw(Lease* lease) {
+    std::scoped_lock lock{leases_mutex_};
+    usage_.fetch_sub(lease->reported_size(), std::memory_order_relaxed);
+    std::erase(leases_, lease);
+    num_leases_.store(leases_.size(), std::memory_order_relaxed);
+}
+
+void MemoryArbiter::relieve() {
+    std::scoped_lock lock{leases_mutex_};
+    const auto largest{std::max_element(leases_.begin(), leases_.end(), [](const Lease* a, const Lease* b) {
+        return a->reported_size() < b->reported_size();
+    })};
+    if (largest != leases_.end() && (*largest)->reported_size() > 0) {
+        (*largest)->flush_requested_.store(true, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,112 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/etl/buffer.hpp>
+
+namespace silkworm::etl {
+
+//! \brief Shares one ETL memory budget among all the collectors alive at the same time (e.g. of stages run
+//! concurrently, or the many filled in parallel by one stage)
+//! \details Each collector holds a Lease for as long as it lives. Half of the budget goes to the buffers collecting
+//! entries, the other half to their twins being flushed (see Collector). A buffer may grow up to the size granted by
+//! its lease: the one the collector asked for, capped to an even share among live leases. Once collecting buffers all
+//! together exceed their half (e.g. some were granted more before other collectors came along), the largest one is
+//! asked to flush early
+//! \remarks Without a budget of its own the arbiter takes the allowance of MemoryTag::kEtl in MemoryGovernor, hence
+//! arbitrates nothing unless either budget is set. Thread safe: leases report from the threads of their collectors
+class MemoryArbiter {
+  public:
+    //! \brief The least size granted to a buffer (one arena block), so that no collector flushes tiny files
+    static constexpr size_t kMinGrant{kArenaBlockSize};
+
+    class Lease {
+      public:
+        //! \brief Enrolls with arbiter a collector whose buffers would be of requested_size each
+        Lease(MemoryArbiter& arbiter, size_t requested_size);
+        ~Lease();
+
+        // Not copyable nor movable
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        //! \brief Size the buffer of the collector may grow up to now
+        [[nodiscard]] size_t granted_size() const noexcept;
+
+        //! \brief Reports the memory held by entries of the collector buffer, possibly asking some collector (this one
+        //! included) to flush
+        void report(size_t bytes) noexcept;
+
+        [[nodiscard]] size_t reported_size() const noexcept { return reported_size_.load(std::memory_order_relaxed); }
+
+        //! \brief Whether the arbiter has asked the collector to flush since last call
+        [[nodiscard]] bool take_flush_request() noexcept {
+            return flush_requested_.load(std::memory_order_relaxed) &&
+                   flush_requested_.exchange(false, std::memory_order_relaxed);
+        }
+
+      private:
+        friend class MemoryArbiter;
+
+        MemoryArbiter& arbiter_;
+        const size_t requested_size_;
+        std::atomic<size_t> reported_size_{0};
+        std::atomic<bool> flush_requested_{false};
+    };
+
+    MemoryArbiter() = default;
+
+    // Not copyable nor movable
+    MemoryArbiter(const MemoryArbiter&) = delete;
+    MemoryArbiter& operator=(const MemoryArbiter&) = delete;
+
+    //! \brief The instance all collectors enroll with
+    static MemoryArbiter& instance();
+
+    //! \brief Sets the budget shared by the buffers of all collectors (0 = the allowance of MemoryTag::kEtl)
+    void set_budget(size_t bytes) noexcept { budget_.store(bytes, std::memory_order_relaxed); }
+
+    //! \return The budget in force, SIZE_MAX if none
+    [[nodiscard]] size_t budget() const noexcept;
+
+    //! \brief Number of live leases
+    [[nodiscard]] size_t leases() const noexcept { return num_leases_.load(std::memory_order_relaxed); }
+
+    //! \brief Memory reported by all live leases together
+    [[nodiscard]] size_t usage() const noexcept { return usage_.load(std::memory_order_relaxed); }
+
+  private:
+    void enroll(Lease* lease);
+    void withdraw(Lease* lease);
+
+    //! \brief Asks the lease holding most memory to flush
+    void relieve();
+
+    std::atomic<size_t> budget_{0};
+    std::atomic<size_t> num_leases_{0};
+    std::atomic<size_t> usage_{0};
+    std::mutex leases_mutex_;
+    std::vector<Lease*> leases_;
+};
+
+}  // namespace silkworm::etl
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "memory_arbiter.hpp"
+
+#include <limits>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::etl {
+
+TEST_CASE("ETL MemoryArbiter") {
+    MemoryArbiter arbiter;
+
+    SECTION("No budget") {
+        MemoryArbiter::Lease lease{arbiter, 256_Mebi};
+        CHECK(arbiter.budget() == std::numeric_limits<size_t>::max());
+        CHECK(lease.granted_size() == 256_Mebi);
+        lease.report(1_Gibi);
+        CHECK_FALSE(lease.take_flush_request());
+    }
+
+    SECTION("Even shares of half the budget") {
+        arbiter.set_budget(256_Mebi);
+        MemoryArbiter::Lease a{arbiter, 512_Mebi};
+        CHECK(a.granted_size() == 128_Mebi);
+        {
+            MemoryArbiter::Lease b{arbiter, 32_Mebi};
+            MemoryArbiter::Lease c{arbiter, 512_Mebi};
+            CHECK(arbiter.leases() == 3);
+            CHECK(a.granted_size() == 128_Mebi / 3);
+            CHECK(b.granted_size() == 32_Mebi);  // Asked for less than its share
+            CHECK(c.granted_size() == 128_Mebi / 3);
+        }
+        CHECK(arbiter.leases() == 1);
+        CHECK(a.granted_size() == 128_Mebi);
+
+        arbiter.set_budget(1_Mebi);
+        CHECK(a.granted_size() == MemoryArbiter::kMinGrant);
+    }
+
+    SECTION("Largest buffer flushes under pressure") {
+        arbiter.set_budget(64_Mebi);  // 32 MiB for buffers collecting entries
+        MemoryArbiter::Lease a{arbiter, 64_Mebi};
+        MemoryArbiter::Lease b{arbiter, 64_Mebi};
+        a.report(20_Mebi);
+        b.report(10_Mebi);
+        CHECK(arbiter.usage() == 30_Mebi);
+        CHECK_FALSE(a.take_flush_request());
+        CHECK_FALSE(b.take_flush_request());
+
+        b.report(15_Mebi);
+        CHECK(arbiter.usage() == 35_Mebi);
+        CHECK_FALSE(b.take_flush_request());
+        CHECK(a.take_flush_request());
+        CHECK_FALSE(a.take_flush_request());  // Consumed
+
+        a.report(0);  // Flushed
+        CHECK(arbiter.usage() == 15_Mebi);
+    }
+
+    CHECK(arbiter.leases() == 0);
+    CHECK(arbiter.usage() == 0);
+}
+
+}  // namespace silkworm::etl
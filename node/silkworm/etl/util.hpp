@@ -31,6 +31,12 @@ class etl_error : public std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+// Compression of data flushed to files
+enum class Compression {
+    kNone,
+    kLz4,  // Fast block compression: favours load speed over ratio
+};
+
 // Head of each data chunk on file
 union head_t {
     uint32_t lengths[2];
@@ -44,6 +50,13 @@ struct Entry {
     [[nodiscard]] size_t size() const noexcept { return key.size() + value.size(); }
 };
 
+// A data chunk viewed in place (e.g. in a mapped file)
+struct EntryView {
+    ByteView key;
+    ByteView value;
+};
+
 bool operator<(const Entry& a, const Entry& b);
+bool operator<(const EntryView& a, const EntryView& b);
 
 }  // namespace silkworm::etl
@@ -17,6 +17,8 @@
 #include "completion_end_point.hpp"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <grpcpp/alarm.h>
 
@@ -64,6 +66,58 @@ bool CompletionEndPoint::post_one(boost::asio::io_context& scheduler) {
     return !got_event;
 }
 
+std::size_t CompletionEndPoint::poll_many(std::size_t max_events) {
+    std::size_t num_completed{0};
+
+    while (num_completed < max_events) {
+        void* tag{nullptr};
+        bool ok{false};
+        const auto next_status = queue_.AsyncNext(&tag, &ok, gpr_time_0(GPR_CLOCK_MONOTONIC));
+        if (next_status == grpc::CompletionQueue::GOT_EVENT) {
+            ++num_completed;
+            // Handle the event completion on the calling thread (*must* be the io_context scheduler).
+            CompletionTag completion_tag{reinterpret_cast<TagProcessor*>(tag), ok};
+            SILK_DEBUG << "CompletionEndPoint::poll_many post operation: " << completion_tag.processor;
+            (*completion_tag.processor)(completion_tag.ok);
+        } else {
+            if (next_status == grpc::CompletionQueue::SHUTDOWN) {
+                closed_ = true;
+                SILK_DEBUG << "CompletionEndPoint::poll_many shutdown";
+            }
+            break;
+        }
+    }
+
+    return num_completed;
+}
+
+bool CompletionEndPoint::post_batch(boost::asio::io_context& scheduler, std::size_t max_events) {
+    SILK_TRACE << "CompletionEndPoint::post_batch START";
+    void* tag{nullptr};
+    bool ok{false};
+    const auto got_event = queue_.Next(&tag, &ok);
+    if (got_event) {
+        std::vector<CompletionTag> completion_tags;
+        completion_tags.push_back({reinterpret_cast<TagProcessor*>(tag), ok});
+        // Take the events already there without waiting: any shutdown will be seen by next Next call
+        while (completion_tags.size() < max_events &&
+               queue_.AsyncNext(&tag, &ok, gpr_time_0(GPR_CLOCK_MONOTONIC)) == grpc::CompletionQueue::GOT_EVENT) {
+            completion_tags.push_back({reinterpret_cast<TagProcessor*>(tag), ok});
+        }
+        // Post the event completions on the passed io_context scheduler as one single task.
+        SILK_DEBUG << "CompletionEndPoint::post_batch post operations: " << completion_tags.size();
+        scheduler.post([completion_tags = std::move(completion_tags)]() {
+            for (const auto& completion_tag : completion_tags) {
+                (*completion_tag.processor)(completion_tag.ok);
+            }
+        });
+    } else {
+        SILK_DEBUG << "CompletionEndPoint::post_batch shutdown";
+    }
+    SILK_TRACE << "CompletionEndPoint::post_batch got_event=" << got_event << " END";
+    return !got_event;
+}
+
 void CompletionEndPoint::shutdown() {
     SILK_TRACE << "CompletionEndPoint::shutdown START";
     queue_.Shutdown();
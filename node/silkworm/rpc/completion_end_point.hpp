@@ -26,6 +26,9 @@ namespace silkworm::rpc {
 //! Application end-point dedicated to read completion notifications from one gRPC completion queue.
 class CompletionEndPoint {
   public:
+    //! Default maximum number of events handled in one execution cycle or task.
+    static constexpr std::size_t kMaxBatchSize{64};
+
     CompletionEndPoint(grpc::CompletionQueue& queue) : queue_(queue) {}
 
     CompletionEndPoint(const CompletionEndPoint&) = delete;
@@ -40,6 +43,15 @@ class CompletionEndPoint {
     //! Post to scheduler at most one execution task polling gRPC completion queue for one event.
     bool post_one(boost::asio::io_context& scheduler);
 
+    //! Run at most one execution cycle polling gRPC completion queue for up to max_events ready events.
+    //! \return the number of completed events
+    std::size_t poll_many(std::size_t max_events = kMaxBatchSize);
+
+    //! Post to scheduler at most one execution task handling a batch of events: wait for one, then take up to
+    //! max_events - 1 more among the ready ones without waiting.
+    //! \return true if the completion queue has been shut down
+    bool post_batch(boost::asio::io_context& scheduler, std::size_t max_events = kMaxBatchSize);
+
     //! Shutdown and drain the gRPC completion queue.
     void shutdown();
 
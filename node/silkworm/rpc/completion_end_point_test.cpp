@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <grpcpp/alarm.h>
@@ -158,6 +159,81 @@ TEST_CASE("CompletionEndPoint::post_one", "[silkworm][rpc][completion_end_point]
         CHECK_NOTHROW(completion_end_point.shutdown());
     }
 }
+TEST_CASE("CompletionEndPoint::poll_many", "[silkworm][rpc][completion_end_point]") {
+    silkworm::log::set_verbosity(silkworm::log::Level::kNone);
+    grpc::CompletionQueue queue;
+    CompletionEndPoint completion_end_point{queue};
+
+    SECTION("executing ready completion handlers in batches") {
+        int executed{0};
+        TagProcessor tag_processor = [&executed](bool) { ++executed; };
+        std::vector<grpc::Alarm> alarms(5);
+        for (auto& alarm : alarms) {
+            alarm.Set(&queue, gpr_now(GPR_CLOCK_MONOTONIC), &tag_processor);
+        }
+        std::size_t num_completed{0};
+        while (num_completed < alarms.size()) {
+            const auto batch_completed{completion_end_point.poll_many(/*max_events=*/2)};
+            CHECK(batch_completed <= 2);
+            num_completed += batch_completed;
+        }
+        CHECK(executed == 5);
+        CHECK(completion_end_point.poll_many() == 0);
+        completion_end_point.shutdown();
+        CHECK(completion_end_point.poll_many() == 0);
+        CHECK(completion_end_point.closed());
+    }
+}
+
+TEST_CASE("CompletionEndPoint::post_batch", "[silkworm][rpc][completion_end_point]") {
+    silkworm::log::set_verbosity(silkworm::log::Level::kNone);
+    grpc::CompletionQueue queue;
+    CompletionEndPoint completion_end_point{queue};
+    boost::asio::io_context io_context;
+    boost::asio::io_context::work work{io_context};
+
+    SECTION("waiting on empty completion queue") {
+        auto completion_runner_thread = std::thread([&]() {
+            bool stopped{false};
+            while (!stopped) {
+                stopped = completion_end_point.post_batch(io_context);
+            }
+        });
+        completion_end_point.shutdown();
+        CHECK_NOTHROW(completion_runner_thread.join());
+    }
+
+    SECTION("executing completion handlers") {
+        int executed{0};
+
+        // Setup the alarm notifications delivered through gRPC queue
+        TagProcessor tag_processor = [&](bool) {
+            if (++executed == 3) {
+                completion_end_point.shutdown();
+                io_context.stop();
+            }
+        };
+        auto alarm_deadline = gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), gpr_time_from_millis(50, GPR_TIMESPAN));
+        std::vector<grpc::Alarm> alarms(3);
+        for (auto& alarm : alarms) {
+            alarm.Set(&queue, alarm_deadline, &tag_processor);
+        }
+
+        // Start the thread blocking on the gRPC queue
+        auto completion_runner_thread = std::thread([&]() {
+            bool stopped{false};
+            while (!stopped) {
+                stopped = completion_end_point.post_batch(io_context);
+            }
+        });
+
+        // Run the Asio scheduler executing the completion handlers
+        io_context.run();
+
+        CHECK_NOTHROW(completion_runner_thread.join());
+        CHECK(executed == 3);
+    }
+}
 #endif // SILKWORM_SANITIZE
 
 } // namespace silkworm::rpc
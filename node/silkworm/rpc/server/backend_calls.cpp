@@ -85,14 +85,10 @@ NetVersionCallFactory::NetVersionCallFactory(const EthereumBackEnd& backend)
     NetVersionCall::fill_predefined_reply(backend);
 }
 
-std::set<SentryClient*> NetPeerCountCall::sentries_;
+SentryPeersCache* NetPeerCountCall::peers_cache_{nullptr};
 
-void NetPeerCountCall::add_sentry(SentryClient* sentry) {
-    NetPeerCountCall::sentries_.insert(sentry);
-}
-
-void NetPeerCountCall::remove_sentry(SentryClient* sentry) {
-    NetPeerCountCall::sentries_.erase(sentry);
+void NetPeerCountCall::set_peers_cache(SentryPeersCache* peers_cache) {
+    NetPeerCountCall::peers_cache_ = peers_cache;
 }
 
 NetPeerCountCall::NetPeerCountCall(boost::asio::io_context& scheduler, remote::ETHBACKEND::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
@@ -102,45 +98,25 @@ NetPeerCountCall::NetPeerCountCall(boost::asio::io_context& scheduler, remote::E
 void NetPeerCountCall::process(const remote::NetPeerCountRequest* request) {
     SILK_TRACE << "NetPeerCountCall::process START request: " << request;
 
-    if (sentries_.size() == 0) {
+    if (peers_cache_ == nullptr) {
         remote::NetPeerCountReply response;
         const bool sent = send_response(response);
         SILK_TRACE << "NetPeerCountCall::process END count: 0 sent: " << sent;
         return;
     }
 
-    SILK_DEBUG << "NetPeerCountCall::process num sentries: " << sentries_.size();
-
-    expected_responses_ = sentries_.size();
-
-    for (const auto& sentry : sentries_) {
-        sentry->peer_count([&](const grpc::Status status, const sentry::PeerCountReply& reply) {
-            --expected_responses_;
-
-            SILK_DEBUG << "Peer count replies: [" << (sentries_.size()-expected_responses_) << "/" << sentries_.size() << "]";
-
-            if (status.ok()) {
-                uint64_t count = reply.count();
-                total_count_ += count;
-                SILK_DEBUG << "Reply OK peer count: partial=" << count << " total=" << total_count_;
-            } else {
-                result_status_ = status;
-                SILK_DEBUG << "Reply KO result: " << result_status_;
-            }
-
-            if (expected_responses_ == 0) {
-                if (result_status_.ok()) {
-                    remote::NetPeerCountReply response;
-                    response.set_count(total_count_);
-                    const bool sent = send_response(response);
-                    SILK_TRACE << "NetPeerCountCall::process END count: " << total_count_ << " sent: " << sent;
-                } else {
-                    finish_with_error(result_status_);
-                    SILK_TRACE << "NetPeerCountCall::process END error: " << result_status_;
-                }
-            }
-        });
-    }
+    // Answer from the latest aggregated snapshot: no round trip to the sentries here
+    peers_cache_->async_read([&](std::shared_ptr<const SentryPeersSnapshot> snapshot) {
+        if (snapshot->peer_count_status.ok()) {
+            remote::NetPeerCountReply response;
+            response.set_count(snapshot->peer_count);
+            const bool sent = send_response(response);
+            SILK_TRACE << "NetPeerCountCall::process END count: " << snapshot->peer_count << " sent: " << sent;
+        } else {
+            finish_with_error(snapshot->peer_count_status);
+            SILK_TRACE << "NetPeerCountCall::process END error: " << snapshot->peer_count_status;
+        }
+    });
 }
 
 NetPeerCountCallFactory::NetPeerCountCallFactory()
@@ -244,14 +220,10 @@ SubscribeCallFactory::SubscribeCallFactory()
     : CallFactory<remote::ETHBACKEND::AsyncService, SubscribeCall>(&remote::ETHBACKEND::AsyncService::RequestSubscribe) {
 }
 
-std::set<SentryClient*> NodeInfoCall::sentries_;
-
-void NodeInfoCall::add_sentry(SentryClient* sentry) {
-    NodeInfoCall::sentries_.insert(sentry);
-}
+SentryPeersCache* NodeInfoCall::peers_cache_{nullptr};
 
-void NodeInfoCall::remove_sentry(SentryClient* sentry) {
-    NodeInfoCall::sentries_.erase(sentry);
+void NodeInfoCall::set_peers_cache(SentryPeersCache* peers_cache) {
+    NodeInfoCall::peers_cache_ = peers_cache;
 }
 
 NodeInfoCall::NodeInfoCall(boost::asio::io_context& scheduler, remote::ETHBACKEND::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
@@ -261,48 +233,49 @@ NodeInfoCall::NodeInfoCall(boost::asio::io_context& scheduler, remote::ETHBACKEN
 void NodeInfoCall::process(const remote::NodesInfoRequest* request) {
     SILK_TRACE << "NodeInfoCall::process request: " << request << " limit: " << request->limit();
 
-    if (sentries_.size() == 0) {
+    if (peers_cache_ == nullptr) {
         remote::NodesInfoReply response;
         const bool sent = send_response(response);
         SILK_TRACE << "NodeInfoCall::process END #nodes: 0 sent: " << sent;
         return;
     }
 
-    expected_responses_ = sentries_.size();
-
-    for (const auto& sentry : sentries_) {
-        sentry->node_info([&](const grpc::Status status, const types::NodeInfoReply& reply) {
-            --expected_responses_;
-
-            if (status.ok()) {
-                types::NodeInfoReply* nodes_info = response_.add_nodesinfo();
-                *nodes_info = reply;
-            } else {
-                result_status_ = status;
-            }
-
-            if (expected_responses_ == 0) {
-                if (result_status_.ok()) {
-                    const bool sent = send_response(response_);
-                    SILK_TRACE << "NodeInfoCall::process END #nodes: " << response_.nodesinfo_size() << " sent: " << sent;
-                } else {
-                    finish_with_error(result_status_);
-                    SILK_TRACE << "NodeInfoCall::process END error: " << result_status_;
-                }
-            }
-        });
-    }
+    // Answer from the latest aggregated snapshot: no round trip to the sentries here
+    peers_cache_->async_read([&](std::shared_ptr<const SentryPeersSnapshot> snapshot) {
+        if (snapshot->nodes_info_status.ok()) {
+            const bool sent = send_response(snapshot->nodes_info);
+            SILK_TRACE << "NodeInfoCall::process END #nodes: " << snapshot->nodes_info.nodesinfo_size() << " sent: " << sent;
+        } else {
+            finish_with_error(snapshot->nodes_info_status);
+            SILK_TRACE << "NodeInfoCall::process END error: " << snapshot->nodes_info_status;
+        }
+    });
 }
 
 NodeInfoCallFactory::NodeInfoCallFactory()
     : CallFactory<remote::ETHBACKEND::AsyncService, NodeInfoCall>(&remote::ETHBACKEND::AsyncService::RequestNodeInfo) {
 }
 
+bool BackEndService::peers_cache_registered_{false};
+
 BackEndService::BackEndService(const EthereumBackEnd& backend)
     : etherbase_factory_{backend}, net_version_factory_{backend}, client_version_factory_{backend} {
 }
 
 void BackEndService::register_backend_request_calls(boost::asio::io_context& scheduler, remote::ETHBACKEND::AsyncService* async_service, grpc::ServerCompletionQueue* queue) {
+    // Start aggregating peers from the sentries: one cache serves all the server contexts
+    if (!sentries_.empty() && !peers_cache_registered_) {
+        std::vector<SentryClient*> sentries;
+        for (const auto& sentry : sentries_) {
+            sentries.push_back(sentry.get());
+        }
+        peers_cache_ = std::make_shared<SentryPeersCache>(scheduler, std::move(sentries));
+        peers_cache_->start();
+        NetPeerCountCall::set_peers_cache(peers_cache_.get());
+        NodeInfoCall::set_peers_cache(peers_cache_.get());
+        peers_cache_registered_ = true;
+    }
+
     // Register one requested call for each RPC factory
     etherbase_factory_.create_rpc(scheduler, async_service, queue);
     net_version_factory_.create_rpc(scheduler, async_service, queue);
@@ -315,15 +288,14 @@ void BackEndService::register_backend_request_calls(boost::asio::io_context& sch
 }
 
 void BackEndService::add_sentry(std::unique_ptr<SentryClient>&& sentry) {
-    NetPeerCountCall::add_sentry(sentry.get());
-    NodeInfoCall::add_sentry(sentry.get());
     sentries_.push_back(std::move(sentry));
 }
 
 BackEndService::~BackEndService() {
-    for (const auto& sentry : sentries_) {
-        NetPeerCountCall::remove_sentry(sentry.get());
-        NodeInfoCall::remove_sentry(sentry.get());
+    if (peers_cache_) {
+        NetPeerCountCall::set_peers_cache(nullptr);
+        NodeInfoCall::set_peers_cache(nullptr);
+        peers_cache_registered_ = false;
     }
 }
 
@@ -17,7 +17,6 @@
 #pragma once
 
 #include <memory>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -30,6 +29,7 @@
 #include <silkworm/rpc/server/call.hpp>
 #include <silkworm/rpc/server/call_factory.hpp>
 #include <silkworm/rpc/client/sentry_client.hpp>
+#include <silkworm/rpc/server/sentry_peers_cache.hpp>
 #include <silkworm/rpc/server/server.hpp>
 
 // ETHBACKEND API protocol versions
@@ -84,19 +84,14 @@ class NetVersionCallFactory : public CallFactory<remote::ETHBACKEND::AsyncServic
 //! Unary RPC for NetPeerCount method of 'ethbackend' gRPC protocol.
 class NetPeerCountCall : public UnaryRpc<remote::ETHBACKEND::AsyncService, remote::NetPeerCountRequest, remote::NetPeerCountReply> {
   public:
-    static void add_sentry(SentryClient* sentry);
-    static void remove_sentry(SentryClient* sentry);
+    static void set_peers_cache(SentryPeersCache* peers_cache);
 
     NetPeerCountCall(boost::asio::io_context& scheduler, remote::ETHBACKEND::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
 
     void process(const remote::NetPeerCountRequest* request) override;
 
   private:
-    static std::set<SentryClient*> sentries_;
-
-    std::size_t expected_responses_{0};
-    uint64_t total_count_{0};
-    grpc::Status result_status_{grpc::Status::OK};
+    static SentryPeersCache* peers_cache_;
 };
 
 //! Factory specialization for NetPeerCount method.
@@ -179,19 +174,14 @@ class SubscribeCallFactory : public CallFactory<remote::ETHBACKEND::AsyncService
 //! Unary RPC for NodeInfo method of 'ethbackend' gRPC protocol.
 class NodeInfoCall : public UnaryRpc<remote::ETHBACKEND::AsyncService, remote::NodesInfoRequest, remote::NodesInfoReply> {
   public:
-    static void add_sentry(SentryClient* sentry);
-    static void remove_sentry(SentryClient* sentry);
+    static void set_peers_cache(SentryPeersCache* peers_cache);
 
     NodeInfoCall(boost::asio::io_context& scheduler, remote::ETHBACKEND::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
 
     void process(const remote::NodesInfoRequest* request) override;
 
   private:
-    static std::set<SentryClient*> sentries_;
-
-    std::size_t expected_responses_{0};
-    remote::NodesInfoReply response_;
-    grpc::Status result_status_{grpc::Status::OK};
+    static SentryPeersCache* peers_cache_;
 };
 
 //! Factory specialization for NodeInfo method.
@@ -220,6 +210,10 @@ struct BackEndService {
     SubscribeCallFactory subscribe_factory_;
     NodeInfoCallFactory node_info_factory_;
     std::vector<std::unique_ptr<SentryClient>> sentries_;
+
+    //! The peers cache, if this service is the first registering calls with some sentries.
+    std::shared_ptr<SentryPeersCache> peers_cache_;
+    static bool peers_cache_registered_;
 };
 
 } // namespace silkworm::rpc
@@ -53,7 +53,7 @@ class BackEndKvServer : public Server {
     remote::ETHBACKEND::AsyncService backend_async_service_;
 
     /// \warning The gRPC service must exist for the lifetime of the gRPC server it is registered on.
-    remote::KV::AsyncService kv_async_service_;
+    KvAsyncService kv_async_service_;
 
     //! The sequence of \ref BackEndKvService instance, one for each \ref ServerContext.
     std::vector<std::unique_ptr<BackEndKvService>> backend_kv_services_;
@@ -31,9 +31,15 @@
 #include <grpc/grpc.h>
 
 #include <silkworm/common/base.hpp>
+#include <silkworm/common/cast.hpp>
 #include <silkworm/common/directories.hpp>
+#include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/bitmap.hpp>
 #include <silkworm/db/mdbx.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
 #include <silkworm/backend/ethereum_backend.hpp>
 #include <silkworm/rpc/conversion.hpp>
 #include <silkworm/rpc/util.hpp>
@@ -540,7 +546,7 @@ TEST_CASE("BackEndKvServer E2E: empty node settings", "[silkworm][node][rpc]") {
         const auto status = backend_client.version(&response);
         CHECK(status.ok());
         CHECK(response.major() == 2);
-        CHECK(response.minor() == 3);
+        CHECK(response.minor() == 4);
         CHECK(response.patch() == 0);
     }
 
@@ -586,7 +592,7 @@ TEST_CASE("BackEndKvServer E2E: KV", "[silkworm][node][rpc]") {
         const auto status = kv_client.version(&response);
         CHECK(status.ok());
         CHECK(response.major() == 4);
-        CHECK(response.minor() == 1);
+        CHECK(response.minor() == 3);
         CHECK(response.patch() == 0);
     }
 
@@ -639,6 +645,17 @@ TEST_CASE("BackEndKvServer E2E: KV", "[silkworm][node][rpc]") {
         CHECK(responses[0].txid() != 0);
     }
 
+    SECTION("Tx OK: compressed messages", "[silkworm][node][rpc]") {
+        grpc::ClientContext context;
+        context.AddMetadata(kCompressionMetadataKey, "deflate");
+        const auto tx_stream = kv_client.tx_start(&context);
+        remote::Pair response;
+        REQUIRE(tx_stream->Read(&response));
+        CHECK(response.txid() != 0);
+        tx_stream->WritesDone();
+        CHECK(tx_stream->Finish().ok());
+    }
+
     SECTION("Tx OK: cursor opened", "[silkworm][node][rpc]") {
         remote::Cursor open;
         open.set_op(remote::Op::OPEN);
@@ -1327,6 +1344,166 @@ TEST_CASE("BackEndKvServer E2E: Tx cursor valid operations", "[silkworm][node][r
         CHECK(responses[6].cursorid() == 0);
     }
 
+    SECTION("Tx OK: NEXT_N operations until the end of table", "[silkworm][node][rpc]") {
+        Bytes limits(8, 0);
+        endian::store_big_u32(limits.data(), 1);  // one pair, no byte limit
+        remote::Cursor open;
+        open.set_op(remote::Op::OPEN);
+        open.set_bucketname(kTestMap.name);
+        remote::Cursor next_n1;
+        next_n1.set_op(kOpNextN);
+        next_n1.set_v(byte_ptr_cast(limits.data()), limits.size());
+        next_n1.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor next_n2;
+        next_n2.set_op(kOpNextN);
+        next_n2.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor next_n3;
+        next_n3.set_op(kOpNextN);
+        next_n3.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor next_n4;
+        next_n4.set_op(kOpNextN);
+        next_n4.set_k("AB");
+        next_n4.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor close;
+        close.set_op(remote::Op::CLOSE);
+        close.set_cursor(0); // automatically assigned by KvClient::tx
+        std::vector<remote::Cursor> requests{open, next_n1, next_n2, next_n3, next_n4, close};
+        std::vector<remote::Pair> responses;
+        const auto status = kv_client.tx(requests, responses);
+        CHECK(status.ok());
+        CHECK(status.error_message().empty());
+        REQUIRE(responses.size() == 7);
+        CHECK(responses[0].txid() != 0);
+        CHECK(responses[1].cursorid() != 0);
+        CHECK(responses[2].k() == "AA");
+        CHECK(detail::decode_batch(responses[2].v()) == std::vector<std::pair<std::string, std::string>>{{"AA", "00"}});
+        CHECK(responses[3].k() == "BB");
+        CHECK(detail::decode_batch(responses[3].v()) == std::vector<std::pair<std::string, std::string>>{{"BB", "11"}});
+        CHECK(responses[4].k().empty());
+        CHECK(responses[4].v().empty());
+        CHECK(responses[5].k() == "BB");
+        CHECK(detail::decode_batch(responses[5].v()) == std::vector<std::pair<std::string, std::string>>{{"BB", "11"}});
+        CHECK(responses[6].cursorid() == 0);
+    }
+
+    SECTION("Tx OK: NEXT_N operations within byte budget", "[silkworm][node][rpc]") {
+        Bytes limits(8, 0);
+        endian::store_big_u32(limits.data() + 4, 1);  // no pair limit, one byte: one pair per batch anyway
+        remote::Cursor open;
+        open.set_op(remote::Op::OPEN);
+        open.set_bucketname(kTestMultiMap.name);
+        remote::Cursor next_n1;
+        next_n1.set_op(kOpNextN);
+        next_n1.set_v(byte_ptr_cast(limits.data()), limits.size());
+        next_n1.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor next_n2{next_n1};
+        remote::Cursor next_n3;
+        next_n3.set_op(kOpNextN);
+        next_n3.set_cursor(0); // automatically assigned by KvClient::tx
+        remote::Cursor close;
+        close.set_op(remote::Op::CLOSE);
+        close.set_cursor(0); // automatically assigned by KvClient::tx
+        std::vector<remote::Cursor> requests{open, next_n1, next_n2, next_n3, close};
+        std::vector<remote::Pair> responses;
+        const auto status = kv_client.tx(requests, responses);
+        CHECK(status.ok());
+        CHECK(status.error_message().empty());
+        REQUIRE(responses.size() == 6);
+        CHECK(detail::decode_batch(responses[2].v()) == std::vector<std::pair<std::string, std::string>>{{"AA", "00"}});
+        CHECK(detail::decode_batch(responses[3].v()) == std::vector<std::pair<std::string, std::string>>{{"AA", "11"}});
+        CHECK(detail::decode_batch(responses[4].v()) ==
+            std::vector<std::pair<std::string, std::string>>{{"AA", "22"}, {"BB", "22"}});
+        CHECK(responses[4].k() == "BB");
+        CHECK(responses[5].cursorid() == 0);
+    }
+
+    SECTION("Tx OK: READ_STATE operations on latest and historical state", "[silkworm][node][rpc]") {
+        evmc::address address{};
+        address.bytes[kAddressLength - 1] = 0xaa;
+        evmc::bytes32 location{};
+        location.bytes[kHashLength - 1] = 0x01;
+        const Bytes code{0x60, 0x00};
+        Account account{/*nonce=*/1, /*balance=*/2};
+        account.code_hash.bytes[0] = 0xcc;
+        account.incarnation = 1;
+        BlockHeader header;
+        header.number = 1;
+        {
+            auto rw_txn = test.database_env.start_write();
+            db::table::check_or_create_chaindata_tables(rw_txn);
+            db::Cursor plain_state{rw_txn, db::table::kPlainState};
+            plain_state.upsert(db::to_slice(ByteView{address.bytes, kAddressLength}),
+                               db::to_slice(account.encode_for_storage()));
+            Bytes storage_entry{location.bytes, kHashLength};
+            storage_entry.push_back(0x2a);
+            plain_state.upsert(db::to_slice(db::storage_prefix(ByteView{address.bytes, kAddressLength}, 1)),
+                               db::to_slice(storage_entry));
+            db::Cursor code_table{rw_txn, db::table::kCode};
+            code_table.upsert(db::to_slice(ByteView{account.code_hash.bytes, kHashLength}), db::to_slice(code));
+            db::write_header(rw_txn, header);
+            // The account is created in block 2: before it, the account is missing
+            roaring::Roaring64Map bitmap{roaring::Roaring64Map::bitmapOf(1, 2)};
+            Bytes bitmap_bytes(bitmap.getSizeInBytes(), 0);
+            bitmap.write(byte_ptr_cast(bitmap_bytes.data()));
+            db::Cursor account_history{rw_txn, db::table::kAccountHistory};
+            account_history.upsert(db::to_slice(db::account_history_key(address, UINT64_MAX)), db::to_slice(bitmap_bytes));
+            db::Cursor account_change_set{rw_txn, db::table::kAccountChangeSet};
+            account_change_set.upsert(db::to_slice(db::block_key(2)), db::to_slice(ByteView{address.bytes, kAddressLength}));
+            rw_txn.commit();
+        }
+
+        const auto slice_of = [](const auto& bytes) { return mdbx::slice{bytes.data(), bytes.size()}; };
+        Bytes storage_argument{address.bytes, kAddressLength};
+        storage_argument.append({0, 0, 0, 0, 0, 0, 0, 1});
+        storage_argument.append(location.bytes, kHashLength);
+        const Bytes header_key{db::block_key(1, header.hash().bytes)};
+        std::string queries;
+        detail::encode_batch(queries, mdbx::slice{"a"}, mdbx::slice{address.bytes, kAddressLength});
+        detail::encode_batch(queries, mdbx::slice{"s"}, slice_of(storage_argument));
+        detail::encode_batch(queries, mdbx::slice{"c"}, mdbx::slice{account.code_hash.bytes, kHashLength});
+        detail::encode_batch(queries, mdbx::slice{"h"}, slice_of(header_key));
+        Bytes block_number(8, 0);
+        endian::store_big_u64(block_number.data(), 1);
+        remote::Cursor read_latest;
+        read_latest.set_op(kOpReadState);
+        read_latest.set_k(queries);
+        remote::Cursor read_historical{read_latest};
+        read_historical.set_v(byte_ptr_cast(block_number.data()), block_number.size());
+        std::vector<remote::Cursor> requests{read_latest, read_historical};
+        std::vector<remote::Pair> responses;
+        const auto status = kv_client.tx(requests, responses);
+        CHECK(status.ok());
+        CHECK(status.error_message().empty());
+        REQUIRE(responses.size() == 3);
+        const auto as_string = [](ByteView bytes) { return std::string{byte_ptr_cast(bytes.data()), bytes.size()}; };
+        Bytes header_rlp;
+        rlp::encode(header_rlp, header);
+        CHECK(detail::decode_batch(responses[1].v()) == std::vector<std::pair<std::string, std::string>>{
+            {"a", as_string(account.encode_for_storage())},
+            {"s", "\x2a"},
+            {"c", as_string(code)},
+            {"h", as_string(header_rlp)}});
+        CHECK(detail::decode_batch(responses[2].v()) == std::vector<std::pair<std::string, std::string>>{
+            {"a", ""},
+            {"s", "\x2a"},
+            {"c", as_string(code)},
+            {"h", as_string(header_rlp)}});
+    }
+
+    SECTION("Tx KO: READ_STATE operation with malformed query", "[silkworm][node][rpc]") {
+        std::string queries;
+        detail::encode_batch(queries, mdbx::slice{"a"}, mdbx::slice{"too short address"});
+        remote::Cursor read_state;
+        read_state.set_op(kOpReadState);
+        read_state.set_k(queries);
+        std::vector<remote::Cursor> requests{read_state};
+        std::vector<remote::Pair> responses;
+        const auto status = kv_client.tx(requests, responses);
+        CHECK(!status.ok());
+        CHECK(status.error_code() == grpc::StatusCode::INVALID_ARGUMENT);
+        CHECK(status.error_message() == "malformed READ_STATE queries");
+    }
+
     SECTION("Tx OK: one PREV operation", "[silkworm][node][rpc]") {
         remote::Cursor open;
         open.set_op(remote::Op::OPEN);
@@ -2309,6 +2486,34 @@ TEST_CASE("BackEndKvServer E2E: bidirectional max TTL duration", "[silkworm][nod
         auto status = tx_reader_writer->Finish();
         CHECK(status.ok());
     }
+
+    SECTION("Tx: cursor never positioned is usable after renew", "[silkworm][node][rpc]") {
+        grpc::ClientContext context;
+        const auto tx_reader_writer = kv_client.tx_start(&context);
+        remote::Pair response;
+        CHECK(tx_reader_writer->Read(&response));
+        CHECK(response.txid() != 0);
+        remote::Cursor open;
+        open.set_op(remote::Op::OPEN);
+        open.set_bucketname(kTestMap.name);
+        CHECK(tx_reader_writer->Write(open));
+        response.clear_txid();
+        CHECK(tx_reader_writer->Read(&response));
+        const auto cursor_id = response.cursorid();
+        CHECK(cursor_id != 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds{kCustomMaxTimeToLive});
+        remote::Cursor last;
+        last.set_op(remote::Op::LAST);
+        last.set_cursor(cursor_id);
+        CHECK(tx_reader_writer->Write(last));
+        response.clear_cursorid();
+        CHECK(tx_reader_writer->Read(&response));
+        CHECK(response.k() == "BB");
+        CHECK(response.v() == "11");
+        tx_reader_writer->WritesDone();
+        auto status = tx_reader_writer->Finish();
+        CHECK(status.ok());
+    }
 }
 #endif // SILKWORM_SANITIZE
 
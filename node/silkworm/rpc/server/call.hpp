@@ -17,8 +17,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <list>
+#include <new>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_context.hpp>
@@ -36,6 +40,9 @@ namespace silkworm::rpc {
 //! The max idle interval to protect from clients which don't send any requests.
 constexpr boost::posix_time::milliseconds kMaxIdleDuration{30'000};
 
+//! The max number of released RPC memory blocks kept for reuse by each thread for each RPC size.
+constexpr std::size_t kMaxPooledRpcBlocks{1024};
+
 //! This represents the generic gRPC call composed by a sequence of bidirectional operations.
 class BaseRpc {
   public:
@@ -56,6 +63,29 @@ class BaseRpc {
         SILK_TRACE << "BaseRpc::~BaseRpc [" << this << "] instances: " << instance_count_ << " total: " << total_count_;
     }
 
+    //! RPC memory comes from a per-thread pool of blocks for each RPC size: a new RPC is created as soon as the
+    //! previous one of the same type is started, so the memory released by the finished ones is reused right away.
+    static void* operator new(std::size_t size) {
+        auto& blocks = block_pools()[size].blocks;
+        if (blocks.empty()) {
+            return ::operator new(size);
+        }
+        void* block = blocks.back();
+        blocks.pop_back();
+        return block;
+    }
+
+    //! Sized delete is called with the size of the most derived RPC type thanks to the virtual destructor.
+    static void operator delete(void* block, std::size_t size) noexcept {
+        auto& pools = block_pools();
+        const auto it = pools.find(size);  // missing if allocated by another thread
+        if (it == pools.end() || it->second.blocks.size() >= kMaxPooledRpcBlocks) {
+            ::operator delete(block);
+            return;
+        }
+        it->second.blocks.push_back(block);  // cannot throw, capacity is reserved up front
+    }
+
     //! Returns a unique identifier of the RPC client for this call.
     std::string peer() const { return context_.peer(); }
 
@@ -134,6 +164,22 @@ class BaseRpc {
     inline static std::atomic_uint64_t total_count_ = 0;
 
   private:
+    //! The released memory blocks of one RPC size, owned by the current thread.
+    struct BlockPool {
+        std::vector<void*> blocks;
+        BlockPool() { blocks.reserve(kMaxPooledRpcBlocks); }
+        ~BlockPool() {
+            for (void* block : blocks) {
+                ::operator delete(block);
+            }
+        }
+    };
+
+    static std::unordered_map<std::size_t, BlockPool>& block_pools() {
+        thread_local std::unordered_map<std::size_t, BlockPool> pools;
+        return pools;
+    }
+
     //! This counts the number of pending operations in this RPC.
     /// \warning It is used to detect when the RPC is really done in some corner cases (e.g. client abruptly exits).
     uint32_t op_count_{0};
@@ -331,6 +377,9 @@ class ServerStreamingRpc : public BaseRpc {
         return false;
     }
 
+    //! The number of responses not written yet, including the one being written.
+    std::size_t pending_responses() const { return response_queue_.size(); }
+
     /// Call this to indicate the completion of server-side streaming.
     bool close() {
         SILK_DEBUG << "ServerStreamingRpc::close response queue size: " << response_queue_.size() << " [" << this << "]";
@@ -51,6 +51,18 @@ TEST_CASE("BaseRpc", "[silkworm][rpc][call]") {
         CHECK(BaseRpc::total_count() > 0);
     }
 
+    SECTION("reuse released memory") {
+        auto rpc1 = new FakeRpc{scheduler};
+        const void* block = rpc1;
+        delete rpc1;
+        auto rpc2 = new FakeRpc{scheduler};
+        CHECK(rpc2 == block);
+        BaseRpc* rpc3 = new FakeRpc{scheduler};
+        CHECK(rpc3 != rpc2);
+        delete rpc3;  // through the base class
+        delete rpc2;
+    }
+
     SECTION("peer") {
         FakeRpc rpc{scheduler};
         CHECK(rpc.peer().empty());
@@ -16,11 +16,17 @@
 
 #include "kv_calls.hpp"
 
+#include <algorithm>
+
 #include <boost/asio/post.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
 
 #include <silkworm/common/assert.hpp>
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/access_layer.hpp>
 
 namespace silkworm::rpc {
 
@@ -36,8 +42,146 @@ std::string dump_mdbx_result(const mdbx::cursor::move_result& result) {
     return dump;
 }
 
+void encode_batch(std::string& batch, const mdbx::slice& key, const mdbx::slice& value) {
+    uint8_t length[sizeof(uint32_t)];
+    endian::store_big_u32(length, static_cast<uint32_t>(key.length()));
+    batch.append(byte_ptr_cast(length), sizeof(length));
+    batch.append(key.char_ptr(), key.length());
+    endian::store_big_u32(length, static_cast<uint32_t>(value.length()));
+    batch.append(byte_ptr_cast(length), sizeof(length));
+    batch.append(value.char_ptr(), value.length());
+}
+
+std::optional<std::vector<std::pair<std::string, std::string>>> decode_batch(std::string_view batch) {
+    const auto read_field = [&batch](std::string& field) {
+        if (batch.size() < sizeof(uint32_t)) {
+            return false;
+        }
+        const auto length = endian::load_big_u32(byte_ptr_cast(batch.data()));
+        batch.remove_prefix(sizeof(uint32_t));
+        if (batch.size() < length) {
+            return false;
+        }
+        field.assign(batch.substr(0, length));
+        batch.remove_prefix(length);
+        return true;
+    };
+
+    std::vector<std::pair<std::string, std::string>> pairs;
+    while (!batch.empty()) {
+        auto& [key, value] = pairs.emplace_back();
+        if (!read_field(key) || !read_field(value)) {
+            return std::nullopt;
+        }
+    }
+    return pairs;
+}
+
+std::optional<std::string> read_state(mdbx::txn& txn, std::optional<BlockNum> block_number, std::string_view queries) {
+    const auto decoded_queries = decode_batch(queries);
+    if (!decoded_queries || decoded_queries->size() > kMaxStateQueries) {
+        return std::nullopt;
+    }
+
+    std::string results;
+    for (const auto& [kind, argument] : *decoded_queries) {
+        if (kind.length() != 1) {
+            return std::nullopt;
+        }
+        const ByteView arg{string_view_to_byte_view(argument)};
+        Bytes result;
+        switch (static_cast<StateQuery>(kind[0])) {
+            case StateQuery::kAccount: {
+                if (arg.length() != kAddressLength) {
+                    return std::nullopt;
+                }
+                if (const auto account = db::read_account(txn, to_evmc_address(arg), block_number)) {
+                    result = account->encode_for_storage();
+                }
+            }
+            break;
+            case StateQuery::kStorage: {
+                if (arg.length() != kAddressLength + sizeof(uint64_t) + kHashLength) {
+                    return std::nullopt;
+                }
+                const auto address = to_evmc_address(arg.substr(0, kAddressLength));
+                const auto incarnation = endian::load_big_u64(arg.data() + kAddressLength);
+                const auto location = to_bytes32(arg.substr(kAddressLength + sizeof(uint64_t)));
+                const auto value = db::read_storage(txn, address, incarnation, location, block_number);
+                result = zeroless_view(ByteView{value.bytes, kHashLength});
+            }
+            break;
+            case StateQuery::kCode: {
+                if (arg.length() != kHashLength) {
+                    return std::nullopt;
+                }
+                if (const auto code = db::read_code(txn, to_bytes32(arg))) {
+                    result = *code;
+                }
+            }
+            break;
+            case StateQuery::kHeader: {
+                if (arg.length() != sizeof(BlockNum) + kHashLength) {
+                    return std::nullopt;
+                }
+                result = db::read_header_raw(txn, arg);  // the argument is the header key
+            }
+            break;
+            default: {
+                return std::nullopt;
+            }
+        }
+        encode_batch(results, mdbx::slice{kind}, mdbx::slice{result.data(), result.length()});
+    }
+    return results;
+}
+
+std::optional<grpc_compression_algorithm> parse_compression(std::string_view name) {
+    for (const auto algorithm : {GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_GZIP}) {
+        const char* algorithm_name{nullptr};
+        if (grpc_compression_algorithm_name(algorithm, &algorithm_name) != 0 && name == algorithm_name) {
+            return algorithm;
+        }
+    }
+    return std::nullopt;
+}
+
+void apply_requested_compression(grpc::ServerContext& context) {
+    const auto& client_metadata = context.client_metadata();
+    const auto requested = client_metadata.find(kCompressionMetadataKey);
+    if (requested == client_metadata.end()) {
+        return;
+    }
+    const std::string_view name{requested->second.data(), requested->second.size()};
+    const auto algorithm = parse_compression(name);
+    if (!algorithm) {
+        SILK_WARN << "Peer: " << context.peer() << " requested unsupported compression: " << name;
+        return;
+    }
+    context.set_compression_algorithm(*algorithm);
+    SILK_DEBUG << "Peer: " << context.peer() << " compression: " << name;
+}
+
+grpc::ByteBuffer make_shared_byte_buffer(std::shared_ptr<const std::string> bytes) {
+    auto* owner = new std::shared_ptr<const std::string>{std::move(bytes)};
+    grpc::Slice slice{const_cast<char*>((*owner)->data()), (*owner)->size(),
+                      [](void* user_data) { delete static_cast<std::shared_ptr<const std::string>*>(user_data); },
+                      owner};
+    return grpc::ByteBuffer{&slice, 1};
+}
+
 } // namespace detail
 
+namespace {
+    //! True for the cursor operations not depending on the current cursor position.
+    bool is_absolute_positioning(const remote::Cursor& request) {
+        const auto op = request.op();
+        return op == remote::Op::FIRST || op == remote::Op::LAST || op == remote::Op::SEEK ||
+               op == remote::Op::SEEK_EXACT || op == remote::Op::SEEK_BOTH || op == remote::Op::SEEK_BOTH_EXACT ||
+               (op == kOpNextN && !request.k().empty());
+    }
+} // namespace
+
 types::VersionReply KvVersionCall::response_;
 
 KvVersion higher_version_ignoring_patch(KvVersion lhs, KvVersion rhs) {
@@ -67,8 +211,8 @@ void KvVersionCall::fill_predefined_reply() {
     KvVersionCall::response_.set_patch(std::get<2>(max_version));
 }
 
-KvVersionCall::KvVersionCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
-    : UnaryRpc<remote::KV::AsyncService, google::protobuf::Empty, types::VersionReply>(scheduler, service, queue, handlers) {
+KvVersionCall::KvVersionCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
+    : UnaryRpc<KvAsyncService, google::protobuf::Empty, types::VersionReply>(scheduler, service, queue, handlers) {
 }
 
 void KvVersionCall::process(const google::protobuf::Empty* request) {
@@ -80,7 +224,7 @@ void KvVersionCall::process(const google::protobuf::Empty* request) {
 }
 
 KvVersionCallFactory::KvVersionCallFactory()
-    : CallFactory<remote::KV::AsyncService, KvVersionCall>(&remote::KV::AsyncService::RequestVersion) {
+    : CallFactory<KvAsyncService, KvVersionCall>(&KvAsyncService::RequestVersion) {
     KvVersionCall::fill_predefined_reply();
 }
 
@@ -95,8 +239,8 @@ void TxCall::set_max_ttl_duration(const boost::posix_time::milliseconds& max_ttl
     TxCall::max_ttl_duration_ = max_ttl_duration;
 }
 
-TxCall::TxCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
-    : BidirectionalStreamingRpc<remote::KV::AsyncService, remote::Cursor, remote::Pair>(scheduler, service, queue, handlers),
+TxCall::TxCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
+    : BidirectionalStreamingRpc<KvAsyncService, remote::Cursor, remote::Pair>(scheduler, service, queue, handlers),
     max_ttl_timer_{scheduler} {
 }
 
@@ -106,6 +250,8 @@ void TxCall::start() {
 
         SILK_DEBUG << "TxCall::start MDBX readers: " << chaindata_env_->get_info().mi_numreaders;
 
+        detail::apply_requested_compression(context_);
+
         // Create a new read-only transaction.
         read_only_txn_ = chaindata_env_->start_read();
         SILK_INFO << "Tx peer: " << peer() << " started tx: " << read_only_txn_.id();
@@ -136,6 +282,8 @@ void TxCall::process(const remote::Cursor* request) {
         handle_cursor_open(request);
     } else if (cursor_op == remote::Op::CLOSE) {
         handle_cursor_close(request);
+    } else if (cursor_op == kOpReadState) {
+        handle_read_state(request);
     } else {
         handle_cursor_operation(request);
     }
@@ -205,8 +353,18 @@ void TxCall::handle_cursor_operation(const remote::Cursor* request) {
         close_with_error(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, error_message});
         return;
     }
-    db::Cursor& cursor = cursor_it->second.cursor;
+    auto& [cursor_id, tx_cursor] = *cursor_it;
+    db::Cursor& cursor = tx_cursor.cursor;
     try {
+        // Operations positioning the cursor on their own do not need the position before txn renewal.
+        if (tx_cursor.saved_position) {
+            if (is_absolute_positioning(*request)) {
+                tx_cursor.saved_position.reset();
+            } else if (!restore_cursor(cursor_id, tx_cursor)) {
+                close_with_internal_error("cannot restore state of cursor: " + std::to_string(cursor_id));
+                return;
+            }
+        }
         handle_operation(request, cursor);
     } catch (const std::exception& exc) {
         close_with_internal_error(request, exc);
@@ -228,6 +386,40 @@ void TxCall::handle_cursor_close(const remote::Cursor* request) {
     SILK_TRACE << "TxCall::handle_cursor_close " << this << " close cursor: " << request->cursor() << " sent: " << sent;
 }
 
+void TxCall::handle_read_state(const remote::Cursor* request) {
+    SILK_TRACE << "TxCall::handle_read_state " << this << " START";
+
+    std::optional<BlockNum> block_number;
+    const std::string& block = request->v();
+    if (block.size() == sizeof(BlockNum)) {
+        block_number = endian::load_big_u64(byte_ptr_cast(block.data()));
+    } else if (!block.empty()) {
+        const auto error_message = "invalid READ_STATE block number size: " + std::to_string(block.size());
+        SILK_ERROR << "Tx peer: " << peer() << " " << error_message;
+        close_with_error(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, error_message});
+        return;
+    }
+
+    try {
+        auto results = detail::read_state(read_only_txn_, block_number, request->k());
+        if (!results) {
+            const std::string error_message{"malformed READ_STATE queries"};
+            SILK_ERROR << "Tx peer: " << peer() << " " << error_message;
+            close_with_error(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, error_message});
+            return;
+        }
+        SILK_DEBUG << "Tx READ_STATE block: " << (block_number ? std::to_string(*block_number) : "latest")
+                   << " bytes: " << results->size();
+
+        remote::Pair kv_pair;
+        kv_pair.set_v(std::move(*results));
+        const bool sent = send_response(kv_pair);
+        SILK_TRACE << "TxCall::handle_read_state " << this << " sent: " << sent << " END";
+    } catch (const std::exception& exc) {
+        close_with_internal_error(request, exc);
+    }
+}
+
 void TxCall::handle_operation(const remote::Cursor* request, db::Cursor& cursor) {
     SILK_INFO << "Tx peer: " << peer() << " op=" << remote::Op_Name(request->op()) << " cursor=" << request->cursor();
 
@@ -292,6 +484,10 @@ void TxCall::handle_operation(const remote::Cursor* request, db::Cursor& cursor)
             handle_prev_no_dup(cursor);
         }
         break;
+        case kOpNextN: {
+            handle_next_n(request, cursor);
+        }
+        break;
         default: {
             std::string error_message{"unhandled operation "};
             error_message.append(remote::Op_Name(request->op()));
@@ -309,25 +505,20 @@ void TxCall::handle_max_ttl_timer_expired(const boost::system::error_code& ec) {
     SILK_TRACE << "TxCall::handle_max_ttl_timer_expired " << this << " ec: " << ec << " START";
     if (!ec) {
         try {
-            std::vector<CursorPosition> positions;
-            const bool save_success = save_cursors(positions);
-            if (!save_success) {
-                close_with_internal_error("cannot save state of cursors");
-                return;
+            for (auto& [_, tx_cursor] : cursors_) {
+                save_cursor(tx_cursor);
             }
-            SILK_DEBUG << "Tx peer: " << peer() << " #cursors: " << cursors_.size() << " saved";
-
-            read_only_txn_.abort();
-            read_only_txn_ = chaindata_env_->start_read();
 
-            const bool restore_success = restore_cursors(positions);
-            if (!restore_success) {
-                close_with_internal_error("cannot restore state of cursors");
-                return;
+            // Release the snapshot and take a new one reusing both transaction and cursor handles: the cursor
+            // positions are restored lazily, only for the cursors used again.
+            read_only_txn_.reset_reading();
+            read_only_txn_.renew_reading();
+            for (auto& [_, tx_cursor] : cursors_) {
+                tx_cursor.cursor.renew(read_only_txn_);
             }
-            SILK_DEBUG << "Tx peer: " << peer() << " #cursors: " << cursors_.size() << " restored";
+            SILK_DEBUG << "Tx peer: " << peer() << " renewed tx: " << read_only_txn_.id() << " #cursors: " << cursors_.size();
         } catch (const std::exception& exc) {
-            SILK_ERROR << "Tx peer: " << peer() << " exception: " << exc.what() << " in save and restore";
+            SILK_ERROR << "Tx peer: " << peer() << " exception: " << exc.what() << " in tx renewal";
         }
 
         max_ttl_timer_.expires_from_now(max_ttl_duration_);
@@ -337,67 +528,51 @@ void TxCall::handle_max_ttl_timer_expired(const boost::system::error_code& ec) {
     SILK_TRACE << "TxCall::handle_max_ttl_timer_expired " << this << " ec: " << ec << " END";
 }
 
-bool TxCall::save_cursors(std::vector<CursorPosition>& positions) {
-    for (const auto& [cursor_id, tx_cursor]: cursors_) {
-        const auto result = tx_cursor.cursor.current(/*throw_notfound=*/false);
-        SILK_DEBUG << "Tx save cursor: " << cursor_id << " result: " << detail::dump_mdbx_result(result);
-        if (!result) {
-            return false;
-        }
-        mdbx::slice key = result.key;
-        mdbx::slice value = result.value;
-        positions.emplace_back(CursorPosition{key.as_string(), value.as_string()});
+void TxCall::save_cursor(TxCursor& tx_cursor) {
+    // A cursor not used since the previous renewal has still its position to restore
+    if (tx_cursor.saved_position) {
+        return;
     }
-
-    return true;
-}
-
-bool TxCall::restore_cursors(std::vector<CursorPosition>& positions) {
-    SILKWORM_ASSERT(positions.size() == cursors_.size());
-
-    auto position_iterator = positions.begin();
-
-    for (auto& [cursor_id, tx_cursor]: cursors_) {
-        const std::string& bucket_name = tx_cursor.bucket_name;
-        const db::MapConfig map_config{bucket_name.c_str()};
-
-        // Bind each cursor to the renewed transaction.
-        db::Cursor& cursor = tx_cursor.cursor;
-        cursor.bind(read_only_txn_, map_config);
-
-        const auto& [current_key, current_value] = *position_iterator;
-        ++position_iterator;
-        SILK_DEBUG << "Tx restore cursor " << cursor_id << " current_key: " << current_key << " current_value: " << current_value;
-        mdbx::slice key{current_key.c_str()};
-
-        // Restore each cursor saved position.
-        //TODO(canepat): change db::Cursor and replace with: cursor.map_flags() & MDBX_DUPSORT
-        if (cursor.txn().get_handle_info(cursor.map()).flags & MDBX_DUPSORT) {
-            /* multi-value table */
-            mdbx::slice value{current_value.c_str()};
-            const auto lbm_result = cursor.lower_bound_multivalue(key, value, /*throw_notfound=*/false);
-            SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " lbm_result: " << detail::dump_mdbx_result(lbm_result);
-            // It may happen that key where we stopped disappeared after transaction reopen, then just move to next key
-            if (!lbm_result) {
-                const auto next_result = cursor.to_next(/*throw_notfound=*/false);
-                SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " next_result: " << detail::dump_mdbx_result(next_result);
-                if (!next_result) {
-                    return false;
-                }
-            }
-        } else {
-            /* single-value table */
-            const auto result = (key.length() == 0) ?
-                cursor.to_first(/*throw_notfound=*/false) :
-                cursor.lower_bound(key, /*throw_notfound=*/false);
-            SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " result: " << detail::dump_mdbx_result(result);
-            if (!result) {
-                return false;
-            }
+    const auto result = tx_cursor.cursor.current(/*throw_notfound=*/false);
+    SILK_DEBUG << "Tx save cursor for: " << tx_cursor.bucket_name << " result: " << detail::dump_mdbx_result(result);
+    if (result) {
+        tx_cursor.saved_position = CursorPosition{result.key.as_string(), result.value.as_string()};
+    }
+}
+
+bool TxCall::restore_cursor(uint32_t cursor_id, TxCursor& tx_cursor) {
+    const auto& [current_key, current_value] = *tx_cursor.saved_position;
+    const std::string& bucket_name = tx_cursor.bucket_name;
+    db::Cursor& cursor = tx_cursor.cursor;
+    SILK_DEBUG << "Tx restore cursor " << cursor_id << " current_key: " << current_key << " current_value: " << current_value;
+    mdbx::slice key{current_key};
+
+    // Restore the cursor saved position.
+    //TODO(canepat): change db::Cursor and replace with: cursor.map_flags() & MDBX_DUPSORT
+    bool restored{false};
+    if (cursor.txn().get_handle_info(cursor.map()).flags & MDBX_DUPSORT) {
+        /* multi-value table */
+        mdbx::slice value{current_value};
+        const auto lbm_result = cursor.lower_bound_multivalue(key, value, /*throw_notfound=*/false);
+        SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " lbm_result: " << detail::dump_mdbx_result(lbm_result);
+        restored = bool(lbm_result);
+        // It may happen that key where we stopped disappeared after transaction reopen, then just move to next key
+        if (!restored) {
+            const auto next_result = cursor.to_next(/*throw_notfound=*/false);
+            SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " next_result: " << detail::dump_mdbx_result(next_result);
+            restored = bool(next_result);
         }
+    } else {
+        /* single-value table */
+        const auto result = (key.length() == 0) ?
+            cursor.to_first(/*throw_notfound=*/false) :
+            cursor.lower_bound(key, /*throw_notfound=*/false);
+        SILK_DEBUG << "Tx restore cursor " << cursor_id << " for: " << bucket_name << " result: " << detail::dump_mdbx_result(result);
+        restored = bool(result);
     }
+    tx_cursor.saved_position.reset();
 
-    return true;
+    return restored;
 }
 
 void TxCall::handle_first(db::Cursor& cursor) {
@@ -635,6 +810,63 @@ void TxCall::handle_prev_no_dup(db::Cursor& cursor) {
     SILK_TRACE << "TxCall::handle_prev_no_dup " << this << " sent: " << sent << " END";
 }
 
+void TxCall::handle_next_n(const remote::Cursor* request, db::Cursor& cursor) {
+    SILK_TRACE << "TxCall::handle_next_n " << this << " START";
+
+    // Limits requested by the client, if any, cannot exceed the server-side ones.
+    uint32_t max_pairs{kMaxBatchPairs};
+    uint32_t max_bytes{kMaxBatchBytes};
+    const std::string& limits = request->v();
+    if (limits.size() == 2 * sizeof(uint32_t)) {
+        const auto* limits_data = byte_ptr_cast(limits.data());
+        if (const auto pairs_limit = endian::load_big_u32(limits_data); pairs_limit != 0) {
+            max_pairs = std::min(pairs_limit, kMaxBatchPairs);
+        }
+        if (const auto bytes_limit = endian::load_big_u32(limits_data + sizeof(uint32_t)); bytes_limit != 0) {
+            max_bytes = std::min(bytes_limit, kMaxBatchBytes);
+        }
+    } else if (!limits.empty()) {
+        const auto error_message = "invalid NEXT_N limits size: " + std::to_string(limits.size());
+        SILK_ERROR << "Tx peer: " << peer() << " cursor=" << request->cursor() << " " << error_message;
+        close_with_error(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, error_message});
+        return;
+    }
+
+    mdbx::slice start_key{request->k()};
+    auto result = (start_key.length() == 0) ?
+        cursor.to_next(/*throw_notfound=*/false) :
+        cursor.lower_bound(start_key, /*throw_notfound=*/false);
+
+    std::string batch;
+    mdbx::slice last_key;
+    uint32_t pairs{0};
+    while (result) {
+        // The first pair is always sent whatever its size, otherwise the scan could not go on.
+        const auto encoded_size = 2 * sizeof(uint32_t) + result.key.length() + result.value.length();
+        if (pairs > 0 && batch.size() + encoded_size > max_bytes) {
+            // Step back so that the pair left out is the first one of the next batch.
+            cursor.to_previous(/*throw_notfound=*/false);
+            break;
+        }
+        detail::encode_batch(batch, result.key, result.value);
+        last_key = result.key;
+        if (++pairs == max_pairs) {
+            break;
+        }
+        result = cursor.to_next(/*throw_notfound=*/false);
+    }
+    SILK_DEBUG << "Tx NEXT_N pairs: " << pairs << " bytes: " << batch.size();
+
+    remote::Pair kv_pair;
+    if (pairs > 0) {
+        kv_pair.set_k(last_key.as_string());
+        kv_pair.set_v(std::move(batch));
+    }
+
+    const bool sent = send_response(kv_pair);
+    SILK_TRACE << "TxCall::handle_next_n " << this << " sent: " << sent << " END";
+}
+
 void TxCall::close_with_internal_error(const remote::Cursor* request, const std::exception& exc) {
     std::string error_message{"exception: "};
     error_message.append(exc.what());
@@ -651,18 +883,30 @@ void TxCall::close_with_internal_error(const std::string& error_message) {
 }
 
 TxCallFactory::TxCallFactory(const EthereumBackEnd& backend)
-    : CallFactory<remote::KV::AsyncService, TxCall>(&remote::KV::AsyncService::RequestTx) {
+    : CallFactory<KvAsyncService, TxCall>(&KvAsyncService::RequestTx) {
     TxCall::set_chaindata_env(backend.chaindata_env());
 }
 
 StateChangeSource* StateChangesCall::source_{nullptr};
+StateChangeBatchPtr StateChangesCall::last_batch_;
+std::shared_ptr<const std::string> StateChangesCall::last_serialized_batch_;
+std::mutex StateChangesCall::serialization_mutex_;
 
 void StateChangesCall::set_source(StateChangeSource* source) {
     StateChangesCall::source_ = source;
 }
 
-StateChangesCall::StateChangesCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
-    : ServerStreamingRpc<remote::KV::AsyncService, remote::StateChangeRequest, remote::StateChangeBatch>(scheduler, service, queue, handlers) {
+grpc::ByteBuffer StateChangesCall::serialize(const StateChangeBatchPtr& batch) {
+    std::unique_lock serialization_lock{serialization_mutex_};
+    if (batch != last_batch_) {
+        last_batch_ = batch;
+        last_serialized_batch_ = std::make_shared<const std::string>(batch->SerializeAsString());
+    }
+    return detail::make_shared_byte_buffer(last_serialized_batch_);
+}
+
+StateChangesCall::StateChangesCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers)
+    : ServerStreamingRpc<KvAsyncService, grpc::ByteBuffer, grpc::ByteBuffer>(scheduler, service, queue, handlers) {
 }
 
 StateChangesCall::~StateChangesCall() {
@@ -671,16 +915,44 @@ StateChangesCall::~StateChangesCall() {
     }
 }
 
-void StateChangesCall::process(const remote::StateChangeRequest* request) {
+void StateChangesCall::process(const grpc::ByteBuffer* request) {
     SILK_TRACE << "StateChangesCall::process " << this << " request: " << request << " START";
 
-    StateChangeFilter filter{request->withstorage(), request->withtransactions()};
-    token_ = source_->subscribe([&](std::optional<remote::StateChangeBatch> batch) {
+    remote::StateChangeRequest state_change_request;
+    grpc::ByteBuffer request_bytes{*request};
+    const auto status = grpc::SerializationTraits<remote::StateChangeRequest>::Deserialize(&request_bytes, &state_change_request);
+    if (!status.ok()) {
+        SILK_ERROR << "StateChanges peer: " << peer() << " invalid request: " << status.error_message();
+        close_with_error(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, status.error_message()});
+        return;
+    }
+
+    detail::apply_requested_compression(context_);
+
+    StateChangeFilter filter{state_change_request.withstorage(), state_change_request.withtransactions()};
+    token_ = source_->subscribe([&](StateChangeBatchPtr batch) {
+        // Subscribers are notified one after the other: the first one serializes the batch, the others share the bytes
+        std::optional<grpc::ByteBuffer> batch_bytes;
+        BlockNum block_height{0};
+        if (batch) {
+            batch_bytes = serialize(batch);
+            block_height = batch->changebatch(0).blockheight();
+        }
         // Make the batch handling logic execute on the scheduler associated to the RPC
-        boost::asio::post(scheduler_, [&, batch = std::move(batch)]() {
-            if (batch) {
-                const auto block_height = batch->changebatch(0).blockheight();
-                const bool sent = send_response(*batch);
+        boost::asio::post(scheduler_, [&, batch_bytes = std::move(batch_bytes), block_height]() {
+            if (dropped_) {
+                return;
+            }
+            if (batch_bytes) {
+                // A subscriber not keeping up is dropped, so that pending batches cannot grow without limit
+                if (pending_responses() >= kMaxPendingStateChangeBatches) {
+                    const auto error_message = "slow consumer, pending batches: " + std::to_string(pending_responses());
+                    SILK_WARN << "StateChanges peer: " << peer() << " dropped: " << error_message;
+                    dropped_ = true;
+                    close_with_error(grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED, error_message});
+                    return;
+                }
+                const bool sent = send_response(*batch_bytes);
                 SILK_DEBUG << "State change batch block: " << block_height << " sent: " << sent;
             } else {
                 const bool sent = close();
@@ -701,14 +973,14 @@ void StateChangesCall::process(const remote::StateChangeRequest* request) {
 }
 
 StateChangesCallFactory::StateChangesCallFactory(const EthereumBackEnd& backend)
-    : CallFactory<remote::KV::AsyncService, StateChangesCall>(&remote::KV::AsyncService::RequestStateChanges) {
+    : CallFactory<KvAsyncService, StateChangesCall>(&KvAsyncService::RequestStateChanges) {
     StateChangesCall::set_source(backend.state_change_source());
 }
 
 KvService::KvService(const EthereumBackEnd& backend) : tx_factory_{backend}, state_changes_factory_{backend} {
 }
 
-void KvService::register_kv_request_calls(boost::asio::io_context& scheduler, remote::KV::AsyncService* async_service, grpc::ServerCompletionQueue* queue) {
+void KvService::register_kv_request_calls(boost::asio::io_context& scheduler, KvAsyncService* async_service, grpc::ServerCompletionQueue* queue) {
     // Register one requested call for each RPC factory
     kv_version_factory_.create_rpc(scheduler, async_service, queue);
     tx_factory_.create_rpc(scheduler, async_service, queue);
@@ -18,12 +18,18 @@
 
 #include <exception>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
+#include <grpc/compression.h>
 #include <grpcpp/grpcpp.h>
 #include <remote/kv.grpc.pb.h>
 
@@ -37,6 +43,9 @@
 
 // KV API protocol versions
 // 5.1.0 - first issue
+// 4.2.0 - NEXT_N batched range scan on Tx cursors
+// 4.3.0 - READ_STATE server-side state reads on Tx
+// 4.4.0 - opt-in message compression on Tx and StateChanges
 
 namespace silkworm::rpc {
 
@@ -48,7 +57,7 @@ KvVersion higher_version_ignoring_patch(KvVersion lhs, KvVersion rhs);
 constexpr auto kDbSchemaVersion = KvVersion{3, 0, 0};
 
 //! Current KV API protocol version.
-constexpr auto kKvApiVersion = KvVersion{4, 1, 0};
+constexpr auto kKvApiVersion = KvVersion{4, 4, 0};
 
 //! The max life duration for MDBX transactions (long-lived transactions are discouraged).
 constexpr boost::posix_time::milliseconds kMaxTxDuration{60'000};
@@ -56,12 +65,55 @@ constexpr boost::posix_time::milliseconds kMaxTxDuration{60'000};
 //! The max number of opened cursors for each remote transaction (arbitrary limit on this KV implementation).
 constexpr std::size_t kMaxTxCursors{100};
 
+//! The KV async service with the StateChanges method in raw form, to write pre-serialized batches.
+using KvAsyncService = remote::KV::WithAsyncMethod_Version<
+    remote::KV::WithAsyncMethod_Tx<remote::KV::WithRawMethod_StateChanges<remote::KV::Service>>>;
+
+//! The max number of state change batches pending for each StateChanges subscriber before it is dropped as too slow.
+constexpr std::size_t kMaxPendingStateChangeBatches{128};
+
+//! Cursor operation for batched range scans, not defined in remote::Op (proto3 enums accept unknown values).
+//! The request key, if not empty, is the start of the range (inclusive), otherwise the scan goes on from the next
+//! position of the cursor. The request value holds the max number of pairs and the max number of bytes of the batch,
+//! both as big-endian uint32 (0 meaning the server-side limit). The reply is one Pair whose key is the last key in
+//! the batch and whose value is the batch encoded by detail::encode_batch. An empty batch means the end of the table.
+constexpr auto kOpNextN = static_cast<remote::Op>(100);
+
+//! The max number of pairs in one NEXT_N batch.
+constexpr uint32_t kMaxBatchPairs{10'000};
+
+//! The max number of bytes in one NEXT_N batch (well below the default gRPC max message size).
+constexpr uint32_t kMaxBatchBytes{1 << 20};
+
+//! Transaction operation for server-side state reads, not defined in remote::Op and not bound to any cursor.
+//! The request key holds the queries encoded by detail::encode_batch as (StateQuery, argument) pairs. The request
+//! value, if not empty, is the big-endian uint64 block number whose state is read (i.e. before its execution) going
+//! through the history indices, otherwise the latest state is read. The reply is one Pair whose value holds the
+//! results encoded by detail::encode_batch as (StateQuery, result) pairs, in the same order as the queries.
+constexpr auto kOpReadState = static_cast<remote::Op>(101);
+
+//! The kinds of READ_STATE query, with their argument and result.
+enum class StateQuery : char {
+    kAccount = 'a',  // address => account encoded for storage, empty if missing
+    kStorage = 's',  // address + big-endian uint64 incarnation + location => value without leading zeros
+    kCode = 'c',     // code hash => code, empty if missing
+    kHeader = 'h',   // big-endian uint64 block number + block hash => header RLP, empty if missing
+};
+
+//! The max number of queries in one READ_STATE request.
+constexpr std::size_t kMaxStateQueries{10'000};
+
+//! Client metadata key to opt in to the compression of the server messages of a Tx or StateChanges call. The value
+//! is the name of a gRPC message compression algorithm, "deflate" (cheapest) or "gzip", that the client must accept.
+//! Compression pays off on large messages, hence together with NEXT_N and READ_STATE batches on Tx.
+constexpr const char* kCompressionMetadataKey{"kv-compression"};
+
 //! Unary RPC for Version method of 'ethbackend' gRPC protocol.
-class KvVersionCall : public UnaryRpc<remote::KV::AsyncService, google::protobuf::Empty, types::VersionReply> {
+class KvVersionCall : public UnaryRpc<KvAsyncService, google::protobuf::Empty, types::VersionReply> {
   public:
     static void fill_predefined_reply();
 
-    KvVersionCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
+    KvVersionCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
 
     void process(const google::protobuf::Empty* request) override;
 
@@ -70,18 +122,18 @@ class KvVersionCall : public UnaryRpc<remote::KV::AsyncService, google::protobuf
 };
 
 //! Factory specialization for Version method.
-class KvVersionCallFactory : public CallFactory<remote::KV::AsyncService, KvVersionCall> {
+class KvVersionCallFactory : public CallFactory<KvAsyncService, KvVersionCall> {
   public:
     explicit KvVersionCallFactory();
 };
 
 //! Bidirectional-streaming RPC for Tx method of 'kv' gRPC protocol.
-class TxCall : public BidirectionalStreamingRpc<remote::KV::AsyncService, remote::Cursor, remote::Pair> {
+class TxCall : public BidirectionalStreamingRpc<KvAsyncService, remote::Cursor, remote::Pair> {
   public:
     static void set_chaindata_env(mdbx::env* chaindata_env);
     static void set_max_ttl_duration(const boost::posix_time::milliseconds& max_ttl_duration);
 
-    TxCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
+    TxCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
 
     void start() override;
 
@@ -90,29 +142,32 @@ class TxCall : public BidirectionalStreamingRpc<remote::KV::AsyncService, remote
     void end() override;
 
   private:
-    struct TxCursor {
-        db::Cursor cursor;
-        std::string bucket_name;
-    };
-
     struct CursorPosition {
         std::string current_key;
         std::string current_value;
     };
 
+    struct TxCursor {
+        db::Cursor cursor;
+        std::string bucket_name;
+        std::optional<CursorPosition> saved_position;  // position to restore on next use after txn renewal
+    };
+
     void handle_cursor_open(const remote::Cursor* request);
 
     void handle_cursor_operation(const remote::Cursor* request);
 
     void handle_cursor_close(const remote::Cursor* request);
 
+    void handle_read_state(const remote::Cursor* request);
+
     void handle_operation(const remote::Cursor* request, db::Cursor& cursor);
 
     void handle_max_ttl_timer_expired(const boost::system::error_code& ec);
 
-    bool save_cursors(std::vector<CursorPosition>& positions);
+    static void save_cursor(TxCursor& tx_cursor);
 
-    bool restore_cursors(std::vector<CursorPosition>& positions);
+    bool restore_cursor(uint32_t cursor_id, TxCursor& tx_cursor);
 
     void handle_first(db::Cursor& cursor);
 
@@ -144,6 +199,8 @@ class TxCall : public BidirectionalStreamingRpc<remote::KV::AsyncService, remote
 
     void handle_prev_no_dup(db::Cursor& cursor);
 
+    void handle_next_n(const remote::Cursor* request, db::Cursor& cursor);
+
     void close_with_internal_error(const remote::Cursor* request, const std::exception& exc);
 
     void close_with_internal_error(const std::string& error_message);
@@ -158,29 +215,40 @@ class TxCall : public BidirectionalStreamingRpc<remote::KV::AsyncService, remote
 };
 
 //! Factory specialization for Tx method.
-class TxCallFactory : public CallFactory<remote::KV::AsyncService, TxCall> {
+class TxCallFactory : public CallFactory<KvAsyncService, TxCall> {
   public:
     explicit TxCallFactory(const EthereumBackEnd& backend);
 };
 
 //! Server-streaming RPC for StateChanges method of 'kv' gRPC protocol.
-class StateChangesCall : public ServerStreamingRpc<remote::KV::AsyncService, remote::StateChangeRequest, remote::StateChangeBatch> {
+//! The method is raw: each batch is serialized once and its bytes are shared by all the subscribers.
+class StateChangesCall : public ServerStreamingRpc<KvAsyncService, grpc::ByteBuffer, grpc::ByteBuffer> {
   public:
     static void set_source(StateChangeSource* source);
 
-    StateChangesCall(boost::asio::io_context& scheduler, remote::KV::AsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
+    StateChangesCall(boost::asio::io_context& scheduler, KvAsyncService* service, grpc::ServerCompletionQueue* queue, Handlers handlers);
     ~StateChangesCall();
 
-    void process(const remote::StateChangeRequest* request) override;
+    void process(const grpc::ByteBuffer* request) override;
 
   private:
+    static grpc::ByteBuffer serialize(const StateChangeBatchPtr& batch);
+
     static StateChangeSource* source_;
 
+    //! The latest batch serialized, shared by the subscribers notified after the first one.
+    static StateChangeBatchPtr last_batch_;
+    static std::shared_ptr<const std::string> last_serialized_batch_;
+    static std::mutex serialization_mutex_;
+
     std::optional<StateChangeToken> token_;
+
+    //! Whether this subscriber has been dropped for being too slow.
+    bool dropped_{false};
 };
 
 //! Factory specialization for StateChanges method.
-class StateChangesCallFactory : public CallFactory<remote::KV::AsyncService, StateChangesCall> {
+class StateChangesCallFactory : public CallFactory<KvAsyncService, StateChangesCall> {
   public:
     explicit StateChangesCallFactory(const EthereumBackEnd& backend);
 };
@@ -190,7 +258,7 @@ class KvService {
   public:
     explicit KvService(const EthereumBackEnd& backend);
 
-    void register_kv_request_calls(boost::asio::io_context& scheduler, remote::KV::AsyncService* async_service, grpc::ServerCompletionQueue* queue);
+    void register_kv_request_calls(boost::asio::io_context& scheduler, KvAsyncService* async_service, grpc::ServerCompletionQueue* queue);
 
   private:
     KvVersionCallFactory kv_version_factory_;
@@ -202,6 +270,26 @@ namespace detail {
 
 std::string dump_mdbx_result(const mdbx::cursor::move_result& result);
 
+//! Append one key-value pair to the NEXT_N batch: big-endian uint32 key length, key, big-endian uint32 value length,
+//! value.
+void encode_batch(std::string& batch, const mdbx::slice& key, const mdbx::slice& value);
+
+//! Split a NEXT_N batch in its key-value pairs, nullopt if the batch is malformed.
+std::optional<std::vector<std::pair<std::string, std::string>>> decode_batch(std::string_view batch);
+
+//! Execute the READ_STATE queries against the latest or historical state, nullopt if any query is malformed.
+std::optional<std::string> read_state(mdbx::txn& txn, std::optional<BlockNum> block_number, std::string_view queries);
+
+//! The message compression algorithm named by the value of kCompressionMetadataKey, nullopt if not supported.
+std::optional<grpc_compression_algorithm> parse_compression(std::string_view name);
+
+//! Compress the server messages of the call if requested by the client through kCompressionMetadataKey.
+//! Must be called before sending the first message.
+void apply_requested_compression(grpc::ServerContext& context);
+
+//! Zero-copy byte buffer referencing the shared bytes, kept alive until gRPC releases the buffer.
+grpc::ByteBuffer make_shared_byte_buffer(std::shared_ptr<const std::string> bytes);
+
 } // namespace detail
 
 } // namespace silkworm::rpc
@@ -16,7 +16,9 @@
 
 #include "kv_calls.hpp"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -88,4 +90,47 @@ TEST_CASE("dump_mdbx_result", "[silkworm][rpc][kv_calls]") {
     ro_txn.abort();
 }
 
+TEST_CASE("NEXT_N batch encoding", "[silkworm][rpc][kv_calls]") {
+    std::string batch;
+    detail::encode_batch(batch, mdbx::slice{"AA"}, mdbx::slice{"00"});
+    detail::encode_batch(batch, mdbx::slice{"BBB"}, mdbx::slice{});
+    CHECK(batch.size() == 2 * 8 + 2 + 2 + 3);
+
+    const auto pairs = detail::decode_batch(batch);
+    REQUIRE(pairs);
+    REQUIRE(pairs->size() == 2);
+    CHECK((*pairs)[0] == std::pair<std::string, std::string>{"AA", "00"});
+    CHECK((*pairs)[1] == std::pair<std::string, std::string>{"BBB", ""});
+
+    CHECK(detail::decode_batch("")->empty());
+    CHECK_FALSE(detail::decode_batch(std::string_view{batch}.substr(0, batch.size() - 1)));  // truncated value
+    CHECK_FALSE(detail::decode_batch(std::string_view{batch}.substr(0, 3)));                // truncated length
+}
+
+TEST_CASE("parse_compression", "[silkworm][rpc][kv_calls]") {
+    CHECK(detail::parse_compression("deflate") == GRPC_COMPRESS_DEFLATE);
+    CHECK(detail::parse_compression("gzip") == GRPC_COMPRESS_GZIP);
+    CHECK_FALSE(detail::parse_compression("identity"));
+    CHECK_FALSE(detail::parse_compression("zstd"));
+    CHECK_FALSE(detail::parse_compression(""));
+}
+
+TEST_CASE("make_shared_byte_buffer", "[silkworm][rpc][kv_calls]") {
+    const auto bytes = std::make_shared<const std::string>("serialized batch");
+    std::vector<grpc::Slice> slices1, slices2;
+    {
+        const auto buffer1 = detail::make_shared_byte_buffer(bytes);
+        const auto buffer2 = detail::make_shared_byte_buffer(bytes);
+        CHECK(bytes.use_count() == 3);
+        REQUIRE(buffer1.Dump(&slices1).ok());
+        REQUIRE(buffer2.Dump(&slices2).ok());
+    }
+    REQUIRE((slices1.size() == 1 && slices2.size() == 1));
+    CHECK(slices1[0].begin() == reinterpret_cast<const uint8_t*>(bytes->data()));  // no copy
+    CHECK(slices2[0].begin() == slices1[0].begin());
+    slices1.clear();
+    slices2.clear();
+    CHECK(bytes.use_count() == 1);  // released with the last slice
+}
+
 } // namespace silkworm::rpc
@@ -0,0 +1,126 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sentry_peers_cache.hpp"
+
+#include <utility>
+
+#include <boost/asio/post.hpp>
+
+#include <silkworm/common/log.hpp>
+#include <silkworm/rpc/util.hpp>
+
+namespace silkworm::rpc {
+
+SentryPeersCache::SentryPeersCache(boost::asio::io_context& scheduler, std::vector<SentryClient*> sentries,
+                                   boost::posix_time::milliseconds refresh_interval)
+    : scheduler_(scheduler), sentries_(std::move(sentries)), refresh_interval_(refresh_interval),
+      refresh_timer_{scheduler} {
+}
+
+void SentryPeersCache::start() {
+    boost::asio::post(scheduler_, [self = weak_from_this()]() {
+        if (auto cache = self.lock()) {
+            cache->refresh();
+            cache->schedule_refresh();
+        }
+    });
+}
+
+void SentryPeersCache::async_read(SentryPeersConsumer consumer) {
+    std::unique_lock snapshot_lock{snapshot_mutex_};
+    if (!snapshot_) {
+        pending_consumers_.push_back(std::move(consumer));
+        return;
+    }
+    const auto snapshot = snapshot_;
+    snapshot_lock.unlock();
+    consumer(snapshot);
+}
+
+void SentryPeersCache::schedule_refresh() {
+    refresh_timer_.expires_from_now(refresh_interval_);
+    refresh_timer_.async_wait([self = weak_from_this()](const auto& ec) {
+        if (ec == boost::asio::error::operation_aborted) {
+            return;
+        }
+        if (auto cache = self.lock()) {
+            cache->refresh();
+            cache->schedule_refresh();
+        }
+    });
+}
+
+void SentryPeersCache::refresh() {
+    if (refreshing_) {
+        SILK_DEBUG << "SentryPeersCache::refresh previous refresh still pending";
+        return;
+    }
+    if (sentries_.empty()) {
+        publish(std::make_shared<SentryPeersSnapshot>());
+        return;
+    }
+    refreshing_ = true;
+
+    // The replies complete on the scheduler thread: no synchronization needed to aggregate them
+    auto next_snapshot = std::make_shared<SentryPeersSnapshot>();
+    auto expected_responses = std::make_shared<std::size_t>(2 * sentries_.size());
+    const auto on_response = [self = weak_from_this(), next_snapshot, expected_responses]() {
+        if (--*expected_responses == 0) {
+            if (auto cache = self.lock()) {
+                cache->publish(next_snapshot);
+            }
+        }
+    };
+    for (const auto& sentry_client : sentries_) {
+        sentry_client->peer_count([=](const grpc::Status status, const sentry::PeerCountReply& reply) {
+            if (status.ok()) {
+                next_snapshot->peer_count += reply.count();
+            } else {
+                next_snapshot->peer_count_status = status;
+                SILK_DEBUG << "SentryPeersCache::refresh peer count KO result: " << status;
+            }
+            on_response();
+        });
+        sentry_client->node_info([=](const grpc::Status status, const types::NodeInfoReply& reply) {
+            if (status.ok()) {
+                *next_snapshot->nodes_info.add_nodesinfo() = reply;
+            } else {
+                next_snapshot->nodes_info_status = status;
+                SILK_DEBUG << "SentryPeersCache::refresh node info KO result: " << status;
+            }
+            on_response();
+        });
+    }
+}
+
+void SentryPeersCache::publish(std::shared_ptr<const SentryPeersSnapshot> snapshot) {
+    refreshing_ = false;
+
+    std::vector<SentryPeersConsumer> consumers;
+    {
+        std::scoped_lock snapshot_lock{snapshot_mutex_};
+        snapshot_ = snapshot;
+        consumers.swap(pending_consumers_);
+    }
+    SILK_DEBUG << "SentryPeersCache::publish peer count: " << snapshot->peer_count
+               << " #nodes: " << snapshot->nodes_info.nodesinfo_size() << " #consumers: " << consumers.size();
+    for (const auto& consumer : consumers) {
+        consumer(snapshot);
+    }
+}
+
+} // namespace silkworm::rpc
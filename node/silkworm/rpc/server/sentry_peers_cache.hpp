@@ -0,0 +1,84 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <grpcpp/grpcpp.h>
+#include <remote/ethbackend.pb.h>
+
+#include <silkworm/rpc/client/sentry_client.hpp>
+
+namespace silkworm::rpc {
+
+//! Default interval between two refreshes of the \ref SentryPeersCache.
+constexpr boost::posix_time::milliseconds kDefaultPeersRefreshInterval{2'000};
+
+//! Peer count and node info aggregated over all the sentries.
+struct SentryPeersSnapshot {
+    grpc::Status peer_count_status{grpc::Status::OK};  // The error of any sentry failing peer count, if any
+    uint64_t peer_count{0};
+    grpc::Status nodes_info_status{grpc::Status::OK};  // The error of any sentry failing node info, if any
+    remote::NodesInfoReply nodes_info;
+};
+
+using SentryPeersConsumer = std::function<void(std::shared_ptr<const SentryPeersSnapshot>)>;
+
+//! Snapshot of \ref SentryPeersSnapshot refreshed in background by a timer, so that requests for peer count or
+//! node info are answered without any round trip to the sentries.
+/// Refreshes run on the scheduler the sentry clients complete on, one at a time: a refresh still waiting for some
+/// sentry when the timer expires is not overlapped. Reads are thread-safe.
+class SentryPeersCache : public std::enable_shared_from_this<SentryPeersCache> {
+  public:
+    SentryPeersCache(boost::asio::io_context& scheduler, std::vector<SentryClient*> sentries,
+                     boost::posix_time::milliseconds refresh_interval = kDefaultPeersRefreshInterval);
+
+    SentryPeersCache(const SentryPeersCache&) = delete;
+    SentryPeersCache& operator=(const SentryPeersCache&) = delete;
+
+    //! Schedule the first refresh and the timer for the following ones, which stops on destruction.
+    void start();
+
+    //! Pass the latest snapshot to consumer: immediately on the calling thread if any refresh is done, otherwise on
+    /// the scheduler thread once the first one is.
+    void async_read(SentryPeersConsumer consumer);
+
+  private:
+    void refresh();
+    void schedule_refresh();
+    void publish(std::shared_ptr<const SentryPeersSnapshot> snapshot);
+
+    boost::asio::io_context& scheduler_;
+    std::vector<SentryClient*> sentries_;
+    boost::posix_time::milliseconds refresh_interval_;
+    boost::asio::deadline_timer refresh_timer_;
+
+    //! Flag indicating if a refresh is waiting for some sentry, accessed on scheduler thread only.
+    bool refreshing_{false};
+
+    std::mutex snapshot_mutex_;
+    std::shared_ptr<const SentryPeersSnapshot> snapshot_;
+    std::vector<SentryPeersConsumer> pending_consumers_;
+};
+
+} // namespace silkworm::rpc
@@ -0,0 +1,132 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sentry_peers_cache.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/log.hpp>
+
+namespace silkworm::rpc {
+
+//! Sentry replying on demand, to control when refreshes complete.
+class TestSentryClient : public SentryClient {
+  public:
+    explicit TestSentryClient(uint64_t peer_count, grpc::Status status = grpc::Status::OK)
+        : peer_count_(peer_count), status_(status) {}
+
+    void peer_count(PeerCountCallback callback) override { peer_count_callbacks_.push_back(callback); }
+    void node_info(NodeInfoCallback callback) override { node_info_callbacks_.push_back(callback); }
+
+    std::size_t num_requests() const { return peer_count_callbacks_.size() + node_info_callbacks_.size(); }
+
+    void reply_all() {
+        sentry::PeerCountReply peer_count_reply;
+        peer_count_reply.set_count(peer_count_);
+        for (const auto& callback : peer_count_callbacks_) {
+            callback(status_, peer_count_reply);
+        }
+        peer_count_callbacks_.clear();
+        types::NodeInfoReply node_info_reply;
+        node_info_reply.set_name("sentry");
+        for (const auto& callback : node_info_callbacks_) {
+            callback(status_, node_info_reply);
+        }
+        node_info_callbacks_.clear();
+    }
+
+  private:
+    uint64_t peer_count_;
+    grpc::Status status_;
+    std::vector<PeerCountCallback> peer_count_callbacks_;
+    std::vector<NodeInfoCallback> node_info_callbacks_;
+};
+
+TEST_CASE("SentryPeersCache", "[silkworm][rpc][sentry_peers_cache]") {
+    silkworm::log::set_verbosity(silkworm::log::Level::kNone);
+    boost::asio::io_context scheduler;
+    TestSentryClient sentry1{10};
+    TestSentryClient sentry2{5};
+
+    std::shared_ptr<const SentryPeersSnapshot> last_snapshot;
+    const auto consumer = [&](std::shared_ptr<const SentryPeersSnapshot> snapshot) { last_snapshot = snapshot; };
+
+    SECTION("aggregate all sentries") {
+        auto cache = std::make_shared<SentryPeersCache>(scheduler, std::vector<SentryClient*>{&sentry1, &sentry2});
+        cache->start();
+        scheduler.poll();
+        CHECK(sentry1.num_requests() == 2);
+        CHECK(sentry2.num_requests() == 2);
+
+        // Readers wait for the first refresh
+        cache->async_read(consumer);
+        sentry1.reply_all();
+        CHECK(last_snapshot == nullptr);
+        sentry2.reply_all();
+        REQUIRE(last_snapshot != nullptr);
+        CHECK(last_snapshot->peer_count_status.ok());
+        CHECK(last_snapshot->peer_count == 15);
+        CHECK(last_snapshot->nodes_info_status.ok());
+        CHECK(last_snapshot->nodes_info.nodesinfo_size() == 2);
+
+        // Then they are answered immediately
+        last_snapshot.reset();
+        cache->async_read(consumer);
+        REQUIRE(last_snapshot != nullptr);
+        CHECK(last_snapshot->peer_count == 15);
+    }
+
+    SECTION("keep error of any sentry") {
+        TestSentryClient failing_sentry{7, grpc::Status::CANCELLED};
+        auto cache = std::make_shared<SentryPeersCache>(scheduler,
+                                                        std::vector<SentryClient*>{&sentry1, &failing_sentry});
+        cache->start();
+        scheduler.poll();
+        sentry1.reply_all();
+        failing_sentry.reply_all();
+        cache->async_read(consumer);
+        REQUIRE(last_snapshot != nullptr);
+        CHECK(last_snapshot->peer_count_status.error_code() == grpc::StatusCode::CANCELLED);
+        CHECK(last_snapshot->nodes_info_status.error_code() == grpc::StatusCode::CANCELLED);
+    }
+
+    SECTION("refresh periodically without overlapping") {
+        auto cache = std::make_shared<SentryPeersCache>(scheduler, std::vector<SentryClient*>{&sentry1},
+                                                        boost::posix_time::milliseconds{1});
+        cache->start();
+        scheduler.run_for(std::chrono::milliseconds{20});
+        CHECK(sentry1.num_requests() == 2);  // first refresh still pending
+        sentry1.reply_all();
+        scheduler.run_for(std::chrono::milliseconds{20});
+        CHECK(sentry1.num_requests() == 2);  // next refresh issued
+    }
+
+    SECTION("stop refreshing on destruction") {
+        auto cache = std::make_shared<SentryPeersCache>(scheduler, std::vector<SentryClient*>{&sentry1},
+                                                        boost::posix_time::milliseconds{1});
+        cache->start();
+        scheduler.poll();
+        cache.reset();
+        sentry1.reply_all();
+        scheduler.run_for(std::chrono::milliseconds{20});
+        CHECK(sentry1.num_requests() == 0);
+    }
+}
+
+} // namespace silkworm::rpc
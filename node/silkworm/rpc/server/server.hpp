@@ -22,6 +22,7 @@
 #include <grpcpp/grpcpp.h>
 
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/memory_governor.hpp>
 #include <silkworm/rpc/server/server_config.hpp>
 #include <silkworm/rpc/server/server_context_pool.hpp>
 
@@ -31,7 +32,7 @@ namespace silkworm::rpc {
 class Server {
   public:
     //! Build a ready-to-start RPC server according to specified configuration.
-    explicit Server(const ServerConfig& config) : config_(config), context_pool_{config.num_contexts()} {}
+    explicit Server(const ServerConfig& config) : config_(config), context_pool_{config.num_contexts(), config.cpu_affinity()} {}
 
     /// No need to explicitly shutdown the server because this destructor takes care.
     /// Use \ref shutdown() if you want explicit control over termination before destruction.
@@ -62,6 +63,13 @@ class Server {
         int selected_port;
         builder.AddListeningPort(config_.address_uri(), config_.credentials(), &selected_port);
 
+        // Cap the memory gRPC may use serving calls and reserve all of it in the node memory budget.
+        if (config_.memory_quota() > 0) {
+            grpc::ResourceQuota quota{"silkworm_server"};
+            quota.Resize(config_.memory_quota());
+            builder.SetResourceQuota(quota);
+        }
+
         // Add one server-side gRPC completion queue for each execution context.
         for (std::size_t i{0}; i < config_.num_contexts(); ++i) {
             context_pool_.add_context(builder.AddCompletionQueue(), config_.wait_mode());
@@ -77,6 +85,7 @@ class Server {
             SILK_ERROR << "Server " << this << " BuildAndStart failed [" << config_.address_uri() << "]";
             throw std::runtime_error("cannot start gRPC server at " + config_.address_uri());
         }
+        MemoryGovernor::instance().charge(MemoryTag::kRpc, config_.memory_quota());
 
         // gRPC async model requires the server to register one request call for each RPC in advance.
         SILK_DEBUG << "Server " << this << " registering request calls";
@@ -112,6 +121,7 @@ class Server {
         if (server_) {
             server_->Shutdown(gpr_time_0(GPR_CLOCK_REALTIME));
             server_->Wait();
+            MemoryGovernor::instance().release(MemoryTag::kRpc, config_.memory_quota());
         }
 
         SILK_DEBUG << "Server::shutdown " << this << " stopping context pool";
@@ -122,6 +132,12 @@ class Server {
         SILK_TRACE << "Server::shutdown " << this << " END";
     }
 
+    //! Returns a channel to this server within the same process, bypassing the network stack and HTTP/2 framing.
+    //! The channel is null until \ref build_and_start() succeeds.
+    std::shared_ptr<grpc::Channel> in_process_channel() {
+        return server_ ? server_->InProcessChannel(grpc::ChannelArguments{}) : nullptr;
+    }
+
     //! Returns the number of server contexts.
     std::size_t num_contexts() const { return context_pool_.num_contexts(); }
 
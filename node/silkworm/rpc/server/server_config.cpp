@@ -22,7 +22,9 @@ ServerConfig::ServerConfig(std::shared_ptr<grpc::ServerCredentials> credentials)
     : address_uri_{kDefaultAddressUri},
       credentials_(credentials),
       num_contexts_{kDefaultNumContexts},
-      wait_mode_{WaitMode::blocking} {
+      wait_mode_{WaitMode::blocking},
+      cpu_affinity_{false},
+      memory_quota_{0} {
 }
 
 void ServerConfig::set_address_uri(const std::string& address_uri) noexcept {
@@ -41,4 +43,12 @@ void ServerConfig::set_wait_mode(WaitMode wait_mode) noexcept {
     wait_mode_ = wait_mode;
 }
 
+void ServerConfig::set_cpu_affinity(bool cpu_affinity) noexcept {
+    cpu_affinity_ = cpu_affinity;
+}
+
+void ServerConfig::set_memory_quota(std::size_t memory_quota) noexcept {
+    memory_quota_ = memory_quota;
+}
+
 } // namespace silkworm::rpc
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <thread>
@@ -38,11 +39,15 @@ class ServerConfig {
     void set_credentials(std::shared_ptr<grpc::ServerCredentials> credentials) noexcept;
     void set_num_contexts(uint32_t num_contexts) noexcept;
     void set_wait_mode(WaitMode wait_mode) noexcept;
+    void set_cpu_affinity(bool cpu_affinity) noexcept;
+    void set_memory_quota(std::size_t memory_quota) noexcept;
 
     const std::string& address_uri() const noexcept { return address_uri_; }
     std::shared_ptr<grpc::ServerCredentials> credentials() const noexcept { return credentials_; }
     uint32_t num_contexts() const noexcept { return num_contexts_; }
     WaitMode wait_mode() const noexcept { return wait_mode_; }
+    bool cpu_affinity() const noexcept { return cpu_affinity_; }
+    std::size_t memory_quota() const noexcept { return memory_quota_; }
 
   private:
     std::string address_uri_;
@@ -51,6 +56,12 @@ class ServerConfig {
 
     //! The waiting mode used by execution loops during idle cycles.
     WaitMode wait_mode_;
+
+    //! Flag indicating if each execution context is pinned to one CPU core (thread-per-core mode).
+    bool cpu_affinity_;
+
+    //! The max memory gRPC may use serving calls, in bytes (0 means no quota).
+    std::size_t memory_quota_;
 };
 
 } // namespace silkworm::rpc
@@ -46,6 +46,20 @@ TEST_CASE("ServerConfig::set_num_contexts", "[silkworm][rpc][server_config]") {
     CHECK(config.num_contexts() == num_contexts);
 }
 
+TEST_CASE("ServerConfig::set_cpu_affinity", "[silkworm][rpc][server_config]") {
+    ServerConfig config;
+    CHECK_FALSE(config.cpu_affinity());
+    config.set_cpu_affinity(true);
+    CHECK(config.cpu_affinity());
+}
+
+TEST_CASE("ServerConfig::set_memory_quota", "[silkworm][rpc][server_config]") {
+    ServerConfig config;
+    CHECK(config.memory_quota() == 0);
+    config.set_memory_quota(64 * kMebi);
+    CHECK(config.memory_quota() == 64 * kMebi);
+}
+
 TEST_CASE("ServerConfig::set_credentials", "[silkworm][rpc][server_config]") {
     grpc::SslServerCredentialsOptions ssl_options;
     const std::shared_ptr<grpc::ServerCredentials> server_credentials{
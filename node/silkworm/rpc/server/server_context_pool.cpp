@@ -16,10 +16,16 @@
 
 #include "server_context_pool.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <thread>
 #include <utility>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <silkworm/common/log.hpp>
 
 namespace silkworm::rpc {
@@ -31,6 +37,18 @@ std::ostream& operator<<(std::ostream& out, const ServerContext& c) {
     return out;
 }
 
+bool pin_current_thread(std::size_t cpu_index) {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_index, &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+#else
+    (void)cpu_index;
+    return false;
+#endif
+}
+
 ServerContext::ServerContext(std::unique_ptr<grpc::ServerCompletionQueue> queue, WaitMode wait_mode)
     : io_context_{std::make_shared<boost::asio::io_context>()},
       work_{boost::asio::require(io_context_->get_executor(), boost::asio::execution::outstanding_work.tracked)},
@@ -45,8 +63,8 @@ template <typename WaitStrategy>
 void ServerContext::execute_loop_single_threaded(WaitStrategy&& wait_strategy) {
     SILK_DEBUG << "Single-thread execution loop start [" << std::this_thread::get_id() << "]";
     while (!io_context_->stopped()) {
-        std::size_t work_count = server_end_point_->poll_one();
-        work_count += client_end_point_->poll_one();
+        std::size_t work_count = server_end_point_->poll_many();
+        work_count += client_end_point_->poll_many();
         work_count += io_context_->poll_one();
         wait_strategy.idle(work_count);
     }
@@ -61,7 +79,7 @@ void ServerContext::execute_loop_multi_threaded() {
         SILK_DEBUG << "Server end-point runner start [t2=" << std::this_thread::get_id() << "]";
         bool stopped{false};
         while (!stopped) {
-            stopped = server_end_point_->post_one(*io_context_);
+            stopped = server_end_point_->post_batch(*io_context_);
         }
         SILK_DEBUG << "Server end-point runner end [t2=" << std::this_thread::get_id() << "]";
     }};
@@ -69,7 +87,7 @@ void ServerContext::execute_loop_multi_threaded() {
         SILK_DEBUG << "Client end-point runner start [t3=" << std::this_thread::get_id() << "]";
         bool stopped{false};
         while (!stopped) {
-            stopped = client_end_point_->post_one(*io_context_);
+            stopped = client_end_point_->post_batch(*io_context_);
         }
         SILK_DEBUG << "Client end-point runner end [t3=" << std::this_thread::get_id() << "]";
     }};
@@ -95,6 +113,9 @@ void ServerContext::execute_loop() {
         case WaitMode::busy_spin:
             execute_loop_single_threaded(BusySpinWaitStrategy{});
         break;
+        case WaitMode::adaptive:
+            execute_loop_single_threaded(AdaptiveWaitStrategy{});
+        break;
     }
 }
 
@@ -102,11 +123,12 @@ void ServerContext::stop() {
     io_context_->stop();
 }
 
-ServerContextPool::ServerContextPool(std::size_t pool_size) : next_index_{0} {
+ServerContextPool::ServerContextPool(std::size_t pool_size, bool cpu_affinity)
+    : next_index_{0}, cpu_affinity_{cpu_affinity} {
     if (pool_size == 0) {
         throw std::logic_error("ServerContextPool::ServerContextPool pool_size is 0");
     }
-    SILK_INFO << "Creating server context pool with size: " << pool_size;
+    SILK_INFO << "Creating server context pool with size: " << pool_size << " CPU affinity: " << cpu_affinity;
 
     contexts_.reserve(pool_size);
 }
@@ -130,10 +152,15 @@ void ServerContextPool::start() {
 
     if (!stopped_) {
         // Create a pool of threads to run all the contexts (each context having 1 thread)
+        const std::size_t num_cpus = std::max(std::thread::hardware_concurrency(), 1u);
         for (std::size_t i{0}; i < contexts_.size(); ++i) {
             auto& context = contexts_[i];
-            context_threads_.create_thread([&, i = i]() {
+            context_threads_.create_thread([&, i = i, num_cpus = num_cpus]() {
                 SILK_TRACE << "thread start context[" << i << "] thread_id: " << std::this_thread::get_id();
+                // Pin before running the loop, so that the end-point runner threads inherit the same core.
+                if (cpu_affinity_ && !pin_current_thread(i % num_cpus)) {
+                    SILK_WARN << "ServerContextPool context[" << i << "] cannot be pinned to CPU " << i % num_cpus;
+                }
                 context.execute_loop();
                 SILK_TRACE << "thread end context[" << i << "] thread_id: " << std::this_thread::get_id();
             });
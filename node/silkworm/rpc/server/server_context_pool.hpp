@@ -71,10 +71,15 @@ class ServerContext {
 
 std::ostream& operator<<(std::ostream& out, const ServerContext& c);
 
+//! Pin the calling thread to the specified CPU core, returning false if not possible or not supported.
+bool pin_current_thread(std::size_t cpu_index);
+
 //! Pool of \ref ServerContext instances running as separate reactive schedulers.
 class ServerContextPool {
   public:
-    explicit ServerContextPool(std::size_t pool_size);
+    //! \param cpu_affinity pin each context to one CPU core: the threads created by a context inherit its affinity
+    //! and the memory it allocates after the start is local to that core (first-touch policy)
+    explicit ServerContextPool(std::size_t pool_size, bool cpu_affinity = false);
     ~ServerContextPool();
 
     ServerContextPool(const ServerContextPool&) = delete;
@@ -112,6 +117,9 @@ class ServerContextPool {
 
     //! Flag indicating if pool has been stopped.
     bool stopped_{false};
+
+    //! Flag indicating if each context thread is pinned to one CPU core.
+    bool cpu_affinity_;
 };
 
 } // namespace silkworm::rpc
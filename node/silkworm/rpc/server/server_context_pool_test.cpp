@@ -22,6 +22,9 @@
 #include <thread>
 
 #include <catch2/catch.hpp>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #include <grpc/grpc.h>
 
 #include <silkworm/common/base.hpp>
@@ -42,6 +45,18 @@ namespace silkworm::rpc {
 
 // Exclude gRPC tests from sanitizer builds due to data race warnings inside gRPC library
 #ifndef SILKWORM_SANITIZE
+#if defined(__linux__)
+TEST_CASE("pin_current_thread", "[silkworm][rpc][server_context]") {
+    std::thread pinned_thread{[]() {
+        const int cpu = sched_getcpu();  // surely allowed for this process
+        REQUIRE(cpu >= 0);
+        CHECK(pin_current_thread(static_cast<std::size_t>(cpu)));
+        CHECK(sched_getcpu() == cpu);
+    }};
+    pinned_thread.join();
+}
+#endif // defined(__linux__)
+
 TEST_CASE("ServerContext", "[silkworm][rpc][server_context]") {
     grpc::ServerBuilder builder;
     std::unique_ptr<grpc::ServerCompletionQueue> scq = builder.AddCompletionQueue();
@@ -153,6 +168,14 @@ TEST_CASE("ServerContextPool", "[silkworm][rpc][server_context]") {
         CHECK_NOTHROW(server_context_pool.stop());
     }
 
+    SECTION("start/stop w/ contexts pinned to CPU cores") {
+        ServerContextPool server_context_pool{2, /*cpu_affinity=*/true};
+        server_context_pool.add_context(builder.AddCompletionQueue(), WaitMode::blocking);
+        server_context_pool.add_context(builder.AddCompletionQueue(), WaitMode::blocking);
+        CHECK_NOTHROW(server_context_pool.start());
+        CHECK_NOTHROW(server_context_pool.stop());
+    }
+
     SECTION("join") {
         ServerContextPool server_context_pool{2};
         server_context_pool.add_context(builder.AddCompletionQueue(), WaitMode::blocking);
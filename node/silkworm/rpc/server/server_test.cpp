@@ -137,6 +137,26 @@ TEST_CASE("Server::build_and_start", "[silkworm][node][rpc]") {
     }
 }
 
+TEST_CASE("Server::in_process_channel", "[silkworm][node][rpc]") {
+    silkworm::log::set_verbosity(silkworm::log::Level::kNone);
+
+    ServerConfig config;
+    config.set_address_uri(kTestAddressUri);
+    EmptyServer server{config};
+
+    SECTION("KO: no channel before start", "[silkworm][node][rpc]") {
+        CHECK(server.in_process_channel() == nullptr);
+    }
+
+    SECTION("OK: channel ready after start", "[silkworm][node][rpc]") {
+        server.build_and_start();
+        auto channel = server.in_process_channel();
+        REQUIRE(channel != nullptr);
+        CHECK(channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds{1}));
+        server.shutdown();
+    }
+}
+
 TEST_CASE("Server::shutdown", "[silkworm][node][rpc]") {
     silkworm::log::set_verbosity(silkworm::log::Level::kNone);
 
@@ -34,7 +34,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
@@ -79,11 +81,68 @@ class BusySpinWaitStrategy {
     }
 };
 
+//! Back off from spinning to yielding and then to sleeping with exponentially longer periods while there is no work,
+//! coming back to spinning as soon as some work is done: busy under bursts, cheap when idle.
+class AdaptiveWaitStrategy {
+  public:
+    enum class State {
+        spinning,
+        yielding,
+        sleeping
+    };
+
+    explicit AdaptiveWaitStrategy(std::size_t max_spins = 1'000, std::size_t max_yields = 100,
+                                  std::chrono::microseconds min_sleep = 1us, std::chrono::microseconds max_sleep = 1ms)
+        : max_spins_(max_spins), max_yields_(max_yields), min_sleep_(min_sleep), max_sleep_(max_sleep),
+          sleep_(min_sleep) {}
+
+    inline void idle(int work_count) {
+        if (work_count > 0) {
+            spins_ = 0;
+            yields_ = 0;
+            sleep_ = min_sleep_;
+            return;
+        }
+
+        if (spins_ < max_spins_) {
+            ++spins_;
+            return;
+        }
+        if (yields_ < max_yields_) {
+            ++yields_;
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(sleep_);
+        sleep_ = std::min(sleep_ * 2, max_sleep_);
+    }
+
+    State state() const {
+        if (spins_ < max_spins_) {
+            return State::spinning;
+        }
+        return yields_ < max_yields_ ? State::yielding : State::sleeping;
+    }
+
+    std::chrono::microseconds next_sleep() const { return sleep_; }
+
+  private:
+    std::size_t max_spins_;
+    std::size_t max_yields_;
+    std::chrono::microseconds min_sleep_;
+    std::chrono::microseconds max_sleep_;
+
+    std::size_t spins_{0};
+    std::size_t yields_{0};
+    std::chrono::microseconds sleep_;
+};
+
 enum class WaitMode {
     blocking,
     sleeping,
     yielding,
-    busy_spin
+    busy_spin,
+    adaptive
 };
 
 bool AbslParseFlag(absl::string_view text, WaitMode* wait_mode, std::string* error);
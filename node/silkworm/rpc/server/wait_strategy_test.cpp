@@ -34,13 +34,14 @@ using Catch::Matchers::Message;
 
 TEST_CASE("parse wait mode", "[silkrpc][common][log]") {
     std::vector<absl::string_view> input_texts{
-        "blocking", "sleeping", "yielding", "busy_spin"
+        "blocking", "sleeping", "yielding", "busy_spin", "adaptive"
     };
     std::vector<WaitMode> expected_wait_modes{
         WaitMode::blocking,
         WaitMode::sleeping,
         WaitMode::yielding,
         WaitMode::busy_spin,
+        WaitMode::adaptive,
     };
     for (std::size_t i{0}; i < input_texts.size(); i++) {
         WaitMode wait_mode;
@@ -66,9 +67,10 @@ TEST_CASE("unparse wait mode", "[silkrpc][common][log]") {
         WaitMode::sleeping,
         WaitMode::yielding,
         WaitMode::busy_spin,
+        WaitMode::adaptive,
     };
     std::vector<absl::string_view> expected_texts{
-        "blocking", "sleeping", "yielding", "busy_spin"
+        "blocking", "sleeping", "yielding", "busy_spin", "adaptive"
     };
     for (std::size_t i{0}; i < input_wait_modes.size(); i++) {
         const auto text{AbslUnparseFlag(input_wait_modes[i])};
@@ -106,4 +108,25 @@ TEST_CASE("BusySpinWaitStrategy", "[silkrpc][context_pool]") {
     sleep_then_check_wait(wait_strategy, 10ms, 1);
 }
 
+TEST_CASE("AdaptiveWaitStrategy", "[silkrpc][context_pool]") {
+    AdaptiveWaitStrategy wait_strategy{/*max_spins=*/2, /*max_yields=*/2, /*min_sleep=*/1us, /*max_sleep=*/4us};
+    CHECK(wait_strategy.state() == AdaptiveWaitStrategy::State::spinning);
+    wait_strategy.idle(0);
+    wait_strategy.idle(0);
+    CHECK(wait_strategy.state() == AdaptiveWaitStrategy::State::yielding);
+    wait_strategy.idle(0);
+    wait_strategy.idle(0);
+    CHECK(wait_strategy.state() == AdaptiveWaitStrategy::State::sleeping);
+    CHECK(wait_strategy.next_sleep() == 1us);
+    wait_strategy.idle(0);
+    CHECK(wait_strategy.next_sleep() == 2us);
+    wait_strategy.idle(0);
+    wait_strategy.idle(0);
+    CHECK(wait_strategy.next_sleep() == 4us);  // capped
+
+    wait_strategy.idle(1);  // some work done: spin again
+    CHECK(wait_strategy.state() == AdaptiveWaitStrategy::State::spinning);
+    CHECK(wait_strategy.next_sleep() == 1us);
+}
+
 } // namespace silkworm::rpc
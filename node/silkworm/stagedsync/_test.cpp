@@ -119,6 +119,37 @@ TEST_CASE("Sync Stages") {
         }
     }
 
+    SECTION("BlockHashes in parallel") {
+        // Distinct hashes not following block order
+        const auto block_hash{[](BlockNum block_num) {
+            evmc::bytes32 hash{};
+            endian::store_big_u64(hash.bytes, block_num * 0x9E3779B97F4A7C15);
+            return hash;
+        }};
+        const BlockNum num_blocks{stagedsync::BlockHashes::kMinParallelBlocks + 1};
+        auto canonical_table{db::open_cursor(*txn, db::table::kCanonicalHashes)};
+        for (BlockNum block_num{1}; block_num <= num_blocks; ++block_num) {
+            const auto hash{block_hash(block_num)};
+            canonical_table.upsert(db::to_slice(db::block_key(block_num)), db::to_slice(hash));
+        }
+        canonical_table.close();
+        db::stages::write_stage_progress(*txn, db::stages::kHeadersKey, num_blocks);
+        REQUIRE_NOTHROW(txn.commit(true));
+
+        stagedsync::BlockHashes stage(&node_settings);
+        REQUIRE(stage.forward(txn) == stagedsync::StageResult::kSuccess);
+        REQUIRE(db::stages::read_stage_progress(*txn, db::stages::kBlockHashesKey) == num_blocks);
+
+        auto target_table{db::open_cursor(*txn, db::table::kHeaderNumbers)};
+        REQUIRE(txn->get_map_stat(target_table.map()).ms_entries == num_blocks + 1);  // Block 0 is genesis
+        for (const BlockNum block_num : {BlockNum{1}, num_blocks / 2, num_blocks}) {
+            const auto hash{block_hash(block_num)};
+            const auto data{target_table.find(db::to_slice(hash), /*throw_notfound=*/false)};
+            REQUIRE(data);
+            CHECK(endian::load_big_u64(static_cast<uint8_t*>(data.value.data())) == block_num);
+        }
+    }
+
     SECTION("Senders") {
         std::vector<evmc::bytes32> block_hashes{
             0x3ac225168df54212a25c1c01fd35bebfea408fdac2e31ddd6f80a4bbf9a5f1cb_bytes32,
@@ -317,6 +348,32 @@ TEST_CASE("Sync Stages") {
             CHECK(storage0 == 0x000000000000000000000000000000000000000000000000000000000000003e_bytes32);
         }
 
+        SECTION("Execution Unwind several blocks") {
+            // ---------------------------------------
+            // Unwind 2nd and 3rd blocks, both changing the same keys: state is the one of first block
+            // ---------------------------------------
+            stagedsync::Execution stage(&node_settings);
+            REQUIRE(stage.unwind(txn, 1) == stagedsync::StageResult::kSuccess);
+
+            db::Buffer buffer2{*txn, 0};
+
+            std::optional<Account> contract_account{buffer2.read_account(contract_address)};
+            REQUIRE(contract_account.has_value());
+            CHECK(contract_account->balance == 0);
+            CHECK(to_hex(contract_account->code_hash) == to_hex(keccak256(contract_code).bytes));
+
+            std::optional<Account> current_sender{buffer2.read_account(sender)};
+            REQUIRE(current_sender.has_value());
+            CHECK(current_sender->nonce == 1);  // Nonce at 1st block
+
+            evmc::bytes32 storage_key0{};
+            evmc::bytes32 storage0{buffer2.read_storage(contract_address, kDefaultIncarnation, storage_key0)};
+            CHECK(storage0 == 0x000000000000000000000000000000000000000000000000000000000000002a_bytes32);
+            evmc::bytes32 storage_key1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+            evmc::bytes32 storage1{buffer2.read_storage(contract_address, kDefaultIncarnation, storage_key1)};
+            CHECK(storage1 == 0x00000000000000000000000000000000000000000000000000000000000001c9_bytes32);
+        }
+
         SECTION("Execution Prune Default") {
             log::Info() << "Pruning with " << node_settings.prune_mode->to_string();
             stagedsync::Execution stage(&node_settings);
@@ -369,6 +426,7 @@ TEST_CASE("Sync Stages") {
             auto actual_stage_result = magic_enum::enum_name<stagedsync::StageResult>(stage.forward(txn));
             REQUIRE(expected_stage_result == actual_stage_result);
             REQUIRE(db::stages::read_stage_progress(*txn, db::stages::kHashStateKey) == 3);
+            CHECK_FALSE(db::stages::read_stage_checkpoint(*txn, db::stages::kHashStateKey));
 
             // ---------------------------------------
             // Check hashed account
@@ -423,4 +481,83 @@ TEST_CASE("Sync Stages") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("HashState unwind in parallel") {
+    constexpr BlockNum kBlocks{1'200};
+    constexpr BlockNum kUnwindTo{100};
+
+    // Each block changes 8 accounts out of 16 and one location of each
+    const auto populate{[](mdbx::txn& txn) {
+        db::table::check_or_create_chaindata_tables(txn);
+        const auto changeset_format{db::read_changeset_format(txn)};
+        auto account_changes{db::open_cursor(txn, db::table::kAccountChangeSet)};
+        auto storage_changes{db::open_cursor(txn, db::table::kStorageChangeSet)};
+        for (BlockNum block_num{1}; block_num <= kBlocks; ++block_num) {
+            const Bytes block_key{db::block_key(block_num)};
+            for (uint8_t i{0}; i < 8; ++i) {
+                evmc::address address{};
+                address.bytes[kAddressLength - 1] = static_cast<uint8_t>((block_num + i) % 16 + 1);
+                Account account;
+                account.nonce = block_num;
+                account.incarnation = kDefaultIncarnation;
+                Bytes account_value{address.bytes, kAddressLength};
+                account_value.append(account.encode_for_storage());
+                account_changes.upsert(db::to_slice(block_key), db::to_slice(account_value));
+
+                evmc::bytes32 location{};
+                location.bytes[kHashLength - 1] = static_cast<uint8_t>(block_num % 4);
+                Bytes storage_key{block_key};
+                storage_key.append(db::storage_prefix(address.bytes, kDefaultIncarnation));
+                const Bytes previous_value(1, static_cast<uint8_t>(block_num));
+                storage_changes.upsert(db::to_slice(storage_key),
+                                       db::to_slice(db::storage_change_value(location, previous_value,
+                                                                             changeset_format)));
+            }
+        }
+        db::stages::write_stage_progress(txn, db::stages::kExecutionKey, kBlocks);
+        db::stages::write_stage_progress(txn, db::stages::kHashStateKey, kBlocks);
+    }};
+
+    const auto dump{[](mdbx::txn& txn) {
+        std::vector<std::pair<Bytes, Bytes>> records;
+        for (const auto& table : {db::table::kHashedAccounts, db::table::kHashedStorage}) {
+            auto cursor{db::open_cursor(txn, table)};
+            for (auto data{cursor.to_first(false)}; data.done; data = cursor.to_next(false)) {
+                records.emplace_back(db::from_slice(data.key), db::from_slice(data.value));
+            }
+        }
+        return records;
+    }};
+
+    // Change sets committed beforehand are read on parallel threads, uncommitted ones on the calling thread only
+    const auto unwind{[&](bool committed) {
+        TemporaryDirectory temp_dir{};
+        NodeSettings node_settings{};
+        node_settings.data_directory = std::make_unique<DataDirectory>(temp_dir.path());
+        node_settings.data_directory->deploy();
+        node_settings.chaindata_env_config.path = node_settings.data_directory->chaindata().path().string();
+        node_settings.chaindata_env_config.inmemory = true;
+        node_settings.chaindata_env_config.create = true;
+        auto env{db::open_env(node_settings.chaindata_env_config)};
+
+        auto external_txn{env.start_write()};
+        populate(external_txn);
+        std::unique_ptr<db::RWTxn> txn;
+        if (committed) {
+            external_txn.commit();
+            txn = std::make_unique<db::RWTxn>(env);
+        } else {
+            txn = std::make_unique<db::RWTxn>(external_txn);
+        }
+
+        stagedsync::HashState stage{&node_settings};
+        REQUIRE(stage.unwind(*txn, kUnwindTo) == stagedsync::StageResult::kSuccess);
+        CHECK(db::stages::read_stage_progress(**txn, db::stages::kHashStateKey) == kUnwindTo);
+        return dump(**txn);
+    }};
+
+    const auto sequential{unwind(/*committed=*/false)};
+    CHECK(sequential.size() > 16);  // 16 accounts and their locations
+    CHECK(unwind(/*committed=*/true) == sequential);
+}
@@ -22,6 +22,18 @@ namespace silkworm::stagedsync {
 
 BlockNum IStage::get_progress(db::RWTxn& txn) { return db::stages::read_stage_progress(*txn, stage_name_); }
 
+// Stages not splitting their forward do all the work while loading
+StageResult IStage::extract_forward(mdbx::txn&) { return StageResult::kSuccess; }
+
+boost::asio::awaitable<StageResult> IStage::async_extract_forward(mdbx::env env, TaskScheduler& scheduler) {
+    co_return co_await async_run(scheduler, [this, env]() mutable {
+        auto ro_txn{env.start_read()};
+        return extract_forward(ro_txn);
+    });
+}
+
+StageResult IStage::load_forward(db::RWTxn& txn) { return forward(txn); }
+
 void IStage::check_block_sequence(BlockNum actual, BlockNum expected) {
     if (actual != expected) {
         const std::string what{"Bad block sequence : expected " + std::to_string(expected) + " got " +
@@ -30,4 +42,13 @@ void IStage::check_block_sequence(BlockNum actual, BlockNum expected) {
     }
 }
 
+std::filesystem::path IStage::checkpoint_manifest_path() const {
+    return node_settings_->data_directory->checkpoints().path() / (std::string(stage_name_) + ".manifest");
+}
+
+void IStage::drop_checkpoint(db::RWTxn& txn) const {
+    db::stages::clear_stage_checkpoint(*txn, stage_name_);
+    etl::Collector::discard(checkpoint_manifest_path());
+}
+
 }  // namespace silkworm::stagedsync
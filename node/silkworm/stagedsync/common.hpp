@@ -18,11 +18,13 @@
 
 #include <cstdint>
 #include <exception>
+#include <filesystem>
 
 #include <magic_enum.hpp>
 
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/settings.hpp>
+#include <silkworm/concurrency/async_task.hpp>
 #include <silkworm/concurrency/stoppable.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/etl/collector.hpp>
@@ -81,6 +83,10 @@ class IStage : public Stoppable {
         Unwind,   // Executing Unwind
         Prune,    // Executing Prune
     };
+    //! \brief Entries loaded in between two checkpoints of a resumable forward (see db::stages::StageCheckpoint):
+    //! forwards loading fewer entries are not worth checkpointing
+    static constexpr size_t kCheckpointInterval{5'000'000};
+
     explicit IStage(const char* stage_name, NodeSettings* node_settings)
         : stage_name_{stage_name}, node_settings_{node_settings} {};
     virtual ~IStage() = default;
@@ -107,6 +113,33 @@ class IStage : public Stoppable {
     //! \brief Returns the actual progress recorded into db
     BlockNum get_progress(db::RWTxn& txn);
 
+    //! \brief Returns the key of the stage whose output this stage reads when its forward can be split into
+    //! extract_forward and load_forward, nullptr otherwise
+    //! \remarks Stages returning a source can be forwarded concurrently once their source has run: they MUST only
+    //! read data committed by previous stages and MUST write tables no other stage touches
+    [[nodiscard]] virtual const char* concurrent_source() const { return nullptr; }
+
+    //! \brief Returns the key of the stage whose progress bounds the forward of this stage (i.e. its input), nullptr
+    //! when unknown
+    //! \remarks Forward can be skipped whenever the source has not progressed beyond this stage
+    [[nodiscard]] virtual const char* input_source() const { return concurrent_source(); }
+
+    //! \brief First phase of forward: reads source data and collects what has to be written
+    //! \param [in] txn : A read-only (or read-write) db transaction
+    //! \remarks Invoked on a worker thread concurrently with other stages: MUST NOT write anything to db
+    [[nodiscard]] virtual StageResult extract_forward(mdbx::txn& txn);
+
+    //! \brief Asynchronous extract_forward: the blocking parts (db reads, ETL flushes...) are run on the scheduler
+    //! while the coroutine is suspended, so that one thread can drive all the stages extracting concurrently
+    //! \param [in] env : The environment to open read-only transactions from (never bound to a thread)
+    //! \remarks The default runs extract_forward on a read-only transaction as a whole
+    [[nodiscard]] virtual boost::asio::awaitable<StageResult> async_extract_forward(mdbx::env env,
+                                                                                   TaskScheduler& scheduler);
+
+    //! \brief Second phase of forward: writes what extract_forward has collected
+    //! \param [in] txn : A db transaction holder
+    [[nodiscard]] virtual StageResult load_forward(db::RWTxn& txn);
+
     //! \brief This function implementation MUST be thread safe as is called asynchronously from ASIO thread
     [[nodiscard]] virtual std::vector<std::string> get_log_progress() = 0;
 
@@ -123,6 +156,12 @@ class IStage : public Stoppable {
 
     //! \brief Throws if actual block != expected block
     static void check_block_sequence(BlockNum actual, BlockNum expected);
+
+    //! \brief Returns the manifest of the etl files persisted by a resumable forward (see etl::Collector::persist)
+    [[nodiscard]] std::filesystem::path checkpoint_manifest_path() const;
+
+    //! \brief Removes the checkpoint (if any) of this stage along with its persisted etl files
+    void drop_checkpoint(db::RWTxn& txn) const;
 };
 
 }  // namespace silkworm::stagedsync
@@ -0,0 +1,208 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pruner.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::stagedsync {
+
+enum class PruneLayout {
+    kBlockKeyed,  // Keys are prefixed by block number
+    kIndex64,     // Bitmaps of 64-bit block numbers chunked under suffixed keys
+    kIndex32,     // Bitmaps of 32-bit block numbers chunked under suffixed keys
+    kTxLookup,    // Values are compact block numbers
+};
+
+struct PruneTarget {
+    const char* stage_key;                                       // The stage writing the table
+    db::MapConfig table;                                         // The pruned table
+    PruneLayout layout;                                          // How to tell the block of a record
+    const db::BlockAmount& (db::PruneMode::*threshold)() const;  // The prune mode setting applying to the table
+    std::vector<const char*> consumers;                          // Later stages reading the table
+};
+
+// Tables of the same stage are adjacent
+static const std::vector<PruneTarget> kPruneTargets{
+    {db::stages::kExecutionKey, db::table::kAccountChangeSet, PruneLayout::kBlockKeyed, &db::PruneMode::history,
+     {db::stages::kHashStateKey, db::stages::kAccountHistoryIndexKey, db::stages::kStorageHistoryIndexKey}},
+    {db::stages::kExecutionKey, db::table::kStorageChangeSet, PruneLayout::kBlockKeyed, &db::PruneMode::history,
+     {db::stages::kHashStateKey, db::stages::kAccountHistoryIndexKey, db::stages::kStorageHistoryIndexKey}},
+    {db::stages::kExecutionKey, db::table::kBlockReceipts, PruneLayout::kBlockKeyed, &db::PruneMode::receipts, {}},
+    {db::stages::kExecutionKey, db::table::kLogs, PruneLayout::kBlockKeyed, &db::PruneMode::receipts,
+     {db::stages::kLogIndexKey}},
+    {db::stages::kAccountHistoryIndexKey, db::table::kAccountHistory, PruneLayout::kIndex64, &db::PruneMode::history,
+     {}},
+    {db::stages::kStorageHistoryIndexKey, db::table::kStorageHistory, PruneLayout::kIndex64, &db::PruneMode::history,
+     {}},
+    {db::stages::kLogIndexKey, db::table::kLogTopicIndex, PruneLayout::kIndex32, &db::PruneMode::receipts, {}},
+    {db::stages::kLogIndexKey, db::table::kLogAddressIndex, PruneLayout::kIndex32, &db::PruneMode::receipts, {}},
+    {db::stages::kTxLookupKey, db::table::kTxLookup, PruneLayout::kTxLookup, &db::PruneMode::tx_index, {}},
+};
+
+//! \brief Erases records of blocks below prune_from from a table keyed by block number, visiting at most max_records
+//! \return Where to resume from (always the first record), or std::nullopt when done
+static std::optional<Bytes> prune_block_keyed(mdbx::cursor& table, BlockNum prune_from, size_t max_records) {
+    size_t visited{0};
+    for (auto data{table.to_first(/*throw_notfound=*/false)}; data; data = table.to_next(/*throw_notfound=*/false)) {
+        if (endian::load_big_u64(static_cast<const uint8_t*>(data.key.data())) >= prune_from) {
+            return std::nullopt;
+        }
+        if (visited >= max_records) {
+            return Bytes{};
+        }
+        visited += table.count_multivalue();
+        table.erase(/*whole_multivalue=*/true);
+    }
+    return std::nullopt;
+}
+
+//! \brief Erases lookups of transactions of blocks below prune_from, visiting at most max_records in key order from
+//! resume_key (from the first record when empty)
+//! \return Where to resume from, or std::nullopt when done
+static std::optional<Bytes> prune_tx_lookup(mdbx::cursor& table, ByteView resume_key, BlockNum prune_from,
+                                            size_t max_records) {
+    auto data{resume_key.empty() ? table.to_first(/*throw_notfound=*/false)
+                                 : table.lower_bound(db::to_slice(resume_key), /*throw_notfound=*/false)};
+    for (size_t visited{0}; data; data = table.to_next(/*throw_notfound=*/false), ++visited) {
+        if (visited == max_records) {
+            return Bytes{db::from_slice(data.key)};
+        }
+        BlockNum block_num{0};
+        if (endian::from_big_compact(db::from_slice(data.value), block_num) != DecodingResult::kOk) {
+            throw std::runtime_error("Invalid block number in " + std::string(db::table::kTxLookup.name));
+        }
+        if (block_num < prune_from) {
+            table.erase(/*whole_multivalue=*/false);
+        }
+    }
+    return std::nullopt;
+}
+
+Pruner::Pruner(NodeSettings* node_settings, mdbx::env* chaindata_env, size_t chunk_size)
+    : Worker("Pruner"), node_settings_{node_settings}, chaindata_env_{chaindata_env}, chunk_size_{chunk_size} {}
+
+Pruner::~Pruner() { stop(/*wait=*/true); }
+
+bool Pruner::required(const db::PruneMode& prune_mode) {
+    return std::any_of(kPruneTargets.begin(), kPruneTargets.end(),
+                       [&prune_mode](const auto& target) { return (prune_mode.*target.threshold)().enabled(); });
+}
+
+void Pruner::resume() {
+    paused_ = false;
+    kick();
+}
+
+void Pruner::stop(bool wait) {
+    paused_ = true;  // Stops at the end of the chunk in progress
+    Worker::stop(wait);
+}
+
+void Pruner::work() {
+    while (wait_for_kick()) {
+        try {
+            while (!paused_ && !is_stopping() && prune_chunk()) {
+            }
+        } catch (const std::exception& ex) {
+            // Data of the failed chunk is left in place: next pass starts over
+            log::Error("Pruner", {"exception", std::string(ex.what())});
+            tasks_.clear();
+        }
+    }
+}
+
+bool Pruner::start_pass() {
+    auto txn{chaindata_env_->start_read()};
+    for (size_t i{0}; i < kPruneTargets.size(); ++i) {
+        const auto& target{kPruneTargets[i]};
+        const auto& threshold{((*node_settings_->prune_mode).*target.threshold)()};
+        if (!threshold.enabled()) {
+            continue;
+        }
+        const BlockNum stage_progress{db::stages::read_stage_progress(txn, target.stage_key)};
+        if (db::stages::read_stage_prune_progress(txn, target.stage_key) >= stage_progress) {
+            continue;  // Nothing to prune since last pass
+        }
+        // Data still to be processed by later stages must not be pruned
+        BlockNum head{stage_progress};
+        for (const char* consumer : target.consumers) {
+            head = std::min(head, db::stages::read_stage_progress(txn, consumer));
+        }
+        if (const BlockNum prune_from{threshold.value_from_head(head)}; prune_from) {
+            tasks_.push_back({i, prune_from, stage_progress, {}});
+        }
+    }
+    return !tasks_.empty();
+}
+
+bool Pruner::prune_chunk() {
+    if (tasks_.empty() && !start_pass()) {
+        return false;
+    }
+
+    auto& task{tasks_.front()};
+    const auto& target{kPruneTargets[task.target]};
+    auto txn{chaindata_env_->start_write()};
+    auto table{db::open_cursor(txn, target.table)};
+    std::optional<Bytes> resume_key;
+    switch (target.layout) {
+        case PruneLayout::kBlockKeyed:
+            resume_key = prune_block_keyed(table, task.prune_from, chunk_size_);
+            break;
+        case PruneLayout::kIndex64:
+            resume_key = db::bitmap::prune(table, task.resume_key, task.prune_from, chunk_size_);
+            break;
+        case PruneLayout::kIndex32: {
+            const auto prune_from{std::min<BlockNum>(task.prune_from, std::numeric_limits<uint32_t>::max())};
+            resume_key = db::bitmap::prune32(table, task.resume_key, static_cast<uint32_t>(prune_from), chunk_size_);
+            break;
+        }
+        case PruneLayout::kTxLookup:
+            resume_key = prune_tx_lookup(table, task.resume_key, task.prune_from, chunk_size_);
+            break;
+    }
+    table.close();
+
+    const bool stage_done{!resume_key && (tasks_.size() == 1 ||
+                                          std::strcmp(kPruneTargets[tasks_[1].target].stage_key, target.stage_key))};
+    if (stage_done) {
+        db::stages::write_stage_prune_progress(txn, target.stage_key, task.stage_progress);
+    }
+    txn.commit();
+
+    if (resume_key) {
+        task.resume_key = std::move(*resume_key);
+    } else {
+        log::Trace("Pruned", {"table", std::string(target.table.name), "below", std::to_string(task.prune_from)});
+        tasks_.pop_front();
+    }
+    return true;
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+
+#include <silkworm/common/settings.hpp>
+#include <silkworm/concurrency/worker.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Prunes data older than required by db::PruneMode on a dedicated thread, so that erasing millions of records
+//! never holds the transaction of a sync cycle.
+//! Each table is walked in key order by chunks of bounded size, each one committed in its own write transaction: as
+//! writers are serialized, a cycle starting meanwhile waits at most for the chunk in progress.
+//! \remarks A pass prunes up to the thresholds computed at its start, then records the prune progress of each stage
+//! whose tables have been pruned
+class Pruner final : public Worker {
+  public:
+    static constexpr size_t kDefaultChunkSize{10'000};  // Max records visited by each commit
+
+    explicit Pruner(NodeSettings* node_settings, mdbx::env* chaindata_env, size_t chunk_size = kDefaultChunkSize);
+    ~Pruner() override;
+
+    //! \brief Whether prune mode requires any table to be pruned at all
+    [[nodiscard]] static bool required(const db::PruneMode& prune_mode);
+
+    //! \brief Suspends pruning past the chunk in progress (if any), e.g. while a sync cycle runs
+    void pause() { paused_ = true; }
+
+    //! \brief Resumes pruning from where it was suspended, or starts a new pass on newly committed progress
+    void resume();
+
+    //! \brief Prunes a chunk of a table in its own write transaction, starting a new pass if none is in progress
+    //! \return False when there is nothing to prune
+    //! \remarks Not to be called while the pruner thread runs
+    bool prune_chunk();
+
+    void stop(bool wait = false) final;
+
+  private:
+    struct Task {
+        size_t target{0};            // Index of the pruned table amongst targets
+        BlockNum prune_from{0};      // Records of blocks below are erased
+        BlockNum stage_progress{0};  // Recorded as prune progress of the stage once all its tables are done
+        Bytes resume_key{};          // Where next chunk starts from (empty = from the first record)
+    };
+
+    void work() final;
+    bool start_pass();  // Queues tasks of the tables due for pruning, if any
+
+    NodeSettings* node_settings_;
+    mdbx::env* chaindata_env_;
+    const size_t chunk_size_;
+    std::atomic_bool paused_{false};
+    std::deque<Task> tasks_{};  // Pending tasks of current pass
+};
+
+}  // namespace silkworm::stagedsync
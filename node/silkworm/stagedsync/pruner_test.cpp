@@ -0,0 +1,87 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pruner.hpp"
+
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("Pruner") {
+    test::Context context;
+    NodeSettings node_settings{};
+    node_settings.prune_mode = db::parse_prune_mode("", std::nullopt, /*olderReceipts=*/10, std::nullopt, std::nullopt,
+                                                    std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                                                    std::nullopt, std::nullopt);
+    REQUIRE(Pruner::required(*node_settings.prune_mode));
+
+    auto& txn{context.txn()};
+    auto receipts{db::open_cursor(txn, db::table::kBlockReceipts)};
+    for (BlockNum block_num{1}; block_num <= 100; ++block_num) {
+        receipts.upsert(db::to_slice(db::block_key(block_num)), db::to_slice(Bytes{0x80}));
+    }
+    receipts.close();
+
+    const Bytes address{*from_hex("0x0000000000000000000000000000000000000001")};
+    Bytes chunk_key(address.size() + sizeof(uint32_t), '\0');
+    std::memcpy(chunk_key.data(), address.data(), address.size());
+    endian::store_big_u32(&chunk_key[address.size()], UINT32_MAX);
+    const auto chunk{roaring::Roaring::bitmapOf(3, 5, 50, 95)};
+    Bytes chunk_bytes(chunk.getSizeInBytes(), '\0');
+    chunk.write(byte_ptr_cast(chunk_bytes.data()));
+    auto log_address_index{db::open_cursor(txn, db::table::kLogAddressIndex)};
+    log_address_index.upsert(db::to_slice(chunk_key), db::to_slice(chunk_bytes));
+    log_address_index.close();
+
+    db::stages::write_stage_progress(txn, db::stages::kExecutionKey, 100);
+    db::stages::write_stage_progress(txn, db::stages::kLogIndexKey, 100);
+    context.commit_txn();
+
+    Pruner pruner{&node_settings, &context.env(), /*chunk_size=*/7};
+    size_t chunks{0};
+    while (pruner.prune_chunk()) {
+        ++chunks;
+    }
+    CHECK(chunks > 2);  // Receipts of 89 blocks do not fit a single chunk
+
+    auto ro_txn{context.env().start_read()};
+    auto pruned_receipts{db::open_cursor(ro_txn, db::table::kBlockReceipts)};
+    const auto first{pruned_receipts.to_first(/*throw_notfound=*/false)};
+    REQUIRE(first);
+    CHECK(endian::load_big_u64(static_cast<const uint8_t*>(first.key.data())) == 90);
+    CHECK(ro_txn.get_map_stat(pruned_receipts.map()).ms_entries == 11);
+
+    auto pruned_index{db::open_cursor(ro_txn, db::table::kLogAddressIndex)};
+    CHECK(db::bitmap::get(pruned_index, address, 0, UINT32_MAX) == roaring::Roaring::bitmapOf(1, 95));
+
+    CHECK(db::stages::read_stage_prune_progress(ro_txn, db::stages::kExecutionKey) == 100);
+    CHECK(db::stages::read_stage_prune_progress(ro_txn, db::stages::kLogIndexKey) == 100);
+
+    // Nothing to prune since last pass
+    CHECK_FALSE(pruner.prune_chunk());
+}
+
+}  // namespace silkworm::stagedsync
@@ -16,18 +16,80 @@
 
 #include "stage_blockhashes.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 
 #include <silkworm/common/as_range.hpp>
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/concurrency/task_scheduler.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/tables.hpp>
 #include <silkworm/etl/collector.hpp>
 
 namespace silkworm::stagedsync {
 
+// A HeaderNumber record: header hash (key) followed by block number (value, big endian)
+using HashRecord = std::array<uint8_t, kHashLength + sizeof(BlockNum)>;
+
+static bool hash_less(const HashRecord& lhs, const HashRecord& rhs) {
+    return std::memcmp(lhs.data(), rhs.data(), kHashLength) < 0;
+}
+
+//! \brief Sorts by hash the records of all buffers into a single sequence: a radix pass scatters records into 256
+//! buckets by their first byte, then buckets are sorted concurrently
+//! \remarks Hashes are uniformly distributed, hence buckets are evenly sized
+static std::vector<HashRecord> sort_hash_records(std::vector<std::vector<HashRecord>>& buffers,
+                                                 TaskScheduler& scheduler) {
+    static constexpr size_t kNumBuckets{256};
+
+    // Each buffer owns a disjoint slot within each bucket: scattering needs no synchronization
+    std::vector<std::array<size_t, kNumBuckets>> offsets(buffers.size());
+    scheduler.parallel_for(size_t{0}, buffers.size(), [&](size_t begin, size_t end) {
+        for (size_t i{begin}; i < end; ++i) {
+            offsets[i].fill(0);
+            for (const auto& record : buffers[i]) {
+                ++offsets[i][record[0]];
+            }
+        }
+    });
+    std::array<size_t, kNumBuckets + 1> bucket_begin{};
+    size_t position{0};
+    for (size_t bucket{0}; bucket < kNumBuckets; ++bucket) {
+        bucket_begin[bucket] = position;
+        for (auto& buffer_offsets : offsets) {
+            const size_t count{buffer_offsets[bucket]};
+            buffer_offsets[bucket] = position;
+            position += count;
+        }
+    }
+    bucket_begin[kNumBuckets] = position;
+
+    std::vector<HashRecord> sorted(position);
+    scheduler.parallel_for(size_t{0}, buffers.size(), [&](size_t begin, size_t end) {
+        for (size_t i{begin}; i < end; ++i) {
+            for (const auto& record : buffers[i]) {
+                sorted[offsets[i][record[0]]++] = record;
+            }
+            std::vector<HashRecord>().swap(buffers[i]);  // Release memory as soon as possible
+        }
+    });
+    scheduler.parallel_for(size_t{0}, kNumBuckets, [&](size_t begin, size_t end) {
+        for (size_t bucket{begin}; bucket < end; ++bucket) {
+            const auto first{sorted.begin() + static_cast<std::ptrdiff_t>(bucket_begin[bucket])};
+            const auto last{sorted.begin() + static_cast<std::ptrdiff_t>(bucket_begin[bucket + 1])};
+            std::sort(first, last, hash_less);
+        }
+    });
+    return sorted;
+}
+
 StageResult BlockHashes::forward(db::RWTxn& txn) {
     /*
      * Creates HeaderNumber index by transforming
@@ -61,12 +123,22 @@ StageResult BlockHashes::forward(db::RWTxn& txn) {
                   {"from", std::to_string(expected_block_number), "to", std::to_string(headers_stage_progress)});
     }
 
+    // Read-only snapshots only see committed data: unless this runs within an external transaction, commit so that
+    // extraction can spread over parallel snapshots
+    if (!txn.is_external() && headers_count >= kMinParallelBlocks && std::thread::hardware_concurrency() > 1) {
+        txn.force_commit();
+        forward_parallel(txn, expected_block_number, headers_stage_progress);
+        return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
+    }
+
     collector_ =
         std::make_unique<etl::Collector>(node_settings_->data_directory->etl().path(), node_settings_->etl_buffer_size);
     auto header_key{db::block_key(expected_block_number)};
     auto source{db::open_cursor(*txn, db::table::kCanonicalHashes)};
     auto data{source.find(db::to_slice(header_key), /*throw_notfound=*/false)};
+    db::ScanReadAhead read_ahead;
     while (data.done) {
+        read_ahead.advise(data.key);
         reached_block_num_ = endian::load_big_u64(static_cast<uint8_t*>(data.key.data()));
         SILKWORM_ASSERT(reached_block_num_ == expected_block_number);
         SILKWORM_ASSERT(data.value.length() == kHashLength);
@@ -103,6 +175,74 @@ StageResult BlockHashes::forward(db::RWTxn& txn) {
     return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
 }
 
+void BlockHashes::forward_parallel(db::RWTxn& txn, BlockNum from, BlockNum to) {
+    static constexpr size_t kRangesPerThread{4};  // Headers are evenly sized: few ranges suffice to balance threads
+
+    const size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};
+
+    // Records of all headers in a batch are held in memory: batches are capped to the ETL buffer size
+    const BlockNum batch_blocks{std::max<BlockNum>(node_settings_->etl_buffer_size / sizeof(HashRecord), 1)};
+    for (BlockNum batch_from{from}; batch_from <= to && !is_stopping(); batch_from += batch_blocks) {
+        const BlockNum batch_to{std::min(to, batch_from + batch_blocks - 1)};
+        current_phase_ = 1;
+
+        std::vector<std::vector<HashRecord>> buffers(num_threads);
+        db::parallel_for_block_ranges(
+            txn.env(), batch_from, batch_to, num_threads, kRangesPerThread,
+            [&](size_t worker, mdbx::txn& ro_txn, BlockNum range_from, BlockNum range_to) {
+                auto& buffer{buffers[worker]};
+                auto source{db::open_cursor(ro_txn, db::table::kCanonicalHashes)};
+                const auto start_key{db::block_key(range_from)};
+                BlockNum expected_block_num{range_from};
+                for (auto data{source.find(db::to_slice(start_key), /*throw_notfound=*/false)};
+                     data && expected_block_num <= range_to; data = source.to_next(/*throw_notfound=*/false)) {
+                    const BlockNum block_num{endian::load_big_u64(static_cast<uint8_t*>(data.key.data()))};
+                    if (block_num != expected_block_num) {
+                        break;
+                    }
+                    SILKWORM_ASSERT(data.value.length() == kHashLength);
+                    auto& record{buffer.emplace_back()};
+                    std::memcpy(record.data(), data.value.data(), kHashLength);
+                    std::memcpy(&record[kHashLength], data.key.data(), sizeof(BlockNum));
+                    if (!(++expected_block_num % 1024) && is_stopping()) {
+                        return;
+                    }
+                }
+                if (expected_block_num != range_to + 1 && !is_stopping()) {
+                    throw std::runtime_error("Unable to read all headers. Missing block " +
+                                             std::to_string(expected_block_num));
+                }
+            });
+        if (is_stopping()) {
+            return;
+        }
+        reached_block_num_ = batch_to;
+
+        current_phase_ = 2;
+        const auto records{sort_hash_records(buffers, TaskScheduler::shared())};
+
+        auto target{db::open_cursor(*txn, db::table::kHeaderNumbers)};
+        if (txn->get_map_stat(target.map()).ms_entries) {
+            // Sorted upserts touch each page once
+            for (const auto& record : records) {
+                target.upsert(db::to_slice(ByteView{record.data(), kHashLength}),
+                              db::to_slice(ByteView{&record[kHashLength], sizeof(BlockNum)}));
+            }
+            target.close();
+        } else {
+            // Bulk loading may commit along the way: should we stop halfway, next run upserts the same records again
+            target.close();
+            db::BulkLoader loader{txn, db::table::kHeaderNumbers};
+            for (const auto& record : records) {
+                loader.append(ByteView{record.data(), kHashLength}, ByteView{&record[kHashLength], sizeof(BlockNum)});
+            }
+        }
+
+        db::stages::write_stage_progress(*txn, stage_name_, batch_to);
+        txn.commit();
+    }
+}
+
 StageResult BlockHashes::unwind(db::RWTxn& txn, BlockNum to) {
     /*
      * Unwinds HeaderNumber index by
@@ -22,15 +22,22 @@ namespace silkworm::stagedsync {
 
 class BlockHashes final : public IStage {
   public:
+    static constexpr BlockNum kMinParallelBlocks{10'000};  // Fewer headers are processed serially
+
     explicit BlockHashes(NodeSettings* node_settings) : IStage(db::stages::kBlockHashesKey, node_settings){};
     ~BlockHashes() override = default;
 
     StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* input_source() const final { return db::stages::kHeadersKey; }
     StageResult unwind(db::RWTxn& txn, BlockNum to) final;
     StageResult prune(db::RWTxn& txn) final;
     std::vector<std::string> get_log_progress() final;
 
   private:
+    //! \brief Forwards headers in range [from, to] on parallel snapshots of committed data into in-memory fixed-width
+    //! records, sorted in parallel then loaded in one pass (append mode when HeaderNumbers is empty)
+    void forward_parallel(db::RWTxn& txn, BlockNum from, BlockNum to);
+
     std::unique_ptr<etl::Collector> collector_{nullptr};
 
     /* Stats */
@@ -16,15 +16,26 @@
 
 #include "stage_execution.hpp"
 
-#include <span>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <limits>
 #include <string>
+#include <thread>
+
+#include <evmc/instructions.h>
 
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/memory.hpp>
+#include <silkworm/common/memory_governor.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/buffer.hpp>
+#include <silkworm/db/changeset_walk.hpp>
+#include <silkworm/db/state_snapshot.hpp>
 #include <silkworm/execution/processor.hpp>
 
 namespace silkworm::stagedsync {
@@ -38,7 +49,6 @@ StageResult Execution::forward(db::RWTxn& txn) {
         return StageResult::kUnknownConsensusEngine;
     }
 
-    StopWatch commit_stopwatch;
     // Check stage boundaries from previous execution and previous stage execution
     auto previous_progress{get_progress(txn)};
     auto headers_stage_progress{db::stages::read_stage_progress(*txn, db::stages::kHeadersKey)};
@@ -71,12 +81,6 @@ StageResult Execution::forward(db::RWTxn& txn) {
     lap_time_ = std::chrono::steady_clock::now();
     progress_lock.unlock();
 
-    block_num_ = previous_progress + 1;
-    BlockNum max_block_num{bodies_stage_progress};
-    if (bodies_stage_progress - previous_progress > 16) {
-        log::Info("Begin Execution", {"from", std::to_string(block_num_), "to", std::to_string(bodies_stage_progress)});
-    }
-
     // Determine pruning thresholds on behalf of current db pruning mode and verify next stage does not need
     // prune-able data
     BlockNum prune_history{node_settings_->prune_mode->history().value_from_head(headers_stage_progress)};
@@ -86,31 +90,275 @@ StageResult Execution::forward(db::RWTxn& txn) {
         prune_receipts = std::min(prune_receipts, hashstate_stage_progress - 1);
     }
 
-    static constexpr size_t kCacheSize{5'000};
-    BaselineAnalysisCache analysis_cache{kCacheSize};
-    ObjectPool<EvmoneExecutionState> state_pool;
+    // On an empty db the state up to a trusted height may be imported instead of executed
+    if (!previous_progress && node_settings_->execution_import_height &&
+        !node_settings_->execution_import_chaindata.empty()) {
+        const BlockNum import_height{node_settings_->execution_import_height};
+        if (senders_stage_progress < import_height) {
+            log::Info("Execution waiting for blocks to import state",
+                      {"block", std::to_string(import_height), "senders", std::to_string(senders_stage_progress)});
+            return StageResult::kSuccess;
+        }
+        try {
+            db::EnvConfig source_config{node_settings_->execution_import_chaindata};
+            source_config.readonly = true;
+            auto source_env{db::open_env(source_config)};
+            auto source_txn{source_env.start_read()};
+            import_state(txn, source_txn, import_height, prune_history, node_settings_);
+        } catch (const std::exception& ex) {
+            log::Error("Unable to import state", {"block", std::to_string(import_height)}) << " " << ex.what();
+            return StageResult::kUnexpectedError;
+        }
+        commit_progress(txn, import_height);
+        previous_progress = import_height;
+    }
+
+    // Or from a state snapshot, which comes with the hashed state and tries hence makes HashState progress as well
+    if (!previous_progress && !node_settings_->execution_import_snapshot.empty()) {
+        BlockNum import_height{0};
+        try {
+            const std::filesystem::path snapshot_dir{node_settings_->execution_import_snapshot};
+            const auto manifest{db::StateSnapshotManifest::read(snapshot_dir)};
+            import_height = manifest.block_number;
+            if (senders_stage_progress < import_height) {
+                log::Info("Execution waiting for blocks to import state snapshot",
+                          {"block", std::to_string(import_height), "senders", std::to_string(senders_stage_progress)});
+                return StageResult::kSuccess;
+            }
+            if (db::read_canonical_header_hash(*txn, import_height) != manifest.block_hash) {
+                throw std::runtime_error("block " + std::to_string(import_height) + " of snapshot is not canonical");
+            }
+            (void)db::import_state_snapshot(txn, snapshot_dir, node_settings_->data_directory->etl().path(),
+                                            std::max(1u, std::thread::hardware_concurrency()));
+            db::stages::write_stage_progress(*txn, db::stages::kHashStateKey, import_height);
+        } catch (const std::exception& ex) {
+            log::Error("Unable to import state snapshot", {"block", std::to_string(import_height)}) << " " << ex.what();
+            return StageResult::kUnexpectedError;
+        }
+        if (import_height) {
+            commit_progress(txn, import_height);
+            previous_progress = import_height;
+            hashstate_stage_progress = import_height;
+        }
+    }
+
+    // HashState picks up the keys changed from here on, unless it lags behind anyway
+    if (changed_keys_) {
+        if (hashstate_stage_progress == previous_progress) {
+            changed_keys_->reset(previous_progress);
+        } else {
+            changed_keys_->invalidate();
+        }
+    }
+
+    block_num_ = previous_progress + 1;
+    BlockNum max_block_num{bodies_stage_progress};
+    if (bodies_stage_progress - previous_progress > 16) {
+        log::Info("Begin Execution", {"from", std::to_string(block_num_), "to", std::to_string(bodies_stage_progress)});
+    }
 
     prefetched_blocks_.clear();
 
+    if (node_settings_->execution_state_root) {
+        try {
+            load_state_root(txn, previous_progress);
+        } catch (const std::exception& ex) {
+            log::Error("Unable to load state", {"block", std::to_string(previous_progress)}) << " " << ex.what();
+            state_root_.reset();
+            return StageResult::kUnexpectedError;
+        }
+    }
+
+    if (node_settings_->execution_state_filter_bits) {
+        load_state_filter(txn, previous_progress);
+    }
+
+    if (node_settings_->execution_state_cache_size) {
+        if (!state_cache_) {
+            state_cache_ = std::make_unique<db::StateCache>(node_settings_->execution_state_cache_size);
+        } else if (state_cache_block_num_ != previous_progress) {
+            state_cache_->clear();
+        }
+        state_cache_block_num_ = previous_progress;
+    }
+
+    // Buffers are flushed when their memory reaches batch size, which must leave room for the rest of the node
+    memory_budget_ = node_settings_->batch_size;
+    if (const auto ram{total_physical_memory()}; ram && memory_budget_ > *ram / 2) {
+        log::Warning("Execution batch size capped", {"batch.size", human_size(memory_budget_), "memory.size",
+                                                     human_size(*ram), "capped.to", human_size(*ram / 2)});
+        memory_budget_ = *ram / 2;
+    }
+
+    // Read blocks ahead on a dedicated thread while executing. This requires previous stages data to be committed
+    // as the reader works on its own transaction: with an external txn we fall back to synchronous reads
+    if (!txn.is_external()) {
+        txn.force_commit();  // Previous stages may have only requested their commits
+        block_prefetcher_ = std::make_unique<BlockPrefetcher>(txn->env());
+        block_prefetcher_->start_range(block_num_, max_block_num);
+
+        // Same for the state touched by upcoming blocks, and the analyses of the contracts they call
+        const auto num_warmup_threads{std::max(2u, std::thread::hardware_concurrency() / 4)};
+        state_warmer_ = std::make_unique<StateWarmer>(txn->env(), num_warmup_threads, StateWarmer::kDefaultLookahead,
+                                                      /*analyze_code=*/true);
+    }
+
     while (!is_stopping() && block_num_ <= max_block_num) {
-        const auto res{execute_batch(txn, max_block_num, analysis_cache, state_pool, prune_history, prune_receipts)};
+        // Each batch commits its own progress, possibly in the course of next batch (see freeze_buffer)
+        const auto res{execute_batch(txn, max_block_num, prune_history, prune_receipts)};
         if (res != StageResult::kSuccess) {
+            state_root_.reset();  // Possibly ahead of what gets written
+            if (state_cache_) {
+                state_cache_->clear();
+            }
+            if (changed_keys_) {
+                changed_keys_->invalidate();
+            }
+            // Blocks in the frozen buffer (if any) are valid unless db itself failed
+            (void)finish_frozen_buffer(txn, /*write=*/res == StageResult::kAborted ||
+                                                res == StageResult::kInvalidBlock);
+            MemoryGovernor::instance().set_usage(MemoryTag::kStateBuffer, 0);
+            state_warmer_.reset();
+            block_prefetcher_.reset();
             return res;
         }
+        block_num_++;
+    }
+    const auto res{finish_frozen_buffer(txn, /*write=*/true)};
+    MemoryGovernor::instance().set_usage(MemoryTag::kStateBuffer, 0);
+    state_warmer_.reset();
+    block_prefetcher_.reset();
+    if (res != StageResult::kSuccess) {
+        state_root_.reset();
+        if (state_cache_) {
+            state_cache_->clear();
+        }
+        if (changed_keys_) {
+            changed_keys_->invalidate();
+        }
+        return res;
+    }
+    return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
+}
+
+void Execution::load_state_root(db::RWTxn& txn, BlockNum block_num) {
+    if (state_root_ && state_root_block_num_ == block_num) {
+        return;
+    }
 
-        // Persist forward and prune progresses
-        db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, block_num_);
-        if (node_settings_->prune_mode->history().enabled() || node_settings_->prune_mode->receipts().enabled()) {
-            db::stages::write_stage_prune_progress(*txn, db::stages::kExecutionKey, block_num_);
+    StopWatch sw{/*auto_start=*/true};
+    state_root_ = std::make_unique<trie::IncrementalStateRoot>();
+    auto plain_state{db::open_cursor(*txn, db::table::kPlainState)};
+    auto data{plain_state.to_first(/*throw_notfound=*/false)};
+    while (data) {
+        const ByteView key{db::from_slice(data.key)};
+        const auto address{to_evmc_address(key)};
+        if (key.length() == kAddressLength) {
+            // Code hash of contracts is not in PlainState
+            state_root_->update_account(address, db::read_account(*txn, address));
+            data = plain_state.to_next(/*throw_notfound=*/false);
+        } else {
+            // Storage locations are duplicates of (address, incarnation)
+            SILKWORM_ASSERT(key.length() == db::kPlainStoragePrefixLength);
+            const uint64_t incarnation{endian::load_big_u64(&key[kAddressLength])};
+            while (data) {
+                const ByteView entry{db::from_slice(data.value)};
+                SILKWORM_ASSERT(entry.length() > kHashLength);
+                state_root_->update_storage(address, incarnation, to_bytes32(entry.substr(0, kHashLength)),
+                                            to_bytes32(entry.substr(kHashLength)));
+                data = plain_state.to_current_next_multi(/*throw_notfound=*/false);
+            }
+            data = plain_state.to_next(/*throw_notfound=*/false);
         }
+    }
+    const auto root{state_root_->root_hash()};
+    state_root_block_num_ = block_num;
 
-        (void)commit_stopwatch.start(/*with_reset=*/true);
-        txn.commit();
-        auto [_, duration]{commit_stopwatch.stop()};
-        log::Info("Commit time", {"batch", StopWatch::format(duration)});
-        block_num_++;
+    auto [_, duration]{sw.stop()};
+    log::Info("Loaded state trie", {"block", std::to_string(block_num), "accounts",
+                                    std::to_string(state_root_->number_of_accounts()), "root", to_hex(root, true),
+                                    "in", StopWatch::format(duration)});
+}
+
+void Execution::load_state_filter(db::RWTxn& txn, BlockNum block_num) {
+    if (state_filter_ && state_filter_block_num_ == block_num && !state_filter_->saturated()) {
+        return;
+    }
+
+    StopWatch sw{/*auto_start=*/true};
+    state_filter_.reset();
+    state_filter_ = std::make_unique<db::StateFilter>(
+        db::StateFilter::build(*txn, node_settings_->execution_state_filter_bits));
+    state_filter_block_num_ = block_num;
+
+    auto [_, duration]{sw.stop()};
+    log::Info("Built state filter", {"block", std::to_string(block_num), "keys", std::to_string(state_filter_->size()),
+                                     "size", human_size(state_filter_->memory_usage()), "in",
+                                     StopWatch::format(duration)});
+}
+
+void Execution::commit_progress(db::RWTxn& txn, BlockNum block_num) {
+    // Persist forward and prune progresses
+    db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, block_num);
+    if (node_settings_->prune_mode->history().enabled() || node_settings_->prune_mode->receipts().enabled()) {
+        db::stages::write_stage_prune_progress(*txn, db::stages::kExecutionKey, block_num);
+    }
+
+    StopWatch commit_stopwatch{/*auto_start=*/true};
+    txn.commit();
+    auto [_, duration]{commit_stopwatch.stop()};
+    log::Info("Commit time", {"batch", StopWatch::format(duration)});
+    if (changed_keys_) {
+        changed_keys_->advance(block_num);
+    }
+
+    // Anything warmed up so far has been read before this commit hence must be read again
+    if (state_warmer_) {
+        state_warmer_->clear();
+        warmups_scheduled_ = 0;
+    }
+}
+
+void Execution::freeze_buffer(std::unique_ptr<db::Buffer> buffer) {
+    SILKWORM_ASSERT(!frozen_buffer_);
+    frozen_buffer_ = std::move(buffer);
+    frozen_buffer_block_num_ = block_num_;
+    frozen_buffer_memory_usage_ = frozen_buffer_->memory_usage();
+    frozen_buffer_prepared_ =
+        std::async(std::launch::async, [buffer = frozen_buffer_.get()] { buffer->prepare_state_write(); });
+}
+
+void Execution::flush_frozen_buffer(db::RWTxn& txn, db::Buffer* child) {
+    if (frozen_buffer_prepared_.valid()) {
+        frozen_buffer_prepared_.get();
+    }
+    frozen_buffer_->write_to_db();
+    commit_progress(txn, frozen_buffer_block_num_);
+    if (child) {
+        child->detach_parent();  // Contents of frozen buffer are in db now
+    }
+    frozen_buffer_.reset();
+}
+
+StageResult Execution::finish_frozen_buffer(db::RWTxn& txn, bool write) {
+    if (!frozen_buffer_) {
+        return StageResult::kSuccess;
+    }
+    try {
+        if (write) {
+            flush_frozen_buffer(txn, /*child=*/nullptr);
+        } else {
+            if (frozen_buffer_prepared_.valid()) {
+                frozen_buffer_prepared_.wait();
+            }
+            frozen_buffer_.reset();
+        }
+        return StageResult::kSuccess;
+    } catch (const mdbx::exception& ex) {
+        log::Error("DB Error", {"block", std::to_string(frozen_buffer_block_num_)}) << " " << ex.what();
+        frozen_buffer_.reset();
+        return StageResult::kDbError;
     }
-    return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
 }
 
 void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const BlockNum to) {
@@ -121,34 +369,19 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
 
     assert(prefetched_blocks_.empty());
 
-    const size_t count{std::min(static_cast<size_t>(to - from + 1), kMaxPrefetchedBlocks)};
-    size_t num_read{0};
-
-    db::Cursor hashes_table(txn, db::table::kCanonicalHashes);
-    auto key{db::block_key(from)};
-    if (hashes_table.seek(db::to_slice(key))) {
-        BlockNum block_num{from};
-        db::WalkFunc walk_function{[&](mdbx::cursor&, mdbx::cursor::move_result& data) {
-            BlockNum reached_block_num{endian::load_big_u64(static_cast<const uint8_t*>(data.key.data()))};
-            if (reached_block_num != block_num) {
-                throw std::runtime_error("Bad canonical header sequence: expected " + std::to_string(block_num) +
-                                         " got " + std::to_string(reached_block_num));
-            }
-            SILKWORM_ASSERT(data.value.length() == kHashLength);
-            const auto hash_ptr{static_cast<const uint8_t*>(data.value.data())};
-            prefetched_blocks_.push_back();
-            if (!db::read_block(*txn, std::span<const uint8_t, kHashLength>{hash_ptr, kHashLength}, block_num,
-                                /*read_senders=*/true, prefetched_blocks_.back())) {
-                throw std::runtime_error("Unable to read block " + std::to_string(block_num));
-            }
-            ++block_num;
-            return true;
-        }};
-        num_read = db::cursor_for_count(hashes_table, walk_function, count);
+    std::vector<Block> blocks;
+    if (block_prefetcher_) {
+        if (!block_prefetcher_->pop_window(blocks)) {
+            throw std::runtime_error("Missing block " + std::to_string(from));
+        }
+    } else {
+        const size_t count{std::min(static_cast<size_t>(to - from + 1), kMaxPrefetchedBlocks)};
+        blocks.reserve(count);
+        read_canonical_blocks(*txn, from, count, blocks);
     }
-
-    if (num_read != count) {
-        throw std::runtime_error("Missing block " + std::to_string(from + num_read));
+    const size_t num_read{blocks.size()};
+    for (auto& block : blocks) {
+        prefetched_blocks_.push_back(std::move(block));
     }
 
     if (sw) {
@@ -157,18 +390,29 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
     }
 }
 
-StageResult Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, BaselineAnalysisCache& analysis_cache,
-                                     ObjectPool<EvmoneExecutionState>& state_pool, BlockNum prune_history_threshold,
+void Execution::warm_up_state(const db::Buffer& buffer) {
+    state_warmer_->apply(buffer, &analysis_cache_);
+    while (warmups_scheduled_ < prefetched_blocks_.size() && state_warmer_->pending() < state_warmer_->lookahead()) {
+        state_warmer_->schedule(prefetched_blocks_[warmups_scheduled_++]);
+    }
+}
+
+StageResult Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, BlockNum prune_history_threshold,
                                      BlockNum prune_receipts_threshold) {
     try {
-        db::Buffer buffer(*txn, prune_history_threshold);
+        // Reads through the buffer of previous batch until the latter has been written
+        auto buffer{std::make_unique<db::Buffer>(*txn, prune_history_threshold, /*historical_block=*/std::nullopt,
+                                                 frozen_buffer_.get())};
+        buffer->track_state_root(state_root_.get());
+        buffer->use_state_filter(state_filter_.get());
+        buffer->use_state_cache(state_cache_.get());
+        buffer->record_changed_keys(changed_keys_);
         std::vector<Receipt> receipts;
 
-        // Transform batch_size limit into Ggas
-        size_t gas_max_history_size{node_settings_->batch_size * 1_Kibi / 2};  // 512MB -> 256Ggas roughly
-        size_t gas_max_batch_size{gas_max_history_size * 20};                  // 256Ggas -> 5Tgas roughly
-        size_t gas_history_size{0};
-        size_t gas_batch_size{0};
+        if (!receipt_encoder_) {
+            receipt_encoder_ = std::make_unique<ReceiptEncoder>();
+        }
+        receipt_encoder_->discard();  // Leftovers of an interrupted batch (if any)
 
         {
             std::unique_lock progress_lock(progress_mtx_);
@@ -192,11 +436,33 @@ StageResult Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, Bas
                 return StageResult::kAborted;
             }
 
-            ExecutionProcessor processor(block, *consensus_engine_, buffer, node_settings_->chain_config.value());
-            processor.evm().baseline_analysis_cache = &analysis_cache;
-            processor.evm().state_pool = &state_pool;
+            // Previous batch is written in between blocks as soon as it's ready
+            if (frozen_buffer_ &&
+                frozen_buffer_prepared_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                flush_frozen_buffer(txn, buffer.get());
+            }
+
+            if (state_warmer_) {
+                warm_up_state(*buffer);
+            }
+
+            ExecutionProcessor processor(block, *consensus_engine_, *buffer, node_settings_->chain_config.value(),
+                                         &execution_context_);
+            processor.evm().baseline_analysis_cache = &analysis_cache_;
+            if (node_settings_->precompile_cache_size) {
+                if (!precompile_cache_) {
+                    precompile_cache_ = std::make_unique<PrecompileCache>(node_settings_->precompile_cache_size);
+                }
+                processor.evm().precompile_cache = precompile_cache_.get();
+            }
 
             // TODO(Andrea) Add Tracer
+            if (node_settings_->execution_profile_interval) {
+                if (!sampling_tracer_) {
+                    sampling_tracer_ = std::make_unique<SamplingTracer>(node_settings_->execution_profile_interval);
+                }
+                processor.evm().add_tracer(*sampling_tracer_);
+            }
 
             if (const auto res{processor.execute_and_write_block(receipts)}; res != ValidationResult::kOk) {
                 const auto block_hash_hex{to_hex(block.header.hash().bytes, true)};
@@ -207,31 +473,89 @@ StageResult Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, Bas
                 return StageResult::kInvalidBlock;
             }
 
+            if (state_root_) {
+                if (const auto state_root{buffer->state_root_hash()}; state_root != block.header.state_root) {
+                    log::Error("Wrong state root", {"block", std::to_string(block_num_), "expected",
+                                                    to_hex(block.header.state_root, true), "got",
+                                                    to_hex(state_root, true)});
+                    return StageResult::kInvalidBlock;
+                }
+                state_root_block_num_ = block_num_;
+            }
+            if (state_filter_) {
+                state_filter_block_num_ = block_num_;
+            }
+            if (state_cache_) {
+                state_cache_block_num_ = block_num_;
+            }
+
+            // Encoding goes on in background: encoded blocks are inserted once ready and all of them before any write
             if (block_num_ >= prune_receipts_threshold) {
-                buffer.insert_receipts(block_num_, receipts);
+                receipt_encoder_->push(block_num_, std::move(receipts));
             }
+            receipt_encoder_->collect(*buffer);
 
             // Stats
             std::unique_lock progress_lock(progress_mtx_);
             ++processed_blocks_;
             processed_transactions_ += block.transactions.size();
             processed_gas_ += block.header.gas_used;
-            gas_batch_size += block.header.gas_used;
-            gas_history_size += block.header.gas_used;
+            if (sampling_tracer_) {
+                profile_.merge(sampling_tracer_->profile());
+                sampling_tracer_->clear_profile();
+            }
             progress_lock.unlock();
 
             prefetched_blocks_.pop_front();
+            if (warmups_scheduled_ > 0) {
+                --warmups_scheduled_;
+            }
 
-            // Flush whole buffer if time to
-            if (gas_batch_size >= gas_max_batch_size || block_num_ >= max_block_num) {
-                log::Trace("Buffer State", {"size", human_size(buffer.current_batch_state_size())});
-                buffer.write_to_db();
+            // Flush whole buffer if time to: the memory of a frozen buffer (if any) is part of the budget, which
+            // shrinks when other subsystems hold much of the node memory budget (if any)
+            const size_t memory_usage{buffer->memory_usage() + (frozen_buffer_ ? frozen_buffer_memory_usage_ : 0)};
+            auto& memory_governor{MemoryGovernor::instance()};
+            memory_governor.set_usage(MemoryTag::kStateBuffer, memory_usage);
+            const size_t memory_budget{std::min(memory_budget_, memory_governor.allowance(MemoryTag::kStateBuffer))};
+            if (memory_usage >= memory_budget || block_num_ >= max_block_num) {
+                receipt_encoder_->drain(*buffer);
+                log::Trace("Buffer State", {"size", human_size(buffer->current_batch_state_size()), "memory",
+                                            human_size(buffer->memory_usage())});
+                if (log::test_verbosity(log::Level::kTrace)) {
+                    const auto& cache_stats{analysis_cache_.stats()};
+                    log::Trace("Analysis cache", {"size", std::to_string(analysis_cache_.size()), "hits",
+                                                  std::to_string(cache_stats.hits), "misses",
+                                                  std::to_string(cache_stats.misses), "evictions",
+                                                  std::to_string(cache_stats.evictions)});
+                    if (precompile_cache_) {
+                        const auto& precompile_stats{precompile_cache_->stats()};
+                        log::Trace("Precompile cache",
+                                   {"size", std::to_string(precompile_cache_->size()), "hits",
+                                    std::to_string(precompile_stats.hits), "misses",
+                                    std::to_string(precompile_stats.misses), "hit.rate",
+                                    std::to_string(precompile_cache_->hit_rate().value_or(0.0))});
+                    }
+                }
+                // Only one buffer may be frozen at a time
+                if (frozen_buffer_) {
+                    flush_frozen_buffer(txn, buffer.get());
+                }
+                if (block_num_ >= max_block_num || is_stopping()) {
+                    // Nothing to overlap writes with
+                    buffer->write_to_db();
+                    commit_progress(txn, block_num_);
+                } else {
+                    freeze_buffer(std::move(buffer));
+                }
                 break;
-            } else if (gas_history_size >= gas_max_history_size) {
-                // or flush history only if needed
-                log::Trace("Buffer History", {"size", human_size(buffer.current_batch_history_size())});
-                buffer.write_history_to_db();
-                gas_history_size = 0;
+            } else if (buffer->current_batch_history_size() >= memory_budget / 2) {
+                receipt_encoder_->drain(*buffer);
+                // or flush history only if needed (history is appended, hence the one of frozen buffer goes first)
+                if (frozen_buffer_) {
+                    flush_frozen_buffer(txn, buffer.get());
+                }
+                log::Trace("Buffer History", {"size", human_size(buffer->current_batch_history_size())});
+                buffer->write_history_to_db();
             }
 
             ++block_num_;
@@ -261,6 +585,14 @@ StageResult Execution::unwind(db::RWTxn& txn, BlockNum to) {
     }
 
     log::Info() << "Unwind Execution from " << execution_progress << " to " << to;
+    state_root_.reset();  // Reloaded on next forward
+    state_filter_.reset();  // Keys of unwound state are not in it
+    if (state_cache_) {
+        state_cache_->clear();
+    }
+    if (changed_keys_) {
+        changed_keys_->invalidate();
+    }
 
     static const db::MapConfig unwind_tables[5] = {
         db::table::kAccountChangeSet,  //
@@ -275,10 +607,8 @@ StageResult Execution::unwind(db::RWTxn& txn, BlockNum to) {
             // Revert states
             auto plain_state_table{db::open_cursor(*txn, db::table::kPlainState)};
             auto plain_code_table{db::open_cursor(*txn, db::table::kPlainCodeHash)};
-            auto account_changeset_table{db::open_cursor(*txn, db::table::kAccountChangeSet)};
-            auto storage_changeset_table{db::open_cursor(*txn, db::table::kStorageChangeSet)};
-            unwind_state_from_changeset(account_changeset_table, plain_state_table, plain_code_table, to);
-            unwind_state_from_changeset(storage_changeset_table, plain_state_table, plain_code_table, to);
+            unwind_state_from_changeset(*txn, /*storage=*/false, plain_state_table, plain_code_table, to);
+            unwind_state_from_changeset(*txn, /*storage=*/true, plain_state_table, plain_code_table, to);
         }
 
         // Delete records which has keys greater than unwind point
@@ -386,10 +716,33 @@ std::vector<std::string> Execution::get_log_progress() {
     processed_blocks_ = 0;
     processed_transactions_ = 0;
     processed_gas_ = 0;
-    progress_lock.unlock();
 
-    return {"block",  std::to_string(block_num_),         "blocks/s", std::to_string(speed_blocks),
-            "txns/s", std::to_string(speed_transactions), "Mgas/s",   std::to_string(speed_mgas)};
+    std::vector<std::string> ret{"block",  std::to_string(block_num_),         "blocks/s", std::to_string(speed_blocks),
+                                 "txns/s", std::to_string(speed_transactions), "Mgas/s",   std::to_string(speed_mgas)};
+    if (profile_.samples) {
+        static constexpr size_t kTopCount{3};
+        const char* const* opcode_names{evmc_get_instruction_names_table(EVMC_MAX_REVISION)};
+        std::string top_opcodes;
+        for (const auto& [opcode, samples] : profile_.top_opcodes(kTopCount)) {
+            const char* name{opcode_names[opcode]};
+            top_opcodes.append(top_opcodes.empty() ? "" : " ")
+                .append(name ? name : to_hex(Bytes{opcode}, /*with_prefix=*/true))
+                .append(":")
+                .append(std::to_string(samples * 100 / profile_.samples))
+                .append("%");
+        }
+        std::string top_contracts;
+        for (const auto& [address, gas] : profile_.top_contracts_by_gas(kTopCount)) {
+            top_contracts.append(top_contracts.empty() ? "" : " ")
+                .append(to_hex(address, /*with_prefix=*/true))
+                .append(":")
+                .append(std::to_string(gas / 1'000'000))
+                .append("Mgas");
+        }
+        ret.insert(ret.end(), {"top.opcodes", top_opcodes, "top.contracts", top_contracts});
+        profile_.clear();
+    }
+    return ret;
 }
 
 void Execution::revert_state(ByteView key, ByteView value, mdbx::cursor& plain_state_table,
@@ -439,21 +792,40 @@ void Execution::revert_state(ByteView key, ByteView value, mdbx::cursor& plain_s
     }
 }
 
-void Execution::unwind_state_from_changeset(mdbx::cursor& source_changeset, mdbx::cursor& plain_state_table,
+void Execution::unwind_state_from_changeset(mdbx::txn& txn, bool storage, mdbx::cursor& plain_state_table,
                                             mdbx::cursor& plain_code_table, BlockNum unwind_to) {
-    auto src_data{source_changeset.to_last(/*throw_notfound*/ false)};
-    while (src_data) {
-        auto key(db::from_slice(src_data.key));
-        auto value(db::from_slice(src_data.value));
-        const BlockNum block_number = endian::load_big_u64(&key[0]);
-        if (block_number <= unwind_to) {
-            break;
-        }
-        auto [new_key, new_value]{db::changeset_to_plainstate_format(key, value)};
-        revert_state(new_key, new_value, plain_state_table, plain_code_table);
-        src_data = source_changeset.to_previous(/*throw_notfound*/ false);
+    // State is reverted to the values it had at unwind_to, i.e. the ones in the earliest change set past it. Walking
+    // change sets (forward, as they're laid out) entries are collected keyed by state key then block number: once
+    // sorted, the earliest value of each state key comes first and later ones are skipped. Hence state is written
+    // once per key and in key order, instead of randomly for each change
+    etl::Collector collector{node_settings_};
+    constexpr BlockNum kLastBlock{std::numeric_limits<BlockNum>::max()};
+    Bytes state_key;
+    if (storage) {
+        (void)db::for_each_storage_change(txn, unwind_to + 1, kLastBlock, [&](const db::StorageChange& change) {
+            state_key = db::storage_prefix(change.address, change.incarnation);
+            state_key.append(change.location.bytes, kHashLength);
+            state_key.append(db::block_key(change.block_num));
+            collector.collect({std::move(state_key), Bytes{change.value}});
+        });
+    } else {
+        (void)db::for_each_account_change(txn, unwind_to + 1, kLastBlock, [&](const db::AccountChange& change) {
+            state_key = change.address;
+            state_key.append(db::block_key(change.block_num));
+            collector.collect({std::move(state_key), Bytes{change.value}});
+        });
     }
 
+    Bytes last_state_key;
+    collector.load(plain_state_table, [&](const etl::Entry& entry, mdbx::cursor& plain_state, MDBX_put_flags_t) {
+        const ByteView state_key{ByteView{entry.key}.substr(0, entry.key.length() - sizeof(BlockNum))};
+        if (state_key == last_state_key) {
+            return;  // Changed again by a later block
+        }
+        last_state_key = state_key;
+        revert_state(state_key, entry.value, plain_state, plain_code_table);
+    });
+
     // TODO(Andrea) Explain why we need to leave unwound changeset in place
 }
 
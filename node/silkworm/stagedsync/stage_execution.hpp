@@ -16,62 +16,142 @@
 
 #pragma once
 
+#include <future>
+
 #include <boost/circular_buffer.hpp>
 
 #include <silkworm/consensus/engine.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/changed_keys.hpp>
+#include <silkworm/db/state_cache.hpp>
+#include <silkworm/db/state_filter.hpp>
 #include <silkworm/execution/analysis_cache.hpp>
 #include <silkworm/execution/evm.hpp>
+#include <silkworm/execution/sampling_tracer.hpp>
 #include <silkworm/stagedsync/common.hpp>
+#include <silkworm/stagedsync/stage_execution/block_prefetcher.hpp>
+#include <silkworm/stagedsync/stage_execution/receipt_encoder.hpp>
+#include <silkworm/stagedsync/stage_execution/state_import.hpp>
+#include <silkworm/stagedsync/stage_execution/state_warmer.hpp>
+#include <silkworm/trie/incremental_trie.hpp>
 
 namespace silkworm::stagedsync {
 
 class Execution final : public IStage {
   public:
-    explicit Execution(NodeSettings* node_settings)
+    //! \param [in] changed_keys : if not null, gets the keys changed by each forward run for HashState to pick up
+    explicit Execution(NodeSettings* node_settings, db::ChangedKeys* changed_keys = nullptr)
         : IStage(db::stages::kExecutionKey, node_settings),
-          consensus_engine_{consensus::engine_factory(node_settings->chain_config.value())} {}
+          consensus_engine_{consensus::engine_factory(node_settings->chain_config.value())},
+          changed_keys_{changed_keys} {}
 
     ~Execution() override = default;
 
     StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* input_source() const final { return db::stages::kSendersKey; }
     StageResult unwind(db::RWTxn& txn, BlockNum to) final;
     StageResult prune(db::RWTxn& txn) final;
     std::vector<std::string> get_log_progress() final;
 
   private:
     static constexpr size_t kMaxPrefetchedBlocks{10240};
+    static constexpr size_t kAnalysisCacheSize{5'000};
 
     std::unique_ptr<consensus::IEngine> consensus_engine_;
     BlockNum block_num_{0};
     boost::circular_buffer<Block> prefetched_blocks_{/*buffer_capacity=*/kMaxPrefetchedBlocks};
+    std::unique_ptr<BlockPrefetcher> block_prefetcher_;  // Background reader (only when txn is not external)
+    std::unique_ptr<StateWarmer> state_warmer_;          // Background state reader (only when txn is not external)
+    size_t warmups_scheduled_{0};                        // Number of prefetched blocks (from front) already warmed up
+    std::unique_ptr<ReceiptEncoder> receipt_encoder_;    // Background encoder of receipts and logs
+
+    // Baseline analyses are keyed by code hash and do not depend on EVM revision: they stay valid across cycles
+    // and unwinds, so short forward runs (e.g. near chain tip) do not start over with a cold cache
+    BaselineAnalysisCache analysis_cache_{kAnalysisCacheSize};
+    ExecutionContext execution_context_;  // VM and execution states shared by all blocks
+    std::unique_ptr<PrecompileCache> precompile_cache_;  // Precompile results are valid forever (only if enabled)
+
+    // Double buffering: a full buffer is frozen and sorted on a background thread while execution goes on with a
+    // fresh buffer reading through it. MDBX allows one writer only, hence it is written to db by this thread as
+    // soon as sorting is done
+    std::unique_ptr<db::Buffer> frozen_buffer_;
+    std::future<void> frozen_buffer_prepared_;
+    BlockNum frozen_buffer_block_num_{0};    // Last block whose state is in frozen_buffer_
+    size_t frozen_buffer_memory_usage_{0};   // Memory of frozen_buffer_ (not to be queried while being sorted)
+    size_t memory_budget_{0};                // Max memory of active and frozen buffers together (in bytes)
+
+    // In-memory state trie verifying the state root of each block (only if enabled). It survives across cycles
+    // as long as it's in sync with db, i.e. no errors or unwinds happened in the meantime
+    std::unique_ptr<trie::IncrementalStateRoot> state_root_;
+    BlockNum state_root_block_num_{0};  // Last block whose state is in state_root_
+
+    // Filter of PlainState keys sparing reads of absent state (only if enabled). Written through by buffers, it
+    // survives across cycles as long as no unwinds happened in the meantime, until saturated
+    std::unique_ptr<db::StateFilter> state_filter_;
+    BlockNum state_filter_block_num_{0};  // Last block whose state is in state_filter_
+
+    // Clean state read and written by buffers, kept across batches and cycles (only if enabled) as long as it's in sync
+    // with db, i.e. no errors or unwinds happened in the meantime
+    std::unique_ptr<db::StateCache> state_cache_;
+    BlockNum state_cache_block_num_{0};  // Last block whose state is in state_cache_
+
+    // Keys changed since the beginning of current forward run (if any), as long as HashState is in sync with us
+    db::ChangedKeys* changed_keys_;
 
     //! \brief Prefetches blocks for processing
     //! \param [in] from: the first block to prefetch (inclusive)
     //! \param [in] to: the last block to prefetch (inclusive)
-    //! \remarks The amount of blocks to be fetched is determined by the upper block number (to)
-    //! or kMaxPrefetchedBlocks collected, whichever comes first
+    //! \remarks When the background reader is active the next window it has already decoded is taken; otherwise
+    //! the amount of blocks to be fetched is determined by the upper block number (to) or kMaxPrefetchedBlocks
+    //! collected, whichever comes first
     void prefetch_blocks(db::RWTxn& txn, BlockNum from, BlockNum to);
 
+    //! \brief Seeds buffer (and analysis_cache_) with the state warmed up so far and schedules the warm up of the next
+    //! prefetched blocks
+    void warm_up_state(const db::Buffer& buffer);
+
+    //! \brief Loads the whole plain state into state_root_ unless the latter is already at block_num
+    void load_state_root(db::RWTxn& txn, BlockNum block_num);
+
+    //! \brief Builds state_filter_ from PlainState unless the current one is at block_num and not saturated
+    void load_state_filter(db::RWTxn& txn, BlockNum block_num);
+
+    //! \brief Persists stage progress up to block_num and commits txn
+    void commit_progress(db::RWTxn& txn, BlockNum block_num);
+
+    //! \brief Hands buffer over to a background thread sorting it for write
+    void freeze_buffer(std::unique_ptr<db::Buffer> buffer);
+
+    //! \brief Waits for the frozen buffer to be sorted, writes it to db and commits
+    //! \param [in] child : the buffer reading through the frozen one (if any), which gets detached
+    void flush_frozen_buffer(db::RWTxn& txn, db::Buffer* child);
+
+    //! \brief Flushes (or drops when write is false) the frozen buffer left over by an interrupted batch, if any
+    StageResult finish_frozen_buffer(db::RWTxn& txn, bool write);
+
     //! \brief Executes a batch of blocks
     //! \remarks A batch completes when either max block is reached or buffer dimensions overflow
-    StageResult execute_batch(db::RWTxn& txn, BlockNum max_block_num, BaselineAnalysisCache& analysis_cache,
-                              ObjectPool<EvmoneExecutionState>& state_pool, BlockNum prune_history_threshold,
+    StageResult execute_batch(db::RWTxn& txn, BlockNum max_block_num, BlockNum prune_history_threshold,
                               BlockNum prune_receipts_threshold);
 
-    //! \brief For given changeset cursor/bucket it reverts the changes on states buckets
-    static void unwind_state_from_changeset(mdbx::cursor& source_changeset, mdbx::cursor& plain_state_table,
-                                            mdbx::cursor& plain_code_table, BlockNum unwind_to);
+    //! \brief Reverts the changes of account (or storage) changesets on states buckets
+    //! \remarks Only the earliest change past unwind_to of each key is applied, all at once in key order
+    void unwind_state_from_changeset(mdbx::txn& txn, bool storage, mdbx::cursor& plain_state_table,
+                                     mdbx::cursor& plain_code_table, BlockNum unwind_to);
 
     //! \brief Revert State for given address/storage location
     static void revert_state(ByteView key, ByteView value, mdbx::cursor& plain_state_table,
                              mdbx::cursor& plain_code_table);
 
+    std::unique_ptr<SamplingTracer> sampling_tracer_;  // Only when execution profiling is enabled
+
     // Stats
     std::mutex progress_mtx_;  // Synchronizes access to progress stats
     std::chrono::time_point<std::chrono::steady_clock> lap_time_{std::chrono::steady_clock::now()};
     size_t processed_blocks_{0};
     size_t processed_transactions_{0};
     size_t processed_gas_{0};
+    ExecutionProfile profile_;  // Accrued since last log
 };
 
 }  // namespace silkworm::stagedsync
@@ -0,0 +1,145 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_prefetcher.hpp"
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <silkworm/common/assert.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::stagedsync {
+
+void read_canonical_blocks(mdbx::txn& txn, BlockNum from, size_t count, std::vector<Block>& out) {
+    size_t num_read{0};
+
+    db::Cursor hashes_table(txn, db::table::kCanonicalHashes);
+    db::SendersReader senders(txn);
+    auto key{db::block_key(from)};
+    if (hashes_table.seek(db::to_slice(key))) {
+        BlockNum block_num{from};
+        db::WalkFunc walk_function{[&](mdbx::cursor&, mdbx::cursor::move_result& data) {
+            BlockNum reached_block_num{endian::load_big_u64(static_cast<const uint8_t*>(data.key.data()))};
+            if (reached_block_num != block_num) {
+                throw std::runtime_error("Bad canonical header sequence: expected " + std::to_string(block_num) +
+                                         " got " + std::to_string(reached_block_num));
+            }
+            SILKWORM_ASSERT(data.value.length() == kHashLength);
+            const auto hash_ptr{static_cast<const uint8_t*>(data.value.data())};
+            auto& block{out.emplace_back()};
+            const std::span<const uint8_t, kHashLength> hash{hash_ptr, kHashLength};
+            if (!db::read_block(txn, hash, block_num, /*read_senders=*/false, block)) {
+                throw std::runtime_error("Unable to read block " + std::to_string(block_num));
+            }
+            senders.parse(block_num, hash, block.transactions);
+            ++block_num;
+            return true;
+        }};
+        num_read = db::cursor_for_count(hashes_table, walk_function, count);
+    }
+
+    if (num_read != count) {
+        throw std::runtime_error("Missing block " + std::to_string(from + num_read));
+    }
+}
+
+BlockPrefetcher::BlockPrefetcher(mdbx::env env, size_t window_size, size_t max_windows)
+    : Worker("BlockPrefetcher"), env_{env}, window_size_{window_size}, max_windows_{max_windows} {
+    SILKWORM_ASSERT(window_size_ > 0 && max_windows_ > 0);
+}
+
+BlockPrefetcher::~BlockPrefetcher() { stop(/*wait=*/true); }
+
+void BlockPrefetcher::start_range(BlockNum from, BlockNum to) {
+    {
+        std::unique_lock lock{mutex_};
+        from_ = from;
+        to_ = to;
+        windows_.clear();
+        done_ = from > to;
+        stop_requested_ = false;
+        exception_ = nullptr;
+    }
+    start(/*wait=*/false);
+}
+
+bool BlockPrefetcher::pop_window(std::vector<Block>& window) {
+    std::unique_lock lock{mutex_};
+    not_empty_.wait(lock, [this] { return !windows_.empty() || done_ || stop_requested_; });
+    if (windows_.empty()) {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        return false;
+    }
+    window = std::move(windows_.front());
+    windows_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+}
+
+void BlockPrefetcher::stop(bool wait) {
+    {
+        std::unique_lock lock{mutex_};
+        stop_requested_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+    Worker::stop(wait);
+}
+
+void BlockPrefetcher::work() {
+    try {
+        BlockNum block_num{from_};
+        while (!is_stopping() && block_num <= to_) {
+            const size_t count{std::min(static_cast<size_t>(to_ - block_num + 1), window_size_)};
+            std::vector<Block> window;
+            window.reserve(count);
+            {
+                // A fresh snapshot for each window: a long-lived reader would pin pages freed by Execution commits
+                auto ro_txn{env_.start_read()};
+                read_canonical_blocks(ro_txn, block_num, count, window);
+            }
+            block_num += count;
+
+            std::unique_lock lock{mutex_};
+            not_full_.wait(lock, [this] { return windows_.size() < max_windows_ || stop_requested_; });
+            if (stop_requested_) {
+                break;
+            }
+            windows_.push_back(std::move(window));
+            lock.unlock();
+            not_empty_.notify_one();
+        }
+    } catch (...) {
+        std::unique_lock lock{mutex_};
+        exception_ = std::current_exception();
+    }
+
+    {
+        std::unique_lock lock{mutex_};
+        done_ = true;
+    }
+    not_empty_.notify_all();
+}
+
+}  // namespace silkworm::stagedsync
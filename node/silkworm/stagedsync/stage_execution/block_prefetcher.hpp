@@ -0,0 +1,80 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/concurrency/worker.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Reads a sequence of canonical blocks (with senders) from db
+//! \param [in] txn : the transaction to read from
+//! \param [in] from : the first block to read (inclusive)
+//! \param [in] count : the number of blocks to read
+//! \param [out] out : the container blocks are appended to
+//! \remarks Throws if the canonical sequence has gaps or a block cannot be read
+void read_canonical_blocks(mdbx::txn& txn, BlockNum from, size_t count, std::vector<Block>& out);
+
+//! \brief Reads canonical blocks ahead of Execution on a dedicated thread with its own read-only transaction.
+//! Blocks are handed off in windows through a bounded queue so the reader never runs too far ahead of the consumer.
+//! \remarks Blocks are read from the last committed snapshot: use only when the data to be read (bodies, senders,
+//! canonical hashes) has been committed by previous stages
+class BlockPrefetcher final : public Worker {
+  public:
+    static constexpr size_t kDefaultWindowSize{1024};
+    static constexpr size_t kDefaultMaxWindows{10};
+
+    explicit BlockPrefetcher(mdbx::env env, size_t window_size = kDefaultWindowSize,
+                             size_t max_windows = kDefaultMaxWindows);
+    ~BlockPrefetcher() override;
+
+    //! \brief Starts the reader thread on blocks in range [from, to]
+    void start_range(BlockNum from, BlockNum to);
+
+    //! \brief Waits for the next window of blocks to be available and moves it into window
+    //! \return False when no more blocks will ever be produced
+    //! \remarks Rethrows any exception raised within the reader thread
+    bool pop_window(std::vector<Block>& window);
+
+    void stop(bool wait = false) final;
+
+  private:
+    void work() final;
+
+    mdbx::env env_;
+    const size_t window_size_;
+    const size_t max_windows_;
+    BlockNum from_{0};
+    BlockNum to_{0};
+
+    std::mutex mutex_;                     // Guards members below
+    std::condition_variable not_empty_;    // Signalled when a window is available or reader is done
+    std::condition_variable not_full_;     // Signalled when a window has been consumed or stop is requested
+    std::deque<std::vector<Block>> windows_;
+    bool done_{false};
+    bool stop_requested_{false};
+    std::exception_ptr exception_{nullptr};
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,51 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_prefetcher.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("BlockPrefetcher") {
+    test::Context context;
+    context.commit_txn();
+
+    std::vector<Block> window;
+
+    SECTION("Empty range") {
+        BlockPrefetcher prefetcher{context.env()};
+        prefetcher.start_range(/*from=*/10, /*to=*/9);
+        CHECK_FALSE(prefetcher.pop_window(window));
+        CHECK(window.empty());
+    }
+
+    SECTION("Missing blocks are reported to consumer") {
+        BlockPrefetcher prefetcher{context.env(), /*window_size=*/4, /*max_windows=*/2};
+        prefetcher.start_range(/*from=*/1, /*to=*/10);
+        CHECK_THROWS_AS(prefetcher.pop_window(window), std::runtime_error);
+    }
+
+    SECTION("Stop unblocks consumer") {
+        BlockPrefetcher prefetcher{context.env()};
+        prefetcher.stop(/*wait=*/true);
+        CHECK_FALSE(prefetcher.pop_window(window));
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,128 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "receipt_encoder.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include <silkworm/common/assert.hpp>
+
+namespace silkworm::stagedsync {
+
+ReceiptEncoder::ReceiptEncoder(size_t max_pending) : Worker("ReceiptEncoder"), max_pending_{max_pending} {
+    SILKWORM_ASSERT(max_pending_ > 0);
+    start(/*wait=*/false);
+}
+
+ReceiptEncoder::~ReceiptEncoder() { stop(/*wait=*/true); }
+
+void ReceiptEncoder::push(BlockNum block_number, std::vector<Receipt>&& receipts) {
+    std::unique_lock lock{mutex_};
+    dequeued_.wait(lock, [this] { return queue_.size() < max_pending_ || stop_requested_; });
+    if (stop_requested_) {
+        throw std::runtime_error("ReceiptEncoder is stopping");
+    }
+    queue_.emplace_back(block_number, std::move(receipts));
+    lock.unlock();
+    queued_.notify_one();
+}
+
+void ReceiptEncoder::collect(db::Buffer& buffer) {
+    std::vector<db::EncodedReceipts> encoded;
+    {
+        std::unique_lock lock{mutex_};
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        encoded.swap(encoded_);
+    }
+    for (auto& block : encoded) {
+        buffer.insert_receipts(std::move(block));
+    }
+}
+
+void ReceiptEncoder::drain(db::Buffer& buffer) {
+    {
+        std::unique_lock lock{mutex_};
+        wait_idle(lock);
+    }
+    collect(buffer);
+}
+
+void ReceiptEncoder::discard() {
+    std::unique_lock lock{mutex_};
+    wait_idle(lock);
+    queue_.clear();
+    encoded_.clear();
+    exception_ = nullptr;
+}
+
+void ReceiptEncoder::wait_idle(std::unique_lock<std::mutex>& lock) {
+    dequeued_.wait(lock, [this] { return (queue_.empty() && !encoding_) || stop_requested_; });
+}
+
+void ReceiptEncoder::stop(bool wait) {
+    {
+        std::unique_lock lock{mutex_};
+        stop_requested_ = true;
+    }
+    queued_.notify_all();
+    dequeued_.notify_all();
+    Worker::stop(wait);
+}
+
+void ReceiptEncoder::work() {
+    std::deque<std::pair<BlockNum, std::vector<Receipt>>> blocks;
+    std::vector<db::EncodedReceipts> encoded;
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            queued_.wait(lock, [this] { return !queue_.empty() || stop_requested_; });
+            if (stop_requested_) {
+                break;
+            }
+            // Take all queued blocks at once: pushes go on meanwhile
+            blocks.swap(queue_);
+            encoding_ = true;
+        }
+        dequeued_.notify_all();
+
+        std::exception_ptr exception{nullptr};
+        try {
+            for (const auto& [block_number, receipts] : blocks) {
+                encoded.push_back(db::encode_receipts(block_number, receipts));
+            }
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        blocks.clear();
+
+        {
+            std::unique_lock lock{mutex_};
+            std::move(encoded.begin(), encoded.end(), std::back_inserter(encoded_));
+            encoding_ = false;
+            if (exception && !exception_) {
+                exception_ = exception;
+            }
+        }
+        encoded.clear();
+        dequeued_.notify_all();
+    }
+}
+
+}  // namespace silkworm::stagedsync
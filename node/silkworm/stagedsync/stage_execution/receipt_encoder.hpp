@@ -0,0 +1,75 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <silkworm/concurrency/worker.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/types/receipt.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief CBOR-encodes receipts and logs of executed blocks on a dedicated thread, so that the execution thread only
+//! executes. Encoded blocks are handed back in the very order they have been pushed
+class ReceiptEncoder final : public Worker {
+  public:
+    static constexpr size_t kDefaultMaxPending{1024};  // Blocks
+
+    explicit ReceiptEncoder(size_t max_pending = kDefaultMaxPending);
+    ~ReceiptEncoder() override;
+
+    //! \brief Queues receipts of a block for encoding, waiting while max_pending blocks are already queued
+    void push(BlockNum block_number, std::vector<Receipt>&& receipts);
+
+    //! \brief Moves into buffer the blocks encoded so far without waiting for others
+    //! \remarks Rethrows any exception raised within the encoding thread
+    void collect(db::Buffer& buffer);
+
+    //! \brief Waits for all queued blocks to be encoded and moves them into buffer
+    //! \remarks Rethrows any exception raised within the encoding thread
+    void drain(db::Buffer& buffer);
+
+    //! \brief Drops all queued and encoded blocks (e.g. those of a batch which has been interrupted)
+    void discard();
+
+    void stop(bool wait = false) final;
+
+  private:
+    void work() final;
+
+    //! \brief Waits for the encoding thread to be idle with nothing queued
+    void wait_idle(std::unique_lock<std::mutex>& lock);
+
+    const size_t max_pending_;
+
+    std::mutex mutex_;                                             // Guards members below
+    std::condition_variable queued_;                               // Signalled on blocks queued or stop request
+    std::condition_variable dequeued_;                             // Signalled on blocks taken or encoded
+    std::deque<std::pair<BlockNum, std::vector<Receipt>>> queue_;  // Blocks waiting to be encoded
+    std::vector<db::EncodedReceipts> encoded_;                     // Blocks encoded and not collected yet
+    bool encoding_{false};                                         // Whether the thread is encoding taken blocks
+    bool stop_requested_{false};
+    std::exception_ptr exception_{nullptr};
+};
+
+}  // namespace silkworm::stagedsync
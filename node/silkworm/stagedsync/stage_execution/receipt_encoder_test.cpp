@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "receipt_encoder.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/types/receipt_cbor.hpp>
+
+namespace silkworm::stagedsync {
+
+using namespace evmc::literals;
+
+TEST_CASE("ReceiptEncoder") {
+    test::Context context;
+    db::Buffer buffer{context.txn(), /*prune_history_threshold=*/0};
+    ReceiptEncoder encoder{/*max_pending=*/2};
+
+    const Log log{0xea674fdde714fd979de3edf0f56aa9716b898ec8_address,
+                  {0x0000000000000000000000000000000000000000000000000000000000000001_bytes32},
+                  {}};
+    std::vector<std::vector<Receipt>> blocks_receipts;
+    for (uint64_t block_number{1}; block_number <= 10; ++block_number) {
+        std::vector<Receipt> receipts{{Transaction::Type::kLegacy, true, 21'000 * block_number, {}, {}},
+                                      {Transaction::Type::kEip1559, true, 42'000 * block_number, {}, {log}}};
+        blocks_receipts.push_back(receipts);
+    }
+
+    SECTION("Blocks are encoded in order") {
+        for (size_t i{0}; i < blocks_receipts.size(); ++i) {
+            auto receipts{blocks_receipts[i]};
+            encoder.push(i + 1, std::move(receipts));
+            encoder.collect(buffer);
+        }
+        encoder.drain(buffer);
+        buffer.write_history_to_db();
+
+        // Receipts and logs are appended: any out of order encoded block would have thrown
+        auto receipts_table{db::open_cursor(context.txn(), db::table::kBlockReceipts)};
+        CHECK(context.txn().get_map_stat(receipts_table.map()).ms_entries == blocks_receipts.size());
+        auto logs_table{db::open_cursor(context.txn(), db::table::kLogs)};
+        CHECK(context.txn().get_map_stat(logs_table.map()).ms_entries == blocks_receipts.size());
+
+        const auto data{receipts_table.find(db::to_slice(db::block_key(10)), /*throw_notfound=*/false)};
+        REQUIRE(data);
+        CHECK(db::from_slice(data.value) == cbor_encode(blocks_receipts[9]));
+    }
+
+    SECTION("Discard drops pending blocks") {
+        auto receipts{blocks_receipts[0]};
+        encoder.push(1, std::move(receipts));
+        encoder.discard();
+        encoder.drain(buffer);
+        CHECK(buffer.current_batch_history_size() == 0);
+    }
+
+    SECTION("Push fails once stopped") {
+        encoder.stop(/*wait=*/true);
+        auto receipts{blocks_receipts[0]};
+        CHECK_THROWS_AS(encoder.push(1, std::move(receipts)), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::stagedsync
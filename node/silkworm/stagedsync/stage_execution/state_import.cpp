@@ -0,0 +1,194 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "state_import.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/common/stopwatch.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/prune_mode.hpp>
+#include <silkworm/db/stages.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/etl/collector.hpp>
+
+namespace silkworm::stagedsync {
+
+namespace {
+
+    //! \brief Copies all records of source map into the same (empty) map of txn
+    void copy_map(db::RWTxn& txn, mdbx::txn& source, const db::MapConfig& config) {
+        db::BulkLoader loader{txn, config};
+        db::Cursor source_table(source, config);
+        for (auto data{source_table.to_first(/*throw_notfound=*/false)}; data;
+             data = source_table.to_next(/*throw_notfound=*/false)) {
+            loader.append(db::from_slice(data.key), db::from_slice(data.value));
+        }
+    }
+
+    //! \brief Copies the change sets of blocks in range [from, to] from source into the (empty) change sets of txn
+    void copy_changesets(db::RWTxn& txn, mdbx::txn& source, BlockNum from, BlockNum to) {
+        const auto source_format{db::read_changeset_format(source)};
+        const auto format{db::read_changeset_format(*txn)};
+        const auto from_key{db::block_key(from)};
+
+        for (const bool storage : {false, true}) {
+            const auto& config{storage ? db::table::kStorageChangeSet : db::table::kAccountChangeSet};
+            db::BulkLoader loader{txn, config};
+            db::Cursor source_table(source, config);
+            for (auto data{source_table.lower_bound(db::to_slice(from_key), /*throw_notfound=*/false)}; data;
+                 data = source_table.to_next(/*throw_notfound=*/false)) {
+                const ByteView key{db::from_slice(data.key)};
+                if (endian::load_big_u64(key.data()) > to) {
+                    break;
+                }
+                const ByteView value{db::from_slice(data.value)};
+                if (storage && source_format != format) {
+                    const auto [location, previous_value]{db::split_storage_change_value(value, source_format)};
+                    loader.append(key, db::storage_change_value(location, previous_value, format));
+                } else {
+                    loader.append(key, value);
+                }
+            }
+        }
+    }
+
+    //! \brief Collects, for each key changed after block, its previous value along with the number of the block
+    //! changing it. Keys are in PlainState format with the location of storage appended to the address
+    //! and incarnation (see changeset_to_plainstate_format), values are block number + previous value: hence the
+    //! first entry of each key is the one of the earliest change, which holds the value as of block
+    void collect_later_changes(mdbx::txn& source, BlockNum block, etl::Collector& collector) {
+        const auto format{db::read_changeset_format(source)};
+        const auto from_key{db::block_key(block + 1)};
+
+        for (const auto& config : {db::table::kAccountChangeSet, db::table::kStorageChangeSet}) {
+            db::Cursor source_table(source, config);
+            for (auto data{source_table.lower_bound(db::to_slice(from_key), /*throw_notfound=*/false)}; data;
+                 data = source_table.to_next(/*throw_notfound=*/false)) {
+                const ByteView key{db::from_slice(data.key)};
+                auto [plain_key, previous_value]{
+                    db::changeset_to_plainstate_format(key, db::from_slice(data.value), format)};
+                Bytes value{key.substr(0, sizeof(BlockNum))};
+                value.append(previous_value);
+                collector.collect({std::move(plain_key), std::move(value)});
+            }
+        }
+    }
+
+    //! \brief Writes the state as of block into the (empty) PlainState of txn, merging the current source PlainState
+    //! with the previous values of the keys changed later (see collect_later_changes), which take precedence
+    void load_plain_state(db::RWTxn& txn, mdbx::txn& source, etl::Collector& later_changes) {
+        db::BulkLoader loader{txn, db::table::kPlainState};
+        db::Cursor source_table(source, db::table::kPlainState);
+        auto data{source_table.to_first(/*throw_notfound=*/false)};
+
+        // Appends current source records up to, but excluding, key (up to the end if none) and skips the one at key
+        Bytes source_key;
+        const auto catch_up{[&](std::optional<ByteView> key) {
+            for (; data; data = source_table.to_next(/*throw_notfound=*/false)) {
+                const ByteView value{db::from_slice(data.value)};
+                source_key.assign(db::from_slice(data.key));
+                if (source_key.length() != kAddressLength) {
+                    source_key.append(value.substr(0, kHashLength));  // Storage location is the head of value
+                }
+                if (key) {
+                    const auto diff{ByteView{source_key}.compare(*key)};
+                    if (diff == 0) {
+                        data = source_table.to_next(/*throw_notfound=*/false);
+                    }
+                    if (diff >= 0) {
+                        break;
+                    }
+                }
+                loader.append(db::from_slice(data.key), value);
+            }
+        }};
+
+        Bytes last_key;
+        Bytes storage_value;
+        later_changes.load(loader, [&](const etl::EntryView& entry, db::BulkLoader& target) {
+            if (entry.key == ByteView{last_key}) {
+                return;  // Not the earliest change
+            }
+            last_key.assign(entry.key);
+            catch_up(entry.key);
+
+            const ByteView previous_value{entry.value.substr(sizeof(BlockNum))};
+            if (previous_value.empty()) {
+                return;  // Did not exist as of block
+            }
+            if (entry.key.length() == kAddressLength) {
+                target.append(entry.key, previous_value);
+            } else {
+                storage_value.assign(entry.key.substr(db::kPlainStoragePrefixLength));
+                storage_value.append(previous_value);
+                target.append(entry.key.substr(0, db::kPlainStoragePrefixLength), storage_value);
+            }
+        });
+        catch_up(std::nullopt);
+    }
+
+}  // namespace
+
+void import_state(db::RWTxn& txn, mdbx::txn& source, BlockNum height, BlockNum prune_history_threshold,
+                  const NodeSettings* node_settings) {
+    const auto source_progress{db::stages::read_stage_progress(source, db::stages::kExecutionKey)};
+    if (source_progress < height) {
+        throw std::runtime_error("Import source executed up to block " + std::to_string(source_progress) +
+                                 " only, while state is requested at block " + std::to_string(height));
+    }
+    const auto hash{db::read_canonical_header_hash(*txn, height)};
+    if (!hash || hash != db::read_canonical_header_hash(source, height)) {
+        throw std::runtime_error("Import source is not on the canonical chain at block " + std::to_string(height));
+    }
+    if (db::read_prune_mode(source).history().value_from_head(source_progress) > height + 1) {
+        throw std::runtime_error("Import source has pruned change sets after block " + std::to_string(height));
+    }
+
+    StopWatch sw{/*auto_start=*/true};
+    log::Info("Importing state", {"block", std::to_string(height), "hash", to_hex(*hash, true)});
+
+    for (const auto& config : {db::table::kPlainState, db::table::kAccountChangeSet, db::table::kStorageChangeSet,
+                               db::table::kCode, db::table::kPlainCodeHash, db::table::kIncarnationMap}) {
+        txn->clear_map(db::open_map(*txn, config));
+    }
+
+    copy_changesets(txn, source, std::max<BlockNum>(prune_history_threshold, 1), height);
+    log::Info("Imported change sets", {"elapsed", StopWatch::format(sw.lap().second)});
+
+    etl::Collector later_changes{node_settings};
+    collect_later_changes(source, height, later_changes);
+    load_plain_state(txn, source, later_changes);
+    log::Info("Imported plain state",
+              {"later.changes", std::to_string(later_changes.size()), "elapsed", StopWatch::format(sw.lap().second)});
+
+    // Code of contracts created later comes along and incarnations might be ahead: both are harmless as they are
+    // keyed by hash and only need to be unique respectively
+    copy_map(txn, source, db::table::kCode);
+    copy_map(txn, source, db::table::kPlainCodeHash);
+    copy_map(txn, source, db::table::kIncarnationMap);
+
+    const auto [finish_time, _]{sw.stop()};
+    log::Info("Imported state",
+              {"block", std::to_string(height), "in", StopWatch::format(sw.since_start(finish_time))});
+}
+
+}  // namespace silkworm::stagedsync
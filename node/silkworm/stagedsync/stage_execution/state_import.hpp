@@ -0,0 +1,36 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#pragma once
+
+#include <silkworm/common/settings.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Imports the state as of block height from a trusted db, in place of executing blocks [1, height]
+//! \param [in] txn : the transaction on the db being synced, whose Execution stage is still at genesis
+//! \param [in] source : a read-only transaction on the trusted db
+//! \param [in] height : the block whose state is imported (it must be canonical in both dbs)
+//! \param [in] prune_history_threshold : change sets of blocks below this are not imported
+//! \param [in] node_settings : the settings of the ETL collector in use
+//! \remarks PlainState, code and change sets up to height are replaced. The state at height is rebuilt from the
+//! source's current PlainState: the previous value in the first change set after height of each key is its value at
+//! height. Hence the source must retain all change sets after height. Throws std::runtime_error if it does not
+//! qualify. Progress is not written: the caller does once done
+void import_state(db::RWTxn& txn, mdbx::txn& source, BlockNum height, BlockNum prune_history_threshold,
+                  const NodeSettings* node_settings);
+
+}  // namespace silkworm::stagedsync
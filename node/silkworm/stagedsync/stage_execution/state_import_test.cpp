@@ -0,0 +1,102 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include "state_import.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/stages.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("Import state") {
+    const auto contract{0x00000000000000000000000000000000000a0001_address};
+    const auto eoa{0x00000000000000000000000000000000000b0001_address};
+    const auto late_eoa{0x00000000000000000000000000000000000c0001_address};
+    const auto location1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto location2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto value1{0x0000000000000000000000000000000000000000000000000000000000000011_bytes32};
+    const auto value2{0x0000000000000000000000000000000000000000000000000000000000000022_bytes32};
+    const auto canonical_hash{0x9a6df7d7b7dc5e1e6c3b6e1c29e8c4cb0fe8cf8b2d9aafc0bbcb074ee92f53a1_bytes32};
+
+    const auto balance_of{[](uint64_t balance) {
+        Account account;
+        account.balance = balance;
+        account.incarnation = 1;
+        return account;
+    }};
+
+    // Source gets state changes of 3 blocks
+    test::Context source;
+    {
+        db::Buffer buffer{source.txn(), /*prune_history_threshold=*/0};
+        buffer.begin_block(1);
+        buffer.update_account(contract, std::nullopt, balance_of(1));
+        buffer.update_storage(contract, 1, location1, {}, value1);
+        buffer.update_account(eoa, std::nullopt, Account{});
+
+        buffer.begin_block(2);
+        buffer.update_account(contract, balance_of(1), balance_of(2));
+        buffer.update_storage(contract, 1, location1, value1, value2);
+        buffer.update_storage(contract, 1, location2, {}, value1);
+
+        buffer.begin_block(3);
+        buffer.update_account(contract, balance_of(2), balance_of(3));
+        buffer.update_storage(contract, 1, location1, value2, {});
+        buffer.update_account(eoa, Account{}, std::nullopt);
+        buffer.update_account(late_eoa, std::nullopt, Account{});
+        buffer.write_to_db();
+    }
+    db::stages::write_stage_progress(source.txn(), db::stages::kExecutionKey, 3);
+    db::write_canonical_header_hash(source.txn(), canonical_hash.bytes, 2);
+
+    test::Context context;
+    db::write_canonical_header_hash(context.txn(), canonical_hash.bytes, 2);
+    db::RWTxn txn{context.txn()};
+    NodeSettings node_settings;
+    node_settings.data_directory = std::make_unique<DataDirectory>(context.dir().path());
+
+    SECTION("State as of height") {
+        import_state(txn, source.txn(), /*height=*/2, /*prune_history_threshold=*/0, &node_settings);
+
+        CHECK(db::read_account(*txn, contract) == balance_of(2));
+        CHECK(db::read_storage(*txn, contract, 1, location1) == value2);
+        CHECK(db::read_storage(*txn, contract, 1, location2) == value1);
+        CHECK(db::read_account(*txn, eoa) == Account{});
+        CHECK_FALSE(db::read_account(*txn, late_eoa));
+
+        CHECK(db::read_account_changes(*txn, 1).size() == 2);
+        CHECK(db::read_account_changes(*txn, 2).size() == 1);
+        CHECK(db::read_account_changes(*txn, 3).empty());
+        CHECK(db::read_storage_changes(*txn, 2).size() == 1);
+        CHECK(db::read_storage_changes(*txn, 3).empty());
+    }
+
+    SECTION("Pruned change sets are not imported") {
+        import_state(txn, source.txn(), /*height=*/2, /*prune_history_threshold=*/2, &node_settings);
+        CHECK(db::read_account_changes(*txn, 1).empty());
+        CHECK(db::read_account_changes(*txn, 2).size() == 1);
+    }
+
+    SECTION("Source not qualifying") {
+        CHECK_THROWS_AS(import_state(txn, source.txn(), /*height=*/4, 0, &node_settings), std::runtime_error);
+        CHECK_THROWS_AS(import_state(txn, source.txn(), /*height=*/1, 0, &node_settings), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::stagedsync
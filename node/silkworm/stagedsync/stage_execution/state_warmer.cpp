@@ -0,0 +1,150 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_warmer.hpp"
+
+#include <chrono>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <silkworm/common/assert.hpp>
+#include <silkworm/db/access_layer.hpp>
+
+namespace silkworm::stagedsync {
+
+TouchedState collect_touched_state(const Block& block) {
+    TouchedState touched;
+    touched.accounts.reserve(block.transactions.size() * 2 + 1);
+    touched.accounts.push_back(block.header.beneficiary);
+    for (const auto& txn : block.transactions) {
+        if (txn.from.has_value()) {
+            touched.accounts.push_back(*txn.from);
+        }
+        if (txn.to.has_value()) {
+            touched.accounts.push_back(*txn.to);
+            touched.callees.push_back(*txn.to);
+        }
+        for (const auto& entry : txn.access_list) {
+            touched.accounts.push_back(entry.account);
+            for (const auto& key : entry.storage_keys) {
+                touched.storage_keys.emplace_back(entry.account, key);
+            }
+        }
+    }
+    return touched;
+}
+
+StateWarmer::StateWarmer(mdbx::env env, uint32_t num_threads, size_t lookahead, bool analyze_code)
+    : env_{env}, lookahead_{lookahead}, analyze_code_{analyze_code}, txn_pool_{env, num_threads}, pool_{num_threads} {
+    SILKWORM_ASSERT(lookahead_ > 0);
+}
+
+StateWarmer::~StateWarmer() { clear(); }
+
+void StateWarmer::schedule(const Block& block) {
+    auto touched{std::make_shared<const TouchedState>(collect_touched_state(block))};
+    warmups_.push_back(pool_.submit([this, touched]() { return read_state(*touched); }));
+}
+
+size_t StateWarmer::apply(const db::Buffer& buffer, BaselineAnalysisCache* analysis_cache) {
+    size_t applied{0};
+    while (!warmups_.empty() && warmups_.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        try {
+            const WarmState warm_state{warmups_.front().get()};
+            for (const auto& [address, account] : warm_state.accounts) {
+                buffer.preload_account(address, account);
+            }
+            for (const auto& entry : warm_state.storage) {
+                buffer.preload_storage(entry.address, entry.incarnation, entry.location, entry.value);
+            }
+            if (analysis_cache) {
+                for (const auto& [code_hash, analysis] : warm_state.analyses) {
+                    if (!analysis_cache->contains(code_hash)) {
+                        analysis_cache->put(code_hash, analysis);
+                    }
+                }
+            }
+            ++applied;
+        } catch (...) {
+            // A failed warmup is not an error: execution will read what it needs on its own
+        }
+        warmups_.pop_front();
+    }
+    return applied;
+}
+
+void StateWarmer::clear() {
+    for (auto& warmup : warmups_) {
+        warmup.wait();
+    }
+    warmups_.clear();
+}
+
+bool StateWarmer::claim_analysis(const evmc::bytes32& code_hash) {
+    std::scoped_lock lock{analyzed_mutex_};
+    if (analyzed_.size() >= kMaxAnalyzedCodeHashes) {
+        analyzed_.clear();  // Hot code analyzed again once in a while, in case it's been evicted from the cache
+    }
+    return analyzed_.insert(code_hash).second;
+}
+
+WarmState StateWarmer::read_state(const TouchedState& touched) {
+    WarmState warm_state;
+    auto ro_txn{txn_pool_.acquire()};
+
+    absl::flat_hash_map<evmc::address, uint64_t> incarnations;
+    absl::flat_hash_map<evmc::address, evmc::bytes32> code_hashes;
+    warm_state.accounts.reserve(touched.accounts.size());
+    for (const auto& address : touched.accounts) {
+        if (incarnations.contains(address)) {
+            continue;
+        }
+        auto account{db::read_account(*ro_txn, address)};
+        incarnations.emplace(address, account.has_value() ? account->incarnation : 0);
+        if (account.has_value() && account->code_hash != kEmptyHash) {
+            code_hashes.emplace(address, account->code_hash);
+        }
+        warm_state.accounts.emplace_back(address, std::move(account));
+    }
+
+    if (analyze_code_) {
+        for (const auto& address : touched.callees) {
+            const auto it{code_hashes.find(address)};
+            if (it == code_hashes.end() || !claim_analysis(it->second)) {
+                continue;
+            }
+            if (const auto code{db::read_code(*ro_txn, it->second)}; code.has_value() && !code->empty()) {
+                warm_state.analyses.emplace_back(
+                    it->second, std::make_shared<evmone::baseline::CodeAnalysis>(evmone::baseline::analyze(*code)));
+            }
+        }
+    }
+
+    warm_state.storage.reserve(touched.storage_keys.size());
+    for (const auto& [address, location] : touched.storage_keys) {
+        // Storage is keyed by incarnation: a missing account has no storage to warm up
+        const uint64_t incarnation{incarnations[address]};
+        if (incarnation == 0) {
+            continue;
+        }
+        const evmc::bytes32 value{db::read_storage(*ro_txn, address, incarnation, location)};
+        warm_state.storage.push_back({address, incarnation, location, value});
+    }
+
+    return warm_state;
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,113 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <silkworm/common/hash_maps.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/db/mdbx.hpp>
+#include <silkworm/types/account.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Accounts and storage locations a block is known to touch before executing it
+struct TouchedState {
+    std::vector<evmc::address> accounts;                                // Beneficiary, senders and recipients
+    std::vector<evmc::address> callees;                                 // Recipients, whose code is about to run
+    std::vector<std::pair<evmc::address, evmc::bytes32>> storage_keys;  // From EIP-2930 access lists
+};
+
+//! \brief Collects the state a block is known to touch: beneficiary, senders, recipients and access lists
+//! \remarks Senders must have already been recovered
+TouchedState collect_touched_state(const Block& block);
+
+//! \brief Plain state values read ahead of execution
+struct WarmState {
+    struct StorageEntry {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 location;
+        evmc::bytes32 value;
+    };
+    std::vector<std::pair<evmc::address, std::optional<Account>>> accounts;
+    std::vector<StorageEntry> storage;
+    std::vector<std::pair<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>> analyses;  // By code hash
+};
+
+//! \brief Reads the state touched by upcoming blocks on background threads, each with a read-only transaction
+//! lent by a pool, so that Execution finds it already cached in db::Buffer instead of walking PlainState cold.
+//! Optionally the code of recipients is analyzed too, so that the EVM finds baseline analyses of contracts called for
+//! the first time already cached instead of analyzing them inline.
+//! \remarks Values are read from the last committed snapshot: warmups must be scheduled after the last commit of the
+//! transaction the Buffer works on, and their results are only used for keys the Buffer has not cached yet
+class StateWarmer {
+  public:
+    static constexpr size_t kDefaultLookahead{32};  // Blocks
+    static constexpr size_t kMaxAnalyzedCodeHashes{16'384};
+
+    explicit StateWarmer(mdbx::env env, uint32_t num_threads, size_t lookahead = kDefaultLookahead,
+                         bool analyze_code = false);
+    ~StateWarmer();
+
+    // Not copyable nor movable
+    StateWarmer(const StateWarmer&) = delete;
+    StateWarmer& operator=(const StateWarmer&) = delete;
+
+    //! \brief Max number of blocks to be warmed up ahead of execution
+    [[nodiscard]] size_t lookahead() const noexcept { return lookahead_; }
+
+    //! \brief Number of warmups scheduled and not yet applied
+    [[nodiscard]] size_t pending() const noexcept { return warmups_.size(); }
+
+    //! \brief Schedules the warm up of the state touched by block
+    void schedule(const Block& block);
+
+    //! \brief Seeds buffer (and analysis_cache, if any) with the warmups completed so far (in scheduling order)
+    //! without waiting for others
+    //! \return The number of warmups applied
+    size_t apply(const db::Buffer& buffer, BaselineAnalysisCache* analysis_cache = nullptr);
+
+    //! \brief Waits for all pending warmups and discards them
+    void clear();
+
+  private:
+    WarmState read_state(const TouchedState& touched);
+
+    //! \brief Whether code_hash is to be analyzed, i.e. it has not been lately
+    bool claim_analysis(const evmc::bytes32& code_hash);
+
+    mdbx::env env_;
+    const size_t lookahead_;
+    const bool analyze_code_;
+    std::mutex analyzed_mutex_;
+    FlatHashSet<evmc::bytes32, DigestHasher> analyzed_;  // Code hashes analyzed lately, forgotten once too many
+    db::ROTxnPool txn_pool_;
+    std::deque<std::future<WarmState>> warmups_;
+    thread_pool pool_;  // Declared last: destroyed (joined) first
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,129 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_warmer.hpp"
+
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("Collect touched state") {
+    const auto beneficiary{0x00000000000000000000000000000000000c0001_address};
+    const auto sender{0x00000000000000000000000000000000000a0001_address};
+    const auto recipient{0x00000000000000000000000000000000000b0001_address};
+    const auto contract{0x00000000000000000000000000000000000d0001_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+
+    Block block;
+    block.header.beneficiary = beneficiary;
+    block.transactions.resize(2);
+    block.transactions[0].from = sender;
+    block.transactions[0].to = recipient;
+    block.transactions[1].from = sender;
+    block.transactions[1].access_list = {{contract, {location}}};
+
+    const TouchedState touched{collect_touched_state(block)};
+    CHECK(touched.accounts == std::vector<evmc::address>{beneficiary, sender, recipient, sender, contract});
+    CHECK(touched.callees == std::vector<evmc::address>{recipient});
+    REQUIRE(touched.storage_keys.size() == 1);
+    CHECK(touched.storage_keys[0] == std::pair{contract, location});
+}
+
+TEST_CASE("StateWarmer") {
+    test::Context context;
+
+    const auto address{0x00000000000000000000000000000000000a0001_address};
+    Account account;
+    account.balance = kEther;
+    {
+        auto plain_state{db::open_cursor(context.txn(), db::table::kPlainState)};
+        plain_state.upsert(db::to_slice(address), db::to_slice(account.encode_for_storage()));
+    }
+    context.commit_and_renew_txn();
+
+    Block block;
+    block.header.beneficiary = address;
+
+    StateWarmer warmer{context.env(), /*num_threads=*/1};
+    warmer.schedule(block);
+    CHECK(warmer.pending() == 1);
+
+    // Change the account after the warm up had been scheduled
+    {
+        auto plain_state{db::open_cursor(context.txn(), db::table::kPlainState)};
+        plain_state.erase(db::to_slice(address));
+    }
+
+    db::Buffer buffer{context.txn(), 0};
+    while (warmer.apply(buffer) == 0) {
+        std::this_thread::yield();
+    }
+    CHECK(warmer.pending() == 0);
+
+    // Warmed up value is served from the buffer
+    const auto read_account{buffer.read_account(address)};
+    REQUIRE(read_account.has_value());
+    CHECK(read_account->balance == kEther);
+}
+
+TEST_CASE("StateWarmer analyzes code of recipients") {
+    test::Context context;
+
+    const auto sender{0x00000000000000000000000000000000000a0001_address};
+    const auto contract{0x00000000000000000000000000000000000d0001_address};
+    const Bytes code{*from_hex("600035600055")};
+    const evmc::bytes32 code_hash{to_bytes32(keccak256(code).bytes)};
+    Account account;
+    account.code_hash = code_hash;
+    account.incarnation = kDefaultIncarnation;
+    {
+        auto plain_state{db::open_cursor(context.txn(), db::table::kPlainState)};
+        plain_state.upsert(db::to_slice(contract), db::to_slice(account.encode_for_storage()));
+        auto code_table{db::open_cursor(context.txn(), db::table::kCode)};
+        code_table.upsert(db::to_slice(code_hash), db::to_slice(code));
+    }
+    context.commit_and_renew_txn();
+
+    Block block;
+    block.transactions.resize(2);
+    for (auto& txn : block.transactions) {
+        txn.from = sender;
+        txn.to = contract;
+    }
+
+    StateWarmer warmer{context.env(), /*num_threads=*/1, StateWarmer::kDefaultLookahead, /*analyze_code=*/true};
+    warmer.schedule(block);
+    warmer.schedule(block);  // Code analyzed once only
+
+    BaselineAnalysisCache analysis_cache{16};
+    db::Buffer buffer{context.txn(), 0};
+    size_t applied{0};
+    while (applied < 2) {
+        applied += warmer.apply(buffer, &analysis_cache);
+        std::this_thread::yield();
+    }
+
+    CHECK(analysis_cache.size() == 1);
+    CHECK(analysis_cache.contains(code_hash));
+}
+
+}  // namespace silkworm::stagedsync
@@ -16,14 +16,49 @@
 
 #include "stage_hashstate.hpp"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <silkworm/common/address_hash_cache.hpp>
+#include <silkworm/common/cast.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/util.hpp>
 #include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/changeset_walk.hpp>
+#include <silkworm/db/parallel_walk.hpp>
+#include <silkworm/db/prefetcher.hpp>
 #include <silkworm/db/util.hpp>
 #include <silkworm/etl/collector.hpp>
 
 namespace silkworm::stagedsync {
 
+//! \brief Starts faulting in the PlainState pages of keys about to be looked up (in the same order), if many enough
+//! \return The prefetcher, to be kept alive while looking up (null if not worth it)
+static std::unique_ptr<db::KeyPrefetcher> prefetch_plain_state(::mdbx::env env, std::vector<db::PrefetchKey> keys) {
+    if (keys.size() < db::KeyPrefetcher::kMinKeys) {
+        return nullptr;
+    }
+    auto prefetcher{std::make_unique<db::KeyPrefetcher>(env)};
+    prefetcher->schedule(db::table::kPlainState, std::move(keys));
+    return prefetcher;
+}
+
+//! \brief Whether the change sets of blocks up to block_num are visible to read-only transactions, i.e. committed
+//! \remarks Every block has account changes (at least its beneficiary's) and they're committed along storage ones
+static bool change_sets_committed(::mdbx::env env, BlockNum block_num) {
+    auto ro_txn{env.start_read()};
+    if (!db::has_map(ro_txn, db::table::kAccountChangeSet.name)) {
+        return false;
+    }
+    auto changeset{db::open_cursor(ro_txn, db::table::kAccountChangeSet)};
+    const auto last{changeset.to_last(/*throw_notfound=*/false)};
+    return last.done && endian::load_big_u64(db::from_slice(last.key).data()) >= block_num;
+}
+
 StageResult HashState::forward(db::RWTxn& txn) {
     try {
         throw_if_stopping();
@@ -50,7 +85,7 @@ StageResult HashState::forward(db::RWTxn& txn) {
         reset_log_progress();
 
         if (!previous_progress) {
-            success_or_throw(hash_from_plainstate(txn));
+            success_or_throw(hash_from_plainstate(txn, execution_stage_progress));
             collector_->clear();
             reset_log_progress();
 
@@ -58,6 +93,10 @@ StageResult HashState::forward(db::RWTxn& txn) {
             collector_->clear();
             reset_log_progress();
 
+        } else if (changed_keys_ && changed_keys_->covers(previous_progress, execution_stage_progress)) {
+            success_or_throw(hash_from_changed_keys(txn));
+            reset_log_progress();
+
         } else {
             success_or_throw(hash_from_account_changeset(txn, previous_progress, execution_stage_progress));
             reset_log_progress();
@@ -68,6 +107,9 @@ StageResult HashState::forward(db::RWTxn& txn) {
 
         throw_if_stopping();
         db::stages::write_stage_progress(*txn, db::stages::kHashStateKey, execution_stage_progress);
+        if (!previous_progress && !txn.is_external()) {
+            drop_checkpoint(txn);
+        }
         txn.commit();
 
     } catch (const StageError& ex) {
@@ -87,6 +129,12 @@ StageResult HashState::forward(db::RWTxn& txn) {
 StageResult HashState::unwind(db::RWTxn& txn, BlockNum to) {
     try {
         throw_if_stopping();
+        // A forward interrupted on its way beyond the unwind point must not be resumed: its data is going to change
+        if (const auto checkpoint{db::stages::read_stage_checkpoint(*txn, stage_name_)};
+            checkpoint && checkpoint->target > to) {
+            drop_checkpoint(txn);
+        }
+
         auto previous_progress{db::stages::read_stage_progress(*txn, stage_name_)};
         if (to >= previous_progress) {
             // Nothing to unwind actually
@@ -97,11 +145,21 @@ StageResult HashState::unwind(db::RWTxn& txn, BlockNum to) {
                       {"from", std::to_string(previous_progress), "to", std::to_string(to)});
         }
 
-        success_or_throw(unwind_from_account_changeset(txn, previous_progress, to));
-        reset_log_progress();
+        const size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};
+        if (num_threads > 1 && previous_progress - to >= kMinParallelUnwindBlocks &&
+            change_sets_committed(txn->env(), previous_progress)) {
+            unwind_accounts_in_parallel(txn, previous_progress, to, num_threads);
+            reset_log_progress();
 
-        success_or_throw(unwind_from_storage_changeset(txn, previous_progress, to));
-        reset_log_progress();
+            unwind_storage_in_parallel(txn, previous_progress, to, num_threads);
+            reset_log_progress();
+        } else {
+            success_or_throw(unwind_from_account_changeset(txn, previous_progress, to));
+            reset_log_progress();
+
+            success_or_throw(unwind_from_storage_changeset(txn, previous_progress, to));
+            reset_log_progress();
+        }
 
         throw_if_stopping();
         db::stages::write_stage_progress(*txn, db::stages::kHashStateKey, to);
@@ -125,49 +183,30 @@ StageResult HashState::prune(db::RWTxn&) {
     return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
 }
 
-StageResult HashState::hash_from_plainstate(db::RWTxn& txn) {
-    StageResult ret{StageResult::kSuccess};
-    try {
-        auto source{db::open_cursor(*txn, db::table::kPlainState)};
-        auto data{source.to_first(/*throw_notfound=*/true)};
-
-        // TODO(Andrea) Maybe introduce an assertion for target tables to be empty ?
-
-        /*
-         * This relies on the assumption previous execution stage has completed correctly
-         * and we do nothing more than hashing keys already present in PlainState either
-         * to HashedAccount or to HashedStorage. We don't need to check an upper block
-         * limit as PlainState holds info up to to highest executed block
-         */
-
-        evmc::address last_address{};
-        ethash_hash256 address_hash{keccak256(last_address.bytes)};  // We might have all zeroed addresses ?
-
-        std::unique_lock log_lck(log_mtx_);
-        operation_ = OperationType::Forward;
-        current_source_ = std::string(db::table::kPlainState.name);
-        current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-        log_lck.unlock();
-
-        // New Hashed Storage Entry Key (72 bytes)
-        // + Address hash  (32 bytes)
-        // + Incarnation   ( 8 bytes)
-        // + Location hash (32 bytes)
-        Bytes etl_storage_entry_key(72, '\0');
-
-        // Hash accounts
-        while (data) {
-            auto data_key_view{db::from_slice(data.key)};
-
-            // We're reading PlainState which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
-            if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
-                throw_if_stopping();
-                last_address = to_evmc_address(data_key_view);
-                address_hash = keccak256(last_address.bytes);
-                log_lck.lock();
-                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-                log_lck.unlock();
+namespace {
+
+    //! \brief Turns PlainState records into HashedAccounts and HashedStorage entries collected into an ETL collector
+    //! \remarks PlainState keys are ordered by address (always initial 20 bytes of key): an address is rehashed only
+    //! when it changes. Storage records are walked through all the values of their key at once so as to hash locations
+    //! kKeccakBatchSize at a time
+    class PlainStateHasher {
+      public:
+        //! \brief Invoked each time a new address is reached
+        using AddressCallback = std::function<void(const evmc::address&)>;
+
+        PlainStateHasher(etl::Collector& collector, AddressCallback on_address)
+            : collector_{&collector}, on_address_{std::move(on_address)} {}
+
+        //! \brief Processes the record data refers to or, for storage, all the values of its key leaving the cursor
+        //! on the last of them (see db::WalkFunc)
+        bool operator()(mdbx::cursor& source, mdbx::cursor::move_result& data) {
+            read_ahead_.advise(data.key);
+            const ByteView data_key_view{db::from_slice(data.key)};
+            if (!has_address_ || std::memcmp(data_key_view.data(), last_address_.bytes, kAddressLength) != 0) {
+                last_address_ = to_evmc_address(data_key_view);
+                address_hash_ = keccak256(last_address_.bytes);
+                has_address_ = true;
+                on_address_(last_address_);
             }
 
             if (data.key.length() == kAddressLength) {
@@ -175,11 +214,12 @@ StageResult HashState::hash_from_plainstate(db::RWTxn& txn) {
                 // data.key == Address
                 // data.value == Account encoded for storage (must exist)
                 if (!data.value.length()) {
-                    const std::string what("Unexpected empty value in PlainState for Account " + current_key_);
+                    const std::string what("Unexpected empty value in PlainState for Account " +
+                                           to_hex(last_address_.bytes, /*with_prefix=*/true));
                     throw StageError(StageResult::kUnexpectedError, what);
                 }
 
-                etl::Entry entry{Bytes(address_hash.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
+                etl::Entry entry{Bytes(address_hash_.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
                 collector_->collect(std::move(entry));
 
             } else if (data.key.length() == db::kPlainStoragePrefixLength) {
@@ -187,19 +227,33 @@ StageResult HashState::hash_from_plainstate(db::RWTxn& txn) {
                 // data.key           == Address + Incarnation
                 // data.value (multi) == Location + zeroless Value
 
-                // See above for allocation
-                std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
-                std::memcpy(&etl_storage_entry_key[kHashLength], &data_key_view[kAddressLength],
+                // New Hashed Storage Entry Key (72 bytes)
+                // + Address hash  (32 bytes)
+                // + Incarnation   ( 8 bytes)
+                // + Location hash (32 bytes)
+                std::memcpy(&etl_storage_entry_key_[0], address_hash_.bytes, kHashLength);
+                std::memcpy(&etl_storage_entry_key_[kHashLength], &data_key_view[kAddressLength],
                             db::kIncarnationLength);
 
                 // Iterate dupkeys only to avoid re-hashing of same address
+                // Locations are read and then hashed kKeccakBatchSize at a time: no write happens in between, hence
+                // views on db data stay valid
                 while (data) {
-                    if (!(data.value.length() > kHashLength)) {
-                        const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
-                        const std::string what("Unexpected empty value in PlainState for Account " + current_key_ +
-                                               " incarnation " + std::to_string(incarnation));
-                        throw StageError(StageResult::kUnexpectedError, what);
+                    size_t batch_size{0};
+                    for (; batch_size < kKeccakBatchSize && data; ++batch_size) {
+                        if (!(data.value.length() > kHashLength)) {
+                            const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
+                            const std::string what("Unexpected empty value in PlainState for Account " +
+                                                   to_hex(last_address_.bytes, /*with_prefix=*/true) +
+                                                   " incarnation " + std::to_string(incarnation));
+                            throw StageError(StageResult::kUnexpectedError, what);
+                        }
+                        const ByteView data_value_view{db::from_slice(data.value)};
+                        locations_[batch_size] = data_value_view.substr(0, kHashLength);
+                        values_[batch_size] = data_value_view.substr(kHashLength);
+                        data = source.to_current_next_multi(false);
                     }
+                    keccak256_batch({locations_.data(), batch_size}, hashed_locations_);
 
                     /*
                      * NOTE !
@@ -210,29 +264,130 @@ StageResult HashState::hash_from_plainstate(db::RWTxn& txn) {
                      * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
                      */
 
-                    auto data_value_view{db::from_slice(data.value)};
-                    std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength],
-                                keccak256(data_value_view.substr(0, kHashLength)).bytes, kHashLength);
-                    data_value_view.remove_prefix(kHashLength);
-                    etl::Entry entry{etl_storage_entry_key, Bytes{data_value_view}};
-                    collector_->collect(std::move(entry));
-                    data = source.to_current_next_multi(false);
+                    for (size_t i{0}; i < batch_size; ++i) {
+                        std::memcpy(&etl_storage_entry_key_[kHashLength + db::kIncarnationLength],
+                                    hashed_locations_[i].bytes, kHashLength);
+                        etl::Entry entry{etl_storage_entry_key_, Bytes{values_[i]}};
+                        collector_->collect(std::move(entry));
+                    }
                 }
 
             } else {
                 std::string what{"Unexpected key length " + std::to_string(data.key.length())};
                 throw StageError(StageResult::kUnexpectedError, what);
             }
+            return true;
+        }
 
-            data = source.to_next(/*throw_notfound=*/false);
+      private:
+        etl::Collector* collector_;
+        AddressCallback on_address_;
+        db::ScanReadAhead read_ahead_;
+        bool has_address_{false};
+        evmc::address last_address_{};
+        ethash::hash256 address_hash_{};
+        Bytes etl_storage_entry_key_ = Bytes(db::kHashedStoragePrefixLength + kHashLength, '\0');
+
+        // Storage locations hashed together
+        std::array<ByteView, kKeccakBatchSize> locations_{};
+        std::array<ByteView, kKeccakBatchSize> values_{};
+        std::array<ethash::hash256, kKeccakBatchSize> hashed_locations_{};
+    };
+
+}  // namespace
+
+StageResult HashState::hash_from_plainstate(db::RWTxn& txn, BlockNum target) {
+    StageResult ret{StageResult::kSuccess};
+    try {
+        // TODO(Andrea) Maybe introduce an assertion for target tables to be empty ?
+
+        // Collected entries are persisted and loading commits checkpoints along the way: a checkpoint recorded when
+        // heading to the very same target lets loading resume right after the last key it has committed
+        const bool resumable{!txn.is_external()};
+        const auto manifest_path{checkpoint_manifest_path()};
+        const auto checkpoint{resumable ? db::stages::read_stage_checkpoint(*txn, stage_name_) : std::nullopt};
+        bool checkpointed{false};  // Whether loading goes through persisted files (thus is resumable)
+        if (checkpoint && checkpoint->target == target) {
+            try {
+                collector_->clear();
+                collector_->restore(manifest_path);
+                collector_->set_resume_key(checkpoint->key);
+                checkpointed = true;
+                log::Info(std::string(stage_name_), {"resuming", "from checkpoint", "key", to_hex(checkpoint->key)});
+            } catch (const etl::etl_error& ex) {
+                log::Warning(std::string(stage_name_), {"checkpoint", "discarded", "reason", ex.what()});
+                collector_->clear();
+            }
+        }
+        if (checkpoint && !checkpointed) {
+            // Tables have been partially loaded by a run which cannot be resumed
+            txn->clear_map(db::open_map(*txn, db::table::kHashedAccounts));
+            txn->clear_map(db::open_map(*txn, db::table::kHashedStorage));
+            drop_checkpoint(txn);
         }
 
-        source.close();
+        /*
+         * This relies on the assumption previous execution stage has completed correctly
+         * and we do nothing more than hashing keys already present in PlainState either
+         * to HashedAccount or to HashedStorage. We don't need to check an upper block
+         * limit as PlainState holds info up to to highest executed block
+         */
+
+        std::unique_lock log_lck(log_mtx_);
+        operation_ = OperationType::Forward;
+        current_source_ = std::string(db::table::kPlainState.name);
+        current_key_.clear();
+        log_lck.unlock();
+
+        const PlainStateHasher::AddressCallback on_address{[this](const evmc::address& address) {
+            throw_if_stopping();
+            std::unique_lock lck(log_mtx_);
+            current_key_ = to_hex(address.bytes, /*with_prefix=*/true);
+        }};
+
+        if (!checkpointed) {
+            // Read-only snapshots only see committed data: PlainState can be walked in parallel key ranges unless
+            // this runs within an external transaction
+            const size_t num_partitions{txn.is_external() ? 1u : std::max(1u, std::thread::hardware_concurrency())};
+            if (num_partitions > 1) {
+                txn.force_commit();
+
+                // Each range is hashed into its own collector: collectors are merged back once all ranges are done
+                const size_t buffer_size{std::max(node_settings_->etl_buffer_size / num_partitions, 16_Mebi)};
+                std::mutex collectors_mtx;
+                std::vector<std::unique_ptr<etl::Collector>> collectors;
+                const db::PartitionWalkerFactory make_hasher{[&](mdbx::txn&) -> db::WalkFunc {
+                    std::unique_lock lck(collectors_mtx);
+                    auto& collector{
+                        collectors.emplace_back(std::make_unique<etl::Collector>(node_settings_, buffer_size))};
+                    return PlainStateHasher{*collector, on_address};
+                }};
+                (void)db::parallel_for_each(txn->env(), db::table::kPlainState, num_partitions, make_hasher);
+                for (auto& collector : collectors) {
+                    collector_->merge(*collector);
+                }
+
+            } else {
+                auto source{db::open_cursor(*txn, db::table::kPlainState)};
+                auto data{source.to_first(/*throw_notfound=*/true)};
+                PlainStateHasher hasher{*collector_, on_address};
+                while (data) {
+                    (void)hasher(source, data);
+                    data = source.to_next(/*throw_notfound=*/false);
+                }
+            }
+            if (resumable && collector_->size() > kCheckpointInterval) {
+                collector_->persist(manifest_path);
+                db::stages::write_stage_checkpoint(*txn, stage_name_, {target, {}});
+                txn.force_commit();
+                checkpointed = true;
+            }
+        }
         throw_if_stopping();
 
         if (!collector_->empty()) {
-            auto account_target = db::open_cursor(*txn, db::table::kHashedAccounts);
-            auto storage_target = db::open_cursor(*txn, db::table::kHashedStorage);
+            db::Cursor account_target(*txn, db::table::kHashedAccounts);
+            db::Cursor storage_target(*txn, db::table::kHashedStorage);
 
             // ETL key contains hashed location; for DB put we need to move it from key to value
             const etl::LoadFunc load_func = [&storage_target](const etl::Entry& entry, mdbx::cursor& target,
@@ -263,6 +418,14 @@ StageResult HashState::hash_from_plainstate(db::RWTxn& txn) {
                 std::string(db::table::kHashedAccounts.name) + "+" + std::string(db::table::kHashedStorage.name);
             loading_ = true;
             log_lck.unlock();
+            if (checkpointed) {
+                collector_->set_checkpoint(kCheckpointInterval, [&](ByteView last_key) {
+                    db::stages::write_stage_checkpoint(*txn, stage_name_, {target, Bytes{last_key}});
+                    txn.force_commit();
+                    account_target.bind(txn, db::table::kHashedAccounts);
+                    storage_target.bind(txn, db::table::kHashedStorage);
+                });
+            }
             collector_->load(account_target, load_func, MDBX_put_flags_t::MDBX_APPENDDUP);
         }
 
@@ -406,14 +569,7 @@ StageResult HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum prev
                 auto changeset_value_view{db::from_slice(changeset_data.value)};
                 evmc::address address{to_evmc_address(changeset_value_view)};
                 if (!changed_addresses.contains(address)) {
-                    auto address_hash{to_bytes32(keccak256(address.bytes).bytes)};
-                    auto plainstate_data{source_plainstate.find(db::to_slice(address.bytes), /*throw_notfound=*/false)};
-                    if (plainstate_data.done) {
-                        Bytes current_value{db::from_slice(plainstate_data.value)};
-                        changed_addresses[address] = std::make_pair(address_hash, current_value);
-                    } else {
-                        changed_addresses[address] = std::make_pair(address_hash, Bytes());
-                    }
+                    changed_addresses[address] = std::make_pair(AddressHashCache::instance().hash(address), Bytes());
                 }
                 changeset_data = source_changeset.to_current_next_multi(/*throw_notfound=*/false);
             }
@@ -421,6 +577,20 @@ StageResult HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum prev
             changeset_data = source_changeset.to_next(/*throw_notfound=*/false);
         }
         source_changeset.close();
+
+        // Current values are looked up once all changed addresses are known, so that their pages can be prefetched
+        std::vector<db::PrefetchKey> prefetch_keys;
+        prefetch_keys.reserve(changed_addresses.size());
+        for (const auto& [address, _] : changed_addresses) {
+            prefetch_keys.push_back({Bytes{address.bytes, kAddressLength}});
+        }
+        const auto prefetcher{prefetch_plain_state(txn->env(), std::move(prefetch_keys))};
+        for (auto& [address, entry] : changed_addresses) {
+            auto plainstate_data{source_plainstate.find(db::to_slice(address.bytes), /*throw_notfound=*/false)};
+            if (plainstate_data.done) {
+                entry.second = db::from_slice(plainstate_data.value);
+            }
+        }
         source_plainstate.close();
         ret = write_changes_from_changed_addresses(txn, changed_addresses);
 
@@ -456,7 +626,7 @@ StageResult HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum prev
         BlockNum reached_blocknum{0};
 
         db::StorageChanges storage_changes{};
-        absl::btree_map<evmc::address, evmc::bytes32> hashed_addresses{};
+        FlatAddressMap<evmc::bytes32> hashed_addresses{};
 
         std::unique_lock log_lck(log_mtx_);
         operation_ = OperationType::Forward;
@@ -467,6 +637,7 @@ StageResult HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum prev
 
         auto source_changeset{db::open_cursor(*txn, db::table::kStorageChangeSet)};
         auto source_plainstate{db::open_cursor(*txn, db::table::kPlainState)};
+        const db::ChangeSetFormat changeset_format{db::read_changeset_format(*txn)};
 
         auto source_initial_key{db::block_key(previous_progress + 1)};
         auto changeset_data{source_changeset.lower_bound(db::to_slice(source_initial_key), /*throw_notfound=*/true)};
@@ -494,25 +665,122 @@ StageResult HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum prev
                 throw StageError(StageResult::kUnexpectedError, "Unexpected EOA in StorageChangeset");
             }
             if (!hashed_addresses.contains(address)) {
-                hashed_addresses[address] = to_bytes32(keccak256(address.bytes).bytes);
+                hashed_addresses[address] = AddressHashCache::instance().hash(address);
                 storage_changes[address].insert_or_assign(incarnation, absl::btree_map<evmc::bytes32, Bytes>());
             }
 
-            Bytes plain_storage_prefix{db::storage_prefix(address, incarnation)};
-
             while (changeset_data.done) {
-                auto changeset_value_view{db::from_slice(changeset_data.value)};
-                auto location{to_bytes32(changeset_value_view)};
-                if (!storage_changes[address][incarnation].contains(location)) {
-                    auto plain_state_value{db::find_value_suffix(source_plainstate, plain_storage_prefix, location)};
-                    storage_changes[address][incarnation].insert_or_assign(location,
-                                                                           plain_state_value.value_or(Bytes()));
-                }
+                const auto [location, _]{
+                    db::split_storage_change_value(db::from_slice(changeset_data.value), changeset_format)};
+                storage_changes[address][incarnation].try_emplace(location);
                 changeset_data = source_changeset.to_current_next_multi(/*throw_notfound=*/false);
             }
             changeset_data = source_changeset.to_next(/*throw_notfound=*/false);
         }
 
+        // Current values are looked up once all changed locations are known, so that their pages can be prefetched
+        std::vector<db::PrefetchKey> prefetch_keys;
+        for (const auto& [address, incarnations] : storage_changes) {
+            for (const auto& [incarnation, locations] : incarnations) {
+                const Bytes plain_storage_prefix{db::storage_prefix(address, incarnation)};
+                for (const auto& [location, _] : locations) {
+                    prefetch_keys.push_back({plain_storage_prefix, Bytes{location.bytes, kHashLength}});
+                }
+            }
+        }
+        const auto prefetcher{prefetch_plain_state(txn->env(), std::move(prefetch_keys))};
+        for (auto& [address, incarnations] : storage_changes) {
+            for (auto& [incarnation, locations] : incarnations) {
+                const Bytes plain_storage_prefix{db::storage_prefix(address, incarnation)};
+                for (auto& [location, value] : locations) {
+                    if (const auto plain_state_value{
+                            db::find_value_suffix(source_plainstate, plain_storage_prefix, location)}) {
+                        value = *plain_state_value;
+                    }
+                }
+            }
+        }
+        source_plainstate.close();
+
+        ret = write_changes_from_changed_storage(txn, storage_changes, hashed_addresses);
+
+    } catch (const mdbx::exception& ex) {
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = StageResult::kDbError;
+    } catch (const StageError& ex) {
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = StageResult::kUnexpectedError;
+    } catch (...) {
+        log::Error(std::string(stage_name_), {"function", std::string(__FUNCTION__), "exception", "undefined"});
+        ret = StageResult::kUnexpectedError;
+    }
+
+    return ret;
+}
+
+StageResult HashState::hash_from_changed_keys(db::RWTxn& txn) {
+    StageResult ret{StageResult::kSuccess};
+    try {
+        /*
+         * Same as hash_from_account_changeset and hash_from_storage_changeset but changed keys are already known:
+         * only current values are looked up from PlainState
+         */
+
+        std::unique_lock log_lck(log_mtx_);
+        operation_ = OperationType::Forward;
+        incremental_ = true;
+        current_source_ = "ChangedKeys";
+        current_key_ = std::to_string(changed_keys_->to());
+        log_lck.unlock();
+
+        // Keys are sorted: accounts then storage locations are looked up in the order of PlainState
+        std::vector<db::PrefetchKey> prefetch_keys;
+        prefetch_keys.reserve(changed_keys_->size());
+        for (const auto& address : changed_keys_->accounts()) {
+            prefetch_keys.push_back({Bytes{address.bytes, kAddressLength}});
+        }
+        for (const auto& [address, incarnation, location] : changed_keys_->storage()) {
+            prefetch_keys.push_back({db::storage_prefix(address, incarnation), Bytes{location.bytes, kHashLength}});
+        }
+        const auto prefetcher{prefetch_plain_state(txn->env(), std::move(prefetch_keys))};
+
+        auto source_plainstate{db::open_cursor(*txn, db::table::kPlainState)};
+
+        ChangedAddresses changed_addresses{};
+        for (const auto& address : changed_keys_->accounts()) {
+            auto address_hash{AddressHashCache::instance().hash(address)};
+            auto plainstate_data{source_plainstate.find(db::to_slice(address.bytes), /*throw_notfound=*/false)};
+            if (plainstate_data.done) {
+                changed_addresses[address] = std::make_pair(address_hash, Bytes{db::from_slice(plainstate_data.value)});
+            } else {
+                changed_addresses[address] = std::make_pair(address_hash, Bytes());
+            }
+        }
+        success_or_throw(write_changes_from_changed_addresses(txn, changed_addresses));
+        changed_addresses.clear();
+        throw_if_stopping();
+
+        db::StorageChanges storage_changes{};
+        FlatAddressMap<evmc::bytes32> hashed_addresses{};
+        Bytes plain_storage_prefix;
+        for (const auto& [address, incarnation, location] : changed_keys_->storage()) {
+            if (!incarnation) {
+                throw StageError(StageResult::kUnexpectedError, "Unexpected EOA in changed storage");
+            }
+            if (!hashed_addresses.contains(address)) {
+                hashed_addresses[address] = AddressHashCache::instance().hash(address);
+            }
+            plain_storage_prefix = db::storage_prefix(address, incarnation);
+            auto plain_state_value{db::find_value_suffix(source_plainstate, plain_storage_prefix, location)};
+            storage_changes[address][incarnation].insert_or_assign(location, plain_state_value.value_or(Bytes()));
+        }
+        source_plainstate.close();
         ret = write_changes_from_changed_storage(txn, storage_changes, hashed_addresses);
 
     } catch (const mdbx::exception& ex) {
@@ -586,7 +854,7 @@ StageResult HashState::unwind_from_account_changeset(db::RWTxn& txn, BlockNum pr
 
                 if (!changed_addresses.contains(address)) {
                     changeset_value_view.remove_prefix(kAddressLength);
-                    auto address_hash{to_bytes32(keccak256(address.bytes).bytes)};
+                    auto address_hash{AddressHashCache::instance().hash(address)};
                     Bytes previous_value(changeset_value_view.data(), changeset_value_view.length());
                     changed_addresses[address] = std::make_pair(address_hash, previous_value);
                 }
@@ -639,7 +907,7 @@ StageResult HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum pr
         BlockNum reached_blocknum{0};
 
         db::StorageChanges storage_changes{};
-        absl::btree_map<evmc::address, evmc::bytes32> hashed_addresses{};
+        FlatAddressMap<evmc::bytes32> hashed_addresses{};
 
         std::unique_lock log_lck(log_mtx_);
         operation_ = OperationType::Unwind;
@@ -649,6 +917,7 @@ StageResult HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum pr
         log_lck.unlock();
 
         auto source_changeset{db::open_cursor(*txn, db::table::kStorageChangeSet)};
+        const db::ChangeSetFormat changeset_format{db::read_changeset_format(*txn)};
         auto source_initial_key{db::block_key(to + 1)};
         auto changeset_data{source_changeset.lower_bound(db::to_slice(source_initial_key), /*throw_notfound=*/true)};
 
@@ -674,17 +943,15 @@ StageResult HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum pr
                 throw std::runtime_error("Unexpected EOA in StorageChangeset");
             }
             if (!hashed_addresses.contains(address)) {
-                hashed_addresses[address] = to_bytes32(keccak256(address.bytes).bytes);
+                hashed_addresses[address] = AddressHashCache::instance().hash(address);
                 storage_changes[address].insert_or_assign(incarnation, absl::btree_map<evmc::bytes32, Bytes>());
             }
 
             while (changeset_data.done) {
-                auto changeset_value_view{db::from_slice(changeset_data.value)};
-                auto location{to_bytes32(changeset_value_view)};
+                const auto [location, previous_value]{
+                    db::split_storage_change_value(db::from_slice(changeset_data.value), changeset_format)};
                 if (!storage_changes[address][incarnation].contains(location)) {
-                    changeset_value_view.remove_prefix(kHashLength);
-                    Bytes previous_value{changeset_value_view};
-                    storage_changes[address][incarnation].insert_or_assign(location, previous_value);
+                    storage_changes[address][incarnation].insert_or_assign(location, Bytes{previous_value});
                 }
                 changeset_data = source_changeset.to_current_next_multi(/*throw_notfound=*/false);
             }
@@ -713,6 +980,132 @@ StageResult HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum pr
     return ret;
 }
 
+void HashState::unwind_accounts_in_parallel(db::RWTxn& txn, BlockNum previous_progress, BlockNum to,
+                                            size_t num_threads) {
+    // The earliest change of each address in (to, previous_progress] holds its value at block `to`
+    struct RevertedAccount {
+        BlockNum block_num{0};
+        evmc::bytes32 address_hash;
+        Bytes value;
+    };
+
+    std::unique_lock log_lck(log_mtx_);
+    operation_ = OperationType::Unwind;
+    current_source_ = std::string(db::table::kAccountChangeSet.name);
+    current_key_ = std::to_string(to + 1);
+    log_lck.unlock();
+
+    std::vector<FlatAddressMap<RevertedAccount>> worker_accounts(num_threads);
+    db::parallel_for_each_account_change(
+        txn->env(), to + 1, previous_progress, num_threads, kUnwindRangesPerThread,
+        [&](size_t worker, const db::AccountChange& change) {
+            throw_if_stopping();
+            // The first change met by a worker is its earliest one
+            auto& accounts{worker_accounts[worker]};
+            const evmc::address address{to_evmc_address(change.address)};
+            if (!accounts.contains(address)) {
+                const evmc::bytes32 address_hash{bit_cast<evmc_bytes32>(keccak256(address.bytes))};
+                accounts.emplace(address, RevertedAccount{change.block_num, address_hash, Bytes{change.value}});
+            }
+        });
+    throw_if_stopping();
+
+    ChangedAddresses changed_addresses{};
+    absl::btree_map<evmc::address, BlockNum> reverted_at;
+    for (auto& accounts : worker_accounts) {
+        for (auto& [address, account] : accounts) {
+            const auto [it, inserted]{reverted_at.try_emplace(address, account.block_num)};
+            if (inserted || account.block_num < it->second) {
+                it->second = account.block_num;
+                changed_addresses[address] = std::make_pair(account.address_hash, std::move(account.value));
+            }
+        }
+        accounts.clear();
+    }
+    if (!changed_addresses.empty()) {
+        success_or_throw(write_changes_from_changed_addresses(txn, changed_addresses));
+    }
+}
+
+void HashState::unwind_storage_in_parallel(db::RWTxn& txn, BlockNum previous_progress, BlockNum to,
+                                           size_t num_threads) {
+    // The earliest change of each location in (to, previous_progress] holds its value at block `to`
+    struct RevertedLocation {
+        BlockNum block_num{0};
+        evmc::bytes32 location_hash;
+        Bytes value;
+    };
+
+    std::unique_lock log_lck(log_mtx_);
+    operation_ = OperationType::Unwind;
+    incremental_ = true;
+    current_source_ = std::string(db::table::kStorageChangeSet.name);
+    current_key_ = std::to_string(to + 1);
+    log_lck.unlock();
+
+    std::vector<absl::btree_map<db::ChangedKeys::StorageKey, RevertedLocation>> worker_locations(num_threads);
+    db::parallel_for_each_storage_change(
+        txn->env(), to + 1, previous_progress, num_threads, kUnwindRangesPerThread,
+        [&](size_t worker, const db::StorageChange& change) {
+            throw_if_stopping();
+            if (!change.incarnation) {
+                throw std::runtime_error("Unexpected EOA in StorageChangeset");
+            }
+            // The first change met by a worker is its earliest one
+            auto& locations{worker_locations[worker]};
+            const db::ChangedKeys::StorageKey key{to_evmc_address(change.address), change.incarnation,
+                                                  change.location};
+            if (!locations.contains(key)) {
+                const evmc::bytes32 location_hash{bit_cast<evmc_bytes32>(keccak256(change.location.bytes))};
+                locations.emplace(key, RevertedLocation{change.block_num, location_hash, Bytes{change.value}});
+            }
+        });
+    throw_if_stopping();
+
+    // Merge keeping the earliest change of each location, then sort by HashedStorage key for one sequential pass
+    struct HashedStorageWrite {
+        evmc::bytes32 address_hash;
+        uint64_t incarnation{0};
+        evmc::bytes32 location_hash;
+        BlockNum block_num{0};
+        Bytes value;
+    };
+    std::vector<HashedStorageWrite> writes;
+    for (auto& locations : worker_locations) {
+        for (auto& [key, location] : locations) {
+            writes.push_back({AddressHashCache::instance().hash(key.address), key.incarnation, location.location_hash,
+                              location.block_num, std::move(location.value)});
+        }
+        locations.clear();
+    }
+    std::sort(writes.begin(), writes.end(), [](const HashedStorageWrite& lhs, const HashedStorageWrite& rhs) {
+        return std::tie(lhs.address_hash, lhs.incarnation, lhs.location_hash, lhs.block_num) <
+               std::tie(rhs.address_hash, rhs.incarnation, rhs.location_hash, rhs.block_num);
+    });
+
+    log_lck.lock();
+    loading_ = true;
+    current_target_ = std::string(db::table::kHashedStorage.name);
+    log_lck.unlock();
+
+    auto target_hashed_storage{db::open_cursor(*txn, db::table::kHashedStorage)};
+    Bytes hashed_storage_prefix(db::kHashedStoragePrefixLength, '\0');  // One allocation only
+    const HashedStorageWrite* previous{nullptr};
+    for (const auto& write : writes) {
+        if (previous && previous->address_hash == write.address_hash && previous->incarnation == write.incarnation &&
+            previous->location_hash == write.location_hash) {
+            continue;  // A later change of the same location
+        }
+        if (!previous || previous->address_hash != write.address_hash) {
+            throw_if_stopping();
+        }
+        previous = &write;
+        std::memcpy(&hashed_storage_prefix[0], write.address_hash.bytes, kHashLength);
+        endian::store_big_u64(&hashed_storage_prefix[kHashLength], write.incarnation);
+        db::upsert_storage_value(target_hashed_storage, hashed_storage_prefix, write.location_hash.bytes, write.value);
+    }
+}
+
 StageResult HashState::write_changes_from_changed_addresses(db::RWTxn& txn, const ChangedAddresses& changed_addresses) {
     throw_if_stopping();
 
@@ -729,12 +1122,21 @@ StageResult HashState::write_changes_from_changed_addresses(db::RWTxn& txn, cons
     Bytes plain_code_key(kAddressLength + db::kIncarnationLength, '\0');  // Only one allocation
     Bytes hashed_code_key(kHashLength + db::kIncarnationLength, '\0');    // Only one allocation
 
-    evmc::address last_address{};
-
-    for (const auto& [address, pair] : changed_addresses) {
-        if (address != last_address) {
+    // Written in the order of HashedAccounts (and HashedCodeHash) keys, i.e. of hashes, for a sequential pass
+    std::vector<const ChangedAddresses::value_type*> entries;
+    entries.reserve(changed_addresses.size());
+    for (const auto& entry : changed_addresses) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto* lhs, const auto* rhs) {
+        return lhs->second.first < rhs->second.first;
+    });
+
+    size_t count{0};
+    for (const auto* entry : entries) {
+        const auto& [address, pair]{*entry};
+        if (++count % 1024 == 0) {
             throw_if_stopping();
-            last_address = address;
             log_lck.lock();
             current_key_ = to_hex(address, true);
             log_lck.unlock();
@@ -771,7 +1173,7 @@ StageResult HashState::write_changes_from_changed_addresses(db::RWTxn& txn, cons
 
 StageResult HashState::write_changes_from_changed_storage(
     db::RWTxn& txn, db::StorageChanges& storage_changes,
-    const absl::btree_map<evmc::address, evmc::bytes32>& hashed_addresses) {
+    const FlatAddressMap<evmc::bytes32>& hashed_addresses) {
     throw_if_stopping();
     auto target_hashed_storage{db::open_cursor(*txn, db::table::kHashedStorage)};
 
@@ -782,6 +1184,8 @@ StageResult HashState::write_changes_from_changed_storage(
 
     evmc::address last_address{};
     Bytes hashed_storage_prefix(db::kHashedStoragePrefixLength, '\0');  // One allocation only
+    std::array<ByteView, kKeccakBatchSize> locations;
+    std::array<ethash::hash256, kKeccakBatchSize> hashed_locations;
     for (const auto& [address, data] : storage_changes) {
         if (address != last_address) {
             throw_if_stopping();
@@ -795,9 +1199,18 @@ StageResult HashState::write_changes_from_changed_storage(
 
         for (const auto& [incarnation, data1] : data) {
             endian::store_big_u64(&hashed_storage_prefix[kHashLength], incarnation);
-            for (const auto& [location, value] : data1) {
-                auto hashed_location{keccak256(location.bytes)};
-                db::upsert_storage_value(target_hashed_storage, hashed_storage_prefix, hashed_location.bytes, value);
+            for (auto it{data1.begin()}; it != data1.end();) {
+                const auto batch_begin{it};
+                size_t batch_size{0};
+                for (; batch_size < kKeccakBatchSize && it != data1.end(); ++batch_size, ++it) {
+                    locations[batch_size] = it->first;
+                }
+                keccak256_batch({locations.data(), batch_size}, hashed_locations);
+                it = batch_begin;
+                for (size_t i{0}; i < batch_size; ++i, ++it) {
+                    db::upsert_storage_value(target_hashed_storage, hashed_storage_prefix, hashed_locations[i].bytes,
+                                             it->second);
+                }
             }
         }
     }
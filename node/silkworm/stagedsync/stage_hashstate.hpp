@@ -16,30 +16,40 @@
 
 #pragma once
 
+#include <silkworm/common/hash_maps.hpp>
+#include <silkworm/db/changed_keys.hpp>
 #include <silkworm/stagedsync/common.hpp>
 
 namespace silkworm::stagedsync {
 
 class HashState final : public IStage {
   public:
-    explicit HashState(NodeSettings* node_settings)
+    //! \param [in] changed_keys : if not null, the keys changed by Execution in the same sync cycle, which spare the
+    //! scans of change sets whenever they cover the blocks to hash (see db::ChangedKeys)
+    explicit HashState(NodeSettings* node_settings, const db::ChangedKeys* changed_keys = nullptr)
         : IStage(db::stages::kHashStateKey, node_settings),
-          collector_(std::make_unique<etl::Collector>(node_settings)){};
+          collector_(std::make_unique<etl::Collector>(node_settings)),
+          changed_keys_{changed_keys} {};
     ~HashState() override = default;
     StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* input_source() const final { return db::stages::kExecutionKey; }
     StageResult unwind(db::RWTxn& txn, BlockNum to) final;
     StageResult prune(db::RWTxn& txn) final;
     std::vector<std::string> get_log_progress() final;
 
   private:
+    static constexpr BlockNum kMinParallelUnwindBlocks{1'000};  // Shorter unwinds read change sets on one thread
+    static constexpr size_t kUnwindRangesPerThread{16};
+
     //! \brief Store already processed addresses to avoid rehashing and multiple lookups
     //! \struct Address -> Address Hash -> Value
     using ChangedAddresses = absl::btree_map<evmc::address, std::pair<evmc::bytes32, Bytes>>;
 
     //! \brief Transforms PlainState into HashedAccounts and HashedStorage respectively in one single read pass over
     //! PlainState \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding
-    //! from 0)
-    StageResult hash_from_plainstate(db::RWTxn& txn);
+    //! from 0). Unless within an external transaction, loading commits a checkpoint every kCheckpointInterval
+    //! entries: a run interrupted afterwards resumes from the last one, provided Execution is still at target
+    StageResult hash_from_plainstate(db::RWTxn& txn, BlockNum target);
 
     //! \brief Transforms PlainCodeHash into HashedCodeHash in one single read pass over PlainCodeHash
     //! \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding from 0)
@@ -54,18 +64,34 @@ class HashState final : public IStage {
     //! locations.
     StageResult hash_from_storage_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to);
 
+    //! \brief Hashes the accounts and storage locations in changed_keys_, as hash_from_account_changeset and
+    //! hash_from_storage_changeset would do for the same blocks
+    StageResult hash_from_changed_keys(db::RWTxn& txn);
+
     //! \brief Detects account changes from AccountChangeSet and reverts hashed states
     StageResult unwind_from_account_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to);
 
     //! \brief Detects storage changes from StorageChangeSet and reverts hashed states
     StageResult unwind_from_storage_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to);
 
-    //! \brief Writes to db the changes collected from account changeset scan either in forward or unwind mode
+    //! \brief Same as unwind_from_account_changeset but AccountChangeSet is read in block ranges on parallel threads,
+    //! which also hash the addresses and keep the earliest previous values. Throws on failure
+    //! \remarks Change sets of blocks in (to, previous_progress] must be committed
+    void unwind_accounts_in_parallel(db::RWTxn& txn, BlockNum previous_progress, BlockNum to, size_t num_threads);
+
+    //! \brief Same as unwind_from_storage_changeset but StorageChangeSet is read in block ranges on parallel threads,
+    //! which also hash the locations and keep the earliest previous values. Writes are then applied in the order of
+    //! HashedStorage keys. Throws on failure
+    //! \remarks Change sets of blocks in (to, previous_progress] must be committed
+    void unwind_storage_in_parallel(db::RWTxn& txn, BlockNum previous_progress, BlockNum to, size_t num_threads);
+
+    //! \brief Writes to db the changes collected from account changeset scan either in forward or unwind mode, in the
+    //! order of HashedAccounts keys
     StageResult write_changes_from_changed_addresses(db::RWTxn& txn, const ChangedAddresses& changed_addresses);
 
     //! \brief Writes to db the changes collected from storage changeset scan either in forward or unwind mode
     StageResult write_changes_from_changed_storage(db::RWTxn& txn, db::StorageChanges& storage_changes,
-                                                   const absl::btree_map<evmc::address, evmc::bytes32>& hashed_addresses);
+                                                   const FlatAddressMap<evmc::bytes32>& hashed_addresses);
 
     //! \brief Resets all fields related to log progress tracking
     void reset_log_progress();
@@ -78,6 +104,7 @@ class HashState final : public IStage {
     std::string current_target_;                 // Current target of transformed data
     std::string current_key_;                    // Actual processing key
     std::unique_ptr<etl::Collector> collector_;  // Collector (used only in !incremental_)
+    const db::ChangedKeys* changed_keys_;        // Keys changed by Execution (if any)
 };
 
 } // namespace silkworm::stagedsync
@@ -14,12 +14,28 @@
    limitations under the License.
 */
 
-#include <unordered_map>
+#include "stage_history_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
 
 #include <silkworm/common/cast.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/changeset_walk.hpp>
+#include <silkworm/db/history_delta.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/etl/collector.hpp>
 
@@ -29,121 +45,271 @@ namespace silkworm::stagedsync {
 
 static constexpr size_t kBitmapBufferSizeLimit = 256_Mebi;
 
-namespace fs = std::filesystem;
+// Forward runs up to this many blocks append deltas rather than chunks (see NodeSettings::history_index_deltas)
+static constexpr BlockNum kMaxDeltaBlocks{128};
 
-static StageResult history_index_stage(db::RWTxn& txn, const std::filesystem::path& etl_path, bool storage) {
-    fs::create_directories(etl_path);
+// Deltas are folded into chunks once they are this many (i.e. a few hundred blocks worth of changes on mainnet)
+static constexpr size_t kMaxHistoryDeltas{1'000'000};
 
-    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
-    std::unordered_map<std::string, roaring::Roaring64Map> bitmaps;
+namespace fs = std::filesystem;
 
-    auto flush_bitmaps_to_etl = [&collector, &bitmaps] {
-        for (const auto& [bitmap_key, bitmap] : bitmaps) {
-            Bytes bitmap_bytes(bitmap.getSizeInBytes(), '\0');
+//! \brief Bitmaps of blocks changing each account (Address) or storage location (Address + Location), flushed into a
+//! collector whenever they grow past a size limit. Hence many bitmaps of the same key may be collected
+template <size_t KeySize>
+class HistoryBitmaps {
+  public:
+    using Key = std::array<uint8_t, KeySize>;
+
+    HistoryBitmaps(etl::Collector& collector, size_t size_limit) : collector_{collector}, size_limit_{size_limit} {}
+
+    void add(const Key& key, BlockNum block_number) {
+        auto [it, inserted]{bitmaps_.try_emplace(key)};
+        it->second.add(block_number);
+        allocated_space_ += inserted ? 64 + 8 : 8;
+        if (allocated_space_ > size_limit_) {
+            flush();
+        }
+    }
+
+    void flush() {
+        Bytes bitmap_bytes;
+        for (const auto& [bitmap_key, bitmap] : bitmaps_) {
+            bitmap_bytes.resize(bitmap.getSizeInBytes());
             bitmap.write(byte_ptr_cast(bitmap_bytes.data()));
-            collector.collect(etl::Entry{Bytes(byte_ptr_cast(bitmap_key.c_str()), bitmap_key.size()), bitmap_bytes});
+            collector_.collect({Bytes{bitmap_key.data(), bitmap_key.size()}, bitmap_bytes});
         }
-        bitmaps.clear();
-    };
+        bitmaps_.clear();
+        allocated_space_ = 0;
+    }
+
+  private:
+    etl::Collector& collector_;
+    const size_t size_limit_;
+    absl::flat_hash_map<Key, roaring::Roaring64Map> bitmaps_;
+    size_t allocated_space_{0};
+};
+
+//! \brief Collects bitmaps of blocks changing each account (or storage location) from changesets of blocks
+//! [block_from, block_to]
+//! \return The last block number reached
+template <size_t KeySize>
+static BlockNum history_index_extract_range(mdbx::txn& txn, etl::Collector& collector, BlockNum block_from,
+                                            BlockNum block_to, size_t size_limit, bool storage) {
+    HistoryBitmaps<KeySize> bitmaps{collector, size_limit};
 
     // We take data from changesets and turn it to indexes, so from [Block Number => Location] to [Location => Block
     // Number]
-    db::MapConfig changeset_config = storage ? db::table::kStorageChangeSet : db::table::kAccountChangeSet;
-    db::MapConfig index_config = storage ? db::table::kStorageHistory : db::table::kAccountHistory;
-    const char* stage_key = storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey;
+    BlockNum block_number{0};
+    typename HistoryBitmaps<KeySize>::Key composite_key;
+    if (storage) {
+        block_number = db::for_each_storage_change(txn, block_from, block_to, [&](const db::StorageChange& change) {
+            // Storage: Address + Location
+            std::memcpy(composite_key.data(), change.address.data(), kAddressLength);
+            std::memcpy(&composite_key[kAddressLength], change.location.bytes, kHashLength);
+            bitmaps.add(composite_key, change.block_num);
+        });
+    } else {
+        block_number = db::for_each_account_change(txn, block_from, block_to, [&](const db::AccountChange& change) {
+            std::memcpy(composite_key.data(), change.address.data(), kAddressLength);
+            bitmaps.add(composite_key, change.block_num);
+        });
+    }
+    bitmaps.flush();
+    return block_number;
+}
 
-    auto changeset_table{db::open_cursor(*txn, changeset_config)};
-    auto last_processed_block_number{db::stages::read_stage_progress(*txn, stage_key)};
-    Bytes start{db::block_key(last_processed_block_number + 1)};
+//! \brief Collects bitmaps of blocks changing each account (or storage location) from changesets of blocks from
+//! block_from onwards. If txn is read-only, large block ranges are split into smaller ones taken by parallel threads,
+//! each on its own snapshot and collecting into its own collector eventually merged into collector
+//! \return The last block number reached
+//! \remarks Other snapshots see the same changesets txn does only if txn is read-only: write transactions see
+//! uncommitted data, hence get processed on a single thread. Bitmaps of the same key collected by different threads
+//! are unioned at load time (see history_index_load)
+static BlockNum history_index_extract(mdbx::txn& txn, etl::Collector& collector, BlockNum block_from, bool storage,
+                                      const fs::path& etl_path, size_t buffer_size) {
+    static constexpr BlockNum kMinParallelBlocks{10'000};
+    static constexpr size_t kRangesPerThread{16};
+
+    const auto extract_range{storage ? &history_index_extract_range<kAddressLength + kHashLength>
+                                     : &history_index_extract_range<kAddressLength>};
+    const db::MapConfig changeset_config{storage ? db::table::kStorageChangeSet : db::table::kAccountChangeSet};
+
+    log::Info() << "Started " << (storage ? "Storage" : "Account") << " Index Extraction. From: " << block_from;
+
+    BlockNum block_to{0};
+    if (txn.is_readonly()) {
+        auto changeset_table{db::open_cursor(txn, changeset_config)};
+        if (const auto last{changeset_table.to_last(/*throw_notfound=*/false)}; last) {
+            block_to = endian::load_big_u64(static_cast<uint8_t*>(last.key.data()));
+        }
+    }
+    const size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (block_to < block_from || block_to - block_from + 1 < kMinParallelBlocks || num_threads == 1) {
+        const BlockNum block_number{extract_range(txn, collector, block_from, std::numeric_limits<BlockNum>::max(),
+                                                  kBitmapBufferSizeLimit, storage)};
+        log::Info() << "Latest Block: " << block_number;
+        return block_number;
+    }
 
-    // Extract
-    log::Info() << "Started " << (storage ? "Storage" : "Account")
-                << " Index Extraction. From: " << (last_processed_block_number + 1);
+    // Both bitmaps and collectors memory budgets are shared among threads
+    const size_t thread_size_limit{kBitmapBufferSizeLimit / num_threads};
+    const size_t thread_buffer_size{std::max(buffer_size / num_threads, 16_Mebi)};
+    std::vector<std::unique_ptr<etl::Collector>> collectors;
+    for (size_t i{0}; i < num_threads; ++i) {
+        collectors.push_back(std::make_unique<etl::Collector>(etl_path, thread_buffer_size));
+    }
+    db::parallel_for_block_ranges(txn.env(), block_from, block_to, num_threads, kRangesPerThread,
+                                  [&](size_t worker, mdbx::txn& ro_txn, BlockNum from, BlockNum to) {
+                                      (void)extract_range(ro_txn, *collectors[worker], from, to, thread_size_limit,
+                                                          storage);
+                                  });
+
+    for (auto& thread_collector : collectors) {
+        collector.merge(*thread_collector);
+    }
+    log::Info() << "Latest Block: " << block_to;
+    return block_to;
+}
 
-    size_t allocated_space{0};
-    BlockNum block_number{0};
-    auto data{changeset_table.lower_bound(db::to_slice(start))};
-    while (data) {
-        std::string composite_key;
-        auto key{db::from_slice(data.key)};
-        auto value{db::from_slice(data.value)};
-        auto [db_key, _]{db::changeset_to_plainstate_format(key, value)};
-        // Make the composite key accordingly whether we are dealing with storages or accounts
-        if (storage) {
-            // Storage: Address + Location
-            composite_key.resize(kAddressLength + kHashLength);
-            std::memcpy(&composite_key[0], &db_key[0], kAddressLength);
-            std::memcpy(&composite_key[kAddressLength], &db_key[kAddressLength + db::kIncarnationLength], kHashLength);
-        } else {
-            // Account: Address
-            composite_key = std::string(data.value.char_ptr(), kAddressLength);
+//! \brief Loads collected bitmaps into AccountHistory (or StorageHistory) merging them with unfinished chunks
+//! \param [in] checkpoint_target : if set, loading commits a checkpoint heading to it every kCheckpointInterval keys
+//! \remarks Collected bitmaps of the same key (i.e. from different flushes or threads) are unioned before being cut
+//! into chunks, so the order they were collected in does not matter
+static void history_index_load(db::RWTxn& txn, etl::Collector& collector, bool append, bool storage,
+                               std::optional<BlockNum> checkpoint_target = std::nullopt) {
+    const db::MapConfig index_config{storage ? db::table::kStorageHistory : db::table::kAccountHistory};
+    db::Cursor target(txn, index_config);
+    const MDBX_put_flags_t load_flags{append ? MDBX_put_flags_t::MDBX_APPEND : MDBX_put_flags_t::MDBX_UPSERT};
+
+    Bytes pending_key;
+    roaring::Roaring64Map pending_bitmap;
+    const auto write_chunks{[&](mdbx::cursor& history_index_table) {
+        if (pending_key.empty()) {
+            return;
         }
-        // Initialize composite key if needed
-        if (bitmaps.find(composite_key) == bitmaps.end()) {
-            bitmaps.emplace(composite_key, roaring::Roaring64Map());
+        auto put_flags{load_flags};
+        // Check whether we still need to rework the previous entry
+        Bytes last_chunk_index(pending_key.size() + 8, '\0');
+        std::memcpy(&last_chunk_index[0], &pending_key[0], pending_key.size());
+        endian::store_big_u64(&last_chunk_index[pending_key.size()], UINT64_MAX);
+        auto previous_bitmap_bytes{history_index_table.find(db::to_slice(last_chunk_index), false)};
+        // If we have an unfinished bitmap for the current location then continue working on it
+        if (previous_bitmap_bytes) {
+            // Merge previous and current bitmap
+            pending_bitmap |= roaring::Roaring64Map::readSafe(previous_bitmap_bytes.value.char_ptr(),
+                                                              previous_bitmap_bytes.value.length());
+            put_flags = MDBX_put_flags_t::MDBX_UPSERT;
         }
-        // Add block number to the bitmap of current key
-        block_number = endian::load_big_u64(static_cast<uint8_t*>(data.key.data()));
-        bitmaps.at(composite_key).add(block_number);
-        allocated_space += 8;
-        // Flush to ETL
-        if (64 * bitmaps.size() + allocated_space > kBitmapBufferSizeLimit) {
-            flush_bitmaps_to_etl();
-            allocated_space = 0;
-            log::Info() << "Current Block: " << block_number;
+        while (pending_bitmap.cardinality() > 0) {
+            // Divide in different bitmaps of different (chunks) and push all of them individually
+            auto current_chunk{db::bitmap::cut_left(pending_bitmap, db::bitmap::kBitmapChunkLimit)};
+            // Make chunk index (Location + Suffix )
+            Bytes chunk_index(pending_key.size() + 8, '\0');
+            std::memcpy(&chunk_index[0], &pending_key[0], pending_key.size());
+            // Suffix is either the maximum Block Number of the bitmap or if it's the last chunk: UINT64_MAX
+            BlockNum suffix{pending_bitmap.cardinality() == 0 ? UINT64_MAX : current_chunk.maximum()};
+            endian::store_big_u64(&chunk_index[pending_key.size()], suffix);
+            // Push chunk to database
+            Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
+            current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
+            mdbx::slice k{db::to_slice(chunk_index)};
+            mdbx::slice v{db::to_slice(current_chunk_bytes)};
+            mdbx::error::success_or_throw(history_index_table.put(k, &v, put_flags));
         }
-        data = changeset_table.to_next(/*throw_notfound*/ false);
+        pending_key.clear();
+    }};
+
+    if (checkpoint_target) {
+        const char* stage_key{storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey};
+        collector.set_checkpoint(IStage::kCheckpointInterval, [&](ByteView last_key) {
+            // Checkpoints come in between keys: all bitmaps of the pending one (i.e. last_key) have been collected
+            write_chunks(target);
+            db::stages::write_stage_checkpoint(*txn, stage_key, {*checkpoint_target, Bytes{last_key}});
+            txn.force_commit();
+            target.bind(txn, index_config);
+        });
     }
-    changeset_table.close();
-    if (allocated_space != 0) {
-        flush_bitmaps_to_etl();
+
+    // Eventually load collected items WITH transform (may throw)
+    collector.load(
+        target,
+        [&](const etl::Entry& entry, mdbx::cursor& history_index_table, MDBX_put_flags_t) {
+            auto bm{roaring::Roaring64Map::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
+            if (entry.key == pending_key) {
+                pending_bitmap |= bm;
+                return;
+            }
+            write_chunks(history_index_table);
+            pending_key = entry.key;
+            pending_bitmap = std::move(bm);
+        },
+        load_flags);
+    write_chunks(target);
+}
+
+//! \brief Appends collected bitmaps to AccountHistoryDelta (or StorageHistoryDelta) leaving chunks untouched
+//! \remarks Collected blocks must be above all the ones of chunks, which holds for forward runs from stage progress
+static void history_index_append_deltas(db::RWTxn& txn, etl::Collector& collector, bool storage) {
+    db::Cursor target(txn, db::history_delta_config(storage));
+    collector.load(
+        target,
+        [](const etl::Entry& entry, mdbx::cursor& delta_table, MDBX_put_flags_t) {
+            const auto blocks{roaring::Roaring64Map::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
+            db::append_history_deltas(delta_table, entry.key, blocks);
+        },
+        MDBX_put_flags_t::MDBX_UPSERT);
+}
+
+//! \brief Folds all deltas of AccountHistoryDelta (or StorageHistoryDelta) into chunks, leaving it empty
+//! \param [in] min_deltas : folding takes place only if there are at least this many deltas
+//! \remarks Chunks must not grow past deltas: any load of chunks has to fold them first
+static void history_index_fold_deltas(db::RWTxn& txn, const fs::path& etl_path, bool storage, size_t min_deltas = 1) {
+    const auto delta_map{db::open_map(*txn, db::history_delta_config(storage))};
+    const size_t num_deltas{txn->get_map_stat(delta_map).ms_entries};
+    if (num_deltas == 0 || num_deltas < min_deltas) {
+        return;
     }
 
-    log::Info() << "Latest Block: " << block_number;
+    etl::Collector collector(etl_path, /* flush size */ 64_Mebi);
+    auto delta_table{txn->open_cursor(delta_map)};
+    Bytes bitmap_bytes;
+    const auto collect{[&](ByteView key, const roaring::Roaring64Map& blocks) {
+        bitmap_bytes.resize(blocks.getSizeInBytes());
+        blocks.write(byte_ptr_cast(bitmap_bytes.data()));
+        collector.collect({Bytes{key}, bitmap_bytes});
+    }};
+    const size_t num_keys{db::for_each_history_delta(delta_table, collect)};
+    delta_table.close();
+    history_index_load(txn, collector, /*append=*/false, storage);
+    txn->clear_map(delta_map);
+    log::Info() << "Folded " << num_deltas << " " << (storage ? "Storage" : "Account") << " History deltas of "
+                << num_keys << " keys";
+}
+
+static StageResult history_index_stage(db::RWTxn& txn, const std::filesystem::path& etl_path, bool storage) {
+    fs::create_directories(etl_path);
+
+    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
+    const char* stage_key = storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey;
+    auto last_processed_block_number{db::stages::read_stage_progress(*txn, stage_key)};
+    // Read-only snapshots only see committed data: unless this runs within an external transaction, commit so that
+    // extraction can spread over parallel snapshots
+    BlockNum block_number{0};
+    if (txn.is_external()) {
+        block_number = history_index_extract(*txn, collector, last_processed_block_number + 1, storage, etl_path,
+                                             512_Mebi);
+    } else {
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        block_number = history_index_extract(ro_txn, collector, last_processed_block_number + 1, storage, etl_path,
+                                             512_Mebi);
+    }
 
     // Proceed only if we've done something
     if (!collector.empty()) {
         log::Info() << "Started Loading";
-
-        MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
-                                                              : MDBX_put_flags_t::MDBX_APPEND};
-
-        // Eventually load collected items WITH transform (may throw)
-        auto target{db::open_cursor(*txn, index_config)};
-        collector.load(
-            target,
-            [](const etl::Entry& entry, mdbx::cursor& history_index_table, MDBX_put_flags_t put_flags) {
-                auto bm{roaring::Roaring64Map::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
-                // Check whether we still need to rework the previous entry
-                Bytes last_chunk_index(entry.key.size() + 8, '\0');
-                std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
-                endian::store_big_u64(&last_chunk_index[entry.key.size()], UINT64_MAX);
-                auto previous_bitmap_bytes{history_index_table.find(db::to_slice(last_chunk_index), false)};
-                // If we have an unfinished bitmap for the current location then continue working on it
-                if (previous_bitmap_bytes) {
-                    // Merge previous and current bitmap
-                    bm |= roaring::Roaring64Map::readSafe(previous_bitmap_bytes.value.char_ptr(),
-                                                          previous_bitmap_bytes.value.length());
-                    put_flags = MDBX_put_flags_t::MDBX_UPSERT;
-                }
-                while (bm.cardinality() > 0) {
-                    // Divide in different bitmaps of different (chunks) and push all of them individually
-                    auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
-                    // Make chunk index (Location + Suffix )
-                    Bytes chunk_index(entry.key.size() + 8, '\0');
-                    std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
-                    // Suffix is either the maximum Block Number of the bitmap or if it's the last chunk: UINT64_MAX
-                    BlockNum suffix{bm.cardinality() == 0 ? UINT64_MAX : current_chunk.maximum()};
-                    endian::store_big_u64(&chunk_index[entry.key.size()], suffix);
-                    // Push chunk to database
-                    Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
-                    current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
-                    mdbx::slice k{db::to_slice(chunk_index)};
-                    mdbx::slice v{db::to_slice(current_chunk_bytes)};
-                    mdbx::error::success_or_throw(history_index_table.put(k, &v, put_flags));
-                }
-            },
-            db_flags);
+        history_index_fold_deltas(txn, etl_path, storage);
+        history_index_load(txn, collector, /*append=*/last_processed_block_number == 0, storage);
 
         // Update progress height with last processed block
         db::stages::write_stage_progress(*txn, stage_key, block_number);
@@ -158,49 +324,39 @@ static StageResult history_index_stage(db::RWTxn& txn, const std::filesystem::pa
     return StageResult::kSuccess;
 }
 
-StageResult history_index_unwind(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t unwind_to,
-                                 bool storage) {
-    // We take data from header table and transform it and put it in blockhashes table
+StageResult history_index_unwind(db::RWTxn& txn, const std::filesystem::path&, uint64_t unwind_to, bool storage) {
     db::MapConfig index_config = storage ? db::table::kStorageHistory : db::table::kAccountHistory;
     const char* stage_key = storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey;
-    etl::Collector collector(etl_path,
-                             /* flush size */ 10_Mebi);  // We do not unwind by many blocks usually
 
-    auto index_table{db::open_cursor(*txn, index_config)};
-    // Extract
     log::Info() << "Started " << (storage ? "Storage" : "Account") << " Index Unwind";
-    if (index_table.to_first(/* throw_notfound = */ false)) {
-        auto data{index_table.current()};
-        while (data) {
-            // Get bitmap data of current element
-            auto key{db::from_slice(data.key)};
-            auto bitmap_data{db::from_slice(data.value)};
-            auto bm{roaring::Roaring64Map::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
-            // Check whether we should skip the current bitmap
-            if (bm.maximum() <= unwind_to) {
-                data = index_table.to_next(/*throw_notfound*/ false);
-                continue;
-            }
-            // check if unwind can be applied
-            if (bm.minimum() <= unwind_to) {
-                // Erase elements that are > unwind_to
-                bm &= roaring::Roaring64Map(roaring::api::roaring_bitmap_from_range(0, unwind_to + 1, 1));
-                Bytes new_bitmap(bm.getSizeInBytes(), '\0');
-                bm.write(byte_ptr_cast(&new_bitmap[0]));
-                // generates new key
-                Bytes new_key(key.size(), '\0');
-                std::memcpy(&new_key[0], key.data(), key.size());
-                endian::store_big_u32(&new_key[new_key.size() - 4], UINT32_MAX);
-                // replace with new index
-                collector.collect(etl::Entry{new_key, new_bitmap});
-            }
-            index_table.erase(/* whole_multivalue = */ true);
-            data = index_table.to_next(/*throw_notfound*/ false);
-        }
+
+    // Only keys changed by unwound blocks have bits to drop: locate them through changesets (which Execution has not
+    // unwound yet) rather than walking the whole index
+    std::set<Bytes> keys;
+    constexpr BlockNum kLastBlock{std::numeric_limits<BlockNum>::max()};
+    if (storage) {
+        (void)db::for_each_storage_change(*txn, unwind_to + 1, kLastBlock, [&](const db::StorageChange& change) {
+            // Storage: Address + Location
+            Bytes composite_key{change.address};
+            composite_key.append(change.location.bytes, kHashLength);
+            keys.insert(std::move(composite_key));
+        });
+    } else {
+        (void)db::for_each_account_change(*txn, unwind_to + 1, kLastBlock, [&](const db::AccountChange& change) {
+            keys.emplace(change.address);
+        });
+    }
+
+    // Trim the tail of each affected bitmap: for a reorg at tip, only the last chunk (or the deltas) of each key is
+    // rewritten
+    auto index_table{db::open_cursor(*txn, index_config)};
+    auto delta_table{db::open_cursor(*txn, db::history_delta_config(storage))};
+    for (const auto& key : keys) {
+        db::bitmap::truncate(index_table, key, unwind_to + 1);
+        db::truncate_history_deltas(delta_table, key, unwind_to + 1);
     }
 
     db::stages::write_stage_progress(*txn, stage_key, unwind_to);
-    collector.load(index_table, nullptr, MDBX_put_flags_t::MDBX_UPSERT);
     txn.commit();
     log::Info() << "All Done";
 
@@ -216,6 +372,8 @@ StageResult history_index_prune(db::RWTxn& txn, const std::filesystem::path& etl
 
     auto last_processed_block{db::stages::read_stage_progress(*txn, stage_key)};
 
+    // Pruning walks chunks only
+    history_index_fold_deltas(txn, etl_path, storage);
     auto index_table{db::open_cursor(*txn, index_config)};
     log::Info() << "Pruning " << (storage ? "Storage" : "Account") << " History from: " << prune_from;
 
@@ -276,4 +434,225 @@ StageResult prune_storage_history(db::RWTxn& txn, const std::filesystem::path& e
     return history_index_prune(txn, etl_path, prune_from, true);
 }
 
+StageResult HistoryIndex::forward(db::RWTxn& txn) {
+    StageResult result{StageResult::kSuccess};
+    if (txn.is_external()) {
+        result = extract_forward(*txn);
+    } else {
+        // Read-only snapshots only see committed data: commit so that extraction can spread over parallel snapshots
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        result = extract_forward(ro_txn);
+    }
+    return result == StageResult::kSuccess ? load_forward(txn) : result;
+}
+
+StageResult HistoryIndex::extract_forward(mdbx::txn& txn) {
+    try {
+        throw_if_stopping();
+        collector_.reset();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        previous_progress_ = db::stages::read_stage_progress(txn, stage_name_);
+        target_progress_ = db::stages::read_stage_progress(txn, db::stages::kExecutionKey);
+        if (previous_progress_ == target_progress_) {
+            // Nothing to process
+            return StageResult::kSuccess;
+        } else if (previous_progress_ > target_progress_) {
+            log::Error() << "Bad progress sequence. " << stage_name_ << " stage progress " << previous_progress_
+                         << " while Execution stage " << target_progress_;
+            return StageResult::kInvalidProgress;
+        }
+
+        operation_ = OperationType::Forward;
+        collector_ = std::make_unique<etl::Collector>(node_settings_);
+        resumed_ = false;
+        stale_checkpoint_ = false;
+
+        // An interrupted run still within reach resumes from its persisted files (trailing blocks, if any, are left
+        // to next forward) otherwise whatever it has committed has to be dropped
+        if (const auto checkpoint{db::stages::read_stage_checkpoint(txn, stage_name_)}; checkpoint) {
+            if (checkpoint->target > previous_progress_ && checkpoint->target <= target_progress_) {
+                try {
+                    collector_->restore(checkpoint_manifest_path());
+                    collector_->set_resume_key(checkpoint->key);
+                    target_progress_ = checkpoint->target;
+                    resumed_ = true;
+                    log::Info(std::string(stage_name_),
+                              {"resuming", "from checkpoint", "key", to_hex(checkpoint->key)});
+                } catch (const etl::etl_error& ex) {
+                    log::Warning(std::string(stage_name_), {"checkpoint", "discarded", "reason", ex.what()});
+                    collector_->clear();
+                }
+            }
+            stale_checkpoint_ = !resumed_;
+        }
+
+        if (!resumed_) {
+            (void)history_index_extract(txn, *collector_, previous_progress_ + 1, storage_,
+                                        node_settings_->data_directory->etl().path(), node_settings_->etl_buffer_size);
+        }
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    return StageResult::kSuccess;
+}
+
+StageResult HistoryIndex::load_forward(db::RWTxn& txn) {
+    if (!collector_) {
+        // Nothing has been extracted
+        return StageResult::kSuccess;
+    }
+    try {
+        throw_if_stopping();
+        const bool resumable{!txn.is_external()};
+        if (stale_checkpoint_) {
+            // Drop what the interrupted run has loaded beyond current progress
+            if (previous_progress_) {
+                success_or_throw(history_index_unwind(txn, {}, previous_progress_, storage_));
+            } else {
+                txn->clear_map(db::open_map(*txn, storage_ ? db::table::kStorageHistory : db::table::kAccountHistory));
+                txn->clear_map(db::open_map(*txn, db::history_delta_config(storage_)));
+            }
+            drop_checkpoint(txn);
+        }
+        if (resumable && !resumed_ && collector_->size() > kCheckpointInterval) {
+            collector_->persist(checkpoint_manifest_path());
+            db::stages::write_stage_checkpoint(*txn, stage_name_, {target_progress_, {}});
+            txn.force_commit();
+            resumed_ = true;
+        }
+
+        // At chain tip few blocks change few keys each: appending deltas spares rewriting the last chunk of each key.
+        // Otherwise (or once too many) deltas are folded, which also clears them out once deltas are turned off
+        const auto& etl_path{node_settings_->data_directory->etl().path()};
+        const bool append_deltas{node_settings_->history_index_deltas && previous_progress_ && !resumed_ &&
+                                 target_progress_ - previous_progress_ <= kMaxDeltaBlocks};
+        history_index_fold_deltas(txn, etl_path, storage_, append_deltas ? kMaxHistoryDeltas : 1);
+        if (!collector_->empty()) {
+            if (append_deltas) {
+                history_index_append_deltas(txn, *collector_, storage_);
+            } else {
+                history_index_load(txn, *collector_, /*append=*/previous_progress_ == 0, storage_,
+                                   resumed_ ? std::optional<BlockNum>{target_progress_} : std::nullopt);
+            }
+        }
+
+        // Trailing blocks may have no changes at all: record what Execution has actually processed
+        db::stages::write_stage_progress(*txn, stage_name_, target_progress_);
+        if (resumed_) {
+            drop_checkpoint(txn);
+        }
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    collector_.reset();
+    return StageResult::kSuccess;
+}
+
+StageResult HistoryIndex::unwind(db::RWTxn& txn, BlockNum to) {
+    try {
+        throw_if_stopping();
+
+        // A forward interrupted on its way beyond the unwind point must not be resumed: its data is going to change
+        if (const auto checkpoint{db::stages::read_stage_checkpoint(*txn, stage_name_)};
+            checkpoint && checkpoint->target > to) {
+            drop_checkpoint(txn);
+        }
+
+        if (to >= get_progress(txn)) {
+            // Nothing to unwind actually
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Unwind;
+        const auto& etl_path{node_settings_->data_directory->etl().path()};
+        success_or_throw(storage_ ? unwind_storage_history(txn, etl_path, to)
+                                  : unwind_account_history(txn, etl_path, to));
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+StageResult HistoryIndex::prune(db::RWTxn& txn) {
+    try {
+        throw_if_stopping();
+        const auto& prune_threshold{node_settings_->prune_mode->history()};
+        if (!prune_threshold.enabled()) {
+            return StageResult::kSuccess;
+        }
+        const auto forward_progress{get_progress(txn)};
+        if (db::stages::read_stage_prune_progress(*txn, stage_name_) >= forward_progress) {
+            // Nothing to prune since last run
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Prune;
+        if (const BlockNum prune_from{prune_threshold.value_from_head(forward_progress)}; prune_from) {
+            const auto& etl_path{node_settings_->data_directory->etl().path()};
+            success_or_throw(storage_ ? prune_storage_history(txn, etl_path, prune_from)
+                                      : prune_account_history(txn, etl_path, prune_from));
+        }
+        db::stages::write_stage_prune_progress(*txn, stage_name_, forward_progress);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+std::vector<std::string> HistoryIndex::get_log_progress() {
+    const auto operation{operation_.load()};
+    if (operation == OperationType::None) {
+        return {};
+    }
+    return {"op", std::string(magic_enum::enum_name<OperationType>(operation))};
+}
+
 }  // namespace silkworm::stagedsync
@@ -0,0 +1,53 @@
+/*
+   Copyright 2021-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+
+#include <silkworm/stagedsync/common.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Builds AccountHistory (or StorageHistory) bitmap indexes out of changesets written by Execution
+//! \remarks Unless within an external transaction, long loads commit a checkpoint every kCheckpointInterval entries:
+//! a forward interrupted afterwards resumes loading the persisted etl files from the last checkpoint. With
+//! NodeSettings::history_index_deltas, forward runs at chain tip append deltas instead, folded into chunks on the way
+class HistoryIndex final : public IStage {
+  public:
+    explicit HistoryIndex(NodeSettings* node_settings, bool storage)
+        : IStage(storage ? db::stages::kStorageHistoryIndexKey : db::stages::kAccountHistoryIndexKey, node_settings),
+          storage_{storage} {};
+    ~HistoryIndex() override = default;
+
+    StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* concurrent_source() const final { return db::stages::kExecutionKey; }
+    StageResult extract_forward(mdbx::txn& txn) final;
+    StageResult load_forward(db::RWTxn& txn) final;
+    StageResult unwind(db::RWTxn& txn, BlockNum to) final;
+    StageResult prune(db::RWTxn& txn) final;
+    std::vector<std::string> get_log_progress() final;
+
+  private:
+    const bool storage_;                                  // Whether this indexes StorageChangeSet or AccountChangeSet
+    std::unique_ptr<etl::Collector> collector_{nullptr};  // Collected by extract_forward
+    BlockNum previous_progress_{0};                       // Stage progress at extraction
+    BlockNum target_progress_{0};                         // Execution progress at extraction
+    bool resumed_{false};                                 // Whether collector_ is persisted (i.e. load is resumable)
+    bool stale_checkpoint_{false};                        // Whether an interrupted run has left data to be dropped
+};
+
+}  // namespace silkworm::stagedsync
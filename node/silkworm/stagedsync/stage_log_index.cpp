@@ -14,14 +14,21 @@
    limitations under the License.
 */
 
+#include "stage_log_index.hpp"
+
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <thread>
+#include <vector>
 
 #include <silkworm/common/cast.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/bitmap.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/etl/collector.hpp>
 #include <silkworm/stagedsync/stage_logindex/listener_log_index.hpp>
@@ -34,80 +41,112 @@ namespace fs = std::filesystem;
 
 static constexpr size_t kBitmapBufferSizeLimit = 512_Mebi;
 
-static void loader_function(const etl::Entry& entry, mdbx::cursor& target_table, MDBX_put_flags_t db_flags) {
-    auto bm{roaring::Roaring::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
-    Bytes last_chunk_index(entry.key.size() + 4, '\0');
-    std::memcpy(&last_chunk_index[0], &entry.key[0], entry.key.size());
-    endian::store_big_u32(&last_chunk_index[entry.key.size()], UINT32_MAX);
-    auto previous_bitmap_bytes{target_table.find(db::to_slice(last_chunk_index), false)};
-    if (previous_bitmap_bytes) {
-        bm |= roaring::Roaring::readSafe(previous_bitmap_bytes.value.char_ptr(), previous_bitmap_bytes.value.length());
-        db_flags = MDBX_put_flags_t::MDBX_UPSERT;
-    }
-    while (bm.cardinality() > 0) {
-        auto current_chunk{db::bitmap::cut_left(bm, db::bitmap::kBitmapChunkLimit)};
-        // make chunk index
-        Bytes chunk_index(entry.key.size() + 4, '\0');
-        std::memcpy(&chunk_index[0], &entry.key[0], entry.key.size());
-        uint64_t suffix{bm.cardinality() == 0 ? UINT32_MAX : current_chunk.maximum()};
-        endian::store_big_u32(&chunk_index[entry.key.size()], suffix);
-        Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
-        current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
-
-        mdbx::slice k{db::to_slice(chunk_index)};
-        mdbx::slice v{db::to_slice(current_chunk_bytes)};
-        mdbx::error::success_or_throw(target_table.put(k, &v, db_flags));
-    }
+//! \brief Loads collected bitmaps into LogTopicIndex (or LogAddressIndex) merging them with unfinished chunks
+//! \remarks Collected bitmaps of the same key (i.e. from different flushes or threads) are unioned before being cut
+//! into chunks, so the order they were collected in does not matter
+static void load_log_index_table(mdbx::cursor& target, etl::Collector& collector, MDBX_put_flags_t load_flags) {
+    Bytes pending_key;
+    roaring::Roaring pending_bitmap;
+
+    const auto write_chunks{[&](mdbx::cursor& target_table) {
+        if (pending_key.empty()) {
+            return;
+        }
+        MDBX_put_flags_t put_flags{load_flags};
+        Bytes last_chunk_index(pending_key.size() + 4, '\0');
+        std::memcpy(&last_chunk_index[0], &pending_key[0], pending_key.size());
+        endian::store_big_u32(&last_chunk_index[pending_key.size()], UINT32_MAX);
+        auto previous_bitmap_bytes{target_table.find(db::to_slice(last_chunk_index), false)};
+        if (previous_bitmap_bytes) {
+            pending_bitmap |= roaring::Roaring::readSafe(previous_bitmap_bytes.value.char_ptr(),
+                                                         previous_bitmap_bytes.value.length());
+            put_flags = MDBX_put_flags_t::MDBX_UPSERT;
+        }
+        while (pending_bitmap.cardinality() > 0) {
+            auto current_chunk{db::bitmap::cut_left(pending_bitmap, db::bitmap::kBitmapChunkLimit)};
+            // make chunk index
+            Bytes chunk_index(pending_key.size() + 4, '\0');
+            std::memcpy(&chunk_index[0], &pending_key[0], pending_key.size());
+            uint64_t suffix{pending_bitmap.cardinality() == 0 ? UINT32_MAX : current_chunk.maximum()};
+            endian::store_big_u32(&chunk_index[pending_key.size()], suffix);
+            Bytes current_chunk_bytes(current_chunk.getSizeInBytes(), '\0');
+            current_chunk.write(byte_ptr_cast(&current_chunk_bytes[0]));
+
+            mdbx::slice k{db::to_slice(chunk_index)};
+            mdbx::slice v{db::to_slice(current_chunk_bytes)};
+            mdbx::error::success_or_throw(target_table.put(k, &v, put_flags));
+        }
+        pending_key.clear();
+    }};
+
+    collector.load(
+        target,
+        [&](const etl::Entry& entry, mdbx::cursor& target_table, MDBX_put_flags_t) {
+            auto bm{roaring::Roaring::readSafe(byte_ptr_cast(entry.value.data()), entry.value.size())};
+            if (entry.key == pending_key) {
+                pending_bitmap |= bm;
+                return;
+            }
+            write_chunks(target_table);
+            pending_key = entry.key;
+            pending_bitmap = std::move(bm);
+        },
+        load_flags);
+    write_chunks(target);
 }
 
-static void flush_bitmaps(etl::Collector& collector, std::unordered_map<std::string, roaring::Roaring>& map) {
+template <class Bitmaps>
+static void flush_bitmaps(etl::Collector& collector, Bitmaps& map) {
     for (const auto& [key, bm] : map) {
         Bytes bitmap_bytes(bm.getSizeInBytes(), '\0');
         bm.write(byte_ptr_cast(bitmap_bytes.data()));
-        collector.collect(etl::Entry{Bytes(byte_ptr_cast(key.c_str()), key.size()), bitmap_bytes});
+        collector.collect(etl::Entry{Bytes(key.data(), key.size()), bitmap_bytes});
     }
     map.clear();
 }
 
-StageResult stage_log_index(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t) {
-    fs::create_directories(etl_path);
-    etl::Collector topic_collector(etl_path, /* flush size */ 256_Mebi);
-    etl::Collector addresses_collector(etl_path, /* flush size */ 256_Mebi);
-
-    auto log_table{db::open_cursor(*txn, db::table::kLogs)};
-    auto last_processed_block_number{db::stages::read_stage_progress(*txn, db::stages::kLogIndexKey)};
+//! \brief Collects bitmaps of blocks logging each topic and each address from logs of blocks in range [block_from,
+//! block_to]
+//! \param [in] size_limit : the allocated space of either set of bitmaps triggering a flush into its collector
+//! \return The last block number reached
+static BlockNum extract_log_index_range(mdbx::txn& txn, etl::Collector& topic_collector,
+                                        etl::Collector& addresses_collector, BlockNum block_from, BlockNum block_to,
+                                        size_t size_limit) {
+    auto log_table{db::open_cursor(txn, db::table::kLogs)};
 
-    // Extract
-    log::Info() << "Started Log Index Extraction";
     Bytes start(8, '\0');
-    endian::store_big_u64(&start[0], last_processed_block_number);
+    endian::store_big_u64(&start[0], block_from);
 
     uint64_t block_number{0};
     uint64_t topics_allocated_space{0};
     uint64_t addresses_allocated_space{0};
     // Two bitmaps to fill: topics and addresses
-    std::unordered_map<std::string, roaring::Roaring> topic_bitmaps;
-    std::unordered_map<std::string, roaring::Roaring> addresses_bitmaps;
+    LogTopicBitmaps topic_bitmaps;
+    LogAddressBitmaps addresses_bitmaps;
     // CBOR decoder
     listener_log_index current_listener(block_number, &topic_bitmaps, &addresses_bitmaps, &topics_allocated_space,
                                         &addresses_allocated_space);
 
     auto log_data{log_table.lower_bound(db::to_slice(start), false)};
     while (log_data) {
+        const BlockNum reached_block_number{endian::load_big_u64(static_cast<uint8_t*>(log_data.key.data()))};
+        if (reached_block_number > block_to) {
+            break;
+        }
         // Decode CBOR and distribute it to the 2 bitmaps
-        block_number = endian::load_big_u64(static_cast<uint8_t*>(log_data.key.data()));
+        block_number = reached_block_number;
         current_listener.set_block_number(block_number);
         cbor::input input(log_data.value.data(), log_data.value.length());
         cbor::decoder decoder(input, current_listener);
         decoder.run();
         // Flushes
-        if (topics_allocated_space > kBitmapBufferSizeLimit) {
+        if (topics_allocated_space > size_limit) {
             flush_bitmaps(topic_collector, topic_bitmaps);
             log::Info() << "Current Block: " << block_number;
             topics_allocated_space = 0;
         }
 
-        if (addresses_allocated_space > kBitmapBufferSizeLimit) {
+        if (addresses_allocated_space > size_limit) {
             flush_bitmaps(addresses_collector, addresses_bitmaps);
             log::Info() << "Current Block: " << block_number;
             addresses_allocated_space = 0;
@@ -121,20 +160,97 @@ StageResult stage_log_index(db::RWTxn& txn, const std::filesystem::path& etl_pat
     flush_bitmaps(topic_collector, topic_bitmaps);
     flush_bitmaps(addresses_collector, addresses_bitmaps);
 
-    log::Info() << "Latest Block: " << block_number;
-    // Proceed only if we've done something
+    return block_number;
+}
+
+//! \brief Collects bitmaps of blocks logging each topic and each address from logs of blocks from block_from onwards
+//! \remarks When txn is read-only block ranges are spread over parallel snapshots, each thread with its own
+//! collectors sized after buffer_size: thread collectors are merged into topic_collector and addresses_collector
+//! \return The last block number reached
+static BlockNum extract_log_index(mdbx::txn& txn, etl::Collector& topic_collector,
+                                  etl::Collector& addresses_collector, BlockNum block_from, const fs::path& etl_path,
+                                  size_t buffer_size) {
+    static constexpr BlockNum kMinParallelBlocks{10'000};
+    static constexpr size_t kRangesPerThread{16};
+
+    log::Info() << "Started Log Index Extraction";
+
+    BlockNum block_to{0};
+    if (txn.is_readonly()) {
+        auto log_table{db::open_cursor(txn, db::table::kLogs)};
+        if (const auto last{log_table.to_last(/*throw_notfound=*/false)}; last) {
+            block_to = endian::load_big_u64(static_cast<uint8_t*>(last.key.data()));
+        }
+    }
+    const size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (block_to < block_from || block_to - block_from + 1 < kMinParallelBlocks || num_threads == 1) {
+        const BlockNum block_number{extract_log_index_range(txn, topic_collector, addresses_collector, block_from,
+                                                            std::numeric_limits<BlockNum>::max(),
+                                                            kBitmapBufferSizeLimit)};
+        log::Info() << "Latest Block: " << block_number;
+        return block_number;
+    }
+
+    // Both bitmaps and collectors memory budgets are shared among threads
+    const size_t thread_size_limit{kBitmapBufferSizeLimit / num_threads};
+    const size_t thread_buffer_size{std::max(buffer_size / num_threads, 16_Mebi)};
+    std::vector<std::unique_ptr<etl::Collector>> topic_collectors;
+    std::vector<std::unique_ptr<etl::Collector>> addresses_collectors;
+    for (size_t i{0}; i < num_threads; ++i) {
+        topic_collectors.push_back(std::make_unique<etl::Collector>(etl_path, thread_buffer_size));
+        addresses_collectors.push_back(std::make_unique<etl::Collector>(etl_path, thread_buffer_size));
+    }
+    db::parallel_for_block_ranges(txn.env(), block_from, block_to, num_threads, kRangesPerThread,
+                                  [&](size_t worker, mdbx::txn& ro_txn, BlockNum from, BlockNum to) {
+                                      (void)extract_log_index_range(ro_txn, *topic_collectors[worker],
+                                                                    *addresses_collectors[worker], from, to,
+                                                                    thread_size_limit);
+                                  });
+
+    for (size_t i{0}; i < num_threads; ++i) {
+        topic_collector.merge(*topic_collectors[i]);
+        addresses_collector.merge(*addresses_collectors[i]);
+    }
+    log::Info() << "Latest Block: " << block_to;
+    return block_to;
+}
+
+//! \brief Loads collected bitmaps into LogTopicIndex and LogAddressIndex merging them with unfinished chunks
+static void load_log_index(db::RWTxn& txn, etl::Collector& topic_collector, etl::Collector& addresses_collector,
+                           bool append) {
     log::Info() << "Started Topics Loading";
     // if stage has never been touched then appending is safe
-    MDBX_put_flags_t db_flags{last_processed_block_number ? MDBX_put_flags_t::MDBX_UPSERT
-                                                          : MDBX_put_flags_t::MDBX_APPEND};
+    MDBX_put_flags_t db_flags{append ? MDBX_put_flags_t::MDBX_APPEND : MDBX_put_flags_t::MDBX_UPSERT};
 
     // Eventually load collected items WITH transform (may throw)
     auto target{db::open_cursor(*txn, db::table::kLogTopicIndex)};
-    topic_collector.load(target, loader_function, db_flags);
+    load_log_index_table(target, topic_collector, db_flags);
     target.close();
     target = db::open_cursor(*txn, db::table::kLogAddressIndex);
     log::Info() << "Started Address Loading";
-    addresses_collector.load(target, loader_function, db_flags);
+    load_log_index_table(target, addresses_collector, db_flags);
+}
+
+StageResult stage_log_index(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t) {
+    fs::create_directories(etl_path);
+    etl::Collector topic_collector(etl_path, /* flush size */ 256_Mebi);
+    etl::Collector addresses_collector(etl_path, /* flush size */ 256_Mebi);
+
+    auto last_processed_block_number{db::stages::read_stage_progress(*txn, db::stages::kLogIndexKey)};
+    // Read-only snapshots only see committed data: unless this runs within an external transaction, commit so that
+    // extraction can spread over parallel snapshots
+    BlockNum block_number{0};
+    if (txn.is_external()) {
+        block_number = extract_log_index(*txn, topic_collector, addresses_collector, last_processed_block_number + 1,
+                                         etl_path, 512_Mebi);
+    } else {
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        block_number = extract_log_index(ro_txn, topic_collector, addresses_collector,
+                                         last_processed_block_number + 1, etl_path, 512_Mebi);
+    }
+
+    load_log_index(txn, topic_collector, addresses_collector, /*append=*/last_processed_block_number == 0);
 
     // Update progress height with last processed block
     db::stages::write_stage_progress(*txn, db::stages::kLogIndexKey, block_number);
@@ -146,66 +262,44 @@ StageResult stage_log_index(db::RWTxn& txn, const std::filesystem::path& etl_pat
     return StageResult::kSuccess;
 }
 
-static StageResult unwind_log_index(db::RWTxn& txn, etl::Collector& collector, uint64_t unwind_to, bool topics) {
-    auto index_table{topics ? db::open_cursor(*txn, db::table::kLogTopicIndex)
-                            : db::open_cursor(*txn, db::table::kLogAddressIndex)};
+StageResult unwind_log_index(db::RWTxn& txn, const std::filesystem::path&, uint64_t unwind_to) {
     if (unwind_to >= db::stages::read_stage_progress(*txn, db::stages::kLogIndexKey)) {
         return StageResult::kSuccess;
     }
 
-    // Latest bitmap
-    auto data{index_table.to_first(/*throw_notfound=*/false)};
-    while (data) {
-        // Get bitmap data of current element
-        auto key{db::from_slice(data.key)};
-        auto bitmap_data{db::from_slice(data.value)};
-
-        auto bm{roaring::Roaring::readSafe(byte_ptr_cast(bitmap_data.data()), bitmap_data.size())};
-        // Check for keys that can be skipped
-        if (bm.maximum() <= unwind_to) {
-            data = index_table.to_next(/*throw_notfound*/ false);
-            continue;
-        }
-        // adjust bitmaps
-        if (bm.minimum() <= unwind_to) {
-            // Erase elements that are > unwind_to
-            bm &= roaring::Roaring(roaring::api::roaring_bitmap_from_range(0, unwind_to + 1, 1));
-            auto new_bitmap{Bytes(bm.getSizeInBytes(), '\0')};
-            bm.write(byte_ptr_cast(&new_bitmap[0]));
-            // make new key
-            Bytes new_key(key.size(), '\0');
-            std::memcpy(&new_key[0], key.data(), key.size());
-            endian::store_big_u32(&new_key[new_key.size() - 4], UINT32_MAX);
-            // collect higher bitmap
-            collector.collect(etl::Entry{new_key, new_bitmap});
-        }
-        // erase index
-        index_table.erase(true);
-        data = index_table.to_next(/*throw_notfound*/ false);
+    // Only topics and addresses logged by unwound blocks have bits to drop: locate them through the logs (which
+    // Execution has not unwound yet) rather than walking the whole indices
+    uint64_t unused_allocated_space{0};
+    LogTopicBitmaps topic_bitmaps;
+    LogAddressBitmaps addresses_bitmaps;
+    listener_log_index current_listener(unwind_to + 1, &topic_bitmaps, &addresses_bitmaps, &unused_allocated_space,
+                                        &unused_allocated_space);
+    auto log_table{db::open_cursor(*txn, db::table::kLogs)};
+    auto log_data{log_table.lower_bound(db::to_slice(db::block_key(unwind_to + 1)), /*throw_notfound=*/false)};
+    while (log_data) {
+        cbor::input input(log_data.value.data(), log_data.value.length());
+        cbor::decoder decoder(input, current_listener);
+        decoder.run();
+        log_data = log_table.to_next(/*throw_notfound*/ false);
     }
+    log_table.close();
 
-    collector.load(index_table, nullptr, MDBX_put_flags_t::MDBX_UPSERT);
-    txn.commit();
-
-    return StageResult::kSuccess;
-}
-
-StageResult unwind_log_index(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t unwind_to) {
-    etl::Collector collector(etl_path, /* flush size */ 256_Mebi);
-
+    // Trim the tail of each affected bitmap: for a reorg at tip, only the last chunk of each key is rewritten
+    const auto from{static_cast<uint32_t>(unwind_to + 1)};
     log::Info() << "Started Topic Index Unwind";
-    auto result{unwind_log_index(txn, collector, unwind_to, true)};
-    collector.clear();
-    if (result != StageResult::kSuccess) {
-        return result;
+    auto index_table{db::open_cursor(*txn, db::table::kLogTopicIndex)};
+    for (const auto& [key, _] : topic_bitmaps) {
+        db::bitmap::truncate32(index_table, ByteView{key.data(), key.size()}, from);
     }
+    index_table.close();
     log::Info() << "Started Address Index Unwind";
-    result = unwind_log_index(txn, collector, unwind_to, false);
-    collector.clear();
-    if (result != StageResult::kSuccess) {
-        return result;
+    index_table = db::open_cursor(*txn, db::table::kLogAddressIndex);
+    for (const auto& [key, _] : addresses_bitmaps) {
+        db::bitmap::truncate32(index_table, ByteView{key.data(), key.size()}, from);
     }
+
     db::stages::write_stage_progress(*txn, db::stages::kLogIndexKey, unwind_to);
+    txn.commit();
     log::Info() << "All Done";
     return StageResult::kSuccess;
 }
@@ -261,4 +355,163 @@ StageResult prune_log_index(db::RWTxn& txn, const std::filesystem::path& etl_pat
     return StageResult::kSuccess;
 }
 
+StageResult LogIndex::forward(db::RWTxn& txn) {
+    StageResult result{StageResult::kSuccess};
+    if (txn.is_external()) {
+        result = extract_forward(*txn);
+    } else {
+        // Read-only snapshots only see committed data: commit so that extraction can spread over parallel snapshots
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        result = extract_forward(ro_txn);
+    }
+    return result == StageResult::kSuccess ? load_forward(txn) : result;
+}
+
+StageResult LogIndex::extract_forward(mdbx::txn& txn) {
+    try {
+        throw_if_stopping();
+        topics_collector_.reset();
+        addresses_collector_.reset();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        previous_progress_ = db::stages::read_stage_progress(txn, stage_name_);
+        target_progress_ = db::stages::read_stage_progress(txn, db::stages::kExecutionKey);
+        if (previous_progress_ == target_progress_) {
+            // Nothing to process
+            return StageResult::kSuccess;
+        } else if (previous_progress_ > target_progress_) {
+            log::Error() << "Bad progress sequence. " << stage_name_ << " stage progress " << previous_progress_
+                         << " while Execution stage " << target_progress_;
+            return StageResult::kInvalidProgress;
+        }
+
+        operation_ = OperationType::Forward;
+        topics_collector_ = std::make_unique<etl::Collector>(node_settings_);
+        addresses_collector_ = std::make_unique<etl::Collector>(node_settings_);
+        (void)extract_log_index(txn, *topics_collector_, *addresses_collector_, previous_progress_ + 1,
+                                node_settings_->data_directory->etl().path(), node_settings_->etl_buffer_size);
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        topics_collector_.reset();
+        addresses_collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        topics_collector_.reset();
+        addresses_collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    return StageResult::kSuccess;
+}
+
+StageResult LogIndex::load_forward(db::RWTxn& txn) {
+    if (!topics_collector_) {
+        // Nothing has been extracted
+        return StageResult::kSuccess;
+    }
+    try {
+        throw_if_stopping();
+        load_log_index(txn, *topics_collector_, *addresses_collector_, /*append=*/previous_progress_ == 0);
+
+        // Trailing blocks may have no logs at all: record what Execution has actually processed
+        db::stages::write_stage_progress(*txn, stage_name_, target_progress_);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        topics_collector_.reset();
+        addresses_collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        topics_collector_.reset();
+        addresses_collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    topics_collector_.reset();
+    addresses_collector_.reset();
+    return StageResult::kSuccess;
+}
+
+StageResult LogIndex::unwind(db::RWTxn& txn, BlockNum to) {
+    try {
+        throw_if_stopping();
+        if (to >= get_progress(txn)) {
+            // Nothing to unwind actually
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Unwind;
+        success_or_throw(unwind_log_index(txn, node_settings_->data_directory->etl().path(), to));
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+StageResult LogIndex::prune(db::RWTxn& txn) {
+    try {
+        throw_if_stopping();
+        const auto& prune_threshold{node_settings_->prune_mode->receipts()};
+        if (!prune_threshold.enabled()) {
+            return StageResult::kSuccess;
+        }
+        const auto forward_progress{get_progress(txn)};
+        if (db::stages::read_stage_prune_progress(*txn, stage_name_) >= forward_progress) {
+            // Nothing to prune since last run
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Prune;
+        if (const BlockNum prune_from{prune_threshold.value_from_head(forward_progress)}; prune_from) {
+            success_or_throw(prune_log_index(txn, node_settings_->data_directory->etl().path(), prune_from));
+        }
+        db::stages::write_stage_prune_progress(*txn, stage_name_, forward_progress);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+std::vector<std::string> LogIndex::get_log_progress() {
+    const auto operation{operation_.load()};
+    if (operation == OperationType::None) {
+        return {};
+    }
+    return {"op", std::string(magic_enum::enum_name<OperationType>(operation))};
+}
+
 }  // namespace silkworm::stagedsync
@@ -0,0 +1,46 @@
+/*
+   Copyright 2021-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+
+#include <silkworm/stagedsync/common.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Builds LogAddressIndex and LogTopicIndex bitmap indexes out of logs written by Execution
+class LogIndex final : public IStage {
+  public:
+    explicit LogIndex(NodeSettings* node_settings) : IStage(db::stages::kLogIndexKey, node_settings){};
+    ~LogIndex() override = default;
+
+    StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* concurrent_source() const final { return db::stages::kExecutionKey; }
+    StageResult extract_forward(mdbx::txn& txn) final;
+    StageResult load_forward(db::RWTxn& txn) final;
+    StageResult unwind(db::RWTxn& txn, BlockNum to) final;
+    StageResult prune(db::RWTxn& txn) final;
+    std::vector<std::string> get_log_progress() final;
+
+  private:
+    std::unique_ptr<etl::Collector> topics_collector_{nullptr};     // Collected by extract_forward
+    std::unique_ptr<etl::Collector> addresses_collector_{nullptr};  // Collected by extract_forward
+    BlockNum previous_progress_{0};                                 // Stage progress at extraction
+    BlockNum target_progress_{0};                                   // Execution progress at extraction
+};
+
+}  // namespace silkworm::stagedsync
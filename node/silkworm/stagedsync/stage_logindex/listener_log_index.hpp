@@ -16,9 +16,10 @@
 
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <array>
+#include <cstring>
 
+#include <absl/container/flat_hash_map.h>
 #include <cbor/decoder.h>
 
 #include <silkworm/common/log.hpp>
@@ -26,11 +27,14 @@
 
 namespace silkworm::stagedsync {
 
+// Bitmaps of blocks logging each topic (or address), keyed by the fixed-size topic (or address)
+using LogTopicBitmaps = absl::flat_hash_map<std::array<uint8_t, kHashLength>, roaring::Roaring>;
+using LogAddressBitmaps = absl::flat_hash_map<std::array<uint8_t, kAddressLength>, roaring::Roaring>;
+
 class listener_log_index : public cbor::listener {
   public:
-    listener_log_index(uint64_t block_number, std::unordered_map<std::string, roaring::Roaring>* topics_map,
-                       std::unordered_map<std::string, roaring::Roaring>* addrs_map, uint64_t* allocated_topics,
-                       uint64_t* allocated_addrs)
+    listener_log_index(uint64_t block_number, LogTopicBitmaps* topics_map, LogAddressBitmaps* addrs_map,
+                       uint64_t* allocated_topics, uint64_t* allocated_addrs)
         : block_number_(block_number),
           topics_map_(topics_map),
           addrs_map_(addrs_map),
@@ -40,18 +44,13 @@ class listener_log_index : public cbor::listener {
     void on_integer(int) override {}
 
     void on_bytes(unsigned char* data, int size) override {
-        std::string key(byte_ptr_cast(data), static_cast<size_t>(size));
         if (size == kHashLength) {
-            if (topics_map_->find(key) == topics_map_->end()) {
-                topics_map_->emplace(key, roaring::Roaring());
-            }
-            topics_map_->at(key).add(block_number_);
+            std::memcpy(topic_key_.data(), data, kHashLength);
+            (*topics_map_)[topic_key_].add(static_cast<uint32_t>(block_number_));
             *allocated_topics_ += kHashLength;
         } else if (size == kAddressLength) {
-            if (addrs_map_->find(key) == addrs_map_->end()) {
-                addrs_map_->emplace(key, roaring::Roaring());
-            }
-            addrs_map_->at(key).add(block_number_);
+            std::memcpy(address_key_.data(), data, kAddressLength);
+            (*addrs_map_)[address_key_].add(static_cast<uint32_t>(block_number_));
             *allocated_addrs_ += kAddressLength;
         }
     }
@@ -88,8 +87,10 @@ class listener_log_index : public cbor::listener {
 
   private:
     uint64_t block_number_;
-    std::unordered_map<std::string, roaring::Roaring>* topics_map_;
-    std::unordered_map<std::string, roaring::Roaring>* addrs_map_;
+    LogTopicBitmaps* topics_map_;
+    LogAddressBitmaps* addrs_map_;
+    LogTopicBitmaps::key_type topic_key_{};
+    LogAddressBitmaps::key_type address_key_{};
     uint64_t* allocated_topics_;
     uint64_t* allocated_addrs_;
 };
@@ -0,0 +1,130 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_metrics.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/etl/collector.hpp>
+
+namespace silkworm::stagedsync {
+
+namespace fs = std::filesystem;
+
+StageMetrics& StageMetrics::operator+=(const StageMetrics& other) {
+    runs += other.runs;
+    wall_time += other.wall_time;
+    cpu_time += other.cpu_time;
+    commit_time += other.commit_time;
+    commits += other.commits;
+    committed_bytes += other.committed_bytes;
+    etl_flushed_bytes += other.etl_flushed_bytes;
+    minor_page_faults += other.minor_page_faults;
+    major_page_faults += other.major_page_faults;
+    block_inputs += other.block_inputs;
+    block_outputs += other.block_outputs;
+    return *this;
+}
+
+std::vector<std::string> StageMetrics::to_log_args() const {
+    return {"done",      StopWatch::format(wall_time),   "cpu",          StopWatch::format(cpu_time),
+            "commit",    StopWatch::format(commit_time), "committed",    human_size(committed_bytes),
+            "etl.flush", human_size(etl_flushed_bytes),  "major.faults", std::to_string(major_page_faults)};
+}
+
+StageMetricsProbe::StageMetricsProbe(const db::RWTxn& txn)
+    : start_{std::chrono::steady_clock::now()},
+      usage_{process_resource_usage()},
+      commit_stats_{txn.commit_stats()},
+      etl_flushed_bytes_{etl::Collector::total_flushed_bytes()} {}
+
+StageMetrics StageMetricsProbe::sample(const db::RWTxn& txn) const {
+    const auto usage{process_resource_usage() - usage_};
+    const auto& commit_stats{txn.commit_stats()};
+
+    StageMetrics metrics;
+    metrics.runs = 1;
+    metrics.wall_time = std::chrono::duration_cast<StopWatch::Duration>(std::chrono::steady_clock::now() - start_);
+    metrics.cpu_time = usage.cpu_time;
+    metrics.commit_time = commit_stats.duration - commit_stats_.duration;
+    metrics.commits = commit_stats.count - commit_stats_.count;
+    metrics.committed_bytes = commit_stats.dirty_bytes - commit_stats_.dirty_bytes;
+    metrics.etl_flushed_bytes = etl::Collector::total_flushed_bytes() - etl_flushed_bytes_;
+    metrics.minor_page_faults = usage.minor_page_faults;
+    metrics.major_page_faults = usage.major_page_faults;
+    metrics.block_inputs = usage.block_inputs;
+    metrics.block_outputs = usage.block_outputs;
+    return metrics;
+}
+
+std::string to_prometheus_text(const std::vector<std::string>& stage_names, const std::vector<StageMetrics>& metrics) {
+    if (stage_names.size() != metrics.size()) {
+        throw std::invalid_argument("Stage names and metrics mismatch");
+    }
+
+    std::ostringstream out;
+    const auto add_family{[&](const char* name, const char* help, const auto& value_of) {
+        out << "# HELP silkworm_stage_" << name << " " << help << "\n"
+            << "# TYPE silkworm_stage_" << name << " counter\n";
+        for (size_t i{0}; i < metrics.size(); ++i) {
+            out << "silkworm_stage_" << name << "{stage=\"" << stage_names[i] << "\"} " << value_of(metrics[i])
+                << "\n";
+        }
+    }};
+    const auto seconds{[](auto duration) { return std::chrono::duration<double>(duration).count(); }};
+
+    add_family("runs_total", "Measured runs of the stage", [](const StageMetrics& m) { return m.runs; });
+    add_family("wall_seconds_total", "Elapsed time", [&](const StageMetrics& m) { return seconds(m.wall_time); });
+    add_family("cpu_seconds_total", "Process CPU time (user + system) while the stage was running",
+               [&](const StageMetrics& m) { return seconds(m.cpu_time); });
+    add_family("commit_seconds_total", "Time spent committing the stage transaction",
+               [&](const StageMetrics& m) { return seconds(m.commit_time); });
+    add_family("commits_total", "Commits of the stage transaction", [](const StageMetrics& m) { return m.commits; });
+    add_family("committed_bytes_total", "Dirty space of transactions committed by the stage",
+               [](const StageMetrics& m) { return m.committed_bytes; });
+    add_family("etl_flushed_bytes_total", "Bytes flushed by ETL collectors to files while the stage was running",
+               [](const StageMetrics& m) { return m.etl_flushed_bytes; });
+    add_family("minor_page_faults_total", "Process page faults served without I/O while the stage was running",
+               [](const StageMetrics& m) { return m.minor_page_faults; });
+    add_family("major_page_faults_total", "Process page faults requiring I/O while the stage was running",
+               [](const StageMetrics& m) { return m.major_page_faults; });
+    add_family("block_inputs_total", "Process file system input operations while the stage was running",
+               [](const StageMetrics& m) { return m.block_inputs; });
+    add_family("block_outputs_total", "Process file system output operations while the stage was running",
+               [](const StageMetrics& m) { return m.block_outputs; });
+    return out.str();
+}
+
+void write_metrics_file(const std::string& path, const std::string& text) {
+    const fs::path target{path};
+    fs::path temp{target};
+    temp += ".tmp";
+    {
+        std::ofstream file{temp, std::ios::out | std::ios::trunc};
+        file << text;
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Unable to write " + temp.string());
+        }
+    }
+    fs::rename(temp, target);
+}
+
+}  // namespace silkworm::stagedsync
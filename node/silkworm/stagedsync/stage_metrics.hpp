@@ -0,0 +1,78 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <silkworm/common/resource_usage.hpp>
+#include <silkworm/common/stopwatch.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Resources consumed by a stage
+//! \remarks CPU time, page faults, block I/O and ETL flushes are sampled process-wide: they include whatever else the
+//! process does meanwhile (e.g. RPC calls)
+struct StageMetrics {
+    uint64_t runs{0};                                    // Number of runs measured
+    StopWatch::Duration wall_time{0};                    // Elapsed time
+    std::chrono::microseconds cpu_time{0};               // User + system (all threads)
+    std::chrono::steady_clock::duration commit_time{0};  // Time spent committing the stage transaction
+    uint64_t commits{0};                                 // Commits of the stage transaction
+    uint64_t committed_bytes{0};                         // Dirty space of committed transactions
+    uint64_t etl_flushed_bytes{0};                       // Bytes flushed by ETL collectors to files
+    uint64_t minor_page_faults{0};                       // Served without I/O
+    uint64_t major_page_faults{0};                       // Requiring I/O
+    uint64_t block_inputs{0};                            // File system input operations
+    uint64_t block_outputs{0};                           // File system output operations
+
+    StageMetrics& operator+=(const StageMetrics& other);
+
+    //! \brief Returns key-value pairs suitable for log lines
+    [[nodiscard]] std::vector<std::string> to_log_args() const;
+};
+
+//! \brief Samples counters at construction so that what a stage consumes afterwards can be added to its metrics
+class StageMetricsProbe {
+  public:
+    explicit StageMetricsProbe(const db::RWTxn& txn);
+
+    //! \brief Returns what has been consumed since construction (as a single run)
+    //! \param [in] txn : the same transaction the probe has been built with
+    [[nodiscard]] StageMetrics sample(const db::RWTxn& txn) const;
+
+  private:
+    std::chrono::steady_clock::time_point start_;
+    ResourceUsage usage_;
+    db::RWTxn::CommitStats commit_stats_;
+    uint64_t etl_flushed_bytes_;
+};
+
+//! \brief Renders cumulative metrics of each stage in Prometheus text exposition format
+//! \param [in] stage_names : the names of the stages
+//! \param [in] metrics : the metrics of each stage (same order as names)
+[[nodiscard]] std::string to_prometheus_text(const std::vector<std::string>& stage_names,
+                                             const std::vector<StageMetrics>& metrics);
+
+//! \brief Writes text to path atomically (i.e. through a temporary file then renamed) so that a scraper never reads
+//! a partial file
+void write_metrics_file(const std::string& path, const std::string& text);
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,79 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_metrics.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_context.hpp>
+#include <silkworm/db/tables.hpp>
+
+namespace silkworm::stagedsync {
+
+TEST_CASE("Stage metrics probe") {
+    test::Context context;
+    context.commit_txn();
+
+    SECTION("Managed transaction") {
+        db::RWTxn txn{context.env()};
+        const StageMetricsProbe probe{txn};
+        auto cursor{db::open_cursor(*txn, db::table::kCanonicalHashes)};
+        const Bytes key{db::block_key(1)};
+        cursor.upsert(db::to_slice(key), db::to_slice(key));
+        txn.commit();
+
+        const auto metrics{probe.sample(txn)};
+        CHECK(metrics.runs == 1);
+        CHECK(metrics.commits == 1);
+        CHECK(metrics.committed_bytes > 0);
+        CHECK(metrics.wall_time >= metrics.commit_time);
+    }
+
+    SECTION("External transaction") {
+        auto external_txn{context.env().start_write()};
+        db::RWTxn txn{external_txn};
+        const StageMetricsProbe probe{txn};
+        txn.commit();
+
+        const auto metrics{probe.sample(txn)};
+        CHECK(metrics.commits == 0);
+        CHECK(metrics.committed_bytes == 0);
+    }
+}
+
+TEST_CASE("Stage metrics in Prometheus format") {
+    StageMetrics first;
+    first.runs = 1;
+    first.wall_time = std::chrono::milliseconds(1'500);
+    first.commits = 2;
+    StageMetrics second{first};
+    second.committed_bytes = 4096;
+    first += second;
+    CHECK(first.runs == 2);
+    CHECK(first.wall_time == std::chrono::seconds(3));
+    CHECK(first.commits == 4);
+    CHECK(first.committed_bytes == 4096);
+
+    const auto text{to_prometheus_text({"Headers", "Bodies"}, {first, second})};
+    CHECK(text.find("# TYPE silkworm_stage_runs_total counter\n") != std::string::npos);
+    CHECK(text.find("silkworm_stage_runs_total{stage=\"Headers\"} 2\n") != std::string::npos);
+    CHECK(text.find("silkworm_stage_wall_seconds_total{stage=\"Bodies\"} 1.5\n") != std::string::npos);
+    CHECK(text.find("silkworm_stage_committed_bytes_total{stage=\"Bodies\"} 4096\n") != std::string::npos);
+
+    CHECK_THROWS_AS(to_prometheus_text({"Headers"}, {first, second}), std::invalid_argument);
+}
+
+}  // namespace silkworm::stagedsync
@@ -23,7 +23,7 @@ StageResult Senders::forward(db::RWTxn& txn) {
         return StageResult::kUnknownChainId;
     }
 
-    farm_ = std::make_unique<recovery::RecoveryFarm>(txn, node_settings_);
+    farm_ = std::make_unique<recovery::RecoveryFarm>(txn, node_settings_, prerecovery_);
     const auto res{farm_->recover()};
     if (res == StageResult::kSuccess) {
         txn.commit();
@@ -23,10 +23,13 @@ namespace silkworm::stagedsync {
 
 class Senders final : public IStage {
   public:
-    explicit Senders(NodeSettings* node_settings) : IStage(db::stages::kSendersKey, node_settings){};
+    //! \param [in] prerecovery : optional source of senders recovered by the body downloader ahead of this stage
+    explicit Senders(NodeSettings* node_settings, recovery::SenderPrerecovery* prerecovery = nullptr)
+        : IStage(db::stages::kSendersKey, node_settings), prerecovery_{prerecovery} {};
     ~Senders() override = default;
 
     StageResult forward(db::RWTxn& txn) final;
+    [[nodiscard]] const char* input_source() const final { return db::stages::kBlockBodiesKey; }
     StageResult unwind(db::RWTxn& txn, BlockNum to) final;
     StageResult prune(db::RWTxn& txn) final;
     std::vector<std::string> get_log_progress() final;
@@ -34,6 +37,7 @@ class Senders final : public IStage {
 
   private:
     std::unique_ptr<recovery::RecoveryFarm> farm_{nullptr};
+    recovery::SenderPrerecovery* prerecovery_;
 };
 
 }  // namespace silkworm::stagedsync
@@ -16,12 +16,11 @@
 
 #include "recovery_farm.hpp"
 
-#include <functional>
-#include <mutex>
+#include <algorithm>
+#include <thread>
 
 #include <silkpre/secp256k1n.hpp>
 
-#include <silkworm/common/as_range.hpp>
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
@@ -30,16 +29,20 @@
 
 namespace silkworm::stagedsync::recovery {
 
-RecoveryFarm::RecoveryFarm(db::RWTxn& txn, NodeSettings* node_settings)
+RecoveryFarm::RecoveryFarm(db::RWTxn& txn, NodeSettings* node_settings, SenderPrerecovery* prerecovery)
     : txn_{txn},
       node_settings_{node_settings},
-      collector_(node_settings),
-      batch_size_{node_settings->batch_size / std::thread::hardware_concurrency() / sizeof(RecoveryPackage)} {
+      prerecovery_{prerecovery},
+      max_workers_{std::max(std::thread::hardware_concurrency(), 1u)},
+      max_pending_chunks_{std::max(node_settings->batch_size / sizeof(RecoveryPackage) / kChunkSize,
+                                   2 * static_cast<size_t>(max_workers_))},
+      chunk_{std::make_shared<RecoveryChunk>()} {
     workers_.reserve(max_workers_);
-    workers_connections_.reserve(max_workers_ * 2);  // One for task completed event and one for worker completed event
-    batch_.reserve(batch_size_);
+    chunk_->packages.reserve(kChunkSize);
 }
 
+RecoveryFarm::~RecoveryFarm() { stop_all_workers(/*wait=*/true); }
+
 StageResult RecoveryFarm::recover() {
     // Check stage boundaries from previous execution and previous stage execution
     auto previous_progress{db::stages::read_stage_progress(*txn_, db::stages::kSendersKey)};
@@ -65,112 +68,121 @@ StageResult RecoveryFarm::recover() {
         return stage_result;
     }
 
-    // Load block bodies
+    // Load block bodies, recover senders and write them as chunks get harvested
     uint64_t reached_block_num{0};                 // Block number being processed
-    header_index_offset_ = expected_block_number;  // See collect_workers_results
+    header_index_offset_ = expected_block_number;  // See harvest_chunks
 
     log::Trace() << "Senders begin read block bodies ... ";
     current_phase_ = 2;
-    auto bodies_table{db::open_cursor(*txn_, db::table::kBlockBodies)};
-    auto transactions_table{db::open_cursor(*txn_, db::table::kBlockTransactions)};
-
-    std::vector<Transaction> transactions;
-
-    // Set to first block and read all in sequence
-    auto bodies_initial_key{db::block_key(expected_block_number, headers_it_1_->block_hash.bytes)};
-    auto body_data{bodies_table.find(db::to_slice(bodies_initial_key), false)};
-    while (body_data.done) {
-        auto body_data_key_view{db::from_slice(body_data.key)};
-        reached_block_num = endian::load_big_u64(body_data_key_view.data());
-        if (reached_block_num < expected_block_number) {
-            // The same block height has been recorded
-            // but is not canonical;
-            body_data = bodies_table.to_next(false);
-            continue;
-        } else if (reached_block_num > expected_block_number) {
-            // We surpassed the expected block which means
-            // either the db misses a block or blocks are not persisted
-            // in sequence
-            log::Error() << "Senders' recovery : Bad block sequence expected " << expected_block_number << " got "
-                         << reached_block_num;
-            stage_result = StageResult::kBadChainSequence;
-            break;
+    try {
+        auto bodies_table{db::open_cursor(*txn_, db::table::kBlockBodies)};
+        auto transactions_table{db::open_cursor(*txn_, db::table::kBlockTransactions)};
+
+        // Rows can be appended unless something has been left beyond the blocks to process
+        senders_table_ = db::open_cursor(*txn_, db::table::kSenders);
+        const auto last_row{senders_table_.to_last(/*throw_notfound=*/false)};
+        if (!last_row.done ||
+            endian::load_big_u64(static_cast<uint8_t*>(last_row.key.data())) < expected_block_number) {
+            put_flags_ = MDBX_put_flags_t::MDBX_APPEND;
         }
 
-        if (memcmp(&body_data_key_view[8], headers_it_1_->block_hash.bytes, sizeof(kHashLength)) != 0) {
-            // We stumbled into a non-canonical block (not matching header)
-            // move next and repeat
-            body_data = bodies_table.to_next(false);
-            continue;
-        }
+        std::vector<TransactionView> transactions;
+
+        // Set to first block and read all in sequence
+        auto bodies_initial_key{db::block_key(expected_block_number, headers_it_1_->block_hash.bytes)};
+        auto body_data{bodies_table.find(db::to_slice(bodies_initial_key), false)};
+        while (body_data.done) {
+            auto body_data_key_view{db::from_slice(body_data.key)};
+            reached_block_num = endian::load_big_u64(body_data_key_view.data());
+            if (reached_block_num < expected_block_number) {
+                // The same block height has been recorded
+                // but is not canonical;
+                body_data = bodies_table.to_next(false);
+                continue;
+            } else if (reached_block_num > expected_block_number) {
+                // We surpassed the expected block which means
+                // either the db misses a block or blocks are not persisted
+                // in sequence
+                log::Error() << "Senders' recovery : Bad block sequence expected " << expected_block_number
+                             << " got " << reached_block_num;
+                stage_result = StageResult::kBadChainSequence;
+                break;
+            }
 
-        // Every 1024 blocks check the SignalHandler has been triggered
-        if ((reached_block_num % 1024 == 0) && is_stopping()) {
-            break;
-        }
+            if (memcmp(&body_data_key_view[8], headers_it_1_->block_hash.bytes, sizeof(kHashLength)) != 0) {
+                // We stumbled into a non-canonical block (not matching header)
+                // move next and repeat
+                body_data = bodies_table.to_next(false);
+                continue;
+            }
+
+            // Every 1024 blocks check the SignalHandler has been triggered
+            if ((reached_block_num % 1024 == 0) && is_stopping()) {
+                break;
+            }
+
+            // Get the body and its transactions
+            auto body_rlp{db::from_slice(body_data.value)};
+            auto block_body{db::detail::decode_stored_block_body(body_rlp)};
+            if (block_body.txn_count) {
+                headers_it_1_->txn_count = block_body.txn_count;
+                db::read_transaction_views(transactions_table, block_body.base_txn_id, block_body.txn_count,
+                                           transactions);
+                std::optional<std::vector<evmc::address>> senders;
+                if (prerecovery_) {
+                    senders = prerecovery_->take(reached_block_num, headers_it_1_->block_hash);
+                    if (senders && senders->size() != transactions.size()) {
+                        senders.reset();
+                    }
+                }
+                stage_result = transform_and_fill_batch(reached_block_num, transactions, senders ? &*senders : nullptr);
+                if (stage_result != StageResult::kSuccess) {
+                    break;
+                }
+            }
 
-        // Get the body and its transactions
-        auto body_rlp{db::from_slice(body_data.value)};
-        auto block_body{db::detail::decode_stored_block_body(body_rlp)};
-        if (block_body.txn_count) {
-            headers_it_1_->txn_count = block_body.txn_count;
-            db::read_transactions(transactions_table, block_body.base_txn_id, block_body.txn_count, transactions);
-            stage_result = transform_and_fill_batch(reached_block_num, transactions);
-            if (stage_result != StageResult::kSuccess) {
+            // After processing move to next block number and header
+            if (++headers_it_1_ == headers_.end()) {
+                // We'd go beyond collected canonical headers
                 break;
             }
+            expected_block_number++;
+            body_data = bodies_table.to_next(false);
         }
 
-        // After processing move to next block number and header
-        if (++headers_it_1_ == headers_.end()) {
-            // We'd go beyond collected canonical headers
-            break;
+        log::Trace("Senders end", {"block", std::to_string(reached_block_num)});
+
+        // Dispatch the residual chunk then wait for all workers to complete
+        if (!is_stopping() && stage_result == StageResult::kSuccess) {
+            stage_result = dispatch_chunk();
         }
-        expected_block_number++;
-        body_data = bodies_table.to_next(false);
-    }
+        if (!is_stopping() && stage_result == StageResult::kSuccess) {
+            queue_.close();
+            stage_result = harvest_chunks(/*max_pending=*/0);
+        }
+        if (!is_stopping() && stage_result == StageResult::kSuccess) {
+            flush_senders_row();
+            senders_table_.close();
 
-    log::Trace("Senders end", {"block", std::to_string(reached_block_num)});
-
-    if (!is_stopping()                            // No stop requests
-        && stage_result == StageResult::kSuccess  // Previous steps ok
-        && dispatch_batch()                       // Residual batch dispatched
-    ) {
-        wait_workers_completion();
-        current_phase_ = 3;
-
-        // If everything ok from previous steps wait for all workers to complete
-        // and collect results
-
-        collect_workers_results();
-        if (!collector_.empty()) {
-            try {
-                // Prepare target table
-                auto target_table{db::open_cursor(*txn_, db::table::kSenders)};
-                log::Trace() << "ETL Load : Loading data into " << db::table::kSenders.name << " "
-                             << human_size(collector_.size());
-                collector_.load(target_table, nullptr, MDBX_put_flags_t::MDBX_APPEND);
-
-                // Update stage progress with last reached block number
-                db::stages::write_stage_progress(*txn_, db::stages::kSendersKey, reached_block_num);
-                txn_.commit();
-
-            } catch (const mdbx::exception& ex) {
-                log::Error() << "Unexpected db error in " << std::string(__FUNCTION__) << " : " << ex.what();
-                stage_result = StageResult::kDbError;
-            } catch (const std::exception& ex) {
-                log::Error() << "Unexpected error in " << std::string(__FUNCTION__) << " : " << ex.what();
-                stage_result = StageResult::kUnexpectedError;
-            } catch (...) {
-                log::Error() << "Unknown error in " << std::string(__FUNCTION__);
-                stage_result = StageResult::kUnexpectedError;
-            }
+            // Update stage progress with last reached block number
+            db::stages::write_stage_progress(*txn_, db::stages::kSendersKey, reached_block_num);
+            txn_.commit();
         }
+
+    } catch (const mdbx::exception& ex) {
+        log::Error() << "Unexpected db error in " << std::string(__FUNCTION__) << " : " << ex.what();
+        stage_result = StageResult::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error() << "Unexpected error in " << std::string(__FUNCTION__) << " : " << ex.what();
+        stage_result = StageResult::kUnexpectedError;
+    } catch (...) {
+        log::Error() << "Unknown error in " << std::string(__FUNCTION__);
+        stage_result = StageResult::kUnexpectedError;
     }
 
     stop_all_workers(/*wait=*/true);
     headers_.clear();
-    workers_connections_.clear();
+    pending_.clear();
     workers_.clear();
     return is_stopping() ? StageResult::kAborted : stage_result;
 }
@@ -200,15 +212,15 @@ std::vector<std::string> RecoveryFarm::get_log_progress() {
     if (!is_stopping()) {
         switch (current_phase_) {
             case 1:
-                return {"phase", std::to_string(current_phase_) + "/3", "blocks", std::to_string(headers_.size())};
+                return {"phase", std::to_string(current_phase_) + "/2", "blocks", std::to_string(headers_.size())};
             case 2:
-                return {"phase",        std::to_string(current_phase_) + "/3",  //
+                return {"phase",        std::to_string(current_phase_) + "/2",  //
                         "blocks",       std::to_string(headers_.size()),        //
                         "current",      std::to_string(total_processed_blocks_),
                         "transactions", std::to_string(total_collected_transactions_),
-                        "workers",      std::to_string(workers_in_flight_.load())};
-            case 3:
-                return {"phase", std::to_string(current_phase_) + "/3", "key", collector_.get_load_key()};
+                        "prerecovered", std::to_string(total_prerecovered_transactions_),
+                        "recovered",    std::to_string(total_recovered_transactions_),
+                        "workers",      std::to_string(workers_.size())};
             default:
                 break;
         }
@@ -217,80 +229,26 @@ std::vector<std::string> RecoveryFarm::get_log_progress() {
 }
 
 void RecoveryFarm::stop_all_workers(bool wait) {
+    queue_.abort();  // Wakes up idle workers
     for (const auto& worker : workers_) {
         log::Trace("Stopping recoverer", {"id", std::to_string(worker->get_id())});
         worker->stop(wait);
     }
 }
 
-void RecoveryFarm::wait_workers_completion() {
-    while (workers_in_flight_.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-}
-
-std::optional<size_t> RecoveryFarm::get_harvestable_worker() {
-    std::optional<size_t> ret;
-    {
-        std::scoped_lock lck(workers_mtx_);
-        if (!harvestable_workers_.empty()) {
-            ret.emplace(harvestable_workers_.front());
-            harvestable_workers_.pop();
-        }
+StageResult RecoveryFarm::transform_and_fill_batch(uint64_t block_num, const std::vector<TransactionView>& transactions,
+                                                   const std::vector<evmc::address>* senders) {
+    if (is_stopping()) {
+        return StageResult::kAborted;
     }
-    return ret;
-}
 
-bool RecoveryFarm::collect_workers_results() {
-    bool ret{true};
-    try {
-        std::vector<RecoveryPackage> worker_batch;
-        auto harvestable_worker{get_harvestable_worker()};
-        while (harvestable_worker.has_value()) {
-            auto& worker{*(workers_.at(harvestable_worker.value()))};
-            log::Trace("Collecting results", {"worker", std::to_string(harvestable_worker.value())});
-            worker.set_work(worker_batch, /*kick=*/false);
-            BlockNum block_num{0};
-            Bytes etl_key;
-            Bytes etl_data;
-            for (const auto& package : worker_batch) {
-                if (package.block_num != block_num) {
-                    if (!etl_key.empty()) {
-                        collector_.collect({etl_key, etl_data});
-                        etl_key.clear();
-                        etl_data.clear();
-                    }
-                    block_num = package.block_num;
-                    const auto& header_info{headers_.at(block_num - header_index_offset_)};
-                    etl_key = db::block_key(block_num, header_info.block_hash.bytes);
-                    etl_data.clear();
-                }
-                etl_data.append(package.tx_from.bytes, sizeof(evmc::address));
-            }
-            if (!etl_key.empty()) {
-                collector_.collect({etl_key, etl_data});
-                etl_key.clear();
-                etl_data.clear();
-            }
-            worker_batch.clear();
-            harvestable_worker = get_harvestable_worker();
+    // A chunk holds either packages to be recovered by workers or already recovered ones
+    const auto chunk_status{senders ? RecoveryChunk::Status::kRecovered : RecoveryChunk::Status::kPending};
+    if (chunk_->status != chunk_status) {
+        if (const auto res{dispatch_chunk()}; res != StageResult::kSuccess) {
+            return res;
         }
-
-    } catch (const std::exception& ex) {
-        log::Error() << "Unexpected error in " << std::string(__FUNCTION__) << " : " << ex.what();
-        ret = false;
-    }
-
-    // Something bad happened stop all recovery process
-    if (!ret) {
-        stop();
-    }
-    return ret;
-}
-
-StageResult RecoveryFarm::transform_and_fill_batch(uint64_t block_num, const std::vector<Transaction>& transactions) {
-    if (is_stopping()) {
-        return StageResult::kAborted;
+        chunk_->status = chunk_status;
     }
 
     const evmc_revision rev{node_settings_->chain_config->revision(block_num)};
@@ -300,107 +258,148 @@ StageResult RecoveryFarm::transform_and_fill_batch(uint64_t block_num, const std
     const bool has_london{rev >= EVMC_LONDON};
 
     uint32_t tx_id{0};
+    bool odd_y_parity{false};
+    std::optional<intx::uint256> chain_id;
+    intx::uint256 r, s;
+    Bytes rlp{};
     for (const auto& transaction : transactions) {
-        switch (transaction.type) {
+        switch (transaction.type()) {
             case Transaction::Type::kLegacy:
                 break;
             case Transaction::Type::kEip2930:
                 if (!has_berlin) {
-                    log::Error() << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type)
+                    log::Error() << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type())
                                  << " for transaction #" << tx_id << " in block #" << block_num << " before Berlin";
                     return StageResult::kInvalidTransaction;
                 }
                 break;
             case Transaction::Type::kEip1559:
                 if (!has_london) {
-                    log::Error() << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type)
+                    log::Error() << "Transaction type " << magic_enum::enum_name<Transaction::Type>(transaction.type())
                                  << " for transaction #" << tx_id << " in block #" << block_num << " before London";
                     return StageResult::kInvalidTransaction;
                 }
                 break;
         }
 
-        if (!silkpre::is_valid_signature(transaction.r, transaction.s, has_homestead)) {
+        if (transaction.decode_signature(odd_y_parity, chain_id, r, s) != DecodingResult::kOk) {
+            log::Error() << "Got undecodable signature for transaction #" << tx_id << " in block #" << block_num;
+            return StageResult::kInvalidTransaction;
+        }
+
+        if (!silkpre::is_valid_signature(r, s, has_homestead)) {
             log::Error() << "Got invalid signature for transaction #" << tx_id << " in block #" << block_num;
             return StageResult::kInvalidTransaction;
         }
 
-        if (transaction.chain_id.has_value()) {
+        if (chain_id.has_value()) {
             if (!has_spurious_dragon) {
                 log::Error() << "EIP-155 signature for transaction #" << tx_id << " in block #" << block_num
                              << " before Spurious Dragon";
                 return StageResult::kInvalidTransaction;
-            } else if (transaction.chain_id.value() != node_settings_->chain_config->chain_id) {
+            } else if (chain_id.value() != node_settings_->chain_config->chain_id) {
                 log::Error() << "EIP-155 invalid signature for transaction #" << tx_id << " in block #" << block_num;
                 return StageResult::kInvalidTransaction;
             }
         }
 
-        Bytes rlp{};
-        rlp::encode(rlp, transaction, /*for_signing=*/true, /*wrap_eip2718_into_string=*/false);
+        if (senders) {
+            auto& package{chunk_->packages.emplace_back(RecoveryPackage{block_num, {}, odd_y_parity})};
+            package.tx_from = (*senders)[tx_id];
+            ++tx_id;
+            continue;
+        }
+
+        rlp.clear();
+        if (transaction.encode_for_signing(rlp) != DecodingResult::kOk) {
+            log::Error() << "Unable to encode for signing transaction #" << tx_id << " in block #" << block_num;
+            return StageResult::kInvalidTransaction;
+        }
 
         auto tx_hash{keccak256(rlp)};
-        batch_.push_back(RecoveryPackage{block_num, tx_hash, transaction.odd_y_parity});
-        intx::be::unsafe::store(batch_.back().tx_signature, transaction.r);
-        intx::be::unsafe::store(batch_.back().tx_signature + kHashLength, transaction.s);
+        auto& package{chunk_->packages.emplace_back(RecoveryPackage{block_num, tx_hash, odd_y_parity})};
+        intx::be::unsafe::store(package.tx_signature, r);
+        intx::be::unsafe::store(package.tx_signature + kHashLength, s);
 
         ++tx_id;
     }
     total_processed_blocks_++;
 
-    // Do we overflow ?
-    if (batch_.size() > batch_size_) {
-        total_collected_transactions_ += batch_.size();
-        if (!dispatch_batch()) {
-            return StageResult::kUnexpectedError;
+    // Is the chunk full ?
+    if (chunk_->packages.size() >= kChunkSize) {
+        if (const auto res{dispatch_chunk()}; res != StageResult::kSuccess) {
+            return res;
         }
     }
 
     return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
 }
 
-bool RecoveryFarm::dispatch_batch() {
-    // Locate first available worker
-    uint_fast32_t wait_count{5};
-    while (!is_stopping() && collect_workers_results() == true) {
-        auto it = as_range::find_if(workers_, [](const std::unique_ptr<RecoveryWorker>& w) {
-            return w->get_state() == RecoveryWorker::State::kKickWaiting;
-        });
-
-        if (it != workers_.end()) {
-            log::Trace("Dispatching batch ...",
-                       {"worker", std::to_string((*it)->get_id()), "items", std::to_string(batch_.size())});
-            (*it)->set_work(batch_, /*kick=*/true);  // Worker will swap contents
-            workers_in_flight_++;
-            batch_.clear();
-            batch_.reserve(batch_size_);
-            return true;
+StageResult RecoveryFarm::dispatch_chunk() {
+    if (chunk_->packages.empty()) {
+        return StageResult::kSuccess;
+    }
+    total_collected_transactions_ += chunk_->packages.size();
+    pending_.push_back(chunk_);
+    if (chunk_->status == RecoveryChunk::Status::kRecovered) {
+        // Nothing left to do but persisting it in order
+        total_prerecovered_transactions_ += chunk_->packages.size();
+        chunk_ = std::make_shared<RecoveryChunk>();
+        chunk_->packages.reserve(kChunkSize);
+        return harvest_chunks(/*max_pending=*/max_pending_chunks_ - 1);
+    }
+    queue_.push(std::move(chunk_));
+    chunk_ = std::make_shared<RecoveryChunk>();
+    chunk_->packages.reserve(kChunkSize);
+
+    // Spawn workers only as long as there's pending work for them
+    if (workers_.size() < max_workers_ && workers_.size() < pending_.size() && !initialize_new_worker()) {
+        if (workers_.empty()) {
+            log::Error() << "Unable to initialize any recovery worker. Aborting";
+            return StageResult::kUnexpectedError;
         }
+        log::Debug() << "Max recovery workers adjusted " << max_workers_ << " -> " << workers_.size();
+        max_workers_ = static_cast<uint32_t>(workers_.size());  // Don't try to spawn new workers. Maybe we're OOM
+    }
 
-        // We don't have a worker available
-        // Maybe we can create a new one if available
-        if (workers_.size() != max_workers_) {
-            if (initialize_new_worker()) {
-                continue;
-            }
-            if (workers_.empty()) {
-                log::Error() << "Unable to initialize any recovery worker. Aborting";
-                return false;
-            }
-            log::Debug() << "Max recovery workers adjusted " << max_workers_ << " -> " << workers_.size();
-            max_workers_ = static_cast<uint32_t>(workers_.size());  // Don't try to spawn new workers. Maybe we're OOM
+    // Bound memory usage: block reading till the oldest chunks are done
+    return harvest_chunks(/*max_pending=*/max_pending_chunks_ - 1);
+}
+
+StageResult RecoveryFarm::harvest_chunks(size_t max_pending) {
+    while (!pending_.empty()) {
+        const auto& chunk{*pending_.front()};
+        const auto status{queue_.status(chunk, /*wait=*/pending_.size() > max_pending)};
+        if (status == RecoveryChunk::Status::kPending) {
+            break;
+        }
+        if (status == RecoveryChunk::Status::kFailed) {
+            return is_stopping() ? StageResult::kAborted : StageResult::kInvalidTransaction;
         }
 
-        // No other option than wait a while and retry
-        if (!--wait_count) {
-            wait_count = 5;
-            log::Info() << "Waiting for available worker ...";
+        // Packages are in block order hence a block's senders span consecutive chunks
+        for (const auto& package : chunk.packages) {
+            if (row_key_.empty() || endian::load_big_u64(row_key_.data()) != package.block_num) {
+                flush_senders_row();
+                const auto& header_info{headers_.at(package.block_num - header_index_offset_)};
+                row_key_ = db::block_key(package.block_num, header_info.block_hash.bytes);
+            }
+            row_data_.append(package.tx_from.bytes, sizeof(evmc::address));
         }
-        std::unique_lock lck(workers_mtx_);
-        (void)worker_completed_cv_.wait_for(lck, std::chrono::seconds(5));
+        total_recovered_transactions_ += chunk.packages.size();
+        pending_.pop_front();
     }
+    return StageResult::kSuccess;
+}
 
-    return is_stopping();
+void RecoveryFarm::flush_senders_row() {
+    if (row_key_.empty()) {
+        return;
+    }
+    auto value{db::to_slice(row_data_)};
+    mdbx::error::success_or_throw(senders_table_.put(db::to_slice(row_key_), &value, put_flags_));
+    row_key_.clear();
+    row_data_.clear();
 }
 
 bool RecoveryFarm::initialize_new_worker() {
@@ -408,13 +407,8 @@ bool RecoveryFarm::initialize_new_worker() {
         return false;
     }
     log::Trace("Spawning new Recovery worker", {"id", std::to_string(workers_.size())});
-    using namespace std::placeholders;
     try {
-        workers_.emplace_back(new RecoveryWorker(workers_.size()));
-        workers_connections_.emplace_back(
-            workers_.back()->signal_task_completed.connect(std::bind(&RecoveryFarm::task_completed_handler, this, _1)));
-        workers_connections_.emplace_back(workers_.back()->signal_worker_stopped.connect(
-            std::bind(&RecoveryFarm::worker_completed_handler, this, _1)));
+        workers_.emplace_back(new RecoveryWorker(static_cast<uint32_t>(workers_.size()), queue_));
         workers_.back()->start(/*wait=*/true);
         return true;
     } catch (const std::exception& ex) {
@@ -481,24 +475,4 @@ StageResult RecoveryFarm::fill_canonical_headers(BlockNum from, BlockNum to) noe
     }
 }
 
-void RecoveryFarm::task_completed_handler(RecoveryWorker* sender) {
-    std::scoped_lock lck(workers_mtx_);
-    harvestable_workers_.push(sender->get_id());
-    if (workers_in_flight_) {
-        workers_in_flight_--;
-    }
-    worker_completed_cv_.notify_one();
-}
-
-void RecoveryFarm::worker_completed_handler(Worker* sender) {
-    std::scoped_lock lck(workers_mtx_);
-    if (workers_in_flight_) {
-        workers_in_flight_--;
-    }
-    if (sender->has_exception()) {
-        stop();
-    }
-    worker_completed_cv_.notify_one();
-}
-
 }  // namespace silkworm::stagedsync::recovery
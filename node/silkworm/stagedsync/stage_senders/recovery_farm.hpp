@@ -16,25 +16,33 @@
 
 #pragma once
 
-#include <atomic>
-#include <queue>
+#include <deque>
+#include <memory>
 
 #include <silkworm/concurrency/stoppable.hpp>
-#include <silkworm/etl/collector.hpp>
 #include <silkworm/stagedsync/common.hpp>
 #include <silkworm/stagedsync/stage_senders/recovery_worker.hpp>
+#include <silkworm/stagedsync/stage_senders/sender_prerecovery.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 namespace silkworm::stagedsync::recovery {
 
 //! \brief A class to orchestrate the work of multiple recoverers
+//! \details Transactions are cut into small fixed-size chunks taken by whichever worker is idle. Chunks are harvested
+//! in the order they were queued and recovered senders are written to db as soon as all the chunks before them are
+//! done, so no ETL pass is needed and the last chunks of a range are shared among all workers.
 class RecoveryFarm : public Stoppable {
   public:
+    //! \brief Number of transactions in a chunk of work
+    static constexpr size_t kChunkSize{1'024};
+
     RecoveryFarm() = delete;
 
     //! \brief This class coordinates the recovery of senders' addresses through multiple threads. May eventually handle
     //! the unwinding of already recovered addresses.
-    RecoveryFarm(db::RWTxn& txn, NodeSettings* node_settings);
-    ~RecoveryFarm() = default;
+    //! \param [in] prerecovery : optional source of senders recovered ahead, which are persisted without recovery
+    RecoveryFarm(db::RWTxn& txn, NodeSettings* node_settings, SenderPrerecovery* prerecovery = nullptr);
+    ~RecoveryFarm() override;
 
     //! \brief Recover sender's addresses from transactions
     //! \return A code indicating process status
@@ -59,33 +67,31 @@ class RecoveryFarm : public Stoppable {
     [[nodiscard]] std::vector<std::string> get_log_progress();
 
   private:
-    friend class RecoveryWorker;
-    friend class ::silkworm::Worker;
-
-    //! \brief Commands every threaded recovery worker to stop
+    //! \brief Aborts pending work and commands every threaded recovery worker to stop
     //! \param [in] wait : whether to wait for worker stopped
     void stop_all_workers(bool wait = true);
 
-    //! \brief Make the farm wait for every threaded worker to stop
-    void wait_workers_completion();
-
-    //! \brief Gets the first harvestable worker in the queue
-    std::optional<size_t> get_harvestable_worker();
-
-    //! \brief Collects results from worker's completed tasks
-    bool collect_workers_results();
-
     //! \brief Transforms transactions into recoverable packages
     //! \param [in] block_num : block number owning this set of transactions
     //! \param [in] transactions : a set of transactions to transform
+    //! \param [in] senders : senders of transactions if already recovered, nullptr otherwise
+    //! \return A code indicating process status
+    //! \remarks If the current chunk gets full it also dispatches it. Only signature fields are decoded
+    StageResult transform_and_fill_batch(BlockNum block_num, const std::vector<TransactionView>& transactions,
+                                         const std::vector<evmc::address>* senders = nullptr);
+
+    //! \brief Queues the current chunk of recovery packages for workers and harvests the completed ones
     //! \return A code indicating process status
-    //! \remarks If detects a batch overflow it also dispatches
-    StageResult transform_and_fill_batch(BlockNum block_num, const std::vector<Transaction>& transactions);
+    //! \remarks May spawn a new worker (up to max_workers) and blocks while too many chunks are pending
+    StageResult dispatch_chunk();
 
-    //! \brief Dispatches the collected batch of recovery packages to first available worker
-    //! \returns True if operation succeeds, false otherwise
-    //! \remarks May spawn new worker(s) up to max_workers
-    bool dispatch_batch();
+    //! \brief Writes the senders of recovered chunks in queuing order, stopping at the first one still pending
+    //! \param [in] max_pending : waits for the oldest chunk while more than max_pending chunks are pending
+    //! \return A code indicating process status
+    StageResult harvest_chunks(size_t max_pending);
+
+    //! \brief Writes the senders row of the block being harvested, if any
+    void flush_senders_row();
 
     //! \brief Spawns a new threaded worker
     bool initialize_new_worker();
@@ -96,26 +102,14 @@ class RecoveryFarm : public Stoppable {
     //! \return A code indicating process status
     StageResult fill_canonical_headers(BlockNum from, BlockNum to) noexcept;
 
-    //! \brief Handle task completion signal from workers
-    void task_completed_handler(RecoveryWorker* sender);
-
-    //! \brief Handle worker terminated signal from workers
-    void worker_completed_handler(Worker* sender);
-
-    db::RWTxn& txn_;               // Managed transaction
-    NodeSettings* node_settings_;  // Global node settings
-    etl::Collector collector_;     // Reserved collector
+    db::RWTxn& txn_;                  // Managed transaction
+    NodeSettings* node_settings_;     // Global node settings
+    SenderPrerecovery* prerecovery_;  // Senders recovered ahead (may be null)
 
     /* Recovery workers */
-    uint32_t max_workers_{std::thread::hardware_concurrency()};  // Max number of workers/threads
-
-    std::vector<boost::signals2::scoped_connection> workers_connections_{};  // Hold event connections to workers
-    std::vector<std::unique_ptr<RecoveryWorker>> workers_{};                 // Actual collection of recoverers
-
-    std::mutex workers_mtx_{};  // Synchronize with workers
-    std::condition_variable worker_completed_cv_{};
-    std::queue<size_t> harvestable_workers_{};    // Queue of ready to harvest workers
-    std::atomic<uint32_t> workers_in_flight_{0};  // Counter of grinding workers
+    uint32_t max_workers_;                                    // Max number of workers/threads
+    RecoveryQueue queue_{};                                   // Chunks waiting for an idle worker
+    std::vector<std::unique_ptr<RecoveryWorker>> workers_{};  // Actual collection of recoverers
 
     /* Canonical blocks + headers */
     struct HeaderInfo {
@@ -127,14 +121,23 @@ class RecoveryFarm : public Stoppable {
     std::vector<HeaderInfo>::iterator headers_it_1_;  // For blocks reading
     BlockNum header_index_offset_{};                  // To retrieve proper header hash while harvesting
 
-    /* Batches */
-    size_t batch_size_;                   // Max number of transaction to be sent a worker for recovery
-    std::vector<RecoveryPackage> batch_;  // Collection of transactions to be sent a worker for recovery
+    /* Chunks */
+    size_t max_pending_chunks_;                             // Max number of chunks dispatched but not harvested
+    std::shared_ptr<RecoveryChunk> chunk_;                  // Chunk being filled
+    std::deque<std::shared_ptr<RecoveryChunk>> pending_{};  // Dispatched chunks in queuing order
+
+    /* Senders rows */
+    mdbx::cursor_managed senders_table_{};                       // Target table
+    MDBX_put_flags_t put_flags_{MDBX_put_flags_t::MDBX_UPSERT};  // Whether rows can be appended
+    Bytes row_key_{};                                            // Key of the block being harvested
+    Bytes row_data_{};                                           // Senders of the block being harvested
 
     /* Stats */
     uint16_t current_phase_{0};
     size_t total_processed_blocks_{0};
     size_t total_collected_transactions_{0};
+    size_t total_prerecovered_transactions_{0};
+    size_t total_recovered_transactions_{0};
 };
 
 }  // namespace silkworm::stagedsync::recovery
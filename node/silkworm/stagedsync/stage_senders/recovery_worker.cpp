@@ -16,16 +16,104 @@
 
 #include "recovery_worker.hpp"
 
+#include <secp256k1_recovery.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include <silkpre/ecdsa.h>
 
 #include <silkworm/common/log.hpp>
-#include <silkworm/common/stopwatch.hpp>
+#include <silkworm/common/util.hpp>
 
 namespace silkworm::stagedsync::recovery {
 
-RecoveryWorker::RecoveryWorker(uint32_t id)
+namespace {
+
+    // Uncompressed public key : 0x04 prefix followed by x and y coordinates
+    using PublicKey = std::array<uint8_t, 65>;
+
+    //! \brief Recovers the public key of a package's signer
+    //! \remarks Same as silkpre_recover_address without the final keccak, which is batched by the caller
+    bool recover_public_key(secp256k1_context* context, const RecoveryPackage& package, PublicKey& out) {
+        secp256k1_ecdsa_recoverable_signature signature;
+        if (!secp256k1_ecdsa_recoverable_signature_parse_compact(context, &signature, package.tx_signature,
+                                                                 package.odd_y_parity ? 1 : 0)) {
+            return false;
+        }
+        secp256k1_pubkey public_key;
+        if (!secp256k1_ecdsa_recover(context, &public_key, &signature, package.tx_hash.bytes)) {
+            return false;
+        }
+        size_t size{out.size()};
+        secp256k1_ec_pubkey_serialize(context, out.data(), &size, &public_key, SECP256K1_EC_UNCOMPRESSED);
+        return size == out.size();
+    }
+
+}  // namespace
+
+void RecoveryQueue::push(std::shared_ptr<RecoveryChunk> chunk) {
+    {
+        std::scoped_lock lock{mutex_};
+        chunks_.push_back(std::move(chunk));
+    }
+    not_empty_.notify_one();
+}
+
+std::shared_ptr<RecoveryChunk> RecoveryQueue::pop() {
+    std::unique_lock lock{mutex_};
+    not_empty_.wait(lock, [this] { return !chunks_.empty() || closed_ || aborted_; });
+    if (aborted_ || chunks_.empty()) {
+        return nullptr;
+    }
+    auto chunk{std::move(chunks_.front())};
+    chunks_.pop_front();
+    return chunk;
+}
+
+void RecoveryQueue::complete(RecoveryChunk& chunk, bool recovered) {
+    // No lock: the farm reads the status without one and only sleeps when it's waiting for a chunk
+    chunk.status.store(recovered ? RecoveryChunk::Status::kRecovered : RecoveryChunk::Status::kFailed,
+                       std::memory_order_release);
+    completed_.notify();
+}
+
+RecoveryChunk::Status RecoveryQueue::status(const RecoveryChunk& chunk, bool wait) {
+    auto chunk_status{chunk.status.load(std::memory_order_acquire)};
+    while (wait && chunk_status == RecoveryChunk::Status::kPending && !aborted_) {
+        // Completions of other chunks wake up as well: check again
+        (void)completed_.wait_for(std::chrono::milliseconds{100});
+        chunk_status = chunk.status.load(std::memory_order_acquire);
+    }
+    if (chunk_status == RecoveryChunk::Status::kPending && aborted_) {
+        return RecoveryChunk::Status::kFailed;
+    }
+    return chunk_status;
+}
+
+void RecoveryQueue::close() {
+    {
+        std::scoped_lock lock{mutex_};
+        closed_ = true;
+    }
+    not_empty_.notify_all();
+}
+
+void RecoveryQueue::abort() {
+    {
+        std::scoped_lock lock{mutex_};
+        aborted_ = true;
+        chunks_.clear();
+    }
+    not_empty_.notify_all();
+    completed_.notify();
+}
+
+RecoveryWorker::RecoveryWorker(uint32_t id, RecoveryQueue& queue)
     : Worker("Address recoverer #" + std::to_string(id)),
       id_(id),
+      queue_{queue},
       context_{secp256k1_context_create(SILKPRE_SECP256K1_CONTEXT_FLAGS)} {
     if (!context_) {
         throw std::runtime_error("Could not create elliptic curve context");
@@ -38,48 +126,37 @@ RecoveryWorker::~RecoveryWorker() {
     }
 }
 
-void RecoveryWorker::set_work(std::vector<RecoveryPackage>& farm_batch, bool kick) {
-    batch_.swap(farm_batch);
-    if (kick) {
-        Worker::kick();
-    }
-}
-
 void RecoveryWorker::work() {
-    StopWatch sw;
-
-    while (wait_for_kick()) {
-        if (log::test_verbosity(log::Level::kTrace)) {
-            sw.start(true);
-        }
-
-        size_t processed{0};
-        BlockNum block_num{batch_.front().block_num};
-
-        for (auto& package : batch_) {
-            // On block switching check stopping
-            if (block_num != package.block_num && is_stopping()) {
-                throw std::runtime_error("Operation cancelled");
+    std::array<PublicKey, kKeccakBatchSize> public_keys;
+    std::array<ByteView, kKeccakBatchSize> hash_inputs;
+    std::array<ethash::hash256, kKeccakBatchSize> hashes;
+
+    while (auto chunk{queue_.pop()}) {
+        auto& packages{chunk->packages};
+        bool recovered{true};
+        for (size_t i{0}; recovered && i < packages.size(); i += kKeccakBatchSize) {
+            // Sender address is the tail of keccak256(x || y): hash a whole batch of public keys at once
+            const size_t batch_size{std::min(kKeccakBatchSize, packages.size() - i)};
+            for (size_t j{0}; j < batch_size; ++j) {
+                if (!recover_public_key(context_, packages[i + j], public_keys[j])) {
+                    log::Error(name_, {"block", std::to_string(packages[i + j].block_num), "error",
+                                       "unable to recover sender"});
+                    recovered = false;
+                    break;
+                }
+                hash_inputs[j] = ByteView{&public_keys[j][1], public_keys[j].size() - 1};
             }
-
-            if (!silkpre_recover_address(package.tx_from.bytes, package.tx_hash.bytes, package.tx_signature,
-                                         package.odd_y_parity, context_)) {
-                throw std::runtime_error("Unable to recover from address in block " + std::to_string(block_num));
+            if (!recovered) {
+                break;
+            }
+            keccak256_batch({hash_inputs.data(), batch_size}, hashes);
+            for (size_t j{0}; j < batch_size; ++j) {
+                std::memcpy(packages[i + j].tx_from.bytes, &hashes[j].bytes[kHashLength - kAddressLength],
+                            kAddressLength);
             }
-            ++processed;
-        }
-
-        // Some measurements
-        if (sw) {
-            auto [_, elapsed]{sw.stop()};
-            auto elapsed_seconds{std::chrono::duration_cast<std::chrono::seconds>(elapsed)};
-            auto package_speed{elapsed_seconds.count() ? processed / static_cast<uint32_t>(elapsed_seconds.count())
-                                                       : processed};
-            log::Trace(name_, {"task completed", StopWatch::format(elapsed), "txn/s", std::to_string(package_speed)});
         }
-
-        // Raise task completed event
-        signal_task_completed(this);
+        // Always complete the chunk: the farm harvests chunks in order and would otherwise wait forever
+        queue_.complete(*chunk, recovered);
     }
 }
 
@@ -19,12 +19,16 @@
 #include <secp256k1.h>
 
 #include <atomic>
-#include <csignal>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
-#include <boost/signals2.hpp>
 #include <ethash/keccak.hpp>
 
+#include <silkworm/concurrency/auto_reset_event.hpp>
 #include <silkworm/concurrency/worker.hpp>
 #include <silkworm/db/util.hpp>
 
@@ -39,34 +43,68 @@ struct RecoveryPackage {
     evmc::address tx_from;     // Recovered address
 };
 
+//! \brief A fixed-size run of consecutive packages: the unit of work taken by recovery workers
+struct RecoveryChunk {
+    enum class Status { kPending, kRecovered, kFailed };
+
+    std::vector<RecoveryPackage> packages;
+    std::atomic<Status> status{Status::kPending};  // Published by workers with release semantics
+};
+
+//! \brief Chunks waiting for recovery. The first idle worker takes the oldest chunk, hence no worker sits idle while
+//! chunks are left and the tail of a block range is spread across all workers
+class RecoveryQueue {
+  public:
+    //! \brief Makes a chunk available to workers
+    void push(std::shared_ptr<RecoveryChunk> chunk);
+
+    //! \brief Waits for a chunk to recover
+    //! \return The oldest queued chunk or nullptr when the queue has been closed and drained or aborted
+    [[nodiscard]] std::shared_ptr<RecoveryChunk> pop();
+
+    //! \brief Records the outcome of a chunk recovery and wakes up whoever is waiting for it
+    void complete(RecoveryChunk& chunk, bool recovered);
+
+    //! \brief Returns the status of a chunk, optionally waiting for it to be processed
+    //! \remarks Pending chunks are reported as failed once the queue has been aborted. Only one thread (the farm) may
+    //! wait at a time
+    [[nodiscard]] RecoveryChunk::Status status(const RecoveryChunk& chunk, bool wait);
+
+    //! \brief No more chunks will be pushed: workers exit once queued ones are taken
+    void close();
+
+    //! \brief Drops queued chunks and wakes up both workers and waiters
+    void abort();
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;  // Signalled when a chunk is queued or queue is closed
+    AutoResetEvent completed_;           // Set when a chunk has been processed or queue is aborted
+    std::deque<std::shared_ptr<RecoveryChunk>> chunks_;
+    bool closed_{false};
+    std::atomic_bool aborted_{false};
+};
+
 //! \brief A threaded worker in charge to recover sender's addresses from transaction signatures
 //! \remarks Inherits from silkworm::Worker
 class RecoveryWorker final : public silkworm::Worker {
   public:
     //! \brief Creates an instance of recovery worker
     //! \param [in] id : unique identifier for this instance
-    //! \remarks data_size is expressed as number of transactions to recover per batch times address size
-    explicit RecoveryWorker(uint32_t id);
+    //! \param [in] queue : the queue chunks to recover are taken from
+    RecoveryWorker(uint32_t id, RecoveryQueue& queue);
 
     ~RecoveryWorker() final;
 
-    //! \brief Feed the worker with a new set of data to process
-    //! \param [in] batch : collection of work packages
-    //! \param [in] kick : whether to kick the worker
-    void set_work(std::vector<RecoveryPackage>& farm_batch, bool kick = false);
-
     //! \brief Returns the identifier of this recoverer
     uint32_t get_id() const { return id_; }
 
-    //! \brief Signals connected handlers a task is completed
-    boost::signals2::signal<void(RecoveryWorker* sender)> signal_task_completed;
-
   private:
-    const uint32_t id_;                   // Unique identifier
-    std::vector<RecoveryPackage> batch_;  // Batch to process
-    secp256k1_context* context_;          // Elliptic curve context;
+    const uint32_t id_;           // Unique identifier
+    RecoveryQueue& queue_;        // Source of chunks to recover
+    secp256k1_context* context_;  // Elliptic curve context;
 
-    //! \brief Basic recovery work loop
+    //! \brief Basic recovery work loop: takes chunks from queue until it's closed or aborted
     //! \remarks Overrides Worker::work()
     void work() final;
 };
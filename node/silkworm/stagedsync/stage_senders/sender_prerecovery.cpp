@@ -0,0 +1,69 @@
+/*
+   Copyright 2020-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sender_prerecovery.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace silkworm::stagedsync::recovery {
+
+SenderPrerecovery::SenderPrerecovery(uint32_t num_threads, size_t max_blocks)
+    : max_blocks_{max_blocks}, pool_{std::max(num_threads, 1u)} {}
+
+void SenderPrerecovery::submit(const Block& block, const evmc::bytes32& block_hash) {
+    if (block.transactions.empty()) {
+        return;
+    }
+    auto transactions{std::make_shared<std::vector<Transaction>>(block.transactions)};
+    pool_.push_task([this, key = BlockKey{block.header.number, block_hash}, transactions] {
+        std::vector<evmc::address> senders;
+        senders.reserve(transactions->size());
+        for (auto& transaction : *transactions) {
+            transaction.from.reset();
+            transaction.recover_sender();
+            if (!transaction.from) {
+                return;
+            }
+            senders.push_back(*transaction.from);
+        }
+
+        std::scoped_lock lock{mutex_};
+        senders_.insert_or_assign(key, std::move(senders));
+        while (senders_.size() > max_blocks_) {
+            senders_.erase(senders_.begin());
+        }
+    });
+}
+
+std::optional<std::vector<evmc::address>> SenderPrerecovery::take(BlockNum block_num,
+                                                                  const evmc::bytes32& block_hash) {
+    std::scoped_lock lock{mutex_};
+    auto node{senders_.extract(BlockKey{block_num, block_hash})};
+    if (node.empty()) {
+        return std::nullopt;
+    }
+    return std::move(node.mapped());
+}
+
+size_t SenderPrerecovery::size() const {
+    std::scoped_lock lock{mutex_};
+    return senders_.size();
+}
+
+void SenderPrerecovery::wait() { pool_.wait_for_tasks(); }
+
+}  // namespace silkworm::stagedsync::recovery
@@ -0,0 +1,67 @@
+/*
+   Copyright 2020-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::stagedsync::recovery {
+
+//! \brief Recovers the senders of blocks as soon as the body downloader accepts them, so that the Senders stage
+//! only has to persist results already computed
+//! \remarks Thread-safe. Results are kept for a bounded number of blocks: the lowest ones are dropped first
+class SenderPrerecovery {
+  public:
+    static constexpr size_t kDefaultMaxBlocks{10'000};
+
+    explicit SenderPrerecovery(uint32_t num_threads = std::thread::hardware_concurrency(),
+                               size_t max_blocks = kDefaultMaxBlocks);
+
+    // Not copyable nor movable
+    SenderPrerecovery(const SenderPrerecovery&) = delete;
+    SenderPrerecovery& operator=(const SenderPrerecovery&) = delete;
+
+    //! \brief Schedules the recovery of the senders of a block
+    //! \remarks Blocks with any unrecoverable sender are discarded: the Senders stage will process them on its own
+    void submit(const Block& block, const evmc::bytes32& block_hash);
+
+    //! \brief Takes the recovered senders of a block, if available
+    [[nodiscard]] std::optional<std::vector<evmc::address>> take(BlockNum block_num, const evmc::bytes32& block_hash);
+
+    //! \brief Number of blocks whose senders are available
+    [[nodiscard]] size_t size() const;
+
+    //! \brief Waits for all scheduled recoveries to complete
+    void wait();
+
+  private:
+    using BlockKey = std::pair<BlockNum, evmc::bytes32>;
+
+    const size_t max_blocks_;
+    mutable std::mutex mutex_;  // Guards senders_
+    std::map<BlockKey, std::vector<evmc::address>> senders_;
+    thread_pool pool_;  // Last member so that pending tasks complete before the others get destroyed
+};
+
+}  // namespace silkworm::stagedsync::recovery
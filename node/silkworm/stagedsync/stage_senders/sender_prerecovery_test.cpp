@@ -0,0 +1,66 @@
+/*
+   Copyright 2020-2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sender_prerecovery.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/test_util.hpp>
+
+namespace silkworm::stagedsync::recovery {
+
+TEST_CASE("SenderPrerecovery") {
+    SenderPrerecovery prerecovery{/*num_threads=*/2, /*max_blocks=*/2};
+    const auto expected_sender{0xc15eb501c014515ad0ecb4ecbf75cc597110b060_address};
+    const auto block_hash{0x3ac225168df54212a25c1c01fd35bebfea408fdac2e31ddd6f80a4bbf9a5f1cb_bytes32};
+
+    Block block;
+    block.transactions.push_back(test::sample_transactions()[0]);
+    block.transactions.push_back(test::sample_transactions()[0]);
+
+    SECTION("Recovered senders are taken once") {
+        block.header.number = 1;
+        prerecovery.submit(block, block_hash);
+        prerecovery.wait();
+
+        CHECK_FALSE(prerecovery.take(1, evmc::bytes32{}));
+        const auto senders{prerecovery.take(1, block_hash)};
+        REQUIRE(senders);
+        CHECK(*senders == std::vector<evmc::address>{expected_sender, expected_sender});
+        CHECK_FALSE(prerecovery.take(1, block_hash));
+    }
+
+    SECTION("Lowest blocks are dropped first") {
+        for (BlockNum block_num{1}; block_num <= 3; ++block_num) {
+            block.header.number = block_num;
+            prerecovery.submit(block, block_hash);
+        }
+        prerecovery.wait();
+
+        CHECK(prerecovery.size() == 2);
+        CHECK_FALSE(prerecovery.take(1, block_hash));
+        CHECK(prerecovery.take(3, block_hash));
+    }
+
+    SECTION("Blocks without transactions are ignored") {
+        block.transactions.clear();
+        prerecovery.submit(block, block_hash);
+        prerecovery.wait();
+        CHECK(prerecovery.size() == 0);
+    }
+}
+
+}  // namespace silkworm::stagedsync::recovery
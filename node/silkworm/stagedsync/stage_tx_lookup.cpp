@@ -14,13 +14,23 @@
    limitations under the License.
 */
 
+#include "stage_tx_lookup.hpp"
+
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include <silkworm/common/assert.hpp>
 #include <silkworm/common/endian.hpp>
 #include <silkworm/common/log.hpp>
+#include <silkworm/common/rlp_err.hpp>
+#include <silkworm/db/parallel_walk.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/etl/collector.hpp>
+#include <silkworm/types/transaction_view.hpp>
 
 #include "stagedsync.hpp"
 
@@ -28,34 +38,36 @@ namespace silkworm::stagedsync {
 
 namespace fs = std::filesystem;
 
-StageResult stage_tx_lookup(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
-    fs::create_directories(etl_path);
-    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
-
-    auto expected_block_number{db::stages::read_stage_progress(*txn, db::stages::kTxLookupKey) + 1};
-
+//! \brief Collects hash => compacted block number mappings of transactions in blocks [block_from, block_to]
+//! \return The last block number reached
+static BlockNum extract_tx_lookup(mdbx::txn& txn, etl::Collector& collector, BlockNum block_from,
+                                  BlockNum block_to = std::numeric_limits<BlockNum>::max()) {
     // We take number from bodies table, and hash from transaction table
-    auto bodies_table{db::open_cursor(*txn, db::table::kBlockBodies)};
-    auto transactions_table{db::open_cursor(*txn, db::table::kBlockTransactions)};
-
-    if (expected_block_number < prune_from) {
-        expected_block_number = prune_from;
-    }
+    auto bodies_table{db::open_cursor(txn, db::table::kBlockBodies)};
+    auto transactions_table{db::open_cursor(txn, db::table::kBlockTransactions)};
 
     Bytes start(8, '\0');
-    endian::store_big_u64(&start[0], expected_block_number);
-
-    log::Info() << "Started Tx Lookup Extraction";
+    endian::store_big_u64(&start[0], block_from);
 
     auto bodies_data{bodies_table.lower_bound(db::to_slice(start), /*throw_notfound*/ false)};
 
+    // Both tables are scanned sequentially: have the kernel read their pages ahead
+    db::ScanReadAhead bodies_read_ahead;
+    db::ScanReadAhead transactions_read_ahead;
+
     BlockNum block_number{0};
+    TransactionView tx_view;
 
     while (bodies_data) {
+        bodies_read_ahead.advise(bodies_data.key);
         auto body_rlp{db::from_slice(bodies_data.value)};
         auto body{db::detail::decode_stored_block_body(body_rlp)};
         // Block number is computed here in order to record accurate stage progress
-        block_number = endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.data()));
+        const BlockNum reached_block_number{endian::load_big_u64(static_cast<uint8_t*>(bodies_data.key.data()))};
+        if (reached_block_number > block_to) {
+            break;
+        }
+        block_number = reached_block_number;
         // Iterate over transactions in current block
         if (body.txn_count) {
             // Extract compact form of big endian block number
@@ -69,9 +81,11 @@ StageResult stage_tx_lookup(db::RWTxn& txn, const std::filesystem::path& etl_pat
             uint64_t tx_count{0};
 
             while (tx_data && tx_count < body.txn_count) {
-                // Hash transaction rlp
-                auto tx_view{db::from_slice(tx_data.value)};
-                auto hash{keccak256(tx_view)};
+                transactions_read_ahead.advise(tx_data.key);
+                // Hash transaction rlp: only the envelope is parsed, fields are never decoded
+                auto tx_rlp{db::from_slice(tx_data.value)};
+                rlp::success_or_throw(tx_view.parse(tx_rlp));
+                auto hash{tx_view.hash()};
                 // Collect hash => compacted block number mapping
                 etl::Entry entry{Bytes(hash.bytes, 32), block_compact_data};
                 collector.collect(entry);
@@ -88,27 +102,104 @@ StageResult stage_tx_lookup(db::RWTxn& txn, const std::filesystem::path& etl_pat
         bodies_data = bodies_table.to_next(/*throw_notfound*/ false);
     }
 
+    return block_number;
+}
+
+//! \brief Same as extract_tx_lookup for all blocks from block_from onwards. If txn is read-only, large block ranges are
+//! split into smaller ones taken by parallel threads, each on its own snapshot and collecting into its own collector
+//! eventually merged into collector
+//! \return The last block number reached
+//! \remarks Other snapshots see the same bodies txn does only if txn is read-only: write transactions see uncommitted
+//! data, hence get processed on a single thread
+static BlockNum collect_tx_lookup(mdbx::txn& txn, etl::Collector& collector, BlockNum block_from,
+                                  const fs::path& etl_path, size_t buffer_size) {
+    // Ranges much smaller than the whole block span: later blocks are far denser in transactions than early ones
+    static constexpr BlockNum kMinParallelBlocks{10'000};
+    static constexpr size_t kRangesPerThread{16};
+
+    log::Info() << "Started Tx Lookup Extraction";
+
+    BlockNum block_to{0};
+    if (txn.is_readonly()) {
+        auto bodies_table{db::open_cursor(txn, db::table::kBlockBodies)};
+        if (const auto last{bodies_table.to_last(/*throw_notfound=*/false)}; last) {
+            block_to = endian::load_big_u64(static_cast<uint8_t*>(last.key.data()));
+        }
+    }
+    const size_t num_threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (block_to < block_from || block_to - block_from + 1 < kMinParallelBlocks || num_threads == 1) {
+        const BlockNum block_number{extract_tx_lookup(txn, collector, block_from)};
+        log::Info() << "Entries Collected << " << collector.size();
+        return block_number;
+    }
+
+    const size_t thread_buffer_size{std::max(buffer_size / num_threads, 16_Mebi)};
+    std::vector<std::unique_ptr<etl::Collector>> collectors;
+    for (size_t i{0}; i < num_threads; ++i) {
+        collectors.push_back(std::make_unique<etl::Collector>(etl_path, thread_buffer_size));
+    }
+    db::parallel_for_block_ranges(txn.env(), block_from, block_to, num_threads, kRangesPerThread,
+                                  [&](size_t worker, mdbx::txn& ro_txn, BlockNum from, BlockNum to) {
+                                      (void)extract_tx_lookup(ro_txn, *collectors[worker], from, to);
+                                  });
+
+    for (auto& thread_collector : collectors) {
+        collector.merge(*thread_collector);
+    }
     log::Info() << "Entries Collected << " << collector.size();
+    return block_to;
+}
+
+//! \brief Loads collected hash => compacted block number mappings into TxLookup
+static void load_tx_lookup(db::RWTxn& txn, etl::Collector& collector) {
+    log::Info() << "Started tx Hashes Loading";
+
+    /*
+     * If we're on first sync then we shouldn't have any records in target
+     * table. For this reason we can apply MDB_APPEND to load as
+     * collector (with no transform) ensures collected entries
+     * are already sorted. If instead target table contains already
+     * some data the only option is to load in upsert mode as we
+     * cannot guarantee keys are sorted amongst different calls
+     * of this stage
+     */
+    auto target_table{db::open_cursor(*txn, db::table::kTxLookup)};
+    auto target_table_rcount{txn->get_map_stat(target_table.map()).ms_entries};
+
+    // Eventually load collected items with no transform (may throw)
+    if (target_table_rcount) {
+        collector.load(target_table, nullptr, MDBX_put_flags_t::MDBX_UPSERT);
+    } else {
+        // Bulk loading may commit along the way: should we stop halfway, next run upserts the same records again
+        target_table.close();
+        db::BulkLoader loader{txn, db::table::kTxLookup};
+        collector.load(loader);
+    }
+}
+
+StageResult stage_tx_lookup(db::RWTxn& txn, const std::filesystem::path& etl_path, uint64_t prune_from) {
+    fs::create_directories(etl_path);
+    etl::Collector collector(etl_path, /* flush size */ 512_Mebi);
+
+    auto expected_block_number{db::stages::read_stage_progress(*txn, db::stages::kTxLookupKey) + 1};
+    if (expected_block_number < prune_from) {
+        expected_block_number = prune_from;
+    }
+
+    // Read-only snapshots only see committed data: unless this runs within an external transaction, commit so that
+    // extraction can spread over parallel snapshots
+    BlockNum block_number{0};
+    if (txn.is_external()) {
+        block_number = collect_tx_lookup(*txn, collector, expected_block_number, etl_path, 512_Mebi);
+    } else {
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        block_number = collect_tx_lookup(ro_txn, collector, expected_block_number, etl_path, 512_Mebi);
+    }
 
     // Proceed only if we've done something
     if (!collector.empty()) {
-        log::Info() << "Started tx Hashes Loading";
-
-        /*
-         * If we're on first sync then we shouldn't have any records in target
-         * table. For this reason we can apply MDB_APPEND to load as
-         * collector (with no transform) ensures collected entries
-         * are already sorted. If instead target table contains already
-         * some data the only option is to load in upsert mode as we
-         * cannot guarantee keys are sorted amongst different calls
-         * of this stage
-         */
-        auto target_table{db::open_cursor(*txn, db::table::kTxLookup)};
-        auto target_table_rcount{txn->get_map_stat(target_table.map()).ms_entries};
-        MDBX_put_flags_t db_flags{target_table_rcount ? MDBX_put_flags_t::MDBX_UPSERT : MDBX_put_flags_t::MDBX_APPEND};
-
-        // Eventually load collected items with no transform (may throw)
-        collector.load(target_table, nullptr, db_flags);
+        load_tx_lookup(txn, collector);
 
         // Update progress height with last processed block
         db::stages::write_stage_progress(*txn, db::stages::kTxLookupKey, block_number);
@@ -141,6 +232,7 @@ StageResult unwind_tx_lookup(db::RWTxn& txn, const std::filesystem::path&, uint6
                 << " to: " << unwind_to;
 
     auto bodies_data{bodies_table.lower_bound(db::to_slice(start), /*throw_notfound*/ false)};
+    TransactionView tx_view;
     while (bodies_data) {
         auto body_rlp{db::from_slice(bodies_data.value)};
         auto body{db::detail::decode_stored_block_body(body_rlp)};
@@ -152,8 +244,9 @@ StageResult unwind_tx_lookup(db::RWTxn& txn, const std::filesystem::path&, uint6
             uint64_t tx_count{0};
 
             while (tx_data && tx_count < body.txn_count) {
-                auto tx_view{db::from_slice(tx_data.value)};
-                auto hash{keccak256(tx_view)};
+                auto tx_rlp{db::from_slice(tx_data.value)};
+                rlp::success_or_throw(tx_view.parse(tx_rlp));
+                auto hash{tx_view.hash()};
                 lookup_table.erase(db::to_slice(hash.bytes));
                 ++tx_count;
                 tx_data = transactions_table.to_next(/*throw_notfound*/ false);
@@ -197,4 +290,159 @@ StageResult prune_tx_lookup(db::RWTxn& txn, const std::filesystem::path&, uint64
     return StageResult::kSuccess;
 }
 
+StageResult TxLookup::forward(db::RWTxn& txn) {
+    StageResult result{StageResult::kSuccess};
+    if (txn.is_external()) {
+        result = extract_forward(*txn);
+    } else {
+        // Read-only snapshots only see committed data: commit so that extraction can spread over parallel snapshots
+        txn.force_commit();
+        auto ro_txn{txn->env().start_read()};
+        result = extract_forward(ro_txn);
+    }
+    return result == StageResult::kSuccess ? load_forward(txn) : result;
+}
+
+StageResult TxLookup::extract_forward(mdbx::txn& txn) {
+    try {
+        throw_if_stopping();
+        collector_.reset();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        previous_progress_ = db::stages::read_stage_progress(txn, stage_name_);
+        target_progress_ = db::stages::read_stage_progress(txn, db::stages::kExecutionKey);
+        if (previous_progress_ == target_progress_) {
+            // Nothing to process
+            return StageResult::kSuccess;
+        } else if (previous_progress_ > target_progress_) {
+            log::Error() << "Bad progress sequence. " << stage_name_ << " stage progress " << previous_progress_
+                         << " while Execution stage " << target_progress_;
+            return StageResult::kInvalidProgress;
+        }
+
+        operation_ = OperationType::Forward;
+        const auto& prune_threshold{node_settings_->prune_mode->tx_index()};
+        const BlockNum prune_from{prune_threshold.enabled() ? prune_threshold.value_from_head(target_progress_) : 0};
+        collector_ = std::make_unique<etl::Collector>(node_settings_);
+        (void)collect_tx_lookup(txn, *collector_, std::max(previous_progress_ + 1, prune_from),
+                                node_settings_->data_directory->etl().path(), node_settings_->etl_buffer_size);
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    return StageResult::kSuccess;
+}
+
+StageResult TxLookup::load_forward(db::RWTxn& txn) {
+    if (!collector_) {
+        // Nothing has been extracted
+        return StageResult::kSuccess;
+    }
+    try {
+        throw_if_stopping();
+        if (!collector_->empty()) {
+            load_tx_lookup(txn, *collector_);
+        }
+        // Bodies are scanned to the end of table: record what Execution has actually processed
+        db::stages::write_stage_progress(*txn, stage_name_, target_progress_);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        collector_.reset();
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    collector_.reset();
+    return StageResult::kSuccess;
+}
+
+StageResult TxLookup::unwind(db::RWTxn& txn, BlockNum to) {
+    try {
+        throw_if_stopping();
+        if (to >= get_progress(txn)) {
+            // Nothing to unwind actually
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Unwind;
+        success_or_throw(unwind_tx_lookup(txn, node_settings_->data_directory->etl().path(), to));
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+StageResult TxLookup::prune(db::RWTxn& txn) {
+    try {
+        throw_if_stopping();
+        const auto& prune_threshold{node_settings_->prune_mode->tx_index()};
+        if (!prune_threshold.enabled()) {
+            return StageResult::kSuccess;
+        }
+        const auto forward_progress{get_progress(txn)};
+        if (db::stages::read_stage_prune_progress(*txn, stage_name_) >= forward_progress) {
+            // Nothing to prune since last run
+            return StageResult::kSuccess;
+        }
+
+        operation_ = OperationType::Prune;
+        if (const BlockNum prune_from{prune_threshold.value_from_head(forward_progress)}; prune_from) {
+            success_or_throw(prune_tx_lookup(txn, node_settings_->data_directory->etl().path(), prune_from));
+        }
+        db::stages::write_stage_prune_progress(*txn, stage_name_, forward_progress);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_),
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        return static_cast<StageResult>(ex.err());
+    } catch (const std::exception& ex) {
+        operation_ = OperationType::None;
+        log::Error(std::string(stage_name_), {"exception", std::string(ex.what())});
+        return StageResult::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return StageResult::kSuccess;
+}
+
+std::vector<std::string> TxLookup::get_log_progress() {
+    const auto operation{operation_.load()};
+    if (operation == OperationType::None) {
+        return {};
+    }
+    return {"op", std::string(magic_enum::enum_name<OperationType>(operation))};
+}
+
 }  // namespace silkworm::stagedsync
@@ -16,20 +16,53 @@
 
 #include "sync_loop.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <thread>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
 #include <boost/format.hpp>
 
+#include <silkworm/common/memory_governor.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/geometry.hpp>
 #include <silkworm/stagedsync/stage_blockhashes.hpp>
 #include <silkworm/stagedsync/stage_execution.hpp>
 #include <silkworm/stagedsync/stage_hashstate.hpp>
+#include <silkworm/stagedsync/stage_history_index.hpp>
+#include <silkworm/stagedsync/stage_log_index.hpp>
 #include <silkworm/stagedsync/stage_senders.hpp>
+#include <silkworm/stagedsync/stage_tx_lookup.hpp>
 
 namespace silkworm::stagedsync {
 
+//! \brief Whether the source of stage has progressed beyond it, i.e. whether its forward has anything to do
+//! \remarks A stage ahead of its source is not skipped: its forward reports the bad progress sequence
+static bool has_input(db::RWTxn& txn, const IStage& stage) {
+    const char* source{stage.input_source()};
+    if (!source) {
+        return true;
+    }
+    return db::stages::read_stage_progress(*txn, source) != db::stages::read_stage_progress(*txn, stage.name());
+}
+
 void SyncLoop::load_stages() {
     stages_.push_back(std::make_unique<stagedsync::BlockHashes>(node_settings_));
     stages_.push_back(std::make_unique<stagedsync::Senders>(node_settings_));
-    stages_.push_back(std::make_unique<stagedsync::Execution>(node_settings_));
-    stages_.push_back(std::make_unique<stagedsync::HashState>(node_settings_));
+    stages_.push_back(std::make_unique<stagedsync::Execution>(node_settings_, &changed_keys_));
+    stages_.push_back(std::make_unique<stagedsync::HashState>(node_settings_, &changed_keys_));
+    stages_.push_back(std::make_unique<stagedsync::HistoryIndex>(node_settings_, /*storage=*/false));
+    stages_.push_back(std::make_unique<stagedsync::HistoryIndex>(node_settings_, /*storage=*/true));
+    stages_.push_back(std::make_unique<stagedsync::LogIndex>(node_settings_));
+    stages_.push_back(std::make_unique<stagedsync::TxLookup>(node_settings_));
+    stage_metrics_.resize(stages_.size());
+    if (Pruner::required(*node_settings_->prune_mode)) {
+        pruner_ = std::make_unique<Pruner>(node_settings_, chaindata_env_);
+    }
 }
 
 void SyncLoop::stop(bool wait) {
@@ -38,6 +71,9 @@ void SyncLoop::stop(bool wait) {
             stage->stop();
         }
     }
+    if (pruner_) {
+        pruner_->stop();
+    }
     Worker::stop(wait);
 }
 
@@ -45,6 +81,8 @@ void SyncLoop::work() {
     log::Trace() << "Synchronization loop started";
 
     bool is_first_cycle{true};
+    const bool tip_follow{node_settings_->sync_loop_tip_latency_ms != 0};
+    BlockNum processed_headers{0};
     std::unique_ptr<db::RWTxn> cycle_txn{nullptr};
     mdbx::txn_managed external_txn;
 
@@ -61,7 +99,18 @@ void SyncLoop::work() {
         },
         true);
 
+    // Pruning runs in between cycles only: a cycle starting meanwhile waits at most for the chunk in progress
+    if (pruner_) {
+        pruner_->start(/*wait=*/false);
+    }
+
     while (!is_stopping()) {
+        if (tip_follow && !is_first_cycle && !wait_for_headers(processed_headers)) {
+            break;
+        }
+        if (pruner_) {
+            pruner_->pause();
+        }
         current_stage_ = 0;
         cycle_stop_watch.start(/*with_reset=*/true);
 
@@ -72,6 +121,7 @@ void SyncLoop::work() {
         {
             auto ro_tx{chaindata_env_->start_read()};
             auto origin{db::stages::read_stage_progress(ro_tx, db::stages::kHeadersKey)};
+            processed_headers = origin;
             if (highest_seen_header >= origin && highest_seen_header - origin > 8096) {
                 cycle_in_one_tx = false;
             }
@@ -82,33 +132,54 @@ void SyncLoop::work() {
             }
         }
 
+        grow_chaindata();
+
         if (cycle_in_one_tx) {
             // A single commit at the end of the cycle
             external_txn = chaindata_env_->start_write();
             cycle_txn = std::make_unique<db::RWTxn>(external_txn);
         } else {
-            // Single stages will commit
+            // Single stages will commit (as the commit policy allows)
             cycle_txn = std::make_unique<db::RWTxn>(*chaindata_env_);
+            cycle_txn->set_commit_policy(node_settings_->commit_policy);
         }
 
         if (run_cycle(*cycle_txn, log_timer) != StageResult::kSuccess) {
             break;
         }
 
+        StopWatch commit_stop_watch{/*auto_start=*/true};
         if (cycle_in_one_tx) {
             external_txn.commit();
+            observe_commit_time(commit_stop_watch.stop().second);
         } else {
-            cycle_txn->commit();
+            cycle_txn->force_commit();
+            const auto& commit_stats{cycle_txn->commit_stats()};
+            observe_commit_time(std::chrono::duration_cast<StopWatch::Duration>(
+                commit_stats.duration / std::max<uint64_t>(commit_stats.count, 1)));
         }
 
         cycle_txn.reset();
         is_first_cycle = false;
+        if (pruner_) {
+            pruner_->resume();
+        }
+        export_metrics();
 
         auto [_, cycle_duration] = cycle_stop_watch.lap();
         log::Info("Cycle completed", {"elapsed", StopWatch::format(cycle_duration)});
         throttle_next_cycle(cycle_duration);
 
-        break;  // TODO(Andrea) Remove
+        if (!tip_follow) {
+            break;  // TODO(Andrea) Remove
+        }
+    }
+
+    if (pruner_) {
+        pruner_->stop(/*wait=*/true);
+        // Nothing else is writing now: complete the pass in progress (if any) unless stop is requested
+        while (!is_stopping() && pruner_->prune_chunk()) {
+        }
     }
 
     log_timer.stop();
@@ -119,18 +190,42 @@ StageResult SyncLoop::run_cycle(db::RWTxn& cycle_txn, Timer& log_timer) {
     StopWatch stages_stop_watch;
     (void)stages_stop_watch.start();
     try {
-        for (; current_stage_ < stages_.size() && !is_stopping(); ++current_stage_) {
+        while (current_stage_ < stages_.size() && !is_stopping()) {
+            if (!has_input(cycle_txn, *stages_.at(current_stage_))) {
+                log::Trace(get_log_prefix(), {"skipped", "no input"});
+                ++current_stage_;
+                continue;
+            }
+
+            // Snapshots only see committed data: stages can run concurrently only when each one commits on its own
+            if (const size_t group_end{cycle_txn.is_external() ? current_stage_ : concurrent_stages_end()};
+                group_end > current_stage_ + 1) {
+                const size_t group_size{group_end - current_stage_};
+                log_timer.reset();  // Resets the interval for next log line from now
+                if (const auto result{run_concurrent_stages(cycle_txn, group_end)}; result != StageResult::kSuccess) {
+                    return result;
+                }
+                auto [_, group_duration] = stages_stop_watch.lap();
+                log::Info("Concurrent stages",
+                          {"count", std::to_string(group_size), "done", StopWatch::format(group_duration)});
+                continue;
+            }
+
             auto& stage{stages_.at(current_stage_)};
             log_timer.reset();  // Resets the interval for next log line from now
+            const StageMetricsProbe probe{cycle_txn};
             const auto stage_result{stage->forward(cycle_txn)};
             if (stage_result != StageResult::kSuccess) {
                 log::Error(get_log_prefix(), {"return", std::string(magic_enum::enum_name<StageResult>(stage_result))});
                 return stage_result;
             }
+            const auto metrics{probe.sample(cycle_txn)};
+            stage_metrics_[current_stage_] += metrics;
             auto [_, stage_duration] = stages_stop_watch.lap();
             if (stage_duration > std::chrono::milliseconds(10)) {
-                log::Info(get_log_prefix(), {"done", StopWatch::format(stage_duration)});
+                log::Info(get_log_prefix(), metrics.to_log_args());
             }
+            ++current_stage_;
         }
         return is_stopping() ? StageResult::kAborted : StageResult::kSuccess;
     } catch (const std::exception& ex) {
@@ -139,6 +234,114 @@ StageResult SyncLoop::run_cycle(db::RWTxn& cycle_txn, Timer& log_timer) {
     }
 }
 
+size_t SyncLoop::concurrent_stages_end() const {
+    size_t end{current_stage_};
+    for (; end < stages_.size(); ++end) {
+        const char* source{stages_[end]->concurrent_source()};
+        if (!source) {
+            break;
+        }
+        // Source must have already been forwarded in this cycle, i.e. it cannot be in the group itself
+        const auto first{stages_.begin()};
+        const auto last{first + static_cast<std::ptrdiff_t>(current_stage_)};
+        const auto is_source{[source](const auto& stage) { return std::strcmp(stage->name(), source) == 0; }};
+        if (std::none_of(first, last, is_source)) {
+            break;
+        }
+    }
+    return end;
+}
+
+StageResult SyncLoop::run_concurrent_stages(db::RWTxn& cycle_txn, size_t group_end) {
+    // Publish what previous stages have written to the snapshots extraction reads from
+    cycle_txn.force_commit();
+
+    // Extraction is CPU and read bound: each stage reads through its own snapshot, its blocking work runs on the
+    // shared scheduler while this thread drives the stage coroutines
+    const size_t group_begin{current_stage_};
+    std::vector<StageResult> results(group_end - group_begin, StageResult::kSuccess);
+    // Process-wide counters cannot be told apart amongst concurrent extractions: only their elapsed time is recorded
+    std::vector<StopWatch::Duration> extraction_times(group_end - group_begin);
+    std::exception_ptr exception;
+    {
+        boost::asio::io_context io_context;
+        std::vector<std::future<StageResult>> extractions;
+        for (size_t i{group_begin}; i < group_end; ++i) {
+            auto extraction = [this, i, group_begin, &extraction_times]() -> boost::asio::awaitable<StageResult> {
+                StopWatch extraction_stop_watch{/*auto_start=*/true};
+                const auto result{
+                    co_await stages_[i]->async_extract_forward(*chaindata_env_, TaskScheduler::shared())};
+                extraction_times[i - group_begin] = extraction_stop_watch.stop().second;
+                co_return result;
+            };
+            extractions.push_back(boost::asio::co_spawn(io_context, extraction, boost::asio::use_future));
+        }
+        io_context.run();
+        for (size_t i{0}; i < extractions.size(); ++i) {
+            try {
+                results[i] = extractions[i].get();
+            } catch (...) {
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    // Loading writes into the only RW transaction hence is serialized
+    for (; current_stage_ < group_end; ++current_stage_) {
+        auto result{results[current_stage_ - group_begin]};
+        const StageMetricsProbe probe{cycle_txn};
+        if (result == StageResult::kSuccess) {
+            result = stages_[current_stage_]->load_forward(cycle_txn);
+        }
+        if (result != StageResult::kSuccess) {
+            log::Error(get_log_prefix(), {"return", std::string(magic_enum::enum_name<StageResult>(result))});
+            return result;
+        }
+        auto metrics{probe.sample(cycle_txn)};
+        metrics.wall_time += extraction_times[current_stage_ - group_begin];
+        stage_metrics_[current_stage_] += metrics;
+    }
+    return StageResult::kSuccess;
+}
+
+void SyncLoop::grow_chaindata() {
+    const auto& config{node_settings_->chaindata_env_config};
+    if (!config.headroom_size || config.inmemory || config.readonly) {
+        return;
+    }
+    try {
+        if (const size_t new_size{db::grow_geometry(*chaindata_env_, config.headroom_size)}; new_size) {
+            log::Info("Database grown", {"size", human_size(new_size)});
+        }
+    } catch (const std::exception& ex) {
+        // Not fatal: MDBX still grows by growth steps on demand
+        log::Warning("Database growth failed", {"exception", std::string(ex.what())});
+    }
+}
+
+void SyncLoop::export_metrics() {
+    const auto& path{node_settings_->sync_loop_metrics_file};
+    if (path.empty()) {
+        return;
+    }
+    std::vector<std::string> stage_names;
+    for (const auto& stage : stages_) {
+        stage_names.emplace_back(stage->name());
+    }
+    try {
+        write_metrics_file(path, to_prometheus_text(stage_names, stage_metrics_) +
+                                     MemoryGovernor::instance().to_prometheus_text());
+    } catch (const std::exception& ex) {
+        // Not fatal: metrics are going to be written again at the end of next cycle
+        log::Warning("Metrics export failed", {"path", path, "exception", std::string(ex.what())});
+    }
+}
+
 void SyncLoop::throttle_next_cycle(const StopWatch::Duration& cycle_duration) {
     if (is_stopping() || !node_settings_->sync_loop_throttle_seconds) {
         return;
@@ -160,6 +363,40 @@ void SyncLoop::throttle_next_cycle(const StopWatch::Duration& cycle_duration) {
         }
     }
 }
+bool SyncLoop::wait_for_headers(BlockNum processed_headers) {
+    static constexpr auto kPollInterval{std::chrono::milliseconds(10)};
+
+    while (true) {
+        if (is_stopping()) {
+            return false;
+        }
+        {
+            auto ro_tx{chaindata_env_->start_read()};
+            if (db::stages::read_stage_progress(ro_tx, db::stages::kHeadersKey) > processed_headers) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(kPollInterval);
+    }
+
+    // Each cycle pays at least one commit regardless of the number of blocks: wait for more headers long enough for
+    // the commit to stay within ~10% of the cycle, i.e. cheap commits mean a block at a time
+    const StopWatch::Duration max_budget{std::chrono::milliseconds(node_settings_->sync_loop_tip_latency_ms)};
+    const auto budget{std::min(max_budget, 9 * commit_time_)};
+    const auto deadline{std::chrono::steady_clock::now() + budget};
+    for (auto now{std::chrono::steady_clock::now()}; now < deadline; now = std::chrono::steady_clock::now()) {
+        if (is_stopping()) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(kPollInterval, deadline - now));
+    }
+    return true;
+}
+
+void SyncLoop::observe_commit_time(StopWatch::Duration commit_time) {
+    commit_time_ = commit_time_.count() ? (3 * commit_time_ + commit_time) / 4 : commit_time;
+}
+
 std::string SyncLoop::get_log_prefix() const {
     static std::string log_prefix_fmt{"Stage %u/%u : %s"};
     return boost::str(boost::format(log_prefix_fmt) % (current_stage_ + 1) % stages_.size() %
@@ -19,7 +19,10 @@
 #include <silkworm/common/asio_timer.hpp>
 #include <silkworm/common/stopwatch.hpp>
 #include <silkworm/concurrency/worker.hpp>
+#include <silkworm/db/changed_keys.hpp>
 #include <silkworm/stagedsync/common.hpp>
+#include <silkworm/stagedsync/pruner.hpp>
+#include <silkworm/stagedsync/stage_metrics.hpp>
 
 namespace silkworm::stagedsync {
 class SyncLoop final : public Worker {
@@ -35,15 +38,37 @@ class SyncLoop final : public Worker {
   private:
     silkworm::NodeSettings* node_settings_;  // As being passed by CLI arguments and/or already initialized data
     mdbx::env* chaindata_env_;               // The actual opened environment
+    db::ChangedKeys changed_keys_{};         // Keys changed by Execution for HashState within a cycle
     std::vector<std::unique_ptr<stagedsync::IStage>> stages_{};  // Collection of stages
     size_t current_stage_{0};                                    // Index of current stage
+    std::vector<StageMetrics> stage_metrics_{};                  // Cumulative metrics of each stage
+    std::unique_ptr<Pruner> pruner_{nullptr};                    // Background pruner (if prune mode requires one)
+    StopWatch::Duration commit_time_{0};                         // Moving average of the cost of a commit
     void work() final;                                           // The loop itself
     void load_stages();                                          // Fills the vector of stages
 
     //! \brief Runs a full sync cycle
     [[nodiscard]] StageResult run_cycle(db::RWTxn& cycle_txn, Timer& log_timer);
 
+    //! \brief Returns the end (exclusive) of the run of stages starting at current stage which can be forwarded
+    //! concurrently as their sources have already been forwarded
+    [[nodiscard]] size_t concurrent_stages_end() const;
+
+    //! \brief Runs extraction of stages in [current stage, group_end) concurrently on read-only snapshots, then loads
+    //! their data serially into cycle_txn
+    //! \remarks Requires cycle_txn to commit on its own, i.e. not to be a wrapper over an external transaction.
+    //! On return current stage is past the last stage loaded
+    [[nodiscard]] StageResult run_concurrent_stages(db::RWTxn& cycle_txn, size_t group_end);
+
+    void grow_chaindata();  // Grows chaindata ahead of demand (if configured) before a cycle writes to it
+    void export_metrics();  // Writes stage metrics to the metrics file (if configured)
     void throttle_next_cycle(const StopWatch::Duration& cycle_duration);  // Delays (if required) next cycle run
+
+    //! \brief Tip-follow mode: waits for headers beyond processed_headers, then keeps coalescing incoming ones for as
+    //! long as the observed cost of a commit suggests, within the configured latency budget
+    //! \return False if stop has been requested meanwhile
+    [[nodiscard]] bool wait_for_headers(BlockNum processed_headers);
+    void observe_commit_time(StopWatch::Duration commit_time);  // Updates the moving average of commit cost
     std::string get_log_prefix() const;  // Returns the current log lines prefix on behalf of current stage
 };
 }  // namespace silkworm::stagedsync
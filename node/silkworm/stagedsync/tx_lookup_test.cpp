@@ -20,6 +20,7 @@
 #include <silkworm/common/test_context.hpp>
 #include <silkworm/common/test_util.hpp>
 
+#include "stage_tx_lookup.hpp"
 #include "stagedsync.hpp"
 
 using namespace evmc::literals;
@@ -56,8 +57,12 @@ TEST_CASE("Stage Transaction Lookups") {
 
     block.base_txn_id = 2;
 
+    tx_rlp.clear();
     rlp::encode(tx_rlp, transactions[1]);
-    auto tx_hash_2{keccak256(tx_rlp)};
+    // Typed transactions are hashed without the string wrapping they are stored with
+    Bytes tx_canonical_rlp{};
+    rlp::encode(tx_canonical_rlp, transactions[1], /*for_signing=*/false, /*wrap_eip2718_into_string=*/false);
+    auto tx_hash_2{keccak256(tx_canonical_rlp)};
 
     transaction_table.upsert(db::to_slice(db::block_key(2)), db::to_slice(tx_rlp));
     bodies_table.upsert(db::to_slice(db::block_key(2, hash_1.bytes)), db::to_slice(block.encode()));
@@ -96,6 +101,31 @@ TEST_CASE("Stage Transaction Lookups") {
         // Block 2 must be absent due to unwind
         CHECK(!lookup_table.seek(db::to_slice(tx_hash_1.bytes)));
     }
+
+    SECTION("Stage unwind and forward") {
+        NodeSettings node_settings;
+        node_settings.data_directory = std::make_unique<DataDirectory>(context.dir().path());
+        node_settings.prune_mode = std::make_unique<db::PruneMode>();
+        db::stages::write_stage_progress(*txn, db::stages::kExecutionKey, 2);
+
+        stagedsync::TxLookup stage(&node_settings);
+        REQUIRE(stage.get_progress(txn) == 2);
+        REQUIRE(stage.unwind(txn, 1) == stagedsync::StageResult::kSuccess);
+        REQUIRE(stage.get_progress(txn) == 1);
+        auto lookup_table{db::open_cursor(*txn, db::table::kTxLookup)};
+        CHECK(!lookup_table.seek(db::to_slice(tx_hash_2.bytes)));
+
+        // Forward re-indexes what has been unwound up to Execution progress: extraction alone writes nothing
+        REQUIRE(stage.extract_forward(*txn) == stagedsync::StageResult::kSuccess);
+        CHECK(stage.get_progress(txn) == 1);
+        CHECK(!lookup_table.seek(db::to_slice(tx_hash_2.bytes)));
+        REQUIRE(stage.load_forward(txn) == stagedsync::StageResult::kSuccess);
+        REQUIRE(stage.get_progress(txn) == 2);
+        lookup_table = db::open_cursor(*txn, db::table::kTxLookup);
+        auto got_block_1{db::from_slice(lookup_table.find(db::to_slice(tx_hash_2.bytes)).value)};
+        CHECK(got_block_1.compare(ByteView({2})) == 0);
+        CHECK(stage.get_log_progress().empty());
+    }
 }
 
 }  // namespace silkworm
@@ -16,26 +16,64 @@
 
 #include "intermediate_hashes.hpp"
 
+#include <algorithm>
 #include <bitset>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
+#include <silkworm/common/address_hash_cache.hpp>
 #include <silkworm/common/assert.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/instrumentation.hpp>
 #include <silkworm/common/log.hpp>
 #include <silkworm/common/rlp_err.hpp>
+#include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/tables.hpp>
 
 namespace silkworm::trie {
 
-Cursor::Cursor(mdbx::cursor& cursor, PrefixSet& changed, ByteView prefix)
-    : cursor_{cursor}, changed_{changed}, prefix_{prefix} {
+Cursor::Cursor(mdbx::cursor& cursor, PrefixSet& changed, ByteView prefix, TrieCache* cache)
+    : cursor_{cursor}, changed_{changed}, prefix_{prefix}, cache_{cache} {
     consume_node(/*key=*/{}, /*exact=*/true);
 }
 
 void Cursor::consume_node(ByteView to, bool exact) {
     const Bytes db_key{prefix_ + Bytes{to}};
-    const auto entry{exact ? cursor_.find(db::to_slice(db_key), /*throw_notfound=*/false)
-                           : cursor_.lower_bound(db::to_slice(db_key), /*throw_notfound=*/false)};
 
-    if (!entry && !exact) {
+    bool found{false};
+    bool from_cache{false};
+    ByteView found_key;
+    std::optional<Node> node{std::nullopt};
+    const std::optional<Node>* cached{cache_ ? cache_->get(db_key) : nullptr};
+    if (cached && (exact || cached->has_value())) {
+        // A record at exactly db_key is also its lower bound
+        from_cache = true;
+        found = cached->has_value();
+        if (found) {
+            found_key = db_key;
+            node = *cached;
+        }
+    } else {
+        const auto entry{exact ? cursor_.find(db::to_slice(db_key), /*throw_notfound=*/false)
+                               : cursor_.lower_bound(db::to_slice(db_key), /*throw_notfound=*/false)};
+        found = entry.done;
+        if (found) {
+            found_key = db::from_slice(entry.key);
+            node = unmarshal_node(db::from_slice(entry.value));
+            SILKWORM_ASSERT(node.has_value());
+        }
+        if (cache_) {
+            if (found && cache_->is_cacheable(found_key)) {
+                cache_->put(found_key, node);
+            }
+            if (!found || found_key != db_key) {
+                cache_->put(db_key, std::nullopt);
+            }
+        }
+    }
+
+    if (!found && !exact) {
         // end-of-tree
         stack_.clear();
         return;
@@ -43,7 +81,7 @@ void Cursor::consume_node(ByteView to, bool exact) {
 
     ByteView key = to;
     if (!exact) {
-        key = db::from_slice(entry.key);
+        key = found_key;
         if (!key.starts_with(prefix_)) {
             stack_.clear();
             return;
@@ -51,10 +89,7 @@ void Cursor::consume_node(ByteView to, bool exact) {
         key.remove_prefix(prefix_.length());
     }
 
-    std::optional<Node> node{std::nullopt};
-    if (entry) {
-        node = unmarshal_node(db::from_slice(entry.value));
-        SILKWORM_ASSERT(node.has_value());
+    if (found) {
         SILKWORM_ASSERT(node->state_mask() != 0);
     }
 
@@ -77,8 +112,15 @@ void Cursor::consume_node(ByteView to, bool exact) {
     update_skip_state();
 
     // don't erase nodes with valid root hashes
-    if (entry && (!can_skip_state_ || nibble != -1)) {
-        cursor_.erase();
+    if (found && (!can_skip_state_ || nibble != -1)) {
+        if (from_cache) {
+            (void)cursor_.erase(db::to_slice(db_key));
+        } else {
+            cursor_.erase();
+        }
+        if (cache_) {
+            cache_->put(prefix_ + stack_.back().key, std::nullopt);
+        }
     }
 }
 
@@ -223,8 +265,15 @@ std::optional<Bytes> Cursor::first_uncovered_prefix() const {
     return pack_nibbles(*k);
 }
 
-DbTrieLoader::DbTrieLoader(mdbx::txn& txn, etl::Collector& account_collector, etl::Collector& storage_collector)
-    : txn_{txn}, storage_collector_{storage_collector} {
+DbTrieLoader::DbTrieLoader(mdbx::txn& txn, etl::Collector& account_collector, etl::Collector& storage_collector,
+                           size_t num_threads, TrieCache* account_trie_cache, TrieCache* storage_trie_cache)
+    : txn_{txn},
+      account_trie_cache_{account_trie_cache},
+      storage_trie_cache_{storage_trie_cache},
+      storage_collector_{storage_collector} {
+    if (num_threads > 1) {
+        pool_ = std::make_unique<thread_pool>(static_cast<uint32_t>(num_threads));
+    }
     hb_.node_collector = [&account_collector](ByteView unpacked_key, const Node& node) {
         if (unpacked_key.empty()) {
             return;
@@ -279,12 +328,14 @@ In practice Trie is not full - it means that after account key `{30 zero bytes}0
 amount of iterations will not be big.
 */
 evmc::bytes32 DbTrieLoader::calculate_root(PrefixSet& account_changes, PrefixSet& storage_changes) {
+    SILK_SCOPED_TIMER("trie::DbTrieLoader::calculate_root");
     auto state{db::open_cursor(txn_, db::table::kHashedAccounts)};
     auto trie_db_cursor{db::open_cursor(txn_, db::table::kTrieOfAccounts)};
 
-    for (Cursor trie{trie_db_cursor, account_changes}; trie.key().has_value();) {
+    for (Cursor trie{trie_db_cursor, account_changes, /*prefix=*/{}, account_trie_cache_}; trie.key().has_value();) {
         if (trie.can_skip_state()) {
             SILKWORM_ASSERT(trie.hash() != nullptr);
+            add_pending_accounts(/*max_pending=*/0);  // Keys of pending accounts precede this node
             hb_.add_branch_node(*trie.key(), *trie.hash(), trie.children_are_in_trie());
         }
 
@@ -298,42 +349,79 @@ evmc::bytes32 DbTrieLoader::calculate_root(PrefixSet& account_changes, PrefixSet
 
         for (auto acc{state.lower_bound(db::to_slice(*uncovered), /*throw_notfound=*/false)}; acc;
              acc = state.to_next(/*throw_notfound=*/false)) {
-            const Bytes unpacked_key{unpack_nibbles(db::from_slice(acc.key))};
+            Bytes unpacked_key{unpack_nibbles(db::from_slice(acc.key))};
             if (trie.key().has_value() && trie.key().value() < unpacked_key) {
                 break;
             }
             const auto [account, err]{Account::from_encoded_storage(db::from_slice(acc.value))};
             rlp::success_or_throw(err);
 
-            evmc::bytes32 storage_root{kEmptyRoot};
-
+            PendingAccount& pending{pending_accounts_.emplace_back()};
+            pending.unpacked_key = std::move(unpacked_key);
+            pending.account = account;
             if (account.incarnation) {
                 const Bytes key_with_inc{db::storage_prefix(db::from_slice(acc.key), account.incarnation)};
-                storage_root = calculate_storage_root(key_with_inc, storage_changes);
+                calculate_storage_root(key_with_inc, storage_changes, pending);
             }
-
-            hb_.add_leaf(unpacked_key, account.rlp(storage_root));
+            add_pending_accounts(kMaxPendingAccounts);
         }
     }
 
+    add_pending_accounts(/*max_pending=*/0);
     return hb_.root_hash();
 }
 
-evmc::bytes32 DbTrieLoader::calculate_storage_root(const Bytes& key_with_inc, PrefixSet& changed) {
+void DbTrieLoader::add_pending_accounts(size_t max_pending) {
+    while (!pending_accounts_.empty()) {
+        PendingAccount& account{pending_accounts_.front()};
+        if (account.storage.valid()) {
+            if (pending_accounts_.size() <= max_pending &&
+                account.storage.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                break;
+            }
+            StorageTrieResult result{account.storage.get()};
+            account.storage_root = result.root;
+            for (auto& node : result.nodes) {
+                storage_collector_.collect(std::move(node));
+            }
+        }
+        hb_.add_leaf(account.unpacked_key, account.account.rlp(account.storage_root));
+        pending_accounts_.pop_front();
+    }
+}
+
+void DbTrieLoader::calculate_storage_root(const Bytes& key_with_inc, PrefixSet& changed, PendingAccount& account) {
     auto state{db::open_cursor(txn_, db::table::kHashedStorage)};
     auto trie_db_cursor{db::open_cursor(txn_, db::table::kTrieOfStorage)};
 
-    HashBuilder hb;
-    hb.node_collector = [&](ByteView unpacked_storage_key, const Node& node) {
-        etl::Entry e{key_with_inc, marshal_node(node)};
-        e.key.append(unpacked_storage_key);
-        storage_collector_.collect(std::move(e));
-    };
+    // Storage entries are buffered for a worker to hash them, unless there's no pool or there are too many of them:
+    // then they're fed to a local builder as they're read
+    std::vector<StorageTrieEntry> entries;
+    std::unique_ptr<HashBuilder> hb;
+    const auto add_entry{[&](StorageTrieEntry entry) {
+        if (!hb && pool_ && entries.size() < kMaxBufferedStorageEntries) {
+            entries.push_back(std::move(entry));
+            return;
+        }
+        if (!hb) {
+            hb = std::make_unique<HashBuilder>();
+            hb->node_collector = [&](ByteView unpacked_storage_key, const Node& node) {
+                etl::Entry e{key_with_inc, marshal_node(node)};
+                e.key.append(unpacked_storage_key);
+                storage_collector_.collect(std::move(e));
+            };
+            for (const auto& buffered : entries) {
+                add_storage_entry(*hb, buffered);
+            }
+            entries.clear();
+        }
+        add_storage_entry(*hb, entry);
+    }};
 
-    for (Cursor trie{trie_db_cursor, changed, key_with_inc}; trie.key().has_value();) {
+    for (Cursor trie{trie_db_cursor, changed, key_with_inc, storage_trie_cache_}; trie.key().has_value();) {
         if (trie.can_skip_state()) {
             SILKWORM_ASSERT(trie.hash() != nullptr);
-            hb.add_branch_node(*trie.key(), *trie.hash(), trie.children_are_in_trie());
+            add_entry({*trie.key(), /*leaf_rlp=*/{}, *trie.hash(), trie.children_are_in_trie()});
         }
 
         const std::optional<Bytes> uncovered{trie.first_uncovered_prefix()};
@@ -348,7 +436,7 @@ evmc::bytes32 DbTrieLoader::calculate_storage_root(const Bytes& key_with_inc, Pr
         for (auto storage{state.lower_bound_multivalue(db::to_slice(key_with_inc), db::to_slice(*uncovered),
                                                        /*throw_notfound=*/false)};
              storage; storage = state.to_current_next_multi(/*throw_notfound=*/false)) {
-            const Bytes unpacked_loc{unpack_nibbles(db::from_slice(storage.value).substr(0, kHashLength))};
+            Bytes unpacked_loc{unpack_nibbles(db::from_slice(storage.value).substr(0, kHashLength))};
             if (trie.key().has_value() && trie.key().value() < unpacked_loc) {
                 break;
             }
@@ -356,30 +444,93 @@ evmc::bytes32 DbTrieLoader::calculate_storage_root(const Bytes& key_with_inc, Pr
             const ByteView value{db::from_slice(storage.value).substr(kHashLength)};
             rlp_.clear();
             rlp::encode(rlp_, value);
-            hb.add_leaf(unpacked_loc, rlp_);
+            add_entry({std::move(unpacked_loc), rlp_, {}, false});
         }
     }
 
-    return hb.root_hash();
+    if (hb) {
+        account.storage_root = hb->root_hash();
+    } else if (entries.empty()) {
+        account.storage_root = kEmptyRoot;
+    } else {
+        // Shared rather than copied into the task
+        auto shared_entries{std::make_shared<const std::vector<StorageTrieEntry>>(std::move(entries))};
+        account.storage = pool_->submit(
+            [key_with_inc, shared_entries] { return hash_storage_trie(key_with_inc, *shared_entries); });
+    }
+}
+
+DbTrieLoader::StorageTrieResult DbTrieLoader::hash_storage_trie(const Bytes& key_with_inc,
+                                                                const std::vector<StorageTrieEntry>& entries) {
+    StorageTrieResult result;
+    HashBuilder hb;
+    hb.node_collector = [&](ByteView unpacked_storage_key, const Node& node) {
+        etl::Entry e{key_with_inc, marshal_node(node)};
+        e.key.append(unpacked_storage_key);
+        result.nodes.push_back(std::move(e));
+    };
+    for (const auto& entry : entries) {
+        add_storage_entry(hb, entry);
+    }
+    result.root = hb.root_hash();
+    return result;
+}
+
+void DbTrieLoader::add_storage_entry(HashBuilder& hb, const StorageTrieEntry& entry) {
+    if (entry.leaf_rlp.empty()) {
+        hb.add_branch_node(entry.unpacked_key, entry.hash, entry.is_in_db_trie);
+    } else {
+        hb.add_leaf(entry.unpacked_key, entry.leaf_rlp);
+    }
+}
+
+// Loads collected trie records into target, writing them through cache
+static void load_trie_records(etl::Collector& collector, mdbx::cursor& target, TrieCache* cache) {
+    if (!cache) {
+        collector.load(target);
+        return;
+    }
+    collector.load(target, [cache](const etl::Entry& entry, mdbx::cursor& cursor, MDBX_put_flags_t flags) {
+        if (entry.value.empty()) {
+            (void)cursor.erase(db::to_slice(entry.key));
+            cache->put(entry.key, std::nullopt);
+            return;
+        }
+        mdbx::slice value{db::to_slice(entry.value)};
+        mdbx::error::success_or_throw(cursor.put(db::to_slice(entry.key), &value, flags));
+        cache->put_encoded(entry.key, entry.value);
+    });
 }
 
 static evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir,
                                                    const evmc::bytes32* expected_root, PrefixSet& account_changes,
-                                                   PrefixSet& storage_changes) {
+                                                   PrefixSet& storage_changes, TrieCache* account_trie_cache,
+                                                   TrieCache* storage_trie_cache) {
     etl::Collector account_collector{etl_dir};
     etl::Collector storage_collector{etl_dir};
-    DbTrieLoader loader{txn, account_collector, storage_collector};
+    DbTrieLoader loader{txn,
+                        account_collector,
+                        storage_collector,
+                        std::thread::hardware_concurrency(),
+                        account_trie_cache,
+                        storage_trie_cache};
     const evmc::bytes32 root{loader.calculate_root(account_changes, storage_changes)};
     if (expected_root != nullptr && root != *expected_root) {
         log::Error() << "Wrong trie root: " << to_hex(root) << ", expected: " << to_hex(*expected_root) << "\n";
+        // Caches have seen erasures which are going to be rolled back
+        for (TrieCache* cache : {account_trie_cache, storage_trie_cache}) {
+            if (cache) {
+                cache->clear();
+            }
+        }
         throw WrongRoot{};
     }
     auto target{db::open_cursor(txn, db::table::kTrieOfAccounts)};
-    account_collector.load(target);
+    load_trie_records(account_collector, target, account_trie_cache);
     target.close();
 
     target = db::open_cursor(txn, db::table::kTrieOfStorage);
-    storage_collector.load(target);
+    load_trie_records(storage_collector, target, storage_trie_cache);
     target.close();
 
     return root;
@@ -393,10 +544,12 @@ static PrefixSet gather_account_changes(mdbx::txn& txn, BlockNum from) {
 
     auto account_changes{db::open_cursor(txn, db::table::kAccountChangeSet)};
     if (account_changes.lower_bound(db::to_slice(starting_key), /*throw_notfound=*/false)) {
-        db::WalkFunc account_walk_function = [&out](mdbx::cursor&, mdbx::cursor::move_result& entry) {
+        uint8_t unpacked[2 * kHashLength];
+        db::WalkFunc account_walk_function = [&out, &unpacked](mdbx::cursor&, mdbx::cursor::move_result& entry) {
             const ByteView address{db::from_slice(entry.value).substr(0, kAddressLength)};
-            const auto hashed_address{keccak256(address)};
-            out.insert(unpack_nibbles(hashed_address.bytes));
+            const auto hashed_address{AddressHashCache::instance().hash(to_evmc_address(address))};
+            unpack_nibbles(hashed_address.bytes, unpacked);
+            out.insert(ByteView{unpacked, sizeof(unpacked)});
             return true;
         };
         (void)db::cursor_for_each(account_changes, account_walk_function);
@@ -412,17 +565,19 @@ static PrefixSet gather_storage_changes(mdbx::txn& txn, BlockNum from) {
     PrefixSet out;
 
     auto storage_changes{db::open_cursor(txn, db::table::kStorageChangeSet)};
+    const db::ChangeSetFormat format{db::read_changeset_format(txn)};
     if (storage_changes.lower_bound(db::to_slice(starting_key), /*throw_notfound=*/false)) {
-        db::WalkFunc storage_walk_func = [&out](mdbx::cursor&, mdbx::cursor::move_result& entry) {
+        db::WalkFunc storage_walk_func = [&out, format](mdbx::cursor&, mdbx::cursor::move_result& entry) {
             const ByteView address{db::from_slice(entry.key).substr(sizeof(BlockNum), kAddressLength)};
             const ByteView incarnation{db::from_slice(entry.key).substr(sizeof(BlockNum) + kAddressLength)};
-            const ByteView location{db::from_slice(entry.value).substr(0, kHashLength)};
-            const auto hashed_address{keccak256(address)};
+            const auto [location, _]{db::split_storage_change_value(db::from_slice(entry.value), format)};
+            const auto hashed_address{AddressHashCache::instance().hash(to_evmc_address(address))};
             const auto hashed_location{keccak256(location)};
 
-            Bytes hashed_key{ByteView{hashed_address.bytes}};
-            hashed_key.append(incarnation);
-            hashed_key.append(unpack_nibbles(hashed_location.bytes));
+            Bytes hashed_key(kHashLength + incarnation.length() + 2 * kHashLength, '\0');
+            std::memcpy(hashed_key.data(), hashed_address.bytes, kHashLength);
+            std::memcpy(&hashed_key[kHashLength], incarnation.data(), incarnation.length());
+            unpack_nibbles(hashed_location.bytes, &hashed_key[kHashLength + incarnation.length()]);
             out.insert(hashed_key);
             return true;
         };
@@ -432,11 +587,44 @@ static PrefixSet gather_storage_changes(mdbx::txn& txn, BlockNum from) {
     return out;
 }
 
+static PrefixSet gather_account_changes(const db::ChangedKeys& changed_keys) {
+    PrefixSet out;
+    uint8_t unpacked[2 * kHashLength];
+    for (const auto& address : changed_keys.accounts()) {
+        unpack_nibbles(AddressHashCache::instance().hash(address).bytes, unpacked);
+        out.insert(ByteView{unpacked, sizeof(unpacked)});
+    }
+    return out;
+}
+
+static PrefixSet gather_storage_changes(const db::ChangedKeys& changed_keys) {
+    PrefixSet out;
+    Bytes hashed_key(db::kHashedStoragePrefixLength + 2 * kHashLength, '\0');
+    for (const auto& [address, incarnation, location] : changed_keys.storage()) {
+        std::memcpy(hashed_key.data(), AddressHashCache::instance().hash(address).bytes, kHashLength);
+        endian::store_big_u64(&hashed_key[kHashLength], incarnation);
+        unpack_nibbles(keccak256(location).bytes, &hashed_key[db::kHashedStoragePrefixLength]);
+        out.insert(hashed_key);
+    }
+    return out;
+}
+
 evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir, BlockNum from,
-                                            const evmc::bytes32* expected_root) {
+                                            const evmc::bytes32* expected_root, TrieCache* account_trie_cache,
+                                            TrieCache* storage_trie_cache) {
     PrefixSet account_changes{gather_account_changes(txn, from)};
     PrefixSet storage_changes{gather_storage_changes(txn, from)};
-    return increment_intermediate_hashes(txn, etl_dir, expected_root, account_changes, storage_changes);
+    return increment_intermediate_hashes(txn, etl_dir, expected_root, account_changes, storage_changes,
+                                         account_trie_cache, storage_trie_cache);
+}
+
+evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir,
+                                            const db::ChangedKeys& changed_keys, const evmc::bytes32* expected_root,
+                                            TrieCache* account_trie_cache, TrieCache* storage_trie_cache) {
+    PrefixSet account_changes{gather_account_changes(changed_keys)};
+    PrefixSet storage_changes{gather_storage_changes(changed_keys)};
+    return increment_intermediate_hashes(txn, etl_dir, expected_root, account_changes, storage_changes,
+                                         account_trie_cache, storage_trie_cache);
 }
 
 evmc::bytes32 regenerate_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir,
@@ -445,7 +633,146 @@ evmc::bytes32 regenerate_intermediate_hashes(mdbx::txn& txn, const std::filesyst
     txn.clear_map(db::open_map(txn, db::table::kTrieOfStorage));
     PrefixSet empty;
     return increment_intermediate_hashes(txn, etl_dir, expected_root, /*account_changes=*/empty,
-                                         /*storage_changes=*/empty);
+                                         /*storage_changes=*/empty, /*account_trie_cache=*/nullptr,
+                                         /*storage_trie_cache=*/nullptr);
+}
+
+namespace {
+
+    // Account sub-trie of keys starting with the same nibble
+    struct AccountShard {
+        uint8_t nibble{0};
+        std::unique_ptr<etl::Collector> account_collector;
+        std::unique_ptr<etl::Collector> storage_collector;
+        size_t num_accounts{0};
+        evmc::bytes32 root{kEmptyRoot};  // Hash of the node at path {nibble}
+    };
+
+}  // namespace
+
+// hb is reset and reused across storage tries so that its buffers are allocated only once per shard
+static evmc::bytes32 regenerate_storage_trie(HashBuilder& hb, mdbx::cursor& hashed_storage, const Bytes& key_with_inc,
+                                             etl::Collector& storage_collector) {
+    hb.reset();
+    hb.node_collector = [&](ByteView unpacked_storage_key, const Node& node) {
+        etl::Entry e{key_with_inc, marshal_node(node)};
+        e.key.append(unpacked_storage_key);
+        storage_collector.collect(std::move(e));
+    };
+
+    Bytes rlp;
+    uint8_t unpacked[2 * kHashLength];
+    for (auto storage{hashed_storage.find(db::to_slice(key_with_inc), /*throw_notfound=*/false)}; storage;
+         storage = hashed_storage.to_current_next_multi(/*throw_notfound=*/false)) {
+        const ByteView entry{db::from_slice(storage.value)};
+        rlp.clear();
+        rlp::encode(rlp, entry.substr(kHashLength));
+        unpack_nibbles(entry.substr(0, kHashLength), unpacked);
+        hb.add_leaf(ByteView{unpacked, sizeof(unpacked)}, rlp);
+    }
+    return hb.root_hash();
+}
+
+// Builds the sub-trie of shard.nibble with keys stripped of their first nibble: its root is the child of the top node
+static void regenerate_account_shard(mdbx::env env, AccountShard& shard) {
+    auto txn{env.start_read()};
+    auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+    auto hashed_storage{db::open_cursor(txn, db::table::kHashedStorage)};
+
+    HashBuilder hb;
+    hb.node_collector = [&shard](ByteView unpacked_key, const Node& node) {
+        etl::Entry e;
+        e.key.push_back(shard.nibble);
+        e.key.append(unpacked_key);
+        if (unpacked_key.empty()) {
+            Node child{node};  // Not the root of the whole trie
+            child.set_root_hash(std::nullopt);
+            e.value = marshal_node(child);
+        } else {
+            e.value = marshal_node(node);
+        }
+        shard.account_collector->collect(std::move(e));
+    };
+    HashBuilder storage_hb;
+
+    const uint8_t first_byte{static_cast<uint8_t>(shard.nibble << 4)};
+    for (auto acc{hashed_accounts.lower_bound(db::to_slice(ByteView{&first_byte, 1}), /*throw_notfound=*/false)};
+         acc; acc = hashed_accounts.to_next(/*throw_notfound=*/false)) {
+        const ByteView key{db::from_slice(acc.key)};
+        if (key[0] >> 4 != shard.nibble) {
+            break;
+        }
+        const auto [account, err]{Account::from_encoded_storage(db::from_slice(acc.value))};
+        rlp::success_or_throw(err);
+
+        evmc::bytes32 storage_root{kEmptyRoot};
+        if (account.incarnation) {
+            const Bytes key_with_inc{db::storage_prefix(key, account.incarnation)};
+            storage_root = regenerate_storage_trie(storage_hb, hashed_storage, key_with_inc, *shard.storage_collector);
+        }
+
+        uint8_t unpacked[2 * kHashLength];
+        unpack_nibbles(key.substr(0, kHashLength), unpacked);
+        hb.add_leaf(ByteView{&unpacked[1], sizeof(unpacked) - 1}, account.rlp(storage_root));
+        ++shard.num_accounts;
+    }
+    shard.root = hb.root_hash();
+}
+
+evmc::bytes32 regenerate_intermediate_hashes_sharded(mdbx::txn& txn, const std::filesystem::path& etl_dir,
+                                                     const evmc::bytes32* expected_root) {
+    static constexpr size_t kNumShards{16};
+
+    // Collectors are flushed to disk early: all of them together take as much memory as a single default one
+    static constexpr size_t kCollectorBufferSize{etl::kOptimalBufferSize / kNumShards / 2};
+
+    std::vector<AccountShard> shards(kNumShards);
+    {
+        thread_pool pool{static_cast<uint32_t>(std::min<size_t>(kNumShards, std::thread::hardware_concurrency()))};
+        std::vector<std::future<bool>> futures;
+        for (size_t i{0}; i < kNumShards; ++i) {
+            AccountShard& shard{shards[i]};
+            shard.nibble = static_cast<uint8_t>(i);
+            shard.account_collector = std::make_unique<etl::Collector>(etl_dir, kCollectorBufferSize);
+            shard.storage_collector = std::make_unique<etl::Collector>(etl_dir, kCollectorBufferSize);
+            futures.push_back(pool.submit([env = txn.env(), &shard] { regenerate_account_shard(env, shard); }));
+        }
+        for (auto& future : futures) {
+            future.get();  // Rethrows
+        }
+    }
+
+    const auto num_populated_shards{std::count_if(shards.begin(), shards.end(),
+                                                  [](const AccountShard& shard) { return shard.num_accounts > 0; })};
+    if (num_populated_shards < 2) {
+        // Top node is not a branch: nothing to gain from sharding
+        shards.clear();
+        return regenerate_intermediate_hashes(txn, etl_dir, expected_root);
+    }
+
+    HashBuilder hb;
+    for (const auto& shard : shards) {
+        if (shard.num_accounts) {
+            hb.add_branch_node(ByteView{&shard.nibble, 1}, shard.root);
+        }
+    }
+    const evmc::bytes32 root{hb.root_hash()};
+    if (expected_root != nullptr && root != *expected_root) {
+        log::Error() << "Wrong trie root: " << to_hex(root) << ", expected: " << to_hex(*expected_root) << "\n";
+        throw WrongRoot{};
+    }
+
+    // Sub-tries don't overlap and shards are in key order
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfAccounts));
+    txn.clear_map(db::open_map(txn, db::table::kTrieOfStorage));
+    auto account_trie{db::open_cursor(txn, db::table::kTrieOfAccounts)};
+    auto storage_trie{db::open_cursor(txn, db::table::kTrieOfStorage)};
+    for (auto& shard : shards) {
+        shard.account_collector->load(account_trie);
+        shard.storage_collector->load(storage_trie);
+    }
+
+    return root;
 }
 
 std::optional<Bytes> increment_key(ByteView unpacked) {
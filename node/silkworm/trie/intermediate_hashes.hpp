@@ -62,14 +62,20 @@ the correct bit in tree_mask bitmap
 - Other records in TrieAccount and TrieStorage must satisfy (tree_mask≠0 ∨ hash_mask≠0)
 */
 
+#include <deque>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include <silkworm/common/base.hpp>
+#include <silkworm/concurrency/thread_pool.hpp>
+#include <silkworm/db/changed_keys.hpp>
 #include <silkworm/etl/collector.hpp>
 #include <silkworm/trie/hash_builder.hpp>
 #include <silkworm/trie/prefix_set.hpp>
+#include <silkworm/trie/trie_cache.hpp>
 #include <silkworm/types/account.hpp>
 
 namespace silkworm::trie {
@@ -86,8 +92,9 @@ class Cursor {
     Cursor(const Cursor&) = delete;
     Cursor& operator=(const Cursor&) = delete;
 
-    // Ignores DB entries whose keys don't start with the prefix
-    Cursor(mdbx::cursor& cursor, PrefixSet& changed, ByteView prefix = {});
+    // Ignores DB entries whose keys don't start with the prefix.
+    // Records are looked up in cache first, if any, which is kept up to date with db reads and erasures.
+    Cursor(mdbx::cursor& cursor, PrefixSet& changed, ByteView prefix = {}, TrieCache* cache = nullptr);
 
     void next();
 
@@ -128,6 +135,8 @@ class Cursor {
 
     Bytes prefix_;
 
+    TrieCache* cache_;
+
     std::vector<SubNode> stack_;
 
     bool can_skip_state_{false};
@@ -136,20 +145,62 @@ class Cursor {
 // Erigon FlatDBTrieLoader
 class DbTrieLoader {
   public:
+    static constexpr size_t kMaxPendingAccounts{10'000};           // Accounts waiting for their storage root
+    static constexpr size_t kMaxBufferedStorageEntries{100'000};  // Larger storage tries are hashed inline
+
     DbTrieLoader(const DbTrieLoader&) = delete;
     DbTrieLoader& operator=(const DbTrieLoader&) = delete;
 
-    DbTrieLoader(mdbx::txn& txn, etl::Collector& account_collector, etl::Collector& storage_collector);
+    // With num_threads > 1 storage tries are hashed in parallel. MDBX transactions are bound to their thread and
+    // other transactions wouldn't see uncommitted state, hence db is read by the calling thread only: workers hash
+    // the storage entries it has read ahead, while account leaves are added in key order as storage roots are ready
+    // Optional caches are consulted before TrieAccount & TrieStorage, see TrieCache
+    DbTrieLoader(mdbx::txn& txn, etl::Collector& account_collector, etl::Collector& storage_collector,
+                 size_t num_threads = 1, TrieCache* account_trie_cache = nullptr,
+                 TrieCache* storage_trie_cache = nullptr);
 
     evmc::bytes32 calculate_root(PrefixSet& account_changes, PrefixSet& storage_changes);
 
   private:
-    evmc::bytes32 calculate_storage_root(const Bytes& key_with_inc, PrefixSet& changed);
+    // Input of a storage HashBuilder: either a leaf or a branch node whose hash is cached in TrieOfStorage
+    struct StorageTrieEntry {
+        Bytes unpacked_key;
+        Bytes leaf_rlp;  // empty for branch nodes
+        evmc::bytes32 hash;
+        bool is_in_db_trie{false};
+    };
+
+    struct StorageTrieResult {
+        evmc::bytes32 root;
+        std::vector<etl::Entry> nodes;  // to be collected into TrieOfStorage
+    };
+
+    struct PendingAccount {
+        Bytes unpacked_key;
+        Account account;
+        evmc::bytes32 storage_root{kEmptyRoot};
+        std::future<StorageTrieResult> storage;  // valid while storage root is being calculated
+    };
+
+    // Sets either storage_root or storage of account
+    void calculate_storage_root(const Bytes& key_with_inc, PrefixSet& changed, PendingAccount& account);
+
+    static StorageTrieResult hash_storage_trie(const Bytes& key_with_inc,
+                                               const std::vector<StorageTrieEntry>& entries);
+
+    static void add_storage_entry(HashBuilder& hb, const StorageTrieEntry& entry);
+
+    // Adds pending accounts to hb_ until at most max_pending are left or the first one is not ready yet
+    void add_pending_accounts(size_t max_pending);
 
     mdbx::txn& txn_;
+    TrieCache* account_trie_cache_;
+    TrieCache* storage_trie_cache_;
     HashBuilder hb_;
     etl::Collector& storage_collector_;
     Bytes rlp_;
+    std::deque<PendingAccount> pending_accounts_;
+    std::unique_ptr<thread_pool> pool_;  // Only if num_threads > 1; declared last: joined first
 };
 
 class WrongRoot : public std::runtime_error {
@@ -163,11 +214,32 @@ class WrongRoot : public std::runtime_error {
 evmc::bytes32 regenerate_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir,
                                              const evmc::bytes32* expected_root = nullptr);
 
-// Erigon incrementIntermediateHashes
+// Same as regenerate_intermediate_hashes, but the account trie is built as 16 independent sub-tries, one per first
+// nibble of hashed keys, on as many threads. The top branch node is combined at the end.
+// Each thread reads HashedAccount & HashedStorage with its own read-only transaction: the hashed state must have been
+// committed, i.e. txn shall not have changed it.
 // might throw WrongRoot
 // returns the state root
+evmc::bytes32 regenerate_intermediate_hashes_sharded(mdbx::txn& txn, const std::filesystem::path& etl_dir,
+                                                     const evmc::bytes32* expected_root = nullptr);
+
+// Erigon incrementIntermediateHashes
+// Caches, if any, are preserved across calls, e.g. TrieCache::for_accounts & TrieCache::for_storage_roots
+// at chain tip; they must be cleared if txn is not committed.
+// might throw WrongRoot (caches are then cleared)
+// returns the state root
 evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir, BlockNum from,
-                                            const evmc::bytes32* expected_root = nullptr);
+                                            const evmc::bytes32* expected_root = nullptr,
+                                            TrieCache* account_trie_cache = nullptr,
+                                            TrieCache* storage_trie_cache = nullptr);
+
+// Same as above, but changed keys are taken from changed_keys instead of change sets, which are not read at all.
+// changed_keys must cover the blocks after the previous increment up to current state (see db::ChangedKeys::covers)
+evmc::bytes32 increment_intermediate_hashes(mdbx::txn& txn, const std::filesystem::path& etl_dir,
+                                            const db::ChangedKeys& changed_keys,
+                                            const evmc::bytes32* expected_root = nullptr,
+                                            TrieCache* account_trie_cache = nullptr,
+                                            TrieCache* storage_trie_cache = nullptr);
 
 // Produces the next key of the same length.
 // It's essentially +1 in the hexadecimal (base 16) numeral system.
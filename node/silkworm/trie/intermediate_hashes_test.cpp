@@ -697,6 +697,78 @@ TEST_CASE("Incremental vs regeneration for storage") {
     CHECK(fused_nodes == incremental_nodes);
 }
 
+TEST_CASE("Incremental from changed keys") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    static constexpr size_t n{1'000};
+
+    auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+    auto hashed_storage{db::open_cursor(txn, db::table::kHashedStorage)};
+    auto account_trie{db::open_cursor(txn, db::table::kTrieOfAccounts)};
+    auto storage_trie{db::open_cursor(txn, db::table::kTrieOfStorage)};
+
+    static constexpr auto contract{0x1000000000000000000000000000000000000000_address};
+    static const auto hashed_contract{keccak256(contract)};
+    static const Bytes storage_prefix{db::storage_prefix(hashed_contract.bytes, kDefaultIncarnation)};
+    Account contract_account;
+    contract_account.incarnation = kDefaultIncarnation;
+    contract_account.code_hash = 0x5e3c5ae99a1c6785210d0d233641562557ad763e18907cca3a8d42bd0a0b4ecb_bytes32;
+
+    static constexpr Account one_eth{0, 1 * kEther};
+    static constexpr Account two_eth{0, 2 * kEther};
+    static const Bytes value_x{*from_hex("42")};
+    static const Bytes value_y{*from_hex("71f6")};
+
+    const auto upsert_account = [&](size_t i, const Account* account) {
+        const auto hash{keccak256(int_to_address(i))};
+        if (account) {
+            hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(account->encode_for_storage()));
+        } else {
+            hashed_accounts.erase(db::to_slice(hash.bytes));
+        }
+    };
+    const auto upsert_storage = [&](size_t i, ByteView value) {
+        db::upsert_storage_value(hashed_storage, storage_prefix, keccak256(int_to_bytes32(i)).bytes, value);
+    };
+
+    // Genesis: 2n accounts holding 1 ETH, and a contract with 2n slots
+    hashed_accounts.upsert(db::to_slice(hashed_contract.bytes), db::to_slice(contract_account.encode_for_storage()));
+    for (size_t i{0}; i < 2 * n; ++i) {
+        upsert_account(i, &one_eth);
+        upsert_storage(i, value_x);
+    }
+    regenerate_intermediate_hashes(txn, context.dir().etl().path());
+
+    // Block 1 changes the first half of accounts and slots, deletes some of them and adds new ones: change sets
+    // are left empty, only changed keys tell what changed
+    db::ChangedKeys changed_keys;
+    changed_keys.reset(0);
+    for (size_t i{0}; i < n; ++i) {
+        upsert_account(i, i % 3 ? &two_eth : nullptr);
+        upsert_storage(i, i % 3 ? ByteView{value_y} : ByteView{});
+        changed_keys.insert_account(int_to_address(i));
+        changed_keys.insert_storage(contract, kDefaultIncarnation, int_to_bytes32(i));
+    }
+    for (size_t i{2 * n}; i < 3 * n; ++i) {
+        upsert_account(i, &one_eth);
+        upsert_storage(i, value_x);
+        changed_keys.insert_account(int_to_address(i));
+        changed_keys.insert_storage(contract, kDefaultIncarnation, int_to_bytes32(i));
+    }
+    changed_keys.insert_account(contract);
+    changed_keys.advance(1);
+
+    const auto incremental_root{increment_intermediate_hashes(txn, context.dir().etl().path(), changed_keys)};
+    const std::map<Bytes, Node> incremental_account_nodes{read_all_nodes(account_trie)};
+    const std::map<Bytes, Node> incremental_storage_nodes{read_all_nodes(storage_trie)};
+
+    const auto fused_root{regenerate_intermediate_hashes(txn, context.dir().etl().path())};
+    CHECK(fused_root == incremental_root);
+    CHECK(read_all_nodes(account_trie) == incremental_account_nodes);
+    CHECK(read_all_nodes(storage_trie) == incremental_storage_nodes);
+}
+
 TEST_CASE("Storage deletion") {
     test::Context context;
     auto& txn{context.txn()};
@@ -765,6 +837,153 @@ TEST_CASE("Storage deletion") {
     }
 }
 
+// Contracts with storage of different sizes interleaved with plain accounts; returns the expected state root
+static evmc::bytes32 setup_contracts(mdbx::txn& txn, uint64_t num_accounts) {
+    auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+    auto hashed_storage{db::open_cursor(txn, db::table::kHashedStorage)};
+
+    std::map<evmc::bytes32, Bytes> expected_leaves;
+    for (uint64_t i{0}; i < num_accounts; ++i) {
+        const auto key{keccak256(int_to_address(i))};
+        Account account{i, i * kEther};
+        if (i % 3 != 0) {
+            account.incarnation = kDefaultIncarnation;
+            const Bytes storage_key{db::storage_prefix(key.bytes, kDefaultIncarnation)};
+            std::map<evmc::bytes32, Bytes> storage_leaves;
+            for (uint64_t j{0}; j < i % 50; ++j) {
+                const auto location{keccak256(int_to_address(i * 1'000 + j))};
+                const Bytes value(1, static_cast<uint8_t>(j + 1));
+                db::upsert_storage_value(hashed_storage, storage_key, location.bytes, value);
+                Bytes value_rlp;
+                rlp::encode(value_rlp, value);
+                storage_leaves[to_bytes32(location.bytes)] = value_rlp;
+            }
+            HashBuilder storage_hb;
+            for (const auto& [location, value_rlp] : storage_leaves) {
+                storage_hb.add_leaf(unpack_nibbles(location), value_rlp);
+            }
+            expected_leaves[to_bytes32(key.bytes)] = account.rlp(storage_hb.root_hash());
+        } else {
+            expected_leaves[to_bytes32(key.bytes)] = account.rlp(kEmptyRoot);
+        }
+        hashed_accounts.upsert(db::to_slice(key.bytes), db::to_slice(account.encode_for_storage()));
+    }
+
+    HashBuilder hb;
+    for (const auto& [key, value] : expected_leaves) {
+        hb.add_leaf(unpack_nibbles(key), value);
+    }
+    return hb.root_hash();
+}
+
+TEST_CASE("Parallel storage roots") {
+    test::Context context;
+    auto& txn{context.txn()};
+
+    const evmc::bytes32 expected_root{setup_contracts(txn, 300)};
+
+    size_t sequential_storage_nodes{0};
+    for (const size_t num_threads : {1u, 4u}) {
+        etl::Collector account_collector{context.dir().etl().path()};
+        etl::Collector storage_collector{context.dir().etl().path()};
+        DbTrieLoader loader{txn, account_collector, storage_collector, num_threads};
+        PrefixSet account_changes;
+        PrefixSet storage_changes;
+        CHECK(to_hex(loader.calculate_root(account_changes, storage_changes)) == to_hex(expected_root));
+        if (num_threads == 1) {
+            sequential_storage_nodes = storage_collector.size();
+            CHECK(sequential_storage_nodes > 0);
+        } else {
+            CHECK(storage_collector.size() == sequential_storage_nodes);
+        }
+    }
+}
+
+TEST_CASE("Sharded regeneration") {
+    test::Context context;
+
+    for (const uint64_t num_accounts : {0u, 1u, 300u}) {
+        SECTION("Accounts: " + std::to_string(num_accounts)) {
+            const evmc::bytes32 expected_root{setup_contracts(context.txn(), num_accounts)};
+            context.commit_and_renew_txn();  // Shards read committed state only
+            auto& txn{context.txn()};
+
+            const auto root{regenerate_intermediate_hashes(txn, context.dir().etl().path(), &expected_root)};
+            auto account_trie{db::open_cursor(txn, db::table::kTrieOfAccounts)};
+            auto storage_trie{db::open_cursor(txn, db::table::kTrieOfStorage)};
+            const std::map<Bytes, Node> account_nodes{read_all_nodes(account_trie)};
+            const std::map<Bytes, Node> storage_nodes{read_all_nodes(storage_trie)};
+
+            CHECK(regenerate_intermediate_hashes_sharded(txn, context.dir().etl().path(), &expected_root) == root);
+            CHECK(read_all_nodes(account_trie) == account_nodes);
+            CHECK(read_all_nodes(storage_trie) == storage_nodes);
+        }
+    }
+}
+
+TEST_CASE("Trie cache") {
+    test::Context context;
+    auto& txn{context.txn()};
+    const auto etl_dir{context.dir().etl().path()};
+
+    (void)setup_contracts(txn, 300);
+    regenerate_intermediate_hashes(txn, etl_dir);
+
+    auto hashed_accounts{db::open_cursor(txn, db::table::kHashedAccounts)};
+    auto hashed_storage{db::open_cursor(txn, db::table::kHashedStorage)};
+    auto account_change_table{db::open_cursor(txn, db::table::kAccountChangeSet)};
+    auto storage_change_table{db::open_cursor(txn, db::table::kStorageChangeSet)};
+
+    TrieCache account_trie_cache{TrieCache::for_accounts(/*max_entries=*/1'000)};
+    TrieCache storage_trie_cache{TrieCache::for_storage_roots(/*max_entries=*/1'000)};
+
+    for (BlockNum block_num{1}; block_num <= 3; ++block_num) {
+        const Bytes block_key{db::block_key(block_num)};
+
+        // The same accounts get a new balance in every block, while their storage is left untouched
+        for (uint64_t i{1}; i < 300; i += 7) {
+            const evmc::address address{int_to_address(i)};
+            Account account{i, (i + block_num) * kEther};
+            if (i % 3 != 0) {
+                account.incarnation = kDefaultIncarnation;
+            }
+            hashed_accounts.upsert(db::to_slice(keccak256(address).bytes),
+                                   db::to_slice(account.encode_for_storage()));
+            account_change_table.upsert(db::to_slice(block_key), db::to_slice(address));
+        }
+
+        // And a new storage slot is added to a different contract each time
+        const uint64_t contract{15 * block_num + 1};
+        const evmc::address address{int_to_address(contract)};
+        const evmc::bytes32 location{block_num};
+        const Bytes value(1, 0xff);
+        db::upsert_storage_value(hashed_storage, db::storage_prefix(keccak256(address).bytes, kDefaultIncarnation),
+                                 keccak256(location).bytes, value);
+        Bytes change_key{block_key + db::storage_prefix(address, kDefaultIncarnation)};
+        storage_change_table.upsert(db::to_slice(change_key), db::to_slice(location.bytes));
+
+        (void)increment_intermediate_hashes(txn, etl_dir, /*from=*/block_num - 1, /*expected_root=*/nullptr,
+                                            &account_trie_cache, &storage_trie_cache);
+    }
+
+    CHECK(account_trie_cache.size() > 0);
+    CHECK(account_trie_cache.hits() > 0);
+    CHECK(storage_trie_cache.hits() > 0);
+
+    auto account_trie{db::open_cursor(txn, db::table::kTrieOfAccounts)};
+    auto storage_trie{db::open_cursor(txn, db::table::kTrieOfStorage)};
+    const std::map<Bytes, Node> incremental_account_nodes{read_all_nodes(account_trie)};
+    const std::map<Bytes, Node> incremental_storage_nodes{read_all_nodes(storage_trie)};
+
+    // Cached increments shall be equivalent to a regeneration
+    const auto incremental_root{increment_intermediate_hashes(txn, etl_dir, /*from=*/3, /*expected_root=*/nullptr,
+                                                              &account_trie_cache, &storage_trie_cache)};
+    const auto fused_root{regenerate_intermediate_hashes(txn, etl_dir)};
+    CHECK(to_hex(incremental_root) == to_hex(fused_root));
+    CHECK(read_all_nodes(account_trie) == incremental_account_nodes);
+    CHECK(read_all_nodes(storage_trie) == incremental_storage_nodes);
+}
+
 TEST_CASE("increment_key") {
     CHECK(increment_key({}) == std::nullopt);
     CHECK(nibbles_to_hex(*increment_key(nibbles_from_hex("12"))) == "13");
@@ -0,0 +1,68 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "trie_cache.hpp"
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::trie {
+
+static std::string to_cache_key(ByteView key) { return {byte_ptr_cast(key.data()), key.length()}; }
+
+TrieCache::TrieCache(size_t max_entries, size_t min_key_length, size_t max_key_length)
+    : cache_{max_entries}, min_key_length_{min_key_length}, max_key_length_{max_key_length} {}
+
+TrieCache TrieCache::for_accounts(size_t max_entries, size_t max_key_length) {
+    return TrieCache{max_entries, /*min_key_length=*/0, max_key_length};
+}
+
+TrieCache TrieCache::for_storage_roots(size_t max_entries) {
+    return TrieCache{max_entries, db::kHashedStoragePrefixLength, db::kHashedStoragePrefixLength};
+}
+
+const std::optional<Node>* TrieCache::get(ByteView key) {
+    if (!is_cacheable(key)) {
+        return nullptr;
+    }
+    const std::optional<Node>* value{cache_.get(to_cache_key(key))};
+    if (value) {
+        ++hits_;
+    } else {
+        ++misses_;
+    }
+    return value;
+}
+
+void TrieCache::put(ByteView key, std::optional<Node> node) {
+    if (is_cacheable(key)) {
+        cache_.put(to_cache_key(key), std::move(node));
+    }
+}
+
+void TrieCache::put_encoded(ByteView key, ByteView value) {
+    if (is_cacheable(key)) {
+        cache_.put(to_cache_key(key), unmarshal_node(value));
+    }
+}
+
+void TrieCache::clear() noexcept {
+    cache_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,77 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/lru_cache.hpp>
+#include <silkworm/trie/node.hpp>
+
+namespace silkworm::trie {
+
+// Resident LRU cache of TrieAccount or TrieStorage records, meant to outlive a single trie computation, e.g. for the
+// root to be verified block after block at chain tip while the records the traversal keeps coming back to (upper
+// levels of the account trie, storage roots) stay in memory.
+// Records are cached decoded, so that hits spare unmarshalling too. Both present and absent records are cached, but
+// only for keys (i.e. nibble paths) whose length is within [min_key_length, max_key_length].
+// Cursor and DbTrieLoader write through the cache: it's kept coherent with the db table as long as nothing else changes
+// it. Otherwise, e.g. after a regeneration or an aborted transaction, the cache must be cleared.
+class TrieCache {
+  public:
+    TrieCache(size_t max_entries, size_t min_key_length, size_t max_key_length);
+
+    // not copyable
+    TrieCache(const TrieCache&) = delete;
+    TrieCache& operator=(const TrieCache&) = delete;
+
+    // Cache of the upper levels of the account trie
+    static TrieCache for_accounts(size_t max_entries, size_t max_key_length = 5);
+
+    // Cache of the storage root records, i.e. those at key hashed address + incarnation
+    static TrieCache for_storage_roots(size_t max_entries);
+
+    [[nodiscard]] bool is_cacheable(ByteView key) const noexcept {
+        return key.length() >= min_key_length_ && key.length() <= max_key_length_;
+    }
+
+    // Returns nullptr if the record at key is not known.
+    // Otherwise returns the decoded record, nullopt meaning there's no such record in db.
+    const std::optional<Node>* get(ByteView key);
+
+    // Records the state of db at key; no-op for keys that are not cacheable
+    void put(ByteView key, std::optional<Node> node);
+
+    // Same as above with the record as stored in db (see marshal_node), only decoded if key is cacheable
+    void put_encoded(ByteView key, ByteView value);
+
+    [[nodiscard]] size_t size() const noexcept { return cache_.size(); }
+    [[nodiscard]] size_t hits() const noexcept { return hits_; }
+    [[nodiscard]] size_t misses() const noexcept { return misses_; }
+
+    void clear() noexcept;
+
+  private:
+    lru_cache<std::string, std::optional<Node>> cache_;
+    size_t min_key_length_;
+    size_t max_key_length_;
+    size_t hits_{0};
+    size_t misses_{0};
+};
+
+}  // namespace silkworm::trie
@@ -0,0 +1,73 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "trie_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::trie {
+
+TEST_CASE("Trie cache of accounts") {
+    TrieCache cache{TrieCache::for_accounts(/*max_entries=*/2, /*max_key_length=*/4)};
+
+    const Bytes key1(3, 0x01);
+    const Bytes key2(2, 0x02);
+    const Bytes deep_key(5, 0x01);
+    const Node node{/*state_mask=*/0b1011, /*tree_mask=*/0b0001, /*hash_mask=*/0b1000,
+                    /*hashes=*/{0x7f9a58b00625a6e725559acf327baf88d90e4a5b65a2003acd24f110c0441df1_bytes32}};
+
+    CHECK(cache.get(key1) == nullptr);
+    CHECK(cache.misses() == 1);
+
+    cache.put(key1, node);
+    cache.put(key2, std::nullopt);  // absent record
+    cache.put(deep_key, node);      // not cacheable
+    CHECK(cache.size() == 2);
+
+    const std::optional<Node>* cached{cache.get(key1)};
+    REQUIRE(cached != nullptr);
+    CHECK(*cached == node);
+
+    cached = cache.get(key2);
+    REQUIRE(cached != nullptr);
+    CHECK(!cached->has_value());
+
+    CHECK(cache.get(deep_key) == nullptr);
+    CHECK(cache.hits() == 2);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.get(key1) == nullptr);
+
+    // Records as stored in db are decoded
+    cache.put_encoded(key1, marshal_node(node));
+    cache.put_encoded(deep_key, marshal_node(node));
+    CHECK(cache.size() == 1);
+    cached = cache.get(key1);
+    REQUIRE(cached != nullptr);
+    CHECK(*cached == node);
+}
+
+TEST_CASE("Trie cache of storage roots") {
+    TrieCache cache{TrieCache::for_storage_roots(/*max_entries=*/10)};
+    CHECK_FALSE(cache.is_cacheable(Bytes{}));
+    CHECK(cache.is_cacheable(Bytes(db::kHashedStoragePrefixLength, 0x00)));
+    CHECK_FALSE(cache.is_cacheable(Bytes(db::kHashedStoragePrefixLength + 1, 0x00)));
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,89 @@
+/*
+   Copyright 2022 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+// Bare CBOR (RFC 8949) encoding of the few item types stored in db, written straight into a buffer sized up front.
+// Encoding is the shortest form, same as cbor-cpp (used for decoding)
+
+#include <cstring>
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/endian.hpp>
+
+namespace silkworm::cbor_util {
+
+enum class MajorType : uint8_t {
+    kUnsignedInteger = 0,
+    kByteString = 2,
+    kArray = 4,
+};
+
+inline constexpr uint8_t kNull{0xf6};
+
+//! \brief Length of the head of an item, i.e. its major type along with its argument (value, length or count)
+constexpr size_t head_length(uint64_t argument) noexcept {
+    if (argument < 24) {
+        return 1;
+    } else if (argument <= 0xff) {
+        return 2;
+    } else if (argument <= 0xffff) {
+        return 3;
+    } else if (argument <= 0xffff'ffff) {
+        return 5;
+    }
+    return 9;
+}
+
+//! \brief Length of a byte string item of given length
+constexpr size_t byte_string_length(size_t length) noexcept { return head_length(length) + length; }
+
+//! \brief Writes the head of an item at out, which must have room for head_length(argument) bytes
+//! \return The position past the head
+inline uint8_t* write_head(uint8_t* out, MajorType type, uint64_t argument) noexcept {
+    const auto initial_byte{static_cast<uint8_t>(static_cast<uint8_t>(type) << 5)};
+    if (argument < 24) {
+        *out = initial_byte | static_cast<uint8_t>(argument);
+        return out + 1;
+    } else if (argument <= 0xff) {
+        out[0] = initial_byte | 24;
+        out[1] = static_cast<uint8_t>(argument);
+        return out + 2;
+    } else if (argument <= 0xffff) {
+        out[0] = initial_byte | 25;
+        endian::store_big_u16(out + 1, static_cast<uint16_t>(argument));
+        return out + 3;
+    } else if (argument <= 0xffff'ffff) {
+        out[0] = initial_byte | 26;
+        endian::store_big_u32(out + 1, static_cast<uint32_t>(argument));
+        return out + 5;
+    }
+    out[0] = initial_byte | 27;
+    endian::store_big_u64(out + 1, argument);
+    return out + 9;
+}
+
+//! \brief Writes a byte string item at out, which must have room for byte_string_length(bytes.length()) bytes
+//! \return The position past the item
+inline uint8_t* write_byte_string(uint8_t* out, ByteView bytes) noexcept {
+    out = write_head(out, MajorType::kByteString, bytes.length());
+    if (!bytes.empty()) {
+        std::memcpy(out, bytes.data(), bytes.length());
+    }
+    return out + bytes.length();
+}
+
+}  // namespace silkworm::cbor_util
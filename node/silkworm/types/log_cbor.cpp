@@ -16,28 +16,48 @@
 
 #include "log_cbor.hpp"
 
-#include <cbor/encoder.h>
-#include <cbor/output_dynamic.h>
+#include <cassert>
+
+#include <silkworm/types/cbor_util.hpp>
 
 namespace silkworm {
 
-Bytes cbor_encode(const std::vector<Log>& v) {
-    cbor::output_dynamic output{};
-    cbor::encoder encoder{output};
+using cbor_util::MajorType;
+
+size_t cbor_encoded_length(const std::vector<Log>& v) noexcept {
+    size_t length{cbor_util::head_length(v.size())};
+    for (const Log& l : v) {
+        length += cbor_util::head_length(3) + cbor_util::byte_string_length(kAddressLength);
+        length += cbor_util::head_length(l.topics.size());
+        length += l.topics.size() * cbor_util::byte_string_length(kHashLength);
+        length += cbor_util::byte_string_length(l.data.size());
+    }
+    return length;
+}
+
+size_t cbor_encode(const std::vector<Log>& v, std::span<uint8_t> out) noexcept {
+    assert(out.size() >= cbor_encoded_length(v));
+    uint8_t* p{out.data()};
 
-    encoder.write_array(static_cast<int>(v.size()));
+    p = cbor_util::write_head(p, MajorType::kArray, v.size());
 
     for (const Log& l : v) {
-        encoder.write_array(3);
-        encoder.write_bytes(l.address.bytes, kAddressLength);
-        encoder.write_array(static_cast<int>(l.topics.size()));
+        p = cbor_util::write_head(p, MajorType::kArray, 3);
+        p = cbor_util::write_byte_string(p, {l.address.bytes, kAddressLength});
+        p = cbor_util::write_head(p, MajorType::kArray, l.topics.size());
         for (const evmc::bytes32& t : l.topics) {
-            encoder.write_bytes(t.bytes, kHashLength);
+            p = cbor_util::write_byte_string(p, {t.bytes, kHashLength});
         }
-        encoder.write_bytes(l.data.data(), l.data.size());
+        p = cbor_util::write_byte_string(p, l.data);
     }
 
-    return Bytes{output.data(), output.size()};
+    return static_cast<size_t>(p - out.data());
+}
+
+Bytes cbor_encode(const std::vector<Log>& v) {
+    Bytes out(cbor_encoded_length(v), '\0');
+    cbor_encode(v, out);
+    return out;
 }
 
 }  // namespace silkworm
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <silkworm/types/log.hpp>
 
 namespace silkworm {
@@ -24,4 +26,11 @@ namespace silkworm {
 // See core/types/log.go
 Bytes cbor_encode(const std::vector<Log>& v);
 
+//! \brief Size of the CBOR encoding of v
+[[nodiscard]] size_t cbor_encoded_length(const std::vector<Log>& v) noexcept;
+
+//! \brief Writes the CBOR encoding of v into out, which must have room for cbor_encoded_length(v) bytes
+//! \return The number of bytes written
+size_t cbor_encode(const std::vector<Log>& v, std::span<uint8_t> out) noexcept;
+
 }  // namespace silkworm
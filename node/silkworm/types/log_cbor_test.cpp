@@ -36,4 +36,25 @@ TEST_CASE("CBOR encoding of logs") {
                              "0000000abba46aabbff780043");
 }
 
+TEST_CASE("CBOR encoding of logs into a span") {
+    auto logs{test::sample_receipts().at(0).logs};
+    Bytes out(cbor_encoded_length(logs) + 1, '\xff');
+    CHECK(cbor_encode(logs, out) == out.size() - 1);
+    CHECK(out.substr(0, out.size() - 1) == cbor_encode(logs));
+    CHECK(out.back() == 0xff);  // untouched
+}
+
+TEST_CASE("CBOR encoding of logs with long data") {
+    using evmc::literals::operator""_address;
+
+    Log log;
+    log.address = 0xea674fdde714fd979de3edf0f56aa9716b898ec8_address;
+    log.data = Bytes(300, 0xab);
+    const std::vector<Log> logs{log};
+    const auto encoded{cbor_encode(logs)};
+    CHECK(encoded.length() == cbor_encoded_length(logs));
+    CHECK(to_hex(encoded.substr(0, 27)) == "818354ea674fdde714fd979de3edf0f56aa9716b898ec88059012c");
+    CHECK(encoded.length() == 27 + 300);
+}
+
 }  // namespace silkworm
@@ -16,33 +16,54 @@
 
 #include "receipt_cbor.hpp"
 
-#include <cbor/encoder.h>
-#include <cbor/output_dynamic.h>
+#include <cassert>
+
+#include <silkworm/types/cbor_util.hpp>
 
 namespace silkworm {
 
-Bytes cbor_encode(const std::vector<Receipt>& v) {
-    cbor::output_dynamic output{};
-    cbor::encoder encoder{output};
+using cbor_util::MajorType;
+
+size_t cbor_encoded_length(const std::vector<Receipt>& v) noexcept {
+    if (v.empty()) {
+        return 1;  // null
+    }
+    size_t length{cbor_util::head_length(v.size())};
+    for (const Receipt& r : v) {
+        length += cbor_util::head_length(4) + cbor_util::head_length(static_cast<uint8_t>(r.type)) + 1 /* null */ +
+                  1 /* success */ + cbor_util::head_length(r.cumulative_gas_used);
+    }
+    return length;
+}
+
+size_t cbor_encode(const std::vector<Receipt>& v, std::span<uint8_t> out) noexcept {
+    assert(out.size() >= cbor_encoded_length(v));
+    uint8_t* p{out.data()};
 
     if (v.empty()) {
-        encoder.write_null();
+        *p++ = cbor_util::kNull;
     } else {
-        encoder.write_array(static_cast<int>(v.size()));
+        p = cbor_util::write_head(p, MajorType::kArray, v.size());
     }
 
     for (const Receipt& r : v) {
-        encoder.write_array(4);
+        p = cbor_util::write_head(p, MajorType::kArray, 4);
 
-        encoder.write_int(static_cast<unsigned>(r.type));
-        encoder.write_null();  // no PostState
-        encoder.write_int(r.success ? 1u : 0u);
-        encoder.write_int(static_cast<unsigned long long>(r.cumulative_gas_used));
+        p = cbor_util::write_head(p, MajorType::kUnsignedInteger, static_cast<uint8_t>(r.type));
+        *p++ = cbor_util::kNull;  // no PostState
+        p = cbor_util::write_head(p, MajorType::kUnsignedInteger, r.success ? 1u : 0u);
+        p = cbor_util::write_head(p, MajorType::kUnsignedInteger, r.cumulative_gas_used);
 
         // Bloom filter and logs are omitted, same as in Erigon
     }
 
-    return Bytes{output.data(), output.size()};
+    return static_cast<size_t>(p - out.data());
+}
+
+Bytes cbor_encode(const std::vector<Receipt>& v) {
+    Bytes out(cbor_encoded_length(v), '\0');
+    cbor_encode(v, out);
+    return out;
 }
 
 }  // namespace silkworm
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <silkworm/types/receipt.hpp>
 
 namespace silkworm {
@@ -24,4 +26,11 @@ namespace silkworm {
 // See core/types/receipt.go and migrations/receipt_cbor.go
 Bytes cbor_encode(const std::vector<Receipt>& v);
 
+//! \brief Size of the CBOR encoding of v
+[[nodiscard]] size_t cbor_encoded_length(const std::vector<Receipt>& v) noexcept;
+
+//! \brief Writes the CBOR encoding of v into out, which must have room for cbor_encoded_length(v) bytes
+//! \return The number of bytes written
+size_t cbor_encode(const std::vector<Receipt>& v, std::span<uint8_t> out) noexcept;
+
 }  // namespace silkworm
@@ -36,4 +36,17 @@ TEST_CASE("CBOR encoding of receipts") {
     CHECK(to_hex(encoded) == "828400f6001a0032f05d8402f6011a00beadd0");
 }
 
+TEST_CASE("CBOR encoding of receipts into a span") {
+    auto v{test::sample_receipts()};
+    v[1].cumulative_gas_used = 0x1'0000'0000;  // 8 bytes
+    std::array<uint8_t, 64> out{};
+    const size_t length{cbor_encode(v, out)};
+    CHECK(length == cbor_encoded_length(v));
+    CHECK(to_hex({out.data(), length}) == "828400f6001a0032f05d8402f6011b0000000100000000");
+
+    std::vector<Receipt> empty{};
+    CHECK(cbor_encode(empty, out) == 1);
+    CHECK(out[0] == 0xf6);
+}
+
 }  // namespace silkworm
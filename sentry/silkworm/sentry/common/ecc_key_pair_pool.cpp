@@ -0,0 +1,72 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "ecc_key_pair_pool.hpp"
+
+#include <utility>
+
+#include <gsl/util>
+
+namespace silkworm::sentry::common {
+
+PrecomputedKeyPair PrecomputedKeyPair::generate() {
+    EccKeyPair key_pair;
+    Bytes public_key = key_pair.public_key();
+    return {std::move(key_pair), std::move(public_key)};
+}
+
+EccKeyPairPool::EccKeyPairPool(std::size_t capacity) : capacity_(capacity) {
+    key_pairs_.reserve(capacity);
+}
+
+PrecomputedKeyPair EccKeyPairPool::take() {
+    {
+        std::scoped_lock lock{mutex_};
+        if (!key_pairs_.empty()) {
+            PrecomputedKeyPair key_pair = std::move(key_pairs_.back());
+            key_pairs_.pop_back();
+            return key_pair;
+        }
+    }
+    return PrecomputedKeyPair::generate();
+}
+
+std::size_t EccKeyPairPool::refill() {
+    if (refilling_.exchange(true)) {
+        return 0;
+    }
+    auto _ = gsl::finally([this] { refilling_ = false; });
+
+    std::size_t added = 0;
+    while (size() < capacity_) {
+        PrecomputedKeyPair key_pair = PrecomputedKeyPair::generate();
+        std::scoped_lock lock{mutex_};
+        key_pairs_.push_back(std::move(key_pair));
+        ++added;
+    }
+    return added;
+}
+
+bool EccKeyPairPool::needs_refill() const {
+    return size() < capacity_ / 2;
+}
+
+std::size_t EccKeyPairPool::size() const {
+    std::scoped_lock lock{mutex_};
+    return key_pairs_.size();
+}
+
+}  // namespace silkworm::sentry::common
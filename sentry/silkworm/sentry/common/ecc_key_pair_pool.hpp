@@ -0,0 +1,64 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+
+#include "ecc_key_pair.hpp"
+
+namespace silkworm::sentry::common {
+
+//! A key pair together with its public key, both computed ahead of time.
+struct PrecomputedKeyPair {
+    EccKeyPair key_pair;
+    Bytes public_key;
+
+    static PrecomputedKeyPair generate();
+};
+
+//! Ephemeral key pairs generated in the background, so that the handshakes of a burst of connections do not pay for
+//! key generation and public key derivation. Thread safe: shared by the handshakes of all the peer contexts.
+class EccKeyPairPool {
+  public:
+    explicit EccKeyPairPool(std::size_t capacity);
+
+    //! A pooled key pair, or one generated on the spot if the pool is exhausted.
+    PrecomputedKeyPair take();
+
+    //! Generate key pairs until the pool is full, without holding the lock while generating.
+    //! Returns the number of key pairs added, 0 if another refill is in progress.
+    std::size_t refill();
+
+    //! true if the pool is below half of its capacity
+    [[nodiscard]] bool needs_refill() const;
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+  private:
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::vector<PrecomputedKeyPair> key_pairs_;
+    std::atomic_bool refilling_{false};
+};
+
+}  // namespace silkworm::sentry::common
@@ -0,0 +1,46 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "ecc_key_pair_pool.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::sentry::common {
+
+TEST_CASE("EccKeyPairPool.take") {
+    EccKeyPairPool pool{4};
+    CHECK(pool.size() == 0);
+    CHECK(pool.needs_refill());
+
+    auto generated = pool.take();  // generated on the spot
+    CHECK(generated.public_key == generated.key_pair.public_key());
+
+    CHECK(pool.refill() == 4);
+    CHECK(pool.refill() == 0);
+    CHECK_FALSE(pool.needs_refill());
+
+    auto pooled = pool.take();
+    CHECK(pooled.public_key == pooled.key_pair.public_key());
+    CHECK(pooled.public_key != generated.public_key);
+    CHECK(pool.size() == 3);
+
+    pool.take();
+    pool.take();
+    CHECK(pool.needs_refill());
+    CHECK(pool.refill() == 3);
+}
+
+}  // namespace silkworm::sentry::common
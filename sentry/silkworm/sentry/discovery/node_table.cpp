@@ -0,0 +1,166 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "node_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::sentry::discovery {
+
+static ethash::hash256 hash_of(const NodeTable::PublicKey& public_key) {
+    return keccak256(ByteView{public_key.data(), public_key.size()});
+}
+
+static bool same_hash(const ethash::hash256& a, const ethash::hash256& b) {
+    return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+}
+
+NodeTable::NodeTable(const PublicKey& local_public_key)
+    : local_hash_(hash_of(local_public_key)), entries_(kNumBuckets * kBucketSize) {}
+
+unsigned NodeTable::log_distance(const ethash::hash256& a, const ethash::hash256& b) {
+    for (std::size_t i = 0; i < sizeof(a.bytes); ++i) {
+        const auto x = static_cast<uint8_t>(a.bytes[i] ^ b.bytes[i]);
+        if (x != 0) {
+            return static_cast<unsigned>((sizeof(a.bytes) - i) * 8 - std::countl_zero(x));
+        }
+    }
+    return 0;
+}
+
+std::size_t NodeTable::bucket_of(const ethash::hash256& hash) const {
+    const unsigned distance = log_distance(local_hash_, hash);
+    return distance <= kBucketMinDistance ? 0 : distance - kBucketMinDistance;
+}
+
+NodeTable::Entry* NodeTable::find(std::size_t bucket, const ethash::hash256& hash) {
+    const auto begin = entries_.begin() + static_cast<std::ptrdiff_t>(bucket * kBucketSize);
+    const auto end = begin + static_cast<std::ptrdiff_t>(bucket_sizes_[bucket]);
+    const auto it = std::find_if(begin, end, [&](const Entry& e) { return same_hash(e.hash, hash); });
+    return it != end ? &*it : nullptr;
+}
+
+std::optional<NodeTable::Node> NodeTable::add(const Node& node, TimePoint now) {
+    const auto hash = hash_of(node.public_key);
+    if (same_hash(hash, local_hash_)) {
+        return std::nullopt;
+    }
+    const std::size_t bucket = bucket_of(hash);
+    if (Entry* entry = find(bucket, hash)) {
+        entry->node = node;
+        entry->last_seen = now;
+        return std::nullopt;
+    }
+
+    const auto begin = entries_.begin() + static_cast<std::ptrdiff_t>(bucket * kBucketSize);
+    if (bucket_sizes_[bucket] < kBucketSize) {
+        begin[static_cast<std::ptrdiff_t>(bucket_sizes_[bucket]++)] = {hash, node, now, {}};
+        return std::nullopt;
+    }
+    const auto oldest = std::min_element(begin, begin + kBucketSize, [](const Entry& a, const Entry& b) {
+        return a.last_seen < b.last_seen;
+    });
+    return oldest->node;
+}
+
+bool NodeTable::replace(const PublicKey& stale, const Node& replacement, TimePoint now) {
+    const auto stale_hash = hash_of(stale);
+    const auto hash = hash_of(replacement.public_key);
+    const std::size_t bucket = bucket_of(stale_hash);
+    if (bucket_of(hash) != bucket || find(bucket, hash)) {
+        return false;
+    }
+    Entry* entry = find(bucket, stale_hash);
+    if (!entry) {
+        return false;
+    }
+    *entry = {hash, replacement, now, {}};
+    return true;
+}
+
+bool NodeTable::remove(const PublicKey& public_key) {
+    const auto hash = hash_of(public_key);
+    const std::size_t bucket = bucket_of(hash);
+    Entry* entry = find(bucket, hash);
+    if (!entry) {
+        return false;
+    }
+    // the last entry of the bucket takes the free slot
+    Entry& last = entries_[bucket * kBucketSize + --bucket_sizes_[bucket]];
+    if (entry != &last) {
+        *entry = last;
+    }
+    return true;
+}
+
+std::vector<NodeTable::Node> NodeTable::closest(const PublicKey& target, std::size_t count) const {
+    const auto target_hash = hash_of(target);
+
+    std::vector<std::pair<ethash::hash256, const Entry*>> candidates;
+    candidates.reserve(size());
+    for (std::size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+        for (std::size_t i = bucket * kBucketSize; i < bucket * kBucketSize + bucket_sizes_[bucket]; ++i) {
+            ethash::hash256 distance{};
+            for (std::size_t j = 0; j < sizeof(distance.bytes); ++j) {
+                distance.bytes[j] = entries_[i].hash.bytes[j] ^ target_hash.bytes[j];
+            }
+            candidates.emplace_back(distance, &entries_[i]);
+        }
+    }
+
+    count = std::min(count, candidates.size());
+    const auto middle = candidates.begin() + static_cast<std::ptrdiff_t>(count);
+    std::partial_sort(candidates.begin(), middle, candidates.end(), [](const auto& a, const auto& b) {
+        return std::memcmp(a.first.bytes, b.first.bytes, sizeof(a.first.bytes)) < 0;
+    });
+
+    std::vector<Node> nodes;
+    nodes.reserve(count);
+    std::transform(candidates.begin(), middle, std::back_inserter(nodes), [](const auto& c) { return c.second->node; });
+    return nodes;
+}
+
+std::vector<NodeTable::Node> NodeTable::nodes_to_ping(TimePoint now, std::size_t max) {
+    std::vector<Node> nodes;
+    for (std::size_t bucket = 0; bucket < kNumBuckets && nodes.size() < max; ++bucket) {
+        for (std::size_t i = bucket * kBucketSize; i < bucket * kBucketSize + bucket_sizes_[bucket]; ++i) {
+            Entry& entry = entries_[i];
+            if (now - entry.last_seen < kRevalidationInterval || now - entry.last_ping < kRevalidationInterval) {
+                continue;
+            }
+            entry.last_ping = now;
+            nodes.push_back(entry.node);
+            if (nodes.size() == max) {
+                break;
+            }
+        }
+    }
+    return nodes;
+}
+
+std::size_t NodeTable::size() const {
+    std::size_t size = 0;
+    for (const std::size_t bucket_size : bucket_sizes_) {
+        size += bucket_size;
+    }
+    return size;
+}
+
+}  // namespace silkworm::sentry::discovery
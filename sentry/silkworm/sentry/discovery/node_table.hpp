@@ -0,0 +1,89 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <boost/asio/ip/udp.hpp>
+#include <ethash/hash_types.hpp>
+
+namespace silkworm::sentry::discovery {
+
+//! Kademlia routing table of the discovery: the known nodes in k-buckets by log distance from the local node.
+//! The buckets are slices of a single flat array, scanned linearly: with 16 entries per bucket this is faster
+//! than any node-based structure and never allocates after construction. As the distance is taken between
+//! keccak256 hashes of the node ids, distances below 241 are virtually never seen: they all share the first bucket.
+//! Not thread safe, it is owned by the discovery service.
+class NodeTable {
+  public:
+    static constexpr std::size_t kBucketSize{16};
+    static constexpr std::size_t kNumBuckets{17};
+    static constexpr unsigned kBucketMinDistance{256 - kNumBuckets + 1};  // the first bucket holds up to this distance
+    static constexpr std::chrono::seconds kRevalidationInterval{10};      // a node is pinged if not seen for this long
+
+    using PublicKey = std::array<uint8_t, 64>;  // uncompressed, without the 0x04 prefix
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Node {
+        PublicKey public_key{};
+        boost::asio::ip::udp::endpoint endpoint;
+        uint16_t tcp_port{0};
+    };
+
+    explicit NodeTable(const PublicKey& local_public_key);
+
+    //! Adds the node, or marks it as seen now if known. If its bucket is full, the least recently seen node of the
+    //! bucket is returned: it has to be pinged and replaced by the new one if it does not answer.
+    std::optional<Node> add(const Node& node, TimePoint now);
+
+    //! Replaces a node that did not answer a ping with the one waiting for its slot
+    bool replace(const PublicKey& stale, const Node& replacement, TimePoint now);
+
+    bool remove(const PublicKey& public_key);
+
+    //! Up to count known nodes, the closest to the target first: the answer to FINDNODE and the connection candidates
+    [[nodiscard]] std::vector<Node> closest(const PublicKey& target, std::size_t count) const;
+
+    //! Up to max nodes not seen nor pinged for kRevalidationInterval, marked as pinged now: max bounds the ping rate
+    std::vector<Node> nodes_to_ping(TimePoint now, std::size_t max);
+
+    [[nodiscard]] std::size_t size() const;
+
+    //! Position of the highest bit that differs between the two hashes, 0 if equal
+    static unsigned log_distance(const ethash::hash256& a, const ethash::hash256& b);
+
+  private:
+    struct Entry {
+        ethash::hash256 hash{};
+        Node node;
+        TimePoint last_seen;
+        TimePoint last_ping;
+    };
+
+    [[nodiscard]] std::size_t bucket_of(const ethash::hash256& hash) const;
+    Entry* find(std::size_t bucket, const ethash::hash256& hash);
+
+    ethash::hash256 local_hash_;
+    std::vector<Entry> entries_;                     // bucket b is [b * kBucketSize, b * kBucketSize + bucket_sizes_[b])
+    std::array<std::size_t, kNumBuckets> bucket_sizes_{};
+};
+
+}  // namespace silkworm::sentry::discovery
@@ -0,0 +1,115 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "node_table.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::sentry::discovery {
+
+TEST_CASE("NodeTable.log_distance") {
+    ethash::hash256 a{};
+    ethash::hash256 b{};
+    CHECK(NodeTable::log_distance(a, b) == 0);
+    b.bytes[31] = 1;
+    CHECK(NodeTable::log_distance(a, b) == 1);
+    b.bytes[0] = 0x80;
+    CHECK(NodeTable::log_distance(a, b) == 256);
+}
+
+TEST_CASE("NodeTable") {
+    using namespace std::chrono_literals;
+    using Node = NodeTable::Node;
+
+    auto make_node = [](uint32_t i) {
+        Node node;
+        endian::store_big_u32(&node.public_key[60], i);
+        node.tcp_port = 30303;
+        return node;
+    };
+    auto hash_of = [](const Node& node) { return keccak256(ByteView{node.public_key.data(), node.public_key.size()}); };
+
+    const Node local = make_node(0);
+    NodeTable table{local.public_key};
+    const auto now = std::chrono::steady_clock::now();
+
+    // nodes of the farthest bucket
+    std::vector<Node> far;
+    for (uint32_t i = 1; far.size() <= NodeTable::kBucketSize; ++i) {
+        Node node = make_node(i);
+        if (NodeTable::log_distance(hash_of(local), hash_of(node)) == 256) {
+            far.push_back(node);
+        }
+    }
+    auto fill_bucket = [&] {
+        for (std::size_t i = 0; i < NodeTable::kBucketSize; ++i) {
+            REQUIRE_FALSE(table.add(far[i], now + std::chrono::seconds(i)));
+        }
+    };
+
+    SECTION("add") {
+        CHECK_FALSE(table.add(local, now));  // never itself
+        CHECK(table.size() == 0);
+        CHECK_FALSE(table.add(far[0], now));
+        CHECK_FALSE(table.add(far[0], now + 1s));
+        CHECK(table.size() == 1);
+    }
+
+    SECTION("full bucket") {
+        fill_bucket();
+        const auto oldest = table.add(far[NodeTable::kBucketSize], now + 1min);
+        REQUIRE(oldest);
+        CHECK(oldest->public_key == far[0].public_key);
+        CHECK(table.size() == NodeTable::kBucketSize);
+
+        CHECK(table.replace(far[0].public_key, far[NodeTable::kBucketSize], now + 1min));
+        CHECK_FALSE(table.replace(far[0].public_key, far[NodeTable::kBucketSize], now + 1min));
+        CHECK(table.size() == NodeTable::kBucketSize);
+        CHECK(table.closest(far[NodeTable::kBucketSize].public_key, 1)[0].public_key ==
+              far[NodeTable::kBucketSize].public_key);
+    }
+
+    SECTION("remove") {
+        fill_bucket();
+        CHECK(table.remove(far[0].public_key));
+        CHECK_FALSE(table.remove(far[0].public_key));
+        CHECK(table.size() == NodeTable::kBucketSize - 1);
+        CHECK_FALSE(table.add(far[NodeTable::kBucketSize], now));  // a free slot
+    }
+
+    SECTION("closest") {
+        fill_bucket();
+        const auto closest = table.closest(far[3].public_key, 3);
+        REQUIRE(closest.size() == 3);
+        CHECK(closest[0].public_key == far[3].public_key);
+        CHECK(table.closest(local.public_key, 100).size() == NodeTable::kBucketSize);
+    }
+
+    SECTION("nodes to ping") {
+        for (std::size_t i = 0; i < 3; ++i) table.add(far[i], now);
+        CHECK(table.nodes_to_ping(now + 5s, 10).empty());  // seen recently
+        CHECK(table.nodes_to_ping(now + 10s, 2).size() == 2);
+        CHECK(table.nodes_to_ping(now + 10s, 2).size() == 1);
+        CHECK(table.nodes_to_ping(now + 15s, 2).empty());  // pinged recently
+        table.add(far[0], now + 15s);                       // answered
+        CHECK(table.nodes_to_ping(now + 20s, 10).size() == 2);
+    }
+}
+
+}  // namespace silkworm::sentry::discovery
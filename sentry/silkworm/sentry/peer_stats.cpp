@@ -0,0 +1,103 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "peer_stats.hpp"
+
+#include <algorithm>
+
+namespace silkworm::sentry {
+
+void PeerStatsCollector::RateMeter::add(std::size_t bytes, Clock::time_point now) {
+    if (now - window_start >= kRateWindow) {
+        last_rate = rate(now);
+        window_start = now;
+        window_bytes = 0;
+    }
+    window_bytes += bytes;
+}
+
+double PeerStatsCollector::RateMeter::rate(Clock::time_point now) const {
+    const auto elapsed = std::chrono::duration<double>(now - window_start).count();
+    if (elapsed < std::chrono::duration<double>(kRateWindow).count()) {
+        return last_rate;  // window in progress
+    }
+    return static_cast<double>(window_bytes) / elapsed;
+}
+
+void PeerStatsCollector::on_connect(const Bytes& peer_id, Clock::time_point now) {
+    std::scoped_lock lock{mutex_};
+    Entry entry;
+    entry.stats.peer_id = peer_id;
+    entry.in.window_start = now;
+    entry.out.window_start = now;
+    peers_.insert_or_assign(peer_id, std::move(entry));
+}
+
+void PeerStatsCollector::on_disconnect(const Bytes& peer_id) {
+    std::scoped_lock lock{mutex_};
+    peers_.erase(peer_id);
+}
+
+void PeerStatsCollector::on_bytes_received(const Bytes& peer_id, std::size_t bytes, Clock::time_point now) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = peers_.find(peer_id); it != peers_.end()) {
+        it->second.in.add(bytes, now);
+    }
+}
+
+void PeerStatsCollector::on_bytes_sent(const Bytes& peer_id, std::size_t bytes, Clock::time_point now) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = peers_.find(peer_id); it != peers_.end()) {
+        it->second.out.add(bytes, now);
+    }
+}
+
+void PeerStatsCollector::on_rtt_sample(const Bytes& peer_id, std::chrono::milliseconds rtt) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = peers_.find(peer_id); it != peers_.end()) {
+        auto& smoothed = it->second.stats.rtt;
+        // exponential moving average with weight 1/8, as the TCP smoothed RTT
+        smoothed = smoothed.count() == 0 ? rtt : (smoothed * 7 + rtt) / 8;
+    }
+}
+
+void PeerStatsCollector::on_send_queue_bytes(const Bytes& peer_id, std::size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = peers_.find(peer_id); it != peers_.end()) {
+        it->second.stats.send_queue_bytes = bytes;
+    }
+}
+
+void PeerStatsCollector::on_best_block(const Bytes& peer_id, BlockNum block_num) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = peers_.find(peer_id); it != peers_.end()) {
+        it->second.stats.best_block = std::max(it->second.stats.best_block, block_num);
+    }
+}
+
+std::vector<PeerStats> PeerStatsCollector::snapshot(Clock::time_point now) const {
+    std::scoped_lock lock{mutex_};
+    std::vector<PeerStats> snapshot;
+    snapshot.reserve(peers_.size());
+    for (const auto& [peer_id, entry] : peers_) {
+        PeerStats& stats = snapshot.emplace_back(entry.stats);
+        stats.bytes_in_per_sec = entry.in.rate(now);
+        stats.bytes_out_per_sec = entry.out.rate(now);
+    }
+    return snapshot;
+}
+
+}  // namespace silkworm::sentry
@@ -0,0 +1,80 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::sentry {
+
+//! Measured statistics of a peer session.
+struct PeerStats {
+    Bytes peer_id;                         // public key
+    std::chrono::milliseconds rtt{0};      // smoothed round trip time of the requests, 0 if not measured yet
+    double bytes_in_per_sec{0};            // over the last rate window
+    double bytes_out_per_sec{0};           // over the last rate window
+    std::size_t send_queue_bytes{0};
+    BlockNum best_block{0};
+};
+
+//! Statistics of all the peer sessions, updated by the sessions on their contexts and read by the clients in the
+//! same process through Sentry::peer_stats, so that they can pick peers without probing. Thread safe.
+class PeerStatsCollector {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds kRateWindow{5};
+
+    void on_connect(const Bytes& peer_id, Clock::time_point now);
+    void on_disconnect(const Bytes& peer_id);
+
+    void on_bytes_received(const Bytes& peer_id, std::size_t bytes, Clock::time_point now);
+    void on_bytes_sent(const Bytes& peer_id, std::size_t bytes, Clock::time_point now);
+    void on_rtt_sample(const Bytes& peer_id, std::chrono::milliseconds rtt);
+    void on_send_queue_bytes(const Bytes& peer_id, std::size_t bytes);
+    void on_best_block(const Bytes& peer_id, BlockNum block_num);
+
+    //! The statistics of the connected peers, in peer id order
+    [[nodiscard]] std::vector<PeerStats> snapshot(Clock::time_point now) const;
+
+  private:
+    //! Bytes transferred in fixed windows: the rate is the one of the last complete window
+    struct RateMeter {
+        Clock::time_point window_start;
+        std::size_t window_bytes{0};
+        double last_rate{0};
+
+        void add(std::size_t bytes, Clock::time_point now);
+        [[nodiscard]] double rate(Clock::time_point now) const;
+    };
+
+    struct Entry {
+        PeerStats stats;
+        RateMeter in;
+        RateMeter out;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<Bytes, Entry> peers_;
+};
+
+}  // namespace silkworm::sentry
@@ -0,0 +1,67 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "peer_stats.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::sentry {
+
+TEST_CASE("PeerStatsCollector.snapshot") {
+    using namespace std::chrono_literals;
+
+    PeerStatsCollector collector;
+    const auto now = PeerStatsCollector::Clock::now();
+    const Bytes peer1(64, 0x01);
+    const Bytes peer2(64, 0x02);
+
+    CHECK(collector.snapshot(now).empty());
+
+    collector.on_connect(peer2, now);
+    collector.on_connect(peer1, now);
+    collector.on_rtt_sample(peer1, 80ms);
+    collector.on_rtt_sample(peer1, 160ms);
+    collector.on_best_block(peer1, 100);
+    collector.on_best_block(peer1, 90);  // not the best one
+    collector.on_send_queue_bytes(peer1, 1'000);
+    collector.on_bytes_received(peer1, 10'000, now);
+    collector.on_bytes_sent(peer1, 5'000, now + 1s);
+    collector.on_best_block(Bytes(64, 0x03), 1);  // not connected
+
+    auto snapshot = collector.snapshot(now + 2s);
+    REQUIRE(snapshot.size() == 2);
+    CHECK(snapshot[0].peer_id == peer1);
+    CHECK(snapshot[0].rtt == 90ms);
+    CHECK(snapshot[0].best_block == 100);
+    CHECK(snapshot[0].send_queue_bytes == 1'000);
+    CHECK(snapshot[0].bytes_in_per_sec == 0);  // first window in progress
+    CHECK(snapshot[1].peer_id == peer2);
+    CHECK(snapshot[1].rtt == 0ms);
+
+    snapshot = collector.snapshot(now + 10s);  // first window over
+    CHECK(snapshot[0].bytes_in_per_sec == Approx(1'000));
+    CHECK(snapshot[0].bytes_out_per_sec == Approx(500));
+
+    collector.on_bytes_received(peer1, 1'000, now + 10s);  // new window
+    CHECK(collector.snapshot(now + 11s)[0].bytes_in_per_sec == Approx(1'000));
+
+    collector.on_disconnect(peer1);
+    snapshot = collector.snapshot(now + 11s);
+    REQUIRE(snapshot.size() == 1);
+    CHECK(snapshot[0].peer_id == peer2);
+}
+
+}  // namespace silkworm::sentry
@@ -25,7 +25,6 @@ limitations under the License.
 #include <silkpre/sha256.h>
 
 #include <silkworm/common/secp256k1_context.hpp>
-#include <silkworm/sentry/common/ecc_key_pair.hpp>
 #include <silkworm/sentry/common/random.hpp>
 
 namespace silkworm::sentry::rlpx::auth {
@@ -37,16 +36,19 @@ static Bytes aes_decrypt(ByteView cipher_text, ByteView key, ByteView iv);
 static Bytes sha256(ByteView data);
 static Bytes hmac(ByteView key, ByteView data1, ByteView data2);
 
-EciesCipher::Message EciesCipher::encrypt_message(ByteView plain_text, PublicKeyView public_key_view) {
+EciesCipher::Message EciesCipher::encrypt_message(ByteView plain_text, PublicKeyView public_key) {
+    return encrypt_message(plain_text, public_key, common::PrecomputedKeyPair::generate());
+}
+
+EciesCipher::Message EciesCipher::encrypt_message(ByteView plain_text, PublicKeyView public_key_view,
+                                                  const common::PrecomputedKeyPair& ephemeral_key_pair) {
     secp256k1_pubkey public_key;
     assert(public_key_view.size() == sizeof(public_key.data));
     memcpy(public_key.data, public_key_view.data(), sizeof(public_key.data));
 
-    common::EccKeyPair ephemeral_key_pair;
-
     Bytes shared_secret(kKeySize * 2, 0);
     SecP256K1Context ctx;
-    auto ephemeral_private_key = ephemeral_key_pair.private_key();
+    auto ephemeral_private_key = ephemeral_key_pair.key_pair.private_key();
     bool ok = ctx.compute_ecdh_secret(shared_secret, &public_key, ephemeral_private_key);
     if (!ok) {
         throw std::runtime_error("Failed to ECDH-agree public key and ephemeral private key");
@@ -61,7 +63,7 @@ EciesCipher::Message EciesCipher::encrypt_message(ByteView plain_text, PublicKey
     Bytes mac = hmac(sha256(mac_key), iv, cypher_text);
 
     return {
-        ephemeral_key_pair.public_key(),
+        ephemeral_key_pair.public_key,
         std::move(iv),
         std::move(cypher_text),
         std::move(mac),
@@ -17,6 +17,7 @@ limitations under the License.
 #pragma once
 
 #include <silkworm/common/base.hpp>
+#include <silkworm/sentry/common/ecc_key_pair_pool.hpp>
 
 namespace silkworm::sentry::rlpx::auth {
 
@@ -34,6 +35,9 @@ class EciesCipher {
     };
 
     static Message encrypt_message(ByteView plain_text, PublicKeyView public_key);
+    //! Encrypt with an ephemeral key pair generated ahead of time, e.g. taken from an EccKeyPairPool
+    static Message encrypt_message(ByteView plain_text, PublicKeyView public_key,
+                                   const common::PrecomputedKeyPair& ephemeral_key_pair);
     static Bytes decrypt_message(const Message& message, PrivateKeyView private_key);
 
     static Bytes encrypt(ByteView plain_text, PublicKeyView public_key);
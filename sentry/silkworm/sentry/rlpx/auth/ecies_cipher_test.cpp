@@ -17,6 +17,7 @@ limitations under the License.
 #include "ecies_cipher.hpp"
 #include <catch2/catch.hpp>
 #include <silkworm/sentry/common/ecc_key_pair.hpp>
+#include <silkworm/sentry/common/ecc_key_pair_pool.hpp>
 
 namespace silkworm::sentry::rlpx::auth {
 
@@ -38,6 +39,18 @@ TEST_CASE("EciesCipher.encrypt_decrypt_message") {
     CHECK(plain_text == expected_plain_text);
 }
 
+TEST_CASE("EciesCipher.encrypt_message_with_pooled_key") {
+    common::EccKeyPair receiver_key;
+    common::EccKeyPairPool pool{1};
+    pool.refill();
+    const auto ephemeral_key_pair = pool.take();
+
+    Bytes expected_plain_text = {1, 2, 3, 4, 5};
+    auto message = EciesCipher::encrypt_message(expected_plain_text, receiver_key.public_key(), ephemeral_key_pair);
+    CHECK(message.ephemeral_public_key == ephemeral_key_pair.public_key);
+    CHECK(EciesCipher::decrypt_message(message, receiver_key.private_key()) == expected_plain_text);
+}
+
 TEST_CASE("EciesCipher.encrypt_decrypt_bytes") {
     common::EccKeyPair receiver_key;
 
@@ -0,0 +1,197 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "frame_cipher.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include <ethash/keccak.hpp>
+#include <openssl/aes.h>
+#include <openssl/crypto.h>
+
+namespace silkworm::sentry::rlpx::framing {
+
+static const std::size_t kSecretSize = 32;
+
+// RLP of the header data [capability-id, context-id], both zero and unused
+static const uint8_t kHeaderData[] = {0xC2, 0x80, 0x80};
+
+static void absorb(std::array<uint64_t, 25>& state, const uint8_t* block, std::size_t size) {
+    for (std::size_t i = 0; i < size / 8; ++i) {
+        uint64_t lane = 0;
+        for (std::size_t j = 0; j < 8; ++j) {
+            lane |= static_cast<uint64_t>(block[i * 8 + j]) << (8 * j);
+        }
+        state[i] ^= lane;
+    }
+    ethash_keccakf1600(state.data());
+}
+
+void Keccak256::update(ByteView data) {
+    while (!data.empty()) {
+        const std::size_t count = std::min(kRate - buffer_size_, data.size());
+        std::copy_n(data.data(), count, buffer_.data() + buffer_size_);
+        buffer_size_ += count;
+        data.remove_prefix(count);
+        if (buffer_size_ == kRate) {
+            absorb(state_, buffer_.data(), kRate);
+            buffer_size_ = 0;
+        }
+    }
+}
+
+std::array<uint8_t, 32> Keccak256::digest() const {
+    std::array<uint64_t, 25> state{state_};
+    std::array<uint8_t, kRate> block{};
+    std::copy_n(buffer_.data(), buffer_size_, block.data());
+    block[buffer_size_] ^= 0x01;
+    block[kRate - 1] ^= 0x80;
+    absorb(state, block.data(), kRate);
+
+    std::array<uint8_t, 32> hash{};
+    for (std::size_t i = 0; i < hash.size(); ++i) {
+        hash[i] = static_cast<uint8_t>(state[i / 8] >> (8 * (i % 8)));
+    }
+    return hash;
+}
+
+static EVP_CIPHER_CTX* new_cipher(const EVP_CIPHER* cipher, ByteView key) {
+    if (key.size() != kSecretSize)
+        throw std::invalid_argument("Invalid RLPx secret size");
+
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    const uint8_t iv[AES_BLOCK_SIZE] = {};
+    if (!ctx || !EVP_EncryptInit_ex(ctx, cipher, nullptr, key.data(), iv)) {
+        EVP_CIPHER_CTX_free(ctx);
+        throw std::runtime_error("Failed to init AES cipher");
+    }
+    EVP_CIPHER_CTX_set_padding(ctx, 0);
+    return ctx;
+}
+
+// Encrypt (or decrypt, CTR mode being symmetric) from source to destination, which may be the same
+static void aes_update(EVP_CIPHER_CTX* ctx, const uint8_t* source, uint8_t* destination, std::size_t size) {
+    int out_size = 0;
+    if (!EVP_EncryptUpdate(ctx, destination, &out_size, source, static_cast<int>(size)))
+        throw std::runtime_error("Failed to AES encrypt");
+    assert(static_cast<std::size_t>(out_size) == size);
+}
+
+// Encrypt (or decrypt) in place
+static void aes_update(EVP_CIPHER_CTX* ctx, uint8_t* data, std::size_t size) {
+    aes_update(ctx, data, data, size);
+}
+
+FrameCipher::FrameCipher(const Secrets& secrets)
+    : egress_aes_(new_cipher(EVP_aes_256_ctr(), secrets.aes_secret)),
+      ingress_aes_(new_cipher(EVP_aes_256_ctr(), secrets.aes_secret)),
+      mac_aes_(new_cipher(EVP_aes_256_ecb(), secrets.mac_secret)) {
+    egress_mac_.update(secrets.egress_mac_seed);
+    ingress_mac_.update(secrets.ingress_mac_seed);
+}
+
+FrameCipher::~FrameCipher() {
+    EVP_CIPHER_CTX_free(egress_aes_);
+    EVP_CIPHER_CTX_free(ingress_aes_);
+    EVP_CIPHER_CTX_free(mac_aes_);
+}
+
+std::size_t FrameCipher::padded_size(std::size_t frame_size) {
+    return (frame_size + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE * AES_BLOCK_SIZE;
+}
+
+std::size_t FrameCipher::encrypted_frame_size(std::size_t frame_size) {
+    return kHeaderSize + kMacSize + padded_size(frame_size) + kMacSize;
+}
+
+void FrameCipher::update_mac(Keccak256& mac, const uint8_t* seed, uint8_t* mac_out) {
+    auto digest = mac.digest();
+    aes_update(mac_aes_, digest.data(), AES_BLOCK_SIZE);
+    for (std::size_t i = 0; i < AES_BLOCK_SIZE; ++i) {
+        digest[i] ^= seed[i];
+    }
+    mac.update({digest.data(), AES_BLOCK_SIZE});
+    std::copy_n(mac.digest().data(), kMacSize, mac_out);
+}
+
+std::span<uint8_t> FrameCipher::encrypt_frame(std::span<uint8_t> buffer, std::size_t frame_size) {
+    if (buffer.size() < kHeaderSize + kMacSize)
+        throw std::invalid_argument("RLPx frame buffer is too small");
+    return encrypt_frame(buffer.data() + kHeaderSize + kMacSize, frame_size, buffer);
+}
+
+std::span<uint8_t> FrameCipher::encrypt_frame(ByteView frame, std::span<uint8_t> buffer) {
+    return encrypt_frame(frame.data(), frame.size(), buffer);
+}
+
+std::span<uint8_t> FrameCipher::encrypt_frame(const uint8_t* source, std::size_t frame_size, std::span<uint8_t> buffer) {
+    if (frame_size > kMaxFrameSize)
+        throw std::invalid_argument("RLPx frame is too large");
+    const std::size_t total_size = encrypted_frame_size(frame_size);
+    if (buffer.size() < total_size)
+        throw std::invalid_argument("RLPx frame buffer is too small");
+
+    uint8_t* header = buffer.data();
+    std::fill_n(header, kHeaderSize, uint8_t{0});
+    header[0] = static_cast<uint8_t>(frame_size >> 16);
+    header[1] = static_cast<uint8_t>(frame_size >> 8);
+    header[2] = static_cast<uint8_t>(frame_size);
+    std::copy_n(kHeaderData, sizeof(kHeaderData), header + 3);
+    aes_update(egress_aes_, header, kHeaderSize);
+    update_mac(egress_mac_, header, header + kHeaderSize);
+
+    uint8_t* frame = header + kHeaderSize + kMacSize;
+    const std::size_t frame_padded_size = padded_size(frame_size);
+    aes_update(egress_aes_, source, frame, frame_size);
+    std::fill(frame + frame_size, frame + frame_padded_size, uint8_t{0});
+    aes_update(egress_aes_, frame + frame_size, frame_padded_size - frame_size);
+    egress_mac_.update({frame, frame_padded_size});
+    const auto seed = egress_mac_.digest();
+    update_mac(egress_mac_, seed.data(), frame + frame_padded_size);
+
+    return buffer.first(total_size);
+}
+
+std::size_t FrameCipher::decrypt_header(std::span<uint8_t, kHeaderSize + kMacSize> header) {
+    uint8_t expected_mac[kMacSize];
+    update_mac(ingress_mac_, header.data(), expected_mac);
+    if (CRYPTO_memcmp(expected_mac, header.data() + kHeaderSize, kMacSize) != 0)
+        throw std::runtime_error("Invalid RLPx header MAC");
+
+    aes_update(ingress_aes_, header.data(), kHeaderSize);
+    return (std::size_t{header[0]} << 16) | (std::size_t{header[1]} << 8) | std::size_t{header[2]};
+}
+
+ByteView FrameCipher::decrypt_frame(std::span<uint8_t> buffer, std::size_t frame_size) {
+    const std::size_t frame_padded_size = padded_size(frame_size);
+    if (buffer.size() < frame_padded_size + kMacSize)
+        throw std::invalid_argument("RLPx frame buffer is too small");
+
+    uint8_t* frame = buffer.data();
+    ingress_mac_.update({frame, frame_padded_size});
+    const auto seed = ingress_mac_.digest();
+    uint8_t expected_mac[kMacSize];
+    update_mac(ingress_mac_, seed.data(), expected_mac);
+    if (CRYPTO_memcmp(expected_mac, frame + frame_padded_size, kMacSize) != 0)
+        throw std::runtime_error("Invalid RLPx frame MAC");
+
+    aes_update(ingress_aes_, frame, frame_padded_size);
+    return {frame, frame_size};
+}
+
+}  // namespace silkworm::sentry::rlpx::framing
@@ -0,0 +1,100 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include <openssl/evp.h>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::sentry::rlpx::framing {
+
+//! Keccak-256 whose digest can be taken at any time while going on hashing, as needed by the RLPx MAC states.
+class Keccak256 {
+  public:
+    void update(ByteView data);
+    [[nodiscard]] std::array<uint8_t, 32> digest() const;
+
+  private:
+    static constexpr std::size_t kRate{136};
+
+    std::array<uint64_t, 25> state_{};
+    std::array<uint8_t, kRate> buffer_{};
+    std::size_t buffer_size_{0};
+};
+
+//! RLPx frame encryption (AES-256-CTR) and authentication (Keccak-256 MACs seeded by AES-256) of one session.
+//! Frames are encrypted and decrypted in place, in buffers owned by the caller: there is no allocation per frame.
+//! The AES implementation of OpenSSL uses the AES instructions of the CPU (AES-NI, ARMv8 crypto) when available.
+class FrameCipher {
+  public:
+    //! The secrets agreed by the handshake.
+    struct Secrets {
+        Bytes aes_secret;        // 32 bytes
+        Bytes mac_secret;        // 32 bytes
+        Bytes egress_mac_seed;   // (mac_secret ^ remote nonce) || auth/ack message sent
+        Bytes ingress_mac_seed;  // (mac_secret ^ local nonce) || auth/ack message received
+    };
+
+    static constexpr std::size_t kHeaderSize{16};
+    static constexpr std::size_t kMacSize{16};
+    static constexpr std::size_t kMaxFrameSize{(1 << 24) - 1};
+
+    explicit FrameCipher(const Secrets& secrets);
+    ~FrameCipher();
+
+    FrameCipher(const FrameCipher&) = delete;
+    FrameCipher& operator=(const FrameCipher&) = delete;
+
+    //! The size of header, header MAC, frame padded to the AES block size and frame MAC.
+    static std::size_t encrypted_frame_size(std::size_t frame_size);
+
+    //! Encrypt in place the frame placed at offset kHeaderSize + kMacSize of the buffer, which must be at least
+    //! encrypted_frame_size long. Returns the encrypted frame with header and MACs, a prefix of the buffer.
+    std::span<uint8_t> encrypt_frame(std::span<uint8_t> buffer, std::size_t frame_size);
+
+    //! Encrypt the frame into the buffer, which must be at least encrypted_frame_size long, leaving the frame
+    //! untouched: a message encoded and compressed once can be broadcast to many sessions, each one only paying for
+    //! its own encryption and MACs. Returns the encrypted frame with header and MACs, a prefix of the buffer.
+    std::span<uint8_t> encrypt_frame(ByteView frame, std::span<uint8_t> buffer);
+
+    //! Check the MAC and decrypt in place the header, returns the size of the frame following it.
+    std::size_t decrypt_header(std::span<uint8_t, kHeaderSize + kMacSize> header);
+
+    //! Check the MAC and decrypt in place the frame following the header: the buffer holds the padded frame and its
+    //! MAC. Returns the frame, a prefix of the buffer.
+    ByteView decrypt_frame(std::span<uint8_t> buffer, std::size_t frame_size);
+
+  private:
+    static std::size_t padded_size(std::size_t frame_size);
+
+    std::span<uint8_t> encrypt_frame(const uint8_t* source, std::size_t frame_size, std::span<uint8_t> buffer);
+
+    //! Absorb the AES-encrypted digest xor seed into the MAC state and write the new MAC.
+    void update_mac(Keccak256& mac, const uint8_t* seed, uint8_t* mac_out);
+
+    EVP_CIPHER_CTX* egress_aes_;
+    EVP_CIPHER_CTX* ingress_aes_;
+    EVP_CIPHER_CTX* mac_aes_;
+    Keccak256 egress_mac_;
+    Keccak256 ingress_mac_;
+};
+
+}  // namespace silkworm::sentry::rlpx::framing
@@ -0,0 +1,102 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "frame_cipher.hpp"
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::sentry::rlpx::framing {
+
+TEST_CASE("Keccak256.digest") {
+    Keccak256 empty;
+    CHECK(to_hex({empty.digest().data(), 32}) == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+
+    Keccak256 abc;
+    abc.update(string_view_to_byte_view("a"));
+    CHECK(to_hex({abc.digest().data(), 32}) == "3ac225168df54212a25c1c01fd35bebfea408fdac2e31ddd6f80a4bbf9a5f1cb");
+    abc.update(string_view_to_byte_view("bc"));  // going on after a digest
+    CHECK(to_hex({abc.digest().data(), 32}) == "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+
+    Bytes data(300, 0x5a);  // more than one block
+    Keccak256 chunked;
+    chunked.update({data.data(), 100});
+    chunked.update({data.data() + 100, 200});
+    const auto expected_hash = ethash::keccak256(data.data(), data.size());
+    CHECK(to_hex({chunked.digest().data(), 32}) == to_hex({expected_hash.bytes, 32}));
+}
+
+TEST_CASE("FrameCipher.encrypt_decrypt_frame") {
+    const Bytes aes_secret(32, 0x01);
+    const Bytes mac_secret(32, 0x02);
+    const Bytes initiator_seed(64, 0x03);
+    const Bytes recipient_seed(64, 0x04);
+    FrameCipher initiator{{aes_secret, mac_secret, initiator_seed, recipient_seed}};
+    FrameCipher recipient{{aes_secret, mac_secret, recipient_seed, initiator_seed}};
+
+    const Bytes expected_frame{*from_hex("c28080deadbeef")};
+    std::array<uint8_t, 1024> buffer{};
+
+    for (int i = 0; i < 3; ++i) {  // the cipher and MAC states go on across frames
+        std::copy(expected_frame.begin(), expected_frame.end(), buffer.begin() + 32);
+        auto encrypted = initiator.encrypt_frame(buffer, expected_frame.size());
+        REQUIRE(encrypted.size() == FrameCipher::encrypted_frame_size(expected_frame.size()));
+        CHECK(encrypted.size() == 32 + 16 + 16);
+
+        const auto frame_size = recipient.decrypt_header(encrypted.first<32>());
+        CHECK(frame_size == expected_frame.size());
+        const auto frame = recipient.decrypt_frame(encrypted.subspan(32), frame_size);
+        CHECK(Bytes{frame} == expected_frame);
+    }
+
+    SECTION("frame shared by sessions") {
+        FrameCipher in_place_sender{{aes_secret, mac_secret, initiator_seed, recipient_seed}};
+        FrameCipher shared_sender{{aes_secret, mac_secret, initiator_seed, recipient_seed}};
+        FrameCipher shared_recipient{{aes_secret, mac_secret, recipient_seed, initiator_seed}};
+
+        std::copy(expected_frame.begin(), expected_frame.end(), buffer.begin() + 32);
+        const auto in_place = in_place_sender.encrypt_frame(buffer, expected_frame.size());
+        const Bytes expected_encrypted{in_place.data(), in_place.size()};
+
+        const Bytes shared_frame{expected_frame};
+        std::array<uint8_t, 1024> session_buffer{};
+        const auto encrypted = shared_sender.encrypt_frame(shared_frame, session_buffer);
+        CHECK(to_hex({encrypted.data(), encrypted.size()}) == to_hex(expected_encrypted));
+        CHECK(shared_frame == expected_frame);  // untouched
+
+        const auto frame_size = shared_recipient.decrypt_header(encrypted.first<32>());
+        CHECK(Bytes{shared_recipient.decrypt_frame(encrypted.subspan(32), frame_size)} == expected_frame);
+    }
+
+    SECTION("tampered frame") {
+        std::copy(expected_frame.begin(), expected_frame.end(), buffer.begin() + 32);
+        auto encrypted = initiator.encrypt_frame(buffer, expected_frame.size());
+        encrypted[32] ^= 0x01;
+        const auto frame_size = recipient.decrypt_header(encrypted.first<32>());
+        CHECK_THROWS_AS(recipient.decrypt_frame(encrypted.subspan(32), frame_size), std::runtime_error);
+    }
+
+    SECTION("tampered header") {
+        auto encrypted = initiator.encrypt_frame(buffer, expected_frame.size());
+        encrypted[0] ^= 0x01;
+        CHECK_THROWS_AS(recipient.decrypt_header(encrypted.first<32>()), std::runtime_error);
+    }
+
+    SECTION("buffer too small") {
+        CHECK_THROWS_AS(initiator.encrypt_frame(std::span{buffer}.first(63), expected_frame.size()), std::invalid_argument);
+    }
+}
+
+}  // namespace silkworm::sentry::rlpx::framing
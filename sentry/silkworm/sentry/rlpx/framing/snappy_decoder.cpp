@@ -0,0 +1,138 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "snappy_decoder.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace silkworm::sentry::rlpx::framing {
+
+// Read a little-endian varint, as used by the length header
+static std::optional<uint64_t> read_varint(ByteView& data) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64 && !data.empty(); shift += 7) {
+        const uint8_t byte = data.front();
+        data.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+// Read a little-endian integer of size bytes
+static std::optional<std::size_t> read_little(ByteView& data, std::size_t size) {
+    if (data.size() < size) {
+        return std::nullopt;
+    }
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        value |= static_cast<std::size_t>(data[i]) << (8 * i);
+    }
+    data.remove_prefix(size);
+    return value;
+}
+
+std::optional<std::size_t> SnappyDecoder::uncompressed_length(ByteView compressed) {
+    const auto length = read_varint(compressed);
+    if (!length || *length > UINT32_MAX) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(*length);
+}
+
+bool SnappyDecoder::decompress(ByteView compressed, std::span<uint8_t> output) {
+    const auto length = read_varint(compressed);
+    if (!length || *length != output.size()) {
+        return false;
+    }
+
+    std::size_t position = 0;
+    while (!compressed.empty()) {
+        const uint8_t tag = compressed.front();
+        compressed.remove_prefix(1);
+
+        if ((tag & 0x03) == 0) {  // literal
+            std::size_t literal_length = tag >> 2;
+            if (literal_length >= 60) {
+                const auto long_length = read_little(compressed, literal_length - 59);
+                if (!long_length) {
+                    return false;
+                }
+                literal_length = *long_length;
+            }
+            ++literal_length;
+            if (literal_length > compressed.size() || literal_length > output.size() - position) {
+                return false;
+            }
+            std::copy_n(compressed.data(), literal_length, output.data() + position);
+            compressed.remove_prefix(literal_length);
+            position += literal_length;
+            continue;
+        }
+
+        std::size_t copy_length{0};
+        std::optional<std::size_t> offset;
+        switch (tag & 0x03) {
+            case 1: {  // copy with 1-byte offset
+                copy_length = ((tag >> 2) & 0x07) + 4;
+                const auto offset_low = read_little(compressed, 1);
+                if (offset_low) {
+                    offset = (static_cast<std::size_t>(tag >> 5) << 8) | *offset_low;
+                }
+            } break;
+            case 2: {  // copy with 2-byte offset
+                copy_length = (tag >> 2) + 1;
+                offset = read_little(compressed, 2);
+            } break;
+            default: {  // copy with 4-byte offset
+                copy_length = (tag >> 2) + 1;
+                offset = read_little(compressed, 4);
+            } break;
+        }
+        if (!offset || *offset == 0 || *offset > position || copy_length > output.size() - position) {
+            return false;
+        }
+        // Byte by byte: the source may overlap the destination, repeating a pattern
+        const uint8_t* source = output.data() + position - *offset;
+        uint8_t* destination = output.data() + position;
+        for (std::size_t i = 0; i < copy_length; ++i) {
+            destination[i] = source[i];
+        }
+        position += copy_length;
+    }
+    return position == output.size();
+}
+
+ByteView SnappyDecoder::decompress(ByteView compressed) {
+    const auto length = uncompressed_length(compressed);
+    if (!length) {
+        throw std::runtime_error("Invalid snappy length header");
+    }
+    if (*length > kMaxMessageSize) {
+        throw std::runtime_error("Snappy message is too large: " + std::to_string(*length));
+    }
+
+    buffer_.resize(*length);  // keeps the capacity of larger previous messages
+    if (!decompress(compressed, buffer_)) {
+        throw std::runtime_error("Invalid snappy data");
+    }
+    return buffer_;
+}
+
+}  // namespace silkworm::sentry::rlpx::framing
@@ -0,0 +1,49 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::sentry::rlpx::framing {
+
+//! Decoder of the snappy-compressed (block format) eth messages of one session.
+//! Each message is decompressed into a session buffer sized from the length header of the block, whose capacity is
+//! reused across messages: no allocation once the buffer has grown to the largest message of the session.
+class SnappyDecoder {
+  public:
+    //! The max uncompressed message size allowed by devp2p.
+    static constexpr std::size_t kMaxMessageSize{(1 << 24) - 1};
+
+    //! The uncompressed length in the header of the block, nullopt if malformed.
+    static std::optional<std::size_t> uncompressed_length(ByteView compressed);
+
+    //! Decompress the block into output, whose size must be the uncompressed length: false if the block is malformed.
+    static bool decompress(ByteView compressed, std::span<uint8_t> output);
+
+    //! Decompress the block into the session buffer: the view is valid until the next call.
+    //! Throws std::runtime_error if the block is malformed or too large.
+    ByteView decompress(ByteView compressed);
+
+  private:
+    Bytes buffer_;
+};
+
+}  // namespace silkworm::sentry::rlpx::framing
@@ -0,0 +1,62 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "snappy_decoder.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/common/cast.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::sentry::rlpx::framing {
+
+TEST_CASE("SnappyDecoder.decompress") {
+    SnappyDecoder decoder;
+
+    SECTION("literal and overlapping copy") {
+        // length 9, literal "abc", copy of length 6 at offset 3
+        const Bytes compressed{*from_hex("0908616263" "0903")};
+        CHECK(SnappyDecoder::uncompressed_length(compressed) == 9);
+        CHECK(decoder.decompress(compressed) == string_view_to_byte_view("abcabcabc"));
+    }
+
+    SECTION("copy with 2-byte offset") {
+        // length 8, literal "abcd", copy of length 4 at offset 4
+        const Bytes compressed{*from_hex("080c61626364" "0e0400")};
+        CHECK(decoder.decompress(compressed) == string_view_to_byte_view("abcdabcd"));
+    }
+
+    SECTION("empty message") {
+        CHECK(decoder.decompress(Bytes{0x00}).empty());
+    }
+
+    SECTION("buffer reused across messages") {
+        const Bytes large{*from_hex("0908616263" "0903")};
+        const auto data = decoder.decompress(large).data();
+        CHECK(decoder.decompress(*from_hex("0204" "6162")) == string_view_to_byte_view("ab"));
+        CHECK(decoder.decompress(large).data() == data);
+    }
+
+    SECTION("malformed") {
+        CHECK_THROWS_AS(decoder.decompress(ByteView{}), std::runtime_error);
+        CHECK_THROWS_AS(decoder.decompress(*from_hex("0a08616263" "0903")), std::runtime_error);  // length mismatch
+        CHECK_THROWS_AS(decoder.decompress(*from_hex("0908616263" "0904")), std::runtime_error);  // offset too far
+        CHECK_THROWS_AS(decoder.decompress(*from_hex("09086162")), std::runtime_error);           // truncated literal
+        CHECK_THROWS_AS(decoder.decompress(*from_hex("8080808008")), std::runtime_error);         // too large
+    }
+}
+
+}  // namespace silkworm::sentry::rlpx::framing
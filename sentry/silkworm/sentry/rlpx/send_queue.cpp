@@ -0,0 +1,55 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "send_queue.hpp"
+
+#include <utility>
+
+namespace silkworm::sentry::rlpx {
+
+SendQueue::SendQueue(std::size_t max_bytes) : max_bytes_(max_bytes) {
+}
+
+SendQueue::PushResult SendQueue::push(Message message, Priority priority) {
+    const std::size_t size = message->size();
+    if (priority == Priority::kLow && bytes_ + size > max_bytes_ / 2) {
+        ++dropped_;
+        return PushResult::kDropped;
+    }
+    if (bytes_ + size > max_bytes_) {
+        return PushResult::kPeerTooSlow;
+    }
+
+    queues_[static_cast<std::size_t>(priority)].push_back(std::move(message));
+    bytes_ += size;
+    ++count_;
+    return PushResult::kQueued;
+}
+
+SendQueue::Message SendQueue::pop() {
+    for (auto& queue : queues_) {
+        if (!queue.empty()) {
+            Message message = std::move(queue.front());
+            queue.pop_front();
+            bytes_ -= message->size();
+            --count_;
+            return message;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace silkworm::sentry::rlpx
@@ -0,0 +1,73 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::sentry::rlpx {
+
+//! The bounded send queue of a peer session. Messages are accounted by size and sent by priority, FIFO within a
+//! priority, so that consensus-critical messages overtake the tx gossip. A peer reading slower than it is sent to
+//! first loses its low priority messages, then has to be disconnected: the memory held per peer never exceeds the
+//! budget. Not thread safe, it is owned by the session running on the context of the peer.
+class SendQueue {
+  public:
+    using Message = std::shared_ptr<const Bytes>;  // shared by the sessions when broadcast
+
+    enum class Priority : uint8_t {
+        kHigh,    // block propagation, responses to requests
+        kNormal,  // requests
+        kLow,     // tx gossip: dropped first
+    };
+    static constexpr std::size_t kNumPriorities{3};
+
+    enum class PushResult {
+        kQueued,
+        kDropped,      // low priority message over the soft limit
+        kPeerTooSlow,  // over the budget: the peer has to be disconnected
+    };
+
+    static constexpr std::size_t kDefaultMaxBytes{16 * kMebi};
+
+    //! Low priority messages are only accepted under half of max_bytes, keeping room for the others
+    explicit SendQueue(std::size_t max_bytes = kDefaultMaxBytes);
+
+    PushResult push(Message message, Priority priority);
+
+    //! The next message to send, the oldest of the highest priority, nullptr if empty
+    Message pop();
+
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+    [[nodiscard]] std::size_t bytes() const { return bytes_; }
+    [[nodiscard]] std::size_t size() const { return count_; }
+    [[nodiscard]] std::size_t dropped() const { return dropped_; }
+
+  private:
+    const std::size_t max_bytes_;
+    std::array<std::deque<Message>, kNumPriorities> queues_;
+    std::size_t bytes_{0};
+    std::size_t count_{0};
+    std::size_t dropped_{0};
+};
+
+}  // namespace silkworm::sentry::rlpx
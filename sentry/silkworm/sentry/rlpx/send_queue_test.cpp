@@ -0,0 +1,66 @@
+/*
+Copyright 2020-2022 The Silkworm Authors
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "send_queue.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::sentry::rlpx {
+
+TEST_CASE("SendQueue.push_pop") {
+    using Priority = SendQueue::Priority;
+    using PushResult = SendQueue::PushResult;
+    auto make_message = [](std::size_t size, uint8_t tag) { return std::make_shared<const Bytes>(size, tag); };
+
+    SendQueue queue{100};
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.pop());
+
+    SECTION("by priority then FIFO") {
+        CHECK(queue.push(make_message(10, 1), Priority::kLow) == PushResult::kQueued);
+        CHECK(queue.push(make_message(10, 2), Priority::kNormal) == PushResult::kQueued);
+        CHECK(queue.push(make_message(10, 3), Priority::kHigh) == PushResult::kQueued);
+        CHECK(queue.push(make_message(10, 4), Priority::kHigh) == PushResult::kQueued);
+        CHECK(queue.size() == 4);
+        CHECK(queue.bytes() == 40);
+
+        for (uint8_t expected_tag : {3, 4, 2, 1}) {
+            const auto message = queue.pop();
+            REQUIRE(message);
+            CHECK(message->front() == expected_tag);
+        }
+        CHECK(queue.empty());
+        CHECK(queue.bytes() == 0);
+    }
+
+    SECTION("low priority dropped over the soft limit") {
+        CHECK(queue.push(make_message(40, 1), Priority::kLow) == PushResult::kQueued);
+        CHECK(queue.push(make_message(20, 2), Priority::kLow) == PushResult::kDropped);
+        CHECK(queue.dropped() == 1);
+        CHECK(queue.push(make_message(20, 3), Priority::kHigh) == PushResult::kQueued);
+        CHECK(queue.bytes() == 60);
+    }
+
+    SECTION("peer too slow over the budget") {
+        CHECK(queue.push(make_message(90, 1), Priority::kNormal) == PushResult::kQueued);
+        CHECK(queue.push(make_message(20, 2), Priority::kHigh) == PushResult::kPeerTooSlow);
+        CHECK(queue.size() == 1);
+        queue.pop();
+        CHECK(queue.push(make_message(20, 2), Priority::kHigh) == PushResult::kQueued);
+    }
+}
+
+}  // namespace silkworm::sentry::rlpx
@@ -20,9 +20,13 @@ limitations under the License.
 #include <string>
 #include <utility>
 
-#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
+#include <gsl/util>
+
 #include <silkworm/common/log.hpp>
 
 namespace silkworm::sentry::rlpx {
@@ -32,7 +36,7 @@ using namespace boost::asio;
 Server::Server(std::string host, uint16_t port) : host_(std::move(host)), port_(port) {
 }
 
-awaitable<void> Server::start(io_context& io_context) {
+awaitable<void> Server::start(io_context& io_context, silkworm::rpc::ServerContextPool& peer_contexts) {
     ip::tcp::resolver resolver{io_context};
     auto endpoints = co_await resolver.async_resolve(host_, std::to_string(port_), use_awaitable);
     const ip::tcp::endpoint& endpoint = *endpoints.cbegin();
@@ -43,10 +47,36 @@ awaitable<void> Server::start(io_context& io_context) {
     acceptor.bind(endpoint);
     acceptor.listen();
 
+    post(peer_contexts.next_io_context(), [this] { ephemeral_key_pairs_.refill(); });
+
     while (acceptor.is_open()) {
-        ip::tcp::socket socket{io_context};
-        co_await acceptor.async_accept(socket, use_awaitable);
+        // The socket is bound to the peer context: all its I/O and processing run there
+        auto& peer_io_context = peer_contexts.next_io_context();
+        ip::tcp::socket socket = co_await acceptor.async_accept(peer_io_context, use_awaitable);
+
+        if (handshakes_ >= kMaxConcurrentHandshakes) {
+            boost::system::error_code ec;
+            log::Debug() << "rlpx::Server too many handshakes, dropped peer: " << socket.remote_endpoint(ec);
+            continue;  // closed by the socket destructor
+        }
+        ++handshakes_;
+        if (ephemeral_key_pairs_.needs_refill()) {
+            post(peer_contexts.next_io_context(), [this] { ephemeral_key_pairs_.refill(); });
+        }
+        co_spawn(peer_io_context, handle_peer(std::move(socket)), detached);
     }
 }
 
+awaitable<void> Server::handle_peer(ip::tcp::socket socket) {
+    auto handshake_slot = gsl::finally([this] { --handshakes_; });
+
+    boost::system::error_code ec;
+    const auto remote_endpoint = socket.remote_endpoint(ec);
+    log::Debug() << "rlpx::Server peer connected: " << remote_endpoint << " ec: " << ec;
+
+    // The RLPx handshake is not implemented yet: it will take its ephemeral keys from ephemeral_key_pairs_,
+    // and release its handshake slot before running the session. The connection is closed on return
+    co_return;
+}
+
 }  // namespace silkworm::sentry::rlpx
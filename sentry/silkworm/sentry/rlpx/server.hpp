@@ -16,22 +16,36 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <silkworm/concurrency/coroutine.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <silkworm/rpc/server/server_context_pool.hpp>
+#include <silkworm/sentry/common/ecc_key_pair_pool.hpp>
 
 namespace silkworm::sentry::rlpx {
 
 class Server final {
   public:
+    //! Handshakes beyond this are refused, so that a burst of connections does not delay the established sessions
+    static constexpr std::size_t kMaxConcurrentHandshakes{256};
+    static constexpr std::size_t kEphemeralKeyPairPoolSize{kMaxConcurrentHandshakes};
+
     Server(std::string host, uint16_t port);
 
-    boost::asio::awaitable<void> start(boost::asio::io_context& io_context);
+    //! Accept connections on io_context and spread them round-robin on the contexts of the pool, each peer session
+    //! running as a coroutine on the context of its connection. The pool must not be used concurrently by others.
+    boost::asio::awaitable<void> start(boost::asio::io_context& io_context, silkworm::rpc::ServerContextPool& peer_contexts);
 
   private:
+    boost::asio::awaitable<void> handle_peer(boost::asio::ip::tcp::socket socket);
+
     std::string host_;
     uint16_t port_;
+    common::EccKeyPairPool ephemeral_key_pairs_{kEphemeralKeyPairPoolSize};  // refilled on the peer contexts
+    std::atomic_size_t handshakes_{0};
 };
 
 }  // namespace silkworm::sentry::rlpx
@@ -49,6 +49,12 @@ class SentryImpl final {
     void stop();
     void join();
 
+    std::shared_ptr<grpc::Channel> in_process_channel() { return rpc_server_.in_process_channel(); }
+
+    [[nodiscard]] std::vector<PeerStats> peer_stats() const {
+        return peer_stats_.snapshot(PeerStatsCollector::Clock::now());
+    }
+
   private:
     void setup_shutdown_on_signals(asio::io_context&);
 
@@ -58,6 +64,7 @@ class SentryImpl final {
     rlpx::Server rlpx_server_;
     std::promise<void> rlpx_server_task_;
     rpc::Server rpc_server_;
+    PeerStatsCollector peer_stats_;
 
     optional<unique_ptr<asio::signal_set>> shutdown_signals_;
     asio::cancellation_signal stop_signal_;
@@ -107,7 +114,7 @@ void SentryImpl::start() {
     };
     asio::co_spawn(
             rlpx_io_context,
-            rlpx_server_.start(rlpx_io_context),
+            rlpx_server_.start(rlpx_io_context, context_pool_),
             asio::bind_cancellation_slot(stop_signal_.slot(), rlpx_server_task_completion));
 
     setup_shutdown_on_signals(context_pool_.next_io_context());
@@ -148,5 +155,7 @@ Sentry::~Sentry() {
 void Sentry::start() { p_impl_->start(); }
 void Sentry::stop() { p_impl_->stop(); }
 void Sentry::join() { p_impl_->join(); }
+std::shared_ptr<grpc::Channel> Sentry::in_process_channel() { return p_impl_->in_process_channel(); }
+std::vector<PeerStats> Sentry::peer_stats() const { return p_impl_->peer_stats(); }
 
 }  // namespace silkworm::sentry
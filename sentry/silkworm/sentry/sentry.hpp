@@ -17,8 +17,14 @@ limitations under the License.
 #pragma once
 
 #include <memory>
+#include <vector>
+#include "peer_stats.hpp"
 #include "settings.hpp"
 
+namespace grpc {
+class Channel;
+}
+
 namespace silkworm::sentry {
 
 class SentryImpl;
@@ -35,6 +41,12 @@ class Sentry final {
     void stop();
     void join();
 
+    //! Channel to the sentry API for clients in the same process (e.g. an embedded downloader), null until started.
+    std::shared_ptr<grpc::Channel> in_process_channel();
+
+    //! Measured statistics of the connected peers, for clients in the same process (e.g. the downloader scheduler).
+    [[nodiscard]] std::vector<PeerStats> peer_stats() const;
+
   private:
     std::unique_ptr<SentryImpl> p_impl_;
 };
@@ -22,12 +22,28 @@
 #include <silkworm/chain/intrinsic_gas.hpp>
 #include <silkworm/common/util.hpp>
 
+bool simd_enabled() {
+#if defined(__wasm_simd128__)
+    return true;
+#else
+    return false;
+#endif
+}
+
 void* new_buffer(size_t size) { return std::malloc(size); }
 
 void delete_buffer(void* ptr) { std::free(ptr); }
 
 using namespace silkworm;
 
+uint8_t* scratch_buffer(size_t size) {
+    static Bytes scratch;
+    if (scratch.length() < size) {
+        scratch.resize(size);
+    }
+    return scratch.data();
+}
+
 // silkworm::consensus::Ethash engine;
 Bytes* new_bytes_from_hex(const char* data, size_t size) {
     std::optional<Bytes> res{from_hex(std::string_view{data, size})};
@@ -203,6 +219,53 @@ void state_update_storage(State* state, const uint8_t* address, const Account* a
                           to_bytes32(*value));
 }
 
+bool state_update_accounts(State* state, const uint8_t* rlp, size_t length) {
+    ByteView view{rlp, length};
+    Bytes code;
+    Bytes location;
+    Bytes value;
+    while (!view.empty()) {
+        const auto [header, err]{rlp::decode_header(view)};
+        if (err != DecodingResult::kOk || !header.list || header.payload_length > view.length()) {
+            return false;
+        }
+        ByteView entry{view.substr(0, header.payload_length)};
+        view.remove_prefix(header.payload_length);
+
+        evmc::address address;
+        Account account;
+        if (rlp::decode(entry, address.bytes) != DecodingResult::kOk ||
+            rlp::decode(entry, account.nonce) != DecodingResult::kOk ||
+            rlp::decode(entry, account.balance) != DecodingResult::kOk ||
+            rlp::decode(entry, code) != DecodingResult::kOk) {
+            return false;
+        }
+        const auto [storage_header, storage_err]{rlp::decode_header(entry)};
+        if (storage_err != DecodingResult::kOk || !storage_header.list ||
+            storage_header.payload_length != entry.length()) {
+            return false;
+        }
+
+        if (!code.empty()) {
+            const ethash::hash256 code_hash{keccak256(code)};
+            std::memcpy(account.code_hash.bytes, code_hash.bytes, kHashLength);
+        }
+        state->update_account(address, /*initial=*/std::nullopt, account);
+        if (!code.empty()) {
+            state->update_account_code(address, account.incarnation, account.code_hash, code);
+        }
+        while (!entry.empty()) {
+            if (rlp::decode(entry, location) != DecodingResult::kOk ||
+                rlp::decode(entry, value) != DecodingResult::kOk) {
+                return false;
+            }
+            state->update_storage(address, account.incarnation, to_bytes32(location), /*initial=*/{},
+                                  to_bytes32(value));
+        }
+    }
+    return true;
+}
+
 consensus::Blockchain* new_blockchain(State* state, const ChainConfig* config, const Block* genesis_block) {
     return new consensus::Blockchain{*state, *config, *genesis_block};
 }
@@ -213,4 +276,23 @@ ValidationResult blockchain_insert_block(consensus::Blockchain* chain, Block* bl
     return chain->insert_block(*block, check_state_root);
 }
 
+bool blockchain_insert_blocks(consensus::Blockchain* chain, const uint8_t* rlp, size_t length, bool check_state_root,
+                              size_t* num_inserted, ValidationResult* result) {
+    *num_inserted = 0;
+    *result = ValidationResult::kOk;
+    ByteView view{rlp, length};
+    while (!view.empty()) {
+        Block block;
+        if (rlp::decode(view, block) != DecodingResult::kOk) {
+            return false;
+        }
+        *result = chain->insert_block(block, check_state_root);
+        if (*result != ValidationResult::kOk) {
+            break;
+        }
+        ++*num_inserted;
+    }
+    return true;
+}
+
 int main() { return 0; }
@@ -37,9 +37,16 @@
 
 extern "C" {
 
+// Whether this module was built with SIMD128 code paths (SILKWORM_WASM_SIMD)
+SILKWORM_EXPORT bool simd_enabled();
+
 SILKWORM_EXPORT void* new_buffer(size_t size);
 SILKWORM_EXPORT void delete_buffer(void* ptr);
 
+// Buffer of at least size bytes, reused across calls: it may move when a larger size is asked for.
+// Meant for the input of the batch calls below, so that no buffer is allocated per call.
+SILKWORM_EXPORT uint8_t* scratch_buffer(size_t size);
+
 SILKWORM_EXPORT silkworm::Bytes* new_bytes_from_hex(const char* data, size_t size);
 SILKWORM_EXPORT void delete_bytes(silkworm::Bytes* x);
 
@@ -127,6 +134,12 @@ SILKWORM_EXPORT void state_update_storage(silkworm::State* state, const uint8_t*
                                           const silkworm::Account* account, const silkworm::Bytes* location,
                                           const silkworm::Bytes* value);
 
+// Batch of state_update_account, state_update_code & state_update_storage calls.
+// [rlp, rlp + length) holds RLP lists one after another, one per account:
+// [address, nonce, balance, code, [location, value, location, value, ...]]
+// Returns false if the batch is malformed, the accounts before the malformed one being updated.
+SILKWORM_EXPORT bool state_update_accounts(silkworm::State* state, const uint8_t* rlp, size_t length);
+
 SILKWORM_EXPORT silkworm::consensus::Blockchain* new_blockchain(silkworm::State* state,
                                                                 const silkworm::ChainConfig* config,
                                                                 const silkworm::Block* genesis_block);
@@ -134,4 +147,12 @@ SILKWORM_EXPORT void delete_blockchain(silkworm::consensus::Blockchain* x);
 
 SILKWORM_EXPORT silkworm::ValidationResult blockchain_insert_block(silkworm::consensus::Blockchain* chain,
                                                                    silkworm::Block* block, bool check_state_root);
+
+// Batch of blockchain_insert_block calls: [rlp, rlp + length) holds RLP-encoded blocks one after another.
+// Stops at the first block failing validation, whose result is put into result (kOk if none fails),
+// and puts the number of blocks inserted into num_inserted.
+// Returns false if the batch is malformed, the blocks before the malformed one being inserted.
+SILKWORM_EXPORT bool blockchain_insert_blocks(silkworm::consensus::Blockchain* chain, const uint8_t* rlp,
+                                              size_t length, bool check_state_root, size_t* num_inserted,
+                                              silkworm::ValidationResult* result);
 }